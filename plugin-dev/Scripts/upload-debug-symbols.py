@@ -2,9 +2,13 @@
 
 import sys
 import os
+import json
 import platform
+import shutil
 import subprocess
+import threading
 import time
+from concurrent.futures import ThreadPoolExecutor, FIRST_COMPLETED, wait
 
 
 def log(message):
@@ -94,6 +98,330 @@ def run_cmd_with_retry(cmd, max_retries=3, retry_delay_sec=2):
     return result
 
 
+# Keeps each sentry-cli command line well below the Windows limit
+MAX_FILES_PER_UPLOAD = 100
+
+DEBUG_FILE_EXTENSIONS = {'.pdb', '.dll', '.exe', '.so', '.dylib', '.debug', '.sym', '.dwp'}
+
+# ELF, 32/64-bit Mach-O in both byte orders and universal binaries
+OBJECT_FILE_MAGICS = (
+    b'\x7fELF',
+    b'\xfe\xed\xfa\xce', b'\xce\xfa\xed\xfe',
+    b'\xfe\xed\xfa\xcf', b'\xcf\xfa\xed\xfe',
+    b'\xca\xfe\xba\xbe',
+)
+
+
+def is_object_file(file_path):
+    # The executable bit isn't available on Windows, where every existing file passes an X_OK check
+    try:
+        with open(file_path, 'rb') as f:
+            return f.read(4) in OBJECT_FILE_MAGICS
+    except OSError:
+        return False
+
+
+def collect_debug_files(paths):
+    debug_files = []
+
+    for path in paths:
+        if not os.path.isdir(path):
+            continue
+
+        for root, dirs, files in os.walk(path):
+            # dSYM bundles are uploaded as a whole
+            for dir_name in list(dirs):
+                if dir_name.endswith('.dSYM'):
+                    debug_files.append(os.path.join(root, dir_name))
+                    dirs.remove(dir_name)
+
+            for file_name in files:
+                extension = os.path.splitext(file_name)[1].lower()
+                file_path = os.path.join(root, file_name)
+
+                # Linux and Mac executables have no extension
+                if extension in DEBUG_FILE_EXTENSIONS or (not extension and is_object_file(file_path)):
+                    debug_files.append(file_path)
+
+    return debug_files
+
+
+def get_path_size(path):
+    if not os.path.isdir(path):
+        return os.path.getsize(path)
+
+    total_size = 0
+    for root, _, files in os.walk(path):
+        for file_name in files:
+            total_size += os.path.getsize(os.path.join(root, file_name))
+
+    return total_size
+
+
+def get_path_fingerprint(path):
+    stat = os.stat(path)
+    return f"{stat.st_size}:{int(stat.st_mtime)}"
+
+
+def load_upload_cache(cache_path):
+    try:
+        with open(cache_path, 'r', encoding='utf-8') as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return {}
+
+
+def save_upload_cache(cache_path, cache):
+    try:
+        os.makedirs(os.path.dirname(cache_path), exist_ok=True)
+        with open(cache_path, 'w', encoding='utf-8') as f:
+            json.dump(cache, f, indent=1)
+    except OSError as e:
+        log(f"Warning: Failed to save debug files upload cache: {e}")
+
+
+def get_debug_ids(cli_exec, path):
+    result = subprocess.run([cli_exec, 'debug-files', 'check', '--json', path], check=False, capture_output=True, text=True)
+    if result.returncode != 0:
+        return None
+
+    try:
+        info = json.loads(result.stdout)
+    except ValueError:
+        return None
+
+    if not info.get('is_usable', True):
+        return []
+
+    # Executables and their PDBs share the debug ID so the features tell them apart
+    return sorted(f"{variant['debug_id']}:{','.join(sorted(variant.get('features', [])))}" for variant in info.get('variants', []) if variant.get('debug_id'))
+
+
+def split_into_batches(files_with_sizes, num_batches):
+    batches = [{'files': [], 'size': 0} for _ in range(num_batches)]
+
+    # Largest files first so that batches end up with about the same amount of data
+    for path, size in sorted(files_with_sizes, key=lambda item: item[1], reverse=True):
+        candidates = [batch for batch in batches if len(batch['files']) < MAX_FILES_PER_UPLOAD]
+        batch = min(candidates, key=lambda b: b['size'])
+        batch['files'].append(path)
+        batch['size'] += size
+
+    return [batch for batch in batches if batch['files']]
+
+
+def get_source_debug_ids(debug_ids):
+    # Only variants with debug information reference source files
+    source_ids = set()
+    for debug_id in debug_ids:
+        debug_id, _, features = debug_id.partition(':')
+        if 'debug' in features.split(','):
+            source_ids.add(debug_id)
+
+    return sorted(source_ids)
+
+
+def build_source_bundle(cli_exec, cli_log_level, path, bundle_path):
+    # sentry-cli names the bundle after the debug file, so it is built in a scratch directory and renamed after its debug ID
+    temp_dir = f"{bundle_path}.tmp"
+    shutil.rmtree(temp_dir, ignore_errors=True)
+    os.makedirs(temp_dir, exist_ok=True)
+
+    try:
+        result = run_cmd_with_retry([cli_exec, 'debug-files', 'bundle-sources', '--log-level', cli_log_level, '--output', temp_dir, path])
+        if result.returncode == 0:
+            bundles = [file_name for file_name in os.listdir(temp_dir) if file_name.endswith('.src.zip')]
+            if bundles:
+                os.replace(os.path.join(temp_dir, bundles[0]), bundle_path)
+            else:
+                # Debug files without any sources available on this machine are remembered so they aren't bundled again
+                open(f"{os.path.splitext(bundle_path)[0]}.empty", 'w').close()
+        return result
+    finally:
+        shutil.rmtree(temp_dir, ignore_errors=True)
+
+
+def prune_source_bundles(source_bundles_dir, source_ids):
+    if not os.path.isdir(source_bundles_dir):
+        return
+
+    for file_name in os.listdir(source_bundles_dir):
+        debug_id = file_name.split('.', 1)[0]
+        if debug_id not in source_ids:
+            try:
+                os.remove(os.path.join(source_bundles_dir, file_name))
+            except OSError:
+                pass
+
+
+def upload_debug_files(cli_exec, cli_args, cli_log_level, paths, num_jobs, cache_path, upload_target, source_bundles_dir=None):
+    cache = load_upload_cache(cache_path) if cache_path else {}
+
+    # Upload status is only meaningful for the organization and project it was recorded for
+    if cache.get('target') != upload_target:
+        cache = {'target': upload_target}
+
+    debug_id_status = cache.get('debug_ids', {})
+    known_files = cache.get('files', {})
+
+    debug_files = collect_debug_files(paths)
+    log(f"Found {len(debug_files)} debug file candidates")
+
+    pending = []
+    pending_ids = {}
+
+    # Debug files to bundle sources for, keyed by the debug ID of the bundle
+    pending_sources = {}
+    all_source_ids = set()
+
+    for path in debug_files:
+        fingerprint = get_path_fingerprint(path)
+
+        # Debug IDs of unchanged files are taken from the cache to avoid parsing multi-GB files again
+        known_file = known_files.get(path)
+        if known_file and known_file.get('fingerprint') == fingerprint:
+            debug_ids = known_file.get('debug_ids', [])
+        else:
+            debug_ids = get_debug_ids(cli_exec, path)
+            if debug_ids is None:
+                continue
+            known_files[path] = {'fingerprint': fingerprint, 'debug_ids': debug_ids}
+
+        if not debug_ids:
+            continue
+
+        if source_bundles_dir:
+            for source_id in get_source_debug_ids(debug_ids):
+                all_source_ids.add(source_id)
+                if not (cache_path and debug_id_status.get(f"{source_id}:sources") == 'uploaded'):
+                    pending_sources.setdefault(source_id, path)
+
+        if cache_path and all(debug_id_status.get(debug_id) == 'uploaded' for debug_id in debug_ids):
+            continue
+
+        pending.append((path, get_path_size(path)))
+        pending_ids[path] = debug_ids
+
+    skipped = len(debug_files) - len(pending)
+    log(f"{len(pending)} debug files to upload, {skipped} skipped as unchanged or not containing debug information")
+
+    ready_bundles = []
+    bundles_to_build = {}
+
+    if source_bundles_dir:
+        # Bundles are cached by debug ID, so only binaries whose debug ID changed since the last build are bundled again
+        prune_source_bundles(source_bundles_dir, all_source_ids)
+        os.makedirs(source_bundles_dir, exist_ok=True)
+
+        for source_id, path in pending_sources.items():
+            bundle_path = os.path.join(source_bundles_dir, f"{source_id}.src.zip")
+            if os.path.exists(bundle_path):
+                ready_bundles.append((source_id, bundle_path))
+            elif not os.path.exists(os.path.join(source_bundles_dir, f"{source_id}.empty")):
+                bundles_to_build[source_id] = (path, bundle_path)
+
+        log(f"{len(pending_sources)} source bundles to upload, {len(bundles_to_build)} of them to build")
+
+    if not pending and not ready_bundles and not bundles_to_build:
+        if cache_path:
+            cache['files'] = known_files
+            save_upload_cache(cache_path, cache)
+        return 0
+
+    output_lock = threading.Lock()
+    total_size = 0
+    uploaded_size = 0
+    num_batches = 0
+    num_finished = 0
+    return_code = 0
+
+    def print_result(result):
+        # Output of each run is printed as a whole so that parallel runs don't interleave
+        with output_lock:
+            if result.stdout:
+                print(result.stdout, end='')
+            if result.stderr:
+                print(result.stderr, end='')
+
+    def upload_batch(batch):
+        # Files are passed explicitly so each sentry-cli run only scans its own batch
+        upload_cmd = [cli_exec, 'debug-files', 'upload', *cli_args, '--log-level', cli_log_level, *batch['files']]
+        return run_cmd_with_retry(upload_cmd)
+
+    with ThreadPoolExecutor(max_workers=num_jobs) as executor:
+        futures = {}
+
+        def submit_batches(files_with_sizes, files_ids):
+            nonlocal total_size, num_batches
+            batch_count = max(num_jobs, (len(files_with_sizes) + MAX_FILES_PER_UPLOAD - 1) // MAX_FILES_PER_UPLOAD)
+            for batch in split_into_batches(files_with_sizes, batch_count):
+                batch['ids'] = [debug_id for path in batch['files'] for debug_id in files_ids[path]]
+                futures[executor.submit(upload_batch, batch)] = ('upload', batch)
+                total_size += batch['size']
+                num_batches += 1
+
+        def submit_bundles(bundles):
+            submit_batches([(bundle_path, os.path.getsize(bundle_path)) for _, bundle_path in bundles], {bundle_path: [f"{source_id}:sources"] for source_id, bundle_path in bundles})
+
+        # Debug files start uploading right away while the missing source bundles are being built
+        if pending:
+            submit_batches(pending, pending_ids)
+
+        for source_id, (path, bundle_path) in bundles_to_build.items():
+            futures[executor.submit(build_source_bundle, cli_exec, cli_log_level, path, bundle_path)] = ('bundle', (source_id, bundle_path))
+
+        if not bundles_to_build and ready_bundles:
+            submit_bundles(ready_bundles)
+
+        while futures:
+            done, _ = wait(futures, return_when=FIRST_COMPLETED)
+
+            for future in done:
+                kind, item = futures.pop(future)
+
+                try:
+                    result = future.result()
+                except Exception as e:
+                    log(f"Error executing sentry-cli: {e}")
+                    return_code = 1
+                    result = None
+
+                if result is not None:
+                    print_result(result)
+
+                if kind == 'bundle':
+                    if result is None or result.returncode != 0:
+                        log(f"Warning: Failed to bundle sources for debug ID {item[0]}")
+                    elif os.path.exists(item[1]):
+                        ready_bundles.append(item)
+
+                    # Bundles are uploaded together once all of them are built so that they are split into as few batches as possible
+                    if ready_bundles and not any(other_kind == 'bundle' for other_kind, _ in futures.values()):
+                        submit_bundles(ready_bundles)
+                    continue
+
+                if result is None:
+                    continue
+
+                if result.returncode != 0:
+                    return_code = result.returncode
+
+                # Failed uploads are recorded too but retried on the next build
+                for debug_id in item['ids']:
+                    debug_id_status[debug_id] = 'uploaded' if result.returncode == 0 else 'failed'
+
+                num_finished += 1
+                uploaded_size += item['size']
+                log(f"Upload progress: {num_finished}/{num_batches} batches, {uploaded_size / (1024 * 1024):.1f}/{total_size / (1024 * 1024):.1f} MB")
+
+    if cache_path:
+        cache['files'] = known_files
+        cache['debug_ids'] = debug_id_status
+        save_upload_cache(cache_path, cache)
+
+    return return_code
+
+
 def main():
     target_platform = sys.argv[1]
     target_name = sys.argv[2]
@@ -196,6 +524,9 @@ def main():
 
         # Set environment variable for sentry-cli
         os.environ['SENTRY_PROPERTIES'] = properties_file
+
+        upload_org = org_name
+        upload_project = project_name
     else:
         log("Properties file not found. Falling back to environment variables.")
 
@@ -212,6 +543,54 @@ def main():
             log("Error: SENTRY_AUTH_TOKEN env var is not set. Skipping...")
             return 0
 
+        upload_org = os.environ.get('SENTRY_ORG')
+        upload_project = os.environ.get('SENTRY_PROJECT')
+
+    # Get number of parallel upload jobs
+    upload_jobs = parse_config_value(config_path, 'SymbolUploadJobs', '/Script/Sentry.SentrySettings')
+
+    env_override = os.environ.get('SENTRY_SYMBOL_UPLOAD_JOBS')
+    if env_override:
+        upload_jobs = env_override
+        log(f"Parallel upload jobs were overridden via environment variable SENTRY_SYMBOL_UPLOAD_JOBS with value '{env_override}'")
+
+    try:
+        upload_jobs = int(upload_jobs) if upload_jobs else 0
+    except ValueError:
+        log(f"Warning: Invalid number of parallel upload jobs '{upload_jobs}', uploading with a single sentry-cli run")
+        upload_jobs = 0
+
+    # Check if debug files uploaded by previous builds should be skipped
+    cache_uploaded = parse_config_value(config_path, 'CacheUploadedSymbols', '/Script/Sentry.SentrySettings')
+
+    env_override = os.environ.get('SENTRY_CACHE_UPLOADED_SYMBOLS')
+    if env_override:
+        cache_uploaded = env_override
+        log(f"Uploaded symbols caching was overridden via environment variable SENTRY_CACHE_UPLOADED_SYMBOLS with value '{env_override}'")
+
+    # Disabled unless explicitly turned on
+    cache_uploaded = bool(cache_uploaded) and cache_uploaded.lower() == "true"
+
+    if upload_jobs > 0 or cache_uploaded:
+        cache_path = os.path.join(project_dir, 'Intermediate', 'Sentry', f'uploaded-debug-files-{target_platform}.json') if cache_uploaded else None
+        upload_target = f"{upload_org}/{upload_project}"
+
+        # Sources are bundled by the script instead of sentry-cli so that bundles of unchanged binaries are reused
+        source_bundles_dir = os.path.join(project_dir, 'Intermediate', 'Sentry', 'SourceBundles', target_platform) if include_sources == "True" else None
+        upload_args = [arg for arg in cli_args if arg != '--include-sources']
+
+        upload_jobs = max(upload_jobs, 1)
+        log(f"Uploading with {upload_jobs} parallel jobs{', skipping debug files uploaded by previous builds' if cache_path else ''}")
+
+        try:
+            result_code = upload_debug_files(cli_exec, upload_args, cli_log_level, [project_binaries_path, plugin_binaries_path], upload_jobs, cache_path, upload_target, source_bundles_dir)
+            log("Upload finished")
+            return result_code
+
+        except Exception as e:
+            log(f"Error uploading debug files: {e}")
+            return 1
+
     # Construct the upload command
     upload_cmd = [
         cli_exec,
@@ -5,9 +5,37 @@
 #include "Infrastructure/AndroidSentryConverters.h"
 #include "Infrastructure/AndroidSentryJavaClasses.h"
 
+#include "SentryDefines.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+namespace SentryAttachmentSpill
+{
+	// Byte attachments of this size and above are handed over to Java by path so their data isn't duplicated in the Java heap
+	static constexpr int32 MinSpillSize = 1024 * 1024;
+
+	static FString GetSpillDirectory()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryAttachments"));
+	}
+}
+
 FAndroidSentryAttachment::FAndroidSentryAttachment(const TArray<uint8>& data, const FString& filename, const FString& contentType)
-	: FSentryJavaObjectWrapper(SentryJavaClasses::Attachment, "([BLjava/lang/String;Ljava/lang/String;)V",
-		  FAndroidSentryConverters::ByteArrayToNative(data), *GetJString(filename), *GetJString(contentType))
+	: FAndroidSentryAttachment(SpillToFile(data, filename), data, filename, contentType)
+{
+}
+
+FAndroidSentryAttachment::FAndroidSentryAttachment(const FString& spilledPath, const TArray<uint8>& data, const FString& filename, const FString& contentType)
+	: FSentryJavaObjectWrapper(SentryJavaClasses::Attachment,
+		  spilledPath.IsEmpty() ? "([BLjava/lang/String;Ljava/lang/String;)V" : "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V",
+		  spilledPath.IsEmpty()
+			  ? static_cast<jobject>(FAndroidSentryConverters::ByteArrayToNative(data))
+			  : static_cast<jobject>(*GetJString(IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*spilledPath))),
+		  *GetJString(filename), *GetJString(contentType))
+	, SpilledFilePath(spilledPath)
 {
 	SetupClassMethods();
 }
@@ -19,6 +47,15 @@ FAndroidSentryAttachment::FAndroidSentryAttachment(const FString& path, const FS
 	SetupClassMethods();
 }
 
+FAndroidSentryAttachment::~FAndroidSentryAttachment()
+{
+	// Java SDK reads the file when an event is captured, and attachments added to the scope are kept alive by the subsystem
+	if (!SpilledFilePath.IsEmpty())
+	{
+		IFileManager::Get().Delete(*SpilledFilePath, false, false, true);
+	}
+}
+
 void FAndroidSentryAttachment::SetupClassMethods()
 {
 	GetDataMethod = GetMethod("getBytes", "()[B");
@@ -27,14 +64,56 @@ void FAndroidSentryAttachment::SetupClassMethods()
 	GetContentTypeMethod = GetMethod("getContentType", "()Ljava/lang/String;");
 }
 
+void FAndroidSentryAttachment::CleanupSpilledFiles()
+{
+	// Java SDK reads attachment files when events are captured so files left by previous sessions are no longer needed
+	const FString SpillDirectory = SentryAttachmentSpill::GetSpillDirectory();
+	if (IFileManager::Get().DirectoryExists(*SpillDirectory))
+	{
+		IFileManager::Get().DeleteDirectory(*SpillDirectory, false, true);
+	}
+}
+
+FString FAndroidSentryAttachment::SpillToFile(const TArray<uint8>& data, const FString& filename)
+{
+	if (data.Num() < SentryAttachmentSpill::MinSpillSize)
+	{
+		return FString();
+	}
+
+	const FString SpillPath = FPaths::Combine(SentryAttachmentSpill::GetSpillDirectory(),
+		FString::Printf(TEXT("%s-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits), *FPaths::GetCleanFilename(filename)));
+
+	if (!FFileHelper::SaveArrayToFile(data, *SpillPath))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to write attachment %s to a temporary file, its data will be copied to the Java heap instead."), *filename);
+		return FString();
+	}
+
+	return SpillPath;
+}
+
 TArray<uint8> FAndroidSentryAttachment::GetData() const
 {
+	if (!SpilledFilePath.IsEmpty())
+	{
+		TArray<uint8> data;
+		FFileHelper::LoadFileToArray(data, *SpilledFilePath);
+		return data;
+	}
+
 	auto data = CallObjectMethod<jobject>(GetDataMethod);
 	return FAndroidSentryConverters::ByteArrayToUnreal(static_cast<jbyteArray>(*data));
 }
 
 FString FAndroidSentryAttachment::GetPath() const
 {
+	if (!SpilledFilePath.IsEmpty())
+	{
+		// Attachment was created from bytes, the temporary file is an implementation detail
+		return FString();
+	}
+
 	return CallMethod<FString>(GetPathMethod);
 }
 
@@ -11,15 +11,29 @@ class FAndroidSentryAttachment : public ISentryAttachment, public FSentryJavaObj
 public:
 	FAndroidSentryAttachment(const TArray<uint8>& data, const FString& filename, const FString& contentType);
 	FAndroidSentryAttachment(const FString& path, const FString& filename, const FString& contentType);
+	virtual ~FAndroidSentryAttachment() override;
 
 	void SetupClassMethods();
 
+	/** Removes byte attachments spilled to disk by previous sessions. */
+	static void CleanupSpilledFiles();
+
+	/** Checks whether the data of the attachment was written to a temporary file that is deleted along with the attachment. */
+	bool IsSpilled() const { return !SpilledFilePath.IsEmpty(); }
+
 	virtual TArray<uint8> GetData() const override;
 	virtual FString GetPath() const override;
 	virtual FString GetFilename() const override;
 	virtual FString GetContentType() const override;
 
 private:
+	FAndroidSentryAttachment(const FString& spilledPath, const TArray<uint8>& data, const FString& filename, const FString& contentType);
+
+	static FString SpillToFile(const TArray<uint8>& data, const FString& filename);
+
+	/** Temporary file holding the data of a large byte attachment, empty if the data lives in the Java heap. */
+	FString SpilledFilePath;
+
 	FSentryJavaMethod GetDataMethod;
 	FSentryJavaMethod GetPathMethod;
 	FSentryJavaMethod GetFilenameMethod;
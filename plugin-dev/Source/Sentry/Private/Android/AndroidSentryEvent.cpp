@@ -22,6 +22,7 @@ FAndroidSentryEvent::FAndroidSentryEvent(jobject event)
 void FAndroidSentryEvent::SetupClassMethods()
 {
 	GetIdMethod = GetMethod("getEventId", "()Lio/sentry/protocol/SentryId;");
+	SetIdMethod = GetMethod("setEventId", "(Lio/sentry/protocol/SentryId;)V");
 	SetMessageMethod = GetMethod("setMessage", "(Lio/sentry/protocol/Message;)V");
 	GetMessageMethod = GetMethod("getMessage", "()Lio/sentry/protocol/Message;");
 	SetLevelMethod = GetMethod("setLevel", "(Lio/sentry/SentryLevel;)V");
@@ -47,6 +48,11 @@ TSharedPtr<ISentryId> FAndroidSentryEvent::GetId() const
 	return MakeShareable(new FAndroidSentryId(*id));
 }
 
+void FAndroidSentryEvent::SetId(const FString& id)
+{
+	CallMethod<void>(SetIdMethod, FAndroidSentryId(id).GetJObject());
+}
+
 void FAndroidSentryEvent::SetMessage(const FString& message)
 {
 	CallMethod<void>(SetMessageMethod, FAndroidSentryMessage(message).GetJObject());
@@ -218,3 +224,9 @@ bool FAndroidSentryEvent::IsAnr() const
 {
 	return CallStaticMethod<bool>(SentryJavaClasses::SentryBridgeJava, "isAnrEvent", "(Lio/sentry/SentryEvent;)Z", GetJObject());
 }
+
+TSharedPtr<ISentryEvent> FAndroidSentryEvent::Clone() const
+{
+	auto eventCopy = CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "copyEvent", "(Lio/sentry/SentryEvent;)Lio/sentry/SentryEvent;", GetJObject());
+	return MakeShareable(new FAndroidSentryEvent(*eventCopy));
+}
@@ -15,6 +15,7 @@ public:
 	void SetupClassMethods();
 
 	virtual TSharedPtr<ISentryId> GetId() const override;
+	virtual void SetId(const FString& id) override;
 	virtual void SetMessage(const FString& message) override;
 	virtual FString GetMessage() const override;
 	virtual void SetLevel(ESentryLevel level) override;
@@ -39,9 +40,11 @@ public:
 	virtual TMap<FString, FSentryVariant> GetExtras() const override;
 	virtual bool IsCrash() const override;
 	virtual bool IsAnr() const override;
+	virtual TSharedPtr<ISentryEvent> Clone() const override;
 
 private:
 	FSentryJavaMethod GetIdMethod;
+	FSentryJavaMethod SetIdMethod;
 	FSentryJavaMethod SetMessageMethod;
 	FSentryJavaMethod GetMessageMethod;
 	FSentryJavaMethod SetLevelMethod;
@@ -7,6 +7,7 @@
 #include "AndroidSentryEvent.h"
 #include "AndroidSentryFeedback.h"
 #include "AndroidSentryId.h"
+#include "AndroidSentryScope.h"
 #include "AndroidSentryTransaction.h"
 #include "AndroidSentryTransactionContext.h"
 #include "AndroidSentryTransactionOptions.h"
@@ -20,20 +21,27 @@
 
 #include "Callbacks/AndroidSentryScopeCallback.h"
 
+#include "Infrastructure/AndroidSentryBridgeBatch.h"
 #include "Infrastructure/AndroidSentryConverters.h"
 #include "Infrastructure/AndroidSentryJavaClasses.h"
+#include "Infrastructure/AndroidSentryJavaEnv.h"
+#include "Infrastructure/AndroidSentryPackedBuffer.h"
 
+#include "Utils/SentryDeviceConditions.h"
 #include "Utils/SentryFileUtils.h"
+#include "Utils/SentryStructLayout.h"
 
-#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
 #include "HAL/FileManager.h"
 #include "Misc/CoreDelegates.h"
+#include "Misc/EngineVersionComparison.h"
 #include "Misc/FileHelper.h"
 #include "Misc/OutputDeviceError.h"
 #include "Misc/Paths.h"
-#include "Serialization/JsonSerializer.h"
 #include "Utils/SentryScreenshotUtils.h"
 
+#include <stdio.h>
+
 FAndroidSentrySubsystem::FAndroidSentrySubsystem()
 {
 	SentryJavaClasses::InitJavaClassRefsCache();
@@ -47,55 +55,83 @@ FAndroidSentrySubsystem::~FAndroidSentrySubsystem()
 void FAndroidSentrySubsystem::InitWithSettings(const USentrySettings* settings, USentryBeforeSendHandler* beforeSendHandler, USentryBeforeBreadcrumbHandler* beforeBreadcrumbHandler, USentryBeforeLogHandler* beforeLogHandler, USentryTraceSampler* traceSampler)
 {
 	isScreenshotAttachmentEnabled = settings->AttachScreenshot;
-
-	TSharedPtr<FJsonObject> SettingsJson = MakeShareable(new FJsonObject);
-	SettingsJson->SetStringField(TEXT("dsn"), settings->Dsn);
-	SettingsJson->SetStringField(TEXT("release"), settings->GetEffectiveRelease());
-	SettingsJson->SetStringField(TEXT("environment"), settings->GetEffectiveEnvironment());
-	SettingsJson->SetStringField(TEXT("dist"), settings->Dist);
-	SettingsJson->SetBoolField(TEXT("autoSessionTracking"), settings->EnableAutoSessionTracking);
-	SettingsJson->SetNumberField(TEXT("sessionTimeout"), settings->SessionTimeout);
-	SettingsJson->SetBoolField(TEXT("enableStackTrace"), settings->AttachStacktrace);
-	SettingsJson->SetBoolField(TEXT("debug"), settings->Debug);
-	SettingsJson->SetNumberField(TEXT("sampleRate"), settings->SampleRate);
-	SettingsJson->SetNumberField(TEXT("maxBreadcrumbs"), settings->MaxBreadcrumbs);
-	SettingsJson->SetBoolField(TEXT("attachScreenshot"), settings->AttachScreenshot);
-	SettingsJson->SetArrayField(TEXT("inAppInclude"), FAndroidSentryConverters::StrinArrayToJsonArray(settings->InAppInclude));
-	SettingsJson->SetArrayField(TEXT("inAppExclude"), FAndroidSentryConverters::StrinArrayToJsonArray(settings->InAppExclude));
-	SettingsJson->SetBoolField(TEXT("sendDefaultPii"), settings->SendDefaultPii);
-	SettingsJson->SetBoolField(TEXT("enableAnrTracking"), settings->EnableAppNotRespondingTracking);
-	SettingsJson->SetBoolField(TEXT("enableAutoLogAttachment"), settings->EnableAutoLogAttachment);
-	SettingsJson->SetBoolField(TEXT("enableStructuredLogging"), settings->EnableStructuredLogging);
-	if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::UniformSampleRate)
+	isAsyncScopedCaptureEnabled = settings->EnableAsyncScopedCaptures;
+	isPixelCopyScreenshotEnabled = settings->AttachScreenshot && settings->UsePixelCopyScreenshots;
+	isPixelCopyScreenshotJpeg = settings->ScreenshotFormat == ESentryScreenshotFormat::Jpeg;
+	screenshotJpegQuality = settings->ScreenshotJpegQuality;
+	screenshotMaxDimension = settings->ScreenshotMaxDimension;
+
+	FAndroidSentryAttachment::CleanupSpilledFiles();
+
+	const bool hasTracesSampleRate = settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::UniformSampleRate;
+	const bool hasTracesSampler = settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::TracesSampler && traceSampler != nullptr;
+
+	// Field order must match SentryBridgeJava.UnrealSettings
+	FAndroidSentryPackedBuffer packedSettings;
+	packedSettings.WriteString(settings->Dsn);
+	packedSettings.WriteString(settings->GetEffectiveRelease());
+	packedSettings.WriteString(settings->GetEffectiveEnvironment());
+	packedSettings.WriteString(settings->Dist);
+	packedSettings.WriteBool(settings->EnableAutoSessionTracking);
+	packedSettings.WriteInt64(settings->SessionTimeout);
+	packedSettings.WriteBool(settings->AttachStacktrace);
+	packedSettings.WriteBool(settings->Debug);
+	packedSettings.WriteDouble(settings->SampleRate);
+	packedSettings.WriteInt32(settings->MaxBreadcrumbs);
+	packedSettings.WriteBool(settings->AttachScreenshot);
+	packedSettings.WriteStringArray(settings->InAppInclude);
+	packedSettings.WriteStringArray(settings->InAppExclude);
+	packedSettings.WriteBool(settings->SendDefaultPii);
+	packedSettings.WriteBool(settings->EnableAppNotRespondingTracking);
+	packedSettings.WriteBool(settings->EnableAutoLogAttachment);
+	packedSettings.WriteBool(settings->EnableStructuredLogging);
+	packedSettings.WriteBool(hasTracesSampleRate);
+	packedSettings.WriteDouble(hasTracesSampleRate ? settings->TracesSampleRate : 0.0);
+	packedSettings.WriteInt64(hasTracesSampler ? (jlong)traceSampler : 0);
+	packedSettings.WriteBool(settings->EnableTracing && settings->EnableProfiling);
+	packedSettings.WriteDouble(settings->ProfilesSampleRate);
+
+	const bool hasSampleRules = settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::SampleRules;
+	packedSettings.WriteInt32(hasSampleRules ? settings->TracesSampleRules.Num() : 0);
+	if (hasSampleRules)
 	{
-		SettingsJson->SetNumberField(TEXT("tracesSampleRate"), settings->TracesSampleRate);
-	}
-	if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::TracesSampler && traceSampler != nullptr)
-	{
-		SettingsJson->SetNumberField(TEXT("tracesSampler"), (jlong)traceSampler);
-	}
-	if (beforeBreadcrumbHandler != nullptr)
-	{
-		SettingsJson->SetNumberField(TEXT("beforeBreadcrumb"), (jlong)beforeBreadcrumbHandler);
-	}
-	if (beforeSendHandler != nullptr)
-	{
-		SettingsJson->SetNumberField(TEXT("beforeSendHandler"), (jlong)beforeSendHandler);
-	}
-	if (beforeLogHandler != nullptr)
-	{
-		SettingsJson->SetNumberField(TEXT("beforeLogHandler"), (jlong)beforeLogHandler);
+		for (const FSentryTraceSampleRule& rule : settings->TracesSampleRules)
+		{
+			packedSettings.WriteBool(rule.Target == ESentryTraceSampleRuleTarget::Operation);
+			packedSettings.WriteString(rule.Prefix);
+			packedSettings.WriteDouble(rule.SampleRate);
+		}
 	}
+	packedSettings.WriteBool(hasSampleRules);
+	packedSettings.WriteDouble(settings->TracesSampleRate);
+	packedSettings.WriteInt64((jlong)beforeBreadcrumbHandler);
+	packedSettings.WriteInt64((jlong)beforeSendHandler);
+	packedSettings.WriteInt64((jlong)beforeLogHandler);
+	packedSettings.WriteBool(settings->EnableAppNotRespondingTracking && settings->AttachNativeStacksToAnrs);
+	packedSettings.WriteBool(settings->ReportProcessExitReasons);
+
+	TArray<uint8> settingsData = packedSettings.Release();
 
-	FString SettingsJsonStr;
-	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&SettingsJsonStr);
-	FJsonSerializer::Serialize(SettingsJson.ToSharedRef(), JsonWriter);
+	JNIEnv* env = SentryJavaEnv::Get();
+	auto settingsBuffer = NewScopedJavaObject(env, env->NewDirectByteBuffer(settingsData.GetData(), settingsData.Num()));
 
-	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "init", "(Landroid/app/Activity;Ljava/lang/String;)V",
-		FJavaWrapper::GameActivityThis, *FSentryJavaObjectWrapper::GetJString(SettingsJsonStr));
+	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "init", "(Landroid/app/Activity;Ljava/nio/ByteBuffer;)V",
+		FJavaWrapper::GameActivityThis, *settingsBuffer);
+
+	if (IsEnabled() && settings->AndroidBridgeBatchSize > 0)
+	{
+		InitBridgeBatch(settings->AndroidBridgeBatchSize);
+	}
 
 	if (IsEnabled() && isScreenshotAttachmentEnabled)
 	{
+		SentryScreenshotUtils::ReserveCrashBuffers();
+
+		if (settings->CacheLastFrameScreenshot)
+		{
+			SentryScreenshotUtils::StartLastFrameCache(settings->LastFrameScreenshotInterval);
+		}
+
 		OnHandleSystemErrorDelegateHandle = FCoreDelegates::OnHandleSystemError.AddLambda([this]()
 		{
 			TryCaptureScreenshot();
@@ -109,9 +145,27 @@ void FAndroidSentrySubsystem::Close()
 	{
 		FCoreDelegates::OnHandleSystemError.Remove(OnHandleSystemErrorDelegateHandle);
 		OnHandleSystemErrorDelegateHandle.Reset();
+
+		SentryScreenshotUtils::ReleaseCrashBuffers();
+		SentryScreenshotUtils::StopLastFrameCache();
+	}
+
+	if (bridgeBatch)
+	{
+		bridgeBatch->Flush();
+		bridgeBatch.Reset();
+	}
+
+	if (isAsyncScopedCaptureEnabled)
+	{
+		// Captures still queued on the Java side would be dropped once the SDK is closed
+		FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "flushAsyncCaptures", "(J)V", (jlong)2000);
 	}
 
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::Sentry, "close", "()V");
+
+	// Temporary files of byte attachments are deleted along with the last reference to them
+	spilledAttachments.Empty();
 }
 
 bool FAndroidSentrySubsystem::IsEnabled()
@@ -145,12 +199,26 @@ void FAndroidSentrySubsystem::AddBreadcrumb(TSharedPtr<ISentryBreadcrumb> breadc
 {
 	TSharedPtr<FAndroidSentryBreadcrumb> breadcrumbAndroid = StaticCastSharedPtr<FAndroidSentryBreadcrumb>(breadcrumb);
 
+	FlushBridgeBatch();
+
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::Sentry, "addBreadcrumb", "(Lio/sentry/Breadcrumb;)V",
 		breadcrumbAndroid->GetJObject());
 }
 
 void FAndroidSentrySubsystem::AddBreadcrumbWithParams(const FString& Message, const FString& Category, const FString& Type, const TMap<FString, FSentryVariant>& Data, ESentryLevel Level)
 {
+	TSharedPtr<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe> batch = bridgeBatch;
+	if (batch)
+	{
+		if (batch->AddBreadcrumb(Message, Category, Type, Data, Level))
+		{
+			return;
+		}
+
+		// Nested data can't be packed, keep breadcrumbs order by sending pending ones first
+		batch->Flush();
+	}
+
 	TSharedPtr<FAndroidSentryBreadcrumb> breadcrumbAndroid = MakeShareable(new FAndroidSentryBreadcrumb());
 	breadcrumbAndroid->SetMessage(Message);
 	breadcrumbAndroid->SetCategory(Category);
@@ -181,6 +249,13 @@ void FAndroidSentrySubsystem::AddLog(const FString& Body, ESentryLevel Level, co
 		FormattedMessage = Body;
 	}
 
+	TSharedPtr<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe> batch = bridgeBatch;
+	if (batch)
+	{
+		batch->AddLog(FormattedMessage, Level);
+		return;
+	}
+
 	// Use level-specific Android Sentry SDK logging functions via Java bridge
 	switch (Level)
 	{
@@ -210,6 +285,8 @@ void FAndroidSentrySubsystem::AddLog(const FString& Body, ESentryLevel Level, co
 
 void FAndroidSentrySubsystem::ClearBreadcrumbs()
 {
+	FlushBridgeBatch();
+
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::Sentry, "clearBreadcrumbs", "()V");
 }
 
@@ -219,6 +296,11 @@ void FAndroidSentrySubsystem::AddAttachment(TSharedPtr<ISentryAttachment> attach
 
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "addAttachment", "(Lio/sentry/Attachment;)V",
 		attachmentAndroid->GetJObject());
+
+	if (attachmentAndroid->IsSpilled())
+	{
+		spilledAttachments.AddUnique(attachmentAndroid);
+	}
 }
 
 void FAndroidSentrySubsystem::RemoveAttachment(TSharedPtr<ISentryAttachment> attachment)
@@ -227,15 +309,21 @@ void FAndroidSentrySubsystem::RemoveAttachment(TSharedPtr<ISentryAttachment> att
 
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "removeAttachment", "(Lio/sentry/Attachment;)V",
 		attachmentAndroid->GetJObject());
+
+	spilledAttachments.Remove(attachmentAndroid);
 }
 
 void FAndroidSentrySubsystem::ClearAttachments()
 {
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "clearAttachments", "()V");
+
+	spilledAttachments.Empty();
 }
 
 TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureMessage(const FString& message, ESentryLevel level)
 {
+	FlushBridgeBatch();
+
 	auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::Sentry, "captureMessage", "(Ljava/lang/String;Lio/sentry/SentryLevel;)Lio/sentry/protocol/SentryId;",
 		*FSentryJavaObjectWrapper::GetJString(message), FAndroidSentryConverters::SentryLevelToNative(level)->GetJObject());
 
@@ -244,6 +332,18 @@ TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureMessage(const FString& mes
 
 TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureMessageWithScope(const FString& message, ESentryLevel level, const FSentryScopeDelegate& onConfigureScope)
 {
+	FlushBridgeBatch();
+
+	if (isAsyncScopedCaptureEnabled)
+	{
+		TSharedPtr<FAndroidSentryScope> preparedScope = PrepareCaptureScope(onConfigureScope);
+
+		auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureMessageWithScopeAsync", "(Ljava/lang/String;Lio/sentry/SentryLevel;Lio/sentry/IScope;)Lio/sentry/protocol/SentryId;",
+			*FSentryJavaObjectWrapper::GetJString(message), FAndroidSentryConverters::SentryLevelToNative(level)->GetJObject(), preparedScope->GetJObject());
+
+		return MakeShareable(new FAndroidSentryId(*id));
+	}
+
 	int64 scopeCallbackId = AndroidSentryScopeCallback::SaveDelegate(onConfigureScope);
 
 	auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureMessageWithScope", "(Ljava/lang/String;Lio/sentry/SentryLevel;J)Lio/sentry/protocol/SentryId;",
@@ -254,6 +354,8 @@ TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureMessageWithScope(const FSt
 
 TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEvent(TSharedPtr<ISentryEvent> event)
 {
+	FlushBridgeBatch();
+
 	TSharedPtr<FAndroidSentryEvent> eventAndroid = StaticCastSharedPtr<FAndroidSentryEvent>(event);
 
 	auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::Sentry, "captureEvent", "(Lio/sentry/SentryEvent;)Lio/sentry/protocol/SentryId;",
@@ -264,8 +366,20 @@ TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEvent(TSharedPtr<ISentryEv
 
 TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEventWithScope(TSharedPtr<ISentryEvent> event, const FSentryScopeDelegate& onConfigureScope)
 {
+	FlushBridgeBatch();
+
 	TSharedPtr<FAndroidSentryEvent> eventAndroid = StaticCastSharedPtr<FAndroidSentryEvent>(event);
 
+	if (isAsyncScopedCaptureEnabled)
+	{
+		TSharedPtr<FAndroidSentryScope> preparedScope = PrepareCaptureScope(onConfigureScope);
+
+		auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureEventWithScopeAsync", "(Lio/sentry/SentryEvent;Lio/sentry/IScope;)Lio/sentry/protocol/SentryId;",
+			eventAndroid->GetJObject(), preparedScope->GetJObject());
+
+		return MakeShareable(new FAndroidSentryId(*id));
+	}
+
 	int64 scopeCallbackId = AndroidSentryScopeCallback::SaveDelegate(onConfigureScope);
 
 	auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureEventWithScope", "(Lio/sentry/SentryEvent;J)Lio/sentry/protocol/SentryId;",
@@ -274,8 +388,23 @@ TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEventWithScope(TSharedPtr<
 	return MakeShareable(new FAndroidSentryId(*id));
 }
 
-TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEnsure(const FString& type, const FString& message)
+TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters)
 {
+	FlushBridgeBatch();
+
+	// Frames are symbolicated on the server, same as for the other platforms
+	const FScopedJavaObject<jlongArray> nativeProgramCounters = FAndroidSentryConverters::CallstackToNative(programCounters);
+
+	// Game surface is copied and encoded in Java off the game thread, the event is sent once the screenshot is ready
+	if (isPixelCopyScreenshotEnabled)
+	{
+		auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureExceptionWithPixelCopy", "(Ljava/lang/String;Ljava/lang/String;ZII[J)Lio/sentry/protocol/SentryId;",
+			*FSentryJavaObjectWrapper::GetJString(type), *FSentryJavaObjectWrapper::GetJString(message),
+			(jboolean)isPixelCopyScreenshotJpeg, (jint)screenshotJpegQuality, (jint)screenshotMaxDimension, *nativeProgramCounters);
+
+		return MakeShareable(new FAndroidSentryId(*id));
+	}
+
 	TSharedPtr<FAndroidSentryAttachment> ScreenshotAttachment = nullptr;
 
 	if (isScreenshotAttachmentEnabled)
@@ -286,7 +415,7 @@ TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEnsure(const FString& type
 			TArray<uint8> ScreenshotData;
 			if (FFileHelper::LoadFileToArray(ScreenshotData, *ScreenshotPath))
 			{
-				ScreenshotAttachment = MakeShareable(new FAndroidSentryAttachment(ScreenshotData, TEXT("screenshot.png"), TEXT("image/png")));
+				ScreenshotAttachment = MakeShareable(new FAndroidSentryAttachment(ScreenshotData, TEXT("screenshot.") + SentryScreenshotUtils::GetScreenshotExtension(), SentryScreenshotUtils::GetScreenshotContentType()));
 			}
 
 			if (!IFileManager::Get().Delete(*ScreenshotPath))
@@ -296,9 +425,9 @@ TSharedPtr<ISentryId> FAndroidSentrySubsystem::CaptureEnsure(const FString& type
 		}
 	}
 
-	auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureException", "(Ljava/lang/String;Ljava/lang/String;Lio/sentry/Attachment;)Lio/sentry/protocol/SentryId;",
+	auto id = FSentryJavaObjectWrapper::CallStaticObjectMethod<jobject>(SentryJavaClasses::SentryBridgeJava, "captureException", "(Ljava/lang/String;Ljava/lang/String;Lio/sentry/Attachment;[J)Lio/sentry/protocol/SentryId;",
 		*FSentryJavaObjectWrapper::GetJString(type), *FSentryJavaObjectWrapper::GetJString(message),
-		ScreenshotAttachment.IsValid() ? ScreenshotAttachment->GetJObject() : nullptr);
+		ScreenshotAttachment.IsValid() ? ScreenshotAttachment->GetJObject() : nullptr, *nativeProgramCounters);
 
 	return MakeShareable(new FAndroidSentryId(*id));
 }
@@ -330,12 +459,24 @@ void FAndroidSentrySubsystem::SetContext(const FString& key, const TMap<FString,
 		*FSentryJavaObjectWrapper::GetJString(key), FAndroidSentryConverters::VariantMapToNative(values)->GetJObject());
 }
 
+void FAndroidSentrySubsystem::SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData)
+{
+	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "setContext", "(Ljava/lang/String;Ljava/util/HashMap;)V",
+		*FSentryJavaObjectWrapper::GetJString(key), FAndroidSentryConverters::StructToNative(*FSentryStructLayout::Get(structType), structData)->GetJObject());
+}
+
 void FAndroidSentrySubsystem::SetTag(const FString& key, const FString& value)
 {
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "setTag", "(Ljava/lang/String;Ljava/lang/String;)V",
 		*FSentryJavaObjectWrapper::GetJString(key), *FSentryJavaObjectWrapper::GetJString(value));
 }
 
+void FAndroidSentrySubsystem::SetTags(const TMap<FString, FString>& tags)
+{
+	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "setTags", "(Ljava/util/HashMap;)V",
+		FAndroidSentryConverters::StringMapToNative(tags)->GetJObject());
+}
+
 void FAndroidSentrySubsystem::RemoveTag(const FString& key)
 {
 	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "removeTag", "(Ljava/lang/String;)V",
@@ -430,18 +571,148 @@ TSharedPtr<ISentryTransactionContext> FAndroidSentrySubsystem::ContinueTrace(con
 
 void FAndroidSentrySubsystem::HandleAssert()
 {
+	FlushBridgeBatch();
+
 	GError->HandleError();
 	PLATFORM_BREAK();
 }
 
+bool FAndroidSentrySubsystem::CaptureEnvelope(const TArray<uint8>& envelope)
+{
+	return FSentryJavaObjectWrapper::CallStaticMethod<bool>(SentryJavaClasses::SentryBridgeJava, "captureEnvelope", "([B)Z",
+		FAndroidSentryConverters::ByteArrayToNative(envelope));
+}
+
+bool FAndroidSentrySubsystem::GetDeviceConditions(FSentryDeviceConditions& outConditions)
+{
+	// Values match the PowerManager.THERMAL_STATUS_* constants, -1 if the API level doesn't support thermal status
+	switch (FSentryJavaObjectWrapper::CallStaticMethod<int>(SentryJavaClasses::SentryBridgeJava, "getThermalStatus", "()I"))
+	{
+	case 0:
+		outConditions.ThermalState = ESentryThermalState::Nominal;
+		break;
+	case 1:
+	case 2:
+		outConditions.ThermalState = ESentryThermalState::Fair;
+		break;
+	case 3:
+		outConditions.ThermalState = ESentryThermalState::Serious;
+		break;
+	case 4:
+	case 5:
+	case 6:
+		outConditions.ThermalState = ESentryThermalState::Critical;
+		break;
+	default:
+		outConditions.ThermalState = ESentryThermalState::Unknown;
+	}
+
+	outConditions.BatteryLevel = FSentryJavaObjectWrapper::CallStaticMethod<int>(SentryJavaClasses::SentryBridgeJava, "getBatteryLevel", "()I");
+	outConditions.bIsCharging = FSentryJavaObjectWrapper::CallStaticMethod<bool>(SentryJavaClasses::SentryBridgeJava, "isCharging", "()Z");
+
+	// Clocks aren't exposed through the Android SDK, sysfs is readable on most devices though and reports kHz for CPUs
+	for (int32 core = 0; core < FPlatformMisc::NumberOfCoresIncludingHyperthreads(); ++core)
+	{
+		const int32 curFrequency = ReadSysfsValue(*FString::Printf(TEXT("/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq"), core));
+		if (curFrequency > 0)
+		{
+			outConditions.CpuFrequencyMHz = FMath::Max(outConditions.CpuFrequencyMHz, curFrequency / 1000);
+		}
+
+		const int32 maxFrequency = ReadSysfsValue(*FString::Printf(TEXT("/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq"), core));
+		if (maxFrequency > 0)
+		{
+			outConditions.CpuMaxFrequencyMHz = FMath::Max(outConditions.CpuMaxFrequencyMHz, maxFrequency / 1000);
+		}
+	}
+
+	// Adreno GPUs report Hz, other vendors don't expose the clock
+	const int32 gpuFrequency = ReadSysfsValue(TEXT("/sys/class/kgsl/kgsl-3d0/gpuclk"));
+	if (gpuFrequency > 0)
+	{
+		outConditions.GpuFrequencyMHz = gpuFrequency / 1000000;
+	}
+
+	return true;
+}
+
+int32 FAndroidSentrySubsystem::ReadSysfsValue(const TCHAR* path)
+{
+	FILE* file = fopen(TCHAR_TO_UTF8(path), "r");
+	if (!file)
+	{
+		return -1;
+	}
+
+	long value = -1;
+	if (fscanf(file, "%ld", &value) != 1)
+	{
+		value = -1;
+	}
+
+	fclose(file);
+
+	return value > 0 && value <= MAX_int32 ? static_cast<int32>(value) : -1;
+}
+
 FString FAndroidSentrySubsystem::TryCaptureScreenshot() const
 {
 	FString ScreenshotPath = SentryFileUtils::GetScreenshotPath();
 
-	if (!SentryScreenshotUtils::CaptureScreenshot(ScreenshotPath))
+	// Cached frame doesn't need the GPU or Slate which might be unusable if the render thread crashed
+	const bool bCaptured = SentryScreenshotUtils::IsLastFrameCacheActive()
+		? SentryScreenshotUtils::SaveLastFrame(ScreenshotPath)
+		: SentryScreenshotUtils::CaptureScreenshot(ScreenshotPath);
+
+	if (!bCaptured)
 	{
 		return FString("");
 	}
 
 	return ScreenshotPath;
 }
+
+void FAndroidSentrySubsystem::InitBridgeBatch(int32 maxEntries)
+{
+	bridgeBatch = MakeShared<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe>(maxEntries);
+
+	TWeakPtr<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe> weakBatch(bridgeBatch);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([weakBatch](float DeltaTime)
+	{
+		TSharedPtr<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe> batch = weakBatch.Pin();
+		if (!batch)
+		{
+			return false;
+		}
+
+		if (batch->HasPendingEntries())
+		{
+			batch->Flush();
+		}
+
+		return true;
+	}));
+}
+
+TSharedPtr<FAndroidSentryScope> FAndroidSentrySubsystem::PrepareCaptureScope(const FSentryScopeDelegate& onConfigureScope)
+{
+	// Scope is configured right away on the calling thread and merged into the event scope by the Java capture worker
+	TSharedPtr<FAndroidSentryScope> preparedScope = MakeShareable(new FAndroidSentryScope());
+	onConfigureScope.ExecuteIfBound(preparedScope);
+	return preparedScope;
+}
+
+void FAndroidSentrySubsystem::FlushBridgeBatch()
+{
+	TSharedPtr<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe> batch = bridgeBatch;
+	if (batch)
+	{
+		batch->Flush();
+	}
+}
@@ -4,6 +4,10 @@
 
 #include "Interface/SentrySubsystemInterface.h"
 
+class FAndroidSentryAttachment;
+class FAndroidSentryBridgeBatch;
+class FAndroidSentryScope;
+
 class FAndroidSentrySubsystem : public ISentrySubsystem
 {
 public:
@@ -25,12 +29,14 @@ public:
 	virtual TSharedPtr<ISentryId> CaptureMessageWithScope(const FString& message, ESentryLevel level, const FSentryScopeDelegate& onConfigureScope) override;
 	virtual TSharedPtr<ISentryId> CaptureEvent(TSharedPtr<ISentryEvent> event) override;
 	virtual TSharedPtr<ISentryId> CaptureEventWithScope(TSharedPtr<ISentryEvent> event, const FSentryScopeDelegate& onConfigureScope) override;
-	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message) override;
+	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters) override;
 	virtual void CaptureFeedback(TSharedPtr<ISentryFeedback> feedback) override;
 	virtual void SetUser(TSharedPtr<ISentryUser> user) override;
 	virtual void RemoveUser() override;
 	virtual void SetContext(const FString& key, const TMap<FString, FSentryVariant>& values) override;
+	virtual void SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData) override;
 	virtual void SetTag(const FString& key, const FString& value) override;
+	virtual void SetTags(const TMap<FString, FString>& tags) override;
 	virtual void RemoveTag(const FString& key) override;
 	virtual void SetLevel(ESentryLevel level) override;
 	virtual void StartSession() override;
@@ -45,11 +51,35 @@ public:
 	virtual TSharedPtr<ISentryTransactionContext> ContinueTrace(const FString& sentryTrace, const TArray<FString>& baggageHeaders) override;
 
 	virtual void HandleAssert() override;
+	virtual TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> GetLogRing() const override { return nullptr; }
+	virtual bool GetDeviceConditions(FSentryDeviceConditions& outConditions) override;
+	virtual bool CaptureEnvelope(const TArray<uint8>& envelope) override;
 
 	FString TryCaptureScreenshot() const;
 
 private:
+	void InitBridgeBatch(int32 maxEntries);
+	void FlushBridgeBatch();
+
+	TSharedPtr<FAndroidSentryScope> PrepareCaptureScope(const FSentryScopeDelegate& onConfigureScope);
+
+	/** Reads a single integer from a sysfs node, -1 if the node is missing or not readable. */
+	static int32 ReadSysfsValue(const TCHAR* path);
+
 	bool isScreenshotAttachmentEnabled = false;
+	bool isAsyncScopedCaptureEnabled = false;
+
+	/** Whether ensure screenshots are taken by PixelCopy in Java, along with the encoding they are written with. */
+	bool isPixelCopyScreenshotEnabled = false;
+	bool isPixelCopyScreenshotJpeg = false;
+	int32 screenshotJpegQuality = 0;
+	int32 screenshotMaxDimension = 0;
+
+	/** Breadcrumbs and logs waiting to be sent to Java in one call, null if batching is disabled. */
+	TSharedPtr<FAndroidSentryBridgeBatch, ESPMode::ThreadSafe> bridgeBatch;
+
+	/** Attachments added to the scope whose temporary files have to outlive them being referenced by the Java scope. */
+	TArray<TSharedPtr<FAndroidSentryAttachment>> spilledAttachments;
 
 	FDelegateHandle OnHandleSystemErrorDelegateHandle;
 };
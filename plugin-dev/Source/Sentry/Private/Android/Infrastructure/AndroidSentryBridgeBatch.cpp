@@ -0,0 +1,149 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "AndroidSentryBridgeBatch.h"
+
+#include "AndroidSentryJavaClasses.h"
+#include "AndroidSentryJavaEnv.h"
+#include "AndroidSentryJavaObjectWrapper.h"
+
+#include "SentryDefines.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace SentryBridgeBatchFormat
+{
+	// Must be kept in sync with SentryBridgeJava.addBatch
+	static constexpr uint8 EntryLog = 0;
+	static constexpr uint8 EntryBreadcrumb = 1;
+
+	static constexpr uint8 ValueString = 0;
+	static constexpr uint8 ValueInteger = 1;
+	static constexpr uint8 ValueFloat = 2;
+	static constexpr uint8 ValueBool = 3;
+}
+
+FAndroidSentryBridgeBatch::FAndroidSentryBridgeBatch(int32 InMaxEntries)
+	: NumEntries(0)
+	, MaxEntries(FMath::Max(1, InMaxEntries))
+{
+}
+
+void FAndroidSentryBridgeBatch::AddLog(const FString& Message, ESentryLevel Level)
+{
+	bool bIsFull = false;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		Buffer.WriteByte(SentryBridgeBatchFormat::EntryLog);
+		Buffer.WriteByte(static_cast<uint8>(Level));
+		Buffer.WriteString(Message);
+
+		bIsFull = ++NumEntries >= MaxEntries;
+	}
+
+	if (bIsFull)
+	{
+		Flush();
+	}
+}
+
+bool FAndroidSentryBridgeBatch::AddBreadcrumb(const FString& Message, const FString& Category, const FString& Type, const TMap<FString, FSentryVariant>& Data, ESentryLevel Level)
+{
+	for (const auto& DataItem : Data)
+	{
+		const ESentryVariantType ValueType = DataItem.Value.GetType();
+		if (ValueType == ESentryVariantType::Array || ValueType == ESentryVariantType::Map)
+		{
+			return false;
+		}
+	}
+
+	bool bIsFull = false;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		Buffer.WriteByte(SentryBridgeBatchFormat::EntryBreadcrumb);
+		Buffer.WriteByte(static_cast<uint8>(Level));
+		Buffer.WriteString(Message);
+		Buffer.WriteString(Category);
+		Buffer.WriteString(Type);
+		Buffer.WriteInt32(Data.Num());
+
+		for (const auto& DataItem : Data)
+		{
+			Buffer.WriteString(DataItem.Key);
+
+			switch (DataItem.Value.GetType())
+			{
+			case ESentryVariantType::Integer:
+				Buffer.WriteByte(SentryBridgeBatchFormat::ValueInteger);
+				Buffer.WriteInt32(DataItem.Value.GetValue<int32>());
+				break;
+			case ESentryVariantType::Float:
+				Buffer.WriteByte(SentryBridgeBatchFormat::ValueFloat);
+				Buffer.WriteFloat(DataItem.Value.GetValue<float>());
+				break;
+			case ESentryVariantType::Bool:
+				Buffer.WriteByte(SentryBridgeBatchFormat::ValueBool);
+				Buffer.WriteBool(DataItem.Value.GetValue<bool>());
+				break;
+			default:
+				Buffer.WriteByte(SentryBridgeBatchFormat::ValueString);
+				Buffer.WriteString(DataItem.Value.GetStringRef());
+				break;
+			}
+		}
+
+		bIsFull = ++NumEntries >= MaxEntries;
+	}
+
+	if (bIsFull)
+	{
+		Flush();
+	}
+
+	return true;
+}
+
+void FAndroidSentryBridgeBatch::Flush()
+{
+	FScopeLock FlushLock(&FlushCriticalSection);
+
+	TArray<uint8> PendingBuffer;
+	int32 NumPendingEntries = 0;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		PendingBuffer = Buffer.Release();
+		NumPendingEntries = NumEntries;
+
+		NumEntries = 0;
+	}
+
+	if (NumPendingEntries == 0)
+	{
+		return;
+	}
+
+	JNIEnv* JEnv = SentryJavaEnv::Get();
+
+	// Java side decodes all entries before returning so the buffer can wrap native memory without copying it
+	auto ByteBuffer = NewScopedJavaObject(JEnv, JEnv->NewDirectByteBuffer(PendingBuffer.GetData(), PendingBuffer.Num()));
+	if (!ByteBuffer)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to allocate direct byte buffer; %d batched breadcrumbs and logs were dropped."), NumPendingEntries);
+		return;
+	}
+
+	FSentryJavaObjectWrapper::CallStaticMethod<void>(SentryJavaClasses::SentryBridgeJava, "addBatch", "(Ljava/nio/ByteBuffer;I)V",
+		*ByteBuffer, NumPendingEntries);
+}
+
+bool FAndroidSentryBridgeBatch::HasPendingEntries() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return NumEntries > 0;
+}
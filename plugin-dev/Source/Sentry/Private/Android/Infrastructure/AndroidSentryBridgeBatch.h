@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HAL/CriticalSection.h"
+
+#include "AndroidSentryPackedBuffer.h"
+
+#include "SentryDataTypes.h"
+#include "SentryVariant.h"
+
+/**
+ * Accumulates breadcrumbs and structured logs on the native side and hands them over to
+ * SentryBridgeJava in a single JNI call as a packed direct byte buffer.
+ *
+ * Entries are flushed once per frame, when the batch reaches its size limit and before anything that relies on
+ * previously added entries (captures, clearing breadcrumbs, closing the SDK).
+ */
+class FAndroidSentryBridgeBatch
+{
+public:
+	explicit FAndroidSentryBridgeBatch(int32 InMaxEntries);
+
+	void AddLog(const FString& Message, ESentryLevel Level);
+
+	/**
+	 * Adds breadcrumb to the batch.
+	 *
+	 * @return False if breadcrumb data contains nested arrays or maps that can't be packed, in which case
+	 * it should be added directly after flushing the batch.
+	 */
+	bool AddBreadcrumb(const FString& Message, const FString& Category, const FString& Type, const TMap<FString, FSentryVariant>& Data, ESentryLevel Level);
+
+	/** Sends all pending entries to Java. Can be called from any thread. */
+	void Flush();
+
+	bool HasPendingEntries() const;
+
+private:
+	mutable FCriticalSection CriticalSection;
+
+	/** Held for the whole JNI call so that batches flushed from different threads can't be reordered. */
+	FCriticalSection FlushCriticalSection;
+
+	FAndroidSentryPackedBuffer Buffer;
+	int32 NumEntries;
+	int32 MaxEntries;
+};
@@ -2,20 +2,94 @@
 
 #include "AndroidSentryConverters.h"
 #include "AndroidSentryJavaClasses.h"
+#include "AndroidSentryJavaEnv.h"
 #include "AndroidSentryJavaObjectWrapper.h"
 
 #include "SentryDefines.h"
 
+#include "Utils/SentryStructLayout.h"
+#include "Utils/SentryTrace.h"
+
 #include "Android/AndroidApplication.h"
-#include "Android/AndroidJavaEnv.h"
 
-#include "Dom/JsonValue.h"
+namespace SentryAndroidConvertersStruct
+{
+	/** Writes struct fields into hash maps, nested structs become nested maps. */
+	class FStructWriter
+	{
+	public:
+		FStructWriter()
+		{
+			BeginStruct();
+			PutMethod = Maps.Last()->GetMethod("put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+		}
+
+		void WriteBool(const FSentryStructLayout::FField& Field, bool Value)
+		{
+			FSentryScopedJavaLocalFrame ElemFrame;
+			Put(Field, FSentryJavaObjectWrapper(SentryJavaClasses::Boolean, "(Z)V", Value).GetJObject());
+		}
+
+		void WriteInteger(const FSentryStructLayout::FField& Field, int32 Value)
+		{
+			FSentryScopedJavaLocalFrame ElemFrame;
+			Put(Field, FSentryJavaObjectWrapper(SentryJavaClasses::Integer, "(I)V", Value).GetJObject());
+		}
+
+		void WriteFloat(const FSentryStructLayout::FField& Field, double Value)
+		{
+			FSentryScopedJavaLocalFrame ElemFrame;
+			Put(Field, FSentryJavaObjectWrapper(SentryJavaClasses::Float, "(F)V", static_cast<float>(Value)).GetJObject());
+		}
+
+		void WriteString(const FSentryStructLayout::FField& Field, const FString& Value)
+		{
+			FSentryScopedJavaLocalFrame ElemFrame;
+			Put(Field, *FSentryJavaObjectWrapper::GetJString(Value));
+		}
+
+		void BeginStruct(const FSentryStructLayout::FField& Field)
+		{
+			BeginStruct();
+		}
+
+		void EndStruct(const FSentryStructLayout::FField& Field)
+		{
+			TSharedPtr<FSentryJavaObjectWrapper> Nested = Maps.Pop();
+
+			FSentryScopedJavaLocalFrame ElemFrame;
+			Put(Field, Nested->GetJObject());
+		}
+
+		TSharedPtr<FSentryJavaObjectWrapper> Finish()
+		{
+			return Maps.Pop();
+		}
+
+	private:
+		void BeginStruct()
+		{
+			Maps.Add(MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::HashMap, "()V")));
+		}
+
+		void Put(const FSentryStructLayout::FField& Field, jobject Value)
+		{
+			Maps.Last()->CallObjectMethod<jobject>(PutMethod, *FSentryJavaObjectWrapper::GetJString(Field.Name), Value);
+		}
+
+		TArray<TSharedPtr<FSentryJavaObjectWrapper>, TInlineAllocator<4>> Maps;
+		FSentryJavaMethod PutMethod;
+	};
+}
 
 TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::SentryLevelToNative(ESentryLevel level)
 {
 	TSharedPtr<FSentryJavaObjectWrapper> nativeLevel = nullptr;
 
-	JNIEnv* Env = AndroidJavaEnv::GetJavaEnv();
+	// Releases the local reference to the enum value once it's wrapped into a global one
+	FSentryScopedJavaLocalFrame LocalFrame;
+
+	JNIEnv* Env = SentryJavaEnv::Get();
 
 	jclass levelEnumClass = SentryJavaClasses::GetCachedJavaClassRef(SentryJavaClasses::SentryLevel);
 
@@ -51,6 +125,8 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::SentryLevelToNati
 
 TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::StringArrayToNative(const TArray<FString>& stringArray)
 {
+	SENTRY_TRACE_SCOPE(StringArrayToNative);
+
 	TSharedPtr<FSentryJavaObjectWrapper> NativeArrayList = MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::ArrayList, "()V"));
 	FSentryJavaMethod AddMethod = NativeArrayList->GetMethod("add", "(Ljava/lang/Object;)Z");
 
@@ -64,6 +140,8 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::StringArrayToNati
 
 TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::StringMapToNative(const TMap<FString, FString>& stringMap)
 {
+	SENTRY_TRACE_SCOPE(StringMapToNative);
+
 	TSharedPtr<FSentryJavaObjectWrapper> NativeHashMap = MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::HashMap, "()V"));
 	FSentryJavaMethod PutMethod = NativeHashMap->GetMethod("put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
 
@@ -86,11 +164,11 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::VariantToNative(c
 	case ESentryVariantType::Bool:
 		return MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::Boolean, "(Z)V", variant.GetValue<bool>()));
 	case ESentryVariantType::String:
-		return MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::String, "(Ljava/lang/String;)V", *FSentryJavaObjectWrapper::GetJString(variant.GetValue<FString>())));
+		return MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::String, "(Ljava/lang/String;)V", *FSentryJavaObjectWrapper::GetJString(variant.GetStringRef())));
 	case ESentryVariantType::Array:
-		return VariantArrayToNative(variant.GetValue<TArray<FSentryVariant>>());
+		return VariantArrayToNative(variant.GetArrayRef());
 	case ESentryVariantType::Map:
-		return VariantMapToNative(variant.GetValue<TMap<FString, FSentryVariant>>());
+		return VariantMapToNative(variant.GetMapRef());
 	default:
 		return nullptr;
 	}
@@ -98,11 +176,15 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::VariantToNative(c
 
 TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::VariantArrayToNative(const TArray<FSentryVariant>& variantArray)
 {
+	SENTRY_TRACE_SCOPE(VariantArrayToNative);
+
 	TSharedPtr<FSentryJavaObjectWrapper> NativeArrayList = MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::ArrayList, "()V"));
 	FSentryJavaMethod AddMethod = NativeArrayList->GetMethod("add", "(Ljava/lang/Object;)Z");
 
 	for (const FSentryVariant& Elem : variantArray)
 	{
+		FSentryScopedJavaLocalFrame ElemFrame;
+
 		TSharedPtr<FSentryJavaObjectWrapper> NativeVariant = VariantToNative(Elem);
 		if (NativeVariant.IsValid())
 		{
@@ -115,11 +197,15 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::VariantArrayToNat
 
 TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::VariantMapToNative(const TMap<FString, FSentryVariant>& variantMap)
 {
+	SENTRY_TRACE_SCOPE(VariantMapToNative);
+
 	TSharedPtr<FSentryJavaObjectWrapper> NativeHashMap = MakeShareable(new FSentryJavaObjectWrapper(SentryJavaClasses::HashMap, "()V"));
 	FSentryJavaMethod PutMethod = NativeHashMap->GetMethod("put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
 
 	for (const auto& dataPair : variantMap)
 	{
+		FSentryScopedJavaLocalFrame ElemFrame;
+
 		TSharedPtr<FSentryJavaObjectWrapper> NativeVariant = VariantToNative(dataPair.Value);
 		if (NativeVariant.IsValid())
 		{
@@ -130,24 +216,35 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::VariantMapToNativ
 	return NativeHashMap;
 }
 
+TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::StructToNative(const FSentryStructLayout& layout, const void* structData)
+{
+	SENTRY_TRACE_SCOPE(StructToNative);
+
+	SentryAndroidConvertersStruct::FStructWriter Writer;
+	layout.Write(structData, Writer);
+	return Writer.Finish();
+}
+
 jbyteArray FAndroidSentryConverters::ByteArrayToNative(const TArray<uint8>& byteArray)
 {
-	JNIEnv* Env = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* Env = SentryJavaEnv::Get();
 
 	jbyteArray javaByteArray = (jbyteArray)Env->NewByteArray(byteArray.Num());
 
-	jbyte* javaByteArrayPtr = (jbyte*)malloc(byteArray.Num() * sizeof(jbyte));
+	Env->SetByteArrayRegion(javaByteArray, 0, byteArray.Num(), reinterpret_cast<const jbyte*>(byteArray.GetData()));
 
-	for (int i = 0; i < byteArray.Num(); i++)
-	{
-		javaByteArrayPtr[i] = byteArray[i];
-	}
+	return javaByteArray;
+}
 
-	Env->SetByteArrayRegion(javaByteArray, 0, byteArray.Num(), javaByteArrayPtr);
+FScopedJavaObject<jlongArray> FAndroidSentryConverters::CallstackToNative(const TArray<uint64>& programCounters)
+{
+	JNIEnv* Env = SentryJavaEnv::Get();
 
-	free(javaByteArrayPtr);
+	jlongArray javaLongArray = Env->NewLongArray(programCounters.Num());
 
-	return javaByteArray;
+	Env->SetLongArrayRegion(javaLongArray, 0, programCounters.Num(), reinterpret_cast<const jlong*>(programCounters.GetData()));
+
+	return NewScopedJavaObject(Env, javaLongArray);
 }
 
 ESentryLevel FAndroidSentryConverters::SentryLevelToUnreal(jobject level)
@@ -187,7 +284,10 @@ TSharedPtr<FSentryJavaObjectWrapper> FAndroidSentryConverters::SentryLogLevelToN
 {
 	TSharedPtr<FSentryJavaObjectWrapper> nativeLevel = nullptr;
 
-	JNIEnv* Env = AndroidJavaEnv::GetJavaEnv();
+	// Releases the local reference to the enum value once it's wrapped into a global one
+	FSentryScopedJavaLocalFrame LocalFrame;
+
+	JNIEnv* Env = SentryJavaEnv::Get();
 
 	jclass levelEnumClass = SentryJavaClasses::GetCachedJavaClassRef(SentryJavaClasses::SentryLogLevel);
 
@@ -271,6 +371,8 @@ TMap<FString, FString> FAndroidSentryConverters::StringMapToUnreal(jobject map)
 
 	while (NativeIterator.CallMethod<bool>(HasNextMethod))
 	{
+		FSentryScopedJavaLocalFrame EntryFrame;
+
 		FSentryJavaObjectWrapper NativeMapEntry(SentryJavaClasses::MapEntry, *NativeIterator.CallObjectMethod<jobject>(NextMethod));
 		FSentryJavaMethod GetKeyMethod = NativeMapEntry.GetMethod("getKey", "()Ljava/lang/Object;");
 		FSentryJavaMethod GetValueMethod = NativeMapEntry.GetMethod("getValue", "()Ljava/lang/Object;");
@@ -296,7 +398,7 @@ TArray<FString> FAndroidSentryConverters::StringListToUnreal(jobject stringList)
 
 	int length = NativeList.CallMethod<int>(SizeMethod);
 
-	JNIEnv* Env = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* Env = SentryJavaEnv::Get();
 
 	for (int i = 0; i < length; i++)
 	{
@@ -315,16 +417,12 @@ TArray<uint8> FAndroidSentryConverters::ByteArrayToUnreal(jbyteArray byteArray)
 		return result;
 	}
 
-	JNIEnv* Env = AndroidJavaEnv::GetJavaEnv();
-
-	jbyte* javaByte = Env->GetByteArrayElements(byteArray, 0);
+	JNIEnv* Env = SentryJavaEnv::Get();
 
 	int length = Env->GetArrayLength(byteArray);
 
-	for (int i = 0; i < length; i++)
-	{
-		result.Add(javaByte[i]);
-	}
+	result.SetNumUninitialized(length);
+	Env->GetByteArrayRegion(byteArray, 0, length, reinterpret_cast<jbyte*>(result.GetData()));
 
 	return result;
 }
@@ -380,11 +478,15 @@ TArray<FSentryVariant> FAndroidSentryConverters::VariantArrayToUnreal(jobject va
 
 	int length = NativeList.CallMethod<int>(SizeMethod);
 
-	JNIEnv* Env = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* Env = SentryJavaEnv::Get();
+
+	result.Reserve(length);
 
 	for (int i = 0; i < length; i++)
 	{
-		result.Add(FSentryVariant(VariantToUnreal(Env->GetObjectArrayElement(*objectArray, i))));
+		FSentryScopedJavaLocalFrame ElemFrame;
+
+		result.Add(VariantToUnreal(Env->GetObjectArrayElement(*objectArray, i)));
 	}
 
 	return result;
@@ -406,6 +508,8 @@ TMap<FString, FSentryVariant> FAndroidSentryConverters::VariantMapToUnreal(jobje
 
 	while (NativeIterator.CallMethod<bool>(HasNextMethod))
 	{
+		FSentryScopedJavaLocalFrame EntryFrame;
+
 		FSentryJavaObjectWrapper NativeMapEntry(SentryJavaClasses::MapEntry, *NativeIterator.CallObjectMethod<jobject>(NextMethod));
 		FSentryJavaMethod GetKeyMethod = NativeMapEntry.GetMethod("getKey", "()Ljava/lang/Object;");
 		FSentryJavaMethod GetValueMethod = NativeMapEntry.GetMethod("getValue", "()Ljava/lang/Object;");
@@ -418,15 +522,3 @@ TMap<FString, FSentryVariant> FAndroidSentryConverters::VariantMapToUnreal(jobje
 
 	return result;
 }
-
-TArray<TSharedPtr<FJsonValue>> FAndroidSentryConverters::StrinArrayToJsonArray(const TArray<FString>& stringArray)
-{
-	TArray<TSharedPtr<FJsonValue>> jsonArray;
-
-	for (const FString& stringItem : stringArray)
-	{
-		jsonArray.Add(MakeShareable(new FJsonValueString(stringItem)));
-	}
-
-	return jsonArray;
-}
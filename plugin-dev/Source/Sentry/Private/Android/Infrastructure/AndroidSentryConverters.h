@@ -5,10 +5,11 @@
 #include "SentryDataTypes.h"
 #include "SentryVariant.h"
 
+#include "Android/AndroidJavaEnv.h"
 #include "Android/AndroidJNI.h"
 
 class FSentryJavaObjectWrapper;
-class FJsonValue;
+class FSentryStructLayout;
 
 class FAndroidSentryConverters
 {
@@ -21,7 +22,9 @@ public:
 	static TSharedPtr<FSentryJavaObjectWrapper> VariantToNative(const FSentryVariant& variant);
 	static TSharedPtr<FSentryJavaObjectWrapper> VariantArrayToNative(const TArray<FSentryVariant>& variantArray);
 	static TSharedPtr<FSentryJavaObjectWrapper> VariantMapToNative(const TMap<FString, FSentryVariant>& variantMap);
+	static TSharedPtr<FSentryJavaObjectWrapper> StructToNative(const FSentryStructLayout& layout, const void* structData);
 	static jbyteArray ByteArrayToNative(const TArray<uint8>& byteArray);
+	static FScopedJavaObject<jlongArray> CallstackToNative(const TArray<uint64>& programCounters);
 
 	/** Conversions from native Java types */
 	static ESentryLevel SentryLevelToUnreal(jobject level);
@@ -32,7 +35,4 @@ public:
 	static FSentryVariant VariantToUnreal(jobject variant);
 	static TArray<FSentryVariant> VariantArrayToUnreal(jobject variantArray);
 	static TMap<FString, FSentryVariant> VariantMapToUnreal(jobject variantMap);
-
-	/** Other conversions */
-	static TArray<TSharedPtr<FJsonValue>> StrinArrayToJsonArray(const TArray<FString>& stringArray);
 };
@@ -1,8 +1,10 @@
 // Copyright (c) 2025 Sentry. All Rights Reserved.
 
 #include "AndroidSentryJavaClasses.h"
+#include "AndroidSentryJavaEnv.h"
 
 #include "Android/AndroidJavaEnv.h"
+#include "Misc/ScopeRWLock.h"
 
 // clang-format off
 
@@ -48,6 +50,9 @@ const FSentryJavaClass SentryJavaClasses::String				= FSentryJavaClass { "java/l
 
 TMap<FName, jclass> SentryJavaClasses::JavaClassRefsCache;
 
+TMap<SentryJavaClasses::FJavaMethodKey, jmethodID> SentryJavaClasses::JavaMethodIdsCache;
+FRWLock SentryJavaClasses::JavaMethodIdsCacheLock;
+
 void SentryJavaClasses::InitJavaClassRefsCache()
 {
 	// External Java classes definitions
@@ -91,7 +96,13 @@ void SentryJavaClasses::InitJavaClassRefsCache()
 
 void SentryJavaClasses::ClearJavaClassRefsCache()
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
+
+	{
+		// Method IDs become invalid once their classes can be unloaded
+		FWriteScopeLock WriteLock(JavaMethodIdsCacheLock);
+		JavaMethodIdsCache.Empty();
+	}
 
 	for (auto& CachedItem : JavaClassRefsCache)
 	{
@@ -114,7 +125,7 @@ jclass SentryJavaClasses::GetCachedJavaClassRef(const FSentryJavaClass& ClassDat
 
 jclass SentryJavaClasses::FindJavaClassRef(const FSentryJavaClass& ClassData)
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	ANSICHAR AnsiClassName[NAME_SIZE];
 	ClassData.Name.GetPlainANSIString(AnsiClassName);
@@ -128,3 +139,36 @@ jclass SentryJavaClasses::FindJavaClassRef(const FSentryJavaClass& ClassData)
 	checkf(Class, TEXT("Failed to obtain Java class reference for %s"), *ClassData.Name.ToString());
 	return Class;
 }
+
+jmethodID SentryJavaClasses::GetCachedJavaMethodId(jclass Class, FName MethodName, FName Signature, bool IsStatic)
+{
+	const FJavaMethodKey Key { Class, MethodName, Signature, IsStatic };
+
+	{
+		FReadScopeLock ReadLock(JavaMethodIdsCacheLock);
+		if (const jmethodID* CachedMethod = JavaMethodIdsCache.Find(Key))
+		{
+			return *CachedMethod;
+		}
+	}
+
+	JNIEnv* JEnv = SentryJavaEnv::Get();
+
+	ANSICHAR AnsiMethodName[NAME_SIZE];
+	MethodName.GetPlainANSIString(AnsiMethodName);
+
+	ANSICHAR AnsiSignature[NAME_SIZE];
+	Signature.GetPlainANSIString(AnsiSignature);
+
+	jmethodID Method = IsStatic
+		? JEnv->GetStaticMethodID(Class, AnsiMethodName, AnsiSignature)
+		: JEnv->GetMethodID(Class, AnsiMethodName, AnsiSignature);
+
+	if (Method)
+	{
+		FWriteScopeLock WriteLock(JavaMethodIdsCacheLock);
+		JavaMethodIdsCache.Add(Key, Method);
+	}
+
+	return Method;
+}
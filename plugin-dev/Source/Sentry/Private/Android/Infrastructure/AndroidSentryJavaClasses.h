@@ -4,6 +4,8 @@
 
 #include "AndroidSentryDataTypes.h"
 
+#include "HAL/CriticalSection.h"
+
 struct SentryJavaClasses
 {
 	// External Java classes
@@ -51,6 +53,31 @@ struct SentryJavaClasses
 	static jclass GetCachedJavaClassRef(const FSentryJavaClass& ClassData);
 	static jclass FindJavaClassRef(const FSentryJavaClass& ClassData);
 
+	// Java method IDs cache, populated on first lookup and cleared together with class references
+	static jmethodID GetCachedJavaMethodId(jclass Class, FName MethodName, FName Signature, bool IsStatic);
+
 private:
+	struct FJavaMethodKey
+	{
+		jclass Class;
+		FName Name;
+		FName Signature;
+		bool IsStatic;
+
+		bool operator==(const FJavaMethodKey& Other) const
+		{
+			return Class == Other.Class && Name == Other.Name && Signature == Other.Signature && IsStatic == Other.IsStatic;
+		}
+
+		friend uint32 GetTypeHash(const FJavaMethodKey& Key)
+		{
+			uint32 Hash = HashCombine(PointerHash(Key.Class), GetTypeHash(Key.Name));
+			return HashCombine(HashCombine(Hash, GetTypeHash(Key.Signature)), Key.IsStatic ? 1u : 0u);
+		}
+	};
+
 	static TMap<FName, jclass> JavaClassRefsCache;
+
+	static TMap<FJavaMethodKey, jmethodID> JavaMethodIdsCache;
+	static FRWLock JavaMethodIdsCacheLock;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "AndroidSentryJavaEnv.h"
+
+#include "Android/AndroidJavaEnv.h"
+
+JNIEnv* SentryJavaEnv::Get()
+{
+	// Threads stay attached until they exit so the environment can be cached for the thread's lifetime
+	static thread_local JNIEnv* CachedEnv = nullptr;
+
+	if (!CachedEnv)
+	{
+		CachedEnv = AndroidJavaEnv::GetJavaEnv();
+	}
+
+	return CachedEnv;
+}
+
+FSentryScopedJavaLocalFrame::FSentryScopedJavaLocalFrame(int32 Capacity)
+	: Env(SentryJavaEnv::Get())
+	, IsPushed(false)
+{
+	IsPushed = Env->PushLocalFrame(Capacity) == JNI_OK;
+	if (!IsPushed)
+	{
+		Env->ExceptionClear();
+	}
+}
+
+FSentryScopedJavaLocalFrame::~FSentryScopedJavaLocalFrame()
+{
+	Pop(nullptr);
+}
+
+jobject FSentryScopedJavaLocalFrame::Pop(jobject Result)
+{
+	if (!IsPushed)
+	{
+		return Result;
+	}
+
+	IsPushed = false;
+	return Env->PopLocalFrame(Result);
+}
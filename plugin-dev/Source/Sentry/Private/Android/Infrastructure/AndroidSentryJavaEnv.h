@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Android/AndroidJNI.h"
+
+namespace SentryJavaEnv
+{
+	/** Returns JNI environment of the calling thread, attaching the thread to the JVM only on its first call. */
+	JNIEnv* Get();
+}
+
+/**
+ * Scoped JNI local reference frame.
+ *
+ * All local references created while the frame is alive are released when it goes out of scope
+ * so that conversions of large containers can't overflow the local reference table.
+ */
+class FSentryScopedJavaLocalFrame
+{
+public:
+	explicit FSentryScopedJavaLocalFrame(int32 Capacity = 16);
+	~FSentryScopedJavaLocalFrame();
+
+	FSentryScopedJavaLocalFrame(const FSentryScopedJavaLocalFrame& rhs) = delete;
+	FSentryScopedJavaLocalFrame& operator=(const FSentryScopedJavaLocalFrame& rhs) = delete;
+
+	/** Pops the frame early, keeping the given local reference valid in the enclosing frame. */
+	jobject Pop(jobject Result);
+
+private:
+	JNIEnv* Env;
+	bool IsPushed;
+};
@@ -2,6 +2,9 @@
 
 #include "AndroidSentryJavaObjectWrapper.h"
 #include "AndroidSentryJavaClasses.h"
+#include "AndroidSentryJavaEnv.h"
+
+#include "Utils/SentryMemoryAccounting.h"
 
 #include "Android/AndroidJNI.h"
 
@@ -14,7 +17,7 @@ FSentryJavaObjectWrapper::FSentryJavaObjectWrapper(FSentryJavaClass ClassData)
 FSentryJavaObjectWrapper::FSentryJavaObjectWrapper(FSentryJavaClass ClassData, const char* CtorSignature, ...)
 	: FSentryJavaObjectWrapper(ClassData)
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	jmethodID Constructor = JEnv->GetMethodID(Class, "<init>", CtorSignature);
 	check(Constructor);
@@ -27,12 +30,13 @@ FSentryJavaObjectWrapper::FSentryJavaObjectWrapper(FSentryJavaClass ClassData, c
 	check(LocalObject);
 
 	Object = JEnv->NewGlobalRef(*LocalObject);
+	SentryMemoryAccounting::AddJniGlobalRefs(1);
 }
 
 FSentryJavaObjectWrapper::FSentryJavaObjectWrapper(FSentryJavaClass ClassData, jobject JavaClassInstance)
 	: FSentryJavaObjectWrapper(ClassData)
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	if (!JEnv->IsInstanceOf(JavaClassInstance, Class))
 	{
@@ -40,24 +44,27 @@ FSentryJavaObjectWrapper::FSentryJavaObjectWrapper(FSentryJavaClass ClassData, j
 	}
 
 	Object = JEnv->NewGlobalRef(JavaClassInstance);
+	SentryMemoryAccounting::AddJniGlobalRefs(1);
 }
 
 FSentryJavaObjectWrapper::~FSentryJavaObjectWrapper()
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	if (Object)
+	{
 		JEnv->DeleteGlobalRef(Object);
+		SentryMemoryAccounting::AddJniGlobalRefs(-1);
+	}
 }
 
 FSentryJavaMethod FSentryJavaObjectWrapper::GetMethod(const char* MethodName, const char* FunctionSignature)
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
 	FSentryJavaMethod Method;
-	Method.Method = JEnv->GetMethodID(Class, MethodName, FunctionSignature);
 	Method.Name = MethodName;
 	Method.Signature = FunctionSignature;
 	Method.IsStatic = false;
+	Method.Method = SentryJavaClasses::GetCachedJavaMethodId(Class, Method.Name, Method.Signature, Method.IsStatic);
 	checkf(Method.Method, TEXT("Unable to find Java Method %s with Signature %s"), UTF8_TO_TCHAR(MethodName), UTF8_TO_TCHAR(FunctionSignature));
 	return Method;
 }
@@ -66,12 +73,11 @@ FSentryJavaMethod FSentryJavaObjectWrapper::GetStaticMethod(FSentryJavaClass Cla
 {
 	jclass StaticClass = SentryJavaClasses::GetCachedJavaClassRef(ClassData);
 
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
 	FSentryJavaMethod Method;
-	Method.Method = JEnv->GetStaticMethodID(StaticClass, MethodName, FunctionSignature);
 	Method.Name = MethodName;
 	Method.Signature = FunctionSignature;
 	Method.IsStatic = true;
+	Method.Method = SentryJavaClasses::GetCachedJavaMethodId(StaticClass, Method.Name, Method.Signature, Method.IsStatic);
 	checkf(Method.Method, TEXT("Unable to find Java Method %s with Signature %s"), UTF8_TO_TCHAR(MethodName), UTF8_TO_TCHAR(FunctionSignature));
 	return Method;
 }
@@ -84,13 +90,13 @@ jobject FSentryJavaObjectWrapper::GetJObject() const
 
 FScopedJavaObject<jstring> FSentryJavaObjectWrapper::GetJString(const FString& String)
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 	return FJavaHelper::ToJavaString(JEnv, String);
 }
 
 bool FSentryJavaObjectWrapper::IsInstanceOf(FSentryJavaClass ClassData, jobject JavaClassInstance)
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 	jclass ClassGlobalRef = SentryJavaClasses::GetCachedJavaClassRef(ClassData);
 	check(ClassGlobalRef);
 
@@ -112,7 +118,7 @@ void FSentryJavaObjectWrapper::VerifyMethodCall(FSentryJavaMethod Method) const
 
 void FSentryJavaObjectWrapper::VerifyException() const
 {
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 	if (JEnv->ExceptionCheck())
 	{
 		JEnv->ExceptionDescribe();
@@ -155,7 +161,7 @@ template<>
 void FSentryJavaObjectWrapper::CallMethodInternal<void>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	!Method.IsStatic
 		? JEnv->CallVoidMethodV(Object, Method.Method, Params)
@@ -168,7 +174,7 @@ template<>
 bool FSentryJavaObjectWrapper::CallMethodInternal<bool>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	bool RetVal =
 		!Method.IsStatic
@@ -183,7 +189,7 @@ template<>
 int FSentryJavaObjectWrapper::CallMethodInternal<int>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	int RetVal =
 		!Method.IsStatic
@@ -198,7 +204,7 @@ template<>
 float FSentryJavaObjectWrapper::CallMethodInternal<float>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	float RetVal =
 		!Method.IsStatic
@@ -213,7 +219,7 @@ template<>
 int64 FSentryJavaObjectWrapper::CallMethodInternal<int64>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	int64 RetVal =
 		!Method.IsStatic
@@ -228,7 +234,7 @@ template<>
 FString FSentryJavaObjectWrapper::CallMethodInternal<FString>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	jstring RetVal =
 		!Method.IsStatic
@@ -244,7 +250,7 @@ template<>
 FScopedJavaObject<jobject> FSentryJavaObjectWrapper::CallObjectMethodInternal<jobject>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	jobject RetVal =
 		!Method.IsStatic
@@ -259,7 +265,7 @@ template<>
 FScopedJavaObject<jobjectArray> FSentryJavaObjectWrapper::CallObjectMethodInternal<jobjectArray>(FSentryJavaMethod Method, va_list Params) const
 {
 	VerifyMethodCall(Method);
-	JNIEnv* JEnv = AndroidJavaEnv::GetJavaEnv();
+	JNIEnv* JEnv = SentryJavaEnv::Get();
 
 	jobject RetVal =
 		!Method.IsStatic
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "AndroidSentryPackedBuffer.h"
+
+void FAndroidSentryPackedBuffer::WriteByte(uint8 Value)
+{
+	Data.Add(Value);
+}
+
+void FAndroidSentryPackedBuffer::WriteBool(bool Value)
+{
+	Data.Add(Value ? 1 : 0);
+}
+
+void FAndroidSentryPackedBuffer::WriteInt32(int32 Value)
+{
+	WriteRaw(&Value, sizeof(Value));
+}
+
+void FAndroidSentryPackedBuffer::WriteInt64(int64 Value)
+{
+	WriteRaw(&Value, sizeof(Value));
+}
+
+void FAndroidSentryPackedBuffer::WriteFloat(float Value)
+{
+	WriteRaw(&Value, sizeof(Value));
+}
+
+void FAndroidSentryPackedBuffer::WriteDouble(double Value)
+{
+	WriteRaw(&Value, sizeof(Value));
+}
+
+void FAndroidSentryPackedBuffer::WriteString(const FString& Value)
+{
+	FTCHARToUTF8 Utf8Value(*Value);
+	WriteInt32(Utf8Value.Length());
+	WriteRaw(Utf8Value.Get(), Utf8Value.Length());
+}
+
+void FAndroidSentryPackedBuffer::WriteStringArray(const TArray<FString>& Value)
+{
+	WriteInt32(Value.Num());
+	for (const FString& Item : Value)
+	{
+		WriteString(Item);
+	}
+}
+
+void FAndroidSentryPackedBuffer::WriteRaw(const void* Value, int32 Size)
+{
+	// Java side reads buffers as little-endian which matches all supported Android ABIs
+	Data.Append(static_cast<const uint8*>(Value), Size);
+}
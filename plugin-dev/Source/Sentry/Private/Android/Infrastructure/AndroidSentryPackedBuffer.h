@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Little-endian binary writer for data handed over to SentryBridgeJava as a direct byte buffer.
+ * Strings are written as a 32-bit byte length followed by UTF-8 bytes.
+ */
+class FAndroidSentryPackedBuffer
+{
+public:
+	void WriteByte(uint8 Value);
+	void WriteBool(bool Value);
+	void WriteInt32(int32 Value);
+	void WriteInt64(int64 Value);
+	void WriteFloat(float Value);
+	void WriteDouble(double Value);
+	void WriteString(const FString& Value);
+	void WriteStringArray(const TArray<FString>& Value);
+
+	const uint8* GetData() const { return Data.GetData(); }
+	int32 Num() const { return Data.Num(); }
+	bool IsEmpty() const { return Data.Num() == 0; }
+
+	void Reset() { Data.Reset(); }
+
+	/** Moves the written bytes out leaving the buffer empty. */
+	TArray<uint8> Release() { return MoveTemp(Data); }
+
+private:
+	void WriteRaw(const void* Value, int32 Size);
+
+	TArray<uint8> Data;
+};
@@ -3,18 +3,53 @@
 package io.sentry.unreal;
 
 import android.app.Activity;
+import android.app.ActivityManager;
+import android.app.ApplicationExitInfo;
+import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
+import android.content.SharedPreferences;
+import android.graphics.Bitmap;
+import android.os.BatteryManager;
+import android.os.Build;
+import android.os.Handler;
+import android.os.HandlerThread;
+import android.os.PowerManager;
+import android.view.PixelCopy;
+import android.view.SurfaceView;
+import android.view.View;
+import android.view.ViewGroup;
 
 import androidx.annotation.NonNull;
+import androidx.annotation.RequiresApi;
 
-import org.json.JSONArray;
-import org.json.JSONException;
 import org.json.JSONObject;
 
+import java.io.ByteArrayOutputStream;
 import java.io.File;
 import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.InputStreamReader;
+import java.io.OutputStreamWriter;
+import java.io.Reader;
+import java.io.StringReader;
+import java.io.StringWriter;
+import java.io.Writer;
+import java.lang.ref.WeakReference;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
 import java.util.Collections;
+import java.util.Date;
 import java.util.HashMap;
+import java.util.Iterator;
+import java.util.List;
 import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.TimeUnit;
 
 import io.sentry.Attachment;
 import io.sentry.Breadcrumb;
@@ -22,17 +57,28 @@ import io.sentry.Hint;
 import io.sentry.IScopes;
 import io.sentry.SamplingContext;
 import io.sentry.IScope;
+import io.sentry.ISerializer;
 import io.sentry.ScopeCallback;
 import io.sentry.Sentry;
 import io.sentry.SentryEvent;
 import io.sentry.SentryLevel;
 import io.sentry.SentryOptions;
+import io.sentry.android.core.InternalSentrySdk;
 import io.sentry.android.core.SentryAndroid;
 import io.sentry.android.core.SentryAndroidOptions;
 import io.sentry.exception.ExceptionMechanismException;
+import io.sentry.hints.Backfillable;
+import io.sentry.hints.Cached;
+import io.sentry.protocol.DebugImage;
+import io.sentry.protocol.DebugMeta;
 import io.sentry.protocol.Mechanism;
+import io.sentry.protocol.Message;
 import io.sentry.protocol.SentryException;
 import io.sentry.protocol.SentryId;
+import io.sentry.protocol.SentryStackFrame;
+import io.sentry.protocol.SentryStackTrace;
+import io.sentry.protocol.SentryThread;
+import io.sentry.util.HintUtils;
 import io.sentry.SentryLogEvent;
 
 public class SentryBridgeJava {
@@ -43,79 +89,208 @@ public class SentryBridgeJava {
 	public static native float onTracesSampler(long samplerAddr, SamplingContext samplingContext);
 	public static native String getLogFilePath(boolean isCrash);
 	public static native String getScreenshotFilePath();
+	public static native long[] captureNativeThreadStacks();
 
-	public static void init(Activity activity, final String settingsJsonStr) {
+	private static Context appContext;
+	private static WeakReference<Activity> gameActivity;
+	private static boolean isProcessExitReportingEnabled;
+
+	public static void init(Activity activity, final ByteBuffer packedSettings) {
+		appContext = activity.getApplicationContext();
+		gameActivity = new WeakReference<Activity>(activity);
+		final UnrealSettings settings = new UnrealSettings(packedSettings);
 		SentryAndroid.init(activity, new Sentry.OptionsConfiguration<SentryAndroidOptions>() {
 			@Override
 			public void configure(SentryAndroidOptions options) {
-				try {
-					JSONObject settingJson = new JSONObject(settingsJsonStr);
-					options.setDsn(settingJson.getString("dsn"));
-					options.setRelease(settingJson.getString("release"));
-					options.setEnvironment(settingJson.getString("environment"));
-					options.setDist(settingJson.getString("dist"));
-					options.setEnableAutoSessionTracking(settingJson.getBoolean("autoSessionTracking"));
-					options.setSessionTrackingIntervalMillis(settingJson.getLong("sessionTimeout"));
-					options.setAttachStacktrace(settingJson.getBoolean("enableStackTrace"));
-					options.setDebug(settingJson.getBoolean("debug"));
-					options.setSampleRate(settingJson.getDouble("sampleRate"));
-					options.setMaxBreadcrumbs(settingJson.getInt("maxBreadcrumbs"));
-					options.setSendDefaultPii(settingJson.getBoolean("sendDefaultPii"));
-					JSONArray Includes = settingJson.getJSONArray("inAppInclude");
-					for (int i = 0; i < Includes.length(); i++) {
-						options.addInAppInclude(Includes.getString(i));
-					}
-					JSONArray Excludes = settingJson.getJSONArray("inAppExclude");
-					for (int i = 0; i < Excludes.length(); i++) {
-						options.addInAppExclude(Excludes.getString(i));
-					}
-					options.setAnrEnabled(settingJson.getBoolean("enableAnrTracking"));
-					options.getLogs().setEnabled(settingJson.getBoolean("enableStructuredLogging"));
-					if(settingJson.has("tracesSampleRate")) {
-						options.setTracesSampleRate(settingJson.getDouble("tracesSampleRate"));
-					}
-					if(settingJson.has("tracesSampler")) {
-						final long samplerAddr = settingJson.getLong("tracesSampler");
-						options.setTracesSampler(new SentryOptions.TracesSamplerCallback() {
-							@Override
-							public Double sample(SamplingContext samplingContext) {
-								float sampleRate = onTracesSampler(samplerAddr, samplingContext);
-								if(sampleRate >= 0.0f) {
-									return (double) sampleRate;
-								} else {
-									return null;
-								}
+				options.setDsn(settings.dsn);
+				options.setRelease(settings.release);
+				options.setEnvironment(settings.environment);
+				options.setDist(settings.dist);
+				options.setEnableAutoSessionTracking(settings.autoSessionTracking);
+				options.setSessionTrackingIntervalMillis(settings.sessionTimeout);
+				options.setAttachStacktrace(settings.enableStackTrace);
+				options.setDebug(settings.debug);
+				options.setSampleRate(settings.sampleRate);
+				options.setMaxBreadcrumbs(settings.maxBreadcrumbs);
+				options.setSendDefaultPii(settings.sendDefaultPii);
+				for (String include : settings.inAppInclude) {
+					options.addInAppInclude(include);
+				}
+				for (String exclude : settings.inAppExclude) {
+					options.addInAppExclude(exclude);
+				}
+				options.setAnrEnabled(settings.enableAnrTracking);
+				// Starting with Android 11 ANRs are only reported on the next launch where the native stacks can't be captured anymore,
+				// the thread dump recorded by the system has them instead
+				if (settings.attachNativeAnrStacks) {
+					options.setAttachAnrThreadDump(true);
+				}
+				options.getLogs().setEnabled(settings.enableStructuredLogging);
+				if (settings.hasTracesSampleRate) {
+					options.setTracesSampleRate(settings.tracesSampleRate);
+				}
+				if (settings.tracesSampler != 0) {
+					final long samplerAddr = settings.tracesSampler;
+					options.setTracesSampler(new SentryOptions.TracesSamplerCallback() {
+						@Override
+						public Double sample(SamplingContext samplingContext) {
+							float sampleRate = onTracesSampler(samplerAddr, samplingContext);
+							if(sampleRate >= 0.0f) {
+								return (double) sampleRate;
+							} else {
+								return null;
 							}
-						});
-					}
-					if(settingJson.has("beforeBreadcrumb")) {
-						final long beforeBreadcrumbAddr = settingJson.getLong("beforeBreadcrumb");
-						options.setBeforeBreadcrumb(new SentryOptions.BeforeBreadcrumbCallback() {
-							@Override
-							public Breadcrumb execute(Breadcrumb breadcrumb, Hint hint) {
-								return onBeforeBreadcrumb(beforeBreadcrumbAddr, breadcrumb, hint);
+						}
+					});
+				}
+				if (settings.enableProfiling) {
+					options.setProfilesSampleRate(settings.profilesSampleRate);
+				}
+				if (settings.hasSampleRules) {
+					options.setTracesSampler(new SentryOptions.TracesSamplerCallback() {
+						@Override
+						public Double sample(SamplingContext samplingContext) {
+							// Keep the decision of the upstream service so that distributed traces stay complete
+							if (samplingContext.getTransactionContext().getParentSampled() != null) {
+								return null;
 							}
-						});
-					}
-                    if (settingJson.has("beforeSendHandler")) {
-						options.setBeforeSend(new SentryUnrealBeforeSendCallback(
-								settingJson.getBoolean("enableAutoLogAttachment"), settingJson.getBoolean("attachScreenshot"), settingJson.getLong("beforeSendHandler")));
-					}
-                    else {
-						options.setBeforeSend(new SentryUnrealBeforeSendCallback(
-								settingJson.getBoolean("enableAutoLogAttachment"), settingJson.getBoolean("attachScreenshot")));
-					}
+							return settings.getSampleRate(samplingContext.getTransactionContext().getName(), samplingContext.getTransactionContext().getOperation());
+						}
+					});
+				}
+				if (settings.beforeBreadcrumb != 0) {
+					final long beforeBreadcrumbAddr = settings.beforeBreadcrumb;
+					options.setBeforeBreadcrumb(new SentryOptions.BeforeBreadcrumbCallback() {
+						@Override
+						public Breadcrumb execute(Breadcrumb breadcrumb, Hint hint) {
+							return onBeforeBreadcrumb(beforeBreadcrumbAddr, breadcrumb, hint);
+						}
+					});
+				}
+				options.setBeforeSend(new SentryUnrealBeforeSendCallback(
+						settings.enableAutoLogAttachment, settings.attachScreenshot, settings.attachNativeAnrStacks, settings.beforeSendHandler));
+				if (settings.beforeLogHandler != 0) {
+					options.getLogs().setBeforeSend(new SentryUnrealBeforeLogCallback(settings.beforeLogHandler));
+				}
+			}
+		});
 
-					if (settingJson.has("beforeLogHandler")) {
-						options.getLogs().setBeforeSend(new SentryUnrealBeforeLogCallback(settingJson.getLong("beforeLogHandler")));
-					}
-				} catch (JSONException e) {
-					throw new RuntimeException(e);
+		if (settings.reportProcessExits && Build.VERSION.SDK_INT >= Build.VERSION_CODES.R) {
+			isProcessExitReportingEnabled = true;
+			// Queued before any context of this session is persisted, so that the previous one is read back
+			captureExecutor.execute(new Runnable() {
+				@Override
+				public void run() {
+					reportProcessExits();
 				}
+			});
+		}
+
+		captureExecutor.execute(new Runnable() {
+			@Override
+			public void run() {
+				sendPendingScreenshotEvents();
 			}
 		});
 	}
 
+	// Settings packed by FAndroidSentrySubsystem::InitWithSettings; the field order must be kept in sync with the native writer
+	private static class UnrealSettings {
+		final String dsn;
+		final String release;
+		final String environment;
+		final String dist;
+		final boolean autoSessionTracking;
+		final long sessionTimeout;
+		final boolean enableStackTrace;
+		final boolean debug;
+		final double sampleRate;
+		final int maxBreadcrumbs;
+		final boolean attachScreenshot;
+		final String[] inAppInclude;
+		final String[] inAppExclude;
+		final boolean sendDefaultPii;
+		final boolean enableAnrTracking;
+		final boolean enableAutoLogAttachment;
+		final boolean enableStructuredLogging;
+		final boolean hasTracesSampleRate;
+		final double tracesSampleRate;
+		final long tracesSampler;
+		final boolean enableProfiling;
+		final double profilesSampleRate;
+		final boolean[] sampleRuleMatchesOperation;
+		final String[] sampleRulePrefixes;
+		final double[] sampleRuleRates;
+		final boolean hasSampleRules;
+		final double defaultTracesSampleRate;
+		final long beforeBreadcrumb;
+		final long beforeSendHandler;
+		final long beforeLogHandler;
+		final boolean attachNativeAnrStacks;
+		final boolean reportProcessExits;
+
+		UnrealSettings(final ByteBuffer buffer) {
+			buffer.order(ByteOrder.LITTLE_ENDIAN);
+			dsn = readPackedString(buffer);
+			release = readPackedString(buffer);
+			environment = readPackedString(buffer);
+			dist = readPackedString(buffer);
+			autoSessionTracking = buffer.get() != 0;
+			sessionTimeout = buffer.getLong();
+			enableStackTrace = buffer.get() != 0;
+			debug = buffer.get() != 0;
+			sampleRate = buffer.getDouble();
+			maxBreadcrumbs = buffer.getInt();
+			attachScreenshot = buffer.get() != 0;
+			inAppInclude = readStringArray(buffer);
+			inAppExclude = readStringArray(buffer);
+			sendDefaultPii = buffer.get() != 0;
+			enableAnrTracking = buffer.get() != 0;
+			enableAutoLogAttachment = buffer.get() != 0;
+			enableStructuredLogging = buffer.get() != 0;
+			hasTracesSampleRate = buffer.get() != 0;
+			tracesSampleRate = buffer.getDouble();
+			tracesSampler = buffer.getLong();
+			enableProfiling = buffer.get() != 0;
+			profilesSampleRate = buffer.getDouble();
+			final int sampleRuleCount = buffer.getInt();
+			sampleRuleMatchesOperation = new boolean[sampleRuleCount];
+			sampleRulePrefixes = new String[sampleRuleCount];
+			sampleRuleRates = new double[sampleRuleCount];
+			for (int i = 0; i < sampleRuleCount; i++) {
+				sampleRuleMatchesOperation[i] = buffer.get() != 0;
+				sampleRulePrefixes[i] = readPackedString(buffer);
+				sampleRuleRates[i] = buffer.getDouble();
+			}
+			hasSampleRules = buffer.get() != 0;
+			defaultTracesSampleRate = buffer.getDouble();
+			beforeBreadcrumb = buffer.getLong();
+			beforeSendHandler = buffer.getLong();
+			beforeLogHandler = buffer.getLong();
+			attachNativeAnrStacks = buffer.get() != 0;
+			reportProcessExits = buffer.get() != 0;
+		}
+
+		// Sample rate of the first rule whose prefix matches, mirrors FSentryTraceSampleRules::GetSampleRate
+		double getSampleRate(final String name, final String operation) {
+			for (int i = 0; i < sampleRulePrefixes.length; i++) {
+				final String value = sampleRuleMatchesOperation[i] ? operation : name;
+				if (sampleRulePrefixes[i].isEmpty() || (value != null && value.startsWith(sampleRulePrefixes[i]))) {
+					return sampleRuleRates[i];
+				}
+			}
+			return defaultTracesSampleRate;
+		}
+
+		private static String[] readStringArray(final ByteBuffer buffer) {
+			String[] result = new String[buffer.getInt()];
+			for (int i = 0; i < result.length; i++) {
+				result[i] = readPackedString(buffer);
+			}
+			return result;
+		}
+	}
+
 	public static void addBreadcrumb(final String message, final String category, final String type, final HashMap<String, String> data, final SentryLevel level) {
 		Breadcrumb breadcrumb = new Breadcrumb();
 		breadcrumb.setMessage(message);
@@ -150,12 +325,84 @@ public class SentryBridgeJava {
 		return eventId;
 	}
 
-	public static SentryId captureException(final String type, final String value, final Attachment screenshotAttachment) {
-		SentryException exception = new SentryException();
-		exception.setType(type);
-		exception.setValue(value);
+	// Single worker keeps asynchronous captures in the order they were requested
+	private static final ExecutorService captureExecutor = Executors.newSingleThreadExecutor(new ThreadFactory() {
+		@Override
+		public Thread newThread(@NonNull Runnable runnable) {
+			Thread thread = new Thread(runnable, "SentryUnrealCapture");
+			thread.setDaemon(true);
+			return thread;
+		}
+	});
+
+	public static SentryId captureMessageWithScopeAsync(final String message, final SentryLevel level, final IScope preparedScope) {
+		Message eventMessage = new Message();
+		eventMessage.setFormatted(message);
 		SentryEvent event = new SentryEvent();
-		event.setExceptions(Collections.singletonList(exception));
+		event.setMessage(eventMessage);
+		event.setLevel(level);
+		return captureEventWithScopeAsync(event, preparedScope);
+	}
+
+	public static SentryId captureEventWithScopeAsync(final SentryEvent event, final IScope preparedScope) {
+		// Event ID is assigned when the event is created so it can be returned before the event is processed
+		final SentryId eventId = event.getEventId();
+		captureExecutor.execute(new Runnable() {
+			@Override
+			public void run() {
+				// Breadcrumbs went through beforeBreadcrumb when added to the prepared scope, adding them to the event scope would run it again
+				for (Breadcrumb breadcrumb : preparedScope.getBreadcrumbs()) {
+					event.addBreadcrumb(breadcrumb);
+				}
+				Sentry.captureEvent(event, new ScopeCallback() {
+					@Override
+					public void run(@NonNull IScope scope) {
+						applyPreparedScope(preparedScope, scope);
+					}
+				});
+			}
+		});
+		return eventId;
+	}
+
+	public static void flushAsyncCaptures(final long timeoutMillis) {
+		try {
+			captureExecutor.submit(new Runnable() {
+				@Override
+				public void run() {
+				}
+			}).get(timeoutMillis, TimeUnit.MILLISECONDS);
+		} catch (Exception e) {
+			getOptions().getLogger().log(SentryLevel.WARNING, "Failed to wait for pending captures", e);
+		}
+	}
+
+	private static void applyPreparedScope(final IScope preparedScope, final IScope scope) {
+		for (Map.Entry<String, String> tag : preparedScope.getTags().entrySet()) {
+			scope.setTag(tag.getKey(), tag.getValue());
+		}
+		for (Map.Entry<String, Object> extra : preparedScope.getExtras().entrySet()) {
+			scope.setExtra(extra.getKey(), String.valueOf(extra.getValue()));
+		}
+		for (String key : Collections.list(preparedScope.getContexts().keys())) {
+			scope.setContexts(key, preparedScope.getContexts().get(key));
+		}
+		for (Attachment attachment : preparedScope.getAttachments()) {
+			scope.addAttachment(attachment);
+		}
+		if (preparedScope.getLevel() != null) {
+			scope.setLevel(preparedScope.getLevel());
+		}
+		if (!preparedScope.getFingerprint().isEmpty()) {
+			scope.setFingerprint(new ArrayList<String>(preparedScope.getFingerprint()));
+		}
+		if (preparedScope.getUser() != null) {
+			scope.setUser(preparedScope.getUser());
+		}
+	}
+
+	public static SentryId captureException(final String type, final String value, final Attachment screenshotAttachment, final long[] programCounters) {
+		SentryEvent event = createExceptionEvent(type, value, programCounters);
 
 		Hint hint = new Hint();
 		if (screenshotAttachment != null) {
@@ -166,6 +413,235 @@ public class SentryBridgeJava {
 		return eventId;
 	}
 
+	// PixelCopy results are delivered to this looper so that neither the readback nor the encoding runs on the game thread
+	private static HandlerThread screenshotThread;
+
+	public static SentryId captureExceptionWithPixelCopy(final String type, final String value, final boolean jpeg, final int jpegQuality, final int maxDimension, final long[] programCounters) {
+		final SentryEvent event = createExceptionEvent(type, value, programCounters);
+		// Event ID is assigned when the event is created so it can be returned before the screenshot is taken
+		final SentryId eventId = event.getEventId();
+
+		persistPendingScreenshotEvent(event);
+
+		final Activity activity = gameActivity != null ? gameActivity.get() : null;
+		if (activity == null || Build.VERSION.SDK_INT < Build.VERSION_CODES.N) {
+			captureEventWithScreenshotAsync(event, null);
+			return eventId;
+		}
+
+		// View hierarchy may only be accessed from the UI thread
+		activity.runOnUiThread(new Runnable() {
+			@Override
+			public void run() {
+				final SurfaceView surfaceView = findSurfaceView(activity.getWindow().getDecorView());
+				if (surfaceView == null || surfaceView.getWidth() <= 0 || surfaceView.getHeight() <= 0 || !surfaceView.getHolder().getSurface().isValid()) {
+					getOptions().getLogger().log(SentryLevel.WARNING, "No game surface to take a screenshot from");
+					captureEventWithScreenshotAsync(event, null);
+					return;
+				}
+
+				final Bitmap bitmap = Bitmap.createBitmap(surfaceView.getWidth(), surfaceView.getHeight(), Bitmap.Config.ARGB_8888);
+				try {
+					PixelCopy.request(surfaceView, bitmap, new PixelCopy.OnPixelCopyFinishedListener() {
+						@Override
+						public void onPixelCopyFinished(int result) {
+							Attachment screenshot = null;
+							if (result == PixelCopy.SUCCESS) {
+								screenshot = encodeScreenshot(bitmap, jpeg, jpegQuality, maxDimension);
+							} else {
+								getOptions().getLogger().log(SentryLevel.WARNING, "PixelCopy screenshot failed with result %d", result);
+							}
+							bitmap.recycle();
+							captureEventWithScreenshotAsync(event, screenshot);
+						}
+					}, getScreenshotHandler());
+				} catch (Exception e) {
+					getOptions().getLogger().log(SentryLevel.ERROR, "Failed to request PixelCopy screenshot", e);
+					bitmap.recycle();
+					captureEventWithScreenshotAsync(event, null);
+				}
+			}
+		});
+
+		return eventId;
+	}
+
+	private static synchronized Handler getScreenshotHandler() {
+		if (screenshotThread == null) {
+			screenshotThread = new HandlerThread("SentryUnrealScreenshot");
+			screenshotThread.start();
+		}
+		return new Handler(screenshotThread.getLooper());
+	}
+
+	private static SurfaceView findSurfaceView(final View view) {
+		if (view instanceof SurfaceView && view.getVisibility() == View.VISIBLE) {
+			return (SurfaceView) view;
+		}
+		if (view instanceof ViewGroup) {
+			final ViewGroup group = (ViewGroup) view;
+			for (int i = 0; i < group.getChildCount(); i++) {
+				final SurfaceView surfaceView = findSurfaceView(group.getChildAt(i));
+				if (surfaceView != null) {
+					return surfaceView;
+				}
+			}
+		}
+		return null;
+	}
+
+	private static Attachment encodeScreenshot(final Bitmap bitmap, final boolean jpeg, final int jpegQuality, final int maxDimension) {
+		Bitmap scaled = bitmap;
+		final int largestDimension = Math.max(bitmap.getWidth(), bitmap.getHeight());
+		if (maxDimension > 0 && largestDimension > maxDimension) {
+			final float scale = (float) maxDimension / largestDimension;
+			scaled = Bitmap.createScaledBitmap(bitmap, Math.max(1, Math.round(bitmap.getWidth() * scale)), Math.max(1, Math.round(bitmap.getHeight() * scale)), true);
+		}
+
+		final ByteArrayOutputStream stream = new ByteArrayOutputStream();
+		final boolean compressed;
+		if (jpeg) {
+			compressed = scaled.compress(Bitmap.CompressFormat.JPEG, jpegQuality, stream);
+		} else if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.R) {
+			compressed = scaled.compress(Bitmap.CompressFormat.WEBP_LOSSLESS, 100, stream);
+		} else {
+			compressed = scaled.compress(Bitmap.CompressFormat.WEBP, 100, stream);
+		}
+
+		if (scaled != bitmap) {
+			scaled.recycle();
+		}
+
+		if (!compressed) {
+			getOptions().getLogger().log(SentryLevel.WARNING, "Failed to encode PixelCopy screenshot");
+			return null;
+		}
+
+		return jpeg
+				? new Attachment(stream.toByteArray(), "screenshot.jpg", "image/jpeg")
+				: new Attachment(stream.toByteArray(), "screenshot.webp", "image/webp");
+	}
+
+	private static void captureEventWithScreenshotAsync(final SentryEvent event, final Attachment screenshot) {
+		captureExecutor.execute(new Runnable() {
+			@Override
+			public void run() {
+				Hint hint = new Hint();
+				if (screenshot != null) {
+					hint.addAttachment(screenshot);
+				}
+				Sentry.captureEvent(event, hint);
+
+				final File pendingFile = getPendingScreenshotEventFile(event.getEventId());
+				if (pendingFile != null && pendingFile.exists() && !pendingFile.delete()) {
+					getOptions().getLogger().log(SentryLevel.WARNING, "Failed to delete pending screenshot event: %s", pendingFile.getPath());
+				}
+			}
+		});
+	}
+
+	// Marks events of a previous session so that the scope of this one isn't applied to them
+	private static final class PendingScreenshotEventHint implements Cached {
+	}
+
+	private static File getPendingScreenshotEventsDir() {
+		final String cacheDirPath = getOptions().getCacheDirPath();
+		return cacheDirPath != null ? new File(cacheDirPath, "unreal-pending-screenshot-events") : null;
+	}
+
+	private static File getPendingScreenshotEventFile(final SentryId eventId) {
+		final File dir = getPendingScreenshotEventsDir();
+		return dir != null ? new File(dir, eventId.toString() + ".json") : null;
+	}
+
+	// Event waiting for its screenshot would be lost with the process if it crashed in the meantime, so a copy is kept on disk until it's captured
+	private static void persistPendingScreenshotEvent(final SentryEvent event) {
+		final File file = getPendingScreenshotEventFile(event.getEventId());
+		if (file == null) {
+			return;
+		}
+
+		final SentryEvent eventCopy = copyEvent(event);
+		if (eventCopy == event) {
+			return;
+		}
+
+		// Scope won't be applied when the copy is sent on the next launch, so the current one is stamped on it
+		Sentry.configureScope(new ScopeCallback() {
+			@Override
+			public void run(@NonNull IScope scope) {
+				eventCopy.setBreadcrumbs(new ArrayList<Breadcrumb>(scope.getBreadcrumbs()));
+				eventCopy.setUser(scope.getUser());
+				if (scope.getLevel() != null) {
+					eventCopy.setLevel(scope.getLevel());
+				}
+				for (Map.Entry<String, String> tag : scope.getTags().entrySet()) {
+					eventCopy.setTag(tag.getKey(), tag.getValue());
+				}
+				for (Map.Entry<String, Object> extra : scope.getExtras().entrySet()) {
+					eventCopy.setExtra(extra.getKey(), extra.getValue());
+				}
+				eventCopy.getContexts().putAll(scope.getContexts());
+			}
+		});
+
+		file.getParentFile().mkdirs();
+		try (Writer writer = new OutputStreamWriter(new FileOutputStream(file), StandardCharsets.UTF_8)) {
+			getOptions().getSerializer().serialize(eventCopy, writer);
+		} catch (Exception e) {
+			getOptions().getLogger().log(SentryLevel.WARNING, "Failed to persist pending screenshot event", e);
+		}
+	}
+
+	// Events whose screenshot didn't make it before the previous session ended are sent without one
+	private static void sendPendingScreenshotEvents() {
+		final File dir = getPendingScreenshotEventsDir();
+		final File[] pendingFiles = dir != null ? dir.listFiles() : null;
+		if (pendingFiles == null) {
+			return;
+		}
+
+		for (final File pendingFile : pendingFiles) {
+			try (Reader reader = new InputStreamReader(new FileInputStream(pendingFile), StandardCharsets.UTF_8)) {
+				final SentryEvent event = getOptions().getSerializer().deserialize(reader, SentryEvent.class);
+				if (event != null) {
+					Sentry.captureEvent(event, HintUtils.createWithTypeCheckHint(new PendingScreenshotEventHint()));
+				}
+			} catch (Exception e) {
+				getOptions().getLogger().log(SentryLevel.WARNING, "Failed to read pending screenshot event", e);
+			}
+
+			if (!pendingFile.delete()) {
+				getOptions().getLogger().log(SentryLevel.WARNING, "Failed to delete pending screenshot event: %s", pendingFile.getPath());
+			}
+		}
+	}
+
+	// Program counters are captured by the native side, innermost first
+	private static SentryEvent createExceptionEvent(final String type, final String value, final long[] programCounters) {
+		SentryException exception = new SentryException();
+		exception.setType(type);
+		exception.setValue(value);
+		SentryEvent event = new SentryEvent();
+
+		if (programCounters != null && programCounters.length > 0) {
+			final List<SentryStackFrame> frames = new ArrayList<SentryStackFrame>(programCounters.length);
+			final ArrayList<Long> addresses = new ArrayList<Long>(programCounters.length);
+			for (int i = programCounters.length - 1; i >= 0; i--) {
+				SentryStackFrame frame = new SentryStackFrame();
+				frame.setInstructionAddr(String.format("0x%x", programCounters[i]));
+				frame.setPlatform("native");
+				frames.add(frame);
+				addresses.add(programCounters[i]);
+			}
+			exception.setStacktrace(new SentryStackTrace(frames));
+			addDebugImages(event, addresses);
+		}
+
+		event.setExceptions(Collections.singletonList(exception));
+		return event;
+	}
+
 	public static void setContext(final String key, final HashMap<String, String> values) {
 		Sentry.configureScope(new ScopeCallback() {
 			@Override
@@ -173,6 +649,9 @@ public class SentryBridgeJava {
 				scope.setContexts(key, values);
 			}
 		});
+		if (isProcessExitReportingEnabled && isPersistedContext(key)) {
+			persistContext(key, values);
+		}
 	}
 
 	public static void setTag(final String key, final String value) {
@@ -184,6 +663,17 @@ public class SentryBridgeJava {
 		});
 	}
 
+	public static void setTags(final HashMap<String, String> tags) {
+		Sentry.configureScope(new ScopeCallback() {
+			@Override
+			public void run(@NonNull IScope scope) {
+				for (Map.Entry<String, String> tag : tags.entrySet()) {
+					scope.setTag(tag.getKey(), tag.getValue());
+				}
+			}
+		});
+	}
+
 	public static void removeTag(final String key) {
 		Sentry.configureScope(new ScopeCallback() {
 			@Override
@@ -215,6 +705,180 @@ public class SentryBridgeJava {
 		return isCrashed ? 1 : 0;
 	}
 
+	private static final String PROCESS_EXIT_PREFERENCES = "io.sentry.unreal.process_exit";
+	private static final String LAST_EXIT_TIMESTAMP_KEY = "last_exit_timestamp";
+	private static final String CONTEXT_KEY_PREFIX = "context.";
+
+	// Contexts describing the game's performance that are kept across launches so that process exits can be reported with them
+	private static final String[] PERSISTED_CONTEXTS = { "device_conditions", "memory" };
+
+	private static boolean isPersistedContext(final String key) {
+		for (String persistedKey : PERSISTED_CONTEXTS) {
+			if (persistedKey.equals(key)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	private static void persistContext(final String key, final HashMap<String, String> values) {
+		final String json = new JSONObject(values).toString();
+		// Written on the capture worker so that it never overtakes reading back the contexts of the previous session
+		captureExecutor.execute(new Runnable() {
+			@Override
+			public void run() {
+				appContext.getSharedPreferences(PROCESS_EXIT_PREFERENCES, Context.MODE_PRIVATE).edit().putString(CONTEXT_KEY_PREFIX + key, json).apply();
+			}
+		});
+	}
+
+	@RequiresApi(api = Build.VERSION_CODES.R)
+	private static void reportProcessExits() {
+		try {
+			final ActivityManager activityManager = (ActivityManager) appContext.getSystemService(Context.ACTIVITY_SERVICE);
+			if (activityManager == null) {
+				return;
+			}
+
+			final SharedPreferences preferences = appContext.getSharedPreferences(PROCESS_EXIT_PREFERENCES, Context.MODE_PRIVATE);
+			final boolean hasWatermark = preferences.contains(LAST_EXIT_TIMESTAMP_KEY);
+			final long lastTimestamp = preferences.getLong(LAST_EXIT_TIMESTAMP_KEY, 0);
+
+			final HashMap<String, HashMap<String, String>> previousContexts = new HashMap<String, HashMap<String, String>>();
+			for (String key : PERSISTED_CONTEXTS) {
+				final String json = preferences.getString(CONTEXT_KEY_PREFIX + key, null);
+				if (json != null) {
+					previousContexts.put(key, jsonToMap(new JSONObject(json)));
+				}
+			}
+
+			// Records are sorted newest first
+			final List<ApplicationExitInfo> exits = activityManager.getHistoricalProcessExitReasons(null, 0, 0);
+			if (exits.isEmpty()) {
+				return;
+			}
+
+			preferences.edit().putLong(LAST_EXIT_TIMESTAMP_KEY, exits.get(0).getTimestamp()).apply();
+
+			// Exits that happened before reporting was enabled are only used to set the watermark
+			if (!hasWatermark) {
+				return;
+			}
+
+			for (ApplicationExitInfo exit : exits) {
+				if (exit.getTimestamp() <= lastTimestamp) {
+					break;
+				}
+				final String reason = getUnreportedExitReason(exit);
+				if (reason != null) {
+					Sentry.captureEvent(createProcessExitEvent(exit, reason, previousContexts));
+				}
+			}
+		} catch (Exception e) {
+			getOptions().getLogger().log(SentryLevel.ERROR, "Failed to report process exit reasons", e);
+		}
+	}
+
+	// Crashes and ANRs are reported by the SDK itself, only the exits it doesn't know about are named here
+	@RequiresApi(api = Build.VERSION_CODES.R)
+	private static String getUnreportedExitReason(final ApplicationExitInfo exit) {
+		switch (exit.getReason()) {
+			case ApplicationExitInfo.REASON_LOW_MEMORY:
+				return "low_memory";
+			case ApplicationExitInfo.REASON_EXCESSIVE_RESOURCE_USAGE:
+				return "excessive_resource_usage";
+			case ApplicationExitInfo.REASON_SIGNALED:
+				// Devices that can't tell low memory kills apart report them as SIGKILL
+				return exit.getStatus() == 9 && !ActivityManager.isLowMemoryKillReportSupported() ? "signaled" : null;
+			default:
+				return null;
+		}
+	}
+
+	@RequiresApi(api = Build.VERSION_CODES.R)
+	private static SentryEvent createProcessExitEvent(final ApplicationExitInfo exit, final String reason, final HashMap<String, HashMap<String, String>> previousContexts) {
+		Message message = new Message();
+		message.setFormatted("Process exited: " + reason);
+
+		SentryEvent event = new SentryEvent(new Date(exit.getTimestamp()));
+		event.setMessage(message);
+		event.setLevel(SentryLevel.FATAL);
+		event.setTag("exit.reason", reason);
+		event.setTag("exit.importance", String.valueOf(exit.getImportance()));
+		if (exit.getReason() == ApplicationExitInfo.REASON_LOW_MEMORY) {
+			event.setTag("out_of_memory", "true");
+		}
+
+		HashMap<String, Object> exitContext = new HashMap<String, Object>();
+		exitContext.put("reason", reason);
+		exitContext.put("description", exit.getDescription());
+		exitContext.put("status", exit.getStatus());
+		exitContext.put("importance", exit.getImportance());
+		exitContext.put("pss_kb", exit.getPss());
+		exitContext.put("rss_kb", exit.getRss());
+		exitContext.put("low_memory_kill_report_supported", ActivityManager.isLowMemoryKillReportSupported());
+		event.getContexts().put("process_exit", exitContext);
+
+		// Event contexts take precedence over the ones of the current scope
+		for (Map.Entry<String, HashMap<String, String>> context : previousContexts.entrySet()) {
+			event.getContexts().put(context.getKey(), context.getValue());
+		}
+
+		return event;
+	}
+
+	private static HashMap<String, String> jsonToMap(final JSONObject json) {
+		HashMap<String, String> map = new HashMap<String, String>();
+		Iterator<String> keys = json.keys();
+		while (keys.hasNext()) {
+			String key = keys.next();
+			map.put(key, json.optString(key));
+		}
+		return map;
+	}
+
+	public static int getThermalStatus() {
+		if (appContext == null || Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) {
+			return -1;
+		}
+		PowerManager powerManager = (PowerManager) appContext.getSystemService(Context.POWER_SERVICE);
+		return powerManager != null ? powerManager.getCurrentThermalStatus() : -1;
+	}
+
+	public static int getBatteryLevel() {
+		if (appContext == null) {
+			return -1;
+		}
+		BatteryManager batteryManager = (BatteryManager) appContext.getSystemService(Context.BATTERY_SERVICE);
+		if (batteryManager == null) {
+			return -1;
+		}
+		int level = batteryManager.getIntProperty(BatteryManager.BATTERY_PROPERTY_CAPACITY);
+		return level >= 0 && level <= 100 ? level : -1;
+	}
+
+	public static boolean isCharging() {
+		if (appContext == null) {
+			return false;
+		}
+		if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.M) {
+			BatteryManager batteryManager = (BatteryManager) appContext.getSystemService(Context.BATTERY_SERVICE);
+			return batteryManager != null && batteryManager.isCharging();
+		}
+		// Battery status is a sticky broadcast so no receiver has to be registered
+		Intent batteryStatus = appContext.registerReceiver(null, new IntentFilter(Intent.ACTION_BATTERY_CHANGED));
+		if (batteryStatus == null) {
+			return false;
+		}
+		int status = batteryStatus.getIntExtra(BatteryManager.EXTRA_STATUS, -1);
+		return status == BatteryManager.BATTERY_STATUS_CHARGING || status == BatteryManager.BATTERY_STATUS_FULL;
+	}
+
+	public static boolean captureEnvelope(final byte[] envelopeData) {
+		// Goes through the SDK transport so rate limits and the offline cache apply to envelopes built by the plugin
+		return InternalSentrySdk.captureEnvelope(envelopeData, false) != null;
+	}
+
 	public static boolean isAnrEvent(final SentryEvent event) {
 		Throwable throwable = event.getThrowableMechanism();
 		if (throwable instanceof ExceptionMechanismException) {
@@ -225,6 +889,24 @@ public class SentryBridgeJava {
 		}
 	}
 
+	public static SentryEvent copyEvent(final SentryEvent event) {
+		// The Java SDK has no copy constructor for events so the copy goes through the serializer
+		try {
+			final ISerializer serializer = getOptions().getSerializer();
+			final StringWriter writer = new StringWriter();
+			serializer.serialize(event, writer);
+			final SentryEvent eventCopy = serializer.deserialize(new StringReader(writer.toString()), SentryEvent.class);
+			if (eventCopy != null) {
+				// The throwable isn't serialized
+				eventCopy.setThrowable(event.getThrowable());
+				return eventCopy;
+			}
+		} catch (Exception e) {
+			getOptions().getLogger().log(SentryLevel.WARNING, "Failed to copy event", e);
+		}
+		return event;
+	}
+
 	public static void setContext(final SentryEvent event, final String key, final Object values) {
 		event.getContexts().put(key, values);
 	}
@@ -277,20 +959,114 @@ public class SentryBridgeJava {
 		Sentry.logger().debug(message);
 	}
 
+	// Entries packed by FAndroidSentryBridgeBatch; the layout must be kept in sync with the native writer
+	private static final byte BATCH_ENTRY_LOG = 0;
+	private static final byte BATCH_ENTRY_BREADCRUMB = 1;
+
+	private static final byte BATCH_VALUE_STRING = 0;
+	private static final byte BATCH_VALUE_INTEGER = 1;
+	private static final byte BATCH_VALUE_FLOAT = 2;
+	private static final byte BATCH_VALUE_BOOL = 3;
+
+	public static void addBatch(final ByteBuffer batch, final int count) {
+		batch.order(ByteOrder.LITTLE_ENDIAN);
+		for (int i = 0; i < count; i++) {
+			byte entryType = batch.get();
+			byte level = batch.get();
+			if (entryType == BATCH_ENTRY_LOG) {
+				addBatchedLog(level, readPackedString(batch));
+			} else if (entryType == BATCH_ENTRY_BREADCRUMB) {
+				Breadcrumb breadcrumb = new Breadcrumb();
+				breadcrumb.setLevel(toSentryLevel(level));
+				breadcrumb.setMessage(readPackedString(batch));
+				breadcrumb.setCategory(readPackedString(batch));
+				breadcrumb.setType(readPackedString(batch));
+				int dataCount = batch.getInt();
+				for (int j = 0; j < dataCount; j++) {
+					String key = readPackedString(batch);
+					breadcrumb.setData(key, readBatchValue(batch));
+				}
+				Sentry.addBreadcrumb(breadcrumb);
+			} else {
+				// Unknown entry layout, the rest of the batch can't be decoded
+				return;
+			}
+		}
+	}
+
+	private static void addBatchedLog(final byte level, final String message) {
+		switch (level) {
+			case 4:
+				addLogFatal(message);
+				break;
+			case 3:
+				addLogError(message);
+				break;
+			case 2:
+				addLogWarn(message);
+				break;
+			case 1:
+				addLogInfo(message);
+				break;
+			default:
+				addLogDebug(message);
+				break;
+		}
+	}
+
+	private static SentryLevel toSentryLevel(final byte level) {
+		switch (level) {
+			case 4:
+				return SentryLevel.FATAL;
+			case 3:
+				return SentryLevel.ERROR;
+			case 2:
+				return SentryLevel.WARNING;
+			case 1:
+				return SentryLevel.INFO;
+			default:
+				return SentryLevel.DEBUG;
+		}
+	}
+
+	private static String readPackedString(final ByteBuffer batch) {
+		int length = batch.getInt();
+		byte[] bytes = new byte[length];
+		batch.get(bytes);
+		return new String(bytes, StandardCharsets.UTF_8);
+	}
+
+	private static Object readBatchValue(final ByteBuffer batch) {
+		byte valueType = batch.get();
+		switch (valueType) {
+			case BATCH_VALUE_INTEGER:
+				return batch.getInt();
+			case BATCH_VALUE_FLOAT:
+				return batch.getFloat();
+			case BATCH_VALUE_BOOL:
+				return batch.get() != 0;
+			default:
+				return readPackedString(batch);
+		}
+	}
+
 	private static class SentryUnrealBeforeSendCallback implements SentryOptions.BeforeSendCallback {
 		private final boolean attachLog;
 		private final boolean attachScreenshot;
+		private final boolean attachNativeAnrStacks;
 		private final long beforeSendAddr;
 
 		public SentryUnrealBeforeSendCallback(boolean attachLog, boolean attachScreenshot) {
 			this.attachLog = attachLog;
 			this.attachScreenshot = attachScreenshot;
+			this.attachNativeAnrStacks = false;
 			this.beforeSendAddr = 0;
 		}
 
-		public SentryUnrealBeforeSendCallback(boolean attachLog, boolean attachScreenshot, long beforeSendAddr) {
+		public SentryUnrealBeforeSendCallback(boolean attachLog, boolean attachScreenshot, boolean attachNativeAnrStacks, long beforeSendAddr) {
 			this.attachLog = attachLog;
 			this.attachScreenshot = attachScreenshot;
+			this.attachNativeAnrStacks = attachNativeAnrStacks;
 			this.beforeSendAddr = beforeSendAddr;
 		}
 
@@ -323,13 +1099,104 @@ public class SentryBridgeJava {
 				}
 			}
 
-            if (beforeSendAddr != 0) {
-				return onBeforeSend(beforeSendAddr, event, hint);
+			// ANRs reported on the next launch from the exit info don't belong to this process, so only live ones get native stacks.
+			// The SDK detects ANRs live only before Android 11, later ones come with the thread dump of the system instead.
+			if (attachNativeAnrStacks && isAnrEvent(event) && !HintUtils.hasType(hint, Backfillable.class)) {
+				try {
+					addNativeThreadStacks(event);
+				} catch (Exception e) {
+					options.getLogger().log(SentryLevel.ERROR, "Failed to add native thread stacks to ANR", e);
+				}
 			}
-            return event;
+
+			// Always calls into native code which runs the native filters before the handler, if any
+			return onBeforeSend(beforeSendAddr, event, hint);
         }
 	}
 
+	private static final String[] NATIVE_THREAD_NAMES = { "GameThread", "RenderThread" };
+
+	// Java stack of the main thread doesn't show where the game is stuck, the native game and render thread stacks are added next to it
+	private static void addNativeThreadStacks(final SentryEvent event) {
+		// Packed by the native side as thread kind, thread ID, number of frames and the program counters, innermost first
+		final long[] stacks = captureNativeThreadStacks();
+		if (stacks == null || stacks.length == 0) {
+			return;
+		}
+
+		final List<SentryThread> threads = event.getThreads() != null ? new ArrayList<SentryThread>(event.getThreads()) : new ArrayList<SentryThread>();
+		final ArrayList<Long> programCounters = new ArrayList<Long>();
+
+		int offset = 0;
+		while (offset + 3 <= stacks.length) {
+			final int kind = (int) stacks[offset++];
+			final long threadId = stacks[offset++];
+			final int depth = (int) Math.min(stacks[offset++], stacks.length - offset);
+
+			final List<SentryStackFrame> frames = new ArrayList<SentryStackFrame>(depth);
+			for (int i = depth - 1; i >= 0; i--) {
+				final long programCounter = stacks[offset + i];
+				SentryStackFrame frame = new SentryStackFrame();
+				frame.setInstructionAddr(String.format("0x%x", programCounter));
+				frame.setPlatform("native");
+				frames.add(frame);
+				programCounters.add(programCounter);
+			}
+			offset += depth;
+
+			SentryThread thread = new SentryThread();
+			thread.setId(threadId);
+			thread.setName(kind >= 0 && kind < NATIVE_THREAD_NAMES.length ? NATIVE_THREAD_NAMES[kind] : "NativeThread");
+			thread.setCrashed(false);
+			thread.setCurrent(false);
+			thread.setMain(false);
+			thread.setStacktrace(new SentryStackTrace(frames));
+			threads.add(thread);
+		}
+
+		event.setThreads(threads);
+
+		addDebugImages(event, programCounters);
+	}
+
+	// Native frames are symbolicated only if the images they belong to are listed
+	private static void addDebugImages(final SentryEvent event, final List<Long> programCounters) {
+		final SentryOptions options = getOptions();
+		if (!(options instanceof SentryAndroidOptions)) {
+			return;
+		}
+
+		final List<DebugImage> allImages = ((SentryAndroidOptions) options).getDebugImagesLoader().loadDebugImages();
+		if (allImages == null) {
+			return;
+		}
+
+		final List<DebugImage> images = new ArrayList<DebugImage>();
+		for (DebugImage image : allImages) {
+			if (image.getImageAddr() == null || image.getImageSize() == null) {
+				continue;
+			}
+			final long start = Long.decode(image.getImageAddr());
+			final long end = start + image.getImageSize();
+			for (long programCounter : programCounters) {
+				if (Long.compareUnsigned(programCounter, start) >= 0 && Long.compareUnsigned(programCounter, end) < 0) {
+					images.add(image);
+					break;
+				}
+			}
+		}
+
+		if (images.isEmpty()) {
+			return;
+		}
+
+		DebugMeta debugMeta = event.getDebugMeta() != null ? event.getDebugMeta() : new DebugMeta();
+		final List<DebugImage> eventImages = debugMeta.getImages() != null ? new ArrayList<DebugImage>(debugMeta.getImages()) : new ArrayList<DebugImage>();
+		eventImages.addAll(images);
+		debugMeta.setImages(eventImages);
+		event.setDebugMeta(debugMeta);
+	}
+
 	private static class SentryUnrealBeforeLogCallback implements SentryOptions.Logs.BeforeSendLogCallback {
 		private final long beforeLogAddr;
 
@@ -0,0 +1,235 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+package io.sentry.unreal;
+
+import android.media.MediaCodec;
+import android.media.MediaCodecInfo;
+import android.media.MediaFormat;
+import android.media.MediaMuxer;
+import android.os.Bundle;
+import android.view.Surface;
+
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.util.Locale;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import io.sentry.SentryLevel;
+
+/**
+ * Hardware H.264 encoder fed through its input surface, so that frames rendered by the game never touch the CPU.
+ * Output is muxed into short MP4 segments, each starting with a keyframe, which are handed over to native code
+ * once finalized.
+ */
+public class SentryCrashVideoEncoder {
+	private static final String MIME_TYPE = MediaFormat.MIMETYPE_VIDEO_AVC;
+	private static final long DRAIN_TIMEOUT_US = 10000;
+	private static final long STOP_TIMEOUT_MS = 2000;
+
+	private static final ConcurrentLinkedQueue<String> finishedSegments = new ConcurrentLinkedQueue<>();
+	// Shared by all encoders since a stopped one may still be finalizing its last segment when the next one starts
+	private static final AtomicInteger nextSegmentIndex = new AtomicInteger();
+	private static SentryCrashVideoEncoder activeEncoder;
+
+	private final MediaCodec codec;
+	private final Surface inputSurface;
+	private final File directory;
+	private final long segmentDurationUs;
+	private final Thread drainThread;
+
+	private volatile boolean isStopRequested;
+
+	// Drain thread state
+	private MediaFormat outputFormat;
+	private MediaMuxer muxer;
+	private File segmentFile;
+	private int trackIndex = -1;
+	private long segmentStartUs = -1;
+	private boolean isSyncFrameRequested;
+
+	/**
+	 * Starts encoding into segments written to the given directory.
+	 *
+	 * @param firstSegmentIndex Index of the first segment file name, or -1 to continue the numbering of the previous encoder.
+	 * @return Surface the frames have to be rendered into, or null if no hardware encoder could be configured.
+	 */
+	public static synchronized Surface start(final String directoryPath, final int width, final int height, final int fps, final int bitrate, final float segmentSeconds, final int firstSegmentIndex) {
+		stop();
+
+		try {
+			activeEncoder = new SentryCrashVideoEncoder(new File(directoryPath), width, height, fps, bitrate, segmentSeconds, firstSegmentIndex);
+			return activeEncoder.inputSurface;
+		} catch (Exception e) {
+			SentryBridgeJava.getOptions().getLogger().log(SentryLevel.WARNING, "Failed to start crash video encoder", e);
+			activeEncoder = null;
+			return null;
+		}
+	}
+
+	/** Stops encoding without blocking, the segment being recorded is finalized on the drain thread. */
+	public static synchronized void stop() {
+		if (activeEncoder != null) {
+			activeEncoder.isStopRequested = true;
+			activeEncoder = null;
+		}
+	}
+
+	/** Gets the next finalized segment, or null if there is none. */
+	public static String pollFinishedSegment() {
+		return finishedSegments.poll();
+	}
+
+	private SentryCrashVideoEncoder(final File directory, final int width, final int height, final int fps, final int bitrate, final float segmentSeconds, final int firstSegmentIndex) throws Exception {
+		this.directory = directory;
+		this.segmentDurationUs = (long) (segmentSeconds * 1000000.0f);
+		if (firstSegmentIndex >= 0) {
+			nextSegmentIndex.set(firstSegmentIndex);
+		}
+
+		if (!directory.exists() && !directory.mkdirs()) {
+			throw new IllegalStateException("Failed to create segments directory " + directory);
+		}
+
+		MediaFormat format = MediaFormat.createVideoFormat(MIME_TYPE, width, height);
+		format.setInteger(MediaFormat.KEY_COLOR_FORMAT, MediaCodecInfo.CodecCapabilities.COLOR_FormatSurface);
+		format.setInteger(MediaFormat.KEY_BIT_RATE, bitrate);
+		format.setInteger(MediaFormat.KEY_FRAME_RATE, fps);
+		// Keyframes at segment boundaries only, the rest of the GOP costs no extra bitrate
+		format.setInteger(MediaFormat.KEY_I_FRAME_INTERVAL, Math.max(1, Math.round(segmentSeconds)));
+
+		MediaCodec newCodec = MediaCodec.createEncoderByType(MIME_TYPE);
+		try {
+			newCodec.configure(format, null, null, MediaCodec.CONFIGURE_FLAG_ENCODE);
+			inputSurface = newCodec.createInputSurface();
+			newCodec.start();
+		} catch (Exception e) {
+			newCodec.release();
+			throw e;
+		}
+
+		codec = newCodec;
+
+		drainThread = new Thread(new Runnable() {
+			@Override
+			public void run() {
+				drain();
+			}
+		}, "SentryCrashVideoEncoder");
+		drainThread.setDaemon(true);
+		drainThread.start();
+	}
+
+	private void drain() {
+		MediaCodec.BufferInfo info = new MediaCodec.BufferInfo();
+		long stopRequestedAtMs = 0;
+
+		try {
+			while (true) {
+				if (isStopRequested && stopRequestedAtMs == 0) {
+					stopRequestedAtMs = System.currentTimeMillis();
+					codec.signalEndOfInputStream();
+				}
+
+				if (stopRequestedAtMs != 0 && System.currentTimeMillis() - stopRequestedAtMs > STOP_TIMEOUT_MS) {
+					break;
+				}
+
+				int index = codec.dequeueOutputBuffer(info, DRAIN_TIMEOUT_US);
+				if (index == MediaCodec.INFO_OUTPUT_FORMAT_CHANGED) {
+					outputFormat = codec.getOutputFormat();
+					continue;
+				}
+
+				if (index < 0) {
+					continue;
+				}
+
+				ByteBuffer data = codec.getOutputBuffer(index);
+				boolean isEndOfStream = (info.flags & MediaCodec.BUFFER_FLAG_END_OF_STREAM) != 0;
+
+				// Codec config is already part of the output format the muxer is set up with
+				if (data != null && info.size > 0 && (info.flags & MediaCodec.BUFFER_FLAG_CODEC_CONFIG) == 0) {
+					writeSample(data, info);
+				}
+
+				codec.releaseOutputBuffer(index, false);
+
+				if (isEndOfStream) {
+					break;
+				}
+			}
+		} catch (Exception e) {
+			SentryBridgeJava.getOptions().getLogger().log(SentryLevel.WARNING, "Crash video encoder failed", e);
+		} finally {
+			finishSegment();
+
+			try {
+				codec.stop();
+			} catch (Exception e) {
+				// Codec may already be in the error state
+			}
+
+			codec.release();
+			inputSurface.release();
+		}
+	}
+
+	private void writeSample(final ByteBuffer data, final MediaCodec.BufferInfo info) throws Exception {
+		boolean isKeyFrame = (info.flags & MediaCodec.BUFFER_FLAG_KEY_FRAME) != 0;
+
+		if (muxer != null && info.presentationTimeUs - segmentStartUs >= segmentDurationUs) {
+			if (isKeyFrame) {
+				finishSegment();
+			} else if (!isSyncFrameRequested) {
+				// Encoder may stretch the GOP, the segment is closed on the next keyframe
+				Bundle params = new Bundle();
+				params.putInt(MediaCodec.PARAMETER_KEY_REQUEST_SYNC_FRAME, 0);
+				codec.setParameters(params);
+				isSyncFrameRequested = true;
+			}
+		}
+
+		if (muxer == null) {
+			// Every segment has to start with a keyframe to be playable on its own
+			if (!isKeyFrame || outputFormat == null) {
+				return;
+			}
+
+			segmentFile = new File(directory, String.format(Locale.US, "crash_video_segment_%04d.mp4", nextSegmentIndex.getAndIncrement()));
+			muxer = new MediaMuxer(segmentFile.getAbsolutePath(), MediaMuxer.OutputFormat.MUXER_OUTPUT_MPEG_4);
+			trackIndex = muxer.addTrack(outputFormat);
+			muxer.start();
+
+			segmentStartUs = info.presentationTimeUs;
+			isSyncFrameRequested = false;
+		}
+
+		data.position(info.offset);
+		data.limit(info.offset + info.size);
+		muxer.writeSampleData(trackIndex, data, info);
+	}
+
+	private void finishSegment() {
+		if (muxer == null) {
+			return;
+		}
+
+		boolean isFinalized = false;
+		try {
+			muxer.stop();
+			isFinalized = true;
+		} catch (Exception e) {
+			// Muxer throws if no samples were written
+		} finally {
+			muxer.release();
+			muxer = null;
+		}
+
+		if (isFinalized) {
+			finishedSegments.add(segmentFile.getAbsolutePath());
+		} else {
+			segmentFile.delete();
+		}
+	}
+}
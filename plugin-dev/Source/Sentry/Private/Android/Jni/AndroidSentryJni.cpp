@@ -25,9 +25,13 @@
 #include "SentryTraceSampler.h"
 
 #include "Utils/SentryCallbackUtils.h"
+#include "Utils/SentryEventFilters.h"
 #include "Utils/SentryFileUtils.h"
+#include "Utils/SentryHandlerBudget.h"
+#include "Utils/SentryWrapperPool.h"
 
 #include "HAL/FileManager.h"
+#include "HAL/PlatformStackWalk.h"
 #include "Misc/Paths.h"
 #include "UObject/GarbageCollection.h"
 #include "UObject/UObjectThreadContext.h"
@@ -53,7 +57,17 @@ JNI_METHOD void Java_io_sentry_unreal_SentryBridgeJava_onConfigureScope(JNIEnv*
 
 JNI_METHOD jobject Java_io_sentry_unreal_SentryBridgeJava_onBeforeSend(JNIEnv* env, jclass clazz, jlong objAddr, jobject event, jobject hint)
 {
-	if (!SentryCallbackUtils::IsCallbackSafeToRun())
+	// Native filters don't create UObjects, so unlike the handler they also run during garbage collection
+	if (SentryEventFilters::HasFilters())
+	{
+		FAndroidSentryEvent nativeEvent(event);
+		if (!SentryEventFilters::Run(nativeEvent))
+		{
+			return nullptr;
+		}
+	}
+
+	if (objAddr == 0 || !SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeSend))
 	{
 		// Event will be sent without calling a `onBeforeSend` handler
 		return event;
@@ -61,17 +75,21 @@ JNI_METHOD jobject Java_io_sentry_unreal_SentryBridgeJava_onBeforeSend(JNIEnv* e
 
 	USentryBeforeSendHandler* handler = reinterpret_cast<USentryBeforeSendHandler*>(objAddr);
 
-	USentryEvent* EventToProcess = USentryEvent::Create(MakeShareable(new FAndroidSentryEvent(event)));
+	const FSentryEventWrapperPool::FScopedObject EventToProcess(MakeShareable(new FAndroidSentryEvent(event)));
 	USentryHint* HintToProcess = USentryHint::Create(MakeShareable(new FAndroidSentryHint(hint)));
 
-	USentryEvent* ProcessedEvent = handler->HandleBeforeSend(EventToProcess, HintToProcess);
+	USentryEvent* ProcessedEvent = nullptr;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeSend);
+		ProcessedEvent = handler->HandleBeforeSend(EventToProcess.Get(), HintToProcess);
+	}
 
 	return ProcessedEvent ? event : nullptr;
 }
 
 JNI_METHOD jobject Java_io_sentry_unreal_SentryBridgeJava_onBeforeBreadcrumb(JNIEnv* env, jclass clazz, jlong objAddr, jobject breadcrumb, jobject hint)
 {
-	if (!SentryCallbackUtils::IsCallbackSafeToRun())
+	if (!SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeBreadcrumb))
 	{
 		// Breadcrumb will be added without calling a `beforeBreadcrumb` handler
 		return breadcrumb;
@@ -79,17 +97,21 @@ JNI_METHOD jobject Java_io_sentry_unreal_SentryBridgeJava_onBeforeBreadcrumb(JNI
 
 	USentryBeforeBreadcrumbHandler* handler = reinterpret_cast<USentryBeforeBreadcrumbHandler*>(objAddr);
 
-	USentryBreadcrumb* BreadcrumbToProcess = USentryBreadcrumb::Create(MakeShareable(new FAndroidSentryBreadcrumb(breadcrumb)));
+	const FSentryBreadcrumbWrapperPool::FScopedObject BreadcrumbToProcess(MakeShareable(new FAndroidSentryBreadcrumb(breadcrumb)));
 	USentryHint* HintToProcess = USentryHint::Create(MakeShareable(new FAndroidSentryHint(hint)));
 
-	USentryBreadcrumb* ProcessedBreadcrumb = handler->HandleBeforeBreadcrumb(BreadcrumbToProcess, HintToProcess);
+	USentryBreadcrumb* ProcessedBreadcrumb = nullptr;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeBreadcrumb);
+		ProcessedBreadcrumb = handler->HandleBeforeBreadcrumb(BreadcrumbToProcess.Get(), HintToProcess);
+	}
 
 	return ProcessedBreadcrumb ? breadcrumb : nullptr;
 }
 
 JNI_METHOD jobject Java_io_sentry_unreal_SentryBridgeJava_onBeforeLog(JNIEnv* env, jclass clazz, jlong objAddr, jobject logEvent)
 {
-	if (!SentryCallbackUtils::IsCallbackSafeToRun())
+	if (!SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeLog))
 	{
 		// Log will be added without calling a `onBeforeLog` handler
 		return logEvent;
@@ -97,16 +119,20 @@ JNI_METHOD jobject Java_io_sentry_unreal_SentryBridgeJava_onBeforeLog(JNIEnv* en
 
 	USentryBeforeLogHandler* handler = reinterpret_cast<USentryBeforeLogHandler*>(objAddr);
 
-	USentryLog* LogDataToProcess = USentryLog::Create(MakeShareable(new FAndroidSentryLog(logEvent)));
+	const FSentryLogWrapperPool::FScopedObject LogDataToProcess(MakeShareable(new FAndroidSentryLog(logEvent)));
 
-	USentryLog* ProcessedLogData = handler->HandleBeforeLog(LogDataToProcess);
+	USentryLog* ProcessedLogData = nullptr;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeLog);
+		ProcessedLogData = handler->HandleBeforeLog(LogDataToProcess.Get());
+	}
 
 	return ProcessedLogData ? logEvent : nullptr;
 }
 
 JNI_METHOD jfloat Java_io_sentry_unreal_SentryBridgeJava_onTracesSampler(JNIEnv* env, jclass clazz, jlong objAddr, jobject samplingContext)
 {
-	if (!SentryCallbackUtils::IsCallbackSafeToRun())
+	if (!SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::TraceSampler))
 	{
 		// Falling back to default sampling value without calling a custom sampling function
 		return -1.0f;
@@ -117,7 +143,13 @@ JNI_METHOD jfloat Java_io_sentry_unreal_SentryBridgeJava_onTracesSampler(JNIEnv*
 	USentrySamplingContext* Context = USentrySamplingContext::Create(MakeShareable(new FAndroidSentrySamplingContext(samplingContext)));
 
 	float samplingValue;
-	if (sampler->Sample(Context, samplingValue))
+	bool bIsSampled = false;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::TraceSampler);
+		bIsSampled = sampler->Sample(Context, samplingValue);
+	}
+
+	if (bIsSampled)
 	{
 		return (jfloat)samplingValue;
 	}
@@ -152,3 +184,44 @@ JNI_METHOD jstring Java_io_sentry_unreal_SentryBridgeJava_getScreenshotFilePath(
 
 	return env->NewStringUTF(TCHAR_TO_UTF8(*ScreenshotFilePath));
 }
+
+JNI_METHOD jlongArray Java_io_sentry_unreal_SentryBridgeJava_captureNativeThreadStacks(JNIEnv* env, jclass clazz)
+{
+	// Called from the ANR watchdog thread, the stacks are sampled without suspending the process
+	constexpr int32 MaxDepth = 128;
+
+	const uint32 ThreadIds[] = { GGameThreadId, GRenderThreadId };
+
+	TArray<jlong> PackedStacks;
+	for (int32 Kind = 0; Kind < UE_ARRAY_COUNT(ThreadIds); ++Kind)
+	{
+		// Without a dedicated render thread rendering runs on the game thread
+		if (ThreadIds[Kind] == 0 || (Kind > 0 && ThreadIds[Kind] == ThreadIds[0]))
+		{
+			continue;
+		}
+
+		uint64 ProgramCounters[MaxDepth];
+		const int32 Depth = static_cast<int32>(FPlatformStackWalk::CaptureThreadStackBackTrace(ThreadIds[Kind], ProgramCounters, MaxDepth));
+		if (Depth <= 0)
+		{
+			continue;
+		}
+
+		PackedStacks.Add(Kind);
+		PackedStacks.Add(ThreadIds[Kind]);
+		PackedStacks.Add(Depth);
+		for (int32 Index = 0; Index < Depth; ++Index)
+		{
+			PackedStacks.Add(static_cast<jlong>(ProgramCounters[Index]));
+		}
+	}
+
+	jlongArray Result = env->NewLongArray(PackedStacks.Num());
+	if (Result && PackedStacks.Num() > 0)
+	{
+		env->SetLongArrayRegion(Result, 0, PackedStacks.Num(), PackedStacks.GetData());
+	}
+
+	return Result;
+}
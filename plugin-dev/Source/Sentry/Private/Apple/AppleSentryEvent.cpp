@@ -34,6 +34,13 @@ TSharedPtr<ISentryId> FAppleSentryEvent::GetId() const
 	return MakeShareable(new FAppleSentryId(id));
 }
 
+void FAppleSentryEvent::SetId(const FString& id)
+{
+	SentryId* eventId = [[SENTRY_APPLE_CLASS(SentryId) alloc] initWithUUIDString:id.GetNSString()];
+	EventApple.eventId = eventId;
+	[eventId release];
+}
+
 void FAppleSentryEvent::SetMessage(const FString& message)
 {
 	SentryMessage* msg = [SENTRY_APPLE_CLASS(SentryMessage) alloc];
@@ -212,3 +219,33 @@ bool FAppleSentryEvent::IsAnr() const
 
 	return isErrorLevel && isAppHangException && isAppHangMechanism && isAppHangMessage;
 }
+
+TSharedPtr<ISentryEvent> FAppleSentryEvent::Clone() const
+{
+	// Event setters replace the collections rather than mutating them so copying the properties is enough to keep both events independent
+	SentryEvent* eventCopy = [[SENTRY_APPLE_CLASS(SentryEvent) alloc] initWithLevel:EventApple.level];
+	eventCopy.eventId = EventApple.eventId;
+	eventCopy.message = EventApple.message;
+	eventCopy.error = EventApple.error;
+	eventCopy.timestamp = EventApple.timestamp;
+	eventCopy.logger = EventApple.logger;
+	eventCopy.serverName = EventApple.serverName;
+	eventCopy.releaseName = EventApple.releaseName;
+	eventCopy.dist = EventApple.dist;
+	eventCopy.environment = EventApple.environment;
+	eventCopy.transaction = EventApple.transaction;
+	eventCopy.fingerprint = EventApple.fingerprint;
+	eventCopy.tags = EventApple.tags;
+	eventCopy.extra = EventApple.extra;
+	eventCopy.context = EventApple.context;
+	eventCopy.user = EventApple.user;
+	eventCopy.exceptions = EventApple.exceptions;
+	eventCopy.threads = EventApple.threads;
+	eventCopy.stacktrace = EventApple.stacktrace;
+	eventCopy.debugMeta = EventApple.debugMeta;
+	eventCopy.breadcrumbs = EventApple.breadcrumbs;
+
+	TSharedPtr<ISentryEvent> clone = MakeShareable(new FAppleSentryEvent(eventCopy));
+	[eventCopy release];
+	return clone;
+}
@@ -16,6 +16,7 @@ public:
 	SentryEvent* GetNativeObject();
 
 	virtual TSharedPtr<ISentryId> GetId() const override;
+	virtual void SetId(const FString& id) override;
 	virtual void SetMessage(const FString& message) override;
 	virtual FString GetMessage() const override;
 	virtual void SetLevel(ESentryLevel level) override;
@@ -40,6 +41,7 @@ public:
 	virtual TMap<FString, FSentryVariant> GetExtras() const override;
 	virtual bool IsCrash() const override;
 	virtual bool IsAnr() const override;
+	virtual TSharedPtr<ISentryEvent> Clone() const override;
 
 private:
 	SentryEvent* EventApple;
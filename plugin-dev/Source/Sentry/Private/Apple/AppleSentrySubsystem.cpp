@@ -26,12 +26,20 @@
 #include "SentryTraceSampler.h"
 
 #include "Infrastructure/AppleSentryConverters.h"
+#include "Infrastructure/AppleSentryDebugImages.h"
 
 #include "Convenience/AppleSentryInclude.h"
 #include "Convenience/AppleSentryMacro.h"
 
 #include "Utils/SentryCallbackUtils.h"
+#include "Utils/SentryDeviceConditions.h"
+#include "Utils/SentryEventFilters.h"
 #include "Utils/SentryFileUtils.h"
+#include "Utils/SentryHandlerBudget.h"
+#include "Utils/SentryLogUtils.h"
+#include "Utils/SentryStructLayout.h"
+#include "Utils/SentryTraceSampleRules.h"
+#include "Utils/SentryWrapperPool.h"
 
 #include "GenericPlatform/GenericPlatformOutputDevices.h"
 #include "HAL/FileManager.h"
@@ -91,14 +99,25 @@ void FAppleSentrySubsystem::InitWithSettings(const USentrySettings* settings, US
 				[options addInAppExclude:it->GetNSString()];
 			}
 			options.enableAppHangTracking = settings->EnableAppNotRespondingTracking;
+#if PLATFORM_IOS
+			if (@available(iOS 15.0, *))
+			{
+				// Hang, CPU exception and disk write exception diagnostics are reported as events by the Cocoa SDK itself
+				options.enableMetricKit = settings->EnableMetricKit;
+			}
+#endif
 			if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::UniformSampleRate)
 			{
 				options.tracesSampleRate = [NSNumber numberWithFloat:settings->TracesSampleRate];
 			}
+			if (settings->EnableTracing && settings->EnableProfiling)
+			{
+				options.profilesSampleRate = [NSNumber numberWithFloat:settings->ProfilesSampleRate];
+			}
 			if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::TracesSampler && traceSampler != nullptr)
 			{
 				options.tracesSampler = ^NSNumber*(SentrySamplingContext* samplingContext) {
-					if (!SentryCallbackUtils::IsCallbackSafeToRun())
+					if (!SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::TraceSampler))
 					{
 						// Falling back to default sampling value without calling a custom sampling function
 						return nil;
@@ -107,21 +126,45 @@ void FAppleSentrySubsystem::InitWithSettings(const USentrySettings* settings, US
 					USentrySamplingContext* Context = USentrySamplingContext::Create(MakeShareable(new FAppleSentrySamplingContext(samplingContext)));
 
 					float samplingValue;
-					return traceSampler->Sample(Context, samplingValue) ? [NSNumber numberWithFloat:samplingValue] : nil;
+					bool bIsSampled = false;
+					{
+						FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::TraceSampler);
+						bIsSampled = traceSampler->Sample(Context, samplingValue);
+					}
+
+					return bIsSampled ? [NSNumber numberWithFloat:samplingValue] : nil;
+				};
+			}
+			if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::SampleRules)
+			{
+				TSharedPtr<FSentryTraceSampleRules, ESPMode::ThreadSafe> sampleRules = MakeShared<FSentryTraceSampleRules, ESPMode::ThreadSafe>(settings->TracesSampleRules, settings->TracesSampleRate);
+				options.tracesSampler = ^NSNumber*(SentrySamplingContext* samplingContext) {
+					// Keep the decision of the upstream service so that distributed traces stay complete
+					if (samplingContext.transactionContext.parentSampled != kSentrySampleDecisionUndecided)
+					{
+						return nil;
+					}
+
+					return [NSNumber numberWithDouble:sampleRules->GetSampleRate(
+						[samplingContext.transactionContext.name UTF8String], [samplingContext.transactionContext.operation UTF8String])];
 				};
 			}
 			if (beforeBreadcrumbHandler != nullptr)
 			{
 				options.beforeBreadcrumb = ^SentryBreadcrumb*(SentryBreadcrumb* breadcrumb) {
-					if (!SentryCallbackUtils::IsCallbackSafeToRun())
+					if (!SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeBreadcrumb))
 					{
 						// Breadcrumb will be added without calling a `beforeBreadcrumb` handler
 						return breadcrumb;
 					}
 
-					USentryBreadcrumb* BreadcrumbToProcess = USentryBreadcrumb::Create(MakeShareable(new FAppleSentryBreadcrumb(breadcrumb)));
+					const FSentryBreadcrumbWrapperPool::FScopedObject BreadcrumbToProcess(MakeShareable(new FAppleSentryBreadcrumb(breadcrumb)));
 
-					USentryBreadcrumb* ProcessedBreadcrumb = beforeBreadcrumbHandler->HandleBeforeBreadcrumb(BreadcrumbToProcess, nullptr);
+					USentryBreadcrumb* ProcessedBreadcrumb = nullptr;
+					{
+						FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeBreadcrumb);
+						ProcessedBreadcrumb = beforeBreadcrumbHandler->HandleBeforeBreadcrumb(BreadcrumbToProcess.Get(), nullptr);
+					}
 
 					return ProcessedBreadcrumb ? breadcrumb : nullptr;
 				};
@@ -129,35 +172,50 @@ void FAppleSentrySubsystem::InitWithSettings(const USentrySettings* settings, US
 			if (beforeLogHandler != nullptr)
 			{
 				options.beforeSendLog = ^SentryLog*(SentryLog* log) {
-					if (!SentryCallbackUtils::IsCallbackSafeToRun())
+					if (!SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeLog))
 					{
 						// Log will be added without calling a `onBeforeLog` handler
 						return log;
 					}
 
-					USentryLog* LogToProcess = USentryLog::Create(MakeShareable(new FAppleSentryLog(log)));
+					const FSentryLogWrapperPool::FScopedObject LogToProcess(MakeShareable(new FAppleSentryLog(log)));
 
-					USentryLog* ProcessedLog = beforeLogHandler->HandleBeforeLog(LogToProcess);
+					USentryLog* ProcessedLog = nullptr;
+					{
+						FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeLog);
+						ProcessedLog = beforeLogHandler->HandleBeforeLog(LogToProcess.Get());
+					}
 
 					return ProcessedLog ? log : nullptr;
 				};
 			}
-			if (beforeSendHandler != nullptr)
-			{
-				options.beforeSend = ^SentryEvent*(SentryEvent* event) {
-					if (!SentryCallbackUtils::IsCallbackSafeToRun())
+			options.beforeSend = ^SentryEvent*(SentryEvent* event) {
+				// Native filters don't create UObjects, so unlike the handler they also run during garbage collection
+				if (SentryEventFilters::HasFilters())
+				{
+					FAppleSentryEvent nativeEvent(event);
+					if (!SentryEventFilters::Run(nativeEvent))
 					{
-						// Event will be sent without calling a `onBeforeSend` handler
-						return event;
+						return nullptr;
 					}
+				}
+
+				if (beforeSendHandler == nullptr || !SentryCallbackUtils::IsCallbackSafeToRun() || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeSend))
+				{
+					// Event will be sent without calling a `onBeforeSend` handler
+					return event;
+				}
 
-					USentryEvent* EventToProcess = USentryEvent::Create(MakeShareable(new FAppleSentryEvent(event)));
+				const FSentryEventWrapperPool::FScopedObject EventToProcess(MakeShareable(new FAppleSentryEvent(event)));
 
-					USentryEvent* ProcessedEvent = beforeSendHandler->HandleBeforeSend(EventToProcess, nullptr);
+				USentryEvent* ProcessedEvent = nullptr;
+				{
+					FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeSend);
+					ProcessedEvent = beforeSendHandler->HandleBeforeSend(EventToProcess.Get(), nullptr);
+				}
 
-					return ProcessedEvent ? event : nullptr;
-				};
-			}
+				return ProcessedEvent ? event : nullptr;
+			};
 		}];
 
 		dispatch_group_leave(sentryDispatchGroup);
@@ -319,16 +377,22 @@ TSharedPtr<ISentryId> FAppleSentrySubsystem::CaptureEventWithScope(TSharedPtr<IS
 	return id;
 }
 
-TSharedPtr<ISentryId> FAppleSentrySubsystem::CaptureEnsure(const FString& type, const FString& message)
+TSharedPtr<ISentryId> FAppleSentrySubsystem::CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters)
 {
+	// Program counters are captured on the ensuring thread, symbolication is left to the server so ensures stay cheap
 	SentryException* nativeException = [[SENTRY_APPLE_CLASS(SentryException) alloc] initWithValue:message.GetNSString() type:type.GetNSString()];
+	nativeException.stacktrace = FAppleSentryConverters::CallstackToNative(programCounters);
+
 	NSMutableArray* nativeExceptionArray = [NSMutableArray arrayWithCapacity:1];
 	[nativeExceptionArray addObject:nativeException];
+	[nativeException release];
 
 	SentryEvent* exceptionEvent = [[SENTRY_APPLE_CLASS(SentryEvent) alloc] init];
 	exceptionEvent.exceptions = nativeExceptionArray;
+	exceptionEvent.debugMeta = FAppleSentryDebugImages::GetForAddresses(programCounters);
 
 	SentryId* nativeId = [SENTRY_APPLE_CLASS(SentrySDK) captureEvent:exceptionEvent];
+	[exceptionEvent release];
 
 	TSharedPtr<ISentryId> id = MakeShareable(new FAppleSentryId(nativeId));
 
@@ -366,6 +430,15 @@ void FAppleSentrySubsystem::SetContext(const FString& key, const TMap<FString, F
 	}];
 }
 
+void FAppleSentrySubsystem::SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData)
+{
+	NSDictionary* context = FAppleSentryConverters::StructToNative(*FSentryStructLayout::Get(structType), structData);
+
+	[SENTRY_APPLE_CLASS(SentrySDK) configureScope:^(SentryScope* scope) {
+		[scope setContextValue:context forKey:key.GetNSString()];
+	}];
+}
+
 void FAppleSentrySubsystem::SetTag(const FString& key, const FString& value)
 {
 	[SENTRY_APPLE_CLASS(SentrySDK) configureScope:^(SentryScope* scope) {
@@ -373,6 +446,16 @@ void FAppleSentrySubsystem::SetTag(const FString& key, const FString& value)
 	}];
 }
 
+void FAppleSentrySubsystem::SetTags(const TMap<FString, FString>& tags)
+{
+	[SENTRY_APPLE_CLASS(SentrySDK) configureScope:^(SentryScope* scope) {
+		for (const auto& tag : tags)
+		{
+			[scope setTagValue:tag.Value.GetNSString() forKey:tag.Key.GetNSString()];
+		}
+	}];
+}
+
 void FAppleSentrySubsystem::RemoveTag(const FString& key)
 {
 	[SENTRY_APPLE_CLASS(SentrySDK) configureScope:^(SentryScope* scope) {
@@ -535,6 +618,47 @@ void FAppleSentrySubsystem::UploadGameLogForEvent(TSharedPtr<ISentryId> eventId,
 	UploadAttachmentForEvent(eventId, logFilePath, SentryFileUtils::GetGameLogName());
 }
 
+bool FAppleSentrySubsystem::CaptureEnvelope(const TArray<uint8>& envelope)
+{
+	NSData* data = [NSData dataWithBytes:envelope.GetData() length:envelope.Num()];
+
+	SentryEnvelope* nativeEnvelope = [SENTRY_APPLE_CLASS(PrivateSentrySDKOnly) envelopeWithData:data];
+	if (!nativeEnvelope)
+	{
+		return false;
+	}
+
+	[SENTRY_APPLE_CLASS(PrivateSentrySDKOnly) captureEnvelope:nativeEnvelope];
+	return true;
+}
+
+bool FAppleSentrySubsystem::GetDeviceConditions(FSentryDeviceConditions& outConditions)
+{
+	switch ([[NSProcessInfo processInfo] thermalState])
+	{
+	case NSProcessInfoThermalStateNominal:
+		outConditions.ThermalState = ESentryThermalState::Nominal;
+		break;
+	case NSProcessInfoThermalStateFair:
+		outConditions.ThermalState = ESentryThermalState::Fair;
+		break;
+	case NSProcessInfoThermalStateSerious:
+		outConditions.ThermalState = ESentryThermalState::Serious;
+		break;
+	case NSProcessInfoThermalStateCritical:
+		outConditions.ThermalState = ESentryThermalState::Critical;
+		break;
+	default:
+		outConditions.ThermalState = ESentryThermalState::Unknown;
+	}
+
+	// Apple platforms don't expose CPU or GPU clocks to apps, battery level is -1 where the engine can't query it
+	outConditions.BatteryLevel = FPlatformMisc::GetBatteryLevel();
+	outConditions.bIsCharging = outConditions.BatteryLevel >= 0 && !FPlatformMisc::IsRunningOnBattery();
+
+	return true;
+}
+
 FString FAppleSentrySubsystem::GetScreenshotPath() const
 {
 	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryScreenshots"), FString::Printf(TEXT("screenshot-%s.png"), *FDateTime::Now().ToString()));
@@ -22,12 +22,14 @@ public:
 	virtual TSharedPtr<ISentryId> CaptureMessageWithScope(const FString& message, ESentryLevel level, const FSentryScopeDelegate& onConfigureScope) override;
 	virtual TSharedPtr<ISentryId> CaptureEvent(TSharedPtr<ISentryEvent> event) override;
 	virtual TSharedPtr<ISentryId> CaptureEventWithScope(TSharedPtr<ISentryEvent> event, const FSentryScopeDelegate& onConfigureScope) override;
-	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message) override;
+	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters) override;
 	virtual void CaptureFeedback(TSharedPtr<ISentryFeedback> feedback) override;
 	virtual void SetUser(TSharedPtr<ISentryUser> user) override;
 	virtual void RemoveUser() override;
 	virtual void SetContext(const FString& key, const TMap<FString, FSentryVariant>& values) override;
+	virtual void SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData) override;
 	virtual void SetTag(const FString& key, const FString& value) override;
+	virtual void SetTags(const TMap<FString, FString>& tags) override;
 	virtual void RemoveTag(const FString& key) override;
 	virtual void SetLevel(ESentryLevel level) override;
 	virtual void StartSession() override;
@@ -42,6 +44,9 @@ public:
 	virtual TSharedPtr<ISentryTransactionContext> ContinueTrace(const FString& sentryTrace, const TArray<FString>& baggageHeaders) override;
 
 	virtual void HandleAssert() override {}
+	virtual TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> GetLogRing() const override { return nullptr; }
+	virtual bool GetDeviceConditions(FSentryDeviceConditions& outConditions) override;
+	virtual bool CaptureEnvelope(const TArray<uint8>& envelope) override;
 
 	virtual FString TryCaptureScreenshot() const { return FString(); };
 
@@ -1,12 +1,137 @@
 // Copyright (c) 2025 Sentry. All Rights Reserved.
 
 #include "AppleSentryConverters.h"
+#include "AppleSentryDebugImages.h"
 
 #include "SentryDefines.h"
 
+#include "Utils/SentryStructLayout.h"
+#include "Utils/SentryTrace.h"
+
 #include "Apple/AppleSentryScope.h"
 #include "Apple/Convenience/AppleSentryMacro.h"
 
+namespace SentryAppleConvertersKeys
+{
+	// Bounds the memory held by the per-thread cache when keys are generated dynamically
+	static constexpr int32 MaxCachedKeys = 256;
+
+	struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, NSString*>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, NSString*>& Element)
+		{
+			return Element.Key;
+		}
+
+		static bool Matches(const FString& A, const FString& B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+
+		static uint32 GetKeyHash(const FString& Key)
+		{
+			return GetTypeHash(Key);
+		}
+	};
+
+	/** Retained NSString instances for dictionary keys that are converted over and over (tags, context fields, extras). */
+	struct FKeyCache
+	{
+		TMap<FString, NSString*, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Keys;
+
+		~FKeyCache()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			for (auto& Key : Keys)
+			{
+				[Key.Value release];
+			}
+			Keys.Reset();
+		}
+	};
+
+	static NSString* GetKey(const FString& Key)
+	{
+		static thread_local FKeyCache Cache;
+
+		if (NSString** CachedKey = Cache.Keys.Find(Key))
+		{
+			return *CachedKey;
+		}
+
+		if (Cache.Keys.Num() >= MaxCachedKeys)
+		{
+			Cache.Reset();
+		}
+
+		NSString* NativeKey = [Key.GetNSString() retain];
+		Cache.Keys.Add(Key, NativeKey);
+		return NativeKey;
+	}
+}
+
+namespace SentryAppleConvertersStruct
+{
+	/** Writes struct fields into dictionaries, nested structs become nested dictionaries. */
+	class FStructWriter
+	{
+	public:
+		FStructWriter()
+		{
+			Dicts.Add([[NSMutableDictionary alloc] init]);
+		}
+
+		void WriteBool(const FSentryStructLayout::FField& Field, bool Value)
+		{
+			Set(Field, [NSNumber numberWithBool:Value]);
+		}
+
+		void WriteInteger(const FSentryStructLayout::FField& Field, int32 Value)
+		{
+			Set(Field, [NSNumber numberWithInt:Value]);
+		}
+
+		void WriteFloat(const FSentryStructLayout::FField& Field, double Value)
+		{
+			Set(Field, [NSNumber numberWithDouble:Value]);
+		}
+
+		void WriteString(const FSentryStructLayout::FField& Field, const FString& Value)
+		{
+			Set(Field, Value.GetNSString());
+		}
+
+		void BeginStruct(const FSentryStructLayout::FField& Field)
+		{
+			Dicts.Add([[NSMutableDictionary alloc] init]);
+		}
+
+		void EndStruct(const FSentryStructLayout::FField& Field)
+		{
+			NSMutableDictionary* Nested = Dicts.Pop();
+			Set(Field, Nested);
+			[Nested release];
+		}
+
+		NSDictionary* Finish()
+		{
+			return [Dicts.Pop() autorelease];
+		}
+
+	private:
+		void Set(const FSentryStructLayout::FField& Field, id Value)
+		{
+			[Dicts.Last() setValue:Value forKey:SentryAppleConvertersKeys::GetKey(Field.Name)];
+		}
+
+		TArray<NSMutableDictionary*, TInlineAllocator<4>> Dicts;
+	};
+}
+
 SentryLevel FAppleSentryConverters::SentryLevelToNative(ESentryLevel level)
 {
 	SentryLevel nativeLevel = kSentryLevelDebug;
@@ -65,26 +190,37 @@ SentryStructuredLogLevel FAppleSentryConverters::SentryStructuredLogLevelToNativ
 
 NSDictionary* FAppleSentryConverters::StringMapToNative(const TMap<FString, FString>& map)
 {
-	NSMutableDictionary* dict = [NSMutableDictionary dictionaryWithCapacity:map.Num()];
+	SENTRY_TRACE_SCOPE(StringMapToNative);
 
-	for (auto it = map.CreateConstIterator(); it; ++it)
+	NSMutableDictionary* dict = [[NSMutableDictionary alloc] initWithCapacity:map.Num()];
+
+	// Temporary strings are released as soon as the dictionary holds them instead of piling up in the caller's pool
+	@autoreleasepool
 	{
-		[dict setValue:it.Value().GetNSString() forKey:it.Key().GetNSString()];
+		for (auto it = map.CreateConstIterator(); it; ++it)
+		{
+			[dict setValue:it.Value().GetNSString() forKey:SentryAppleConvertersKeys::GetKey(it.Key())];
+		}
 	}
 
-	return dict;
+	return [dict autorelease];
 }
 
 NSArray* FAppleSentryConverters::StringArrayToNative(const TArray<FString>& array)
 {
-	NSMutableArray* arr = [NSMutableArray arrayWithCapacity:array.Num()];
+	SENTRY_TRACE_SCOPE(StringArrayToNative);
 
-	for (auto it = array.CreateConstIterator(); it; ++it)
+	NSMutableArray* arr = [[NSMutableArray alloc] initWithCapacity:array.Num()];
+
+	@autoreleasepool
 	{
-		[arr addObject:it->GetNSString()];
+		for (auto it = array.CreateConstIterator(); it; ++it)
+		{
+			[arr addObject:it->GetNSString()];
+		}
 	}
 
-	return arr;
+	return [arr autorelease];
 }
 
 NSData* FAppleSentryConverters::ByteDataToNative(const TArray<uint8>& array)
@@ -103,11 +239,11 @@ id FAppleSentryConverters::VariantToNative(const FSentryVariant& variant)
 	case ESentryVariantType::Bool:
 		return [NSNumber numberWithBool:variant.GetValue<bool>()];
 	case ESentryVariantType::String:
-		return variant.GetValue<FString>().GetNSString();
+		return variant.GetStringRef().GetNSString();
 	case ESentryVariantType::Array:
-		return VariantArrayToNative(variant.GetValue<TArray<FSentryVariant>>());
+		return VariantArrayToNative(variant.GetArrayRef());
 	case ESentryVariantType::Map:
-		return VariantMapToNative(variant.GetValue<TMap<FString, FSentryVariant>>());
+		return VariantMapToNative(variant.GetMapRef());
 	default:
 		return nullptr;
 	}
@@ -115,44 +251,82 @@ id FAppleSentryConverters::VariantToNative(const FSentryVariant& variant)
 
 NSArray* FAppleSentryConverters::VariantArrayToNative(const TArray<FSentryVariant>& variantArray)
 {
-	NSMutableArray* arr = [NSMutableArray arrayWithCapacity:variantArray.Num()];
+	SENTRY_TRACE_SCOPE(VariantArrayToNative);
+
+	NSMutableArray* arr = [[NSMutableArray alloc] initWithCapacity:variantArray.Num()];
 
-	for (auto it = variantArray.CreateConstIterator(); it; ++it)
+	@autoreleasepool
 	{
-		[arr addObject:VariantToNative(*it)];
+		for (auto it = variantArray.CreateConstIterator(); it; ++it)
+		{
+			// Empty variants have no native counterpart and can't be stored in NSArray
+			if (id value = VariantToNative(*it))
+			{
+				[arr addObject:value];
+			}
+		}
 	}
 
-	return arr;
+	return [arr autorelease];
 }
 
 NSDictionary* FAppleSentryConverters::VariantMapToNative(const TMap<FString, FSentryVariant>& variantMap)
 {
-	NSMutableDictionary* dict = [NSMutableDictionary dictionaryWithCapacity:variantMap.Num()];
+	SENTRY_TRACE_SCOPE(VariantMapToNative);
+
+	NSMutableDictionary* dict = [[NSMutableDictionary alloc] initWithCapacity:variantMap.Num()];
+
+	@autoreleasepool
+	{
+		for (auto it = variantMap.CreateConstIterator(); it; ++it)
+		{
+			[dict setValue:VariantToNative(it.Value()) forKey:SentryAppleConvertersKeys::GetKey(it.Key())];
+		}
+	}
+
+	return [dict autorelease];
+}
+
+NSDictionary* FAppleSentryConverters::StructToNative(const FSentryStructLayout& layout, const void* structData)
+{
+	SENTRY_TRACE_SCOPE(StructToNative);
+
+	SentryAppleConvertersStruct::FStructWriter writer;
 
-	for (auto it = variantMap.CreateConstIterator(); it; ++it)
+	@autoreleasepool
 	{
-		[dict setValue:VariantToNative(it.Value()) forKey:it.Key().GetNSString()];
+		layout.Write(structData, writer);
 	}
 
-	return dict;
+	return writer.Finish();
 }
 
-SentryStacktrace* FAppleSentryConverters::CallstackToNative(const TArray<FProgramCounterSymbolInfo>& callstack)
+SentryStacktrace* FAppleSentryConverters::CallstackToNative(const TArray<uint64>& programCounters)
 {
-	int32 framesCount = callstack.Num();
+	int32 framesCount = programCounters.Num();
 
 	NSMutableArray* arr = [NSMutableArray arrayWithCapacity:framesCount];
 
+	// Frames are only described by addresses, symbolication is done on the server using uploaded dSYMs
 	for (int i = 0; i < framesCount; ++i)
 	{
+		const uint64 programCounter = programCounters[framesCount - i - 1];
+
 		SentryFrame* frame = [[SENTRY_APPLE_CLASS(SentryFrame) alloc] init];
-		frame.instructionAddress = FString::Printf(TEXT("0x%llx"), callstack[framesCount - i - 1].ProgramCounter).GetNSString();
+		frame.instructionAddress = FString::Printf(TEXT("0x%llx"), programCounter).GetNSString();
+
+		if (const uint64 imageAddress = FAppleSentryDebugImages::GetImageAddress(programCounter))
+		{
+			frame.imageAddress = FString::Printf(TEXT("0x%llx"), imageAddress).GetNSString();
+		}
+
 		[arr addObject:frame];
+		[frame release];
 	}
 
 	SentryStacktrace* trace = [[SENTRY_APPLE_CLASS(SentryStacktrace) alloc] initWithFrames:arr registers:@{}];
 
-	return trace;
+	return [trace autorelease];
 }
 
 ESentryLevel FAppleSentryConverters::SentryLevelToUnreal(SentryLevel level)
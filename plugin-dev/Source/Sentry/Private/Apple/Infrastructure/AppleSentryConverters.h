@@ -7,9 +7,8 @@
 
 #include "Convenience/AppleSentryInclude.h"
 
-#include "GenericPlatform/GenericPlatformStackWalk.h"
-
 struct FSentryVariant;
+class FSentryStructLayout;
 
 class FAppleSentryConverters
 {
@@ -23,7 +22,8 @@ public:
 	static id VariantToNative(const FSentryVariant& variant);
 	static NSArray* VariantArrayToNative(const TArray<FSentryVariant>& variantArray);
 	static NSDictionary* VariantMapToNative(const TMap<FString, FSentryVariant>& variantMap);
-	static SentryStacktrace* CallstackToNative(const TArray<FProgramCounterSymbolInfo>& callstack);
+	static NSDictionary* StructToNative(const FSentryStructLayout& layout, const void* structData);
+	static SentryStacktrace* CallstackToNative(const TArray<uint64>& programCounters);
 
 	/** Conversions from native Mac/iOS types */
 	static ESentryLevel SentryLevelToUnreal(SentryLevel level);
@@ -0,0 +1,148 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "AppleSentryDebugImages.h"
+
+#include "Apple/Convenience/AppleSentryMacro.h"
+
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+
+#include <mach-o/dyld.h>
+#include <mach-o/loader.h>
+
+namespace SentryAppleDebugImages
+{
+	struct FImageInfo
+	{
+		uint64 Address = 0;
+		uint64 Size = 0;
+		uint64 VmAddress = 0;
+		FString DebugId;
+		FString CodeFile;
+	};
+
+	static FCriticalSection CriticalSection;
+	static TArray<FImageInfo> Images;
+
+	static bool ReadImageInfo(uint32 ImageIndex, FImageInfo& OutInfo)
+	{
+		const mach_header_64* Header = reinterpret_cast<const mach_header_64*>(_dyld_get_image_header(ImageIndex));
+		if (!Header || Header->magic != MH_MAGIC_64)
+		{
+			return false;
+		}
+
+		OutInfo.Address = reinterpret_cast<uint64>(Header);
+		OutInfo.CodeFile = UTF8_TO_TCHAR(_dyld_get_image_name(ImageIndex));
+
+		const uint8* Command = reinterpret_cast<const uint8*>(Header + 1);
+		for (uint32 CommandIndex = 0; CommandIndex < Header->ncmds; ++CommandIndex)
+		{
+			const load_command* LoadCommand = reinterpret_cast<const load_command*>(Command);
+
+			if (LoadCommand->cmd == LC_SEGMENT_64)
+			{
+				const segment_command_64* Segment = reinterpret_cast<const segment_command_64*>(LoadCommand);
+				if (FCStringAnsi::Strncmp(Segment->segname, SEG_TEXT, sizeof(Segment->segname)) == 0)
+				{
+					OutInfo.Size = Segment->vmsize;
+					OutInfo.VmAddress = Segment->vmaddr;
+				}
+			}
+			else if (LoadCommand->cmd == LC_UUID)
+			{
+				const uuid_command* UuidCommand = reinterpret_cast<const uuid_command*>(LoadCommand);
+				NSUUID* Uuid = [[NSUUID alloc] initWithUUIDBytes:UuidCommand->uuid];
+				OutInfo.DebugId = FString(Uuid.UUIDString);
+				[Uuid release];
+			}
+
+			Command += LoadCommand->cmdsize;
+		}
+
+		return OutInfo.Size > 0 && !OutInfo.DebugId.IsEmpty();
+	}
+
+	static void RefreshImages()
+	{
+		Images.Reset();
+
+		const uint32 ImageCount = _dyld_image_count();
+		for (uint32 ImageIndex = 0; ImageIndex < ImageCount; ++ImageIndex)
+		{
+			FImageInfo Info;
+			if (ReadImageInfo(ImageIndex, Info))
+			{
+				Images.Add(MoveTemp(Info));
+			}
+		}
+	}
+
+	static const FImageInfo* FindImage(uint64 ProgramCounter)
+	{
+		for (const FImageInfo& Image : Images)
+		{
+			if (ProgramCounter >= Image.Address && ProgramCounter < Image.Address + Image.Size)
+			{
+				return &Image;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/** Finds image containing the program counter, re-reading the image list once if it was loaded after the last refresh. */
+	static const FImageInfo* FindOrRefreshImage(uint64 ProgramCounter, bool& bInOutRefreshed)
+	{
+		const FImageInfo* Image = FindImage(ProgramCounter);
+		if (!Image && !bInOutRefreshed)
+		{
+			bInOutRefreshed = true;
+			RefreshImages();
+			Image = FindImage(ProgramCounter);
+		}
+
+		return Image;
+	}
+}
+
+NSArray<SentryDebugMeta*>* FAppleSentryDebugImages::GetForAddresses(const TArray<uint64>& programCounters)
+{
+	FScopeLock Lock(&SentryAppleDebugImages::CriticalSection);
+
+	NSMutableArray<SentryDebugMeta*>* debugMeta = [NSMutableArray arrayWithCapacity:4];
+	TSet<uint64> addedImages;
+	bool bRefreshed = false;
+
+	for (uint64 programCounter : programCounters)
+	{
+		const SentryAppleDebugImages::FImageInfo* image = SentryAppleDebugImages::FindOrRefreshImage(programCounter, bRefreshed);
+		if (!image || addedImages.Contains(image->Address))
+		{
+			continue;
+		}
+
+		addedImages.Add(image->Address);
+
+		SentryDebugMeta* meta = [[SENTRY_APPLE_CLASS(SentryDebugMeta) alloc] init];
+		meta.type = @"macho";
+		meta.debugID = image->DebugId.GetNSString();
+		meta.codeFile = image->CodeFile.GetNSString();
+		meta.imageAddress = FString::Printf(TEXT("0x%llx"), image->Address).GetNSString();
+		meta.imageVmAddress = FString::Printf(TEXT("0x%llx"), image->VmAddress).GetNSString();
+		meta.imageSize = [NSNumber numberWithUnsignedLongLong:image->Size];
+		[debugMeta addObject:meta];
+		[meta release];
+	}
+
+	return debugMeta;
+}
+
+uint64 FAppleSentryDebugImages::GetImageAddress(uint64 programCounter)
+{
+	FScopeLock Lock(&SentryAppleDebugImages::CriticalSection);
+
+	bool bRefreshed = false;
+	const SentryAppleDebugImages::FImageInfo* image = SentryAppleDebugImages::FindOrRefreshImage(programCounter, bRefreshed);
+	return image ? image->Address : 0;
+}
@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Convenience/AppleSentryInclude.h"
+
+/**
+ * Describes loaded Mach-O images so that raw program counters can be symbolicated on the server with uploaded dSYMs.
+ * Image info is read from dyld once and reused for later captures.
+ */
+class FAppleSentryDebugImages
+{
+public:
+	/** Gets debug meta for the images that contain the given program counters. */
+	static NSArray<SentryDebugMeta*>* GetForAddresses(const TArray<uint64>& programCounters);
+
+	/** Gets the load address of the image containing the given program counter, 0 if it's unknown. */
+	static uint64 GetImageAddress(uint64 programCounter);
+};
@@ -9,135 +9,330 @@
 #include "SentryDefines.h"
 
 #include "Dom/JsonObject.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializer.h"
 
 #if USE_SENTRY_NATIVE
 
-FGenericPlatformSentryCrashReporter::FGenericPlatformSentryCrashReporter()
+namespace SentryCrashReporterJson
 {
-	crashReporterConfig = MakeShareable(new FJsonObject);
+	static void AppendString(FString& out, const FString& value)
+	{
+		out.AppendChar(TEXT('"'));
+
+		for (const TCHAR ch : value)
+		{
+			switch (ch)
+			{
+			case TEXT('"'):
+				out.Append(TEXT("\\\""));
+				break;
+			case TEXT('\\'):
+				out.Append(TEXT("\\\\"));
+				break;
+			case TEXT('\n'):
+				out.Append(TEXT("\\n"));
+				break;
+			case TEXT('\r'):
+				out.Append(TEXT("\\r"));
+				break;
+			case TEXT('\t'):
+				out.Append(TEXT("\\t"));
+				break;
+			default:
+				if (ch < TEXT(' '))
+				{
+					out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(ch));
+				}
+				else
+				{
+					out.AppendChar(ch);
+				}
+				break;
+			}
+		}
+
+		out.AppendChar(TEXT('"'));
+	}
+
+	static void AppendStringField(FString& out, bool& isFirst, const FString& key, const FString& value)
+	{
+		if (!isFirst)
+		{
+			out.AppendChar(TEXT(','));
+		}
 
+		isFirst = false;
+
+		AppendString(out, key);
+		out.AppendChar(TEXT(':'));
+		AppendString(out, value);
+	}
+
+	static FString SerializeObject(const TSharedRef<FJsonObject>& object)
+	{
+		FString result;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> jsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&result);
+		FJsonSerializer::Serialize(object, jsonWriter);
+		return result;
+	}
+}
+
+FGenericPlatformSentryCrashReporter::FGenericPlatformSentryCrashReporter()
+	: isDirty(false)
+	, hasUser(false)
+{
 	const FString sentryData = FGenericPlatformSentryCrashContext::Get()->GetGameData(TEXT("__sentry"));
 	if (!sentryData.IsEmpty())
 	{
+		TSharedPtr<FJsonObject> crashReporterConfig;
 		const TSharedRef<TJsonReader<>> jsonReader = TJsonReaderFactory<>::Create(*sentryData);
-		if (!FJsonSerializer::Deserialize(jsonReader, crashReporterConfig) && crashReporterConfig.IsValid())
+		if (!FJsonSerializer::Deserialize(jsonReader, crashReporterConfig) || !crashReporterConfig.IsValid())
 		{
 			UE_LOG(LogSentrySdk, Log, TEXT("Faield to deserialize `__sentry` data stored in crash context object: %s"), *FString(sentryData));
 		}
+		else
+		{
+			crashReporterConfig->TryGetStringField(TEXT("release"), releaseConfig);
+			crashReporterConfig->TryGetStringField(TEXT("environment"), environmentConfig);
+
+			const TSharedPtr<FJsonObject>* userObject = nullptr;
+			if (crashReporterConfig->TryGetObjectField(TEXT("user"), userObject))
+			{
+				hasUser = true;
+				for (const auto& field : (*userObject)->Values)
+				{
+					userConfig.Add(field.Key, field.Value->AsString());
+				}
+			}
+
+			const TSharedPtr<FJsonObject>* tagsConfig = nullptr;
+			if (crashReporterConfig->TryGetObjectField(TEXT("tags"), tagsConfig))
+			{
+				for (const auto& field : (*tagsConfig)->Values)
+				{
+					tags.Add(field.Key, field.Value->AsString());
+				}
+			}
+
+			const TSharedPtr<FJsonObject>* contextsConfig = nullptr;
+			if (crashReporterConfig->TryGetObjectField(TEXT("contexts"), contextsConfig))
+			{
+				for (const auto& field : (*contextsConfig)->Values)
+				{
+					const TSharedPtr<FJsonObject>* contextConfig = nullptr;
+					if (field.Value->TryGetObject(contextConfig))
+					{
+						contexts.Add(field.Key, SentryCrashReporterJson::SerializeObject(contextConfig->ToSharedRef()));
+					}
+				}
+			}
+		}
 	}
+
+	// Crash context is serialized right after system error handlers are run so pending changes have to be written out here
+	onHandleSystemErrorDelegateHandle = FCoreDelegates::OnHandleSystemError.AddLambda([this]()
+	{
+		UpdateCrashReporterConfig(false);
+	});
+}
+
+FGenericPlatformSentryCrashReporter::~FGenericPlatformSentryCrashReporter()
+{
+	FCoreDelegates::OnHandleSystemError.Remove(onHandleSystemErrorDelegateHandle);
 }
 
 void FGenericPlatformSentryCrashReporter::SetRelease(const FString& release)
 {
-	if (!release.IsEmpty())
-		crashReporterConfig->SetStringField(TEXT("release"), release);
+	if (release.IsEmpty())
+		return;
 
-	UpdateCrashReporterConfig();
+	FScopeLock lock(&criticalSection);
+	releaseConfig = release;
+	isDirty = true;
 }
 
 void FGenericPlatformSentryCrashReporter::SetEnvironment(const FString& environment)
 {
-	if (!environment.IsEmpty())
-		crashReporterConfig->SetStringField(TEXT("environment"), environment);
+	if (environment.IsEmpty())
+		return;
 
-	UpdateCrashReporterConfig();
+	FScopeLock lock(&criticalSection);
+	environmentConfig = environment;
+	isDirty = true;
 }
 
 void FGenericPlatformSentryCrashReporter::SetUser(TSharedPtr<FGenericPlatformSentryUser> user)
 {
-	TSharedPtr<FJsonObject> userConfig = MakeShareable(new FJsonObject);
-	userConfig->SetStringField(TEXT("email"), user->GetEmail());
-	userConfig->SetStringField(TEXT("username"), user->GetUsername());
-	userConfig->SetStringField(TEXT("id"), user->GetId());
-	userConfig->SetStringField(TEXT("ip_address"), user->GetIpAddress());
+	TMap<FString, FString> userFields;
+	userFields.Add(TEXT("email"), user->GetEmail());
+	userFields.Add(TEXT("username"), user->GetUsername());
+	userFields.Add(TEXT("id"), user->GetId());
+	userFields.Add(TEXT("ip_address"), user->GetIpAddress());
 
 	const TMap<FString, FString>& userData = user->GetData();
 
 	for (auto it = userData.CreateConstIterator(); it; ++it)
 	{
-		userConfig->SetStringField(it.Key(), it.Value());
+		userFields.Add(it.Key(), it.Value());
 	}
 
-	crashReporterConfig->SetObjectField(TEXT("user"), userConfig);
-
-	UpdateCrashReporterConfig();
+	FScopeLock lock(&criticalSection);
+	userConfig = MoveTemp(userFields);
+	hasUser = true;
+	isDirty = true;
 }
 
 void FGenericPlatformSentryCrashReporter::RemoveUser()
 {
-	crashReporterConfig->RemoveField(TEXT("user"));
-
-	UpdateCrashReporterConfig();
+	FScopeLock lock(&criticalSection);
+	userConfig.Empty();
+	hasUser = false;
+	isDirty = true;
 }
 
 void FGenericPlatformSentryCrashReporter::SetContext(const FString& key, const TMap<FString, FSentryVariant>& values)
 {
-	TSharedPtr<FJsonObject> valuesConfig = MakeShareable(new FJsonObject);
+	TSharedRef<FJsonObject> valuesConfig = MakeShared<FJsonObject>();
 
 	for (auto it = values.CreateConstIterator(); it; ++it)
 	{
 		valuesConfig->Values.Add(it.Key(), FGenericPlatformSentryConverters::VariantToJsonValue(it.Value()));
 	}
 
-	TSharedPtr<FJsonObject> contextConfig;
+	// Only the modified context is serialized, the rest of the config is reused as is
+	FString contextConfig = SentryCrashReporterJson::SerializeObject(valuesConfig);
+
+	FScopeLock lock(&criticalSection);
+	contexts.Add(key, MoveTemp(contextConfig));
+	isDirty = true;
+}
 
-	if (crashReporterConfig->HasField(TEXT("contexts")))
+void FGenericPlatformSentryCrashReporter::RemoveContext(const FString& key)
+{
+	FScopeLock lock(&criticalSection);
+	if (contexts.Remove(key) > 0)
 	{
-		contextConfig = crashReporterConfig->GetObjectField(TEXT("contexts"));
-		contextConfig->SetObjectField(key, valuesConfig);
+		isDirty = true;
 	}
-	else
+}
+
+void FGenericPlatformSentryCrashReporter::SetTag(const FString& key, const FString& value)
+{
+	FScopeLock lock(&criticalSection);
+	tags.Add(key, value);
+	isDirty = true;
+}
+
+void FGenericPlatformSentryCrashReporter::RemoveTag(const FString& key)
+{
+	FScopeLock lock(&criticalSection);
+	if (tags.Remove(key) > 0)
 	{
-		contextConfig = MakeShareable(new FJsonObject);
-		contextConfig->SetObjectField(key, valuesConfig);
-		crashReporterConfig->SetObjectField(TEXT("contexts"), contextConfig);
+		isDirty = true;
 	}
+}
 
-	crashReporterConfig->SetObjectField(TEXT("contexts"), contextConfig);
+void FGenericPlatformSentryCrashReporter::UpdateCrashReporterConfig(bool bCanBlock)
+{
+	if (bCanBlock)
+	{
+		criticalSection.Lock();
+	}
+	else if (!criticalSection.TryLock())
+	{
+		return;
+	}
+
+	if (!isDirty)
+	{
+		criticalSection.Unlock();
+		return;
+	}
+
+	const FString config = SerializeConfig();
+	isDirty = false;
+
+	criticalSection.Unlock();
 
-	UpdateCrashReporterConfig();
+	FGenericCrashContext::SetGameData(TEXT("__sentry"), config);
 }
 
-void FGenericPlatformSentryCrashReporter::SetTag(const FString& key, const FString& value)
+FString FGenericPlatformSentryCrashReporter::SerializeConfig() const
 {
-	TSharedPtr<FJsonObject> tagsConfig;
+	FString config;
+	config.Reserve(256 + tags.Num() * 32 + contexts.Num() * 128);
+
+	bool isFirst = true;
+
+	config.AppendChar(TEXT('{'));
 
-	if (crashReporterConfig->HasField(TEXT("tags")))
+	if (!releaseConfig.IsEmpty())
 	{
-		tagsConfig = crashReporterConfig->GetObjectField(TEXT("tags"));
-		tagsConfig->SetStringField(key, value);
+		SentryCrashReporterJson::AppendStringField(config, isFirst, TEXT("release"), releaseConfig);
 	}
-	else
+
+	if (!environmentConfig.IsEmpty())
 	{
-		tagsConfig = MakeShareable(new FJsonObject);
-		tagsConfig->SetStringField(key, value);
-		crashReporterConfig->SetObjectField(TEXT("tags"), tagsConfig);
+		SentryCrashReporterJson::AppendStringField(config, isFirst, TEXT("environment"), environmentConfig);
 	}
 
-	UpdateCrashReporterConfig();
-}
+	if (hasUser)
+	{
+		config.Append(isFirst ? TEXT("\"user\":{") : TEXT(",\"user\":{"));
+		isFirst = false;
 
-void FGenericPlatformSentryCrashReporter::RemoveTag(const FString& key)
-{
-	TSharedPtr<FJsonObject> tagsConfig;
+		bool isFirstField = true;
+		for (const auto& field : userConfig)
+		{
+			SentryCrashReporterJson::AppendStringField(config, isFirstField, field.Key, field.Value);
+		}
 
-	if (crashReporterConfig->HasField(TEXT("tags")))
+		config.AppendChar(TEXT('}'));
+	}
+
+	if (contexts.Num() > 0)
 	{
-		tagsConfig = crashReporterConfig->GetObjectField(TEXT("tags"));
-		tagsConfig->RemoveField(key);
+		config.Append(isFirst ? TEXT("\"contexts\":{") : TEXT(",\"contexts\":{"));
+		isFirst = false;
+
+		bool isFirstContext = true;
+		for (const auto& context : contexts)
+		{
+			if (!isFirstContext)
+			{
+				config.AppendChar(TEXT(','));
+			}
+
+			isFirstContext = false;
+
+			SentryCrashReporterJson::AppendString(config, context.Key);
+			config.AppendChar(TEXT(':'));
+			config.Append(context.Value);
+		}
+
+		config.AppendChar(TEXT('}'));
 	}
 
-	UpdateCrashReporterConfig();
-}
+	if (tags.Num() > 0)
+	{
+		config.Append(isFirst ? TEXT("\"tags\":{") : TEXT(",\"tags\":{"));
+		isFirst = false;
 
-void FGenericPlatformSentryCrashReporter::UpdateCrashReporterConfig()
-{
-	FString config;
-	TSharedRef<TJsonWriter<>> jsonWriter = TJsonWriterFactory<>::Create(&config);
-	FJsonSerializer::Serialize(crashReporterConfig.ToSharedRef(), jsonWriter);
+		bool isFirstTag = true;
+		for (const auto& tag : tags)
+		{
+			SentryCrashReporterJson::AppendStringField(config, isFirstTag, tag.Key, tag.Value);
+		}
 
-	FGenericCrashContext::SetGameData(TEXT("__sentry"), config);
+		config.AppendChar(TEXT('}'));
+	}
+
+	config.AppendChar(TEXT('}'));
+
+	return config;
 }
 
-#endif
\ No newline at end of file
+#endif
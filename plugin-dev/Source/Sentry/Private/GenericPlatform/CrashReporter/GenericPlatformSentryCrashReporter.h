@@ -3,32 +3,55 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "SentryVariant.h"
 
 #if USE_SENTRY_NATIVE
 
 class FGenericPlatformSentryUser;
 
-class FJsonObject;
-
 class FGenericPlatformSentryCrashReporter
 {
 public:
 	FGenericPlatformSentryCrashReporter();
+	~FGenericPlatformSentryCrashReporter();
 
 	void SetRelease(const FString& release);
 	void SetEnvironment(const FString& environment);
 	void SetUser(TSharedPtr<FGenericPlatformSentryUser> user);
 	void RemoveUser();
 	void SetContext(const FString& key, const TMap<FString, FSentryVariant>& values);
+	void RemoveContext(const FString& key);
 	void SetTag(const FString& key, const FString& value);
 	void RemoveTag(const FString& key);
 
-protected:
-	void UpdateCrashReporterConfig();
+	/**
+	 * Writes the config to the crash context if it was modified since the last update.
+	 * Mutations only mark the config as dirty so this is expected to be called once per frame and before the crash context is written.
+	 *
+	 * @param bCanBlock Whether to wait for a concurrent mutation to finish instead of skipping the update.
+	 */
+	void UpdateCrashReporterConfig(bool bCanBlock = true);
 
 private:
-	TSharedPtr<FJsonObject> crashReporterConfig;
+	FString SerializeConfig() const;
+
+	mutable FCriticalSection criticalSection;
+
+	bool isDirty;
+
+	FString releaseConfig;
+	FString environmentConfig;
+
+	bool hasUser;
+	TMap<FString, FString> userConfig;
+
+	TMap<FString, FString> tags;
+
+	/** Values of each context pre-serialized to a condensed JSON object */
+	TMap<FString, FString> contexts;
+
+	FDelegateHandle onHandleSystemErrorDelegateHandle;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryMemoryAccounting.h"
+
+#include "HAL/UnrealMemory.h"
+
+#if USE_SENTRY_NATIVE
+
+// Allocation hooks sentry-native's `sentry_malloc`/`sentry_free` are redirected to when the SDK is built with
+// scripts/sentry-native-allocator.cmake. Routing them through FMemory makes the SDK's value trees, envelopes and
+// breadcrumbs visible to Memory Insights and accounted under the Sentry LLM tag.
+// Libraries built without the hooks simply leave these unreferenced.
+
+#if SENTRY_MEMORY_ACCOUNTING
+
+namespace SentryAllocator
+{
+	/** Precedes every allocation so that it's attributed to the same component when freed, sized to keep the allocation aligned. */
+	struct alignas(16) FHeader
+	{
+		uint32 Size;
+		ESentryMemoryComponent Component;
+	};
+}
+
+extern "C" void* sentry_unreal_malloc(size_t size)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	SentryAllocator::FHeader* Header = static_cast<SentryAllocator::FHeader*>(FMemory::Malloc(sizeof(SentryAllocator::FHeader) + size));
+	if (!Header)
+	{
+		return nullptr;
+	}
+
+	Header->Size = static_cast<uint32>(size);
+	Header->Component = SentryMemoryAccounting::GetCurrentComponent();
+	SentryMemoryAccounting::AddNativeBytes(Header->Component, Header->Size);
+	SentryMemoryAccounting::MarkNativeHeapTracked();
+
+	return Header + 1;
+}
+
+extern "C" void sentry_unreal_free(void* ptr)
+{
+	if (!ptr)
+	{
+		return;
+	}
+
+	SentryAllocator::FHeader* Header = static_cast<SentryAllocator::FHeader*>(ptr) - 1;
+	SentryMemoryAccounting::AddNativeBytes(Header->Component, -static_cast<int64>(Header->Size));
+
+	FMemory::Free(Header);
+}
+
+#else
+
+extern "C" void* sentry_unreal_malloc(size_t size)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	return FMemory::Malloc(size);
+}
+
+extern "C" void sentry_unreal_free(void* ptr)
+{
+	FMemory::Free(ptr);
+}
+
+#endif // SENTRY_MEMORY_ACCOUNTING
+
+#endif // USE_SENTRY_NATIVE
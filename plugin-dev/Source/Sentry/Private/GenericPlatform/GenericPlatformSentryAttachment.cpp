@@ -2,21 +2,34 @@
 
 #include "GenericPlatformSentryAttachment.h"
 
+#include "Utils/SentryMemoryAccounting.h"
+#include "Utils/SentryStats.h"
+
 #if USE_SENTRY_NATIVE
 
 FGenericPlatformSentryAttachment::FGenericPlatformSentryAttachment(const TArray<uint8>& data, const FString& filename, const FString& contentType)
-	: Data(data), Filename(filename), ContentType(contentType), Attachment(nullptr)
+	: Data(data), Filename(filename), ContentType(contentType), Attachment(nullptr), AccountedSize(0)
+{
+	INC_MEMORY_STAT_BY(STAT_SentryAttachmentMemory, Data.GetAllocatedSize());
+	SentryMemoryAccounting::AddAttachmentBytes(Data.GetAllocatedSize());
+}
+
+FGenericPlatformSentryAttachment::FGenericPlatformSentryAttachment(TArray<uint8>&& data, const FString& filename, const FString& contentType)
+	: Data(MoveTemp(data)), Filename(filename), ContentType(contentType), Attachment(nullptr), AccountedSize(0)
 {
+	INC_MEMORY_STAT_BY(STAT_SentryAttachmentMemory, Data.GetAllocatedSize());
+	SentryMemoryAccounting::AddAttachmentBytes(Data.GetAllocatedSize());
 }
 
 FGenericPlatformSentryAttachment::FGenericPlatformSentryAttachment(const FString& path, const FString& filename, const FString& contentType)
-	: Path(path), Filename(filename), ContentType(contentType), Attachment(nullptr)
+	: Path(path), Filename(filename), ContentType(contentType), Attachment(nullptr), AccountedSize(0)
 {
 }
 
 FGenericPlatformSentryAttachment::~FGenericPlatformSentryAttachment()
 {
-	// Put custom destructor logic here if needed
+	DEC_MEMORY_STAT_BY(STAT_SentryAttachmentMemory, Data.GetAllocatedSize());
+	SentryMemoryAccounting::AddAttachmentBytes(-static_cast<int64>(Data.GetAllocatedSize()));
 }
 
 void FGenericPlatformSentryAttachment::SetNativeObject(sentry_attachment_t* attachment)
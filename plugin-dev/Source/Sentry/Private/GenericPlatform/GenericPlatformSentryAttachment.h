@@ -12,6 +12,7 @@ class FGenericPlatformSentryAttachment : public ISentryAttachment
 {
 public:
 	FGenericPlatformSentryAttachment(const TArray<uint8>& data, const FString& filename, const FString& contentType);
+	FGenericPlatformSentryAttachment(TArray<uint8>&& data, const FString& filename, const FString& contentType);
 	FGenericPlatformSentryAttachment(const FString& path, const FString& filename, const FString& contentType);
 	virtual ~FGenericPlatformSentryAttachment() override;
 
@@ -25,6 +26,10 @@ public:
 
 	const TArray<uint8>& GetDataByRef() const;
 
+	/** Size counted towards the global attachments size while the attachment is on the scope. */
+	void SetAccountedSize(int64 size) { AccountedSize = size; }
+	int64 GetAccountedSize() const { return AccountedSize; }
+
 private:
 	TArray<uint8> Data;
 	FString Path;
@@ -32,6 +37,8 @@ private:
 	FString ContentType;
 
 	sentry_attachment_t* Attachment;
+
+	int64 AccountedSize;
 };
 
 typedef FGenericPlatformSentryAttachment FPlatformSentryAttachment;
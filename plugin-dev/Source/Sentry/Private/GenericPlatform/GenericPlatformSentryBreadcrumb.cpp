@@ -4,11 +4,14 @@
 
 #include "Infrastructure/GenericPlatformSentryConverters.h"
 
+#include "Utils/SentryMonotonicClock.h"
+
 #if USE_SENTRY_NATIVE
 
 FGenericPlatformSentryBreadcrumb::FGenericPlatformSentryBreadcrumb()
 {
 	Breadcrumb = sentry_value_new_breadcrumb("", "");
+	sentry_value_set_by_key(Breadcrumb, "timestamp", FGenericPlatformSentryConverters::TimestampToNative(FSentryMonotonicClock::GetProcessTimestamp()));
 }
 
 FGenericPlatformSentryBreadcrumb::FGenericPlatformSentryBreadcrumb(sentry_value_t breadcrumb)
@@ -34,7 +37,7 @@ FString FGenericPlatformSentryBreadcrumb::GetMessage() const
 
 void FGenericPlatformSentryBreadcrumb::SetType(const FString& type)
 {
-	sentry_value_set_by_key(Breadcrumb, "type", sentry_value_new_string(TCHAR_TO_ANSI(*type)));
+	sentry_value_set_by_key(Breadcrumb, "type", sentry_value_new_string(TCHAR_TO_UTF8(*type)));
 }
 
 FString FGenericPlatformSentryBreadcrumb::GetType() const
@@ -45,7 +48,7 @@ FString FGenericPlatformSentryBreadcrumb::GetType() const
 
 void FGenericPlatformSentryBreadcrumb::SetCategory(const FString& category)
 {
-	sentry_value_set_by_key(Breadcrumb, "category", sentry_value_new_string(TCHAR_TO_ANSI(*category)));
+	sentry_value_set_by_key(Breadcrumb, "category", sentry_value_new_string(TCHAR_TO_UTF8(*category)));
 }
 
 FString FGenericPlatformSentryBreadcrumb::GetCategory() const
@@ -69,7 +72,7 @@ void FGenericPlatformSentryBreadcrumb::SetLevel(ESentryLevel level)
 {
 	FString levelStr = FGenericPlatformSentryConverters::SentryLevelToString(level);
 	if (!levelStr.IsEmpty())
-		sentry_value_set_by_key(Breadcrumb, "level", sentry_value_new_string(TCHAR_TO_ANSI(*levelStr)));
+		sentry_value_set_by_key(Breadcrumb, "level", sentry_value_new_string(TCHAR_TO_UTF8(*levelStr)));
 }
 
 ESentryLevel FGenericPlatformSentryBreadcrumb::GetLevel() const
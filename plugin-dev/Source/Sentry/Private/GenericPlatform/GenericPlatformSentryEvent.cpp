@@ -37,6 +37,11 @@ TSharedPtr<ISentryId> FGenericPlatformSentryEvent::GetId() const
 	return MakeShareable(new FGenericPlatformSentryId(uuid));
 }
 
+void FGenericPlatformSentryEvent::SetId(const FString& id)
+{
+	sentry_value_set_by_key(Event, "event_id", sentry_value_new_string(TCHAR_TO_UTF8(*id)));
+}
+
 void FGenericPlatformSentryEvent::SetMessage(const FString& message)
 {
 	sentry_value_t messageСontainer = sentry_value_new_object();
@@ -55,7 +60,7 @@ void FGenericPlatformSentryEvent::SetLevel(ESentryLevel level)
 {
 	FString levelStr = FGenericPlatformSentryConverters::SentryLevelToString(level).ToLower();
 	if (!levelStr.IsEmpty())
-		sentry_value_set_by_key(Event, "level", sentry_value_new_string(TCHAR_TO_ANSI(*levelStr)));
+		sentry_value_set_by_key(Event, "level", sentry_value_new_string(TCHAR_TO_UTF8(*levelStr)));
 }
 
 ESentryLevel FGenericPlatformSentryEvent::GetLevel() const
@@ -84,7 +89,7 @@ void FGenericPlatformSentryEvent::SetTag(const FString& key, const FString& valu
 	}
 	else
 	{
-		sentry_value_set_by_key(eventTags, TCHAR_TO_ANSI(*key), sentry_value_new_string(TCHAR_TO_ANSI(*value)));
+		sentry_value_set_by_key(eventTags, TCHAR_TO_UTF8(*key), sentry_value_new_string(TCHAR_TO_UTF8(*value)));
 	}
 }
 
@@ -96,7 +101,7 @@ FString FGenericPlatformSentryEvent::GetTag(const FString& key) const
 		return FString();
 	}
 
-	sentry_value_t tag = sentry_value_get_by_key(eventTags, TCHAR_TO_ANSI(*key));
+	sentry_value_t tag = sentry_value_get_by_key(eventTags, TCHAR_TO_UTF8(*key));
 	return FString(sentry_value_as_string(tag));
 }
 
@@ -108,7 +113,7 @@ bool FGenericPlatformSentryEvent::TryGetTag(const FString& key, FString& value)
 		return false;
 	}
 
-	sentry_value_t tag = sentry_value_get_by_key(eventTags, TCHAR_TO_ANSI(*key));
+	sentry_value_t tag = sentry_value_get_by_key(eventTags, TCHAR_TO_UTF8(*key));
 	if (sentry_value_is_null(tag))
 	{
 		return false;
@@ -127,7 +132,7 @@ void FGenericPlatformSentryEvent::RemoveTag(const FString& key)
 		return;
 	}
 
-	sentry_value_remove_by_key(eventTags, TCHAR_TO_ANSI(*key));
+	sentry_value_remove_by_key(eventTags, TCHAR_TO_UTF8(*key));
 }
 
 void FGenericPlatformSentryEvent::SetTags(const TMap<FString, FString>& tags)
@@ -147,13 +152,13 @@ void FGenericPlatformSentryEvent::SetContext(const FString& key, const TMap<FStr
 	{
 		eventContexts = sentry_value_new_object();
 
-		sentry_value_set_by_key(eventContexts, TCHAR_TO_ANSI(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
+		sentry_value_set_by_key(eventContexts, TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
 
 		sentry_value_set_by_key(Event, "contexts", eventContexts);
 	}
 	else
 	{
-		sentry_value_set_by_key(eventContexts, TCHAR_TO_ANSI(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
+		sentry_value_set_by_key(eventContexts, TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
 	}
 }
 
@@ -165,7 +170,7 @@ TMap<FString, FSentryVariant> FGenericPlatformSentryEvent::GetContext(const FStr
 		return TMap<FString, FSentryVariant>();
 	}
 
-	sentry_value_t context = sentry_value_get_by_key(eventContexts, TCHAR_TO_ANSI(*key));
+	sentry_value_t context = sentry_value_get_by_key(eventContexts, TCHAR_TO_UTF8(*key));
 	if (sentry_value_is_null(context))
 	{
 		return TMap<FString, FSentryVariant>();
@@ -184,7 +189,7 @@ bool FGenericPlatformSentryEvent::TryGetContext(const FString& key, TMap<FString
 		return false;
 	}
 
-	sentry_value_t context = sentry_value_get_by_key(eventContexts, TCHAR_TO_ANSI(*key));
+	sentry_value_t context = sentry_value_get_by_key(eventContexts, TCHAR_TO_UTF8(*key));
 	if (sentry_value_is_null(context))
 	{
 		return false;
@@ -209,7 +214,7 @@ void FGenericPlatformSentryEvent::RemoveContext(const FString& key)
 		return;
 	}
 
-	sentry_value_remove_by_key(eventContexts, TCHAR_TO_ANSI(*key));
+	sentry_value_remove_by_key(eventContexts, TCHAR_TO_UTF8(*key));
 }
 
 void FGenericPlatformSentryEvent::SetExtra(const FString& key, const FSentryVariant& value)
@@ -221,7 +226,7 @@ void FGenericPlatformSentryEvent::SetExtra(const FString& key, const FSentryVari
 	}
 	else
 	{
-		sentry_value_set_by_key(eventExtra, TCHAR_TO_ANSI(*key), FGenericPlatformSentryConverters::VariantToNative(value));
+		sentry_value_set_by_key(eventExtra, TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantToNative(value));
 	}
 }
 
@@ -233,7 +238,7 @@ FSentryVariant FGenericPlatformSentryEvent::GetExtra(const FString& key) const
 		return FSentryVariant();
 	}
 
-	sentry_value_t extra = sentry_value_get_by_key(eventExtra, TCHAR_TO_ANSI(*key));
+	sentry_value_t extra = sentry_value_get_by_key(eventExtra, TCHAR_TO_UTF8(*key));
 	return FGenericPlatformSentryConverters::VariantToUnreal(extra);
 }
 
@@ -245,7 +250,7 @@ bool FGenericPlatformSentryEvent::TryGetExtra(const FString& key, FSentryVariant
 		return false;
 	}
 
-	sentry_value_t extra = sentry_value_get_by_key(eventExtra, TCHAR_TO_ANSI(*key));
+	sentry_value_t extra = sentry_value_get_by_key(eventExtra, TCHAR_TO_UTF8(*key));
 	if (sentry_value_is_null(extra))
 	{
 		return false;
@@ -264,7 +269,7 @@ void FGenericPlatformSentryEvent::RemoveExtra(const FString& key)
 		return;
 	}
 
-	sentry_value_remove_by_key(eventExtra, TCHAR_TO_ANSI(*key));
+	sentry_value_remove_by_key(eventExtra, TCHAR_TO_UTF8(*key));
 }
 
 void FGenericPlatformSentryEvent::SetExtras(const TMap<FString, FSentryVariant>& extras)
@@ -296,8 +301,62 @@ bool FGenericPlatformSentryEvent::IsCrash() const
 
 bool FGenericPlatformSentryEvent::IsAnr() const
 {
-	// ANR error tracking is not available in `sentry-native`
-	return false;
+	// ANR error tracking is not available in `sentry-native`, hangs are detected by the SDK watchdog instead
+	sentry_value_t exceptions = sentry_value_get_by_key(sentry_value_get_by_key(Event, "exception"), "values");
+	sentry_value_t mechanism = sentry_value_get_by_key(sentry_value_get_by_index(exceptions, 0), "mechanism");
+
+	const char* mechanismType = sentry_value_as_string(sentry_value_get_by_key(mechanism, "type"));
+	return FCStringAnsi::Strcmp(mechanismType, "AppHang") == 0;
+}
+
+TSharedPtr<ISentryEvent> FGenericPlatformSentryEvent::Clone() const
+{
+	// sentry-native has no public API for a deep copy so the event is rebuilt from its converted values
+	sentry_value_t eventCopy = FGenericPlatformSentryConverters::VariantToNative(FGenericPlatformSentryConverters::VariantToUnreal(Event));
+	return MakeShareable(new FGenericPlatformSentryEvent(eventCopy, IsCrashEvent));
+}
+
+static bool TryGetStringView(sentry_value_t value, FAnsiStringView& view)
+{
+	if (sentry_value_get_type(value) != SENTRY_VALUE_TYPE_STRING)
+	{
+		return false;
+	}
+
+	// Strings are owned by the event and stay valid until the value is replaced
+	const char* str = sentry_value_as_string(value);
+	view = FAnsiStringView(str, FCStringAnsi::Strlen(str));
+	return true;
+}
+
+bool FGenericPlatformSentryEvent::TryGetTagUtf8(FAnsiStringView key, FAnsiStringView& value, TArray<TArray<ANSICHAR>>& scratch) const
+{
+	sentry_value_t eventTags = sentry_value_get_by_key(Event, "tags");
+	return TryGetStringView(sentry_value_get_by_key_n(eventTags, key.GetData(), key.Len()), value);
+}
+
+bool FGenericPlatformSentryEvent::TryGetContextValue(const FString& key, const FString& valueKey, FSentryVariant& value) const
+{
+	sentry_value_t eventContexts = sentry_value_get_by_key(Event, "contexts");
+	sentry_value_t context = sentry_value_get_by_key(eventContexts, TCHAR_TO_UTF8(*key));
+
+	sentry_value_t contextValue = sentry_value_get_by_key(context, TCHAR_TO_UTF8(*valueKey));
+	if (sentry_value_is_null(contextValue))
+	{
+		return false;
+	}
+
+	// Only the requested value is converted rather than the whole context
+	value = FGenericPlatformSentryConverters::VariantToUnreal(contextValue);
+
+	return true;
+}
+
+bool FGenericPlatformSentryEvent::TryGetContextStringUtf8(FAnsiStringView key, FAnsiStringView valueKey, FAnsiStringView& value, TArray<TArray<ANSICHAR>>& scratch) const
+{
+	sentry_value_t eventContexts = sentry_value_get_by_key(Event, "contexts");
+	sentry_value_t context = sentry_value_get_by_key_n(eventContexts, key.GetData(), key.Len());
+	return TryGetStringView(sentry_value_get_by_key_n(context, valueKey.GetData(), valueKey.Len()), value);
 }
 
 #endif
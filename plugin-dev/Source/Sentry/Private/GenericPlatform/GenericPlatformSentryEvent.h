@@ -18,6 +18,7 @@ public:
 	sentry_value_t GetNativeObject();
 
 	virtual TSharedPtr<ISentryId> GetId() const override;
+	virtual void SetId(const FString& id) override;
 	virtual void SetMessage(const FString& message) override;
 	virtual FString GetMessage() const override;
 	virtual void SetLevel(ESentryLevel level) override;
@@ -42,6 +43,10 @@ public:
 	virtual TMap<FString, FSentryVariant> GetExtras() const override;
 	virtual bool IsCrash() const override;
 	virtual bool IsAnr() const override;
+	virtual TSharedPtr<ISentryEvent> Clone() const override;
+	virtual bool TryGetTagUtf8(FAnsiStringView key, FAnsiStringView& value, TArray<TArray<ANSICHAR>>& scratch) const override;
+	virtual bool TryGetContextValue(const FString& key, const FString& valueKey, FSentryVariant& value) const override;
+	virtual bool TryGetContextStringUtf8(FAnsiStringView key, FAnsiStringView valueKey, FAnsiStringView& value, TArray<TArray<ANSICHAR>>& scratch) const override;
 
 private:
 	sentry_value_t Event;
@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "GenericPlatformSentryMemoryTransport.h"
+
+#include "Utils/SentryMemoryTransport.h"
+
+#if USE_SENTRY_NATIVE && WITH_AUTOMATION_TESTS
+
+sentry_transport_t* FGenericPlatformSentryMemoryTransport::CreateNativeTransport()
+{
+	return sentry_transport_new(HandleSend);
+}
+
+void FGenericPlatformSentryMemoryTransport::HandleSend(sentry_envelope_t* envelope, void* state)
+{
+	size_t size = 0;
+	char* serialized = sentry_envelope_serialize(envelope, &size);
+	sentry_envelope_free(envelope);
+
+	if (!serialized)
+	{
+		return;
+	}
+
+	SentryMemoryTransport::Record(TArray<uint8>(reinterpret_cast<const uint8*>(serialized), static_cast<int32>(size)));
+
+	sentry_free(serialized);
+}
+
+#endif
@@ -0,0 +1,22 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "Convenience/GenericPlatformSentryInclude.h"
+
+#if USE_SENTRY_NATIVE && WITH_AUTOMATION_TESTS
+
+/**
+ * Native transport handing serialized envelopes over to SentryMemoryTransport instead of sending them.
+ * Envelopes are recorded synchronously on the capturing thread so that specs can inspect them right after capturing.
+ */
+class FGenericPlatformSentryMemoryTransport
+{
+public:
+	static sentry_transport_t* CreateNativeTransport();
+
+private:
+	static void HandleSend(sentry_envelope_t* envelope, void* state);
+};
+
+#endif
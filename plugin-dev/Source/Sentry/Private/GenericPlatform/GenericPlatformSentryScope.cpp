@@ -12,49 +12,72 @@
 
 #include "Infrastructure/GenericPlatformSentryConverters.h"
 
+#include "Utils/SentryTrace.h"
+
+#include "Misc/ScopeLock.h"
+
 #if USE_SENTRY_NATIVE
 
 FGenericPlatformSentryScope::FGenericPlatformSentryScope()
 	: Level(ESentryLevel::Debug)
+	, TagsLimiter(FSentryModule::Get().GetSettings()->MaxScopeTags)
+	, ExtraLimiter(FSentryModule::Get().GetSettings()->MaxScopeExtras)
+	, ContextsLimiter(FSentryModule::Get().GetSettings()->MaxScopeContexts)
+	, MaxContextDepth(FSentryModule::Get().GetSettings()->MaxContextDepth)
+	, MaxContextValues(FSentryModule::Get().GetSettings()->MaxContextValues)
+	, bNativeTagsDirty(true)
+	, NativeFingerprint(sentry_value_new_null())
 {
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	Breadcrumbs.Configure(Settings->MaxBreadcrumbs, Settings->bRetainBreadcrumbsByLevel, Settings->BreadcrumbLevelReservedPercent);
 }
 
 FGenericPlatformSentryScope::~FGenericPlatformSentryScope()
 {
+	ReleaseNative(NativeExtra);
+	ReleaseNative(NativeContexts);
+	ReleaseNativeFingerprint();
 }
 
 void FGenericPlatformSentryScope::AddBreadcrumb(TSharedPtr<ISentryBreadcrumb> breadcrumb)
 {
-	if (Breadcrumbs.Num() >= FSentryModule::Get().GetSettings()->MaxBreadcrumbs)
-	{
-		Breadcrumbs.PopFront();
-	}
+	FScopeLock Lock(&CriticalSection);
 
-	Breadcrumbs.Add(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(breadcrumb));
+	Breadcrumbs.Add(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(breadcrumb), breadcrumb->GetLevel());
 }
 
 void FGenericPlatformSentryScope::ClearBreadcrumbs()
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Breadcrumbs.Empty();
 }
 
 void FGenericPlatformSentryScope::AddAttachment(TSharedPtr<ISentryAttachment> attachment)
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Attachments.Add(StaticCastSharedPtr<FGenericPlatformSentryAttachment>(attachment));
 }
 
 void FGenericPlatformSentryScope::ClearAttachments()
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Attachments.Empty();
 }
 
 void FGenericPlatformSentryScope::SetTag(const FString& key, const FString& value)
 {
-	Tags.Add(key, value);
+	FScopeLock Lock(&CriticalSection);
+
+	SetTagUnlocked(key, value);
 }
 
 FString FGenericPlatformSentryScope::GetTag(const FString& key) const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Tags.Contains(key))
 		return FString();
 
@@ -63,6 +86,8 @@ FString FGenericPlatformSentryScope::GetTag(const FString& key) const
 
 bool FGenericPlatformSentryScope::TryGetTag(const FString& key, FString& value) const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Tags.Contains(key))
 		return false;
 
@@ -72,46 +97,79 @@ bool FGenericPlatformSentryScope::TryGetTag(const FString& key, FString& value)
 
 void FGenericPlatformSentryScope::RemoveTag(const FString& key)
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Tags.Remove(key);
+	TagsLimiter.Remove(key);
+	bNativeTagsDirty = true;
 }
 
 void FGenericPlatformSentryScope::SetTags(const TMap<FString, FString>& tags)
 {
-	Tags.Append(tags);
+	FScopeLock Lock(&CriticalSection);
+
+	for (const auto& TagItem : tags)
+	{
+		SetTagUnlocked(TagItem.Key, TagItem.Value);
+	}
 }
 
 TMap<FString, FString> FGenericPlatformSentryScope::GetTags() const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	return Tags;
 }
 
 void FGenericPlatformSentryScope::SetFingerprint(const TArray<FString>& fingerprint)
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Fingerprint = fingerprint;
+	ReleaseNativeFingerprint();
 }
 
 TArray<FString> FGenericPlatformSentryScope::GetFingerprint() const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	return Fingerprint;
 }
 
 void FGenericPlatformSentryScope::SetLevel(ESentryLevel level)
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Level = level;
 }
 
 ESentryLevel FGenericPlatformSentryScope::GetLevel() const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	return Level;
 }
 
 void FGenericPlatformSentryScope::SetContext(const FString& key, const TMap<FString, FSentryVariant>& values)
 {
-	Contexts.Add(key, values);
+	FScopeLock Lock(&CriticalSection);
+
+	TMap<FString, FSentryVariant>& Context = Contexts.Add(key, values);
+	SentryScopeLimits::TrimContext(Context, MaxContextDepth, MaxContextValues);
+	ReleaseNative(NativeContexts, key);
+
+	FString EvictedKey;
+	if (ContextsLimiter.Touch(key, EvictedKey))
+	{
+		Contexts.Remove(EvictedKey);
+		ReleaseNative(NativeContexts, EvictedKey);
+	}
 }
 
 TMap<FString, FSentryVariant> FGenericPlatformSentryScope::GetContext(const FString& key) const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Contexts.Contains(key))
 		return TMap<FString, FSentryVariant>();
 
@@ -120,6 +178,8 @@ TMap<FString, FSentryVariant> FGenericPlatformSentryScope::GetContext(const FStr
 
 bool FGenericPlatformSentryScope::TryGetContext(const FString& key, TMap<FString, FSentryVariant>& value) const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Contexts.Contains(key))
 		return false;
 
@@ -129,19 +189,27 @@ bool FGenericPlatformSentryScope::TryGetContext(const FString& key, TMap<FString
 
 void FGenericPlatformSentryScope::RemoveContext(const FString& key)
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Contexts.Contains(key))
 		return;
 
 	Contexts.Remove(key);
+	ContextsLimiter.Remove(key);
+	ReleaseNative(NativeContexts, key);
 }
 
 void FGenericPlatformSentryScope::SetExtra(const FString& key, const FSentryVariant& value)
 {
-	Extra.Add(key, value);
+	FScopeLock Lock(&CriticalSection);
+
+	SetExtraUnlocked(key, value);
 }
 
 FSentryVariant FGenericPlatformSentryScope::GetExtra(const FString& key) const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Extra.Contains(key))
 		return FSentryVariant();
 
@@ -150,6 +218,8 @@ FSentryVariant FGenericPlatformSentryScope::GetExtra(const FString& key) const
 
 bool FGenericPlatformSentryScope::TryGetExtra(const FString& key, FSentryVariant& value) const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Extra.Contains(key))
 		return false;
 
@@ -159,24 +229,37 @@ bool FGenericPlatformSentryScope::TryGetExtra(const FString& key, FSentryVariant
 
 void FGenericPlatformSentryScope::RemoveExtra(const FString& key)
 {
+	FScopeLock Lock(&CriticalSection);
+
 	if (!Extra.Contains(key))
 		return;
 
 	Extra.Remove(key);
+	ExtraLimiter.Remove(key);
+	ReleaseNative(NativeExtra, key);
 }
 
 void FGenericPlatformSentryScope::SetExtras(const TMap<FString, FSentryVariant>& extras)
 {
-	Extra.Append(extras);
+	FScopeLock Lock(&CriticalSection);
+
+	for (const auto& ExtraItem : extras)
+	{
+		SetExtraUnlocked(ExtraItem.Key, ExtraItem.Value);
+	}
 }
 
 TMap<FString, FSentryVariant> FGenericPlatformSentryScope::GetExtras() const
 {
+	FScopeLock Lock(&CriticalSection);
+
 	return Extra;
 }
 
 void FGenericPlatformSentryScope::Clear()
 {
+	FScopeLock Lock(&CriticalSection);
+
 	Dist = FString();
 	Environment = FString();
 	Fingerprint.Empty();
@@ -185,16 +268,29 @@ void FGenericPlatformSentryScope::Clear()
 	Contexts.Empty();
 	Breadcrumbs.Empty();
 	Level = ESentryLevel::Debug;
+
+	TagsLimiter.Reset();
+	ExtraLimiter.Reset();
+	ContextsLimiter.Reset();
+
+	NativeTags.Empty();
+	bNativeTagsDirty = true;
+	ReleaseNative(NativeExtra);
+	ReleaseNative(NativeContexts);
+	ReleaseNativeFingerprint();
 }
 
 void FGenericPlatformSentryScope::Apply(sentry_scope_t* scope)
 {
+	SENTRY_TRACE_SCOPE(ApplyScope);
+
+	FScopeLock Lock(&CriticalSection);
 
-	for (const auto& Breadcrumb : Breadcrumbs)
+	Breadcrumbs.ForEach([scope](const TSharedPtr<FGenericPlatformSentryBreadcrumb>& Breadcrumb)
 	{
 		sentry_value_t nativeBreadcrumb = Breadcrumb->GetNativeObject();
 		sentry_scope_add_breadcrumb(scope, nativeBreadcrumb);
-	}
+	});
 
 	for (auto& Attachment : Attachments)
 	{
@@ -210,27 +306,127 @@ void FGenericPlatformSentryScope::Apply(sentry_scope_t* scope)
 
 	if (Fingerprint.Num() > 0)
 	{
-		sentry_scope_set_fingerprints(scope, FGenericPlatformSentryConverters::StringArrayToNative(Fingerprint));
+		if (sentry_value_is_null(NativeFingerprint))
+		{
+			NativeFingerprint = FGenericPlatformSentryConverters::StringArrayToNative(Fingerprint);
+			sentry_value_freeze(NativeFingerprint);
+		}
+
+		// Native scope takes ownership of the passed reference while the cache keeps its own
+		sentry_value_incref(NativeFingerprint);
+		sentry_scope_set_fingerprints(scope, NativeFingerprint);
+	}
+
+	if (bNativeTagsDirty)
+	{
+		NativeTags.Reset(Tags.Num());
+
+		for (const auto& TagItem : Tags)
+		{
+			FTCHARToUTF8 KeyConverter(*TagItem.Key);
+			FTCHARToUTF8 ValueConverter(*TagItem.Value);
+
+			TPair<TArray<ANSICHAR>, TArray<ANSICHAR>>& NativeTag = NativeTags.AddDefaulted_GetRef();
+			NativeTag.Key.Append(KeyConverter.Get(), KeyConverter.Length() + 1);
+			NativeTag.Value.Append(ValueConverter.Get(), ValueConverter.Length() + 1);
+		}
+
+		bNativeTagsDirty = false;
 	}
 
-	for (const auto& TagItem : Tags)
+	for (const auto& NativeTag : NativeTags)
 	{
-		sentry_scope_set_tag(scope, TCHAR_TO_UTF8(*TagItem.Key), TCHAR_TO_UTF8(*TagItem.Value));
+		sentry_scope_set_tag(scope, NativeTag.Key.GetData(), NativeTag.Value.GetData());
 	}
 
 	for (const auto& ExtraItem : Extra)
 	{
-		sentry_scope_set_extra(scope, TCHAR_TO_UTF8(*ExtraItem.Key), FGenericPlatformSentryConverters::VariantToNative(ExtraItem.Value));
+		sentry_value_t* NativeValue = NativeExtra.Find(ExtraItem.Key);
+		if (!NativeValue)
+		{
+			NativeValue = &NativeExtra.Add(ExtraItem.Key, FGenericPlatformSentryConverters::VariantToNative(ExtraItem.Value));
+			sentry_value_freeze(*NativeValue);
+		}
+
+		sentry_value_incref(*NativeValue);
+		sentry_scope_set_extra(scope, TCHAR_TO_UTF8(*ExtraItem.Key), *NativeValue);
 	}
 
 	for (const auto& ContextsItem : Contexts)
 	{
-		sentry_scope_set_context(scope, TCHAR_TO_UTF8(*ContextsItem.Key), FGenericPlatformSentryConverters::VariantMapToNative(ContextsItem.Value));
+		sentry_value_t* NativeValue = NativeContexts.Find(ContextsItem.Key);
+		if (!NativeValue)
+		{
+			NativeValue = &NativeContexts.Add(ContextsItem.Key, FGenericPlatformSentryConverters::VariantMapToNative(ContextsItem.Value));
+			sentry_value_freeze(*NativeValue);
+		}
+
+		sentry_value_incref(*NativeValue);
+		sentry_scope_set_context(scope, TCHAR_TO_UTF8(*ContextsItem.Key), *NativeValue);
 	}
 
 	sentry_scope_set_level(scope, FGenericPlatformSentryConverters::SentryLevelToNative(Level));
 }
 
+bool FGenericPlatformSentryScope::IsEmpty() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	// Level is always applied so a scope with a non-default one isn't empty
+	return Breadcrumbs.Num() == 0 && Attachments.Num() == 0 && Fingerprint.Num() == 0 && Tags.Num() == 0 && Extra.Num() == 0 && Contexts.Num() == 0
+		&& Level == ESentryLevel::Debug;
+}
+
+void FGenericPlatformSentryScope::ReleaseNative(TMap<FString, sentry_value_t>& NativeValues, const FString& Key)
+{
+	sentry_value_t NativeValue;
+	if (NativeValues.RemoveAndCopyValue(Key, NativeValue))
+	{
+		sentry_value_decref(NativeValue);
+	}
+}
+
+void FGenericPlatformSentryScope::ReleaseNative(TMap<FString, sentry_value_t>& NativeValues)
+{
+	for (const auto& NativeItem : NativeValues)
+	{
+		sentry_value_decref(NativeItem.Value);
+	}
+
+	NativeValues.Empty();
+}
+
+void FGenericPlatformSentryScope::ReleaseNativeFingerprint()
+{
+	sentry_value_decref(NativeFingerprint);
+	NativeFingerprint = sentry_value_new_null();
+}
+
+void FGenericPlatformSentryScope::SetTagUnlocked(const FString& key, const FString& value)
+{
+	Tags.Add(key, value);
+	bNativeTagsDirty = true;
+
+	FString EvictedKey;
+	if (TagsLimiter.Touch(key, EvictedKey))
+	{
+		Tags.Remove(EvictedKey);
+	}
+}
+
+void FGenericPlatformSentryScope::SetExtraUnlocked(const FString& key, const FSentryVariant& value)
+{
+	Extra.Add(key, value);
+	ReleaseNative(NativeExtra, key);
+
+	FString EvictedKey;
+	if (ExtraLimiter.Touch(key, EvictedKey))
+	{
+		Extra.Remove(EvictedKey);
+		ReleaseNative(NativeExtra, EvictedKey);
+	}
+}
+
 void FGenericPlatformSentryScope::AddFileAttachment(TSharedPtr<FGenericPlatformSentryAttachment> attachment, sentry_scope_t* scope)
 {
 	sentry_attachment_t* nativeAttachment =
@@ -2,11 +2,14 @@
 
 #pragma once
 
-#include "Containers/RingBuffer.h"
+#include "HAL/CriticalSection.h"
 #include "Convenience/GenericPlatformSentryInclude.h"
 
 #include "Interface/SentryScopeInterface.h"
 
+#include "Utils/SentryBreadcrumbRetention.h"
+#include "Utils/SentryScopeLimiter.h"
+
 #if USE_SENTRY_NATIVE
 
 class FGenericPlatformSentryAttachment;
@@ -47,11 +50,21 @@ public:
 
 	void Apply(sentry_scope_t* scope);
 
+	/** Checks whether the scope has anything that Apply would write to a native scope. */
+	bool IsEmpty() const;
+
 protected:
 	virtual void AddFileAttachment(TSharedPtr<FGenericPlatformSentryAttachment> attachment, sentry_scope_t* scope);
 	virtual void AddByteAttachment(TSharedPtr<FGenericPlatformSentryAttachment> attachment, sentry_scope_t* scope);
 
 private:
+	static void ReleaseNative(TMap<FString, sentry_value_t>& NativeValues, const FString& Key);
+	static void ReleaseNative(TMap<FString, sentry_value_t>& NativeValues);
+	void ReleaseNativeFingerprint();
+
+	void SetTagUnlocked(const FString& key, const FString& value);
+	void SetExtraUnlocked(const FString& key, const FSentryVariant& value);
+
 	FString Dist;
 	FString Environment;
 
@@ -62,11 +75,34 @@ private:
 
 	TMap<FString, TMap<FString, FSentryVariant>> Contexts;
 
-	TRingBuffer<TSharedPtr<FGenericPlatformSentryBreadcrumb>> Breadcrumbs;
+	/** Keeps the warnings and errors when bursts of less important breadcrumbs exceed the budget */
+	TSentryBreadcrumbRetention<TSharedPtr<FGenericPlatformSentryBreadcrumb>> Breadcrumbs;
 
 	TArray<TSharedPtr<FGenericPlatformSentryAttachment>> Attachments;
 
 	ESentryLevel Level;
+
+	/** Keep the collections within the scope limits configured in plugin settings */
+	FSentryScopeKeyLimiter TagsLimiter;
+	FSentryScopeKeyLimiter ExtraLimiter;
+	FSentryScopeKeyLimiter ContextsLimiter;
+	int32 MaxContextDepth;
+	int32 MaxContextValues;
+
+	/** Scopes can be configured and applied from any thread, e.g. when captures are triggered from worker threads. */
+	mutable FCriticalSection CriticalSection;
+
+	/**
+	 * Native representation of the scope cached by Apply and reused until the corresponding entries change,
+	 * so that applying the same scope again only converts what was modified since. Cached values are frozen
+	 * as they are shared with every native scope they were applied to.
+	 */
+	TArray<TPair<TArray<ANSICHAR>, TArray<ANSICHAR>>> NativeTags;
+	bool bNativeTagsDirty;
+
+	TMap<FString, sentry_value_t> NativeExtra;
+	TMap<FString, sentry_value_t> NativeContexts;
+	sentry_value_t NativeFingerprint;
 };
 
 #if !PLATFORM_MICROSOFT
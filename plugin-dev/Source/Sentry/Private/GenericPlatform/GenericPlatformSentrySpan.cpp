@@ -12,9 +12,11 @@ void CopySpanTracingHeader(const char* key, const char* value, void* userdata)
 	sentry_value_set_by_key(*header, key, sentry_value_new_string(value));
 }
 
-FGenericPlatformSentrySpan::FGenericPlatformSentrySpan(sentry_span_t* span)
+FGenericPlatformSentrySpan::FGenericPlatformSentrySpan(sentry_span_t* span, bool sampled, const FSentryMonotonicClock& clock)
 	: Span(span)
+	, Clock(clock)
 	, isFinished(false)
+	, isSampled(sampled)
 {
 }
 
@@ -23,16 +25,38 @@ sentry_span_t* FGenericPlatformSentrySpan::GetNativeObject()
 	return Span;
 }
 
+sentry_span_t* FGenericPlatformSentrySpan::StartNativeChild(const char* operation, const char* description)
+{
+	if (!isSampled)
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	return sentry_span_start_child_ts(Span, operation, description, Clock.GetTimestamp());
+}
+
+bool FGenericPlatformSentrySpan::IsSampled() const
+{
+	return isSampled;
+}
+
+const FSentryMonotonicClock& FGenericPlatformSentrySpan::GetClock() const
+{
+	return Clock;
+}
+
 TSharedPtr<ISentrySpan> FGenericPlatformSentrySpan::StartChild(const FString& operation, const FString& description, bool bindToScope)
 {
-	if (sentry_span_t* nativeSpan = sentry_span_start_child(Span, TCHAR_TO_ANSI(*operation), TCHAR_TO_ANSI(*description)))
+	if (sentry_span_t* nativeSpan = sentry_span_start_child_ts(Span, TCHAR_TO_UTF8(*operation), TCHAR_TO_UTF8(*description), Clock.GetTimestamp()))
 	{
 		if (bindToScope)
 		{
 			sentry_set_span(nativeSpan);
 		}
 
-		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan));
+		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan, isSampled, Clock));
 	}
 	else
 	{
@@ -42,14 +66,14 @@ TSharedPtr<ISentrySpan> FGenericPlatformSentrySpan::StartChild(const FString& op
 
 TSharedPtr<ISentrySpan> FGenericPlatformSentrySpan::StartChildWithTimestamp(const FString& operation, const FString& description, int64 timestamp, bool bindToScope)
 {
-	if (sentry_span_t* nativeSpan = sentry_span_start_child_ts(Span, TCHAR_TO_ANSI(*operation), TCHAR_TO_ANSI(*description), timestamp))
+	if (sentry_span_t* nativeSpan = sentry_span_start_child_ts(Span, TCHAR_TO_UTF8(*operation), TCHAR_TO_UTF8(*description), timestamp))
 	{
 		if (bindToScope)
 		{
 			sentry_set_span(nativeSpan);
 		}
 
-		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan));
+		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan, isSampled, Clock));
 	}
 	else
 	{
@@ -59,7 +83,7 @@ TSharedPtr<ISentrySpan> FGenericPlatformSentrySpan::StartChildWithTimestamp(cons
 
 void FGenericPlatformSentrySpan::Finish()
 {
-	sentry_span_finish(Span);
+	sentry_span_finish_ts(Span, Clock.GetTimestamp());
 
 	isFinished = true;
 }
@@ -80,28 +104,28 @@ void FGenericPlatformSentrySpan::SetTag(const FString& key, const FString& value
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_span_set_tag(Span, TCHAR_TO_ANSI(*key), TCHAR_TO_ANSI(*value));
+	sentry_span_set_tag(Span, TCHAR_TO_UTF8(*key), TCHAR_TO_UTF8(*value));
 }
 
 void FGenericPlatformSentrySpan::RemoveTag(const FString& key)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_span_remove_tag(Span, TCHAR_TO_ANSI(*key));
+	sentry_span_remove_tag(Span, TCHAR_TO_UTF8(*key));
 }
 
 void FGenericPlatformSentrySpan::SetData(const FString& key, const TMap<FString, FSentryVariant>& values)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_span_set_data(Span, TCHAR_TO_ANSI(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
+	sentry_span_set_data(Span, TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
 }
 
 void FGenericPlatformSentrySpan::RemoveData(const FString& key)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_span_remove_data(Span, TCHAR_TO_ANSI(*key));
+	sentry_span_remove_data(Span, TCHAR_TO_UTF8(*key));
 }
 
 void FGenericPlatformSentrySpan::GetTrace(FString& name, FString& value)
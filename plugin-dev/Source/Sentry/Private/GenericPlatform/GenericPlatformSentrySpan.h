@@ -8,16 +8,25 @@
 
 #include "Interface/SentrySpanInterface.h"
 
+#include "Utils/SentryMonotonicClock.h"
+
 #if USE_SENTRY_NATIVE
 
 class FGenericPlatformSentrySpan : public ISentrySpan
 {
 public:
-	FGenericPlatformSentrySpan(sentry_span_t* span);
+	FGenericPlatformSentrySpan(sentry_span_t* span, bool sampled, const FSentryMonotonicClock& clock);
 	virtual ~FGenericPlatformSentrySpan() override = default;
 
 	sentry_span_t* GetNativeObject();
 
+	/** Starts a child span without creating a wrapper, returns null if the span isn't sampled. The caller must finish it. */
+	sentry_span_t* StartNativeChild(const char* operation, const char* description);
+
+	bool IsSampled() const;
+
+	const FSentryMonotonicClock& GetClock() const;
+
 	virtual TSharedPtr<ISentrySpan> StartChild(const FString& operation, const FString& description, bool bindToScope) override;
 	virtual TSharedPtr<ISentrySpan> StartChildWithTimestamp(const FString& operation, const FString& description, int64 timestamp, bool bindToScope) override;
 	virtual void Finish() override;
@@ -32,9 +41,13 @@ public:
 private:
 	sentry_span_t* Span;
 
+	/** Clock of the transaction the span belongs to. */
+	FSentryMonotonicClock Clock;
+
 	FCriticalSection CriticalSection;
 
 	bool isFinished;
+	bool isSampled;
 };
 
 typedef FGenericPlatformSentrySpan FPlatformSentrySpan;
@@ -7,19 +7,22 @@
 #include "GenericPlatformSentryFeedback.h"
 #include "GenericPlatformSentryId.h"
 #include "GenericPlatformSentryLog.h"
+#include "GenericPlatformSentryMemoryTransport.h"
 #include "GenericPlatformSentrySamplingContext.h"
 #include "GenericPlatformSentryScope.h"
 #include "GenericPlatformSentryTransaction.h"
 #include "GenericPlatformSentryTransactionContext.h"
+#include "GenericPlatformSentryTransport.h"
 #include "GenericPlatformSentryUser.h"
 
 #include "SentryBeforeBreadcrumbHandler.h"
 #include "SentryBeforeLogHandler.h"
 #include "SentryBeforeSendHandler.h"
 #include "SentryBreadcrumb.h"
-#include "SentryCrashVideoHandler.h"
+#include "SentryCrashVideoCapture.h"
 #include "SentryDefines.h"
 #include "SentryEvent.h"
+#include "SentryInitProfile.h"
 #include "SentryLog.h"
 #include "SentryModule.h"
 #include "SentrySamplingContext.h"
@@ -27,32 +30,97 @@
 #include "SentrySubsystem.h"
 #include "SentryTraceSampler.h"
 
+#include "Utils/SentryAdaptiveSampler.h"
 #include "Utils/SentryCallbackUtils.h"
+#include "Utils/SentryCrashAudioRing.h"
+#include "Utils/SentryCrashMemoryRegions.h"
+#include "Utils/SentryCrashVideoFrameStrip.h"
+#include "Utils/SentryCrashVideoRawRing.h"
+#include "Utils/SentryCrashVideoHistory.h"
+#include "Utils/SentryCrashVideoPendingUpload.h"
+#include "Utils/SentryCrashVideoSegments.h"
+#include "Utils/SentryCrashVideoTimeline.h"
+#include "Utils/SentryDatabaseMaintenance.h"
+#include "Utils/SentryDeferredCallbacks.h"
+#include "Utils/SentryEventFilters.h"
 #include "Utils/SentryFileUtils.h"
+#include "Utils/SentryFrameTimeHistory.h"
+#include "Utils/SentryGpuBreadcrumbs.h"
+#include "Utils/SentryHandlerBudget.h"
+#include "Utils/SentryHangWatchdog.h"
+#include "Utils/SentryInputRing.h"
+#include "Utils/SentryLogRing.h"
+#include "Utils/SentryLogUtils.h"
+#include "Utils/SentryMemoryAccounting.h"
+#include "Utils/SentryMemorySampler.h"
+#include "Utils/SentryMemoryTransport.h"
+#include "Utils/SentryMonotonicClock.h"
+#include "Utils/SentryNetworkQuality.h"
+#include "Utils/SentryPayloadAccounting.h"
+#include "Utils/SentrySamplingProfiler.h"
 #include "Utils/SentryScreenshotUtils.h"
+#include "Utils/SentryServerReplay.h"
+#include "Utils/SentryStateTimelineRecorder.h"
+#include "Utils/SentryStaticScopeFragment.h"
+#include "Utils/SentryStructLayout.h"
+#include "Utils/SentryTrace.h"
+#include "Utils/SentryWrapperPool.h"
 
 #include "Infrastructure/GenericPlatformSentryConverters.h"
+#include "Infrastructure/GenericPlatformSentryPayloadBudget.h"
+#include "Infrastructure/GenericPlatformSentryStacktraceCache.h"
+#include "Infrastructure/GenericPlatformSentryStaticScope.h"
 
 #include "GenericPlatform/CrashReporter/GenericPlatformSentryCrashContext.h"
 #include "GenericPlatform/CrashReporter/GenericPlatformSentryCrashReporter.h"
 
+#include "Containers/Ticker.h"
 #include "Engine/Engine.h"
 #include "GenericPlatform/GenericPlatformOutputDevices.h"
 #include "HAL/ExceptionHandling.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
 #include "Misc/CoreDelegates.h"
+#include "Misc/EngineVersionComparison.h"
 #include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UnrealTemplate.h"
 #include "UObject/UObjectThreadContext.h"
 
-#if HAS_RUNTIME_VIDEO_RECORDER
-#include "RuntimeVideoRecorder.h"
-#endif
-
 extern CORE_API bool GIsGPUCrashed;
 
 #if USE_SENTRY_NATIVE
 
+/** Max number of events and logs held while the handlers can't run, the ones above the limit bypass the handlers. */
+static const int32 MaxDeferredCallbacks = 256;
+
+/** Set while an event or log which has already been processed by the deferred handler is handed back to sentry-native. */
+static thread_local bool IsSendingDeferredPayload = false;
+
+/** Processed log which replaces the one sentry-native builds while the deferred log is logged again, so that it keeps its timestamp and attributes. */
+static thread_local const sentry_value_t* DeferredLogToSend = nullptr;
+
+/** Adds a context to the event, keeping the one already set under the same key unless asked to replace it. */
+static void SetEventContext(sentry_value_t event, const char* key, sentry_value_t context, bool bReplaceExisting = true)
+{
+	sentry_value_t contexts = sentry_value_get_by_key(event, "contexts");
+	if (sentry_value_is_null(contexts))
+	{
+		contexts = sentry_value_new_object();
+		sentry_value_set_by_key(event, "contexts", contexts);
+	}
+	else if (!bReplaceExisting && !sentry_value_is_null(sentry_value_get_by_key(contexts, key)))
+	{
+		sentry_value_decref(context);
+		return;
+	}
+
+	sentry_value_set_by_key(contexts, key, context);
+}
+
 static void PrintVerboseLog(sentry_level_t level, const char* message, va_list args, void* closure)
 {
 	char buffer[512];
@@ -109,7 +177,11 @@ static void PrintVerboseLog(sentry_level_t level, const char* message, va_list a
 {
 	if (closure)
 	{
-		return StaticCast<FGenericPlatformSentrySubsystem*>(closure)->OnTraceSampling(transaction_ctx, custom_sampling_ctx, parent_sampled);
+		FGenericPlatformSentrySubsystem* subsystem = StaticCast<FGenericPlatformSentrySubsystem*>(closure);
+		const double sampleRate = subsystem->OnTraceSampling(transaction_ctx, custom_sampling_ctx, parent_sampled);
+
+		// Upstream decisions are kept so that distributed traces stay complete
+		return subsystem->adaptiveSampler && parent_sampled == nullptr ? sampleRate * subsystem->adaptiveSampler->GetSampleRate() : sampleRate;
 	}
 	else
 	{
@@ -129,28 +201,132 @@ static void PrintVerboseLog(sentry_level_t level, const char* message, va_list a
 
 sentry_value_t FGenericPlatformSentrySubsystem::OnBeforeSend(sentry_value_t event, void* hint, void* closure, bool isCrash)
 {
+	SENTRY_TRACE_SCOPE(OnBeforeSend);
+
 	if (!closure || this != closure)
 	{
 		return event;
 	}
 
+	if (IsSendingDeferredPayload)
+	{
+		return event;
+	}
+
+	// Crashes are never sampled out
+	if (!isCrash && eventSampleRate.Load() < 1.0f && FMath::FRand() >= eventSampleRate.Load())
+	{
+		sentry_value_decref(event);
+		return sentry_value_new_null();
+	}
+
+	// Low-priority events are shed while the transport is backed up
+	if (!isCrash && adaptiveSampler && adaptiveSampler->GetSampleRate() < 1.0f)
+	{
+		const char* level = sentry_value_as_string(sentry_value_get_by_key(event, "level"));
+		const bool isLowPriority = FCStringAnsi::Strcmp(level, "info") == 0 || FCStringAnsi::Strcmp(level, "debug") == 0;
+		if (isLowPriority && !adaptiveSampler->ShouldKeep())
+		{
+			sentry_value_decref(event);
+			return sentry_value_new_null();
+		}
+	}
+
+	// Platform stats aren't safe to query from the crash handler, crashes get the latest sample instead
+	if (FSentryMemorySampler::Get().IsActive())
+	{
+		AddMemoryContext(event, isCrash ? FSentryMemorySampler::Get().GetLatestSample() : FSentryMemorySampler::Get().GetRefreshedSample());
+	}
+
+	if (FSentryFrameTimeHistory::Get().IsActive())
+	{
+		AddPerformanceContext(event);
+	}
+
+	if (FSentryNetworkQuality::Get().IsActive())
+	{
+		AddNetworkContext(event);
+	}
+
+	// Native filters don't create UObjects, so unlike the handler they also run during garbage collection
+	if (SentryEventFilters::HasFilters())
+	{
+		FGenericPlatformSentryEvent nativeEvent(event, isCrash);
+		if (!SentryEventFilters::Run(nativeEvent))
+		{
+			sentry_value_decref(event);
+			return sentry_value_new_null();
+		}
+	}
+
 	USentryBeforeSendHandler* Handler = GetBeforeSendHandler();
-	if (!Handler)
+	if (!Handler || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeSend))
 	{
 		// If custom handler isn't set skip further processing
-		return event;
+		return StripStaticScope(ApplyPayloadBudget(event), isCrash);
 	}
 
 	if (!SentryCallbackUtils::IsCallbackSafeToRun())
+	{
+		// Crashed process can't wait for the garbage collection to finish
+		if (!isCrash && DeferBeforeSend(event))
+		{
+			return sentry_value_new_null();
+		}
+
+		return StripStaticScope(ApplyPayloadBudget(event), isCrash);
+	}
+
+	const FSentryEventWrapperPool::FScopedObject EventToProcess(MakeShareable(new FGenericPlatformSentryEvent(event, isCrash)));
+
+	USentryEvent* ProcessedEvent = nullptr;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeSend);
+		ProcessedEvent = Handler->HandleBeforeSend(EventToProcess.Get(), nullptr);
+	}
+
+	return ProcessedEvent ? StripStaticScope(ApplyPayloadBudget(event), isCrash) : sentry_value_new_null();
+}
+
+sentry_value_t FGenericPlatformSentrySubsystem::ApplyPayloadBudget(sentry_value_t event)
+{
+	if (maxEventPayloadSize <= 0 && !isPayloadTrackingEnabled)
 	{
 		return event;
 	}
 
-	USentryEvent* EventToProcess = USentryEvent::Create(MakeShareable(new FGenericPlatformSentryEvent(event, isCrash)));
+	bool wasTrimmed = false;
+
+	const int64 size = maxEventPayloadSize > 0
+		? FGenericPlatformSentryPayloadBudget::Enforce(event, maxEventPayloadSize, wasTrimmed)
+		: FGenericPlatformSentryPayloadBudget::GetSerializedSize(event);
+
+	SentryPayloadAccounting::RecordEvent(size, wasTrimmed);
+
+	if (wasTrimmed)
+	{
+		UE_LOG(LogSentrySdk, Verbose, TEXT("Event was trimmed to %lld bytes to fit the event size limit."), size);
+	}
+
+	// Attachments added to the global scope are sent with every event
+	const int64 attachmentsSize = globalAttachmentsSize;
+	if (attachmentsSize > 0)
+	{
+		SentryPayloadAccounting::Record(ESentryPayloadCategory::Attachment, attachmentsSize);
+	}
+
+	return event;
+}
 
-	USentryEvent* ProcessedEvent = Handler->HandleBeforeSend(EventToProcess, nullptr);
+sentry_value_t FGenericPlatformSentrySubsystem::StripStaticScope(sentry_value_t event, bool isCrash) const
+{
+	// Crash events are sent by the crash handler rather than the transport splicing the static scope back
+	if (staticScope && !isCrash)
+	{
+		staticScope->Strip(event);
+	}
 
-	return ProcessedEvent ? event : sentry_value_new_null();
+	return event;
 }
 
 // Currently this handler is not set anywhere since the Unreal SDK doesn't use `sentry_add_breadcrumb` directly and relies on
@@ -158,13 +334,15 @@ sentry_value_t FGenericPlatformSentrySubsystem::OnBeforeSend(sentry_value_t even
 // The support for it will be enabled with https://github.com/getsentry/sentry-native/pull/1166
 sentry_value_t FGenericPlatformSentrySubsystem::OnBeforeBreadcrumb(sentry_value_t breadcrumb, void* hint, void* closure)
 {
+	SENTRY_TRACE_SCOPE(OnBeforeBreadcrumb);
+
 	if (!closure || this != closure)
 	{
 		return breadcrumb;
 	}
 
 	USentryBeforeBreadcrumbHandler* Handler = GetBeforeBreadcrumbHandler();
-	if (!Handler)
+	if (!Handler || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeBreadcrumb))
 	{
 		// If custom handler isn't set skip further processing
 		return breadcrumb;
@@ -175,22 +353,57 @@ sentry_value_t FGenericPlatformSentrySubsystem::OnBeforeBreadcrumb(sentry_value_
 		return breadcrumb;
 	}
 
-	USentryBreadcrumb* BreadcrumbToProcess = USentryBreadcrumb::Create(MakeShareable(new FGenericPlatformSentryBreadcrumb(breadcrumb)));
+	const FSentryBreadcrumbWrapperPool::FScopedObject BreadcrumbToProcess(MakeShareable(new FGenericPlatformSentryBreadcrumb(breadcrumb)));
 
-	USentryBreadcrumb* ProcessedBreadcrumb = Handler->HandleBeforeBreadcrumb(BreadcrumbToProcess, nullptr);
+	USentryBreadcrumb* ProcessedBreadcrumb = nullptr;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeBreadcrumb);
+		ProcessedBreadcrumb = Handler->HandleBeforeBreadcrumb(BreadcrumbToProcess.Get(), nullptr);
+	}
 
 	return ProcessedBreadcrumb ? breadcrumb : sentry_value_new_null();
 }
 
 sentry_value_t FGenericPlatformSentrySubsystem::OnBeforeLog(sentry_value_t log, void* closure)
 {
+	SENTRY_TRACE_SCOPE(OnBeforeLog);
+
 	if (!closure || this != closure)
 	{
 		return log;
 	}
 
+	if (IsSendingDeferredPayload)
+	{
+		if (!DeferredLogToSend)
+		{
+			return log;
+		}
+
+		sentry_value_decref(log);
+		sentry_value_incref(*DeferredLogToSend);
+		return *DeferredLogToSend;
+	}
+
+	if (adaptiveSampler && adaptiveSampler->GetSampleRate() < 1.0f && !adaptiveSampler->ShouldKeep(FGenericPlatformSentryLog(log).GetLevel()))
+	{
+		sentry_value_decref(log);
+		return sentry_value_new_null();
+	}
+
+	// Rules run first so that dropped logs don't cost the handler its UObjects
+	if (logFilterRules)
+	{
+		const FGenericPlatformSentryLog nativeLog(log);
+		if (!logFilterRules->ShouldKeep(sentry_value_as_string(sentry_value_get_by_key(log, "body")), nativeLog.GetLevel()))
+		{
+			sentry_value_decref(log);
+			return sentry_value_new_null();
+		}
+	}
+
 	USentryBeforeLogHandler* Handler = GetBeforeLogHandler();
-	if (!Handler)
+	if (!Handler || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeLog))
 	{
 		// If custom handler isn't set skip further processing
 		return log;
@@ -198,43 +411,252 @@ sentry_value_t FGenericPlatformSentrySubsystem::OnBeforeLog(sentry_value_t log,
 
 	if (!SentryCallbackUtils::IsCallbackSafeToRun())
 	{
-		return log;
+		return DeferBeforeLog(log) ? sentry_value_new_null() : log;
 	}
 
-	// Create USentryLog object using the log wrapper
-	USentryLog* LogData = USentryLog::Create(MakeShareable(new FGenericPlatformSentryLog(log)));
+	// Pooled USentryLog object wrapping the log for the duration of the handler call
+	const FSentryLogWrapperPool::FScopedObject LogData(MakeShareable(new FGenericPlatformSentryLog(log)));
 
-	USentryLog* ProcessedLogData = Handler->HandleBeforeLog(LogData);
+	USentryLog* ProcessedLogData = nullptr;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeLog);
+		ProcessedLogData = Handler->HandleBeforeLog(LogData.Get());
+	}
 
 	return ProcessedLogData ? log : sentry_value_new_null();
 }
 
 sentry_value_t FGenericPlatformSentrySubsystem::OnCrash(const sentry_ucontext_t* uctx, sentry_value_t event, void* closure)
 {
+	SENTRY_TRACE_SCOPE(OnCrash);
+
+	if (crashTimeline)
+	{
+		crashTimeline->Begin();
+	}
+
+	// Scope changes still waiting in the queue would otherwise be missing from the crash event
+	USentrySubsystem::FlushPlatformCallsOnCrash();
+	MarkCrashStage(TEXT("command_queue"));
+
 	if (isScreenshotAttachmentEnabled)
 	{
 		TryCaptureScreenshot();
+		MarkCrashStage(TEXT("screenshot"));
 	}
 
 	if (GIsGPUCrashed && isGpuDumpAttachmentEnabled)
 	{
 		TryCaptureGpuDump();
+		MarkCrashStage(TEXT("gpu_dump"));
 	}
 
-	if (isCrashVideoEnabled)
+	if (GIsGPUCrashed && FSentryGpuBreadcrumbs::Get().IsActive())
+	{
+		AddGpuBreadcrumbsContext(event);
+		MarkCrashStage(TEXT("gpu_breadcrumbs"));
+	}
+
+	// Platform stats aren't safe to query from the crash handler, the latest sample has to do
+	if (FSentryMemorySampler::Get().IsActive())
+	{
+		AddMemoryContext(event, FSentryMemorySampler::Get().GetLatestSample());
+		MarkCrashStage(TEXT("memory"));
+	}
+
+	if (FSentryFrameTimeHistory::Get().IsActive())
+	{
+		AddPerformanceContext(event);
+		MarkCrashStage(TEXT("frame_times"));
+	}
+
+	if (FSentryNetworkQuality::Get().IsActive())
+	{
+		AddNetworkContext(event);
+		MarkCrashStage(TEXT("network"));
+	}
+
+	const uint32 crashVideoFingerprint = isCrashVideoEnabled ? GetCrashVideoFingerprint(uctx) : 0;
+	if (isCrashVideoEnabled && ShouldCaptureCrashVideo(event, crashVideoFingerprint))
+	{
+		const FString eventId(sentry_value_as_string(sentry_value_get_by_key(event, "event_id")));
+
+		// Fingerprint only de-duplicates later crashes once the video is known to be sent
+		ESentryCrashVideoDelivery delivery;
+		if (TryCaptureEmergencyCrashVideo(eventId, delivery))
+		{
+			FSentryCrashVideoHistory::Get().MarkPending(crashVideoFingerprint, delivery, eventId, FDateTime::UtcNow().ToUnixTimestamp());
+		}
+		MarkCrashStage(TEXT("crash_video"));
+
+		TryCaptureCrashAudio();
+		MarkCrashStage(TEXT("crash_audio"));
+	}
+
+	if (isCrashFrameStripEnabled)
+	{
+		TryCaptureCrashFrameStrip();
+		MarkCrashStage(TEXT("frame_strip"));
+	}
+
+	if (crashLogTailSize > 0)
+	{
+		TryCaptureCrashLogTail();
+		MarkCrashStage(TEXT("log_tail"));
+	}
+
+	if (FSentryInputRing::Get().IsActive())
+	{
+		TryCaptureInputEvents();
+		MarkCrashStage(TEXT("input_events"));
+	}
+
+	if (FSentryStateTimelineRecorder::Get().IsActive())
+	{
+		TryCaptureStateTimeline();
+		MarkCrashStage(TEXT("state_timeline"));
+	}
+
+	if (isCrashMemoryRegionsEnabled)
+	{
+		TryCaptureCrashMemoryRegions();
+		MarkCrashStage(TEXT("memory_regions"));
+	}
+
+	if (FSentryServerReplay::Get().IsActive())
+	{
+		TryCaptureServerReplay();
+		MarkCrashStage(TEXT("server_replay"));
+	}
+
+	// Crash event carries the breadcrumbs, so the next session only has to report what the crash handler couldn't
+	if (breadcrumbRing)
+	{
+		breadcrumbRing->MarkReported();
+	}
+
+	if (crashReporter)
 	{
-		TryCaptureEmergencyCrashVideo();
+		crashReporter->UpdateCrashReporterConfig(false);
 	}
 
+	MarkCrashStage(TEXT("crash_reporter"));
+
+	// Event may be released by `OnBeforeSend` if it gets discarded
+	const FString eventId = crashTimeline ? FString(sentry_value_as_string(sentry_value_get_by_key(event, "event_id"))) : FString();
+
 	// At this point crash events are handled the same way as non-fatal ones,
 	// so we defer to `OnBeforeSend` to invoke the custom `beforeSend` handler (if configured)
-	return OnBeforeSend(event, nullptr, closure, true);
+	sentry_value_t processedEvent = OnBeforeSend(event, nullptr, closure, true);
+
+	if (crashTimeline)
+	{
+		crashTimeline->MarkStage(TEXT("before_send"));
+		crashTimeline->Write(eventId, GetDatabasePath());
+	}
+
+	return processedEvent;
+}
+
+bool FGenericPlatformSentrySubsystem::DeferBeforeSend(sentry_value_t event)
+{
+	if (!deferredCallbacks)
+	{
+		return false;
+	}
+
+	return deferredCallbacks->Defer([this, event](bool bCanRun)
+	{
+		if (!bCanRun)
+		{
+			sentry_value_decref(event);
+			return;
+		}
+
+		USentryBeforeSendHandler* Handler = GetBeforeSendHandler();
+		if (Handler && !FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeSend))
+		{
+			const FSentryEventWrapperPool::FScopedObject EventToProcess(MakeShareable(new FGenericPlatformSentryEvent(event, false)));
+
+			FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeSend);
+			if (!Handler->HandleBeforeSend(EventToProcess.Get(), nullptr))
+			{
+				sentry_value_decref(event);
+				return;
+			}
+		}
+
+		// Event keeps its ID, and scope data it already carries isn't overwritten when the event is captured again
+		TGuardValue<bool> SendingDeferredGuard(IsSendingDeferredPayload, true);
+		sentry_capture_event(ApplyPayloadBudget(event));
+	});
+}
+
+bool FGenericPlatformSentrySubsystem::DeferBeforeLog(sentry_value_t log)
+{
+	if (!deferredCallbacks)
+	{
+		return false;
+	}
+
+	return deferredCallbacks->Defer([this, log](bool bCanRun)
+	{
+		if (bCanRun)
+		{
+			TSharedPtr<FGenericPlatformSentryLog> NativeLog = MakeShareable(new FGenericPlatformSentryLog(log));
+
+			USentryBeforeLogHandler* Handler = GetBeforeLogHandler();
+
+			bool bKeepLog = true;
+			if (Handler && !FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeLog))
+			{
+				const FSentryLogWrapperPool::FScopedObject LogToProcess(NativeLog);
+
+				FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::BeforeLog);
+				bKeepLog = Handler->HandleBeforeLog(LogToProcess.Get()) != nullptr;
+			}
+
+			if (bKeepLog)
+			{
+				// sentry-native doesn't take prepared logs, so a log is emitted again and swapped for the processed one in OnBeforeLog
+				TGuardValue<bool> SendingDeferredGuard(IsSendingDeferredPayload, true);
+				TGuardValue<const sentry_value_t*> DeferredLogGuard(DeferredLogToSend, &log);
+				AddLog(NativeLog->GetBody(), NativeLog->GetLevel(), FString());
+			}
+		}
+
+		sentry_value_decref(log);
+	});
+}
+
+void FGenericPlatformSentrySubsystem::MarkCrashStage(const TCHAR* name)
+{
+	if (crashTimeline)
+	{
+		crashTimeline->MarkStage(name);
+	}
 }
 
 double FGenericPlatformSentrySubsystem::OnTraceSampling(const sentry_transaction_context_t* transaction_ctx, sentry_value_t custom_sampling_ctx, const int* parent_sampled)
 {
+	if (isUniformTracesSampling)
+	{
+		return parent_sampled != nullptr ? *parent_sampled : tracesSampleRate.Load();
+	}
+
+	if (sampleRules)
+	{
+		// Keep the decision of the upstream service so that distributed traces stay complete
+		if (parent_sampled != nullptr)
+		{
+			return *parent_sampled;
+		}
+
+		return sampleRules->GetSampleRate(sentry_transaction_context_get_name(transaction_ctx), sentry_transaction_context_get_operation(transaction_ctx));
+	}
+
 	USentryTraceSampler* Sampler = GetTraceSampler();
-	if (!Sampler)
+	if (!Sampler || FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::TraceSampler))
 	{
 		// If custom sampler isn't set skip further processing
 		return parent_sampled != nullptr ? *parent_sampled : 0.0;
@@ -249,7 +671,13 @@ double FGenericPlatformSentrySubsystem::OnTraceSampling(const sentry_transaction
 		MakeShareable(new FGenericPlatformSentrySamplingContext(const_cast<sentry_transaction_context_t*>(transaction_ctx), custom_sampling_ctx)));
 
 	float samplingValue;
-	if (Sampler->Sample(Context, samplingValue))
+	bool bIsSampled = false;
+	{
+		FSentryHandlerBudget::FScope BudgetScope(ESentryHandlerType::TraceSampler);
+		bIsSampled = Sampler->Sample(Context, samplingValue);
+	}
+
+	if (bIsSampled)
 	{
 		return samplingValue;
 	}
@@ -263,6 +691,27 @@ void FGenericPlatformSentrySubsystem::InitCrashReporter(const FString& release,
 
 	crashReporter->SetRelease(release);
 	crashReporter->SetEnvironment(environment);
+	crashReporter->UpdateCrashReporterConfig();
+
+	// Crash reporter mutations are only written to the crash context once per frame
+	TWeakPtr<FGenericPlatformSentryCrashReporter> weakCrashReporter(crashReporter);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& ticker = FTSTicker::GetCoreTicker();
+#endif
+	ticker.AddTicker(FTickerDelegate::CreateLambda([weakCrashReporter](float DeltaTime)
+	{
+		TSharedPtr<FGenericPlatformSentryCrashReporter> pinnedCrashReporter = weakCrashReporter.Pin();
+		if (!pinnedCrashReporter)
+		{
+			return false;
+		}
+
+		pinnedCrashReporter->UpdateCrashReporterConfig();
+		return true;
+	}));
 }
 
 void FGenericPlatformSentrySubsystem::AddFileAttachment(TSharedPtr<ISentryAttachment> attachment)
@@ -305,13 +754,30 @@ FGenericPlatformSentrySubsystem::FGenericPlatformSentrySubsystem()
 	, beforeBreadcrumb(nullptr)
 	, beforeLog(nullptr)
 	, sampler(nullptr)
+	, eventSampleRate(1.0f)
+	, tracesSampleRate(0.0f)
+	, isUniformTracesSampling(false)
 	, crashReporter(nullptr)
+	, profilesSampleRate(0.0f)
+	, maxContextDepth(0)
+	, maxContextValues(0)
+	, isBatchedTransportEnabled(false)
 	, isEnabled(false)
-	, isStackTraceEnabled(true)
+	, isStackTraceEnabled(false)
 	, isPiiAttachmentEnabled(false)
 	, isScreenshotAttachmentEnabled(false)
 	, isGpuDumpAttachmentEnabled(false)
 	, isCrashVideoEnabled(false)
+	, isCrashVideoUploadDeferred(false)
+	, isCrashFrameStripEnabled(false)
+	, isCrashMemoryRegionsEnabled(false)
+	, isAppHangCrashVideoEnabled(false)
+	, maxAttachmentSize(20 * 1024 * 1024)
+	, eventLogTailSize(0)
+	, crashLogTailSize(0)
+	, maxEventPayloadSize(0)
+	, isPayloadTrackingEnabled(false)
+	, globalAttachmentsSize(0)
 {
 }
 
@@ -322,13 +788,15 @@ void FGenericPlatformSentrySubsystem::InitWithSettings(const USentrySettings* se
 	beforeLog = beforeLogHandler;
 	sampler = traceSampler;
 
-	sentry_options_t* options = sentry_options_new();
-
-	if (settings->EnableAutoLogAttachment)
+	if (beforeSend || beforeLog)
 	{
-		ConfigureLogFileAttachment(options);
+		deferredCallbacks = MakeShared<FSentryDeferredCallbacks, ESPMode::ThreadSafe>(MaxDeferredCallbacks);
 	}
 
+	const double buildOptionsStartTime = FPlatformTime::Seconds();
+
+	sentry_options_t* options = sentry_options_new();
+
 	switch (settings->DatabaseLocation)
 	{
 	case ESentryDatabaseLocation::ProjectDirectory:
@@ -345,69 +813,215 @@ void FGenericPlatformSentrySubsystem::InitWithSettings(const USentrySettings* se
 		databaseParentPath = FPaths::ProjectUserDir();
 	}
 
+	databaseInstanceKey.Empty();
+	if (settings->SeparateDatabasePerInstance && FParse::Value(FCommandLine::Get(), TEXT("SentryInstance="), databaseInstanceKey))
+	{
+		databaseInstanceKey = FPaths::MakeValidFileName(databaseInstanceKey, TEXT('_'));
+		UE_LOG(LogSentrySdk, Log, TEXT("Using Sentry database of instance %s."), *databaseInstanceKey);
+	}
+
+	PrepareCrashPaths();
+
+	TArray<uint8> unreportedLogLines;
+	TArray<uint8> unreportedBreadcrumbs;
+	CreateLogRings(settings, unreportedLogLines, unreportedBreadcrumbs);
+
+	// Tail is attached from memory at capture time so that the log file doesn't have to be read for every event
+	if (settings->EnableAutoLogAttachment && eventLogTailSize == 0)
+	{
+		ConfigureLogFileAttachment(options);
+	}
+
+	tagsLimiter = MakeUnique<FSentryScopeKeyLimiter>(settings->MaxScopeTags);
+	contextsLimiter = MakeUnique<FSentryScopeKeyLimiter>(settings->MaxScopeContexts);
+	maxContextDepth = settings->MaxContextDepth;
+	maxContextValues = settings->MaxContextValues;
+
 	isScreenshotAttachmentEnabled = settings->AttachScreenshot;
 	if (isScreenshotAttachmentEnabled)
 	{
 		// Clear screenshot captured during previous session if any
 		IFileManager::Get().DeleteDirectory(*FPaths::Combine(GetDatabasePath(), TEXT("screenshots")), false, true);
+
+		SentryScreenshotUtils::ReserveCrashBuffers();
+
+		if (settings->CacheLastFrameScreenshot)
+		{
+			SentryScreenshotUtils::StartLastFrameCache(settings->LastFrameScreenshotInterval);
+		}
 	}
 
 	isGpuDumpAttachmentEnabled = settings->AttachGpuDump;
 	
 	isCrashVideoEnabled = settings->AttachCrashVideo;
+	isCrashVideoUploadDeferred = settings->DeferCrashVideoUpload;
 
-	if (settings->UseProxy)
+	if (isCrashVideoEnabled)
 	{
-		sentry_options_set_proxy(options, TCHAR_TO_ANSI(*settings->ProxyUrl));
+		FSentryCrashVideoHistory::Get().Open(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"), TEXT("crash_video_history.bin")),
+			settings->CrashVideoSampleRate, settings->CrashVideoDeduplicationDays);
 	}
 
-	if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::UniformSampleRate)
-	{
-		sentry_options_set_traces_sample_rate(options, settings->TracesSampleRate);
-	}
-	if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::TracesSampler)
+	isCrashFrameStripEnabled = settings->AttachCrashFrameStrip;
+	isCrashMemoryRegionsEnabled = settings->AttachCrashMemoryRegions;
+
+	if (isCrashMemoryRegionsEnabled)
 	{
-		sentry_options_set_traces_sampler(options, HandleTraceSampling, this);
+		FSentryCrashMemoryRegions::Get().SetMaxTotalSize(settings->CrashMemoryRegionsMaxSizeKB * 1024);
 	}
+	isAppHangCrashVideoEnabled = settings->EnableAppNotRespondingTracking && settings->AttachCrashVideoToAppHangs && isCrashVideoEnabled;
 
-	ConfigureHandlerPath(options);
-	ConfigureDatabasePath(options);
-	ConfigureCertsPath(options);
-	ConfigureNetworkConnectFunc(options);
-
-	sentry_options_set_dsn(options, TCHAR_TO_ANSI(*settings->GetEffectiveDsn()));
-	sentry_options_set_release(options, TCHAR_TO_ANSI(*settings->GetEffectiveRelease()));
-	sentry_options_set_environment(options, TCHAR_TO_ANSI(*settings->GetEffectiveEnvironment()));
-	sentry_options_set_dist(options, TCHAR_TO_ANSI(*settings->Dist));
-	sentry_options_set_logger(options, PrintVerboseLog, nullptr);
-	sentry_options_set_debug(options, settings->Debug);
-	sentry_options_set_auto_session_tracking(options, settings->EnableAutoSessionTracking);
-	sentry_options_set_sample_rate(options, settings->SampleRate);
-	sentry_options_set_max_breadcrumbs(options, settings->MaxBreadcrumbs);
-	sentry_options_set_before_send(options, HandleBeforeSend, this);
-	sentry_options_set_before_send_log(options, HandleBeforeLog, this);
-	sentry_options_set_on_crash(options, HandleOnCrash, this);
-	sentry_options_set_shutdown_timeout(options, 3000);
-	sentry_options_set_crashpad_wait_for_upload(options, settings->CrashpadWaitForUpload);
-	sentry_options_set_logger_enabled_when_crashed(options, false);
-	sentry_options_set_enable_logs(options, settings->EnableStructuredLogging);
+	maxAttachmentSize = settings->MaxAttachmentSize;
+	maxEventPayloadSize = static_cast<int64>(settings->MaxEventPayloadSizeKB) * 1024;
+	isPayloadTrackingEnabled = settings->TrackPayloadSizes;
 
-	if (settings->bRequireUserConsent)
+	if (settings->WriteCrashTimeline)
 	{
-		sentry_options_set_require_user_consent(options, 1);
+		crashTimeline = MakeUnique<FSentryCrashTimeline>(FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashTimeline.json"))));
+		IFileManager::Get().Delete(*crashTimeline->GetFilePath(), false, false, true);
 	}
 
-	int initResult = sentry_init(options);
-
-	UE_LOG(LogSentrySdk, Log, TEXT("Sentry initialization completed with result %d (0 on success)."), initResult);
-
-	isEnabled = initResult == 0 ? true : false;
-
-	sentry_clear_crashed_last_run();
+	if (settings->UseProxy)
+	{
+		sentry_options_set_proxy(options, TCHAR_TO_UTF8(*settings->ProxyUrl));
+	}
+
+#if WITH_AUTOMATION_TESTS
+	if (SentryMemoryTransport::IsInstalled())
+	{
+		sentry_options_set_transport(options, FGenericPlatformSentryMemoryTransport::CreateNativeTransport());
+	}
+	else
+#endif
+	if (settings->EnableBatchedTransport)
+	{
+		if (settings->UseProxy)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Batched transport can't send requests through the configured HTTP proxy, falling back to the default transport."));
+		}
+		else
+		{
+			TSharedPtr<FSentryStaticScopeFragment, ESPMode::ThreadSafe> staticScopeFragment;
+			if (settings->SerializeStaticScopeOnce)
+			{
+				staticScope = MakeUnique<FGenericPlatformSentryStaticScope>(settings->GetEffectiveRelease(), settings->GetEffectiveEnvironment(), settings->Dist);
+				staticScopeFragment = staticScope->GetFragment();
+			}
+
+			if (settings->EnableAdaptiveSampling)
+			{
+				adaptiveSampler = MakeShared<FSentryAdaptiveSampler, ESPMode::ThreadSafe>(settings->AdaptiveSamplingMaxPendingEnvelopes,
+					static_cast<int64>(settings->AdaptiveSamplingMaxPendingSizeMB) * 1024 * 1024, settings->AdaptiveSamplingMinRate);
+			}
+
+			sentry_transport_t* transport = FGenericPlatformSentryTransport::CreateNativeTransport(settings, FPaths::Combine(GetDatabasePath(), TEXT("spool")), staticScopeFragment, adaptiveSampler);
+
+			if (transport)
+			{
+				sentry_options_set_transport(options, transport);
+				isBatchedTransportEnabled = true;
+			}
+			else
+			{
+				staticScope.Reset();
+				adaptiveSampler.Reset();
+			}
+		}
+	}
+
+	// Uniform rate goes through the sampler as well so that it can be changed without re-initializing
+	isUniformTracesSampling = settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::UniformSampleRate;
+	if (isUniformTracesSampling)
+	{
+		sentry_options_set_traces_sampler(options, HandleTraceSampling, this);
+	}
+	if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::TracesSampler)
+	{
+		sentry_options_set_traces_sampler(options, HandleTraceSampling, this);
+	}
+	if (settings->EnableTracing && settings->SamplingType == ESentryTracesSamplingType::SampleRules)
+	{
+		sampleRules = MakeUnique<FSentryTraceSampleRules>(settings->TracesSampleRules, settings->TracesSampleRate);
+		sentry_options_set_traces_sampler(options, HandleTraceSampling, this);
+	}
+	if (settings->EnableStructuredLogging && settings->StructuredLoggingFilterRules.Num() > 0)
+	{
+		logFilterRules = MakeUnique<FSentryLogFilterRules>(settings->StructuredLoggingFilterRules);
+	}
+	if (settings->EnableTracing && settings->EnableProfiling && settings->ProfilesSampleRate > 0.0f)
+	{
+		profiler = MakeShared<FSentrySamplingProfiler, ESPMode::ThreadSafe>(settings->ProfilerSamplingFrequency);
+		profilesSampleRate = settings->ProfilesSampleRate;
+	}
+
+	ConfigureHandlerPath(options);
+	ConfigureDatabasePath(options);
+	ConfigureCertsPath(options);
+	ConfigureNetworkConnectFunc(options);
+
+	sentry_options_set_dsn(options, TCHAR_TO_UTF8(*settings->GetEffectiveDsn()));
+	sentry_options_set_release(options, TCHAR_TO_UTF8(*settings->GetEffectiveRelease()));
+	sentry_options_set_environment(options, TCHAR_TO_UTF8(*settings->GetEffectiveEnvironment()));
+	sentry_options_set_dist(options, TCHAR_TO_UTF8(*settings->Dist));
+	sentry_options_set_logger(options, PrintVerboseLog, nullptr);
+	sentry_options_set_debug(options, settings->Debug);
+	sentry_options_set_auto_session_tracking(options, settings->EnableAutoSessionTracking);
+	// Events are sampled in OnBeforeSend so that the rate can be changed without re-initializing
+	sentry_options_set_sample_rate(options, 1.0);
+	ApplyRuntimeSettings(settings);
+	sentry_options_set_max_breadcrumbs(options, settings->MaxBreadcrumbs);
+	sentry_options_set_before_send(options, HandleBeforeSend, this);
+	sentry_options_set_before_send_log(options, HandleBeforeLog, this);
+	sentry_options_set_on_crash(options, HandleOnCrash, this);
+	// Native SDK persists the envelopes its transport didn't send in time, so a zero timeout hands all of them over to the next launch
+	sentry_options_set_shutdown_timeout(options, settings->FastExitOnClose ? 0 : FMath::Max(0, settings->ShutdownTimeoutMs));
+	sentry_options_set_crashpad_wait_for_upload(options, settings->CrashpadWaitForUpload);
+	sentry_options_set_logger_enabled_when_crashed(options, false);
+	sentry_options_set_enable_logs(options, settings->EnableStructuredLogging);
+
+	if (settings->bRequireUserConsent)
+	{
+		sentry_options_set_require_user_consent(options, 1);
+	}
+
+	FSentryInitProfile::RecordPhase(TEXT("BuildOptions"), buildOptionsStartTime, FPlatformTime::Seconds());
+
+	int initResult = 0;
+
+	{
+		// Crashpad handler is spawned inside sentry_init so its startup is a part of this phase
+		SENTRY_INIT_PHASE_SCOPE(SentryInit);
+		initResult = sentry_init(options);
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Sentry initialization completed with result %d (0 on success)."), initResult);
+
+	isEnabled = initResult == 0 ? true : false;
+
+	sentry_clear_crashed_last_run();
+
+	if (isEnabled)
+	{
+		// Reports that piled up while offline are pruned off the startup path
+		FSentryDatabaseRetention databaseRetention;
+		databaseRetention.MaxAgeDays = settings->DatabaseMaxReportAgeDays;
+		databaseRetention.MaxSizeBytes = static_cast<int64>(settings->DatabaseMaxReportsSizeMB) * 1024 * 1024;
+		FSentryDatabaseMaintenance::PruneAsync(GetDatabasePath(), databaseRetention);
+	}
+
+	if (settings->AttachStacktrace)
+	{
+		stacktraceCache = MakeUnique<FGenericPlatformSentryStacktraceCache>(settings->StacktraceMaxFrames, settings->bCacheCallsiteStacktraces);
+		isStackTraceEnabled = true;
+	}
 
-	isStackTraceEnabled = settings->AttachStacktrace;
 	isPiiAttachmentEnabled = settings->SendDefaultPii;
 
+	if (isEnabled && (unreportedLogLines.Num() > 0 || unreportedBreadcrumbs.Num() > 0))
+	{
+		CaptureUnreportedSessionTails(unreportedLogLines, unreportedBreadcrumbs);
+	}
+
 	// Best-effort at writing user consent to disk so that user consent can change at runtime and persist
 	// We should never have a valid user consent state return "Unknown", so assume that no consent value is written if we see this
 	if (settings->bRequireUserConsent && GetUserConsent() == EUserConsent::Unknown)
@@ -425,9 +1039,73 @@ void FGenericPlatformSentrySubsystem::InitWithSettings(const USentrySettings* se
 
 void FGenericPlatformSentrySubsystem::Close()
 {
+	if (deferredCallbacks)
+	{
+		// Events and logs held during garbage collection are sent before the transport shuts down if handlers can run
+		deferredCallbacks->Flush();
+	}
+
 	isEnabled = false;
+	isStackTraceEnabled = false;
+
+	// Profiled transactions are finished on the thread pool and would be lost if the transport closed first
+	if (profiler && !profiler->WaitForPendingSummaries(2.0))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Timed out waiting for profiled transactions to finish, they won't be sent."));
+	}
+
+	profiler.Reset();
 
 	sentry_close();
+
+	staticScope.Reset();
+	adaptiveSampler.Reset();
+	isBatchedTransportEnabled = false;
+
+	// Whatever was deferred after the flush above is released without being sent
+	deferredCallbacks.Reset();
+	stacktraceCache.Reset();
+
+	if (crashReporter)
+	{
+		crashReporter->UpdateCrashReporterConfig();
+		crashReporter.Reset();
+	}
+
+	{
+		FScopeLock Lock(&InternedStringsCriticalSection);
+
+		for (const auto& InternedString : InternedStrings)
+		{
+			sentry_value_decref(InternedString.Value);
+		}
+
+		InternedStrings.Empty();
+	}
+
+	if (isScreenshotAttachmentEnabled)
+	{
+		SentryScreenshotUtils::ReleaseCrashBuffers();
+		SentryScreenshotUtils::StopLastFrameCache();
+	}
+
+	if (isCrashVideoEnabled)
+	{
+		FSentryCrashVideoHistory::Get().Close();
+	}
+
+	// Persisted tails of a session closed cleanly have nothing to report
+	if (logRing)
+	{
+		logRing->MarkReported();
+		logRing.Reset();
+	}
+
+	if (breadcrumbRing)
+	{
+		breadcrumbRing->MarkReported();
+		breadcrumbRing.Reset();
+	}
 }
 
 bool FGenericPlatformSentrySubsystem::IsEnabled()
@@ -459,6 +1137,8 @@ ESentryCrashedLastRun FGenericPlatformSentrySubsystem::IsCrashedLastRun()
 
 void FGenericPlatformSentrySubsystem::AddBreadcrumb(TSharedPtr<ISentryBreadcrumb> breadcrumb)
 {
+	SENTRY_MEMORY_SCOPE(Breadcrumbs);
+
 	if (beforeBreadcrumb != nullptr)
 	{
 		sentry_value_t processedBreadcrumb = HandleBeforeBreadcrumb(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(breadcrumb)->GetNativeObject(), nullptr, this);
@@ -468,28 +1148,94 @@ void FGenericPlatformSentrySubsystem::AddBreadcrumb(TSharedPtr<ISentryBreadcrumb
 		}
 	}
 
+	AddBreadcrumbVideoTimelineId(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(breadcrumb)->GetNativeObject());
+	AppendToBreadcrumbRing(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(breadcrumb)->GetNativeObject());
+
 	sentry_add_breadcrumb(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(breadcrumb)->GetNativeObject());
 }
 
 void FGenericPlatformSentrySubsystem::AddBreadcrumbWithParams(const FString& Message, const FString& Category, const FString& Type, const TMap<FString, FSentryVariant>& Data, ESentryLevel Level)
 {
-	TSharedPtr<FGenericPlatformSentryBreadcrumb> Breadcrumb = MakeShareable(new FGenericPlatformSentryBreadcrumb());
-	Breadcrumb->SetMessage(Message);
-	Breadcrumb->SetCategory(Category);
-	Breadcrumb->SetType(Type);
-	Breadcrumb->SetData(Data);
-	Breadcrumb->SetLevel(Level);
+	SENTRY_MEMORY_SCOPE(Breadcrumbs);
+
+	// Log-driven breadcrumbs come in bursts so they are built as native values directly, sharing interned category,
+	// type and level strings and leaving the message and data as the only per-breadcrumb allocations
+	static thread_local TArray<ANSICHAR> MessageBuffer;
+
+	sentry_value_t NativeBreadcrumb = sentry_value_new_breadcrumb(nullptr, nullptr);
+	sentry_value_set_by_key(NativeBreadcrumb, "timestamp", FGenericPlatformSentryConverters::TimestampToNative(FSentryMonotonicClock::GetProcessTimestamp()));
+	sentry_value_set_by_key(NativeBreadcrumb, "message", sentry_value_new_string(FGenericPlatformSentryConverters::StringToUtf8(Message, MessageBuffer)));
+
+	if (!Category.IsEmpty())
+	{
+		sentry_value_set_by_key(NativeBreadcrumb, "category", GetInternedString(Category));
+	}
+
+	if (!Type.IsEmpty())
+	{
+		sentry_value_set_by_key(NativeBreadcrumb, "type", GetInternedString(Type));
+	}
+
+	if (Data.Num() > 0)
+	{
+		sentry_value_set_by_key(NativeBreadcrumb, "data", FGenericPlatformSentryConverters::VariantMapToNative(Data));
+	}
+
+	const FString LevelStr = FGenericPlatformSentryConverters::SentryLevelToString(Level);
+	if (!LevelStr.IsEmpty())
+	{
+		sentry_value_set_by_key(NativeBreadcrumb, "level", GetInternedString(LevelStr));
+	}
 
 	if (beforeBreadcrumb != nullptr)
 	{
-		sentry_value_t processdBreadcrumb = HandleBeforeBreadcrumb(Breadcrumb->GetNativeObject(), nullptr, this);
+		sentry_value_t processdBreadcrumb = HandleBeforeBreadcrumb(NativeBreadcrumb, nullptr, this);
 		if (sentry_value_is_null(processdBreadcrumb))
 		{
+			sentry_value_decref(NativeBreadcrumb);
 			return;
 		}
 	}
 
-	sentry_add_breadcrumb(StaticCastSharedPtr<FGenericPlatformSentryBreadcrumb>(Breadcrumb)->GetNativeObject());
+	AddBreadcrumbVideoTimelineId(NativeBreadcrumb);
+	AppendToBreadcrumbRing(NativeBreadcrumb);
+
+	sentry_add_breadcrumb(NativeBreadcrumb);
+}
+
+TSharedPtr<FSentrySamplingProfiler, ESPMode::ThreadSafe> FGenericPlatformSentrySubsystem::GetTransactionProfiler() const
+{
+	if (!profiler || FMath::FRand() >= profilesSampleRate)
+	{
+		return nullptr;
+	}
+
+	return profiler;
+}
+
+sentry_value_t FGenericPlatformSentrySubsystem::GetInternedString(const FString& Str)
+{
+	// Bounded so that strings that are unique per call can't grow the table forever
+	static constexpr int32 MaxInternedStrings = 512;
+
+	FScopeLock Lock(&InternedStringsCriticalSection);
+
+	if (const sentry_value_t* InternedString = InternedStrings.Find(Str))
+	{
+		sentry_value_incref(*InternedString);
+		return *InternedString;
+	}
+
+	sentry_value_t NativeString = sentry_value_new_string(TCHAR_TO_UTF8(*Str));
+
+	if (InternedStrings.Num() < MaxInternedStrings)
+	{
+		sentry_value_freeze(NativeString);
+		sentry_value_incref(NativeString);
+		InternedStrings.Add(Str, NativeString);
+	}
+
+	return NativeString;
 }
 
 void FGenericPlatformSentrySubsystem::AddLog(const FString& Body, ESentryLevel Level, const FString& Category)
@@ -500,39 +1246,59 @@ void FGenericPlatformSentrySubsystem::AddLog(const FString& Body, ESentryLevel L
 		return;
 	}
 
-	// Format body with category if provided
-	FString FormattedMessage;
+	// Logs are usually forwarded from a few threads only so per-thread buffers keep their allocations warm
+	static thread_local TArray<ANSICHAR> BodyBuffer;
+	static thread_local TArray<ANSICHAR> CategoryBuffer;
+
+	const char* BodyUtf8 = FGenericPlatformSentryConverters::StringToUtf8(Body, BodyBuffer);
+
+	// Category and body are passed as template parameters rather than formatted into the message so that the native SDK
+	// records them as log attributes, and so that '%' in the log text isn't interpreted as a format specifier
 	if (!Category.IsEmpty())
 	{
-		FormattedMessage = FString::Printf(TEXT("[%s] %s"), *Category, *Body);
+		const char* CategoryUtf8 = FGenericPlatformSentryConverters::StringToUtf8(Category, CategoryBuffer);
+
+		switch (Level)
+		{
+		case ESentryLevel::Fatal:
+			sentry_log_fatal("[%s] %s", CategoryUtf8, BodyUtf8);
+			break;
+		case ESentryLevel::Error:
+			sentry_log_error("[%s] %s", CategoryUtf8, BodyUtf8);
+			break;
+		case ESentryLevel::Warning:
+			sentry_log_warn("[%s] %s", CategoryUtf8, BodyUtf8);
+			break;
+		case ESentryLevel::Info:
+			sentry_log_info("[%s] %s", CategoryUtf8, BodyUtf8);
+			break;
+		case ESentryLevel::Debug:
+		default:
+			sentry_log_debug("[%s] %s", CategoryUtf8, BodyUtf8);
+			break;
+		}
 	}
 	else
 	{
-		FormattedMessage = Body;
-	}
-
-	auto MessageCStrConverter = StringCast<ANSICHAR>(*FormattedMessage);
-	const char* MessageCStr = MessageCStrConverter.Get();
-
-	// Use level-specific sentry logging functions
-	switch (Level)
-	{
-	case ESentryLevel::Fatal:
-		sentry_log_fatal(MessageCStr);
-		break;
-	case ESentryLevel::Error:
-		sentry_log_error(MessageCStr);
-		break;
-	case ESentryLevel::Warning:
-		sentry_log_warn(MessageCStr);
-		break;
-	case ESentryLevel::Info:
-		sentry_log_info(MessageCStr);
-		break;
-	case ESentryLevel::Debug:
-	default:
-		sentry_log_debug(MessageCStr);
-		break;
+		switch (Level)
+		{
+		case ESentryLevel::Fatal:
+			sentry_log_fatal("%s", BodyUtf8);
+			break;
+		case ESentryLevel::Error:
+			sentry_log_error("%s", BodyUtf8);
+			break;
+		case ESentryLevel::Warning:
+			sentry_log_warn("%s", BodyUtf8);
+			break;
+		case ESentryLevel::Info:
+			sentry_log_info("%s", BodyUtf8);
+			break;
+		case ESentryLevel::Debug:
+		default:
+			sentry_log_debug("%s", BodyUtf8);
+			break;
+		}
 	}
 }
 
@@ -543,6 +1309,14 @@ void FGenericPlatformSentrySubsystem::ClearBreadcrumbs()
 
 void FGenericPlatformSentrySubsystem::AddAttachment(TSharedPtr<ISentryAttachment> attachment)
 {
+	TSharedPtr<FGenericPlatformSentryAttachment> platformAttachment = StaticCastSharedPtr<FGenericPlatformSentryAttachment>(attachment);
+
+	// Re-adding an attachment replaces it, otherwise the previous native copy would stay attached without being accounted for
+	if (platformAttachment->GetNativeObject())
+	{
+		RemoveAttachment(attachment);
+	}
+
 	if (!attachment->GetPath().IsEmpty())
 	{
 		AddFileAttachment(attachment);
@@ -551,6 +1325,12 @@ void FGenericPlatformSentrySubsystem::AddAttachment(TSharedPtr<ISentryAttachment
 	{
 		AddByteAttachment(attachment);
 	}
+
+	if (isPayloadTrackingEnabled || maxEventPayloadSize > 0)
+	{
+		platformAttachment->SetAccountedSize(GetAttachmentSize(attachment));
+		globalAttachmentsSize += platformAttachment->GetAccountedSize();
+	}
 }
 
 void FGenericPlatformSentrySubsystem::RemoveAttachment(TSharedPtr<ISentryAttachment> attachment)
@@ -565,6 +1345,10 @@ void FGenericPlatformSentrySubsystem::RemoveAttachment(TSharedPtr<ISentryAttachm
 	sentry_remove_attachment(nativeAttachment);
 
 	platformAttachment->SetNativeObject(nullptr);
+
+	// Files may have changed since they were added, so exactly the size counted back then is taken off
+	globalAttachmentsSize -= platformAttachment->GetAccountedSize();
+	platformAttachment->SetAccountedSize(0);
 }
 
 void FGenericPlatformSentrySubsystem::ClearAttachments()
@@ -575,6 +1359,16 @@ void FGenericPlatformSentrySubsystem::ClearAttachments()
 	}
 
 	attachments.Empty();
+
+	globalAttachmentsSize = 0;
+}
+
+int64 FGenericPlatformSentrySubsystem::GetAttachmentSize(TSharedPtr<ISentryAttachment> attachment)
+{
+	TSharedPtr<FGenericPlatformSentryAttachment> platformAttachment = StaticCastSharedPtr<FGenericPlatformSentryAttachment>(attachment);
+
+	// File attachments are read when an event is sent, their size at the time they were added is a close enough estimate
+	return platformAttachment->GetPath().IsEmpty() ? platformAttachment->GetDataByRef().Num() : FMath::Max<int64>(IFileManager::Get().FileSize(*platformAttachment->GetPath()), 0);
 }
 
 TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureMessage(const FString& message, ESentryLevel level)
@@ -583,10 +1377,10 @@ TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureMessage(const FStr
 
 	if (isStackTraceEnabled)
 	{
-		sentry_value_set_stacktrace(nativeEvent, nullptr, 0);
+		stacktraceCache->SetStacktrace(nativeEvent);
 	}
 
-	sentry_uuid_t id = sentry_capture_event(nativeEvent);
+	sentry_uuid_t id = CaptureWithLocalScope(nativeEvent, nullptr);
 	return MakeShareable(new FGenericPlatformSentryId(id));
 }
 
@@ -596,16 +1390,13 @@ TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureMessageWithScope(c
 
 	if (isStackTraceEnabled)
 	{
-		sentry_value_set_stacktrace(nativeEvent, nullptr, 0);
+		stacktraceCache->SetStacktrace(nativeEvent);
 	}
 
-	sentry_scope_t* scope = sentry_local_scope_new();
-
 	TSharedPtr<FGenericPlatformSentryScope> NewLocalScope = MakeShareable(new FGenericPlatformSentryScope());
 	onConfigureScope.ExecuteIfBound(NewLocalScope);
-	NewLocalScope->Apply(scope);
 
-	sentry_uuid_t id = sentry_capture_event_with_scope(nativeEvent, scope);
+	sentry_uuid_t id = CaptureWithLocalScope(nativeEvent, NewLocalScope);
 
 	return MakeShareable(new FGenericPlatformSentryId(id));
 }
@@ -618,10 +1409,10 @@ TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureEvent(TSharedPtr<I
 
 	if (isStackTraceEnabled)
 	{
-		sentry_value_set_stacktrace(nativeEvent, nullptr, 0);
+		stacktraceCache->SetStacktrace(nativeEvent);
 	}
 
-	sentry_uuid_t id = sentry_capture_event(nativeEvent);
+	sentry_uuid_t id = CaptureWithLocalScope(nativeEvent, nullptr);
 	return MakeShareable(new FGenericPlatformSentryId(id));
 }
 
@@ -631,102 +1422,525 @@ TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureEventWithScope(TSh
 
 	sentry_value_t nativeEvent = Event->GetNativeObject();
 
-	if (isStackTraceEnabled)
+	if (isStackTraceEnabled)
+	{
+		stacktraceCache->SetStacktrace(nativeEvent);
+	}
+
+	TSharedPtr<FGenericPlatformSentryScope> NewLocalScope = MakeShareable(new FGenericPlatformSentryScope());
+	onScopeConfigure.ExecuteIfBound(NewLocalScope);
+
+	sentry_uuid_t id = CaptureWithLocalScope(nativeEvent, NewLocalScope);
+
+	return MakeShareable(new FGenericPlatformSentryId(id));
+}
+
+void FGenericPlatformSentrySubsystem::CreateLogRings(const USentrySettings* settings, TArray<uint8>& outUnreportedLogLines, TArray<uint8>& outUnreportedBreadcrumbs)
+{
+	static constexpr int32 breadcrumbRingSize = 64 * 1024;
+
+	eventLogTailSize = settings->EnableAutoLogAttachment ? settings->AutoLogAttachmentTailSizeKB * 1024 : 0;
+	// Log file isn't attached at all once it's tailed, so crashes get the same tail unless they're configured with their own
+	crashLogTailSize = settings->AttachCrashLogTail ? settings->CrashLogTailSizeKB * 1024 : eventLogTailSize;
+
+	// Events and crashes share the ring, each taking the tail size it's configured with
+	const int32 logRingSize = FMath::Max3(eventLogTailSize, crashLogTailSize, settings->PersistLogTail ? settings->CrashLogTailSizeKB * 1024 : 0);
+
+	logRing = nullptr;
+	breadcrumbRing = nullptr;
+
+	if (settings->PersistLogTail)
+	{
+		logRing = FSentryLogRing::CreatePersistent(FPaths::Combine(GetDatabasePath(), TEXT("log_ring.bin")), logRingSize, outUnreportedLogLines);
+		breadcrumbRing = FSentryLogRing::CreatePersistent(FPaths::Combine(GetDatabasePath(), TEXT("breadcrumb_ring.bin")), breadcrumbRingSize, outUnreportedBreadcrumbs);
+
+		// Breadcrumbs are already a part of every event, the ring is only of use if it outlives the process
+		if (!breadcrumbRing->IsPersistent())
+		{
+			breadcrumbRing = nullptr;
+		}
+	}
+	else if (logRingSize > 0)
+	{
+		logRing = MakeShared<FSentryLogRing, ESPMode::ThreadSafe>(logRingSize);
+	}
+
+	// Tail takes the log file's name only if it replaces the file
+	const FString logFilePath = FGenericPlatformOutputDevices::GetAbsoluteLogFilename();
+	logTailFilename = eventLogTailSize > 0 ? FPaths::GetCleanFilename(logFilePath) : FPaths::GetBaseFilename(logFilePath) + TEXT("_tail.log");
+}
+
+void FGenericPlatformSentrySubsystem::CaptureUnreportedSessionTails(const TArray<uint8>& logLines, const TArray<uint8>& breadcrumbs)
+{
+	UE_LOG(LogSentrySdk, Log, TEXT("Previous session ended without reporting its log tail, sending it now."));
+
+	sentry_value_t nativeEvent = sentry_value_new_message_event(SENTRY_LEVEL_WARNING, nullptr, "Previous session ended unexpectedly");
+
+	sentry_scope_t* scope = sentry_local_scope_new();
+	sentry_scope_set_tag(scope, "crashed_last_run", sentry_get_crashed_last_run() == 1 ? "true" : "false");
+
+	if (logLines.Num() > 0)
+	{
+		sentry_attachment_t* logAttachment =
+			sentry_scope_attach_bytes(scope, reinterpret_cast<const char*>(logLines.GetData()), logLines.Num(), "previous_session.log");
+		sentry_attachment_set_content_type(logAttachment, "text/plain");
+	}
+
+	if (breadcrumbs.Num() > 0)
+	{
+		sentry_attachment_t* breadcrumbsAttachment =
+			sentry_scope_attach_bytes(scope, reinterpret_cast<const char*>(breadcrumbs.GetData()), breadcrumbs.Num(), "previous_session_breadcrumbs.log");
+		sentry_attachment_set_content_type(breadcrumbsAttachment, "text/plain");
+	}
+
+	sentry_capture_event_with_scope(nativeEvent, scope);
+}
+
+void FGenericPlatformSentrySubsystem::AddBreadcrumbVideoTimelineId(sentry_value_t breadcrumb)
+{
+	FSentryCrashVideoTimeline& timeline = FSentryCrashVideoTimeline::Get();
+	if (!timeline.IsActive())
+	{
+		return;
+	}
+
+	sentry_value_t data = sentry_value_get_by_key(breadcrumb, "data");
+	if (sentry_value_is_null(data))
+	{
+		data = sentry_value_new_object();
+		sentry_value_set_by_key(breadcrumb, "data", data);
+	}
+
+	// Matches the breadcrumb against the frames of the crash video timeline
+	sentry_value_set_by_key(data, "breadcrumb_id", sentry_value_new_int32(static_cast<int32_t>(timeline.OnBreadcrumbAdded())));
+}
+
+void FGenericPlatformSentrySubsystem::AppendToBreadcrumbRing(sentry_value_t breadcrumb)
+{
+	if (!breadcrumbRing)
+	{
+		return;
+	}
+
+	// Native strings are UTF-8 already so the line is put together on the stack without any conversion
+	ANSICHAR line[1024];
+	const int32 maxLength = UE_ARRAY_COUNT(line) - 1;
+
+	int32 length = FMath::Clamp(FCStringAnsi::Snprintf(line, maxLength, "[%.3f] ", FPlatformTime::Seconds() - GStartTime), 0, maxLength);
+
+	const auto appendString = [&line, &length, maxLength](const char* str)
+	{
+		const int32 num = FMath::Min(FCStringAnsi::Strlen(str), maxLength - length);
+		FMemory::Memcpy(line + length, str, num);
+		length += num;
+	};
+
+	appendString(sentry_value_as_string(sentry_value_get_by_key(breadcrumb, "level")));
+	appendString(" ");
+	appendString(sentry_value_as_string(sentry_value_get_by_key(breadcrumb, "category")));
+	appendString(": ");
+	appendString(sentry_value_as_string(sentry_value_get_by_key(breadcrumb, "message")));
+
+	line[length++] = '\n';
+
+	breadcrumbRing->Append(line, length);
+}
+
+sentry_uuid_t FGenericPlatformSentrySubsystem::CaptureWithLocalScope(sentry_value_t nativeEvent, TSharedPtr<FGenericPlatformSentryScope> localScope)
+{
+	SENTRY_MEMORY_SCOPE(PendingEnvelopes);
+
+	const bool hasLogTail = eventLogTailSize > 0 && !logRing->IsEmpty();
+
+	// Input events and the state timeline are only serialized for errors, they're left alone for anything less severe
+	TArray<uint8> inputEvents;
+	TArray<uint8> stateTimeline;
+
+	const char* level = sentry_value_as_string(sentry_value_get_by_key(nativeEvent, "level"));
+	if (FCStringAnsi::Strcmp(level, "error") == 0 || FCStringAnsi::Strcmp(level, "fatal") == 0)
+	{
+		if (FSentryInputRing::Get().IsActive())
+		{
+			inputEvents = FSentryInputRing::Get().Serialize();
+		}
+
+		if (FSentryStateTimelineRecorder::Get().IsActive())
+		{
+			stateTimeline = FSentryStateTimelineRecorder::Get().Serialize();
+		}
+	}
+
+	// Native SDK merges the global scope into the event at capture time, so the local scope only carries the overrides.
+	// When there are none the event is captured directly, sharing the global scope without any copying.
+	if ((!localScope || localScope->IsEmpty()) && !hasLogTail && inputEvents.Num() == 0 && stateTimeline.Num() == 0)
+	{
+		return sentry_capture_event(nativeEvent);
+	}
+
+	sentry_scope_t* scope = sentry_local_scope_new();
+
+	if (localScope)
+	{
+		localScope->Apply(scope);
+	}
+
+	if (hasLogTail)
+	{
+		const TArray<uint8> logTail = logRing->Copy(eventLogTailSize);
+
+		sentry_attachment_t* logAttachment =
+			sentry_scope_attach_bytes(scope, reinterpret_cast<const char*>(logTail.GetData()), logTail.Num(), TCHAR_TO_UTF8(*logTailFilename));
+		sentry_attachment_set_content_type(logAttachment, "text/plain");
+	}
+
+	if (inputEvents.Num() > 0)
+	{
+		sentry_attachment_t* inputEventsAttachment =
+			sentry_scope_attach_bytes(scope, reinterpret_cast<const char*>(inputEvents.GetData()), inputEvents.Num(), "input_events.json");
+		sentry_attachment_set_content_type(inputEventsAttachment, "application/json");
+	}
+
+	if (stateTimeline.Num() > 0)
+	{
+		sentry_attachment_t* stateTimelineAttachment =
+			sentry_scope_attach_bytes(scope, reinterpret_cast<const char*>(stateTimeline.GetData()), stateTimeline.Num(), "state_timeline.json");
+		sentry_attachment_set_content_type(stateTimelineAttachment, "application/json");
+	}
+
+	return sentry_capture_event_with_scope(nativeEvent, scope);
+}
+
+TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters)
+{
+	sentry_value_t exceptionEvent = sentry_value_new_event();
+
+	// Raw frame addresses are symbolicated on the server using debug files, walking them in-process would hitch the capturing thread
+	sentry_value_t nativeException = sentry_value_new_exception(TCHAR_TO_UTF8(*type), TCHAR_TO_UTF8(*message));
+	sentry_value_set_by_key(nativeException, "stacktrace", FGenericPlatformSentryConverters::CallstackToNative(programCounters));
+	sentry_event_add_exception(exceptionEvent, nativeException);
+
+	sentry_uuid_t id = CaptureWithLocalScope(exceptionEvent, nullptr);
+	return MakeShareable(new FGenericPlatformSentryId(id));
+}
+
+void FGenericPlatformSentrySubsystem::ApplyRuntimeSettings(const USentrySettings* settings)
+{
+	eventSampleRate = settings->SampleRate;
+	tracesSampleRate = settings->TracesSampleRate;
+}
+
+bool FGenericPlatformSentrySubsystem::CaptureEnvelope(const TArray<uint8>& envelope)
+{
+	sentry_envelope_t* nativeEnvelope = sentry_envelope_deserialize(reinterpret_cast<const char*>(envelope.GetData()), envelope.Num());
+	if (!nativeEnvelope)
+	{
+		return false;
+	}
+
+	// Rate limits, batching and the offline spool of the configured transport apply to it like to any other envelope
+	sentry_capture_envelope(nativeEnvelope);
+	return true;
+}
+
+void FGenericPlatformSentrySubsystem::AddMemoryStats(FSentryMemoryStats& outStats) const
+{
+	// Breadcrumbs kept by the native SDK are accounted by the allocation hooks, only the persisted tail is added here
+	if (breadcrumbRing)
+	{
+		outStats.BreadcrumbBytes += breadcrumbRing->GetCapacity();
+	}
+}
+
+TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureAppHang(const FSentryHangReport& report)
+{
+	const FSentryHangThreadStack& culprit = report.GetCulprit();
+
+	sentry_value_t hangEvent = sentry_value_new_event();
+	sentry_value_set_by_key(hangEvent, "level", sentry_value_new_string("error"));
+
+	const FString message = FString::Printf(TEXT("App hanging for at least %.0f ms."), culprit.StalledSeconds * 1000.0);
+
+	sentry_value_t nativeException = sentry_value_new_exception("App Hanging", TCHAR_TO_UTF8(*message));
+	sentry_value_set_by_key(nativeException, "stacktrace", FGenericPlatformSentryConverters::CallstackToNative(culprit.ProgramCounters));
+	sentry_value_set_by_key(nativeException, "thread_id", sentry_value_new_int32(static_cast<int32_t>(culprit.ThreadId)));
+
+	// Same mechanism as hangs reported by the Apple SDK so that both are grouped and recognized as ANRs
+	sentry_value_t mechanism = sentry_value_new_object();
+	sentry_value_set_by_key(mechanism, "type", sentry_value_new_string("AppHang"));
+	sentry_value_set_by_key(mechanism, "handled", sentry_value_new_bool(false));
+	sentry_value_set_by_key(nativeException, "mechanism", mechanism);
+
+	sentry_event_add_exception(hangEvent, nativeException);
+
+	// Stacks of the other watched threads show what they were waiting on, the culprit is marked as crashed
+	sentry_value_t threadValues = sentry_value_new_list();
+	sentry_value_t stalledThreads = sentry_value_new_object();
+	for (const FSentryHangThreadStack& threadStack : report.Threads)
+	{
+		sentry_value_t thread = sentry_value_new_object();
+		sentry_value_set_by_key(thread, "id", sentry_value_new_int32(static_cast<int32_t>(threadStack.ThreadId)));
+		sentry_value_set_by_key(thread, "name", sentry_value_new_string(TCHAR_TO_UTF8(*threadStack.Name)));
+		sentry_value_set_by_key(thread, "crashed", sentry_value_new_bool(&threadStack == &culprit));
+		sentry_value_set_by_key(thread, "current", sentry_value_new_bool(false));
+		sentry_value_set_by_key(thread, "stacktrace", FGenericPlatformSentryConverters::CallstackToNative(threadStack.ProgramCounters));
+		sentry_value_append(threadValues, thread);
+
+		if (threadStack.bIsStalled)
+		{
+			sentry_value_set_by_key(stalledThreads, TCHAR_TO_UTF8(*threadStack.Name), sentry_value_new_double(threadStack.StalledSeconds * 1000.0));
+		}
+	}
+
+	sentry_value_t threads = sentry_value_new_object();
+	sentry_value_set_by_key(threads, "values", threadValues);
+	sentry_value_set_by_key(hangEvent, "threads", threads);
+
+	sentry_value_t appHangContext = sentry_value_new_object();
+	sentry_value_set_by_key(appHangContext, "stalled_thread", sentry_value_new_string(TCHAR_TO_UTF8(*culprit.Name)));
+	sentry_value_set_by_key(appHangContext, "stalled_ms", stalledThreads);
+
+	sentry_value_t contexts = sentry_value_new_object();
+	sentry_value_set_by_key(contexts, "app_hang", appHangContext);
+	sentry_value_set_by_key(hangEvent, "contexts", contexts);
+
+	sentry_value_t tags = sentry_value_new_object();
+	sentry_value_set_by_key(tags, "hang.thread", sentry_value_new_string(TCHAR_TO_UTF8(*culprit.Name)));
+	sentry_value_set_by_key(hangEvent, "tags", tags);
+
+	TSharedPtr<FGenericPlatformSentryScope> localScope;
+
+	const TArray<FString> videoSegments = isAppHangCrashVideoEnabled ? FSentryCrashVideoSegments::Get().GetSegments() : TArray<FString>();
+	if (videoSegments.Num() > 0)
+	{
+		// Only the newest segment is attached since it covers the moments leading up to the hang
+		localScope = MakeShareable(new FGenericPlatformSentryScope());
+		localScope->AddAttachment(MakeShareable(new FGenericPlatformSentryAttachment(videoSegments.Last(), FPaths::GetCleanFilename(videoSegments.Last()), TEXT("video/mp4"))));
+	}
+
+	sentry_uuid_t id = CaptureWithLocalScope(hangEvent, localScope);
+	return MakeShareable(new FGenericPlatformSentryId(id));
+}
+
+void FGenericPlatformSentrySubsystem::CaptureFeedback(TSharedPtr<ISentryFeedback> feedback)
+{
+	SENTRY_MEMORY_SCOPE(PendingEnvelopes);
+
+	TSharedPtr<FGenericPlatformSentryFeedback> Feedback = StaticCastSharedPtr<FGenericPlatformSentryFeedback>(feedback);
+	sentry_capture_feedback(Feedback->GetNativeObject());
+}
+
+void FGenericPlatformSentrySubsystem::SetUser(TSharedPtr<ISentryUser> InUser)
+{
+	SENTRY_MEMORY_SCOPE(Scope);
+
+	TSharedPtr<FGenericPlatformSentryUser> user = StaticCastSharedPtr<FGenericPlatformSentryUser>(InUser);
+
+	// sentry-native doesn't provide `send_default_pii` option, so we need to check if user's `ip_address`
+	// allowed to be determined automatically
+	if (isPiiAttachmentEnabled && user->GetIpAddress().IsEmpty())
+	{
+		user->SetIpAddress(TEXT("{{auto}}"));
+	}
+
+	sentry_set_user(user->GetNativeObject());
+
+	if (crashReporter)
+	{
+		crashReporter->SetUser(user);
+	}
+}
+
+void FGenericPlatformSentrySubsystem::RemoveUser()
+{
+	SENTRY_MEMORY_SCOPE(Scope);
+
+	sentry_remove_user();
+
+	if (crashReporter)
+	{
+		crashReporter->RemoveUser();
+	}
+}
+
+void FGenericPlatformSentrySubsystem::SetContext(const FString& key, const TMap<FString, FSentryVariant>& values)
+{
+	SENTRY_MEMORY_SCOPE(Scope);
+
+	// Context set once again is no longer considered static
+	if (staticScope)
+	{
+		staticScope->RemoveContext(key);
+	}
+
+	TMap<FString, FSentryVariant> contextValues = values;
+	SentryScopeLimits::TrimContext(contextValues, maxContextDepth, maxContextValues);
+
+	sentry_set_context(TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantMapToNative(contextValues));
+
+	if (crashReporter)
+	{
+		crashReporter->SetContext(key, contextValues);
+	}
+
+	TouchContextKey(key);
+}
+
+void FGenericPlatformSentrySubsystem::SetStaticContext(const FString& key, const TMap<FString, FSentryVariant>& values)
+{
+	SENTRY_MEMORY_SCOPE(Scope);
+
+	if (!staticScope)
+	{
+		SetContext(key, values);
+		return;
+	}
+
+	TMap<FString, FSentryVariant> contextValues = values;
+	SentryScopeLimits::TrimContext(contextValues, maxContextDepth, maxContextValues);
+
+	sentry_value_t context = FGenericPlatformSentryConverters::VariantMapToNative(contextValues);
+
+	// Registered before the native scope takes over the context so that it's never released in between
+	staticScope->SetContext(key, context);
+	sentry_set_context(TCHAR_TO_UTF8(*key), context);
+
+	if (crashReporter)
+	{
+		crashReporter->SetContext(key, contextValues);
+	}
+
+	TouchContextKey(key);
+}
+
+void FGenericPlatformSentrySubsystem::SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData)
+{
+	SENTRY_MEMORY_SCOPE(Scope);
+
+	if (staticScope)
+	{
+		staticScope->RemoveContext(key);
+	}
+
+	const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> layout = FSentryStructLayout::Get(structType);
+
+	if (crashReporter)
+	{
+		// Crash reporter keeps its own copy of the scope as values, which have to be built anyway
+		SetContext(key, layout->ToVariantMap(structData));
+		return;
+	}
+
+	int32 numTrimmed = 0;
+	sentry_value_t context = FGenericPlatformSentryConverters::StructToNative(*layout, structData, maxContextDepth, maxContextValues, numTrimmed);
+	if (numTrimmed > 0)
 	{
-		sentry_value_set_stacktrace(nativeEvent, nullptr, 0);
+		SentryScopeLimits::RecordEvicted(numTrimmed);
 	}
 
-	sentry_scope_t* scope = sentry_local_scope_new();
-
-	TSharedPtr<FGenericPlatformSentryScope> NewLocalScope = MakeShareable(new FGenericPlatformSentryScope());
-	onScopeConfigure.ExecuteIfBound(NewLocalScope);
-	NewLocalScope->Apply(scope);
-
-	sentry_uuid_t id = sentry_capture_event_with_scope(nativeEvent, scope);
+	sentry_set_context(TCHAR_TO_UTF8(*key), context);
 
-	return MakeShareable(new FGenericPlatformSentryId(id));
+	TouchContextKey(key);
 }
 
-TSharedPtr<ISentryId> FGenericPlatformSentrySubsystem::CaptureEnsure(const FString& type, const FString& message)
+void FGenericPlatformSentrySubsystem::TouchContextKey(const FString& key)
 {
-	sentry_value_t exceptionEvent = sentry_value_new_event();
-
-	sentry_value_t nativeException = sentry_value_new_exception(TCHAR_TO_ANSI(*type), TCHAR_TO_ANSI(*message));
-	sentry_event_add_exception(exceptionEvent, nativeException);
-
-	sentry_value_set_stacktrace(exceptionEvent, nullptr, 0);
+	FString evictedKey;
+	if (contextsLimiter && contextsLimiter->Touch(key, evictedKey))
+	{
+		sentry_remove_context(TCHAR_TO_UTF8(*evictedKey));
 
-	sentry_uuid_t id = sentry_capture_event(exceptionEvent);
-	return MakeShareable(new FGenericPlatformSentryId(id));
-}
+		if (staticScope)
+		{
+			staticScope->RemoveContext(evictedKey);
+		}
 
-void FGenericPlatformSentrySubsystem::CaptureFeedback(TSharedPtr<ISentryFeedback> feedback)
-{
-	TSharedPtr<FGenericPlatformSentryFeedback> Feedback = StaticCastSharedPtr<FGenericPlatformSentryFeedback>(feedback);
-	sentry_capture_feedback(Feedback->GetNativeObject());
+		if (crashReporter)
+		{
+			crashReporter->RemoveContext(evictedKey);
+		}
+	}
 }
 
-void FGenericPlatformSentrySubsystem::SetUser(TSharedPtr<ISentryUser> InUser)
+void FGenericPlatformSentrySubsystem::SetTag(const FString& key, const FString& value)
 {
-	TSharedPtr<FGenericPlatformSentryUser> user = StaticCastSharedPtr<FGenericPlatformSentryUser>(InUser);
+	SENTRY_MEMORY_SCOPE(Scope);
 
-	// sentry-native doesn't provide `send_default_pii` option, so we need to check if user's `ip_address`
-	// allowed to be determined automatically
-	if (isPiiAttachmentEnabled && user->GetIpAddress().IsEmpty())
+	if (staticScope)
 	{
-		user->SetIpAddress(TEXT("{{auto}}"));
+		staticScope->RemoveTag(key);
 	}
 
-	sentry_set_user(user->GetNativeObject());
+	sentry_set_tag(TCHAR_TO_UTF8(*key), TCHAR_TO_UTF8(*value));
 
 	if (crashReporter)
 	{
-		crashReporter->SetUser(user);
+		crashReporter->SetTag(key, value);
 	}
-}
-
-void FGenericPlatformSentrySubsystem::RemoveUser()
-{
-	sentry_remove_user();
 
-	if (crashReporter)
+	FString evictedKey;
+	if (tagsLimiter && tagsLimiter->Touch(key, evictedKey))
 	{
-		crashReporter->RemoveUser();
+		sentry_remove_tag(TCHAR_TO_UTF8(*evictedKey));
+
+		if (staticScope)
+		{
+			staticScope->RemoveTag(evictedKey);
+		}
+
+		if (crashReporter)
+		{
+			crashReporter->RemoveTag(evictedKey);
+		}
 	}
 }
 
-void FGenericPlatformSentrySubsystem::SetContext(const FString& key, const TMap<FString, FSentryVariant>& values)
+void FGenericPlatformSentrySubsystem::SetTags(const TMap<FString, FString>& tags)
 {
-	sentry_set_context(TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
-
-	if (crashReporter)
+	// Native SDK has no bulk API, each tag takes the scope lock on its own
+	for (const auto& tag : tags)
 	{
-		crashReporter->SetContext(key, values);
+		SetTag(tag.Key, tag.Value);
 	}
 }
 
-void FGenericPlatformSentrySubsystem::SetTag(const FString& key, const FString& value)
+void FGenericPlatformSentrySubsystem::SetStaticTag(const FString& key, const FString& value)
 {
-	sentry_set_tag(TCHAR_TO_UTF8(*key), TCHAR_TO_UTF8(*value));
+	SENTRY_MEMORY_SCOPE(Scope);
 
-	if (crashReporter)
+	SetTag(key, value);
+
+	if (staticScope)
 	{
-		crashReporter->SetTag(key, value);
+		staticScope->SetTag(key, value);
 	}
 }
 
 void FGenericPlatformSentrySubsystem::RemoveTag(const FString& key)
 {
+	SENTRY_MEMORY_SCOPE(Scope);
+
+	if (staticScope)
+	{
+		staticScope->RemoveTag(key);
+	}
+
 	sentry_remove_tag(TCHAR_TO_UTF8(*key));
 
 	if (crashReporter)
 	{
 		crashReporter->RemoveTag(key);
 	}
+
+	if (tagsLimiter)
+	{
+		tagsLimiter->Remove(key);
+	}
 }
 
 void FGenericPlatformSentrySubsystem::SetLevel(ESentryLevel level)
 {
+	SENTRY_MEMORY_SCOPE(Scope);
+
 	sentry_set_level(FGenericPlatformSentryConverters::SentryLevelToNative(level));
 }
 
@@ -774,14 +1988,17 @@ TSharedPtr<ISentryTransaction> FGenericPlatformSentrySubsystem::StartTransaction
 {
 	if (TSharedPtr<FGenericPlatformSentryTransactionContext> platformTransactionContext = StaticCastSharedPtr<FGenericPlatformSentryTransactionContext>(context))
 	{
-		if (sentry_transaction_t* nativeTransaction = sentry_transaction_start(platformTransactionContext->GetNativeObject(), sentry_value_new_null()))
+		// Transaction and its spans are timed with the monotonic clock anchored here instead of reading the wall clock each time
+		const FSentryMonotonicClock clock;
+
+		if (sentry_transaction_t* nativeTransaction = sentry_transaction_start_ts(platformTransactionContext->GetNativeObject(), sentry_value_new_null(), clock.GetTimestamp()))
 		{
 			if (bindToScope)
 			{
 				sentry_set_transaction_object(nativeTransaction);
 			}
 
-			return MakeShareable(new FGenericPlatformSentryTransaction(nativeTransaction));
+			return MakeShareable(new FGenericPlatformSentryTransaction(nativeTransaction, clock, GetTransactionProfiler()));
 		}
 	}
 
@@ -799,7 +2016,7 @@ TSharedPtr<ISentryTransaction> FGenericPlatformSentrySubsystem::StartTransaction
 				sentry_set_transaction_object(nativeTransaction);
 			}
 
-			return MakeShareable(new FGenericPlatformSentryTransaction(nativeTransaction));
+			return MakeShareable(new FGenericPlatformSentryTransaction(nativeTransaction, FSentryMonotonicClock(), GetTransactionProfiler()));
 		}
 	}
 
@@ -810,14 +2027,16 @@ TSharedPtr<ISentryTransaction> FGenericPlatformSentrySubsystem::StartTransaction
 {
 	if (TSharedPtr<FGenericPlatformSentryTransactionContext> platformTransactionContext = StaticCastSharedPtr<FGenericPlatformSentryTransactionContext>(context))
 	{
-		if (sentry_transaction_t* nativeTransaction = sentry_transaction_start(platformTransactionContext->GetNativeObject(), FGenericPlatformSentryConverters::VariantMapToNative(options.CustomSamplingContext)))
+		const FSentryMonotonicClock clock;
+
+		if (sentry_transaction_t* nativeTransaction = sentry_transaction_start_ts(platformTransactionContext->GetNativeObject(), FGenericPlatformSentryConverters::VariantMapToNative(options.CustomSamplingContext), clock.GetTimestamp()))
 		{
 			if (options.BindToScope)
 			{
 				sentry_set_transaction_object(nativeTransaction);
 			}
 
-			return MakeShareable(new FGenericPlatformSentryTransaction(nativeTransaction));
+			return MakeShareable(new FGenericPlatformSentryTransaction(nativeTransaction, clock, GetTransactionProfiler()));
 		}
 	}
 
@@ -828,7 +2047,7 @@ TSharedPtr<ISentryTransactionContext> FGenericPlatformSentrySubsystem::ContinueT
 {
 	TSharedPtr<FGenericPlatformSentryTransactionContext> transactionContext = MakeShareable(new FGenericPlatformSentryTransactionContext(TEXT("<unlabeled transaction>"), TEXT("default")));
 
-	sentry_transaction_context_update_from_header(transactionContext->GetNativeObject(), "sentry-trace", TCHAR_TO_ANSI(*sentryTrace));
+	sentry_transaction_context_update_from_header(transactionContext->GetNativeObject(), "sentry-trace", TCHAR_TO_UTF8(*sentryTrace));
 
 	// currently `sentry-native` doesn't have API for `sentry_transaction_context_t` to set `baggageHeaders`
 
@@ -857,20 +2076,102 @@ USentryTraceSampler* FGenericPlatformSentrySubsystem::GetTraceSampler() const
 
 void FGenericPlatformSentrySubsystem::TryCaptureScreenshot()
 {
-	const FString& ScreenshotPath = GetScreenshotPath();
+	const FString& ScreenshotPath = crashPaths.ScreenshotPath;
+
+	// Cached frame doesn't need the GPU or Slate which might be unusable if the render thread crashed
+	const bool bCaptured = SentryScreenshotUtils::IsLastFrameCacheActive()
+		? SentryScreenshotUtils::SaveLastFrame(ScreenshotPath)
+		: SentryScreenshotUtils::CaptureScreenshot(ScreenshotPath);
 
-	if (!SentryScreenshotUtils::CaptureScreenshot(ScreenshotPath))
+	if (!bCaptured)
 	{
 		// Screenshot capturing is a best-effort solution so if one wasn't captured skip the attachment
 		return;
 	}
 
 	TSharedPtr<ISentryAttachment> ScreenshotAttachment =
-		MakeShareable(new FGenericPlatformSentryAttachment(ScreenshotPath, TEXT("screenshot.png"), TEXT("image/png")));
+		MakeShareable(new FGenericPlatformSentryAttachment(ScreenshotPath, crashPaths.ScreenshotFilename, crashPaths.ScreenshotContentType));
 
 	AddFileAttachment(ScreenshotAttachment);
 }
 
+void FGenericPlatformSentrySubsystem::AddGpuBreadcrumbsContext(sentry_value_t event)
+{
+	const TArray<FSentryGpuBreadcrumb> breadcrumbs = FSentryGpuBreadcrumbs::Get().GetBreadcrumbs();
+	if (breadcrumbs.Num() == 0)
+	{
+		return;
+	}
+
+	sentry_value_t passes = sentry_value_new_list();
+	int32 lastCompletedIndex = INDEX_NONE;
+
+	for (int32 i = 0; i < breadcrumbs.Num(); ++i)
+	{
+		const FSentryGpuBreadcrumb& breadcrumb = breadcrumbs[i];
+
+		sentry_value_t pass = sentry_value_new_object();
+		sentry_value_set_by_key(pass, "name", sentry_value_new_string(TCHAR_TO_UTF8(*breadcrumb.Name.ToString())));
+		sentry_value_set_by_key(pass, "frame", sentry_value_new_int32(static_cast<int32_t>(breadcrumb.Frame)));
+		sentry_value_set_by_key(pass, "completed", sentry_value_new_bool(breadcrumb.bIsCompleted));
+		sentry_value_append(passes, pass);
+
+		if (breadcrumb.bIsCompleted)
+		{
+			lastCompletedIndex = i;
+		}
+	}
+
+	sentry_value_t gpuBreadcrumbs = sentry_value_new_object();
+	sentry_value_set_by_key(gpuBreadcrumbs, "passes", passes);
+
+	if (lastCompletedIndex != INDEX_NONE)
+	{
+		sentry_value_set_by_key(gpuBreadcrumbs, "last_completed", sentry_value_new_string(TCHAR_TO_UTF8(*breadcrumbs[lastCompletedIndex].Name.ToString())));
+	}
+
+	// Oldest pass the GPU hasn't been seen finishing is the most likely one to have caused the device loss
+	if (breadcrumbs.IsValidIndex(lastCompletedIndex + 1))
+	{
+		sentry_value_set_by_key(gpuBreadcrumbs, "first_incomplete", sentry_value_new_string(TCHAR_TO_UTF8(*breadcrumbs[lastCompletedIndex + 1].Name.ToString())));
+	}
+
+	SetEventContext(event, "gpu_breadcrumbs", gpuBreadcrumbs);
+}
+
+void FGenericPlatformSentrySubsystem::AddMemoryContext(sentry_value_t event, const FSentryMemorySample& sample)
+{
+	if (!sample.IsValid())
+	{
+		return;
+	}
+
+	// Events carrying a sample of their own, e.g. out of memory reports of the previous session, keep it
+	SetEventContext(event, "memory", FGenericPlatformSentryConverters::VariantMapToNative(sample.ToContext()), false);
+}
+
+void FGenericPlatformSentrySubsystem::AddPerformanceContext(sentry_value_t event)
+{
+	const TMap<FString, FSentryVariant> context = FSentryFrameTimeHistory::Get().ToContext();
+	if (context.Num() == 0)
+	{
+		return;
+	}
+
+	SetEventContext(event, "performance", FGenericPlatformSentryConverters::VariantMapToNative(context));
+}
+
+void FGenericPlatformSentrySubsystem::AddNetworkContext(sentry_value_t event)
+{
+	const TMap<FString, FSentryVariant> context = FSentryNetworkQuality::Get().ToContext();
+	if (context.Num() == 0)
+	{
+		return;
+	}
+
+	SetEventContext(event, "network", FGenericPlatformSentryConverters::VariantMapToNative(context));
+}
+
 void FGenericPlatformSentrySubsystem::TryCaptureGpuDump()
 {
 	const FString& GpuDumpPath = SentryFileUtils::GetGpuDumpPath();
@@ -886,37 +2187,289 @@ void FGenericPlatformSentrySubsystem::TryCaptureGpuDump()
 	AddFileAttachment(GpuDumpAttachment);
 }
 
-void FGenericPlatformSentrySubsystem::TryCaptureEmergencyCrashVideo()
+uint32 FGenericPlatformSentrySubsystem::GetCrashVideoFingerprint(const sentry_ucontext_t* uctx)
 {
-#if HAS_RUNTIME_VIDEO_RECORDER
-	URuntimeVideoRecorder* VideoRecorder = GEngine ? GEngine->GetEngineSubsystem<URuntimeVideoRecorder>() : nullptr;
-	if (!VideoRecorder || !VideoRecorder->IsRecordingInProgress())
+	// Crashed thread is unwound from the crash context so the fingerprint points at the crash site rather than the handler
+	void* frames[FSentryCrashVideoHistory::MaxFingerprintDepth];
+	const int32 depth = uctx ? static_cast<int32>(sentry_unwind_stack_from_ucontext(uctx, frames, FSentryCrashVideoHistory::MaxFingerprintDepth)) : 0;
+	if (depth == 0)
 	{
-		return;
+		return FSentryCrashVideoHistory::CaptureCrashFingerprint();
+	}
+
+	uint64 programCounters[FSentryCrashVideoHistory::MaxFingerprintDepth];
+	for (int32 i = 0; i < depth; ++i)
+	{
+		programCounters[i] = reinterpret_cast<uint64>(frames[i]);
+	}
+
+	return FSentryCrashVideoHistory::GetCrashFingerprint(programCounters, depth);
+}
+
+bool FGenericPlatformSentrySubsystem::ShouldCaptureCrashVideo(sentry_value_t event, uint32 fingerprint)
+{
+	const ESentryCrashVideoSkipReason skipReason = FSentryCrashVideoHistory::Get().ShouldCaptureVideo(fingerprint, FDateTime::UtcNow().ToUnixTimestamp());
+	if (skipReason == ESentryCrashVideoSkipReason::None)
+	{
+		return true;
+	}
+
+	// Lets the issue tell crashes without a video by design apart from failed captures
+	sentry_value_t tags = sentry_value_get_by_key(event, "tags");
+	if (sentry_value_is_null(tags))
+	{
+		tags = sentry_value_new_object();
+		sentry_value_set_by_key(event, "tags", tags);
+	}
+
+	sentry_value_set_by_key(tags, "crash_video", sentry_value_new_string(skipReason == ESentryCrashVideoSkipReason::Duplicate ? "duplicate" : "sampled_out"));
+
+	return false;
+}
+
+bool FGenericPlatformSentrySubsystem::TryCaptureEmergencyCrashVideo(const FString& eventId, ESentryCrashVideoDelivery& outDelivery)
+{
+	outDelivery = ESentryCrashVideoDelivery::Attached;
+
+	FSentryCrashVideoRawRing& RawRing = FSentryCrashVideoRawRing::Get();
+	if (RawRing.IsActive())
+	{
+		// Raw frames are already in the mapped ring file, so the video is encoded and uploaded on the next launch
+		outDelivery = ESentryCrashVideoDelivery::Deferred;
+		return RawRing.MarkCrashed(eventId);
+	}
+
+	FSentryCrashVideoSegments& Segments = FSentryCrashVideoSegments::Get();
+	if (Segments.HasSegments())
+	{
+		// Segments are already encoded so only the concat index has to be written at crash time.
+		// Oldest segments are dropped so that the video leading up to the crash fits the attachment size limit.
+		const TArray<FString> SegmentPaths = Segments.GetNewestSegmentsWithinSize(maxAttachmentSize);
+		if (SegmentPaths.Num() == 0)
+		{
+			return false;
+		}
+
+		FString SegmentsDir;
+		FString IndexPath;
+		FString TimelinePath;
+		Segments.GetPaths(SegmentsDir, IndexPath, TimelinePath);
+
+		if (isCrashVideoUploadDeferred)
+		{
+			// Leave the video on disk to be uploaded on the next launch
+			FSentryCrashVideoSegments::WriteIndex(IndexPath, SegmentPaths);
+
+			TArray<FString> PendingFiles = SegmentPaths;
+			PendingFiles.Add(IndexPath);
+
+			if (FSentryCrashVideoTimeline::Get().IsActive() && FSentryCrashVideoTimeline::Get().Write(TimelinePath))
+			{
+				PendingFiles.Add(TimelinePath);
+			}
+
+			if (SentryCrashVideoPendingUpload::Persist(SegmentsDir, PendingFiles, eventId))
+			{
+				outDelivery = ESentryCrashVideoDelivery::Deferred;
+				return true;
+			}
+		}
+
+		if (FSentryCrashVideoSegments::WriteIndex(IndexPath, SegmentPaths))
+		{
+			AddFileAttachment(MakeShareable(new FGenericPlatformSentryAttachment(IndexPath, FPaths::GetCleanFilename(IndexPath), TEXT("text/plain"))));
+		}
+
+		// Keep original filenames so that the index can be used as-is after downloading the attachments
+		for (const FString& SegmentPath : SegmentPaths)
+		{
+			AddFileAttachment(MakeShareable(new FGenericPlatformSentryAttachment(SegmentPath, FPaths::GetCleanFilename(SegmentPath), TEXT("video/mp4"))));
+		}
+
+		TryCaptureCrashVideoTimeline(TimelinePath);
+
+		return true;
+	}
+
+	// Video recorder is driven by the SentryVideo module, which isn't loaded in every target
+	ISentryCrashVideoCapture* CrashVideoCapture = FSentryModule::GetCrashVideoCapture();
+	if (!CrashVideoCapture || crashPaths.CrashVideoClipPath.IsEmpty())
+	{
+		return false;
 	}
 
 	// Encode the circular buffer to video immediately
-	FString CrashVideoDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"));
-	FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
-	FString OutputBasePath = FPaths::Combine(CrashVideoDir, FString::Printf(TEXT("crash_video_%s"), *Timestamp));
-	
-	bool bSuccess = VideoRecorder->EncodeCircularBufferToVideo(OutputBasePath);
-	
-	if (!bSuccess)
+	const FString& VideoPath = crashPaths.CrashVideoClipPath;
+
+	if (!CrashVideoCapture->EncodeEmergencyClip())
 	{
 		// Video encoding failed, nothing to attach
-		return;
+		return false;
+	}
+
+	// Video exceeding the limit would be discarded by the server after being fully uploaded
+	const int64 VideoSize = IFileManager::Get().FileSize(*VideoPath);
+	if (maxAttachmentSize > 0 && VideoSize > maxAttachmentSize)
+	{
+		return false;
 	}
-	
-	// The encoded video file path (EncodeCircularBufferToVideo appends "_crash_recovery.mp4")
-	FString VideoPath = OutputBasePath + TEXT("_crash_recovery.mp4");
 	
 	// Create Sentry attachment immediately (same pattern as screenshot)
 	TSharedPtr<ISentryAttachment> VideoAttachment =
 		MakeShareable(new FGenericPlatformSentryAttachment(VideoPath, TEXT("crash_video.mp4"), TEXT("video/mp4")));
 	
 	AddFileAttachment(VideoAttachment);
-#endif
+
+	TryCaptureCrashVideoTimeline(crashPaths.CrashVideoTimelinePath);
+
+	return true;
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureCrashVideoTimeline(const FString& timelinePath)
+{
+	FSentryCrashVideoTimeline& Timeline = FSentryCrashVideoTimeline::Get();
+	if (!Timeline.IsActive())
+	{
+		return;
+	}
+
+	// Frames are already recorded in a fixed-size ring so writing them out doesn't involve any formatting
+	if (!Timeline.Write(timelinePath))
+	{
+		return;
+	}
+
+	AddFileAttachment(MakeShareable(new FGenericPlatformSentryAttachment(timelinePath, TEXT("crash_video_timeline.bin"), TEXT("application/octet-stream"))));
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureCrashAudio()
+{
+	FSentryCrashAudioRing& AudioRing = FSentryCrashAudioRing::Get();
+	if (!AudioRing.IsActive())
+	{
+		return;
+	}
+
+	// Audio is kept as raw PCM so writing it out doesn't involve any encoding
+	const FString& AudioPath = crashPaths.CrashAudioPath;
+	if (!AudioRing.WriteWaveFile(AudioPath))
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryAttachment> AudioAttachment =
+		MakeShareable(new FGenericPlatformSentryAttachment(AudioPath, TEXT("crash_audio.wav"), TEXT("audio/wav")));
+
+	AddFileAttachment(AudioAttachment);
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureCrashFrameStrip()
+{
+	FSentryCrashVideoFrameStrip& FrameStrip = FSentryCrashVideoFrameStrip::Get();
+	if (!FrameStrip.IsActive())
+	{
+		return;
+	}
+
+	// Sprite sheet is kept encoded in memory so it only has to be written to disk here
+	const FString& FrameStripPath = crashPaths.CrashFrameStripPath;
+	if (!FrameStrip.WriteSpriteSheet(FrameStripPath))
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryAttachment> FrameStripAttachment =
+		MakeShareable(new FGenericPlatformSentryAttachment(FrameStripPath, TEXT("crash_frames.jpg"), TEXT("image/jpeg")));
+
+	AddFileAttachment(FrameStripAttachment);
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureCrashMemoryRegions()
+{
+	FSentryCrashMemoryRegions& MemoryRegions = FSentryCrashMemoryRegions::Get();
+	if (!MemoryRegions.HasRegions())
+	{
+		return;
+	}
+
+	const FString& MemoryRegionsPath = crashPaths.CrashMemoryRegionsPath;
+	if (!MemoryRegions.Write(MemoryRegionsPath))
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryAttachment> MemoryRegionsAttachment =
+		MakeShareable(new FGenericPlatformSentryAttachment(MemoryRegionsPath, TEXT("crash_memory.bin"), TEXT("application/octet-stream")));
+
+	AddFileAttachment(MemoryRegionsAttachment);
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureServerReplay()
+{
+	// Replay streamer writes the segments as it records, so whatever reached the disk before the crash is attached
+	TArray<FString> Segments;
+	if (!FSentryServerReplay::Get().GetSegments(Segments))
+	{
+		return;
+	}
+
+	for (const FString& SegmentPath : Segments)
+	{
+		if (!IFileManager::Get().FileExists(*SegmentPath))
+		{
+			continue;
+		}
+
+		TSharedPtr<ISentryAttachment> SegmentAttachment =
+			MakeShareable(new FGenericPlatformSentryAttachment(SegmentPath, FPaths::GetCleanFilename(SegmentPath), TEXT("application/octet-stream")));
+
+		AddFileAttachment(SegmentAttachment);
+	}
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureInputEvents()
+{
+	TArray<uint8> InputEvents = FSentryInputRing::Get().Serialize();
+	if (InputEvents.Num() == 0)
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryAttachment> InputEventsAttachment =
+		MakeShareable(new FGenericPlatformSentryAttachment(MoveTemp(InputEvents), TEXT("input_events.json"), TEXT("application/json")));
+
+	AddByteAttachment(InputEventsAttachment);
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureStateTimeline()
+{
+	TArray<uint8> StateTimeline = FSentryStateTimelineRecorder::Get().Serialize();
+	if (StateTimeline.Num() == 0)
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryAttachment> StateTimelineAttachment =
+		MakeShareable(new FGenericPlatformSentryAttachment(MoveTemp(StateTimeline), TEXT("state_timeline.json"), TEXT("application/json")));
+
+	AddByteAttachment(StateTimelineAttachment);
+}
+
+void FGenericPlatformSentrySubsystem::TryCaptureCrashLogTail()
+{
+	// Log file may not have been flushed before the crash, the ring always holds the lines up to the last one
+	TArray<uint8> LogTail = logRing->Copy(crashLogTailSize);
+	if (LogTail.Num() == 0)
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryAttachment> LogTailAttachment =
+		MakeShareable(new FGenericPlatformSentryAttachment(MoveTemp(LogTail), logTailFilename, TEXT("text/plain")));
+
+	AddByteAttachment(LogTailAttachment);
+
+	logRing->MarkReported();
 }
 
 FString FGenericPlatformSentrySubsystem::GetHandlerPath() const
@@ -929,15 +2482,35 @@ FString FGenericPlatformSentrySubsystem::GetHandlerPath() const
 
 FString FGenericPlatformSentrySubsystem::GetDatabasePath() const
 {
-	const FString DatabasePath = FPaths::Combine(databaseParentPath, TEXT(".sentry-native"));
+	// Instance databases are kept next to the default one since sentry-native owns everything inside its database
+	const FString DatabasePath = databaseInstanceKey.IsEmpty()
+		? FPaths::Combine(databaseParentPath, TEXT(".sentry-native"))
+		: FPaths::Combine(databaseParentPath, FString::Printf(TEXT(".sentry-native-%s"), *databaseInstanceKey));
 	const FString DatabaseFullPath = FPaths::ConvertRelativePathToFull(DatabasePath);
 
 	return DatabaseFullPath;
 }
 
+void FGenericPlatformSentrySubsystem::PrepareCrashPaths()
+{
+	crashPaths.ScreenshotPath = GetScreenshotPath();
+	crashPaths.ScreenshotFilename = TEXT("screenshot.") + SentryScreenshotUtils::GetScreenshotExtension();
+	crashPaths.ScreenshotContentType = SentryScreenshotUtils::GetScreenshotContentType();
+
+	crashPaths.CrashVideoDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos")));
+	crashPaths.CrashVideoTimelinePath = FPaths::Combine(crashPaths.CrashVideoDir, TEXT("crash_video_timeline.bin"));
+	crashPaths.CrashAudioPath = FPaths::Combine(crashPaths.CrashVideoDir, TEXT("crash_audio.wav"));
+	crashPaths.CrashFrameStripPath = FPaths::Combine(crashPaths.CrashVideoDir, TEXT("crash_frames.jpg"));
+	crashPaths.CrashMemoryRegionsPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashMemory"), TEXT("crash_memory.bin")));
+
+	// Video recorder is driven by the SentryVideo module which registers itself before the SDK is initialized
+	ISentryCrashVideoCapture* CrashVideoCapture = FSentryModule::GetCrashVideoCapture();
+	crashPaths.CrashVideoClipPath = CrashVideoCapture ? CrashVideoCapture->PrepareEmergencyClip(crashPaths.CrashVideoDir) : FString();
+}
+
 FString FGenericPlatformSentrySubsystem::GetScreenshotPath() const
 {
-	const FString ScreenshotPath = FPaths::Combine(GetDatabasePath(), TEXT("screenshots"), FString::Printf(TEXT("screenshot-%s.png"), *FDateTime::Now().ToString()));
+	const FString ScreenshotPath = FPaths::Combine(GetDatabasePath(), TEXT("screenshots"), FString::Printf(TEXT("screenshot-%s.%s"), *FDateTime::Now().ToString(), *SentryScreenshotUtils::GetScreenshotExtension()));
 	const FString ScreenshotFullPath = FPaths::ConvertRelativePathToFull(ScreenshotPath);
 
 	return ScreenshotFullPath;
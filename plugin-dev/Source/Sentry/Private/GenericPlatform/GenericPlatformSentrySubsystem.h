@@ -6,11 +6,27 @@
 
 #include "Interface/SentrySubsystemInterface.h"
 
+#include "Utils/SentryCrashPaths.h"
+#include "Utils/SentryCrashTimeline.h"
+#include "Utils/SentryLogFilterRules.h"
+#include "Utils/SentryScopeLimiter.h"
+#include "Utils/SentryTraceSampleRules.h"
+
 #include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
 
 class FGenericPlatformSentryAttachment;
 class FGenericPlatformSentryScope;
+class FGenericPlatformSentryStacktraceCache;
+class FGenericPlatformSentryStaticScope;
 class FGenericPlatformSentryCrashReporter;
+class FSentryAdaptiveSampler;
+class FSentryDeferredCallbacks;
+class FSentryLogRing;
+class FSentrySamplingProfiler;
+struct FSentryMemorySample;
+
+enum class ESentryCrashVideoDelivery : uint8;
 
 #if USE_SENTRY_NATIVE
 
@@ -34,13 +50,17 @@ public:
 	virtual TSharedPtr<ISentryId> CaptureMessageWithScope(const FString& message, ESentryLevel level, const FSentryScopeDelegate& onConfigureScope) override;
 	virtual TSharedPtr<ISentryId> CaptureEvent(TSharedPtr<ISentryEvent> event) override;
 	virtual TSharedPtr<ISentryId> CaptureEventWithScope(TSharedPtr<ISentryEvent> event, const FSentryScopeDelegate& onScopeConfigure) override;
-	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message) override;
+	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters) override;
 	virtual void CaptureFeedback(TSharedPtr<ISentryFeedback> feedback) override;
 	virtual void SetUser(TSharedPtr<ISentryUser> user) override;
 	virtual void RemoveUser() override;
 	virtual void SetContext(const FString& key, const TMap<FString, FSentryVariant>& values) override;
+	virtual void SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData) override;
 	virtual void SetTag(const FString& key, const FString& value) override;
+	virtual void SetTags(const TMap<FString, FString>& tags) override;
 	virtual void RemoveTag(const FString& key) override;
+	virtual void SetStaticContext(const FString& key, const TMap<FString, FSentryVariant>& values) override;
+	virtual void SetStaticTag(const FString& key, const FString& value) override;
 	virtual void SetLevel(ESentryLevel level) override;
 	virtual void StartSession() override;
 	virtual void EndSession() override;
@@ -54,6 +74,11 @@ public:
 	virtual TSharedPtr<ISentryTransactionContext> ContinueTrace(const FString& sentryTrace, const TArray<FString>& baggageHeaders) override;
 
 	virtual void HandleAssert() override {}
+	virtual TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> GetLogRing() const override { return logRing; }
+	virtual TSharedPtr<ISentryId> CaptureAppHang(const FSentryHangReport& report) override;
+	virtual void AddMemoryStats(FSentryMemoryStats& outStats) const override;
+	virtual bool CaptureEnvelope(const TArray<uint8>& envelope) override;
+	virtual void ApplyRuntimeSettings(const USentrySettings* settings) override;
 
 	USentryBeforeSendHandler* GetBeforeSendHandler() const;
 	USentryBeforeBreadcrumbHandler* GetBeforeBreadcrumbHandler() const;
@@ -62,7 +87,24 @@ public:
 
 	void TryCaptureScreenshot();
 	void TryCaptureGpuDump();
-	void TryCaptureEmergencyCrashVideo();
+	void AddGpuBreadcrumbsContext(sentry_value_t event);
+	void AddMemoryContext(sentry_value_t event, const FSentryMemorySample& sample);
+	void AddPerformanceContext(sentry_value_t event);
+	void AddNetworkContext(sentry_value_t event);
+	uint32 GetCrashVideoFingerprint(const sentry_ucontext_t* uctx);
+	bool ShouldCaptureCrashVideo(sentry_value_t event, uint32 fingerprint);
+	bool TryCaptureEmergencyCrashVideo(const FString& eventId, ESentryCrashVideoDelivery& outDelivery);
+	void TryCaptureCrashVideoTimeline(const FString& timelinePath);
+	void TryCaptureCrashAudio();
+	void TryCaptureCrashFrameStrip();
+	void TryCaptureCrashLogTail();
+	void TryCaptureInputEvents();
+	void TryCaptureStateTimeline();
+	void TryCaptureCrashMemoryRegions();
+	void TryCaptureServerReplay();
+
+	/** Records the crash handler stage that has just finished if the crash timeline is enabled. */
+	void MarkCrashStage(const TCHAR* name);
 
 protected:
 	virtual void ConfigureHandlerPath(sentry_options_t* Options) {}
@@ -73,10 +115,21 @@ protected:
 
 	FString GetHandlerPath() const;
 	FString GetDatabasePath() const;
+
+	/** Whether envelopes are sent through the engine's HTTP module rather than the sentry-native transport. */
+	bool IsBatchedTransportEnabled() const { return isBatchedTransportEnabled; }
 	FString GetScreenshotPath() const;
 	virtual FString GetHandlerExecutableName() const { return TEXT("invalid"); }
 
 	virtual sentry_value_t OnBeforeSend(sentry_value_t event, void* hint, void* closure, bool isCrash);
+
+	/** Trims the event to the configured size limit and accounts its size, returns the event. */
+	sentry_value_t ApplyPayloadBudget(sentry_value_t event);
+
+	/** Strips the entries the transport splices back from a pre-serialized fragment, returns the event. */
+	sentry_value_t StripStaticScope(sentry_value_t event, bool isCrash) const;
+
+	static int64 GetAttachmentSize(TSharedPtr<ISentryAttachment> attachment);
 	virtual sentry_value_t OnBeforeBreadcrumb(sentry_value_t breadcrumb, void* hint, void* closure);
 	virtual sentry_value_t OnBeforeLog(sentry_value_t log, void* closure);
 	virtual sentry_value_t OnCrash(const sentry_ucontext_t* uctx, sentry_value_t event, void* closure);
@@ -99,22 +152,132 @@ private:
 	static sentry_value_t HandleOnCrash(const sentry_ucontext_t* uctx, sentry_value_t event, void* closure);
 	static double HandleTraceSampling(const sentry_transaction_context_t* transaction_ctx, sentry_value_t custom_sampling_ctx, const int* parent_sampled, void* closure);
 
+	/** Records the context key as recently set and removes the least recently set context if the limit is exceeded. */
+	void TouchContextKey(const FString& key);
+
+	/** Gets a shared native string for values repeated across breadcrumbs (categories, types, levels). Caller owns the returned reference. */
+	sentry_value_t GetInternedString(const FString& Str);
+
+	/** Gets the profiler for a transaction that has just started, null if it shouldn't be profiled. */
+	TSharedPtr<FSentrySamplingProfiler, ESPMode::ThreadSafe> GetTransactionProfiler() const;
+
+	/** Creates the rings holding the log and breadcrumb tails, persisted ones hand over what the previous session left unreported. */
+	void CreateLogRings(const USentrySettings* settings, TArray<uint8>& outUnreportedLogLines, TArray<uint8>& outUnreportedBreadcrumbs);
+
+	/** Sends the log and breadcrumb tails of a previous session that ended without reporting them, e.g. after an OOM kill. */
+	void CaptureUnreportedSessionTails(const TArray<uint8>& logLines, const TArray<uint8>& breadcrumbs);
+
+	/** Adds the breadcrumb ID the crash video timeline refers to while it's active. */
+	void AddBreadcrumbVideoTimelineId(sentry_value_t breadcrumb);
+
+	/** Writes the breadcrumb to the breadcrumb ring as a single line. */
+	void AppendToBreadcrumbRing(sentry_value_t breadcrumb);
+
+	/** Captures the event with the local scope, if any, applied on top of the global one. */
+	sentry_uuid_t CaptureWithLocalScope(sentry_value_t nativeEvent, TSharedPtr<FGenericPlatformSentryScope> localScope);
+
+	/** Resolves the paths of the files written by the crash handler. */
+	void PrepareCrashPaths();
+
+	/**
+	 * Hold the event or log for the handler until UObjects can be created again, e.g. after garbage collection.
+	 * Take the ownership of the native value and return true if it was queued.
+	 */
+	bool DeferBeforeSend(sentry_value_t event);
+	bool DeferBeforeLog(sentry_value_t log);
+
 	USentryBeforeSendHandler* beforeSend;
 	USentryBeforeBreadcrumbHandler* beforeBreadcrumb;
 	USentryBeforeLogHandler* beforeLog;
 	USentryTraceSampler* sampler;
 
+	/** Events and logs waiting for the handlers which can't run during garbage collection and post-load, null if no handler is set. */
+	TSharedPtr<FSentryDeferredCallbacks, ESPMode::ThreadSafe> deferredCallbacks;
+
+	/** Native sample rate rules, null unless rule-based sampling is selected in plugin settings */
+	TUniquePtr<FSentryTraceSampleRules> sampleRules;
+
+	/** Native log filter rules evaluated before the `beforeLog` handler, null if there are none in plugin settings */
+	TUniquePtr<FSentryLogFilterRules> logFilterRules;
+
+	/**
+	 * Sample rates applied by the SDK instead of sentry-native which only reads them on initialization.
+	 * Traces sample rate is only used if uniform sampling is selected in plugin settings.
+	 */
+	TAtomic<float> eventSampleRate;
+	TAtomic<float> tracesSampleRate;
+	bool isUniformTracesSampling;
+
 	TSharedPtr<FGenericPlatformSentryCrashReporter> crashReporter;
 
-	bool isEnabled;
+	/** Continuous sampling profiler, null if profiling is disabled */
+	TSharedPtr<FSentrySamplingProfiler, ESPMode::ThreadSafe> profiler;
+	float profilesSampleRate;
+
+	/** Keep the global scope within the scope limits configured in plugin settings */
+	TUniquePtr<FSentryScopeKeyLimiter> tagsLimiter;
+	TUniquePtr<FSentryScopeKeyLimiter> contextsLimiter;
+	int32 maxContextDepth;
+	int32 maxContextValues;
+
+	/** Static scope entries serialized once for the batched transport, null unless enabled. */
+	TUniquePtr<FGenericPlatformSentryStaticScope> staticScope;
+
+	/** Sheds low-priority events, logs and transactions while the batched transport is backed up, null unless enabled. */
+	TSharedPtr<FSentryAdaptiveSampler, ESPMode::ThreadSafe> adaptiveSampler;
+
+	bool isBatchedTransportEnabled;
+
+	/** Read from any thread, the platform SDK may be initialized on a background thread. */
+	TAtomic<bool> isEnabled;
+
+	/** Only set once the stack trace cache is created, so that captures made meanwhile don't use it. */
+	TAtomic<bool> isStackTraceEnabled;
 
-	bool isStackTraceEnabled;
+	/** Builds the stack traces attached to captured events, null unless stack traces are attached. */
+	TUniquePtr<FGenericPlatformSentryStacktraceCache> stacktraceCache;
 	bool isPiiAttachmentEnabled;
 	bool isScreenshotAttachmentEnabled;
 	bool isGpuDumpAttachmentEnabled;
 	bool isCrashVideoEnabled;
+	bool isCrashVideoUploadDeferred;
+	bool isCrashFrameStripEnabled;
+	bool isCrashMemoryRegionsEnabled;
+	bool isAppHangCrashVideoEnabled;
+
+	int32 maxAttachmentSize;
+
+	/** Ring holding the game log tail attached to events and crashes, null if neither is enabled nor the log is persisted. */
+	TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> logRing;
+	FString logTailFilename;
+
+	/** Ring holding the most recent breadcrumbs in a memory-mapped file, null unless the log is persisted. */
+	TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> breadcrumbRing;
+
+	/** Sizes of the log tail attached to events instead of the whole log file and to crashes, 0 if not attached. */
+	int32 eventLogTailSize;
+	int32 crashLogTailSize;
+
+	/** Max serialized size of an event in bytes, 0 for no limit. */
+	int64 maxEventPayloadSize;
+	bool isPayloadTrackingEnabled;
+
+	/** Size of the attachments added to the global scope, counted towards every event if payload sizes are tracked. */
+	TAtomic<int64> globalAttachmentsSize;
+
+	/** Records the duration of each crash handler stage, null unless enabled in plugin settings. */
+	TUniquePtr<FSentryCrashTimeline> crashTimeline;
 
 	FString databaseParentPath;
+
+	/** Key of the instance keeping its own database, empty if the default database is used. */
+	FString databaseInstanceKey;
+
+	/** Paths of the files written by the crash handler, resolved on initialization. */
+	FSentryCrashPaths crashPaths;
+
+	TMap<FString, sentry_value_t> InternedStrings;
+	FCriticalSection InternedStringsCriticalSection;
 };
 
 #endif
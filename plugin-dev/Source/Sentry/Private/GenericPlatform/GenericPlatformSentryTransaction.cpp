@@ -5,6 +5,11 @@
 
 #include "Infrastructure/GenericPlatformSentryConverters.h"
 
+#include "Utils/SentrySamplingProfiler.h"
+
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+
 #if USE_SENTRY_NATIVE
 
 void CopyTransactionTracingHeader(const char* key, const char* value, void* userdata)
@@ -13,10 +18,18 @@ void CopyTransactionTracingHeader(const char* key, const char* value, void* user
 	sentry_value_set_by_key(*header, key, sentry_value_new_string(value));
 }
 
-FGenericPlatformSentryTransaction::FGenericPlatformSentryTransaction(sentry_transaction_t* transaction)
+FGenericPlatformSentryTransaction::FGenericPlatformSentryTransaction(sentry_transaction_t* transaction, const FSentryMonotonicClock& clock, TSharedPtr<FSentrySamplingProfiler, ESPMode::ThreadSafe> profiler)
 	: Transaction(transaction)
+	, Profiler(profiler)
+	, StartTime(FPlatformTime::Seconds())
+	, Clock(clock)
 	, isFinished(false)
+	, isSampled(false)
 {
+	// The sampling decision is made when the transaction starts and only exposed through its trace header
+	FString traceName, traceValue;
+	GetTrace(traceName, traceValue);
+	isSampled = traceValue.EndsWith(TEXT("-1"));
 }
 
 sentry_transaction_t* FGenericPlatformSentryTransaction::GetNativeObject()
@@ -24,16 +37,38 @@ sentry_transaction_t* FGenericPlatformSentryTransaction::GetNativeObject()
 	return Transaction;
 }
 
+sentry_span_t* FGenericPlatformSentryTransaction::StartNativeChild(const char* operation, const char* description)
+{
+	if (!isSampled)
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	return sentry_transaction_start_child_ts(Transaction, operation, description, Clock.GetTimestamp());
+}
+
+bool FGenericPlatformSentryTransaction::IsSampled() const
+{
+	return isSampled;
+}
+
+const FSentryMonotonicClock& FGenericPlatformSentryTransaction::GetClock() const
+{
+	return Clock;
+}
+
 TSharedPtr<ISentrySpan> FGenericPlatformSentryTransaction::StartChildSpan(const FString& operation, const FString& description, bool bindToScope)
 {
-	if (sentry_span_t* nativeSpan = sentry_transaction_start_child(Transaction, TCHAR_TO_ANSI(*operation), TCHAR_TO_ANSI(*description)))
+	if (sentry_span_t* nativeSpan = sentry_transaction_start_child_ts(Transaction, TCHAR_TO_UTF8(*operation), TCHAR_TO_UTF8(*description), Clock.GetTimestamp()))
 	{
 		if (bindToScope)
 		{
 			sentry_set_span(nativeSpan);
 		}
 
-		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan));
+		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan, isSampled, Clock));
 	}
 	else
 	{
@@ -43,14 +78,14 @@ TSharedPtr<ISentrySpan> FGenericPlatformSentryTransaction::StartChildSpan(const
 
 TSharedPtr<ISentrySpan> FGenericPlatformSentryTransaction::StartChildSpanWithTimestamp(const FString& operation, const FString& description, int64 timestamp, bool bindToScope)
 {
-	if (sentry_span_t* nativeSpan = sentry_transaction_start_child_ts(Transaction, TCHAR_TO_ANSI(*operation), TCHAR_TO_ANSI(*description), timestamp))
+	if (sentry_span_t* nativeSpan = sentry_transaction_start_child_ts(Transaction, TCHAR_TO_UTF8(*operation), TCHAR_TO_UTF8(*description), timestamp))
 	{
 		if (bindToScope)
 		{
 			sentry_set_span(nativeSpan);
 		}
 
-		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan));
+		return MakeShareable(new FGenericPlatformSentrySpan(nativeSpan, isSampled, Clock));
 	}
 	else
 	{
@@ -60,14 +95,21 @@ TSharedPtr<ISentrySpan> FGenericPlatformSentryTransaction::StartChildSpanWithTim
 
 void FGenericPlatformSentryTransaction::Finish()
 {
-	sentry_transaction_finish(Transaction);
+	const int64 timestamp = Clock.GetTimestamp();
+	if (!FinishProfiled(timestamp))
+	{
+		sentry_transaction_finish_ts(Transaction, timestamp);
+	}
 
 	isFinished = true;
 }
 
 void FGenericPlatformSentryTransaction::FinishWithTimestamp(int64 timestamp)
 {
-	sentry_transaction_finish_ts(Transaction, timestamp);
+	if (!FinishProfiled(timestamp))
+	{
+		sentry_transaction_finish_ts(Transaction, timestamp);
+	}
 
 	isFinished = true;
 }
@@ -81,35 +123,62 @@ void FGenericPlatformSentryTransaction::SetName(const FString& name)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_transaction_set_name(Transaction, TCHAR_TO_ANSI(*name));
+	sentry_transaction_set_name(Transaction, TCHAR_TO_UTF8(*name));
 }
 
 void FGenericPlatformSentryTransaction::SetTag(const FString& key, const FString& value)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_transaction_set_tag(Transaction, TCHAR_TO_ANSI(*key), TCHAR_TO_ANSI(*value));
+	sentry_transaction_set_tag(Transaction, TCHAR_TO_UTF8(*key), TCHAR_TO_UTF8(*value));
 }
 
 void FGenericPlatformSentryTransaction::RemoveTag(const FString& key)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_transaction_remove_tag(Transaction, TCHAR_TO_ANSI(*key));
+	sentry_transaction_remove_tag(Transaction, TCHAR_TO_UTF8(*key));
 }
 
 void FGenericPlatformSentryTransaction::SetData(const FString& key, const TMap<FString, FSentryVariant>& values)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_transaction_set_data(Transaction, TCHAR_TO_ANSI(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
+	sentry_transaction_set_data(Transaction, TCHAR_TO_UTF8(*key), FGenericPlatformSentryConverters::VariantMapToNative(values));
 }
 
 void FGenericPlatformSentryTransaction::RemoveData(const FString& key)
 {
 	FScopeLock Lock(&CriticalSection);
 
-	sentry_transaction_remove_data(Transaction, TCHAR_TO_ANSI(*key));
+	sentry_transaction_remove_data(Transaction, TCHAR_TO_UTF8(*key));
+}
+
+bool FGenericPlatformSentryTransaction::FinishProfiled(int64 timestamp)
+{
+	// Transactions dropped by the traces sampler aren't sent, so there is no point in summarizing their samples
+	if (!Profiler || !isSampled)
+	{
+		return false;
+	}
+
+	const double endTime = FPlatformTime::Seconds() - (Clock.GetTimestamp() - timestamp) / 1000000.0;
+
+	// Symbolicating the samples is slow, the native transaction stays alive until it's finished
+	Profiler->BeginPendingSummary();
+	Async(EAsyncExecution::ThreadPool, [transaction = Transaction, profiler = MoveTemp(Profiler), startTime = StartTime, endTime, timestamp]()
+	{
+		for (const TPair<FString, TMap<FString, FSentryVariant>>& data : profiler->Summarize(startTime, endTime))
+		{
+			sentry_transaction_set_data(transaction, TCHAR_TO_UTF8(*data.Key), FGenericPlatformSentryConverters::VariantMapToNative(data.Value));
+		}
+
+		sentry_transaction_finish_ts(transaction, timestamp);
+
+		profiler->EndPendingSummary();
+	});
+
+	return true;
 }
 
 void FGenericPlatformSentryTransaction::GetTrace(FString& name, FString& value)
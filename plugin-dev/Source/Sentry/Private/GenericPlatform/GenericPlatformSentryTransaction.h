@@ -8,16 +8,27 @@
 
 #include "Interface/SentryTransactionInterface.h"
 
+#include "Utils/SentryMonotonicClock.h"
+
 #if USE_SENTRY_NATIVE
 
+class FSentrySamplingProfiler;
+
 class FGenericPlatformSentryTransaction : public ISentryTransaction
 {
 public:
-	FGenericPlatformSentryTransaction(sentry_transaction_t* transaction);
+	FGenericPlatformSentryTransaction(sentry_transaction_t* transaction, const FSentryMonotonicClock& clock, TSharedPtr<FSentrySamplingProfiler, ESPMode::ThreadSafe> profiler = nullptr);
 	virtual ~FGenericPlatformSentryTransaction() override = default;
 
 	sentry_transaction_t* GetNativeObject();
 
+	/** Starts a child span without creating a wrapper, returns null if the transaction isn't sampled. The caller must finish it. */
+	sentry_span_t* StartNativeChild(const char* operation, const char* description);
+
+	bool IsSampled() const;
+
+	const FSentryMonotonicClock& GetClock() const;
+
 	virtual TSharedPtr<ISentrySpan> StartChildSpan(const FString& operation, const FString& description, bool bindToScope) override;
 	virtual TSharedPtr<ISentrySpan> StartChildSpanWithTimestamp(const FString& operation, const FString& description, int64 timestamp, bool bindToScope) override;
 	virtual void Finish() override;
@@ -31,11 +42,23 @@ public:
 	virtual void GetTrace(FString& name, FString& value) override;
 
 private:
+	/** Attaches the profile summary and finishes the transaction in the background if it's being profiled, returns false otherwise. */
+	bool FinishProfiled(int64 timestamp);
+
 	sentry_transaction_t* Transaction;
 
+	/** Profiler recording samples for this transaction, null if it isn't profiled */
+	TSharedPtr<FSentrySamplingProfiler, ESPMode::ThreadSafe> Profiler;
+
+	double StartTime;
+
+	/** Clock the transaction and its spans are timed with. */
+	FSentryMonotonicClock Clock;
+
 	FCriticalSection CriticalSection;
 
 	bool isFinished;
+	bool isSampled;
 };
 
 typedef FGenericPlatformSentryTransaction FPlatformSentryTransaction;
@@ -0,0 +1,773 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "GenericPlatformSentryTransport.h"
+
+#include "SentryDefines.h"
+#include "SentryModule.h"
+#include "SentrySettings.h"
+#include "Utils/SentryAdaptiveSampler.h"
+#include "Utils/SentryAttachmentCompression.h"
+#include "Utils/SentryDsn.h"
+#include "Utils/SentryStaticScopeFragment.h"
+#include "Utils/SentryThreadUtils.h"
+#include "Utils/SentryTransportAccounting.h"
+
+#include "CoreGlobals.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+
+#if USE_SENTRY_NATIVE
+
+namespace SentryTransport
+{
+	/** Max size of the merged envelopes after which the batch is sent without waiting for the window to elapse. */
+	static constexpr int64 MaxBatchSize = 1024 * 1024;
+
+	/** Time envelopes are dropped for if the server asks to back off without saying for how long. */
+	static constexpr double DefaultRetryAfterSeconds = 60.0;
+
+	/** Retry delay after the first failed request, doubled with every subsequent failure up to the max. */
+	static constexpr double BaseRetryDelaySeconds = 5.0;
+	static constexpr double MaxRetryDelaySeconds = 600.0;
+
+	/** Size from which text attachments are gzipped on their own when envelopes are compressed. */
+	static constexpr int32 TextAttachmentCompressionThreshold = 16 * 1024;
+
+	/** Interval at which completed requests are checked for while the offline spool is enabled. */
+	static constexpr double ResultsPollIntervalSeconds = 0.1;
+
+	/**
+	 * Gets the time to back off for by data category from the response. Categories are empty if all of them are limited.
+	 * Rate limits header is honored on any response while Retry-After is only considered for 429 responses.
+	 */
+	static void GetRetryAfterSeconds(const FHttpResponsePtr& Response, TMap<FString, double>& OutRetryAfter)
+	{
+		const FString RateLimits = Response->GetHeader(TEXT("X-Sentry-Rate-Limits"));
+		if (!RateLimits.IsEmpty())
+		{
+			TArray<FString> Limits;
+			RateLimits.ParseIntoArray(Limits, TEXT(","));
+			for (const FString& Limit : Limits)
+			{
+				// Each limit is formatted as retry_after:categories:scope:reason_code with the categories separated by semicolons
+				TArray<FString> Fields;
+				Limit.TrimStartAndEnd().ParseIntoArray(Fields, TEXT(":"), false);
+				if (Fields.Num() == 0)
+				{
+					continue;
+				}
+
+				const double RetryAfter = FCString::Atod(*Fields[0]);
+				if (RetryAfter <= 0.0)
+				{
+					continue;
+				}
+
+				TArray<FString> Categories;
+				if (Fields.Num() > 1)
+				{
+					Fields[1].ParseIntoArray(Categories, TEXT(";"));
+				}
+
+				if (Categories.Num() == 0)
+				{
+					Categories.Add(FString());
+				}
+
+				for (const FString& Category : Categories)
+				{
+					double& CategoryRetryAfter = OutRetryAfter.FindOrAdd(Category);
+					CategoryRetryAfter = FMath::Max(CategoryRetryAfter, RetryAfter);
+				}
+			}
+
+			if (OutRetryAfter.Num() > 0)
+			{
+				return;
+			}
+		}
+
+		if (Response->GetResponseCode() == 429)
+		{
+			const FString RetryAfterHeader = Response->GetHeader(TEXT("Retry-After"));
+			OutRetryAfter.Add(FString(), RetryAfterHeader.IsNumeric() ? FCString::Atod(*RetryAfterHeader) : DefaultRetryAfterSeconds);
+		}
+	}
+
+	/** Gets the data category that rate limits of the given envelope item type are reported for. */
+	static FString GetDataCategory(const FString& ItemType)
+	{
+		if (ItemType == TEXT("event"))
+		{
+			return TEXT("error");
+		}
+		if (ItemType == TEXT("session") || ItemType == TEXT("sessions"))
+		{
+			return TEXT("session");
+		}
+		if (ItemType == TEXT("log"))
+		{
+			return TEXT("log_item");
+		}
+		if (ItemType == TEXT("client_report"))
+		{
+			return TEXT("internal");
+		}
+		if (ItemType == TEXT("replay_event") || ItemType == TEXT("replay_recording") || ItemType == TEXT("replay_video"))
+		{
+			return TEXT("replay");
+		}
+		if (ItemType == TEXT("check_in"))
+		{
+			return TEXT("monitor");
+		}
+
+		// Transactions, attachments, profiles and the like share the name of their category
+		return ItemType;
+	}
+
+	static bool Compress(const TArray<uint8>& Data, TArray<uint8>& OutCompressed)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Data.Num());
+		OutCompressed.SetNumUninitialized(CompressedSize);
+
+		if (!FCompression::CompressMemory(NAME_Gzip, OutCompressed.GetData(), CompressedSize, Data.GetData(), Data.Num()) || CompressedSize >= Data.Num())
+		{
+			return false;
+		}
+
+		OutCompressed.SetNum(CompressedSize, false);
+		return true;
+	}
+}
+
+FGenericPlatformSentryTransport::FGenericPlatformSentryTransport(const FString& endpointUrl, const FString& authHeader, float batchWindow, bool isCompressionEnabled, const FString& spoolDirectory, int64 spoolMaxSize)
+	: endpointUrl(endpointUrl)
+	, authHeader(authHeader)
+	, batchWindowSeconds(FMath::Max(0.0f, batchWindow))
+	, isCompressionEnabled(isCompressionEnabled)
+	, spoolDirectory(spoolDirectory)
+	, spoolMaxSize(spoolMaxSize)
+	, backoff(SentryTransport::BaseRetryDelaySeconds, SentryTransport::MaxRetryDelaySeconds)
+	, requestState(MakeShared<FRequestState, ESPMode::ThreadSafe>())
+{
+	requestState->IsReportingResults = spoolMaxSize > 0;
+
+	wakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FGenericPlatformSentryTransport::~FGenericPlatformSentryTransport()
+{
+	if (thread)
+	{
+		thread->Kill(true);
+		delete thread;
+		thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(wakeEvent);
+	wakeEvent = nullptr;
+}
+
+sentry_transport_t* FGenericPlatformSentryTransport::CreateNativeTransport(const USentrySettings* settings, const FString& spoolDirectory, TSharedPtr<FSentryStaticScopeFragment, ESPMode::ThreadSafe> staticScopeFragment,
+	TSharedPtr<FSentryAdaptiveSampler, ESPMode::ThreadSafe> adaptiveSampler)
+{
+	// Loading modules is not safe from the background thread the SDK may be initialized on
+	if (!FModuleManager::Get().IsModuleLoaded(TEXT("HTTP")))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("HTTP module isn't loaded, falling back to the default transport."));
+		return nullptr;
+	}
+
+	FString endpointUrl;
+	FString publicKey;
+	if (!SentryDsn::Parse(settings->GetEffectiveDsn(), endpointUrl, publicKey))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to parse DSN for the batched transport, falling back to the default transport."));
+		return nullptr;
+	}
+
+	const FString authHeader = SentryDsn::GetAuthHeader(publicKey);
+
+	const int64 spoolMaxSize = settings->EnableOfflineSpool ? static_cast<int64>(settings->OfflineSpoolMaxSizeMB) * 1024 * 1024 : 0;
+
+	FGenericPlatformSentryTransport* transport = new FGenericPlatformSentryTransport(endpointUrl, authHeader, settings->TransportBatchWindow, settings->CompressEnvelopes, spoolDirectory, spoolMaxSize);
+	transport->threadPriority = SentryThreadUtils::ToThreadPriority(settings->BackgroundThreadPriority);
+	transport->threadAffinityMask = SentryThreadUtils::ToAffinityMask(settings->BackgroundThreadAffinityMask);
+
+	if (settings->DeduplicateAttachments)
+	{
+		transport->attachmentDeduplicator = MakeUnique<FSentryAttachmentDeduplicator>(settings->AttachmentDeduplicationWindowMinutes * 60.0);
+
+		// Attachments can only be referenced once the upload of their event is confirmed
+		transport->requestState->IsReportingResults = true;
+	}
+
+	if (settings->CompressEnvelopes)
+	{
+		transport->textAttachmentCompressionThreshold = SentryTransport::TextAttachmentCompressionThreshold;
+	}
+
+	transport->staticScopeFragment = staticScopeFragment;
+	transport->adaptiveSampler = adaptiveSampler;
+
+	transport->isFastExitEnabled = settings->FastExitOnClose;
+	if (settings->FastExitOnClose && spoolMaxSize == 0)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Fast exit requires the offline spool, the batched transport will keep sending envelopes on shutdown."));
+	}
+
+	sentry_transport_t* nativeTransport = sentry_transport_new(HandleSend);
+	sentry_transport_set_state(nativeTransport, transport);
+	sentry_transport_set_startup_func(nativeTransport, HandleStartup);
+	sentry_transport_set_flush_func(nativeTransport, HandleFlush);
+	sentry_transport_set_shutdown_func(nativeTransport, HandleShutdown);
+	sentry_transport_set_free_func(nativeTransport, HandleFree);
+
+	return nativeTransport;
+}
+
+uint32 FGenericPlatformSentryTransport::Run()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	if (spoolMaxSize > 0)
+	{
+		spool = MakeUnique<FSentryEnvelopeSpool>(spoolDirectory, spoolMaxSize);
+
+		// Envelopes left by previous sessions are retried after a randomized delay rather than in a burst at startup
+		spoolRetryStartTime = FPlatformTime::Seconds() + backoff.NextDelay();
+		backoff.Reset();
+	}
+
+	while (stopRequested.GetValue() == 0)
+	{
+		// Sleep until a new envelope arrives, a request completes, the batch window elapses or a retry is due
+		uint32 waitMs = MAX_uint32;
+
+		const double wakeUpTime = GetWakeUpTime();
+		if (wakeUpTime < TNumericLimits<double>::Max())
+		{
+			waitMs = static_cast<uint32>(FMath::Max(1.0, (wakeUpTime - FPlatformTime::Seconds()) * 1000.0));
+		}
+
+		wakeEvent->Wait(waitMs);
+
+		ProcessResults();
+		ProcessQueue(flushRequested.GetValue() > 0);
+		RetrySpooledEnvelope();
+
+		if (spool)
+		{
+			numSpooledEnvelopes = spool->Num();
+			numSpooledBytes = spool->GetSize();
+		}
+
+		UpdateBacklog();
+	}
+
+	ProcessResults();
+
+	// Nothing is sent anymore on fast exit, whatever is left is persisted for the next session
+	isSpoolingOnly = isFastExitEnabled && spool.IsValid();
+	ProcessQueue(true);
+
+	return 0;
+}
+
+void FGenericPlatformSentryTransport::Stop()
+{
+	stopRequested.Set(1);
+	wakeEvent->Trigger();
+}
+
+void FGenericPlatformSentryTransport::HandleSend(sentry_envelope_t* envelope, void* state)
+{
+	FGenericPlatformSentryTransport* transport = static_cast<FGenericPlatformSentryTransport*>(state);
+
+	size_t size = 0;
+	char* serialized = sentry_envelope_serialize(envelope, &size);
+	sentry_envelope_free(envelope);
+
+	if (!serialized)
+	{
+		return;
+	}
+
+	// Counted before queueing so that a flush never sees the envelope neither queued nor unsent
+	transport->numUnsentEnvelopes.Increment();
+	transport->numQueuedBytes += static_cast<int64>(size);
+	transport->UpdateBacklog();
+	transport->queue.Enqueue(TArray<uint8>(reinterpret_cast<const uint8*>(serialized), static_cast<int32>(size)));
+	transport->wakeEvent->Trigger();
+
+	sentry_free(serialized);
+}
+
+int FGenericPlatformSentryTransport::HandleStartup(const sentry_options_t* options, void* state)
+{
+	FGenericPlatformSentryTransport* transport = static_cast<FGenericPlatformSentryTransport*>(state);
+
+	transport->thread = FRunnableThread::Create(transport, TEXT("SentryTransport"), 0, transport->threadPriority, transport->threadAffinityMask);
+
+	SentryTransportAccounting::SetTracked(transport->thread != nullptr);
+
+	return transport->thread ? 0 : 1;
+}
+
+int FGenericPlatformSentryTransport::HandleFlush(uint64_t timeout, void* state)
+{
+	FGenericPlatformSentryTransport* transport = static_cast<FGenericPlatformSentryTransport*>(state);
+
+	transport->flushRequested.Increment();
+	transport->wakeEvent->Trigger();
+
+	const bool isFlushed = transport->WaitUntilIdle(timeout);
+
+	transport->flushRequested.Decrement();
+
+	return isFlushed ? 0 : 1;
+}
+
+int FGenericPlatformSentryTransport::HandleShutdown(uint64_t timeout, void* state)
+{
+	FGenericPlatformSentryTransport* transport = static_cast<FGenericPlatformSentryTransport*>(state);
+
+	if (!transport->thread)
+	{
+		return 0;
+	}
+
+	// Transport thread sends everything that is left once stopped, or spools it on fast exit
+	transport->Stop();
+	transport->thread->WaitForCompletion();
+
+	if (transport->isSpoolingOnly)
+	{
+		// Failures reported so far are still spooled, requests in flight are left to complete on their own
+		transport->ProcessResults();
+		return 0;
+	}
+
+	const bool isFlushed = transport->WaitUntilIdle(timeout);
+
+	// Transport thread is done, envelopes that failed in the meantime are spooled for the next session from here
+	transport->ProcessResults();
+	if (!isFlushed)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Batched transport didn't send all envelopes before shutting down."));
+	}
+
+	return isFlushed ? 0 : 1;
+}
+
+void FGenericPlatformSentryTransport::HandleFree(void* state)
+{
+	SentryTransportAccounting::Reset();
+
+	delete static_cast<FGenericPlatformSentryTransport*>(state);
+}
+
+void FGenericPlatformSentryTransport::ProcessQueue(bool force)
+{
+	TArray<uint8> envelope;
+	while (queue.Dequeue(envelope))
+	{
+		numQueuedBytes -= envelope.Num();
+
+		if (batchWindowSeconds > 0.0 && batch.Add(envelope))
+		{
+			if (batch.GetNumEnvelopes() == 1)
+			{
+				batchStartTime = FPlatformTime::Seconds();
+			}
+
+			continue;
+		}
+
+		// Static scope is spliced in before the envelope can be spooled, so that it's sent with the values of this session
+		if (staticScopeFragment)
+		{
+			staticScopeFragment->Splice(envelope);
+		}
+
+		// Attachments are hashed and compressed here to keep it off the thread the event was captured on
+		if (attachmentDeduplicator)
+		{
+			attachmentDeduplicator->Deduplicate(envelope, FPlatformTime::Seconds());
+		}
+
+		if (textAttachmentCompressionThreshold >= 0)
+		{
+			SentryAttachmentCompression::CompressTextAttachments(envelope, textAttachmentCompressionThreshold);
+		}
+
+		SendOrSpool(envelope);
+		numUnsentEnvelopes.Decrement();
+	}
+
+	if (!batch.IsEmpty() && (force || batch.GetSize() >= SentryTransport::MaxBatchSize || FPlatformTime::Seconds() >= batchStartTime + batchWindowSeconds))
+	{
+		const int32 numBatchedEnvelopes = batch.GetNumEnvelopes();
+
+		SendOrSpool(batch.Take());
+		numUnsentEnvelopes.Subtract(numBatchedEnvelopes);
+	}
+}
+
+void FGenericPlatformSentryTransport::SendOrSpool(const TArray<uint8>& envelope)
+{
+	if (spool && (isSpoolingOnly || FPlatformTime::Seconds() < nextRetryTime))
+	{
+		spool->Store(envelope, FSentryEnvelopeSpool::GetPriority(envelope));
+		return;
+	}
+
+	Send(envelope);
+}
+
+void FGenericPlatformSentryTransport::FRequestState::UpdateRateLimits(const FHttpResponsePtr& Response)
+{
+	TMap<FString, double> retryAfter;
+	SentryTransport::GetRetryAfterSeconds(Response, retryAfter);
+
+	if (retryAfter.Num() == 0)
+	{
+		return;
+	}
+
+	const uint64 now = FPlatformTime::Cycles64();
+
+	FScopeLock lock(&RateLimitsCriticalSection);
+
+	for (const TPair<FString, double>& limit : retryAfter)
+	{
+		uint64& until = RetryAfterCycles.FindOrAdd(limit.Key);
+		until = FMath::Max(until, now + static_cast<uint64>(limit.Value / FPlatformTime::GetSecondsPerCycle64()));
+
+		// Only a limit of all categories means the transport can't send anything
+		if (limit.Key.IsEmpty())
+		{
+			SentryTransportAccounting::SetRateLimitedUntil(FPlatformTime::Seconds() + limit.Value);
+		}
+
+		UE_LOG(LogSentrySdk, Warning, TEXT("Envelope items of %s were rate limited, dropping them for the next %.0f seconds."),
+			limit.Key.IsEmpty() ? TEXT("all categories") : *FString::Printf(TEXT("category '%s'"), *limit.Key), limit.Value);
+	}
+}
+
+bool FGenericPlatformSentryTransport::FRequestState::ApplyRateLimits(const TArray<uint8>& Envelope, TArray<uint8>& OutFiltered)
+{
+	const uint64 now = FPlatformTime::Cycles64();
+
+	TSet<FString> limitedCategories;
+	bool isAllLimited = false;
+
+	{
+		FScopeLock lock(&RateLimitsCriticalSection);
+
+		for (auto It = RetryAfterCycles.CreateIterator(); It; ++It)
+		{
+			if (now >= It->Value)
+			{
+				It.RemoveCurrent();
+			}
+			else if (It->Key.IsEmpty())
+			{
+				isAllLimited = true;
+			}
+			else
+			{
+				limitedCategories.Add(It->Key);
+			}
+		}
+	}
+
+	if (isAllLimited)
+	{
+		return false;
+	}
+
+	if (limitedCategories.Num() == 0)
+	{
+		return true;
+	}
+
+	int32 headerEnd = 0;
+	TArray<FSentryEnvelopeBatch::FItem> items;
+	if (!FSentryEnvelopeBatch::Parse(Envelope, headerEnd, items))
+	{
+		return true;
+	}
+
+	TArray<uint8> filtered;
+	filtered.Append(Envelope.GetData(), headerEnd);
+	filtered.Add('\n');
+
+	int32 numKept = 0;
+	for (const FSentryEnvelopeBatch::FItem& item : items)
+	{
+		if (limitedCategories.Contains(SentryTransport::GetDataCategory(item.Type)))
+		{
+			continue;
+		}
+
+		filtered.Append(Envelope.GetData() + item.Start, item.PayloadEnd - item.Start);
+		filtered.Add('\n');
+		++numKept;
+	}
+
+	if (numKept == 0)
+	{
+		return false;
+	}
+
+	if (numKept < items.Num())
+	{
+		UE_LOG(LogSentrySdk, Verbose, TEXT("%d envelope item(s) dropped due to rate limiting."), items.Num() - numKept);
+		OutFiltered = MoveTemp(filtered);
+	}
+
+	return true;
+}
+
+bool FGenericPlatformSentryTransport::Send(const TArray<uint8>& unfilteredEnvelope, const FString& spoolId)
+{
+	TArray<uint8> filtered;
+	if (!requestState->ApplyRateLimits(unfilteredEnvelope, filtered))
+	{
+		UE_LOG(LogSentrySdk, Verbose, TEXT("Envelope dropped due to rate limiting."));
+		SentryTransportAccounting::RecordRateLimitedEnvelope();
+		return false;
+	}
+
+	const TArray<uint8>& envelope = filtered.Num() > 0 ? filtered : unfilteredEnvelope;
+
+	TArray<uint8> compressed;
+	const bool isCompressed = isCompressionEnabled && SentryTransport::Compress(envelope, compressed);
+
+	auto request = FHttpModule::Get().CreateRequest();
+	request->SetURL(endpointUrl);
+	request->SetVerb(TEXT("POST"));
+	request->SetHeader(TEXT("Content-Type"), TEXT("application/x-sentry-envelope"));
+	request->SetHeader(TEXT("X-Sentry-Auth"), authHeader);
+
+	if (isCompressed)
+	{
+		request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+		request->SetContent(compressed);
+	}
+	else
+	{
+		request->SetContent(envelope);
+	}
+
+	requestState->NumPendingRequests.Increment();
+
+	// New envelopes are kept until the request completes so that they can be spooled if it fails
+	TArray<uint8> retainedEnvelope;
+	if (spoolMaxSize > 0 && spoolId.IsEmpty())
+	{
+		retainedEnvelope = envelope;
+	}
+
+	FString eventId;
+	if (attachmentDeduplicator && attachmentDeduplicator->HasPendingUploads())
+	{
+		eventId = FSentryAttachmentDeduplicator::GetEventId(envelope);
+	}
+
+	request->OnProcessRequestComplete().BindLambda([state = requestState, retainedEnvelope = MoveTemp(retainedEnvelope), spoolId, eventId, sendTime = FPlatformTime::Seconds()](FHttpRequestPtr, FHttpResponsePtr response, bool succeeded) mutable
+	{
+		SentryTransportAccounting::RecordRequest(FPlatformTime::Seconds() - sendTime, succeeded && response.IsValid() && response->GetResponseCode() < 400);
+
+		bool isRetryable = false;
+
+		if (succeeded && response.IsValid())
+		{
+			state->UpdateRateLimits(response);
+		}
+
+		if (!succeeded || !response.IsValid())
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to send envelope."));
+			isRetryable = true;
+		}
+		else if (response->GetResponseCode() >= 500)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Envelope was not accepted due to server error %d."), response->GetResponseCode());
+			isRetryable = true;
+		}
+		else if (response->GetResponseCode() == 429)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Envelope was rate limited."));
+		}
+		else if (response->GetResponseCode() >= 400)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Envelope was rejected with status code %d."), response->GetResponseCode());
+		}
+
+		if (state->IsReportingResults)
+		{
+			FRequestResult result;
+			result.Envelope = isRetryable ? MoveTemp(retainedEnvelope) : TArray<uint8>();
+			result.SpoolId = spoolId;
+			result.EventId = eventId;
+			result.IsRetryable = isRetryable;
+			result.IsDelivered = succeeded && response.IsValid() && response->GetResponseCode() < 400;
+
+			state->Results.Enqueue(MoveTemp(result));
+		}
+
+		state->NumPendingRequests.Decrement();
+	});
+
+	request->ProcessRequest();
+
+	return true;
+}
+
+void FGenericPlatformSentryTransport::ProcessResults()
+{
+	FRequestResult result;
+	while (requestState->Results.Dequeue(result))
+	{
+		if (!result.SpoolId.IsEmpty())
+		{
+			isSpoolRequestPending = false;
+		}
+
+		if (attachmentDeduplicator && !result.EventId.IsEmpty())
+		{
+			attachmentDeduplicator->OnUploadCompleted(result.EventId, result.IsDelivered, result.IsRetryable && spool.IsValid(), FPlatformTime::Seconds());
+		}
+
+		if (!spool)
+		{
+			continue;
+		}
+
+		if (!result.IsRetryable)
+		{
+			// Server is reachable again, so whatever is spooled can be retried right away
+			if (!result.SpoolId.IsEmpty())
+			{
+				spool->Remove(result.SpoolId);
+			}
+
+			backoff.Reset();
+			nextRetryTime = 0.0;
+			SentryTransportAccounting::SetOfflineUntil(0.0);
+			continue;
+		}
+
+		if (result.Envelope.Num() > 0)
+		{
+			spool->Store(result.Envelope, FSentryEnvelopeSpool::GetPriority(result.Envelope));
+		}
+
+		// Requests sent before the server became unreachable fail together, only the first one extends the delay
+		const double now = FPlatformTime::Seconds();
+		if (now >= nextRetryTime)
+		{
+			nextRetryTime = now + backoff.NextDelay();
+			SentryTransportAccounting::SetOfflineUntil(nextRetryTime);
+
+			UE_LOG(LogSentrySdk, Log, TEXT("Server is unreachable, spooling envelopes for the next %.0f seconds."), nextRetryTime - now);
+		}
+	}
+}
+
+void FGenericPlatformSentryTransport::RetrySpooledEnvelope()
+{
+	const double now = FPlatformTime::Seconds();
+	if (!spool || spool->IsEmpty() || isSpoolRequestPending || now < nextRetryTime || now < spoolRetryStartTime)
+	{
+		return;
+	}
+
+	FString spoolId;
+	TArray<uint8> envelope;
+	if (!spool->Peek(spoolId, envelope))
+	{
+		return;
+	}
+
+	// Envelope stays spooled until its categories aren't limited anymore rather than being dropped
+	TArray<uint8> filtered;
+	if (!requestState->ApplyRateLimits(envelope, filtered))
+	{
+		return;
+	}
+
+	isSpoolRequestPending = Send(envelope, spoolId);
+}
+
+double FGenericPlatformSentryTransport::GetWakeUpTime() const
+{
+	double wakeUpTime = TNumericLimits<double>::Max();
+
+	if (!batch.IsEmpty())
+	{
+		wakeUpTime = batchStartTime + batchWindowSeconds;
+	}
+
+	if ((spool || attachmentDeduplicator) && requestState->NumPendingRequests.GetValue() > 0)
+	{
+		wakeUpTime = FMath::Min(wakeUpTime, FPlatformTime::Seconds() + SentryTransport::ResultsPollIntervalSeconds);
+	}
+
+	if (spool && !spool->IsEmpty() && !isSpoolRequestPending)
+	{
+		wakeUpTime = FMath::Min(wakeUpTime, FMath::Max(nextRetryTime, spoolRetryStartTime));
+	}
+
+	return wakeUpTime;
+}
+
+bool FGenericPlatformSentryTransport::WaitUntilIdle(uint64 timeoutMs)
+{
+	const double endTime = FPlatformTime::Seconds() + timeoutMs / 1000.0;
+
+	while (numUnsentEnvelopes.GetValue() > 0 || requestState->NumPendingRequests.GetValue() > 0)
+	{
+		if (FPlatformTime::Seconds() >= endTime)
+		{
+			return false;
+		}
+
+		// Request completion is dispatched from the game thread, which may be the one waiting here
+		if (IsInGameThread())
+		{
+			FHttpModule::Get().GetHttpManager().Tick(0.0f);
+		}
+
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	return true;
+}
+
+void FGenericPlatformSentryTransport::UpdateBacklog()
+{
+	const int32 numQueuedEnvelopes = numUnsentEnvelopes.GetValue();
+	const int32 numRequestsInFlight = requestState->NumPendingRequests.GetValue();
+
+	SentryTransportAccounting::SetBacklog(numQueuedEnvelopes, numQueuedBytes.Load(), numRequestsInFlight, numSpooledEnvelopes.Load(), numSpooledBytes.Load());
+
+	if (adaptiveSampler)
+	{
+		adaptiveSampler->SetBacklog(numQueuedEnvelopes + numRequestsInFlight + numSpooledEnvelopes.Load(), numQueuedBytes.Load() + numSpooledBytes.Load());
+		SentryTransportAccounting::SetAdaptiveSampleRate(adaptiveSampler->GetSampleRate());
+	}
+}
+
+#endif
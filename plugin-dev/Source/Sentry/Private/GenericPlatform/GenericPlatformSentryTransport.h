@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "Convenience/GenericPlatformSentryInclude.h"
+
+#include "Utils/SentryAttachmentDeduplicator.h"
+#include "Utils/SentryEnvelopeBatch.h"
+#include "Utils/SentryEnvelopeSpool.h"
+
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Templates/Atomic.h"
+
+class FEvent;
+class FRunnableThread;
+class FSentryAdaptiveSampler;
+class FSentryStaticScopeFragment;
+class USentrySettings;
+
+#if USE_SENTRY_NATIVE
+
+/**
+ * Transport sending envelopes through the engine's HTTP module instead of the sentry-native one.
+ *
+ * Envelopes that don't carry an event (sessions, logs, client reports) are held for a short window and merged
+ * into one envelope, all other envelopes are sent as soon as possible. Requests are gzipped and go through the
+ * engine's HTTP connection pool so connections are kept alive between envelopes.
+ *
+ * If the offline spool is enabled, envelopes that fail to send are persisted and retried one at a time with
+ * an exponential backoff, new envelopes go straight to the spool until the next retry succeeds. With fast exit,
+ * envelopes left at shutdown are spooled without being sent and without waiting for the requests in flight.
+ *
+ * If attachment deduplication is enabled, attachments with the same content as an attachment of an earlier event
+ * are replaced with a reference to that event before the envelope is sent. If envelopes are compressed, large text
+ * attachments are gzipped on their own on the transport thread as well.
+ *
+ * If a static scope fragment is given, the scope entries that never change are spliced into events and transactions
+ * from their pre-serialized form rather than being serialized by the native SDK for each of them.
+ *
+ * The backlog of queued, in-flight and spooled envelopes along with request outcomes is published to the transport
+ * stats and, if one is given, to the adaptive sampler.
+ */
+class FGenericPlatformSentryTransport : public FRunnable
+{
+public:
+	FGenericPlatformSentryTransport(const FString& endpointUrl, const FString& authHeader, float batchWindow, bool isCompressionEnabled, const FString& spoolDirectory, int64 spoolMaxSize);
+	virtual ~FGenericPlatformSentryTransport() override;
+
+	/** Creates a native transport owning a new instance of this class, null if it can't be used with the given settings. */
+	static sentry_transport_t* CreateNativeTransport(const USentrySettings* settings, const FString& spoolDirectory, TSharedPtr<FSentryStaticScopeFragment, ESPMode::ThreadSafe> staticScopeFragment = nullptr,
+		TSharedPtr<FSentryAdaptiveSampler, ESPMode::ThreadSafe> adaptiveSampler = nullptr);
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+private:
+	struct FRequestResult
+	{
+		/** Envelope to be spooled if the request can be retried, empty for envelopes that are already spooled. */
+		TArray<uint8> Envelope;
+
+		/** ID of the spooled envelope the request was sent for, empty for new envelopes. */
+		FString SpoolId;
+
+		/** ID of the event the envelope carried, only set if attachments of the event wait for the upload to be deduplicated. */
+		FString EventId;
+
+		/** Whether the request failed due to network or server errors and can be retried later. */
+		bool IsRetryable;
+
+		/** Whether the server accepted the envelope. */
+		bool IsDelivered;
+	};
+
+	/** State shared with the requests in flight which can outlive the transport. */
+	struct FRequestState
+	{
+		FThreadSafeCounter NumPendingRequests;
+
+		/**
+		 * Times until which items of each data category are dropped as requested by the server, in FPlatformTime::Cycles64.
+		 * Empty category stands for all of them.
+		 */
+		FCriticalSection RateLimitsCriticalSection;
+		TMap<FString, uint64> RetryAfterCycles;
+
+		/** Applies the rate limits of the response, if any. Called when a request completes. */
+		void UpdateRateLimits(const FHttpResponsePtr& Response);
+
+		/**
+		 * Removes the items of rate limited categories from the envelope.
+		 *
+		 * @param OutFiltered Envelope without the rate limited items, left empty if none of them are.
+		 * @return False if all items of the envelope are rate limited.
+		 */
+		bool ApplyRateLimits(const TArray<uint8>& Envelope, TArray<uint8>& OutFiltered);
+
+		/** Outcomes of completed requests, only reported if the offline spool or attachment deduplication is enabled. */
+		TQueue<FRequestResult, EQueueMode::Mpsc> Results;
+		bool IsReportingResults = false;
+	};
+
+	/**
+	 * Static wrappers that are passed to the Sentry library.
+	 */
+	static void HandleSend(sentry_envelope_t* envelope, void* state);
+	static int HandleStartup(const sentry_options_t* options, void* state);
+	static int HandleFlush(uint64_t timeout, void* state);
+	static int HandleShutdown(uint64_t timeout, void* state);
+	static void HandleFree(void* state);
+
+	/** Sends the queued envelopes, the batch is sent only when its window has elapsed unless forced. */
+	void ProcessQueue(bool force);
+
+	/** Sends the envelope unless the server is unreachable, in which case it's spooled right away. */
+	void SendOrSpool(const TArray<uint8>& envelope);
+
+	/** Sends the envelope without the items of rate limited categories, false if all of them were dropped. */
+	bool Send(const TArray<uint8>& envelope, const FString& spoolId = FString());
+
+	/** Spools envelopes of the failed requests and removes the sent ones from the spool. */
+	void ProcessResults();
+
+	/** Sends the next spooled envelope once the previous one has been sent and the retry delay has elapsed. */
+	void RetrySpooledEnvelope();
+
+	/** Gets the time the transport thread has to wake up at to handle batching and retries. */
+	double GetWakeUpTime() const;
+
+	/** Waits until all envelopes are sent and their requests complete, false on timeout. */
+	bool WaitUntilIdle(uint64 timeoutMs);
+
+	/** Publishes the current backlog to the transport stats and the adaptive sampler, if any. */
+	void UpdateBacklog();
+
+	const FString endpointUrl;
+	const FString authHeader;
+	const double batchWindowSeconds;
+	const bool isCompressionEnabled;
+
+	const FString spoolDirectory;
+	const int64 spoolMaxSize;
+
+	TQueue<TArray<uint8>, EQueueMode::Mpsc> queue;
+
+	/** Envelopes held for merging, accessed from the transport thread only. */
+	FSentryEnvelopeBatch batch;
+	double batchStartTime = 0.0;
+
+	/** Offline spool, null if disabled. Accessed from the transport thread only, created once it starts to keep file access off the calling thread. */
+	TUniquePtr<FSentryEnvelopeSpool> spool;
+	FSentryRetryBackoff backoff;
+
+	/** Time until which the server is considered unreachable after a failed request. */
+	double nextRetryTime = 0.0;
+
+	/** Time before which envelopes spooled by previous sessions aren't retried to keep them from competing with the startup. */
+	double spoolRetryStartTime = 0.0;
+
+	bool isSpoolRequestPending = false;
+
+	/** Deduplicates attachments of the sent events, null if disabled. Accessed from the transport thread only. */
+	TUniquePtr<FSentryAttachmentDeduplicator> attachmentDeduplicator;
+
+	/** Size from which text attachments are gzipped, negative if disabled. */
+	int32 textAttachmentCompressionThreshold = -1;
+
+	/** Pre-serialized static scope entries spliced into events and transactions, null if disabled. */
+	TSharedPtr<FSentryStaticScopeFragment, ESPMode::ThreadSafe> staticScopeFragment;
+
+	/** Whether envelopes left at shutdown are spooled for the next session instead of being sent. */
+	bool isFastExitEnabled = false;
+
+	/** Set on the transport thread once it's stopped with fast exit, every envelope goes to the spool from then on. */
+	bool isSpoolingOnly = false;
+
+	/** Number of envelopes either queued or batched. */
+	FThreadSafeCounter numUnsentEnvelopes;
+
+	/** Size of the queued envelopes, used along with the spool size to report the backlog. */
+	TAtomic<int64> numQueuedBytes { 0 };
+	TAtomic<int32> numSpooledEnvelopes { 0 };
+	TAtomic<int64> numSpooledBytes { 0 };
+
+	/** Sampler the backlog is reported to, null if disabled. */
+	TSharedPtr<FSentryAdaptiveSampler, ESPMode::ThreadSafe> adaptiveSampler;
+
+	TSharedRef<FRequestState, ESPMode::ThreadSafe> requestState;
+
+	FEvent* wakeEvent = nullptr;
+	FRunnableThread* thread = nullptr;
+
+	/** Priority and cores the transport thread is created with. */
+	EThreadPriority threadPriority = TPri_BelowNormal;
+	uint64 threadAffinityMask = 0;
+
+	FThreadSafeCounter stopRequested;
+	FThreadSafeCounter flushRequested;
+};
+
+#endif
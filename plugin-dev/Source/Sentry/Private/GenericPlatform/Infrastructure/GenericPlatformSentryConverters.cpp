@@ -4,7 +4,11 @@
 
 #include "SentryDefines.h"
 
+#include "Utils/SentryStructLayout.h"
+#include "Utils/SentryTrace.h"
+
 #include "Dom/JsonObject.h"
+#include "Misc/DateTime.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "UObject/Class.h"
@@ -13,6 +17,83 @@
 
 #if USE_SENTRY_NATIVE
 
+namespace SentryConvertersUtf8
+{
+	/**
+	 * Per-thread scratch buffers shared by all conversions. Native SDK copies keys and strings it receives, so each buffer
+	 * only has to outlive a single call and converting a large map reuses one allocation instead of making one per string.
+	 */
+	static thread_local TArray<ANSICHAR> KeyBuffer;
+	static thread_local TArray<ANSICHAR> ValueBuffer;
+
+	static sentry_value_t NewString(const FString& value)
+	{
+		FGenericPlatformSentryConverters::StringToUtf8(value, ValueBuffer);
+		return sentry_value_new_string_n(ValueBuffer.GetData(), ValueBuffer.Num() - 1);
+	}
+
+	/** Nested values have to be converted before calling this since they reuse the same key buffer. */
+	static void SetByKey(sentry_value_t object, const FString& key, sentry_value_t value)
+	{
+		FGenericPlatformSentryConverters::StringToUtf8(key, KeyBuffer);
+		sentry_value_set_by_key_n(object, KeyBuffer.GetData(), KeyBuffer.Num() - 1, value);
+	}
+
+	/** Writes struct fields using the UTF-8 keys cached in the layout, nested structs become nested objects. */
+	class FStructWriter
+	{
+	public:
+		FStructWriter()
+		{
+			Objects.Add(sentry_value_new_object());
+		}
+
+		void WriteBool(const FSentryStructLayout::FField& Field, bool Value)
+		{
+			Set(Field, sentry_value_new_bool(Value));
+		}
+
+		void WriteInteger(const FSentryStructLayout::FField& Field, int32 Value)
+		{
+			Set(Field, sentry_value_new_int32(Value));
+		}
+
+		void WriteFloat(const FSentryStructLayout::FField& Field, double Value)
+		{
+			Set(Field, sentry_value_new_double(Value));
+		}
+
+		void WriteString(const FSentryStructLayout::FField& Field, const FString& Value)
+		{
+			Set(Field, NewString(Value));
+		}
+
+		void BeginStruct(const FSentryStructLayout::FField& Field)
+		{
+			Objects.Add(sentry_value_new_object());
+		}
+
+		void EndStruct(const FSentryStructLayout::FField& Field)
+		{
+			sentry_value_t Nested = Objects.Pop();
+			Set(Field, Nested);
+		}
+
+		sentry_value_t Finish()
+		{
+			return Objects.Pop();
+		}
+
+	private:
+		void Set(const FSentryStructLayout::FField& Field, sentry_value_t Value)
+		{
+			sentry_value_set_by_key_n(Objects.Last(), Field.Utf8Name.GetData(), Field.Utf8Name.Num() - 1, Value);
+		}
+
+		TArray<sentry_value_t, TInlineAllocator<4>> Objects;
+	};
+}
+
 sentry_level_e FGenericPlatformSentryConverters::SentryLevelToNative(ESentryLevel level)
 {
 	sentry_level_e Level = {};
@@ -43,11 +124,13 @@ sentry_level_e FGenericPlatformSentryConverters::SentryLevelToNative(ESentryLeve
 
 sentry_value_t FGenericPlatformSentryConverters::StringMapToNative(const TMap<FString, FString>& map)
 {
+	SENTRY_TRACE_SCOPE(StringMapToNative);
+
 	sentry_value_t nativeValue = sentry_value_new_object();
 
 	for (auto it = map.CreateConstIterator(); it; ++it)
 	{
-		sentry_value_set_by_key(nativeValue, TCHAR_TO_ANSI(*it.Key()), sentry_value_new_string(TCHAR_TO_ANSI(*it.Value())));
+		SentryConvertersUtf8::SetByKey(nativeValue, it.Key(), SentryConvertersUtf8::NewString(it.Value()));
 	}
 
 	return nativeValue;
@@ -55,12 +138,14 @@ sentry_value_t FGenericPlatformSentryConverters::StringMapToNative(const TMap<FS
 
 sentry_value_t FGenericPlatformSentryConverters::StringArrayToNative(const TArray<FString>& array)
 {
+	SENTRY_TRACE_SCOPE(StringArrayToNative);
+
 	sentry_value_t sentryArray = sentry_value_new_list();
 
 	for (auto it = array.CreateConstIterator(); it; ++it)
 	{
 		const FString& ArrayItem = *it;
-		sentry_value_append(sentryArray, sentry_value_new_string(TCHAR_TO_ANSI(*ArrayItem)));
+		sentry_value_append(sentryArray, SentryConvertersUtf8::NewString(ArrayItem));
 	}
 
 	return sentryArray;
@@ -77,11 +162,11 @@ sentry_value_t FGenericPlatformSentryConverters::VariantToNative(const FSentryVa
 	case ESentryVariantType::Bool:
 		return sentry_value_new_bool(variant.GetValue<bool>());
 	case ESentryVariantType::String:
-		return sentry_value_new_string(TCHAR_TO_ANSI(*variant.GetValue<FString>()));
+		return SentryConvertersUtf8::NewString(variant.GetStringRef());
 	case ESentryVariantType::Array:
-		return VariantArrayToNative(variant.GetValue<TArray<FSentryVariant>>());
+		return VariantArrayToNative(variant.GetArrayRef());
 	case ESentryVariantType::Map:
-		return VariantMapToNative(variant.GetValue<TMap<FString, FSentryVariant>>());
+		return VariantMapToNative(variant.GetMapRef());
 	default:
 		return sentry_value_new_null();
 	}
@@ -89,6 +174,8 @@ sentry_value_t FGenericPlatformSentryConverters::VariantToNative(const FSentryVa
 
 sentry_value_t FGenericPlatformSentryConverters::VariantArrayToNative(const TArray<FSentryVariant>& array)
 {
+	SENTRY_TRACE_SCOPE(VariantArrayToNative);
+
 	sentry_value_t sentryArray = sentry_value_new_list();
 
 	for (auto it = array.CreateConstIterator(); it; ++it)
@@ -101,16 +188,41 @@ sentry_value_t FGenericPlatformSentryConverters::VariantArrayToNative(const TArr
 
 sentry_value_t FGenericPlatformSentryConverters::VariantMapToNative(const TMap<FString, FSentryVariant>& map)
 {
+	SENTRY_TRACE_SCOPE(VariantMapToNative);
+
 	sentry_value_t sentryObject = sentry_value_new_object();
 
 	for (auto it = map.CreateConstIterator(); it; ++it)
 	{
-		sentry_value_set_by_key(sentryObject, TCHAR_TO_ANSI(*it.Key()), VariantToNative(it.Value()));
+		sentry_value_t nativeValue = VariantToNative(it.Value());
+		SentryConvertersUtf8::SetByKey(sentryObject, it.Key(), nativeValue);
 	}
 
 	return sentryObject;
 }
 
+sentry_value_t FGenericPlatformSentryConverters::StructToNative(const FSentryStructLayout& layout, const void* structData, int32 maxDepth, int32 maxValues, int32& numTrimmed)
+{
+	SENTRY_TRACE_SCOPE(StructToNative);
+
+	SentryConvertersUtf8::FStructWriter writer;
+	numTrimmed = layout.Write(structData, writer, maxDepth, maxValues);
+	return writer.Finish();
+}
+
+const char* FGenericPlatformSentryConverters::StringToUtf8(const FString& str, TArray<ANSICHAR>& buffer)
+{
+	const int32 utf8Length = FPlatformString::ConvertedLength<UTF8CHAR>(*str, str.Len());
+
+	buffer.Reset();
+	buffer.AddUninitialized(utf8Length + 1);
+
+	FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(buffer.GetData()), utf8Length, *str, str.Len());
+	buffer[utf8Length] = '\0';
+
+	return buffer.GetData();
+}
+
 sentry_value_t FGenericPlatformSentryConverters::AddressToNative(uint64 address)
 {
 	char buffer[32];
@@ -123,15 +235,15 @@ sentry_value_t FGenericPlatformSentryConverters::AddressToNative(uint64 address)
 	return sentry_value_new_string(buffer);
 }
 
-sentry_value_t FGenericPlatformSentryConverters::CallstackToNative(const TArray<FProgramCounterSymbolInfo>& callstack)
+sentry_value_t FGenericPlatformSentryConverters::CallstackToNative(const TArray<uint64>& programCounters)
 {
-	int32 framesCount = callstack.Num();
+	int32 framesCount = programCounters.Num();
 
 	sentry_value_t frames = sentry_value_new_list();
 	for (int i = 0; i < framesCount; ++i)
 	{
 		sentry_value_t frame = sentry_value_new_object();
-		sentry_value_set_by_key(frame, "instruction_addr", AddressToNative(callstack[framesCount - i - 1].ProgramCounter));
+		sentry_value_set_by_key(frame, "instruction_addr", AddressToNative(programCounters[framesCount - i - 1]));
 		sentry_value_append(frames, frame);
 	}
 
@@ -141,6 +253,16 @@ sentry_value_t FGenericPlatformSentryConverters::CallstackToNative(const TArray<
 	return stacktrace;
 }
 
+sentry_value_t FGenericPlatformSentryConverters::TimestampToNative(int64 timestamp)
+{
+	const FDateTime dateTime = FDateTime(1970, 1, 1) + FTimespan(timestamp * ETimespan::TicksPerMicrosecond);
+
+	char buffer[40];
+	snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ", dateTime.GetYear(), dateTime.GetMonth(), dateTime.GetDay(),
+		dateTime.GetHour(), dateTime.GetMinute(), dateTime.GetSecond(), static_cast<int32>((dateTime.GetTicks() / ETimespan::TicksPerMicrosecond) % 1000000));
+	return sentry_value_new_string(buffer);
+}
+
 ESentryLevel FGenericPlatformSentryConverters::SentryLevelToUnreal(sentry_value_t level)
 {
 	FString levelStr = FString(sentry_value_as_string(level));
@@ -238,7 +360,7 @@ TMap<FString, FSentryVariant> FGenericPlatformSentryConverters::VariantMapToUnre
 
 	for (auto it = keysArr.CreateConstIterator(); it; ++it)
 	{
-		unrealMap.Add(*it, VariantToUnreal(sentry_value_get_by_key(map, TCHAR_TO_ANSI(**it))));
+		unrealMap.Add(*it, VariantToUnreal(sentry_value_get_by_key(map, TCHAR_TO_UTF8(**it))));
 	}
 
 	sentry_string_free(jsonString);
@@ -376,11 +498,11 @@ TSharedPtr<FJsonValue> FGenericPlatformSentryConverters::VariantToJsonValue(cons
 	case ESentryVariantType::Bool:
 		return MakeShareable(new FJsonValueBoolean(variant.GetValue<bool>()));
 	case ESentryVariantType::String:
-		return MakeShareable(new FJsonValueString(variant.GetValue<FString>()));
+		return MakeShareable(new FJsonValueString(variant.GetStringRef()));
 	case ESentryVariantType::Array:
-		return VariantArrayToJsonValue(variant.GetValue<TArray<FSentryVariant>>());
+		return VariantArrayToJsonValue(variant.GetArrayRef());
 	case ESentryVariantType::Map:
-		return VariantMapToJsonValue(variant.GetValue<TMap<FString, FSentryVariant>>());
+		return VariantMapToJsonValue(variant.GetMapRef());
 	default:
 		return MakeShareable(new FJsonValueNull());
 	}
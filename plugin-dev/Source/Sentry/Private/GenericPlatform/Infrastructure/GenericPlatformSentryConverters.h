@@ -6,11 +6,11 @@
 #include "SentryVariant.h"
 
 #include "GenericPlatform/Convenience/GenericPlatformSentryInclude.h"
-#include "GenericPlatform/GenericPlatformStackWalk.h"
 
 #if USE_SENTRY_NATIVE
 
 class FJsonValue;
+class FSentryStructLayout;
 
 class FGenericPlatformSentryConverters
 {
@@ -23,7 +23,16 @@ public:
 	static sentry_value_t VariantArrayToNative(const TArray<FSentryVariant>& array);
 	static sentry_value_t VariantMapToNative(const TMap<FString, FSentryVariant>& map);
 	static sentry_value_t AddressToNative(uint64 address);
-	static sentry_value_t CallstackToNative(const TArray<FProgramCounterSymbolInfo>& callstack);
+	static sentry_value_t CallstackToNative(const TArray<uint64>& programCounters);
+
+	/** Converts microseconds since the Unix epoch to an RFC 3339 string keeping the microseconds. */
+	static sentry_value_t TimestampToNative(int64 timestamp);
+
+	/** Writes the struct straight into a native object, `numTrimmed` receives the amount of values dropped because of the limits. */
+	static sentry_value_t StructToNative(const FSentryStructLayout& layout, const void* structData, int32 maxDepth, int32 maxValues, int32& numTrimmed);
+
+	/** Encodes the string as null-terminated UTF-8 into the buffer, reusing its allocation. */
+	static const char* StringToUtf8(const FString& str, TArray<ANSICHAR>& buffer);
 
 	/** Conversions from native types */
 	static ESentryLevel SentryLevelToUnreal(sentry_value_t level);
@@ -0,0 +1,148 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "GenericPlatformSentryPayloadBudget.h"
+
+#include "GenericPlatformSentryConverters.h"
+
+#if USE_SENTRY_NATIVE
+
+int64 FGenericPlatformSentryPayloadBudget::GetSerializedSize(sentry_value_t value)
+{
+	char* json = sentry_value_to_json(value);
+	if (!json)
+	{
+		return 0;
+	}
+
+	const int64 size = FCStringAnsi::Strlen(json);
+
+	sentry_string_free(json);
+
+	return size;
+}
+
+int64 FGenericPlatformSentryPayloadBudget::Enforce(sentry_value_t event, int64 maxSize, bool& outWasTrimmed)
+{
+	outWasTrimmed = false;
+
+	int64 size = GetSerializedSize(event);
+	if (size <= maxSize)
+	{
+		return size;
+	}
+
+	// Breadcrumbs are usually the bulk of an event and the oldest ones are the least useful, custom data goes next
+	int64 freed = TrimBreadcrumbs(event, size - maxSize);
+
+	if (size - freed > maxSize)
+	{
+		freed += TrimLargestEntries(event, "extra", size - freed - maxSize);
+	}
+
+	if (size - freed > maxSize)
+	{
+		freed += TrimLargestEntries(event, "contexts", size - freed - maxSize);
+	}
+
+	if (freed > 0)
+	{
+		outWasTrimmed = true;
+		size = GetSerializedSize(event);
+	}
+
+	return size;
+}
+
+int64 FGenericPlatformSentryPayloadBudget::TrimBreadcrumbs(sentry_value_t event, int64 excess)
+{
+	sentry_value_t breadcrumbs = sentry_value_get_by_key(event, "breadcrumbs");
+
+	// Breadcrumbs are either a plain list or wrapped in an object with a list of values
+	const bool isWrapped = sentry_value_get_type(breadcrumbs) == SENTRY_VALUE_TYPE_OBJECT;
+	sentry_value_t values = isWrapped ? sentry_value_get_by_key(breadcrumbs, "values") : breadcrumbs;
+
+	if (sentry_value_get_type(values) != SENTRY_VALUE_TYPE_LIST)
+	{
+		return 0;
+	}
+
+	const int32 numBreadcrumbs = static_cast<int32>(sentry_value_get_length(values));
+
+	int64 freed = 0;
+	int32 numDropped = 0;
+
+	while (numDropped < numBreadcrumbs && freed < excess)
+	{
+		// Each list element is followed by a comma except for the last one
+		freed += GetSerializedSize(sentry_value_get_by_index(values, numDropped)) + 1;
+		numDropped++;
+	}
+
+	if (numDropped == 0)
+	{
+		return 0;
+	}
+
+	sentry_value_t keptValues = sentry_value_new_list();
+	for (int32 i = numDropped; i < numBreadcrumbs; ++i)
+	{
+		sentry_value_t breadcrumb = sentry_value_get_by_index(values, i);
+		sentry_value_incref(breadcrumb);
+		sentry_value_append(keptValues, breadcrumb);
+	}
+
+	if (isWrapped)
+	{
+		sentry_value_set_by_key(breadcrumbs, "values", keptValues);
+	}
+	else
+	{
+		sentry_value_set_by_key(event, "breadcrumbs", keptValues);
+	}
+
+	return freed;
+}
+
+int64 FGenericPlatformSentryPayloadBudget::TrimLargestEntries(sentry_value_t event, const char* key, int64 excess)
+{
+	sentry_value_t entries = sentry_value_get_by_key(event, key);
+	if (sentry_value_get_type(entries) != SENTRY_VALUE_TYPE_OBJECT)
+	{
+		return 0;
+	}
+
+	TArray<FString> keys;
+	FGenericPlatformSentryConverters::VariantMapToUnreal(entries).GetKeys(keys);
+
+	TArray<TPair<int64, FString>> entrySizes;
+	entrySizes.Reserve(keys.Num());
+
+	for (const FString& entryKey : keys)
+	{
+		// Key, its quotes, the colon and the separating comma
+		const int64 entrySize = GetSerializedSize(sentry_value_get_by_key(entries, TCHAR_TO_UTF8(*entryKey))) + FTCHARToUTF8(*entryKey).Length() + 4;
+		entrySizes.Emplace(entrySize, entryKey);
+	}
+
+	entrySizes.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	int64 freed = 0;
+
+	for (const TPair<int64, FString>& entrySize : entrySizes)
+	{
+		if (freed >= excess)
+		{
+			break;
+		}
+
+		sentry_value_remove_by_key(entries, TCHAR_TO_UTF8(*entrySize.Value));
+		freed += entrySize.Key;
+	}
+
+	return freed;
+}
+
+#endif
@@ -0,0 +1,39 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "GenericPlatform/Convenience/GenericPlatformSentryInclude.h"
+
+#if USE_SENTRY_NATIVE
+
+/**
+ * Keeps events within a serialized size budget.
+ *
+ * Oversized events are trimmed in a fixed order: oldest breadcrumbs first, then the largest extras and finally
+ * the largest contexts, until the event fits. Message, exception, tags and the rest of the event are never touched.
+ */
+class FGenericPlatformSentryPayloadBudget
+{
+public:
+	/** Gets the size of the value serialized as JSON in bytes. */
+	static int64 GetSerializedSize(sentry_value_t value);
+
+	/**
+	 * Trims the event until its serialized size fits the budget or there is nothing left to trim.
+	 *
+	 * @param event Event to trim in place.
+	 * @param maxSize Max serialized size of the event in bytes.
+	 * @param outWasTrimmed Whether anything was removed from the event.
+	 * @return Serialized size of the event after trimming.
+	 */
+	static int64 Enforce(sentry_value_t event, int64 maxSize, bool& outWasTrimmed);
+
+private:
+	/** Drops the oldest breadcrumbs until the given amount of bytes is freed, returns the amount actually freed. */
+	static int64 TrimBreadcrumbs(sentry_value_t event, int64 excess);
+
+	/** Drops the largest entries of the given event object until the given amount of bytes is freed, returns the amount actually freed. */
+	static int64 TrimLargestEntries(sentry_value_t event, const char* key, int64 excess);
+};
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "GenericPlatformSentryStacktraceCache.h"
+
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+
+#if USE_SENTRY_NATIVE
+
+FGenericPlatformSentryStacktraceCache::FGenericPlatformSentryStacktraceCache(int32 inMaxFrames, bool inIsCacheEnabled)
+	: maxFrames(FMath::Max(inMaxFrames, 0))
+	, isCacheEnabled(inIsCacheEnabled)
+{
+}
+
+FGenericPlatformSentryStacktraceCache::~FGenericPlatformSentryStacktraceCache()
+{
+	Clear();
+}
+
+void FGenericPlatformSentryStacktraceCache::SetStacktrace(sentry_value_t event)
+{
+	void* frames[maxWalkDepth];
+
+	// Frames that are trimmed anyway don't have to be walked
+	const int32 walkDepth = maxFrames > 0 ? FMath::Min(maxFrames, maxWalkDepth) : maxWalkDepth;
+
+	if (!isCacheEnabled)
+	{
+		const int32 length = static_cast<int32>(sentry_unwind_stack(nullptr, frames, walkDepth));
+		AttachStacktrace(event, CreateStacktrace(frames, length));
+		return;
+	}
+
+	const int32 callsiteLength = static_cast<int32>(sentry_unwind_stack(nullptr, frames, callsiteDepth));
+	const uint32 key = FCrc::MemCrc32(frames, callsiteLength * sizeof(void*));
+
+	{
+		FScopeLock Lock(&criticalSection);
+
+		const FEntry* entry = entries.Find(key);
+		if (entry && entry->callsiteLength == callsiteLength && FMemory::Memcmp(entry->callsite, frames, callsiteLength * sizeof(void*)) == 0)
+		{
+			sentry_value_incref(entry->stacktrace);
+			AttachStacktrace(event, entry->stacktrace);
+			return;
+		}
+	}
+
+	FEntry newEntry;
+	FMemory::Memcpy(newEntry.callsite, frames, callsiteLength * sizeof(void*));
+	newEntry.callsiteLength = callsiteLength;
+
+	const int32 length = callsiteLength < callsiteDepth ? callsiteLength : static_cast<int32>(sentry_unwind_stack(nullptr, frames, walkDepth));
+
+	newEntry.stacktrace = CreateStacktrace(frames, length);
+	sentry_value_freeze(newEntry.stacktrace);
+
+	{
+		FScopeLock Lock(&criticalSection);
+
+		if (entries.Num() < maxEntries && !entries.Contains(key))
+		{
+			sentry_value_incref(newEntry.stacktrace);
+			entries.Add(key, newEntry);
+		}
+	}
+
+	AttachStacktrace(event, newEntry.stacktrace);
+}
+
+void FGenericPlatformSentryStacktraceCache::Clear()
+{
+	FScopeLock Lock(&criticalSection);
+
+	for (const auto& entry : entries)
+	{
+		sentry_value_decref(entry.Value.stacktrace);
+	}
+
+	entries.Empty();
+}
+
+int32 FGenericPlatformSentryStacktraceCache::Num() const
+{
+	FScopeLock Lock(&criticalSection);
+	return entries.Num();
+}
+
+sentry_value_t FGenericPlatformSentryStacktraceCache::CreateStacktrace(void** frames, int32 length) const
+{
+	// Walked frames are innermost first, so trimming drops the outermost ones
+	return sentry_value_new_stacktrace(frames, maxFrames > 0 ? FMath::Min(length, maxFrames) : length);
+}
+
+void FGenericPlatformSentryStacktraceCache::AttachStacktrace(sentry_value_t event, sentry_value_t stacktrace)
+{
+	// Same layout as `sentry_value_set_stacktrace` produces
+	sentry_value_t thread = sentry_value_new_object();
+	sentry_value_set_by_key(thread, "stacktrace", stacktrace);
+
+	sentry_value_t values = sentry_value_new_list();
+	sentry_value_append(values, thread);
+
+	sentry_value_t threads = sentry_value_new_object();
+	sentry_value_set_by_key(threads, "values", values);
+
+	sentry_value_set_by_key(event, "threads", threads);
+}
+
+#endif
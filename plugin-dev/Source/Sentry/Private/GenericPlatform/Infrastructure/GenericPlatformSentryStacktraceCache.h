@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "GenericPlatform/Convenience/GenericPlatformSentryInclude.h"
+
+#include "HAL/CriticalSection.h"
+
+#if USE_SENTRY_NATIVE
+
+/**
+ * Builds the stack traces attached to captured events.
+ *
+ * Stack traces can be limited to the innermost frames, which drops the engine loop and the rest of the outer frames
+ * that are the same for every capture. If callsites are cached, only the innermost frames are walked to identify
+ * where the capture comes from and the frame list built for the first capture from there is reused,
+ * so repeated captures from a callsite cost neither a full stack walk nor building the frames again.
+ */
+class FGenericPlatformSentryStacktraceCache
+{
+public:
+	FGenericPlatformSentryStacktraceCache(int32 inMaxFrames, bool inIsCacheEnabled);
+	~FGenericPlatformSentryStacktraceCache();
+
+	/** Sets the stack trace of the calling thread as the event's thread stack trace. */
+	void SetStacktrace(sentry_value_t event);
+
+	/** Releases the cached stack traces. */
+	void Clear();
+
+	int32 Num() const;
+
+private:
+	/** Number of innermost frames identifying a callsite */
+	static constexpr int32 callsiteDepth = 16;
+
+	static constexpr int32 maxWalkDepth = 128;
+	static constexpr int32 maxEntries = 256;
+
+	struct FEntry
+	{
+		void* callsite[callsiteDepth];
+		int32 callsiteLength;
+
+		/** Frozen frame list shared by the events captured from the callsite */
+		sentry_value_t stacktrace;
+	};
+
+	sentry_value_t CreateStacktrace(void** frames, int32 length) const;
+
+	static void AttachStacktrace(sentry_value_t event, sentry_value_t stacktrace);
+
+	TMap<uint32, FEntry> entries;
+	mutable FCriticalSection criticalSection;
+
+	int32 maxFrames;
+	bool isCacheEnabled;
+};
+
+#endif
@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "GenericPlatformSentryStaticScope.h"
+
+#include "Utils/SentryStaticScopeFragment.h"
+
+#include "Misc/ScopeLock.h"
+
+#if USE_SENTRY_NATIVE
+
+namespace GenericPlatformSentryStaticScope
+{
+	static TArray<ANSICHAR> ToUtf8(const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+
+		TArray<ANSICHAR> Utf8;
+		Utf8.Append(Converted.Get(), Converted.Length());
+		Utf8.Add('\0');
+
+		return Utf8;
+	}
+
+	static bool IsSameString(sentry_value_t value, const TArray<ANSICHAR>& expected)
+	{
+		return sentry_value_get_type(value) == SENTRY_VALUE_TYPE_STRING && FCStringAnsi::Strcmp(sentry_value_as_string(value), expected.GetData()) == 0;
+	}
+}
+
+FGenericPlatformSentryStaticScope::FGenericPlatformSentryStaticScope(const FString& release, const FString& environment, const FString& dist)
+	: fragment(MakeShared<FSentryStaticScopeFragment, ESPMode::ThreadSafe>())
+{
+	const TPair<const TCHAR*, const FString*> nativeAttributes[] = {
+		{ TEXT("release"), &release },
+		{ TEXT("environment"), &environment },
+		{ TEXT("dist"), &dist }
+	};
+
+	// Native SDK leaves out the attributes that aren't set
+	for (const TPair<const TCHAR*, const FString*>& attribute : nativeAttributes)
+	{
+		if (!attribute.Value->IsEmpty())
+		{
+			attributes.Add(attribute.Key, GenericPlatformSentryStaticScope::ToUtf8(*attribute.Value));
+			fragment->SetAttribute(attribute.Key, *attribute.Value);
+		}
+	}
+}
+
+FGenericPlatformSentryStaticScope::~FGenericPlatformSentryStaticScope()
+{
+	for (const TPair<FString, sentry_value_t>& context : contexts)
+	{
+		sentry_value_decref(context.Value);
+	}
+}
+
+void FGenericPlatformSentryStaticScope::SetContext(const FString& key, sentry_value_t context)
+{
+	char* json = sentry_value_to_json(context);
+	if (!json)
+	{
+		RemoveContext(key);
+		return;
+	}
+
+	sentry_value_incref(context);
+
+	{
+		FScopeLock lock(&criticalSection);
+
+		if (sentry_value_t* previous = contexts.Find(key))
+		{
+			sentry_value_decref(*previous);
+		}
+
+		contexts.Add(key, context);
+		fragment->SetContext(key, json);
+	}
+
+	sentry_string_free(json);
+}
+
+void FGenericPlatformSentryStaticScope::RemoveContext(const FString& key)
+{
+	FScopeLock lock(&criticalSection);
+
+	sentry_value_t context;
+	if (contexts.RemoveAndCopyValue(key, context))
+	{
+		sentry_value_decref(context);
+		fragment->RemoveContext(key);
+	}
+}
+
+void FGenericPlatformSentryStaticScope::SetTag(const FString& key, const FString& value)
+{
+	FScopeLock lock(&criticalSection);
+
+	tags.Add(key, GenericPlatformSentryStaticScope::ToUtf8(value));
+	fragment->SetTag(key, value);
+}
+
+void FGenericPlatformSentryStaticScope::RemoveTag(const FString& key)
+{
+	FScopeLock lock(&criticalSection);
+
+	if (tags.Remove(key) > 0)
+	{
+		fragment->RemoveTag(key);
+	}
+}
+
+void FGenericPlatformSentryStaticScope::Strip(sentry_value_t event) const
+{
+	FScopeLock lock(&criticalSection);
+
+	for (const TPair<FString, TArray<ANSICHAR>>& attribute : attributes)
+	{
+		const FTCHARToUTF8 key(*attribute.Key);
+		if (GenericPlatformSentryStaticScope::IsSameString(sentry_value_get_by_key(event, key.Get()), attribute.Value))
+		{
+			sentry_value_remove_by_key(event, key.Get());
+		}
+	}
+
+	sentry_value_t eventTags = sentry_value_get_by_key(event, "tags");
+	if (sentry_value_get_type(eventTags) == SENTRY_VALUE_TYPE_OBJECT)
+	{
+		for (const TPair<FString, TArray<ANSICHAR>>& tag : tags)
+		{
+			const FTCHARToUTF8 key(*tag.Key);
+			if (GenericPlatformSentryStaticScope::IsSameString(sentry_value_get_by_key(eventTags, key.Get()), tag.Value))
+			{
+				sentry_value_remove_by_key(eventTags, key.Get());
+			}
+		}
+	}
+
+	// Contexts are merged into events by reference, anything else than the registered value was set after it
+	sentry_value_t eventContexts = sentry_value_get_by_key(event, "contexts");
+	if (sentry_value_get_type(eventContexts) == SENTRY_VALUE_TYPE_OBJECT)
+	{
+		for (const TPair<FString, sentry_value_t>& context : contexts)
+		{
+			const FTCHARToUTF8 key(*context.Key);
+			if (sentry_value_get_by_key(eventContexts, key.Get())._bits == context.Value._bits)
+			{
+				sentry_value_remove_by_key(eventContexts, key.Get());
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "GenericPlatform/Convenience/GenericPlatformSentryInclude.h"
+
+#include "HAL/CriticalSection.h"
+
+class FSentryStaticScopeFragment;
+
+#if USE_SENTRY_NATIVE
+
+/**
+ * Global scope entries that don't change after initialization, serialized once for the batched transport.
+ *
+ * Entries are still set on the native scope so that crash reports written by the crash handler carry them. Events
+ * passing through `before_send` are stripped of the entries that still hold the very value set here, and the
+ * transport splices the pre-serialized fragment back into the outgoing envelope instead.
+ */
+class FGenericPlatformSentryStaticScope
+{
+public:
+	FGenericPlatformSentryStaticScope(const FString& release, const FString& environment, const FString& dist);
+	~FGenericPlatformSentryStaticScope();
+
+	/** Registers the context set on the native scope, a reference to it is kept to recognize it in events. */
+	void SetContext(const FString& key, sentry_value_t context);
+	void RemoveContext(const FString& key);
+
+	void SetTag(const FString& key, const FString& value);
+	void RemoveTag(const FString& key);
+
+	/** Removes the entries that still hold their static value from the event before it's serialized. */
+	void Strip(sentry_value_t event) const;
+
+	TSharedRef<FSentryStaticScopeFragment, ESPMode::ThreadSafe> GetFragment() const { return fragment; }
+
+private:
+	/** Values of the string entries as null-terminated UTF-8 to be compared with the native ones. */
+	TMap<FString, TArray<ANSICHAR>> attributes;
+	TMap<FString, TArray<ANSICHAR>> tags;
+	TMap<FString, sentry_value_t> contexts;
+
+	mutable FCriticalSection criticalSection;
+
+	TSharedRef<FSentryStaticScopeFragment, ESPMode::ThreadSafe> fragment;
+};
+
+#endif
@@ -23,3 +23,9 @@ static TSharedPtr<ISentryAttachment> CreateSharedSentryAttachment(const TArray<u
 {
 	return MakeShareable(new FPlatformSentryAttachment(Data, Filename, ContentType));
 }
+
+static TSharedPtr<ISentryAttachment> CreateSharedSentryAttachment(TArray<uint8>&& Data, const FString& Filename, const FString& ContentType)
+{
+	// Platforms handing the data over to their SDK copy it anyway, the others take it over as is
+	return MakeShareable(new FPlatformSentryAttachment(MoveTemp(Data), Filename, ContentType));
+}
@@ -5,6 +5,9 @@
 #include "SentryDefines.h"
 #include "SentrySettings.h"
 
+#include "Convenience/AppleSentryInclude.h"
+#include "Convenience/AppleSentryMacro.h"
+
 #include "Utils/SentryFileUtils.h"
 #include "Utils/SentryScreenshotUtils.h"
 
@@ -24,6 +27,91 @@
 
 #pragma pop_macro("PLATFORM_VISIONOS")
 
+#import <MetricKit/MetricKit.h>
+
+static void AddHistogramMeasurements(id<SentrySpan> transaction, NSString* name, MXHistogram<NSUnitDuration*>* histogram) API_AVAILABLE(ios(15.0))
+{
+	if (histogram == nil || histogram.totalBucketCount == 0)
+	{
+		return;
+	}
+
+	// Buckets only carry their bounds, so the midpoint stands for every sample that fell into one.
+	// `totalBucketCount` is the number of buckets, the number of samples is the sum of their counts.
+	double weightedSum = 0.0;
+	double maxValue = 0.0;
+	int64 sampleCount = 0;
+	for (MXHistogramBucket<NSUnitDuration*>* bucket in histogram.bucketEnumerator)
+	{
+		const double bucketStart = [bucket.bucketStart measurementByConvertingToUnit:NSUnitDuration.milliseconds].doubleValue;
+		const double bucketEnd = [bucket.bucketEnd measurementByConvertingToUnit:NSUnitDuration.milliseconds].doubleValue;
+
+		weightedSum += (bucketStart + bucketEnd) * 0.5 * bucket.bucketCount;
+		sampleCount += bucket.bucketCount;
+		if (bucket.bucketCount > 0)
+		{
+			maxValue = FMath::Max(maxValue, bucketEnd);
+		}
+	}
+
+	if (sampleCount == 0)
+	{
+		return;
+	}
+
+	[transaction setMeasurement:[NSString stringWithFormat:@"%@.avg", name] value:@(weightedSum / sampleCount) unit:SentryMeasurementUnitDuration.millisecond];
+	[transaction setMeasurement:[NSString stringWithFormat:@"%@.max", name] value:@(maxValue) unit:SentryMeasurementUnitDuration.millisecond];
+	[transaction setMeasurement:[NSString stringWithFormat:@"%@.count", name] value:@(sampleCount)];
+}
+
+API_AVAILABLE(ios(15.0))
+@interface SentryUnrealMetricKitSubscriber : NSObject <MXMetricManagerSubscriber>
+@end
+
+@implementation SentryUnrealMetricKitSubscriber
+
+- (void)didReceiveMetricPayloads:(NSArray<MXMetricPayload*>*)payloads
+{
+	for (MXMetricPayload* payload in payloads)
+	{
+		// Payloads arrive at most once a day, so they're always sent rather than left to the traces sample rate, which would
+		// also drop them altogether if tracing is disabled
+		SentryTransactionContext* transactionContext = [[SENTRY_APPLE_CLASS(SentryTransactionContext) alloc] initWithName:@"MetricKit payload" operation:@"app.metrickit"
+																													sampled:kSentrySampleDecisionYes
+																												 sampleRate:nil
+																												 sampleRand:nil];
+		id<SentrySpan> transaction = [SENTRY_APPLE_CLASS(SentrySDK) startTransactionWithContext:transactionContext bindToScope:NO];
+		[transactionContext release];
+
+		[transaction setDataValue:payload.latestApplicationVersion forKey:@"app_version"];
+		[transaction setDataValue:@(payload.timeStampBegin.timeIntervalSince1970) forKey:@"timestamp_begin"];
+		[transaction setDataValue:@(payload.timeStampEnd.timeIntervalSince1970) forKey:@"timestamp_end"];
+
+		if (MXAppLaunchMetric* launchMetrics = payload.applicationLaunchMetrics)
+		{
+			AddHistogramMeasurements(transaction, @"time_to_first_draw", launchMetrics.histogrammedTimeToFirstDraw);
+			AddHistogramMeasurements(transaction, @"app_resume_time", launchMetrics.histogrammedApplicationResumeTime);
+		}
+
+		if (MXAppResponsivenessMetric* responsivenessMetrics = payload.applicationResponsivenessMetrics)
+		{
+			AddHistogramMeasurements(transaction, @"hang_time", responsivenessMetrics.histogrammedApplicationHangTime);
+		}
+
+		if (MXCPUMetric* cpuMetrics = payload.cpuMetrics)
+		{
+			const double cpuTime = [cpuMetrics.cumulativeCPUTime measurementByConvertingToUnit:NSUnitDuration.milliseconds].doubleValue;
+			[transaction setMeasurement:@"cpu_time" value:@(cpuTime) unit:SentryMeasurementUnitDuration.millisecond];
+		}
+
+		[transaction finish];
+	}
+}
+
+@end
+
+static SentryUnrealMetricKitSubscriber* GMetricKitSubscriber API_AVAILABLE(ios(15.0)) = nil;
+
 static FIOSSentrySubsystem* GIOSSentrySubsystem = nullptr;
 
 struct sigaction DefaultSigIllHandler;
@@ -89,6 +177,37 @@ void FIOSSentrySubsystem::InitWithSettings(const USentrySettings* settings, USen
 	InstallSentrySignalHandler();
 
 	FAppleSentrySubsystem::InitWithSettings(settings, beforeSendHandler, beforeBreadcrumbHandler, beforeLogHandler, traceSampler);
+
+	if (settings->EnableMetricKit)
+	{
+		if (@available(iOS 15.0, *))
+		{
+			// Diagnostics are handled by the Cocoa SDK, only the daily metric payloads are subscribed to here
+			if (GMetricKitSubscriber == nil)
+			{
+				GMetricKitSubscriber = [[SentryUnrealMetricKitSubscriber alloc] init];
+				[[MXMetricManager sharedManager] addSubscriber:GMetricKitSubscriber];
+			}
+		}
+		else
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("MetricKit requires iOS 15 or newer and won't be enabled."));
+		}
+	}
+}
+
+void FIOSSentrySubsystem::Close()
+{
+	if (@available(iOS 15.0, *))
+	{
+		if (GMetricKitSubscriber != nil)
+		{
+			[[MXMetricManager sharedManager] removeSubscriber:GMetricKitSubscriber];
+			GMetricKitSubscriber = nil;
+		}
+	}
+
+	FAppleSentrySubsystem::Close();
 }
 
 void FIOSSentrySubsystem::HandleAssert()
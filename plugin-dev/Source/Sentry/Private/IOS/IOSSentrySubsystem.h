@@ -9,6 +9,8 @@ class FIOSSentrySubsystem : public FAppleSentrySubsystem
 public:
 	virtual void InitWithSettings(const USentrySettings* settings, USentryBeforeSendHandler* beforeSendHandler, USentryBeforeBreadcrumbHandler* beforeBreadcrumbHandler, USentryBeforeLogHandler* beforeLogHandler, USentryTraceSampler* traceSampler) override;
 
+	virtual void Close() override;
+
 	virtual void HandleAssert() override;
 
 	virtual FString TryCaptureScreenshot() const override;
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 
+#include "Containers/StringView.h"
+
 #include "SentryDataTypes.h"
 #include "SentryVariant.h"
 
@@ -15,6 +17,7 @@ public:
 	virtual ~ISentryEvent() = default;
 
 	virtual TSharedPtr<ISentryId> GetId() const = 0;
+	virtual void SetId(const FString& id) = 0;
 	virtual void SetMessage(const FString& message) = 0;
 	virtual FString GetMessage() const = 0;
 	virtual void SetLevel(ESentryLevel level) = 0;
@@ -39,4 +42,66 @@ public:
 	virtual TMap<FString, FSentryVariant> GetExtras() const = 0;
 	virtual bool IsCrash() const = 0;
 	virtual bool IsAnr() const = 0;
+
+	/** Copies the event so that it can be handed to another thread while the original stays accessible to the caller. */
+	virtual TSharedPtr<ISentryEvent> Clone() const = 0;
+
+	/**
+	 * Single key lookups for read-only access that avoid converting whole tags and contexts.
+	 *
+	 * UTF-8 views point into the native event where the platform allows it. Otherwise the value is converted into
+	 * a new entry of the scratch array and the view points there instead, so it's valid as long as both the event and the scratch array are.
+	 */
+	virtual bool TryGetTagUtf8(FAnsiStringView key, FAnsiStringView& value, TArray<TArray<ANSICHAR>>& scratch) const
+	{
+		FString tag;
+		if (!TryGetTag(FString(FUTF8ToTCHAR(key.GetData(), key.Len()).Get()), tag))
+		{
+			return false;
+		}
+
+		value = ConvertToScratch(tag, scratch);
+		return true;
+	}
+
+	virtual bool TryGetContextValue(const FString& key, const FString& valueKey, FSentryVariant& value) const
+	{
+		TMap<FString, FSentryVariant> context;
+		if (!TryGetContext(key, context))
+		{
+			return false;
+		}
+
+		const FSentryVariant* contextValue = context.Find(valueKey);
+		if (!contextValue)
+		{
+			return false;
+		}
+
+		value = *contextValue;
+		return true;
+	}
+
+	virtual bool TryGetContextStringUtf8(FAnsiStringView key, FAnsiStringView valueKey, FAnsiStringView& value, TArray<TArray<ANSICHAR>>& scratch) const
+	{
+		FSentryVariant contextValue;
+		if (!TryGetContextValue(FString(FUTF8ToTCHAR(key.GetData(), key.Len()).Get()), FString(FUTF8ToTCHAR(valueKey.GetData(), valueKey.Len()).Get()), contextValue) ||
+			contextValue.GetType() != ESentryVariantType::String)
+		{
+			return false;
+		}
+
+		value = ConvertToScratch(contextValue.GetValue<FString>(), scratch);
+		return true;
+	}
+
+protected:
+	static FAnsiStringView ConvertToScratch(const FString& str, TArray<TArray<ANSICHAR>>& scratch)
+	{
+		// Entries are moved on reallocation which keeps their buffers and thus the views returned earlier intact
+		const FTCHARToUTF8 converted(*str);
+		TArray<ANSICHAR>& storage = scratch.AddDefaulted_GetRef();
+		storage.Append(converted.Get(), converted.Length());
+		return FAnsiStringView(storage.GetData(), storage.Num());
+	}
 };
@@ -18,7 +18,12 @@ class ISentryTransactionContext;
 class ISentryId;
 class ISentryScope;
 
+class FSentryLogRing;
+struct FSentryDeviceConditions;
+struct FSentryHangReport;
+struct FSentryMemoryStats;
 class USentrySettings;
+class UScriptStruct;
 class USentryBeforeSendHandler;
 class USentryBeforeLogHandler;
 class USentryBeforeBreadcrumbHandler;
@@ -47,12 +52,14 @@ public:
 	virtual TSharedPtr<ISentryId> CaptureMessageWithScope(const FString& message, ESentryLevel level, const FSentryScopeDelegate& onConfigureScope) = 0;
 	virtual TSharedPtr<ISentryId> CaptureEvent(TSharedPtr<ISentryEvent> event) = 0;
 	virtual TSharedPtr<ISentryId> CaptureEventWithScope(TSharedPtr<ISentryEvent> event, const FSentryScopeDelegate& onConfigureScope) = 0;
-	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message) = 0;
+	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters) = 0;
 	virtual void CaptureFeedback(TSharedPtr<ISentryFeedback> feedback) = 0;
 	virtual void SetUser(TSharedPtr<ISentryUser> user) = 0;
 	virtual void RemoveUser() = 0;
 	virtual void SetContext(const FString& key, const TMap<FString, FSentryVariant>& values) = 0;
+	virtual void SetContextFromStruct(const FString& key, const UScriptStruct* structType, const void* structData) = 0;
 	virtual void SetTag(const FString& key, const FString& value) = 0;
+	virtual void SetTags(const TMap<FString, FString>& tags) = 0;
 	virtual void RemoveTag(const FString& key) = 0;
 	virtual void SetLevel(ESentryLevel level) = 0;
 	virtual void StartSession() = 0;
@@ -68,4 +75,24 @@ public:
 
 	/** Unreal-specific methods that are not part of the platform's Sentry SDK API */
 	virtual void HandleAssert() = 0;
+	virtual TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> GetLogRing() const = 0;
+
+	/** Captures a hang of the game thread detected by the SDK watchdog, platforms with built-in hang tracking don't use it. */
+	virtual TSharedPtr<ISentryId> CaptureAppHang(const FSentryHangReport& report) { return nullptr; }
+
+	/** Applies the sample rates changed after initialization, platforms that only read them on initialization ignore it. */
+	virtual void ApplyRuntimeSettings(const USentrySettings* settings) {}
+
+	/** Queries the thermal state, battery and clocks of the device, false on platforms that don't report them. */
+	virtual bool GetDeviceConditions(FSentryDeviceConditions& outConditions) { return false; }
+
+	/** Adds the memory held by platform-specific buffers to the stats, allocations of the platform SDK are accounted separately. */
+	virtual void AddMemoryStats(FSentryMemoryStats& outStats) const {}
+
+	/** Hands an envelope built by the plugin over to the transport of the platform SDK, false if the platform can't take it. */
+	virtual bool CaptureEnvelope(const TArray<uint8>& envelope) { return false; }
+
+	/** Sets a context or tag that doesn't change after initialization, platforms that don't serialize those once treat it like any other. */
+	virtual void SetStaticContext(const FString& key, const TMap<FString, FSentryVariant>& values) { SetContext(key, values); }
+	virtual void SetStaticTag(const FString& key, const FString& value) { SetTag(key, value); }
 };
\ No newline at end of file
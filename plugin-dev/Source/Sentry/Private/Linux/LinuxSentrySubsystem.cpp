@@ -7,16 +7,74 @@
 #include "SentryDefines.h"
 #include "SentrySettings.h"
 
+#include "Utils/SentryDsn.h"
+
 #include "GenericPlatform/GenericPlatformOutputDevices.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
 #include "Misc/Paths.h"
 
 #if USE_SENTRY_NATIVE
 
+namespace LinuxSentrySubsystem
+{
+	/** Looks up CA certificates in the known locations, null if there are none. */
+	static const char* FindCertsPath()
+	{
+		// In order to use CURL transport for sentry-native we have to manually specify path to a valid CA certificates on Linux.
+		// Unreal Engine itself follows a similar approach (see `CertBundlePath` implementation in CurlHttp.cpp for extra details)
+		static const char* KnownCertPaths[] = {
+			"/etc/pki/tls/certs/ca-bundle.crt",
+			"/etc/ssl/certs/ca-certificates.crt",
+			"/etc/ssl/ca-bundle.pem"
+		};
+
+		for (const char* BundlePath : KnownCertPaths)
+		{
+			if (FPaths::FileExists(FString(BundlePath)))
+			{
+				return BundlePath;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Sends a request to the ingest endpoint so that the TLS connection it opens is kept alive by the engine's HTTP connection pool
+	 * and the first envelope doesn't wait for the DNS lookup and the handshake.
+	 */
+	static void WarmUpTransport(const FString& EndpointUrl)
+	{
+		// Response doesn't matter, the request is only sent to get the TLS handshake done
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+		Request->SetURL(EndpointUrl);
+		Request->SetVerb(TEXT("HEAD"));
+		Request->OnProcessRequestComplete().BindLambda([](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+		{
+			UE_LOG(LogSentrySdk, Verbose, TEXT("Sentry transport warm-up %s."), bSucceeded && Response.IsValid() ? TEXT("completed") : TEXT("failed"));
+		});
+		Request->ProcessRequest();
+	}
+}
+
 void FLinuxSentrySubsystem::InitWithSettings(const USentrySettings* Settings, USentryBeforeSendHandler* BeforeSendHandler, USentryBeforeBreadcrumbHandler* BeforeBreadcrumbHandler, USentryBeforeLogHandler* BeforeLogHandler, USentryTraceSampler* TraceSampler)
 {
 	FGenericPlatformSentrySubsystem::InitWithSettings(Settings, BeforeSendHandler, BeforeBreadcrumbHandler, BeforeLogHandler, TraceSampler);
 
 	InitCrashReporter(Settings->GetEffectiveRelease(), Settings->GetEffectiveEnvironment());
+
+	// Connection of the sentry-native transport can't be reached and a lookup alone isn't cached without a caching resolver
+	if (IsEnabled() && IsBatchedTransportEnabled() && Settings->WarmUpTransportConnection)
+	{
+		FString EndpointUrl;
+		FString PublicKey;
+		if (SentryDsn::Parse(Settings->GetEffectiveDsn(), EndpointUrl, PublicKey))
+		{
+			LinuxSentrySubsystem::WarmUpTransport(EndpointUrl);
+		}
+	}
 }
 
 void FLinuxSentrySubsystem::ConfigureHandlerPath(sentry_options_t* Options)
@@ -31,24 +89,14 @@ void FLinuxSentrySubsystem::ConfigureDatabasePath(sentry_options_t* Options)
 
 void FLinuxSentrySubsystem::ConfigureCertsPath(sentry_options_t* Options)
 {
-	// In order to use CURL transport for sentry-native we have to manually specify path to a valid CA certificates on Linux.
-	// Unreal Engine itself follows a similar approach (see `CertBundlePath` implementation in CurlHttp.cpp for extra details)
-	static const char* KnownCertPaths[] = {
-		"/etc/pki/tls/certs/ca-bundle.crt",
-		"/etc/ssl/certs/ca-certificates.crt",
-		"/etc/ssl/ca-bundle.pem"
-	};
-
-	for (const char* BundlePath : KnownCertPaths)
-	{
-		FString FileName(BundlePath);
+	// Bundle doesn't move while the game is running, so the known locations are only probed on the first initialization
+	static const char* CertsPath = LinuxSentrySubsystem::FindCertsPath();
 
-		if (FPaths::FileExists(FileName))
-		{
-			UE_LOG(LogSentrySdk, Log, TEXT("Sentry transport will use the certificate found at %s for verification."), *FileName);
-			sentry_options_set_ca_certs(Options, BundlePath);
-			return;
-		}
+	if (CertsPath)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Sentry transport will use the certificate found at %s for verification."), UTF8_TO_TCHAR(CertsPath));
+		sentry_options_set_ca_certs(Options, CertsPath);
+		return;
 	}
 
 	UE_LOG(LogSentrySdk, Warning, TEXT("Could not find CA certificates in any known location. Sentry transport may not function properly for handled events"));
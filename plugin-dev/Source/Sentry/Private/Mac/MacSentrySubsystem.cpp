@@ -38,9 +38,9 @@ void FMacSentrySubsystem::Close()
 	FAppleSentrySubsystem::Close();
 }
 
-TSharedPtr<ISentryId> FMacSentrySubsystem::CaptureEnsure(const FString& type, const FString& message)
+TSharedPtr<ISentryId> FMacSentrySubsystem::CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters)
 {
-	TSharedPtr<ISentryId> id = FAppleSentrySubsystem::CaptureEnsure(type, message);
+	TSharedPtr<ISentryId> id = FAppleSentrySubsystem::CaptureEnsure(type, message, programCounters);
 
 	if (isScreenshotAttachmentEnabled)
 	{
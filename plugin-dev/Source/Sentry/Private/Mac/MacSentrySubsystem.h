@@ -10,7 +10,7 @@ public:
 	virtual void InitWithSettings(const USentrySettings* settings, USentryBeforeSendHandler* beforeSendHandler, USentryBeforeBreadcrumbHandler* beforeBreadcrumbHandler, USentryBeforeLogHandler* beforeLogHandler, USentryTraceSampler* traceSampler) override;
 	virtual void Close() override;
 
-	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message) override;
+	virtual TSharedPtr<ISentryId> CaptureEnsure(const FString& type, const FString& message, const TArray<uint64>& programCounters) override;
 
 	virtual FString TryCaptureScreenshot() const override;
 
@@ -10,6 +10,7 @@ public:
 	virtual ~FNullSentryEvent() override = default;
 
 	virtual TSharedPtr<ISentryId> GetId() const override { return nullptr; }
+	virtual void SetId(const FString& id) override {}
 	virtual void SetMessage(const FString& message) override {}
 	virtual FString GetMessage() const override { return TEXT(""); }
 	virtual void SetLevel(ESentryLevel level) override {}
@@ -34,6 +35,7 @@ public:
 	virtual TMap<FString, FSentryVariant> GetExtras() const override { return TMap<FString, FSentryVariant>(); }
 	virtual bool IsCrash() const override { return false; }
 	virtual bool IsAnr() const override { return false; }
+	virtual TSharedPtr<ISentryEvent> Clone() const override { return MakeShareable(new FNullSentryEvent()); }
 };
 
 typedef FNullSentryEvent FPlatformSentryEvent;
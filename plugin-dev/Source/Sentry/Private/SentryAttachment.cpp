@@ -4,11 +4,116 @@
 
 #include "HAL/PlatformSentryAttachment.h"
 
+#include "SentryDefines.h"
+
+#include "Utils/SentryTrace.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+namespace SentryAttachmentStreaming
+{
+	static constexpr int64 ChunkSize = 64 * 1024;
+
+	static FString GetStreamedFilesDirectory()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryAttachments"), TEXT("Streamed"));
+	}
+}
+
 void USentryAttachment::InitializeWithData(const TArray<uint8>& Data, const FString& Filename, const FString& ContentType /* = FString(TEXT("application/octet-stream")) */)
 {
+	TRACE_COUNTER_ADD(SentryBytesAttached, Data.Num());
+
 	NativeImpl = CreateSharedSentryAttachment(Data, Filename, ContentType);
 }
 
+void USentryAttachment::InitializeWithData(TArray<uint8>&& Data, const FString& Filename, const FString& ContentType /* = FString(TEXT("application/octet-stream")) */)
+{
+	TRACE_COUNTER_ADD(SentryBytesAttached, Data.Num());
+
+	NativeImpl = CreateSharedSentryAttachment(MoveTemp(Data), Filename, ContentType);
+}
+
+bool USentryAttachment::InitializeWithReader(const FSentryAttachmentReader& Reader, const FString& Filename, const FString& ContentType /* = FString(TEXT("application/octet-stream")) */)
+{
+	const FString StreamedFilePath = FPaths::Combine(SentryAttachmentStreaming::GetStreamedFilesDirectory(),
+		FString::Printf(TEXT("%s-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits), *FPaths::GetCleanFilename(Filename)));
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*StreamedFilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to create a temporary file for attachment %s."), *Filename);
+		return false;
+	}
+
+	// Data only passes through a small chunk buffer on its way to the file
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(SentryAttachmentStreaming::ChunkSize);
+
+	int64 TotalSize = 0;
+	bool bIsReadFailed = false;
+
+	while (true)
+	{
+		const int64 NumRead = Reader(Chunk.GetData(), Chunk.Num());
+		if (NumRead <= 0)
+		{
+			bIsReadFailed = NumRead < 0;
+			break;
+		}
+
+		const int64 NumToWrite = FMath::Min<int64>(NumRead, Chunk.Num());
+		Writer->Serialize(Chunk.GetData(), NumToWrite);
+		TotalSize += NumToWrite;
+	}
+
+	const bool bIsWriteFailed = !Writer->Close();
+	Writer.Reset();
+
+	if (bIsReadFailed || bIsWriteFailed)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to stream attachment %s to a temporary file."), *Filename);
+		IFileManager::Get().Delete(*StreamedFilePath);
+		return false;
+	}
+
+	TRACE_COUNTER_ADD(SentryBytesAttached, TotalSize);
+
+	// Temporary file goes away with the last reference to the attachment, the subsystem keeps the ones added to the global scope
+	NativeImpl = MakeShareable(new FPlatformSentryAttachment(StreamedFilePath, Filename, ContentType), [StreamedFilePath](FPlatformSentryAttachment* Attachment)
+	{
+		delete Attachment;
+		IFileManager::Get().Delete(*StreamedFilePath, false, false, true);
+	});
+	return true;
+}
+
+bool USentryAttachment::IsStreamed() const
+{
+	return NativeImpl && FPaths::IsUnderDirectory(NativeImpl->GetPath(), SentryAttachmentStreaming::GetStreamedFilesDirectory());
+}
+
+void USentryAttachment::CleanupStreamedFiles()
+{
+	// Streamed files can be created before the SDK is initialized so only the ones older than this process are removed
+	const FDateTime ProcessStartTime = FDateTime::UtcNow() - FTimespan::FromSeconds(FPlatformTime::Seconds() - GStartTime);
+
+	TArray<FString> StreamedFiles;
+	IFileManager::Get().FindFiles(StreamedFiles, *FPaths::Combine(SentryAttachmentStreaming::GetStreamedFilesDirectory(), TEXT("*")), true, false);
+
+	for (const FString& StreamedFile : StreamedFiles)
+	{
+		const FString StreamedFilePath = FPaths::Combine(SentryAttachmentStreaming::GetStreamedFilesDirectory(), StreamedFile);
+		if (IFileManager::Get().GetTimeStamp(*StreamedFilePath) < ProcessStartTime)
+		{
+			IFileManager::Get().Delete(*StreamedFilePath);
+		}
+	}
+}
+
 void USentryAttachment::InitializeWithPath(const FString& Path, const FString& Filename, const FString& ContentType /* = FString(TEXT("application/octet-stream")) */)
 {
 	NativeImpl = CreateSharedSentryAttachment(Path, Filename, ContentType);
@@ -0,0 +1,15 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCrashMemory.h"
+
+#include "Utils/SentryCrashMemoryRegions.h"
+
+int32 SentryCrashMemory::RegisterRegion(const FString& Name, const void* Address, int32 Size)
+{
+	return FSentryCrashMemoryRegions::Get().Register(Name, Address, Size);
+}
+
+void SentryCrashMemory::UnregisterRegion(int32 Handle)
+{
+	FSentryCrashMemoryRegions::Get().Unregister(Handle);
+}
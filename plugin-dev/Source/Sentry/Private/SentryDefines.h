@@ -1,7 +0,0 @@
-// Copyright (c) 2025 Sentry. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-
-DECLARE_LOG_CATEGORY_EXTERN(LogSentrySdk, Verbose, All);
@@ -2,6 +2,8 @@
 
 #include "SentryErrorOutputDevice.h"
 
+#include "SentryDefines.h"
+
 #include "Misc/AssertionMacros.h"
 
 FSentryErrorOutputDevice::FSentryErrorOutputDevice(FOutputDeviceError* Parent)
@@ -11,6 +13,8 @@ FSentryErrorOutputDevice::FSentryErrorOutputDevice(FOutputDeviceError* Parent)
 
 void FSentryErrorOutputDevice::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category)
 {
+	LLM_SCOPE_BYTAG(Sentry);
+
 	if (FDebug::HasAsserted())
 	{
 		OnAssert.Broadcast(V);
@@ -142,6 +142,14 @@ bool USentryEvent::TryGetContext(const FString& Key, TMap<FString, FSentryVarian
 	return NativeImpl->TryGetContext(Key, Value);
 }
 
+bool USentryEvent::TryGetContextValue(const FString& Key, const FString& ValueKey, FSentryVariant& Value) const
+{
+	if (!NativeImpl)
+		return false;
+
+	return NativeImpl->TryGetContextValue(Key, ValueKey, Value);
+}
+
 void USentryEvent::RemoveContext(const FString& Key)
 {
 	if (!NativeImpl)
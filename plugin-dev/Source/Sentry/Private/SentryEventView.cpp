@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryEventView.h"
+
+#include "Interface/SentryEventInterface.h"
+#include "Interface/SentryIdInterface.h"
+
+FString FSentryEventView::GetId() const
+{
+	TSharedPtr<ISentryId> Id = Event.GetId();
+	return Id ? Id->ToString() : FString();
+}
+
+FString FSentryEventView::GetMessage() const
+{
+	return Event.GetMessage();
+}
+
+ESentryLevel FSentryEventView::GetLevel() const
+{
+	return Event.GetLevel();
+}
+
+void FSentryEventView::SetLevel(ESentryLevel Level)
+{
+	Event.SetLevel(Level);
+}
+
+bool FSentryEventView::TryGetTag(const FString& Key, FString& Value) const
+{
+	return Event.TryGetTag(Key, Value);
+}
+
+bool FSentryEventView::TryGetTagUtf8(FAnsiStringView Key, FAnsiStringView& Value) const
+{
+	return Event.TryGetTagUtf8(Key, Value, Scratch);
+}
+
+bool FSentryEventView::TryGetContextValue(const FString& Key, const FString& ValueKey, FSentryVariant& Value) const
+{
+	return Event.TryGetContextValue(Key, ValueKey, Value);
+}
+
+bool FSentryEventView::TryGetContextStringUtf8(FAnsiStringView Key, FAnsiStringView ValueKey, FAnsiStringView& Value) const
+{
+	return Event.TryGetContextStringUtf8(Key, ValueKey, Value, Scratch);
+}
+
+void FSentryEventView::SetTag(const FString& Key, const FString& Value)
+{
+	Event.SetTag(Key, Value);
+}
+
+void FSentryEventView::RemoveTag(const FString& Key)
+{
+	Event.RemoveTag(Key);
+}
+
+void FSentryEventView::SetFingerprint(const TArray<FString>& Fingerprint)
+{
+	Event.SetFingerprint(Fingerprint);
+}
+
+bool FSentryEventView::IsCrash() const
+{
+	return Event.IsCrash();
+}
+
+bool FSentryEventView::IsAnr() const
+{
+	return Event.IsAnr();
+}
@@ -0,0 +1,10 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryGpuMarkers.h"
+
+#include "Utils/SentryGpuBreadcrumbs.h"
+
+void SentryGpuMarkers::Add(FRHICommandListImmediate& RHICmdList, FName Name)
+{
+	FSentryGpuBreadcrumbs::Get().AddMarker(RHICmdList, Name);
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryInitProfile.h"
+
+#include "HAL/PlatformTime.h"
+
+static thread_local FSentryInitProfile* CurrentInitProfile = nullptr;
+
+void FSentryInitProfile::Reset()
+{
+	Phases.Reset();
+}
+
+void FSentryInitProfile::AddPhase(const FString& Name, double StartTime, double EndTime)
+{
+	int32 Index = Phases.Num();
+	while (Index > 0 && Phases[Index - 1].StartTime > StartTime)
+	{
+		--Index;
+	}
+
+	Phases.Insert(FSentryInitPhase(Name, StartTime, EndTime), Index);
+}
+
+const TArray<FSentryInitPhase>& FSentryInitProfile::GetPhases() const
+{
+	return Phases;
+}
+
+double FSentryInitProfile::GetTotalDurationMs() const
+{
+	// Nested phases and gaps between phases are not counted, phases are already ordered by their start time
+	double TotalSeconds = 0.0;
+	double CoveredUntil = 0.0;
+
+	for (const FSentryInitPhase& Phase : Phases)
+	{
+		const double StartTime = FMath::Max(Phase.StartTime, CoveredUntil);
+		if (Phase.EndTime > StartTime)
+		{
+			TotalSeconds += Phase.EndTime - StartTime;
+			CoveredUntil = Phase.EndTime;
+		}
+	}
+
+	return TotalSeconds * 1000.0;
+}
+
+FSentryInitProfile* FSentryInitProfile::GetCurrent()
+{
+	return CurrentInitProfile;
+}
+
+void FSentryInitProfile::RecordPhase(const FString& Name, double StartTime, double EndTime)
+{
+	if (CurrentInitProfile)
+	{
+		CurrentInitProfile->AddPhase(Name, StartTime, EndTime);
+	}
+}
+
+FSentryInitProfile::FScopedCurrent::FScopedCurrent(FSentryInitProfile* Profile)
+	: PreviousProfile(CurrentInitProfile)
+{
+	CurrentInitProfile = Profile;
+}
+
+FSentryInitProfile::FScopedCurrent::~FScopedCurrent()
+{
+	CurrentInitProfile = PreviousProfile;
+}
+
+FSentryInitPhaseScope::FSentryInitPhaseScope(const TCHAR* InName)
+	: Name(InName)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FSentryInitPhaseScope::~FSentryInitPhaseScope()
+{
+	FSentryInitProfile::RecordPhase(Name, StartTime, FPlatformTime::Seconds());
+}
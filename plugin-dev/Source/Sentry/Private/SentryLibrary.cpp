@@ -79,6 +79,11 @@ USentryAttachment* USentryLibrary::CreateSentryAttachmentWithData(const TArray<u
 	return USentryAttachment::Create(CreateSharedSentryAttachment(Data, Filename, ContentType));
 }
 
+USentryAttachment* USentryLibrary::CreateSentryAttachmentWithData(TArray<uint8>&& Data, const FString& Filename, const FString& ContentType)
+{
+	return USentryAttachment::Create(CreateSharedSentryAttachment(MoveTemp(Data), Filename, ContentType));
+}
+
 USentryAttachment* USentryLibrary::CreateSentryAttachmentWithPath(const FString& Path, const FString& Filename, const FString& ContentType)
 {
 	return USentryAttachment::Create(CreateSharedSentryAttachment(Path, Filename, ContentType));
@@ -1,14 +1,21 @@
 // Copyright (c) 2025 Sentry. All Rights Reserved.
 
 #include "SentryModule.h"
+#include "SentryCrashVideoCapture.h"
 #include "SentryDefines.h"
 #include "SentrySettings.h"
 
+#include "Utils/SentryFileIoPlatformFile.h"
+#include "Utils/SentryStructLayout.h"
+
 #include "Developer/Settings/Public/ISettingsModule.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
 #include "Modules/ModuleManager.h"
+#include "Templates/Atomic.h"
 #include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -16,22 +23,38 @@
 
 const FName FSentryModule::ModuleName = "Sentry";
 
+namespace SentryModule
+{
+	// Read by the crash handler, so it's kept outside of the module manager
+	static TAtomic<ISentryCrashVideoCapture*> CrashVideoCapture(nullptr);
+}
+
 void FSentryModule::StartupModule()
 {
+	LLM_SCOPE_BYTAG(Sentry);
+
+	StartupTime = FPlatformTime::Seconds();
+
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-	SentrySettings = NewObject<USentrySettings>(GetTransientPackage(), "SentrySettings", RF_Standalone);
-	SentrySettings->AddToRoot();
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SentryInit_LoadSettings);
 
-#if PLATFORM_MAC
-	// Load Sentry Cocoa dynamic library
-	FString LibraryPath = FPaths::Combine(GetBinariesPath(), TEXT("sentry.dylib"));
-	mDllHandleSentry = FPlatformProcess::GetDllHandle(*LibraryPath);
+		SettingsLoadPhase.Name = TEXT("LoadSettings");
+		SettingsLoadPhase.StartTime = FPlatformTime::Seconds();
 
-	if (!mDllHandleSentry)
+		SentrySettings = NewObject<USentrySettings>(GetTransientPackage(), "SentrySettings", RF_Standalone);
+		SentrySettings->AddToRoot();
+
+		SettingsLoadPhase.EndTime = FPlatformTime::Seconds();
+	}
+
+	// Layer has to be in place before gameplay opens files, reporting starts once Sentry is initialized
+	if (SentrySettings->EnableSyncFileIoTracking && !GIsEditor)
 	{
-		UE_LOG(LogSentrySdk, Error, TEXT("Failed to load sentry.dylib from %s"), *LibraryPath);
+		FSentryFileIoPlatformFile::Register();
 	}
-#endif
+
+	FSentryStructLayout::BindCacheInvalidation();
 
 	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
 	{
@@ -49,10 +72,9 @@ void FSentryModule::ShutdownModule()
 
 #if PLATFORM_MAC
 	// Free sentry dynamic library
-	if (mDllHandleSentry)
+	if (void* DllHandle = mDllHandleSentry.Exchange(nullptr))
 	{
-		FPlatformProcess::FreeDllHandle(mDllHandleSentry);
-		mDllHandleSentry = nullptr;
+		FPlatformProcess::FreeDllHandle(DllHandle);
 	}
 #endif
 
@@ -61,6 +83,9 @@ void FSentryModule::ShutdownModule()
 		SettingsModule->UnregisterSettings("Project", "Plugins", "Sentry");
 	}
 
+	FSentryFileIoPlatformFile::Unregister();
+	FSentryStructLayout::UnbindCacheInvalidation();
+
 	if (!GExitPurge)
 	{
 		// If we're in exit purge, this object has already been destroyed
@@ -87,6 +112,26 @@ USentrySettings* FSentryModule::GetSettings() const
 	return SentrySettings;
 }
 
+const FSentryInitPhase& FSentryModule::GetSettingsLoadPhase() const
+{
+	return SettingsLoadPhase;
+}
+
+double FSentryModule::GetStartupTime() const
+{
+	return StartupTime;
+}
+
+void FSentryModule::SetCrashVideoCapture(ISentryCrashVideoCapture* InCrashVideoCapture)
+{
+	SentryModule::CrashVideoCapture = InCrashVideoCapture;
+}
+
+ISentryCrashVideoCapture* FSentryModule::GetCrashVideoCapture()
+{
+	return SentryModule::CrashVideoCapture;
+}
+
 FString FSentryModule::GetBinariesPath()
 {
 	const FString PluginDir = IPluginManager::Get().FindPlugin(TEXT("Sentry"))->GetBaseDir();
@@ -129,6 +174,41 @@ bool FSentryModule::IsMarketplaceVersion()
 
 #if PLATFORM_MAC
 
+bool FSentryModule::LoadSentryLib()
+{
+	if (mDllHandleSentry)
+	{
+		return true;
+	}
+
+	// Wrappers can be created on any thread, the first one to need the library loads it
+	FScopeLock Lock(&SentryLibCriticalSection);
+
+	if (mDllHandleSentry)
+	{
+		return true;
+	}
+
+	if (bHasSentryLibFailedToLoad)
+	{
+		return false;
+	}
+
+	// Loading registers all of the Cocoa SDK classes with the Objective-C runtime, so it's put off until the SDK is first used
+	FString LibraryPath = FPaths::Combine(GetBinariesPath(), TEXT("sentry.dylib"));
+	void* DllHandle = FPlatformProcess::GetDllHandle(*LibraryPath);
+
+	if (!DllHandle)
+	{
+		bHasSentryLibFailedToLoad = true;
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to load sentry.dylib from %s"), *LibraryPath);
+		return false;
+	}
+
+	mDllHandleSentry = DllHandle;
+	return true;
+}
+
 void* FSentryModule::GetSentryLibHandle() const
 {
 	return mDllHandleSentry;
@@ -136,6 +216,12 @@ void* FSentryModule::GetSentryLibHandle() const
 
 Class FSentryModule::GetSentryCocoaClass(const ANSICHAR* ClassName)
 {
+	// Wrappers created before Sentry is initialized (or without a DSN) need the classes too, so the library is loaded on first use
+	if (!LoadSentryLib())
+	{
+		return nil;
+	}
+
 	ANSICHAR ClassNamePattern[256];
 	FCStringAnsi::Snprintf(ClassNamePattern, sizeof(ClassNamePattern), "OBJC_CLASS_$_%s", ClassName);
 	Class FoundClass = (__bridge Class)dlsym(GetSentryLibHandle(), ClassNamePattern);
@@ -159,3 +245,5 @@ Class FSentryModule::GetSentryCocoaClass(const ANSICHAR* ClassName)
 IMPLEMENT_MODULE(FSentryModule, Sentry)
 
 DEFINE_LOG_CATEGORY(LogSentrySdk);
+
+LLM_DEFINE_TAG(Sentry);
@@ -2,83 +2,218 @@
 
 #include "SentryOutputDevice.h"
 
+#include "SentryDefines.h"
+
+#include "SentryBreadcrumbMacros.h"
 #include "SentryModule.h"
 #include "SentrySettings.h"
 #include "SentrySubsystem.h"
 
-#include "Engine/Engine.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Utils/SentryLogCategoryFilter.h"
+#include "Utils/SentryLogLimiter.h"
+#include "Utils/SentryLogQueue.h"
+#include "Utils/SentryLogRing.h"
 #include "Utils/SentryLogUtils.h"
+#include "Utils/SentryStats.h"
+#include "Utils/SentryThreadUtils.h"
+#include "Utils/SentryTrace.h"
 
-FSentryOutputDevice::FSentryOutputDevice()
+FSentryOutputDevice::FSentryOutputDevice(TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> InLogRing)
+	: BreadcrumbLevelMask(0)
+	, StructuredLoggingLevelMask(0)
+	, StructuredLoggingCategories(nullptr)
+	, LogRing(InLogRing)
 {
 	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
 
-	BreadcrumbFlags.Add(ESentryLevel::Fatal, Settings->AutomaticBreadcrumbsForLogs.bOnFatalLog);
-	BreadcrumbFlags.Add(ESentryLevel::Error, Settings->AutomaticBreadcrumbsForLogs.bOnErrorLog);
-	BreadcrumbFlags.Add(ESentryLevel::Warning, Settings->AutomaticBreadcrumbsForLogs.bOnWarningLog);
-	BreadcrumbFlags.Add(ESentryLevel::Info, Settings->AutomaticBreadcrumbsForLogs.bOnInfoLog);
-	BreadcrumbFlags.Add(ESentryLevel::Debug, Settings->AutomaticBreadcrumbsForLogs.bOnDebugLog);
-
-	StructuredLoggingFlags.Add(ESentryLevel::Fatal, Settings->StructuredLoggingLevels.bOnFatalLog);
-	StructuredLoggingFlags.Add(ESentryLevel::Error, Settings->StructuredLoggingLevels.bOnErrorLog);
-	StructuredLoggingFlags.Add(ESentryLevel::Warning, Settings->StructuredLoggingLevels.bOnWarningLog);
-	StructuredLoggingFlags.Add(ESentryLevel::Info, Settings->StructuredLoggingLevels.bOnInfoLog);
-	StructuredLoggingFlags.Add(ESentryLevel::Debug, Settings->StructuredLoggingLevels.bOnDebugLog);
-
 	bIsStructuredLoggingEnabled = Settings->EnableStructuredLogging;
-	StructuredLoggingCategories = Settings->StructuredLoggingCategories;
 	bSendBreadcrumbsWithStructuredLogging = Settings->bSendBreadcrumbsWithStructuredLogging;
+
+	ApplySettings(Settings);
+
+	// Limiter is only kept if it limits anything so that unlimited lines skip its lock
+	LogLimiter = MakeUnique<FSentryLogLimiter>(Settings->LogRateLimit, Settings->LogRateLimitBurst, Settings->RepeatedLogsWindow);
+	if (!LogLimiter->IsEnabled())
+	{
+		LogLimiter.Reset();
+	}
+
+	if (bIsStructuredLoggingEnabled && Settings->bAsyncStructuredLogging && FPlatformProcess::SupportsMultithreading())
+	{
+		FSentryLogBatchLimits BatchLimits;
+		BatchLimits.MaxItems = Settings->LogBatchMaxItems;
+		BatchLimits.MaxBytes = Settings->LogBatchMaxBytes;
+		BatchLimits.FlushIntervalMs = static_cast<uint32>(FMath::Max(1, Settings->LogFlushIntervalMs));
+
+		LogQueue = MakeUnique<FSentryLogQueue>(Settings->StructuredLoggingQueueCapacity, [](const FString& Message, ESentryLevel Level, const FString& Category)
+		{
+			USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+			if (SentrySubsystem && USentrySubsystem::IsEnabledFast())
+			{
+				ForwardToStructuredLogging(SentrySubsystem, Message, Level, Category);
+			}
+		}, BatchLimits, SentryThreadUtils::ToThreadPriority(Settings->BackgroundThreadPriority), SentryThreadUtils::ToAffinityMask(Settings->BackgroundThreadAffinityMask));
+	}
+	else if (bIsStructuredLoggingEnabled)
+	{
+		const FSentryLogBatchLimits DefaultLimits;
+		if (Settings->LogBatchMaxItems != DefaultLimits.MaxItems || Settings->LogBatchMaxBytes != DefaultLimits.MaxBytes || Settings->LogFlushIntervalMs != static_cast<int32>(DefaultLimits.FlushIntervalMs))
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Log batch settings are ignored since structured logs are forwarded synchronously (bAsyncStructuredLogging is off or the platform doesn't support multithreading)."));
+		}
+	}
+}
+
+FSentryOutputDevice::~FSentryOutputDevice()
+{
+	// Stops the consumer thread and forwards the remaining logs while the subsystem is still alive
+	LogQueue.Reset();
+}
+
+void FSentryOutputDevice::ApplySettings(const USentrySettings* Settings)
+{
+	const auto MakeLevelMask = [](const auto& Levels)
+	{
+		uint8 Mask = 0;
+		Mask |= Levels.bOnFatalLog ? GetLevelBit(ESentryLevel::Fatal) : 0;
+		Mask |= Levels.bOnErrorLog ? GetLevelBit(ESentryLevel::Error) : 0;
+		Mask |= Levels.bOnWarningLog ? GetLevelBit(ESentryLevel::Warning) : 0;
+		Mask |= Levels.bOnInfoLog ? GetLevelBit(ESentryLevel::Info) : 0;
+		Mask |= Levels.bOnDebugLog ? GetLevelBit(ESentryLevel::Debug) : 0;
+		return Mask;
+	};
+
+	// Levels below the min breadcrumb level are dropped here already instead of after the message was converted
+	BreadcrumbLevelMask = static_cast<uint8>(MakeLevelMask(Settings->AutomaticBreadcrumbsForLogs) & SentryBreadcrumbs::EnabledLevelMask);
+	StructuredLoggingLevelMask = MakeLevelMask(Settings->StructuredLoggingLevels);
+
+	FScopeLock Lock(&CategoryFiltersCriticalSection);
+
+	CategoryFilters.Add(MakeUnique<FSentryLogCategoryFilter>(Settings->StructuredLoggingCategories));
+	StructuredLoggingCategories = CategoryFilters.Last().Get();
 }
 
 void FSentryOutputDevice::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category)
 {
-	const FString Message = FString(V).TrimStartAndEnd();
-	if (Message.IsEmpty() || Message.Contains(TEXT("[Callstack]")))
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_TRACE_SCOPE(OutputDeviceSerialize);
+	SENTRY_STAT_SCOPE(Logs);
+
+	if (LogRing && V)
+	{
+		AppendToLogRing(V, static_cast<ELogVerbosity::Type>(Verbosity & ELogVerbosity::VerbosityMask), Category);
+	}
+
+	// Filtering runs on the raw input first so that dropped lines cost neither allocations nor subsystem lookups
+	const ESentryLevel Level = SentryLogUtils::ConvertLogVerbosityToSentryLevel(static_cast<ELogVerbosity::Type>(Verbosity & ELogVerbosity::VerbosityMask));
+
+	bool bForwardToStructuredLogging = bIsStructuredLoggingEnabled && ShouldForwardToStructuredLogging(Category, Level);
+	const bool bAddBreadcrumb = (BreadcrumbLevelMask.Load() & GetLevelBit(Level)) && (!bForwardToStructuredLogging || bSendBreadcrumbsWithStructuredLogging);
+
+	if (!bForwardToStructuredLogging && !bAddBreadcrumb)
 	{
 		return;
 	}
 
-	ESentryLevel Level = SentryLogUtils::ConvertLogVerbosityToSentryLevel(Verbosity);
-	const FString CategoryString = Category.ToString();
+	if (!V)
+	{
+		return;
+	}
 
-	USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
-	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+	while (FChar::IsWhitespace(*V))
+	{
+		++V;
+	}
+
+	if (*V == TEXT('\0') || FCString::Strstr(V, TEXT("[Callstack]")))
 	{
 		return;
 	}
 
-	if (bIsStructuredLoggingEnabled && ShouldForwardToStructuredLogging(CategoryString, Level))
+	FString LimiterNotice;
+	if (LogLimiter && !LogLimiter->ShouldForward(V, Category, LimiterNotice))
 	{
-		// Use level-specific logging methods
-		switch (Level)
-		{
-		case ESentryLevel::Info:
-			SentrySubsystem->LogInfo(Message, CategoryString);
-			break;
-		case ESentryLevel::Warning:
-			SentrySubsystem->LogWarning(Message, CategoryString);
-			break;
-		case ESentryLevel::Error:
-			SentrySubsystem->LogError(Message, CategoryString);
-			break;
-		case ESentryLevel::Fatal:
-			SentrySubsystem->LogFatal(Message, CategoryString);
-			break;
-		case ESentryLevel::Debug:
-		default:
-			SentrySubsystem->LogDebug(Message, CategoryString);
-			break;
-		}
+		return;
+	}
 
-		// If we don't want to also send breadcrumbs when structured logging is enabled, return early
-		if (!bSendBreadcrumbsWithStructuredLogging)
+	if (!LimiterNotice.IsEmpty())
+	{
+		ForwardLine(*LimiterNotice, Level, Category, bForwardToStructuredLogging, bAddBreadcrumb);
+	}
+
+	ForwardLine(V, Level, Category, bForwardToStructuredLogging, bAddBreadcrumb);
+}
+
+void FSentryOutputDevice::AppendToLogRing(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	// Line is formatted on the stack as this runs for every log line, overly long lines are truncated
+	ANSICHAR Line[MaxLogRingLineSize];
+	const int32 MaxLength = MaxLogRingLineSize - 1;
+
+	int32 Length = FCStringAnsi::Snprintf(Line, MaxLength, "[%.3f]", FPlatformTime::Seconds() - GStartTime);
+	Length = FMath::Clamp(Length, 0, MaxLength);
+
+	const auto AppendString = [&Line, &Length, MaxLength](const TCHAR* Str)
+	{
+		Length += FSentryLogRing::ConvertToUTF8(Str, Line + Length, MaxLength - Length);
+	};
+
+	TCHAR CategoryName[NAME_SIZE];
+	Category.ToString(CategoryName, NAME_SIZE);
+
+	AppendString(CategoryName);
+	AppendString(TEXT(": "));
+
+	// Same as in the log file, the default verbosity isn't spelled out
+	if (Verbosity != ELogVerbosity::Log)
+	{
+		AppendString(ToString(Verbosity));
+		AppendString(TEXT(": "));
+	}
+
+	AppendString(V);
+
+	Line[Length++] = '\n';
+
+	LogRing->Append(Line, Length);
+}
+
+void FSentryOutputDevice::ForwardLine(const TCHAR* V, ESentryLevel Level, const FName& Category, bool bForwardToStructuredLogging, bool bAddBreadcrumb)
+{
+	TRACE_COUNTER_INCREMENT(SentryLogsForwarded);
+
+	// Fatal logs are forwarded right away as the process is about to go down
+	if (bForwardToStructuredLogging && LogQueue && Level != ESentryLevel::Fatal)
+	{
+		LogQueue->Enqueue(V, Level, Category);
+
+		if (!bAddBreadcrumb)
 		{
 			return;
 		}
+
+		bForwardToStructuredLogging = false;
+	}
+
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem || !USentrySubsystem::IsEnabledFast())
+	{
+		return;
+	}
+
+	const FString Message = FString(V).TrimEnd();
+	const FString CategoryString = Category.ToString();
+
+	if (bForwardToStructuredLogging)
+	{
+		ForwardToStructuredLogging(SentrySubsystem, Message, Level, CategoryString);
 	}
 
 	// Send breadcrumb if not sent to structured logging, or if forced to send both
-	if (BreadcrumbFlags.Contains(Level) && BreadcrumbFlags[Level])
+	if (bAddBreadcrumb)
 	{
 		SentrySubsystem->AddBreadcrumbWithParams(Message, CategoryString, FString(), TMap<FString, FSentryVariant>(), Level);
 	}
@@ -101,28 +236,39 @@ bool FSentryOutputDevice::CanBeUsedOnPanicThread() const
 }
 #endif
 
-bool FSentryOutputDevice::ShouldForwardToStructuredLogging(const FString& Category, ESentryLevel Level) const
+void FSentryOutputDevice::ForwardToStructuredLogging(USentrySubsystem* SentrySubsystem, const FString& Message, ESentryLevel Level, const FString& Category)
 {
-	// Check if this log level should be forwarded
-	if (!StructuredLoggingFlags.Contains(Level) || !StructuredLoggingFlags[Level])
+	// Use level-specific logging methods
+	switch (Level)
 	{
-		return false;
+	case ESentryLevel::Info:
+		SentrySubsystem->LogInfo(Message, Category);
+		break;
+	case ESentryLevel::Warning:
+		SentrySubsystem->LogWarning(Message, Category);
+		break;
+	case ESentryLevel::Error:
+		SentrySubsystem->LogError(Message, Category);
+		break;
+	case ESentryLevel::Fatal:
+		SentrySubsystem->LogFatal(Message, Category);
+		break;
+	case ESentryLevel::Debug:
+	default:
+		SentrySubsystem->LogDebug(Message, Category);
+		break;
 	}
+}
 
-	// Check category filter
-	if (StructuredLoggingCategories.Num() > 0)
+bool FSentryOutputDevice::ShouldForwardToStructuredLogging(const FName& Category, ESentryLevel Level) const
+{
+	// Check if this log level should be forwarded
+	if (!(StructuredLoggingLevelMask.Load() & GetLevelBit(Level)))
 	{
-		for (const FString& CategoryFilter : StructuredLoggingCategories)
-		{
-			if (Category.Equals(CategoryFilter, ESearchCase::IgnoreCase))
-			{
-				return true;
-			}
-		}
-
 		return false;
 	}
 
 	// No category filter, forward all logs that passed the level check
-	return true;
+	const FSentryLogCategoryFilter* CategoryFilter = StructuredLoggingCategories.Load();
+	return CategoryFilter->IsEmpty() || CategoryFilter->Matches(Category);
 }
@@ -0,0 +1,25 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryPrivacyMask.h"
+
+#include "Utils/SentryRedactedWidgets.h"
+
+void SentryPrivacyMask::RedactWidget(const TSharedRef<SWidget>& Widget)
+{
+	FSentryRedactedWidgets::Get().AddWidget(Widget);
+}
+
+void SentryPrivacyMask::RedactWidget(UWidget* Widget)
+{
+	FSentryRedactedWidgets::Get().AddWidget(Widget);
+}
+
+void SentryPrivacyMask::UnredactWidget(const TSharedRef<SWidget>& Widget)
+{
+	FSentryRedactedWidgets::Get().RemoveWidget(Widget);
+}
+
+void SentryPrivacyMask::UnredactWidget(UWidget* Widget)
+{
+	FSentryRedactedWidgets::Get().RemoveWidget(Widget);
+}
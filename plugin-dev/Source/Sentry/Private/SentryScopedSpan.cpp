@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryScopedSpan.h"
+
+#include "SentrySpan.h"
+#include "SentryTransaction.h"
+
+#include "Interface/SentrySpanInterface.h"
+#include "Interface/SentryTransactionInterface.h"
+
+#include "HAL/PlatformSentrySpan.h"
+#include "HAL/PlatformSentryTransaction.h"
+
+#if USE_SENTRY_NATIVE
+#include "Infrastructure/GenericPlatformSentryConverters.h"
+#include "Utils/SentryMonotonicClock.h"
+#endif
+
+FSentryScopedSpan::FSentryScopedSpan(USentryTransaction* Parent, const TCHAR* Operation, const TCHAR* Description)
+{
+	TSharedPtr<ISentryTransaction> ParentTransaction = Parent ? Parent->GetNativeObject() : nullptr;
+	if (!ParentTransaction || ParentTransaction->IsFinished())
+	{
+		return;
+	}
+
+#if USE_SENTRY_NATIVE
+	TSharedPtr<FGenericPlatformSentryTransaction> PlatformTransaction = StaticCastSharedPtr<FGenericPlatformSentryTransaction>(ParentTransaction);
+	NativeSpan = PlatformTransaction->StartNativeChild(TCHAR_TO_UTF8(Operation), TCHAR_TO_UTF8(Description));
+	ClockOffset = PlatformTransaction->GetClock().GetOffset();
+#else
+	Span = ParentTransaction->StartChildSpan(Operation, Description, false);
+#endif
+}
+
+FSentryScopedSpan::FSentryScopedSpan(USentrySpan* Parent, const TCHAR* Operation, const TCHAR* Description)
+{
+	TSharedPtr<ISentrySpan> ParentSpan = Parent ? Parent->GetNativeObject() : nullptr;
+	if (!ParentSpan || ParentSpan->IsFinished())
+	{
+		return;
+	}
+
+#if USE_SENTRY_NATIVE
+	TSharedPtr<FGenericPlatformSentrySpan> PlatformSpan = StaticCastSharedPtr<FGenericPlatformSentrySpan>(ParentSpan);
+	NativeSpan = PlatformSpan->StartNativeChild(TCHAR_TO_UTF8(Operation), TCHAR_TO_UTF8(Description));
+	ClockOffset = PlatformSpan->GetClock().GetOffset();
+#else
+	Span = ParentSpan->StartChild(Operation, Description, false);
+#endif
+}
+
+FSentryScopedSpan::FSentryScopedSpan(const FSentryScopedSpan& Parent, const TCHAR* Operation, const TCHAR* Description)
+{
+	if (!Parent.IsRecording())
+	{
+		return;
+	}
+
+#if USE_SENTRY_NATIVE
+	// Nested scoped spans live on the same thread as their parent, so no locking is needed
+	ClockOffset = Parent.ClockOffset;
+	NativeSpan = sentry_span_start_child_ts(static_cast<sentry_span_t*>(Parent.NativeSpan), TCHAR_TO_UTF8(Operation), TCHAR_TO_UTF8(Description),
+		FSentryMonotonicClock(ClockOffset).GetTimestamp());
+#else
+	Span = Parent.Span->StartChild(Operation, Description, false);
+#endif
+}
+
+FSentryScopedSpan::~FSentryScopedSpan()
+{
+#if USE_SENTRY_NATIVE
+	if (NativeSpan)
+	{
+		sentry_span_finish_ts(static_cast<sentry_span_t*>(NativeSpan), FSentryMonotonicClock(ClockOffset).GetTimestamp());
+	}
+#else
+	if (Span)
+	{
+		Span->Finish();
+	}
+#endif
+}
+
+bool FSentryScopedSpan::IsRecording() const
+{
+#if USE_SENTRY_NATIVE
+	return NativeSpan != nullptr;
+#else
+	return Span.IsValid();
+#endif
+}
+
+void FSentryScopedSpan::SetData(const FString& Key, const TMap<FString, FSentryVariant>& Values)
+{
+#if USE_SENTRY_NATIVE
+	if (NativeSpan)
+	{
+		sentry_span_set_data(static_cast<sentry_span_t*>(NativeSpan), TCHAR_TO_UTF8(*Key), FGenericPlatformSentryConverters::VariantMapToNative(Values));
+	}
+#else
+	if (Span)
+	{
+		Span->SetData(Key, Values);
+	}
+#endif
+}
@@ -4,6 +4,7 @@
 #include "SentryBeforeSendHandler.h"
 #include "SentryDefines.h"
 #include "SentryTraceSampler.h"
+#include "Utils/SentryCrashVideoPresets.h"
 
 #include "Misc/App.h"
 #include "Misc/ConfigCacheIni.h"
@@ -12,54 +13,193 @@
 USentrySettings::USentrySettings(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, InitAutomatically(true)
+	, InitAsynchronously(false)
 	, Dsn()
 	, Debug(true)
 	, Environment()
 	, Dist()
 	, SampleRate(1.0f)
+	, MaxDuplicateEventsPerMinute(0)
+	, MaxEventsPerMinute(0)
+	, ReportEnsuresOncePerLocation(true)
 	, EnableAutoLogAttachment(false)
+	, AutoLogAttachmentTailSizeKB(0)
+	, AttachCrashLogTail(false)
+	, CrashLogTailSizeKB(256)
+	, AttachCrashMemoryRegions(true)
+	, CrashMemoryRegionsMaxSizeKB(256)
+	, AttachInputEvents(false)
+	, InputEventsCapacity(256)
+	, AttachStateTimeline(false)
+	, StateTimelineSampleIntervalSeconds(0.5f)
+	, StateTimelineArenaSizeKB(256)
+	, PersistLogTail(false)
 	, AttachStacktrace(true)
+	, StacktraceMaxFrames(0)
+	, bCacheCallsiteStacktraces(false)
 	, SendDefaultPii(false)
 	, AttachScreenshot(false)
+	, ScreenshotFormat(ESentryScreenshotFormat::Png)
+	, ScreenshotSource(ESentryScreenshotSource::Slate)
+	, ScreenshotIncludeUI(true)
+	, ScreenshotJpegQuality(85)
+	, ScreenshotMaxDimension(0)
+	, CacheLastFrameScreenshot(false)
+	, LastFrameScreenshotInterval(2.0f)
 	, AttachGpuDump(true)
+	, EnableGpuBreadcrumbs(false)
+	, GpuBreadcrumbsCapacity(64)
+	, AttachCrashFrameStrip(false)
+	, DeferCrashVideoUpload(false)
+	, UploadCrashVideoPreviewFirst(false)
+	, CrashVideoPreviewSizeKB(2560)
+	, CrashVideoFullClipRetentionDays(7)
+	, CrashVideoSampleRate(1.0f)
+	, CrashVideoDeduplicationDays(0)
+	, AttachEnsureVideo(false)
+	, EnsureVideoMinInterval(60.0f)
+	, AutoStartCrashVideoRecording(false)
+	, CrashVideoPresets(SentryCrashVideoPresets::GetDefaultPresets())
+	, AttachServerReplay(false)
+	, ServerReplayDurationSeconds(60.0f)
+	, ServerReplayCheckpointIntervalSeconds(30.0f)
+	, ServerReplayMaxSizeMB(64)
+	, AttachServerReplayToEnsures(false)
+	, ServerReplayEnsureMinInterval(60.0f)
 	, MaxAttachmentSize(20 * 1024 * 1024)
+	, MaxUploadBandwidthKBps(0)
+	, DeferLargeUploadsDuringMatch(false)
+	, LargeUploadThresholdKB(512)
 	, EnableStructuredLogging(false)
 	, StructuredLoggingCategories()
+	, StructuredLoggingFilterRules()
+	, LogRateLimit(0.0f)
+	, LogRateLimitBurst(20)
+	, RepeatedLogsWindow(0.0f)
 	, StructuredLoggingLevels()
 	, bSendBreadcrumbsWithStructuredLogging(false)
+	, bAsyncStructuredLogging(false)
+	, StructuredLoggingQueueCapacity(4096)
+	, LogBatchMaxItems(256)
+	, LogBatchMaxBytes(1024 * 1024)
+	, LogFlushIntervalMs(100)
 	, MaxBreadcrumbs(100)
+	, MinBreadcrumbLevel(ESentryLevel::Debug)
+	, bRetainBreadcrumbsByLevel(false)
+	, BreadcrumbLevelReservedPercent(10)
 	, AutomaticBreadcrumbs()
 	, AutomaticBreadcrumbsForLogs()
+	, MaxScopeTags(0)
+	, MaxScopeExtras(0)
+	, MaxScopeContexts(0)
+	, MaxContextDepth(0)
+	, MaxContextValues(0)
+	, MaxEventPayloadSizeKB(0)
+	, TrackPayloadSizes(false)
 	, EnableAutoSessionTracking(true)
 	, SessionTimeout(30000)
 	, OverrideReleaseName(false)
 	, Release()
+	, EnableSessionAggregation(false)
+	, SessionAggregationFlushInterval(60.0f)
+	, EnableMetrics(false)
+	, MetricsFlushInterval(10.0f)
 	, UseProxy(false)
 	, ProxyUrl()
+	, EnableBatchedTransport(false)
+	, TransportBatchWindow(5.0f)
+	, CompressEnvelopes(true)
+	, EnableOfflineSpool(false)
+	, OfflineSpoolMaxSizeMB(20)
+	, DeduplicateAttachments(false)
+	, AttachmentDeduplicationWindowMinutes(0.0f)
+	, SerializeStaticScopeOnce(false)
+	, WarmUpTransportConnection(false)
+	, EnableAdaptiveSampling(false)
+	, AdaptiveSamplingMaxPendingEnvelopes(100)
+	, AdaptiveSamplingMaxPendingSizeMB(10)
+	, AdaptiveSamplingMinRate(0.1f)
 	, BeforeSendHandler(nullptr)
 	, BeforeBreadcrumbHandler(nullptr)
 	, BeforeLogHandler(nullptr)
+	, HandlerTimeBudgetMs(0.0f)
+	, bDisableSlowHandlers(false)
 	, EnableAutoCrashCapturing(true)
 	, DatabaseLocation(ESentryDatabaseLocation::ProjectUserDirectory)
+	, SeparateDatabasePerInstance(false)
 	, CrashpadWaitForUpload(false)
+	, ShutdownTimeoutMs(3000)
+	, FastExitOnClose(false)
+	, DatabaseMaxReportAgeDays(0)
+	, DatabaseMaxReportsSizeMB(0)
 	, InAppInclude()
 	, InAppExclude()
 	, EnableAppNotRespondingTracking(false)
+	, AppHangTimeoutSeconds(5.0f)
+	, RenderThreadHangTimeoutSeconds(5.0f)
+	, RHIThreadHangTimeoutSeconds(5.0f)
+	, AttachCrashVideoToAppHangs(false)
+	, AttachNativeStacksToAnrs(false)
+	, ReportProcessExitReasons(false)
+	, EnableMetricKit(false)
+	, EnableMemorySampling(false)
+	, MemorySamplingIntervalSeconds(5.0f)
+	, LowMemoryThresholdPercent(10)
+	, MemorySamplingTopTags(5)
+	, ReportOutOfMemoryOnNextLaunch(true)
+	, AndroidBridgeBatchSize(0)
+	, EnableAsyncScopedCaptures(false)
+	, UsePixelCopyScreenshots(false)
+	, EnableDeviceConditionsSampling(false)
+	, DeviceConditionsSamplingIntervalSeconds(10.0f)
 	, EnableTracing(false)
 	, SamplingType(ESentryTracesSamplingType::UniformSampleRate)
 	, TracesSampleRate(0.0f)
 	, TracesSampler(nullptr)
+	, SendInitProfileTransaction(false)
+	, SendAppStartTransaction(false)
+	, EnableMapPerformanceTransactions(false)
+	, MapPerformanceHitchThresholdMs(50.0f)
+	, EnableHitchSpans(false)
+	, HitchStackSamplingIntervalMs(10.0f)
+	, EnableFrameBreakdownTransactions(false)
+	, FrameBreakdownSampleInterval(1800)
+	, EnableFrameTimeHistory(false)
+	, FrameTimeHistorySeconds(10.0f)
+	, EnableNetworkQualityTimeline(false)
+	, NetworkQualityTimelineSeconds(60)
+	, EnablePsoTracking(false)
+	, PsoStallSpanThresholdMs(50.0f)
+	, EnableGcTracking(false)
+	, GcPauseSpanThresholdMs(20.0f)
+	, EnableSyncFileIoTracking(false)
+	, SyncFileIoThresholdMs(5.0f)
+	, EnableLoadTransactions(false)
+	, AsyncLoadSpanThresholdMs(100.0f)
+	, EnableHttpTracing(false)
+	, HttpTracePropagationTargets()
+	, EnableProfiling(false)
+	, ProfilesSampleRate(1.0f)
+	, ProfilerSamplingFrequency(100.0f)
 	, EditorDsn()
 	, TagsPromotion()
 	, EnableBuildConfigurations()
 	, EnableBuildTargets()
 	, EnableForPromotedBuildsOnly(false)
+	, bCoalesceScopeUpdates(false)
+	, bAsyncPlatformCalls(false)
+	, AsyncPlatformCallsQueueCapacity(4096)
+	, WriteCrashTimeline(false)
+	, BackgroundThreadPriority(ESentryThreadPriority::BelowNormal)
+	, BackgroundThreadAffinityMask(0)
 	, UploadSymbolsAutomatically(false)
 	, ProjectName()
 	, OrgName()
 	, AuthToken()
 	, IncludeSources(false)
 	, DiagnosticLevel(ESentryCliLogLevel::Info)
+	, SymbolUploadJobs(0)
+	, CacheUploadedSymbols(false)
 	, UseLegacyGradlePlugin(false)
 	, CrashReporterUrl()
 	, bRequireUserConsent(false)
@@ -91,6 +231,8 @@ void USentrySettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChan
 		PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(USentrySettings, IncludeSources) ||
 		PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(USentrySettings, UseLegacyGradlePlugin) ||
 		PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(USentrySettings, DiagnosticLevel) ||
+		PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(USentrySettings, SymbolUploadJobs) ||
+		PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(USentrySettings, CacheUploadedSymbols) ||
 		PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(USentrySettings, CrashReporterUrl))
 	{
 		return;
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryStateTimeline.h"
+
+#include "Utils/SentryStateTimelineRecorder.h"
+
+int32 SentryStateTimeline::RegisterProvider(const FString& Name, int32 SnapshotSize, FSentryStateProvider Provider)
+{
+	return FSentryStateTimelineRecorder::Get().Register(Name, SnapshotSize, nullptr, MoveTemp(Provider));
+}
+
+int32 SentryStateTimeline::RegisterStructProvider(const FString& Name, const UScriptStruct* Struct, FSentryStateProvider Provider)
+{
+	return FSentryStateTimelineRecorder::Get().RegisterStruct(Name, Struct, MoveTemp(Provider));
+}
+
+void SentryStateTimeline::UnregisterProvider(int32 Handle)
+{
+	FSentryStateTimelineRecorder::Get().Unregister(Handle);
+}
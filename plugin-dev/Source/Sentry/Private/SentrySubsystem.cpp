@@ -6,33 +6,170 @@
 #include "SentryBeforeLogHandler.h"
 #include "SentryBeforeSendHandler.h"
 #include "SentryBreadcrumb.h"
+#include "SentryBreadcrumbMacros.h"
+#include "SentryCrashVideoCapture.h"
 #include "SentryDefines.h"
 #include "SentryErrorOutputDevice.h"
 #include "SentryEvent.h"
 #include "SentryFeedback.h"
+#include "SentryInitProfile.h"
+#include "SentryLibrary.h"
+#include "SentryLog.h"
 #include "SentryModule.h"
 #include "SentryOutputDevice.h"
 #include "SentrySettings.h"
+#include "SentrySpan.h"
 #include "SentryTraceSampler.h"
 #include "SentryTransaction.h"
 #include "SentryTransactionContext.h"
 #include "SentryUser.h"
 
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "CoreGlobals.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
 #include "Engine/World.h"
-#include "GenericPlatform/GenericPlatformDriver.h"
 #include "GenericPlatform/GenericPlatformMisc.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapperModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
 #include "Misc/App.h"
 #include "Misc/AssertionMacros.h"
 #include "Misc/CoreDelegates.h"
+#include "Misc/Crc.h"
 #include "Misc/EngineVersion.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Modules/ModuleManager.h"
+#include "Templates/Atomic.h"
+#include "UObject/Stack.h"
+#include "UObject/UObjectArray.h"
 #include "SentryAttachment.h"
 
+#include "Interface/SentryScopeInterface.h"
+#include "Interface/SentrySpanInterface.h"
 #include "Interface/SentrySubsystemInterface.h"
-
+#include "Interface/SentryTransactionInterface.h"
+
+#include "Utils/SentryAppStart.h"
+#include "Utils/SentryCommandQueue.h"
+#include "Utils/SentryContextCache.h"
+#include "Utils/SentryDeviceConditions.h"
+#include "Utils/SentryDsn.h"
+#include "Utils/SentryEventFilters.h"
+#include "Utils/SentryEventLimiter.h"
+#include "Utils/SentryCrashVideoPendingUpload.h"
+#include "Utils/SentryCrashVideoHistory.h"
+#include "Utils/SentryCrashVideoRawRing.h"
+#include "Utils/SentryEnvelopeSender.h"
+#include "Utils/SentryFileIoPlatformFile.h"
+#include "Utils/SentryFileUtils.h"
+#include "Utils/SentryFrameBreakdown.h"
+#include "Utils/SentryFrameTimeHistory.h"
+#include "Utils/SentryLoadTracker.h"
+#include "Utils/SentryLogRing.h"
+#include "Utils/SentryLogUtils.h"
+#include "Utils/SentryPayloadAccounting.h"
+#include "Utils/SentryPsoTracker.h"
+#include "Utils/SentryGpuBreadcrumbs.h"
+#include "Utils/SentryHandlerBudget.h"
+#include "Utils/SentryHangWatchdog.h"
+#include "Utils/SentryHitchDetector.h"
+#include "Utils/SentryHttpTracing.h"
+#include "Utils/SentryInputRing.h"
+#include "Utils/SentryMapPerformance.h"
+#include "Utils/SentryMemoryAccounting.h"
+#include "Utils/SentryMemorySampler.h"
+#include "Utils/SentryMetrics.h"
+#include "Utils/SentryMonotonicClock.h"
+#include "Utils/SentryNetworkQuality.h"
+#include "Utils/SentryServerReplay.h"
+#include "Utils/SentrySessionAggregator.h"
+#include "Utils/SentryScopeBatch.h"
+#include "Utils/SentryScopeLimiter.h"
+#include "Utils/SentryScreenshotUtils.h"
+#include "Utils/SentryStateTimelineRecorder.h"
+#include "Utils/SentryStats.h"
+#include "Utils/SentryStructLayout.h"
+#include "Utils/SentryThreadUtils.h"
+#include "Utils/SentryTrace.h"
+#include "Utils/SentryTransportAccounting.h"
+#include "Utils/SentryUploadScheduler.h"
+#include "Utils/SentryWorldScopes.h"
+#include "Utils/SentryWrapperPool.h"
+
+#include "HAL/PlatformSentryEvent.h"
 #include "HAL/PlatformSentryFeedback.h"
 #include "HAL/PlatformSentryId.h"
 #include "HAL/PlatformSentrySubsystem.h"
+#include "HAL/PlatformSentryTransactionContext.h"
+
+uint8 SentryBreadcrumbs::EnabledLevelMask = 0;
+
+namespace SentryEnsures
+{
+	/** Frames of the ensure handler, its delegate instance and the delegate broadcast on top of the ensure site. */
+	static constexpr int32 DelegateFramesToSkip = 3;
+}
+
+namespace SentrySubsystemInstance
+{
+	/** Published by the engine subsystem itself so that hot paths don't look it up in the subsystem collection every time. */
+	static TAtomic<USentrySubsystem*> Subsystem(nullptr);
+
+	/** Mirrors whether the platform SDK is initialized. */
+	static TAtomic<bool> bIsEnabled(false);
+
+	/** Published for the crash handler which can't take the lock guarding the command queue of the subsystem. */
+	static TAtomic<FSentryCommandQueue*> CommandQueue(nullptr);
+}
+
+namespace SentryWrapperPools
+{
+	/** Releases the objects pooled for the handlers. */
+	static void ResetAll()
+	{
+		FSentryEventWrapperPool::Get().Reset();
+		FSentryBreadcrumbWrapperPool::Get().Reset();
+		FSentryLogWrapperPool::Get().Reset();
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice SentryMemReportCommand(
+	TEXT("Sentry.MemReport"),
+	TEXT("Prints the memory held by the Sentry SDK broken down by component."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+		if (!SentrySubsystem)
+		{
+			Ar.Log(TEXT("Sentry subsystem isn't available."));
+			return;
+		}
+
+		for (const FString& Line : SentryMemoryAccounting::ToLines(SentrySubsystem->GetMemoryStats()))
+		{
+			Ar.Log(Line);
+		}
+	}));
+
+void SentryBreadcrumbs::Add(ESentryLevel Level, const TCHAR* Category, const FString& Message, const TMap<FString, FSentryVariant>& Data)
+{
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem)
+	{
+		return;
+	}
+
+	SentrySubsystem->AddBreadcrumbWithParams(Message, Category, TEXT("Default"), Data, Level);
+}
 
 void USentrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -40,6 +177,8 @@ void USentrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	SubsystemNativeImpl = MakeShareable(new FPlatformSentrySubsystem());
 
+	SentrySubsystemInstance::Subsystem.Store(this);
+
 	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
 	check(Settings);
 
@@ -57,6 +196,9 @@ void USentrySubsystem::Deinitialize()
 
 	Close();
 
+	USentrySubsystem* Expected = this;
+	SentrySubsystemInstance::Subsystem.CompareExchange(Expected, nullptr);
+
 	Super::Deinitialize();
 }
 
@@ -70,6 +212,12 @@ void USentrySubsystem::Initialize()
 		return;
 	}
 
+	if (IsInitializingAsync())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Sentry is already being initialized asynchronously."));
+		return;
+	}
+
 	if (SubsystemNativeImpl->IsEnabled())
 	{
 		UE_LOG(LogSentrySdk, Warning, TEXT("Sentry is already initialized. It will be shut down automatically before re-init."));
@@ -97,6 +245,52 @@ void USentrySubsystem::Initialize()
 		return;
 	}
 
+	InitProfile.Reset();
+
+	const FSentryInitPhase& SettingsLoadPhase = FSentryModule::Get().GetSettingsLoadPhase();
+	InitProfile.AddPhase(SettingsLoadPhase.Name, SettingsLoadPhase.StartTime, SettingsLoadPhase.EndTime);
+
+	FSentryInitProfile::FScopedCurrent InitProfileScope(&InitProfile);
+
+#if PLATFORM_MAC
+	{
+		SENTRY_INIT_PHASE_SCOPE(LoadSentryLib);
+
+		// Cocoa SDK is loaded once it's known that Sentry is going to run, unless a wrapper created earlier already needed its classes
+		if (!FSentryModule::Get().LoadSentryLib())
+		{
+			return;
+		}
+	}
+#endif
+
+	USentryAttachment::CleanupStreamedFiles();
+
+	CreateHandlers();
+
+	if (Settings->InitAsynchronously)
+	{
+#if USE_SENTRY_NATIVE
+		InitializeAsync();
+		return;
+#else
+		UE_LOG(LogSentrySdk, Log, TEXT("Asynchronous initialization is supported on Windows and Linux only. Sentry will be initialized synchronously."));
+#endif
+	}
+
+	if (InitializeNativeImpl())
+	{
+		CompleteInitialization();
+	}
+}
+
+void USentrySubsystem::CreateHandlers()
+{
+	SENTRY_INIT_PHASE_SCOPE(CreateHandlers);
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
 	BeforeSendHandler =
 		Settings->BeforeSendHandler != nullptr
 			? NewObject<USentryBeforeSendHandler>(this, static_cast<UClass*>(Settings->BeforeSendHandler))
@@ -116,443 +310,600 @@ void USentrySubsystem::Initialize()
 		Settings->TracesSampler != nullptr
 			? NewObject<USentryTraceSampler>(this, static_cast<UClass*>(Settings->TracesSampler))
 			: nullptr;
+}
 
-	SubsystemNativeImpl->InitWithSettings(Settings, BeforeSendHandler, BeforeBreadcrumbHandler, BeforeLogHandler, TraceSampler);
-
-	if (!SubsystemNativeImpl->IsEnabled())
+void USentrySubsystem::InitializeAsync()
+{
 	{
-		UE_LOG(LogSentrySdk, Error, TEXT("Sentry initialization failed."));
-		return;
+		FScopeLock Lock(&DeferredCallsCriticalSection);
+		bIsInitializingAsync = true;
 	}
 
-	AddDefaultContext();
-	AddGpuContext();
-	AddDeviceContext();
-
-	PromoteTags();
-	ConfigureBreadcrumbs();
+	const int32 InitSerial = ++AsyncInitSerial;
 
-	ConfigureOutputDevice();
-	ConfigureErrorOutputDevice();
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
 
-	OnEnsureDelegate = FCoreDelegates::OnHandleSystemEnsure.AddWeakLambda(this, [this]()
+	// Close waits for this task to finish so the subsystem is guaranteed to outlive it
+	AsyncInitTask = Async(EAsyncExecution::ThreadPool, [this, WeakThis, InitSerial]()
 	{
-		verify(SubsystemNativeImpl);
+		const bool bIsInitialized = InitializeNativeImpl();
 
-		FString EnsureMessage = GErrorHist;
-		SubsystemNativeImpl->CaptureEnsure(TEXT("Ensure failed"), EnsureMessage.TrimStartAndEnd());
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, InitSerial, bIsInitialized]()
+		{
+			USentrySubsystem* Subsystem = WeakThis.Get();
+			if (!Subsystem || Subsystem->AsyncInitSerial != InitSerial)
+			{
+				return;
+			}
+
+			Subsystem->AsyncInitTask = TFuture<void>();
+
+			if (bIsInitialized)
+			{
+				Subsystem->CompleteInitialization();
+			}
+
+			Subsystem->ReplayDeferredCalls();
+		});
 	});
 }
 
-void USentrySubsystem::InitializeWithSettings(const FConfigureSettingsDelegate& OnConfigureSettings)
+bool USentrySubsystem::InitializeNativeImpl()
 {
-	return InitializeWithSettings(FConfigureSettingsNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureSettings.GetUObject()), OnConfigureSettings.GetFunctionName()));
-}
+	LLM_SCOPE_BYTAG(Sentry);
 
-void USentrySubsystem::InitializeWithSettings(const FConfigureSettingsNativeDelegate& OnConfigureSettings)
-{
-	USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
 	check(Settings);
 
-	OnConfigureSettings.ExecuteIfBound(Settings);
+	FSentryInitProfile::FScopedCurrent InitProfileScope(&InitProfile);
 
-	Initialize();
-}
+	const double InitStartTime = FPlatformTime::Seconds();
 
-void USentrySubsystem::Close()
-{
-	if (GLog && OutputDevice)
-	{
-		GLog->RemoveOutputDevice(OutputDevice.Get());
-		OutputDevice = nullptr;
-	}
+	FSentryHandlerBudget::Get().Start(Settings->HandlerTimeBudgetMs, Settings->bDisableSlowHandlers);
 
-	if (GError && OutputDeviceError)
 	{
-		if (OnAssertDelegate.IsValid())
-		{
-			OutputDeviceError->OnAssert.Remove(OnAssertDelegate);
-			OnAssertDelegate.Reset();
-		}
-
-		GError = OutputDeviceError->GetParentDevice();
-		OutputDeviceError = nullptr;
+		SENTRY_INIT_PHASE_SCOPE(PlatformInit);
+		SubsystemNativeImpl->InitWithSettings(Settings, BeforeSendHandler, BeforeBreadcrumbHandler, BeforeLogHandler, TraceSampler);
 	}
 
-	if (OnEnsureDelegate.IsValid())
-	{
-		FCoreDelegates::OnHandleSystemEnsure.Remove(OnEnsureDelegate);
-		OnEnsureDelegate.Reset();
-	}
+	InitializationDurationMs = static_cast<float>((FPlatformTime::Seconds() - InitStartTime) * 1000.0);
+	UE_LOG(LogSentrySdk, Log, TEXT("Sentry platform SDK initialization took %.2f ms."), InitializationDurationMs);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (!SubsystemNativeImpl->IsEnabled())
 	{
-		return;
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry initialization failed."));
+		return false;
 	}
 
-	SubsystemNativeImpl->Close();
-}
+	SentrySubsystemInstance::bIsEnabled.Store(true);
 
-bool USentrySubsystem::IsEnabled() const
-{
-	return SubsystemNativeImpl ? SubsystemNativeImpl->IsEnabled() : false;
-}
+	AddDefaultContext();
+	AddHardwareContexts();
 
-ESentryCrashedLastRun USentrySubsystem::IsCrashedLastRun() const
-{
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
-	{
-		return ESentryCrashedLastRun::NotEvaluated;
-	}
+	PromoteTags();
 
-	return SubsystemNativeImpl->IsCrashedLastRun();
+	return true;
 }
 
-void USentrySubsystem::AddBreadcrumb(USentryBreadcrumb* Breadcrumb)
+void USentrySubsystem::CompleteInitialization()
 {
-	check(SubsystemNativeImpl);
-	check(Breadcrumb);
+	LLM_SCOPE_BYTAG(Sentry);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
-	{
-		return;
-	}
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
 
-	if (!Breadcrumb)
+	FSentryInitProfile::FScopedCurrent InitProfileScope(&InitProfile);
+
+	SentryBreadcrumbs::EnabledLevelMask = 0;
+	if (Settings->MaxBreadcrumbs > 0)
 	{
-		return;
+		for (uint8 Level = static_cast<uint8>(Settings->MinBreadcrumbLevel); Level <= static_cast<uint8>(ESentryLevel::Fatal); ++Level)
+		{
+			SentryBreadcrumbs::EnabledLevelMask |= 1 << Level;
+		}
 	}
 
-	SubsystemNativeImpl->AddBreadcrumb(Breadcrumb->GetNativeObject());
-}
+	ConfigureBreadcrumbs();
 
-void USentrySubsystem::AddBreadcrumbWithParams(const FString& Message, const FString& Category, const FString& Type, const TMap<FString, FSentryVariant>& Data, ESentryLevel Level)
-{
-	check(SubsystemNativeImpl);
+	ConfigureOutputDevice();
+	ConfigureErrorOutputDevice();
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->bAsyncPlatformCalls && FPlatformProcess::SupportsMultithreading())
 	{
-		return;
+		// Queued calls already keep scope updates off the calling thread so they aren't coalesced on top of that
+		FWriteScopeLock Lock(CommandQueueLock);
+		CommandQueue = MakeShared<FSentryCommandQueue, ESPMode::ThreadSafe>(Settings->AsyncPlatformCallsQueueCapacity,
+			SentryThreadUtils::ToThreadPriority(Settings->BackgroundThreadPriority), SentryThreadUtils::ToAffinityMask(Settings->BackgroundThreadAffinityMask));
+		SentrySubsystemInstance::CommandQueue.Store(CommandQueue.Get());
 	}
-
-	SubsystemNativeImpl->AddBreadcrumbWithParams(Message, Category, Type, Data, Level);
-}
-
-void USentrySubsystem::LogDebug(const FString& Message, const FString& Category)
-{
-	check(SubsystemNativeImpl);
-
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	else if (Settings->bCoalesceScopeUpdates)
 	{
-		return;
+		ConfigureScopeBatch();
 	}
 
-	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Debug, Category);
-}
-
-void USentrySubsystem::LogInfo(const FString& Message, const FString& Category)
-{
-	check(SubsystemNativeImpl);
+	WorldScopes = MakeShared<FSentryWorldScopes, ESPMode::ThreadSafe>();
+	WorldCleanupDelegate = FWorldDelegates::OnWorldCleanup.AddWeakLambda(this, [this](UWorld* World, bool bSessionEnded, bool bCleanupResources)
+	{
+		if (WorldScopes)
+		{
+			WorldScopes->Clear(World);
+		}
+	});
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->MaxDuplicateEventsPerMinute > 0 || Settings->MaxEventsPerMinute > 0)
 	{
-		return;
+		ConfigureEventLimiter();
 	}
 
-	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Info, Category);
-}
-
-void USentrySubsystem::LogWarning(const FString& Message, const FString& Category)
-{
-	check(SubsystemNativeImpl);
-
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->EnableSessionAggregation)
 	{
-		return;
+		ConfigureSessionAggregation();
 	}
 
-	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Warning, Category);
-}
-
-void USentrySubsystem::LogError(const FString& Message, const FString& Category)
-{
-	check(SubsystemNativeImpl);
-
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->EnableMetrics)
 	{
-		return;
+		ConfigureMetrics();
 	}
 
-	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Error, Category);
-}
+	if (Settings->MaxUploadBandwidthKBps > 0 || Settings->DeferLargeUploadsDuringMatch)
+	{
+		ConfigureUploadScheduler();
+	}
 
-void USentrySubsystem::LogFatal(const FString& Message, const FString& Category)
-{
-	check(SubsystemNativeImpl);
+	if (Settings->AttachCrashVideo)
+	{
+		UploadPendingCrashVideos();
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->EnableTracing && Settings->EnableMapPerformanceTransactions)
 	{
-		return;
+		ConfigureMapPerformanceTransactions();
 	}
 
-	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Fatal, Category);
-}
+	if (Settings->EnableTracing && Settings->EnableLoadTransactions)
+	{
+		ConfigureLoadTransactions();
+	}
 
-void USentrySubsystem::ClearBreadcrumbs()
-{
-	check(SubsystemNativeImpl);
+	if (Settings->EnableTracing && Settings->EnableFrameBreakdownTransactions)
+	{
+		ConfigureFrameBreakdownTransactions();
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->EnableMemorySampling)
 	{
-		return;
+		ConfigureMemorySampling();
 	}
 
-	SubsystemNativeImpl->ClearBreadcrumbs();
-}
+	if (Settings->EnableDeviceConditionsSampling)
+	{
+		ConfigureDeviceConditionsSampling();
+	}
 
-void USentrySubsystem::AddAttachment(USentryAttachment* Attachment)
-{
-	check(SubsystemNativeImpl);
-	check(Attachment);
+	if (Settings->EnablePsoTracking)
+	{
+		ConfigurePsoTracking();
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (Settings->EnableGcTracking)
 	{
-		return;
+		ConfigureGcTracking();
 	}
 
-	if (!Attachment)
+	if (Settings->EnableSyncFileIoTracking)
 	{
-		return;
+		ConfigureSyncFileIoTracking();
 	}
 
-	SubsystemNativeImpl->AddAttachment(Attachment->GetNativeObject());
-}
+	if (Settings->AttachServerReplay)
+	{
+		FSentryServerReplayConfig ServerReplayConfig;
+		ServerReplayConfig.DurationSeconds = Settings->ServerReplayDurationSeconds;
+		ServerReplayConfig.CheckpointIntervalSeconds = Settings->ServerReplayCheckpointIntervalSeconds;
+		ServerReplayConfig.MaxSizeMB = Settings->ServerReplayMaxSizeMB;
 
-void USentrySubsystem::ClearAttachments()
-{
-	check(SubsystemNativeImpl);
+		FSentryServerReplay::Get().Start(ServerReplayConfig);
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+#if USE_SENTRY_NATIVE
+	if (Settings->EnableAppNotRespondingTracking)
 	{
-		return;
+		ConfigureAppHangTracking();
 	}
 
-	SubsystemNativeImpl->ClearAttachments();
-}
+	if (Settings->EnableGpuBreadcrumbs)
+	{
+		FSentryGpuBreadcrumbs::Get().Start(Settings->GpuBreadcrumbsCapacity);
+	}
 
-FString USentrySubsystem::CaptureMessage(const FString& Message, ESentryLevel Level)
-{
-	check(SubsystemNativeImpl);
+	if (Settings->EnableFrameTimeHistory)
+	{
+		FSentryFrameTimeHistory::Get().Start(Settings->FrameTimeHistorySeconds);
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	// Recorded keys may spell out what the user typed, so they're treated as personally identifiable information
+	if (Settings->AttachInputEvents && Settings->SendDefaultPii)
 	{
-		return FString();
+		FSentryInputRing::Get().Start(Settings->InputEventsCapacity);
 	}
 
-	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureMessage(Message, Level);
-	if (!SentryId)
+	if (Settings->AttachStateTimeline)
 	{
-		return FString();
+		FSentryStateTimelineRecorder::Get().Start(Settings->StateTimelineSampleIntervalSeconds, Settings->StateTimelineArenaSizeKB * 1024);
 	}
 
-	return SentryId->ToString();
+	if (Settings->EnableNetworkQualityTimeline)
+	{
+		FSentryNetworkQuality::Get().Start(Settings->NetworkQualityTimelineSeconds);
+	}
+#endif
+
+	// Ensures fire on any thread where the weak object check of a weak lambda isn't safe, Close() removes the delegate instead
+	OnEnsureDelegate = FCoreDelegates::OnHandleSystemEnsure.AddLambda([this, bReportOncePerLocation = Settings->ReportEnsuresOncePerLocation]()
+	{
+		verify(SubsystemNativeImpl);
+
+		SENTRY_STAT_SCOPE(Captures);
+
+		if (bReportOncePerLocation && !MarkEnsureReported(GErrorHist))
+		{
+			return;
+		}
+
+		FString EnsureMessage = GErrorHist;
+		if (IsCaptureSuppressed(EnsureMessage, ESentryLevel::Error))
+		{
+			return;
+		}
+
+		// Skips this lambda along with the delegate instance and the broadcast calling it so that the stack starts at the ensure
+		TArray<uint64> ProgramCounters = SentryLogUtils::CaptureStackBackTrace(SentryEnsures::DelegateFramesToSkip);
+
+		// Only the call stack is captured on the ensuring thread, the event is built and sent by the command queue which Close() flushes
+		if (EnqueuePlatformCall([this, EnsureMessage, ProgramCounters]() { ReportEnsure(EnsureMessage, ProgramCounters); }, true))
+		{
+			return;
+		}
+
+		// Without the queue it's sent from the thread pool, Close() waits for the reports in flight instead
+		FScopeLock Lock(&PendingEnsureReportsCriticalSection);
+
+		if (!IsEnabledFast())
+		{
+			return;
+		}
+
+		PendingEnsureReports.RemoveAll([](const TFuture<void>& Report) { return Report.IsReady(); });
+		PendingEnsureReports.Add(Async(EAsyncExecution::ThreadPool, [this, EnsureMessage = MoveTemp(EnsureMessage), ProgramCounters = MoveTemp(ProgramCounters)]()
+		{
+			ReportEnsure(EnsureMessage, ProgramCounters);
+		}));
+	});
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Sentry initialization took %.2f ms in total."), InitProfile.GetTotalDurationMs());
+
+	if (Settings->EnableTracing && Settings->SendInitProfileTransaction)
+	{
+		SendInitProfileTransaction();
+	}
+
+	if (Settings->EnableTracing && Settings->SendAppStartTransaction)
+	{
+		ConfigureAppStartMeasurement();
+	}
 }
 
-FString USentrySubsystem::CaptureMessageWithScope(const FString& Message, const FConfigureScopeDelegate& OnConfigureScope, ESentryLevel Level)
+void USentrySubsystem::InitializeWithSettings(const FConfigureSettingsDelegate& OnConfigureSettings)
 {
-	return CaptureMessageWithScope(Message, FConfigureScopeNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureScope.GetUObject()), OnConfigureScope.GetFunctionName()), Level);
+	return InitializeWithSettings(FConfigureSettingsNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureSettings.GetUObject()), OnConfigureSettings.GetFunctionName()));
 }
 
-FString USentrySubsystem::CaptureMessageWithScope(const FString& Message, const FConfigureScopeNativeDelegate& OnConfigureScope, ESentryLevel Level)
+void USentrySubsystem::InitializeWithSettings(const FConfigureSettingsNativeDelegate& OnConfigureSettings)
 {
-	check(SubsystemNativeImpl);
+	USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	OnConfigureSettings.ExecuteIfBound(Settings);
+
+	Initialize();
+}
+
+void USentrySubsystem::UpdateSettings(const FConfigureSettingsDelegate& OnConfigureSettings)
+{
+	return UpdateSettings(FConfigureSettingsNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureSettings.GetUObject()), OnConfigureSettings.GetFunctionName()));
+}
+
+void USentrySubsystem::UpdateSettings(const FConfigureSettingsNativeDelegate& OnConfigureSettings)
+{
+	USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	OnConfigureSettings.ExecuteIfBound(Settings);
+
+	if (OutputDevice)
 	{
-		return FString();
+		OutputDevice->ApplySettings(Settings);
 	}
 
-	const auto ConfigureScopeLambda = FSentryScopeDelegate::CreateLambda([OnConfigureScope](TSharedPtr<ISentryScope> NativeScope)
+	if (SubsystemNativeImpl && SubsystemNativeImpl->IsEnabled())
 	{
-		USentryScope* UnrealScope = USentryScope::Create(NativeScope);
-		OnConfigureScope.ExecuteIfBound(UnrealScope);
-	});
+		SubsystemNativeImpl->ApplyRuntimeSettings(Settings);
+	}
+}
 
-	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureMessageWithScope(Message, Level, ConfigureScopeLambda);
-	if (!SentryId)
+void USentrySubsystem::Close()
+{
+	if (AsyncInitTask.IsValid())
 	{
-		return FString();
+		AsyncInitTask.Wait();
+		AsyncInitTask = TFuture<void>();
+
+		// Drop the pending completion and send whatever was captured in the meantime before shutting down
+		++AsyncInitSerial;
+		ReplayDeferredCalls();
 	}
 
-	return SentryId->ToString();
-}
+	// Held uploads are handed to the transport while the SDK is still enabled, it spools what it can't send before exit
+	if (UploadScheduler)
+	{
+		UploadScheduler->Flush();
+	}
 
-FString USentrySubsystem::CaptureEvent(USentryEvent* Event)
-{
-	check(SubsystemNativeImpl);
-	check(Event);
+	SentrySubsystemInstance::bIsEnabled.Store(false);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	// Calls queued so far still reach the platform SDK before it's closed
+	TSharedPtr<FSentryCommandQueue, ESPMode::ThreadSafe> ClosedCommandQueue;
 	{
-		return FString();
+		FWriteScopeLock Lock(CommandQueueLock);
+		ClosedCommandQueue = MoveTemp(CommandQueue);
+		SentrySubsystemInstance::CommandQueue.Store(nullptr);
 	}
 
-	if (!Event)
+	if (ClosedCommandQueue)
 	{
-		return FString();
+		ClosedCommandQueue->Flush();
 	}
 
-	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureEvent(Event->GetNativeObject());
-	if (!SentryId)
+	SentryBreadcrumbs::EnabledLevelMask = 0;
+
+	if (GLog && OutputDevice)
 	{
-		return FString();
+		GLog->RemoveOutputDevice(OutputDevice.Get());
+		OutputDevice = nullptr;
 	}
 
-	return SentryId->ToString();
-}
+	if (GError && OutputDeviceError)
+	{
+		if (OnAssertDelegate.IsValid())
+		{
+			OutputDeviceError->OnAssert.Remove(OnAssertDelegate);
+			OnAssertDelegate.Reset();
+		}
 
-FString USentrySubsystem::CaptureEventWithScope(USentryEvent* Event, const FConfigureScopeDelegate& OnConfigureScope)
-{
-	return CaptureEventWithScope(Event, FConfigureScopeNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureScope.GetUObject()), OnConfigureScope.GetFunctionName()));
-}
+		GError = OutputDeviceError->GetParentDevice();
+		OutputDeviceError = nullptr;
+	}
 
-FString USentrySubsystem::CaptureEventWithScope(USentryEvent* Event, const FConfigureScopeNativeDelegate& OnConfigureScope)
-{
-	check(SubsystemNativeImpl);
-	check(Event);
+	if (OnEnsureDelegate.IsValid())
+	{
+		FCoreDelegates::OnHandleSystemEnsure.Remove(OnEnsureDelegate);
+		OnEnsureDelegate.Reset();
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	// Ensures reported from here on see the SDK disabled, the lock isn't held while waiting since a report may hit an ensure itself
+	TArray<TFuture<void>> EnsureReportsInFlight;
 	{
-		return FString();
+		FScopeLock Lock(&PendingEnsureReportsCriticalSection);
+		EnsureReportsInFlight = MoveTemp(PendingEnsureReports);
 	}
 
-	if (!Event)
+	for (TFuture<void>& EnsureReport : EnsureReportsInFlight)
 	{
-		return FString();
+		EnsureReport.Wait();
 	}
 
-	const auto ConfigureScopeLambda = FSentryScopeDelegate::CreateLambda([OnConfigureScope](TSharedPtr<ISentryScope> NativeScope)
 	{
-		USentryScope* UnrealScope = USentryScope::Create(NativeScope);
-		OnConfigureScope.ExecuteIfBound(UnrealScope);
-	});
+		FScopeLock Lock(&ReportedEnsuresCriticalSection);
+		ReportedEnsureLocations.Empty();
+	}
 
-	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureEventWithScope(Event->GetNativeObject(), ConfigureScopeLambda);
-	if (!SentryId)
+	DisableMapPerformanceTransactions();
+	DisableLoadTransactions();
+	DisableFrameBreakdownTransactions();
+	DisableAppHangTracking();
+	DisableAppStartMeasurement();
+	DisableGcTracking();
+
+	if (FSentryFileIoPlatformFile* FileIoPlatformFile = FSentryFileIoPlatformFile::Get())
 	{
-		return FString();
+		FileIoPlatformFile->StopReporting();
 	}
 
-	return SentryId->ToString();
-}
+	FSentryDeviceConditionsSampler::Get().Stop();
+	FSentryFrameTimeHistory::Get().Stop();
+	FSentryGpuBreadcrumbs::Get().Stop();
+	FSentryHandlerBudget::Get().Stop();
+	FSentryInputRing::Get().Stop();
+	FSentryMemorySampler::Get().Stop();
+	FSentryNetworkQuality::Get().Stop();
+	FSentryPsoTracker::Get().Stop();
+	FSentryServerReplay::Get().Stop();
+	FSentryStateTimelineRecorder::Get().Stop();
 
-void USentrySubsystem::CaptureFeedback(USentryFeedback* Feedback)
-{
-	check(SubsystemNativeImpl);
-	check(Feedback);
+	UploadScheduler = nullptr;
+
+	if (WorldCleanupDelegate.IsValid())
+	{
+		FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupDelegate);
+		WorldCleanupDelegate.Reset();
+	}
+
+	WorldScopes = nullptr;
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
+		ScopeBatch = nullptr;
+		EventLimiter = nullptr;
+		SessionAggregator = nullptr;
+		SessionAggregatorSender = nullptr;
+		FSentryMetrics::Get().Stop();
+		MetricsSender = nullptr;
+		StreamedAttachments.Empty();
+		SentryWrapperPools::ResetAll();
 		return;
 	}
 
-	if (!Feedback)
+	// Request may not complete if the process exits right away, but sessions counted since the last flush would be lost otherwise
+	if (SessionAggregator && !SessionAggregator->IsEmpty())
 	{
-		return;
+		SessionAggregatorSender->Send(SessionAggregator->TakeEnvelope(), TEXT("aggregated sessions"));
 	}
 
-	SubsystemNativeImpl->CaptureFeedback(Feedback->GetNativeObject());
-}
+	SessionAggregator = nullptr;
+	SessionAggregatorSender = nullptr;
 
-void USentrySubsystem::CaptureFeedbackWithParams(const FString& Message, const FString& Name, const FString& Email, const FString& EventId)
-{
-	check(SubsystemNativeImpl);
+	if (MetricsSender)
+	{
+		FSentryMetrics::Get().Stop();
+		MetricsSender->Send(FSentryMetrics::Get().TakeEnvelope(true), TEXT("metrics"));
+		MetricsSender = nullptr;
+	}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	FlushScope();
+	ScopeBatch = nullptr;
+
+	// Summary isn't due yet, but counts would be lost otherwise
+	if (EventLimiter)
 	{
-		return;
+		FString Summary;
+		if (EventLimiter->TakeSuppressedSummary(Summary, 0.0))
+		{
+			SubsystemNativeImpl->CaptureMessage(Summary, ESentryLevel::Warning);
+		}
+
+		EventLimiter = nullptr;
 	}
 
-	TSharedPtr<ISentryFeedback> Feedback = MakeShareable(new FPlatformSentryFeedback(Message));
+	SubsystemNativeImpl->Close();
 
-	if (!Name.IsEmpty())
-		Feedback->SetName(Name);
-	if (!Email.IsEmpty())
-		Feedback->SetContactEmail(Email);
-	if (!EventId.IsEmpty())
-		Feedback->SetAssociatedEvent(EventId);
+	StreamedAttachments.Empty();
 
-	SubsystemNativeImpl->CaptureFeedback(Feedback);
+	// Handlers can't be called anymore, pooled wrappers mustn't stay rooted past the SDK
+	SentryWrapperPools::ResetAll();
 }
 
-void USentrySubsystem::SetUser(USentryUser* User)
+bool USentrySubsystem::IsEnabled() const
 {
-	check(SubsystemNativeImpl);
-	check(User);
+	return SubsystemNativeImpl ? SubsystemNativeImpl->IsEnabled() : false;
+}
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+USentrySubsystem* USentrySubsystem::Get()
+{
+	return SentrySubsystemInstance::Subsystem.Load(EMemoryOrder::Relaxed);
+}
+
+bool USentrySubsystem::IsEnabledFast()
+{
+	return SentrySubsystemInstance::bIsEnabled.Load(EMemoryOrder::Relaxed);
+}
+
+void USentrySubsystem::FlushPlatformCallsOnCrash()
+{
+	if (FSentryCommandQueue* PublishedCommandQueue = SentrySubsystemInstance::CommandQueue.Load())
 	{
-		return;
+		PublishedCommandQueue->TryFlushOnCrash();
 	}
+}
 
-	if (!User)
+ESentryCrashedLastRun USentrySubsystem::IsCrashedLastRun() const
+{
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return;
+		return ESentryCrashedLastRun::NotEvaluated;
 	}
 
-	SubsystemNativeImpl->SetUser(User->GetNativeObject());
+	return SubsystemNativeImpl->IsCrashedLastRun();
 }
 
-void USentrySubsystem::RemoveUser()
+void USentrySubsystem::AddBreadcrumb(USentryBreadcrumb* Breadcrumb)
 {
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Breadcrumbs);
+
 	check(SubsystemNativeImpl);
+	check(Breadcrumb);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (!Breadcrumb)
 	{
 		return;
 	}
 
-	SubsystemNativeImpl->RemoveUser();
-}
-
-void USentrySubsystem::SetContext(const FString& Key, const TMap<FString, FSentryVariant>& Values)
-{
-	check(SubsystemNativeImpl);
+	if (DeferUntilInitialized([this, NativeBreadcrumb = Breadcrumb->GetNativeObject()]() { AddBreadcrumb(USentryBreadcrumb::Create(NativeBreadcrumb)); }))
+	{
+		return;
+	}
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
 		return;
 	}
 
-	SubsystemNativeImpl->SetContext(Key, Values);
+	if (!SentryBreadcrumbs::IsLevelEnabled(Breadcrumb->GetLevel()))
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, NativeBreadcrumb = Breadcrumb->GetNativeObject()]() { AddNativeBreadcrumb(NativeBreadcrumb); }))
+	{
+		return;
+	}
+
+	AddNativeBreadcrumb(Breadcrumb->GetNativeObject());
 }
 
-void USentrySubsystem::SetTag(const FString& Key, const FString& Value)
+void USentrySubsystem::AddNativeBreadcrumb(TSharedPtr<ISentryBreadcrumb> NativeBreadcrumb)
 {
-	check(SubsystemNativeImpl);
-
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
 		return;
 	}
 
-	SubsystemNativeImpl->SetTag(Key, Value);
+	TRACE_COUNTER_INCREMENT(SentryBreadcrumbsAdded);
+
+	SubsystemNativeImpl->AddBreadcrumb(NativeBreadcrumb);
 }
 
-void USentrySubsystem::RemoveTag(const FString& Key)
+void USentrySubsystem::AddBreadcrumbWithParams(const FString& Message, const FString& Category, const FString& Type, const TMap<FString, FSentryVariant>& Data, ESentryLevel Level)
 {
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Breadcrumbs);
+
 	check(SubsystemNativeImpl);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (DeferUntilInitialized([this, Message, Category, Type, Data, Level]() { AddBreadcrumbWithParams(Message, Category, Type, Data, Level); }))
 	{
 		return;
 	}
 
-	SubsystemNativeImpl->RemoveTag(Key);
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled() || !SentryBreadcrumbs::IsLevelEnabled(Level))
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, Message, Category, Type, Data, Level]() { AddBreadcrumbWithParams(Message, Category, Type, Data, Level); }))
+	{
+		return;
+	}
+
+	TRACE_COUNTER_INCREMENT(SentryBreadcrumbsAdded);
+
+	SubsystemNativeImpl->AddBreadcrumbWithParams(Message, Category, Type, Data, Level);
 }
 
-void USentrySubsystem::SetLevel(ESentryLevel Level)
+void USentrySubsystem::LogDebug(const FString& Message, const FString& Category)
 {
+	SENTRY_STAT_SCOPE(Logs);
+
 	check(SubsystemNativeImpl);
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
@@ -560,11 +911,13 @@ void USentrySubsystem::SetLevel(ESentryLevel Level)
 		return;
 	}
 
-	SubsystemNativeImpl->SetLevel(Level);
+	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Debug, Category);
 }
 
-void USentrySubsystem::StartSession()
+void USentrySubsystem::LogInfo(const FString& Message, const FString& Category)
 {
+	SENTRY_STAT_SCOPE(Logs);
+
 	check(SubsystemNativeImpl);
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
@@ -572,11 +925,13 @@ void USentrySubsystem::StartSession()
 		return;
 	}
 
-	SubsystemNativeImpl->StartSession();
+	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Info, Category);
 }
 
-void USentrySubsystem::EndSession()
+void USentrySubsystem::LogWarning(const FString& Message, const FString& Category)
 {
+	SENTRY_STAT_SCOPE(Logs);
+
 	check(SubsystemNativeImpl);
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
@@ -584,11 +939,13 @@ void USentrySubsystem::EndSession()
 		return;
 	}
 
-	SubsystemNativeImpl->EndSession();
+	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Warning, Category);
 }
 
-void USentrySubsystem::GiveUserConsent()
+void USentrySubsystem::LogError(const FString& Message, const FString& Category)
 {
+	SENTRY_STAT_SCOPE(Logs);
+
 	check(SubsystemNativeImpl);
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
@@ -596,11 +953,13 @@ void USentrySubsystem::GiveUserConsent()
 		return;
 	}
 
-	SubsystemNativeImpl->GiveUserConsent();
+	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Error, Category);
 }
 
-void USentrySubsystem::RevokeUserConsent()
+void USentrySubsystem::LogFatal(const FString& Message, const FString& Category)
 {
+	SENTRY_STAT_SCOPE(Logs);
+
 	check(SubsystemNativeImpl);
 
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
@@ -608,407 +967,3192 @@ void USentrySubsystem::RevokeUserConsent()
 		return;
 	}
 
-	SubsystemNativeImpl->RevokeUserConsent();
+	SubsystemNativeImpl->AddLog(Message, ESentryLevel::Fatal, Category);
 }
 
-EUserConsent USentrySubsystem::GetUserConsent() const
+void USentrySubsystem::ClearBreadcrumbs()
 {
 	check(SubsystemNativeImpl);
 
+	if (DeferUntilInitialized([this]() { ClearBreadcrumbs(); }))
+	{
+		return;
+	}
+
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return EUserConsent::Unknown;
+		return;
 	}
 
-	return SubsystemNativeImpl->GetUserConsent();
+	SubsystemNativeImpl->ClearBreadcrumbs();
 }
 
-USentryTransaction* USentrySubsystem::StartTransaction(const FString& Name, const FString& Operation, bool BindToScope)
+void USentrySubsystem::AddAttachment(USentryAttachment* Attachment)
 {
+	LLM_SCOPE_BYTAG(Sentry);
+
 	check(SubsystemNativeImpl);
+	check(Attachment);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (!Attachment)
 	{
-		return nullptr;
+		return;
 	}
 
-	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransaction(Name, Operation, BindToScope);
-	if (!SentryTransaction)
+	if (DeferUntilInitialized([this, NativeAttachment = Attachment->GetNativeObject()]() { AddAttachment(USentryAttachment::Create(NativeAttachment)); }))
 	{
-		return nullptr;
+		return;
 	}
 
-	return USentryTransaction::Create(SentryTransaction);
-}
-
-USentryTransaction* USentrySubsystem::StartTransactionWithContext(USentryTransactionContext* Context, bool BindToScope)
-{
-	check(SubsystemNativeImpl);
-	check(Context);
-
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return nullptr;
+		return;
 	}
 
-	if (!Context)
-	{
-		return nullptr;
-	}
+	SubsystemNativeImpl->AddAttachment(Attachment->GetNativeObject());
 
-	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransactionWithContext(Context->GetNativeObject(), BindToScope);
-	if (!SentryTransaction)
+	// Platform SDKs read the file whenever an event is captured, so it has to stay around while the attachment is on the scope
+	if (Attachment->IsStreamed())
 	{
-		return nullptr;
+		StreamedAttachments.AddUnique(Attachment->GetNativeObject());
 	}
-
-	return USentryTransaction::Create(SentryTransaction);
 }
 
-USentryTransaction* USentrySubsystem::StartTransactionWithContextAndTimestamp(USentryTransactionContext* Context, int64 Timestamp, bool BindToScope)
+void USentrySubsystem::ClearAttachments()
 {
 	check(SubsystemNativeImpl);
-	check(Context);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (DeferUntilInitialized([this]() { ClearAttachments(); }))
 	{
-		return nullptr;
+		return;
 	}
 
-	if (!Context)
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return nullptr;
+		return;
 	}
 
-	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransactionWithContextAndTimestamp(Context->GetNativeObject(), Timestamp, BindToScope);
-	if (!SentryTransaction)
-	{
-		return nullptr;
-	}
+	SubsystemNativeImpl->ClearAttachments();
 
-	return USentryTransaction::Create(SentryTransaction);
+	StreamedAttachments.Empty();
 }
 
-USentryTransaction* USentrySubsystem::StartTransactionWithContextAndOptions(USentryTransactionContext* Context, const FSentryTransactionOptions& Options)
+void USentrySubsystem::AddScreenshotAttachmentAsync(const FScreenshotAttachedDelegate& OnAttached)
 {
-	check(SubsystemNativeImpl);
-	check(Context);
+	AddScreenshotAttachmentAsync(FScreenshotAttachedNativeDelegate::CreateUFunction(const_cast<UObject*>(OnAttached.GetUObject()), OnAttached.GetFunctionName()));
+}
 
+void USentrySubsystem::AddScreenshotAttachmentAsync(const FScreenshotAttachedNativeDelegate& OnAttached)
+{
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return nullptr;
+		OnAttached.ExecuteIfBound(false);
+		return;
 	}
 
-	if (!Context)
-	{
-		return nullptr;
-	}
+	const FString ScreenshotPath = SentryFileUtils::GetScreenshotPath();
 
-	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransactionWithContextAndOptions(Context->GetNativeObject(), Options);
-	if (!SentryTransaction)
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	SentryScreenshotUtils::CaptureScreenshotAsync(ScreenshotPath, [WeakThis, ScreenshotPath, OnAttached](bool bSaved)
 	{
-		return nullptr;
-	}
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!bSaved || !Subsystem || !Subsystem->IsEnabled())
+		{
+			OnAttached.ExecuteIfBound(false);
+			return;
+		}
 
-	return USentryTransaction::Create(SentryTransaction);
+		Subsystem->AddAttachment(USentryLibrary::CreateSentryAttachmentWithPath(ScreenshotPath, FPaths::GetCleanFilename(ScreenshotPath), SentryScreenshotUtils::GetScreenshotContentType()));
+
+		OnAttached.ExecuteIfBound(true);
+	});
 }
 
-USentryTransactionContext* USentrySubsystem::ContinueTrace(const FString& SentryTrace, const TArray<FString>& BaggageHeaders)
+FString USentrySubsystem::CaptureMessage(const FString& Message, ESentryLevel Level)
 {
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Captures);
+
 	check(SubsystemNativeImpl);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (DeferUntilInitialized([this, Message, Level]() { CaptureMessage(Message, Level); }))
 	{
-		return nullptr;
+		return FString();
 	}
 
-	TSharedPtr<ISentryTransactionContext> SentryTransactionContext = SubsystemNativeImpl->ContinueTrace(SentryTrace, BaggageHeaders);
-	if (!SentryTransactionContext)
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return nullptr;
+		return FString();
 	}
 
-	return USentryTransactionContext::Create(SentryTransactionContext);
-}
+	if (IsCaptureSuppressed(Message, Level))
+	{
+		return FString();
+	}
 
-bool USentrySubsystem::IsSupportedForCurrentSettings() const
-{
-	if (!IsCurrentBuildConfigurationEnabled() || !IsCurrentBuildTargetEnabled())
+	FString QueuedEventId;
+	if (EnqueueCapture([Message, Level]()
 	{
-		return false;
+		TSharedPtr<ISentryEvent> NativeEvent = CreateSharedSentryEvent();
+		NativeEvent->SetMessage(Message);
+		NativeEvent->SetLevel(Level);
+		return NativeEvent;
+	}, QueuedEventId))
+	{
+		return QueuedEventId;
 	}
 
-	if (IsPromotedBuildsOnlyEnabled() && !FApp::GetEngineIsPromotedBuild())
+	FlushScope();
+
+	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureMessage(Message, Level);
+	if (!SentryId)
 	{
-		return false;
+		return FString();
 	}
 
-	return true;
+	TRACE_COUNTER_INCREMENT(SentryEventsCaptured);
+
+	return SentryId->ToString();
 }
 
-TSharedPtr<ISentrySubsystem> USentrySubsystem::GetNativeObject() const
+FString USentrySubsystem::CaptureMessageWithScope(const FString& Message, const FConfigureScopeDelegate& OnConfigureScope, ESentryLevel Level)
 {
-	return SubsystemNativeImpl;
+	return CaptureMessageWithScope(Message, FConfigureScopeNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureScope.GetUObject()), OnConfigureScope.GetFunctionName()), Level);
 }
 
-void USentrySubsystem::AddDefaultContext()
+FString USentrySubsystem::CaptureMessageWithScope(const FString& Message, const FConfigureScopeNativeDelegate& OnConfigureScope, ESentryLevel Level)
 {
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Captures);
+
 	check(SubsystemNativeImpl);
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	if (DeferUntilInitialized([this, Message, OnConfigureScope, Level]() { CaptureMessageWithScope(Message, OnConfigureScope, Level); }))
 	{
-		return;
+		return FString();
 	}
 
-	TMap<FString, FSentryVariant> DefaultContext;
-	DefaultContext.Add(TEXT("Engine version"), FEngineVersion::Current().ToString(EVersionComponent::Changelist));
-	DefaultContext.Add(TEXT("Plugin version"), FSentryModule::Get().GetPluginVersion());
-	DefaultContext.Add(TEXT("Is Marketplace version"), LexToString(FSentryModule::Get().IsMarketplaceVersion()));
-	DefaultContext.Add(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
-	DefaultContext.Add(TEXT("Target Type"), LexToString(FApp::GetBuildTargetType()));
-	DefaultContext.Add(TEXT("Engine mode"), FGenericPlatformMisc::GetEngineMode());
-	DefaultContext.Add(TEXT("Is game"), LexToString(FApp::IsGame()));
-	DefaultContext.Add(TEXT("Is standalone"), LexToString(FApp::IsStandalone()));
-	DefaultContext.Add(TEXT("Is unattended"), LexToString(FApp::IsUnattended()));
-	DefaultContext.Add(TEXT("Game name"), FApp::GetName());
-
-	SubsystemNativeImpl->SetContext(TEXT("Unreal Engine"), DefaultContext);
-}
-
-void USentrySubsystem::AddGpuContext()
-{
-	check(SubsystemNativeImpl);
-
 	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		return;
+		return FString();
 	}
 
-	FGPUDriverInfo GpuDriverInfo = FPlatformMisc::GetGPUDriverInfo(FPlatformMisc::GetPrimaryGPUBrand());
-
-	if (GpuDriverInfo.IsValid())
+	if (IsCaptureSuppressed(Message, Level))
 	{
-		TMap<FString, FSentryVariant> GpuContext;
-		GpuContext.Add(TEXT("name"), GpuDriverInfo.DeviceDescription);
-		GpuContext.Add(TEXT("vendor_name"), GpuDriverInfo.ProviderName);
-		GpuContext.Add(TEXT("driver_version"), GpuDriverInfo.UserDriverVersion);
-
-		SubsystemNativeImpl->SetContext(TEXT("gpu"), GpuContext);
+		return FString();
 	}
-}
 
-void USentrySubsystem::AddDeviceContext()
-{
-	check(SubsystemNativeImpl);
+	const auto ConfigureScopeLambda = FSentryScopeDelegate::CreateLambda([OnConfigureScope](TSharedPtr<ISentryScope> NativeScope)
+	{
+		USentryScope* UnrealScope = USentryScope::Create(NativeScope);
+		OnConfigureScope.ExecuteIfBound(UnrealScope);
+	});
 
-	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	FlushScope();
+
+	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureMessageWithScope(Message, Level, ConfigureScopeLambda);
+	if (!SentryId)
 	{
-		return;
+		return FString();
 	}
 
-	const FPlatformMemoryConstants& MemoryConstants = FPlatformMemory::GetConstants();
+	TRACE_COUNTER_INCREMENT(SentryEventsCaptured);
 
-	TMap<FString, FSentryVariant> DeviceContext;
-	DeviceContext.Add(TEXT("cpu_description"), FPlatformMisc::GetCPUBrand());
-	DeviceContext.Add(TEXT("number_of_cores"), FString::FromInt(FPlatformMisc::NumberOfCores()));
-	DeviceContext.Add(TEXT("number_of_cores_including_hyperthreads"), FString::FromInt(FPlatformMisc::NumberOfCoresIncludingHyperthreads()));
-	DeviceContext.Add(TEXT("physical_memory_size_gb"), FString::FromInt(MemoryConstants.TotalPhysicalGB));
-
-	SubsystemNativeImpl->SetContext(TEXT("device"), DeviceContext);
+	return SentryId->ToString();
 }
 
-void USentrySubsystem::PromoteTags()
+FString USentrySubsystem::CaptureEvent(USentryEvent* Event)
 {
-	check(SubsystemNativeImpl);
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Captures);
 
-	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
-	check(Settings);
+	check(SubsystemNativeImpl);
+	check(Event);
 
-	if (Settings->TagsPromotion.bPromoteBuildConfiguration)
+	if (!Event)
 	{
-		SubsystemNativeImpl->SetTag(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+		return FString();
 	}
 
-	if (Settings->TagsPromotion.bPromoteTargetType)
+	if (IsInitializingAsync() && DeferUntilInitialized([this, NativeEvent = Event->GetNativeObject()->Clone()]() { CaptureEvent(USentryEvent::Create(NativeEvent)); }))
 	{
-		SubsystemNativeImpl->SetTag(TEXT("Target Type"), LexToString(FApp::GetBuildTargetType()));
+		return FString();
 	}
 
-	if (Settings->TagsPromotion.bPromoteEngineMode)
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		SubsystemNativeImpl->SetTag(TEXT("Engine Mode"), FGenericPlatformMisc::GetEngineMode());
+		return FString();
 	}
 
-	if (Settings->TagsPromotion.bPromoteIsGame)
+	if (EventLimiter && IsCaptureSuppressed(Event->GetMessage(), Event->GetLevel()))
 	{
-		SubsystemNativeImpl->SetTag(TEXT("Is game"), LexToString(FApp::IsGame()));
+		return FString();
 	}
 
-	if (Settings->TagsPromotion.bPromoteIsStandalone)
+	// The queued capture gets a copy as the caller is free to keep modifying the event once this returns
+	FString QueuedEventId;
+	if (CanEnqueuePlatformCall() && EnqueueCapture([NativeEvent = Event->GetNativeObject()->Clone()]() { return NativeEvent; }, QueuedEventId))
 	{
-		SubsystemNativeImpl->SetTag(TEXT("Is standalone"), LexToString(FApp::IsStandalone()));
+		return QueuedEventId;
 	}
 
-	if (Settings->TagsPromotion.bPromoteIsUnattended)
+	FlushScope();
+
+	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureEvent(Event->GetNativeObject());
+	if (!SentryId)
 	{
-		SubsystemNativeImpl->SetTag(TEXT("Is unattended"), LexToString(FApp::IsUnattended()));
+		return FString();
 	}
+
+	TRACE_COUNTER_INCREMENT(SentryEventsCaptured);
+
+	return SentryId->ToString();
 }
 
-void USentrySubsystem::ConfigureBreadcrumbs()
+FString USentrySubsystem::CaptureEventWithScope(USentryEvent* Event, const FConfigureScopeDelegate& OnConfigureScope)
 {
-	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
-	check(Settings);
+	return CaptureEventWithScope(Event, FConfigureScopeNativeDelegate::CreateUFunction(const_cast<UObject*>(OnConfigureScope.GetUObject()), OnConfigureScope.GetFunctionName()));
+}
 
-	if (Settings->AutomaticBreadcrumbs.bOnMapLoadingStarted)
+FString USentrySubsystem::CaptureEventWithScope(USentryEvent* Event, const FConfigureScopeNativeDelegate& OnConfigureScope)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Captures);
+
+	check(SubsystemNativeImpl);
+	check(Event);
+
+	if (!Event)
 	{
-		PreLoadMapDelegate = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString& MapName)
-		{
-			AddBreadcrumbWithParams(TEXT("PreLoadMap"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Map"), MapName } }, ESentryLevel::Info);
-		});
+		return FString();
 	}
 
-	if (Settings->AutomaticBreadcrumbs.bOnMapLoaded)
+	if (IsInitializingAsync() && DeferUntilInitialized([this, NativeEvent = Event->GetNativeObject()->Clone(), OnConfigureScope]() { CaptureEventWithScope(USentryEvent::Create(NativeEvent), OnConfigureScope); }))
 	{
-		PostLoadMapDelegate = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld* World)
-		{
-			if (World)
-			{
-				AddBreadcrumbWithParams(TEXT("PostLoadMapWithWorld"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Map"), World->GetMapName() } }, ESentryLevel::Info);
-			}
-			else
-			{
-				AddBreadcrumbWithParams(TEXT("PostLoadMapWithWorld"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Error"), TEXT("Map load failed") } }, ESentryLevel::Error);
-			}
-		});
+		return FString();
 	}
 
-	if (Settings->AutomaticBreadcrumbs.bOnGameStateClassChanged)
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		GameStateChangedDelegate = FCoreDelegates::GameStateClassChanged.AddWeakLambda(this, [this](const FString& GameState)
-		{
-			AddBreadcrumbWithParams(TEXT("GameStateClassChanged"), TEXT("Unreal"), TEXT("Default"), { { TEXT("GameState"), GameState } }, ESentryLevel::Info);
-		});
+		return FString();
 	}
 
-	if (Settings->AutomaticBreadcrumbs.bOnUserActivityStringChanged)
+	if (EventLimiter && IsCaptureSuppressed(Event->GetMessage(), Event->GetLevel()))
 	{
-		UserActivityChangedDelegate = FCoreDelegates::UserActivityStringChanged.AddWeakLambda(this, [this](const FString& Activity)
-		{
-			AddBreadcrumbWithParams(TEXT("UserActivityStringChanged"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Activity"), Activity } }, ESentryLevel::Info);
-		});
+		return FString();
 	}
 
-	if (Settings->AutomaticBreadcrumbs.bOnGameSessionIDChanged)
+	const auto ConfigureScopeLambda = FSentryScopeDelegate::CreateLambda([OnConfigureScope](TSharedPtr<ISentryScope> NativeScope)
 	{
-		GameSessionIDChangedDelegate = FCoreDelegates::GameSessionIDChanged.AddWeakLambda(this, [this](const FString& SessionId)
-		{
-			AddBreadcrumbWithParams(TEXT("GameSessionIDChanged"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Session ID"), SessionId } }, ESentryLevel::Info);
-		});
+		USentryScope* UnrealScope = USentryScope::Create(NativeScope);
+		OnConfigureScope.ExecuteIfBound(UnrealScope);
+	});
+
+	FlushScope();
+
+	TSharedPtr<ISentryId> SentryId = SubsystemNativeImpl->CaptureEventWithScope(Event->GetNativeObject(), ConfigureScopeLambda);
+	if (!SentryId)
+	{
+		return FString();
 	}
+
+	TRACE_COUNTER_INCREMENT(SentryEventsCaptured);
+
+	return SentryId->ToString();
 }
 
-void USentrySubsystem::DisableAutomaticBreadcrumbs()
+FString USentrySubsystem::CaptureMessageForWorld(const UObject* WorldContextObject, const FString& Message, ESentryLevel Level)
 {
-	if (PreLoadMapDelegate.IsValid())
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
 	{
-		FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapDelegate);
+		return CaptureMessage(Message, Level);
 	}
 
-	if (PostLoadMapDelegate.IsValid())
+	return CaptureMessageWithScope(Message, FConfigureScopeNativeDelegate::CreateLambda([WorldScopes = WorldScopes, WorldKey](USentryScope* Scope)
 	{
-		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegate);
-	}
+		WorldScopes->Apply(WorldKey, Scope);
+	}), Level);
+}
 
-	if (GameStateChangedDelegate.IsValid())
+FString USentrySubsystem::CaptureEventForWorld(const UObject* WorldContextObject, USentryEvent* Event)
+{
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
 	{
-		FCoreDelegates::GameStateClassChanged.Remove(GameStateChangedDelegate);
+		return CaptureEvent(Event);
 	}
 
-	if (UserActivityChangedDelegate.IsValid())
+	return CaptureEventWithScope(Event, FConfigureScopeNativeDelegate::CreateLambda([WorldScopes = WorldScopes, WorldKey](USentryScope* Scope)
+	{
+		WorldScopes->Apply(WorldKey, Scope);
+	}));
+}
+
+void USentrySubsystem::CaptureFeedback(USentryFeedback* Feedback)
+{
+	SENTRY_STAT_SCOPE(Captures);
+
+	check(SubsystemNativeImpl);
+	check(Feedback);
+
+	if (!Feedback)
+	{
+		return;
+	}
+
+	if (DeferUntilInitialized([this, NativeFeedback = Feedback->GetNativeObject()]() { CaptureFeedback(USentryFeedback::Create(NativeFeedback)); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->CaptureFeedback(Feedback->GetNativeObject());
+}
+
+void USentrySubsystem::CaptureFeedbackWithParams(const FString& Message, const FString& Name, const FString& Email, const FString& EventId)
+{
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this, Message, Name, Email, EventId]() { CaptureFeedbackWithParams(Message, Name, Email, EventId); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	TSharedPtr<ISentryFeedback> Feedback = MakeShareable(new FPlatformSentryFeedback(Message));
+
+	if (!Name.IsEmpty())
+		Feedback->SetName(Name);
+	if (!Email.IsEmpty())
+		Feedback->SetContactEmail(Email);
+	if (!EventId.IsEmpty())
+		Feedback->SetAssociatedEvent(EventId);
+
+	SubsystemNativeImpl->CaptureFeedback(Feedback);
+}
+
+void USentrySubsystem::SetUser(USentryUser* User)
+{
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+	check(User);
+
+	if (!User)
+	{
+		return;
+	}
+
+	if (DeferUntilInitialized([this, NativeUser = User->GetNativeObject()]() { SetUser(USentryUser::Create(NativeUser)); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, NativeUser = User->GetNativeObject()]()
+	{
+		if (SubsystemNativeImpl && SubsystemNativeImpl->IsEnabled())
+		{
+			SubsystemNativeImpl->SetUser(NativeUser);
+		}
+	}))
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->SetUser(User->GetNativeObject());
+}
+
+void USentrySubsystem::RemoveUser()
+{
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this]() { RemoveUser(); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this]() { RemoveUser(); }))
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->RemoveUser();
+}
+
+void USentrySubsystem::SetContext(const FString& Key, const TMap<FString, FSentryVariant>& Values)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this, Key, Values]() { SetContext(Key, Values); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, Key, Values]() { SetContext(Key, Values); }))
+	{
+		return;
+	}
+
+	if (ScopeBatch)
+	{
+		ScopeBatch->SetContext(Key, Values);
+		return;
+	}
+
+	SubsystemNativeImpl->SetContext(Key, Values);
+}
+
+void USentrySubsystem::SetContextFromStruct(const FString& Key, const UScriptStruct* Struct, const void* StructData)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (!Struct || !StructData)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Context %s can't be set from an invalid struct."), *Key);
+		return;
+	}
+
+	// Deferred, queued and batched contexts outlive the struct, so they keep its values instead
+	if (IsInitializingAsync())
+	{
+		SetContext(Key, FSentryStructLayout::Get(Struct)->ToVariantMap(StructData));
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (ScopeBatch || CanEnqueuePlatformCall())
+	{
+		SetContext(Key, FSentryStructLayout::Get(Struct)->ToVariantMap(StructData));
+		return;
+	}
+
+	SubsystemNativeImpl->SetContextFromStruct(Key, Struct, StructData);
+}
+
+DEFINE_FUNCTION(USentrySubsystem::execK2_SetContextFromStruct)
+{
+	P_GET_PROPERTY(FStrProperty, Key);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	const void* StructData = Stack.MostRecentPropertyAddress;
+
+	P_FINISH;
+
+	if (!StructProperty || !StructData)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Context %s can't be set, the value isn't a struct."), *Key);
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	P_THIS->SetContextFromStruct(Key, StructProperty->Struct, StructData);
+	P_NATIVE_END;
+}
+
+void USentrySubsystem::SetTag(const FString& Key, const FString& Value)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this, Key, Value]() { SetTag(Key, Value); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, Key, Value]() { SetTag(Key, Value); }))
+	{
+		return;
+	}
+
+	if (ScopeBatch)
+	{
+		ScopeBatch->SetTag(Key, Value);
+		return;
+	}
+
+	SubsystemNativeImpl->SetTag(Key, Value);
+}
+
+void USentrySubsystem::SetTags(const TMap<FString, FString>& Tags)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this, Tags]() { SetTags(Tags); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled() || Tags.Num() == 0)
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, Tags]() { SetTags(Tags); }))
+	{
+		return;
+	}
+
+	if (ScopeBatch)
+	{
+		for (const auto& Tag : Tags)
+		{
+			ScopeBatch->SetTag(Tag.Key, Tag.Value);
+		}
+		return;
+	}
+
+	SubsystemNativeImpl->SetTags(Tags);
+}
+
+void USentrySubsystem::RemoveTag(const FString& Key)
+{
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this, Key]() { RemoveTag(Key); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, Key]() { RemoveTag(Key); }))
+	{
+		return;
+	}
+
+	if (ScopeBatch)
+	{
+		ScopeBatch->RemoveTag(Key);
+		return;
+	}
+
+	SubsystemNativeImpl->RemoveTag(Key);
+}
+
+void USentrySubsystem::SetWorldTag(const UObject* WorldContextObject, const FString& Key, const FString& Value)
+{
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
+	{
+		return;
+	}
+
+	WorldScopes->SetTag(WorldKey, Key, Value);
+}
+
+void USentrySubsystem::RemoveWorldTag(const UObject* WorldContextObject, const FString& Key)
+{
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
+	{
+		return;
+	}
+
+	WorldScopes->RemoveTag(WorldKey, Key);
+}
+
+void USentrySubsystem::SetWorldContext(const UObject* WorldContextObject, const FString& Key, const TMap<FString, FSentryVariant>& Values)
+{
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
+	{
+		return;
+	}
+
+	WorldScopes->SetContext(WorldKey, Key, Values);
+}
+
+void USentrySubsystem::RemoveWorldContext(const UObject* WorldContextObject, const FString& Key)
+{
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
+	{
+		return;
+	}
+
+	WorldScopes->RemoveContext(WorldKey, Key);
+}
+
+void USentrySubsystem::ClearWorldScope(const UObject* WorldContextObject)
+{
+	const FObjectKey WorldKey = GetWorldScopeKey(WorldContextObject);
+	if (!WorldScopes || WorldKey == FObjectKey())
+	{
+		return;
+	}
+
+	WorldScopes->Clear(WorldKey);
+}
+
+FObjectKey USentrySubsystem::GetWorldScopeKey(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("World scope can't be used without a world context."));
+		return FObjectKey();
+	}
+
+	return World;
+}
+
+void USentrySubsystem::SetLevel(ESentryLevel Level)
+{
+	SENTRY_STAT_SCOPE(ScopeMutations);
+
+	check(SubsystemNativeImpl);
+
+	if (DeferUntilInitialized([this, Level]() { SetLevel(Level); }))
+	{
+		return;
+	}
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (EnqueuePlatformCall([this, Level]() { SetLevel(Level); }))
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->SetLevel(Level);
+}
+
+void USentrySubsystem::StartSession()
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->StartSession();
+}
+
+void USentrySubsystem::EndSession()
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->EndSession();
+}
+
+void USentrySubsystem::RecordAggregatedSession(const FDateTime& StartedAt, ESentrySessionStatus Status)
+{
+	// Keep the aggregator alive in case the subsystem is closed from another thread in the meantime
+	TSharedPtr<FSentrySessionAggregator, ESPMode::ThreadSafe> PinnedSessionAggregator = SessionAggregator;
+	if (!PinnedSessionAggregator)
+	{
+		return;
+	}
+
+	PinnedSessionAggregator->Record(StartedAt, Status);
+}
+
+FSentryMetricKey USentrySubsystem::RegisterMetric(ESentryMetricType Type, const FString& Name, const FString& Unit, const TMap<FString, FString>& Tags)
+{
+	return FSentryMetrics::Get().Register(Type, Name, Unit, Tags);
+}
+
+void USentrySubsystem::RecordMetric(const FSentryMetricKey& Key, float Value)
+{
+	FSentryMetrics::Get().Record(Key, Value);
+}
+
+void USentrySubsystem::IncrementCounter(const FString& Name, float Value, const FString& Unit, const TMap<FString, FString>& Tags)
+{
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
+	{
+		Metrics.Record(Metrics.Register(ESentryMetricType::Counter, Name, Unit, Tags), Value);
+	}
+}
+
+void USentrySubsystem::SetGauge(const FString& Name, float Value, const FString& Unit, const TMap<FString, FString>& Tags)
+{
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
+	{
+		Metrics.Record(Metrics.Register(ESentryMetricType::Gauge, Name, Unit, Tags), Value);
+	}
+}
+
+void USentrySubsystem::AddDistributionSample(const FString& Name, float Value, const FString& Unit, const TMap<FString, FString>& Tags)
+{
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
+	{
+		Metrics.Record(Metrics.Register(ESentryMetricType::Distribution, Name, Unit, Tags), Value);
+	}
+}
+
+void USentrySubsystem::GiveUserConsent()
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->GiveUserConsent();
+}
+
+void USentrySubsystem::RevokeUserConsent()
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	SubsystemNativeImpl->RevokeUserConsent();
+}
+
+EUserConsent USentrySubsystem::GetUserConsent() const
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return EUserConsent::Unknown;
+	}
+
+	return SubsystemNativeImpl->GetUserConsent();
+}
+
+USentryTransaction* USentrySubsystem::StartTransaction(const FString& Name, const FString& Operation, bool BindToScope)
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransaction(Name, Operation, BindToScope);
+	if (!SentryTransaction)
+	{
+		return nullptr;
+	}
+
+	return USentryTransaction::Create(SentryTransaction);
+}
+
+USentryTransaction* USentrySubsystem::StartTransactionWithContext(USentryTransactionContext* Context, bool BindToScope)
+{
+	check(SubsystemNativeImpl);
+	check(Context);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return nullptr;
+	}
+
+	if (!Context)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransactionWithContext(Context->GetNativeObject(), BindToScope);
+	if (!SentryTransaction)
+	{
+		return nullptr;
+	}
+
+	return USentryTransaction::Create(SentryTransaction);
+}
+
+USentryTransaction* USentrySubsystem::StartTransactionWithContextAndTimestamp(USentryTransactionContext* Context, int64 Timestamp, bool BindToScope)
+{
+	check(SubsystemNativeImpl);
+	check(Context);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return nullptr;
+	}
+
+	if (!Context)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransactionWithContextAndTimestamp(Context->GetNativeObject(), Timestamp, BindToScope);
+	if (!SentryTransaction)
+	{
+		return nullptr;
+	}
+
+	return USentryTransaction::Create(SentryTransaction);
+}
+
+USentryTransaction* USentrySubsystem::StartTransactionWithContextAndOptions(USentryTransactionContext* Context, const FSentryTransactionOptions& Options)
+{
+	check(SubsystemNativeImpl);
+	check(Context);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return nullptr;
+	}
+
+	if (!Context)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<ISentryTransaction> SentryTransaction = SubsystemNativeImpl->StartTransactionWithContextAndOptions(Context->GetNativeObject(), Options);
+	if (!SentryTransaction)
+	{
+		return nullptr;
+	}
+
+	return USentryTransaction::Create(SentryTransaction);
+}
+
+USentryTransactionContext* USentrySubsystem::ContinueTrace(const FString& SentryTrace, const TArray<FString>& BaggageHeaders)
+{
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<ISentryTransactionContext> SentryTransactionContext = SubsystemNativeImpl->ContinueTrace(SentryTrace, BaggageHeaders);
+	if (!SentryTransactionContext)
+	{
+		return nullptr;
+	}
+
+	return USentryTransactionContext::Create(SentryTransactionContext);
+}
+
+void USentrySubsystem::TraceHttpRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, USentryTransaction* Parent)
+{
+	TSharedPtr<ISentryTransaction> ParentTransaction = Parent ? Parent->GetNativeObject() : MapPerformanceTransaction;
+
+	StartHttpRequestSpan(Request, ParentTransaction, nullptr);
+}
+
+void USentrySubsystem::TraceHttpRequestWithParentSpan(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, USentrySpan* Parent)
+{
+	if (!Parent)
+	{
+		TraceHttpRequest(Request);
+		return;
+	}
+
+	StartHttpRequestSpan(Request, nullptr, Parent->GetNativeObject());
+}
+
+void USentrySubsystem::StartHttpRequestSpan(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, TSharedPtr<ISentryTransaction> ParentTransaction, TSharedPtr<ISentrySpan> ParentSpan)
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	if (!Settings->EnableTracing || !Settings->EnableHttpTracing || !SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	if (ParentTransaction && ParentTransaction->IsFinished())
+	{
+		ParentTransaction = nullptr;
+	}
+
+	const FString Url = Request->GetURL();
+	const FString Description = SentryHttpTracing::GetSpanDescription(Request->GetVerb(), Url);
+
+	TSharedPtr<ISentrySpan> Span;
+	TSharedPtr<ISentryTransaction> StandaloneTransaction;
+
+	if (ParentSpan)
+	{
+		Span = ParentSpan->StartChild(TEXT("http.client"), Description, false);
+	}
+	else if (ParentTransaction)
+	{
+		Span = ParentTransaction->StartChildSpan(TEXT("http.client"), Description, false);
+	}
+	else
+	{
+		StandaloneTransaction = SubsystemNativeImpl->StartTransaction(Description, TEXT("http.client"), false);
+	}
+
+	if (!Span && !StandaloneTransaction)
+	{
+		return;
+	}
+
+	if (SentryHttpTracing::ShouldPropagate(Url, Settings->HttpTracePropagationTargets))
+	{
+		FString TraceHeaderName, TraceHeaderValue;
+		if (Span)
+		{
+			Span->GetTrace(TraceHeaderName, TraceHeaderValue);
+		}
+		else
+		{
+			StandaloneTransaction->GetTrace(TraceHeaderName, TraceHeaderValue);
+		}
+
+		if (!TraceHeaderName.IsEmpty())
+		{
+			Request->SetHeader(TraceHeaderName, TraceHeaderValue);
+
+			FString EndpointUrl, PublicKey;
+			SentryDsn::Parse(Settings->GetEffectiveDsn(), EndpointUrl, PublicKey);
+
+			const FString Baggage = SentryHttpTracing::GetBaggage(TraceHeaderValue, PublicKey, Settings->GetEffectiveRelease(), Settings->GetEffectiveEnvironment());
+			if (!Baggage.IsEmpty())
+			{
+				Request->AppendToHeader(TEXT("baggage"), Baggage);
+			}
+		}
+	}
+
+	// Request completion delegate is single-cast, so the one bound by the caller is invoked once the span is finished
+	FHttpRequestCompleteDelegate OriginalDelegate = Request->OnProcessRequestComplete();
+
+	Request->OnProcessRequestComplete().BindLambda([Span, StandaloneTransaction, OriginalDelegate](FHttpRequestPtr CompletedRequest, FHttpResponsePtr Response, bool bSucceeded)
+	{
+		TMap<FString, FSentryVariant> Data;
+		Data.Add(TEXT("method"), CompletedRequest ? CompletedRequest->GetVerb() : FString());
+		Data.Add(TEXT("success"), bSucceeded && Response.IsValid());
+		Data.Add(TEXT("request_content_length"), CompletedRequest ? CompletedRequest->GetContent().Num() : 0);
+
+		FString StatusCode;
+		if (Response)
+		{
+			StatusCode = FString::FromInt(Response->GetResponseCode());
+
+			Data.Add(TEXT("status_code"), Response->GetResponseCode());
+			Data.Add(TEXT("response_content_length"), Response->GetContent().Num());
+		}
+
+		if (Span)
+		{
+			Span->SetData(TEXT("http"), Data);
+			Span->SetTag(TEXT("http.status_code"), StatusCode.IsEmpty() ? TEXT("none") : StatusCode);
+			Span->Finish();
+		}
+
+		if (StandaloneTransaction)
+		{
+			StandaloneTransaction->SetData(TEXT("http"), Data);
+			StandaloneTransaction->SetTag(TEXT("http.status_code"), StatusCode.IsEmpty() ? TEXT("none") : StatusCode);
+			StandaloneTransaction->Finish();
+		}
+
+		OriginalDelegate.ExecuteIfBound(CompletedRequest, Response, bSucceeded);
+	});
+}
+
+bool USentrySubsystem::IsSupportedForCurrentSettings() const
+{
+	if (!IsCurrentBuildConfigurationEnabled() || !IsCurrentBuildTargetEnabled())
+	{
+		return false;
+	}
+
+	if (IsPromotedBuildsOnlyEnabled() && !FApp::GetEngineIsPromotedBuild())
+	{
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<ISentrySubsystem> USentrySubsystem::GetNativeObject() const
+{
+	return SubsystemNativeImpl;
+}
+
+void USentrySubsystem::AddDefaultContext()
+{
+	SENTRY_INIT_PHASE_SCOPE(AddDefaultContext);
+
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	TMap<FString, FSentryVariant> DefaultContext;
+	DefaultContext.Add(TEXT("Engine version"), FEngineVersion::Current().ToString(EVersionComponent::Changelist));
+	DefaultContext.Add(TEXT("Plugin version"), FSentryModule::Get().GetPluginVersion());
+	DefaultContext.Add(TEXT("Is Marketplace version"), LexToString(FSentryModule::Get().IsMarketplaceVersion()));
+	DefaultContext.Add(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+	DefaultContext.Add(TEXT("Target Type"), LexToString(FApp::GetBuildTargetType()));
+	DefaultContext.Add(TEXT("Engine mode"), FGenericPlatformMisc::GetEngineMode());
+	DefaultContext.Add(TEXT("Is game"), LexToString(FApp::IsGame()));
+	DefaultContext.Add(TEXT("Is standalone"), LexToString(FApp::IsStandalone()));
+	DefaultContext.Add(TEXT("Is unattended"), LexToString(FApp::IsUnattended()));
+	DefaultContext.Add(TEXT("Game name"), FApp::GetName());
+
+	SubsystemNativeImpl->SetStaticContext(TEXT("Unreal Engine"), DefaultContext);
+}
+
+void USentrySubsystem::AddHardwareContexts()
+{
+	SENTRY_INIT_PHASE_SCOPE(AddHardwareContexts);
+
+	check(SubsystemNativeImpl);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	const FString CachePath = SentryContextCache::GetCachePath();
+	const FString Fingerprint = SentryContextCache::GetFingerprint();
+
+	FSentryHardwareContexts CachedContexts;
+	if (!SentryContextCache::Load(CachePath, Fingerprint, CachedContexts))
+	{
+		const FSentryHardwareContexts Contexts = SentryContextCache::Probe();
+		SetHardwareContexts(SubsystemNativeImpl, Contexts);
+
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [CachePath, Fingerprint, Contexts]()
+		{
+			SentryContextCache::Save(CachePath, Fingerprint, Contexts);
+		});
+
+		return;
+	}
+
+	SetHardwareContexts(SubsystemNativeImpl, CachedContexts);
+
+	// Cached values are checked against fresh ones off the startup path so that a change is still reflected in the current session
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [NativeImpl = SubsystemNativeImpl, CachePath, Fingerprint, CachedContexts]()
+	{
+		const FSentryHardwareContexts Contexts = SentryContextCache::Probe();
+		if (Contexts == CachedContexts)
+		{
+			return;
+		}
+
+		if (NativeImpl->IsEnabled())
+		{
+			SetHardwareContexts(NativeImpl, Contexts);
+		}
+
+		SentryContextCache::Save(CachePath, Fingerprint, Contexts);
+	});
+}
+
+void USentrySubsystem::SetHardwareContexts(TSharedPtr<ISentrySubsystem> NativeImpl, const FSentryHardwareContexts& Contexts)
+{
+	auto ToVariantMap = [](const TMap<FString, FString>& Values)
+	{
+		TMap<FString, FSentryVariant> VariantValues;
+		for (const TPair<FString, FString>& Value : Values)
+		{
+			VariantValues.Add(Value.Key, Value.Value);
+		}
+		return VariantValues;
+	};
+
+	if (Contexts.Gpu.Num() > 0)
+	{
+		NativeImpl->SetStaticContext(TEXT("gpu"), ToVariantMap(Contexts.Gpu));
+	}
+
+	NativeImpl->SetStaticContext(TEXT("device"), ToVariantMap(Contexts.Device));
+}
+
+void USentrySubsystem::SendInitProfileTransaction()
+{
+#if USE_SENTRY_NATIVE
+	const TArray<FSentryInitPhase>& Phases = InitProfile.GetPhases();
+	if (Phases.Num() == 0)
+	{
+		return;
+	}
+
+	// Phases are timed with the monotonic clock while transactions expect microseconds since the Unix epoch
+	const int64 NowMicroseconds = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	auto ToTimestamp = [NowMicroseconds, NowSeconds](double Seconds)
+	{
+		return NowMicroseconds - static_cast<int64>((NowSeconds - Seconds) * 1000000.0);
+	};
+
+	double EndTime = Phases[0].EndTime;
+	for (const FSentryInitPhase& Phase : Phases)
+	{
+		EndTime = FMath::Max(EndTime, Phase.EndTime);
+	}
+
+	TSharedPtr<ISentryTransaction> Transaction = SubsystemNativeImpl->StartTransactionWithContextAndTimestamp(
+		CreateSharedSentryTransactionContext(TEXT("Sentry initialization"), TEXT("app.start.sentry")), ToTimestamp(Phases[0].StartTime), false);
+	if (!Transaction)
+	{
+		return;
+	}
+
+	for (const FSentryInitPhase& Phase : Phases)
+	{
+		if (TSharedPtr<ISentrySpan> Span = Transaction->StartChildSpanWithTimestamp(TEXT("app.start.sentry.phase"), Phase.Name, ToTimestamp(Phase.StartTime), false))
+		{
+			Span->FinishWithTimestamp(ToTimestamp(Phase.EndTime));
+		}
+	}
+
+	Transaction->FinishWithTimestamp(ToTimestamp(EndTime));
+#else
+	UE_LOG(LogSentrySdk, Log, TEXT("Sending the startup transaction is supported on Windows and Linux only."));
+#endif
+}
+
+void USentrySubsystem::ConfigureAppStartMeasurement()
+{
+	DisableAppStartMeasurement();
+
+	// Late or repeated initialization can't tell when the game has started anymore
+	if (GIsEditor || GFrameCounter > 1)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("App start measurement skipped since Sentry was initialized after the first frame."));
+		return;
+	}
+
+	const TArray<FSentryInitPhase>& Phases = InitProfile.GetPhases();
+
+	FSentryInitPhase InitPhase;
+	InitPhase.Name = TEXT("Sentry initialization");
+	for (const FSentryInitPhase& Phase : Phases)
+	{
+		InitPhase.StartTime = InitPhase.StartTime > 0.0 ? FMath::Min(InitPhase.StartTime, Phase.StartTime) : Phase.StartTime;
+		InitPhase.EndTime = FMath::Max(InitPhase.EndTime, Phase.EndTime);
+	}
+
+	bool bIsMapLoaded = false;
+	if (GEngine)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			bIsMapLoaded |= Context.WorldType == EWorldType::Game && Context.World() != nullptr && Context.World()->HasBegunPlay();
+		}
+	}
+
+	AppStart = MakeShared<FSentryAppStart>(GStartTime, FSentryModule::Get().GetStartupTime(), InitPhase, bIsMapLoaded);
+
+	AppStartPreLoadMapDelegate = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString& MapName)
+	{
+		if (AppStart)
+		{
+			AppStart->OnMapLoadStarted(FPlatformTime::Seconds(), MapName);
+		}
+	});
+
+	AppStartPostLoadMapDelegate = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld* World)
+	{
+		if (AppStart)
+		{
+			AppStart->OnMapLoadFinished(FPlatformTime::Seconds());
+		}
+	});
+
+	AppStartEndFrameDelegate = FCoreDelegates::OnEndFrame.AddWeakLambda(this, [this]()
+	{
+		if (AppStart && AppStart->OnFrameEnded(FPlatformTime::Seconds()))
+		{
+			FinishAppStartMeasurement();
+		}
+	});
+}
+
+void USentrySubsystem::DisableAppStartMeasurement()
+{
+	if (AppStartPreLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PreLoadMap.Remove(AppStartPreLoadMapDelegate);
+		AppStartPreLoadMapDelegate.Reset();
+	}
+
+	if (AppStartPostLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(AppStartPostLoadMapDelegate);
+		AppStartPostLoadMapDelegate.Reset();
+	}
+
+	if (AppStartEndFrameDelegate.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(AppStartEndFrameDelegate);
+		AppStartEndFrameDelegate.Reset();
+	}
+
+	AppStart = nullptr;
+}
+
+void USentrySubsystem::FinishAppStartMeasurement()
+{
+	// Measurement is released along with the hooks so keep it alive until it's reported
+	const TSharedPtr<FSentryAppStart> CompletedAppStart = AppStart;
+
+	DisableAppStartMeasurement();
+
+	if (!CompletedAppStart)
+	{
+		return;
+	}
+
+	const float TimeToFirstFrameMs = static_cast<float>(CompletedAppStart->GetTimeToFirstFrameMs());
+	const float TimeToInteractiveMs = static_cast<float>(CompletedAppStart->GetTimeToInteractiveMs());
+
+	UE_LOG(LogSentrySdk, Log, TEXT("App start took %.2f ms to the first frame and %.2f ms to the first map being interactive."), TimeToFirstFrameMs, TimeToInteractiveMs);
+
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
+	{
+		Metrics.Record(Metrics.Register(ESentryMetricType::Distribution, TEXT("app.start.first_frame"), TEXT("millisecond"), {}), TimeToFirstFrameMs);
+		Metrics.Record(Metrics.Register(ESentryMetricType::Distribution, TEXT("app.start.interactive"), TEXT("millisecond"), {}), TimeToInteractiveMs);
+	}
+
+#if USE_SENTRY_NATIVE
+	// Milestones are timed with the monotonic clock while transactions expect microseconds since the Unix epoch
+	const int64 NowMicroseconds = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	auto ToTimestamp = [NowMicroseconds, NowSeconds](double Seconds)
+	{
+		return NowMicroseconds - static_cast<int64>((NowSeconds - Seconds) * 1000000.0);
+	};
+
+	TSharedPtr<ISentryTransaction> Transaction = SubsystemNativeImpl->StartTransactionWithContextAndTimestamp(
+		CreateSharedSentryTransactionContext(TEXT("App start"), TEXT("app.start.cold")), ToTimestamp(CompletedAppStart->GetProcessStartTime()), false);
+	if (!Transaction)
+	{
+		return;
+	}
+
+	for (const FSentryInitPhase& Phase : CompletedAppStart->GetPhases())
+	{
+		if (TSharedPtr<ISentrySpan> Span = Transaction->StartChildSpanWithTimestamp(Phase.Name, Phase.Name, ToTimestamp(Phase.StartTime), false))
+		{
+			Span->FinishWithTimestamp(ToTimestamp(Phase.EndTime));
+		}
+	}
+
+	TMap<FString, FSentryVariant> AppStartData;
+	AppStartData.Add(TEXT("time_to_first_frame_ms"), TimeToFirstFrameMs);
+	AppStartData.Add(TEXT("time_to_interactive_ms"), TimeToInteractiveMs);
+	if (!CompletedAppStart->GetMapName().IsEmpty())
+	{
+		AppStartData.Add(TEXT("map"), CompletedAppStart->GetMapName());
+	}
+
+	Transaction->SetData(TEXT("app_start"), AppStartData);
+	Transaction->FinishWithTimestamp(ToTimestamp(CompletedAppStart->GetInteractiveTime()));
+#endif
+}
+
+void USentrySubsystem::UploadPendingCrashVideos()
+{
+	const FString CrashVideoDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"));
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	const int64 MaxBatchBytes = Settings->MaxAttachmentSize;
+	const int64 MaxPreviewBytes = Settings->UploadCrashVideoPreviewFirst ? static_cast<int64>(Settings->CrashVideoPreviewSizeKB) * 1024 : 0;
+	const int32 FullClipRetentionDays = Settings->CrashVideoFullClipRetentionDays;
+
+	// Raw frame rings of crashed sessions are encoded on a background thread which needs the image wrapper module loaded already
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	// Looking up persisted videos touches the disk so keep it off the game thread
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, CrashVideoDir, MaxBatchBytes, MaxPreviewBytes, FullClipRetentionDays]()
+	{
+		// Video of a crash recorded as raw frames is only encoded now, then goes through the same upload as any persisted video
+		FSentryCrashVideoRawRing::ClaimCrashedRing(FSentryCrashVideoRawRing::GetDefaultPath());
+		FSentryCrashVideoRawRing::ClaimCrashedRing(FSentryCrashVideoRawRing::GetLongTierPath(FSentryCrashVideoRawRing::GetDefaultPath()));
+
+		// Long tier of a crash is encoded into the same directory, so that both videos are uploaded together
+		TMap<FString, TArray<FString>> EncodedRingVideos;
+
+		for (const TPair<FString, FString>& ClaimedRing : FSentryCrashVideoRawRing::FindClaimedRings(CrashVideoDir))
+		{
+			const bool bIsLongTier = FSentryCrashVideoRawRing::IsLongTierRing(ClaimedRing.Key);
+
+			const FString VideoDir = FPaths::Combine(CrashVideoDir, FString::Printf(TEXT("RawFrames_%s"), *ClaimedRing.Value));
+			const FString VideoPath = FPaths::Combine(VideoDir, bIsLongTier ? TEXT("crash_video_long.avi") : TEXT("crash_video.avi"));
+
+			if (FSentryCrashVideoRawRing::EncodeRingFile(ClaimedRing.Key, VideoPath))
+			{
+				// Long tier covers the older footage so it goes first
+				TArray<FString>& Videos = EncodedRingVideos.FindOrAdd(ClaimedRing.Value);
+				Videos.Insert(VideoPath, bIsLongTier ? 0 : Videos.Num());
+			}
+
+			IFileManager::Get().Delete(*ClaimedRing.Key, false, true, true);
+		}
+
+		for (const TPair<FString, TArray<FString>>& EncodedRing : EncodedRingVideos)
+		{
+			const FString VideoDir = FPaths::Combine(CrashVideoDir, FString::Printf(TEXT("RawFrames_%s"), *EncodedRing.Key));
+			SentryCrashVideoPendingUpload::Persist(VideoDir, EncodedRing.Value, EncodedRing.Key);
+		}
+
+		TArray<FSentryPendingCrashVideo> PendingVideos = SentryCrashVideoPendingUpload::Collect(CrashVideoDir, FullClipRetentionDays);
+
+		for (const FSentryPendingCrashVideo& PendingVideo : PendingVideos)
+		{
+			// Rest of the clip waits for RequestFullCrashVideo
+			if (PendingVideo.bIsPreviewUploaded || !SentryCrashVideoPendingUpload::TryBeginUpload(PendingVideo))
+			{
+				continue;
+			}
+
+			const TArray<FString> Files = MaxPreviewBytes > 0 ? SentryCrashVideoPendingUpload::SelectPreview(PendingVideo, MaxPreviewBytes) : PendingVideo.Files;
+			SendPendingCrashVideo(WeakThis, PendingVideo, Files, MaxBatchBytes, Files.Num() < PendingVideo.Files.Num());
+		}
+	});
+}
+
+void USentrySubsystem::RequestFullCrashVideo(const FString& CrashEventId)
+{
+	if (!IsEnabled() || CrashEventId.IsEmpty())
+	{
+		return;
+	}
+
+	const FString CrashVideoDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"));
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	const int64 MaxBatchBytes = FSentryModule::Get().GetSettings()->MaxAttachmentSize;
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, CrashVideoDir, MaxBatchBytes, CrashEventId]()
+	{
+		for (const FSentryPendingCrashVideo& PendingVideo : SentryCrashVideoPendingUpload::Collect(CrashVideoDir))
+		{
+			if (PendingVideo.EventId == CrashEventId && PendingVideo.bIsPreviewUploaded)
+			{
+				if (!SentryCrashVideoPendingUpload::TryBeginUpload(PendingVideo))
+				{
+					break;
+				}
+
+				SendPendingCrashVideo(WeakThis, PendingVideo, PendingVideo.Files, MaxBatchBytes, false);
+				return;
+			}
+		}
+
+		UE_LOG(LogSentrySdk, Log, TEXT("No crash video awaiting the full clip upload for event %s"), *CrashEventId);
+	});
+}
+
+void USentrySubsystem::SendPendingCrashVideo(TWeakObjectPtr<USentrySubsystem> WeakThis, const FSentryPendingCrashVideo& PendingVideo, const TArray<FString>& Files, int64 MaxBatchBytes, bool bIsPreview)
+{
+	FSentryPendingCrashVideo FilesToSend = PendingVideo;
+	FilesToSend.Files = Files;
+
+	// Large videos are sent in several smaller events so a dropped connection only costs the part in flight
+	const TArray<TArray<FString>> Batches = SentryCrashVideoPendingUpload::SplitIntoBatches(FilesToSend, MaxBatchBytes);
+
+	// Sizes are needed for upload pacing, so they are looked up here rather than on the game thread
+	TArray<int64> BatchSizes;
+	for (const TArray<FString>& Batch : Batches)
+	{
+		int64& BatchSize = BatchSizes.Add_GetRef(0);
+		for (const FString& File : Batch)
+		{
+			BatchSize += FMath::Max<int64>(0, IFileManager::Get().FileSize(*File));
+		}
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [WeakThis, PendingVideo, Batches, BatchSizes, bIsPreview]()
+	{
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!Subsystem || !Subsystem->IsEnabled())
+		{
+			SentryCrashVideoPendingUpload::EndUpload(PendingVideo);
+			return;
+		}
+
+		// Upload progress is shared by all parts so every manifest update accounts for the parts sent before
+		TSharedRef<FSentryPendingCrashVideo> Progress = MakeShared<FSentryPendingCrashVideo>(PendingVideo);
+
+		const TCHAR* Title = bIsPreview ? TEXT("Crash video preview") : TEXT("Crash video");
+
+		for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+		{
+			const FString Message = Batches.Num() > 1
+				? FString::Printf(TEXT("%s (part %d/%d)"), Title, BatchIndex + 1, Batches.Num())
+				: FString(Title);
+
+			Subsystem->ScheduleUpload(BatchSizes[BatchIndex], [WeakThis, Progress, Batches, Batch = Batches[BatchIndex], Message, bIsPreview, IsLastBatch = BatchIndex == Batches.Num() - 1, NumBatches = Batches.Num()]()
+			{
+				USentrySubsystem* Subsystem = WeakThis.Get();
+				if (!Subsystem || !Subsystem->IsEnabled())
+				{
+					SentryCrashVideoPendingUpload::EndUpload(*Progress);
+					return;
+				}
+
+				Subsystem->CaptureMessageWithScope(Message, FConfigureScopeNativeDelegate::CreateLambda([&Progress, &Batch, bIsPreview](USentryScope* Scope)
+				{
+					Scope->SetTag(TEXT("crash_event_id"), Progress->EventId);
+
+					if (bIsPreview)
+					{
+						Scope->SetTag(TEXT("crash_video_preview"), TEXT("true"));
+					}
+
+					for (const FString& File : Batch)
+					{
+						const TCHAR* ContentType = File.EndsWith(TEXT(".mp4")) ? TEXT("video/mp4") : File.EndsWith(TEXT(".avi")) ? TEXT("video/x-msvideo") : TEXT("text/plain");
+						Scope->AddAttachment(USentryLibrary::CreateSentryAttachmentWithPath(File, FPaths::GetCleanFilename(File), ContentType));
+					}
+				}), ESentryLevel::Info);
+
+				if (bIsPreview)
+				{
+					// An interrupted preview is simply sent again on the next launch
+					if (IsLastBatch)
+					{
+						TArray<FString> PreviewFiles;
+						for (const TArray<FString>& PreviewBatch : Batches)
+						{
+							PreviewFiles.Append(PreviewBatch);
+						}
+
+						SentryCrashVideoPendingUpload::MarkPreviewUploaded(*Progress, PreviewFiles);
+						FSentryCrashVideoHistory::Get().ConfirmUpload(Progress->EventId, FDateTime::UtcNow().ToUnixTimestamp());
+
+						// Rest of the clip can be requested now
+						SentryCrashVideoPendingUpload::EndUpload(*Progress);
+
+						UE_LOG(LogSentrySdk, Log, TEXT("Uploaded crash video preview for event %s, the full clip is kept until requested"), *Progress->EventId);
+					}
+
+					return;
+				}
+
+				// Persist progress after every part so an interrupted upload resumes with the remaining files
+				SentryCrashVideoPendingUpload::MarkFilesUploaded(*Progress, Batch);
+
+				if (IsLastBatch)
+				{
+					FSentryCrashVideoHistory::Get().ConfirmUpload(Progress->EventId, FDateTime::UtcNow().ToUnixTimestamp());
+
+					UE_LOG(LogSentrySdk, Log, TEXT("Uploaded crash video for event %s in %d part(s)"), *Progress->EventId, NumBatches);
+				}
+			});
+		}
+	});
+}
+
+void USentrySubsystem::ScheduleUpload(int64 Size, TFunction<void()> Upload)
+{
+	check(IsInGameThread());
+
+	if (!UploadScheduler)
+	{
+		Upload();
+		return;
+	}
+
+	UploadScheduler->Schedule(Size, MoveTemp(Upload));
+}
+
+void USentrySubsystem::ConfigureUploadScheduler()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	UploadScheduler = MakeShared<FSentryUploadScheduler>(static_cast<int64>(Settings->MaxUploadBandwidthKBps) * 1024,
+		static_cast<int64>(Settings->LargeUploadThresholdKB) * 1024, Settings->DeferLargeUploadsDuringMatch);
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+	TWeakPtr<FSentryUploadScheduler> WeakUploadScheduler(UploadScheduler);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakThis, WeakUploadScheduler](float DeltaTime)
+	{
+		TSharedPtr<FSentryUploadScheduler> PinnedUploadScheduler = WeakUploadScheduler.Pin();
+		if (!PinnedUploadScheduler || !WeakThis.IsValid())
+		{
+			return false;
+		}
+
+		// Budget still has to be refilled while there is nothing to upload, the match state is only looked up when needed
+		const bool bHasPendingUploads = PinnedUploadScheduler->GetNumPending() > 0;
+
+		bool bIsTransportBackedUp = false;
+		if (bHasPendingUploads)
+		{
+			const FSentryTransportStats TransportStats = SentryTransportAccounting::GetStats();
+			bIsTransportBackedUp = TransportStats.bIsOffline || TransportStats.bIsRateLimited;
+		}
+
+		PinnedUploadScheduler->Tick(DeltaTime, bHasPendingUploads && IsNetworkedMatchInProgress(), bIsTransportBackedUp);
+
+		return true;
+	}));
+}
+
+bool USentrySubsystem::IsNetworkedMatchInProgress()
+{
+	if (!GEngine)
+	{
+		return false;
+	}
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		UWorld* World = Context.World();
+		UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		if (NetDriver && (NetDriver->ServerConnection || NetDriver->ClientConnections.Num() > 0))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool USentrySubsystem::MarkEnsureReported(const TCHAR* ErrorHist)
+{
+	// First line names the failed condition along with its file and line, the rest is the message and call stack
+	int32 LocationLength = 0;
+	while (ErrorHist[LocationLength] != TEXT('\0') && ErrorHist[LocationLength] != TEXT('\n'))
+	{
+		LocationLength++;
+	}
+
+	const uint32 LocationHash = FCrc::MemCrc32(ErrorHist, LocationLength * sizeof(TCHAR));
+
+	bool bIsAlreadyReported = false;
+
+	FScopeLock Lock(&ReportedEnsuresCriticalSection);
+	ReportedEnsureLocations.Add(LocationHash, &bIsAlreadyReported);
+
+	return !bIsAlreadyReported;
+}
+
+void USentrySubsystem::ReportEnsure(const FString& EnsureMessage, const TArray<uint64>& ProgramCounters)
+{
+	LLM_SCOPE_BYTAG(Sentry);
+	SENTRY_STAT_SCOPE(Captures);
+
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	FlushScope();
+
+	TSharedPtr<ISentryId> EnsureId = SubsystemNativeImpl->CaptureEnsure(TEXT("Ensure failed"), EnsureMessage.TrimStartAndEnd(), ProgramCounters);
+	TRACE_COUNTER_INCREMENT(SentryEventsCaptured);
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	if (Settings->AttachCrashVideo && Settings->AttachEnsureVideo && EnsureId)
+	{
+		// Video recorder is driven from the game thread
+		TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, EnsureEventId = EnsureId->ToString()]()
+		{
+			if (USentrySubsystem* Subsystem = WeakThis.Get())
+			{
+				Subsystem->CaptureEnsureVideo(EnsureEventId);
+			}
+		});
+	}
+
+	if (Settings->AttachServerReplayToEnsures && FSentryServerReplay::Get().IsActive() && EnsureId)
+	{
+		TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, EnsureEventId = EnsureId->ToString()]()
+		{
+			if (USentrySubsystem* Subsystem = WeakThis.Get())
+			{
+				Subsystem->CaptureEnsureServerReplay(EnsureEventId);
+			}
+		});
+	}
+}
+
+void USentrySubsystem::CaptureEnsureServerReplay(const FString& EnsureEventId)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const float MinInterval = FSentryModule::Get().GetSettings()->ServerReplayEnsureMinInterval;
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (LastEnsureServerReplayTime > 0.0 && CurrentTime - LastEnsureServerReplayTime < MinInterval)
+	{
+		return;
+	}
+
+	TArray<FString> Segments;
+	if (!FSentryServerReplay::Get().GetSegments(Segments))
+	{
+		return;
+	}
+
+	LastEnsureServerReplayTime = CurrentTime;
+
+	const FString SnapshotDir = FSentryServerReplay::GetSnapshotsDirectory();
+	const int32 MaxAttachmentSize = FSentryModule::Get().GetSettings()->MaxAttachmentSize;
+
+	// Segments are rotated into while the upload may still be deferred, so they're copied off the game thread first
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Segments, SnapshotDir, MaxAttachmentSize, EnsureEventId]()
+	{
+		TArray<int64> SegmentSizes;
+		int64 SegmentsSize = 0;
+
+		for (const FString& Segment : Segments)
+		{
+			const int64 SegmentSize = IFileManager::Get().FileSize(*Segment);
+			SegmentSizes.Add(SegmentSize);
+
+			if (SegmentSize > 0 && SegmentSize <= MaxAttachmentSize)
+			{
+				SegmentsSize += SegmentSize;
+			}
+		}
+
+		// Ensure storms would otherwise pile up copies faster than the upload scheduler sends them
+		FSentryServerReplay::Get().TrimSnapshots(SegmentsSize);
+
+		TArray<FString> Files;
+		int64 TotalSize = 0;
+
+		for (int32 Index = 0; Index < Segments.Num(); ++Index)
+		{
+			const int64 SegmentSize = SegmentSizes[Index];
+			if (SegmentSize <= 0 || SegmentSize > MaxAttachmentSize)
+			{
+				continue;
+			}
+
+			const FString File = FPaths::Combine(SnapshotDir, FString::Printf(TEXT("%s_%d.replay"), *EnsureEventId, Index));
+			if (IFileManager::Get().Copy(*File, *Segments[Index]) == COPY_OK)
+			{
+				Files.Add(File);
+				TotalSize += SegmentSize;
+			}
+		}
+
+		if (Files.Num() == 0)
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Files, TotalSize, EnsureEventId]()
+		{
+			USentrySubsystem* Subsystem = WeakThis.Get();
+			if (!Subsystem || !Subsystem->IsEnabled())
+			{
+				return;
+			}
+
+			Subsystem->ScheduleUpload(TotalSize, [WeakThis, Files, EnsureEventId]()
+			{
+				USentrySubsystem* Subsystem = WeakThis.Get();
+				if (!Subsystem || !Subsystem->IsEnabled())
+				{
+					return;
+				}
+
+				Subsystem->CaptureMessageWithScope(TEXT("Server replay"), FConfigureScopeNativeDelegate::CreateLambda([&Files, &EnsureEventId](USentryScope* Scope)
+				{
+					Scope->SetTag(TEXT("related_event_id"), EnsureEventId);
+
+					for (const FString& File : Files)
+					{
+						Scope->AddAttachment(USentryLibrary::CreateSentryAttachmentWithPath(File, FPaths::GetCleanFilename(File), TEXT("application/octet-stream")));
+					}
+				}), ESentryLevel::Info);
+
+				UE_LOG(LogSentrySdk, Log, TEXT("Server replay sent to Sentry (%d segment(s))."), Files.Num());
+			});
+		});
+	});
+}
+
+void USentrySubsystem::CaptureEnsureVideo(const FString& EnsureEventId)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const float MinInterval = FSentryModule::Get().GetSettings()->EnsureVideoMinInterval;
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (LastEnsureVideoTime > 0.0 && CurrentTime - LastEnsureVideoTime < MinInterval)
+	{
+		return;
+	}
+
+	// Clips are recorded by the SentryVideo module, which isn't loaded in every target
+	ISentryCrashVideoCapture* CrashVideoCapture = FSentryModule::GetCrashVideoCapture();
+	if (!CrashVideoCapture)
+	{
+		return;
+	}
+
+	if (CrashVideoCapture->CaptureSnapshotClip(EnsureEventId))
+	{
+		LastEnsureVideoTime = CurrentTime;
+	}
+}
+
+void USentrySubsystem::PromoteTags()
+{
+	SENTRY_INIT_PHASE_SCOPE(PromoteTags);
+
+	check(SubsystemNativeImpl);
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	if (Settings->TagsPromotion.bPromoteBuildConfiguration)
+	{
+		SubsystemNativeImpl->SetStaticTag(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+	}
+
+	if (Settings->TagsPromotion.bPromoteTargetType)
+	{
+		SubsystemNativeImpl->SetStaticTag(TEXT("Target Type"), LexToString(FApp::GetBuildTargetType()));
+	}
+
+	if (Settings->TagsPromotion.bPromoteEngineMode)
+	{
+		SubsystemNativeImpl->SetStaticTag(TEXT("Engine Mode"), FGenericPlatformMisc::GetEngineMode());
+	}
+
+	if (Settings->TagsPromotion.bPromoteIsGame)
+	{
+		SubsystemNativeImpl->SetStaticTag(TEXT("Is game"), LexToString(FApp::IsGame()));
+	}
+
+	if (Settings->TagsPromotion.bPromoteIsStandalone)
+	{
+		SubsystemNativeImpl->SetStaticTag(TEXT("Is standalone"), LexToString(FApp::IsStandalone()));
+	}
+
+	if (Settings->TagsPromotion.bPromoteIsUnattended)
+	{
+		SubsystemNativeImpl->SetStaticTag(TEXT("Is unattended"), LexToString(FApp::IsUnattended()));
+	}
+}
+
+void USentrySubsystem::ConfigureBreadcrumbs()
+{
+	SENTRY_INIT_PHASE_SCOPE(ConfigureBreadcrumbs);
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	if (Settings->AutomaticBreadcrumbs.bOnMapLoadingStarted)
+	{
+		PreLoadMapDelegate = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString& MapName)
+		{
+			AddBreadcrumbWithParams(TEXT("PreLoadMap"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Map"), MapName } }, ESentryLevel::Info);
+		});
+	}
+
+	if (Settings->AutomaticBreadcrumbs.bOnMapLoaded)
+	{
+		PostLoadMapDelegate = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld* World)
+		{
+			if (World)
+			{
+				AddBreadcrumbWithParams(TEXT("PostLoadMapWithWorld"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Map"), World->GetMapName() } }, ESentryLevel::Info);
+			}
+			else
+			{
+				AddBreadcrumbWithParams(TEXT("PostLoadMapWithWorld"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Error"), TEXT("Map load failed") } }, ESentryLevel::Error);
+			}
+		});
+	}
+
+	if (Settings->AutomaticBreadcrumbs.bOnGameStateClassChanged)
+	{
+		GameStateChangedDelegate = FCoreDelegates::GameStateClassChanged.AddWeakLambda(this, [this](const FString& GameState)
+		{
+			AddBreadcrumbWithParams(TEXT("GameStateClassChanged"), TEXT("Unreal"), TEXT("Default"), { { TEXT("GameState"), GameState } }, ESentryLevel::Info);
+		});
+	}
+
+	if (Settings->AutomaticBreadcrumbs.bOnUserActivityStringChanged)
+	{
+		UserActivityChangedDelegate = FCoreDelegates::UserActivityStringChanged.AddWeakLambda(this, [this](const FString& Activity)
+		{
+			AddBreadcrumbWithParams(TEXT("UserActivityStringChanged"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Activity"), Activity } }, ESentryLevel::Info);
+		});
+	}
+
+	if (Settings->AutomaticBreadcrumbs.bOnGameSessionIDChanged)
+	{
+		GameSessionIDChangedDelegate = FCoreDelegates::GameSessionIDChanged.AddWeakLambda(this, [this](const FString& SessionId)
+		{
+			AddBreadcrumbWithParams(TEXT("GameSessionIDChanged"), TEXT("Unreal"), TEXT("Default"), { { TEXT("Session ID"), SessionId } }, ESentryLevel::Info);
+		});
+	}
+}
+
+void USentrySubsystem::DisableAutomaticBreadcrumbs()
+{
+	if (PreLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapDelegate);
+	}
+
+	if (PostLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegate);
+	}
+
+	if (GameStateChangedDelegate.IsValid())
+	{
+		FCoreDelegates::GameStateClassChanged.Remove(GameStateChangedDelegate);
+	}
+
+	if (UserActivityChangedDelegate.IsValid())
 	{
 		FCoreDelegates::UserActivityStringChanged.Remove(UserActivityChangedDelegate);
 	}
 
-	if (GameSessionIDChangedDelegate.IsValid())
+	if (GameSessionIDChangedDelegate.IsValid())
+	{
+		FCoreDelegates::GameSessionIDChanged.Remove(GameSessionIDChangedDelegate);
+	}
+}
+
+bool USentrySubsystem::IsCurrentBuildConfigurationEnabled() const
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	switch (FApp::GetBuildConfiguration())
+	{
+	case EBuildConfiguration::Debug:
+		return Settings->EnableBuildConfigurations.bEnableDebug;
+	case EBuildConfiguration::DebugGame:
+		return Settings->EnableBuildConfigurations.bEnableDebugGame;
+	case EBuildConfiguration::Development:
+		return Settings->EnableBuildConfigurations.bEnableDevelopment;
+	case EBuildConfiguration::Shipping:
+		return Settings->EnableBuildConfigurations.bEnableShipping;
+	case EBuildConfiguration::Test:
+		return Settings->EnableBuildConfigurations.bEnableTest;
+	default:
+		return false;
+	}
+}
+
+bool USentrySubsystem::IsCurrentBuildTargetEnabled() const
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	switch (FApp::GetBuildTargetType())
+	{
+	case EBuildTargetType::Game:
+		return Settings->EnableBuildTargets.bEnableGame;
+	case EBuildTargetType::Server:
+		return Settings->EnableBuildTargets.bEnableServer;
+	case EBuildTargetType::Client:
+		return Settings->EnableBuildTargets.bEnableClient;
+	case EBuildTargetType::Editor:
+		return Settings->EnableBuildTargets.bEnableEditor;
+	case EBuildTargetType::Program:
+		return Settings->EnableBuildTargets.bEnableProgram;
+	default:
+		return false;
+	}
+}
+
+bool USentrySubsystem::IsPromotedBuildsOnlyEnabled() const
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	return Settings->EnableForPromotedBuildsOnly;
+}
+
+void USentrySubsystem::ConfigureOutputDevice()
+{
+	SENTRY_INIT_PHASE_SCOPE(ConfigureOutputDevice);
+
+	// Log ring is owned by the platform SDK which attaches its contents to events and crashes
+	OutputDevice = MakeShareable(new FSentryOutputDevice(SubsystemNativeImpl->GetLogRing()));
+	if (OutputDevice)
+	{
+		GLog->AddOutputDevice(OutputDevice.Get());
+		GLog->SerializeBacklog(OutputDevice.Get());
+	}
+}
+
+void USentrySubsystem::ConfigureErrorOutputDevice()
+{
+	SENTRY_INIT_PHASE_SCOPE(ConfigureErrorOutputDevice);
+
+	OutputDeviceError = MakeShareable(new FSentryErrorOutputDevice(GError));
+	if (OutputDeviceError)
+	{
+		OnAssertDelegate = OutputDeviceError->OnAssert.AddWeakLambda(this, [this](const FString& Message)
+		{
+			check(SubsystemNativeImpl);
+			FlushScope();
+			SubsystemNativeImpl->HandleAssert();
+		});
+		GError = OutputDeviceError.Get();
+	}
+}
+
+void USentrySubsystem::ConfigureScopeBatch()
+{
+	ScopeBatch = MakeShared<FSentryScopeBatch, ESPMode::ThreadSafe>();
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+	TWeakPtr<FSentryScopeBatch, ESPMode::ThreadSafe> WeakScopeBatch(ScopeBatch);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakThis, WeakScopeBatch](float DeltaTime)
+	{
+		TSharedPtr<FSentryScopeBatch, ESPMode::ThreadSafe> PinnedScopeBatch = WeakScopeBatch.Pin();
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!PinnedScopeBatch || !Subsystem)
+		{
+			return false;
+		}
+
+		if (PinnedScopeBatch->HasPendingChanges())
+		{
+			Subsystem->FlushScope();
+		}
+
+		return true;
+	}));
+}
+
+void USentrySubsystem::ConfigureEventLimiter()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	EventLimiter = MakeShared<FSentryEventLimiter, ESPMode::ThreadSafe>(Settings->MaxDuplicateEventsPerMinute, Settings->MaxEventsPerMinute);
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+	TWeakPtr<FSentryEventLimiter, ESPMode::ThreadSafe> WeakEventLimiter(EventLimiter);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakThis, WeakEventLimiter](float DeltaTime)
+	{
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!WeakEventLimiter.IsValid() || !Subsystem)
+		{
+			return false;
+		}
+
+		Subsystem->ReportSuppressedEvents();
+
+		return true;
+	}), 1.0f);
+}
+
+void USentrySubsystem::ConfigureSessionAggregation()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	TSharedPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> EnvelopeSender = FSentryEnvelopeSender::Create(Settings, SubsystemNativeImpl);
+	if (!EnvelopeSender)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Session aggregation is disabled."));
+		return;
+	}
+
+	SessionAggregator = MakeShared<FSentrySessionAggregator, ESPMode::ThreadSafe>(Settings->GetEffectiveRelease(), Settings->GetEffectiveEnvironment());
+	SessionAggregatorSender = EnvelopeSender;
+
+	TWeakPtr<FSentrySessionAggregator, ESPMode::ThreadSafe> WeakSessionAggregator(SessionAggregator);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakSessionAggregator, EnvelopeSender](float DeltaTime)
+	{
+		TSharedPtr<FSentrySessionAggregator, ESPMode::ThreadSafe> PinnedSessionAggregator = WeakSessionAggregator.Pin();
+		if (!PinnedSessionAggregator)
+		{
+			return false;
+		}
+
+		if (!PinnedSessionAggregator->IsEmpty())
+		{
+			EnvelopeSender->Send(PinnedSessionAggregator->TakeEnvelope(), TEXT("aggregated sessions"));
+		}
+
+		return true;
+	}), FMath::Max(10.0f, Settings->SessionAggregationFlushInterval));
+}
+
+void USentrySubsystem::ConfigureMetrics()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	MetricsSender = FSentryEnvelopeSender::Create(Settings, SubsystemNativeImpl);
+	if (!MetricsSender)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Metrics are disabled."));
+		return;
+	}
+
+	FSentryMetrics::Get().Start(Settings->GetEffectiveRelease(), Settings->GetEffectiveEnvironment());
+
+	TWeakPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> WeakMetricsSender(MetricsSender);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakMetricsSender](float DeltaTime)
+	{
+		TSharedPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> PinnedMetricsSender = WeakMetricsSender.Pin();
+		if (!PinnedMetricsSender)
+		{
+			return false;
+		}
+
+		PinnedMetricsSender->Send(FSentryMetrics::Get().TakeEnvelope(false), TEXT("metrics"));
+
+		return true;
+	}), FMath::Max(10.0f, Settings->MetricsFlushInterval));
+}
+
+bool USentrySubsystem::IsCaptureSuppressed(const FString& Message, ESentryLevel Level)
+{
+	// Keep the limiter alive in case the subsystem is closed from another thread in the meantime
+	TSharedPtr<FSentryEventLimiter, ESPMode::ThreadSafe> PinnedEventLimiter = EventLimiter;
+	if (!PinnedEventLimiter)
+	{
+		return false;
+	}
+
+	// Skips this function and the capture function calling it so that the innermost frames identify the call site
+	const TArray<uint64> ProgramCounters = SentryLogUtils::CaptureStackBackTrace(2, 7);
+
+	// Captures made from Blueprints all share the same native thunk frames, so the script stack is what tells them apart
+	FString ScriptCallstack;
+#if DO_BLUEPRINT_GUARD
+	ScriptCallstack = FFrame::GetScriptCallstack(true);
+#endif
+
+	return !PinnedEventLimiter->ShouldCapture(FSentryEventLimiter::GetFingerprint(Message, Level, ProgramCounters, ScriptCallstack), Message);
+}
+
+void USentrySubsystem::ReportSuppressedEvents()
+{
+	TSharedPtr<FSentryEventLimiter, ESPMode::ThreadSafe> PinnedEventLimiter = EventLimiter;
+	if (!PinnedEventLimiter || !SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	FString Summary;
+	if (PinnedEventLimiter->TakeSuppressedSummary(Summary))
+	{
+		SubsystemNativeImpl->CaptureMessage(Summary, ESentryLevel::Warning);
+	}
+}
+
+void USentrySubsystem::ConfigureMapPerformanceTransactions()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	MapPerformance = MakeShared<FSentryMapPerformance, ESPMode::ThreadSafe>(Settings->MapPerformanceHitchThresholdMs);
+
+	MapPerformancePreLoadMapDelegate = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString& MapName)
+	{
+		FinishMapPerformanceTransaction();
+	});
+
+	MapPerformancePostLoadMapDelegate = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld* World)
+	{
+		if (World)
+		{
+			StartMapPerformanceTransaction(World->GetMapName());
+		}
+	});
+
+#if USE_SENTRY_NATIVE
+	if (Settings->EnableHitchSpans)
+	{
+		HitchDetector = MakeShared<FSentryHitchDetector, ESPMode::ThreadSafe>(GGameThreadId, Settings->HitchStackSamplingIntervalMs);
+	}
+#endif
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+	TWeakPtr<FSentryMapPerformance, ESPMode::ThreadSafe> WeakMapPerformance(MapPerformance);
+	const float HitchThresholdSeconds = Settings->MapPerformanceHitchThresholdMs / 1000.0f;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakThis, WeakMapPerformance, HitchThresholdSeconds](float DeltaTime)
+	{
+		TSharedPtr<FSentryMapPerformance, ESPMode::ThreadSafe> PinnedMapPerformance = WeakMapPerformance.Pin();
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!PinnedMapPerformance || !Subsystem)
+		{
+			return false;
+		}
+
+		PinnedMapPerformance->SampleFrame(DeltaTime);
+
+		if (HitchThresholdSeconds > 0.0f && DeltaTime >= HitchThresholdSeconds)
+		{
+			Subsystem->AddHitchSpan(DeltaTime);
+		}
+
+		return true;
+	}));
+}
+
+void USentrySubsystem::DisableMapPerformanceTransactions()
+{
+	if (MapPerformancePreLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PreLoadMap.Remove(MapPerformancePreLoadMapDelegate);
+		MapPerformancePreLoadMapDelegate.Reset();
+	}
+
+	if (MapPerformancePostLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(MapPerformancePostLoadMapDelegate);
+		MapPerformancePostLoadMapDelegate.Reset();
+	}
+
+	FinishMapPerformanceTransaction();
+
+	MapPerformance = nullptr;
+	HitchDetector = nullptr;
+}
+
+void USentrySubsystem::ConfigureAppHangTracking()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	// Reported from the watchdog thread, the native SDK is safe to capture from any thread
+	HangWatchdog = MakeShared<FSentryHangWatchdog, ESPMode::ThreadSafe>(Settings->AppHangTimeoutSeconds, Settings->RenderThreadHangTimeoutSeconds, Settings->RHIThreadHangTimeoutSeconds,
+		FSentryOnHangDetected::CreateLambda([WeakThis](const FSentryHangReport& Report)
+		{
+			USentrySubsystem* Subsystem = WeakThis.Get();
+			if (!Subsystem || !Subsystem->SubsystemNativeImpl || !Subsystem->SubsystemNativeImpl->IsEnabled())
+			{
+				return;
+			}
+
+			UE_LOG(LogSentrySdk, Warning, TEXT("%s has been unresponsive for %.1f seconds, reporting an app hang."), *Report.GetCulprit().Name, Report.GetCulprit().StalledSeconds);
+
+			Subsystem->SubsystemNativeImpl->CaptureAppHang(Report);
+		}));
+
+	// Blocking map loads stall the game thread by design and usually flush rendering commands repeatedly
+	AppHangPreLoadMapDelegate = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString& MapName)
+	{
+		if (HangWatchdog)
+		{
+			HangWatchdog->Suspend();
+		}
+	});
+
+	AppHangPostLoadMapDelegate = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld* World)
+	{
+		if (HangWatchdog)
+		{
+			HangWatchdog->Resume();
+		}
+	});
+
+	TWeakPtr<FSentryHangWatchdog, ESPMode::ThreadSafe> WeakHangWatchdog(HangWatchdog);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakHangWatchdog](float DeltaTime)
+	{
+		TSharedPtr<FSentryHangWatchdog, ESPMode::ThreadSafe> PinnedHangWatchdog = WeakHangWatchdog.Pin();
+		if (!PinnedHangWatchdog)
+		{
+			return false;
+		}
+
+		PinnedHangWatchdog->Heartbeat();
+		return true;
+	}));
+}
+
+void USentrySubsystem::DisableAppHangTracking()
+{
+	if (AppHangPreLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PreLoadMap.Remove(AppHangPreLoadMapDelegate);
+		AppHangPreLoadMapDelegate.Reset();
+	}
+
+	if (AppHangPostLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(AppHangPostLoadMapDelegate);
+		AppHangPostLoadMapDelegate.Reset();
+	}
+
+	// Waits for a hang that is being reported to be captured before the SDK is closed
+	HangWatchdog = nullptr;
+}
+
+namespace SentryMemoryBreadcrumbs
+{
+	static void Add(ESentryMemoryEvent Event, const FSentryMemorySample& Sample)
+	{
+		const int32 PeakPercent = Sample.TotalPhysical > 0 ? static_cast<int32>(Sample.PeakUsedPhysical * 100 / Sample.TotalPhysical) : 0;
+
+		const auto MakeData = [&Sample]()
+		{
+			TMap<FString, FSentryVariant> Data;
+			Data.Add(TEXT("Used physical (MB)"), static_cast<int32>(Sample.UsedPhysical / (1024 * 1024)));
+			Data.Add(TEXT("Available physical (MB)"), static_cast<int32>(Sample.AvailablePhysical / (1024 * 1024)));
+			Data.Add(TEXT("Used virtual (MB)"), static_cast<int32>(Sample.UsedVirtual / (1024 * 1024)));
+			Data.Add(TEXT("Peak used physical (MB)"), static_cast<int32>(Sample.PeakUsedPhysical / (1024 * 1024)));
+			return Data;
+		};
+
+		switch (Event)
+		{
+		case ESentryMemoryEvent::WatermarkReached:
+			SENTRY_BREADCRUMB_DATA(Info, TEXT("Memory"), FString::Printf(TEXT("Memory usage peaked at %d%% of physical memory"), PeakPercent), MakeData());
+			break;
+		case ESentryMemoryEvent::LowMemory:
+			SENTRY_BREADCRUMB_DATA(Warning, TEXT("Memory"), TEXT("Low memory"), MakeData());
+			break;
+		case ESentryMemoryEvent::MemoryRecovered:
+			SENTRY_BREADCRUMB_DATA(Info, TEXT("Memory"), TEXT("Memory recovered"), MakeData());
+			break;
+		case ESentryMemoryEvent::MemoryTrim:
+			SENTRY_BREADCRUMB_DATA(Warning, TEXT("Memory"), TEXT("Memory trim requested"), MakeData());
+			break;
+		}
+	}
+}
+
+void USentrySubsystem::ConfigureMemorySampling()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	FSentryMemorySampler::Get().Start(Settings->MemorySamplingIntervalSeconds, Settings->LowMemoryThresholdPercent, Settings->MemorySamplingTopTags,
+		FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryMemory"), TEXT("memory_sample.bin")),
+		FSentryOnMemoryEvent::CreateStatic(&SentryMemoryBreadcrumbs::Add));
+
+	if (Settings->ReportOutOfMemoryOnNextLaunch)
+	{
+		ReportPreviousSessionOutOfMemory();
+	}
+}
+
+void USentrySubsystem::ReportPreviousSessionOutOfMemory()
+{
+	FSentryMemorySample PreviousSample;
+	if (!FSentryMemorySampler::Get().GetPreviousSessionSample(PreviousSample) || !PreviousSample.bIsUnderMemoryPressure)
+	{
+		return;
+	}
+
+	// Crash handler reports crashes itself, a session that vanished without one while low on memory was most likely killed by the OS
+	if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled() || SubsystemNativeImpl->IsCrashedLastRun() == ESentryCrashedLastRun::Crashed)
+	{
+		return;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Previous session was terminated while low on memory after %.0f seconds, reporting it as out of memory."), PreviousSample.SessionSeconds);
+
+	SubsystemNativeImpl->CaptureMessageWithScope(TEXT("Out of memory"), ESentryLevel::Fatal, FSentryScopeDelegate::CreateLambda([Context = PreviousSample.ToContext()](TSharedPtr<ISentryScope> Scope)
+	{
+		Scope->SetContext(TEXT("memory"), Context);
+		Scope->SetTag(TEXT("out_of_memory"), TEXT("true"));
+	}));
+}
+
+void USentrySubsystem::ConfigureDeviceConditionsSampling()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	FSentryDeviceConditionsSampler::Get().Start(Settings->DeviceConditionsSamplingIntervalSeconds,
+		FSentryQueryDeviceConditions::CreateLambda([WeakThis](FSentryDeviceConditions& OutConditions)
+		{
+			USentrySubsystem* Subsystem = WeakThis.Get();
+			return Subsystem && Subsystem->SubsystemNativeImpl && Subsystem->SubsystemNativeImpl->IsEnabled() && Subsystem->SubsystemNativeImpl->GetDeviceConditions(OutConditions);
+		}),
+		FSentryOnDeviceConditionsChanged::CreateLambda([WeakThis](const FSentryDeviceConditions& Previous, const FSentryDeviceConditions& Current)
+		{
+			USentrySubsystem* Subsystem = WeakThis.Get();
+			if (!Subsystem || !Subsystem->SubsystemNativeImpl)
+			{
+				return;
+			}
+
+			Subsystem->SubsystemNativeImpl->SetContext(TEXT("device_conditions"), FSentryDeviceConditionsSampler::Get().ToContext());
+
+			if (Previous.ThermalState != Current.ThermalState && Previous.ThermalState != ESentryThermalState::Unknown)
+			{
+				TMap<FString, FSentryVariant> Data;
+				Data.Add(TEXT("Previous"), FSentryDeviceConditions::ThermalStateToString(Previous.ThermalState));
+				Data.Add(TEXT("Current"), FSentryDeviceConditions::ThermalStateToString(Current.ThermalState));
+
+				const FString Message = FString::Printf(TEXT("Thermal state changed to %s"), *FSentryDeviceConditions::ThermalStateToString(Current.ThermalState));
+				if (Current.bIsThrottled)
+				{
+					SENTRY_BREADCRUMB_DATA(Warning, TEXT("Device"), Message, Data);
+				}
+				else
+				{
+					SENTRY_BREADCRUMB_DATA(Info, TEXT("Device"), Message, Data);
+				}
+			}
+		}));
+}
+
+void USentrySubsystem::ConfigureLoadTransactions()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	LoadTracker = MakeShared<FSentryLoadTracker>(Settings->AsyncLoadSpanThresholdMs, [WeakThis](const FSentryLoadTracker::FLoad& Load)
+	{
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!Subsystem || !Subsystem->SubsystemNativeImpl || !Subsystem->SubsystemNativeImpl->IsEnabled())
+		{
+			return;
+		}
+
+		// Phases are timed with the monotonic clock while transactions expect microseconds since the Unix epoch
+		const int64 NowMicroseconds = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+		const double NowSeconds = FPlatformTime::Seconds();
+
+		auto ToTimestamp = [NowMicroseconds, NowSeconds](double Seconds)
+		{
+			return NowMicroseconds - static_cast<int64>((NowSeconds - Seconds) * 1000000.0);
+		};
+
+		TSharedPtr<ISentryTransaction> Transaction = Subsystem->SubsystemNativeImpl->StartTransactionWithContextAndTimestamp(
+			CreateSharedSentryTransactionContext(Load.Name, TEXT("map.load")), ToTimestamp(Load.StartTime), false);
+		if (!Transaction)
+		{
+			return;
+		}
+
+		for (const FSentryLoadTracker::FSpan& Phase : Load.Spans)
+		{
+			if (TSharedPtr<ISentrySpan> Span = Transaction->StartChildSpanWithTimestamp(Phase.Operation, Phase.Description, ToTimestamp(Phase.StartTime), false))
+			{
+				Span->FinishWithTimestamp(ToTimestamp(Phase.EndTime));
+			}
+		}
+
+		Transaction->SetData(TEXT("load"), { { TEXT("duration_ms"), static_cast<float>((Load.EndTime - Load.StartTime) * 1000.0) }, { TEXT("spans"), Load.Spans.Num() } });
+		Transaction->FinishWithTimestamp(ToTimestamp(Load.EndTime));
+	});
+
+	LoadTrackerPreLoadMapDelegate = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString& MapName)
+	{
+		if (LoadTracker)
+		{
+			LoadTracker->OnPreLoadMap(MapName);
+		}
+	});
+
+	LoadTrackerPostLoadMapDelegate = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld* World)
+	{
+		if (LoadTracker)
+		{
+			LoadTracker->OnPostLoadMap(World);
+		}
+	});
+
+	TWeakPtr<FSentryLoadTracker> WeakLoadTracker(LoadTracker);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakLoadTracker](float DeltaTime)
+	{
+		TSharedPtr<FSentryLoadTracker> PinnedLoadTracker = WeakLoadTracker.Pin();
+		if (!PinnedLoadTracker)
+		{
+			return false;
+		}
+
+		PinnedLoadTracker->Tick();
+
+		return true;
+	}));
+}
+
+void USentrySubsystem::DisableLoadTransactions()
+{
+	if (LoadTrackerPreLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PreLoadMap.Remove(LoadTrackerPreLoadMapDelegate);
+		LoadTrackerPreLoadMapDelegate.Reset();
+	}
+
+	if (LoadTrackerPostLoadMapDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(LoadTrackerPostLoadMapDelegate);
+		LoadTrackerPostLoadMapDelegate.Reset();
+	}
+
+	// Load in progress is dropped since its end can't be told anymore
+	LoadTracker = nullptr;
+}
+
+void USentrySubsystem::ConfigureFrameBreakdownTransactions()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	// Sampled frames are rare enough for the few span wrappers of their transactions not to matter
+	FrameBreakdown = MakeShared<FSentryFrameBreakdown>(Settings->FrameBreakdownSampleInterval, [WeakThis](const FSentryFrameBreakdown::FFrame& Frame)
+	{
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!Subsystem || !Subsystem->SubsystemNativeImpl || !Subsystem->SubsystemNativeImpl->IsEnabled())
+		{
+			return;
+		}
+
+		const int64 NowMicroseconds = FSentryMonotonicClock::GetProcessTimestamp();
+		const double NowSeconds = FPlatformTime::Seconds();
+
+		auto ToTimestamp = [NowMicroseconds, NowSeconds](double Seconds)
+		{
+			return NowMicroseconds - static_cast<int64>((NowSeconds - Seconds) * 1000000.0);
+		};
+
+		TSharedPtr<ISentryTransaction> Transaction = Subsystem->SubsystemNativeImpl->StartTransactionWithContextAndTimestamp(
+			CreateSharedSentryTransactionContext(Frame.MapName.IsEmpty() ? TEXT("Frame") : FString::Printf(TEXT("Frame: %s"), *Frame.MapName), TEXT("game.frame")),
+			ToTimestamp(Frame.StartTime), false);
+		if (!Transaction)
+		{
+			return;
+		}
+
+		// Tick groups are nested within the world tick, which comes first
+		TSharedPtr<ISentrySpan> WorldTickSpan;
+		for (const FSentryFrameBreakdown::FSpan& TickSpan : Frame.TickSpans)
+		{
+			TSharedPtr<ISentrySpan> Span = WorldTickSpan
+				? WorldTickSpan->StartChildWithTimestamp(TickSpan.Operation, TickSpan.Description, ToTimestamp(TickSpan.StartTime), false)
+				: Transaction->StartChildSpanWithTimestamp(TickSpan.Operation, TickSpan.Description, ToTimestamp(TickSpan.StartTime), false);
+			if (!Span)
+			{
+				break;
+			}
+
+			if (!WorldTickSpan)
+			{
+				WorldTickSpan = Span;
+				continue;
+			}
+
+			Span->FinishWithTimestamp(ToTimestamp(TickSpan.EndTime));
+		}
+
+		if (WorldTickSpan)
+		{
+			WorldTickSpan->FinishWithTimestamp(ToTimestamp(Frame.TickSpans[0].EndTime));
+		}
+
+		// Other threads only report how long they were busy with the frame, so their spans start with it
+		const TPair<const TCHAR*, float> ThreadTimes[] = {
+			{ TEXT("render.thread"), Frame.RenderThreadMs },
+			{ TEXT("rhi.thread"), Frame.RhiThreadMs },
+			{ TEXT("gpu.frame"), Frame.GpuMs }
+		};
+
+		for (const TPair<const TCHAR*, float>& ThreadTime : ThreadTimes)
+		{
+			if (ThreadTime.Value <= 0.0f)
+			{
+				continue;
+			}
+
+			if (TSharedPtr<ISentrySpan> Span = Transaction->StartChildSpanWithTimestamp(ThreadTime.Key, FString::Printf(TEXT("%.2f ms"), ThreadTime.Value), ToTimestamp(Frame.StartTime), false))
+			{
+				Span->FinishWithTimestamp(ToTimestamp(Frame.StartTime) + static_cast<int64>(ThreadTime.Value * 1000.0f));
+			}
+		}
+
+		Transaction->SetData(TEXT("frame"), {
+			{ TEXT("number"), static_cast<int32>(Frame.FrameNumber) },
+			{ TEXT("frame_ms"), static_cast<float>((Frame.EndTime - Frame.StartTime) * 1000.0) },
+			{ TEXT("game_thread_ms"), Frame.GameThreadMs },
+			{ TEXT("render_thread_ms"), Frame.RenderThreadMs },
+			{ TEXT("rhi_thread_ms"), Frame.RhiThreadMs },
+			{ TEXT("gpu_ms"), Frame.GpuMs }
+		});
+
+		Transaction->FinishWithTimestamp(ToTimestamp(Frame.EndTime));
+	});
+}
+
+void USentrySubsystem::DisableFrameBreakdownTransactions()
+{
+	FrameBreakdown = nullptr;
+}
+
+void USentrySubsystem::StartMapPerformanceTransaction(const FString& MapName)
+{
+	if (!MapPerformance || !SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+	{
+		return;
+	}
+
+	// Not every map change goes through PreLoadMap (e.g. seamless travel), so the previous session may still be open
+	FinishMapPerformanceTransaction();
+
+	MapPerformance->Begin(MapName);
+	NumHitchSpans = 0;
+	NumPsoStallSpans = 0;
+	NumGcSpans = 0;
+	NumSyncFileIoSpans = 0;
+
+	MapPerformanceTransaction = SubsystemNativeImpl->StartTransaction(FString::Printf(TEXT("Map: %s"), *MapName), TEXT("game.map"), false);
+}
+
+void USentrySubsystem::FinishMapPerformanceTransaction()
+{
+	TSharedPtr<ISentryTransaction> Transaction = MoveTemp(MapPerformanceTransaction);
+	MapPerformanceTransaction = nullptr;
+
+	if (!Transaction || !MapPerformance || Transaction->IsFinished())
+	{
+		return;
+	}
+
+	for (const TPair<FString, TMap<FString, FSentryVariant>>& Data : MapPerformance->GetData())
+	{
+		Transaction->SetData(Data.Key, Data.Value);
+	}
+
+	Transaction->Finish();
+}
+
+void USentrySubsystem::AddHitchSpan(float DeltaSeconds)
+{
+	// Keeps a single hitchy map session from growing its transaction past what the server accepts
+	static constexpr int32 MaxHitchSpans = 100;
+
+	if (!HitchDetector || !MapPerformanceTransaction || NumHitchSpans >= MaxHitchSpans)
+	{
+		return;
+	}
+
+	++NumHitchSpans;
+
+	// Look a sample before and after the frame as well since the sampler isn't synchronized with frame boundaries
+	const double EndTime = FPlatformTime::Seconds();
+	const double StartTime = EndTime - DeltaSeconds;
+	TArray<FSentryHitchDetector::FStackSample> Samples = HitchDetector->GetSamples(StartTime - HitchDetector->GetSampleInterval(), EndTime);
+
+	const int64 EndTimestamp = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+	const int64 StartTimestamp = EndTimestamp - static_cast<int64>(DeltaSeconds * 1000000.0);
+
+	TWeakPtr<ISentryTransaction> WeakTransaction(MapPerformanceTransaction);
+
+	// Symbolication can take a while, so the span is added once it's done
+	Async(EAsyncExecution::ThreadPool, [WeakTransaction, Samples = MoveTemp(Samples), StartTimestamp, EndTimestamp, DeltaSeconds]()
+	{
+		TArray<FSentryVariant> Stacks;
+		for (const FSentryHitchDetector::FStackSample& Sample : Samples)
+		{
+			Stacks.Add(FString::Join(FSentryHitchDetector::Symbolicate(Sample.ProgramCounters), TEXT("\n")));
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakTransaction, Stacks = MoveTemp(Stacks), StartTimestamp, EndTimestamp, DeltaSeconds]()
+		{
+			TSharedPtr<ISentryTransaction> Transaction = WeakTransaction.Pin();
+			if (!Transaction || Transaction->IsFinished())
+			{
+				return;
+			}
+
+			const float DurationMs = DeltaSeconds * 1000.0f;
+
+			TSharedPtr<ISentrySpan> Span = Transaction->StartChildSpanWithTimestamp(TEXT("game.hitch"), FString::Printf(TEXT("Hitch (%.1f ms)"), DurationMs), StartTimestamp, false);
+			if (!Span)
+			{
+				return;
+			}
+
+			Span->SetData(TEXT("hitch"), { { TEXT("duration_ms"), DurationMs } });
+
+			if (Stacks.Num() > 0)
+			{
+				Span->SetData(TEXT("game_thread_stack"), { { TEXT("samples"), Stacks } });
+			}
+
+			Span->FinishWithTimestamp(EndTimestamp);
+		});
+	});
+}
+
+void USentrySubsystem::ConfigurePsoTracking()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	check(Settings);
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	FSentryPsoTracker::Get().Start(Settings->PsoStallSpanThresholdMs, FSentryOnPsoStall::CreateLambda([WeakThis](int32 NumMisses, float StallMs)
+	{
+		if (USentrySubsystem* Subsystem = WeakThis.Get())
+		{
+			Subsystem->AddPsoStallSpan(NumMisses, StallMs);
+		}
+	}));
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+
+	// Totals only change while PSOs are compiled, so the context is rewritten at most every few seconds and only if they did
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([WeakThis, LastFramesWithMisses = -1](float DeltaTime) mutable
+	{
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!Subsystem || !FSentryPsoTracker::Get().IsActive())
+		{
+			return false;
+		}
+
+		const FSentryPsoTracker::FStats Stats = FSentryPsoTracker::Get().GetStats();
+		if (Stats.FramesWithMisses != LastFramesWithMisses && Subsystem->SubsystemNativeImpl && Subsystem->SubsystemNativeImpl->IsEnabled())
+		{
+			LastFramesWithMisses = Stats.FramesWithMisses;
+			Subsystem->SubsystemNativeImpl->SetContext(TEXT("pso"), FSentryPsoTracker::ToContext(Stats));
+		}
+
+		return true;
+	}), 5.0f);
+}
+
+void USentrySubsystem::AddPsoStallSpan(int32 NumMisses, float StallMs)
+{
+	// Shaders of a new area tend to be compiled in bursts, which shouldn't grow the transaction past what the server accepts
+	static constexpr int32 MaxPsoStallSpans = 100;
+
+	if (!MapPerformanceTransaction || MapPerformanceTransaction->IsFinished() || NumPsoStallSpans >= MaxPsoStallSpans)
+	{
+		return;
+	}
+
+	++NumPsoStallSpans;
+
+	const int64 EndTimestamp = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+	const int64 StartTimestamp = EndTimestamp - static_cast<int64>(StallMs * 1000.0f);
+
+	TSharedPtr<ISentrySpan> Span = MapPerformanceTransaction->StartChildSpanWithTimestamp(TEXT("pso.compile"), FString::Printf(TEXT("PSO compile stall (%d misses)"), NumMisses), StartTimestamp, false);
+	if (!Span)
 	{
-		FCoreDelegates::GameSessionIDChanged.Remove(GameSessionIDChangedDelegate);
+		return;
 	}
+
+	Span->SetData(TEXT("pso"), { { TEXT("misses"), NumMisses }, { TEXT("stall_ms"), StallMs } });
+	Span->FinishWithTimestamp(EndTimestamp);
 }
 
-bool USentrySubsystem::IsCurrentBuildConfigurationEnabled() const
+void USentrySubsystem::ConfigureGcTracking()
 {
 	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
 	check(Settings);
 
-	switch (FApp::GetBuildConfiguration())
+	GcPauseSpanThresholdMs = Settings->GcPauseSpanThresholdMs;
+
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
 	{
-	case EBuildConfiguration::Debug:
-		return Settings->EnableBuildConfigurations.bEnableDebug;
-	case EBuildConfiguration::DebugGame:
-		return Settings->EnableBuildConfigurations.bEnableDebugGame;
-	case EBuildConfiguration::Development:
-		return Settings->EnableBuildConfigurations.bEnableDevelopment;
-	case EBuildConfiguration::Shipping:
-		return Settings->EnableBuildConfigurations.bEnableShipping;
-	case EBuildConfiguration::Test:
-		return Settings->EnableBuildConfigurations.bEnableTest;
-	default:
-		return false;
+		GcPauseMetric = Metrics.Register(ESentryMetricType::Distribution, TEXT("gc.pause"), TEXT("millisecond"), {});
+		GcPurgedMetric = Metrics.Register(ESentryMetricType::Counter, TEXT("gc.objects_purged"), TEXT("none"), {});
+	}
+
+	GcPreGarbageCollectDelegate = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddWeakLambda(this, [this]()
+	{
+		GcStartTime = FPlatformTime::Seconds();
+		GcObjectsAtStart = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	});
+
+	// Reachability analysis and, unless purging is incremental, the purge itself block the game thread until here
+	GcPostGarbageCollectDelegate = FCoreUObjectDelegates::GetPostGarbageCollect().AddWeakLambda(this, [this]()
+	{
+		if (GcStartTime <= 0.0)
+		{
+			return;
+		}
+
+		const float PauseMs = static_cast<float>((FPlatformTime::Seconds() - GcStartTime) * 1000.0);
+
+		FSentryFrameTimeHistory::Get().AddGcPause(PauseMs);
+
+		FSentryMetrics& Metrics = FSentryMetrics::Get();
+		if (Metrics.IsActive() && GcPauseMetric.IsValid())
+		{
+			Metrics.Record(GcPauseMetric, PauseMs);
+		}
+
+		if (PauseMs >= GcPauseSpanThresholdMs)
+		{
+			AddGcSpan(PauseMs, GcObjectsAtStart);
+		}
+
+		GcStartTime = 0.0;
+	});
+
+	// Incremental purge finishes frames later, the difference in object count tells how many were purged
+	GcCompleteDelegate = FCoreUObjectDelegates::GarbageCollectComplete.AddWeakLambda(this, [this]()
+	{
+		if (GcObjectsAtStart < 0)
+		{
+			return;
+		}
+
+		const int32 NumPurged = FMath::Max(0, GcObjectsAtStart - GUObjectArray.GetObjectArrayNumMinusAvailable());
+		GcObjectsAtStart = INDEX_NONE;
+
+		FSentryMetrics& Metrics = FSentryMetrics::Get();
+		if (Metrics.IsActive() && GcPurgedMetric.IsValid())
+		{
+			Metrics.Record(GcPurgedMetric, NumPurged);
+		}
+	});
+}
+
+void USentrySubsystem::DisableGcTracking()
+{
+	if (GcPreGarbageCollectDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(GcPreGarbageCollectDelegate);
+		GcPreGarbageCollectDelegate.Reset();
+	}
+
+	if (GcPostGarbageCollectDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(GcPostGarbageCollectDelegate);
+		GcPostGarbageCollectDelegate.Reset();
 	}
+
+	if (GcCompleteDelegate.IsValid())
+	{
+		FCoreUObjectDelegates::GarbageCollectComplete.Remove(GcCompleteDelegate);
+		GcCompleteDelegate.Reset();
+	}
+
+	GcStartTime = 0.0;
+	GcObjectsAtStart = INDEX_NONE;
+
+	GcPauseMetric = FSentryMetricKey();
+	GcPurgedMetric = FSentryMetricKey();
 }
 
-bool USentrySubsystem::IsCurrentBuildTargetEnabled() const
+void USentrySubsystem::AddGcSpan(float PauseMs, int32 NumObjects)
 {
-	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
-	check(Settings);
+	// Keeps a level streaming heavy map session from growing its transaction past what the server accepts
+	static constexpr int32 MaxGcSpans = 100;
 
-	switch (FApp::GetBuildTargetType())
+	if (!MapPerformanceTransaction || MapPerformanceTransaction->IsFinished() || NumGcSpans >= MaxGcSpans)
 	{
-	case EBuildTargetType::Game:
-		return Settings->EnableBuildTargets.bEnableGame;
-	case EBuildTargetType::Server:
-		return Settings->EnableBuildTargets.bEnableServer;
-	case EBuildTargetType::Client:
-		return Settings->EnableBuildTargets.bEnableClient;
-	case EBuildTargetType::Editor:
-		return Settings->EnableBuildTargets.bEnableEditor;
-	case EBuildTargetType::Program:
-		return Settings->EnableBuildTargets.bEnableProgram;
-	default:
-		return false;
+		return;
+	}
+
+	++NumGcSpans;
+
+	const int64 EndTimestamp = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+	const int64 StartTimestamp = EndTimestamp - static_cast<int64>(PauseMs * 1000.0f);
+
+	TSharedPtr<ISentrySpan> Span = MapPerformanceTransaction->StartChildSpanWithTimestamp(TEXT("gc"), FString::Printf(TEXT("Garbage collection (%.1f ms)"), PauseMs), StartTimestamp, false);
+	if (!Span)
+	{
+		return;
 	}
+
+	Span->SetData(TEXT("gc"), { { TEXT("pause_ms"), PauseMs }, { TEXT("objects"), NumObjects } });
+	Span->FinishWithTimestamp(EndTimestamp);
 }
 
-bool USentrySubsystem::IsPromotedBuildsOnlyEnabled() const
+void USentrySubsystem::ConfigureSyncFileIoTracking()
 {
 	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
 	check(Settings);
 
-	return Settings->EnableForPromotedBuildsOnly;
+	FSentryFileIoPlatformFile* FileIoPlatformFile = FSentryFileIoPlatformFile::Get();
+	if (!FileIoPlatformFile)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Synchronous file I/O tracking requires restarting the game after enabling it."));
+		return;
+	}
+
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
+	{
+		SyncFileOpenMetric = Metrics.Register(ESentryMetricType::Distribution, TEXT("file_io.sync"), TEXT("millisecond"), { { TEXT("operation"), TEXT("open") } });
+		SyncFileReadMetric = Metrics.Register(ESentryMetricType::Distribution, TEXT("file_io.sync"), TEXT("millisecond"), { { TEXT("operation"), TEXT("read") } });
+	}
+
+	TWeakObjectPtr<USentrySubsystem> WeakThis(this);
+
+	FileIoPlatformFile->StartReporting(Settings->SyncFileIoThresholdMs, FSentryOnSyncFileIo::CreateLambda([WeakThis](const FSentrySyncFileIo& Io)
+	{
+		USentrySubsystem* Subsystem = WeakThis.Get();
+		if (!Subsystem)
+		{
+			return;
+		}
+
+		const FSentryMetricKey& Key = FCString::Strcmp(Io.Operation, TEXT("open")) == 0 ? Subsystem->SyncFileOpenMetric : Subsystem->SyncFileReadMetric;
+
+		FSentryMetrics& Metrics = FSentryMetrics::Get();
+		if (Metrics.IsActive() && Key.IsValid())
+		{
+			Metrics.Record(Key, Io.DurationMs);
+		}
+
+		Subsystem->AddSyncFileIoSpan(Io);
+	}));
 }
 
-void USentrySubsystem::ConfigureOutputDevice()
+void USentrySubsystem::AddSyncFileIoSpan(const FSentrySyncFileIo& Io)
 {
-	OutputDevice = MakeShareable(new FSentryOutputDevice());
-	if (OutputDevice)
+	// Sync loads tend to come in bursts, which shouldn't grow the transaction past what the server accepts
+	static constexpr int32 MaxSyncFileIoSpans = 100;
+
+	if (!MapPerformanceTransaction || NumSyncFileIoSpans >= MaxSyncFileIoSpans)
 	{
-		GLog->AddOutputDevice(OutputDevice.Get());
-		GLog->SerializeBacklog(OutputDevice.Get());
+		return;
 	}
+
+	++NumSyncFileIoSpans;
+
+	const int64 EndTimestamp = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+	const int64 StartTimestamp = EndTimestamp - static_cast<int64>(Io.DurationMs * 1000.0f);
+
+	TWeakPtr<ISentryTransaction> WeakTransaction(MapPerformanceTransaction);
+
+	// Symbolication can take a while, so the span is added once it's done
+	Async(EAsyncExecution::ThreadPool, [WeakTransaction, Io, StartTimestamp, EndTimestamp]()
+	{
+		const FString Stack = FString::Join(FSentryHitchDetector::Symbolicate(Io.ProgramCounters), TEXT("\n"));
+
+		AsyncTask(ENamedThreads::GameThread, [WeakTransaction, Io, Stack, StartTimestamp, EndTimestamp]()
+		{
+			TSharedPtr<ISentryTransaction> Transaction = WeakTransaction.Pin();
+			if (!Transaction || Transaction->IsFinished())
+			{
+				return;
+			}
+
+			TSharedPtr<ISentrySpan> Span = Transaction->StartChildSpanWithTimestamp(TEXT("file.read"), FPaths::GetCleanFilename(Io.Path), StartTimestamp, false);
+			if (!Span)
+			{
+				return;
+			}
+
+			Span->SetData(TEXT("file"), {
+				{ TEXT("path"), Io.Path },
+				{ TEXT("operation"), Io.Operation },
+				{ TEXT("duration_ms"), Io.DurationMs },
+				{ TEXT("bytes"), static_cast<int32>(FMath::Min<int64>(Io.Bytes, MAX_int32)) },
+				{ TEXT("callsite"), Stack }
+			});
+
+			Span->FinishWithTimestamp(EndTimestamp);
+		});
+	});
 }
 
-void USentrySubsystem::ConfigureErrorOutputDevice()
+void USentrySubsystem::FlushScope()
 {
-	OutputDeviceError = MakeShareable(new FSentryErrorOutputDevice(GError));
-	if (OutputDeviceError)
+	// Keep the batch alive in case it's flushed from another thread while the subsystem is closing
+	TSharedPtr<FSentryScopeBatch, ESPMode::ThreadSafe> PinnedScopeBatch = ScopeBatch;
+	if (!PinnedScopeBatch || !SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
 	{
-		OnAssertDelegate = OutputDeviceError->OnAssert.AddWeakLambda(this, [this](const FString& Message)
+		return;
+	}
+
+	PinnedScopeBatch->Flush(*SubsystemNativeImpl);
+}
+
+int64 USentrySubsystem::GetScopeEvictionCount() const
+{
+	return SentryScopeLimits::GetNumEvicted();
+}
+
+FSentryPayloadStats USentrySubsystem::GetPayloadStats() const
+{
+	return SentryPayloadAccounting::GetStats();
+}
+
+FSentryTransportStats USentrySubsystem::GetTransportStats() const
+{
+	return SentryTransportAccounting::GetStats();
+}
+
+FSentryMemoryStats USentrySubsystem::GetMemoryStats() const
+{
+	FSentryMemoryStats Stats = SentryMemoryAccounting::GetStats();
+
+	if (SubsystemNativeImpl)
+	{
+		SubsystemNativeImpl->AddMemoryStats(Stats);
+
+		if (const TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> LogRing = SubsystemNativeImpl->GetLogRing())
 		{
-			check(SubsystemNativeImpl);
-			SubsystemNativeImpl->HandleAssert();
-		});
-		GError = OutputDeviceError.Get();
+			Stats.LogRingBytes += LogRing->GetCapacity();
+		}
+	}
+
+	Stats.PendingEnvelopeBytes += SentryTransportAccounting::GetStats().QueuedBytes;
+
+	if (ScopeBatch)
+	{
+		Stats.ScopeBytes += ScopeBatch->GetAllocatedSize();
+	}
+
+	if (WorldScopes)
+	{
+		Stats.ScopeBytes += WorldScopes->GetAllocatedSize();
+	}
+
+	for (UObject* Handler : TArray<UObject*>{ BeforeSendHandler, BeforeBreadcrumbHandler, BeforeLogHandler, TraceSampler })
+	{
+		if (Handler)
+		{
+			Stats.HandlerObjectBytes += Handler->GetClass()->GetStructureSize() + Handler->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	return Stats;
+}
+
+float USentrySubsystem::GetInitializationDurationMs() const
+{
+	return InitializationDurationMs;
+}
+
+FDelegateHandle USentrySubsystem::AddBeforeSendFilter(FSentryBeforeSendFilter Filter)
+{
+	return SentryEventFilters::Add(MoveTemp(Filter));
+}
+
+void USentrySubsystem::RemoveBeforeSendFilter(FDelegateHandle Handle)
+{
+	SentryEventFilters::Remove(Handle);
+}
+
+const FSentryInitProfile& USentrySubsystem::GetInitProfile() const
+{
+	return InitProfile;
+}
+
+bool USentrySubsystem::IsInitializingAsync() const
+{
+	return bIsInitializingAsync;
+}
+
+bool USentrySubsystem::DeferUntilInitialized(TFunction<void()>&& Call)
+{
+	// Checked without the lock first so that scope changes don't contend on it once initialized
+	if (!bIsInitializingAsync)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&DeferredCallsCriticalSection);
+
+	if (!bIsInitializingAsync)
+	{
+		return false;
+	}
+
+	DeferredCalls.Add(MoveTemp(Call));
+	return true;
+}
+
+bool USentrySubsystem::CanEnqueuePlatformCall() const
+{
+	FReadScopeLock Lock(CommandQueueLock);
+	return CommandQueue && !CommandQueue->IsRunningCommands();
+}
+
+bool USentrySubsystem::EnqueuePlatformCall(TFunction<void()>&& Call, bool bIsCapture)
+{
+	TSharedPtr<FSentryCommandQueue, ESPMode::ThreadSafe> PinnedCommandQueue;
+	{
+		FReadScopeLock Lock(CommandQueueLock);
+		PinnedCommandQueue = CommandQueue;
+	}
+
+	if (!PinnedCommandQueue || PinnedCommandQueue->IsRunningCommands())
+	{
+		return false;
+	}
+
+	PinnedCommandQueue->Enqueue(MoveTemp(Call), !bIsCapture);
+	return true;
+}
+
+bool USentrySubsystem::EnqueueCapture(TFunction<TSharedPtr<ISentryEvent>()>&& CreateNativeEvent, FString& OutEventId)
+{
+	// Same format as the IDs generated by the platform SDKs
+	const FString EventId = FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+
+	if (!EnqueuePlatformCall([this, CreateNativeEvent = MoveTemp(CreateNativeEvent), EventId]()
+	{
+		if (!SubsystemNativeImpl || !SubsystemNativeImpl->IsEnabled())
+		{
+			return;
+		}
+
+		FlushScope();
+
+		TSharedPtr<ISentryEvent> NativeEvent = CreateNativeEvent();
+		NativeEvent->SetId(EventId);
+
+		if (SubsystemNativeImpl->CaptureEvent(NativeEvent))
+		{
+			TRACE_COUNTER_INCREMENT(SentryEventsCaptured);
+		}
+	}, true))
+	{
+		return false;
+	}
+
+	OutEventId = EventId;
+	return true;
+}
+
+void USentrySubsystem::ReplayDeferredCalls()
+{
+	TArray<TFunction<void()>> Calls;
+
+	{
+		FScopeLock Lock(&DeferredCallsCriticalSection);
+		bIsInitializingAsync = false;
+		Calls = MoveTemp(DeferredCalls);
+	}
+
+	if (Calls.Num() > 0)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Replaying %d scope changes and captures made during the asynchronous initialization."), Calls.Num());
+	}
+
+	for (const TFunction<void()>& Call : Calls)
+	{
+		Call();
 	}
 }
 
@@ -3,29 +3,111 @@
 #include "SentryVariant.h"
 #include "SentryDefines.h"
 
-template int32 FSentryVariant::GetValue<int32>() const;
-template float FSentryVariant::GetValue<float>() const;
-template bool FSentryVariant::GetValue<bool>() const;
-template FString FSentryVariant::GetValue<FString>() const;
-template TArray<FSentryVariant> FSentryVariant::GetValue<TArray<FSentryVariant>>() const;
-template TMap<FString, FSentryVariant> FSentryVariant::GetValue<TMap<FString, FSentryVariant>>() const;
+#include "Serialization/Archive.h"
 
 FSentryVariant::FSentryVariant()
-	: Type(ESentryVariantType::Empty) {}
+	: Type(ESentryVariantType::Empty), IntValue(0), FloatValue(0.0f), bBoolValue(false) {}
 FSentryVariant::FSentryVariant(int32 InValue)
-	: Type(ESentryVariantType::Integer), Value(InValue) {}
+	: Type(ESentryVariantType::Integer), IntValue(InValue), FloatValue(0.0f), bBoolValue(false) {}
 FSentryVariant::FSentryVariant(float InValue)
-	: Type(ESentryVariantType::Float), Value(InValue) {}
+	: Type(ESentryVariantType::Float), IntValue(0), FloatValue(InValue), bBoolValue(false) {}
 FSentryVariant::FSentryVariant(bool InValue)
-	: Type(ESentryVariantType::Bool), Value(InValue) {}
+	: Type(ESentryVariantType::Bool), IntValue(0), FloatValue(0.0f), bBoolValue(InValue) {}
 FSentryVariant::FSentryVariant(const FString& InValue)
-	: Type(ESentryVariantType::String), Value(InValue) {}
+	: Type(ESentryVariantType::String), IntValue(0), FloatValue(0.0f), bBoolValue(false), StringValue(InValue) {}
+FSentryVariant::FSentryVariant(FString&& InValue)
+	: Type(ESentryVariantType::String), IntValue(0), FloatValue(0.0f), bBoolValue(false), StringValue(MoveTemp(InValue)) {}
 FSentryVariant::FSentryVariant(const TCHAR* InValue)
-	: Type(ESentryVariantType::String), Value(InValue) {}
+	: Type(ESentryVariantType::String), IntValue(0), FloatValue(0.0f), bBoolValue(false), StringValue(InValue) {}
 FSentryVariant::FSentryVariant(const TArray<FSentryVariant>& InValue)
-	: Type(ESentryVariantType::Array), Value(InValue) {}
+	: Type(ESentryVariantType::Array), IntValue(0), FloatValue(0.0f), bBoolValue(false), ArrayValue(MakeShared<TArray<FSentryVariant>, ESPMode::ThreadSafe>(InValue)) {}
+FSentryVariant::FSentryVariant(TArray<FSentryVariant>&& InValue)
+	: Type(ESentryVariantType::Array), IntValue(0), FloatValue(0.0f), bBoolValue(false), ArrayValue(MakeShared<TArray<FSentryVariant>, ESPMode::ThreadSafe>(MoveTemp(InValue))) {}
 FSentryVariant::FSentryVariant(const TMap<FString, FSentryVariant>& InValue)
-	: Type(ESentryVariantType::Map), Value(InValue) {}
+	: Type(ESentryVariantType::Map), IntValue(0), FloatValue(0.0f), bBoolValue(false), MapValue(MakeShared<TMap<FString, FSentryVariant>, ESPMode::ThreadSafe>(InValue)) {}
+FSentryVariant::FSentryVariant(TMap<FString, FSentryVariant>&& InValue)
+	: Type(ESentryVariantType::Map), IntValue(0), FloatValue(0.0f), bBoolValue(false), MapValue(MakeShared<TMap<FString, FSentryVariant>, ESPMode::ThreadSafe>(MoveTemp(InValue))) {}
+
+const TArray<FSentryVariant>& FSentryVariant::GetArrayRef() const
+{
+	static const TArray<FSentryVariant> EmptyArray;
+	return ArrayValue.IsValid() ? *ArrayValue : EmptyArray;
+}
+
+const TMap<FString, FSentryVariant>& FSentryVariant::GetMapRef() const
+{
+	static const TMap<FString, FSentryVariant> EmptyMap;
+	return MapValue.IsValid() ? *MapValue : EmptyMap;
+}
+
+bool FSentryVariant::operator==(const FSentryVariant& Other) const
+{
+	if (Type != Other.Type)
+	{
+		return false;
+	}
+
+	switch (Type)
+	{
+	case ESentryVariantType::Integer:
+		return IntValue == Other.IntValue;
+	case ESentryVariantType::Float:
+		return FloatValue == Other.FloatValue;
+	case ESentryVariantType::Bool:
+		return bBoolValue == Other.bBoolValue;
+	case ESentryVariantType::String:
+		return StringValue.Equals(Other.StringValue, ESearchCase::CaseSensitive);
+	case ESentryVariantType::Array:
+		return ArrayValue == Other.ArrayValue || GetArrayRef() == Other.GetArrayRef();
+	case ESentryVariantType::Map:
+		return MapValue == Other.MapValue || GetMapRef().OrderIndependentCompareEqual(Other.GetMapRef());
+	default:
+		return true;
+	}
+}
+
+void FSentryVariant::Serialize(FArchive& Ar)
+{
+	Ar << Type;
+
+	switch (Type)
+	{
+	case ESentryVariantType::Integer:
+		Ar << IntValue;
+		break;
+	case ESentryVariantType::Float:
+		Ar << FloatValue;
+		break;
+	case ESentryVariantType::Bool:
+		Ar << bBoolValue;
+		break;
+	case ESentryVariantType::String:
+		Ar << StringValue;
+		break;
+	case ESentryVariantType::Array:
+	{
+		TArray<FSentryVariant> Array = GetArrayRef();
+		Ar << Array;
+		if (Ar.IsLoading())
+		{
+			ArrayValue = MakeShared<TArray<FSentryVariant>, ESPMode::ThreadSafe>(MoveTemp(Array));
+		}
+		break;
+	}
+	case ESentryVariantType::Map:
+	{
+		TMap<FString, FSentryVariant> Map = GetMapRef();
+		Ar << Map;
+		if (Ar.IsLoading())
+		{
+			MapValue = MakeShared<TMap<FString, FSentryVariant>, ESPMode::ThreadSafe>(MoveTemp(Map));
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
 
 FSentryVariant USentryVariantHelper::MakeSentryVariantFromInteger(int32 Value)
 {
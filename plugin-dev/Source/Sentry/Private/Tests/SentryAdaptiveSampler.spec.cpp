@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryAdaptiveSampler.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryAdaptiveSamplerSpec, "Sentry.SentryAdaptiveSampler", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryAdaptiveSamplerSpec)
+
+void SentryAdaptiveSamplerSpec::Define()
+{
+	Describe("Sample rate", [this]()
+	{
+		It("should keep everything while the backlog is small", [this]()
+		{
+			FSentryAdaptiveSampler Sampler(100, 1000, 0.1f);
+
+			TestEqual("Initial rate", Sampler.GetSampleRate(), 1.0f);
+
+			Sampler.SetBacklog(50, 500);
+			TestEqual("Rate at half of the limits", Sampler.GetSampleRate(), 1.0f);
+		});
+
+		It("should lower the rate as the backlog grows", [this]()
+		{
+			FSentryAdaptiveSampler Sampler(100, 1000, 0.2f);
+
+			Sampler.SetBacklog(75, 0);
+			TestEqual("Rate halfway through degradation", Sampler.GetSampleRate(), 0.6f, 0.001f);
+
+			Sampler.SetBacklog(0, 1000);
+			TestEqual("Rate at the size limit", Sampler.GetSampleRate(), 0.2f, 0.001f);
+
+			Sampler.SetBacklog(500, 0);
+			TestEqual("Rate beyond the limits", Sampler.GetSampleRate(), 0.2f, 0.001f);
+		});
+
+		It("should recover once the backlog drains", [this]()
+		{
+			FSentryAdaptiveSampler Sampler(10, 1000, 0.0f);
+
+			Sampler.SetBacklog(10, 0);
+			TestEqual("Rate at the limit", Sampler.GetSampleRate(), 0.0f);
+
+			Sampler.SetBacklog(0, 0);
+			TestEqual("Rate after draining", Sampler.GetSampleRate(), 1.0f);
+		});
+	});
+
+	Describe("Sampling", [this]()
+	{
+		It("should never sample out warnings, errors and fatals", [this]()
+		{
+			FSentryAdaptiveSampler Sampler(10, 1000, 0.0f);
+			Sampler.SetBacklog(10, 0);
+
+			TestTrue("Warning kept", Sampler.ShouldKeep(ESentryLevel::Warning));
+			TestTrue("Error kept", Sampler.ShouldKeep(ESentryLevel::Error));
+			TestTrue("Fatal kept", Sampler.ShouldKeep(ESentryLevel::Fatal));
+
+			TestFalse("Info sampled out", Sampler.ShouldKeep(ESentryLevel::Info));
+			TestFalse("Low-priority payload sampled out", Sampler.ShouldKeep());
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryAppStart.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryAppStartSpec, "Sentry.SentryAppStart", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryAppStartSpec)
+
+void SentryAppStartSpec::Define()
+{
+	Describe("Milestones", [this]()
+	{
+		It("should complete once a frame ends after the first map load", [this]()
+		{
+			FSentryAppStart AppStart(1.0, 2.0, FSentryInitPhase(TEXT("Sentry initialization"), 2.0, 2.1), false);
+
+			TestFalse("Not interactive before the map load", AppStart.OnFrameEnded(2.5));
+			TestTrue("First frame recorded", AppStart.HasFirstFrame());
+
+			AppStart.OnMapLoadStarted(3.0, TEXT("Entry"));
+			AppStart.OnMapLoadFinished(4.0);
+
+			TestTrue("Interactive after the map load", AppStart.OnFrameEnded(4.2));
+			TestTrue("Complete", AppStart.IsComplete());
+			TestFalse("Completes once", AppStart.OnFrameEnded(4.3));
+
+			TestEqual("Time to first frame", AppStart.GetTimeToFirstFrameMs(), 1500.0, 0.01);
+			TestEqual("Time to interactive", AppStart.GetTimeToInteractiveMs(), 3200.0, 0.01);
+			TestEqual("Map name", AppStart.GetMapName(), FString(TEXT("Entry")));
+		});
+
+		It("should only track the first map load", [this]()
+		{
+			FSentryAppStart AppStart(1.0, 2.0, FSentryInitPhase(TEXT("Sentry initialization"), 2.0, 2.1), false);
+
+			AppStart.OnMapLoadStarted(3.0, TEXT("Entry"));
+			AppStart.OnMapLoadStarted(3.5, TEXT("Lobby"));
+			AppStart.OnMapLoadFinished(4.0);
+			AppStart.OnMapLoadFinished(5.0);
+
+			TestEqual("First map kept", AppStart.GetMapName(), FString(TEXT("Entry")));
+
+			AppStart.OnFrameEnded(4.1);
+
+			const TArray<FSentryInitPhase> Phases = AppStart.GetPhases();
+			const FSentryInitPhase* MapLoad = Phases.FindByPredicate([](const FSentryInitPhase& Phase) { return Phase.Name == TEXT("app.start.map_load"); });
+
+			TestNotNull("Map load phase", MapLoad);
+			if (MapLoad)
+			{
+				TestEqual("Map load duration", MapLoad->GetDurationMs(), 1000.0, 0.01);
+			}
+		});
+
+		It("should be interactive on the first frame if a map was already loaded", [this]()
+		{
+			FSentryAppStart AppStart(1.0, 2.0, FSentryInitPhase(TEXT("Sentry initialization"), 2.0, 2.1), true);
+
+			TestTrue("Interactive right away", AppStart.OnFrameEnded(2.5));
+			TestEqual("No map load phase", AppStart.GetPhases().Num(), 3);
+		});
+	});
+
+	Describe("Phases", [this]()
+	{
+		It("should order the observed phases by their start", [this]()
+		{
+			FSentryAppStart AppStart(1.0, 2.0, FSentryInitPhase(TEXT("Sentry initialization"), 2.0, 2.1), false);
+
+			AppStart.OnMapLoadStarted(3.0, TEXT("Entry"));
+			AppStart.OnMapLoadFinished(4.0);
+			AppStart.OnFrameEnded(4.2);
+
+			const TArray<FSentryInitPhase> Phases = AppStart.GetPhases();
+
+			TestEqual("All phases", Phases.Num(), 4);
+			for (int32 Index = 1; Index < Phases.Num(); ++Index)
+			{
+				TestTrue("Ordered", Phases[Index - 1].StartTime <= Phases[Index].StartTime);
+			}
+		});
+
+		It("should skip phases that weren't observed", [this]()
+		{
+			FSentryAppStart AppStart(1.0, 2.0, FSentryInitPhase(), false);
+
+			TestEqual("Only module loading", AppStart.GetPhases().Num(), 1);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryAttachmentCompression.h"
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryAttachmentCompressionSpec, "Sentry.SentryAttachmentCompression", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static TArray<uint8> ToBytes(const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static TArray<uint8> MakeEnvelope(const FString& ItemHeaderFields, const FString& Content)
+	{
+		return ToBytes(FString::Printf(TEXT("{\"event_id\":\"0123456789abcdef0123456789abcdef\"}\n{\"type\":\"event\",\"length\":2}\n{}\n{\"type\":\"attachment\",%s,\"length\":%d}\n%s\n"),
+			*ItemHeaderFields, Content.Len(), *Content));
+	}
+
+	static FString MakeLog()
+	{
+		FString Log;
+		for (int32 Index = 0; Index < 200; ++Index)
+		{
+			Log += FString::Printf(TEXT("[2025.01.01-00.00.%02d:000][  0]LogTemp: Display: Repeated log line %d\n"), Index % 60, Index);
+		}
+
+		return Log;
+	}
+END_DEFINE_SPEC(SentryAttachmentCompressionSpec)
+
+void SentryAttachmentCompressionSpec::Define()
+{
+	Describe("Text detection", [this]()
+	{
+		It("should detect text by content type or file extension", [this]()
+		{
+			TSharedRef<FJsonObject> Header = MakeShared<FJsonObject>();
+			Header->SetStringField(TEXT("filename"), TEXT("Game.log"));
+			TestTrue("Log file is text", SentryAttachmentCompression::IsTextAttachment(*Header));
+
+			Header->SetStringField(TEXT("content_type"), TEXT("application/json"));
+			TestTrue("JSON is text", SentryAttachmentCompression::IsTextAttachment(*Header));
+
+			Header->SetStringField(TEXT("content_type"), TEXT("image/png"));
+			TestFalse("Image isn't text", SentryAttachmentCompression::IsTextAttachment(*Header));
+
+			Header->SetStringField(TEXT("content_type"), TEXT("application/json"));
+			Header->SetStringField(TEXT("attachment_type"), TEXT("event.view_hierarchy"));
+			TestFalse("View hierarchy is kept as is", SentryAttachmentCompression::IsTextAttachment(*Header));
+		});
+	});
+
+	Describe("Compression", [this]()
+	{
+		It("should gzip text attachments above the threshold", [this]()
+		{
+			const FString Log = MakeLog();
+			const FTCHARToUTF8 LogUtf8(*Log);
+
+			TArray<uint8> Envelope = MakeEnvelope(TEXT("\"filename\":\"Game.log\""), Log);
+			const int32 OriginalSize = Envelope.Num();
+
+			TestTrue("Attachment compressed", SentryAttachmentCompression::CompressTextAttachments(Envelope, 1024));
+			TestTrue("Envelope is smaller", Envelope.Num() < OriginalSize);
+
+			int32 HeaderEnd = 0;
+			TArray<FSentryEnvelopeBatch::FItem> Items;
+			TestTrue("Envelope stays valid", FSentryEnvelopeBatch::Parse(Envelope, HeaderEnd, Items));
+
+			if (!TestEqual("Items kept", Items.Num(), 2))
+			{
+				return;
+			}
+
+			const TSharedPtr<FJsonObject> ItemHeader = FSentryEnvelopeBatch::ParseItemHeader(Envelope, Items[1]);
+			if (!TestTrue("Item header valid", ItemHeader.IsValid()))
+			{
+				return;
+			}
+
+			TestEqual("Extension added", ItemHeader->GetStringField(TEXT("filename")), TEXT("Game.log.gz"));
+			TestEqual("Content type set", ItemHeader->GetStringField(TEXT("content_type")), TEXT("application/gzip"));
+
+			TArray<uint8> Uncompressed;
+			Uncompressed.SetNumUninitialized(LogUtf8.Length());
+			TestTrue("Payload can be decompressed", FCompression::UncompressMemory(NAME_Gzip, Uncompressed.GetData(), Uncompressed.Num(),
+				Envelope.GetData() + Items[1].PayloadStart, Items[1].PayloadEnd - Items[1].PayloadStart));
+			TestTrue("Content restored", FMemory::Memcmp(Uncompressed.GetData(), LogUtf8.Get(), LogUtf8.Length()) == 0);
+		});
+
+		It("should leave small and binary attachments as they are", [this]()
+		{
+			const FString Log = MakeLog();
+
+			TArray<uint8> Small = MakeEnvelope(TEXT("\"filename\":\"Game.log\""), Log);
+			TestFalse("Small attachment kept", SentryAttachmentCompression::CompressTextAttachments(Small, 1024 * 1024));
+
+			TArray<uint8> Binary = MakeEnvelope(TEXT("\"filename\":\"save.dat\""), Log);
+			TestFalse("Binary attachment kept", SentryAttachmentCompression::CompressTextAttachments(Binary, 1024));
+		});
+	});
+}
+
+#endif
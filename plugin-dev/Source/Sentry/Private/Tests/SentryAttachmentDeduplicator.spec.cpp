@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryAttachmentDeduplicator.h"
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryAttachmentDeduplicatorSpec, "Sentry.SentryAttachmentDeduplicator", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static TArray<uint8> ToBytes(const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static FString ToString(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	static TArray<uint8> MakeEnvelope(const FString& EventId, const FString& Content, const FString& AttachmentType = FString())
+	{
+		const FString TypeField = AttachmentType.IsEmpty() ? FString() : FString::Printf(TEXT(",\"attachment_type\":\"%s\""), *AttachmentType);
+
+		return ToBytes(FString::Printf(TEXT("{\"event_id\":\"%s\"}\n{\"type\":\"event\",\"length\":2}\n{}\n{\"type\":\"attachment\",\"filename\":\"save.dat\"%s,\"length\":%d}\n%s\n"),
+			*EventId, *TypeField, Content.Len(), *Content));
+	}
+END_DEFINE_SPEC(SentryAttachmentDeduplicatorSpec)
+
+void SentryAttachmentDeduplicatorSpec::Define()
+{
+	const FString Content = TEXT("0123456789abcdef");
+
+	Describe("Deduplication", [this, Content]()
+	{
+		It("should replace an attachment already uploaded with another event", [this, Content]()
+		{
+			FSentryAttachmentDeduplicator Deduplicator(0.0, 8);
+
+			TArray<uint8> First = MakeEnvelope(TEXT("first"), Content);
+			TestFalse("First upload kept", Deduplicator.Deduplicate(First, 0.0));
+			Deduplicator.OnUploadCompleted(TEXT("first"), true, false, 0.0);
+
+			TArray<uint8> Second = MakeEnvelope(TEXT("second"), Content);
+			TestTrue("Duplicate replaced", Deduplicator.Deduplicate(Second, 1.0));
+
+			const FString Deduplicated = ToString(Second);
+			TestFalse("Content removed", Deduplicated.Contains(Content));
+			TestTrue("Earlier event referenced", Deduplicated.Contains(TEXT("of event first")));
+			TestTrue("Reference attached", Deduplicated.Contains(TEXT("\"filename\":\"save.dat.ref.txt\"")));
+
+			TArray<FString> Types;
+			TestTrue("Envelope stays valid", FSentryEnvelopeBatch::GetItemTypes(Second, Types));
+			TestEqual("Items kept", Types.Num(), 2);
+		});
+
+		It("should keep attachments with different content, small size or special meaning", [this, Content]()
+		{
+			FSentryAttachmentDeduplicator Deduplicator(0.0, 8);
+
+			TArray<uint8> First = MakeEnvelope(TEXT("first"), Content);
+			Deduplicator.Deduplicate(First, 0.0);
+			Deduplicator.OnUploadCompleted(TEXT("first"), true, false, 0.0);
+
+			TArray<uint8> Different = MakeEnvelope(TEXT("second"), TEXT("fedcba9876543210"));
+			TestFalse("Different content kept", Deduplicator.Deduplicate(Different, 1.0));
+
+			TArray<uint8> Small = MakeEnvelope(TEXT("first"), TEXT("abc"));
+			Deduplicator.Deduplicate(Small, 1.0);
+			Deduplicator.OnUploadCompleted(TEXT("first"), true, false, 1.0);
+			TArray<uint8> SmallDuplicate = MakeEnvelope(TEXT("second"), TEXT("abc"));
+			TestFalse("Small attachment kept", Deduplicator.Deduplicate(SmallDuplicate, 1.0));
+
+			TArray<uint8> Minidump = MakeEnvelope(TEXT("third"), Content, TEXT("event.minidump"));
+			TestFalse("Minidump kept", Deduplicator.Deduplicate(Minidump, 1.0));
+		});
+
+		It("should upload the content again once the window has elapsed", [this, Content]()
+		{
+			FSentryAttachmentDeduplicator Deduplicator(10.0, 8);
+
+			TArray<uint8> First = MakeEnvelope(TEXT("first"), Content);
+			Deduplicator.Deduplicate(First, 0.0);
+			Deduplicator.OnUploadCompleted(TEXT("first"), true, false, 0.0);
+
+			TArray<uint8> Late = MakeEnvelope(TEXT("second"), Content);
+			TestFalse("Uploaded again after the window", Deduplicator.Deduplicate(Late, 20.0));
+			Deduplicator.OnUploadCompleted(TEXT("second"), true, false, 20.0);
+
+			TArray<uint8> Duplicate = MakeEnvelope(TEXT("third"), Content);
+			TestTrue("Replaced within the new window", Deduplicator.Deduplicate(Duplicate, 25.0));
+			TestTrue("Latest upload referenced", ToString(Duplicate).Contains(TEXT("of event second")));
+		});
+
+		It("should only reference content whose upload was delivered", [this, Content]()
+		{
+			FSentryAttachmentDeduplicator Deduplicator(0.0, 8);
+
+			TArray<uint8> First = MakeEnvelope(TEXT("first"), Content);
+			Deduplicator.Deduplicate(First, 0.0);
+
+			TArray<uint8> InFlight = MakeEnvelope(TEXT("second"), Content);
+			TestFalse("Pending upload not referenced", Deduplicator.Deduplicate(InFlight, 1.0));
+
+			Deduplicator.OnUploadCompleted(TEXT("first"), false, true, 1.0);
+			TestTrue("Retried upload still pending", Deduplicator.HasPendingUploads());
+
+			Deduplicator.OnUploadCompleted(TEXT("first"), false, false, 2.0);
+			Deduplicator.OnUploadCompleted(TEXT("second"), false, false, 2.0);
+			TestEqual("Failed uploads not recorded", Deduplicator.Num(), 0);
+
+			TArray<uint8> Retry = MakeEnvelope(TEXT("third"), Content);
+			TestFalse("Content uploaded again", Deduplicator.Deduplicate(Retry, 3.0));
+		});
+
+		It("should forget the oldest hashes once full", [this, Content]()
+		{
+			FSentryAttachmentDeduplicator Deduplicator(0.0, 8, 1);
+
+			TArray<uint8> First = MakeEnvelope(TEXT("first"), Content);
+			Deduplicator.Deduplicate(First, 0.0);
+			Deduplicator.OnUploadCompleted(TEXT("first"), true, false, 0.0);
+			TArray<uint8> Other = MakeEnvelope(TEXT("second"), TEXT("fedcba9876543210"));
+			Deduplicator.Deduplicate(Other, 1.0);
+			Deduplicator.OnUploadCompleted(TEXT("second"), true, false, 1.0);
+
+			TestEqual("Entries bounded", Deduplicator.Num(), 1);
+
+			TArray<uint8> Duplicate = MakeEnvelope(TEXT("third"), Content);
+			TestFalse("Forgotten content uploaded again", Deduplicator.Deduplicate(Duplicate, 2.0));
+		});
+	});
+}
+
+#endif
@@ -1,6 +1,7 @@
 // Copyright (c) 2025 Sentry. All Rights Reserved.
 
 #include "SentryBreadcrumb.h"
+#include "SentryBreadcrumbMacros.h"
 #include "SentryTests.h"
 
 #include "Misc/AutomationTest.h"
@@ -52,6 +53,27 @@ void SentryBreadcrumbSpec::Define()
 			TestEqual("Data 4", ReceivedData[TEXT("Key4")], TestData[TEXT("Key4")]);
 		});
 	});
+
+	Describe("Breadcrumb macros", [this]()
+	{
+		It("should not evaluate arguments of disabled levels", [this]()
+		{
+			const uint8 EnabledLevelMask = SentryBreadcrumbs::EnabledLevelMask;
+			SentryBreadcrumbs::EnabledLevelMask = 1 << static_cast<uint8>(ESentryLevel::Error);
+
+			int32 NumEvaluated = 0;
+			auto Evaluate = [&NumEvaluated]() { return ++NumEvaluated; };
+
+			SENTRY_BREADCRUMB(Info, TEXT("Test"), TEXT("Value %d"), Evaluate());
+			SENTRY_BREADCRUMB_DATA(Debug, TEXT("Test"), TEXT("Message"), { { TEXT("Value"), Evaluate() } });
+			TestEqual("Arguments of disabled levels", NumEvaluated, 0);
+
+			SENTRY_BREADCRUMB(Error, TEXT("Test"), TEXT("Value %d"), Evaluate());
+			TestEqual("Arguments of enabled levels", NumEvaluated, 1);
+
+			SentryBreadcrumbs::EnabledLevelMask = EnabledLevelMask;
+		});
+	});
 }
 
 #endif
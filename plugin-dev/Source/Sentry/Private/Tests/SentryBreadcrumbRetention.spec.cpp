@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryBreadcrumbRetention.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryBreadcrumbRetentionSpec, "Sentry.SentryBreadcrumbRetention", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static TArray<int32> ToArray(const TSentryBreadcrumbRetention<int32>& Retention)
+	{
+		TArray<int32> Result;
+		Retention.ForEach([&Result](int32 Element)
+		{
+			Result.Add(Element);
+		});
+		return Result;
+	}
+END_DEFINE_SPEC(SentryBreadcrumbRetentionSpec)
+
+void SentryBreadcrumbRetentionSpec::Define()
+{
+	Describe("Level-aware retention", [this]()
+	{
+		It("should keep the order breadcrumbs were added in", [this]()
+		{
+			TSentryBreadcrumbRetention<int32> Retention;
+			Retention.Configure(10, true, 0);
+
+			Retention.Add(1, ESentryLevel::Error);
+			Retention.Add(2, ESentryLevel::Debug);
+			Retention.Add(3, ESentryLevel::Warning);
+			Retention.Add(4, ESentryLevel::Info);
+
+			TestEqual("Merged in order", ToArray(Retention), TArray<int32>({ 1, 2, 3, 4 }));
+		});
+
+		It("should keep errors through a burst of info breadcrumbs", [this]()
+		{
+			TSentryBreadcrumbRetention<int32> Retention;
+			Retention.Configure(10, true, 10);
+
+			Retention.Add(0, ESentryLevel::Error);
+			Retention.Add(1, ESentryLevel::Warning);
+			for (int32 Index = 100; Index < 200; ++Index)
+			{
+				Retention.Add(Index, ESentryLevel::Info);
+			}
+
+			const TArray<int32> Elements = ToArray(Retention);
+
+			TestEqual("Budget kept", Retention.Num(), 10);
+			TestEqual("Error kept", Elements[0], 0);
+			TestEqual("Warning kept", Elements[1], 1);
+			TestEqual("Most recent info kept", Elements.Last(), 199);
+		});
+
+		It("should guarantee each level its reserved share", [this]()
+		{
+			TSentryBreadcrumbRetention<int32> Retention;
+			Retention.Configure(10, true, 20);
+
+			Retention.Add(0, ESentryLevel::Debug);
+			for (int32 Index = 100; Index < 200; ++Index)
+			{
+				Retention.Add(Index, ESentryLevel::Error);
+			}
+
+			const TArray<int32> Elements = ToArray(Retention);
+
+			TestEqual("Budget kept", Retention.Num(), 10);
+			TestEqual("Debug breadcrumb within its share kept", Elements[0], 0);
+		});
+
+		It("should drop breadcrumbs less important than all the kept ones", [this]()
+		{
+			TSentryBreadcrumbRetention<int32> Retention;
+			Retention.Configure(2, true, 0);
+
+			Retention.Add(1, ESentryLevel::Error);
+			Retention.Add(2, ESentryLevel::Error);
+			Retention.Add(3, ESentryLevel::Debug);
+
+			TestEqual("Debug dropped", ToArray(Retention), TArray<int32>({ 1, 2 }));
+		});
+
+		It("should evict within the budget when shrunk", [this]()
+		{
+			TSentryBreadcrumbRetention<int32> Retention;
+			Retention.Configure(4, true, 0);
+
+			Retention.Add(1, ESentryLevel::Info);
+			Retention.Add(2, ESentryLevel::Error);
+			Retention.Add(3, ESentryLevel::Info);
+			Retention.Add(4, ESentryLevel::Error);
+
+			Retention.Configure(2, true, 0);
+
+			TestEqual("Info evicted first", ToArray(Retention), TArray<int32>({ 2, 4 }));
+		});
+	});
+
+	Describe("Plain retention", [this]()
+	{
+		It("should evict the oldest breadcrumbs", [this]()
+		{
+			TSentryBreadcrumbRetention<int32> Retention;
+			Retention.Configure(2, false, 10);
+
+			Retention.Add(1, ESentryLevel::Error);
+			Retention.Add(2, ESentryLevel::Debug);
+			Retention.Add(3, ESentryLevel::Debug);
+
+			TestEqual("Oldest evicted", ToArray(Retention), TArray<int32>({ 2, 3 }));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryCaptureCadence.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCaptureCadenceSpec, "Sentry.SentryCaptureCadence", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FSentryCaptureCadence Cadence;
+
+	int32 CountCaptures(double FrameTime, double Duration)
+	{
+		int32 NumCaptures = 0;
+		for (double Time = 1000.0; Time < 1000.0 + Duration; Time += FrameTime)
+		{
+			NumCaptures += Cadence.ShouldCapture(Time) ? 1 : 0;
+		}
+		return NumCaptures;
+	}
+END_DEFINE_SPEC(SentryCaptureCadenceSpec)
+
+void SentryCaptureCadenceSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Cadence.Reset(30.0f);
+	});
+
+	It("should capture at the target rate when rendering faster", [this]()
+	{
+		// Measuring from the last captured frame would settle at 144 / 5 = 28.8 FPS
+		TestEqual("Captures per second at 144 FPS", CountCaptures(1.0 / 144.0, 10.0), 300);
+	});
+
+	It("should capture every frame when rendering slower than the target rate", [this]()
+	{
+		TestEqual("Captures per second at 20 FPS", CountCaptures(1.0 / 20.0, 10.0), 200);
+	});
+
+	It("should not catch up after a hitch", [this]()
+	{
+		TestTrue("First frame", Cadence.ShouldCapture(1000.0));
+		TestTrue("Frame after hitch", Cadence.ShouldCapture(1001.0));
+		TestFalse("Next frame", Cadence.ShouldCapture(1001.001));
+	});
+
+	It("should count dropped frames until reset", [this]()
+	{
+		Cadence.OnDropped();
+		Cadence.OnDropped();
+
+		TestEqual("Dropped", Cadence.GetNumDropped(), 2ll);
+
+		Cadence.Reset(30.0f);
+
+		TestEqual("Dropped after reset", Cadence.GetNumDropped(), 0ll);
+	});
+}
+
+#endif
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryContextCache.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryContextCacheSpec, "Sentry.SentryContextCache", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString CachePath;
+	FSentryHardwareContexts Contexts;
+END_DEFINE_SPEC(SentryContextCacheSpec)
+
+void SentryContextCacheSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		CachePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryTests"), TEXT("ContextCache.txt"));
+
+		Contexts = FSentryHardwareContexts();
+		Contexts.Gpu.Add(TEXT("name"), TEXT("Test GPU"));
+		Contexts.Gpu.Add(TEXT("driver_version"), TEXT("1.2.3"));
+		Contexts.Device.Add(TEXT("cpu_description"), TEXT("Test\tCPU"));
+		Contexts.Device.Add(TEXT("number_of_cores"), TEXT(""));
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().Delete(*CachePath);
+	});
+
+	Describe("Cache", [this]()
+	{
+		It("should load saved contexts for the same fingerprint", [this]()
+		{
+			TestTrue("Contexts saved", SentryContextCache::Save(CachePath, TEXT("fingerprint"), Contexts));
+
+			FSentryHardwareContexts LoadedContexts;
+			TestTrue("Contexts loaded", SentryContextCache::Load(CachePath, TEXT("fingerprint"), LoadedContexts));
+			TestEqual("GPU context", LoadedContexts.Gpu.Num(), 2);
+			TestEqual("Device context", LoadedContexts.Device.Num(), 2);
+			TestEqual("Separators replaced", LoadedContexts.Device.FindRef(TEXT("cpu_description")), TEXT("Test CPU"));
+			TestEqual("Empty value kept", LoadedContexts.Device.FindRef(TEXT("number_of_cores")), TEXT(""));
+		});
+
+		It("should discard contexts saved for another fingerprint", [this]()
+		{
+			SentryContextCache::Save(CachePath, TEXT("fingerprint"), Contexts);
+
+			FSentryHardwareContexts LoadedContexts;
+			TestFalse("Contexts not loaded", SentryContextCache::Load(CachePath, TEXT("other fingerprint"), LoadedContexts));
+		});
+
+		It("should not load missing cache", [this]()
+		{
+			FSentryHardwareContexts LoadedContexts;
+			TestFalse("Contexts not loaded", SentryContextCache::Load(CachePath, TEXT("fingerprint"), LoadedContexts));
+		});
+	});
+
+	Describe("Probe", [this]()
+	{
+		It("should always provide device context", [this]()
+		{
+			TestTrue("Device context probed", SentryContextCache::Probe().Device.Num() > 0);
+		});
+	});
+}
+
+#endif
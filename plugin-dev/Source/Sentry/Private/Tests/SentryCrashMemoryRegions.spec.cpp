@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryCrashMemoryRegions.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashMemoryRegionsSpec, "Sentry.SentryCrashMemoryRegions", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString FilePath;
+	TArray<int32> Handles;
+
+	int32 Register(const FString& Name, const void* Address, int32 Size)
+	{
+		const int32 Handle = FSentryCrashMemoryRegions::Get().Register(Name, Address, Size);
+		Handles.Add(Handle);
+		return Handle;
+	}
+
+	template <typename T>
+	static T ReadValue(const TArray<uint8>& Data, int32& Offset)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Data.GetData() + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return Value;
+	}
+END_DEFINE_SPEC(SentryCrashMemoryRegionsSpec)
+
+void SentryCrashMemoryRegionsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		FilePath = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("crash_memory.bin"));
+		FSentryCrashMemoryRegions::Get().SetMaxTotalSize(1024);
+	});
+
+	AfterEach([this]()
+	{
+		for (int32 Handle : Handles)
+		{
+			FSentryCrashMemoryRegions::Get().Unregister(Handle);
+		}
+		Handles.Empty();
+
+		FSentryCrashMemoryRegions::Get().SetMaxTotalSize(256 * 1024);
+		IFileManager::Get().Delete(*FilePath);
+	});
+
+	Describe("Register", [this]()
+	{
+		It("should reject empty regions", [this]()
+		{
+			const uint8 Byte = 0;
+
+			TestEqual("Null address", Register(TEXT("null"), nullptr, 4), INDEX_NONE);
+			TestEqual("Zero size", Register(TEXT("empty"), &Byte, 0), INDEX_NONE);
+		});
+
+		It("should reject regions once the budget is exhausted", [this]()
+		{
+			static uint8 Buffer[1024];
+
+			TestNotEqual("First region registered", Register(TEXT("first"), Buffer, 1024), INDEX_NONE);
+			TestEqual("Second region rejected", Register(TEXT("second"), Buffer, 1), INDEX_NONE);
+		});
+
+		It("should free the budget of unregistered regions", [this]()
+		{
+			static uint8 Buffer[1024];
+
+			FSentryCrashMemoryRegions::Get().Unregister(Register(TEXT("first"), Buffer, 1024));
+
+			TestNotEqual("Second region registered", Register(TEXT("second"), Buffer, 1024), INDEX_NONE);
+		});
+	});
+
+	Describe("Write", [this]()
+	{
+		It("should write the registered regions", [this]()
+		{
+			const uint32 GameState[2] = { 0xDEADBEEF, 42 };
+			Register(TEXT("GameState"), GameState, sizeof(GameState));
+
+			TestTrue("File written", FSentryCrashMemoryRegions::Get().Write(FilePath));
+
+			TArray<uint8> Data;
+			TestTrue("File read", FFileHelper::LoadFileToArray(Data, *FilePath));
+
+			int32 Offset = 0;
+			TestEqual("Magic", FString(8, reinterpret_cast<const ANSICHAR*>(Data.GetData())), TEXT("SNTRYMEM"));
+			Offset += 8;
+			TestEqual("Version", ReadValue<uint32>(Data, Offset), 1u);
+			TestEqual("Number of regions", ReadValue<uint32>(Data, Offset), 1u);
+
+			const uint32 NameLength = ReadValue<uint32>(Data, Offset);
+			TestEqual("Name", FString(NameLength, reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset)), TEXT("GameState"));
+			Offset += NameLength;
+
+			TestEqual("Address", ReadValue<uint64>(Data, Offset), static_cast<uint64>(reinterpret_cast<UPTRINT>(GameState)));
+			TestEqual("Size", ReadValue<uint32>(Data, Offset), static_cast<uint32>(sizeof(GameState)));
+			TestEqual("First value", ReadValue<uint32>(Data, Offset), 0xDEADBEEFu);
+			TestEqual("Second value", ReadValue<uint32>(Data, Offset), 42u);
+			TestEqual("Nothing left", Offset, Data.Num());
+		});
+
+		It("should truncate regions exceeding the budget", [this]()
+		{
+			static uint8 Buffer[2048];
+			Register(TEXT("large"), Buffer, sizeof(Buffer));
+
+			TestTrue("File written", FSentryCrashMemoryRegions::Get().Write(FilePath));
+
+			TestEqual("File size", IFileManager::Get().FileSize(*FilePath), static_cast<int64>(8 + 4 + 4 + 4 + 5 + 8 + 4 + 1024));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryCrashVideoHistory.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoHistorySpec, "Sentry.SentryCrashVideoHistory", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString FilePath;
+	TUniquePtr<FSentryCrashVideoHistory> History;
+
+	static constexpr int64 Now = 1700000000;
+	static constexpr int64 Day = 24 * 60 * 60;
+END_DEFINE_SPEC(SentryCrashVideoHistorySpec)
+
+void SentryCrashVideoHistorySpec::Define()
+{
+	BeforeEach([this]()
+	{
+		FilePath = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("crash_video_history.bin"));
+		IFileManager::Get().Delete(*FilePath);
+
+		History = MakeUnique<FSentryCrashVideoHistory>();
+	});
+
+	AfterEach([this]()
+	{
+		History.Reset();
+		IFileManager::Get().Delete(*FilePath);
+	});
+
+	Describe("GetCrashFingerprint", [this]()
+	{
+		It("should not depend on the module load address", [this]()
+		{
+			const uint64 Stack[3] = { 0x7FF612341234, 0x7FF612345678, 0x7FF6123459AB };
+			const uint64 RelocatedStack[3] = { 0x7FF698761234, 0x7FF698765678, 0x7FF6987659AB };
+
+			TestEqual("Fingerprint", FSentryCrashVideoHistory::GetCrashFingerprint(RelocatedStack, 3), FSentryCrashVideoHistory::GetCrashFingerprint(Stack, 3));
+		});
+
+		It("should differ for different call sites", [this]()
+		{
+			const uint64 Stack[3] = { 0x7FF612341234, 0x7FF612345678, 0x7FF6123459AB };
+			const uint64 OtherStack[3] = { 0x7FF612341234, 0x7FF612345680, 0x7FF6123459AB };
+
+			TestNotEqual("Fingerprint", FSentryCrashVideoHistory::GetCrashFingerprint(OtherStack, 3), FSentryCrashVideoHistory::GetCrashFingerprint(Stack, 3));
+		});
+	});
+
+	Describe("ShouldCaptureVideo", [this]()
+	{
+		It("should skip crashes with a fingerprint sent within the retention period", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+
+			TestTrue("First crash", History->ShouldCaptureVideo(42, Now) == ESentryCrashVideoSkipReason::None);
+			History->MarkPending(42, ESentryCrashVideoDelivery::Deferred, TEXT("event-1"), Now);
+			History->ConfirmUpload(TEXT("event-1"), Now);
+
+			TestTrue("Same crash", History->ShouldCaptureVideo(42, Now + Day) == ESentryCrashVideoSkipReason::Duplicate);
+			TestTrue("Other crash", History->ShouldCaptureVideo(7, Now + Day) == ESentryCrashVideoSkipReason::None);
+		});
+
+		It("should capture crashes again once the fingerprint expired", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+
+			History->MarkPending(42, ESentryCrashVideoDelivery::Deferred, TEXT("event-1"), Now);
+			History->ConfirmUpload(TEXT("event-1"), Now);
+
+			TestTrue("Expired crash", History->ShouldCaptureVideo(42, Now + 7 * Day) == ESentryCrashVideoSkipReason::None);
+		});
+
+		It("should not de-duplicate crashes without a retention period", [this]()
+		{
+			History->Open(FilePath, 1.0f, 0);
+
+			History->MarkPending(42, ESentryCrashVideoDelivery::Deferred, TEXT("event-1"), Now);
+			History->ConfirmUpload(TEXT("event-1"), Now);
+
+			TestTrue("Same crash", History->ShouldCaptureVideo(42, Now) == ESentryCrashVideoSkipReason::None);
+		});
+
+		It("should sample out crashes", [this]()
+		{
+			History->Open(FilePath, 0.0f, 7);
+
+			TestTrue("Crash", History->ShouldCaptureVideo(42, Now) == ESentryCrashVideoSkipReason::SampledOut);
+		});
+
+		It("should replace the oldest fingerprint once the history is full", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+
+			for (uint32 Fingerprint = 1; Fingerprint <= 256; ++Fingerprint)
+			{
+				const FString EventId = FString::Printf(TEXT("event-%u"), Fingerprint);
+				History->MarkPending(Fingerprint, ESentryCrashVideoDelivery::Deferred, EventId, Now + Fingerprint);
+				History->ConfirmUpload(EventId, Now + Fingerprint);
+			}
+
+			History->MarkPending(1000, ESentryCrashVideoDelivery::Deferred, TEXT("event-1000"), Now + 1000);
+			History->ConfirmUpload(TEXT("event-1000"), Now + 1000);
+
+			TestTrue("New crash", History->ShouldCaptureVideo(1000, Now + 1000) == ESentryCrashVideoSkipReason::Duplicate);
+			TestTrue("Oldest crash", History->ShouldCaptureVideo(1, Now + 1000) == ESentryCrashVideoSkipReason::None);
+			TestTrue("Newest crash", History->ShouldCaptureVideo(256, Now + 1000) == ESentryCrashVideoSkipReason::Duplicate);
+		});
+	});
+
+	Describe("MarkPending", [this]()
+	{
+		It("should not skip crashes while the deferred video wasn't uploaded", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+
+			History->MarkPending(42, ESentryCrashVideoDelivery::Deferred, TEXT("event-1"), Now);
+
+			TestTrue("Same crash", History->ShouldCaptureVideo(42, Now + Day) == ESentryCrashVideoSkipReason::None);
+		});
+
+		It("should only confirm the fingerprint of the uploaded video", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+
+			History->MarkPending(42, ESentryCrashVideoDelivery::Deferred, TEXT("event-1"), Now);
+			History->MarkPending(7, ESentryCrashVideoDelivery::Deferred, TEXT("event-2"), Now);
+			History->ConfirmUpload(TEXT("event-2"), Now);
+
+			TestTrue("Pending crash", History->ShouldCaptureVideo(42, Now + Day) == ESentryCrashVideoSkipReason::None);
+			TestTrue("Uploaded crash", History->ShouldCaptureVideo(7, Now + Day) == ESentryCrashVideoSkipReason::Duplicate);
+		});
+
+		It("should confirm attached videos on the next launch", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+			History->MarkPending(42, ESentryCrashVideoDelivery::Attached, FString(), FDateTime::UtcNow().ToUnixTimestamp());
+			History->Close();
+
+			History->Open(FilePath, 1.0f, 7);
+
+			TestTrue("Same crash", History->ShouldCaptureVideo(42, FDateTime::UtcNow().ToUnixTimestamp()) == ESentryCrashVideoSkipReason::Duplicate);
+		});
+
+		It("should keep deferred videos pending on the next launch", [this]()
+		{
+			History->Open(FilePath, 1.0f, 7);
+			History->MarkPending(42, ESentryCrashVideoDelivery::Deferred, TEXT("event-1"), FDateTime::UtcNow().ToUnixTimestamp());
+			History->Close();
+
+			History->Open(FilePath, 1.0f, 7);
+
+			TestTrue("Same crash", History->ShouldCaptureVideo(42, FDateTime::UtcNow().ToUnixTimestamp()) == ESentryCrashVideoSkipReason::None);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryCrashVideoPendingUpload.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoPendingUploadSpec, "Sentry.SentryCrashVideoPendingUpload", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString CrashVideoDirectory;
+	FSentryPendingCrashVideo PendingVideo;
+
+	FString AddFile(const TCHAR* Name, int32 Size)
+	{
+		const FString Path = FPaths::Combine(PendingVideo.Directory, Name);
+
+		TArray<uint8> Data;
+		Data.SetNumZeroed(Size);
+		FFileHelper::SaveArrayToFile(Data, *Path);
+
+		PendingVideo.Files.Add(Path);
+		return Path;
+	}
+END_DEFINE_SPEC(SentryCrashVideoPendingUploadSpec)
+
+void SentryCrashVideoPendingUploadSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		CrashVideoDirectory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("CrashVideoPendingUpload"));
+
+		PendingVideo = FSentryPendingCrashVideo();
+		PendingVideo.Directory = FPaths::Combine(CrashVideoDirectory, TEXT("PendingUpload_event"));
+		PendingVideo.EventId = TEXT("event");
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().DeleteDirectory(*CrashVideoDirectory, false, true);
+	});
+
+	Describe("Preview", [this]()
+	{
+		It("should select the newest segments fitting the budget without the concat index", [this]()
+		{
+			AddFile(TEXT("segment_0.mp4"), 400);
+			const FString Newer = AddFile(TEXT("segment_1.mp4"), 400);
+			const FString Newest = AddFile(TEXT("segment_2.mp4"), 400);
+			AddFile(TEXT("crash_video_segments.ffconcat"), 10);
+			const FString Timeline = AddFile(TEXT("crash_video_timeline.bin"), 10);
+
+			TestEqual("Preview files", SentryCrashVideoPendingUpload::SelectPreview(PendingVideo, 1000), TArray<FString>({ Newer, Newest, Timeline }));
+		});
+
+		It("should select the newest segment even if it exceeds the budget", [this]()
+		{
+			AddFile(TEXT("segment_0.mp4"), 400);
+			const FString Newest = AddFile(TEXT("segment_1.mp4"), 400);
+
+			TestEqual("Preview files", SentryCrashVideoPendingUpload::SelectPreview(PendingVideo, 100), TArray<FString>({ Newest }));
+		});
+
+		It("should select every file if all videos fit the budget", [this]()
+		{
+			AddFile(TEXT("segment_0.mp4"), 400);
+			AddFile(TEXT("crash_video_segments.ffconcat"), 10);
+
+			TestEqual("Preview files", SentryCrashVideoPendingUpload::SelectPreview(PendingVideo, 1000), PendingVideo.Files);
+		});
+
+		It("should keep the rest of the clip once the preview is uploaded", [this]()
+		{
+			const FString Oldest = AddFile(TEXT("segment_0.mp4"), 400);
+			const FString Newest = AddFile(TEXT("segment_1.mp4"), 400);
+			const FString Index = AddFile(TEXT("crash_video_segments.ffconcat"), 10);
+
+			SentryCrashVideoPendingUpload::MarkPreviewUploaded(PendingVideo, { Newest });
+
+			const TArray<FSentryPendingCrashVideo> PendingVideos = SentryCrashVideoPendingUpload::Collect(CrashVideoDirectory, 7);
+
+			TestEqual("Pending videos", PendingVideos.Num(), 1);
+			if (PendingVideos.Num() == 1)
+			{
+				TestTrue("Preview uploaded", PendingVideos[0].bIsPreviewUploaded);
+				TestEqual("Remaining files", PendingVideos[0].Files, TArray<FString>({ Oldest, Index }));
+			}
+		});
+	});
+
+	Describe("Upload claim", [this]()
+	{
+		It("should not collect a video that is being uploaded", [this]()
+		{
+			AddFile(TEXT("segment_0.mp4"), 400);
+			SentryCrashVideoPendingUpload::MarkFilesUploaded(PendingVideo, {});
+
+			TestTrue("First claim", SentryCrashVideoPendingUpload::TryBeginUpload(PendingVideo));
+			TestFalse("Second claim", SentryCrashVideoPendingUpload::TryBeginUpload(PendingVideo));
+			TestEqual("Pending videos while uploading", SentryCrashVideoPendingUpload::Collect(CrashVideoDirectory).Num(), 0);
+
+			SentryCrashVideoPendingUpload::EndUpload(PendingVideo);
+
+			TestEqual("Pending videos after release", SentryCrashVideoPendingUpload::Collect(CrashVideoDirectory).Num(), 1);
+		});
+	});
+}
+
+#endif
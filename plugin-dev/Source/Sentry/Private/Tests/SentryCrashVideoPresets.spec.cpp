@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "SentryCrashVideoConfig.h"
+#include "Utils/SentryCrashVideoPresets.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoPresetsSpec, "Sentry.SentryCrashVideoPresets", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	TArray<FCrashVideoPreset> Presets;
+END_DEFINE_SPEC(SentryCrashVideoPresetsSpec)
+
+void SentryCrashVideoPresetsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Presets = SentryCrashVideoPresets::GetDefaultPresets();
+	});
+
+	Describe("FindPreset", [this]()
+	{
+		It("should select the preset of the device profile", [this]()
+		{
+			const int32 Index = SentryCrashVideoPresets::FindPreset(Presets, { TEXT("Android_Low"), TEXT("Android") }, 3);
+
+			TestEqual("Preset", Presets[Index].Name, TEXT("LowEnd"));
+		});
+
+		It("should match the profiles the device profile is based on", [this]()
+		{
+			const int32 Index = SentryCrashVideoPresets::FindPreset(Presets, { TEXT("Android_Adreno6xx"), TEXT("Android_High"), TEXT("Android") }, 3);
+
+			TestEqual("Preset", Presets[Index].Name, TEXT("Mobile"));
+		});
+
+		It("should match device profiles ignoring case", [this]()
+		{
+			const int32 Index = SentryCrashVideoPresets::FindPreset(Presets, { TEXT("ios") }, 3);
+
+			TestEqual("Preset", Presets[Index].Name, TEXT("Mobile"));
+		});
+
+		It("should select the preset of the scalability level", [this]()
+		{
+			TestEqual("Low scalability", Presets[SentryCrashVideoPresets::FindPreset(Presets, { TEXT("Windows") }, 1)].Name, TEXT("LowScalability"));
+			TestEqual("High scalability", Presets[SentryCrashVideoPresets::FindPreset(Presets, { TEXT("Windows") }, 3)].Name, TEXT("Detailed"));
+		});
+
+		It("should return none if no preset matches", [this]()
+		{
+			Presets.SetNum(2);
+
+			TestEqual("Index", SentryCrashVideoPresets::FindPreset(Presets, { TEXT("Windows") }, 3), static_cast<int32>(INDEX_NONE));
+		});
+	});
+}
+
+#endif
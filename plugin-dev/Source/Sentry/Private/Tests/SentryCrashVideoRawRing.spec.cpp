@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryCrashVideoRawRing.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoRawRingSpec, "Sentry.SentryCrashVideoRawRing", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryCrashVideoRawRingSpec)
+
+void SentryCrashVideoRawRingSpec::Define()
+{
+	Describe("I420 conversion", [this]()
+	{
+		It("should keep colors close to the original", [this]()
+		{
+			const int32 Width = 4;
+			const int32 Height = 2;
+
+			TArray<FColor> Pixels;
+			Pixels.Init(FColor(200, 100, 50, 255), Width * Height);
+
+			TArray<uint8> I420;
+			I420.SetNumUninitialized(Width * Height * 3 / 2);
+			FSentryCrashVideoRawRing::ConvertToI420(Pixels.GetData(), Width, Height, I420.GetData());
+
+			TArray<FColor> Converted;
+			Converted.SetNumUninitialized(Width * Height);
+			FSentryCrashVideoRawRing::ConvertFromI420(I420.GetData(), Width, Height, Converted.GetData());
+
+			for (const FColor& Color : Converted)
+			{
+				TestTrue("Red", FMath::Abs(Color.R - 200) <= 3);
+				TestTrue("Green", FMath::Abs(Color.G - 100) <= 3);
+				TestTrue("Blue", FMath::Abs(Color.B - 50) <= 3);
+			}
+		});
+	});
+
+	Describe("Tiles", [this]()
+	{
+		It("should cover the whole frame with a single tile", [this]()
+		{
+			TestEqual("Tile", FSentryCrashVideoRawRing::GetTileRect(0, 1, 640, 360), FIntRect(0, 0, 640, 360));
+		});
+
+		It("should lay out the tiles in a grid row by row", [this]()
+		{
+			TestEqual("First tile", FSentryCrashVideoRawRing::GetTileRect(0, 3, 640, 360), FIntRect(0, 0, 320, 180));
+			TestEqual("Second tile", FSentryCrashVideoRawRing::GetTileRect(1, 3, 640, 360), FIntRect(320, 0, 640, 180));
+			TestEqual("Third tile", FSentryCrashVideoRawRing::GetTileRect(2, 3, 640, 360), FIntRect(0, 180, 320, 360));
+		});
+
+		It("should keep the tile dimensions even", [this]()
+		{
+			const FIntRect Tile = FSentryCrashVideoRawRing::GetTileRect(4, 9, 640, 360);
+
+			TestEqual("Width", Tile.Width() % 2, 0);
+			TestEqual("Height", Tile.Height() % 2, 0);
+			TestEqual("Left", Tile.Min.X % 2, 0);
+			TestEqual("Top", Tile.Min.Y % 2, 0);
+		});
+
+		It("should be empty for tiles out of range", [this]()
+		{
+			TestEqual("Negative index", FSentryCrashVideoRawRing::GetTileRect(INDEX_NONE, 2, 640, 360).Area(), 0);
+			TestEqual("Index past the last tile", FSentryCrashVideoRawRing::GetTileRect(2, 2, 640, 360).Area(), 0);
+		});
+
+		It("should letterbox windows into tiles of another aspect ratio", [this]()
+		{
+			const FIntRect Tile = FSentryCrashVideoRawRing::GetTileRect(1, 2, 640, 360);
+
+			TestEqual("Wide window", FSentryCrashVideoRawRing::GetLetterboxRect(Tile, FIntPoint(1920, 1080)), FIntRect(320, 90, 640, 270));
+			TestEqual("Tall window", FSentryCrashVideoRawRing::GetLetterboxRect(FIntRect(0, 0, 640, 360), FIntPoint(1080, 1920)), FIntRect(218, 0, 420, 360));
+			TestEqual("Same aspect ratio", FSentryCrashVideoRawRing::GetLetterboxRect(FIntRect(0, 0, 640, 360), FIntPoint(1280, 720)), FIntRect(0, 0, 640, 360));
+		});
+	});
+
+	Describe("Long tier", [this]()
+	{
+		It("should average the source pixels of every downscaled pixel", [this]()
+		{
+			TArray<FColor> Pixels;
+			Pixels.Add(FColor(0, 0, 0, 255));
+			Pixels.Add(FColor(200, 100, 40, 255));
+			Pixels.Add(FColor(100, 50, 20, 255));
+			Pixels.Add(FColor(100, 50, 20, 255));
+
+			FColor Downscaled;
+			FSentryCrashVideoRawRing::Downscale(Pixels.GetData(), 2, 2, &Downscaled, 1, 1);
+
+			TestEqual("Red", Downscaled.R, 100);
+			TestEqual("Green", Downscaled.G, 50);
+			TestEqual("Blue", Downscaled.B, 20);
+		});
+
+		It("should be recorded next to the regular ring", [this]()
+		{
+			const FString LongTierPath = FSentryCrashVideoRawRing::GetLongTierPath(FSentryCrashVideoRawRing::GetDefaultPath());
+
+			TestEqual("Same directory", FPaths::GetPath(LongTierPath), FPaths::GetPath(FSentryCrashVideoRawRing::GetDefaultPath()));
+			TestTrue("Long tier", FSentryCrashVideoRawRing::IsLongTierRing(LongTierPath));
+			TestFalse("Regular ring", FSentryCrashVideoRawRing::IsLongTierRing(FSentryCrashVideoRawRing::GetDefaultPath()));
+		});
+
+		It("should be found along with the regular ring of the same crash", [this]()
+		{
+			const FString Directory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("ClaimedRings"));
+			const FString RingPath = FPaths::Combine(Directory, TEXT("raw_frames_crash_abc123.ring"));
+			const FString LongTierRingPath = FPaths::Combine(Directory, TEXT("raw_frames_crash_abc123_long.ring"));
+
+			FFileHelper::SaveStringToFile(TEXT("ring"), *RingPath);
+			FFileHelper::SaveStringToFile(TEXT("ring"), *LongTierRingPath);
+
+			const TMap<FString, FString> ClaimedRings = FSentryCrashVideoRawRing::FindClaimedRings(Directory);
+
+			TestEqual("Both rings found", ClaimedRings.Num(), 2);
+			TestEqual("Event of the regular ring", ClaimedRings.FindRef(RingPath), FString(TEXT("abc123")));
+			TestEqual("Event of the long tier", ClaimedRings.FindRef(LongTierRingPath), FString(TEXT("abc123")));
+
+			IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		});
+	});
+
+	Describe("ClaimCrashedRing", [this]()
+	{
+		It("should ignore files that are not rings", [this]()
+		{
+			const FString RingPath = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("not_a_ring.ring"));
+
+			TArray<uint8> Garbage;
+			Garbage.Init(0xAB, 256);
+			FFileHelper::SaveArrayToFile(Garbage, *RingPath);
+
+			TestFalse("Claimed", FSentryCrashVideoRawRing::ClaimCrashedRing(RingPath));
+			TestTrue("File kept", IFileManager::Get().FileExists(*RingPath));
+
+			IFileManager::Get().Delete(*RingPath);
+		});
+
+		It("should ignore missing files", [this]()
+		{
+			TestFalse("Claimed", FSentryCrashVideoRawRing::ClaimCrashedRing(FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("missing.ring"))));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryCrashVideoSegments.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoSegmentsSpec, "Sentry.SentryCrashVideoSegments", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString Directory;
+	TArray<FString> Paths;
+
+	static constexpr int64 SegmentSize = 100;
+END_DEFINE_SPEC(SentryCrashVideoSegmentsSpec)
+
+void SentryCrashVideoSegmentsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Directory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("SentryTests"), TEXT("CrashVideoSegments"));
+
+		Paths.Empty();
+		for (const TCHAR* Name : { TEXT("segment_0.mp4"), TEXT("segment_1.mp4"), TEXT("segment_2.mp4") })
+		{
+			const FString Path = FPaths::Combine(Directory, Name);
+
+			TArray<uint8> Data;
+			Data.SetNumZeroed(SegmentSize);
+			FFileHelper::SaveArrayToFile(Data, *Path);
+
+			Paths.Add(Path);
+		}
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	});
+
+	Describe("Bookmarks", [this]()
+	{
+		It("should evict segments that no bookmark overlaps", [this]()
+		{
+			FSentryCrashVideoSegments Segments;
+			Segments.Configure(1);
+			Segments.ConfigureBookmarks(1000.0f, 1024 * 1024);
+
+			Segments.AddSegment(Paths[0]);
+			const TArray<FString> Evicted = Segments.AddSegment(Paths[1]);
+
+			TestEqual("Evicted segments", Evicted, TArray<FString>({ Paths[0] }));
+			TestEqual("Nothing pinned", Segments.GetPinnedBytes(), static_cast<int64>(0));
+		});
+
+		It("should pin evicted segments overlapping a bookmark", [this]()
+		{
+			FSentryCrashVideoSegments Segments;
+			Segments.Configure(1);
+			Segments.ConfigureBookmarks(1000.0f, 1024 * 1024);
+
+			Segments.AddBookmark(TEXT("desync"), FPlatformTime::Seconds());
+			Segments.AddSegment(Paths[0]);
+			const TArray<FString> Evicted = Segments.AddSegment(Paths[1]);
+
+			TestEqual("Nothing evicted", Evicted.Num(), 0);
+			TestEqual("Ring segments", Segments.GetSegments(), TArray<FString>({ Paths[1] }));
+			TestEqual("Pinned size", Segments.GetPinnedBytes(), SegmentSize);
+			TestEqual("Bookmark segments", Segments.GetBookmarkSegments(TEXT("desync")), TArray<FString>({ Paths[0], Paths[1] }));
+		});
+
+		It("should not pin segments when pinning is disabled", [this]()
+		{
+			FSentryCrashVideoSegments Segments;
+			Segments.Configure(1);
+			Segments.ConfigureBookmarks(1000.0f, 0);
+
+			Segments.AddBookmark(TEXT("desync"), FPlatformTime::Seconds());
+			Segments.AddSegment(Paths[0]);
+
+			TestEqual("Evicted segments", Segments.AddSegment(Paths[1]), TArray<FString>({ Paths[0] }));
+		});
+
+		It("should release pinned segments once the bookmark is removed", [this]()
+		{
+			FSentryCrashVideoSegments Segments;
+			Segments.Configure(1);
+			Segments.ConfigureBookmarks(1000.0f, 1024 * 1024);
+
+			Segments.AddBookmark(TEXT("desync"), FPlatformTime::Seconds());
+			Segments.AddSegment(Paths[0]);
+			Segments.AddSegment(Paths[1]);
+
+			TestEqual("Released segments", Segments.RemoveBookmark(TEXT("desync")), TArray<FString>({ Paths[0] }));
+			TestFalse("Bookmark removed", Segments.HasBookmark(TEXT("desync")));
+			TestEqual("Nothing pinned", Segments.GetPinnedBytes(), static_cast<int64>(0));
+		});
+
+		It("should release the oldest pinned segments exceeding the budget", [this]()
+		{
+			FSentryCrashVideoSegments Segments;
+			Segments.Configure(1);
+			Segments.ConfigureBookmarks(1000.0f, SegmentSize);
+
+			Segments.AddBookmark(TEXT("desync"), FPlatformTime::Seconds());
+			Segments.AddSegment(Paths[0]);
+			Segments.AddSegment(Paths[1]);
+			const TArray<FString> Evicted = Segments.AddSegment(Paths[2]);
+
+			TestEqual("Evicted segments", Evicted, TArray<FString>({ Paths[0] }));
+			TestEqual("Pinned size", Segments.GetPinnedBytes(), SegmentSize);
+			TestEqual("Bookmark segments", Segments.GetBookmarkSegments(TEXT("desync")), TArray<FString>({ Paths[1], Paths[2] }));
+		});
+
+		It("should forget bookmarks on reset", [this]()
+		{
+			FSentryCrashVideoSegments Segments;
+			Segments.Configure(1);
+			Segments.AddBookmark(TEXT("desync"), FPlatformTime::Seconds());
+
+			Segments.Reset();
+
+			TestEqual("No bookmarks", Segments.GetBookmarkNames().Num(), 0);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryDatabaseMaintenance.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryDatabaseMaintenanceSpec, "Sentry.SentryDatabaseMaintenance", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString DatabasePath;
+
+	FString WriteFile(const FString& RelativePath, int32 Size, const FDateTime& Timestamp)
+	{
+		const FString Path = FPaths::Combine(DatabasePath, RelativePath);
+
+		TArray<uint8> Data;
+		Data.SetNumZeroed(Size);
+		FFileHelper::SaveArrayToFile(Data, *Path);
+		IFileManager::Get().SetTimeStamp(*Path, Timestamp);
+
+		return Path;
+	}
+END_DEFINE_SPEC(SentryDatabaseMaintenanceSpec)
+
+void SentryDatabaseMaintenanceSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		DatabasePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryTests"), TEXT("Database"));
+		IFileManager::Get().DeleteDirectory(*DatabasePath, false, true);
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().DeleteDirectory(*DatabasePath, false, true);
+	});
+
+	It("should delete reports older than the max age", [this]()
+	{
+		const FDateTime Now = FDateTime::UtcNow();
+
+		const FString OldReport = WriteFile(TEXT("completed/old.dmp"), 16, Now - FTimespan::FromDays(10));
+		const FString NewReport = WriteFile(TEXT("completed/new.dmp"), 16, Now - FTimespan::FromDays(1));
+
+		FSentryDatabaseRetention Retention;
+		Retention.MaxAgeDays = 5;
+
+		TestEqual("Deleted files", FSentryDatabaseMaintenance::Prune(DatabasePath, Retention, Now), 1);
+		TestFalse("Old report deleted", IFileManager::Get().FileExists(*OldReport));
+		TestTrue("New report kept", IFileManager::Get().FileExists(*NewReport));
+	});
+
+	It("should delete the oldest reports until the rest fits the max size", [this]()
+	{
+		const FDateTime Now = FDateTime::UtcNow();
+
+		const FString OldestReport = WriteFile(TEXT("reports/a.dmp"), 100, Now - FTimespan::FromHours(3));
+		const FString OlderAttachment = WriteFile(TEXT("attachments/b/log.txt"), 100, Now - FTimespan::FromHours(2));
+		const FString NewestReport = WriteFile(TEXT("pending/c.dmp"), 100, Now - FTimespan::FromHours(1));
+
+		FSentryDatabaseRetention Retention;
+		Retention.MaxSizeBytes = 150;
+
+		TestEqual("Deleted files", FSentryDatabaseMaintenance::Prune(DatabasePath, Retention, Now), 2);
+		TestFalse("Oldest report deleted", IFileManager::Get().FileExists(*OldestReport));
+		TestFalse("Older attachment deleted", IFileManager::Get().FileExists(*OlderAttachment));
+		TestTrue("Newest report kept", IFileManager::Get().FileExists(*NewestReport));
+	});
+
+	It("should not touch files outside of the report directories", [this]()
+	{
+		const FDateTime Now = FDateTime::UtcNow();
+
+		const FString SpooledEnvelope = WriteFile(TEXT("spool/0_1.envelope"), 16, Now - FTimespan::FromDays(10));
+		const FString LastCrash = WriteFile(TEXT("last_crash"), 16, Now - FTimespan::FromDays(10));
+
+		FSentryDatabaseRetention Retention;
+		Retention.MaxAgeDays = 1;
+		Retention.MaxSizeBytes = 1;
+
+		TestEqual("Deleted files", FSentryDatabaseMaintenance::Prune(DatabasePath, Retention, Now), 0);
+		TestTrue("Spooled envelope kept", IFileManager::Get().FileExists(*SpooledEnvelope));
+		TestTrue("Last crash marker kept", IFileManager::Get().FileExists(*LastCrash));
+	});
+}
+
+#endif
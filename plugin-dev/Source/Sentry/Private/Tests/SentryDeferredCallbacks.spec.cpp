@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryDeferredCallbacks.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryDeferredCallbacksSpec, "Sentry.SentryDeferredCallbacks", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	TSharedPtr<FSentryDeferredCallbacks, ESPMode::ThreadSafe> DeferredCallbacks;
+END_DEFINE_SPEC(SentryDeferredCallbacksSpec)
+
+void SentryDeferredCallbacksSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		DeferredCallbacks = MakeShared<FSentryDeferredCallbacks, ESPMode::ThreadSafe>(2);
+	});
+
+	AfterEach([this]()
+	{
+		DeferredCallbacks.Reset();
+	});
+
+	It("should run deferred callbacks in order when flushed", [this]()
+	{
+		TArray<int32> Order;
+
+		DeferredCallbacks->Defer([&Order](bool bCanRun) { Order.Add(bCanRun ? 1 : -1); });
+		DeferredCallbacks->Defer([&Order](bool bCanRun) { Order.Add(bCanRun ? 2 : -2); });
+
+		DeferredCallbacks->Flush();
+
+		TestEqual("Callbacks run", Order.Num(), 2);
+		TestEqual("First callback runs first", Order[0], 1);
+		TestEqual("Second callback runs second", Order[1], 2);
+		TestEqual("Queue is empty", DeferredCallbacks->Num(), 0);
+	});
+
+	It("should refuse callbacks above the capacity", [this]()
+	{
+		int32 RunCount = 0;
+
+		TestTrue("First callback deferred", DeferredCallbacks->Defer([&RunCount](bool bCanRun) { ++RunCount; }));
+		TestTrue("Second callback deferred", DeferredCallbacks->Defer([&RunCount](bool bCanRun) { ++RunCount; }));
+		TestFalse("Third callback refused", DeferredCallbacks->Defer([&RunCount](bool bCanRun) { ++RunCount; }));
+
+		DeferredCallbacks->Flush();
+
+		TestEqual("Only accepted callbacks run", RunCount, 2);
+	});
+
+	It("should let discarded callbacks release what they hold", [this]()
+	{
+		bool bWasRun = false;
+		bool bWasDiscarded = false;
+
+		DeferredCallbacks->Defer([&bWasRun, &bWasDiscarded](bool bCanRun)
+		{
+			bWasRun = bCanRun;
+			bWasDiscarded = !bCanRun;
+		});
+
+		DeferredCallbacks.Reset();
+
+		TestFalse("Callback not run", bWasRun);
+		TestTrue("Callback discarded", bWasDiscarded);
+	});
+}
+
+#endif
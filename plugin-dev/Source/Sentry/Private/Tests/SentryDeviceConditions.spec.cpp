@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryDeviceConditions.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryDeviceConditionsSpec, "Sentry.SentryDeviceConditions", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	/** Max CPU clock of the simulated device. */
+	static constexpr int32 MaxClockMHz = 3000;
+END_DEFINE_SPEC(SentryDeviceConditionsSpec)
+
+void SentryDeviceConditionsSpec::Define()
+{
+	Describe("Throttling", [this]()
+	{
+		It("should be detected from the thermal state right away", [this]()
+		{
+			FSentryThrottleDetector Detector;
+			TestFalse("Fair", Detector.Update(FSentryDeviceConditions(0.0, ESentryThermalState::Fair, 50, 2800, MaxClockMHz)));
+			TestTrue("Serious", Detector.Update(FSentryDeviceConditions(10.0, ESentryThermalState::Serious, 50, 2800, MaxClockMHz)));
+			TestFalse("Cooled down", Detector.Update(FSentryDeviceConditions(20.0, ESentryThermalState::Fair, 50, 2800, MaxClockMHz)));
+		});
+
+		It("should not be detected from a single sample of reduced CPU clocks", [this]()
+		{
+			FSentryThrottleDetector Detector;
+			TestFalse("Idle clock", Detector.Update(FSentryDeviceConditions(0.0, ESentryThermalState::Unknown, 50, 1200, MaxClockMHz)));
+			TestFalse("Busy clock", Detector.Update(FSentryDeviceConditions(10.0, ESentryThermalState::Unknown, 50, 2800, MaxClockMHz)));
+			TestFalse("Idle clock again", Detector.Update(FSentryDeviceConditions(20.0, ESentryThermalState::Unknown, 50, 1200, MaxClockMHz)));
+			TestFalse("Unknown clock", Detector.Update(FSentryDeviceConditions(30.0, ESentryThermalState::Unknown, 50, -1, MaxClockMHz)));
+		});
+
+		It("should be detected from CPU clocks staying well below their max", [this]()
+		{
+			FSentryThrottleDetector Detector;
+			for (int32 Index = 0; Index < FSentryThrottleDetector::SustainedSamples - 1; ++Index)
+			{
+				TestFalse("Not sustained yet", Detector.Update(FSentryDeviceConditions(Index * 10.0, ESentryThermalState::Unknown, 50, 1200, MaxClockMHz)));
+			}
+
+			TestTrue("Sustained", Detector.Update(FSentryDeviceConditions(100.0, ESentryThermalState::Unknown, 50, 1200, MaxClockMHz)));
+		});
+
+		It("should only end once CPU clocks are back close to their max", [this]()
+		{
+			FSentryThrottleDetector Detector;
+			for (int32 Index = 0; Index < FSentryThrottleDetector::SustainedSamples; ++Index)
+			{
+				Detector.Update(FSentryDeviceConditions(Index * 10.0, ESentryThermalState::Unknown, 50, 1200, MaxClockMHz));
+			}
+
+			TestTrue("Slightly above the threshold", Detector.Update(FSentryDeviceConditions(100.0, ESentryThermalState::Unknown, 50, 2000, MaxClockMHz)));
+			TestFalse("Recovered", Detector.Update(FSentryDeviceConditions(110.0, ESentryThermalState::Unknown, 50, 2600, MaxClockMHz)));
+		});
+	});
+
+	Describe("Changes", [this]()
+	{
+		It("should ignore small clock changes", [this]()
+		{
+			const FSentryDeviceConditions Previous = FSentryDeviceConditions(0.0, ESentryThermalState::Nominal, 50, 2800, MaxClockMHz);
+
+			TestFalse("Small change", FSentryDeviceConditions(10.0, ESentryThermalState::Nominal, 50, 2700, MaxClockMHz).HasChangedSince(Previous));
+			TestTrue("Large change", FSentryDeviceConditions(10.0, ESentryThermalState::Nominal, 50, 2000, MaxClockMHz).HasChangedSince(Previous));
+			TestTrue("Thermal change", FSentryDeviceConditions(10.0, ESentryThermalState::Fair, 50, 2800, MaxClockMHz).HasChangedSince(Previous));
+			TestTrue("Battery change", FSentryDeviceConditions(10.0, ESentryThermalState::Nominal, 49, 2800, MaxClockMHz).HasChangedSince(Previous));
+		});
+	});
+
+	Describe("Device conditions context", [this]()
+	{
+		It("should be empty without samples", [this]()
+		{
+			TestEqual("No values", FSentryDeviceConditionsSampler::ToContext(TArray<FSentryDeviceConditions>()).Num(), 0);
+		});
+
+		It("should contain the latest sample and the trend", [this]()
+		{
+			TArray<FSentryDeviceConditions> History;
+			History.Add(FSentryDeviceConditions(0.0, ESentryThermalState::Nominal, 80, 2800, MaxClockMHz));
+			History.Add(FSentryDeviceConditions(900.0, ESentryThermalState::Fair, 78, 2400, MaxClockMHz));
+			History.Add(FSentryDeviceConditions(1800.0, ESentryThermalState::Serious, 75, 1500, MaxClockMHz));
+			History.Last().bIsThrottled = true;
+
+			const TMap<FString, FSentryVariant> Context = FSentryDeviceConditionsSampler::ToContext(History);
+
+			TestEqual("Thermal state", Context.FindRef(TEXT("thermal_state")).GetValue<FString>(), FString(TEXT("serious")));
+			TestTrue("Throttled", Context.FindRef(TEXT("throttled")).GetValue<bool>());
+			TestEqual("Battery level", Context.FindRef(TEXT("battery_level")).GetValue<int32>(), 75);
+			TestEqual("Thermal trend", Context.FindRef(TEXT("thermal_trend")).GetValue<FString>(), FString(TEXT("rising")));
+			TestEqual("Battery drain", Context.FindRef(TEXT("battery_drain_percent_per_hour")).GetValue<float>(), 10.0f, 0.01f);
+			TestEqual("CPU clock change", Context.FindRef(TEXT("cpu_frequency_change_mhz")).GetValue<int32>(), -1300);
+			TestFalse("No GPU clock", Context.Contains(TEXT("gpu_frequency_mhz")));
+		});
+	});
+}
+
+#endif
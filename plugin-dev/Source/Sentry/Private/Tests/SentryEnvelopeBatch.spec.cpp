@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryEnvelopeBatchSpec, "Sentry.SentryEnvelopeBatch", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static TArray<uint8> ToBytes(const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static FString ToString(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+END_DEFINE_SPEC(SentryEnvelopeBatchSpec)
+
+void SentryEnvelopeBatchSpec::Define()
+{
+	const FString Header = TEXT("{\"dsn\":\"https://key@sentry.io/1\"}\n");
+	const FString Session = TEXT("{\"type\":\"session\"}\n{\"status\":\"ok\"}\n");
+	const FString Event = TEXT("{\"event_id\":\"0123456789abcdef0123456789abcdef\"}\n{\"type\":\"event\",\"length\":2}\n{}\n");
+
+	Describe("Batchable envelopes", [this, Header, Session, Event]()
+	{
+		It("should accept envelopes with sessions and logs only", [this, Header, Session]()
+		{
+			TestTrue("Session is batchable", FSentryEnvelopeBatch::IsBatchable(ToBytes(Header + Session)));
+			TestTrue("Logs are batchable", FSentryEnvelopeBatch::IsBatchable(ToBytes(Header + TEXT("{\"type\":\"log\",\"item_count\":1}\n{\"items\":[{\"body\":\"A\"}]}\n"))));
+		});
+
+		It("should reject envelopes with events and malformed envelopes", [this, Header, Session, Event]()
+		{
+			TestFalse("Event isn't batchable", FSentryEnvelopeBatch::IsBatchable(ToBytes(Event)));
+			TestFalse("Session with attachment isn't batchable", FSentryEnvelopeBatch::IsBatchable(ToBytes(Header + Session + TEXT("{\"type\":\"attachment\",\"length\":1}\nA\n"))));
+			TestFalse("Envelope without items isn't batchable", FSentryEnvelopeBatch::IsBatchable(ToBytes(Header)));
+			TestFalse("Item with invalid length isn't batchable", FSentryEnvelopeBatch::IsBatchable(ToBytes(Header + TEXT("{\"type\":\"session\",\"length\":100}\n{}\n"))));
+		});
+	});
+
+	Describe("Merging", [this, Header, Session, Event]()
+	{
+		It("should merge items of several envelopes under the first header", [this, Header, Session, Event]()
+		{
+			FSentryEnvelopeBatch Batch;
+
+			TestTrue("First envelope added", Batch.Add(ToBytes(Header + Session)));
+			TestTrue("Second envelope added", Batch.Add(ToBytes(Header + Session)));
+			TestFalse("Event not added", Batch.Add(ToBytes(Event)));
+			TestEqual("Envelopes counted", Batch.GetNumEnvelopes(), 2);
+
+			TestEqual("Items merged", ToString(Batch.Take()), Header + Session + Session);
+			TestTrue("Batch reset", Batch.IsEmpty());
+		});
+
+		It("should merge logs into a single container", [this, Header]()
+		{
+			FSentryEnvelopeBatch Batch;
+
+			Batch.Add(ToBytes(Header + TEXT("{\"type\":\"log\",\"item_count\":1}\n{\"items\":[{\"body\":\"A\"}]}\n")));
+			Batch.Add(ToBytes(Header + TEXT("{\"type\":\"log\",\"item_count\":2,\"length\":37}\n{\"items\":[{\"body\":\"B\"},{\"body\":\"C\"}]}\n")));
+
+			const FString Envelope = ToString(Batch.Take());
+
+			TestTrue("Log count updated", Envelope.Contains(TEXT("\"item_count\":3")));
+			TestTrue("Logs merged", Envelope.Contains(TEXT("{\"items\":[{\"body\":\"A\"},{\"body\":\"B\"},{\"body\":\"C\"}]}")));
+		});
+	});
+}
+
+#endif
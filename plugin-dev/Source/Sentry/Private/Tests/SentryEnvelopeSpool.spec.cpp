@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryEnvelopeSpool.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryEnvelopeSpoolSpec, "Sentry.SentryEnvelopeSpool", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FString SpoolDirectory;
+
+	static TArray<uint8> MakeEnvelope(const FString& Type, int32 PayloadSize)
+	{
+		const FString Envelope = FString::Printf(TEXT("{}\n{\"type\":\"%s\",\"length\":%d}\n%s\n"), *Type, PayloadSize, *FString::ChrN(PayloadSize, TEXT('x')));
+
+		const FTCHARToUTF8 Converted(*Envelope);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+END_DEFINE_SPEC(SentryEnvelopeSpoolSpec)
+
+void SentryEnvelopeSpoolSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		SpoolDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryTests"), TEXT("Spool"));
+		IFileManager::Get().DeleteDirectory(*SpoolDirectory, false, true);
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().DeleteDirectory(*SpoolDirectory, false, true);
+	});
+
+	Describe("Priority", [this]()
+	{
+		It("should rank events over transactions over logs", [this]()
+		{
+			TestTrue("Event priority", FSentryEnvelopeSpool::GetPriority(MakeEnvelope(TEXT("event"), 10)) == ESentryEnvelopePriority::High);
+			TestTrue("Transaction priority", FSentryEnvelopeSpool::GetPriority(MakeEnvelope(TEXT("transaction"), 10)) == ESentryEnvelopePriority::Normal);
+			TestTrue("Log priority", FSentryEnvelopeSpool::GetPriority(MakeEnvelope(TEXT("log"), 10)) == ESentryEnvelopePriority::Low);
+		});
+	});
+
+	Describe("Storage", [this]()
+	{
+		It("should return envelopes by priority and age", [this]()
+		{
+			FSentryEnvelopeSpool Spool(SpoolDirectory, 1024 * 1024);
+
+			const TArray<uint8> Log = MakeEnvelope(TEXT("log"), 10);
+			const TArray<uint8> FirstEvent = MakeEnvelope(TEXT("event"), 11);
+			const TArray<uint8> SecondEvent = MakeEnvelope(TEXT("event"), 12);
+
+			Spool.Store(Log, ESentryEnvelopePriority::Low);
+			Spool.Store(FirstEvent, ESentryEnvelopePriority::High);
+			Spool.Store(SecondEvent, ESentryEnvelopePriority::High);
+
+			FString Id;
+			TArray<uint8> Envelope;
+
+			TestTrue("First envelope loaded", Spool.Peek(Id, Envelope));
+			TestTrue("Oldest event first", Envelope == FirstEvent);
+			Spool.Remove(Id);
+
+			TestTrue("Second envelope loaded", Spool.Peek(Id, Envelope));
+			TestTrue("Newer event second", Envelope == SecondEvent);
+			Spool.Remove(Id);
+
+			TestTrue("Third envelope loaded", Spool.Peek(Id, Envelope));
+			TestTrue("Log last", Envelope == Log);
+			Spool.Remove(Id);
+
+			TestTrue("Spool empty", Spool.IsEmpty());
+			TestEqual("Size reset", Spool.GetSize(), 0ll);
+		});
+
+		It("should keep envelopes across sessions", [this]()
+		{
+			{
+				FSentryEnvelopeSpool Spool(SpoolDirectory, 1024 * 1024);
+				Spool.Store(MakeEnvelope(TEXT("event"), 10), ESentryEnvelopePriority::High);
+			}
+
+			FSentryEnvelopeSpool Spool(SpoolDirectory, 1024 * 1024);
+			TestEqual("Envelope picked up", Spool.Num(), 1);
+		});
+	});
+
+	Describe("Eviction", [this]()
+	{
+		It("should evict the oldest envelopes of the lowest priority first", [this]()
+		{
+			const TArray<uint8> Event = MakeEnvelope(TEXT("event"), 100);
+			const TArray<uint8> OldLog = MakeEnvelope(TEXT("log"), 101);
+			const TArray<uint8> NewLog = MakeEnvelope(TEXT("log"), 102);
+
+			FSentryEnvelopeSpool Spool(SpoolDirectory, Event.Num() + OldLog.Num() + NewLog.Num() - 1);
+
+			TestTrue("Event stored", Spool.Store(Event, ESentryEnvelopePriority::High));
+			TestTrue("Old log stored", Spool.Store(OldLog, ESentryEnvelopePriority::Low));
+			TestTrue("New log stored", Spool.Store(NewLog, ESentryEnvelopePriority::Low));
+			TestEqual("Old log evicted", Spool.Num(), 2);
+
+			FString Id;
+			TArray<uint8> Envelope;
+
+			Spool.Peek(Id, Envelope);
+			Spool.Remove(Id);
+			Spool.Peek(Id, Envelope);
+			TestTrue("New log kept", Envelope == NewLog);
+		});
+
+		It("should not evict envelopes of a higher priority", [this]()
+		{
+			const TArray<uint8> Event = MakeEnvelope(TEXT("event"), 100);
+
+			FSentryEnvelopeSpool Spool(SpoolDirectory, Event.Num());
+
+			TestTrue("Event stored", Spool.Store(Event, ESentryEnvelopePriority::High));
+			TestFalse("Log dropped", Spool.Store(MakeEnvelope(TEXT("log"), 10), ESentryEnvelopePriority::Low));
+			TestEqual("Event kept", Spool.Num(), 1);
+		});
+	});
+
+	Describe("Backoff", [this]()
+	{
+		It("should grow the delay up to the limit", [this]()
+		{
+			FSentryRetryBackoff Backoff(1.0, 8.0);
+
+			const double First = Backoff.NextDelay();
+			TestTrue("First delay within base", First >= 0.5 && First <= 1.0);
+
+			Backoff.NextDelay();
+			Backoff.NextDelay();
+			Backoff.NextDelay();
+
+			const double Capped = Backoff.NextDelay();
+			TestTrue("Delay capped", Capped >= 4.0 && Capped <= 8.0);
+
+			Backoff.Reset();
+			TestTrue("Delay reset", Backoff.NextDelay() <= 1.0);
+		});
+	});
+}
+
+#endif
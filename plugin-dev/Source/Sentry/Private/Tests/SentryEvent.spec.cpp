@@ -1,6 +1,7 @@
 // Copyright (c) 2025 Sentry. All Rights Reserved.
 
 #include "SentryEvent.h"
+#include "SentryEventView.h"
 #include "SentryTests.h"
 
 #include "Misc/AutomationTest.h"
@@ -145,6 +146,45 @@ void SentryEventSpec::Define()
 			TestFalse("No context with given key available after it was removed (Try)", SentryEvent->TryGetContext(TEXT("TestContext1"), NonExistingContext));
 			TestEqual("No context with given key available after it was removed", SentryEvent->GetContext(TEXT("TestContext1")).Num(), 0);
 		});
+
+		It("can be looked up by a single value", [this]()
+		{
+			TMap<FString, FSentryVariant> TestContext;
+			TestContext.Add(TEXT("Key1"), TEXT("Val1"));
+			TestContext.Add(TEXT("Key2"), 42);
+
+			SentryEvent->SetContext(TEXT("TestContext"), TestContext);
+
+			FSentryVariant Value;
+			TestTrue("Context value found", SentryEvent->TryGetContextValue(TEXT("TestContext"), TEXT("Key2"), Value));
+			TestEqual("Context value retains its original value", Value.GetValue<int32>(), 42);
+			TestFalse("Missing context value not found", SentryEvent->TryGetContextValue(TEXT("TestContext"), TEXT("Key3"), Value));
+			TestFalse("Missing context not found", SentryEvent->TryGetContextValue(TEXT("OtherContext"), TEXT("Key1"), Value));
+		});
+	});
+
+	Describe("Event view", [this]()
+	{
+		It("should look up tags and context strings as UTF-8", [this]()
+		{
+			TMap<FString, FSentryVariant> TestContext;
+			TestContext.Add(TEXT("Key1"), TEXT("Val1"));
+
+			SentryEvent->SetTag(TEXT("TagKey"), TEXT("TagVal"));
+			SentryEvent->SetContext(TEXT("TestContext"), TestContext);
+
+			FSentryEventView View(*SentryEvent->GetNativeObject());
+
+			FAnsiStringView Tag;
+			TestTrue("Tag found", View.TryGetTagUtf8("TagKey", Tag));
+			TestTrue("Tag retains its original value", Tag.Equals("TagVal"));
+			TestFalse("Missing tag not found", View.TryGetTagUtf8("OtherKey", Tag));
+
+			FAnsiStringView ContextValue;
+			TestTrue("Context string found", View.TryGetContextStringUtf8("TestContext", "Key1", ContextValue));
+			TestTrue("Context string retains its original value", ContextValue.Equals("Val1"));
+			TestFalse("Missing context string not found", View.TryGetContextStringUtf8("TestContext", "Key2", ContextValue));
+		});
 	});
 
 	Describe("Event extras", [this]()
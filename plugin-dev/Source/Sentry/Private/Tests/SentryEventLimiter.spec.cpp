@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryEventLimiter.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryEventLimiterSpec, "Sentry.SentryEventLimiter", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryEventLimiterSpec)
+
+void SentryEventLimiterSpec::Define()
+{
+	Describe("Duplicate limiting", [this]()
+	{
+		It("should suppress duplicates beyond the per-fingerprint limit", [this]()
+		{
+			FSentryEventLimiter Limiter(3, 0);
+			const uint32 Fingerprint = FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Error, {});
+
+			int32 NumCaptured = 0;
+			for (int32 i = 0; i < 10; ++i)
+			{
+				NumCaptured += Limiter.ShouldCapture(Fingerprint, TEXT("Spam")) ? 1 : 0;
+			}
+
+			TestEqual("Only limit captured", NumCaptured, 3);
+		});
+
+		It("should track fingerprints independently", [this]()
+		{
+			FSentryEventLimiter Limiter(1, 0);
+
+			TestTrue("Event captured", Limiter.ShouldCapture(FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Error, {}), TEXT("Spam")));
+			TestTrue("Event with another level captured", Limiter.ShouldCapture(FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Warning, {}), TEXT("Spam")));
+			TestTrue("Event from another call site captured", Limiter.ShouldCapture(FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Error, { 0x1234 }), TEXT("Spam")));
+			TestTrue("Event from another Blueprint captured", Limiter.ShouldCapture(FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Error, {}, TEXT("BP_Player.Tick")), TEXT("Spam")));
+		});
+	});
+
+	Describe("Global limiting", [this]()
+	{
+		It("should suppress events beyond the global limit", [this]()
+		{
+			FSentryEventLimiter Limiter(0, 2);
+
+			int32 NumCaptured = 0;
+			for (int32 i = 0; i < 5; ++i)
+			{
+				const FString Message = FString::Printf(TEXT("Event %d"), i);
+				NumCaptured += Limiter.ShouldCapture(FSentryEventLimiter::GetFingerprint(Message, ESentryLevel::Error, {}), Message) ? 1 : 0;
+			}
+
+			TestEqual("Only limit captured", NumCaptured, 2);
+		});
+	});
+
+	Describe("Summary", [this]()
+	{
+		It("should report suppressed events once", [this]()
+		{
+			FSentryEventLimiter Limiter(1, 0);
+			const uint32 Fingerprint = FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Error, {});
+
+			FString Summary;
+			TestFalse("Nothing to report", Limiter.TakeSuppressedSummary(Summary, 0.0));
+
+			Limiter.ShouldCapture(Fingerprint, TEXT("Spam"));
+			Limiter.ShouldCapture(Fingerprint, TEXT("Spam"));
+			Limiter.ShouldCapture(Fingerprint, TEXT("Spam"));
+
+			TestTrue("Summary reported", Limiter.TakeSuppressedSummary(Summary, 0.0));
+			TestTrue("Summary counts suppressed events", Summary.Contains(TEXT("2x Spam")));
+			TestFalse("Summary not repeated", Limiter.TakeSuppressedSummary(Summary, 0.0));
+		});
+
+		It("should wait for the report interval", [this]()
+		{
+			FSentryEventLimiter Limiter(1, 0);
+			const uint32 Fingerprint = FSentryEventLimiter::GetFingerprint(TEXT("Spam"), ESentryLevel::Error, {});
+
+			Limiter.ShouldCapture(Fingerprint, TEXT("Spam"));
+			Limiter.ShouldCapture(Fingerprint, TEXT("Spam"));
+
+			FString Summary;
+			TestFalse("Summary not due", Limiter.TakeSuppressedSummary(Summary, 3600.0));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryFrameBreakdown.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryFrameBreakdownSpec, "Sentry.SentryFrameBreakdown", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryFrameBreakdownSpec)
+
+void SentryFrameBreakdownSpec::Define()
+{
+	Describe("Frame sampling", [this]()
+	{
+		It("should sample one in every N frames on average with jitter", [this]()
+		{
+			FRandomStream Random(1234);
+
+			const int32 Interval = 600;
+			const int32 NumSamples = 1000;
+
+			uint64 Frame = 0;
+			uint64 MinGap = MAX_uint64;
+			uint64 MaxGap = 0;
+
+			for (int32 Index = 0; Index < NumSamples; ++Index)
+			{
+				const uint64 Next = FSentryFrameBreakdown::GetNextSampledFrame(Frame, Interval, Random);
+				MinGap = FMath::Min(MinGap, Next - Frame);
+				MaxGap = FMath::Max(MaxGap, Next - Frame);
+				Frame = Next;
+			}
+
+			TestTrue("Gaps of at least half an interval", MinGap >= Interval / 2);
+			TestTrue("Gaps of at most one and a half intervals", MaxGap <= Interval + Interval / 2);
+			TestTrue("Gaps vary", MaxGap > MinGap);
+
+			const double AverageGap = static_cast<double>(Frame) / NumSamples;
+			TestTrue("Average gap close to the interval", FMath::Abs(AverageGap - Interval) < Interval * 0.05);
+		});
+
+		It("should always move forward", [this]()
+		{
+			FRandomStream Random(1);
+
+			TestTrue("Next frame with an interval of one", FSentryFrameBreakdown::GetNextSampledFrame(10, 1, Random) > 10);
+			TestTrue("Next frame with an invalid interval", FSentryFrameBreakdown::GetNextSampledFrame(10, 0, Random) > 10);
+		});
+	});
+}
+
+#endif
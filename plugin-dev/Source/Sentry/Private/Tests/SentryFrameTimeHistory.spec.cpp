@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryFrameTimeHistory.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryFrameTimeHistorySpec, "Sentry.SentryFrameTimeHistory", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryFrameTimeHistorySpec)
+
+void SentryFrameTimeHistorySpec::Define()
+{
+	Describe("Performance context", [this]()
+	{
+		It("should be empty without frames", [this]()
+		{
+			TestEqual("No values", FSentryFrameTimeHistory::ToContext(TArray<FSentryFrameTimeHistory::FFrame>()).Num(), 0);
+		});
+
+		It("should summarize recorded frames", [this]()
+		{
+			TArray<FSentryFrameTimeHistory::FFrame> Frames;
+			Frames.Add(FSentryFrameTimeHistory::FFrame(10, 1.0, 10.0f));
+			Frames.Add(FSentryFrameTimeHistory::FFrame(11, 1.05, 50.0f));
+			Frames.Add(FSentryFrameTimeHistory::FFrame(12, 1.85, 800.0f));
+			Frames.Add(FSentryFrameTimeHistory::FFrame(13, 1.86, 20.0f));
+
+			Frames[2].GpuMs = 600.0f;
+
+			const TMap<FString, FSentryVariant> Context = FSentryFrameTimeHistory::ToContext(Frames);
+
+			TestEqual("Frames counted", Context.FindRef(TEXT("frames")).GetValue<int32>(), 4);
+			TestEqual("First frame", Context.FindRef(TEXT("first_frame")).GetValue<int32>(), 10);
+			TestEqual("Last frame", Context.FindRef(TEXT("last_frame")).GetValue<int32>(), 13);
+			TestEqual("Slow frames", Context.FindRef(TEXT("slow_frames")).GetValue<int32>(), 2);
+			TestEqual("Frozen frames", Context.FindRef(TEXT("frozen_frames")).GetValue<int32>(), 1);
+			TestEqual("Average frame time", Context.FindRef(TEXT("frame_avg_ms")).GetValue<float>(), 220.0f, 0.01f);
+			TestEqual("Max GPU time", Context.FindRef(TEXT("gpu_max_ms")).GetValue<float>(), 600.0f, 0.01f);
+			TestEqual("Recent frames listed", Context.FindRef(TEXT("recent_frame_ms")).GetValue<FString>(), FString(TEXT("10.0,50.0,800.0,20.0")));
+			TestFalse("No GC pauses", Context.Contains(TEXT("gc_frames")));
+		});
+
+		It("should summarize garbage collection pauses", [this]()
+		{
+			TArray<FSentryFrameTimeHistory::FFrame> Frames;
+			Frames.Add(FSentryFrameTimeHistory::FFrame(10, 1.0, 10.0f));
+			Frames.Add(FSentryFrameTimeHistory::FFrame(11, 1.05, 50.0f, 35.0f));
+			Frames.Add(FSentryFrameTimeHistory::FFrame(12, 1.1, 20.0f, 5.0f));
+
+			const TMap<FString, FSentryVariant> Context = FSentryFrameTimeHistory::ToContext(Frames);
+
+			TestEqual("GC frames", Context.FindRef(TEXT("gc_frames")).GetValue<int32>(), 2);
+			TestEqual("GC total", Context.FindRef(TEXT("gc_total_ms")).GetValue<float>(), 40.0f, 0.01f);
+			TestEqual("GC max", Context.FindRef(TEXT("gc_max_ms")).GetValue<float>(), 35.0f, 0.01f);
+		});
+	});
+}
+
+#endif
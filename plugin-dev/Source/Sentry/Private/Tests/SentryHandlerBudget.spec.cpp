@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryHandlerBudget.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryHandlerBudgetSpec, "Sentry.SentryHandlerBudget", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static uint64 ToCycles(double Ms)
+	{
+		return static_cast<uint64>(Ms / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+	}
+END_DEFINE_SPEC(SentryHandlerBudgetSpec)
+
+void SentryHandlerBudgetSpec::Define()
+{
+	AfterEach([this]()
+	{
+		FSentryHandlerBudget::Get().Start(0.0f, false);
+	});
+
+	It("should keep call statistics", [this]()
+	{
+		FSentryHandlerBudget::Get().Start(0.0f, false);
+
+		FSentryHandlerBudget::Get().Record(ESentryHandlerType::BeforeLog, ToCycles(1.0));
+		FSentryHandlerBudget::Get().Record(ESentryHandlerType::BeforeLog, ToCycles(3.0));
+
+		const FSentryHandlerStats Stats = FSentryHandlerBudget::Get().GetStats(ESentryHandlerType::BeforeLog);
+		TestEqual("Number of calls", Stats.NumCalls, static_cast<uint64>(2));
+		TestEqual("Average call", Stats.GetAverageMs(), 2.0, 0.01);
+		TestEqual("Longest call", Stats.MaxMs, 3.0, 0.01);
+		TestEqual("No budget", Stats.NumOverBudget, static_cast<uint64>(0));
+
+		TestEqual("Other handlers unaffected", FSentryHandlerBudget::Get().GetStats(ESentryHandlerType::BeforeSend).NumCalls, static_cast<uint64>(0));
+	});
+
+	It("should count calls over the budget without disabling the handler", [this]()
+	{
+		FSentryHandlerBudget::Get().Start(1.0f, false);
+
+		for (int32 Index = 0; Index < 10; ++Index)
+		{
+			FSentryHandlerBudget::Get().Record(ESentryHandlerType::BeforeSend, ToCycles(2.0));
+		}
+
+		TestEqual("Calls over budget", FSentryHandlerBudget::Get().GetStats(ESentryHandlerType::BeforeSend).NumOverBudget, static_cast<uint64>(10));
+		TestFalse("Handler enabled", FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::BeforeSend));
+	});
+
+	It("should disable the handler exceeding the budget several calls in a row", [this]()
+	{
+		FSentryHandlerBudget::Get().Start(1.0f, true);
+
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			FSentryHandlerBudget::Get().Record(ESentryHandlerType::TraceSampler, ToCycles(2.0));
+		}
+
+		FSentryHandlerBudget::Get().Record(ESentryHandlerType::TraceSampler, ToCycles(0.5));
+		TestFalse("Handler enabled after a fast call", FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::TraceSampler));
+
+		for (int32 Index = 0; Index < 5; ++Index)
+		{
+			FSentryHandlerBudget::Get().Record(ESentryHandlerType::TraceSampler, ToCycles(2.0));
+		}
+
+		TestTrue("Handler disabled", FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::TraceSampler));
+
+		FSentryHandlerBudget::Get().Start(1.0f, true);
+		TestFalse("Handler enabled after restart", FSentryHandlerBudget::Get().IsDisabled(ESentryHandlerType::TraceSampler));
+	});
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryHttpTracing.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryHttpTracingSpec, "Sentry.SentryHttpTracing", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryHttpTracingSpec)
+
+void SentryHttpTracingSpec::Define()
+{
+	Describe("ShouldPropagate", [this]()
+	{
+		It("should propagate to all URLs without targets", [this]()
+		{
+			TestTrue("Propagate", SentryHttpTracing::ShouldPropagate(TEXT("https://example.com/api"), {}));
+		});
+
+		It("should only propagate to matching targets", [this]()
+		{
+			const TArray<FString> Targets = { TEXT("api.mygame.com"), TEXT("") };
+
+			TestTrue("Matching URL", SentryHttpTracing::ShouldPropagate(TEXT("https://api.mygame.com/v1/match"), Targets));
+			TestFalse("Other URL", SentryHttpTracing::ShouldPropagate(TEXT("https://cdn.example.com/patch"), Targets));
+		});
+	});
+
+	Describe("GetSpanDescription", [this]()
+	{
+		It("should strip query string and fragment", [this]()
+		{
+			TestEqual("Description", SentryHttpTracing::GetSpanDescription(TEXT("post"), TEXT("https://example.com/api?token=secret#top")), TEXT("POST https://example.com/api"));
+		});
+
+		It("should default to GET", [this]()
+		{
+			TestEqual("Description", SentryHttpTracing::GetSpanDescription(TEXT(""), TEXT("https://example.com")), TEXT("GET https://example.com"));
+		});
+	});
+
+	Describe("GetBaggage", [this]()
+	{
+		const FString TraceId = TEXT("2674eb52d5874b13b560236d6c79ce8a");
+
+		It("should carry the trace ID and sampling decision", [this, TraceId]()
+		{
+			const FString Baggage = SentryHttpTracing::GetBaggage(TraceId + TEXT("-a0f9fdf04f1a63df-1"), TEXT("key"), TEXT("game@1.0 beta"), TEXT("production"));
+
+			TestEqual("Baggage", Baggage, FString::Printf(TEXT("sentry-trace_id=%s,sentry-public_key=key,sentry-release=game%%401.0%%20beta,sentry-environment=production,sentry-sampled=true"), *TraceId));
+		});
+
+		It("should be empty for malformed headers", [this]()
+		{
+			TestTrue("Baggage", SentryHttpTracing::GetBaggage(TEXT("not-a-trace"), TEXT("key"), TEXT(""), TEXT("")).IsEmpty());
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryInputRing.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryInputRingSpec, "Sentry.SentryInputRing", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryInputRingSpec)
+
+void SentryInputRingSpec::Define()
+{
+	Describe("Serialization", [this]()
+	{
+		It("should serialize entries as JSON with times relative to the capture", [this]()
+		{
+			TArray<FSentryInputRing::FEntry> Entries;
+			Entries.Add(FSentryInputRing::FEntry::Make(FSentryInputRing::EType::KeyDown, TEXT("W"), 0));
+			Entries.Add(FSentryInputRing::FEntry::Make(FSentryInputRing::EType::MouseMove, NAME_None, 0, 12.0f, -4.0f));
+			Entries.Add(FSentryInputRing::FEntry::Make(FSentryInputRing::EType::TouchStart, NAME_None, 0, 100.0f, 200.0f));
+
+			Entries[0].Timestamp = 8.0;
+			Entries[1].Timestamp = 9.0;
+			Entries[1].Count = 5;
+			Entries[2].Timestamp = 9.5;
+
+			const TSharedPtr<FJsonObject> Json = SentryTests::ParseJson(FSentryInputRing::Serialize(Entries, 10.0, 120));
+			if (!TestTrue("Valid JSON", Json.IsValid()))
+			{
+				return;
+			}
+
+			TestEqual("Frame", Json->GetIntegerField(TEXT("frame")), 120);
+
+			const TArray<TSharedPtr<FJsonValue>>& Events = Json->GetArrayField(TEXT("events"));
+			if (!TestEqual("Events", Events.Num(), 3))
+			{
+				return;
+			}
+
+			const TSharedPtr<FJsonObject> KeyDown = Events[0]->AsObject();
+			TestEqual("Key down type", KeyDown->GetStringField(TEXT("type")), TEXT("key_down"));
+			TestEqual("Key down key", KeyDown->GetStringField(TEXT("key")), TEXT("W"));
+			TestEqual("Key down time", KeyDown->GetNumberField(TEXT("t")), -2.0, 0.001);
+
+			const TSharedPtr<FJsonObject> MouseMove = Events[1]->AsObject();
+			TestEqual("Mouse move type", MouseMove->GetStringField(TEXT("type")), TEXT("mouse_move"));
+			TestFalse("Mouse move has no key", MouseMove->HasField(TEXT("key")));
+			TestEqual("Mouse move delta", MouseMove->GetNumberField(TEXT("dx")), 12.0, 0.001);
+			TestEqual("Mouse move count", MouseMove->GetIntegerField(TEXT("count")), 5);
+
+			const TSharedPtr<FJsonObject> Touch = Events[2]->AsObject();
+			TestEqual("Touch type", Touch->GetStringField(TEXT("type")), TEXT("touch_start"));
+			TestEqual("Touch position", Touch->GetNumberField(TEXT("y")), 200.0, 0.001);
+		});
+
+		It("should not record anything while inactive", [this]()
+		{
+			FSentryInputRing& Ring = FSentryInputRing::Get();
+			if (Ring.IsActive())
+			{
+				return;
+			}
+
+			Ring.Record(FSentryInputRing::EType::KeyDown, TEXT("W"), 0);
+			TestEqual("Nothing serialized", Ring.Serialize().Num(), 0);
+		});
+	});
+}
+
+#endif
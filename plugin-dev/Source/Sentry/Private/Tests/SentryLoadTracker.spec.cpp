@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryLoadTracker.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryLoadTrackerSpec, "Sentry.SentryLoadTracker", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	TUniquePtr<FSentryLoadTracker> LoadTracker;
+	TArray<FSentryLoadTracker::FLoad> FinishedLoads;
+END_DEFINE_SPEC(SentryLoadTrackerSpec)
+
+void SentryLoadTrackerSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		FinishedLoads.Empty();
+
+		LoadTracker = MakeUnique<FSentryLoadTracker>(100.0f, [this](const FSentryLoadTracker::FLoad& Load)
+		{
+			FinishedLoads.Add(Load);
+		});
+	});
+
+	AfterEach([this]()
+	{
+		LoadTracker.Reset();
+	});
+
+	Describe("Map load", [this]()
+	{
+		It("should report a failed load when no world was loaded", [this]()
+		{
+			LoadTracker->OnPreLoadMap(TEXT("/Game/Maps/Missing"));
+			LoadTracker->OnPostLoadMap(nullptr);
+
+			// Editor may still be loading packages in the background, the load finishes once that settles
+			for (int32 Frame = 0; Frame < 1000 && FinishedLoads.Num() == 0; ++Frame)
+			{
+				LoadTracker->Tick();
+			}
+
+			if (!TestEqual("Number of loads", FinishedLoads.Num(), 1))
+			{
+				return;
+			}
+
+			const FSentryLoadTracker::FLoad& Load = FinishedLoads[0];
+
+			TestEqual("Name", Load.Name, TEXT("Map load: Missing"));
+			TestTrue("Has spans", Load.Spans.Num() > 0);
+			TestTrue("Load end", Load.EndTime >= Load.StartTime);
+
+			if (Load.Spans.Num() > 0)
+			{
+				TestEqual("Operation", Load.Spans[0].Operation, TEXT("map.load.failed"));
+				TestEqual("Description", Load.Spans[0].Description, TEXT("Missing"));
+			}
+		});
+
+		It("should ignore PostLoadMap without a preceding PreLoadMap", [this]()
+		{
+			LoadTracker->OnPostLoadMap(nullptr);
+
+			TestEqual("Number of loads", FinishedLoads.Num(), 0);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryLogCategoryFilter.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryLogCategoryFilterSpec, "Sentry.SentryLogCategoryFilter", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryLogCategoryFilterSpec)
+
+void SentryLogCategoryFilterSpec::Define()
+{
+	Describe("Category names", [this]()
+	{
+		It("should match regardless of case", [this]()
+		{
+			FSentryLogCategoryFilter Filter({ TEXT("LogTemp") });
+
+			TestTrue("Exact name matches", Filter.Matches(FName(TEXT("LogTemp"))));
+			TestTrue("Different case matches", Filter.Matches(FName(TEXT("logtemp"))));
+			TestFalse("Other name doesn't match", Filter.Matches(FName(TEXT("LogNet"))));
+		});
+
+		It("should be empty without entries", [this]()
+		{
+			FSentryLogCategoryFilter Filter({ TEXT(" ") });
+
+			TestTrue("Blank entries are ignored", Filter.IsEmpty());
+		});
+	});
+
+	Describe("Wildcard patterns", [this]()
+	{
+		It("should match prefixes", [this]()
+		{
+			FSentryLogCategoryFilter Filter({ TEXT("LogNet*") });
+
+			TestTrue("Prefixed category matches", Filter.Matches(FName(TEXT("LogNetTraffic"))));
+			TestTrue("Repeated lookup matches", Filter.Matches(FName(TEXT("LogNetTraffic"))));
+			TestFalse("Other category doesn't match", Filter.Matches(FName(TEXT("LogTemp"))));
+			TestFalse("Repeated lookup doesn't match", Filter.Matches(FName(TEXT("LogTemp"))));
+		});
+	});
+}
+
+#endif
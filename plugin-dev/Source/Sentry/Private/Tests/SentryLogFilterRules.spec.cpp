@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "SentrySettings.h"
+
+#include "Utils/SentryLogFilterRules.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryLogFilterRulesSpec, "Sentry.SentryLogFilterRules", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static FSentryLogFilterRule MakeRule(const FString& Category, ESentryLogFilterTextMatch TextMatch, const FString& Text, ESentryLevel MaxLevel, float SampleRate)
+	{
+		FSentryLogFilterRule Rule;
+		Rule.Category = Category;
+		Rule.TextMatch = TextMatch;
+		Rule.Text = Text;
+		Rule.MaxLevel = MaxLevel;
+		Rule.SampleRate = SampleRate;
+		return Rule;
+	}
+END_DEFINE_SPEC(SentryLogFilterRulesSpec)
+
+void SentryLogFilterRulesSpec::Define()
+{
+	It("should keep logs matching no rule", [this]()
+	{
+		const FSentryLogFilterRules Rules({ MakeRule(TEXT("LogNet"), ESentryLogFilterTextMatch::Contains, TEXT(""), ESentryLevel::Fatal, 0.0f) });
+
+		TestEqual("Other category", Rules.GetSampleRate("[LogTemp] Message", ESentryLevel::Info), 1.0);
+		TestEqual("No category", Rules.GetSampleRate("Message", ESentryLevel::Info), 1.0);
+		TestTrue("Log kept", Rules.ShouldKeep("[LogTemp] Message", ESentryLevel::Info));
+	});
+
+	It("should match categories case-insensitively", [this]()
+	{
+		const FSentryLogFilterRules Rules({ MakeRule(TEXT("LogNet"), ESentryLogFilterTextMatch::Contains, TEXT(""), ESentryLevel::Fatal, 0.0f) });
+
+		TestEqual("Same case", Rules.GetSampleRate("[LogNet] Message", ESentryLevel::Info), 0.0);
+		TestEqual("Other case", Rules.GetSampleRate("[lognet] Message", ESentryLevel::Info), 0.0);
+		TestEqual("Longer category", Rules.GetSampleRate("[LogNetTraffic] Message", ESentryLevel::Info), 1.0);
+		TestFalse("Log dropped", Rules.ShouldKeep("[LogNet] Message", ESentryLevel::Info));
+	});
+
+	It("should match text by substring or prefix of the message", [this]()
+	{
+		const FSentryLogFilterRules Rules({
+			MakeRule(TEXT(""), ESentryLogFilterTextMatch::StartsWith, TEXT("Ping"), ESentryLevel::Fatal, 0.25f),
+			MakeRule(TEXT(""), ESentryLogFilterTextMatch::Contains, TEXT("timeout"), ESentryLevel::Fatal, 0.5f) });
+
+		TestEqual("Prefix after category", Rules.GetSampleRate("[LogNet] Ping 20ms", ESentryLevel::Info), 0.25);
+		TestEqual("Prefix elsewhere", Rules.GetSampleRate("[LogNet] Last Ping 20ms", ESentryLevel::Info), 1.0);
+		TestEqual("Substring", Rules.GetSampleRate("Connection timeout after 5s", ESentryLevel::Info), 0.5);
+		TestEqual("Substring at the end", Rules.GetSampleRate("Connection timeout", ESentryLevel::Info), 0.5);
+		TestEqual("Partial substring", Rules.GetSampleRate("Connection timeou", ESentryLevel::Info), 1.0);
+	});
+
+	It("should only apply rules up to their level", [this]()
+	{
+		const FSentryLogFilterRules Rules({ MakeRule(TEXT(""), ESentryLogFilterTextMatch::Contains, TEXT(""), ESentryLevel::Info, 0.0f) });
+
+		TestEqual("Debug log", Rules.GetSampleRate("Message", ESentryLevel::Debug), 0.0);
+		TestEqual("Info log", Rules.GetSampleRate("Message", ESentryLevel::Info), 0.0);
+		TestEqual("Warning log", Rules.GetSampleRate("Message", ESentryLevel::Warning), 1.0);
+	});
+
+	It("should use the first matching rule", [this]()
+	{
+		const FSentryLogFilterRules Rules({
+			MakeRule(TEXT("LogNet"), ESentryLogFilterTextMatch::Contains, TEXT("Ping"), ESentryLevel::Fatal, 1.0f),
+			MakeRule(TEXT("LogNet"), ESentryLogFilterTextMatch::Contains, TEXT(""), ESentryLevel::Fatal, 0.0f) });
+
+		TestEqual("First rule", Rules.GetSampleRate("[LogNet] Ping", ESentryLevel::Info), 1.0);
+		TestEqual("Second rule", Rules.GetSampleRate("[LogNet] Pong", ESentryLevel::Info), 0.0);
+	});
+}
+
+#endif
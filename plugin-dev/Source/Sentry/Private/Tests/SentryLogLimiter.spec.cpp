@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryLogLimiter.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryLogLimiterSpec, "Sentry.SentryLogLimiter", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryLogLimiterSpec)
+
+void SentryLogLimiterSpec::Define()
+{
+	Describe("Deduplication", [this]()
+	{
+		It("should collapse repeats of the last line", [this]()
+		{
+			FSentryLogLimiter Limiter(0.0f, 1, 60.0f);
+			const FName Category(TEXT("LogTest"));
+
+			FString Notice;
+			TestTrue("First line forwarded", Limiter.ShouldForward(TEXT("Spam"), Category, Notice));
+			TestTrue("No notice for first line", Notice.IsEmpty());
+
+			TestFalse("Repeat dropped", Limiter.ShouldForward(TEXT("Spam"), Category, Notice));
+			TestFalse("Repeat dropped", Limiter.ShouldForward(TEXT("Spam"), Category, Notice));
+
+			TestTrue("Different line forwarded", Limiter.ShouldForward(TEXT("Other"), Category, Notice));
+			TestEqual("Repeats summarized", Notice, TEXT("Previous message repeated 2 times"));
+		});
+
+		It("should track categories independently", [this]()
+		{
+			FSentryLogLimiter Limiter(0.0f, 1, 60.0f);
+
+			FString Notice;
+			TestTrue("Line forwarded", Limiter.ShouldForward(TEXT("Spam"), FName(TEXT("LogA")), Notice));
+			TestTrue("Same line in another category forwarded", Limiter.ShouldForward(TEXT("Spam"), FName(TEXT("LogB")), Notice));
+		});
+	});
+
+	Describe("Rate limiting", [this]()
+	{
+		It("should drop lines exceeding the burst", [this]()
+		{
+			// Low rate so that no token is refilled while the test runs
+			FSentryLogLimiter Limiter(0.001f, 3, 0.0f);
+			const FName Category(TEXT("LogTest"));
+
+			FString Notice;
+			int32 NumForwarded = 0;
+			for (int32 i = 0; i < 10; ++i)
+			{
+				NumForwarded += Limiter.ShouldForward(*FString::Printf(TEXT("Line %d"), i), Category, Notice) ? 1 : 0;
+			}
+
+			TestEqual("Only burst forwarded", NumForwarded, 3);
+		});
+	});
+}
+
+#endif
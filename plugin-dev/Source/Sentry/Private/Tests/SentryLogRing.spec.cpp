@@ -0,0 +1,156 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryLogRing.h"
+#include "Utils/SentryMappedFile.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryLogRingSpec, "Sentry.SentryLogRing", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static void Append(FSentryLogRing& Ring, const ANSICHAR* Line)
+	{
+		Ring.Append(Line, FCStringAnsi::Strlen(Line));
+	}
+
+	static FString ToString(const TArray<uint8>& Data)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData()), Data.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+END_DEFINE_SPEC(SentryLogRingSpec)
+
+void SentryLogRingSpec::Define()
+{
+	Describe("Copy", [this]()
+	{
+		It("should return nothing for an empty ring", [this]()
+		{
+			FSentryLogRing Ring(64);
+
+			TestTrue("Ring empty", Ring.IsEmpty());
+			TestEqual("No data", Ring.Copy().Num(), 0);
+		});
+
+		It("should return all lines while the ring isn't full", [this]()
+		{
+			FSentryLogRing Ring(64);
+
+			Append(Ring, "first\n");
+			Append(Ring, "second\n");
+
+			TestEqual("Lines in order", ToString(Ring.Copy()), TEXT("first\nsecond\n"));
+		});
+
+		It("should drop the partially overwritten line once the ring wraps", [this]()
+		{
+			FSentryLogRing Ring(16);
+
+			Append(Ring, "aaaaa\n");
+			Append(Ring, "bbbbb\n");
+			Append(Ring, "ccccc\n");
+
+			TestEqual("Newest lines kept", ToString(Ring.Copy()), TEXT("bbbbb\nccccc\n"));
+		});
+
+		It("should keep the end of a line longer than the ring", [this]()
+		{
+			FSentryLogRing Ring(8);
+
+			Append(Ring, "0123456789abcdef\n");
+
+			TestEqual("Partial line dropped", Ring.Copy().Num(), 0);
+
+			Append(Ring, "xyz\n");
+
+			TestEqual("Next line kept", ToString(Ring.Copy()), TEXT("xyz\n"));
+		});
+
+		It("should return only whole lines within the size limit", [this]()
+		{
+			FSentryLogRing Ring(64);
+
+			Append(Ring, "first\n");
+			Append(Ring, "second\n");
+
+			TestEqual("Cut line dropped", ToString(Ring.Copy(9)), TEXT("second\n"));
+		});
+	});
+
+	Describe("Persistence", [this]()
+	{
+		const FString RingPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryTests"), TEXT("log_ring.bin"));
+
+		AfterEach([RingPath]()
+		{
+			IFileManager::Get().Delete(*RingPath);
+		});
+
+		It("should hand over unreported lines to the next session", [this, RingPath]()
+		{
+			if (!FSentryMappedFile::IsSupported())
+			{
+				return;
+			}
+
+			TArray<uint8> UnreportedLines;
+
+			{
+				TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> Ring = FSentryLogRing::CreatePersistent(RingPath, 64, UnreportedLines);
+				TestTrue("Ring persistent", Ring->IsPersistent());
+				Append(*Ring, "last words\n");
+			}
+
+			TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> Ring = FSentryLogRing::CreatePersistent(RingPath, 64, UnreportedLines);
+
+			TestEqual("Lines recovered", ToString(UnreportedLines), TEXT("last words\n"));
+			TestTrue("New session starts empty", Ring->IsEmpty());
+		});
+
+		It("should not hand over reported lines", [this, RingPath]()
+		{
+			if (!FSentryMappedFile::IsSupported())
+			{
+				return;
+			}
+
+			TArray<uint8> UnreportedLines;
+
+			{
+				TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> Ring = FSentryLogRing::CreatePersistent(RingPath, 64, UnreportedLines);
+				Append(*Ring, "clean exit\n");
+				Ring->MarkReported();
+			}
+
+			FSentryLogRing::CreatePersistent(RingPath, 64, UnreportedLines);
+
+			TestEqual("Nothing recovered", UnreportedLines.Num(), 0);
+		});
+	});
+
+	Describe("Conversion", [this]()
+	{
+		It("should convert to UTF-8", [this]()
+		{
+			ANSICHAR Buffer[16];
+			const int32 Length = FSentryLogRing::ConvertToUTF8(TEXT("a\u00e9\u20ac"), Buffer, UE_ARRAY_COUNT(Buffer));
+
+			TestEqual("Length", Length, 6);
+			TestTrue("Encoded", FMemory::Memcmp(Buffer, "a\xc3\xa9\xe2\x82\xac", 6) == 0);
+		});
+
+		It("should stop at the last whole character that fits", [this]()
+		{
+			ANSICHAR Buffer[4];
+			const int32 Length = FSentryLogRing::ConvertToUTF8(TEXT("ab\u20ac"), Buffer, UE_ARRAY_COUNT(Buffer));
+
+			TestEqual("Multi-byte character skipped", Length, 2);
+		});
+	});
+}
+
+#endif
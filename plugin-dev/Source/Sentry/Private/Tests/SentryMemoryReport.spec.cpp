@@ -0,0 +1,255 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "SentryEvent.h"
+#include "SentryModule.h"
+#include "SentrySubsystem.h"
+
+#include "Utils/SentryMemoryAccounting.h"
+
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryMemoryAccountingSpec, "Sentry.SentryMemoryAccounting", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryMemoryAccountingSpec)
+
+void SentryMemoryAccountingSpec::Define()
+{
+	Describe("Scope", [this]()
+	{
+		It("should attribute allocations to the innermost component and restore the previous one", [this]()
+		{
+			TestEqual("Outside of any scope", SentryMemoryAccounting::GetCurrentComponent(), ESentryMemoryComponent::Other);
+
+			{
+				const SentryMemoryAccounting::FScope Outer(ESentryMemoryComponent::Scope);
+				TestEqual("Outer scope", SentryMemoryAccounting::GetCurrentComponent(), ESentryMemoryComponent::Scope);
+
+				{
+					const SentryMemoryAccounting::FScope Inner(ESentryMemoryComponent::Breadcrumbs);
+					TestEqual("Inner scope", SentryMemoryAccounting::GetCurrentComponent(), ESentryMemoryComponent::Breadcrumbs);
+				}
+
+				TestEqual("Back in outer scope", SentryMemoryAccounting::GetCurrentComponent(), ESentryMemoryComponent::Scope);
+			}
+
+			TestEqual("After all scopes", SentryMemoryAccounting::GetCurrentComponent(), ESentryMemoryComponent::Other);
+		});
+	});
+
+	Describe("GetStats", [this]()
+	{
+		It("should report native bytes per component", [this]()
+		{
+			const FSentryMemoryStats Before = SentryMemoryAccounting::GetStats();
+
+			SentryMemoryAccounting::AddNativeBytes(ESentryMemoryComponent::Breadcrumbs, 1000);
+			SentryMemoryAccounting::AddNativeBytes(ESentryMemoryComponent::PendingEnvelopes, 300);
+
+			const FSentryMemoryStats After = SentryMemoryAccounting::GetStats();
+
+			SentryMemoryAccounting::AddNativeBytes(ESentryMemoryComponent::Breadcrumbs, -1000);
+			SentryMemoryAccounting::AddNativeBytes(ESentryMemoryComponent::PendingEnvelopes, -300);
+
+			TestEqual("Breadcrumbs", After.BreadcrumbBytes - Before.BreadcrumbBytes, 1000ll);
+			TestEqual("Pending envelopes", After.PendingEnvelopeBytes - Before.PendingEnvelopeBytes, 300ll);
+			TestEqual("Scope", After.ScopeBytes, Before.ScopeBytes);
+			TestEqual("Only the allocation hooks mark the native heap tracked", After.bIsNativeHeapTracked, Before.bIsNativeHeapTracked);
+		});
+
+		It("should sum all components except the JNI references into the total", [this]()
+		{
+			FSentryMemoryStats Stats;
+			Stats.BreadcrumbBytes = 1;
+			Stats.ScopeBytes = 2;
+			Stats.PendingEnvelopeBytes = 4;
+			Stats.LogRingBytes = 8;
+			Stats.AttachmentBytes = 16;
+			Stats.CrashVideoBytes = 32;
+			Stats.HandlerObjectBytes = 64;
+			Stats.NativeSdkOtherBytes = 128;
+			Stats.NumJniGlobalRefs = 1000;
+
+			TestEqual("Total", Stats.GetTotalBytes(), 255ll);
+		});
+	});
+
+	Describe("GetAllocatedSize", [this]()
+	{
+		It("should include the strings and nested values owned by a context", [this]()
+		{
+			const FString LongValue = FString::ChrN(256, TEXT('x'));
+
+			TMap<FString, FSentryVariant> Nested;
+			Nested.Add(TEXT("value"), LongValue);
+
+			TMap<FString, FSentryVariant> Context;
+			Context.Add(TEXT("nested"), Nested);
+			Context.Add(TEXT("array"), TArray<FSentryVariant>{ LongValue, LongValue });
+			Context.Add(TEXT("number"), 42);
+
+			const SIZE_T Size = SentryMemoryAccounting::GetAllocatedSize(Context);
+
+			TestTrue("Size includes the container", Size >= Context.GetAllocatedSize());
+			TestTrue("Size includes all nested strings", Size >= Context.GetAllocatedSize() + 3 * LongValue.GetAllocatedSize());
+		});
+
+		It("should be zero for empty containers", [this]()
+		{
+			TestEqual("Empty tags", SentryMemoryAccounting::GetAllocatedSize(TMap<FString, FString>()), static_cast<SIZE_T>(0));
+			TestEqual("Empty contexts", SentryMemoryAccounting::GetAllocatedSize(TMap<FString, TMap<FString, FSentryVariant>>()), static_cast<SIZE_T>(0));
+		});
+	});
+
+	Describe("ToLines", [this]()
+	{
+		It("should list every component and the total", [this]()
+		{
+			FSentryMemoryStats Stats;
+			Stats.LogRingBytes = 64 * 1024;
+			Stats.bIsNativeHeapTracked = true;
+
+			const FString Report = FString::Join(SentryMemoryAccounting::ToLines(Stats), TEXT("\n"));
+
+			TestTrue("Breadcrumbs", Report.Contains(TEXT("Breadcrumbs")));
+			TestTrue("Log ring", Report.Contains(TEXT("Log ring")));
+			TestTrue("Crash video", Report.Contains(TEXT("Crash video")));
+			TestTrue("JNI global refs", Report.Contains(TEXT("JNI global refs")));
+			TestTrue("Total", Report.Contains(TEXT("64.0 KB")));
+			TestFalse("No untracked note", Report.Contains(TEXT("aren't tracked")));
+		});
+	});
+}
+
+/**
+ * Memory footprint of the SDK after a synthetic session of breadcrumbs, scope changes, logs and captured events.
+ *
+ * Meant to be run manually (e.g. `Automation RunTests Sentry.MemReport`) with the plugin settings of the game being
+ * measured, so that the report reflects the features it enables. The session lasts 10 minutes unless overridden with
+ * `-SentryMemReportSeconds=`. The report is logged and written to Saved/Automation/SentryMemReport.json.
+ */
+BEGIN_DEFINE_SPEC(SentryMemoryReportSpec, "Sentry.MemReport", EAutomationTestFlags::PerfFilter | SentryApplicationContextMask)
+	USentrySubsystem* SentrySubsystem = nullptr;
+	FDelegateHandle FilterHandle;
+	double SessionSeconds = 600.0;
+	double EndTime = 0.0;
+	double NextCaptureTime = 0.0;
+	int32 NumTicks = 0;
+
+	void TickSession()
+	{
+		const int32 Tick = NumTicks++;
+
+		SentrySubsystem->AddBreadcrumbWithParams(FString::Printf(TEXT("Session breadcrumb %d"), Tick), TEXT("session"), TEXT("default"),
+			{ { TEXT("tick"), Tick }, { TEXT("map"), TEXT("/Game/Maps/Arena_Night") } }, ESentryLevel::Info);
+
+		SentrySubsystem->SetTag(TEXT("session_phase"), FString::Printf(TEXT("phase_%d"), Tick % 8));
+		SentrySubsystem->SetContext(FString::Printf(TEXT("session_context_%d"), Tick % 4),
+			{ { TEXT("tick"), Tick }, { TEXT("players"), 12 }, { TEXT("match_time"), Tick * 0.1f } });
+
+		SentrySubsystem->LogInfo(FString::Printf(TEXT("Session log %d"), Tick));
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= NextCaptureTime)
+		{
+			SentrySubsystem->CaptureMessage(FString::Printf(TEXT("Session message %d"), Tick), ESentryLevel::Warning);
+			NextCaptureTime = Now + 10.0;
+		}
+	}
+
+	void WriteReport(const FSentryMemoryStats& Stats) const
+	{
+		TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject());
+		RootObject->SetStringField(TEXT("plugin_version"), FSentryModule::Get().GetPluginVersion());
+		RootObject->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+		RootObject->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+		RootObject->SetNumberField(TEXT("session_seconds"), SessionSeconds);
+		RootObject->SetNumberField(TEXT("breadcrumb_bytes"), Stats.BreadcrumbBytes);
+		RootObject->SetNumberField(TEXT("scope_bytes"), Stats.ScopeBytes);
+		RootObject->SetNumberField(TEXT("pending_envelope_bytes"), Stats.PendingEnvelopeBytes);
+		RootObject->SetNumberField(TEXT("log_ring_bytes"), Stats.LogRingBytes);
+		RootObject->SetNumberField(TEXT("attachment_bytes"), Stats.AttachmentBytes);
+		RootObject->SetNumberField(TEXT("crash_video_bytes"), Stats.CrashVideoBytes);
+		RootObject->SetNumberField(TEXT("handler_object_bytes"), Stats.HandlerObjectBytes);
+		RootObject->SetNumberField(TEXT("native_sdk_other_bytes"), Stats.NativeSdkOtherBytes);
+		RootObject->SetNumberField(TEXT("total_bytes"), Stats.GetTotalBytes());
+		RootObject->SetNumberField(TEXT("jni_global_refs"), Stats.NumJniGlobalRefs);
+		RootObject->SetBoolField(TEXT("native_heap_tracked"), Stats.bIsNativeHeapTracked);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+
+		FFileHelper::SaveStringToFile(Json, *FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("SentryMemReport.json")));
+	}
+END_DEFINE_SPEC(SentryMemoryReportSpec)
+
+void SentryMemoryReportSpec::Define()
+{
+	FParse::Value(FCommandLine::Get(), TEXT("SentryMemReportSeconds="), SessionSeconds);
+
+	LatentIt("should report the memory footprint after a synthetic session", FTimespan::FromSeconds(SessionSeconds + 60.0), [this](const FDoneDelegate& Done)
+	{
+		SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+		if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+		{
+			AddWarning(TEXT("Memory report requires an initialized SDK, skipping."));
+			Done.Execute();
+			return;
+		}
+
+		// Captured events are dropped before they're sent so that the session doesn't flood the project
+		FilterHandle = SentrySubsystem->AddBeforeSendFilter([](FSentryEventView& Event) { return false; });
+
+		NumTicks = 0;
+		EndTime = FPlatformTime::Seconds() + SessionSeconds;
+		NextCaptureTime = 0.0;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+		FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+		Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Done](float DeltaTime)
+		{
+			if (FPlatformTime::Seconds() < EndTime)
+			{
+				TickSession();
+				return true;
+			}
+
+			SentrySubsystem->RemoveBeforeSendFilter(FilterHandle);
+
+			const FSentryMemoryStats Stats = SentrySubsystem->GetMemoryStats();
+
+			AddInfo(FString::Printf(TEXT("Memory footprint after %.0f seconds (%d ticks):"), SessionSeconds, NumTicks));
+			for (const FString& Line : SentryMemoryAccounting::ToLines(Stats))
+			{
+				AddInfo(Line);
+			}
+
+			TestTrue("Footprint is reported", Stats.GetTotalBytes() > 0);
+
+			WriteReport(Stats);
+
+			Done.Execute();
+			return false;
+		}), 0.1f);
+	});
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryMemorySampler.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryMemorySamplerSpec, "Sentry.SentryMemorySampler", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FSentryMemorySample Sample;
+END_DEFINE_SPEC(SentryMemorySamplerSpec)
+
+void SentryMemorySamplerSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Sample = FSentryMemorySample();
+		Sample.SessionSeconds = 12.5;
+		Sample.TotalPhysical = 16ull * 1024 * 1024 * 1024;
+		Sample.AvailablePhysical = 1024ull * 1024 * 1024;
+		Sample.UsedPhysical = 6ull * 1024 * 1024 * 1024;
+		Sample.UsedVirtual = 8ull * 1024 * 1024 * 1024;
+		Sample.PeakUsedPhysical = 7ull * 1024 * 1024 * 1024;
+		Sample.NumMemoryTrims = 2;
+		Sample.bIsLowMemory = true;
+		Sample.bIsUnderMemoryPressure = true;
+	});
+
+	Describe("ToContext", [this]()
+	{
+		It("should convert sizes to megabytes", [this]()
+		{
+			const TMap<FString, FSentryVariant> Context = Sample.ToContext();
+
+			TestEqual("Total physical", Context.FindRef(TEXT("total_physical_mb")).GetValue<int32>(), 16 * 1024);
+			TestEqual("Available physical", Context.FindRef(TEXT("available_physical_mb")).GetValue<int32>(), 1024);
+			TestEqual("Used physical", Context.FindRef(TEXT("used_physical_mb")).GetValue<int32>(), 6 * 1024);
+			TestEqual("Used virtual", Context.FindRef(TEXT("used_virtual_mb")).GetValue<int32>(), 8 * 1024);
+			TestEqual("Peak used physical", Context.FindRef(TEXT("peak_used_physical_mb")).GetValue<int32>(), 7 * 1024);
+		});
+
+		It("should include the memory pressure state", [this]()
+		{
+			const TMap<FString, FSentryVariant> Context = Sample.ToContext();
+
+			TestEqual("Memory trims", Context.FindRef(TEXT("memory_trims")).GetValue<int32>(), 2);
+			TestTrue("Low memory", Context.FindRef(TEXT("low_memory")).GetValue<bool>());
+			TestTrue("Under memory pressure", Context.FindRef(TEXT("under_memory_pressure")).GetValue<bool>());
+		});
+
+		It("should only include LLM tags if there are any", [this]()
+		{
+			TestFalse("No tags", Sample.ToContext().Contains(TEXT("llm_top_tags_mb")));
+
+			Sample.TopTags.Emplace(TEXT("Textures"), 512ll * 1024 * 1024);
+
+			const TMap<FString, FSentryVariant> Context = Sample.ToContext();
+			TestTrue("Tags", Context.Contains(TEXT("llm_top_tags_mb")));
+			TestEqual("Textures", Context.FindRef(TEXT("llm_top_tags_mb")).GetValue<TMap<FString, FSentryVariant>>().FindRef(TEXT("Textures")).GetValue<int32>(), 512);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryModule.h"
+#include "SentrySettings.h"
+#include "SentrySubsystem.h"
+#include "SentryTests.h"
+
+#include "Utils/SentryMemoryTransport.h"
+
+#include "Engine/Engine.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryMemoryTransportSpec, "Sentry.SentryMemoryTransport", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	USentrySubsystem* SentrySubsystem;
+	FString OriginalDsn;
+
+	const FSentryCapturedEnvelope* FindEnvelopeWithItem(const TArray<FSentryCapturedEnvelope>& Envelopes, const FString& ItemType) const
+	{
+		return Envelopes.FindByPredicate([&ItemType](const FSentryCapturedEnvelope& Envelope)
+		{
+			return Envelope.ItemTypes.Contains(ItemType);
+		});
+	}
+END_DEFINE_SPEC(SentryMemoryTransportSpec)
+
+void SentryMemoryTransportSpec::Define()
+{
+	if (!SentryMemoryTransport::IsSupported())
+	{
+		return;
+	}
+
+	BeforeEach([this]()
+	{
+		SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+		SentrySubsystem->Close();
+
+		SentryMemoryTransport::Install();
+
+		// Envelopes are only handed over to the transport if a DSN is set, it's never contacted though
+		SentrySubsystem->InitializeWithSettings(FConfigureSettingsNativeDelegate::CreateLambda([this](USentrySettings* Settings)
+		{
+			OriginalDsn = Settings->Dsn;
+			Settings->Dsn = TEXT("https://public@127.0.0.1/1");
+		}));
+
+		SentryMemoryTransport::Reset();
+	});
+
+	AfterEach([this]()
+	{
+		SentrySubsystem->Close();
+
+		SentryMemoryTransport::Uninstall();
+
+		FSentryModule::Get().GetSettings()->Dsn = OriginalDsn;
+	});
+
+	Describe("Captured envelopes", [this]()
+	{
+		It("should contain the captured message", [this]()
+		{
+			const double CaptureTime = FPlatformTime::Seconds();
+
+			const FString EventId = SentrySubsystem->CaptureMessage(TEXT("Automation: memory transport message"), ESentryLevel::Info);
+			TestFalse("Event ID is non-empty", EventId.IsEmpty());
+
+			TestTrue("Envelope is captured", SentryMemoryTransport::WaitForEnvelopes(1, 5.0f));
+
+			const TArray<FSentryCapturedEnvelope> Envelopes = SentryMemoryTransport::GetEnvelopes();
+
+			const FSentryCapturedEnvelope* Envelope = FindEnvelopeWithItem(Envelopes, TEXT("event"));
+			if (!TestNotNull("Envelope with event is captured", Envelope))
+			{
+				return;
+			}
+
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Envelope->Data.GetData()), Envelope->Data.Num());
+			const FString Payload(Converted.Length(), Converted.Get());
+
+			TestTrue("Payload contains the message", Payload.Contains(TEXT("Automation: memory transport message")));
+			TestTrue("Payload contains the event ID", Payload.Replace(TEXT("-"), TEXT("")).Contains(EventId));
+			TestTrue("Envelope is timestamped after the capture", Envelope->Timestamp >= CaptureTime);
+		});
+
+		It("should count bytes of all captured envelopes", [this]()
+		{
+			for (int32 i = 0; i < 10; ++i)
+			{
+				SentrySubsystem->CaptureMessage(FString::Printf(TEXT("Automation: memory transport message %d"), i), ESentryLevel::Info);
+			}
+
+			TestTrue("Envelopes are captured", SentryMemoryTransport::WaitForEnvelopes(10, 5.0f));
+
+			int64 TotalBytes = 0;
+			for (const FSentryCapturedEnvelope& Envelope : SentryMemoryTransport::GetEnvelopes())
+			{
+				TotalBytes += Envelope.Data.Num();
+			}
+
+			TestTrue("Envelopes aren't empty", TotalBytes > 0);
+			TestEqual("Total bytes match the captured envelopes", SentryMemoryTransport::GetTotalBytes(), TotalBytes);
+		});
+
+		It("should be discarded on reset", [this]()
+		{
+			SentrySubsystem->CaptureMessage(TEXT("Automation: memory transport message"), ESentryLevel::Info);
+			TestTrue("Envelope is captured", SentryMemoryTransport::WaitForEnvelopes(1, 5.0f));
+
+			SentryMemoryTransport::Reset();
+
+			TestEqual("No envelopes are left", SentryMemoryTransport::GetNumEnvelopes(), 0);
+			TestEqual("No bytes are left", SentryMemoryTransport::GetTotalBytes(), static_cast<int64>(0));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryMetrics.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryMetricsSpec, "Sentry.SentryMetrics", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	TUniquePtr<FSentryMetrics> Metrics;
+
+	TArray<FString> TakeLines(bool bIncludeCurrent)
+	{
+		const TArray<uint8> Envelope = Metrics->TakeEnvelope(bIncludeCurrent);
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Envelope.GetData()), Envelope.Num());
+
+		TArray<FString> Lines;
+		FString(Converted.Length(), Converted.Get()).ParseIntoArray(Lines, TEXT("\n"));
+
+		// Envelope and item headers aren't metrics
+		return Lines.Num() > 2 ? TArray<FString>(Lines.GetData() + 2, Lines.Num() - 2) : TArray<FString>();
+	}
+END_DEFINE_SPEC(SentryMetricsSpec)
+
+void SentryMetricsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Metrics = MakeUnique<FSentryMetrics>();
+		Metrics->Start(FString(), FString());
+	});
+
+	AfterEach([this]()
+	{
+		Metrics.Reset();
+	});
+
+	Describe("Register", [this]()
+	{
+		It("should return the same key for the same metric regardless of the tag order", [this]()
+		{
+			const FSentryMetricKey Key = Metrics->Register(ESentryMetricType::Counter, TEXT("kills"), TEXT("none"), { { TEXT("map"), TEXT("Arena") }, { TEXT("mode"), TEXT("ffa") } });
+			const FSentryMetricKey SameKey = Metrics->Register(ESentryMetricType::Counter, TEXT("kills"), TEXT("none"), { { TEXT("mode"), TEXT("ffa") }, { TEXT("map"), TEXT("Arena") } });
+			const FSentryMetricKey OtherKey = Metrics->Register(ESentryMetricType::Gauge, TEXT("kills"), TEXT("none"), {});
+
+			TestTrue("Key is valid", Key.IsValid());
+			TestEqual("Same key", SameKey.Id, Key.Id);
+			TestNotEqual("Other key", OtherKey.Id, Key.Id);
+		});
+
+		It("should not register metrics without a name", [this]()
+		{
+			TestFalse("Key is valid", Metrics->Register(ESentryMetricType::Counter, FString(), TEXT("none"), {}).IsValid());
+		});
+	});
+
+	Describe("TakeEnvelope", [this]()
+	{
+		It("should sum counters recorded on several threads", [this]()
+		{
+			const FSentryMetricKey Key = Metrics->Register(ESentryMetricType::Counter, TEXT("requests"), FString(), { { TEXT("region"), TEXT("eu") } });
+
+			ParallelFor(100, [this, Key](int32 Index)
+			{
+				Metrics->Record(Key, 1.0);
+			});
+
+			const TArray<FString> Lines = TakeLines(true);
+
+			// Samples may fall into two buckets if the test runs across a bucket boundary
+			double Sum = 0.0;
+			for (const FString& Line : Lines)
+			{
+				TestTrue("Line format", Line.StartsWith(TEXT("requests@none:")) && Line.Contains(TEXT("|c|#region:eu|T")));
+				Sum += FCString::Atod(*Line.Mid(FCString::Strlen(TEXT("requests@none:"))));
+			}
+
+			TestEqual("Sum", Sum, 100.0);
+		});
+
+		It("should keep last, min, max, sum and count of gauges", [this]()
+		{
+			const FSentryMetricKey Key = Metrics->Register(ESentryMetricType::Gauge, TEXT("players"), FString(), {});
+
+			Metrics->Record(Key, 4.0);
+			Metrics->Record(Key, 8.0);
+			Metrics->Record(Key, 6.0);
+
+			const TArray<FString> Lines = TakeLines(true);
+
+			if (!TestEqual("Lines", Lines.Num(), 1))
+			{
+				return;
+			}
+
+			TestTrue("Gauge", Lines[0].StartsWith(TEXT("players@none:6:4:8:18:3|g|T")));
+		});
+
+		It("should keep all samples of distributions", [this]()
+		{
+			const FSentryMetricKey Key = Metrics->Register(ESentryMetricType::Distribution, TEXT("load time"), TEXT("millisecond"), {});
+
+			Metrics->Record(Key, 1.5);
+			Metrics->Record(Key, 2.5);
+
+			const TArray<FString> Lines = TakeLines(true);
+
+			if (!TestEqual("Lines", Lines.Num(), 1))
+			{
+				return;
+			}
+
+			TestTrue("Distribution", Lines[0].StartsWith(TEXT("load_time@millisecond:1.5:2.5|d|T")));
+		});
+
+		It("should remove the taken samples", [this]()
+		{
+			Metrics->Record(Metrics->Register(ESentryMetricType::Counter, TEXT("requests"), FString(), {}), 1.0);
+
+			Metrics->TakeEnvelope(true);
+
+			TestEqual("Envelope size", Metrics->TakeEnvelope(true).Num(), 0);
+		});
+
+		It("should not record samples while stopped", [this]()
+		{
+			const FSentryMetricKey Key = Metrics->Register(ESentryMetricType::Counter, TEXT("requests"), FString(), {});
+
+			Metrics->Stop();
+			Metrics->Record(Key, 1.0);
+
+			TestEqual("Envelope size", Metrics->TakeEnvelope(true).Num(), 0);
+		});
+	});
+}
+
+#endif
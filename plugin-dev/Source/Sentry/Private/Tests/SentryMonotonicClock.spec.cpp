@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryMonotonicClock.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryMonotonicClockSpec, "Sentry.SentryMonotonicClock", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryMonotonicClockSpec)
+
+void SentryMonotonicClockSpec::Define()
+{
+	Describe("Timestamps", [this]()
+	{
+		It("should match the wall clock when anchored", [this]()
+		{
+			const FSentryMonotonicClock Clock;
+
+			const int64 Difference = FSentryMonotonicClock::GetWallClockTimestamp() - Clock.GetTimestamp();
+			TestTrue("Within 10 ms of the wall clock", FMath::Abs(Difference) < 10000);
+		});
+
+		It("should keep the process clock close to the wall clock", [this]()
+		{
+			const int64 Difference = FSentryMonotonicClock::GetWallClockTimestamp() - FSentryMonotonicClock::GetProcessTimestamp();
+			TestTrue("Within 10 ms of the wall clock", FMath::Abs(Difference) < 10000);
+		});
+
+		It("should never go back", [this]()
+		{
+			const FSentryMonotonicClock Clock;
+
+			int64 Previous = Clock.GetTimestamp();
+			for (int32 Index = 0; Index < 1000; ++Index)
+			{
+				const int64 Current = Clock.GetTimestamp();
+				if (!TestTrue("Monotonic", Current >= Previous))
+				{
+					return;
+				}
+				Previous = Current;
+			}
+		});
+
+		It("should convert cycles with a single offset", [this]()
+		{
+			const FSentryMonotonicClock Clock;
+			const FSentryMonotonicClock Copy(Clock.GetOffset());
+
+			const uint64 Start = FPlatformTime::Cycles64();
+			const uint64 End = Start + static_cast<uint64>(0.5 / FPlatformTime::GetSecondsPerCycle64());
+
+			TestEqual("Same timestamps from the offset", Copy.ToTimestamp(Start), Clock.ToTimestamp(Start));
+			TestTrue("Half a second apart", FMath::Abs(Clock.ToTimestamp(End) - Clock.ToTimestamp(Start) - 500000) <= 1);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryNetworkQuality.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryNetworkQualitySpec, "Sentry.SentryNetworkQuality", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryNetworkQualitySpec)
+
+void SentryNetworkQualitySpec::Define()
+{
+	Describe("Network context", [this]()
+	{
+		It("should be empty without samples", [this]()
+		{
+			TestEqual("No values", FSentryNetworkQuality::ToContext(TArray<FSentryNetworkQuality::FSample>()).Num(), 0);
+		});
+
+		It("should contain the latest sample and summarize the timeline", [this]()
+		{
+			TArray<FSentryNetworkQuality::FSample> Samples;
+			Samples.Add(FSentryNetworkQuality::FSample(100.0, 40.0f, 0.0f, 0.2f));
+			Samples.Add(FSentryNetworkQuality::FSample(101.0, 60.0f, 10.0f, 1.2f));
+			Samples.Add(FSentryNetworkQuality::FSample(102.0, 200.0f, 2.5f, 0.5f));
+
+			const TMap<FString, FSentryVariant> Context = FSentryNetworkQuality::ToContext(Samples, TEXT("client"));
+
+			TestEqual("Net mode", Context.FindRef(TEXT("net_mode")).GetValue<FString>(), FString(TEXT("client")));
+			TestEqual("Latest ping", Context.FindRef(TEXT("ping_ms")).GetValue<float>(), 200.0f, 0.01f);
+			TestEqual("Average ping", Context.FindRef(TEXT("ping_avg_ms")).GetValue<float>(), 100.0f, 0.01f);
+			TestEqual("Max loss", Context.FindRef(TEXT("loss_max_percent")).GetValue<float>(), 10.0f, 0.01f);
+			TestEqual("High loss seconds", Context.FindRef(TEXT("high_loss_seconds")).GetValue<int32>(), 1);
+			TestEqual("Saturated seconds", Context.FindRef(TEXT("saturated_seconds")).GetValue<int32>(), 1);
+			TestEqual("Timeline seconds", Context.FindRef(TEXT("timeline_seconds")).GetValue<float>(), 3.0f, 0.01f);
+			TestEqual("Ping timeline", Context.FindRef(TEXT("recent_ping_ms")).GetValue<FString>(), FString(TEXT("40,60,200")));
+			TestEqual("Loss timeline", Context.FindRef(TEXT("recent_loss_percent")).GetValue<FString>(), FString(TEXT("0.0,10.0,2.5")));
+		});
+	});
+}
+
+#endif
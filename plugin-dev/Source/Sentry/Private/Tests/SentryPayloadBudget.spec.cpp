@@ -0,0 +1,137 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryPayloadAccounting.h"
+
+#include "Misc/AutomationTest.h"
+
+#if USE_SENTRY_NATIVE
+#include "GenericPlatform/Infrastructure/GenericPlatformSentryPayloadBudget.h"
+#endif
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryPayloadBudgetSpec, "Sentry.SentryPayloadBudget", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+#if USE_SENTRY_NATIVE
+	static sentry_value_t MakeEvent(int32 NumBreadcrumbs, int32 ExtraSize, int32 ContextSize)
+	{
+		sentry_value_t Event = sentry_value_new_message_event(SENTRY_LEVEL_INFO, nullptr, "Budget message");
+
+		sentry_value_t Breadcrumbs = sentry_value_new_list();
+		for (int32 i = 0; i < NumBreadcrumbs; ++i)
+		{
+			sentry_value_append(Breadcrumbs, sentry_value_new_breadcrumb("default", TCHAR_TO_UTF8(*FString::Printf(TEXT("Breadcrumb %d"), i))));
+		}
+		sentry_value_set_by_key(Event, "breadcrumbs", Breadcrumbs);
+
+		sentry_value_t Extra = sentry_value_new_object();
+		sentry_value_set_by_key(Extra, "small", sentry_value_new_string("value"));
+		sentry_value_set_by_key(Extra, "large", sentry_value_new_string(TCHAR_TO_UTF8(*FString::ChrN(ExtraSize, TEXT('x')))));
+		sentry_value_set_by_key(Event, "extra", Extra);
+
+		sentry_value_t Context = sentry_value_new_object();
+		sentry_value_set_by_key(Context, "data", sentry_value_new_string(TCHAR_TO_UTF8(*FString::ChrN(ContextSize, TEXT('y')))));
+
+		sentry_value_t Contexts = sentry_value_new_object();
+		sentry_value_set_by_key(Contexts, "game", Context);
+		sentry_value_set_by_key(Event, "contexts", Contexts);
+
+		return Event;
+	}
+#endif
+END_DEFINE_SPEC(SentryPayloadBudgetSpec)
+
+void SentryPayloadBudgetSpec::Define()
+{
+#if USE_SENTRY_NATIVE
+	Describe("Payload budget", [this]()
+	{
+		It("should leave events within the budget untouched", [this]()
+		{
+			sentry_value_t Event = MakeEvent(10, 100, 100);
+
+			const int64 OriginalSize = FGenericPlatformSentryPayloadBudget::GetSerializedSize(Event);
+
+			bool bWasTrimmed = true;
+			const int64 Size = FGenericPlatformSentryPayloadBudget::Enforce(Event, OriginalSize, bWasTrimmed);
+
+			TestFalse("Event isn't trimmed", bWasTrimmed);
+			TestEqual("Size is unchanged", Size, OriginalSize);
+			TestEqual("Breadcrumbs are kept", static_cast<int32>(sentry_value_get_length(sentry_value_get_by_key(Event, "breadcrumbs"))), 10);
+
+			sentry_value_decref(Event);
+		});
+
+		It("should drop the oldest breadcrumbs first", [this]()
+		{
+			sentry_value_t Event = MakeEvent(100, 100, 100);
+
+			const int64 OriginalSize = FGenericPlatformSentryPayloadBudget::GetSerializedSize(Event);
+
+			bool bWasTrimmed = false;
+			const int64 Size = FGenericPlatformSentryPayloadBudget::Enforce(Event, OriginalSize - 500, bWasTrimmed);
+
+			TestTrue("Event is trimmed", bWasTrimmed);
+			TestTrue("Event fits the budget", Size <= OriginalSize - 500);
+
+			sentry_value_t Breadcrumbs = sentry_value_get_by_key(Event, "breadcrumbs");
+			const int32 NumBreadcrumbs = static_cast<int32>(sentry_value_get_length(Breadcrumbs));
+
+			TestTrue("Some breadcrumbs are dropped", NumBreadcrumbs < 100 && NumBreadcrumbs > 0);
+			TestEqual("Newest breadcrumb is kept", FString(sentry_value_as_string(sentry_value_get_by_key(sentry_value_get_by_index(Breadcrumbs, NumBreadcrumbs - 1), "message"))), TEXT("Breadcrumb 99"));
+			TestFalse("Extras are kept", sentry_value_is_null(sentry_value_get_by_key(sentry_value_get_by_key(Event, "extra"), "large")));
+
+			sentry_value_decref(Event);
+		});
+
+		It("should drop the largest extras and then contexts", [this]()
+		{
+			sentry_value_t Event = MakeEvent(5, 4000, 2000);
+
+			bool bWasTrimmed = false;
+			const int64 Size = FGenericPlatformSentryPayloadBudget::Enforce(Event, 1000, bWasTrimmed);
+
+			TestTrue("Event is trimmed", bWasTrimmed);
+			TestTrue("Event fits the budget", Size <= 1000);
+			TestEqual("Breadcrumbs are dropped", static_cast<int32>(sentry_value_get_length(sentry_value_get_by_key(Event, "breadcrumbs"))), 0);
+			TestTrue("Large extra is dropped", sentry_value_is_null(sentry_value_get_by_key(sentry_value_get_by_key(Event, "extra"), "large")));
+			TestTrue("Large context is dropped", sentry_value_is_null(sentry_value_get_by_key(sentry_value_get_by_key(Event, "contexts"), "game")));
+			TestEqual("Message is kept", FString(sentry_value_as_string(sentry_value_get_by_key(sentry_value_get_by_key(Event, "message"), "formatted"))), TEXT("Budget message"));
+
+			sentry_value_decref(Event);
+		});
+	});
+#endif
+
+	Describe("Payload accounting", [this]()
+	{
+		BeforeEach([]()
+		{
+			SentryPayloadAccounting::Reset();
+		});
+
+		AfterEach([]()
+		{
+			SentryPayloadAccounting::Reset();
+		});
+
+		It("should accumulate sizes by category", [this]()
+		{
+			SentryPayloadAccounting::RecordEvent(1000, false);
+			SentryPayloadAccounting::RecordEvent(3000, true);
+			SentryPayloadAccounting::Record(ESentryPayloadCategory::Attachment, 500);
+
+			const FSentryPayloadStats Stats = SentryPayloadAccounting::GetStats();
+
+			TestEqual("Event bytes per minute", Stats.EventBytesPerMinute, static_cast<int64>(4000));
+			TestEqual("Attachment bytes per minute", Stats.AttachmentBytesPerMinute, static_cast<int64>(500));
+			TestEqual("Total event bytes", Stats.TotalEventBytes, static_cast<int64>(4000));
+			TestEqual("Number of events", Stats.NumEvents, static_cast<int64>(2));
+			TestEqual("Number of trimmed events", Stats.NumTrimmedEvents, static_cast<int64>(1));
+			TestEqual("Largest event", Stats.MaxEventBytes, static_cast<int64>(3000));
+		});
+	});
+}
+
+#endif
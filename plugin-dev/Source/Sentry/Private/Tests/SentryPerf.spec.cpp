@@ -0,0 +1,610 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "SentryModule.h"
+#include "SentryOutputDevice.h"
+#include "SentrySubsystem.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if USE_SENTRY_NATIVE
+#include "GenericPlatform/GenericPlatformSentryBreadcrumb.h"
+#include "GenericPlatform/GenericPlatformSentryScope.h"
+#include "GenericPlatform/Infrastructure/GenericPlatformSentryConverters.h"
+#endif
+
+#if PLATFORM_ANDROID
+#include "Infrastructure/AndroidSentryConverters.h"
+#include "Infrastructure/AndroidSentryJavaEnv.h"
+#include "Infrastructure/AndroidSentryJavaObjectWrapper.h"
+#elif PLATFORM_APPLE
+#include "Infrastructure/AppleSentryConverters.h"
+#endif
+
+#if WITH_AUTOMATION_TESTS
+
+/**
+ * Allocator counting the allocations made by a single thread while it's installed as GMalloc.
+ *
+ * Everything is forwarded to the allocator it wraps so memory can be freed by either of them. The instance is never
+ * destroyed since other threads may still be inside one of its calls after it has been uninstalled.
+ */
+class FSentryCountingMalloc final : public FMalloc
+{
+public:
+	explicit FSentryCountingMalloc(FMalloc* InInner)
+		: Inner(InInner)
+	{
+	}
+
+	static FSentryCountingMalloc& Get()
+	{
+		static FSentryCountingMalloc* Instance = new FSentryCountingMalloc(GMalloc);
+		return *Instance;
+	}
+
+	void Begin()
+	{
+		CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+		NumAllocations = 0;
+		GMalloc = this;
+	}
+
+	int64 End()
+	{
+		GMalloc = Inner;
+		CountingThreadId = 0;
+		return NumAllocations;
+	}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		Inner->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return Inner->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return Inner->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		Inner->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		Inner->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		Inner->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return Inner->IsInternallyThreadSafe();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return TEXT("SentryCountingMalloc");
+	}
+
+private:
+	void CountAllocation()
+	{
+		// Only the benchmarked thread writes the counter so it doesn't need to be atomic
+		if (FPlatformTLS::GetCurrentThreadId() == CountingThreadId)
+		{
+			++NumAllocations;
+		}
+	}
+
+	FMalloc* Inner;
+
+	volatile uint32 CountingThreadId = 0;
+	int64 NumAllocations = 0;
+};
+
+#if PLATFORM_ANDROID
+/**
+ * Tracks the JNI local references held by a single thread while its JNI environment uses the instrumented function table.
+ *
+ * Only the functions the bridge creates and releases local references with are intercepted, so the counts are a lower
+ * bound of the local reference table usage. That's enough to catch missing DeleteLocalRef calls and conversions of
+ * large containers that don't push a local frame, which is what overflows the table on device.
+ */
+class FSentryJniLocalRefCounter
+{
+public:
+	static FSentryJniLocalRefCounter& Get()
+	{
+		static FSentryJniLocalRefCounter Instance;
+		return Instance;
+	}
+
+	void Begin()
+	{
+		Env = SentryJavaEnv::Get();
+		Original = Env->functions;
+
+		Table = *Original;
+		Table.NewLocalRef = &NewLocalRef;
+		Table.DeleteLocalRef = &DeleteLocalRef;
+		Table.PushLocalFrame = &PushLocalFrame;
+		Table.PopLocalFrame = &PopLocalFrame;
+		Table.NewStringUTF = &NewStringUTF;
+		Table.NewObjectV = &NewObjectV;
+		Table.NewObjectA = &NewObjectA;
+		Table.NewObjectArray = &NewObjectArray;
+		Table.NewByteArray = &NewByteArray;
+		Table.CallObjectMethodV = &CallObjectMethodV;
+		Table.CallObjectMethodA = &CallObjectMethodA;
+		Table.CallStaticObjectMethodV = &CallStaticObjectMethodV;
+		Table.CallStaticObjectMethodA = &CallStaticObjectMethodA;
+		Table.GetObjectClass = &GetObjectClass;
+		Table.FindClass = &FindClass;
+		Table.GetObjectArrayElement = &GetObjectArrayElement;
+		Table.GetObjectField = &GetObjectField;
+		Table.GetStaticObjectField = &GetStaticObjectField;
+
+		NumLive = 0;
+		Peak = 0;
+		FrameStack.Reset();
+
+		Env->functions = &Table;
+	}
+
+	/** Restores the original function table, returning the peak number of local references and those still alive. */
+	void End(int32& OutPeak, int32& OutRetained)
+	{
+		Env->functions = Original;
+
+		OutPeak = Peak;
+		OutRetained = FMath::Max(0, NumLive);
+	}
+
+private:
+	template <typename RefType>
+	static RefType Track(RefType Ref)
+	{
+		if (Ref)
+		{
+			FSentryJniLocalRefCounter& Counter = Get();
+			Counter.Peak = FMath::Max(Counter.Peak, ++Counter.NumLive);
+		}
+
+		return Ref;
+	}
+
+	static const JNINativeInterface* Fn() { return Get().Original; }
+
+	static jobject JNICALL NewLocalRef(JNIEnv* InEnv, jobject Ref) { return Track(Fn()->NewLocalRef(InEnv, Ref)); }
+	static jstring JNICALL NewStringUTF(JNIEnv* InEnv, const char* Bytes) { return Track(Fn()->NewStringUTF(InEnv, Bytes)); }
+	static jobject JNICALL NewObjectV(JNIEnv* InEnv, jclass Class, jmethodID Method, va_list Args) { return Track(Fn()->NewObjectV(InEnv, Class, Method, Args)); }
+	static jobject JNICALL NewObjectA(JNIEnv* InEnv, jclass Class, jmethodID Method, const jvalue* Args) { return Track(Fn()->NewObjectA(InEnv, Class, Method, Args)); }
+	static jobjectArray JNICALL NewObjectArray(JNIEnv* InEnv, jsize Length, jclass Class, jobject Initial) { return Track(Fn()->NewObjectArray(InEnv, Length, Class, Initial)); }
+	static jbyteArray JNICALL NewByteArray(JNIEnv* InEnv, jsize Length) { return Track(Fn()->NewByteArray(InEnv, Length)); }
+	static jobject JNICALL CallObjectMethodV(JNIEnv* InEnv, jobject Object, jmethodID Method, va_list Args) { return Track(Fn()->CallObjectMethodV(InEnv, Object, Method, Args)); }
+	static jobject JNICALL CallObjectMethodA(JNIEnv* InEnv, jobject Object, jmethodID Method, const jvalue* Args) { return Track(Fn()->CallObjectMethodA(InEnv, Object, Method, Args)); }
+	static jobject JNICALL CallStaticObjectMethodV(JNIEnv* InEnv, jclass Class, jmethodID Method, va_list Args) { return Track(Fn()->CallStaticObjectMethodV(InEnv, Class, Method, Args)); }
+	static jobject JNICALL CallStaticObjectMethodA(JNIEnv* InEnv, jclass Class, jmethodID Method, const jvalue* Args) { return Track(Fn()->CallStaticObjectMethodA(InEnv, Class, Method, Args)); }
+	static jclass JNICALL GetObjectClass(JNIEnv* InEnv, jobject Object) { return Track(Fn()->GetObjectClass(InEnv, Object)); }
+	static jclass JNICALL FindClass(JNIEnv* InEnv, const char* Name) { return Track(Fn()->FindClass(InEnv, Name)); }
+	static jobject JNICALL GetObjectArrayElement(JNIEnv* InEnv, jobjectArray Array, jsize Index) { return Track(Fn()->GetObjectArrayElement(InEnv, Array, Index)); }
+	static jobject JNICALL GetObjectField(JNIEnv* InEnv, jobject Object, jfieldID Field) { return Track(Fn()->GetObjectField(InEnv, Object, Field)); }
+	static jobject JNICALL GetStaticObjectField(JNIEnv* InEnv, jclass Class, jfieldID Field) { return Track(Fn()->GetStaticObjectField(InEnv, Class, Field)); }
+
+	static void JNICALL DeleteLocalRef(JNIEnv* InEnv, jobject Ref)
+	{
+		Fn()->DeleteLocalRef(InEnv, Ref);
+
+		if (Ref)
+		{
+			--Get().NumLive;
+		}
+	}
+
+	static jint JNICALL PushLocalFrame(JNIEnv* InEnv, jint Capacity)
+	{
+		const jint Result = Fn()->PushLocalFrame(InEnv, Capacity);
+
+		if (Result == JNI_OK)
+		{
+			Get().FrameStack.Push(Get().NumLive);
+		}
+
+		return Result;
+	}
+
+	static jobject JNICALL PopLocalFrame(JNIEnv* InEnv, jobject Result)
+	{
+		jobject Ref = Fn()->PopLocalFrame(InEnv, Result);
+
+		// Everything created inside the frame is released, the result is moved to the enclosing frame
+		FSentryJniLocalRefCounter& Counter = Get();
+		if (Counter.FrameStack.Num() > 0)
+		{
+			Counter.NumLive = Counter.FrameStack.Pop();
+		}
+
+		return Track(Ref);
+	}
+
+	JNIEnv* Env = nullptr;
+	const JNINativeInterface* Original = nullptr;
+	JNINativeInterface Table;
+
+	int32 NumLive = 0;
+	int32 Peak = 0;
+	TArray<int32> FrameStack;
+};
+#endif
+
+struct FSentryPerfResult
+{
+	FString Name;
+	int32 NumIterations = 0;
+	double NsPerOp = 0.0;
+	double AllocationsPerOp = 0.0;
+
+	/** JNI local references held at once and left behind by all iterations, only tracked on Android. */
+	int32 PeakLocalRefs = INDEX_NONE;
+	int32 RetainedLocalRefs = INDEX_NONE;
+};
+
+/**
+ * Microbenchmarks of the hot paths of the SDK, reporting time and allocations per operation.
+ *
+ * Meant to be run manually (e.g. `Automation RunTests Sentry.Perf`) in a Development or Shipping-like build. Results of
+ * all benchmarks run so far are written to Saved/Automation/SentryPerf.json so that they can be compared between plugin versions.
+ * Run on device, the subsystem and converter benchmarks measure the cost of the JNI and Cocoa bridges. Allocations only
+ * count those made through GMalloc, not the Java or Objective-C objects created on the other side of the bridge.
+ */
+BEGIN_DEFINE_SPEC(SentryPerfSpec, "Sentry.Perf", EAutomationTestFlags::PerfFilter | SentryApplicationContextMask)
+	TArray<FSentryPerfResult> Results;
+
+	template <typename FuncType>
+	void Measure(const FString& Name, int32 NumIterations, FuncType&& Func)
+	{
+		// Warm-up takes lazily created caches and first-time allocations out of the measurement
+		for (int32 i = 0; i < FMath::Min(NumIterations, 16); ++i)
+		{
+			Func();
+		}
+
+#if PLATFORM_ANDROID
+		FSentryJniLocalRefCounter& LocalRefCounter = FSentryJniLocalRefCounter::Get();
+		LocalRefCounter.Begin();
+#endif
+
+		FSentryCountingMalloc& CountingMalloc = FSentryCountingMalloc::Get();
+		CountingMalloc.Begin();
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			Func();
+		}
+
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+
+		const int64 NumAllocations = CountingMalloc.End();
+
+		FSentryPerfResult Result;
+		Result.Name = Name;
+		Result.NumIterations = NumIterations;
+		Result.NsPerOp = FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1e9 / NumIterations;
+		Result.AllocationsPerOp = static_cast<double>(NumAllocations) / NumIterations;
+
+#if PLATFORM_ANDROID
+		LocalRefCounter.End(Result.PeakLocalRefs, Result.RetainedLocalRefs);
+
+		AddInfo(FString::Printf(TEXT("%s: %.0f ns/op, %.2f allocations/op, %d local refs peak, %d retained (%d iterations)"),
+			*Name, Result.NsPerOp, Result.AllocationsPerOp, Result.PeakLocalRefs, Result.RetainedLocalRefs, NumIterations));
+#else
+		AddInfo(FString::Printf(TEXT("%s: %.0f ns/op, %.2f allocations/op (%d iterations)"), *Name, Result.NsPerOp, Result.AllocationsPerOp, NumIterations));
+#endif
+
+		Results.Add(Result);
+		WriteResults();
+	}
+
+	void WriteResults() const
+	{
+		TArray<TSharedPtr<FJsonValue>> ResultValues;
+		for (const FSentryPerfResult& Result : Results)
+		{
+			TSharedPtr<FJsonObject> ResultObject = MakeShareable(new FJsonObject());
+			ResultObject->SetStringField(TEXT("name"), Result.Name);
+			ResultObject->SetNumberField(TEXT("iterations"), Result.NumIterations);
+			ResultObject->SetNumberField(TEXT("ns_per_op"), Result.NsPerOp);
+			ResultObject->SetNumberField(TEXT("allocations_per_op"), Result.AllocationsPerOp);
+			if (Result.PeakLocalRefs != INDEX_NONE)
+			{
+				ResultObject->SetNumberField(TEXT("local_refs_peak"), Result.PeakLocalRefs);
+				ResultObject->SetNumberField(TEXT("local_refs_retained"), Result.RetainedLocalRefs);
+			}
+			ResultValues.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+		}
+
+		TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject());
+		RootObject->SetStringField(TEXT("plugin_version"), FSentryModule::Get().GetPluginVersion());
+		RootObject->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+		RootObject->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+		RootObject->SetArrayField(TEXT("results"), ResultValues);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+
+		FFileHelper::SaveStringToFile(Json, *FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("SentryPerf.json")));
+	}
+
+	static TMap<FString, FSentryVariant> MakeContext()
+	{
+		TMap<FString, FSentryVariant> GraphicsSettings;
+		GraphicsSettings.Add(TEXT("rhi"), TEXT("D3D12"));
+		GraphicsSettings.Add(TEXT("scalability"), 3);
+		GraphicsSettings.Add(TEXT("resolution_scale"), 0.75f);
+		GraphicsSettings.Add(TEXT("vsync"), false);
+
+		TArray<FSentryVariant> Features;
+		Features.Add(TEXT("RayTracing"));
+		Features.Add(TEXT("Nanite"));
+		Features.Add(TEXT("Lumen"));
+
+		TMap<FString, FSentryVariant> Context;
+		Context.Add(TEXT("name"), TEXT("NVIDIA GeForce RTX 3070"));
+		Context.Add(TEXT("vendor_name"), TEXT("NVIDIA"));
+		Context.Add(TEXT("driver_version"), TEXT("546.33"));
+		Context.Add(TEXT("memory_size"), 8192);
+		Context.Add(TEXT("map"), TEXT("/Game/Maps/Arena_Night"));
+		Context.Add(TEXT("players"), 12);
+		Context.Add(TEXT("match_time"), 431.5f);
+		Context.Add(TEXT("is_host"), true);
+		Context.Add(TEXT("settings"), GraphicsSettings);
+		Context.Add(TEXT("features"), Features);
+		return Context;
+	}
+
+	/** Context with the given number of flat keys of mixed types, the typical size of a game's custom context. */
+	static TMap<FString, FSentryVariant> MakeFlatContext(int32 NumKeys)
+	{
+		TMap<FString, FSentryVariant> Context;
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			const FString Key = FString::Printf(TEXT("key_%02d"), i);
+			switch (i % 4)
+			{
+			case 0:
+				Context.Add(Key, FString::Printf(TEXT("value_%d"), i));
+				break;
+			case 1:
+				Context.Add(Key, i);
+				break;
+			case 2:
+				Context.Add(Key, i * 0.5f);
+				break;
+			default:
+				Context.Add(Key, i % 2 == 0);
+				break;
+			}
+		}
+
+		return Context;
+	}
+END_DEFINE_SPEC(SentryPerfSpec)
+
+void SentryPerfSpec::Define()
+{
+	Describe("Output device", [this]()
+	{
+		It("should measure filtered and forwarded lines", [this]()
+		{
+			FSentryOutputDevice OutputDevice;
+
+			Measure(TEXT("OutputDevice.Serialize.Filtered"), 10000, [&OutputDevice]()
+			{
+				OutputDevice.Serialize(TEXT("Verbose line which is dropped by the level filter"), ELogVerbosity::VeryVerbose, TEXT("LogSentryPerf"));
+			});
+
+			Measure(TEXT("OutputDevice.Serialize.Forwarded"), 1000, [&OutputDevice]()
+			{
+				OutputDevice.Serialize(TEXT("Warning line which is forwarded as a breadcrumb"), ELogVerbosity::Warning, TEXT("LogSentryPerf"));
+			});
+		});
+	});
+
+	Describe("Subsystem", [this]()
+	{
+		It("should measure breadcrumbs and message capturing", [this]()
+		{
+			USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+			if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+			{
+				AddWarning(TEXT("Benchmark requires an initialized SDK, skipping."));
+				return;
+			}
+
+			const TMap<FString, FSentryVariant> Data = MakeContext();
+
+			Measure(TEXT("Subsystem.AddBreadcrumbWithParams"), 1000, [SentrySubsystem, &Data]()
+			{
+				SentrySubsystem->AddBreadcrumbWithParams(TEXT("Perf breadcrumb"), TEXT("perf"), TEXT("default"), Data, ESentryLevel::Info);
+			});
+
+			SentrySubsystem->ClearBreadcrumbs();
+
+			// Captured events are dropped before they're sent so that the benchmark doesn't flood the project
+			const FDelegateHandle FilterHandle = SentrySubsystem->AddBeforeSendFilter([](FSentryEventView& Event) { return false; });
+
+			Measure(TEXT("Subsystem.CaptureMessage"), 200, [SentrySubsystem]()
+			{
+				SentrySubsystem->CaptureMessage(TEXT("Perf message"), ESentryLevel::Info);
+			});
+
+			SentrySubsystem->RemoveBeforeSendFilter(FilterHandle);
+		});
+
+		It("should measure tags, contexts and logs", [this]()
+		{
+			USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+			if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+			{
+				AddWarning(TEXT("Benchmark requires an initialized SDK, skipping."));
+				return;
+			}
+
+			const TMap<FString, FSentryVariant> Context = MakeFlatContext(20);
+
+			Measure(TEXT("Subsystem.SetTag"), 1000, [SentrySubsystem]()
+			{
+				SentrySubsystem->SetTag(TEXT("perf_tag"), TEXT("perf_value"));
+			});
+
+			SentrySubsystem->RemoveTag(TEXT("perf_tag"));
+
+			Measure(TEXT("Subsystem.SetContext.20Keys"), 1000, [SentrySubsystem, &Context]()
+			{
+				SentrySubsystem->SetContext(TEXT("perf"), Context);
+			});
+
+			// Logs are only forwarded if structured logging is enabled in the settings, otherwise this measures the early out
+			Measure(TEXT("Subsystem.AddLog"), 1000, [SentrySubsystem]()
+			{
+				SentrySubsystem->LogInfo(TEXT("Perf log"), TEXT("LogSentryPerf"));
+			});
+		});
+	});
+
+#if PLATFORM_ANDROID
+	Describe("Android converters", [this]()
+	{
+		It("should measure context map conversion", [this]()
+		{
+			const TMap<FString, FSentryVariant> Context = MakeFlatContext(20);
+
+			Measure(TEXT("AndroidConverters.VariantMapToNative.20Keys"), 1000, [&Context]()
+			{
+				FAndroidSentryConverters::VariantMapToNative(Context);
+			});
+
+			Measure(TEXT("AndroidConverters.GetJString"), 10000, []()
+			{
+				FSentryJavaObjectWrapper::GetJString(TEXT("perf_value"));
+			});
+		});
+	});
+#elif PLATFORM_APPLE
+	Describe("Apple converters", [this]()
+	{
+		It("should measure context map conversion", [this]()
+		{
+			const TMap<FString, FSentryVariant> Context = MakeFlatContext(20);
+
+			// Each iteration drains its own pool so that the converted objects are freed as they would be on the game thread
+			Measure(TEXT("AppleConverters.VariantMapToNative.20Keys"), 1000, [&Context]()
+			{
+				@autoreleasepool
+				{
+					FAppleSentryConverters::VariantMapToNative(Context);
+				}
+			});
+		});
+	});
+#endif
+
+#if USE_SENTRY_NATIVE
+	Describe("Converters", [this]()
+	{
+		It("should measure context map conversion", [this]()
+		{
+			const TMap<FString, FSentryVariant> Context = MakeContext();
+
+			Measure(TEXT("Converters.VariantMapToNative"), 10000, [&Context]()
+			{
+				sentry_value_decref(FGenericPlatformSentryConverters::VariantMapToNative(Context));
+			});
+		});
+	});
+
+	Describe("Scope", [this]()
+	{
+		It("should measure applying a scope with 100 breadcrumbs", [this]()
+		{
+			USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+			if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+			{
+				AddWarning(TEXT("Benchmark requires an initialized SDK, skipping."));
+				return;
+			}
+
+			FGenericPlatformSentryScope Scope;
+			Scope.SetContext(TEXT("perf"), MakeContext());
+
+			for (int32 i = 0; i < 100; ++i)
+			{
+				TSharedPtr<FGenericPlatformSentryBreadcrumb> Breadcrumb = MakeShareable(new FGenericPlatformSentryBreadcrumb());
+				Breadcrumb->SetMessage(FString::Printf(TEXT("Perf breadcrumb %d"), i));
+				Breadcrumb->SetCategory(TEXT("perf"));
+				Scope.AddBreadcrumb(Breadcrumb);
+			}
+
+			// Native local scopes can only be released by capturing them, so capturing with an empty scope is measured as the baseline
+			const FDelegateHandle FilterHandle = SentrySubsystem->AddBeforeSendFilter([](FSentryEventView& Event) { return false; });
+
+			Measure(TEXT("Scope.Capture.Baseline"), 200, []()
+			{
+				sentry_capture_event_with_scope(sentry_value_new_message_event(SENTRY_LEVEL_INFO, nullptr, "Perf message"), sentry_local_scope_new());
+			});
+
+			Measure(TEXT("Scope.Apply.100Breadcrumbs"), 200, [&Scope]()
+			{
+				sentry_scope_t* NativeScope = sentry_local_scope_new();
+				Scope.Apply(NativeScope);
+				sentry_capture_event_with_scope(sentry_value_new_message_event(SENTRY_LEVEL_INFO, nullptr, "Perf message"), NativeScope);
+			});
+
+			SentrySubsystem->RemoveBeforeSendFilter(FilterHandle);
+		});
+	});
+#endif
+}
+
+#endif
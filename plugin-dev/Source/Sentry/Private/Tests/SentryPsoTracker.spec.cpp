@@ -0,0 +1,52 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryPsoTracker.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryPsoTrackerSpec, "Sentry.SentryPsoTracker", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryPsoTrackerSpec)
+
+void SentryPsoTrackerSpec::Define()
+{
+	Describe("Stall estimation", [this]()
+	{
+		It("should count the time beyond the average frame", [this]()
+		{
+			TestEqual("Stall", FSentryPsoTracker::EstimateStallMs(120.0f, 16.0f), 104.0f, 0.01f);
+		});
+
+		It("should not be negative for frames faster than the average", [this]()
+		{
+			TestEqual("Stall", FSentryPsoTracker::EstimateStallMs(10.0f, 16.0f), 0.0f);
+		});
+	});
+
+	Describe("PSO context", [this]()
+	{
+		It("should contain the totals", [this]()
+		{
+			FSentryPsoTracker::FStats Stats;
+			Stats.NewPsos = 30;
+			Stats.Misses = 12;
+			Stats.FramesWithMisses = 4;
+			Stats.Stalls = 1;
+			Stats.TotalStallMs = 200.0f;
+			Stats.MaxStallMs = 150.0f;
+
+			const TMap<FString, FSentryVariant> Context = FSentryPsoTracker::ToContext(Stats);
+
+			TestEqual("New PSOs", Context.FindRef(TEXT("new_psos")).GetValue<int32>(), 30);
+			TestEqual("Misses", Context.FindRef(TEXT("misses")).GetValue<int32>(), 12);
+			TestEqual("Stalls", Context.FindRef(TEXT("stalls")).GetValue<int32>(), 1);
+			TestEqual("Average stall", Context.FindRef(TEXT("avg_stall_ms")).GetValue<float>(), 50.0f, 0.01f);
+			TestFalse("No precache requests", Context.Contains(TEXT("pending_precache_requests")));
+		});
+	});
+}
+
+#endif
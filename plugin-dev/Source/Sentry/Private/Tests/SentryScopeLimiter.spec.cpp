@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryScopeLimiter.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryScopeLimiterSpec, "Sentry.SentryScopeLimiter", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryScopeLimiterSpec)
+
+void SentryScopeLimiterSpec::Define()
+{
+	Describe("Key limiter", [this]()
+	{
+		It("should evict the least recently set key", [this]()
+		{
+			FSentryScopeKeyLimiter Limiter(2);
+			const int64 NumEvicted = SentryScopeLimits::GetNumEvicted();
+
+			FString EvictedKey;
+			TestFalse("Key within limit", Limiter.Touch(TEXT("A"), EvictedKey));
+			TestFalse("Key within limit", Limiter.Touch(TEXT("B"), EvictedKey));
+			TestFalse("Existing key updated", Limiter.Touch(TEXT("A"), EvictedKey));
+
+			TestTrue("Key exceeding limit", Limiter.Touch(TEXT("C"), EvictedKey));
+			TestEqual("Evicted key", EvictedKey, TEXT("B"));
+			TestEqual("Eviction counted", SentryScopeLimits::GetNumEvicted() - NumEvicted, 1ll);
+		});
+
+		It("should not count removed keys", [this]()
+		{
+			FSentryScopeKeyLimiter Limiter(1);
+
+			FString EvictedKey;
+			Limiter.Touch(TEXT("A"), EvictedKey);
+			Limiter.Remove(TEXT("A"));
+
+			TestFalse("Key within limit", Limiter.Touch(TEXT("B"), EvictedKey));
+		});
+
+		It("should not limit keys if disabled", [this]()
+		{
+			FSentryScopeKeyLimiter Limiter(0);
+
+			FString EvictedKey;
+			for (int32 i = 0; i < 100; ++i)
+			{
+				TestFalse("Key not evicted", Limiter.Touch(FString::FromInt(i), EvictedKey));
+			}
+		});
+	});
+
+	Describe("Context trimming", [this]()
+	{
+		It("should drop values exceeding the context size", [this]()
+		{
+			TMap<FString, FSentryVariant> Context;
+			Context.Add(TEXT("A"), 1);
+			Context.Add(TEXT("B"), 2);
+			Context.Add(TEXT("C"), 3);
+
+			TestEqual("Dropped values", SentryScopeLimits::TrimContext(Context, 0, 2), 1);
+			TestEqual("Kept values", Context.Num(), 2);
+		});
+
+		It("should drop containers nested too deep", [this]()
+		{
+			TMap<FString, FSentryVariant> Inner;
+			Inner.Add(TEXT("Value"), TEXT("Deep"));
+
+			TMap<FString, FSentryVariant> Middle;
+			Middle.Add(TEXT("Inner"), Inner);
+			Middle.Add(TEXT("Value"), TEXT("Shallow"));
+
+			TMap<FString, FSentryVariant> Context;
+			Context.Add(TEXT("Middle"), Middle);
+
+			TestEqual("Dropped values", SentryScopeLimits::TrimContext(Context, 1, 0), 1);
+
+			const TMap<FString, FSentryVariant> TrimmedMiddle = Context[TEXT("Middle")].GetValue<TMap<FString, FSentryVariant>>();
+			TestFalse("Nested container dropped", TrimmedMiddle.Contains(TEXT("Inner")));
+			TestTrue("Shallow value kept", TrimmedMiddle.Contains(TEXT("Value")));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentrySessionAggregator.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentrySessionAggregatorSpec, "Sentry.SentrySessionAggregator", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	TUniquePtr<FSentrySessionAggregator> Aggregator;
+
+	TArray<FString> SplitEnvelope(const TArray<uint8>& Envelope) const
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Envelope.GetData()), Envelope.Num());
+
+		TArray<FString> Lines;
+		FString(Converted.Length(), Converted.Get()).ParseIntoArray(Lines, TEXT("\n"), false);
+		return Lines;
+	}
+
+	TSharedPtr<FJsonObject> ParsePayload(const TArray<uint8>& Envelope) const
+	{
+		const TArray<FString> Lines = SplitEnvelope(Envelope);
+		if (Lines.Num() < 3)
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Payload;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Lines[2]), Payload);
+		return Payload;
+	}
+END_DEFINE_SPEC(SentrySessionAggregatorSpec)
+
+void SentrySessionAggregatorSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Aggregator = MakeUnique<FSentrySessionAggregator>(TEXT("game@1.0"), TEXT("production"));
+	});
+
+	AfterEach([this]()
+	{
+		Aggregator.Reset();
+	});
+
+	Describe("TakeEnvelope", [this]()
+	{
+		It("should be empty if no sessions were recorded", [this]()
+		{
+			TestTrue("Is empty", Aggregator->IsEmpty());
+			TestEqual("Envelope size", Aggregator->TakeEnvelope().Num(), 0);
+		});
+
+		It("should count sessions by the minute they started in", [this]()
+		{
+			Aggregator->Record(FDateTime(2025, 1, 1, 12, 0, 5), ESentrySessionStatus::Exited);
+			Aggregator->Record(FDateTime(2025, 1, 1, 12, 0, 55), ESentrySessionStatus::Exited);
+			Aggregator->Record(FDateTime(2025, 1, 1, 12, 0, 30), ESentrySessionStatus::Crashed);
+			Aggregator->Record(FDateTime(2025, 1, 1, 12, 1, 0), ESentrySessionStatus::Errored);
+
+			const TArray<uint8> Envelope = Aggregator->TakeEnvelope();
+
+			TestTrue("Item type", SplitEnvelope(Envelope)[1].Contains(TEXT("\"type\":\"sessions\"")));
+
+			const TSharedPtr<FJsonObject> Payload = ParsePayload(Envelope);
+			if (!TestNotNull("Payload", Payload.Get()))
+			{
+				return;
+			}
+
+			TestEqual("Release", Payload->GetObjectField(TEXT("attrs"))->GetStringField(TEXT("release")), FString(TEXT("game@1.0")));
+
+			const TArray<TSharedPtr<FJsonValue>>& Aggregates = Payload->GetArrayField(TEXT("aggregates"));
+			if (!TestEqual("Aggregates", Aggregates.Num(), 2))
+			{
+				return;
+			}
+
+			const TSharedPtr<FJsonObject> First = Aggregates[0]->AsObject();
+			TestEqual("First started", First->GetStringField(TEXT("started")), FDateTime(2025, 1, 1, 12, 0, 0).ToIso8601());
+			TestEqual("First exited", static_cast<int32>(First->GetNumberField(TEXT("exited"))), 2);
+			TestEqual("First crashed", static_cast<int32>(First->GetNumberField(TEXT("crashed"))), 1);
+			TestFalse("First errored", First->HasField(TEXT("errored")));
+
+			const TSharedPtr<FJsonObject> Second = Aggregates[1]->AsObject();
+			TestEqual("Second errored", static_cast<int32>(Second->GetNumberField(TEXT("errored"))), 1);
+		});
+
+		It("should reset the counts", [this]()
+		{
+			Aggregator->Record(FDateTime(2025, 1, 1, 12, 0, 0), ESentrySessionStatus::Abnormal);
+
+			Aggregator->TakeEnvelope();
+
+			TestTrue("Is empty", Aggregator->IsEmpty());
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Misc/AutomationTest.h"
+
+#if USE_SENTRY_NATIVE
+#include "GenericPlatform/Infrastructure/GenericPlatformSentryStacktraceCache.h"
+#endif
+
+#if WITH_AUTOMATION_TESTS && USE_SENTRY_NATIVE
+
+BEGIN_DEFINE_SPEC(SentryStacktraceCacheSpec, "Sentry.SentryStacktraceCache", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static sentry_value_t GetFrames(sentry_value_t Event)
+	{
+		sentry_value_t Thread = sentry_value_get_by_index(sentry_value_get_by_key(sentry_value_get_by_key(Event, "threads"), "values"), 0);
+		return sentry_value_get_by_key(sentry_value_get_by_key(Thread, "stacktrace"), "frames");
+	}
+END_DEFINE_SPEC(SentryStacktraceCacheSpec)
+
+void SentryStacktraceCacheSpec::Define()
+{
+	It("should attach the stack trace to the event", [this]()
+	{
+		FGenericPlatformSentryStacktraceCache Cache(0, false);
+
+		sentry_value_t Event = sentry_value_new_event();
+		Cache.SetStacktrace(Event);
+
+		TestTrue("Frames attached", sentry_value_get_length(GetFrames(Event)) > 0);
+		TestEqual("Nothing cached", Cache.Num(), 0);
+
+		sentry_value_decref(Event);
+	});
+
+	It("should limit the number of frames", [this]()
+	{
+		FGenericPlatformSentryStacktraceCache Cache(3, false);
+
+		sentry_value_t Event = sentry_value_new_event();
+		Cache.SetStacktrace(Event);
+
+		TestTrue("Frames limited", sentry_value_get_length(GetFrames(Event)) <= 3);
+
+		sentry_value_decref(Event);
+	});
+
+	It("should reuse the stack trace of the same callsite", [this]()
+	{
+		FGenericPlatformSentryStacktraceCache Cache(0, true);
+
+		sentry_value_t Events[2];
+		for (sentry_value_t& Event : Events)
+		{
+			Event = sentry_value_new_event();
+			Cache.SetStacktrace(Event);
+		}
+
+		TestEqual("Single callsite cached", Cache.Num(), 1);
+		TestEqual("Same frames", sentry_value_get_length(GetFrames(Events[0])), sentry_value_get_length(GetFrames(Events[1])));
+
+		sentry_value_t OtherEvent = sentry_value_new_event();
+		Cache.SetStacktrace(OtherEvent);
+
+		TestEqual("Other callsite cached", Cache.Num(), 2);
+
+		Cache.Clear();
+		TestEqual("Cache cleared", Cache.Num(), 0);
+		TestTrue("Events keep their frames", sentry_value_get_length(GetFrames(Events[0])) > 0);
+
+		sentry_value_decref(Events[0]);
+		sentry_value_decref(Events[1]);
+		sentry_value_decref(OtherEvent);
+	});
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryStateTimelineRecorder.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryStateTimelineSpec, "Sentry.SentryStateTimeline", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static TArray<uint8> Encode(const TArray<uint8>& Snapshot, const TArray<uint8>* Previous)
+	{
+		TArray<uint8> Encoded;
+		Encoded.SetNumUninitialized(FSentryStateTimelineRecorder::GetMaxEncodedSize(Snapshot.Num()));
+		Encoded.SetNum(FSentryStateTimelineRecorder::EncodeDelta(Snapshot.GetData(), Previous ? Previous->GetData() : nullptr, Snapshot.Num(), Encoded.GetData()));
+		return Encoded;
+	}
+END_DEFINE_SPEC(SentryStateTimelineSpec)
+
+void SentryStateTimelineSpec::Define()
+{
+	Describe("Delta encoding", [this]()
+	{
+		It("should encode nothing for unchanged snapshots", [this]()
+		{
+			const TArray<uint8> Snapshot = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+			TestEqual("Encoded size", Encode(Snapshot, &Snapshot).Num(), 0);
+		});
+
+		It("should only encode the changed bytes", [this]()
+		{
+			TArray<uint8> Previous;
+			Previous.SetNumZeroed(64);
+
+			TArray<uint8> Snapshot = Previous;
+			Snapshot[10] = 7;
+			Snapshot[50] = 9;
+
+			const TArray<uint8> Encoded = Encode(Snapshot, &Previous);
+			TestEqual("Two tokens of one byte", Encoded.Num(), 10);
+
+			TArray<uint8> Decoded = Previous;
+			TestTrue("Applied", FSentryStateTimelineRecorder::ApplyDelta(Encoded.GetData(), Encoded.Num(), Decoded.GetData(), Decoded.Num()));
+			TestEqual("Decoded", Decoded, Snapshot);
+		});
+
+		It("should round-trip keyframes and differences", [this]()
+		{
+			TArray<uint8> Previous;
+			TArray<uint8> Snapshot;
+			for (int32 Index = 0; Index < 257; ++Index)
+			{
+				Previous.Add(static_cast<uint8>(Index * 31));
+				Snapshot.Add(static_cast<uint8>(Index % 3 == 0 ? Index : Index * 31));
+			}
+
+			TArray<uint8> Decoded;
+			Decoded.SetNumZeroed(Previous.Num());
+
+			const TArray<uint8> Keyframe = Encode(Previous, nullptr);
+			TestTrue("Keyframe within bounds", Keyframe.Num() <= FSentryStateTimelineRecorder::GetMaxEncodedSize(Previous.Num()));
+			TestTrue("Keyframe applied", FSentryStateTimelineRecorder::ApplyDelta(Keyframe.GetData(), Keyframe.Num(), Decoded.GetData(), Decoded.Num()));
+			TestEqual("Keyframe decoded", Decoded, Previous);
+
+			const TArray<uint8> Delta = Encode(Snapshot, &Previous);
+			TestTrue("Difference applied", FSentryStateTimelineRecorder::ApplyDelta(Delta.GetData(), Delta.Num(), Decoded.GetData(), Decoded.Num()));
+			TestEqual("Difference decoded", Decoded, Snapshot);
+		});
+
+		It("should reject malformed encodings", [this]()
+		{
+			TArray<uint8> Snapshot;
+			Snapshot.SetNumZeroed(8);
+
+			const uint8 PastTheEnd[] = { 6, 0, 4, 0, 1, 2, 3, 4 };
+			TestFalse("Out of bounds", FSentryStateTimelineRecorder::ApplyDelta(PastTheEnd, UE_ARRAY_COUNT(PastTheEnd), Snapshot.GetData(), Snapshot.Num()));
+
+			const uint8 Truncated[] = { 0, 0, 4, 0, 1 };
+			TestFalse("Truncated", FSentryStateTimelineRecorder::ApplyDelta(Truncated, UE_ARRAY_COUNT(Truncated), Snapshot.GetData(), Snapshot.Num()));
+		});
+	});
+
+	Describe("Timeline", [this]()
+	{
+		It("should decode the samples of registered providers", [this]()
+		{
+			FSentryStateTimelineRecorder& Recorder = FSentryStateTimelineRecorder::Get();
+			Recorder.Start(10.0f, 16 * 1024);
+
+			int32 Health = 100;
+			const int32 Handle = Recorder.Register(TEXT("Health"), sizeof(int32), nullptr, [&Health](void* OutSnapshot)
+			{
+				FMemory::Memcpy(OutSnapshot, &Health, sizeof(int32));
+			});
+
+			Recorder.Sample();
+			Recorder.Sample();
+			Health = 0x01020304;
+			Recorder.Sample();
+
+			const TSharedPtr<FJsonObject> Timeline = SentryTests::ParseJson(Recorder.Serialize());
+
+			Recorder.Unregister(Handle);
+			Recorder.Stop();
+
+			if (!TestTrue("Timeline parsed", Timeline.IsValid()))
+			{
+				return;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>& Samples = Timeline->GetArrayField(TEXT("samples"));
+			if (!TestEqual("Unchanged sample skipped", Samples.Num(), 2))
+			{
+				return;
+			}
+
+			TestEqual("Provider", Samples[0]->AsObject()->GetStringField(TEXT("provider")), TEXT("Health"));
+			TestEqual("Keyframe", Samples[0]->AsObject()->GetStringField(TEXT("data")), TEXT("64000000"));
+			TestEqual("Difference", Samples[1]->AsObject()->GetStringField(TEXT("data")), TEXT("04030201"));
+		});
+
+		It("should keep decoding once older samples are evicted", [this]()
+		{
+			FSentryStateTimelineRecorder& Recorder = FSentryStateTimelineRecorder::Get();
+			Recorder.Start(10.0f, 16 * 1024);
+
+			uint8 Counter = 0;
+			const int32 Handle = Recorder.Register(TEXT("Counter"), 2048, nullptr, [&Counter](void* OutSnapshot)
+			{
+				FMemory::Memset(OutSnapshot, Counter, 2048);
+			});
+
+			for (int32 Index = 0; Index < 64; ++Index)
+			{
+				++Counter;
+				Recorder.Sample();
+			}
+
+			const TSharedPtr<FJsonObject> Timeline = SentryTests::ParseJson(Recorder.Serialize());
+
+			Recorder.Unregister(Handle);
+			Recorder.Stop();
+
+			if (!TestTrue("Timeline parsed", Timeline.IsValid()))
+			{
+				return;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>& Samples = Timeline->GetArrayField(TEXT("samples"));
+			if (!TestTrue("Samples kept", Samples.Num() > 0 && Samples.Num() < 64))
+			{
+				return;
+			}
+
+			const FString LastData = Samples.Last()->AsObject()->GetStringField(TEXT("data"));
+			TestTrue("Newest sample decoded", LastData.StartsWith(TEXT("4040")));
+		});
+	});
+}
+
+#endif
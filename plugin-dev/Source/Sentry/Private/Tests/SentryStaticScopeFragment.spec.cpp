@@ -0,0 +1,143 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+#include "Utils/SentryStaticScopeFragment.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryStaticScopeFragmentSpec, "Sentry.SentryStaticScopeFragment", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static TArray<uint8> ToBytes(const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static FString ToString(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	static FString SplicePayload(const FSentryStaticScopeFragment& Fragment, const FString& Payload)
+	{
+		const TArray<uint8> Bytes = ToBytes(Payload);
+
+		TArray<uint8> Spliced;
+		return Fragment.SplicePayload(Bytes.GetData(), Bytes.Num(), Spliced) ? ToString(Spliced) : Payload;
+	}
+END_DEFINE_SPEC(SentryStaticScopeFragmentSpec)
+
+void SentryStaticScopeFragmentSpec::Define()
+{
+	Describe("Payload splicing", [this]()
+	{
+		It("should add missing attributes, tags and contexts", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetAttribute(TEXT("release"), TEXT("game@1.0"));
+			Fragment.SetTag(TEXT("Configuration"), TEXT("Shipping"));
+			Fragment.SetContext(TEXT("gpu"), "{\"name\":\"GPU\"}");
+
+			TestEqual("Spliced into empty event", SplicePayload(Fragment, TEXT("{}")),
+				TEXT("{\"release\":\"game@1.0\",\"tags\":{\"Configuration\":\"Shipping\"},\"contexts\":{\"gpu\":{\"name\":\"GPU\"}}}"));
+
+			TestEqual("Spliced into existing sections", SplicePayload(Fragment, TEXT("{\"tags\":{\"a\":\"b\"},\"contexts\":{},\"level\":\"error\"}")),
+				TEXT("{\"tags\":{\"a\":\"b\",\"Configuration\":\"Shipping\"},\"contexts\":{\"gpu\":{\"name\":\"GPU\"}},\"level\":\"error\",\"release\":\"game@1.0\"}"));
+		});
+
+		It("should keep values set on the event", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetAttribute(TEXT("release"), TEXT("game@1.0"));
+			Fragment.SetTag(TEXT("Configuration"), TEXT("Shipping"));
+			Fragment.SetContext(TEXT("gpu"), "{\"name\":\"GPU\"}");
+
+			const FString Payload = TEXT("{\"release\":\"custom\",\"tags\":{\"Configuration\":\"Debug\"},\"contexts\":{\"gpu\":null}}");
+
+			TArray<uint8> Spliced;
+			const TArray<uint8> Bytes = ToBytes(Payload);
+			TestFalse("Nothing spliced", Fragment.SplicePayload(Bytes.GetData(), Bytes.Num(), Spliced));
+		});
+
+		It("should skip nested objects and strings containing braces", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetTag(TEXT("Is game"), TEXT("true"));
+
+			TestEqual("Spliced at the top level", SplicePayload(Fragment, TEXT("{ \"extra\": {\"tags\": {\"x\": \"}\\\"{\"}}, \"list\": [1, {\"a\": [true]}] }")),
+				TEXT("{ \"extra\": {\"tags\": {\"x\": \"}\\\"{\"}}, \"list\": [1, {\"a\": [true]}] ,\"tags\":{\"Is game\":\"true\"}}"));
+		});
+
+		It("should escape keys and values", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetTag(TEXT("Quote\""), TEXT("Line\nBreak"));
+
+			TestEqual("Escaped", SplicePayload(Fragment, TEXT("{}")), TEXT("{\"tags\":{\"Quote\\\"\":\"Line\\nBreak\"}}"));
+		});
+
+		It("should leave malformed payloads as they are", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetTag(TEXT("a"), TEXT("b"));
+
+			TArray<uint8> Spliced;
+			const TArray<uint8> Bytes = ToBytes(TEXT("{\"tags\":{\"x\":"));
+			TestFalse("Not spliced", Fragment.SplicePayload(Bytes.GetData(), Bytes.Num(), Spliced));
+		});
+
+		It("should forget removed entries", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetTag(TEXT("a"), TEXT("b"));
+			Fragment.SetContext(TEXT("gpu"), "{}");
+
+			Fragment.RemoveTag(TEXT("a"));
+			Fragment.RemoveContext(TEXT("gpu"));
+
+			TestTrue("Empty", Fragment.IsEmpty());
+		});
+	});
+
+	Describe("Envelope splicing", [this]()
+	{
+		It("should splice events and update their length", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetTag(TEXT("a"), TEXT("b"));
+
+			TArray<uint8> Envelope = ToBytes(TEXT("{\"event_id\":\"0123456789abcdef0123456789abcdef\"}\n{\"type\":\"event\",\"length\":2}\n{}\n{\"type\":\"attachment\",\"length\":1}\nA\n"));
+
+			TestTrue("Envelope spliced", Fragment.Splice(Envelope));
+
+			int32 HeaderEnd = 0;
+			TArray<FSentryEnvelopeBatch::FItem> Items;
+			TestTrue("Spliced envelope is valid", FSentryEnvelopeBatch::Parse(Envelope, HeaderEnd, Items));
+
+			TestEqual("Items kept", Items.Num(), 2);
+
+			if (Items.Num() == 2)
+			{
+				const TArray<uint8> Payload(Envelope.GetData() + Items[0].PayloadStart, Items[0].PayloadEnd - Items[0].PayloadStart);
+				TestEqual("Event spliced", ToString(Payload), TEXT("{\"tags\":{\"a\":\"b\"}}"));
+				TestEqual("Attachment kept", Items[1].Type, TEXT("attachment"));
+			}
+		});
+
+		It("should leave envelopes without events as they are", [this]()
+		{
+			FSentryStaticScopeFragment Fragment;
+			Fragment.SetTag(TEXT("a"), TEXT("b"));
+
+			TArray<uint8> Envelope = ToBytes(TEXT("{}\n{\"type\":\"session\"}\n{\"status\":\"ok\"}\n"));
+
+			TestFalse("Session not spliced", Fragment.Splice(Envelope));
+		});
+	});
+}
+
+#endif
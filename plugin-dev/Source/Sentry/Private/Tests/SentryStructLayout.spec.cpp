@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "SentryCrashVideoConfig.h"
+#include "SentryMetricKey.h"
+
+#include "Utils/SentryStructLayout.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryStructLayoutSpec, "Sentry.SentryStructLayout", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	/** Counts the written fields and the nesting of structs. */
+	struct FCountingWriter
+	{
+		int32 NumValues = 0;
+		int32 NumStructs = 0;
+		int32 Depth = 0;
+		int32 MaxDepth = 0;
+
+		void WriteBool(const FSentryStructLayout::FField& Field, bool Value) { ++NumValues; }
+		void WriteInteger(const FSentryStructLayout::FField& Field, int32 Value) { ++NumValues; }
+		void WriteFloat(const FSentryStructLayout::FField& Field, double Value) { ++NumValues; }
+		void WriteString(const FSentryStructLayout::FField& Field, const FString& Value) { ++NumValues; }
+
+		void BeginStruct(const FSentryStructLayout::FField& Field)
+		{
+			++NumStructs;
+			MaxDepth = FMath::Max(MaxDepth, ++Depth);
+		}
+
+		void EndStruct(const FSentryStructLayout::FField& Field)
+		{
+			--Depth;
+		}
+	};
+END_DEFINE_SPEC(SentryStructLayoutSpec)
+
+void SentryStructLayoutSpec::Define()
+{
+	Describe("Layout", [this]()
+	{
+		It("should be cached per struct type", [this]()
+		{
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> First = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct());
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Second = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct());
+
+			TestTrue("Same layout returned", &First.Get() == &Second.Get());
+		});
+
+		It("should be rebuilt once the cache is reset", [this]()
+		{
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Before = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct());
+
+			FSentryStructLayout::ResetCache();
+
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> After = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct());
+
+			TestTrue("New layout returned", &Before.Get() != &After.Get());
+			TestEqual("Same fields", After->GetFields().Num(), Before->GetFields().Num());
+		});
+
+		It("should skip containers", [this]()
+		{
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Layout = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct());
+
+			TestFalse("Array skipped", Layout->GetFields().ContainsByPredicate([](const FSentryStructLayout::FField& Field)
+			{
+				return Field.Name == TEXT("DeviceProfiles");
+			}));
+		});
+	});
+
+	Describe("Variant map", [this]()
+	{
+		It("should hold the struct fields", [this]()
+		{
+			FCrashVideoPreset Preset;
+			Preset.Name = TEXT("Android_Low");
+			Preset.MaxScalabilityLevel = 1;
+			Preset.Config.TargetFPS = 15;
+			Preset.Config.bEnableAudio = true;
+			Preset.Config.LastSecondsToRecord = 12.5f;
+			Preset.Config.FrameStripFrameSize = FIntPoint(160, 90);
+
+			const TMap<FString, FSentryVariant> Values = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct())->ToVariantMap(&Preset);
+
+			TestEqual("String", Values.FindRef(TEXT("Name")).GetValue<FString>(), FString(TEXT("Android_Low")));
+			TestEqual("Integer", Values.FindRef(TEXT("MaxScalabilityLevel")).GetValue<int32>(), 1);
+			TestFalse("Array skipped", Values.Contains(TEXT("DeviceProfiles")));
+
+			const TMap<FString, FSentryVariant> Config = Values.FindRef(TEXT("Config")).GetValue<TMap<FString, FSentryVariant>>();
+			TestEqual("Nested integer", Config.FindRef(TEXT("TargetFPS")).GetValue<int32>(), 15);
+			TestEqual("Nested bool", Config.FindRef(TEXT("bEnableAudio")).GetValue<bool>(), true);
+			TestEqual("Nested float", Config.FindRef(TEXT("LastSecondsToRecord")).GetValue<float>(), 12.5f);
+
+			const TMap<FString, FSentryVariant> FrameSize = Config.FindRef(TEXT("FrameStripFrameSize")).GetValue<TMap<FString, FSentryVariant>>();
+			TestEqual("Deeply nested integer", FrameSize.FindRef(TEXT("X")).GetValue<int32>(), 160);
+		});
+
+		It("should write enums as names", [this]()
+		{
+			FSentryMetricKey Key;
+			Key.Id = 3;
+			Key.Type = ESentryMetricType::Counter;
+
+			const TMap<FString, FSentryVariant> Values = FSentryStructLayout::Get(FSentryMetricKey::StaticStruct())->ToVariantMap(&Key);
+
+			TestEqual("Id", Values.FindRef(TEXT("Id")).GetValue<int32>(), 3);
+			TestEqual("Type", Values.FindRef(TEXT("Type")).GetValue<FString>(), StaticEnum<ESentryMetricType>()->GetNameStringByValue(static_cast<int64>(ESentryMetricType::Counter)));
+		});
+	});
+
+	Describe("Limits", [this]()
+	{
+		It("should drop structs nested too deep", [this]()
+		{
+			const FCrashVideoPreset Preset;
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Layout = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct());
+
+			FCountingWriter Unlimited;
+			TestEqual("Nothing dropped without limits", Layout->Write(&Preset, Unlimited), 0);
+			TestEqual("Nested structs written", Unlimited.MaxDepth, 2);
+
+			FCountingWriter Limited;
+			const int32 NumDropped = Layout->Write(&Preset, Limited, 1);
+
+			TestEqual("Only one level of nesting", Limited.MaxDepth, 1);
+			TestEqual("Every struct of the nested level dropped", NumDropped, Unlimited.NumStructs - Limited.NumStructs);
+		});
+
+		It("should cap the amount of fields", [this]()
+		{
+			const FCrashVideoPreset Preset;
+
+			FCountingWriter Writer;
+			const int32 NumDropped = FSentryStructLayout::Get(FCrashVideoPreset::StaticStruct())->Write(&Preset, Writer, 0, 2);
+
+			TestEqual("Two top-level fields kept", Writer.NumValues + Writer.NumStructs, 2);
+			TestTrue("Remaining fields dropped", NumDropped > 0);
+		});
+	});
+}
+
+#endif
@@ -33,6 +33,19 @@ void SentrySubsystemSpec::Define()
 		}
 	});
 
+	Describe("Cached instance", [this]()
+	{
+		It("should be the engine subsystem", [this]()
+		{
+			TestTrue("Cached subsystem", USentrySubsystem::Get() == SentrySubsystem);
+		});
+
+		It("should mirror whether Sentry is enabled", [this]()
+		{
+			TestEqual("Enabled", USentrySubsystem::IsEnabledFast(), SentrySubsystem->IsEnabled());
+		});
+	});
+
 	Describe("Capture Message", [this]()
 	{
 		It("should return a non-null Event ID if message captured", [this]()
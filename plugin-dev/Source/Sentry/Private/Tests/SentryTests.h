@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include "Dom/JsonObject.h"
 #include "Misc/AutomationTest.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 #if WITH_AUTOMATION_TESTS
 
@@ -13,4 +16,17 @@ static constexpr EAutomationTestFlags::Type SentryApplicationContextMask = EAuto
 static constexpr EAutomationTestFlags SentryApplicationContextMask = EAutomationTestFlags_ApplicationContextMask;
 #endif
 
+namespace SentryTests
+{
+	/** Parses a UTF-8 JSON document produced by the SDK, invalid if it isn't an object. */
+	inline TSharedPtr<FJsonObject> ParseJson(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+
+		TSharedPtr<FJsonObject> Object;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get())), Object);
+		return Object;
+	}
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryUploadScheduler.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryUploadSchedulerSpec, "Sentry.SentryUploadScheduler", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryUploadSchedulerSpec)
+
+void SentryUploadSchedulerSpec::Define()
+{
+	Describe("Bandwidth", [this]()
+	{
+		It("should start all uploads right away without a limit", [this]()
+		{
+			FSentryUploadScheduler Scheduler(0, 0);
+
+			int32 NumStarted = 0;
+			for (int32 i = 0; i < 5; ++i)
+			{
+				Scheduler.Schedule(1024 * 1024, [&NumStarted]() { NumStarted++; });
+			}
+
+			Scheduler.Tick(0.0f, false);
+
+			TestEqual("All uploads started", NumStarted, 5);
+		});
+
+		It("should keep uploads within the bandwidth limit on average", [this]()
+		{
+			FSentryUploadScheduler Scheduler(100, 0);
+
+			int32 NumStarted = 0;
+			Scheduler.Schedule(100, [&NumStarted]() { NumStarted++; });
+			Scheduler.Schedule(100, [&NumStarted]() { NumStarted++; });
+
+			Scheduler.Tick(0.0f, false);
+			TestEqual("First upload started with the initial budget", NumStarted, 1);
+
+			Scheduler.Tick(0.5f, false);
+			TestEqual("Second upload waits for the budget", NumStarted, 1);
+
+			Scheduler.Tick(0.5f, false);
+			TestEqual("Second upload started", NumStarted, 2);
+		});
+
+		It("should pay off uploads larger than the limit", [this]()
+		{
+			FSentryUploadScheduler Scheduler(100, 0);
+
+			int32 NumStarted = 0;
+			Scheduler.Schedule(300, [&NumStarted]() { NumStarted++; });
+			Scheduler.Schedule(100, [&NumStarted]() { NumStarted++; });
+
+			Scheduler.Tick(0.0f, false);
+			TestEqual("Large upload started with the full budget", NumStarted, 1);
+			TestEqual("Budget negative", Scheduler.GetBudget(), -200.0);
+
+			Scheduler.Tick(2.0f, false);
+			TestEqual("Next upload waits until paid off", NumStarted, 1);
+
+			Scheduler.Tick(1.0f, false);
+			TestEqual("Next upload started", NumStarted, 2);
+		});
+	});
+
+	Describe("Matches", [this]()
+	{
+		It("should hold large uploads during a match and let small ones through", [this]()
+		{
+			FSentryUploadScheduler Scheduler(0, 1000);
+
+			bool bLargeStarted = false;
+			bool bSmallStarted = false;
+			Scheduler.Schedule(2000, [&bLargeStarted]() { bLargeStarted = true; });
+			Scheduler.Schedule(10, [&bSmallStarted]() { bSmallStarted = true; });
+
+			Scheduler.Tick(1.0f, true);
+			TestFalse("Large upload held", bLargeStarted);
+			TestTrue("Small upload started", bSmallStarted);
+			TestEqual("Large upload pending", Scheduler.GetNumPending(), 1);
+
+			Scheduler.Tick(1.0f, false);
+			TestTrue("Large upload started after the match", bLargeStarted);
+		});
+	});
+
+	Describe("Transport", [this]()
+	{
+		It("should hold only large uploads while the transport is backed up", [this]()
+		{
+			FSentryUploadScheduler Scheduler(0, 1000, false);
+
+			bool bLargeStarted = false;
+			bool bSmallStarted = false;
+			Scheduler.Schedule(2000, [&bLargeStarted]() { bLargeStarted = true; });
+			Scheduler.Schedule(10, [&bSmallStarted]() { bSmallStarted = true; });
+
+			Scheduler.Tick(1.0f, true, true);
+			TestFalse("Large upload held", bLargeStarted);
+			TestTrue("Small upload left to the transport", bSmallStarted);
+
+			Scheduler.Tick(1.0f, true, false);
+			TestTrue("Large upload started once the transport recovers, matches aren't waited for", bLargeStarted);
+		});
+
+		It("should start held uploads when flushed", [this]()
+		{
+			FSentryUploadScheduler Scheduler(100, 1000);
+
+			int32 NumStarted = 0;
+			Scheduler.Schedule(2000, [&NumStarted]() { NumStarted++; });
+			Scheduler.Schedule(2000, [&NumStarted]() { NumStarted++; });
+
+			Scheduler.Tick(0.0f, true, true);
+			TestEqual("Uploads held", NumStarted, 0);
+
+			Scheduler.Flush();
+			TestEqual("All uploads started", NumStarted, 2);
+			TestEqual("Nothing pending", Scheduler.GetNumPending(), 0);
+		});
+	});
+}
+
+#endif
@@ -3,6 +3,9 @@
 #include "SentryVariant.h"
 #include "SentryTests.h"
 
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
 #if WITH_AUTOMATION_TESTS
 
 BEGIN_DEFINE_SPEC(SentryVariantSpec, "Sentry.SentryVariant", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
@@ -120,6 +123,41 @@ void SentryVariantSpec::Define()
 			TestEqual("Map is empty", MapVariant.GetValue<TMap<FString, FSentryVariant>>().Num(), 0);
 		});
 
+		It("should survive serialization round-trip", [this]()
+		{
+			TMap<FString, FSentryVariant> TestMap;
+			TestMap.Add(TEXT("Int"), 42);
+			TestMap.Add(TEXT("Float"), 1.5f);
+			TestMap.Add(TEXT("Bool"), true);
+			TestMap.Add(TEXT("String"), TEXT("Hello"));
+			TestMap.Add(TEXT("Array"), TArray<FSentryVariant>({ 1, TEXT("Two") }));
+
+			FSentryVariant Original(TestMap);
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Writer << Original;
+
+			FSentryVariant Loaded;
+			FMemoryReader Reader(Bytes);
+			Reader << Loaded;
+
+			TestTrue("Loaded variant equals original", Loaded == Original);
+			TestEqual("Nested array value", Loaded.GetMapRef()[TEXT("Array")].GetArrayRef()[1].GetStringRef(), TEXT("Two"));
+		});
+
+		It("should keep copies independent of the source container", [this]()
+		{
+			TArray<FSentryVariant> TestArray = { 1, 2 };
+			FSentryVariant ArrayVariant(TestArray);
+			FSentryVariant CopiedVariant = ArrayVariant;
+
+			TestArray.Add(3);
+
+			TestEqual("Variant array size", ArrayVariant.GetArrayRef().Num(), 2);
+			TestTrue("Copies are equal", CopiedVariant == ArrayVariant);
+		});
+
 		It("should support nested containers", [this]()
 		{
 			const TArray<FSentryVariant>& NestedArray = {
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "Utils/SentryWorldScopes.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryWorldScopesSpec, "Sentry.SentryWorldScopes", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	TUniquePtr<FSentryWorldScopes> WorldScopes;
+	UObject* FirstWorld;
+	UObject* SecondWorld;
+END_DEFINE_SPEC(SentryWorldScopesSpec)
+
+void SentryWorldScopesSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		WorldScopes = MakeUnique<FSentryWorldScopes>();
+
+		// Scopes are only keyed by the object, so any two objects stand in for the worlds
+		FirstWorld = GetTransientPackage();
+		SecondWorld = UPackage::StaticClass()->GetDefaultObject();
+	});
+
+	AfterEach([this]()
+	{
+		WorldScopes.Reset();
+	});
+
+	Describe("SetTag", [this]()
+	{
+		It("should keep the tags of different worlds apart", [this]()
+		{
+			WorldScopes->SetTag(FirstWorld, TEXT("match"), TEXT("first"));
+			WorldScopes->SetTag(SecondWorld, TEXT("match"), TEXT("second"));
+
+			FSentryWorldScopes::FSnapshot FirstSnapshot;
+			FSentryWorldScopes::FSnapshot SecondSnapshot;
+
+			TestTrue("First world has scope", WorldScopes->GetSnapshot(FirstWorld, FirstSnapshot));
+			TestTrue("Second world has scope", WorldScopes->GetSnapshot(SecondWorld, SecondSnapshot));
+
+			TestEqual("First world tag", FirstSnapshot.Tags.FindRef(TEXT("match")), FString(TEXT("first")));
+			TestEqual("Second world tag", SecondSnapshot.Tags.FindRef(TEXT("match")), FString(TEXT("second")));
+		});
+
+		It("should remove only the tag of the given world", [this]()
+		{
+			WorldScopes->SetTag(FirstWorld, TEXT("match"), TEXT("first"));
+			WorldScopes->SetTag(SecondWorld, TEXT("match"), TEXT("second"));
+
+			WorldScopes->RemoveTag(FirstWorld, TEXT("match"));
+
+			FSentryWorldScopes::FSnapshot FirstSnapshot;
+			FSentryWorldScopes::FSnapshot SecondSnapshot;
+
+			WorldScopes->GetSnapshot(FirstWorld, FirstSnapshot);
+			WorldScopes->GetSnapshot(SecondWorld, SecondSnapshot);
+
+			TestFalse("First world tag", FirstSnapshot.Tags.Contains(TEXT("match")));
+			TestTrue("Second world tag", SecondSnapshot.Tags.Contains(TEXT("match")));
+		});
+	});
+
+	Describe("SetContext", [this]()
+	{
+		It("should replace the context of the world", [this]()
+		{
+			WorldScopes->SetContext(FirstWorld, TEXT("match"), { { TEXT("round"), 1 } });
+			WorldScopes->SetContext(FirstWorld, TEXT("match"), { { TEXT("round"), 2 } });
+
+			FSentryWorldScopes::FSnapshot Snapshot;
+			WorldScopes->GetSnapshot(FirstWorld, Snapshot);
+
+			TestEqual("Contexts", Snapshot.Contexts.Num(), 1);
+			TestEqual("Round", Snapshot.Contexts.FindRef(TEXT("match")).FindRef(TEXT("round")).GetValue<int32>(), 2);
+		});
+	});
+
+	Describe("Clear", [this]()
+	{
+		It("should discard the scope of the world only", [this]()
+		{
+			WorldScopes->SetTag(FirstWorld, TEXT("match"), TEXT("first"));
+			WorldScopes->SetTag(SecondWorld, TEXT("match"), TEXT("second"));
+
+			WorldScopes->Clear(FirstWorld);
+
+			FSentryWorldScopes::FSnapshot Snapshot;
+
+			TestFalse("First world has scope", WorldScopes->GetSnapshot(FirstWorld, Snapshot));
+			TestTrue("Second world has scope", WorldScopes->GetSnapshot(SecondWorld, Snapshot));
+			TestEqual("Scopes", WorldScopes->Num(), 1);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTests.h"
+
+#include "SentryEvent.h"
+
+#include "HAL/PlatformSentryEvent.h"
+#include "Utils/SentryWrapperPool.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryWrapperPoolSpec, "Sentry.SentryWrapperPool", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+END_DEFINE_SPEC(SentryWrapperPoolSpec)
+
+void SentryWrapperPoolSpec::Define()
+{
+	Describe("Event wrappers", [this]()
+	{
+		It("should reuse released objects", [this]()
+		{
+			USentryEvent* FirstEvent = nullptr;
+			{
+				const FSentryEventWrapperPool::FScopedObject Event(CreateSharedSentryEvent());
+				FirstEvent = Event.Get();
+
+				TestNotNull("Event created", FirstEvent);
+				TestTrue("Event rooted", FirstEvent && FirstEvent->IsRooted());
+			}
+
+			TestFalse("Native implementation released", FirstEvent && FirstEvent->GetNativeObject().IsValid());
+
+			const FSentryEventWrapperPool::FScopedObject Event(CreateSharedSentryEvent());
+
+			TestEqual("Object reused", Event.Get(), FirstEvent);
+			TestTrue("Native implementation bound", Event.Get()->GetNativeObject().IsValid());
+		});
+
+		It("should wrap the given native implementation", [this]()
+		{
+			TSharedPtr<ISentryEvent> NativeEvent = CreateSharedSentryEvent();
+
+			const FSentryEventWrapperPool::FScopedObject Event(NativeEvent);
+
+			TestTrue("Same native implementation", Event.Get()->GetNativeObject() == NativeEvent);
+		});
+
+		It("should unroot pooled objects when reset", [this]()
+		{
+			USentryEvent* PooledEvent = nullptr;
+			{
+				const FSentryEventWrapperPool::FScopedObject Event(CreateSharedSentryEvent());
+				PooledEvent = Event.Get();
+			}
+
+			FSentryEventWrapperPool::Get().Reset();
+
+			TestEqual("Pool emptied", FSentryEventWrapperPool::Get().GetNumFree(), 0);
+			TestFalse("Pooled object unrooted", PooledEvent && PooledEvent->IsRooted());
+		});
+
+		It("should not pool objects acquired before a reset", [this]()
+		{
+			FSentryEventWrapperPool::Get().Reset();
+
+			USentryEvent* StaleEvent = nullptr;
+			{
+				const FSentryEventWrapperPool::FScopedObject Event(CreateSharedSentryEvent());
+				StaleEvent = Event.Get();
+
+				FSentryEventWrapperPool::Get().Reset();
+			}
+
+			TestEqual("Pool still empty", FSentryEventWrapperPool::Get().GetNumFree(), 0);
+			TestFalse("Stale object unrooted", StaleEvent && StaleEvent->IsRooted());
+		});
+
+		It("should not create objects without a native implementation", [this]()
+		{
+			const FSentryEventWrapperPool::FScopedObject Event(nullptr);
+
+			TestNull("No object", Event.Get());
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryAdaptiveSampler.h"
+
+#include "SentryDefines.h"
+
+namespace SentryAdaptiveSampler
+{
+	/** Fraction of the backlog limits below which nothing is sampled out. */
+	static constexpr float DegradationStart = 0.5f;
+}
+
+FSentryAdaptiveSampler::FSentryAdaptiveSampler(int32 InMaxPendingEnvelopes, int64 InMaxPendingBytes, float InMinSampleRate)
+	: MaxPendingEnvelopes(FMath::Max(1, InMaxPendingEnvelopes))
+	, MaxPendingBytes(FMath::Max<int64>(1, InMaxPendingBytes))
+	, MinSampleRate(FMath::Clamp(InMinSampleRate, 0.0f, 1.0f))
+	, SampleRate(1.0f)
+{
+}
+
+void FSentryAdaptiveSampler::SetBacklog(int32 NumEnvelopes, int64 NumBytes)
+{
+	const float Pressure = FMath::Max(static_cast<float>(NumEnvelopes) / MaxPendingEnvelopes, static_cast<float>(static_cast<double>(NumBytes) / MaxPendingBytes));
+	const float Degradation = FMath::Clamp((Pressure - SentryAdaptiveSampler::DegradationStart) / (1.0f - SentryAdaptiveSampler::DegradationStart), 0.0f, 1.0f);
+
+	const float NewSampleRate = FMath::Lerp(1.0f, MinSampleRate, Degradation);
+	const float OldSampleRate = SampleRate.Exchange(NewSampleRate);
+
+	if (OldSampleRate >= 1.0f && NewSampleRate < 1.0f)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Transport backlog is growing (%d envelopes, %lld bytes), sampling out low-priority events, logs and transactions."), NumEnvelopes, NumBytes);
+	}
+	else if (OldSampleRate < 1.0f && NewSampleRate >= 1.0f)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Transport backlog has drained, low-priority events, logs and transactions are no longer sampled out."));
+	}
+}
+
+bool FSentryAdaptiveSampler::ShouldKeep(ESentryLevel Level) const
+{
+	return Level > ESentryLevel::Info || ShouldKeep();
+}
+
+bool FSentryAdaptiveSampler::ShouldKeep() const
+{
+	const float Rate = SampleRate.Load();
+	return Rate >= 1.0f || FMath::FRand() < Rate;
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+#include "SentryDataTypes.h"
+
+/**
+ * Sample rate for low-priority payloads lowered as envelopes pile up in the transport.
+ *
+ * The transport reports its backlog (queued, in-flight and spooled envelopes) and the rate goes down linearly
+ * from 1 once the backlog exceeds half of its limits, reaching the min rate at the limits. It's derived from the
+ * current backlog only, so it recovers as soon as the queue drains. Info and debug events and logs as well as
+ * transactions are subject to it; warnings, errors and crashes never are. Thread-safe.
+ */
+class FSentryAdaptiveSampler
+{
+public:
+	/**
+	 * @param InMaxPendingEnvelopes Backlog size in envelopes at which the min rate applies.
+	 * @param InMaxPendingBytes Backlog size in bytes at which the min rate applies.
+	 * @param InMinSampleRate Sample rate applied to low-priority payloads under full backlog.
+	 */
+	FSentryAdaptiveSampler(int32 InMaxPendingEnvelopes, int64 InMaxPendingBytes, float InMinSampleRate);
+
+	/** Updates the backlog the rate is derived from. */
+	void SetBacklog(int32 NumEnvelopes, int64 NumBytes);
+
+	/** Gets the rate low-priority payloads are currently kept at, 1 while the backlog is small. */
+	float GetSampleRate() const { return SampleRate.Load(); }
+
+	/** Checks whether a payload of the given level is kept, payloads above info level always are. */
+	bool ShouldKeep(ESentryLevel Level) const;
+
+	/** Checks whether a low-priority payload is kept. */
+	bool ShouldKeep() const;
+
+private:
+	const int32 MaxPendingEnvelopes;
+	const int64 MaxPendingBytes;
+	const float MinSampleRate;
+
+	TAtomic<float> SampleRate;
+};
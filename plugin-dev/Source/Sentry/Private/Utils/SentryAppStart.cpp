@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryAppStart.h"
+
+FSentryAppStart::FSentryAppStart(double InProcessStartTime, double InModuleStartupTime, const FSentryInitPhase& InInitPhase, bool bInIsMapLoaded)
+	: ProcessStartTime(InProcessStartTime)
+	, ModuleStartupTime(InModuleStartupTime)
+	, InitPhase(InInitPhase)
+	, bIsMapLoaded(bInIsMapLoaded)
+{
+}
+
+void FSentryAppStart::OnMapLoadStarted(double Time, const FString& InMapName)
+{
+	if (bIsMapLoaded || MapLoadStartTime > 0.0)
+	{
+		return;
+	}
+
+	MapName = InMapName;
+	MapLoadStartTime = Time;
+}
+
+void FSentryAppStart::OnMapLoadFinished(double Time)
+{
+	if (bIsMapLoaded || MapLoadStartTime <= 0.0 || MapLoadEndTime > 0.0)
+	{
+		return;
+	}
+
+	MapLoadEndTime = Time;
+}
+
+bool FSentryAppStart::OnFrameEnded(double Time)
+{
+	if (IsComplete())
+	{
+		return false;
+	}
+
+	if (FirstFrameTime <= 0.0)
+	{
+		FirstFrameTime = Time;
+	}
+
+	if (bIsMapLoaded || MapLoadEndTime > 0.0)
+	{
+		InteractiveTime = Time;
+		return true;
+	}
+
+	return false;
+}
+
+double FSentryAppStart::GetTimeToFirstFrameMs() const
+{
+	return HasFirstFrame() ? (FirstFrameTime - ProcessStartTime) * 1000.0 : 0.0;
+}
+
+double FSentryAppStart::GetTimeToInteractiveMs() const
+{
+	return IsComplete() ? (InteractiveTime - ProcessStartTime) * 1000.0 : 0.0;
+}
+
+TArray<FSentryInitPhase> FSentryAppStart::GetPhases() const
+{
+	TArray<FSentryInitPhase> Phases;
+
+	auto AddPhase = [&Phases](const TCHAR* Name, double StartTime, double EndTime)
+	{
+		if (StartTime > 0.0 && EndTime >= StartTime)
+		{
+			FSentryInitPhase& Phase = Phases.AddDefaulted_GetRef();
+			Phase.Name = Name;
+			Phase.StartTime = StartTime;
+			Phase.EndTime = EndTime;
+		}
+	};
+
+	AddPhase(TEXT("app.start.modules"), ProcessStartTime, ModuleStartupTime);
+	AddPhase(TEXT("app.start.sentry"), InitPhase.StartTime, InitPhase.EndTime);
+	AddPhase(TEXT("app.start.map_load"), MapLoadStartTime, MapLoadEndTime);
+	AddPhase(TEXT("app.start.first_frame"), ProcessStartTime, FirstFrameTime);
+
+	Phases.StableSort([](const FSentryInitPhase& A, const FSentryInitPhase& B)
+	{
+		return A.StartTime < B.StartTime;
+	});
+
+	return Phases;
+}
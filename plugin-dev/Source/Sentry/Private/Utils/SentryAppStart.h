@@ -0,0 +1,69 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryInitProfile.h"
+
+/**
+ * Milestones of a cold start of the game, from the process start to the first map being interactive.
+ *
+ * All times are in FPlatformTime::Seconds. The first rendered frame is the first frame to end after Sentry was
+ * initialized, and the game is considered interactive once a frame ends after the first map finished loading.
+ */
+class FSentryAppStart
+{
+public:
+	/**
+	 * @param InProcessStartTime Time the engine started at.
+	 * @param InModuleStartupTime Time the Sentry module was loaded at, after most engine modules.
+	 * @param InInitPhase Span of the Sentry initialization.
+	 * @param bInIsMapLoaded Whether a map was already loaded when Sentry was initialized, e.g. by a manual initialization.
+	 */
+	FSentryAppStart(double InProcessStartTime, double InModuleStartupTime, const FSentryInitPhase& InInitPhase, bool bInIsMapLoaded);
+
+	/** Records the start of the first map load, later loads are ignored. */
+	void OnMapLoadStarted(double Time, const FString& MapName);
+
+	/** Records the end of the first map load, later loads are ignored. */
+	void OnMapLoadFinished(double Time);
+
+	/**
+	 * Records the end of a frame.
+	 *
+	 * @return True if the game has just become interactive, which completes the measurement.
+	 */
+	bool OnFrameEnded(double Time);
+
+	bool IsComplete() const { return InteractiveTime > 0.0; }
+
+	bool HasFirstFrame() const { return FirstFrameTime > 0.0; }
+
+	double GetProcessStartTime() const { return ProcessStartTime; }
+
+	double GetInteractiveTime() const { return InteractiveTime; }
+
+	double GetTimeToFirstFrameMs() const;
+
+	double GetTimeToInteractiveMs() const;
+
+	const FString& GetMapName() const { return MapName; }
+
+	/** Gets the phases of the start that were observed, ordered by their start time. Phase names are used as span operations. */
+	TArray<FSentryInitPhase> GetPhases() const;
+
+private:
+	double ProcessStartTime;
+	double ModuleStartupTime;
+	FSentryInitPhase InitPhase;
+
+	bool bIsMapLoaded;
+
+	FString MapName;
+	double MapLoadStartTime = 0.0;
+	double MapLoadEndTime = 0.0;
+
+	double FirstFrameTime = 0.0;
+	double InteractiveTime = 0.0;
+};
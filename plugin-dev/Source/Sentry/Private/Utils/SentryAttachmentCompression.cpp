@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryAttachmentCompression.h"
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+
+namespace SentryAttachmentCompression
+{
+	/** Compressed attachments have to be at least this much smaller to be worth the extra step of decompressing them. */
+	static constexpr float MaxCompressionRatio = 0.8f;
+
+	static bool Compress(const uint8* Data, int32 Size, TArray<uint8>& OutCompressed)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Size);
+		OutCompressed.SetNumUninitialized(CompressedSize);
+
+		if (!FCompression::CompressMemory(NAME_Gzip, OutCompressed.GetData(), CompressedSize, Data, Size) || CompressedSize > Size * MaxCompressionRatio)
+		{
+			return false;
+		}
+
+		OutCompressed.SetNum(CompressedSize, false);
+		return true;
+	}
+}
+
+bool SentryAttachmentCompression::IsTextAttachment(const FJsonObject& ItemHeader)
+{
+	// Attachments with a special meaning (view hierarchies, etc.) are processed by the server and have to stay as they are
+	FString AttachmentType;
+	if (ItemHeader.TryGetStringField(TEXT("attachment_type"), AttachmentType) && AttachmentType != TEXT("event.attachment"))
+	{
+		return false;
+	}
+
+	FString ContentType;
+	if (ItemHeader.TryGetStringField(TEXT("content_type"), ContentType) && ContentType != TEXT("application/octet-stream"))
+	{
+		return ContentType.StartsWith(TEXT("text/")) || ContentType == TEXT("application/json") || ContentType == TEXT("application/xml") || ContentType.EndsWith(TEXT("+json"));
+	}
+
+	FString Filename;
+	ItemHeader.TryGetStringField(TEXT("filename"), Filename);
+
+	const FString Extension = FPaths::GetExtension(Filename).ToLower();
+	return Extension == TEXT("log") || Extension == TEXT("txt") || Extension == TEXT("json") || Extension == TEXT("ini") || Extension == TEXT("csv") || Extension == TEXT("xml");
+}
+
+bool SentryAttachmentCompression::CompressTextAttachments(TArray<uint8>& Envelope, int32 MinSize)
+{
+	int32 HeaderEnd = 0;
+	TArray<FSentryEnvelopeBatch::FItem> Items;
+	if (!FSentryEnvelopeBatch::Parse(Envelope, HeaderEnd, Items) || HeaderEnd >= Envelope.Num())
+	{
+		return false;
+	}
+
+	const bool bHasCandidates = Items.ContainsByPredicate([MinSize](const FSentryEnvelopeBatch::FItem& Item)
+	{
+		return Item.Type == TEXT("attachment") && Item.PayloadEnd - Item.PayloadStart >= MinSize;
+	});
+
+	if (!bHasCandidates)
+	{
+		return false;
+	}
+
+	TArray<uint8> Compressed;
+	Compressed.Append(Envelope.GetData(), HeaderEnd + 1);
+
+	bool bChanged = false;
+	TArray<uint8> Payload;
+
+	for (const FSentryEnvelopeBatch::FItem& Item : Items)
+	{
+		const int32 PayloadSize = Item.PayloadEnd - Item.PayloadStart;
+
+		TSharedPtr<FJsonObject> ItemHeader;
+		if (Item.Type == TEXT("attachment") && PayloadSize >= MinSize)
+		{
+			ItemHeader = FSentryEnvelopeBatch::ParseItemHeader(Envelope, Item);
+		}
+
+		if (ItemHeader && IsTextAttachment(*ItemHeader) && Compress(Envelope.GetData() + Item.PayloadStart, PayloadSize, Payload))
+		{
+			FString Filename;
+			ItemHeader->TryGetStringField(TEXT("filename"), Filename);
+
+			ItemHeader->SetStringField(TEXT("filename"), Filename + TEXT(".gz"));
+			ItemHeader->SetStringField(TEXT("content_type"), TEXT("application/gzip"));
+
+			FSentryEnvelopeBatch::AppendItem(Compressed, ItemHeader.ToSharedRef(), Payload.GetData(), Payload.Num());
+			bChanged = true;
+			continue;
+		}
+
+		Compressed.Append(Envelope.GetData() + Item.Start, Item.PayloadEnd - Item.Start);
+		Compressed.Add('\n');
+	}
+
+	if (!bChanged)
+	{
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Verbose, TEXT("Text attachments compressed, %d bytes saved."), Envelope.Num() - Compressed.Num());
+
+	Envelope = MoveTemp(Compressed);
+	return true;
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+namespace SentryAttachmentCompression
+{
+	/** Checks whether the attachment with the given item header holds text, judging by its content type or file extension. */
+	bool IsTextAttachment(const FJsonObject& ItemHeader);
+
+	/**
+	 * Gzips text attachments of a serialized envelope in place. Compressed attachments get the `.gz` extension
+	 * and the `application/gzip` content type so that they can be downloaded and opened as is.
+	 *
+	 * @param MinSize Size in bytes below which attachments are left as they are.
+	 *
+	 * @return True if at least one attachment was compressed.
+	 */
+	bool CompressTextAttachments(TArray<uint8>& Envelope, int32 MinSize);
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryAttachmentDeduplicator.h"
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "Dom/JsonObject.h"
+
+namespace SentryAttachmentDeduplicator
+{
+	/** Checks whether the attachment has no special meaning for the server and can be left out of its event. */
+	static bool IsGenericAttachment(const FJsonObject& ItemHeader)
+	{
+		FString AttachmentType;
+		return !ItemHeader.TryGetStringField(TEXT("attachment_type"), AttachmentType) || AttachmentType == TEXT("event.attachment");
+	}
+
+	/** Serializes the item replacing a duplicate attachment with a text note pointing to the event it was uploaded with. */
+	static void AppendReference(TArray<uint8>& Out, const FString& Filename, int32 Size, const FSHAHash& Hash, const FString& EventId, const FString& OriginalFilename)
+	{
+		const FTCHARToUTF8 Payload(*FString::Printf(TEXT("Attachment \"%s\" (%d bytes, SHA-1 %s) was not uploaded again as it has the same content as attachment \"%s\" of event %s."),
+			*Filename, Size, *Hash.ToString().ToLower(), *OriginalFilename, *EventId));
+
+		TSharedRef<FJsonObject> ItemHeader = MakeShared<FJsonObject>();
+		ItemHeader->SetStringField(TEXT("type"), TEXT("attachment"));
+		ItemHeader->SetStringField(TEXT("filename"), Filename + TEXT(".ref.txt"));
+		ItemHeader->SetStringField(TEXT("content_type"), TEXT("text/plain"));
+
+		FSentryEnvelopeBatch::AppendItem(Out, ItemHeader, reinterpret_cast<const uint8*>(Payload.Get()), Payload.Length());
+	}
+}
+
+FSentryAttachmentDeduplicator::FSentryAttachmentDeduplicator(double InWindowSeconds, int32 InMinSize, int32 InMaxEntries)
+	: WindowSeconds(FMath::Max(0.0, InWindowSeconds))
+	, MinSize(FMath::Max(0, InMinSize))
+	, MaxEntries(FMath::Max(1, InMaxEntries))
+{
+}
+
+bool FSentryAttachmentDeduplicator::Deduplicate(TArray<uint8>& Envelope, double Now)
+{
+	int32 HeaderEnd = 0;
+	TArray<FSentryEnvelopeBatch::FItem> Items;
+	if (!FSentryEnvelopeBatch::Parse(Envelope, HeaderEnd, Items))
+	{
+		return false;
+	}
+
+	const bool bHasCandidates = Items.ContainsByPredicate([this](const FSentryEnvelopeBatch::FItem& Item)
+	{
+		return Item.Type == TEXT("attachment") && Item.PayloadEnd - Item.PayloadStart >= MinSize;
+	});
+
+	if (!bHasCandidates || HeaderEnd >= Envelope.Num())
+	{
+		return false;
+	}
+
+	// References point to the event the content was uploaded with, attachments sent on their own can't be referenced
+	FString EventId;
+	const TSharedPtr<FJsonObject> Header = FSentryEnvelopeBatch::ParseHeader(Envelope, HeaderEnd);
+	if (!Header || !Header->TryGetStringField(TEXT("event_id"), EventId) || EventId.IsEmpty())
+	{
+		return false;
+	}
+
+	TArray<uint8> Deduplicated;
+	Deduplicated.Append(Envelope.GetData(), HeaderEnd + 1);
+
+	bool bChanged = false;
+
+	for (const FSentryEnvelopeBatch::FItem& Item : Items)
+	{
+		const int32 PayloadSize = Item.PayloadEnd - Item.PayloadStart;
+
+		TSharedPtr<FJsonObject> ItemHeader;
+		if (Item.Type == TEXT("attachment") && PayloadSize >= MinSize)
+		{
+			ItemHeader = FSentryEnvelopeBatch::ParseItemHeader(Envelope, Item);
+		}
+
+		if (!ItemHeader || !SentryAttachmentDeduplicator::IsGenericAttachment(*ItemHeader))
+		{
+			Deduplicated.Append(Envelope.GetData() + Item.Start, Item.PayloadEnd - Item.Start);
+			Deduplicated.Add('\n');
+			continue;
+		}
+
+		FString Filename;
+		ItemHeader->TryGetStringField(TEXT("filename"), Filename);
+
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Envelope.GetData() + Item.PayloadStart, PayloadSize, Hash.Hash);
+
+		const FEntry* Entry = Entries.Find(Hash);
+		if (Entry && Entry->EventId != EventId && (WindowSeconds <= 0.0 || Now - Entry->Time < WindowSeconds))
+		{
+			SentryAttachmentDeduplicator::AppendReference(Deduplicated, Filename, PayloadSize, Hash, Entry->EventId, Entry->Filename);
+			bChanged = true;
+			continue;
+		}
+
+		// Spooled envelopes being retried are deduplicated again, their attachments are pending already
+		if ((!Entry || Entry->EventId != EventId) && (PendingUploads.Contains(EventId) || PendingUploads.Num() < MaxEntries))
+		{
+			TArray<FPendingAttachment>& Pending = PendingUploads.FindOrAdd(EventId);
+			if (!Pending.ContainsByPredicate([&Hash](const FPendingAttachment& Attachment) { return Attachment.Hash == Hash; }))
+			{
+				Pending.Add({ Hash, Filename });
+			}
+		}
+
+		Deduplicated.Append(Envelope.GetData() + Item.Start, Item.PayloadEnd - Item.Start);
+		Deduplicated.Add('\n');
+	}
+
+	if (!bChanged)
+	{
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Verbose, TEXT("Duplicate attachments of event %s replaced with references, %d bytes saved."), *EventId, Envelope.Num() - Deduplicated.Num());
+
+	Envelope = MoveTemp(Deduplicated);
+	return true;
+}
+
+void FSentryAttachmentDeduplicator::OnUploadCompleted(const FString& EventId, bool bDelivered, bool bWillRetry, double Now)
+{
+	if (!bDelivered && bWillRetry)
+	{
+		return;
+	}
+
+	TArray<FPendingAttachment> Pending;
+	if (!PendingUploads.RemoveAndCopyValue(EventId, Pending) || !bDelivered)
+	{
+		return;
+	}
+
+	for (const FPendingAttachment& Attachment : Pending)
+	{
+		Record(Attachment.Hash, EventId, Attachment.Filename, Now);
+	}
+}
+
+FString FSentryAttachmentDeduplicator::GetEventId(const TArray<uint8>& Envelope)
+{
+	const int32 HeaderEnd = Envelope.IndexOfByKey('\n');
+
+	FString EventId;
+	const TSharedPtr<FJsonObject> Header = FSentryEnvelopeBatch::ParseHeader(Envelope, HeaderEnd != INDEX_NONE ? HeaderEnd : Envelope.Num());
+	if (Header)
+	{
+		Header->TryGetStringField(TEXT("event_id"), EventId);
+	}
+
+	return EventId;
+}
+
+void FSentryAttachmentDeduplicator::Record(const FSHAHash& Hash, const FString& EventId, const FString& Filename, double Now)
+{
+	if (!Entries.Contains(Hash) && Entries.Num() >= MaxEntries)
+	{
+		const FSHAHash* Oldest = nullptr;
+		double OldestTime = TNumericLimits<double>::Max();
+
+		for (const TPair<FSHAHash, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.Time < OldestTime)
+			{
+				Oldest = &Pair.Key;
+				OldestTime = Pair.Value.Time;
+			}
+		}
+
+		if (Oldest)
+		{
+			const FSHAHash OldestHash = *Oldest;
+			Entries.Remove(OldestHash);
+		}
+	}
+
+	Entries.Add(Hash, { EventId, Filename, Now });
+}
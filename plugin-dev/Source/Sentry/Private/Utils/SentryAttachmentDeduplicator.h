@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+
+/**
+ * Replaces attachments of serialized envelopes with a reference to an earlier event that carried the same content.
+ *
+ * Attachments are identified by the SHA-1 hash of their payload, computed on the thread the envelope is processed on.
+ * Only generic attachments are considered since the ones with a special meaning (minidumps, view hierarchies, etc.)
+ * have to be sent along with their event to be processed. Content only becomes a deduplication target once the upload
+ * of its event is confirmed, so that a failed or rejected upload isn't referenced by later events. Not thread-safe.
+ */
+class FSentryAttachmentDeduplicator
+{
+public:
+	/**
+	 * @param InWindowSeconds Time after which the same content is uploaded again, 0 to deduplicate for the whole session.
+	 * @param InMinSize Size in bytes below which attachments are always uploaded as the reference wouldn't be much smaller.
+	 * @param InMaxEntries Max number of remembered hashes, the oldest ones are forgotten first.
+	 */
+	FSentryAttachmentDeduplicator(double InWindowSeconds, int32 InMinSize = 1024, int32 InMaxEntries = 1024);
+
+	/** Replaces duplicate attachments of the envelope in place, false if the envelope wasn't changed. */
+	bool Deduplicate(TArray<uint8>& Envelope, double Now);
+
+	/**
+	 * Records the attachments of the event once its upload completed.
+	 *
+	 * @param bDelivered Whether the server accepted the envelope, only then its attachments can be referenced.
+	 * @param bWillRetry Whether the envelope is kept to be sent again, in which case its attachments are still pending.
+	 */
+	void OnUploadCompleted(const FString& EventId, bool bDelivered, bool bWillRetry, double Now);
+
+	/** Checks whether any deduplicated envelope waits for its upload to complete. */
+	bool HasPendingUploads() const { return PendingUploads.Num() > 0; }
+
+	/** Gets the event ID from the header of the serialized envelope, empty if it has none. */
+	static FString GetEventId(const TArray<uint8>& Envelope);
+
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	struct FEntry
+	{
+		FString EventId;
+		FString Filename;
+		double Time;
+	};
+
+	struct FPendingAttachment
+	{
+		FSHAHash Hash;
+		FString Filename;
+	};
+
+	/** Remembers the attachment evicting the oldest entry if needed. */
+	void Record(const FSHAHash& Hash, const FString& EventId, const FString& Filename, double Now);
+
+	const double WindowSeconds;
+	const int32 MinSize;
+	const int32 MaxEntries;
+
+	TMap<FSHAHash, FEntry> Entries;
+
+	/** Attachments of the events whose upload hasn't completed yet, bounded by the max number of entries as well. */
+	TMap<FString, TArray<FPendingAttachment>> PendingUploads;
+};
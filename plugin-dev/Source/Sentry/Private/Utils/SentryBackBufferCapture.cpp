@@ -0,0 +1,330 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryBackBufferCapture.h"
+
+#include "SentryDefines.h"
+#include "Utils/SentryRedactedWidgets.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+#include "UnrealClient.h"
+#include "Widgets/SWindow.h"
+
+FSentryBackBufferCapture& FSentryBackBufferCapture::Get()
+{
+	static FSentryBackBufferCapture Instance;
+	return Instance;
+}
+
+bool FSentryBackBufferCapture::Start(bool bInIncludeUI, float InRefreshIntervalSeconds)
+{
+	check(IsInGameThread());
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	UE_LOG(LogSentrySdk, Log, TEXT("Backbuffer screenshot capturing requires Unreal Engine 5.0 or newer, falling back to Slate screenshots."));
+	return false;
+#else
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	if (!FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Slate renderer required for backbuffer screenshot capturing is not available, falling back to Slate screenshots."));
+		return false;
+	}
+
+	bIncludeUI = bInIncludeUI;
+	RefreshIntervalSeconds = FMath::Max(0.1f, InRefreshIntervalSeconds);
+
+	bIsActive = true;
+
+	OnBackBufferReadyHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddRaw(this, &FSentryBackBufferCapture::OnBackBufferReadyToPresent);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Backbuffer screenshot capturing enabled (UI %s)."), bIncludeUI ? TEXT("included") : TEXT("excluded"));
+
+	return true;
+#endif
+}
+
+void FSentryBackBufferCapture::Stop()
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(OnBackBufferReadyHandle);
+	}
+
+	OnBackBufferReadyHandle.Reset();
+
+	// Make sure the render thread is done with the readback and the pending requests before releasing them
+	FlushRenderingCommands();
+
+	Readback.Reset();
+	SceneRenderTarget.SafeRelease();
+	PrivacyMaskTarget.SafeRelease();
+	ResolveBuffer.Empty();
+	CapturedWindow = nullptr;
+
+	TArray<FSentryOnFrameCaptured> UnansweredRequests = MoveTemp(InFlightRequests);
+	InFlightRequests.Reset();
+
+	{
+		FScopeLock Lock(&RequestsCriticalSection);
+		UnansweredRequests.Append(MoveTemp(PendingRequests));
+		PendingRequests.Reset();
+		bIsFrameRequested = false;
+	}
+
+	for (const FSentryOnFrameCaptured& OnCaptured : UnansweredRequests)
+	{
+		OnCaptured(false, TArray<FColor>(), FIntPoint::ZeroValue);
+	}
+
+	FScopeLock Lock(&LatestFrameCriticalSection);
+	LatestFrame.Empty();
+	LatestFrameSize = FIntPoint::ZeroValue;
+}
+
+void FSentryBackBufferCapture::SetViewport(FViewport* Viewport, const TSharedPtr<SWindow>& Window)
+{
+	check(IsInGameThread());
+
+	if (!bIsActive || !Viewport)
+	{
+		return;
+	}
+
+	CapturedWindow = Window.Get();
+
+	if (bIncludeUI)
+	{
+		return;
+	}
+
+	// Scene render target is recreated on the render thread on resize, this runs after that
+	ENQUEUE_RENDER_COMMAND(SentryBackBufferCaptureSetViewport)([this, Viewport](FRHICommandListImmediate& RHICmdList)
+	{
+		SceneRenderTarget = Viewport->GetRenderTargetTexture();
+	});
+}
+
+void FSentryBackBufferCapture::RequestFrame(FSentryOnFrameCaptured OnCaptured)
+{
+	FScopeLock Lock(&RequestsCriticalSection);
+
+	PendingRequests.Add(MoveTemp(OnCaptured));
+	bIsFrameRequested = true;
+}
+
+bool FSentryBackBufferCapture::CopyLatestFrame(TArray<FColor>& OutBitmap, FIntPoint& OutSize) const
+{
+	// Crashed thread might be the one holding the lock so waiting for it isn't an option
+	if (!LatestFrameCriticalSection.TryLock())
+	{
+		return false;
+	}
+
+	const bool bHasFrame = LatestFrame.Num() > 0;
+	if (bHasFrame)
+	{
+		OutBitmap.Reset();
+		OutBitmap.Append(LatestFrame);
+		OutSize = LatestFrameSize;
+	}
+
+	LatestFrameCriticalSection.Unlock();
+
+	return bHasFrame;
+}
+
+void FSentryBackBufferCapture::OnBackBufferReadyToPresent(SWindow& Window, const FSentryTextureRHIRef& BackBuffer)
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	check(IsInRenderingThread());
+
+	if (!bIsActive || &Window != CapturedWindow.Load() || !BackBuffer.IsValid())
+	{
+		return;
+	}
+
+	// Readbacks are polled instead of waited for so capturing never stalls the render thread
+	if (Readback.IsValid() && Readback->IsReady() && ReadbackSize != FIntPoint::ZeroValue)
+	{
+		ResolveReadback();
+	}
+
+	if (Readback.IsValid() && !Readback->IsReady())
+	{
+		// Previous frame is still in flight
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (!bIsFrameRequested && Now - LastCaptureTime < RefreshIntervalSeconds)
+	{
+		return;
+	}
+
+	FSentryTextureRHIRef Source = BackBuffer;
+	if (!bIncludeUI)
+	{
+		if (SceneRenderTarget.IsValid() && SceneRenderTarget != BackBuffer)
+		{
+			Source = SceneRenderTarget;
+		}
+		else if (!bHasLoggedMissingSceneRenderTarget)
+		{
+			// Scene is rendered straight into the backbuffer so there's no frame without the UI to read
+			UE_LOG(LogSentrySdk, Log, TEXT("Game viewport has no separate scene render target, screenshots include the UI."));
+			bHasLoggedMissingSceneRenderTarget = true;
+		}
+	}
+
+	const EPixelFormat Format = Source->GetFormat();
+	if (Format != PF_B8G8R8A8 && Format != PF_R8G8B8A8 && Format != PF_A2B10G10R10)
+	{
+		return;
+	}
+
+	if (!Readback.IsValid())
+	{
+		Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("SentryBackBufferCapture"));
+	}
+
+	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+
+	// Redacted widgets are only drawn into the backbuffer, the scene render target never contains them
+	const FIntPoint SourceSize = Source->GetSizeXY();
+	if (Source == BackBuffer)
+	{
+		Source = FSentryRedactedWidgets::Get().Apply(RHICmdList, Window, Source, PrivacyMaskTarget);
+	}
+
+	TArray<FSentryOnFrameCaptured> RefusedRequests;
+	{
+		FScopeLock Lock(&RequestsCriticalSection);
+
+		if (Source.IsValid())
+		{
+			InFlightRequests.Append(MoveTemp(PendingRequests));
+		}
+		else
+		{
+			// Redacted widgets can't be cleared from this frame, so it isn't captured at all
+			RefusedRequests = MoveTemp(PendingRequests);
+		}
+
+		PendingRequests.Reset();
+		bIsFrameRequested = false;
+	}
+
+	for (const FSentryOnFrameCaptured& OnCaptured : RefusedRequests)
+	{
+		OnCaptured(false, TArray<FColor>(), FIntPoint::ZeroValue);
+	}
+
+	LastCaptureTime = Now;
+
+	if (!Source.IsValid())
+	{
+		return;
+	}
+
+	ReadbackSize = SourceSize;
+	ReadbackFormat = Format;
+
+	Readback->EnqueueCopy(RHICmdList, Source);
+#endif
+}
+
+void FSentryBackBufferCapture::ResolveReadback()
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	const FIntPoint Size = ReadbackSize;
+	ReadbackSize = FIntPoint::ZeroValue;
+
+	int32 RowPitchInPixels = 0;
+	const uint8* Data = static_cast<const uint8*>(Readback->Lock(RowPitchInPixels));
+	if (!Data)
+	{
+		Readback->Unlock();
+
+		for (const FSentryOnFrameCaptured& OnCaptured : InFlightRequests)
+		{
+			OnCaptured(false, TArray<FColor>(), FIntPoint::ZeroValue);
+		}
+
+		InFlightRequests.Reset();
+		return;
+	}
+
+	// OpenGL reads rows bottom to top, flipping while converting costs nothing extra
+	bool bFlip = false;
+#if PLATFORM_ANDROID
+	bFlip = GDynamicRHI && FString(GDynamicRHI->GetName()).Contains(TEXT("OpenGL"));
+#endif
+
+	// Reset keeps the allocation from the previous resolve
+	ResolveBuffer.Reset();
+	ResolveBuffer.AddUninitialized(Size.X * Size.Y);
+
+	for (int32 Y = 0; Y < Size.Y; ++Y)
+	{
+		const uint32* SourceRow = reinterpret_cast<const uint32*>(Data) + static_cast<int64>(Y) * RowPitchInPixels;
+		FColor* DestRow = ResolveBuffer.GetData() + static_cast<int64>(bFlip ? Size.Y - 1 - Y : Y) * Size.X;
+
+		switch (ReadbackFormat)
+		{
+		case PF_B8G8R8A8:
+			// Same memory layout as FColor, only the alpha has to be made opaque
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				DestRow[X].DWColor() = SourceRow[X] | 0xFF000000;
+			}
+			break;
+		case PF_R8G8B8A8:
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const uint32 Pixel = SourceRow[X];
+				DestRow[X] = FColor(Pixel & 0xFF, (Pixel >> 8) & 0xFF, (Pixel >> 16) & 0xFF, 255);
+			}
+			break;
+		default:
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const uint32 Pixel = SourceRow[X];
+				DestRow[X] = FColor(((Pixel >> 0) & 0x3FF) >> 2, ((Pixel >> 10) & 0x3FF) >> 2, ((Pixel >> 20) & 0x3FF) >> 2, 255);
+			}
+			break;
+		}
+	}
+
+	Readback->Unlock();
+
+	for (const FSentryOnFrameCaptured& OnCaptured : InFlightRequests)
+	{
+		OnCaptured(true, ResolveBuffer, Size);
+	}
+
+	InFlightRequests.Reset();
+
+	// Swapping hands the new frame over without copying it and keeps both allocations for the next resolves
+	FScopeLock Lock(&LatestFrameCriticalSection);
+	Swap(LatestFrame, ResolveBuffer);
+	LatestFrameSize = Size;
+#endif
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/RingBuffer.h"
+
+#include "SentryDataTypes.h"
+
+/**
+ * Fixed-size breadcrumb buffer that evicts by level instead of by age alone.
+ *
+ * Breadcrumbs are kept in a ring per level. Each level is guaranteed a reserved share of the capacity for its most
+ * recent breadcrumbs; once the buffer is full, the oldest breadcrumb of the lowest level holding more than its share
+ * makes room for the new one. A burst of debug/info breadcrumbs thus only evicts its own kind while the warnings
+ * and errors that explain a crash survive, without raising the total budget. The rings are merged back into
+ * the order the breadcrumbs were added in when iterating.
+ *
+ * Without level-aware retention the buffer behaves like a plain ring that evicts the oldest breadcrumb.
+ */
+template <typename ElementType>
+class TSentryBreadcrumbRetention
+{
+public:
+	/**
+	 * @param InCapacity Max amount of breadcrumbs kept.
+	 * @param bInByLevel Whether to evict by level, plain FIFO when false.
+	 * @param ReservedPercent Share of the capacity reserved for the most recent breadcrumbs of each level.
+	 */
+	void Configure(int32 InCapacity, bool bInByLevel, int32 ReservedPercent)
+	{
+		Capacity = FMath::Max(0, InCapacity);
+		bByLevel = bInByLevel;
+		Reserved = Capacity * FMath::Clamp(ReservedPercent, 0, 100 / NumLevels) / 100;
+
+		while (NumElements > Capacity)
+		{
+			Evict(PickEvictedLevel(INDEX_NONE));
+		}
+	}
+
+	void Add(ElementType Element, ESentryLevel Level)
+	{
+		if (Capacity == 0)
+		{
+			return;
+		}
+
+		const int32 LevelIndex = bByLevel ? FMath::Clamp(static_cast<int32>(Level), 0, NumLevels - 1) : 0;
+
+		if (NumElements >= Capacity)
+		{
+			const int32 EvictedLevel = PickEvictedLevel(LevelIndex);
+
+			// The new breadcrumb is the lowest priority one, it's dropped rather than evicting something more important
+			if (EvictedLevel == LevelIndex && Rings[LevelIndex].Num() == 0)
+			{
+				return;
+			}
+
+			Evict(EvictedLevel);
+		}
+
+		Rings[LevelIndex].Add(FEntry { NextSequence++, MoveTemp(Element) });
+		++NumElements;
+	}
+
+	void Empty()
+	{
+		for (TRingBuffer<FEntry>& Ring : Rings)
+		{
+			Ring.Empty();
+		}
+
+		NumElements = 0;
+	}
+
+	int32 Num() const { return NumElements; }
+
+	/** Calls the visitor for each breadcrumb in the order they were added in, oldest first. */
+	template <typename VisitorType>
+	void ForEach(VisitorType&& Visitor) const
+	{
+		int32 Positions[NumLevels] = {};
+
+		for (int32 Visited = 0; Visited < NumElements; ++Visited)
+		{
+			int32 NextLevel = INDEX_NONE;
+			for (int32 LevelIndex = 0; LevelIndex < NumLevels; ++LevelIndex)
+			{
+				const TRingBuffer<FEntry>& Ring = Rings[LevelIndex];
+				if (Positions[LevelIndex] < Ring.Num() && (NextLevel == INDEX_NONE || Ring[Positions[LevelIndex]].Sequence < Rings[NextLevel][Positions[NextLevel]].Sequence))
+				{
+					NextLevel = LevelIndex;
+				}
+			}
+
+			Visitor(Rings[NextLevel][Positions[NextLevel]++].Element);
+		}
+	}
+
+private:
+	static constexpr int32 NumLevels = static_cast<int32>(ESentryLevel::Fatal) + 1;
+
+	struct FEntry
+	{
+		uint64 Sequence;
+		ElementType Element;
+	};
+
+	/** Picks the level to evict from, counting an incoming breadcrumb of the given level as already added. */
+	int32 PickEvictedLevel(int32 IncomingLevel) const
+	{
+		for (int32 LevelIndex = 0; LevelIndex < NumLevels; ++LevelIndex)
+		{
+			const int32 Count = Rings[LevelIndex].Num() + (LevelIndex == IncomingLevel ? 1 : 0);
+			if (Count > Reserved)
+			{
+				return LevelIndex;
+			}
+		}
+
+		// Every level is within its reserved share, the least important one yields
+		for (int32 LevelIndex = 0; LevelIndex < NumLevels; ++LevelIndex)
+		{
+			if (Rings[LevelIndex].Num() > 0)
+			{
+				return LevelIndex;
+			}
+		}
+
+		return IncomingLevel;
+	}
+
+	void Evict(int32 LevelIndex)
+	{
+		if (Rings[LevelIndex].Num() > 0)
+		{
+			Rings[LevelIndex].PopFront();
+			--NumElements;
+		}
+	}
+
+	TRingBuffer<FEntry> Rings[NumLevels];
+
+	int32 NumElements = 0;
+	int32 Capacity = 0;
+	int32 Reserved = 0;
+	bool bByLevel = true;
+
+	uint64 NextSequence = 0;
+};
@@ -0,0 +1,23 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryCaptureCadence.h"
+
+void FSentryCaptureCadence::Reset(float FramesPerSecond)
+{
+	Interval = 1.0 / FMath::Max(0.01f, FramesPerSecond);
+	NextCaptureTime = 0.0;
+	NumDropped = 0;
+}
+
+bool FSentryCaptureCadence::ShouldCapture(double PresentTime)
+{
+	if (PresentTime < NextCaptureTime)
+	{
+		return false;
+	}
+
+	// Grid restarts after a hitch instead of capturing a burst of frames to catch up
+	NextCaptureTime = PresentTime - NextCaptureTime < Interval ? NextCaptureTime + Interval : PresentTime + Interval;
+
+	return true;
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCommandQueue.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryCommandQueue
+{
+	/** Max number of commands run in one batch before the worker checks whether it should stop. */
+	static constexpr int32 BatchSize = 256;
+
+	/** Max time the worker sleeps if it missed a wake up. */
+	static constexpr uint32 WaitIntervalMs = 100;
+}
+
+FSentryCommandQueue::FSentryCommandQueue(int32 InCapacity, EThreadPriority InThreadPriority, uint64 InThreadAffinityMask)
+	: Capacity(FMath::Max(1, InCapacity))
+	, ConsumerThreadId(0)
+{
+	WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("SentryCommandQueue"), 0, InThreadPriority, InThreadAffinityMask);
+}
+
+FSentryCommandQueue::~FSentryCommandQueue()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	// Run whatever was enqueued after the worker stopped
+	Flush();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+	WakeUpEvent = nullptr;
+}
+
+void FSentryCommandQueue::Enqueue(FCommand&& Command, bool bIsCrashSafe)
+{
+	if (NumQueued.Increment() > Capacity)
+	{
+		NumQueued.Decrement();
+
+		// Commands queued before this one have to run first
+		FScopeLock Lock(&ConsumerCriticalSection);
+		ConsumerThreadId = FPlatformTLS::GetCurrentThreadId();
+
+		Drain(MAX_int32);
+		Command();
+
+		ConsumerThreadId = 0;
+		return;
+	}
+
+	Queue.Enqueue({ MoveTemp(Command), bIsCrashSafe });
+
+	// Worker drains everything once woken up, so only the first command after it went idle has to wake it
+	if (NumQueued.GetValue() == 1)
+	{
+		WakeUpEvent->Trigger();
+	}
+}
+
+void FSentryCommandQueue::Flush()
+{
+	FScopeLock Lock(&ConsumerCriticalSection);
+	ConsumerThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	while (Drain(MAX_int32) > 0)
+	{
+	}
+
+	ConsumerThreadId = 0;
+}
+
+bool FSentryCommandQueue::TryFlushOnCrash()
+{
+	// A command that crashed must not be run again
+	if (IsRunningCommands() || !ConsumerCriticalSection.TryLock())
+	{
+		return false;
+	}
+
+	ConsumerThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	// Building and sending events from the crashing thread could take the locks held by the crashed code
+	while (Drain(MAX_int32, true) > 0)
+	{
+	}
+
+	ConsumerThreadId = 0;
+
+	ConsumerCriticalSection.Unlock();
+	return true;
+}
+
+bool FSentryCommandQueue::IsRunningCommands() const
+{
+	return ConsumerThreadId.Load() == FPlatformTLS::GetCurrentThreadId();
+}
+
+uint32 FSentryCommandQueue::Run()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	while (StopRequested.GetValue() == 0)
+	{
+		WakeUpEvent->Wait(SentryCommandQueue::WaitIntervalMs);
+
+		while (StopRequested.GetValue() == 0)
+		{
+			FScopeLock Lock(&ConsumerCriticalSection);
+			ConsumerThreadId = FPlatformTLS::GetCurrentThreadId();
+
+			const int32 NumRun = Drain(SentryCommandQueue::BatchSize);
+
+			ConsumerThreadId = 0;
+
+			if (NumRun < SentryCommandQueue::BatchSize)
+			{
+				break;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void FSentryCommandQueue::Stop()
+{
+	StopRequested.Set(1);
+	WakeUpEvent->Trigger();
+}
+
+int32 FSentryCommandQueue::Drain(int32 MaxCommands, bool bCrashSafeOnly)
+{
+	int32 NumRun = 0;
+
+	FQueuedCommand QueuedCommand;
+	while (NumRun < MaxCommands && Queue.Dequeue(QueuedCommand))
+	{
+		// Decremented after the command ran so that calls enqueued in the meantime don't wake the worker needlessly
+		if (!bCrashSafeOnly || QueuedCommand.bIsCrashSafe)
+		{
+			QueuedCommand.Command();
+		}
+		QueuedCommand.Command = nullptr;
+
+		NumQueued.Decrement();
+		++NumRun;
+	}
+
+	return NumRun;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/PlatformAffinity.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Atomic.h"
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Bounded multi-producer single-consumer queue executing platform SDK calls on a dedicated thread.
+ *
+ * Callers only record the call with its arguments and push it into a lock-free queue, so they never wait for the locks
+ * of the platform SDK or attach to the JVM. Commands run in the order they were enqueued. Once the queue is full the
+ * caller drains it and runs the command itself to keep the order instead of dropping calls.
+ *
+ * Commands are marked as crash-safe when they only change state kept by the platform SDK (scope, breadcrumbs), which
+ * is all the crash handler replays. Anything else, like building and sending an event, is dropped at crash time.
+ */
+class FSentryCommandQueue : public FRunnable
+{
+public:
+	using FCommand = TFunction<void()>;
+
+	FSentryCommandQueue(int32 InCapacity, EThreadPriority InThreadPriority = TPri_BelowNormal, uint64 InThreadAffinityMask = FPlatformAffinity::GetNoAffinityMask());
+	virtual ~FSentryCommandQueue() override;
+
+	/** Pushes the command into the queue. Safe to call from any thread. */
+	void Enqueue(FCommand&& Command, bool bIsCrashSafe = true);
+
+	/** Runs all queued commands on the calling thread. */
+	void Flush();
+
+	/**
+	 * Runs the queued crash-safe commands on the calling thread and drops the others, unless another thread is running
+	 * commands at the moment. Meant for the crash handler which must not wait on a thread that may never resume.
+	 * Returns whether the queue was flushed.
+	 */
+	bool TryFlushOnCrash();
+
+	/** Checks whether the calling thread is running queued commands, in which case calls shouldn't be queued again. */
+	bool IsRunningCommands() const;
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+private:
+	struct FQueuedCommand
+	{
+		FCommand Command;
+		bool bIsCrashSafe = true;
+	};
+
+	/**
+	 * Runs up to the given amount of queued commands, skipping the ones that aren't crash-safe if requested.
+	 * Returns the number of commands that were dequeued.
+	 */
+	int32 Drain(int32 MaxCommands, bool bCrashSafeOnly = false);
+
+	TQueue<FQueuedCommand, EQueueMode::Mpsc> Queue;
+
+	const int32 Capacity;
+
+	FThreadSafeCounter NumQueued;
+
+	/** Guards the consumer side of the queue which can be drained by both the worker thread and the callers. */
+	FCriticalSection ConsumerCriticalSection;
+
+	/** ID of the thread holding the consumer lock, 0 if none. */
+	TAtomic<uint32> ConsumerThreadId;
+
+	FEvent* WakeUpEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+
+	FThreadSafeCounter StopRequested;
+};
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryContextCache.h"
+
+#include "GenericPlatform/GenericPlatformDriver.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RHI.h"
+
+namespace SentryContextCacheFormat
+{
+	static const TCHAR* GpuSection = TEXT("gpu");
+	static const TCHAR* DeviceSection = TEXT("device");
+	static const TCHAR* Separator = TEXT("\t");
+
+	static FString Sanitize(const FString& Value)
+	{
+		return Value.Replace(TEXT("\t"), TEXT(" ")).Replace(TEXT("\r"), TEXT(" ")).Replace(TEXT("\n"), TEXT(" "));
+	}
+
+	static void AppendSection(FString& Output, const TCHAR* Section, const TMap<FString, FString>& Values)
+	{
+		for (const TPair<FString, FString>& Value : Values)
+		{
+			Output += FString::Printf(TEXT("%s%s%s%s%s\n"), Section, Separator, *Sanitize(Value.Key), Separator, *Sanitize(Value.Value));
+		}
+	}
+}
+
+FString SentryContextCache::GetFingerprint()
+{
+	const FPlatformMemoryConstants& MemoryConstants = FPlatformMemory::GetConstants();
+
+	// Driver version is already known to the RHI by the time Sentry is initialized, so it's free to read here
+	return SentryContextCacheFormat::Sanitize(FString::Printf(TEXT("%s|%s|%s|%d|%d|%u"),
+		*FPlatformMisc::GetOSVersion(),
+		*FPlatformMisc::GetPrimaryGPUBrand(),
+		*GRHIAdapterUserDriverVersion,
+		FPlatformMisc::NumberOfCores(),
+		FPlatformMisc::NumberOfCoresIncludingHyperthreads(),
+		MemoryConstants.TotalPhysicalGB));
+}
+
+FSentryHardwareContexts SentryContextCache::Probe()
+{
+	FSentryHardwareContexts Contexts;
+
+	FGPUDriverInfo GpuDriverInfo = FPlatformMisc::GetGPUDriverInfo(FPlatformMisc::GetPrimaryGPUBrand());
+
+	if (GpuDriverInfo.IsValid())
+	{
+		Contexts.Gpu.Add(TEXT("name"), GpuDriverInfo.DeviceDescription);
+		Contexts.Gpu.Add(TEXT("vendor_name"), GpuDriverInfo.ProviderName);
+		Contexts.Gpu.Add(TEXT("driver_version"), GpuDriverInfo.UserDriverVersion);
+	}
+
+	const FPlatformMemoryConstants& MemoryConstants = FPlatformMemory::GetConstants();
+
+	Contexts.Device.Add(TEXT("cpu_description"), FPlatformMisc::GetCPUBrand());
+	Contexts.Device.Add(TEXT("number_of_cores"), FString::FromInt(FPlatformMisc::NumberOfCores()));
+	Contexts.Device.Add(TEXT("number_of_cores_including_hyperthreads"), FString::FromInt(FPlatformMisc::NumberOfCoresIncludingHyperthreads()));
+	Contexts.Device.Add(TEXT("physical_memory_size_gb"), FString::FromInt(MemoryConstants.TotalPhysicalGB));
+
+	return Contexts;
+}
+
+bool SentryContextCache::Load(const FString& Path, const FString& Fingerprint, FSentryHardwareContexts& OutContexts)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path) || Lines.Num() < 1 || Lines[0] != Fingerprint)
+	{
+		return false;
+	}
+
+	FSentryHardwareContexts Contexts;
+
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Fields;
+		Lines[LineIndex].ParseIntoArray(Fields, SentryContextCacheFormat::Separator, false);
+
+		if (Fields.Num() != 3)
+		{
+			return false;
+		}
+
+		if (Fields[0] == SentryContextCacheFormat::GpuSection)
+		{
+			Contexts.Gpu.Add(Fields[1], Fields[2]);
+		}
+		else if (Fields[0] == SentryContextCacheFormat::DeviceSection)
+		{
+			Contexts.Device.Add(Fields[1], Fields[2]);
+		}
+	}
+
+	OutContexts = MoveTemp(Contexts);
+	return true;
+}
+
+bool SentryContextCache::Save(const FString& Path, const FString& Fingerprint, const FSentryHardwareContexts& Contexts)
+{
+	FString Output = Fingerprint + TEXT("\n");
+	SentryContextCacheFormat::AppendSection(Output, SentryContextCacheFormat::GpuSection, Contexts.Gpu);
+	SentryContextCacheFormat::AppendSection(Output, SentryContextCacheFormat::DeviceSection, Contexts.Device);
+
+	return FFileHelper::SaveStringToFile(Output, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString SentryContextCache::GetCachePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryContextCache.txt"));
+}
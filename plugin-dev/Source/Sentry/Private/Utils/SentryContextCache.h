@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** GPU and device context values that are expensive to probe. */
+struct FSentryHardwareContexts
+{
+	TMap<FString, FString> Gpu;
+	TMap<FString, FString> Device;
+
+	bool operator==(const FSentryHardwareContexts& Other) const
+	{
+		return Gpu.OrderIndependentCompareEqual(Other.Gpu) && Device.OrderIndependentCompareEqual(Other.Device);
+	}
+
+	bool operator!=(const FSentryHardwareContexts& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/**
+ * Persists hardware contexts between launches so that driver and CPU queries can be moved off the startup path.
+ * Cached values are keyed by a fingerprint of cheap-to-query hardware, OS and driver properties.
+ */
+class SentryContextCache
+{
+public:
+	/** Gets the fingerprint of the current hardware, contexts cached for a different one are discarded. */
+	static FString GetFingerprint();
+
+	/** Queries hardware contexts from the platform. Can be slow, e.g. GPU driver info is read from the registry on Windows. */
+	static FSentryHardwareContexts Probe();
+
+	/** Loads the cached contexts, returns false if there are none or they were cached for a different fingerprint. */
+	static bool Load(const FString& Path, const FString& Fingerprint, FSentryHardwareContexts& OutContexts);
+
+	/** Saves the contexts for the given fingerprint. */
+	static bool Save(const FString& Path, const FString& Fingerprint, const FSentryHardwareContexts& Contexts);
+
+	/** Gets the default cache location. */
+	static FString GetCachePath();
+};
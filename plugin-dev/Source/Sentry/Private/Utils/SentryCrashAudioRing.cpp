@@ -0,0 +1,209 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Utils/SentryCrashAudioRing.h"
+
+#include "SentryDefines.h"
+#include "Utils/SentryMemoryAccounting.h"
+#include "Utils/SentryStats.h"
+
+#include "Audio.h"
+#include "AudioDevice.h"
+#include "AudioDeviceManager.h"
+#include "Engine/Engine.h"
+#include "HAL/CriticalSection.h"
+#include "ISubmixBufferListener.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+/** Receives mixed buffers of the main submix on the audio render thread and stores them in the ring. */
+class FSentryCrashAudioListener : public ISubmixBufferListener
+{
+public:
+	explicit FSentryCrashAudioListener(int32 InCapacity)
+	{
+		Samples.SetNumZeroed(FMath::Max(1, InCapacity));
+	}
+
+	virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 InSampleRate, double AudioClock) override
+	{
+		if (!AudioData || NumChannels <= 0 || InSampleRate <= 0)
+		{
+			return;
+		}
+
+		const int32 NumFrames = NumSamples / NumChannels;
+		const double Step = static_cast<double>(FSentryCrashAudioRing::SampleRate) / InSampleRate;
+
+		FScopeLock Lock(&CriticalSection);
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			float Mono = 0.0f;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				Mono += AudioData[Frame * NumChannels + Channel];
+			}
+
+			// Averaging the frames that fall into one output sample is enough of a low-pass filter for context audio
+			Accumulator += Mono / NumChannels;
+			++NumAccumulated;
+
+			Phase += Step;
+			if (Phase < 1.0)
+			{
+				continue;
+			}
+
+			Phase -= 1.0;
+
+			const float Value = FMath::Clamp(Accumulator / NumAccumulated, -1.0f, 1.0f);
+			Samples[WriteIndex] = static_cast<int16>(Value * MAX_int16);
+
+			WriteIndex = (WriteIndex + 1) % Samples.Num();
+			bIsFull |= WriteIndex == 0;
+
+			Accumulator = 0.0f;
+			NumAccumulated = 0;
+		}
+	}
+
+#if !UE_VERSION_OLDER_THAN(5, 4, 0)
+	virtual const FString& GetListenerName() const override
+	{
+		static const FString ListenerName(TEXT("SentryCrashAudioRing"));
+		return ListenerName;
+	}
+#endif
+
+	/** Copies the ring content ordered from the oldest to the newest sample unless the audio thread holds the lock. */
+	bool TryCopySamples(TArray<int16>& OutSamples)
+	{
+		if (!CriticalSection.TryLock())
+		{
+			return false;
+		}
+
+		if (bIsFull)
+		{
+			OutSamples.Append(Samples.GetData() + WriteIndex, Samples.Num() - WriteIndex);
+		}
+
+		OutSamples.Append(Samples.GetData(), WriteIndex);
+
+		CriticalSection.Unlock();
+
+		return true;
+	}
+
+private:
+	FCriticalSection CriticalSection;
+
+	TArray<int16> Samples;
+	int32 WriteIndex = 0;
+	bool bIsFull = false;
+
+	// Downsampling state carried over between buffers
+	float Accumulator = 0.0f;
+	int32 NumAccumulated = 0;
+	double Phase = 0.0;
+};
+
+FSentryCrashAudioRing& FSentryCrashAudioRing::Get()
+{
+	static FSentryCrashAudioRing Instance;
+	return Instance;
+}
+
+bool FSentryCrashAudioRing::Start(float Seconds)
+{
+	check(IsInGameThread());
+
+	FAudioDeviceHandle AudioDevice = GEngine ? GEngine->GetMainAudioDevice() : FAudioDeviceHandle();
+
+	const int32 NumSamples = FMath::Max(1, FMath::CeilToInt(Seconds * SampleRate));
+	if (IsActive() && AudioDevice.IsValid() && AudioDevice.GetDeviceID() == AudioDeviceId && NumSamples == Capacity)
+	{
+		return true;
+	}
+
+	if (IsActive())
+	{
+		Stop();
+	}
+
+	if (!AudioDevice.IsValid())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Audio device required for crash audio capturing is not available."));
+		return false;
+	}
+
+	Listener = MakeShared<FSentryCrashAudioListener, ESPMode::ThreadSafe>(NumSamples);
+	AudioDeviceId = AudioDevice.GetDeviceID();
+	Capacity = NumSamples;
+
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	AudioDevice->RegisterSubmixBufferListener(Listener.Get(), nullptr);
+#else
+	AudioDevice->RegisterSubmixBufferListener(Listener.ToSharedRef(), AudioDevice->GetMainSubmixObject());
+#endif
+
+	SET_MEMORY_STAT(STAT_SentryAudioRingMemory, NumSamples * sizeof(int16));
+	SentryMemoryAccounting::SetCrashAudioBytes(NumSamples * sizeof(int16));
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash audio ring enabled: %.1f seconds at %d Hz (%.1f MB)."), Seconds, SampleRate, Seconds * SampleRate * sizeof(int16) / (1024.0f * 1024.0f));
+
+	return true;
+}
+
+void FSentryCrashAudioRing::Stop()
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	FAudioDeviceManager* AudioDeviceManager = GEngine ? GEngine->GetAudioDeviceManager() : nullptr;
+	FAudioDevice* AudioDevice = AudioDeviceManager ? AudioDeviceManager->GetAudioDeviceRaw(AudioDeviceId) : nullptr;
+	if (AudioDevice)
+	{
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+		AudioDevice->UnregisterSubmixBufferListener(Listener.Get(), nullptr);
+#else
+		AudioDevice->UnregisterSubmixBufferListener(Listener.ToSharedRef(), AudioDevice->GetMainSubmixObject());
+#endif
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	// Audio device only holds a raw pointer and unregisters it asynchronously so the listener has to outlive this call
+	RetiredListener = MoveTemp(Listener);
+#else
+	// Audio thread might still be inside the callback, shared ownership keeps the listener alive until it's done
+	Listener.Reset();
+#endif
+	AudioDeviceId = 0;
+	Capacity = 0;
+
+	SET_MEMORY_STAT(STAT_SentryAudioRingMemory, 0);
+	SentryMemoryAccounting::SetCrashAudioBytes(0);
+}
+
+bool FSentryCrashAudioRing::WriteWaveFile(const FString& Path) const
+{
+	TSharedPtr<FSentryCrashAudioListener, ESPMode::ThreadSafe> ActiveListener = Listener;
+	if (!ActiveListener.IsValid())
+	{
+		return false;
+	}
+
+	TArray<int16> Samples;
+	if (!ActiveListener->TryCopySamples(Samples) || Samples.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<uint8> WaveFile;
+	SerializeWaveFile(WaveFile, reinterpret_cast<const uint8*>(Samples.GetData()), Samples.Num() * sizeof(int16), 1, SampleRate);
+
+	return FFileHelper::SaveArrayToFile(WaveFile, *Path);
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCrashMemoryRegions.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryCrashMemoryRegions
+{
+	static constexpr ANSICHAR Magic[8] = { 'S', 'N', 'T', 'R', 'Y', 'M', 'E', 'M' };
+	static constexpr uint32 Version = 1;
+
+	static constexpr int32 DefaultMaxTotalSize = 256 * 1024;
+
+	template <typename T>
+	static bool WriteValue(IFileHandle& File, T Value)
+	{
+		return File.Write(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+}
+
+FSentryCrashMemoryRegions::FSentryCrashMemoryRegions()
+	: NumRegions(0)
+	, MaxTotalSize(SentryCrashMemoryRegions::DefaultMaxTotalSize)
+{
+}
+
+FSentryCrashMemoryRegions& FSentryCrashMemoryRegions::Get()
+{
+	static FSentryCrashMemoryRegions Instance;
+	return Instance;
+}
+
+int32 FSentryCrashMemoryRegions::Register(const FString& Name, const void* Address, int32 Size)
+{
+	if (!Address || Size <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	FScopeLock Lock(&RegistrationLock);
+
+	const int32 ClampedSize = FMath::Min(Size, MaxTotalSize - TotalSize);
+	if (ClampedSize <= 0)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Crash memory region %s wasn't registered, the %d bytes budget is exhausted."), *Name, MaxTotalSize);
+		return INDEX_NONE;
+	}
+
+	for (int32 Handle = 0; Handle < MaxRegions; ++Handle)
+	{
+		FRegion& Region = Regions[Handle];
+		if (Region.bIsRegistered)
+		{
+			continue;
+		}
+
+		const FTCHARToUTF8 NameUtf8(*Name);
+		Region.NameLength = FMath::Min(NameUtf8.Length(), static_cast<int32>(UE_ARRAY_COUNT(Region.Name)));
+		FMemory::Memcpy(Region.Name, NameUtf8.Get(), Region.NameLength);
+		Region.Address = Address;
+		Region.Size = ClampedSize;
+		Region.bIsRegistered = true;
+
+		TotalSize += ClampedSize;
+		++NumRegions;
+
+		if (ClampedSize < Size)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Crash memory region %s was truncated to %d bytes to fit the budget."), *Name, ClampedSize);
+		}
+
+		return Handle;
+	}
+
+	UE_LOG(LogSentrySdk, Warning, TEXT("Crash memory region %s wasn't registered, all %d slots are taken."), *Name, MaxRegions);
+	return INDEX_NONE;
+}
+
+void FSentryCrashMemoryRegions::Unregister(int32 Handle)
+{
+	if (Handle < 0 || Handle >= MaxRegions)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&RegistrationLock);
+
+	FRegion& Region = Regions[Handle];
+	if (!Region.bIsRegistered)
+	{
+		return;
+	}
+
+	Region.bIsRegistered = false;
+
+	TotalSize -= Region.Size;
+	--NumRegions;
+}
+
+void FSentryCrashMemoryRegions::SetMaxTotalSize(int32 InMaxTotalSize)
+{
+	FScopeLock Lock(&RegistrationLock);
+
+	// Already registered regions are kept, the new budget only applies to the ones registered from now on
+	MaxTotalSize = FMath::Max(0, InMaxTotalSize);
+}
+
+bool FSentryCrashMemoryRegions::Write(const FString& Path) const
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+	TUniquePtr<IFileHandle> File(PlatformFile.OpenWrite(*Path));
+	if (!File)
+	{
+		return false;
+	}
+
+	const FRegion* RegisteredRegions[MaxRegions];
+	uint32 NumRegisteredRegions = 0;
+
+	for (const FRegion& Region : Regions)
+	{
+		if (Region.bIsRegistered)
+		{
+			RegisteredRegions[NumRegisteredRegions++] = &Region;
+		}
+	}
+
+	bool bSuccess = File->Write(reinterpret_cast<const uint8*>(SentryCrashMemoryRegions::Magic), sizeof(SentryCrashMemoryRegions::Magic))
+		&& SentryCrashMemoryRegions::WriteValue(*File, SentryCrashMemoryRegions::Version)
+		&& SentryCrashMemoryRegions::WriteValue(*File, NumRegisteredRegions);
+
+	for (uint32 Index = 0; bSuccess && Index < NumRegisteredRegions; ++Index)
+	{
+		const FRegion& Region = *RegisteredRegions[Index];
+
+		bSuccess = SentryCrashMemoryRegions::WriteValue(*File, static_cast<uint32>(Region.NameLength))
+			&& File->Write(reinterpret_cast<const uint8*>(Region.Name), Region.NameLength)
+			&& SentryCrashMemoryRegions::WriteValue(*File, static_cast<uint64>(reinterpret_cast<UPTRINT>(Region.Address)))
+			&& SentryCrashMemoryRegions::WriteValue(*File, static_cast<uint32>(Region.Size))
+			&& File->Write(static_cast<const uint8*>(Region.Address), Region.Size);
+	}
+
+	return bSuccess;
+}
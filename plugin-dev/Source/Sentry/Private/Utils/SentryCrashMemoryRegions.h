@@ -0,0 +1,76 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Registry of small memory regions dumped alongside crash reports, e.g. the current game state struct, recent
+ * network packets or allocator stats.
+ *
+ * Regions are registered by address so their contents aren't copied until a crash happens, at which point they're
+ * written straight from memory into a single binary attachment. Owners must unregister a region before freeing it.
+ *
+ * File layout, all integers little-endian: "SNTRYMEM" magic, uint32 version, uint32 region count, then for each
+ * region a uint32 name length, the UTF-8 name, uint64 address, uint32 size and the region bytes.
+ */
+class FSentryCrashMemoryRegions
+{
+public:
+	static constexpr int32 MaxRegions = 32;
+
+	static FSentryCrashMemoryRegions& Get();
+
+	/**
+	 * Registers a region to be dumped on crash. Size is clamped to the remaining budget.
+	 *
+	 * @return Handle to unregister the region with, INDEX_NONE if all slots are taken or the budget is exhausted.
+	 */
+	int32 Register(const FString& Name, const void* Address, int32 Size);
+
+	/** Stops dumping the region, has to be called before its memory is freed. */
+	void Unregister(int32 Handle);
+
+	/** Limits the total size of the dumped regions. */
+	void SetMaxTotalSize(int32 InMaxTotalSize);
+
+	/** Checks whether any region is registered. */
+	bool HasRegions() const { return NumRegions.Load() > 0; }
+
+	/**
+	 * Writes the registered regions to the file. Doesn't lock and streams the regions without copying them so that it can be used from the crash handler.
+	 *
+	 * @return True if the file was written.
+	 */
+	bool Write(const FString& Path) const;
+
+private:
+	struct FRegion
+	{
+		ANSICHAR Name[64];
+		int32 NameLength = 0;
+		const void* Address = nullptr;
+		int32 Size = 0;
+
+		/** Published last so that the crash handler never sees a partially registered region. */
+		TAtomic<bool> bIsRegistered;
+
+		FRegion()
+			: bIsRegistered(false)
+		{
+		}
+	};
+
+	FSentryCrashMemoryRegions();
+
+	FRegion Regions[MaxRegions];
+
+	TAtomic<int32> NumRegions;
+
+	int32 TotalSize = 0;
+	int32 MaxTotalSize;
+
+	FCriticalSection RegistrationLock;
+};
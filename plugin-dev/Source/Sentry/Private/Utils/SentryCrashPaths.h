@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Full paths of the files written by the crash handler.
+ *
+ * Resolved once when the SDK is initialized so that the crash handler doesn't have to query the clock,
+ * join paths or convert them to absolute ones in a crashing process.
+ */
+struct FSentryCrashPaths
+{
+	/** Screenshot of the last frame, named after the session start since there is only one per session. */
+	FString ScreenshotPath;
+	FString ScreenshotFilename;
+	FString ScreenshotContentType;
+
+	/** Directory the crash video files are written to. */
+	FString CrashVideoDir;
+
+	/** Clip encoded from the in-memory recording of the video recorder, empty if the SentryVideo module isn't loaded. */
+	FString CrashVideoClipPath;
+
+	FString CrashVideoTimelinePath;
+	FString CrashAudioPath;
+	FString CrashFrameStripPath;
+	FString CrashMemoryRegionsPath;
+};
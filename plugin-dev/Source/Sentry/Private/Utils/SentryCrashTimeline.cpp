@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCrashTimeline.h"
+
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+
+FSentryCrashTimeline::FSentryCrashTimeline(const FString& InFilePath)
+	: FilePath(InFilePath)
+	, NumStages(0)
+	, StartSeconds(0.0)
+	, StartUnixMilliseconds(0.0)
+{
+}
+
+void FSentryCrashTimeline::Begin()
+{
+	NumStages = 0;
+	StartSeconds = FPlatformTime::Seconds();
+	StartUnixMilliseconds = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+}
+
+void FSentryCrashTimeline::MarkStage(const TCHAR* Name)
+{
+	if (NumStages >= MaxStages)
+	{
+		return;
+	}
+
+	Stages[NumStages].Name = Name;
+	Stages[NumStages].EndSeconds = FPlatformTime::Seconds();
+	NumStages++;
+}
+
+bool FSentryCrashTimeline::Write(const FString& EventId, const FString& DatabasePath) const
+{
+	const double EndSeconds = FPlatformTime::Seconds();
+
+	FString StagesJson;
+
+	double StageStartSeconds = StartSeconds;
+	for (int32 i = 0; i < NumStages; ++i)
+	{
+		StagesJson += FString::Printf(TEXT("%s{\"name\":\"%s\",\"start_ms\":%.3f,\"duration_ms\":%.3f}"),
+			i > 0 ? TEXT(",") : TEXT(""), Stages[i].Name,
+			(StageStartSeconds - StartSeconds) * 1000.0, (Stages[i].EndSeconds - StageStartSeconds) * 1000.0);
+
+		StageStartSeconds = Stages[i].EndSeconds;
+	}
+
+	const FString Json = FString::Printf(TEXT("{\"event_id\":\"%s\",\"platform\":\"%s\",\"handler_start_unix_ms\":%.3f,\"handler_total_ms\":%.3f,\"database_path\":\"%s\",\"stages\":[%s]}"),
+		*EventId, ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()), StartUnixMilliseconds, (EndSeconds - StartSeconds) * 1000.0,
+		*DatabasePath.ReplaceCharWithEscapedChar(), *StagesJson);
+
+	return FFileHelper::SaveStringToFile(Json, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Records how long each stage of the crash handler takes and writes the timings to a side file.
+ *
+ * Used to measure how close the handler gets to the crash backend timeouts. Stage storage is preallocated
+ * so recording doesn't allocate, only writing the file at the end of the handler does.
+ */
+class FSentryCrashTimeline
+{
+public:
+	explicit FSentryCrashTimeline(const FString& InFilePath);
+
+	/** Starts a new timeline, called when the crash handler is entered. */
+	void Begin();
+
+	/** Records the stage that has just finished. Name has to be a string literal. */
+	void MarkStage(const TCHAR* Name);
+
+	/**
+	 * Writes the recorded stages as JSON. Wall clock time of entering the handler is included so that
+	 * the time it took the backend to write the minidump can be derived from the dump file's modification time.
+	 */
+	bool Write(const FString& EventId, const FString& DatabasePath) const;
+
+	const FString& GetFilePath() const { return FilePath; }
+
+private:
+	static constexpr int32 MaxStages = 16;
+
+	struct FStage
+	{
+		const TCHAR* Name;
+		double EndSeconds;
+	};
+
+	FString FilePath;
+
+	FStage Stages[MaxStages];
+	int32 NumStages;
+
+	double StartSeconds;
+	double StartUnixMilliseconds;
+};
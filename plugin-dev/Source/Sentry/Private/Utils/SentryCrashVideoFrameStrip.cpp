@@ -0,0 +1,302 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Utils/SentryCrashVideoFrameStrip.h"
+
+#include "SentryDefines.h"
+#include "Utils/SentryRedactedWidgets.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+
+FSentryCrashVideoFrameStrip& FSentryCrashVideoFrameStrip::Get()
+{
+	static FSentryCrashVideoFrameStrip Instance;
+	return Instance;
+}
+
+bool FSentryCrashVideoFrameStrip::Start(const FSentryFrameStripConfig& InConfig)
+{
+	check(IsInGameThread());
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	UE_LOG(LogSentrySdk, Warning, TEXT("Crash frame strip requires Unreal Engine 5.0 or newer."));
+	return false;
+#else
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	if (!FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Slate renderer required for crash frame strip capturing is not available."));
+		return false;
+	}
+
+	if (!GEngine || !GEngine->GameViewport || !GEngine->GameViewport->GetWindow().IsValid())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Game viewport window required for crash frame strip capturing is not available."));
+		return false;
+	}
+
+	// Image wrapper module has to be loaded on the game thread before encoding on background threads
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	Config = InConfig;
+	Config.FrameWidth = FMath::Clamp(Config.FrameWidth, 16, 1280);
+	Config.FrameHeight = FMath::Clamp(Config.FrameHeight, 16, 720);
+	Config.FramesPerSecond = FMath::Clamp(Config.FramesPerSecond, 0.1f, 10.0f);
+	Config.MaxFrames = FMath::Clamp(Config.MaxFrames, 1, 64);
+
+	{
+		FScopeLock Lock(&FramesCriticalSection);
+		Frames.Empty(Config.MaxFrames);
+		SpriteSheet.Empty();
+	}
+
+	CapturedWindow = GEngine->GameViewport->GetWindow().Get();
+	CaptureCadence.Reset(Config.FramesPerSecond);
+
+	bIsActive = true;
+
+	OnBackBufferReadyHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddRaw(this, &FSentryCrashVideoFrameStrip::OnBackBufferReadyToPresent);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash frame strip enabled: %dx%d at %.1f FPS, %d frames."), Config.FrameWidth, Config.FrameHeight, Config.FramesPerSecond, Config.MaxFrames);
+
+	return true;
+#endif
+}
+
+void FSentryCrashVideoFrameStrip::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(OnBackBufferReadyHandle);
+	}
+
+	OnBackBufferReadyHandle.Reset();
+
+	// Make sure the render thread is done with the readback before releasing it
+	FlushRenderingCommands();
+
+	Readback.Reset();
+	bIsReadbackInFlight = false;
+	PrivacyMaskTarget.SafeRelease();
+	CapturedWindow = nullptr;
+
+	FScopeLock Lock(&FramesCriticalSection);
+	Frames.Empty();
+	SpriteSheet.Empty();
+}
+
+bool FSentryCrashVideoFrameStrip::WriteSpriteSheet(const FString& Path) const
+{
+	FScopeLock Lock(&FramesCriticalSection);
+
+	if (SpriteSheet.Num() == 0)
+	{
+		return false;
+	}
+
+	return FFileHelper::SaveArrayToFile(SpriteSheet, *Path);
+}
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+void FSentryCrashVideoFrameStrip::OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer)
+#else
+void FSentryCrashVideoFrameStrip::OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer)
+#endif
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	check(IsInRenderingThread());
+
+	if (!bIsActive || &Window != CapturedWindow || !BackBuffer.IsValid())
+	{
+		return;
+	}
+
+	// Readbacks are polled instead of waited for so capturing never stalls the render thread
+	if (bIsReadbackInFlight && Readback->IsReady())
+	{
+		bIsReadbackInFlight = false;
+		ResolveReadback();
+	}
+
+	// Frames are picked from the present timeline on a fixed cadence, the ones in between cost nothing else
+	if (!CaptureCadence.ShouldCapture(FPlatformTime::Seconds()))
+	{
+		return;
+	}
+
+	if (!Readback.IsValid())
+	{
+		Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("SentryCrashFrameStrip"));
+	}
+	else if (bIsReadbackInFlight)
+	{
+		// Previous frame is still in flight, dropping this one keeps the GPU work from queueing up
+		CaptureCadence.OnDropped();
+		return;
+	}
+
+	const EPixelFormat Format = BackBuffer->GetFormat();
+	if (Format != PF_B8G8R8A8 && Format != PF_R8G8B8A8 && Format != PF_A2B10G10R10)
+	{
+		return;
+	}
+
+	ReadbackSize = BackBuffer->GetSizeXY();
+	ReadbackFormat = Format;
+
+	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+
+	const FSentryTextureRHIRef Source = FSentryRedactedWidgets::Get().Apply(RHICmdList, Window, BackBuffer, PrivacyMaskTarget);
+	if (!Source.IsValid())
+	{
+		return;
+	}
+
+	Readback->EnqueueCopy(RHICmdList, Source);
+	bIsReadbackInFlight = true;
+#endif
+}
+
+void FSentryCrashVideoFrameStrip::ResolveReadback()
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	int32 RowPitchInPixels = 0;
+	const uint8* Data = static_cast<const uint8*>(Readback->Lock(RowPitchInPixels));
+	if (!Data)
+	{
+		Readback->Unlock();
+		return;
+	}
+
+	TArray<FColor> Frame;
+	Frame.SetNumUninitialized(Config.FrameWidth * Config.FrameHeight);
+
+	// Nearest sampling is enough for thumbnails and keeps the render thread cost negligible
+	for (int32 Y = 0; Y < Config.FrameHeight; ++Y)
+	{
+		const int32 SourceY = Y * ReadbackSize.Y / Config.FrameHeight;
+		const uint32* SourceRow = reinterpret_cast<const uint32*>(Data) + SourceY * RowPitchInPixels;
+
+		for (int32 X = 0; X < Config.FrameWidth; ++X)
+		{
+			const uint32 Pixel = SourceRow[X * ReadbackSize.X / Config.FrameWidth];
+
+			FColor& Color = Frame[Y * Config.FrameWidth + X];
+			switch (ReadbackFormat)
+			{
+			case PF_R8G8B8A8:
+				Color = FColor(Pixel & 0xFF, (Pixel >> 8) & 0xFF, (Pixel >> 16) & 0xFF, 255);
+				break;
+			case PF_A2B10G10R10:
+				Color = FColor(((Pixel >> 0) & 0x3FF) >> 2, ((Pixel >> 10) & 0x3FF) >> 2, ((Pixel >> 20) & 0x3FF) >> 2, 255);
+				break;
+			default:
+				Color = FColor((Pixel >> 16) & 0xFF, (Pixel >> 8) & 0xFF, Pixel & 0xFF, 255);
+				break;
+			}
+		}
+	}
+
+	Readback->Unlock();
+
+	{
+		FScopeLock Lock(&FramesCriticalSection);
+
+		if (Frames.Num() >= Config.MaxFrames)
+		{
+			Frames.RemoveAt(0);
+		}
+
+		Frames.Add(MoveTemp(Frame));
+	}
+
+	if (!bIsEncoding)
+	{
+		bIsEncoding = true;
+
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this]()
+		{
+			EncodeSpriteSheet();
+			bIsEncoding = false;
+		});
+	}
+#endif
+}
+
+void FSentryCrashVideoFrameStrip::EncodeSpriteSheet()
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	TArray<TArray<FColor>> FramesToEncode;
+	{
+		FScopeLock Lock(&FramesCriticalSection);
+		FramesToEncode = Frames;
+	}
+
+	if (FramesToEncode.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Config.MaxFrames)));
+	const int32 Rows = FMath::DivideAndRoundUp(Config.MaxFrames, Columns);
+
+	const int32 SheetWidth = Columns * Config.FrameWidth;
+	const int32 SheetHeight = Rows * Config.FrameHeight;
+
+	TArray<FColor> Sheet;
+	Sheet.SetNumZeroed(SheetWidth * SheetHeight);
+
+	for (int32 FrameIndex = 0; FrameIndex < FramesToEncode.Num(); ++FrameIndex)
+	{
+		const int32 OffsetX = (FrameIndex % Columns) * Config.FrameWidth;
+		const int32 OffsetY = (FrameIndex / Columns) * Config.FrameHeight;
+
+		for (int32 Y = 0; Y < Config.FrameHeight; ++Y)
+		{
+			FMemory::Memcpy(&Sheet[(OffsetY + Y) * SheetWidth + OffsetX], &FramesToEncode[FrameIndex][Y * Config.FrameWidth], Config.FrameWidth * sizeof(FColor));
+		}
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Sheet.GetData(), Sheet.Num() * sizeof(FColor), SheetWidth, SheetHeight, ERGBFormat::BGRA, 8))
+	{
+		return;
+	}
+
+	const TArray64<uint8> Compressed = ImageWrapper->GetCompressed(70);
+
+	FScopeLock Lock(&FramesCriticalSection);
+
+	if (!bIsActive)
+	{
+		// Capturing was stopped while encoding
+		return;
+	}
+
+	SpriteSheet = TArray<uint8>(Compressed.GetData(), Compressed.Num());
+#endif
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCrashVideoHistory.h"
+
+#include "SentryDefines.h"
+#include "SentryMappedFile.h"
+
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/Crc.h"
+
+namespace SentryCrashVideoHistory
+{
+	/** Smallest page size of the supported platforms, module load addresses are aligned to it. */
+	static constexpr uint64 PageOffsetMask = 0xFFF;
+}
+
+FSentryCrashVideoHistory& FSentryCrashVideoHistory::Get()
+{
+	static FSentryCrashVideoHistory Instance;
+	return Instance;
+}
+
+FSentryCrashVideoHistory::FSentryCrashVideoHistory()
+	: Record(&LocalRecord)
+{
+	FMemory::Memzero(LocalRecord);
+}
+
+FSentryCrashVideoHistory::~FSentryCrashVideoHistory() = default;
+
+void FSentryCrashVideoHistory::Open(const FString& Path, float InSampleRate, int32 InRetentionDays)
+{
+	check(IsInGameThread());
+
+	SampleRate = FMath::Clamp(InSampleRate, 0.0f, 1.0f);
+	RetentionSeconds = static_cast<int64>(FMath::Max(0, InRetentionDays)) * 24 * 60 * 60;
+
+	// Crash handler may use the record at any time, so it's switched to the local one before the file is remapped
+	Record = &LocalRecord;
+	MappedFile.Reset();
+
+	if (RetentionSeconds == 0)
+	{
+		return;
+	}
+
+	if (FSentryMappedFile::IsSupported() && !Path.IsEmpty())
+	{
+		MappedFile = FSentryMappedFile::Open(Path, sizeof(FRecord));
+	}
+
+	FRecord* NewRecord = MappedFile ? reinterpret_cast<FRecord*>(MappedFile->GetData()) : &LocalRecord;
+	if (NewRecord->Magic != RecordMagic || NewRecord->Version != RecordVersion)
+	{
+		FMemory::Memzero(*NewRecord);
+		NewRecord->Magic = RecordMagic;
+		NewRecord->Version = RecordVersion;
+	}
+
+	const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+
+	int32 NumRemembered = 0;
+	for (FEntry& Entry : NewRecord->Entries)
+	{
+		if (Entry.UnixSeconds == 0)
+		{
+			continue;
+		}
+
+		// Entries from the future mean the clock was changed, they'd never expire otherwise
+		if (Now - Entry.UnixSeconds >= RetentionSeconds || Entry.UnixSeconds > Now)
+		{
+			FMemory::Memzero(Entry);
+			continue;
+		}
+
+		// Attached video went out with the crash report, deferred ones are confirmed once they're uploaded
+		if (Entry.bIsPending && Entry.EventId[0] == '\0')
+		{
+			Entry.bIsPending = 0;
+		}
+
+		++NumRemembered;
+	}
+
+	Record = NewRecord;
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video history loaded with %d fingerprints sent within the last %d days."), NumRemembered, InRetentionDays);
+}
+
+void FSentryCrashVideoHistory::Close()
+{
+	Record = &LocalRecord;
+	MappedFile.Reset();
+}
+
+ESentryCrashVideoSkipReason FSentryCrashVideoHistory::ShouldCaptureVideo(uint32 Fingerprint, int64 NowUnixSeconds)
+{
+	if (SampleRate < 1.0f && FMath::FRand() >= SampleRate)
+	{
+		return ESentryCrashVideoSkipReason::SampledOut;
+	}
+
+	if (RetentionSeconds == 0)
+	{
+		return ESentryCrashVideoSkipReason::None;
+	}
+
+	for (const FEntry& Entry : Record->Entries)
+	{
+		const bool bIsExpired = Entry.UnixSeconds == 0 || NowUnixSeconds - Entry.UnixSeconds >= RetentionSeconds;
+
+		// Video of a pending fingerprint may still fail to be sent, so the crash gets its own
+		if (!bIsExpired && !Entry.bIsPending && Entry.Fingerprint == Fingerprint)
+		{
+			return ESentryCrashVideoSkipReason::Duplicate;
+		}
+	}
+
+	return ESentryCrashVideoSkipReason::None;
+}
+
+void FSentryCrashVideoHistory::MarkPending(uint32 Fingerprint, ESentryCrashVideoDelivery Delivery, const FString& EventId, int64 NowUnixSeconds)
+{
+	if (RetentionSeconds == 0)
+	{
+		return;
+	}
+
+	FEntry& Entry = FindFreeEntry(NowUnixSeconds);
+
+	Entry.Fingerprint = Fingerprint;
+	Entry.bIsPending = 1;
+	Entry.UnixSeconds = NowUnixSeconds;
+
+	// Event id is a plain uuid, copied char by char since the crash handler can't allocate for a conversion
+	int32 Length = 0;
+	if (Delivery == ESentryCrashVideoDelivery::Deferred)
+	{
+		for (; Length < EventId.Len() && Length < MaxEventIdLength - 1; ++Length)
+		{
+			Entry.EventId[Length] = static_cast<ANSICHAR>(EventId[Length]);
+		}
+	}
+	Entry.EventId[Length] = '\0';
+}
+
+void FSentryCrashVideoHistory::ConfirmUpload(const FString& EventId, int64 NowUnixSeconds)
+{
+	check(IsInGameThread());
+
+	if (RetentionSeconds == 0 || EventId.IsEmpty())
+	{
+		return;
+	}
+
+	for (FEntry& Entry : Record->Entries)
+	{
+		if (Entry.bIsPending && Entry.EventId[0] != '\0' && EventId.Equals(ANSI_TO_TCHAR(Entry.EventId), ESearchCase::IgnoreCase))
+		{
+			// Retention starts once the video is sent since that's when it becomes available for the issue
+			Entry.bIsPending = 0;
+			Entry.UnixSeconds = NowUnixSeconds;
+			FMemory::Memzero(Entry.EventId);
+		}
+	}
+}
+
+FSentryCrashVideoHistory::FEntry& FSentryCrashVideoHistory::FindFreeEntry(int64 NowUnixSeconds) const
+{
+	FEntry* Slot = nullptr;
+	bool bIsSlotExpired = false;
+
+	for (FEntry& Entry : Record->Entries)
+	{
+		const bool bIsExpired = Entry.UnixSeconds == 0 || NowUnixSeconds - Entry.UnixSeconds >= RetentionSeconds;
+
+		if (!Slot || (bIsExpired && !bIsSlotExpired) || (!bIsExpired && !bIsSlotExpired && Entry.UnixSeconds < Slot->UnixSeconds))
+		{
+			Slot = &Entry;
+			bIsSlotExpired = bIsExpired;
+		}
+	}
+
+	return *Slot;
+}
+
+uint32 FSentryCrashVideoHistory::GetCrashFingerprint(const uint64* ProgramCounters, int32 Depth)
+{
+	uint32 Fingerprint = 0;
+
+	for (int32 Index = 0; Index < FMath::Min(Depth, MaxFingerprintDepth); ++Index)
+	{
+		const uint16 PageOffset = static_cast<uint16>(ProgramCounters[Index] & SentryCrashVideoHistory::PageOffsetMask);
+		Fingerprint = FCrc::MemCrc32(&PageOffset, sizeof(PageOffset), Fingerprint);
+	}
+
+	return Fingerprint;
+}
+
+FORCENOINLINE uint32 FSentryCrashVideoHistory::CaptureCrashFingerprint()
+{
+	uint64 ProgramCounters[MaxFingerprintDepth];
+	const int32 Depth = static_cast<int32>(FPlatformStackWalk::CaptureStackBackTrace(ProgramCounters, MaxFingerprintDepth));
+
+	return GetCrashFingerprint(ProgramCounters, Depth);
+}
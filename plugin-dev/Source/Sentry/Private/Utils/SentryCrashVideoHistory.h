@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSentryMappedFile;
+
+/** Reason for a crash not getting a video. */
+enum class ESentryCrashVideoSkipReason : uint8
+{
+	None,
+	/** Crash wasn't picked by the crash video sample rate. */
+	SampledOut,
+	/** Video of a crash with the same fingerprint was sent recently. */
+	Duplicate
+};
+
+/** How the video of a crash leaves the device. */
+enum class ESentryCrashVideoDelivery : uint8
+{
+	/** Video is attached to the crash report. */
+	Attached,
+	/** Video is left on disk and uploaded in a separate event on the next launch. */
+	Deferred
+};
+
+/**
+ * Decides which crashes get a crash video.
+ *
+ * Applies the crash video sample rate and remembers the fingerprints of crashes whose video was sent, so that crashes
+ * that keep happening at the same place don't encode and upload a video every time. Fingerprints of the last few
+ * days are kept in a memory-mapped file on Windows/Linux which the crash handler can check and update without
+ * allocating or touching the file system.
+ *
+ * A fingerprint recorded by the crash handler stays pending until its video is known to be sent, so a video that
+ * failed to encode or never got uploaded doesn't stop the next crash at the same place from getting one.
+ */
+class FSentryCrashVideoHistory
+{
+public:
+	static FSentryCrashVideoHistory& Get();
+
+	FSentryCrashVideoHistory();
+	~FSentryCrashVideoHistory();
+
+	/** Max number of frames the fingerprint is calculated from. */
+	static constexpr int32 MaxFingerprintDepth = 32;
+
+	/**
+	 * Loads the fingerprints of the previous sessions and drops the expired ones. Called on the game thread.
+	 *
+	 * Pending fingerprints of videos attached to a crash report are confirmed here since the report was handed over
+	 * to the crash reporter by then, while the ones of deferred videos wait for ConfirmUpload.
+	 *
+	 * @param Path File to keep the fingerprints in.
+	 * @param InSampleRate Share of crashes that get a video (0.0 - 1.0).
+	 * @param InRetentionDays Days a fingerprint is remembered for after its video was sent, 0 to not de-duplicate videos.
+	 */
+	void Open(const FString& Path, float InSampleRate, int32 InRetentionDays);
+
+	/** Stops remembering fingerprints in the file. */
+	void Close();
+
+	/** Checks whether the crash with the given fingerprint should get a video. Safe to call from the crash handler. */
+	ESentryCrashVideoSkipReason ShouldCaptureVideo(uint32 Fingerprint, int64 NowUnixSeconds);
+
+	/**
+	 * Remembers the fingerprint of a crash that got a video until the video is known to be sent.
+	 * Safe to call from the crash handler.
+	 *
+	 * @param EventId Crash event the deferred video is uploaded for, ignored for attached videos.
+	 */
+	void MarkPending(uint32 Fingerprint, ESentryCrashVideoDelivery Delivery, const FString& EventId, int64 NowUnixSeconds);
+
+	/** Confirms the pending fingerprint of the crash whose deferred video was uploaded. Called on the game thread. */
+	void ConfirmUpload(const FString& EventId, int64 NowUnixSeconds);
+
+	/**
+	 * Fingerprints the crash from the program counters of the crashed thread.
+	 *
+	 * Only offsets within the memory pages are used since modules are loaded at page-aligned addresses that change
+	 * between launches, which keeps the fingerprint stable across sessions without resolving any symbols.
+	 */
+	static uint32 GetCrashFingerprint(const uint64* ProgramCounters, int32 Depth);
+
+	/**
+	 * Captures the stack of the calling thread and fingerprints it. Safe to call from the crash handler.
+	 * Used when the crashed thread can't be unwound, the crash handler frames it includes are the same for all crashes.
+	 */
+	static uint32 CaptureCrashFingerprint();
+
+private:
+	static constexpr int32 MaxEntries = 256;
+	static constexpr int32 MaxEventIdLength = 40;
+
+	struct FEntry
+	{
+		uint32 Fingerprint;
+		/** Non-zero until the video of the crash is known to be sent. */
+		uint32 bIsPending;
+		int64 UnixSeconds;
+		/** Crash event a deferred video is uploaded for, empty for videos attached to the crash report. */
+		ANSICHAR EventId[MaxEventIdLength];
+	};
+
+	/** POD layout of the remembered fingerprints, placed at the start of the mapped file. */
+	struct FRecord
+	{
+		uint32 Magic;
+		uint32 Version;
+		FEntry Entries[MaxEntries];
+	};
+
+	static constexpr uint32 RecordMagic = 0x4D565253; // "SRVM"
+	static constexpr uint32 RecordVersion = 2;
+
+	TUniquePtr<FSentryMappedFile> MappedFile;
+
+	/** Record used when the fingerprints can't be persisted. */
+	FRecord LocalRecord;
+
+	/** Record the fingerprints are kept in, either the local one or the one in the mapped file. */
+	FRecord* Record;
+
+	/** Finds the entry a new fingerprint goes to, an expired one or the oldest one if the table is full. */
+	FEntry& FindFreeEntry(int64 NowUnixSeconds) const;
+
+	float SampleRate = 1.0f;
+	int64 RetentionSeconds = 0;
+};
@@ -0,0 +1,267 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "SentryCrashVideoPendingUpload.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static const TCHAR* PendingDirectoryPrefix = TEXT("PendingUpload_");
+
+// Startup upload and full clip requests run on background tasks and may overlap
+static FCriticalSection PendingUploadCriticalSection;
+static TSet<FString> UploadingDirectories;
+
+bool SentryCrashVideoPendingUpload::Persist(const FString& SegmentsDirectory, const TArray<FString>& Segments, const FString& EventId)
+{
+	if (Segments.Num() == 0 || EventId.IsEmpty())
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Renaming the directory is a single metadata operation and keeps the segments from being wiped when recording starts again
+	const FString PendingDirectory = FPaths::Combine(FPaths::GetPath(SegmentsDirectory), PendingDirectoryPrefix + EventId);
+	if (!PlatformFile.MoveFile(*PendingDirectory, *SegmentsDirectory))
+	{
+		return false;
+	}
+
+	FSentryPendingCrashVideo PendingVideo;
+	PendingVideo.Directory = PendingDirectory;
+	PendingVideo.EventId = EventId;
+	PendingVideo.Files = Segments;
+
+	return WriteManifest(PendingVideo);
+}
+
+TArray<FSentryPendingCrashVideo> SentryCrashVideoPendingUpload::Collect(const FString& CrashVideoDirectory, int32 FullClipRetentionDays)
+{
+	FScopeLock Lock(&PendingUploadCriticalSection);
+
+	TArray<FSentryPendingCrashVideo> PendingVideos;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<FString> PendingDirectories;
+	PlatformFile.IterateDirectory(*CrashVideoDirectory, [&PendingDirectories](const TCHAR* Path, bool bIsDirectory)
+	{
+		// Videos being uploaded are neither returned again nor removed while their files are still in use
+		if (bIsDirectory && FPaths::GetCleanFilename(Path).StartsWith(PendingDirectoryPrefix) && !UploadingDirectories.Contains(Path))
+		{
+			PendingDirectories.Add(Path);
+		}
+		return true;
+	});
+
+	for (const FString& PendingDirectory : PendingDirectories)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *GetManifestPath(PendingDirectory)) || Lines.Num() < 2)
+		{
+			// Either uploaded during the previous session or the crash handler didn't manage to finish writing it
+			PlatformFile.DeleteDirectoryRecursively(*PendingDirectory);
+			continue;
+		}
+
+		FSentryPendingCrashVideo PendingVideo;
+		PendingVideo.Directory = PendingDirectory;
+		PendingVideo.EventId = Lines[0].TrimStartAndEnd();
+
+		const FString PreviewMarkerPath = GetPreviewMarkerPath(PendingDirectory);
+		PendingVideo.bIsPreviewUploaded = PlatformFile.FileExists(*PreviewMarkerPath);
+
+		// Nobody asked for the full clip in time, the preview is all the issue gets
+		if (PendingVideo.bIsPreviewUploaded && FullClipRetentionDays > 0
+			&& FDateTime::UtcNow() - PlatformFile.GetTimeStamp(*PreviewMarkerPath) > FTimespan::FromDays(FullClipRetentionDays))
+		{
+			PlatformFile.DeleteDirectoryRecursively(*PendingDirectory);
+			continue;
+		}
+
+		for (int32 i = 1; i < Lines.Num(); ++i)
+		{
+			const FString FilePath = FPaths::Combine(PendingDirectory, Lines[i].TrimStartAndEnd());
+			if (!Lines[i].IsEmpty() && PlatformFile.FileExists(*FilePath))
+			{
+				PendingVideo.Files.Add(FilePath);
+			}
+		}
+
+		if (PendingVideo.Files.Num() == 0)
+		{
+			PlatformFile.DeleteDirectoryRecursively(*PendingDirectory);
+			continue;
+		}
+
+		PendingVideos.Add(PendingVideo);
+	}
+
+	return PendingVideos;
+}
+
+TArray<TArray<FString>> SentryCrashVideoPendingUpload::SplitIntoBatches(const FSentryPendingCrashVideo& PendingVideo, int64 MaxBatchBytes)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<TArray<FString>> Batches;
+	int64 BatchBytes = 0;
+
+	for (const FString& File : PendingVideo.Files)
+	{
+		const int64 FileSize = FMath::Max<int64>(0, PlatformFile.FileSize(*File));
+
+		if (Batches.Num() == 0 || (MaxBatchBytes > 0 && BatchBytes + FileSize > MaxBatchBytes && Batches.Last().Num() > 0))
+		{
+			Batches.AddDefaulted();
+			BatchBytes = 0;
+		}
+
+		Batches.Last().Add(File);
+		BatchBytes += FileSize;
+	}
+
+	return Batches;
+}
+
+TArray<FString> SentryCrashVideoPendingUpload::SelectPreview(const FSentryPendingCrashVideo& PendingVideo, int64 MaxPreviewBytes)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TSet<FString> PreviewVideos;
+	int32 NumVideos = 0;
+	int64 PreviewBytes = 0;
+
+	// Newest footage is the part leading up to the crash, so the budget is filled backwards
+	for (int32 Index = PendingVideo.Files.Num() - 1; Index >= 0; --Index)
+	{
+		const FString& File = PendingVideo.Files[Index];
+		if (!IsVideoFile(File))
+		{
+			continue;
+		}
+
+		++NumVideos;
+
+		const int64 FileSize = FMath::Max<int64>(0, PlatformFile.FileSize(*File));
+		if (PreviewVideos.Num() > 0 && (PreviewVideos.Num() < NumVideos - 1 || PreviewBytes + FileSize > MaxPreviewBytes))
+		{
+			continue;
+		}
+
+		PreviewVideos.Add(File);
+		PreviewBytes += FileSize;
+	}
+
+	if (PreviewVideos.Num() == NumVideos)
+	{
+		return PendingVideo.Files;
+	}
+
+	TArray<FString> Preview;
+	for (const FString& File : PendingVideo.Files)
+	{
+		if (PreviewVideos.Contains(File) || (!IsVideoFile(File) && !File.EndsWith(TEXT(".ffconcat"))))
+		{
+			Preview.Add(File);
+		}
+	}
+
+	return Preview;
+}
+
+bool SentryCrashVideoPendingUpload::TryBeginUpload(const FSentryPendingCrashVideo& PendingVideo)
+{
+	FScopeLock Lock(&PendingUploadCriticalSection);
+
+	bool bIsAlreadyUploading = false;
+	UploadingDirectories.Add(PendingVideo.Directory, &bIsAlreadyUploading);
+
+	return !bIsAlreadyUploading;
+}
+
+void SentryCrashVideoPendingUpload::EndUpload(const FSentryPendingCrashVideo& PendingVideo)
+{
+	FScopeLock Lock(&PendingUploadCriticalSection);
+
+	UploadingDirectories.Remove(PendingVideo.Directory);
+}
+
+void SentryCrashVideoPendingUpload::MarkFilesUploaded(FSentryPendingCrashVideo& PendingVideo, const TArray<FString>& UploadedFiles)
+{
+	FScopeLock Lock(&PendingUploadCriticalSection);
+
+	PendingVideo.Files.RemoveAll([&UploadedFiles](const FString& File)
+	{
+		return UploadedFiles.Contains(File);
+	});
+
+	if (PendingVideo.Files.Num() == 0)
+	{
+		MarkUploaded(PendingVideo);
+		return;
+	}
+
+	if (!WriteManifest(PendingVideo))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to update crash video upload progress: %s"), *PendingVideo.Directory);
+	}
+}
+
+void SentryCrashVideoPendingUpload::MarkUploaded(const FSentryPendingCrashVideo& PendingVideo)
+{
+	FScopeLock Lock(&PendingUploadCriticalSection);
+
+	if (!FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*GetManifestPath(PendingVideo.Directory)))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to mark crash video as uploaded: %s"), *PendingVideo.Directory);
+	}
+}
+
+void SentryCrashVideoPendingUpload::MarkPreviewUploaded(FSentryPendingCrashVideo& PendingVideo, const TArray<FString>& PreviewFiles)
+{
+	FScopeLock Lock(&PendingUploadCriticalSection);
+
+	// Small files such as the timeline describe the whole clip, so they're uploaded again along with it
+	PendingVideo.Files.RemoveAll([&PreviewFiles](const FString& File)
+	{
+		return IsVideoFile(File) && PreviewFiles.Contains(File);
+	});
+
+	PendingVideo.bIsPreviewUploaded = true;
+
+	if (!WriteManifest(PendingVideo) || !FFileHelper::SaveStringToFile(FString(), *GetPreviewMarkerPath(PendingVideo.Directory)))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to mark crash video preview as uploaded: %s"), *PendingVideo.Directory);
+	}
+}
+
+bool SentryCrashVideoPendingUpload::WriteManifest(const FSentryPendingCrashVideo& PendingVideo)
+{
+	FString Manifest = PendingVideo.EventId + TEXT("\n");
+	for (const FString& File : PendingVideo.Files)
+	{
+		Manifest += FPaths::GetCleanFilename(File) + TEXT("\n");
+	}
+
+	return FFileHelper::SaveStringToFile(Manifest, *GetManifestPath(PendingVideo.Directory), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString SentryCrashVideoPendingUpload::GetManifestPath(const FString& Directory)
+{
+	return FPaths::Combine(Directory, TEXT("pending_upload.txt"));
+}
+
+FString SentryCrashVideoPendingUpload::GetPreviewMarkerPath(const FString& Directory)
+{
+	return FPaths::Combine(Directory, TEXT("preview_uploaded.txt"));
+}
+
+bool SentryCrashVideoPendingUpload::IsVideoFile(const FString& File)
+{
+	return File.EndsWith(TEXT(".mp4")) || File.EndsWith(TEXT(".avi"));
+}
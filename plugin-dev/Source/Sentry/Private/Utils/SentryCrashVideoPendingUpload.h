@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Crash video persisted by the crash handler that still has to be uploaded. */
+struct FSentryPendingCrashVideo
+{
+	/** Directory containing the video files and the manifest. */
+	FString Directory;
+
+	/** Identifier of the crash event the video belongs to. */
+	FString EventId;
+
+	/** Video files ordered from the oldest to the newest. */
+	TArray<FString> Files;
+
+	/** Whether a preview was uploaded already and the remaining files wait for the full clip to be requested. */
+	bool bIsPreviewUploaded = false;
+};
+
+/**
+ * Persists crash videos at crash time so that they can be uploaded on the next launch
+ * instead of doing the work inside the crash handler.
+ */
+class SentryCrashVideoPendingUpload
+{
+public:
+	/**
+	 * Moves the segments directory aside and writes a manifest referencing the given segments. Cheap enough for the crash handler.
+	 *
+	 * @param SegmentsDirectory - Directory containing finalized crash video segments
+	 * @param Segments - Segments to be uploaded
+	 * @param EventId - Identifier of the crash event
+	 *
+	 * @return True if the video was persisted.
+	 */
+	static bool Persist(const FString& SegmentsDirectory, const TArray<FString>& Segments, const FString& EventId);
+
+	/**
+	 * Finds crash videos persisted during previous sessions and removes the ones that were already uploaded.
+	 * Touches the disk, so it's expected to be called from a background thread.
+	 * Collections are serialized and skip videos that are being uploaded.
+	 *
+	 * @param FullClipRetentionDays - Days the rest of a video is kept after its preview was uploaded (0 to keep it until requested)
+	 */
+	static TArray<FSentryPendingCrashVideo> Collect(const FString& CrashVideoDirectory, int32 FullClipRetentionDays = 0);
+
+	/**
+	 * Selects the newest video files whose total size fits the given budget, along with the small non-video files.
+	 * The concat index isn't selected since it references the whole clip. At least the newest video file is selected.
+	 *
+	 * @return Files ordered like in the pending video, or all of them if every video file fits the budget.
+	 */
+	static TArray<FString> SelectPreview(const FSentryPendingCrashVideo& PendingVideo, int64 MaxPreviewBytes);
+
+	/**
+	 * Splits the remaining files into batches so that each upload stays within the given size.
+	 * Files larger than the limit are uploaded on their own.
+	 */
+	static TArray<TArray<FString>> SplitIntoBatches(const FSentryPendingCrashVideo& PendingVideo, int64 MaxBatchBytes);
+
+	/**
+	 * Claims the crash video for uploading so that concurrent collections don't pick it up again.
+	 *
+	 * @return False if the video is already being uploaded.
+	 */
+	static bool TryBeginUpload(const FSentryPendingCrashVideo& PendingVideo);
+
+	/**
+	 * Releases the claim so that the video can be collected again, e.g. once its preview is uploaded.
+	 * Fully uploaded videos stay claimed until the next launch as their files may still be read while the event is being sent.
+	 */
+	static void EndUpload(const FSentryPendingCrashVideo& PendingVideo);
+
+	/**
+	 * Removes the uploaded files from the manifest so that an interrupted upload resumes with the remaining ones on the next launch.
+	 */
+	static void MarkFilesUploaded(FSentryPendingCrashVideo& PendingVideo, const TArray<FString>& UploadedFiles);
+
+	/**
+	 * Marks the crash video as uploaded. Its files are removed during the next collection
+	 * since attachments may still be read from disk while the event is being sent.
+	 */
+	static void MarkUploaded(const FSentryPendingCrashVideo& PendingVideo);
+
+	/**
+	 * Removes the uploaded preview files from the manifest and keeps the rest on disk until the full clip is requested
+	 * or the retention period runs out.
+	 */
+	static void MarkPreviewUploaded(FSentryPendingCrashVideo& PendingVideo, const TArray<FString>& PreviewFiles);
+
+private:
+	static bool WriteManifest(const FSentryPendingCrashVideo& PendingVideo);
+
+	static FString GetManifestPath(const FString& Directory);
+
+	static FString GetPreviewMarkerPath(const FString& Directory);
+
+	static bool IsVideoFile(const FString& File);
+};
@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Utils/SentryCrashVideoPresets.h"
+
+#include "SentryCrashVideoConfig.h"
+
+#include "DeviceProfiles/DeviceProfile.h"
+#include "DeviceProfiles/DeviceProfileManager.h"
+#include "Scalability.h"
+
+TArray<FCrashVideoPreset> SentryCrashVideoPresets::GetDefaultPresets()
+{
+	TArray<FCrashVideoPreset> Presets;
+
+	FCrashVideoPreset& LowEnd = Presets.AddDefaulted_GetRef();
+	LowEnd.Name = TEXT("LowEnd");
+	LowEnd.DeviceProfiles = { TEXT("Android_Low"), TEXT("Android_Mid") };
+	LowEnd.Config.LastSecondsToRecord = 10.0f;
+	LowEnd.Config.TargetFPS = 15;
+	LowEnd.Config.Width = 854;
+	LowEnd.Config.Height = 480;
+	LowEnd.Config.QualityPreset = 20;
+	LowEnd.Config.bRequireHardwareEncoder = true;
+
+	FCrashVideoPreset& Mobile = Presets.AddDefaulted_GetRef();
+	Mobile.Name = TEXT("Mobile");
+	Mobile.DeviceProfiles = { TEXT("Android"), TEXT("IOS") };
+	Mobile.Config.LastSecondsToRecord = 15.0f;
+	Mobile.Config.TargetFPS = 20;
+	Mobile.Config.Width = 1280;
+	Mobile.Config.Height = 720;
+	Mobile.Config.QualityPreset = 30;
+
+	FCrashVideoPreset& LowScalability = Presets.AddDefaulted_GetRef();
+	LowScalability.Name = TEXT("LowScalability");
+	LowScalability.MaxScalabilityLevel = 1;
+	LowScalability.Config.LastSecondsToRecord = 20.0f;
+	LowScalability.Config.TargetFPS = 20;
+	LowScalability.Config.Width = 1280;
+	LowScalability.Config.Height = 720;
+	LowScalability.Config.QualityPreset = 40;
+
+	FCrashVideoPreset& Detailed = Presets.AddDefaulted_GetRef();
+	Detailed.Name = TEXT("Detailed");
+	Detailed.Config.LastSecondsToRecord = 30.0f;
+	Detailed.Config.TargetFPS = 30;
+	Detailed.Config.Width = 1920;
+	Detailed.Config.Height = 1080;
+	Detailed.Config.QualityPreset = 50;
+
+	return Presets;
+}
+
+int32 SentryCrashVideoPresets::FindPreset(const TArray<FCrashVideoPreset>& Presets, const TArray<FString>& DeviceProfiles, int32 ScalabilityLevel)
+{
+	for (int32 Index = 0; Index < Presets.Num(); ++Index)
+	{
+		const FCrashVideoPreset& Preset = Presets[Index];
+
+		if (Preset.MaxScalabilityLevel >= 0 && ScalabilityLevel > Preset.MaxScalabilityLevel)
+		{
+			continue;
+		}
+
+		const bool bMatchesDevice = Preset.DeviceProfiles.Num() == 0 || Preset.DeviceProfiles.ContainsByPredicate([&DeviceProfiles](const FString& PresetProfile)
+		{
+			return DeviceProfiles.ContainsByPredicate([&PresetProfile](const FString& DeviceProfile)
+			{
+				return DeviceProfile.Equals(PresetProfile, ESearchCase::IgnoreCase);
+			});
+		});
+
+		if (bMatchesDevice)
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+TArray<FString> SentryCrashVideoPresets::GetActiveDeviceProfiles()
+{
+	TArray<FString> DeviceProfiles;
+
+	FString ProfileName = UDeviceProfileManager::Get().GetActiveDeviceProfileName();
+
+	// Profiles inherit from each other, e.g. Android_Low is based on Android
+	while (!ProfileName.IsEmpty() && !DeviceProfiles.Contains(ProfileName))
+	{
+		DeviceProfiles.Add(ProfileName);
+
+		const UDeviceProfile* Profile = UDeviceProfileManager::Get().FindProfile(ProfileName, false);
+		ProfileName = Profile ? Profile->BaseProfileName : FString();
+	}
+
+	return DeviceProfiles;
+}
+
+int32 SentryCrashVideoPresets::GetScalabilityLevel()
+{
+	return Scalability::GetQualityLevels().GetMinQualityLevel();
+}
@@ -0,0 +1,1185 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryCrashVideoRawRing.h"
+
+#include "SentryDefines.h"
+#include "SentryMappedFile.h"
+#include "Utils/SentryRedactedWidgets.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/Compression.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+
+namespace SentryCrashVideoRawRing
+{
+	static constexpr uint32 Magic = 0x52465253; // "SRFR"
+	static constexpr uint32 Version = 1;
+
+	/** Marks slots that were never written or are being written at the moment. */
+	static constexpr uint64 InvalidFrameIndex = MAX_uint64;
+
+	/** Upper bound of the ring file size, the number of frames is reduced to fit. */
+	static constexpr int64 MaxRingSize = 2048ll * 1024 * 1024;
+
+	static constexpr int32 JpegQuality = 85;
+
+	static const TCHAR* ClaimedRingPrefix = TEXT("raw_frames_crash_");
+
+	/** Appended to the base file names of long tier rings, both while recording and once claimed. */
+	static const TCHAR* LongTierSuffix = TEXT("_long");
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 Width;
+		uint32 Height;
+		float FramesPerSecond;
+		uint32 NumSlots;
+		uint32 SlotSize;
+		uint32 Padding;
+		uint64 NumFramesWritten;
+		ANSICHAR CrashEventId[40];
+	};
+
+	struct FSlotHeader
+	{
+		uint64 FrameIndex;
+		int64 TimestampUs;
+		uint32 CompressedSize;
+		uint32 Layout;
+	};
+
+	static int32 GetI420Size(int32 Width, int32 Height)
+	{
+		return Width * Height * 3 / 2;
+	}
+
+	static bool IsValidHeader(const FHeader& Header, int64 RingSize)
+	{
+		if (Header.Magic != Magic || Header.Version != Version || Header.Width == 0 || Header.Height == 0 || Header.NumSlots == 0)
+		{
+			return false;
+		}
+
+		if (Header.Width % 2 != 0 || Header.Height % 2 != 0 || Header.Width > 4096 || Header.Height > 4096)
+		{
+			return false;
+		}
+
+		if (Header.SlotSize <= sizeof(FSlotHeader))
+		{
+			return false;
+		}
+
+		return static_cast<int64>(sizeof(FHeader)) + static_cast<int64>(Header.NumSlots) * Header.SlotSize <= RingSize;
+	}
+
+	static FString GetEventId(const FHeader& Header)
+	{
+		ANSICHAR EventId[UE_ARRAY_COUNT(Header.CrashEventId) + 1] = {};
+		FMemory::Memcpy(EventId, Header.CrashEventId, sizeof(Header.CrashEventId));
+
+		return FString(UTF8_TO_TCHAR(EventId));
+	}
+
+	/**
+	 * Maps the ring file and invalidates the frames left by the previous session.
+	 *
+	 * @param InOutMaxFrames Number of frames to keep, reduced to fit the max ring file size.
+	 */
+	static TUniquePtr<FSentryMappedFile> OpenRing(const FString& RingPath, int32 Width, int32 Height, float FramesPerSecond, int32& InOutMaxFrames, int32& OutSlotSize)
+	{
+		const int32 I420Size = GetI420Size(Width, Height);
+		const int32 SlotSize = Align(static_cast<int32>(sizeof(FSlotHeader)) + FCompression::CompressMemoryBound(NAME_LZ4, I420Size), 4096);
+
+		InOutMaxFrames = FMath::Clamp<int64>(InOutMaxFrames, 1, (MaxRingSize - sizeof(FHeader)) / SlotSize);
+		OutSlotSize = SlotSize;
+
+		// Ring of a crashed session is still waiting to be encoded and uploaded
+		FSentryCrashVideoRawRing::ClaimCrashedRing(RingPath);
+
+		TUniquePtr<FSentryMappedFile> MappedFile = FSentryMappedFile::Open(RingPath, sizeof(FHeader) + static_cast<int64>(InOutMaxFrames) * SlotSize);
+		if (!MappedFile)
+		{
+			return nullptr;
+		}
+
+		// File keeps the contents of the previous session, so its frames have to be invalidated
+		FHeader& Header = *reinterpret_cast<FHeader*>(MappedFile->GetData());
+		FMemory::Memzero(Header);
+		Header.Magic = Magic;
+		Header.Version = Version;
+		Header.Width = Width;
+		Header.Height = Height;
+		Header.FramesPerSecond = FramesPerSecond;
+		Header.NumSlots = InOutMaxFrames;
+		Header.SlotSize = SlotSize;
+
+		for (int32 SlotIndex = 0; SlotIndex < InOutMaxFrames; ++SlotIndex)
+		{
+			uint8* Slot = MappedFile->GetData() + sizeof(FHeader) + static_cast<int64>(SlotIndex) * SlotSize;
+			reinterpret_cast<FSlotHeader*>(Slot)->FrameIndex = InvalidFrameIndex;
+		}
+
+		return MappedFile;
+	}
+
+	/** Compresses I420 pixels into the next slot of the ring. Expected to be called under the ring lock. */
+	static void WriteSlot(FSentryMappedFile& MappedFile, const uint8* I420, int32 I420Size, uint32 Layout)
+	{
+		FHeader& Header = *reinterpret_cast<FHeader*>(MappedFile.GetData());
+
+		const uint64 FrameIndex = Header.NumFramesWritten;
+
+		uint8* Slot = MappedFile.GetData() + sizeof(FHeader) + (FrameIndex % Header.NumSlots) * Header.SlotSize;
+		FSlotHeader& SlotHeader = *reinterpret_cast<FSlotHeader*>(Slot);
+
+		// Slot is invalidated first so that a crash in the middle of writing doesn't leave a torn frame behind
+		SlotHeader.FrameIndex = InvalidFrameIndex;
+		FPlatformMisc::MemoryBarrier();
+
+		int32 CompressedSize = Header.SlotSize - sizeof(FSlotHeader);
+		if (!FCompression::CompressMemory(NAME_LZ4, Slot + sizeof(FSlotHeader), CompressedSize, I420, I420Size))
+		{
+			return;
+		}
+
+		SlotHeader.TimestampUs = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+		SlotHeader.CompressedSize = CompressedSize;
+		SlotHeader.Layout = Layout;
+		FPlatformMisc::MemoryBarrier();
+
+		SlotHeader.FrameIndex = FrameIndex;
+		Header.NumFramesWritten = FrameIndex + 1;
+	}
+
+	/** Writes the crash event ID into the ring header. Only touches mapped memory, safe to call from the crash handler. */
+	static bool WriteCrashEventId(FSentryMappedFile& MappedFile, const FString& EventId)
+	{
+		FHeader& Header = *reinterpret_cast<FHeader*>(MappedFile.GetData());
+
+		// Event IDs are hex strings so a plain narrowing copy doesn't need any allocations
+		const int32 Length = FMath::Min(EventId.Len(), static_cast<int32>(UE_ARRAY_COUNT(Header.CrashEventId)) - 1);
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			Header.CrashEventId[Index] = static_cast<ANSICHAR>(EventId[Index]);
+		}
+		Header.CrashEventId[Length] = 0;
+
+		return Header.NumFramesWritten > 0;
+	}
+
+	/** Minimal writer of Motion JPEG AVI files, which every common player and browser download can open. */
+	class FAviWriter
+	{
+	public:
+		FAviWriter(FArchive& InAr, int32 Width, int32 Height, float FramesPerSecond)
+			: Ar(InAr)
+		{
+			const uint32 Rate = static_cast<uint32>(FMath::RoundToInt(FramesPerSecond * 1000.0f));
+
+			WriteFourCC("RIFF");
+			WriteU32(0); // Patched in Finish
+			WriteFourCC("AVI ");
+
+			WriteFourCC("LIST");
+			WriteU32(192);
+			WriteFourCC("hdrl");
+
+			WriteFourCC("avih");
+			WriteU32(56);
+			WriteU32(static_cast<uint32>(1000000.0f / FramesPerSecond));
+			WriteU32(0);
+			WriteU32(0);
+			WriteU32(0x10); // AVIF_HASINDEX
+			TotalFramesOffset = Ar.Tell();
+			WriteU32(0); // Patched in Finish
+			WriteU32(0);
+			WriteU32(1);
+			WriteU32(0);
+			WriteU32(Width);
+			WriteU32(Height);
+			WriteU32(0);
+			WriteU32(0);
+			WriteU32(0);
+			WriteU32(0);
+
+			WriteFourCC("LIST");
+			WriteU32(116);
+			WriteFourCC("strl");
+
+			WriteFourCC("strh");
+			WriteU32(56);
+			WriteFourCC("vids");
+			WriteFourCC("MJPG");
+			WriteU32(0);
+			WriteU16(0);
+			WriteU16(0);
+			WriteU32(0);
+			WriteU32(1000);
+			WriteU32(Rate);
+			WriteU32(0);
+			LengthOffset = Ar.Tell();
+			WriteU32(0); // Patched in Finish
+			WriteU32(0);
+			WriteU32(MAX_uint32);
+			WriteU32(0);
+			WriteU16(0);
+			WriteU16(0);
+			WriteU16(static_cast<uint16>(Width));
+			WriteU16(static_cast<uint16>(Height));
+
+			WriteFourCC("strf");
+			WriteU32(40);
+			WriteU32(40);
+			WriteU32(Width);
+			WriteU32(Height);
+			WriteU16(1);
+			WriteU16(24);
+			WriteFourCC("MJPG");
+			WriteU32(Width * Height * 3);
+			WriteU32(0);
+			WriteU32(0);
+			WriteU32(0);
+			WriteU32(0);
+
+			MoviListOffset = Ar.Tell();
+			WriteFourCC("LIST");
+			WriteU32(0); // Patched in Finish
+			WriteFourCC("movi");
+		}
+
+		void AddFrame(const TArray64<uint8>& Jpeg)
+		{
+			// Index offsets are relative to the `movi` FourCC
+			Index.Add(TPair<uint32, uint32>(static_cast<uint32>(Ar.Tell() - (MoviListOffset + 8)), static_cast<uint32>(Jpeg.Num())));
+
+			WriteFourCC("00dc");
+			WriteU32(static_cast<uint32>(Jpeg.Num()));
+			Ar.Serialize(const_cast<uint8*>(Jpeg.GetData()), Jpeg.Num());
+
+			// Chunks are word aligned
+			if (Jpeg.Num() % 2 != 0)
+			{
+				uint8 Padding = 0;
+				Ar << Padding;
+			}
+		}
+
+		int32 GetNumFrames() const { return Index.Num(); }
+
+		void Finish()
+		{
+			const int64 IndexOffset = Ar.Tell();
+
+			WriteFourCC("idx1");
+			WriteU32(Index.Num() * 16);
+			for (const TPair<uint32, uint32>& Entry : Index)
+			{
+				WriteFourCC("00dc");
+				WriteU32(0x10); // AVIIF_KEYFRAME
+				WriteU32(Entry.Key);
+				WriteU32(Entry.Value);
+			}
+
+			const int64 FileSize = Ar.Tell();
+
+			Ar.Seek(4);
+			WriteU32(static_cast<uint32>(FileSize - 8));
+
+			Ar.Seek(MoviListOffset + 4);
+			WriteU32(static_cast<uint32>(IndexOffset - (MoviListOffset + 8)));
+
+			Ar.Seek(TotalFramesOffset);
+			WriteU32(Index.Num());
+
+			Ar.Seek(LengthOffset);
+			WriteU32(Index.Num());
+
+			Ar.Seek(FileSize);
+		}
+
+	private:
+		void WriteFourCC(const ANSICHAR* Code)
+		{
+			Ar.Serialize(const_cast<ANSICHAR*>(Code), 4);
+		}
+
+		// Archives are little-endian on all supported platforms, matching the RIFF byte order
+		void WriteU32(uint32 Value)
+		{
+			Ar << Value;
+		}
+
+		void WriteU16(uint16 Value)
+		{
+			Ar << Value;
+		}
+
+		FArchive& Ar;
+
+		int64 TotalFramesOffset = 0;
+		int64 LengthOffset = 0;
+		int64 MoviListOffset = 0;
+
+		TArray<TPair<uint32, uint32>> Index;
+	};
+}
+
+FSentryCrashVideoRawRing& FSentryCrashVideoRawRing::Get()
+{
+	static FSentryCrashVideoRawRing Instance;
+	return Instance;
+}
+
+FSentryCrashVideoRawRing::~FSentryCrashVideoRawRing() = default;
+
+bool FSentryCrashVideoRawRing::Start(const FString& InPath, const FSentryRawFrameRingConfig& InConfig)
+{
+	check(IsInGameThread());
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	UE_LOG(LogSentrySdk, Warning, TEXT("Raw frame ring recording requires Unreal Engine 5.0 or newer."));
+	return false;
+#else
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	if (!FSentryMappedFile::IsSupported())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Raw frame ring recording requires memory-mapped files which are supported on Windows and Linux only."));
+		return false;
+	}
+
+	if (!FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Slate renderer required for raw frame ring recording is not available."));
+		return false;
+	}
+
+	if (!GEngine || !GEngine->GameViewport || !GEngine->GameViewport->GetWindow().IsValid())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Game viewport window required for raw frame ring recording is not available."));
+		return false;
+	}
+
+	// Image wrapper module has to be loaded on the game thread before encoding on background threads
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	// Chroma is subsampled in 2x2 blocks so both dimensions have to be even
+	Config = InConfig;
+	Config.FrameWidth = FMath::Clamp(Config.FrameWidth, 16, 1920) & ~1;
+	Config.FrameHeight = FMath::Clamp(Config.FrameHeight, 16, 1080) & ~1;
+	Config.FramesPerSecond = FMath::Clamp(Config.FramesPerSecond, 1.0f, 30.0f);
+
+	int32 SlotSize = 0;
+	TUniquePtr<FSentryMappedFile> NewMappedFile = SentryCrashVideoRawRing::OpenRing(InPath, Config.FrameWidth, Config.FrameHeight, Config.FramesPerSecond, Config.MaxFrames, SlotSize);
+	if (!NewMappedFile)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to map raw frame ring file %s."), *InPath);
+		return false;
+	}
+
+	// Long tier frames are derived from the captured ones, so they can't be larger or more frequent
+	TUniquePtr<FSentryMappedFile> NewLongTierMappedFile;
+	int32 LongTierSlotSize = 0;
+	if (Config.LongTierMaxFrames > 0)
+	{
+		Config.LongTierFrameWidth = FMath::Clamp(Config.LongTierFrameWidth, 16, Config.FrameWidth) & ~1;
+		Config.LongTierFrameHeight = FMath::Clamp(Config.LongTierFrameHeight, 16, Config.FrameHeight) & ~1;
+		Config.LongTierFramesPerSecond = FMath::Clamp(Config.LongTierFramesPerSecond, 0.1f, Config.FramesPerSecond);
+
+		NewLongTierMappedFile = SentryCrashVideoRawRing::OpenRing(GetLongTierPath(InPath), Config.LongTierFrameWidth, Config.LongTierFrameHeight, Config.LongTierFramesPerSecond,
+			Config.LongTierMaxFrames, LongTierSlotSize);
+		if (!NewLongTierMappedFile)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to map long tier raw frame ring file %s, recording the regular ring only."), *GetLongTierPath(InPath));
+			Config.LongTierMaxFrames = 0;
+		}
+	}
+
+	{
+		FScopeLock Lock(&RingCriticalSection);
+		MappedFile = MakeShareable(NewMappedFile.Release());
+		LongTierMappedFile = NewLongTierMappedFile ? MakeShareable(NewLongTierMappedFile.Release()) : nullptr;
+	}
+
+	Path = InPath;
+	NextLongTierFrameTime = 0.0;
+	CaptureCadence.Reset(Config.FramesPerSecond);
+
+	// Render thread isn't capturing yet, so the tiles can be set up right away
+	NumCapturedWindows = 1;
+	CapturedWindowsLayout = 0;
+	SetTiles({ GEngine->GameViewport->GetWindow().Get() }, CapturedWindowsLayout);
+
+	bIsActive = true;
+
+	OnBackBufferReadyHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddRaw(this, &FSentryCrashVideoRawRing::OnBackBufferReadyToPresent);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Raw frame ring enabled: %dx%d at %.1f FPS, %d frames (%lld MB on disk)."),
+		Config.FrameWidth, Config.FrameHeight, Config.FramesPerSecond, Config.MaxFrames, (static_cast<int64>(Config.MaxFrames) * SlotSize) / (1024 * 1024));
+
+	if (Config.LongTierMaxFrames > 0)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Raw frame ring long tier enabled: %dx%d at %.1f FPS, %d frames (%lld MB on disk)."),
+			Config.LongTierFrameWidth, Config.LongTierFrameHeight, Config.LongTierFramesPerSecond, Config.LongTierMaxFrames, (static_cast<int64>(Config.LongTierMaxFrames) * LongTierSlotSize) / (1024 * 1024));
+	}
+
+	return true;
+#endif
+}
+
+void FSentryCrashVideoRawRing::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(OnBackBufferReadyHandle);
+	}
+
+	OnBackBufferReadyHandle.Reset();
+
+	// Make sure the render thread is done with the readback before releasing it
+	FlushRenderingCommands();
+
+	const int64 NumDropped = CaptureCadence.GetNumDropped();
+
+	Tiles.Empty();
+	TiledFrame.Empty();
+	NumCapturedWindows = 0;
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Raw frame ring stopped, %lld frame(s) were dropped while the capture pipeline was busy."), NumDropped);
+
+	// Frame being written on a background thread checks for the mapping under the same lock
+	FScopeLock Lock(&RingCriticalSection);
+	MappedFile.Reset();
+	LongTierMappedFile.Reset();
+}
+
+void FSentryCrashVideoRawRing::SetCapturedWindows(const TArray<const SWindow*>& Windows)
+{
+	check(IsInGameThread());
+
+	if (!bIsActive || Windows.Num() == 0)
+	{
+		return;
+	}
+
+	NumCapturedWindows = Windows.Num();
+
+	// Frames recorded so far keep the previous layout, so that a clip cropped to a tile never mixes in another window
+	const uint32 Layout = ++CapturedWindowsLayout;
+
+	ENQUEUE_RENDER_COMMAND(SentryCrashVideoRawRingSetWindows)([this, Windows, Layout](FRHICommandListImmediate& RHICmdList)
+	{
+		SetTiles(Windows, Layout);
+	});
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Raw frame ring captures %d window(s) into tiles of %dx%d."),
+		Windows.Num(), GetCapturedWindowRect(0).Width(), GetCapturedWindowRect(0).Height());
+}
+
+FIntRect FSentryCrashVideoRawRing::GetCapturedWindowRect(int32 WindowIndex) const
+{
+	return GetTileRect(WindowIndex, NumCapturedWindows, Config.FrameWidth, Config.FrameHeight);
+}
+
+FIntRect FSentryCrashVideoRawRing::GetTileRect(int32 TileIndex, int32 NumTiles, int32 FrameWidth, int32 FrameHeight)
+{
+	if (TileIndex < 0 || TileIndex >= NumTiles)
+	{
+		return FIntRect();
+	}
+
+	const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumTiles)));
+	const int32 NumRows = FMath::DivideAndRoundUp(NumTiles, NumColumns);
+
+	// Chroma is subsampled in 2x2 blocks, so tiles keep even dimensions and offsets to be cropped cleanly
+	const int32 TileWidth = FMath::Max(2, (FrameWidth / NumColumns) & ~1);
+	const int32 TileHeight = FMath::Max(2, (FrameHeight / NumRows) & ~1);
+
+	const FIntPoint Min((TileIndex % NumColumns) * TileWidth, (TileIndex / NumColumns) * TileHeight);
+	return FIntRect(Min, Min + FIntPoint(TileWidth, TileHeight));
+}
+
+FIntRect FSentryCrashVideoRawRing::GetLetterboxRect(const FIntRect& TileRect, const FIntPoint& ImageSize)
+{
+	if (TileRect.Area() <= 0 || ImageSize.X <= 0 || ImageSize.Y <= 0)
+	{
+		return TileRect;
+	}
+
+	const FIntPoint TileSize = TileRect.Size();
+
+	// Scaled to fit whichever side is the tighter one, the other side is narrowed to keep the aspect ratio
+	FIntPoint Size = TileSize;
+	if (static_cast<int64>(ImageSize.X) * TileSize.Y > static_cast<int64>(ImageSize.Y) * TileSize.X)
+	{
+		Size.Y = FMath::Max(2, static_cast<int32>(static_cast<int64>(TileSize.X) * ImageSize.Y / ImageSize.X) & ~1);
+	}
+	else
+	{
+		Size.X = FMath::Max(2, static_cast<int32>(static_cast<int64>(TileSize.Y) * ImageSize.X / ImageSize.Y) & ~1);
+	}
+
+	const FIntPoint Min = TileRect.Min + FIntPoint(((TileSize.X - Size.X) / 2) & ~1, ((TileSize.Y - Size.Y) / 2) & ~1);
+	return FIntRect(Min, Min + Size);
+}
+
+bool FSentryCrashVideoRawRing::MarkCrashed(const FString& EventId)
+{
+	// Crashed thread might be the one writing a frame, the header is written without locking since nothing else touches the event ID
+	FSentryMappedFile* File = MappedFile.Get();
+	if (!bIsActive || !File || EventId.IsEmpty())
+	{
+		return false;
+	}
+
+	if (FSentryMappedFile* LongTierFile = LongTierMappedFile.Get())
+	{
+		SentryCrashVideoRawRing::WriteCrashEventId(*LongTierFile, EventId);
+	}
+
+	return SentryCrashVideoRawRing::WriteCrashEventId(*File, EventId);
+}
+
+bool FSentryCrashVideoRawRing::EncodeVideo(const FString& VideoPath, const FIntRect& CropRect, uint32 CropLayout) const
+{
+	TSharedPtr<FSentryMappedFile, ESPMode::ThreadSafe> PinnedMappedFile;
+	{
+		FScopeLock Lock(&RingCriticalSection);
+		PinnedMappedFile = MappedFile;
+	}
+
+	if (!PinnedMappedFile)
+	{
+		return false;
+	}
+
+	return EncodeRing(PinnedMappedFile->GetData(), PinnedMappedFile->GetSize(), VideoPath, &RingCriticalSection, CropRect, CropLayout);
+}
+
+bool FSentryCrashVideoRawRing::EncodeLongTierVideo(const FString& VideoPath) const
+{
+	TSharedPtr<FSentryMappedFile, ESPMode::ThreadSafe> PinnedMappedFile;
+	{
+		FScopeLock Lock(&RingCriticalSection);
+		PinnedMappedFile = LongTierMappedFile;
+	}
+
+	if (!PinnedMappedFile)
+	{
+		return false;
+	}
+
+	return EncodeRing(PinnedMappedFile->GetData(), PinnedMappedFile->GetSize(), VideoPath, &RingCriticalSection);
+}
+
+FString FSentryCrashVideoRawRing::GetDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"), TEXT("raw_frames.ring"));
+}
+
+FString FSentryCrashVideoRawRing::GetLongTierPath(const FString& RingPath)
+{
+	return FPaths::Combine(FPaths::GetPath(RingPath), FPaths::GetBaseFilename(RingPath) + SentryCrashVideoRawRing::LongTierSuffix + TEXT(".ring"));
+}
+
+bool FSentryCrashVideoRawRing::IsLongTierRing(const FString& RingPath)
+{
+	return FPaths::GetBaseFilename(RingPath).EndsWith(SentryCrashVideoRawRing::LongTierSuffix);
+}
+
+bool FSentryCrashVideoRawRing::ClaimCrashedRing(const FString& RingPath)
+{
+	SentryCrashVideoRawRing::FHeader Header;
+	FMemory::Memzero(Header);
+
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*RingPath, FILEREAD_Silent));
+		if (!Reader || Reader->TotalSize() < static_cast<int64>(sizeof(Header)))
+		{
+			return false;
+		}
+
+		Reader->Serialize(&Header, sizeof(Header));
+	}
+
+	if (!SentryCrashVideoRawRing::IsValidHeader(Header, MAX_int64) || Header.CrashEventId[0] == 0 || Header.NumFramesWritten == 0)
+	{
+		return false;
+	}
+
+	const FString EventId = SentryCrashVideoRawRing::GetEventId(Header);
+	const TCHAR* Suffix = IsLongTierRing(RingPath) ? SentryCrashVideoRawRing::LongTierSuffix : TEXT("");
+	const FString ClaimedPath = FPaths::Combine(FPaths::GetPath(RingPath), FString::Printf(TEXT("%s%s%s.ring"), SentryCrashVideoRawRing::ClaimedRingPrefix, *EventId, Suffix));
+
+	if (!IFileManager::Get().Move(*ClaimedPath, *RingPath, true, true, false, true))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to claim raw frame ring of crash %s."), *EventId);
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Raw frame ring of crash %s is kept to be encoded."), *EventId);
+
+	return true;
+}
+
+TMap<FString, FString> FSentryCrashVideoRawRing::FindClaimedRings(const FString& Directory)
+{
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(Directory, FString::Printf(TEXT("%s*.ring"), SentryCrashVideoRawRing::ClaimedRingPrefix)), true, false);
+
+	TMap<FString, FString> Rings;
+	for (const FString& FileName : FileNames)
+	{
+		FString EventId = FPaths::GetBaseFilename(FileName).RightChop(FCString::Strlen(SentryCrashVideoRawRing::ClaimedRingPrefix));
+		EventId.RemoveFromEnd(SentryCrashVideoRawRing::LongTierSuffix);
+		if (!EventId.IsEmpty())
+		{
+			Rings.Add(FPaths::Combine(Directory, FileName), EventId);
+		}
+	}
+
+	return Rings;
+}
+
+bool FSentryCrashVideoRawRing::EncodeRingFile(const FString& RingPath, const FString& VideoPath)
+{
+	// Rings are only recorded where files can be mapped, and mapping spares reading up to gigabytes into memory
+	const int64 RingSize = IFileManager::Get().FileSize(*RingPath);
+	if (RingSize < static_cast<int64>(sizeof(SentryCrashVideoRawRing::FHeader)))
+	{
+		return false;
+	}
+
+	const TUniquePtr<FSentryMappedFile> RingFile = FSentryMappedFile::Open(RingPath, RingSize);
+	if (!RingFile)
+	{
+		return false;
+	}
+
+	return EncodeRing(RingFile->GetData(), RingFile->GetSize(), VideoPath, nullptr);
+}
+
+bool FSentryCrashVideoRawRing::EncodeRing(const uint8* RingData, int64 RingSize, const FString& VideoPath, FCriticalSection* Lock, const FIntRect& CropRect, uint32 CropLayout)
+{
+	using namespace SentryCrashVideoRawRing;
+
+	if (RingSize < static_cast<int64>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	FHeader Header;
+	{
+		if (Lock)
+		{
+			Lock->Lock();
+		}
+
+		FMemory::Memcpy(&Header, RingData, sizeof(Header));
+
+		if (Lock)
+		{
+			Lock->Unlock();
+		}
+	}
+
+	if (!IsValidHeader(Header, RingSize))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Raw frame ring is malformed and can't be encoded."));
+		return false;
+	}
+
+	const uint64 NumFrames = FMath::Min<uint64>(Header.NumFramesWritten, Header.NumSlots);
+	if (NumFrames == 0)
+	{
+		return false;
+	}
+
+	const int32 Width = Header.Width;
+	const int32 Height = Header.Height;
+	const int32 I420Size = GetI420Size(Width, Height);
+	const uint32 MaxCompressedSize = Header.SlotSize - sizeof(FSlotHeader);
+
+	FIntRect Crop(0, 0, Width, Height);
+	if (CropRect.Area() > 0)
+	{
+		Crop.Clip(CropRect);
+		if (Crop.Area() <= 0)
+		{
+			return false;
+		}
+	}
+
+	const bool bIsCropped = Crop.Width() != Width || Crop.Height() != Height;
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(VideoPath), true);
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*VideoPath));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	FAviWriter AviWriter(*Writer, Crop.Width(), Crop.Height(), Header.FramesPerSecond);
+
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(MaxCompressedSize);
+
+	TArray<uint8> I420;
+	I420.SetNumUninitialized(I420Size);
+
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(Width * Height);
+
+	TArray<FColor> CroppedPixels;
+	if (bIsCropped)
+	{
+		CroppedPixels.SetNumUninitialized(Crop.Area());
+	}
+
+	for (uint64 FrameIndex = Header.NumFramesWritten - NumFrames; FrameIndex < Header.NumFramesWritten; ++FrameIndex)
+	{
+		const uint8* Slot = RingData + sizeof(FHeader) + (FrameIndex % Header.NumSlots) * Header.SlotSize;
+
+		FSlotHeader SlotHeader;
+		{
+			// Slots of a ring being recorded into are copied out under the lock, the conversion and encoding happen outside of it
+			if (Lock)
+			{
+				Lock->Lock();
+			}
+
+			FMemory::Memcpy(&SlotHeader, Slot, sizeof(SlotHeader));
+
+			// Tiles of frames recorded with another layout hold other windows, or parts of them
+			const bool bIsValid = SlotHeader.FrameIndex == FrameIndex && SlotHeader.CompressedSize > 0 && SlotHeader.CompressedSize <= MaxCompressedSize &&
+				(!bIsCropped || SlotHeader.Layout == CropLayout);
+			if (bIsValid)
+			{
+				FMemory::Memcpy(Compressed.GetData(), Slot + sizeof(FSlotHeader), SlotHeader.CompressedSize);
+			}
+
+			if (Lock)
+			{
+				Lock->Unlock();
+			}
+
+			// Slot was being written when the game crashed or was overwritten since the header was read
+			if (!bIsValid)
+			{
+				continue;
+			}
+		}
+
+		if (!FCompression::UncompressMemory(NAME_LZ4, I420.GetData(), I420Size, Compressed.GetData(), SlotHeader.CompressedSize))
+		{
+			continue;
+		}
+
+		ConvertFromI420(I420.GetData(), Width, Height, Pixels.GetData());
+
+		if (bIsCropped)
+		{
+			for (int32 Y = 0; Y < Crop.Height(); ++Y)
+			{
+				FMemory::Memcpy(&CroppedPixels[Y * Crop.Width()], &Pixels[(Crop.Min.Y + Y) * Width + Crop.Min.X], Crop.Width() * sizeof(FColor));
+			}
+		}
+
+		const TArray<FColor>& EncodedPixels = bIsCropped ? CroppedPixels : Pixels;
+
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(EncodedPixels.GetData(), EncodedPixels.Num() * sizeof(FColor), Crop.Width(), Crop.Height(), ERGBFormat::BGRA, 8))
+		{
+			continue;
+		}
+
+		AviWriter.AddFrame(ImageWrapper->GetCompressed(JpegQuality));
+	}
+
+	AviWriter.Finish();
+
+	const int32 NumFramesEncoded = AviWriter.GetNumFrames();
+	const bool bClosed = Writer->Close();
+	Writer.Reset();
+
+	if (!bClosed || NumFramesEncoded == 0)
+	{
+		IFileManager::Get().Delete(*VideoPath, false, true, true);
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Encoded %d raw frames into %s."), NumFramesEncoded, *VideoPath);
+
+	return true;
+}
+
+void FSentryCrashVideoRawRing::ConvertToI420(const FColor* Pixels, int32 Width, int32 Height, uint8* OutI420)
+{
+	uint8* PlaneY = OutI420;
+	uint8* PlaneU = PlaneY + Width * Height;
+	uint8* PlaneV = PlaneU + (Width / 2) * (Height / 2);
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const FColor& Color = Pixels[Y * Width + X];
+			PlaneY[Y * Width + X] = static_cast<uint8>(((66 * Color.R + 129 * Color.G + 25 * Color.B + 128) >> 8) + 16);
+		}
+	}
+
+	for (int32 Y = 0; Y < Height / 2; ++Y)
+	{
+		for (int32 X = 0; X < Width / 2; ++X)
+		{
+			const FColor& TopLeft = Pixels[(2 * Y) * Width + 2 * X];
+			const FColor& TopRight = Pixels[(2 * Y) * Width + 2 * X + 1];
+			const FColor& BottomLeft = Pixels[(2 * Y + 1) * Width + 2 * X];
+			const FColor& BottomRight = Pixels[(2 * Y + 1) * Width + 2 * X + 1];
+
+			const int32 R = (TopLeft.R + TopRight.R + BottomLeft.R + BottomRight.R + 2) / 4;
+			const int32 G = (TopLeft.G + TopRight.G + BottomLeft.G + BottomRight.G + 2) / 4;
+			const int32 B = (TopLeft.B + TopRight.B + BottomLeft.B + BottomRight.B + 2) / 4;
+
+			PlaneU[Y * (Width / 2) + X] = static_cast<uint8>(((-38 * R - 74 * G + 112 * B + 128) >> 8) + 128);
+			PlaneV[Y * (Width / 2) + X] = static_cast<uint8>(((112 * R - 94 * G - 18 * B + 128) >> 8) + 128);
+		}
+	}
+}
+
+void FSentryCrashVideoRawRing::ConvertFromI420(const uint8* I420, int32 Width, int32 Height, FColor* OutPixels)
+{
+	const uint8* PlaneY = I420;
+	const uint8* PlaneU = PlaneY + Width * Height;
+	const uint8* PlaneV = PlaneU + (Width / 2) * (Height / 2);
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 C = PlaneY[Y * Width + X] - 16;
+			const int32 D = PlaneU[(Y / 2) * (Width / 2) + X / 2] - 128;
+			const int32 E = PlaneV[(Y / 2) * (Width / 2) + X / 2] - 128;
+
+			OutPixels[Y * Width + X] = FColor(
+				static_cast<uint8>(FMath::Clamp((298 * C + 409 * E + 128) >> 8, 0, 255)),
+				static_cast<uint8>(FMath::Clamp((298 * C - 100 * D - 208 * E + 128) >> 8, 0, 255)),
+				static_cast<uint8>(FMath::Clamp((298 * C + 516 * D + 128) >> 8, 0, 255)),
+				255);
+		}
+	}
+}
+
+void FSentryCrashVideoRawRing::Downscale(const FColor* Pixels, int32 Width, int32 Height, FColor* OutPixels, int32 OutWidth, int32 OutHeight)
+{
+	for (int32 Y = 0; Y < OutHeight; ++Y)
+	{
+		const int32 SourceY0 = Y * Height / OutHeight;
+		const int32 SourceY1 = FMath::Max(SourceY0 + 1, (Y + 1) * Height / OutHeight);
+
+		for (int32 X = 0; X < OutWidth; ++X)
+		{
+			const int32 SourceX0 = X * Width / OutWidth;
+			const int32 SourceX1 = FMath::Max(SourceX0 + 1, (X + 1) * Width / OutWidth);
+
+			uint32 R = 0;
+			uint32 G = 0;
+			uint32 B = 0;
+			for (int32 SourceY = SourceY0; SourceY < SourceY1; ++SourceY)
+			{
+				for (int32 SourceX = SourceX0; SourceX < SourceX1; ++SourceX)
+				{
+					const FColor& Color = Pixels[SourceY * Width + SourceX];
+					R += Color.R;
+					G += Color.G;
+					B += Color.B;
+				}
+			}
+
+			const uint32 NumPixels = (SourceY1 - SourceY0) * (SourceX1 - SourceX0);
+			OutPixels[Y * OutWidth + X] = FColor(
+				static_cast<uint8>((R + NumPixels / 2) / NumPixels),
+				static_cast<uint8>((G + NumPixels / 2) / NumPixels),
+				static_cast<uint8>((B + NumPixels / 2) / NumPixels),
+				255);
+		}
+	}
+}
+
+void FSentryCrashVideoRawRing::SetTiles(const TArray<const SWindow*>& Windows, uint32 Layout)
+{
+	// Readbacks still in flight are released along with their tiles, the frames they carry are simply lost
+	Tiles.Empty(Windows.Num());
+
+	for (int32 TileIndex = 0; TileIndex < Windows.Num(); ++TileIndex)
+	{
+		FCapturedTile& Tile = Tiles.AddDefaulted_GetRef();
+		Tile.Window = Windows[TileIndex];
+		Tile.Rect = GetTileRect(TileIndex, Windows.Num(), Config.FrameWidth, Config.FrameHeight);
+	}
+
+	TilesLayout = Layout;
+	NextTileIndex = 0;
+
+	// Tiles are black until their windows are captured with the new layout, as are the areas not covered by any tile
+	TiledFrame.Init(FColor::Black, Config.FrameWidth * Config.FrameHeight);
+}
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+void FSentryCrashVideoRawRing::OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer)
+#else
+void FSentryCrashVideoRawRing::OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer)
+#endif
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	check(IsInRenderingThread());
+
+	if (!bIsActive || !BackBuffer.IsValid())
+	{
+		return;
+	}
+
+	const int32 TileIndex = Tiles.IndexOfByPredicate([&Window](const FCapturedTile& Tile) { return Tile.Window == &Window; });
+	if (TileIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Readbacks are polled instead of waited for so capturing never stalls the render thread
+	FCapturedTile* InFlightTile = Tiles.FindByPredicate([](const FCapturedTile& Tile) { return Tile.bIsReadbackInFlight; });
+	if (InFlightTile && InFlightTile->Readback->IsReady())
+	{
+		InFlightTile->bIsReadbackInFlight = false;
+		ResolveReadback(*InFlightTile);
+		InFlightTile = nullptr;
+	}
+
+	// Redacted widget rectangles are tracked for the game viewport window only, other windows are left out rather than leaked
+	const bool bHasRedactedWidgets = FSentryRedactedWidgets::Get().HasWidgets();
+	if (TileIndex > 0 && bHasRedactedWidgets)
+	{
+		return;
+	}
+
+	Tiles[TileIndex].LastPresentTime = Now;
+
+	// Windows take turns, one is read back per capture, and windows that can't be captured (e.g. minimized) lose their turn
+	const int32 TurnIndex = FMath::Min(NextTileIndex, Tiles.Num() - 1);
+	const bool bTurnIsTaken = !(TurnIndex > 0 && bHasRedactedWidgets) && Now - Tiles[TurnIndex].LastPresentTime < 1.0;
+	if (TileIndex != TurnIndex && bTurnIsTaken)
+	{
+		return;
+	}
+
+	// Frames are picked from the present timeline on a fixed cadence, the ones in between cost nothing else
+	if (!CaptureCadence.ShouldCapture(Now))
+	{
+		return;
+	}
+
+	if (InFlightTile)
+	{
+		// Previous frame is still in flight, dropping this one keeps the GPU work from queueing up
+		CaptureCadence.OnDropped();
+		return;
+	}
+
+	FCapturedTile& Tile = Tiles[TileIndex];
+	if (!Tile.Readback.IsValid())
+	{
+		Tile.Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("SentryCrashVideoRawRing"));
+	}
+
+	const EPixelFormat Format = BackBuffer->GetFormat();
+	if (Format != PF_B8G8R8A8 && Format != PF_R8G8B8A8 && Format != PF_A2B10G10R10)
+	{
+		return;
+	}
+
+	Tile.ReadbackSize = BackBuffer->GetSizeXY();
+	Tile.ReadbackFormat = Format;
+
+	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+
+	const FSentryTextureRHIRef Source = FSentryRedactedWidgets::Get().Apply(RHICmdList, Window, BackBuffer, Tile.PrivacyMaskTarget);
+	if (!Source.IsValid())
+	{
+		return;
+	}
+
+	Tile.Readback->EnqueueCopy(RHICmdList, Source);
+	Tile.bIsReadbackInFlight = true;
+
+	NextTileIndex = (TileIndex + 1) % Tiles.Num();
+#endif
+}
+
+void FSentryCrashVideoRawRing::ResolveReadback(FCapturedTile& Tile)
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	int32 RowPitchInPixels = 0;
+	const uint8* Data = static_cast<const uint8*>(Tile.Readback->Lock(RowPitchInPixels));
+	if (!Data)
+	{
+		Tile.Readback->Unlock();
+		return;
+	}
+
+	// Windows keep their aspect ratio within the tile, the bars are cleared whenever the window is resized
+	const FIntRect ImageRect = GetLetterboxRect(Tile.Rect, Tile.ReadbackSize);
+	if (ImageRect != Tile.ImageRect)
+	{
+		for (int32 Y = Tile.Rect.Min.Y; Y < Tile.Rect.Max.Y; ++Y)
+		{
+			for (int32 X = Tile.Rect.Min.X; X < Tile.Rect.Max.X; ++X)
+			{
+				TiledFrame[Y * Config.FrameWidth + X] = FColor::Black;
+			}
+		}
+
+		Tile.ImageRect = ImageRect;
+	}
+
+	const int32 ImageWidth = ImageRect.Width();
+	const int32 ImageHeight = ImageRect.Height();
+
+	// Nearest sampling keeps the render thread cost to a copy of the downscaled tile
+	for (int32 Y = 0; Y < ImageHeight; ++Y)
+	{
+		const int32 SourceY = Y * Tile.ReadbackSize.Y / ImageHeight;
+		const uint32* SourceRow = reinterpret_cast<const uint32*>(Data) + SourceY * RowPitchInPixels;
+		FColor* TargetRow = &TiledFrame[(ImageRect.Min.Y + Y) * Config.FrameWidth + ImageRect.Min.X];
+
+		for (int32 X = 0; X < ImageWidth; ++X)
+		{
+			const uint32 Pixel = SourceRow[X * Tile.ReadbackSize.X / ImageWidth];
+
+			FColor& Color = TargetRow[X];
+			switch (Tile.ReadbackFormat)
+			{
+			case PF_R8G8B8A8:
+				Color = FColor(Pixel & 0xFF, (Pixel >> 8) & 0xFF, (Pixel >> 16) & 0xFF, 255);
+				break;
+			case PF_A2B10G10R10:
+				Color = FColor(((Pixel >> 0) & 0x3FF) >> 2, ((Pixel >> 10) & 0x3FF) >> 2, ((Pixel >> 20) & 0x3FF) >> 2, 255);
+				break;
+			default:
+				Color = FColor((Pixel >> 16) & 0xFF, (Pixel >> 8) & 0xFF, Pixel & 0xFF, 255);
+				break;
+			}
+		}
+	}
+
+	Tile.Readback->Unlock();
+
+	// Previous frame is still being compressed, dropping this one keeps the background thread from falling behind
+	if (bIsWriting)
+	{
+		CaptureCadence.OnDropped();
+		return;
+	}
+
+	bIsWriting = true;
+
+	// With several tiles every capture completes the frame, the other tiles show the last image of their windows
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Frame = TiledFrame, Layout = TilesLayout]()
+	{
+		WriteFrame(Frame, Layout);
+		bIsWriting = false;
+	});
+#endif
+}
+
+void FSentryCrashVideoRawRing::WriteFrame(const TArray<FColor>& Frame, uint32 Layout)
+{
+	using namespace SentryCrashVideoRawRing;
+
+	const int32 I420Size = GetI420Size(Config.FrameWidth, Config.FrameHeight);
+	if (Frame.Num() != Config.FrameWidth * Config.FrameHeight)
+	{
+		return;
+	}
+
+	I420Buffer.SetNumUninitialized(I420Size);
+	ConvertToI420(Frame.GetData(), Config.FrameWidth, Config.FrameHeight, I420Buffer.GetData());
+
+	{
+		FScopeLock Lock(&RingCriticalSection);
+
+		if (!MappedFile)
+		{
+			// Recording was stopped in the meantime
+			return;
+		}
+
+		WriteSlot(*MappedFile, I420Buffer.GetData(), I420Size, Layout);
+	}
+
+	if (Config.LongTierMaxFrames > 0)
+	{
+		WriteLongTierFrame(Frame);
+	}
+}
+
+void FSentryCrashVideoRawRing::WriteLongTierFrame(const TArray<FColor>& Frame)
+{
+	using namespace SentryCrashVideoRawRing;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextLongTierFrameTime)
+	{
+		return;
+	}
+
+	// Due times advance by whole intervals to keep the rate steady, unless frames were missing for longer than that
+	const double Interval = 1.0 / Config.LongTierFramesPerSecond;
+	NextLongTierFrameTime = Now - NextLongTierFrameTime > Interval ? Now + Interval : NextLongTierFrameTime + Interval;
+
+	const int32 Width = Config.LongTierFrameWidth;
+	const int32 Height = Config.LongTierFrameHeight;
+	const int32 I420Size = GetI420Size(Width, Height);
+
+	LongTierFrame.SetNumUninitialized(Width * Height);
+	Downscale(Frame.GetData(), Config.FrameWidth, Config.FrameHeight, LongTierFrame.GetData(), Width, Height);
+
+	LongTierI420Buffer.SetNumUninitialized(I420Size);
+	ConvertToI420(LongTierFrame.GetData(), Width, Height, LongTierI420Buffer.GetData());
+
+	FScopeLock Lock(&RingCriticalSection);
+
+	if (LongTierMappedFile)
+	{
+		WriteSlot(*LongTierMappedFile, LongTierI420Buffer.GetData(), I420Size, 0);
+	}
+}
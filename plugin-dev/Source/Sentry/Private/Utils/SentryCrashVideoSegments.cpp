@@ -0,0 +1,317 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Utils/SentryCrashVideoSegments.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+FSentryCrashVideoSegments& FSentryCrashVideoSegments::Get()
+{
+	static FSentryCrashVideoSegments Instance;
+	return Instance;
+}
+
+void FSentryCrashVideoSegments::Configure(int32 InMaxSegments)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	MaxSegments = FMath::Max(1, InMaxSegments);
+
+	Segments.Empty(MaxSegments + 1);
+	LastSegmentEndTime = FPlatformTime::Seconds();
+}
+
+void FSentryCrashVideoSegments::ConfigureBookmarks(float InWindowSeconds, int64 InMaxPinnedBytes)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	BookmarkWindowSeconds = FMath::Max(0.0f, InWindowSeconds);
+	MaxPinnedBytes = FMath::Max<int64>(0, InMaxPinnedBytes);
+}
+
+TArray<FString> FSentryCrashVideoSegments::SetMaxSegments(int32 InMaxSegments)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	MaxSegments = FMath::Max(1, InMaxSegments);
+
+	return EvictExcessSegments();
+}
+
+TArray<FString> FSentryCrashVideoSegments::AddSegment(const FString& SegmentPath)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const double Now = FPlatformTime::Seconds();
+
+	FSegment& Segment = Segments.AddDefaulted_GetRef();
+	Segment.Path = SegmentPath;
+	Segment.StartTime = LastSegmentEndTime;
+	Segment.EndTime = Now;
+
+	LastSegmentEndTime = Now;
+
+	// Segments of a recording share a directory so this rarely happens more than once per recording
+	const FString SegmentDirectory = FPaths::GetPath(SegmentPath);
+	if (SegmentDirectory != Directory)
+	{
+		Directory = SegmentDirectory;
+		IndexPath = FPaths::Combine(Directory, TEXT("crash_video_segments.ffconcat"));
+		TimelinePath = FPaths::Combine(Directory, TEXT("crash_video_timeline.bin"));
+	}
+
+	return EvictExcessSegments();
+}
+
+TArray<FString> FSentryCrashVideoSegments::EvictExcessSegments()
+{
+	TArray<FString> EvictedSegments;
+
+	bool bHasPinned = false;
+
+	while (Segments.Num() > MaxSegments)
+	{
+		FSegment Segment = MoveTemp(Segments[0]);
+		Segments.RemoveAt(0);
+
+		if (MaxPinnedBytes > 0 && IsBookmarked(Segment))
+		{
+			Segment.Size = FMath::Max<int64>(0, FPlatformFileManager::Get().GetPlatformFile().FileSize(*Segment.Path));
+			PinnedBytes += Segment.Size;
+			PinnedSegments.Add(MoveTemp(Segment));
+			bHasPinned = true;
+			continue;
+		}
+
+		EvictedSegments.Add(MoveTemp(Segment.Path));
+	}
+
+	if (bHasPinned)
+	{
+		EvictedSegments.Append(ReleasePinnedSegments());
+	}
+
+	return EvictedSegments;
+}
+
+bool FSentryCrashVideoSegments::Overlaps(const FSegment& Segment, const FBookmark& Bookmark) const
+{
+	return Segment.EndTime >= Bookmark.Time - BookmarkWindowSeconds && Segment.StartTime <= Bookmark.Time + BookmarkWindowSeconds;
+}
+
+bool FSentryCrashVideoSegments::IsBookmarked(const FSegment& Segment) const
+{
+	for (const FBookmark& Bookmark : Bookmarks)
+	{
+		if (Overlaps(Segment, Bookmark))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TArray<FString> FSentryCrashVideoSegments::ReleasePinnedSegments()
+{
+	TArray<FString> ReleasedSegments;
+
+	for (int32 Index = PinnedSegments.Num() - 1; Index >= 0; --Index)
+	{
+		if (!IsBookmarked(PinnedSegments[Index]))
+		{
+			PinnedBytes -= PinnedSegments[Index].Size;
+			ReleasedSegments.Add(MoveTemp(PinnedSegments[Index].Path));
+			PinnedSegments.RemoveAt(Index);
+		}
+	}
+
+	// Oldest footage goes first, which may leave the oldest bookmarks with only part of their window
+	while (PinnedSegments.Num() > 0 && PinnedBytes > MaxPinnedBytes)
+	{
+		PinnedBytes -= PinnedSegments[0].Size;
+		ReleasedSegments.Add(MoveTemp(PinnedSegments[0].Path));
+		PinnedSegments.RemoveAt(0);
+	}
+
+	return ReleasedSegments;
+}
+
+TArray<FString> FSentryCrashVideoSegments::GetSegments() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	TArray<FString> Result;
+	Result.Reserve(Segments.Num());
+	for (const FSegment& Segment : Segments)
+	{
+		Result.Add(Segment.Path);
+	}
+
+	return Result;
+}
+
+void FSentryCrashVideoSegments::GetPaths(FString& OutDirectory, FString& OutIndexPath, FString& OutTimelinePath) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	OutDirectory = Directory;
+	OutIndexPath = IndexPath;
+	OutTimelinePath = TimelinePath;
+}
+
+bool FSentryCrashVideoSegments::HasSegments() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Segments.Num() > 0;
+}
+
+void FSentryCrashVideoSegments::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	Segments.Empty();
+	PinnedSegments.Empty();
+	PinnedBytes = 0;
+	Bookmarks.Empty();
+
+	LastSegmentEndTime = FPlatformTime::Seconds();
+}
+
+TArray<FString> FSentryCrashVideoSegments::AddBookmark(const FString& Name, double Time)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	Bookmarks.RemoveAll([&Name](const FBookmark& Bookmark) { return Bookmark.Name == Name; });
+
+	FBookmark& Bookmark = Bookmarks.AddDefaulted_GetRef();
+	Bookmark.Name = Name;
+	Bookmark.Time = Time;
+
+	return ReleasePinnedSegments();
+}
+
+TArray<FString> FSentryCrashVideoSegments::RemoveBookmark(const FString& Name)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (Bookmarks.RemoveAll([&Name](const FBookmark& Bookmark) { return Bookmark.Name == Name; }) == 0)
+	{
+		return TArray<FString>();
+	}
+
+	return ReleasePinnedSegments();
+}
+
+bool FSentryCrashVideoSegments::HasBookmark(const FString& Name) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	return Bookmarks.ContainsByPredicate([&Name](const FBookmark& Bookmark) { return Bookmark.Name == Name; });
+}
+
+TArray<FString> FSentryCrashVideoSegments::GetBookmarkNames() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	TArray<FString> Names;
+	for (const FBookmark& Bookmark : Bookmarks)
+	{
+		Names.Add(Bookmark.Name);
+	}
+
+	return Names;
+}
+
+TArray<FString> FSentryCrashVideoSegments::GetBookmarkSegments(const FString& Name) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	TArray<FString> Result;
+
+	const FBookmark* Bookmark = Bookmarks.FindByPredicate([&Name](const FBookmark& Candidate) { return Candidate.Name == Name; });
+	if (!Bookmark)
+	{
+		return Result;
+	}
+
+	// Pinned segments are all older than the ones still in the ring
+	for (const TArray<FSegment>* List : { &PinnedSegments, &Segments })
+	{
+		for (const FSegment& Segment : *List)
+		{
+			if (Overlaps(Segment, *Bookmark))
+			{
+				Result.Add(Segment.Path);
+			}
+		}
+	}
+
+	return Result;
+}
+
+int64 FSentryCrashVideoSegments::GetPinnedBytes() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return PinnedBytes;
+}
+
+TArray<FString> FSentryCrashVideoSegments::GetNewestSegmentsWithinSize(int64 MaxBytes) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (MaxBytes <= 0)
+	{
+		TArray<FString> Result;
+		for (const FSegment& Segment : Segments)
+		{
+			Result.Add(Segment.Path);
+		}
+
+		return Result;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	int64 TotalBytes = 0;
+	int32 FirstSegmentIndex = Segments.Num();
+
+	for (int32 i = Segments.Num() - 1; i >= 0; --i)
+	{
+		TotalBytes += FMath::Max<int64>(0, PlatformFile.FileSize(*Segments[i].Path));
+		if (TotalBytes > MaxBytes)
+		{
+			break;
+		}
+
+		FirstSegmentIndex = i;
+	}
+
+	TArray<FString> Result;
+	for (int32 i = FirstSegmentIndex; i < Segments.Num(); ++i)
+	{
+		Result.Add(Segments[i].Path);
+	}
+
+	return Result;
+}
+
+bool FSentryCrashVideoSegments::WriteIndex(const FString& IndexPath, const TArray<FString>& SegmentPaths)
+{
+	if (SegmentPaths.Num() == 0)
+	{
+		return false;
+	}
+
+	// Segments can be joined without re-encoding with `ffmpeg -f concat -safe 0 -i <index> -c copy out.mp4`
+	FString Index = TEXT("ffconcat version 1.0\n");
+	for (const FString& Segment : SegmentPaths)
+	{
+		Index += FString::Printf(TEXT("file '%s'\n"), *FPaths::GetCleanFilename(Segment));
+	}
+
+	return FFileHelper::SaveStringToFile(Index, *IndexPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
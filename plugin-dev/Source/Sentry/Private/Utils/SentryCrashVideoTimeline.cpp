@@ -0,0 +1,173 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Utils/SentryCrashVideoTimeline.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/CoreMisc.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+namespace SentryCrashVideoTimeline
+{
+	static constexpr uint32 Magic = 0x54565253; // "SRVT"
+	static constexpr uint32 Version = 1;
+}
+
+FSentryCrashVideoTimeline& FSentryCrashVideoTimeline::Get()
+{
+	static FSentryCrashVideoTimeline Instance;
+	return Instance;
+}
+
+void FSentryCrashVideoTimeline::Start(int32 MaxFrames)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		Frames.SetNumZeroed(FMath::Clamp(MaxFrames, 60, 64 * 1024));
+		NumFramesWritten = 0;
+
+		FMemory::Memzero(Videos);
+		NumVideosStarted = 0;
+	}
+
+	LastFrameBreadcrumbId = static_cast<uint32>(LastBreadcrumbId.GetValue());
+	VideoStartSeconds = FPlatformTime::Seconds();
+
+	bIsActive = true;
+
+	OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSentryCrashVideoTimeline::OnEndFrame);
+}
+
+void FSentryCrashVideoTimeline::Stop()
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+	OnEndFrameHandle.Reset();
+
+	FScopeLock Lock(&CriticalSection);
+
+	Frames.Empty();
+	NumFramesWritten = 0;
+	NumVideosStarted = 0;
+}
+
+void FSentryCrashVideoTimeline::OnVideoStarted(const FString& VideoPath)
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	VideoStartSeconds = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&CriticalSection);
+
+	FVideo& Video = Videos[NumVideosStarted % MaxVideos];
+	Video.VideoIndex = static_cast<uint32>(NumVideosStarted);
+	Video.StartTimestampUs = GetTimestampUs();
+	FCStringAnsi::Strncpy(Video.FileName, TCHAR_TO_UTF8(*FPaths::GetCleanFilename(VideoPath)), UE_ARRAY_COUNT(Video.FileName));
+
+	++NumVideosStarted;
+}
+
+uint32 FSentryCrashVideoTimeline::OnBreadcrumbAdded()
+{
+	return static_cast<uint32>(LastBreadcrumbId.Increment());
+}
+
+void FSentryCrashVideoTimeline::OnEndFrame()
+{
+	const uint32 BreadcrumbId = static_cast<uint32>(LastBreadcrumbId.GetValue());
+
+	FFrame Frame;
+	Frame.FrameNumber = GFrameCounter;
+	Frame.TimestampUs = GetTimestampUs();
+	Frame.VideoSeconds = static_cast<float>(FPlatformTime::Seconds() - VideoStartSeconds);
+	Frame.VideoIndex = static_cast<uint32>(FMath::Max(0, NumVideosStarted - 1));
+	Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Frame.GpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+	Frame.FirstBreadcrumbId = LastFrameBreadcrumbId + 1;
+	Frame.NumBreadcrumbs = BreadcrumbId - LastFrameBreadcrumbId;
+	Frame.Padding = 0;
+
+	LastFrameBreadcrumbId = BreadcrumbId;
+
+	FScopeLock Lock(&CriticalSection);
+
+	Frames[NumFramesWritten % Frames.Num()] = Frame;
+	++NumFramesWritten;
+}
+
+bool FSentryCrashVideoTimeline::Write(const FString& Path) const
+{
+	// Crashed thread might be the one holding the lock so waiting for it isn't an option
+	if (!CriticalSection.TryLock())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Crash video timeline is being updated and can't be written"));
+		return false;
+	}
+
+	bool bWritten = false;
+
+	if (NumFramesWritten > 0)
+	{
+		if (FArchive* Writer = IFileManager::Get().CreateFileWriter(*Path))
+		{
+			const int32 NumFrames = static_cast<int32>(FMath::Min<int64>(NumFramesWritten, Frames.Num()));
+			const int32 NumVideos = FMath::Min(NumVideosStarted, MaxVideos);
+
+			uint32 Header[4] = { SentryCrashVideoTimeline::Magic, SentryCrashVideoTimeline::Version, static_cast<uint32>(NumVideos), static_cast<uint32>(NumFrames) };
+			Writer->Serialize(Header, sizeof(Header));
+
+			for (int32 Index = NumVideosStarted - NumVideos; Index < NumVideosStarted; ++Index)
+			{
+				Writer->Serialize(const_cast<FVideo*>(&Videos[Index % MaxVideos]), sizeof(FVideo));
+			}
+
+			// Ring is unwrapped so that frames are written from the oldest to the newest
+			const int32 OldestIndex = static_cast<int32>((NumFramesWritten - NumFrames) % Frames.Num());
+			const int32 NumUntilEnd = FMath::Min(NumFrames, Frames.Num() - OldestIndex);
+
+			Writer->Serialize(const_cast<FFrame*>(Frames.GetData() + OldestIndex), NumUntilEnd * sizeof(FFrame));
+			Writer->Serialize(const_cast<FFrame*>(Frames.GetData()), (NumFrames - NumUntilEnd) * sizeof(FFrame));
+
+			bWritten = Writer->Close();
+			delete Writer;
+		}
+	}
+
+	CriticalSection.Unlock();
+
+	return bWritten;
+}
+
+int64 FSentryCrashVideoTimeline::GetTimestampUs()
+{
+	return (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryDatabaseMaintenance.h"
+
+#include "SentryDefines.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+namespace SentryDatabaseMaintenance
+{
+	/** Crashpad report directories across platforms, the database root also holds files owned by sentry-native. */
+	static const TCHAR* ReportDirectories[] = { TEXT("reports"), TEXT("completed"), TEXT("pending"), TEXT("new"), TEXT("attachments") };
+
+	struct FReportFile
+	{
+		FString Path;
+		FDateTime Timestamp;
+		int64 Size;
+	};
+}
+
+void FSentryDatabaseMaintenance::PruneAsync(const FString& DatabasePath, const FSentryDatabaseRetention& Retention)
+{
+	if (!Retention.IsEnabled())
+	{
+		return;
+	}
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [DatabasePath, Retention]()
+	{
+		const int32 NumDeleted = Prune(DatabasePath, Retention, FDateTime::UtcNow());
+		if (NumDeleted > 0)
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("Pruned %d crash report files from the Sentry database."), NumDeleted);
+		}
+	});
+}
+
+int32 FSentryDatabaseMaintenance::Prune(const FString& DatabasePath, const FSentryDatabaseRetention& Retention, const FDateTime& Now)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<SentryDatabaseMaintenance::FReportFile> Files;
+	int64 TotalSize = 0;
+
+	for (const TCHAR* ReportDirectory : SentryDatabaseMaintenance::ReportDirectories)
+	{
+		const FString Directory = FPaths::Combine(DatabasePath, ReportDirectory);
+		if (!PlatformFile.DirectoryExists(*Directory))
+		{
+			continue;
+		}
+
+		PlatformFile.IterateDirectoryStatRecursively(*Directory, [&Files, &TotalSize](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+			{
+				Files.Add({ Path, StatData.ModificationTime, StatData.FileSize });
+				TotalSize += StatData.FileSize;
+			}
+			return true;
+		});
+	}
+
+	Files.Sort([](const SentryDatabaseMaintenance::FReportFile& A, const SentryDatabaseMaintenance::FReportFile& B)
+	{
+		return A.Timestamp < B.Timestamp;
+	});
+
+	const FDateTime OldestAllowed = Now - FTimespan::FromDays(Retention.MaxAgeDays);
+
+	int32 NumDeleted = 0;
+
+	for (const SentryDatabaseMaintenance::FReportFile& File : Files)
+	{
+		const bool bTooOld = Retention.MaxAgeDays > 0 && File.Timestamp < OldestAllowed;
+		const bool bOverSize = Retention.MaxSizeBytes > 0 && TotalSize > Retention.MaxSizeBytes;
+		if (!bTooOld && !bOverSize)
+		{
+			// Files are sorted by age so the rest is within both limits
+			break;
+		}
+
+		if (IFileManager::Get().Delete(*File.Path, false, false, true))
+		{
+			TotalSize -= File.Size;
+			++NumDeleted;
+		}
+	}
+
+	return NumDeleted;
+}
@@ -0,0 +1,37 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Limits applied to the crash reports kept in the Sentry database. */
+struct FSentryDatabaseRetention
+{
+	/** Max age of a crash report in days, 0 for no limit. */
+	int32 MaxAgeDays = 0;
+
+	/** Max total size of the crash reports in bytes, 0 for no limit. */
+	int64 MaxSizeBytes = 0;
+
+	bool IsEnabled() const { return MaxAgeDays > 0 || MaxSizeBytes > 0; }
+};
+
+/**
+ * Prunes the crash reports piling up in the Sentry database while the machine is offline.
+ *
+ * Only the Crashpad report directories are touched. Envelopes spooled by the transport are limited by the spool itself
+ * and retried from the transport thread, unfinished runs are processed by sentry-native on initialization.
+ */
+class FSentryDatabaseMaintenance
+{
+public:
+	/** Prunes the database on a background thread so that it doesn't delay the startup. */
+	static void PruneAsync(const FString& DatabasePath, const FSentryDatabaseRetention& Retention);
+
+	/**
+	 * Deletes the crash report files exceeding the retention limits, oldest first.
+	 *
+	 * @return Number of deleted files.
+	 */
+	static int32 Prune(const FString& DatabasePath, const FSentryDatabaseRetention& Retention, const FDateTime& Now);
+};
@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryDeferredCallbacks.h"
+
+#include "SentryCallbackUtils.h"
+
+#include "Async/Async.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UObjectGlobals.h"
+
+FSentryDeferredCallbacks::FSentryDeferredCallbacks(int32 InCapacity)
+	: Capacity(FMath::Max(InCapacity, 1))
+	, bIsFlushScheduled(false)
+{
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FSentryDeferredCallbacks::Flush);
+}
+
+FSentryDeferredCallbacks::~FSentryDeferredCallbacks()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	Discard();
+}
+
+bool FSentryDeferredCallbacks::Defer(FCallback&& Callback)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (Callbacks.Num() >= Capacity)
+	{
+		return false;
+	}
+
+	Callbacks.Add(MoveTemp(Callback));
+
+	// Post garbage collection delegate picks up the callbacks queued during GC, post-load has no such notification
+	if (!IsGarbageCollecting())
+	{
+		ScheduleFlush();
+	}
+
+	return true;
+}
+
+void FSentryDeferredCallbacks::Flush()
+{
+	check(IsInGameThread());
+
+	TArray<FCallback> CallbacksToRun;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		if (Callbacks.Num() == 0)
+		{
+			return;
+		}
+
+		if (!SentryCallbackUtils::IsCallbackSafeToRun())
+		{
+			ScheduleFlush();
+			return;
+		}
+
+		CallbacksToRun = MoveTemp(Callbacks);
+	}
+
+	for (FCallback& Callback : CallbacksToRun)
+	{
+		Callback(true);
+	}
+}
+
+void FSentryDeferredCallbacks::Discard()
+{
+	TArray<FCallback> CallbacksToDiscard;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		CallbacksToDiscard = MoveTemp(Callbacks);
+	}
+
+	for (FCallback& Callback : CallbacksToDiscard)
+	{
+		Callback(false);
+	}
+}
+
+int32 FSentryDeferredCallbacks::Num() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Callbacks.Num();
+}
+
+void FSentryDeferredCallbacks::ScheduleFlush()
+{
+	if (bIsFlushScheduled)
+	{
+		return;
+	}
+
+	bIsFlushScheduled = true;
+
+	TWeakPtr<FSentryDeferredCallbacks, ESPMode::ThreadSafe> WeakThis = AsShared();
+	AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+	{
+		TSharedPtr<FSentryDeferredCallbacks, ESPMode::ThreadSafe> PinnedThis = WeakThis.Pin();
+		if (!PinnedThis)
+		{
+			return;
+		}
+
+		{
+			FScopeLock Lock(&PinnedThis->CriticalSection);
+			PinnedThis->bIsFlushScheduled = false;
+		}
+
+		PinnedThis->Flush();
+	});
+}
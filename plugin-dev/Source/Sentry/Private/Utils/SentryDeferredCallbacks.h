@@ -0,0 +1,49 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+
+/**
+ * Holds the work of custom callback handlers that can't run at the moment because UObjects can't be created
+ * (see `SentryCallbackUtils::IsCallbackSafeToRun`) and runs it on the game thread as soon as garbage collection or post-load is over.
+ *
+ * Callbacks are invoked with `bCanRun` set to false when they are discarded instead, so that they can release what they hold.
+ */
+class FSentryDeferredCallbacks : public TSharedFromThis<FSentryDeferredCallbacks, ESPMode::ThreadSafe>
+{
+public:
+	using FCallback = TFunction<void(bool bCanRun)>;
+
+	explicit FSentryDeferredCallbacks(int32 InCapacity);
+	~FSentryDeferredCallbacks();
+
+	/**
+	 * Queues the callback until handlers can run. Can be called from any thread.
+	 *
+	 * @return False if the queue is full, in which case the callback isn't taken.
+	 */
+	bool Defer(FCallback&& Callback);
+
+	/** Runs the queued callbacks if handlers can run, otherwise retries later. Must be called on the game thread. */
+	void Flush();
+
+	/** Drops the queued callbacks without running them. */
+	void Discard();
+
+	int32 Num() const;
+
+private:
+	void ScheduleFlush();
+
+	TArray<FCallback> Callbacks;
+	mutable FCriticalSection CriticalSection;
+
+	int32 Capacity;
+	bool bIsFlushScheduled;
+
+	FDelegateHandle PostGarbageCollectHandle;
+};
@@ -0,0 +1,271 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryDeviceConditions.h"
+
+#include "SentryDefines.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/EngineVersionComparison.h"
+
+namespace SentryDeviceConditions
+{
+	/** CPU clocked below this share of its max is considered throttled if it stays there. */
+	static constexpr float ThrottledCpuFrequencyRatio = 0.6f;
+
+	/** CPU clocked above this share of its max is no longer considered throttled. */
+	static constexpr float RecoveredCpuFrequencyRatio = 0.8f;
+
+	/** Change of a clock that is worth updating the context for. */
+	static constexpr float SignificantFrequencyChangeRatio = 0.1f;
+
+	static bool HasChangedSignificantly(int32 Previous, int32 Current)
+	{
+		if ((Previous > 0) != (Current > 0))
+		{
+			return true;
+		}
+
+		return Previous > 0 && FMath::Abs(Current - Previous) > Previous * SignificantFrequencyChangeRatio;
+	}
+}
+
+bool FSentryDeviceConditions::IsThermallyThrottled() const
+{
+	return ThermalState >= ESentryThermalState::Serious;
+}
+
+bool FSentryDeviceConditions::HasReducedClock() const
+{
+	return CpuFrequencyMHz > 0 && CpuMaxFrequencyMHz > 0 && CpuFrequencyMHz < CpuMaxFrequencyMHz * SentryDeviceConditions::ThrottledCpuFrequencyRatio;
+}
+
+bool FSentryDeviceConditions::HasRecoveredClock() const
+{
+	return CpuFrequencyMHz <= 0 || CpuMaxFrequencyMHz <= 0 || CpuFrequencyMHz >= CpuMaxFrequencyMHz * SentryDeviceConditions::RecoveredCpuFrequencyRatio;
+}
+
+bool FSentryDeviceConditions::HasChangedSince(const FSentryDeviceConditions& Previous) const
+{
+	return ThermalState != Previous.ThermalState
+		|| bIsCharging != Previous.bIsCharging
+		|| BatteryLevel != Previous.BatteryLevel
+		|| bIsThrottled != Previous.bIsThrottled
+		|| SentryDeviceConditions::HasChangedSignificantly(Previous.CpuFrequencyMHz, CpuFrequencyMHz)
+		|| SentryDeviceConditions::HasChangedSignificantly(Previous.GpuFrequencyMHz, GpuFrequencyMHz);
+}
+
+FString FSentryDeviceConditions::ThermalStateToString(ESentryThermalState State)
+{
+	switch (State)
+	{
+	case ESentryThermalState::Nominal:
+		return TEXT("nominal");
+	case ESentryThermalState::Fair:
+		return TEXT("fair");
+	case ESentryThermalState::Serious:
+		return TEXT("serious");
+	case ESentryThermalState::Critical:
+		return TEXT("critical");
+	default:
+		return TEXT("unknown");
+	}
+}
+
+bool FSentryThrottleDetector::Update(const FSentryDeviceConditions& Conditions)
+{
+	bIsThermallyThrottled = Conditions.IsThermallyThrottled();
+
+	if (Conditions.HasReducedClock())
+	{
+		NumReducedClockSamples++;
+		if (NumReducedClockSamples >= SustainedSamples)
+		{
+			bIsClockThrottled = true;
+		}
+	}
+	else
+	{
+		NumReducedClockSamples = 0;
+
+		// Between the two thresholds the previous state holds
+		if (Conditions.HasRecoveredClock())
+		{
+			bIsClockThrottled = false;
+		}
+	}
+
+	return IsThrottled();
+}
+
+void FSentryThrottleDetector::Reset()
+{
+	NumReducedClockSamples = 0;
+	bIsThermallyThrottled = false;
+	bIsClockThrottled = false;
+}
+
+FSentryDeviceConditionsSampler& FSentryDeviceConditionsSampler::Get()
+{
+	static FSentryDeviceConditionsSampler Instance;
+	return Instance;
+}
+
+void FSentryDeviceConditionsSampler::Start(float InIntervalSeconds, FSentryQueryDeviceConditions InQuery, FSentryOnDeviceConditionsChanged InOnChanged)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	Query = InQuery;
+	OnChanged = InOnChanged;
+
+	StartSeconds = FPlatformTime::Seconds();
+	History.Reset();
+	LastReported = FSentryDeviceConditions();
+	ThrottleDetector.Reset();
+
+	bIsActive = true;
+
+	Sample();
+
+	const uint32 Serial = ++StartSerial;
+	const float IntervalSeconds = FMath::Max(1.0f, InIntervalSeconds);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Serial](float DeltaTime)
+	{
+		if (!bIsActive || StartSerial != Serial)
+		{
+			return false;
+		}
+
+		Sample();
+		return true;
+	}), IntervalSeconds);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Device conditions sampling enabled, sampling every %.1f seconds."), IntervalSeconds);
+}
+
+void FSentryDeviceConditionsSampler::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+	bIsThrottled = false;
+
+	Query.Unbind();
+	OnChanged.Unbind();
+
+	History.Empty();
+}
+
+TMap<FString, FSentryVariant> FSentryDeviceConditionsSampler::ToContext() const
+{
+	return ToContext(History);
+}
+
+TMap<FString, FSentryVariant> FSentryDeviceConditionsSampler::ToContext(const TArray<FSentryDeviceConditions>& InHistory)
+{
+	TMap<FString, FSentryVariant> Context;
+
+	if (InHistory.Num() == 0)
+	{
+		return Context;
+	}
+
+	const FSentryDeviceConditions& Latest = InHistory.Last();
+	const FSentryDeviceConditions& Oldest = InHistory[0];
+
+	Context.Add(TEXT("sampled_at_seconds"), static_cast<float>(Latest.SampledAtSeconds));
+	Context.Add(TEXT("thermal_state"), FSentryDeviceConditions::ThermalStateToString(Latest.ThermalState));
+	Context.Add(TEXT("throttled"), Latest.bIsThrottled);
+
+	if (Latest.BatteryLevel >= 0)
+	{
+		Context.Add(TEXT("battery_level"), Latest.BatteryLevel);
+		Context.Add(TEXT("charging"), Latest.bIsCharging);
+	}
+
+	if (Latest.CpuFrequencyMHz > 0)
+	{
+		Context.Add(TEXT("cpu_frequency_mhz"), Latest.CpuFrequencyMHz);
+	}
+
+	if (Latest.CpuMaxFrequencyMHz > 0)
+	{
+		Context.Add(TEXT("cpu_max_frequency_mhz"), Latest.CpuMaxFrequencyMHz);
+	}
+
+	if (Latest.GpuFrequencyMHz > 0)
+	{
+		Context.Add(TEXT("gpu_frequency_mhz"), Latest.GpuFrequencyMHz);
+	}
+
+	if (InHistory.Num() < 2)
+	{
+		return Context;
+	}
+
+	const float TrendSeconds = static_cast<float>(Latest.SampledAtSeconds - Oldest.SampledAtSeconds);
+	Context.Add(TEXT("trend_seconds"), TrendSeconds);
+
+	if (Latest.ThermalState != ESentryThermalState::Unknown && Oldest.ThermalState != ESentryThermalState::Unknown)
+	{
+		const TCHAR* Trend = Latest.ThermalState > Oldest.ThermalState ? TEXT("rising") : Latest.ThermalState < Oldest.ThermalState ? TEXT("falling") : TEXT("stable");
+		Context.Add(TEXT("thermal_trend"), Trend);
+	}
+
+	// Drain rate is only meaningful while the battery is discharging for the whole window
+	const bool bIsDischarging = !Latest.bIsCharging && !Oldest.bIsCharging && Latest.BatteryLevel >= 0 && Oldest.BatteryLevel >= 0;
+	if (bIsDischarging && TrendSeconds > 0.0f)
+	{
+		Context.Add(TEXT("battery_drain_percent_per_hour"), (Oldest.BatteryLevel - Latest.BatteryLevel) * 3600.0f / TrendSeconds);
+	}
+
+	if (Latest.CpuFrequencyMHz > 0 && Oldest.CpuFrequencyMHz > 0)
+	{
+		Context.Add(TEXT("cpu_frequency_change_mhz"), Latest.CpuFrequencyMHz - Oldest.CpuFrequencyMHz);
+	}
+
+	return Context;
+}
+
+void FSentryDeviceConditionsSampler::Sample()
+{
+	FSentryDeviceConditions Conditions;
+	if (!Query.IsBound() || !Query.Execute(Conditions))
+	{
+		return;
+	}
+
+	Conditions.SampledAtSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+	if (History.Num() >= MaxHistory)
+	{
+		History.RemoveAt(0);
+	}
+
+	History.Add(Conditions);
+
+	Conditions.bIsThrottled = ThrottleDetector.Update(Conditions);
+	bIsThrottled = Conditions.bIsThrottled;
+
+	if (History.Num() == 1 || Conditions.HasChangedSince(LastReported))
+	{
+		const FSentryDeviceConditions Previous = LastReported;
+		LastReported = Conditions;
+
+		OnChanged.ExecuteIfBound(Previous, Conditions);
+	}
+}
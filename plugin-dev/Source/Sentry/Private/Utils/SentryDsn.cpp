@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryDsn.h"
+
+#include "SentryModule.h"
+
+bool SentryDsn::Parse(const FString& Dsn, FString& OutEndpointUrl, FString& OutPublicKey)
+{
+	FString Scheme, Rest;
+	if (!Dsn.Split(TEXT("://"), &Scheme, &Rest))
+	{
+		return false;
+	}
+
+	FString Credentials, HostAndPath;
+	if (!Rest.Split(TEXT("@"), &Credentials, &HostAndPath))
+	{
+		return false;
+	}
+
+	// Secret key is deprecated and ignored by the server
+	if (!Credentials.Split(TEXT(":"), &OutPublicKey, nullptr))
+	{
+		OutPublicKey = Credentials;
+	}
+
+	FString Host, Path;
+	if (!HostAndPath.Split(TEXT("/"), &Host, &Path))
+	{
+		return false;
+	}
+
+	Path.RemoveFromEnd(TEXT("/"));
+
+	FString PathPrefix, ProjectId;
+	if (!Path.Split(TEXT("/"), &PathPrefix, &ProjectId, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+	{
+		ProjectId = Path;
+	}
+
+	if (OutPublicKey.IsEmpty() || Host.IsEmpty() || ProjectId.IsEmpty())
+	{
+		return false;
+	}
+
+	if (!PathPrefix.IsEmpty())
+	{
+		PathPrefix += TEXT("/");
+	}
+
+	OutEndpointUrl = FString::Printf(TEXT("%s://%s/%sapi/%s/envelope/"), *Scheme, *Host, *PathPrefix, *ProjectId);
+	return true;
+}
+
+FString SentryDsn::GetAuthHeader(const FString& PublicKey)
+{
+	return FString::Printf(TEXT("Sentry sentry_version=7, sentry_key=%s, sentry_client=sentry.native.unreal/%s"),
+		*PublicKey, *FSentryModule::Get().GetPluginVersion());
+}
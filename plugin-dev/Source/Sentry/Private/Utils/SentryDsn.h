@@ -0,0 +1,14 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace SentryDsn
+{
+	/** Splits DSN of the form `{scheme}://{key}@{host}/{path}{project}` into the envelope endpoint and the public key. */
+	bool Parse(const FString& Dsn, FString& OutEndpointUrl, FString& OutPublicKey);
+
+	/** Gets the value of the `X-Sentry-Auth` header of the requests sent directly to the envelope endpoint. */
+	FString GetAuthHeader(const FString& PublicKey);
+}
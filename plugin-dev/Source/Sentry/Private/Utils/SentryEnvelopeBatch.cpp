@@ -0,0 +1,230 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryEnvelopeBatch.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace SentryEnvelopeBatch
+{
+	static int32 FindNewline(const TArray<uint8>& Data, int32 From)
+	{
+		for (int32 Index = From; Index < Data.Num(); ++Index)
+		{
+			if (Data[Index] == '\n')
+			{
+				return Index;
+			}
+		}
+
+		return Data.Num();
+	}
+
+	static TSharedPtr<FJsonObject> ParseJson(const uint8* Data, int32 Length)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Length);
+		const FString Json(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonObject> Object;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+
+		return FJsonSerializer::Deserialize(Reader, Object) ? Object : nullptr;
+	}
+
+	static void AppendUtf8(TArray<uint8>& Out, const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static bool IsBatchableItem(const FString& Type)
+	{
+		return Type == TEXT("session") || Type == TEXT("sessions") || Type == TEXT("client_report") || Type == TEXT("log");
+	}
+}
+
+bool FSentryEnvelopeBatch::Parse(const TArray<uint8>& Envelope, int32& OutHeaderEnd, TArray<FItem>& OutItems)
+{
+	OutHeaderEnd = SentryEnvelopeBatch::FindNewline(Envelope, 0);
+
+	int32 Position = OutHeaderEnd + 1;
+	while (Position < Envelope.Num())
+	{
+		const int32 ItemHeaderEnd = SentryEnvelopeBatch::FindNewline(Envelope, Position);
+		if (ItemHeaderEnd == Position)
+		{
+			Position++;
+			continue;
+		}
+
+		const TSharedPtr<FJsonObject> ItemHeader = SentryEnvelopeBatch::ParseJson(Envelope.GetData() + Position, ItemHeaderEnd - Position);
+		if (!ItemHeader)
+		{
+			return false;
+		}
+
+		FItem& Item = OutItems.AddDefaulted_GetRef();
+		Item.Start = Position;
+		Item.PayloadStart = FMath::Min(ItemHeaderEnd + 1, Envelope.Num());
+		ItemHeader->TryGetStringField(TEXT("type"), Item.Type);
+
+		// Payload without an explicit length is terminated by a newline
+		double Length = 0.0;
+		if (ItemHeader->TryGetNumberField(TEXT("length"), Length))
+		{
+			Item.PayloadEnd = Item.PayloadStart + static_cast<int32>(Length);
+			if (Length < 0.0 || Item.PayloadEnd > Envelope.Num())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			Item.PayloadEnd = SentryEnvelopeBatch::FindNewline(Envelope, Item.PayloadStart);
+		}
+
+		// Trailing newline of the payload is skipped as an empty line
+		Position = Item.PayloadEnd;
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FSentryEnvelopeBatch::ParseHeader(const TArray<uint8>& Envelope, int32 HeaderEnd)
+{
+	return SentryEnvelopeBatch::ParseJson(Envelope.GetData(), FMath::Min(HeaderEnd, Envelope.Num()));
+}
+
+TSharedPtr<FJsonObject> FSentryEnvelopeBatch::ParseItemHeader(const TArray<uint8>& Envelope, const FItem& Item)
+{
+	return SentryEnvelopeBatch::ParseJson(Envelope.GetData() + Item.Start, SentryEnvelopeBatch::FindNewline(Envelope, Item.Start) - Item.Start);
+}
+
+void FSentryEnvelopeBatch::AppendItem(TArray<uint8>& Out, const TSharedRef<FJsonObject>& ItemHeader, const uint8* Payload, int32 Length)
+{
+	ItemHeader->SetNumberField(TEXT("length"), Length);
+
+	FString HeaderJson;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&HeaderJson);
+	FJsonSerializer::Serialize(ItemHeader, Writer);
+
+	SentryEnvelopeBatch::AppendUtf8(Out, HeaderJson);
+	Out.Add('\n');
+	Out.Append(Payload, Length);
+	Out.Add('\n');
+}
+
+bool FSentryEnvelopeBatch::IsBatchable(const TArray<uint8>& Envelope)
+{
+	TArray<FString> Types;
+	if (!GetItemTypes(Envelope, Types) || Types.Num() == 0)
+	{
+		return false;
+	}
+
+	for (const FString& Type : Types)
+	{
+		if (!SentryEnvelopeBatch::IsBatchableItem(Type))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FSentryEnvelopeBatch::GetItemTypes(const TArray<uint8>& Envelope, TArray<FString>& OutTypes)
+{
+	int32 HeaderEnd = 0;
+	TArray<FItem> EnvelopeItems;
+	if (!Parse(Envelope, HeaderEnd, EnvelopeItems))
+	{
+		return false;
+	}
+
+	for (const FItem& Item : EnvelopeItems)
+	{
+		OutTypes.Add(Item.Type);
+	}
+
+	return true;
+}
+
+bool FSentryEnvelopeBatch::Add(const TArray<uint8>& Envelope)
+{
+	if (!IsBatchable(Envelope))
+	{
+		return false;
+	}
+
+	int32 HeaderEnd = 0;
+	TArray<FItem> EnvelopeItems;
+	Parse(Envelope, HeaderEnd, EnvelopeItems);
+
+	for (const FItem& Item : EnvelopeItems)
+	{
+		if (Item.Type == TEXT("log"))
+		{
+			const TSharedPtr<FJsonObject> Payload = SentryEnvelopeBatch::ParseJson(Envelope.GetData() + Item.PayloadStart, Item.PayloadEnd - Item.PayloadStart);
+
+			const TArray<TSharedPtr<FJsonValue>>* EnvelopeLogs = nullptr;
+			if (Payload && Payload->TryGetArrayField(TEXT("items"), EnvelopeLogs))
+			{
+				Logs.Append(*EnvelopeLogs);
+			}
+		}
+		else
+		{
+			Items.Append(Envelope.GetData() + Item.Start, Item.PayloadEnd - Item.Start);
+			Items.Add('\n');
+		}
+	}
+
+	if (NumEnvelopes == 0)
+	{
+		Header.Append(Envelope.GetData(), HeaderEnd);
+	}
+
+	NumEnvelopes++;
+	Size += Envelope.Num();
+
+	return true;
+}
+
+TArray<uint8> FSentryEnvelopeBatch::Take()
+{
+	TArray<uint8> Envelope;
+	Envelope.Reserve(Header.Num() + Items.Num() + 1);
+
+	Envelope.Append(Header);
+	Envelope.Add('\n');
+	Envelope.Append(Items);
+
+	if (Logs.Num() > 0)
+	{
+		TSharedPtr<FJsonObject> Payload = MakeShareable(new FJsonObject);
+		Payload->SetArrayField(TEXT("items"), Logs);
+
+		FString PayloadJson;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&PayloadJson);
+		FJsonSerializer::Serialize(Payload.ToSharedRef(), Writer);
+
+		TArray<uint8> PayloadUtf8;
+		SentryEnvelopeBatch::AppendUtf8(PayloadUtf8, PayloadJson);
+
+		SentryEnvelopeBatch::AppendUtf8(Envelope, FString::Printf(TEXT("{\"type\":\"log\",\"item_count\":%d,\"content_type\":\"application/vnd.sentry.items.log+json\",\"length\":%d}\n"),
+			Logs.Num(), PayloadUtf8.Num()));
+		Envelope.Append(PayloadUtf8);
+		Envelope.Add('\n');
+	}
+
+	Header.Reset();
+	Items.Reset();
+	Logs.Reset();
+	NumEnvelopes = 0;
+	Size = 0;
+
+	return Envelope;
+}
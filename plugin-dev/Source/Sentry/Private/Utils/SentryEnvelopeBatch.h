@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * Merges serialized envelopes that don't carry an event into a single envelope.
+ *
+ * Sessions and client reports are copied as is while logs are merged into one log container item since an envelope
+ * can hold only one of those. Envelopes with events, transactions or attachments can't share an envelope and have
+ * to be sent on their own.
+ */
+class FSentryEnvelopeBatch
+{
+public:
+	/** Item of a serialized envelope. */
+	struct FItem
+	{
+		FString Type;
+
+		/** Range of the item header and payload within the envelope, including the header but not the trailing newline. */
+		int32 Start = 0;
+		int32 PayloadStart = 0;
+		int32 PayloadEnd = 0;
+	};
+
+	/** Splits a serialized envelope into its header and items, false if it's malformed. */
+	static bool Parse(const TArray<uint8>& Envelope, int32& OutHeaderEnd, TArray<FItem>& OutItems);
+
+	/** Parses the envelope header ending at the given position, null if it's malformed. */
+	static TSharedPtr<FJsonObject> ParseHeader(const TArray<uint8>& Envelope, int32 HeaderEnd);
+
+	/** Parses the header of the given item, null if it's malformed. */
+	static TSharedPtr<FJsonObject> ParseItemHeader(const TArray<uint8>& Envelope, const FItem& Item);
+
+	/** Serializes an item with the given header and payload, the length of the header is set to the size of the payload. */
+	static void AppendItem(TArray<uint8>& Out, const TSharedRef<FJsonObject>& ItemHeader, const uint8* Payload, int32 Length);
+
+	/** Checks whether the items of the given serialized envelope can be merged with items of other envelopes. */
+	static bool IsBatchable(const TArray<uint8>& Envelope);
+
+	/** Gets the types of all items of the given serialized envelope, false if it's malformed. */
+	static bool GetItemTypes(const TArray<uint8>& Envelope, TArray<FString>& OutTypes);
+
+	/** Appends the items of a batchable envelope, false if the envelope is malformed or not batchable. */
+	bool Add(const TArray<uint8>& Envelope);
+
+	/** Serializes the batched items into a single envelope and resets the batch. */
+	TArray<uint8> Take();
+
+	bool IsEmpty() const { return NumEnvelopes == 0; }
+
+	/** Gets the number of envelopes merged into the batch. */
+	int32 GetNumEnvelopes() const { return NumEnvelopes; }
+
+	/** Gets the size of the batched payloads in bytes. */
+	int64 GetSize() const { return Size; }
+
+private:
+	/** Header of the first batched envelope, shared by all of them as they are sent with the same DSN. */
+	TArray<uint8> Header;
+
+	/** Serialized items that are copied as is. */
+	TArray<uint8> Items;
+
+	/** Logs of all batched log containers. */
+	TArray<TSharedPtr<FJsonValue>> Logs;
+
+	int32 NumEnvelopes = 0;
+	int64 Size = 0;
+};
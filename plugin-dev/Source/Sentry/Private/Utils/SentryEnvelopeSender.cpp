@@ -0,0 +1,76 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryEnvelopeSender.h"
+
+#include "SentryDefines.h"
+#include "SentrySettings.h"
+#include "Utils/SentryDsn.h"
+
+#include "Interface/SentrySubsystemInterface.h"
+
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+FSentryEnvelopeSender::FSentryEnvelopeSender(TWeakPtr<ISentrySubsystem> Subsystem, const FString& EndpointUrl, const FString& AuthHeader)
+	: Subsystem(Subsystem)
+	, EndpointUrl(EndpointUrl)
+	, AuthHeader(AuthHeader)
+{
+}
+
+TSharedPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> FSentryEnvelopeSender::Create(const USentrySettings* Settings, TWeakPtr<ISentrySubsystem> Subsystem)
+{
+	FString EndpointUrl;
+	FString PublicKey;
+	if (!SentryDsn::Parse(Settings->GetEffectiveDsn(), EndpointUrl, PublicKey))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to parse DSN, envelopes built by the plugin can't be sent."));
+		return nullptr;
+	}
+
+	// Like the batched transport, the engine's HTTP module can't tunnel only Sentry requests through the proxy
+	if (Settings->UseProxy && !Settings->ProxyUrl.IsEmpty())
+	{
+		EndpointUrl.Empty();
+	}
+
+	return MakeShared<FSentryEnvelopeSender, ESPMode::ThreadSafe>(Subsystem, EndpointUrl, SentryDsn::GetAuthHeader(PublicKey));
+}
+
+bool FSentryEnvelopeSender::Send(const TArray<uint8>& Envelope, const TCHAR* Description) const
+{
+	if (Envelope.Num() == 0)
+	{
+		return false;
+	}
+
+	TSharedPtr<ISentrySubsystem> PinnedSubsystem = Subsystem.Pin();
+	if (PinnedSubsystem && PinnedSubsystem->CaptureEnvelope(Envelope))
+	{
+		return true;
+	}
+
+	if (EndpointUrl.IsEmpty())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to send %s, envelopes built by the plugin can't be sent through an HTTP proxy."), Description);
+		return false;
+	}
+
+	auto Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(EndpointUrl);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/x-sentry-envelope"));
+	Request->SetHeader(TEXT("X-Sentry-Auth"), AuthHeader);
+	Request->SetContent(Envelope);
+
+	Request->OnProcessRequestComplete().BindLambda([Description = FString(Description)](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+	{
+		if (!bConnectedSuccessfully || !Response.IsValid() || Response->GetResponseCode() >= 300)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to send %s (%d)."), *Description, Response.IsValid() ? Response->GetResponseCode() : 0);
+		}
+	});
+
+	return Request->ProcessRequest();
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISentrySubsystem;
+class USentrySettings;
+
+/**
+ * Sends envelopes built by the plugin itself, e.g. session aggregates or metrics, which the platform SDKs have no
+ * public API for. Envelopes are handed over to the transport of the platform SDK where possible, so its rate limits
+ * and offline caching apply to them. Otherwise they go directly to the envelope endpoint of the DSN through the
+ * engine's HTTP module.
+ */
+class FSentryEnvelopeSender
+{
+public:
+	FSentryEnvelopeSender(TWeakPtr<ISentrySubsystem> Subsystem, const FString& EndpointUrl, const FString& AuthHeader);
+
+	/**
+	 * Creates a sender for the given platform SDK and the DSN of the given settings, null if the DSN is invalid.
+	 * Envelopes the platform SDK can't take aren't sent if requests have to go through a proxy.
+	 */
+	static TSharedPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> Create(const USentrySettings* Settings, TWeakPtr<ISentrySubsystem> Subsystem);
+
+	/**
+	 * Sends the serialized envelope without waiting for the response.
+	 *
+	 * @param Envelope Serialized envelope.
+	 * @param Description What the envelope carries, used in the log if the request fails.
+	 */
+	bool Send(const TArray<uint8>& Envelope, const TCHAR* Description) const;
+
+private:
+	const TWeakPtr<ISentrySubsystem> Subsystem;
+
+	/** Endpoint the envelopes the platform SDK can't take are posted to, empty if they can't be sent directly. */
+	const FString EndpointUrl;
+	const FString AuthHeader;
+};
@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryEnvelopeSpool.h"
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace SentryEnvelopeSpool
+{
+	static const TCHAR* Extension = TEXT(".envelope");
+
+	static bool IsHigherInOrder(ESentryEnvelopePriority PriorityA, const FString& IdA, ESentryEnvelopePriority PriorityB, const FString& IdB)
+	{
+		// IDs start with the zero-padded time the envelope was stored at, so lexical order is the age order
+		return PriorityA != PriorityB ? PriorityA > PriorityB : IdA < IdB;
+	}
+}
+
+FSentryEnvelopeSpool::FSentryEnvelopeSpool(const FString& InDirectory, int64 InMaxSize)
+	: Directory(InDirectory)
+	, MaxSize(FMath::Max<int64>(0, InMaxSize))
+{
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.MakeDirectory(*Directory, true);
+
+	TArray<FString> FileNames;
+	FileManager.FindFiles(FileNames, *FPaths::Combine(Directory, FString(TEXT("*")) + SentryEnvelopeSpool::Extension), true, false);
+
+	for (const FString& FileName : FileNames)
+	{
+		const FString Id = FPaths::GetBaseFilename(FileName);
+		const int64 FileSize = FileManager.FileSize(*FPaths::Combine(Directory, FileName));
+
+		const uint8 Priority = Id.Len() > 0 ? static_cast<uint8>(Id[0] - TEXT('0')) : MAX_uint8;
+		if (Priority > static_cast<uint8>(ESentryEnvelopePriority::High) || FileSize <= 0)
+		{
+			FileManager.Delete(*FPaths::Combine(Directory, FileName));
+			continue;
+		}
+
+		Entries.Add({ Id, static_cast<ESentryEnvelopePriority>(Priority), FileSize });
+		Size += FileSize;
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B)
+	{
+		return SentryEnvelopeSpool::IsHigherInOrder(A.Priority, A.Id, B.Priority, B.Id);
+	});
+
+	// Limit could have been lowered since the previous session
+	while (Size > MaxSize && Entries.Num() > 0)
+	{
+		RemoveEntry(GetEvictionIndex());
+	}
+
+	if (Entries.Num() > 0)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Found %d envelopes (%lld bytes) spooled during previous sessions."), Entries.Num(), Size);
+	}
+}
+
+bool FSentryEnvelopeSpool::Store(const TArray<uint8>& Envelope, ESentryEnvelopePriority Priority)
+{
+	if (Envelope.Num() > MaxSize)
+	{
+		return false;
+	}
+
+	while (Size + Envelope.Num() > MaxSize)
+	{
+		const int32 EvictionIndex = GetEvictionIndex();
+		if (EvictionIndex == INDEX_NONE || Entries[EvictionIndex].Priority > Priority)
+		{
+			UE_LOG(LogSentrySdk, Verbose, TEXT("Envelope wasn't spooled as the spool is full of envelopes with higher priority."));
+			return false;
+		}
+
+		RemoveEntry(EvictionIndex);
+	}
+
+	const FString Id = FString::Printf(TEXT("%d%020lld%08u"), static_cast<int32>(Priority), FDateTime::UtcNow().GetTicks(), Counter++);
+
+	if (!FFileHelper::SaveArrayToFile(Envelope, *FPaths::Combine(Directory, Id + SentryEnvelopeSpool::Extension)))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to spool envelope %s."), *Id);
+		return false;
+	}
+
+	int32 InsertIndex = 0;
+	while (InsertIndex < Entries.Num() && SentryEnvelopeSpool::IsHigherInOrder(Entries[InsertIndex].Priority, Entries[InsertIndex].Id, Priority, Id))
+	{
+		InsertIndex++;
+	}
+
+	Entries.Insert({ Id, Priority, Envelope.Num() }, InsertIndex);
+	Size += Envelope.Num();
+
+	return true;
+}
+
+bool FSentryEnvelopeSpool::Peek(FString& OutId, TArray<uint8>& OutEnvelope)
+{
+	while (Entries.Num() > 0)
+	{
+		if (FFileHelper::LoadFileToArray(OutEnvelope, *FPaths::Combine(Directory, Entries[0].Id + SentryEnvelopeSpool::Extension)))
+		{
+			OutId = Entries[0].Id;
+			return true;
+		}
+
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to load spooled envelope %s."), *Entries[0].Id);
+		RemoveEntry(0);
+	}
+
+	return false;
+}
+
+void FSentryEnvelopeSpool::Remove(const FString& Id)
+{
+	const int32 Index = Entries.IndexOfByPredicate([&Id](const FEntry& Entry)
+	{
+		return Entry.Id == Id;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		RemoveEntry(Index);
+	}
+}
+
+ESentryEnvelopePriority FSentryEnvelopeSpool::GetPriority(const TArray<uint8>& Envelope)
+{
+	TArray<FString> Types;
+	FSentryEnvelopeBatch::GetItemTypes(Envelope, Types);
+
+	ESentryEnvelopePriority Priority = ESentryEnvelopePriority::Low;
+
+	for (const FString& Type : Types)
+	{
+		if (Type == TEXT("event") || Type == TEXT("attachment") || Type == TEXT("minidump") || Type == TEXT("feedback") || Type == TEXT("user_report"))
+		{
+			return ESentryEnvelopePriority::High;
+		}
+
+		if (Type == TEXT("transaction") || Type == TEXT("profile"))
+		{
+			Priority = ESentryEnvelopePriority::Normal;
+		}
+	}
+
+	return Priority;
+}
+
+int32 FSentryEnvelopeSpool::GetEvictionIndex() const
+{
+	if (Entries.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Oldest envelope of the lowest priority is the first of the last priority group
+	int32 Index = Entries.Num() - 1;
+	while (Index > 0 && Entries[Index - 1].Priority == Entries.Last().Priority)
+	{
+		Index--;
+	}
+
+	return Index;
+}
+
+void FSentryEnvelopeSpool::RemoveEntry(int32 Index)
+{
+	IFileManager::Get().Delete(*FPaths::Combine(Directory, Entries[Index].Id + SentryEnvelopeSpool::Extension));
+
+	Size -= Entries[Index].Size;
+	Entries.RemoveAt(Index);
+}
+
+FSentryRetryBackoff::FSentryRetryBackoff(double InBaseDelay, double InMaxDelay)
+	: BaseDelay(InBaseDelay)
+	, MaxDelay(FMath::Max(InBaseDelay, InMaxDelay))
+	, Random(static_cast<int32>(FPlatformTime::Cycles()))
+{
+}
+
+double FSentryRetryBackoff::NextDelay()
+{
+	const double Delay = FMath::Min(MaxDelay, BaseDelay * static_cast<double>(1ull << FMath::Min(NumFailures, 30)));
+
+	NumFailures++;
+
+	// Half of the delay is randomized so that clients going back online at once don't retry at once
+	return Delay * (0.5 + 0.5 * Random.GetFraction());
+}
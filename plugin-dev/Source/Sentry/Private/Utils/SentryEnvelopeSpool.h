@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+enum class ESentryEnvelopePriority : uint8
+{
+	/** Sessions, logs and client reports */
+	Low,
+	/** Transactions */
+	Normal,
+	/** Events and everything sent along with them */
+	High
+};
+
+/**
+ * Envelopes that couldn't be sent, persisted on disk across sessions within a size limit.
+ *
+ * Once the limit is reached the oldest envelopes of the lowest priority are evicted first so that events survive
+ * long offline periods at the expense of logs and transactions. Not thread-safe.
+ */
+class FSentryEnvelopeSpool
+{
+public:
+	/** Creates a spool in the given directory picking up envelopes left by previous sessions. */
+	FSentryEnvelopeSpool(const FString& InDirectory, int64 InMaxSize);
+
+	/** Persists the envelope evicting others if needed, false if it doesn't fit even after eviction. */
+	bool Store(const TArray<uint8>& Envelope, ESentryEnvelopePriority Priority);
+
+	/** Loads the envelope that should be retried next, highest priority and oldest first. */
+	bool Peek(FString& OutId, TArray<uint8>& OutEnvelope);
+
+	/** Deletes the envelope with the given ID once it has been sent. */
+	void Remove(const FString& Id);
+
+	bool IsEmpty() const { return Entries.Num() == 0; }
+
+	int32 Num() const { return Entries.Num(); }
+
+	/** Gets the size of the persisted envelopes in bytes. */
+	int64 GetSize() const { return Size; }
+
+	/** Gets the priority of a serialized envelope based on the types of its items. */
+	static ESentryEnvelopePriority GetPriority(const TArray<uint8>& Envelope);
+
+private:
+	struct FEntry
+	{
+		FString Id;
+		ESentryEnvelopePriority Priority;
+		int64 Size;
+	};
+
+	/** Gets the index of the envelope to be evicted first, INDEX_NONE if the spool is empty. */
+	int32 GetEvictionIndex() const;
+
+	void RemoveEntry(int32 Index);
+
+	const FString Directory;
+	const int64 MaxSize;
+
+	/** Persisted envelopes sorted by priority, highest first, and age, oldest first. */
+	TArray<FEntry> Entries;
+
+	int64 Size = 0;
+
+	/** Keeps file names unique for envelopes stored within the same tick. */
+	uint32 Counter = 0;
+};
+
+/**
+ * Delay between retries growing exponentially with every failure, randomized to spread retries of many clients.
+ */
+class FSentryRetryBackoff
+{
+public:
+	FSentryRetryBackoff(double InBaseDelay, double InMaxDelay);
+
+	/** Gets the delay before the next retry and increases it for the one after. */
+	double NextDelay();
+
+	/** Resets the delay after a successful attempt. */
+	void Reset() { NumFailures = 0; }
+
+	int32 GetNumFailures() const { return NumFailures; }
+
+private:
+	const double BaseDelay;
+	const double MaxDelay;
+
+	int32 NumFailures = 0;
+
+	FRandomStream Random;
+};
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryEventFilters.h"
+
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace SentryEventFilters_Private
+{
+	struct FRegisteredFilter
+	{
+		FDelegateHandle Handle;
+		FSentryBeforeSendFilter Filter;
+	};
+
+	static FRWLock FiltersLock;
+	static TArray<FRegisteredFilter> Filters;
+
+	/** Lets events skip taking the lock while no filters are registered, which is the common case */
+	static FThreadSafeCounter NumFilters;
+}
+
+FDelegateHandle SentryEventFilters::Add(FSentryBeforeSendFilter&& Filter)
+{
+	using namespace SentryEventFilters_Private;
+
+	FDelegateHandle Handle(FDelegateHandle::GenerateNewHandle);
+
+	FWriteScopeLock Lock(FiltersLock);
+	Filters.Add({ Handle, MoveTemp(Filter) });
+	NumFilters.Set(Filters.Num());
+
+	return Handle;
+}
+
+void SentryEventFilters::Remove(FDelegateHandle Handle)
+{
+	using namespace SentryEventFilters_Private;
+
+	FWriteScopeLock Lock(FiltersLock);
+	Filters.RemoveAll([&Handle](const FRegisteredFilter& Registered) { return Registered.Handle == Handle; });
+	NumFilters.Set(Filters.Num());
+}
+
+bool SentryEventFilters::HasFilters()
+{
+	return SentryEventFilters_Private::NumFilters.GetValue() > 0;
+}
+
+bool SentryEventFilters::Run(ISentryEvent& Event)
+{
+	using namespace SentryEventFilters_Private;
+
+	FSentryEventView View(Event);
+
+	FReadScopeLock Lock(FiltersLock);
+	for (const FRegisteredFilter& Registered : Filters)
+	{
+		if (!Registered.Filter(View))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
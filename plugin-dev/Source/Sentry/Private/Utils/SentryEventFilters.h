@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryEventView.h"
+
+class ISentryEvent;
+
+/**
+ * Chain of native before-send filters shared by all platform implementations.
+ */
+class SentryEventFilters
+{
+public:
+	/** Registers a filter, it runs after the ones registered before it. */
+	static FDelegateHandle Add(FSentryBeforeSendFilter&& Filter);
+
+	/** Unregisters a filter, doesn't return until calls to it that are in progress on other threads are finished. */
+	static void Remove(FDelegateHandle Handle);
+
+	/** Checks whether any filters are registered, lets callers skip wrapping the platform event otherwise. */
+	static bool HasFilters();
+
+	/** Runs the filters in order of registration. Returns false as soon as one of them drops the event. */
+	static bool Run(ISentryEvent& Event);
+};
@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryEventLimiter.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryEventLimiter
+{
+	/** Max number of fingerprints tracked at once, the least recently seen one is forgotten beyond that. */
+	static constexpr int32 MaxFingerprints = 1024;
+
+	/** Number of fingerprints listed in a summary. */
+	static constexpr int32 MaxSummaryEntries = 5;
+
+	/** Max length of a message quoted in a summary. */
+	static constexpr int32 MaxSummaryMessageLength = 120;
+}
+
+FSentryEventLimiter::FSentryEventLimiter(int32 InMaxDuplicatesPerMinute, int32 InMaxEventsPerMinute)
+	: MaxDuplicatesPerMinute(FMath::Max(0, InMaxDuplicatesPerMinute))
+	, MaxEventsPerMinute(FMath::Max(0, InMaxEventsPerMinute))
+{
+	GlobalBucket.Tokens = MaxEventsPerMinute;
+	GlobalBucket.LastRefillTime = FPlatformTime::Seconds();
+	LastReportTime = GlobalBucket.LastRefillTime;
+}
+
+bool FSentryEventLimiter::ShouldCapture(uint32 Fingerprint, const FString& Message)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&CriticalSection);
+
+	FFingerprintState* State = Fingerprints.Find(Fingerprint);
+	if (!State)
+	{
+		if (Fingerprints.Num() >= SentryEventLimiter::MaxFingerprints)
+		{
+			EvictFingerprint();
+		}
+
+		State = &Fingerprints.Add(Fingerprint);
+		State->Bucket.Tokens = MaxDuplicatesPerMinute;
+		State->Bucket.LastRefillTime = Now;
+		State->Message = Message.Left(SentryEventLimiter::MaxSummaryMessageLength);
+	}
+
+	State->LastSeenTime = Now;
+
+	// Both buckets are checked before either is consumed so that a suppressed event doesn't use up tokens
+	const bool bHasDuplicateToken = MaxDuplicatesPerMinute == 0 || TryConsume(State->Bucket, MaxDuplicatesPerMinute, Now);
+	if (!bHasDuplicateToken || (MaxEventsPerMinute > 0 && !TryConsume(GlobalBucket, MaxEventsPerMinute, Now)))
+	{
+		if (bHasDuplicateToken && MaxDuplicatesPerMinute > 0)
+		{
+			State->Bucket.Tokens += 1.0f;
+		}
+
+		++State->NumSuppressed;
+		++NumSuppressed;
+		return false;
+	}
+
+	return true;
+}
+
+bool FSentryEventLimiter::TakeSuppressedSummary(FString& OutSummary, double ReportInterval)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&CriticalSection);
+
+	if (NumSuppressed == 0 || Now - LastReportTime < ReportInterval)
+	{
+		return false;
+	}
+
+	TArray<const FFingerprintState*> SuppressedStates;
+	for (const TPair<uint32, FFingerprintState>& Fingerprint : Fingerprints)
+	{
+		if (Fingerprint.Value.NumSuppressed > 0)
+		{
+			SuppressedStates.Add(&Fingerprint.Value);
+		}
+	}
+
+	SuppressedStates.Sort([](const FFingerprintState& A, const FFingerprintState& B) { return A.NumSuppressed > B.NumSuppressed; });
+
+	OutSummary = FString::Printf(TEXT("Sentry suppressed %d events in the last %.0f seconds:"), NumSuppressed, Now - LastReportTime);
+	for (int32 Index = 0; Index < FMath::Min(SuppressedStates.Num(), SentryEventLimiter::MaxSummaryEntries); ++Index)
+	{
+		OutSummary += FString::Printf(TEXT("\n%dx %s"), SuppressedStates[Index]->NumSuppressed, *SuppressedStates[Index]->Message);
+	}
+
+	for (TPair<uint32, FFingerprintState>& Fingerprint : Fingerprints)
+	{
+		Fingerprint.Value.NumSuppressed = 0;
+	}
+
+	NumSuppressed = 0;
+	LastReportTime = Now;
+
+	return true;
+}
+
+uint32 FSentryEventLimiter::GetFingerprint(const FString& Message, ESentryLevel Level, const TArray<uint64>& ProgramCounters, const FString& ScriptCallstack)
+{
+	uint32 Fingerprint = FCrc::StrCrc32(*Message);
+	Fingerprint = HashCombine(Fingerprint, static_cast<uint32>(Level));
+	Fingerprint = FCrc::MemCrc32(ProgramCounters.GetData(), ProgramCounters.Num() * sizeof(uint64), Fingerprint);
+
+	if (!ScriptCallstack.IsEmpty())
+	{
+		Fingerprint = HashCombine(Fingerprint, FCrc::StrCrc32(*ScriptCallstack));
+	}
+
+	return Fingerprint;
+}
+
+bool FSentryEventLimiter::TryConsume(FBucket& Bucket, float Capacity, double Now)
+{
+	Bucket.Tokens = FMath::Min(Capacity, Bucket.Tokens + static_cast<float>((Now - Bucket.LastRefillTime) * Capacity / 60.0));
+	Bucket.LastRefillTime = Now;
+
+	if (Bucket.Tokens < 1.0f)
+	{
+		return false;
+	}
+
+	Bucket.Tokens -= 1.0f;
+	return true;
+}
+
+void FSentryEventLimiter::EvictFingerprint()
+{
+	uint32 OldestFingerprint = 0;
+	double OldestTime = TNumericLimits<double>::Max();
+
+	for (const TPair<uint32, FFingerprintState>& Fingerprint : Fingerprints)
+	{
+		if (Fingerprint.Value.LastSeenTime < OldestTime)
+		{
+			OldestFingerprint = Fingerprint.Key;
+			OldestTime = Fingerprint.Value.LastSeenTime;
+		}
+	}
+
+	Fingerprints.Remove(OldestFingerprint);
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include "SentryDataTypes.h"
+
+/**
+ * Client-side deduplication and rate limiting of captured events.
+ *
+ * Each fingerprint (message, level and call site) has a token bucket and all events share a global one, so that
+ * a bug capturing an event every frame doesn't burn through the quota. Suppressed events are counted and summarized
+ * at most once per report interval.
+ */
+class FSentryEventLimiter
+{
+public:
+	/**
+	 * @param InMaxDuplicatesPerMinute Events allowed per minute for each fingerprint, 0 for no limit.
+	 * @param InMaxEventsPerMinute Events allowed per minute in total, 0 for no limit.
+	 */
+	FSentryEventLimiter(int32 InMaxDuplicatesPerMinute, int32 InMaxEventsPerMinute);
+
+	/** Checks whether any limiting is configured. */
+	bool IsEnabled() const { return MaxDuplicatesPerMinute > 0 || MaxEventsPerMinute > 0; }
+
+	/** Checks whether the event should be captured. Safe to call from any thread. */
+	bool ShouldCapture(uint32 Fingerprint, const FString& Message);
+
+	/**
+	 * Gets a summary of the events suppressed since the last one, if any were and the report interval has passed.
+	 *
+	 * @param ReportInterval Min time in seconds between two summaries.
+	 */
+	bool TakeSuppressedSummary(FString& OutSummary, double ReportInterval = 60.0);
+
+	/** Combines the event properties, the innermost frames of the call site and the Blueprint script stack (if any) into a fingerprint. */
+	static uint32 GetFingerprint(const FString& Message, ESentryLevel Level, const TArray<uint64>& ProgramCounters, const FString& ScriptCallstack = FString());
+
+private:
+	struct FBucket
+	{
+		float Tokens = 0.0f;
+		double LastRefillTime = 0.0;
+	};
+
+	struct FFingerprintState
+	{
+		FBucket Bucket;
+		double LastSeenTime = 0.0;
+
+		int32 NumSuppressed = 0;
+
+		/** Message of the first event with this fingerprint, used in the summary */
+		FString Message;
+	};
+
+	static bool TryConsume(FBucket& Bucket, float Capacity, double Now);
+
+	/** Forgets the fingerprint not seen for the longest time, its suppressed events are still included in the total of the next summary. */
+	void EvictFingerprint();
+
+	const int32 MaxDuplicatesPerMinute;
+	const int32 MaxEventsPerMinute;
+
+	FCriticalSection CriticalSection;
+
+	TMap<uint32, FFingerprintState> Fingerprints;
+	FBucket GlobalBucket;
+
+	int32 NumSuppressed = 0;
+	double LastReportTime = 0.0;
+};
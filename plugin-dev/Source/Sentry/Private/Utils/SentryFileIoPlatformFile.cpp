@@ -0,0 +1,191 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryFileIoPlatformFile.h"
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryLogUtils.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace SentryFileIoPlatformFile
+{
+	static FSentryFileIoPlatformFile* Instance = nullptr;
+
+	/** Frames of the layer itself on top of the callsite. */
+	static constexpr int32 FramesToSkip = 3;
+
+	static constexpr int32 MaxStackDepth = 32;
+}
+
+/** Handle timing the reads the game thread performs, everything else is forwarded as is. */
+class FSentryTimedFileHandle : public IFileHandle
+{
+public:
+	FSentryTimedFileHandle(IFileHandle* InHandle, FSentryFileIoPlatformFile& InPlatformFile, const TCHAR* InFilename)
+		: Handle(InHandle)
+		, PlatformFile(InPlatformFile)
+		, Filename(InFilename)
+	{
+	}
+
+	virtual int64 Tell() override { return Handle->Tell(); }
+	virtual bool Seek(int64 NewPosition) override { return Handle->Seek(NewPosition); }
+	virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd = 0) override { return Handle->SeekFromEnd(NewPositionRelativeToEnd); }
+	virtual bool Write(const uint8* Source, int64 BytesToWrite) override { return Handle->Write(Source, BytesToWrite); }
+	virtual bool Flush(const bool bFullFlush = false) override { return Handle->Flush(bFullFlush); }
+	virtual bool Truncate(int64 NewSize) override { return Handle->Truncate(NewSize); }
+	virtual int64 Size() override { return Handle->Size(); }
+	virtual void ShrinkBuffers() override { Handle->ShrinkBuffers(); }
+
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+	virtual bool ReadAt(uint8* Destination, int64 BytesToRead, int64 Offset) override
+	{
+		if (!PlatformFile.ShouldTime())
+		{
+			return Handle->ReadAt(Destination, BytesToRead, Offset);
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool bResult = Handle->ReadAt(Destination, BytesToRead, Offset);
+		PlatformFile.OnOperationFinished(TEXT("read"), Filename, StartCycles, BytesToRead);
+		return bResult;
+	}
+#endif
+
+	virtual bool Read(uint8* Destination, int64 BytesToRead) override
+	{
+		if (!PlatformFile.ShouldTime())
+		{
+			return Handle->Read(Destination, BytesToRead);
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool bResult = Handle->Read(Destination, BytesToRead);
+		PlatformFile.OnOperationFinished(TEXT("read"), Filename, StartCycles, BytesToRead);
+		return bResult;
+	}
+
+private:
+	TUniquePtr<IFileHandle> Handle;
+	FSentryFileIoPlatformFile& PlatformFile;
+	FString Filename;
+};
+
+void FSentryFileIoPlatformFile::Register()
+{
+	check(IsInGameThread());
+
+	if (SentryFileIoPlatformFile::Instance)
+	{
+		return;
+	}
+
+	FSentryFileIoPlatformFile* PlatformFile = new FSentryFileIoPlatformFile();
+	if (!PlatformFile->Initialize(&FPlatformFileManager::Get().GetPlatformFile(), TEXT("")))
+	{
+		delete PlatformFile;
+		return;
+	}
+
+	FPlatformFileManager::Get().SetPlatformFile(*PlatformFile);
+	SentryFileIoPlatformFile::Instance = PlatformFile;
+}
+
+void FSentryFileIoPlatformFile::Unregister()
+{
+	FSentryFileIoPlatformFile* PlatformFile = SentryFileIoPlatformFile::Instance;
+	if (!PlatformFile)
+	{
+		return;
+	}
+
+	PlatformFile->StopReporting();
+
+	FPlatformFileManager::Get().RemovePlatformFile(PlatformFile);
+	SentryFileIoPlatformFile::Instance = nullptr;
+
+	// Handles opened through the layer may still be in use and refer to it, so it's intentionally leaked
+}
+
+FSentryFileIoPlatformFile* FSentryFileIoPlatformFile::Get()
+{
+	return SentryFileIoPlatformFile::Instance;
+}
+
+void FSentryFileIoPlatformFile::StartReporting(float InThresholdMs, FSentryOnSyncFileIo InOnSyncFileIo)
+{
+	check(IsInGameThread());
+
+	ThresholdCycles = static_cast<uint64>(FMath::Max(0.1f, InThresholdMs) / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+	OnSyncFileIo = InOnSyncFileIo;
+
+	bIsReporting = true;
+}
+
+void FSentryFileIoPlatformFile::StopReporting()
+{
+	check(IsInGameThread());
+
+	bIsReporting = false;
+	OnSyncFileIo.Unbind();
+}
+
+bool FSentryFileIoPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
+{
+	LowerLevel = Inner;
+	return LowerLevel != nullptr;
+}
+
+IFileHandle* FSentryFileIoPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
+{
+	if (!ShouldTime())
+	{
+		return LowerLevel->OpenRead(Filename, bAllowWrite);
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	return WrapHandle(LowerLevel->OpenRead(Filename, bAllowWrite), Filename, StartCycles);
+}
+
+IFileHandle* FSentryFileIoPlatformFile::OpenReadNoBuffering(const TCHAR* Filename, bool bAllowWrite)
+{
+	if (!ShouldTime())
+	{
+		return LowerLevel->OpenReadNoBuffering(Filename, bAllowWrite);
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	return WrapHandle(LowerLevel->OpenReadNoBuffering(Filename, bAllowWrite), Filename, StartCycles);
+}
+
+IFileHandle* FSentryFileIoPlatformFile::WrapHandle(IFileHandle* Handle, const TCHAR* Filename, uint64 StartCycles)
+{
+	OnOperationFinished(TEXT("open"), Filename, StartCycles, 0);
+
+	if (!Handle)
+	{
+		return nullptr;
+	}
+
+	return new FSentryTimedFileHandle(Handle, *this, Filename);
+}
+
+void FSentryFileIoPlatformFile::OnOperationFinished(const TCHAR* Operation, const FString& Path, uint64 StartCycles, int64 Bytes)
+{
+	const uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+	if (ElapsedCycles < ThresholdCycles)
+	{
+		return;
+	}
+
+	FSentrySyncFileIo Io;
+	Io.Operation = Operation;
+	Io.Path = Path;
+	Io.DurationMs = static_cast<float>(FPlatformTime::ToMilliseconds64(ElapsedCycles));
+	Io.Bytes = Bytes;
+	Io.ProgramCounters = SentryLogUtils::CaptureStackBackTrace(SentryFileIoPlatformFile::FramesToSkip, SentryFileIoPlatformFile::MaxStackDepth);
+
+	OnSyncFileIo.ExecuteIfBound(Io);
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/EngineVersionComparison.h"
+
+/** Synchronous file operation the game thread was blocked on for longer than the threshold. */
+struct FSentrySyncFileIo
+{
+	/** Either `open` or `read`. */
+	const TCHAR* Operation = TEXT("");
+
+	FString Path;
+
+	float DurationMs = 0.0f;
+
+	/** Number of bytes read, zero for opens. */
+	int64 Bytes = 0;
+
+	/** Raw program counters of the callsite, innermost frame first. */
+	TArray<uint64> ProgramCounters;
+};
+
+DECLARE_DELEGATE_OneParam(FSentryOnSyncFileIo, const FSentrySyncFileIo&);
+
+/**
+ * Platform file layer timing synchronous opens and reads the game thread performs, e.g. sync loads in gameplay code.
+ *
+ * The layer is inserted on top of the platform file chain at module startup when enabled in the settings, since
+ * layers can't be safely added once files are open. Until a handler is set every call is a single branch away from
+ * the lower level. Call stacks are only captured for operations that exceeded the threshold. Every other call is
+ * forwarded as is, like FLoggedPlatformFile does, so that the layer doesn't hide features of the lower levels such as
+ * memory mapping.
+ *
+ * Async reads and the IoStore package loader don't go through this layer.
+ */
+class FSentryFileIoPlatformFile : public IPlatformFile
+{
+public:
+	/** Inserts the layer on top of the platform file chain. Called on the game thread at module startup. */
+	static void Register();
+
+	/** Removes the layer from the platform file chain. */
+	static void Unregister();
+
+	/** Gets the registered layer, null if it isn't registered. */
+	static FSentryFileIoPlatformFile* Get();
+
+	/** Starts reporting game thread operations slower than the threshold. Called on the game thread. */
+	void StartReporting(float InThresholdMs, FSentryOnSyncFileIo InOnSyncFileIo);
+
+	void StopReporting();
+
+	//~ Begin IPlatformFile interface
+	virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CmdLine) override;
+	virtual void InitializeAfterSetActive() override { LowerLevel->InitializeAfterSetActive(); }
+	virtual void MakeUniquePakFilesForTheseFiles(const TArray<TArray<FString>>& InFiles) override { LowerLevel->MakeUniquePakFilesForTheseFiles(InFiles); }
+	virtual void InitializeNewAsyncIO() override { LowerLevel->InitializeNewAsyncIO(); }
+	virtual void AddLocalDirectories(TArray<FString>& LocalDirectories) override { LowerLevel->AddLocalDirectories(LocalDirectories); }
+	virtual void BypassSecurity(bool bInBypass) override { LowerLevel->BypassSecurity(bInBypass); }
+	virtual IPlatformFile* GetLowerLevel() override { return LowerLevel; }
+	virtual void SetLowerLevel(IPlatformFile* NewLowerLevel) override { LowerLevel = NewLowerLevel; }
+	virtual const TCHAR* GetName() const override { return TEXT("SentryFileIo"); }
+	virtual void Tick() override { LowerLevel->Tick(); }
+	virtual void SetSandboxEnabled(bool bInEnabled) override { LowerLevel->SetSandboxEnabled(bInEnabled); }
+	virtual bool IsSandboxEnabled() const override { return LowerLevel->IsSandboxEnabled(); }
+	virtual bool FileExists(const TCHAR* Filename) override { return LowerLevel->FileExists(Filename); }
+	virtual int64 FileSize(const TCHAR* Filename) override { return LowerLevel->FileSize(Filename); }
+	virtual bool DeleteFile(const TCHAR* Filename) override { return LowerLevel->DeleteFile(Filename); }
+	virtual bool IsReadOnly(const TCHAR* Filename) override { return LowerLevel->IsReadOnly(Filename); }
+	virtual bool MoveFile(const TCHAR* To, const TCHAR* From) override { return LowerLevel->MoveFile(To, From); }
+	virtual bool SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue) override { return LowerLevel->SetReadOnly(Filename, bNewReadOnlyValue); }
+	virtual FDateTime GetTimeStamp(const TCHAR* Filename) override { return LowerLevel->GetTimeStamp(Filename); }
+	virtual void SetTimeStamp(const TCHAR* Filename, FDateTime DateTime) override { LowerLevel->SetTimeStamp(Filename, DateTime); }
+	virtual void GetTimeStampPair(const TCHAR* PathA, const TCHAR* PathB, FDateTime& OutTimeStampA, FDateTime& OutTimeStampB) override { LowerLevel->GetTimeStampPair(PathA, PathB, OutTimeStampA, OutTimeStampB); }
+	virtual FDateTime GetAccessTimeStamp(const TCHAR* Filename) override { return LowerLevel->GetAccessTimeStamp(Filename); }
+	virtual FString GetFilenameOnDisk(const TCHAR* Filename) override { return LowerLevel->GetFilenameOnDisk(Filename); }
+	virtual ESymlinkResult IsSymlink(const TCHAR* Filename) override { return LowerLevel->IsSymlink(Filename); }
+	virtual IFileHandle* OpenRead(const TCHAR* Filename, bool bAllowWrite = false) override;
+	virtual IFileHandle* OpenReadNoBuffering(const TCHAR* Filename, bool bAllowWrite = false) override;
+	virtual IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override { return LowerLevel->OpenWrite(Filename, bAppend, bAllowRead); }
+	virtual bool DirectoryExists(const TCHAR* Directory) override { return LowerLevel->DirectoryExists(Directory); }
+	virtual bool CreateDirectory(const TCHAR* Directory) override { return LowerLevel->CreateDirectory(Directory); }
+	virtual bool DeleteDirectory(const TCHAR* Directory) override { return LowerLevel->DeleteDirectory(Directory); }
+	virtual FFileStatData GetStatData(const TCHAR* FilenameOrDirectory) override { return LowerLevel->GetStatData(FilenameOrDirectory); }
+	virtual bool IterateDirectory(const TCHAR* Directory, FDirectoryVisitor& Visitor) override { return LowerLevel->IterateDirectory(Directory, Visitor); }
+	virtual bool IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor) override { return LowerLevel->IterateDirectoryStat(Directory, Visitor); }
+	virtual bool IterateDirectoryRecursively(const TCHAR* Directory, FDirectoryVisitor& Visitor) override { return LowerLevel->IterateDirectoryRecursively(Directory, Visitor); }
+	virtual bool IterateDirectoryStatRecursively(const TCHAR* Directory, FDirectoryStatVisitor& Visitor) override { return LowerLevel->IterateDirectoryStatRecursively(Directory, Visitor); }
+	virtual bool DeleteDirectoryRecursively(const TCHAR* Directory) override { return LowerLevel->DeleteDirectoryRecursively(Directory); }
+	virtual bool CreateDirectoryTree(const TCHAR* Directory) override { return LowerLevel->CreateDirectoryTree(Directory); }
+	virtual bool CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags = EPlatformFileRead::None, EPlatformFileWrite WriteFlags = EPlatformFileWrite::None) override { return LowerLevel->CopyFile(To, From, ReadFlags, WriteFlags); }
+	virtual bool CopyDirectoryTree(const TCHAR* DestinationDirectory, const TCHAR* Source, bool bOverwriteAllExisting) override { return LowerLevel->CopyDirectoryTree(DestinationDirectory, Source, bOverwriteAllExisting); }
+	virtual void FindFiles(TArray<FString>& FoundFiles, const TCHAR* Directory, const TCHAR* FileExtension) override { LowerLevel->FindFiles(FoundFiles, Directory, FileExtension); }
+	virtual void FindFilesRecursively(TArray<FString>& FoundFiles, const TCHAR* Directory, const TCHAR* FileExtension) override { LowerLevel->FindFilesRecursively(FoundFiles, Directory, FileExtension); }
+	virtual FString ConvertToAbsolutePathForExternalAppForRead(const TCHAR* Filename) override { return LowerLevel->ConvertToAbsolutePathForExternalAppForRead(Filename); }
+	virtual FString ConvertToAbsolutePathForExternalAppForWrite(const TCHAR* Filename) override { return LowerLevel->ConvertToAbsolutePathForExternalAppForWrite(Filename); }
+	virtual bool SendMessageToServer(const TCHAR* Message, IFileServerMessageHandler* Handler) override { return LowerLevel->SendMessageToServer(Message, Handler); }
+	virtual bool DoesCreatePublicFiles() override { return LowerLevel->DoesCreatePublicFiles(); }
+	virtual void SetCreatePublicFiles(bool bCreatePublicFiles) override { LowerLevel->SetCreatePublicFiles(bCreatePublicFiles); }
+	virtual void SetAsyncMinimumPriority(EAsyncIOPriorityAndFlags MinPriority) override { LowerLevel->SetAsyncMinimumPriority(MinPriority); }
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename) override { return LowerLevel->OpenAsyncRead(Filename); }
+#else
+	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename, bool bAllowWrite = false) override { return LowerLevel->OpenAsyncRead(Filename, bAllowWrite); }
+#endif
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override { return LowerLevel->OpenMapped(Filename); }
+#else
+	virtual FOpenMappedResult OpenMappedEx(const TCHAR* Filename, EOpenReadFlags OpenOptions = EOpenReadFlags::None, int64 MaximumSize = 0) override { return LowerLevel->OpenMappedEx(Filename, OpenOptions, MaximumSize); }
+#endif
+	//~ End IPlatformFile interface
+
+private:
+	friend class FSentryTimedFileHandle;
+
+	/** Wraps handles opened on the game thread while reporting so that their reads are timed as well. */
+	IFileHandle* WrapHandle(IFileHandle* Handle, const TCHAR* Filename, uint64 StartCycles);
+
+	/** Reports the operation if it took longer than the threshold. Called on the game thread. */
+	void OnOperationFinished(const TCHAR* Operation, const FString& Path, uint64 StartCycles, int64 Bytes);
+
+	bool ShouldTime() const { return bIsReporting && IsInGameThread(); }
+
+	IPlatformFile* LowerLevel = nullptr;
+
+	FThreadSafeBool bIsReporting;
+
+	/** Threshold in cycles so that the common case is a subtraction and a comparison. */
+	uint64 ThresholdCycles = 0;
+
+	FSentryOnSyncFileIo OnSyncFileIo;
+};
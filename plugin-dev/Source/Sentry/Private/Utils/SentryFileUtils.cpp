@@ -2,20 +2,48 @@
 
 #include "SentryFileUtils.h"
 #include "SentryDefines.h"
+#include "SentryScreenshotUtils.h"
 
+#include "CoreGlobals.h"
 #include "GenericPlatform/GenericPlatformOutputDevices.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
 
-struct FSentrySortFileByDatePredicate
+namespace SentryFileUtilsPrivate
 {
-	bool operator()(const FString& A, const FString& B) const
+	/**
+	 * Finds the most recently modified file matching the wildcard in a single pass over the directory.
+	 * Directory iteration already provides timestamps, so unlike sorting the results this costs no extra stat calls.
+	 */
+	static FString FindNewestFile(const FString& Directory, const FString& Wildcard, const FDateTime& MinTimestamp = FDateTime::MinValue())
 	{
-		const FDateTime TimestampA = IFileManager::Get().GetTimeStamp(*A);
-		const FDateTime TimestampB = IFileManager::Get().GetTimeStamp(*B);
-		return TimestampB < TimestampA;
+		FString NewestFile;
+		FDateTime NewestTimestamp = MinTimestamp;
+
+		IFileManager::Get().IterateDirectoryStat(*Directory, [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory && StatData.ModificationTime >= NewestTimestamp && FPaths::GetCleanFilename(FilenameOrDirectory).MatchesWildcard(Wildcard))
+			{
+				NewestFile = FilenameOrDirectory;
+				NewestTimestamp = StatData.ModificationTime;
+			}
+			return true;
+		});
+
+		return NewestFile;
 	}
-};
+
+	/** Log backups are only rotated on startup, so the lookup result stays valid for the whole session. */
+	static FCriticalSection GameLogBackupPathLock;
+	static FString GameLogBackupPath;
+	static bool bIsGameLogBackupPathCached = false;
+
+	/** Path of the last screenshot requested via GetScreenshotPath. */
+	static FCriticalSection LatestScreenshotPathLock;
+	static FString LatestScreenshotPath;
+}
 
 FString SentryFileUtils::GetGameLogName()
 {
@@ -29,73 +57,74 @@ FString SentryFileUtils::GetGameLogPath()
 
 FString SentryFileUtils::GetGameLogBackupPath()
 {
-	TArray<FString> GameLogBackupFiles;
-	IFileManager::Get().FindFiles(GameLogBackupFiles, *FString::Printf(TEXT("%s*-backup-*.*"), *FPaths::ProjectLogDir()), true, false);
+	FScopeLock Lock(&SentryFileUtilsPrivate::GameLogBackupPathLock);
 
-	if (GameLogBackupFiles.Num() == 0)
+	if (!SentryFileUtilsPrivate::bIsGameLogBackupPathCached)
 	{
-		UE_LOG(LogSentrySdk, Log, TEXT("There are no game log backups available."));
-		return FString("");
+		const FString GameLogBackupFile = SentryFileUtilsPrivate::FindNewestFile(FPaths::ProjectLogDir(), TEXT("*-backup-*.*"));
+
+		SentryFileUtilsPrivate::GameLogBackupPath = GameLogBackupFile.IsEmpty()
+			? FString()
+			: IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*GameLogBackupFile);
+		SentryFileUtilsPrivate::bIsGameLogBackupPathCached = true;
 	}
 
-	for (int i = 0; i < GameLogBackupFiles.Num(); ++i)
+	if (SentryFileUtilsPrivate::GameLogBackupPath.IsEmpty())
 	{
-		GameLogBackupFiles[i] = FPaths::ProjectLogDir() / GameLogBackupFiles[i];
+		UE_LOG(LogSentrySdk, Log, TEXT("There are no game log backups available."));
 	}
 
-	GameLogBackupFiles.Sort(FSentrySortFileByDatePredicate());
-
-	return IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*GameLogBackupFiles[0]);
+	return SentryFileUtilsPrivate::GameLogBackupPath;
 }
 
 FString SentryFileUtils::GetGpuDumpPath()
 {
-	TArray<FString> GpuDumpFiles;
-	IFileManager::Get().FindFiles(GpuDumpFiles, *FString::Printf(TEXT("%s*.nv-gpudmp"), *FPaths::ProjectLogDir()), true, false);
+	// By default, engine cleans up GPU dumps from the previous runs however this doesn't seem to be the case
+	// if https://github.com/EpicGames/UnrealEngine/pull/12648 patch is applied so we just return the newest one.
+	// The dump is written right before the crash without any notification, so the directory still has to be scanned
+	// but dumps older than the current session are skipped without being compared.
+	const FDateTime SessionStartTime = FDateTime::UtcNow() - FTimespan::FromSeconds(FPlatformTime::Seconds() - GStartTime);
+
+	const FString GpuDumpFile = SentryFileUtilsPrivate::FindNewestFile(FPaths::ProjectLogDir(), TEXT("*.nv-gpudmp"), SessionStartTime);
 
-	if (GpuDumpFiles.Num() == 0)
+	if (GpuDumpFile.IsEmpty())
 	{
 		UE_LOG(LogSentrySdk, Log, TEXT("There is no GPU dump file available."));
 		return FString("");
 	}
 
-	// By default, engine cleans up GPU dumps from the previous runs however this doesn't seem to be the case
-	// if https://github.com/EpicGames/UnrealEngine/pull/12648 patch is applied so we just return the newest one
-
-	for (int i = 0; i < GpuDumpFiles.Num(); ++i)
-	{
-		GpuDumpFiles[i] = FPaths::ProjectLogDir() / GpuDumpFiles[i];
-	}
-
-	GpuDumpFiles.Sort(FSentrySortFileByDatePredicate());
-
-	return IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*GpuDumpFiles[0]);
+	return IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*GpuDumpFile);
 }
 
 FString SentryFileUtils::GetScreenshotPath()
 {
-	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryScreenshots"), FString::Printf(TEXT("screenshot-%s.png"), *FDateTime::Now().ToString()));
+	const FString ScreenshotPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryScreenshots"), FString::Printf(TEXT("screenshot-%s.%s"), *FDateTime::Now().ToString(), *SentryScreenshotUtils::GetScreenshotExtension()));
+
+	FScopeLock Lock(&SentryFileUtilsPrivate::LatestScreenshotPathLock);
+	SentryFileUtilsPrivate::LatestScreenshotPath = ScreenshotPath;
+
+	return ScreenshotPath;
 }
 
 FString SentryFileUtils::GetLatestScreenshot()
 {
-	const FString& ScreenshotsDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryScreenshots"));
-
-	TArray<FString> Screenshots;
-	IFileManager::Get().FindFiles(Screenshots, *ScreenshotsDir, TEXT("*.png"));
-
-	if (Screenshots.Num() == 0)
 	{
-		UE_LOG(LogSentrySdk, Log, TEXT("There are no screenshots found."));
-		return FString("");
+		FScopeLock Lock(&SentryFileUtilsPrivate::LatestScreenshotPathLock);
+
+		// Screenshots are only written to paths handed out by GetScreenshotPath, so there's nothing to scan for
+		if (!SentryFileUtilsPrivate::LatestScreenshotPath.IsEmpty() && IFileManager::Get().FileExists(*SentryFileUtilsPrivate::LatestScreenshotPath))
+		{
+			return SentryFileUtilsPrivate::LatestScreenshotPath;
+		}
 	}
 
-	for (int i = 0; i < Screenshots.Num(); ++i)
+	// Fall back to screenshots left from previous sessions
+	const FString Screenshot = SentryFileUtilsPrivate::FindNewestFile(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryScreenshots")), TEXT("*.") + SentryScreenshotUtils::GetScreenshotExtension());
+
+	if (Screenshot.IsEmpty())
 	{
-		Screenshots[i] = ScreenshotsDir / Screenshots[i];
+		UE_LOG(LogSentrySdk, Log, TEXT("There are no screenshots found."));
 	}
 
-	Screenshots.Sort(FSentrySortFileByDatePredicate());
-
-	return Screenshots[0];
+	return Screenshot;
 }
@@ -0,0 +1,242 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryFrameBreakdown.h"
+
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/CoreMisc.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+namespace SentryFrameBreakdown
+{
+	struct FTickGroupInfo
+	{
+		ETickingGroup Group;
+		const TCHAR* Name;
+	};
+
+	static const FTickGroupInfo TickGroups[] = {
+		{ TG_PrePhysics, TEXT("PrePhysics") },
+		{ TG_StartPhysics, TEXT("StartPhysics") },
+		{ TG_DuringPhysics, TEXT("DuringPhysics") },
+		{ TG_EndPhysics, TEXT("EndPhysics") },
+		{ TG_PostPhysics, TEXT("PostPhysics") },
+		{ TG_PostUpdateWork, TEXT("PostUpdateWork") },
+		{ TG_LastDemotable, TEXT("LastDemotable") }
+	};
+}
+
+/**
+ * Tick function running first in its tick group, marking the time the group started at.
+ */
+struct FSentryTickGroupMarker : public FTickFunction
+{
+	FSentryTickGroupMarker(FSentryFrameBreakdown& InOwner, int32 InGroupIndex)
+		: Owner(InOwner)
+		, GroupIndex(InGroupIndex)
+	{
+		TickGroup = SentryFrameBreakdown::TickGroups[GroupIndex].Group;
+		EndTickGroup = TickGroup;
+		bHighPriority = true;
+		bCanEverTick = true;
+		bStartWithTickEnabled = true;
+		bTickEvenWhenPaused = true;
+		bRunOnAnyThread = false;
+	}
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override
+	{
+		Owner.OnTickGroupStarted(GroupIndex);
+	}
+
+	virtual FString DiagnosticMessage() override
+	{
+		return FString::Printf(TEXT("FSentryTickGroupMarker[%s]"), SentryFrameBreakdown::TickGroups[GroupIndex].Name);
+	}
+
+	FSentryFrameBreakdown& Owner;
+	const int32 GroupIndex;
+};
+
+FSentryFrameBreakdown::FSentryFrameBreakdown(int32 InSampleInterval, FOnFrameSampled InOnFrameSampled)
+	: SampleInterval(FMath::Max(1, InSampleInterval))
+	, OnFrameSampled(MoveTemp(InOnFrameSampled))
+	, Random(static_cast<int32>(FPlatformTime::Cycles()))
+{
+	check(IsInGameThread());
+
+	NextSampledFrame = GetNextSampledFrame(GFrameCounter, SampleInterval, Random);
+
+	TickGroupStartTimes.SetNumZeroed(UE_ARRAY_COUNT(SentryFrameBreakdown::TickGroups));
+
+	for (int32 GroupIndex = 0; GroupIndex < UE_ARRAY_COUNT(SentryFrameBreakdown::TickGroups); ++GroupIndex)
+	{
+		Markers.Add(MakeUnique<FSentryTickGroupMarker>(*this, GroupIndex));
+	}
+
+	OnBeginFrameHandle = FCoreDelegates::OnBeginFrame.AddRaw(this, &FSentryFrameBreakdown::OnBeginFrame);
+	OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSentryFrameBreakdown::OnEndFrame);
+	OnWorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddRaw(this, &FSentryFrameBreakdown::OnWorldTickStart);
+	OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FSentryFrameBreakdown::OnWorldPostActorTick);
+	OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FSentryFrameBreakdown::OnWorldCleanup);
+}
+
+FSentryFrameBreakdown::~FSentryFrameBreakdown()
+{
+	FCoreDelegates::OnBeginFrame.Remove(OnBeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+	FWorldDelegates::OnWorldTickStart.Remove(OnWorldTickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+
+	UnregisterMarkers();
+}
+
+uint64 FSentryFrameBreakdown::GetNextSampledFrame(uint64 FrameNumber, int32 SampleInterval, FRandomStream& Random)
+{
+	const int32 Interval = FMath::Max(1, SampleInterval);
+	return FrameNumber + FMath::Max(1, Interval / 2 + Random.RandHelper(Interval + 1));
+}
+
+void FSentryFrameBreakdown::OnTickGroupStarted(int32 GroupIndex)
+{
+	if (bIsSampling && TickGroupStartTimes.IsValidIndex(GroupIndex))
+	{
+		TickGroupStartTimes[GroupIndex] = FPlatformTime::Seconds();
+	}
+}
+
+void FSentryFrameBreakdown::OnBeginFrame()
+{
+	bIsSampling = GFrameCounter >= NextSampledFrame;
+	if (!bIsSampling)
+	{
+		return;
+	}
+
+	FrameStartTime = FPlatformTime::Seconds();
+	WorldTickStartTime = 0.0;
+	WorldTickEndTime = 0.0;
+
+	for (double& StartTime : TickGroupStartTimes)
+	{
+		StartTime = 0.0;
+	}
+}
+
+void FSentryFrameBreakdown::OnEndFrame()
+{
+	if (!bIsSampling)
+	{
+		return;
+	}
+
+	bIsSampling = false;
+	NextSampledFrame = GetNextSampledFrame(GFrameCounter, SampleInterval, Random);
+
+	FFrame Frame;
+	Frame.FrameNumber = GFrameCounter;
+	Frame.MapName = MarkedWorld.IsValid() ? MarkedWorld->GetMapName() : FString();
+	Frame.StartTime = FrameStartTime;
+	Frame.EndTime = FPlatformTime::Seconds();
+	Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Frame.RhiThreadMs = FPlatformTime::ToMilliseconds(GRHIThreadTime);
+	Frame.GpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+
+	if (WorldTickStartTime > 0.0 && WorldTickEndTime >= WorldTickStartTime)
+	{
+		Frame.TickSpans.Add({ TEXT("game.world_tick"), TEXT("World tick"), WorldTickStartTime, WorldTickEndTime });
+
+		// Groups without any tick functions still run their marker, groups that didn't run at all are skipped
+		for (int32 GroupIndex = 0; GroupIndex < TickGroupStartTimes.Num(); ++GroupIndex)
+		{
+			const double StartTime = TickGroupStartTimes[GroupIndex];
+			if (StartTime <= 0.0)
+			{
+				continue;
+			}
+
+			double EndTime = WorldTickEndTime;
+			for (int32 NextIndex = GroupIndex + 1; NextIndex < TickGroupStartTimes.Num(); ++NextIndex)
+			{
+				if (TickGroupStartTimes[NextIndex] > 0.0)
+				{
+					EndTime = TickGroupStartTimes[NextIndex];
+					break;
+				}
+			}
+
+			Frame.TickSpans.Add({ TEXT("game.tick_group"), SentryFrameBreakdown::TickGroups[GroupIndex].Name, StartTime, FMath::Max(StartTime, EndTime) });
+		}
+	}
+
+	OnFrameSampled(Frame);
+}
+
+void FSentryFrameBreakdown::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!World || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	if (!MarkedWorld.IsValid())
+	{
+		RegisterMarkers(World);
+	}
+
+	if (bIsSampling && World == MarkedWorld.Get())
+	{
+		WorldTickStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void FSentryFrameBreakdown::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (bIsSampling && World && World == MarkedWorld.Get())
+	{
+		WorldTickEndTime = FPlatformTime::Seconds();
+	}
+}
+
+void FSentryFrameBreakdown::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (World && World == MarkedWorld.Get())
+	{
+		UnregisterMarkers();
+	}
+}
+
+void FSentryFrameBreakdown::RegisterMarkers(UWorld* World)
+{
+	UnregisterMarkers();
+
+	if (!World->PersistentLevel)
+	{
+		return;
+	}
+
+	for (const TUniquePtr<FSentryTickGroupMarker>& Marker : Markers)
+	{
+		Marker->RegisterTickFunction(World->PersistentLevel);
+	}
+
+	MarkedWorld = World;
+}
+
+void FSentryFrameBreakdown::UnregisterMarkers()
+{
+	for (const TUniquePtr<FSentryTickGroupMarker>& Marker : Markers)
+	{
+		if (Marker->IsTickFunctionRegistered())
+		{
+			Marker->UnRegisterTickFunction();
+		}
+	}
+
+	MarkedWorld.Reset();
+}
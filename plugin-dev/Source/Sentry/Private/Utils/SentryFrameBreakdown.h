@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Math/RandomStream.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UWorld;
+struct FSentryTickGroupMarker;
+
+/**
+ * Records a full breakdown of one in every N frames, sent as a small transaction per sampled frame.
+ *
+ * Game thread tick groups are timed with high-priority marker tick functions registered with the game world, which run
+ * first in their group, so a group lasts from its marker to the next one. Render thread, RHI thread and GPU times are the
+ * engine's own per-frame counters, which lag the game thread by a frame or two due to pipelining. Frames to sample are
+ * picked with some jitter so that the samples don't lock onto periodic game work. Nothing but the marker timestamps
+ * is recorded for frames that aren't sampled.
+ */
+class FSentryFrameBreakdown
+{
+public:
+	struct FSpan
+	{
+		const TCHAR* Operation;
+		const TCHAR* Description;
+
+		/** Time the span started and ended at, in FPlatformTime::Seconds. */
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+	};
+
+	struct FFrame
+	{
+		uint64 FrameNumber = 0;
+		FString MapName;
+
+		/** Time the frame started and ended at, in FPlatformTime::Seconds. */
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+
+		/** World tick followed by its tick groups. */
+		TArray<FSpan> TickSpans;
+
+		float GameThreadMs = 0.0f;
+		float RenderThreadMs = 0.0f;
+		float RhiThreadMs = 0.0f;
+		float GpuMs = 0.0f;
+	};
+
+	using FOnFrameSampled = TFunction<void(const FFrame& Frame)>;
+
+	/**
+	 * @param SampleInterval Average number of frames between two sampled frames.
+	 * @param OnFrameSampled Called on the game thread at the end of every sampled frame.
+	 */
+	FSentryFrameBreakdown(int32 SampleInterval, FOnFrameSampled OnFrameSampled);
+	~FSentryFrameBreakdown();
+
+	/** Picks the frame to sample after the given one, half to one and a half intervals later. */
+	static uint64 GetNextSampledFrame(uint64 FrameNumber, int32 SampleInterval, FRandomStream& Random);
+
+	/** Called by the marker of the tick group when it starts. */
+	void OnTickGroupStarted(int32 GroupIndex);
+
+private:
+	void OnBeginFrame();
+	void OnEndFrame();
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** Moves the markers to the given world. */
+	void RegisterMarkers(UWorld* World);
+	void UnregisterMarkers();
+
+	const int32 SampleInterval;
+	FOnFrameSampled OnFrameSampled;
+
+	FRandomStream Random;
+	uint64 NextSampledFrame = 0;
+
+	/** Whether the current frame is sampled. */
+	bool bIsSampling = false;
+
+	TArray<TUniquePtr<FSentryTickGroupMarker>> Markers;
+	TWeakObjectPtr<UWorld> MarkedWorld;
+
+	double FrameStartTime = 0.0;
+	double WorldTickStartTime = 0.0;
+	double WorldTickEndTime = 0.0;
+	TArray<double> TickGroupStartTimes;
+
+	FDelegateHandle OnBeginFrameHandle;
+	FDelegateHandle OnEndFrameHandle;
+	FDelegateHandle OnWorldTickStartHandle;
+	FDelegateHandle OnWorldPostActorTickHandle;
+	FDelegateHandle OnWorldCleanupHandle;
+};
@@ -0,0 +1,252 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryFrameTimeHistory.h"
+
+#include "Algo/BinarySearch.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/CoreMisc.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+namespace SentryFrameTimeHistory
+{
+	/** Highest frame rate the ring is sized for, faster frames shorten the time span covered by the history. */
+	static constexpr int32 MaxFramesPerSecond = 240;
+
+	/** Max number of frame times listed in the context, the summary covers all recorded frames. */
+	static constexpr int32 MaxListedFrames = 300;
+
+	/** Frames slower than this miss the 30 FPS budget. */
+	static constexpr float SlowFrameMs = 1000.0f / 30.0f;
+
+	/** Frames slower than this are noticed by players as freezes. */
+	static constexpr float FrozenFrameMs = 700.0f;
+
+	struct FStat
+	{
+		float Sum = 0.0f;
+		float Max = 0.0f;
+
+		void Add(float ValueMs)
+		{
+			Sum += ValueMs;
+			Max = FMath::Max(Max, ValueMs);
+		}
+
+		void AddTo(TMap<FString, FSentryVariant>& Context, const TCHAR* Name, int32 NumFrames) const
+		{
+			Context.Add(FString::Printf(TEXT("%s_avg_ms"), Name), Sum / NumFrames);
+			Context.Add(FString::Printf(TEXT("%s_max_ms"), Name), Max);
+		}
+	};
+}
+
+FSentryFrameTimeHistory& FSentryFrameTimeHistory::Get()
+{
+	static FSentryFrameTimeHistory Instance;
+	return Instance;
+}
+
+void FSentryFrameTimeHistory::Start(float InHistorySeconds)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	HistorySeconds = FMath::Max(1.0f, InHistorySeconds);
+
+	// The ring is only reallocated while inactive, readers check the flag before touching it
+	const int32 NumSlots = FMath::Clamp(FMath::CeilToInt(HistorySeconds * SentryFrameTimeHistory::MaxFramesPerSecond), 60, 64 * 1024);
+	if (Frames.Num() != NumSlots)
+	{
+		Frames.Empty(NumSlots);
+		Frames.SetNumZeroed(NumSlots);
+	}
+
+	NumFramesWritten.Store(0);
+
+	LastFrameEndTime = FPlatformTime::Seconds();
+	PendingGcMs = 0.0f;
+
+	bIsActive = true;
+
+	OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSentryFrameTimeHistory::OnEndFrame);
+}
+
+void FSentryFrameTimeHistory::Stop()
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+	OnEndFrameHandle.Reset();
+
+	// Frames aren't freed since the crash handler or a capture on another thread may still be copying them
+	NumFramesWritten.Store(0);
+}
+
+TArray<FSentryFrameTimeHistory::FFrame> FSentryFrameTimeHistory::GetFrames() const
+{
+	TArray<FFrame> Result;
+
+	if (!bIsActive || Frames.Num() == 0)
+	{
+		return Result;
+	}
+
+	const uint64 Capacity = static_cast<uint64>(Frames.Num());
+
+	const uint64 End = NumFramesWritten.Load();
+	const uint64 Begin = End > Capacity ? End - Capacity : 0;
+
+	Result.Reserve(static_cast<int32>(End - Begin));
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		Result.Add(Frames[Index % Capacity]);
+	}
+
+	// Slots the game thread wrote to in the meantime may be torn, so only frames that are still in the ring are kept
+	const uint64 EndAfterCopy = NumFramesWritten.Load();
+	const uint64 FirstIntact = EndAfterCopy >= Capacity ? EndAfterCopy - Capacity + 1 : 0;
+	if (FirstIntact > Begin)
+	{
+		Result.RemoveAt(0, static_cast<int32>(FMath::Min(FirstIntact - Begin, End - Begin)));
+	}
+
+	if (Result.Num() > 0)
+	{
+		const double StartTime = Result.Last().EndTime - HistorySeconds;
+		const int32 NumExpired = Algo::LowerBoundBy(Result, StartTime, &FFrame::EndTime);
+		Result.RemoveAt(0, NumExpired);
+	}
+
+	return Result;
+}
+
+void FSentryFrameTimeHistory::AddGcPause(float PauseMs)
+{
+	if (bIsActive)
+	{
+		PendingGcMs += PauseMs;
+	}
+}
+
+TMap<FString, FSentryVariant> FSentryFrameTimeHistory::ToContext() const
+{
+	return ToContext(GetFrames());
+}
+
+TMap<FString, FSentryVariant> FSentryFrameTimeHistory::ToContext(const TArray<FFrame>& InFrames)
+{
+	TMap<FString, FSentryVariant> Context;
+
+	if (InFrames.Num() == 0)
+	{
+		return Context;
+	}
+
+	SentryFrameTimeHistory::FStat FrameStat;
+	SentryFrameTimeHistory::FStat GameThreadStat;
+	SentryFrameTimeHistory::FStat RenderThreadStat;
+	SentryFrameTimeHistory::FStat RhiThreadStat;
+	SentryFrameTimeHistory::FStat GpuStat;
+
+	int32 NumSlowFrames = 0;
+	int32 NumFrozenFrames = 0;
+
+	int32 NumGcFrames = 0;
+	float GcTotalMs = 0.0f;
+	float GcMaxMs = 0.0f;
+
+	for (const FFrame& Frame : InFrames)
+	{
+		FrameStat.Add(Frame.FrameMs);
+		GameThreadStat.Add(Frame.GameThreadMs);
+		RenderThreadStat.Add(Frame.RenderThreadMs);
+		RhiThreadStat.Add(Frame.RhiThreadMs);
+		GpuStat.Add(Frame.GpuMs);
+
+		NumSlowFrames += Frame.FrameMs > SentryFrameTimeHistory::SlowFrameMs ? 1 : 0;
+		NumFrozenFrames += Frame.FrameMs > SentryFrameTimeHistory::FrozenFrameMs ? 1 : 0;
+
+		if (Frame.GcMs > 0.0f)
+		{
+			++NumGcFrames;
+			GcTotalMs += Frame.GcMs;
+			GcMaxMs = FMath::Max(GcMaxMs, Frame.GcMs);
+		}
+	}
+
+	const int32 NumFrames = InFrames.Num();
+
+	Context.Add(TEXT("frames"), NumFrames);
+	Context.Add(TEXT("first_frame"), static_cast<int32>(InFrames[0].FrameNumber));
+	Context.Add(TEXT("last_frame"), static_cast<int32>(InFrames.Last().FrameNumber));
+	Context.Add(TEXT("duration_seconds"), static_cast<float>(InFrames.Last().EndTime - InFrames[0].EndTime + InFrames[0].FrameMs / 1000.0f));
+	Context.Add(TEXT("slow_frames"), NumSlowFrames);
+	Context.Add(TEXT("frozen_frames"), NumFrozenFrames);
+
+	FrameStat.AddTo(Context, TEXT("frame"), NumFrames);
+	GameThreadStat.AddTo(Context, TEXT("game_thread"), NumFrames);
+	RenderThreadStat.AddTo(Context, TEXT("render_thread"), NumFrames);
+	RhiThreadStat.AddTo(Context, TEXT("rhi_thread"), NumFrames);
+	GpuStat.AddTo(Context, TEXT("gpu"), NumFrames);
+
+	if (NumGcFrames > 0)
+	{
+		Context.Add(TEXT("gc_frames"), NumGcFrames);
+		Context.Add(TEXT("gc_total_ms"), GcTotalMs);
+		Context.Add(TEXT("gc_max_ms"), GcMaxMs);
+	}
+
+	// Most recent frame times as a single string, which is far more compact than an array of values
+	FString FrameTimes;
+	for (int32 Index = FMath::Max(0, NumFrames - SentryFrameTimeHistory::MaxListedFrames); Index < NumFrames; ++Index)
+	{
+		FrameTimes += FString::Printf(FrameTimes.IsEmpty() ? TEXT("%.1f") : TEXT(",%.1f"), InFrames[Index].FrameMs);
+	}
+
+	Context.Add(TEXT("recent_frame_ms"), MoveTemp(FrameTimes));
+
+	return Context;
+}
+
+void FSentryFrameTimeHistory::Record(const FFrame& Frame)
+{
+	if (Frames.Num() == 0)
+	{
+		return;
+	}
+
+	const uint64 Index = NumFramesWritten.Load();
+
+	Frames[Index % static_cast<uint64>(Frames.Num())] = Frame;
+
+	NumFramesWritten.Store(Index + 1);
+}
+
+void FSentryFrameTimeHistory::OnEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FFrame Frame(GFrameCounter, Now, static_cast<float>((Now - LastFrameEndTime) * 1000.0), PendingGcMs);
+	Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Frame.RhiThreadMs = FPlatformTime::ToMilliseconds(GRHIThreadTime);
+	Frame.GpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+
+	LastFrameEndTime = Now;
+	PendingGcMs = 0.0f;
+
+	Record(Frame);
+}
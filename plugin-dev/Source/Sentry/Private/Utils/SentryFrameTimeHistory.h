@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+
+#include "SentryVariant.h"
+
+/**
+ * Rolling history of the frame times of the last few seconds, added to events as the `performance` context.
+ *
+ * Once per frame the game thread writes a fixed-size record to a preallocated ring and publishes it by bumping
+ * an atomic counter, so recording takes a few nanoseconds and never locks or allocates. Readers copy the ring and
+ * drop the records that may have been overwritten while copying, which makes it safe to read from the crash handler.
+ */
+class FSentryFrameTimeHistory
+{
+public:
+	/** Times of a single frame in milliseconds. */
+	struct FFrame
+	{
+		/** Engine frame counter. */
+		uint64 FrameNumber = 0;
+
+		/** Time the frame ended at, in FPlatformTime::Seconds. */
+		double EndTime = 0.0;
+
+		float FrameMs = 0.0f;
+		float GameThreadMs = 0.0f;
+		float RenderThreadMs = 0.0f;
+		float RhiThreadMs = 0.0f;
+		float GpuMs = 0.0f;
+
+		/** Time the game thread spent in garbage collection pauses during the frame. */
+		float GcMs = 0.0f;
+
+		FFrame() = default;
+
+		FFrame(uint64 InFrameNumber, double InEndTime, float InFrameMs, float InGcMs = 0.0f)
+			: FrameNumber(InFrameNumber)
+			, EndTime(InEndTime)
+			, FrameMs(InFrameMs)
+			, GcMs(InGcMs)
+		{
+		}
+	};
+
+	static FSentryFrameTimeHistory& Get();
+
+	/**
+	 * Starts recording frame times. Called on the game thread.
+	 *
+	 * @param InHistorySeconds Time span covered by the history.
+	 */
+	void Start(float InHistorySeconds);
+
+	/** Stops recording frame times and discards the recorded frames. The ring is kept allocated for readers on other threads. */
+	void Stop();
+
+	/** Checks whether frame times are being recorded. */
+	bool IsActive() const { return bIsActive; }
+
+	/** Gets the frames recorded within the history time span, oldest first. Safe to call from any thread including the crash handler. */
+	TArray<FFrame> GetFrames() const;
+
+	/** Adds a garbage collection pause to the frame in progress. Called on the game thread. */
+	void AddGcPause(float PauseMs);
+
+	/** Converts the recorded frames to the values of the performance context, empty if nothing was recorded. */
+	TMap<FString, FSentryVariant> ToContext() const;
+
+	/** Converts frames to the values of the performance context. */
+	static TMap<FString, FSentryVariant> ToContext(const TArray<FFrame>& InFrames);
+
+private:
+	FSentryFrameTimeHistory() = default;
+
+	void OnEndFrame();
+
+	/** Publishes the frame to the ring. Called on the game thread only. */
+	void Record(const FFrame& Frame);
+
+	FThreadSafeBool bIsActive;
+
+	FDelegateHandle OnEndFrameHandle;
+
+	double HistorySeconds = 10.0;
+
+	/** Time the previous frame ended at, in FPlatformTime::Seconds. Game thread only. */
+	double LastFrameEndTime = 0.0;
+
+	/** Garbage collection pauses of the frame in progress. Game thread only. */
+	float PendingGcMs = 0.0f;
+
+	TArray<FFrame> Frames;
+
+	/** Number of frames recorded since the start, the slot of the next frame is derived from it. */
+	TAtomic<uint64> NumFramesWritten { 0 };
+};
@@ -0,0 +1,211 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryGpuBreadcrumbs.h"
+
+#include "SentryDefines.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/CoreDelegates.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+
+namespace SentryGpuBreadcrumbs
+{
+	static const FName FrameBeginMarker(TEXT("FrameBegin"));
+	static const FName SlatePresentMarker(TEXT("SlatePresent"));
+	static const FName FrameEndMarker(TEXT("FrameEnd"));
+}
+
+FSentryGpuBreadcrumbs::FSentryGpuBreadcrumbs()
+	: LastCompletedSequence(0)
+{
+}
+
+FSentryGpuBreadcrumbs& FSentryGpuBreadcrumbs::Get()
+{
+	static FSentryGpuBreadcrumbs Instance;
+	return Instance;
+}
+
+bool FSentryGpuBreadcrumbs::Start(int32 InCapacity)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	if (GUsingNullRHI)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("GPU breadcrumbs are disabled since rendering is disabled."));
+		return false;
+	}
+
+	// Ring is only accessed on the render thread and by the crash handler from here on
+	FlushRenderingCommands();
+
+	Slots.Empty();
+	Slots.SetNum(FMath::Clamp(InCapacity, 8, 1024));
+	NextSequence = 1;
+	LastCompletedSequence = 0;
+
+	bIsActive = true;
+
+	OnBeginFrameHandle = FCoreDelegates::OnBeginFrameRT.AddRaw(this, &FSentryGpuBreadcrumbs::OnBeginFrameRT);
+	OnEndFrameHandle = FCoreDelegates::OnEndFrameRT.AddRaw(this, &FSentryGpuBreadcrumbs::OnEndFrameRT);
+
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		OnBackBufferReadyHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddRaw(this, &FSentryGpuBreadcrumbs::OnBackBufferReadyToPresent);
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("GPU breadcrumbs enabled, keeping the last %d markers."), Slots.Num());
+
+	return true;
+}
+
+void FSentryGpuBreadcrumbs::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FCoreDelegates::OnBeginFrameRT.Remove(OnBeginFrameHandle);
+	FCoreDelegates::OnEndFrameRT.Remove(OnEndFrameHandle);
+
+	if (OnBackBufferReadyHandle.IsValid() && FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(OnBackBufferReadyHandle);
+	}
+
+	OnBeginFrameHandle.Reset();
+	OnEndFrameHandle.Reset();
+	OnBackBufferReadyHandle.Reset();
+
+	// Make sure the render thread is done with the fences before releasing them
+	FlushRenderingCommands();
+
+	Slots.Empty();
+}
+
+void FSentryGpuBreadcrumbs::AddMarker(FRHICommandListImmediate& RHICmdList, FName Name)
+{
+	check(IsInRenderingThread());
+
+	if (!bIsActive || Slots.Num() == 0)
+	{
+		return;
+	}
+
+	PollFences();
+
+	const uint64 Sequence = NextSequence++;
+
+	FSlot& Slot = Slots[Sequence % Slots.Num()];
+
+	// Hide the slot from the crash handler while it's being rewritten
+	Slot.Sequence = 0;
+
+	if (!Slot.Fence.IsValid())
+	{
+		Slot.Fence = RHICreateGPUFence(TEXT("SentryGpuBreadcrumb"));
+	}
+	else
+	{
+		Slot.Fence->Clear();
+	}
+
+	Slot.Name = Name;
+	Slot.Frame = GFrameNumberRenderThread;
+
+	RHICmdList.WriteGPUFence(Slot.Fence);
+
+	Slot.Sequence = Sequence;
+}
+
+TArray<FSentryGpuBreadcrumb> FSentryGpuBreadcrumbs::GetBreadcrumbs() const
+{
+	TArray<TPair<uint64, FSentryGpuBreadcrumb>> SortedBreadcrumbs;
+	SortedBreadcrumbs.Reserve(Slots.Num());
+
+	const uint64 LastCompleted = LastCompletedSequence.Load();
+
+	for (const FSlot& Slot : Slots)
+	{
+		const uint64 Sequence = Slot.Sequence.Load();
+		if (Sequence == 0)
+		{
+			continue;
+		}
+
+		FSentryGpuBreadcrumb Breadcrumb;
+		Breadcrumb.Name = Slot.Name;
+		Breadcrumb.Frame = Slot.Frame;
+		Breadcrumb.bIsCompleted = Sequence <= LastCompleted;
+
+		SortedBreadcrumbs.Emplace(Sequence, Breadcrumb);
+	}
+
+	SortedBreadcrumbs.Sort([](const TPair<uint64, FSentryGpuBreadcrumb>& A, const TPair<uint64, FSentryGpuBreadcrumb>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	TArray<FSentryGpuBreadcrumb> Breadcrumbs;
+	Breadcrumbs.Reserve(SortedBreadcrumbs.Num());
+
+	for (const TPair<uint64, FSentryGpuBreadcrumb>& SortedBreadcrumb : SortedBreadcrumbs)
+	{
+		Breadcrumbs.Add(SortedBreadcrumb.Value);
+	}
+
+	return Breadcrumbs;
+}
+
+void FSentryGpuBreadcrumbs::OnBeginFrameRT()
+{
+	AddMarker(FRHICommandListExecutor::GetImmediateCommandList(), SentryGpuBreadcrumbs::FrameBeginMarker);
+}
+
+void FSentryGpuBreadcrumbs::OnEndFrameRT()
+{
+	AddMarker(FRHICommandListExecutor::GetImmediateCommandList(), SentryGpuBreadcrumbs::FrameEndMarker);
+}
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+void FSentryGpuBreadcrumbs::OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer)
+#else
+void FSentryGpuBreadcrumbs::OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer)
+#endif
+{
+	AddMarker(FRHICommandListExecutor::GetImmediateCommandList(), SentryGpuBreadcrumbs::SlatePresentMarker);
+}
+
+void FSentryGpuBreadcrumbs::PollFences()
+{
+	const uint64 NumSlots = static_cast<uint64>(Slots.Num());
+
+	// Markers that were overwritten before they got polled can't be checked anymore
+	uint64 Sequence = LastCompletedSequence.Load(EMemoryOrder::Relaxed) + 1;
+	if (NextSequence > NumSlots && Sequence < NextSequence - NumSlots)
+	{
+		Sequence = NextSequence - NumSlots;
+	}
+
+	// GPU executes the fences in order, so the first unsignaled one is the oldest pass still in flight
+	for (; Sequence < NextSequence; ++Sequence)
+	{
+		const FSlot& Slot = Slots[Sequence % NumSlots];
+		if (Slot.Sequence.Load(EMemoryOrder::Relaxed) != Sequence || !Slot.Fence.IsValid() || !Slot.Fence->Poll())
+		{
+			break;
+		}
+
+		LastCompletedSequence = Sequence;
+	}
+}
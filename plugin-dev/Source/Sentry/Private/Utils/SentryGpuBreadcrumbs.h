@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RHI.h"
+#include "Templates/Atomic.h"
+
+class FRHICommandListImmediate;
+class SWindow;
+
+/** Pass marker as seen by the crash handler. */
+struct FSentryGpuBreadcrumb
+{
+	FName Name;
+	uint32 Frame = 0;
+
+	/** Whether the GPU was known to have finished the pass when it was last checked. */
+	bool bIsCompleted = false;
+};
+
+/**
+ * Vendor-agnostic GPU breadcrumbs for attributing GPU crashes.
+ *
+ * Keeps a ring of pass markers, each followed by a GPU fence written into the command stream. Fences are polled on the
+ * render thread whenever a new marker is added, so the last pass the GPU is known to have completed is tracked while
+ * the device is alive. Once the device is lost fences can no longer be trusted, the crash handler only reads the ring.
+ *
+ * Frame begin, Slate present and frame end are marked automatically, projects can add their own passes from the
+ * render thread via SentryGpuMarkers::Add.
+ */
+class FSentryGpuBreadcrumbs
+{
+public:
+	static FSentryGpuBreadcrumbs& Get();
+
+	/** Starts recording markers, called on the game thread. */
+	bool Start(int32 InCapacity);
+
+	/** Stops recording markers and releases the fences. */
+	void Stop();
+
+	/** Checks whether markers are being recorded. */
+	bool IsActive() const { return bIsActive; }
+
+	/** Adds a marker followed by a GPU fence to the command list. Called on the render thread. */
+	void AddMarker(FRHICommandListImmediate& RHICmdList, FName Name);
+
+	/** Gets the markers in the ring, oldest first. Doesn't lock anything so that it can be used from the crash handler. */
+	TArray<FSentryGpuBreadcrumb> GetBreadcrumbs() const;
+
+private:
+	struct FSlot
+	{
+		FName Name;
+		uint32 Frame = 0;
+		FGPUFenceRHIRef Fence;
+
+		/** Sequence number of the marker in the slot, 0 if it was never written. Published after the other fields. */
+		TAtomic<uint64> Sequence;
+
+		FSlot()
+			: Sequence(0)
+		{
+		}
+	};
+
+	void OnBeginFrameRT();
+	void OnEndFrameRT();
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer);
+#else
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer);
+#endif
+
+	/** Advances the last completed marker past the fences the GPU has signaled so far. */
+	void PollFences();
+
+	FThreadSafeBool bIsActive;
+
+	FDelegateHandle OnBeginFrameHandle;
+	FDelegateHandle OnEndFrameHandle;
+	FDelegateHandle OnBackBufferReadyHandle;
+
+	/** Ring of markers, only resized on the game thread while the render thread is flushed. */
+	TArray<FSlot> Slots;
+
+	// Render thread state
+	uint64 NextSequence = 1;
+
+	/** Sequence number of the newest marker the GPU is known to have completed. */
+	TAtomic<uint64> LastCompletedSequence;
+
+	FSentryGpuBreadcrumbs();
+};
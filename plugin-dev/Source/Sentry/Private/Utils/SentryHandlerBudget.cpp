@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryHandlerBudget.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformTime.h"
+
+namespace SentryHandlerBudget
+{
+	/** Number of consecutive calls over the budget after which the handler is disabled. */
+	static const int32 MaxOverBudgetInRow = 5;
+
+	/** Min time between the warnings about the same handler. */
+	static const double WarningIntervalSeconds = 10.0;
+
+	/** Weight of the latest call in the moving average, out of 16. */
+	static const uint64 RecentAverageWeight = 2;
+}
+
+void FSentryHandlerBudget::FCounters::Reset()
+{
+	NumCalls = 0;
+	NumOverBudget = 0;
+	TotalCycles = 0;
+	MaxCycles = 0;
+	RecentAverageCycles = 0;
+	NumOverBudgetInRow = 0;
+	LastWarningCycles = 0;
+	bIsDisabled = false;
+}
+
+FSentryHandlerBudget& FSentryHandlerBudget::Get()
+{
+	static FSentryHandlerBudget Instance;
+	return Instance;
+}
+
+FSentryHandlerBudget::FSentryHandlerBudget()
+	: BudgetCycles(0)
+	, bDisableOverBudget(false)
+{
+	for (FCounters& HandlerCounters : Counters)
+	{
+		HandlerCounters.Reset();
+	}
+}
+
+void FSentryHandlerBudget::Start(float InBudgetMs, bool bInDisableOverBudget)
+{
+	for (FCounters& HandlerCounters : Counters)
+	{
+		HandlerCounters.Reset();
+	}
+
+	BudgetCycles = InBudgetMs > 0.0f ? static_cast<uint64>(InBudgetMs / 1000.0 / FPlatformTime::GetSecondsPerCycle64()) : 0;
+	bDisableOverBudget = bInDisableOverBudget;
+}
+
+void FSentryHandlerBudget::Stop()
+{
+	for (uint8 Index = 0; Index < static_cast<uint8>(ESentryHandlerType::Count); ++Index)
+	{
+		const ESentryHandlerType Type = static_cast<ESentryHandlerType>(Index);
+
+		const FSentryHandlerStats Stats = GetStats(Type);
+		if (Stats.NumCalls == 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogSentrySdk, Log, TEXT("%s handler was called %llu times taking %.3f ms on average and %.3f ms at most, %llu calls exceeded the budget."),
+			GetName(Type), Stats.NumCalls, Stats.GetAverageMs(), Stats.MaxMs, Stats.NumOverBudget);
+	}
+}
+
+bool FSentryHandlerBudget::IsDisabled(ESentryHandlerType Type) const
+{
+	return Counters[static_cast<uint8>(Type)].bIsDisabled.Load(EMemoryOrder::Relaxed);
+}
+
+void FSentryHandlerBudget::Record(ESentryHandlerType Type, uint64 Cycles)
+{
+	FCounters& HandlerCounters = Counters[static_cast<uint8>(Type)];
+
+	HandlerCounters.NumCalls.IncrementExchange();
+	HandlerCounters.TotalCycles.AddExchange(Cycles);
+
+	uint64 MaxCycles = HandlerCounters.MaxCycles.Load(EMemoryOrder::Relaxed);
+	while (Cycles > MaxCycles && !HandlerCounters.MaxCycles.CompareExchange(MaxCycles, Cycles))
+	{
+	}
+
+	const uint64 RecentAverageCycles = HandlerCounters.RecentAverageCycles.Load(EMemoryOrder::Relaxed);
+	HandlerCounters.RecentAverageCycles.Store(
+		(RecentAverageCycles * (16 - SentryHandlerBudget::RecentAverageWeight) + Cycles * SentryHandlerBudget::RecentAverageWeight) / 16, EMemoryOrder::Relaxed);
+
+	const uint64 Budget = BudgetCycles.Load(EMemoryOrder::Relaxed);
+	if (Budget == 0 || Cycles <= Budget)
+	{
+		HandlerCounters.NumOverBudgetInRow.Store(0, EMemoryOrder::Relaxed);
+		return;
+	}
+
+	HandlerCounters.NumOverBudget.IncrementExchange();
+
+	const double CallMs = FPlatformTime::ToMilliseconds64(Cycles);
+	const double BudgetMs = FPlatformTime::ToMilliseconds64(Budget);
+
+	if (bDisableOverBudget.Load(EMemoryOrder::Relaxed) && HandlerCounters.NumOverBudgetInRow.IncrementExchange() + 1 >= SentryHandlerBudget::MaxOverBudgetInRow)
+	{
+		if (!HandlerCounters.bIsDisabled.Exchange(true))
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("%s handler exceeded the %.3f ms budget %d calls in a row (last call took %.3f ms) and is disabled for the rest of the session."),
+				GetName(Type), BudgetMs, SentryHandlerBudget::MaxOverBudgetInRow, CallMs);
+		}
+		return;
+	}
+
+	const uint64 Now = FPlatformTime::Cycles64();
+	const uint64 WarningIntervalCycles = static_cast<uint64>(SentryHandlerBudget::WarningIntervalSeconds / FPlatformTime::GetSecondsPerCycle64());
+
+	uint64 LastWarningCycles = HandlerCounters.LastWarningCycles.Load(EMemoryOrder::Relaxed);
+	if ((LastWarningCycles == 0 || Now - LastWarningCycles >= WarningIntervalCycles) && HandlerCounters.LastWarningCycles.CompareExchange(LastWarningCycles, Now))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("%s handler call took %.3f ms exceeding the %.3f ms budget."), GetName(Type), CallMs, BudgetMs);
+	}
+}
+
+FSentryHandlerStats FSentryHandlerBudget::GetStats(ESentryHandlerType Type) const
+{
+	const FCounters& HandlerCounters = Counters[static_cast<uint8>(Type)];
+
+	FSentryHandlerStats Stats;
+	Stats.NumCalls = HandlerCounters.NumCalls.Load();
+	Stats.NumOverBudget = HandlerCounters.NumOverBudget.Load();
+	Stats.TotalMs = FPlatformTime::ToMilliseconds64(HandlerCounters.TotalCycles.Load());
+	Stats.MaxMs = FPlatformTime::ToMilliseconds64(HandlerCounters.MaxCycles.Load());
+	Stats.RecentAverageMs = FPlatformTime::ToMilliseconds64(HandlerCounters.RecentAverageCycles.Load());
+	Stats.bIsDisabled = HandlerCounters.bIsDisabled.Load();
+	return Stats;
+}
+
+const TCHAR* FSentryHandlerBudget::GetName(ESentryHandlerType Type)
+{
+	switch (Type)
+	{
+	case ESentryHandlerType::BeforeSend:
+		return TEXT("BeforeSend");
+	case ESentryHandlerType::BeforeBreadcrumb:
+		return TEXT("BeforeBreadcrumb");
+	case ESentryHandlerType::BeforeLog:
+		return TEXT("BeforeLog");
+	case ESentryHandlerType::TraceSampler:
+		return TEXT("TraceSampler");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+FSentryHandlerBudget::FScope::FScope(ESentryHandlerType InType)
+	: Type(InType)
+	, StartCycles(FPlatformTime::Cycles64())
+{
+}
+
+FSentryHandlerBudget::FScope::~FScope()
+{
+	FSentryHandlerBudget::Get().Record(Type, FPlatformTime::Cycles64() - StartCycles);
+}
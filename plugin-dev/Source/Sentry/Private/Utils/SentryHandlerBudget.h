@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+/** Custom callback handlers whose execution time is tracked. */
+enum class ESentryHandlerType : uint8
+{
+	BeforeSend,
+	BeforeBreadcrumb,
+	BeforeLog,
+	TraceSampler,
+
+	Count
+};
+
+/** Execution time statistics of a custom callback handler. */
+struct FSentryHandlerStats
+{
+	uint64 NumCalls = 0;
+
+	/** Number of calls that took longer than the budget. */
+	uint64 NumOverBudget = 0;
+
+	double TotalMs = 0.0;
+	double MaxMs = 0.0;
+
+	/** Moving average over the recent calls. */
+	double RecentAverageMs = 0.0;
+
+	bool bIsDisabled = false;
+
+	double GetAverageMs() const { return NumCalls > 0 ? TotalMs / NumCalls : 0.0; }
+};
+
+/**
+ * Times the custom `beforeSend`, `beforeBreadcrumb`, `beforeLog` and traces sampler handlers.
+ *
+ * Calls exceeding the per-call budget are reported with a (throttled) warning. If slow handlers are to be disabled,
+ * a handler exceeding the budget several calls in a row is skipped for the rest of the session as if it wasn't set.
+ * Statistics are kept for the whole session regardless of the budget and are cheap to update from any thread.
+ */
+class FSentryHandlerBudget
+{
+public:
+	static FSentryHandlerBudget& Get();
+
+	/** Resets the statistics and applies the budget, 0 for no budget. Called on initialization. */
+	void Start(float InBudgetMs, bool bInDisableOverBudget);
+
+	/** Logs the statistics of the handlers that were called. Called when the SDK is closed. */
+	void Stop();
+
+	/** Checks whether the handler has been disabled for exceeding the budget. */
+	bool IsDisabled(ESentryHandlerType Type) const;
+
+	/** Accounts a single call of the handler. */
+	void Record(ESentryHandlerType Type, uint64 Cycles);
+
+	FSentryHandlerStats GetStats(ESentryHandlerType Type) const;
+
+	/** Times the handler call within the scope. */
+	class FScope
+	{
+	public:
+		explicit FScope(ESentryHandlerType InType);
+		~FScope();
+
+	private:
+		ESentryHandlerType Type;
+		uint64 StartCycles;
+	};
+
+private:
+	FSentryHandlerBudget();
+
+	struct FCounters
+	{
+		TAtomic<uint64> NumCalls;
+		TAtomic<uint64> NumOverBudget;
+		TAtomic<uint64> TotalCycles;
+		TAtomic<uint64> MaxCycles;
+
+		/** Moving average in cycles, updated without synchronization as an approximation is good enough. */
+		TAtomic<uint64> RecentAverageCycles;
+
+		TAtomic<int32> NumOverBudgetInRow;
+		TAtomic<uint64> LastWarningCycles;
+		TAtomic<bool> bIsDisabled;
+
+		void Reset();
+	};
+
+	static const TCHAR* GetName(ESentryHandlerType Type);
+
+	FCounters Counters[static_cast<uint8>(ESentryHandlerType::Count)];
+
+	TAtomic<uint64> BudgetCycles;
+	TAtomic<bool> bDisableOverBudget;
+};
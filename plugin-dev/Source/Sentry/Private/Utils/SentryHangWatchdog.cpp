@@ -0,0 +1,301 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryHangWatchdog.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+
+namespace SentryHangWatchdog
+{
+	/** Max number of frames captured from each thread. */
+	static constexpr int32 MaxDepth = 128;
+
+	/** Longest time between two checks so that the reported hang duration stays accurate for long timeouts. */
+	static constexpr float MaxCheckIntervalSeconds = 0.5f;
+
+	static constexpr int32 NumThreads = static_cast<int32>(ESentryHangThread::Num);
+}
+
+FSentryHangWatchdog::FSharedState::FSharedState()
+{
+	for (int32 Index = 0; Index < SentryHangWatchdog::NumThreads; ++Index)
+	{
+		StalledSinceCycles[Index].Store(0);
+		ThreadIds[Index].Store(0);
+		bIsWatched[Index] = false;
+	}
+}
+
+bool FSentryHangWatchdog::FSharedState::Request(ESentryHangThread HangThread)
+{
+	uint64 Expected = 0;
+	return StalledSinceCycles[static_cast<int32>(HangThread)].CompareExchange(Expected, FPlatformTime::Cycles64());
+}
+
+void FSentryHangWatchdog::FSharedState::Respond(ESentryHangThread HangThread)
+{
+	ThreadIds[static_cast<int32>(HangThread)].Store(FPlatformTLS::GetCurrentThreadId(), EMemoryOrder::Relaxed);
+	StalledSinceCycles[static_cast<int32>(HangThread)].Store(0);
+}
+
+FSentryHangWatchdog::FSentryHangWatchdog(float InGameThreadTimeoutSeconds, float InRenderThreadTimeoutSeconds, float InRHIThreadTimeoutSeconds, FSentryOnHangDetected InOnHangDetected)
+	: State(MakeShared<FSharedState, ESPMode::ThreadSafe>())
+	, OnHangDetected(MoveTemp(InOnHangDetected))
+	, bIsSuspended(false)
+	, ResumedCycles(0)
+{
+	const float Timeouts[SentryHangWatchdog::NumThreads] = { InGameThreadTimeoutSeconds, InRenderThreadTimeoutSeconds, InRHIThreadTimeoutSeconds };
+
+	for (int32 Index = 0; Index < SentryHangWatchdog::NumThreads; ++Index)
+	{
+		State->bIsWatched[Index] = Timeouts[Index] > 0.0f;
+		TimeoutSeconds[Index] = FMath::Max(0.1f, Timeouts[Index]);
+	}
+
+	State->ThreadIds[static_cast<int32>(ESentryHangThread::Game)].Store(GGameThreadId);
+	State->StalledSinceCycles[static_cast<int32>(ESentryHangThread::Game)].Store(FPlatformTime::Cycles64());
+
+	Thread = FRunnableThread::Create(this, TEXT("SentryHangWatchdog"), 0, TPri_BelowNormal);
+}
+
+FSentryHangWatchdog::~FSentryHangWatchdog()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+void FSentryHangWatchdog::Heartbeat()
+{
+	check(IsInGameThread());
+
+	State->StalledSinceCycles[static_cast<int32>(ESentryHangThread::Game)].Store(FPlatformTime::Cycles64(), EMemoryOrder::Relaxed);
+
+	// Without a dedicated render thread render commands run inline and the game thread heartbeat covers them
+	if (!State->bIsWatched[static_cast<int32>(ESentryHangThread::Render)] || !GIsThreadedRendering)
+	{
+		return;
+	}
+
+	if (!State->Request(ESentryHangThread::Render))
+	{
+		// Previous request hasn't been answered yet
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(SentryHangWatchdogHeartbeat)([SharedState = State](FRHICommandListImmediate& RHICmdList)
+	{
+		SharedState->Respond(ESentryHangThread::Render);
+
+		if (!SharedState->bIsWatched[static_cast<int32>(ESentryHangThread::RHI)])
+		{
+			return;
+		}
+
+		// With RHI tasks instead of a dedicated thread the lambda runs on any worker, whose stack wouldn't tell anything
+		if (!IsRunningRHIInDedicatedThread())
+		{
+			SharedState->ThreadIds[static_cast<int32>(ESentryHangThread::RHI)].Store(0, EMemoryOrder::Relaxed);
+			return;
+		}
+
+		if (SharedState->Request(ESentryHangThread::RHI))
+		{
+			RHICmdList.EnqueueLambda([SharedState](auto&)
+			{
+				SharedState->Respond(ESentryHangThread::RHI);
+			});
+		}
+	});
+}
+
+void FSentryHangWatchdog::Suspend()
+{
+	bIsSuspended = true;
+}
+
+void FSentryHangWatchdog::Resume()
+{
+	ResumedCycles = FPlatformTime::Cycles64();
+	bIsSuspended = false;
+}
+
+uint32 FSentryHangWatchdog::Run()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	// Threads that aren't watched keep the clamped timeout, they mustn't make the watchdog wake up more often
+	double MinTimeoutSeconds = TNumericLimits<double>::Max();
+	for (int32 Index = 0; Index < SentryHangWatchdog::NumThreads; ++Index)
+	{
+		if (State->bIsWatched[Index])
+		{
+			MinTimeoutSeconds = FMath::Min(MinTimeoutSeconds, TimeoutSeconds[Index]);
+		}
+	}
+
+	const float CheckInterval = static_cast<float>(FMath::Min(MinTimeoutSeconds / 4.0, static_cast<double>(SentryHangWatchdog::MaxCheckIntervalSeconds)));
+
+	while (StopRequested.GetValue() == 0)
+	{
+		FPlatformProcess::SleepNoStats(CheckInterval);
+
+		CheckHeartbeats();
+	}
+
+	return 0;
+}
+
+void FSentryHangWatchdog::Stop()
+{
+	StopRequested.Set(1);
+}
+
+const TCHAR* FSentryHangWatchdog::GetThreadName(ESentryHangThread HangThread)
+{
+	switch (HangThread)
+	{
+	case ESentryHangThread::Game:
+		return TEXT("GameThread");
+	case ESentryHangThread::Render:
+		return TEXT("RenderThread");
+	case ESentryHangThread::RHI:
+		return TEXT("RHIThread");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+void FSentryHangWatchdog::CheckHeartbeats()
+{
+	if (bIsSuspended)
+	{
+		return;
+	}
+
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	const uint64 Resumed = ResumedCycles.Load(EMemoryOrder::Relaxed);
+
+	uint64 StalledSince[SentryHangWatchdog::NumThreads] = {};
+	bool bHasNewStall = false;
+	bool bHasReportedStall = false;
+	int32 CulpritThread = INDEX_NONE;
+
+	for (int32 Index = 0; Index < SentryHangWatchdog::NumThreads; ++Index)
+	{
+		const uint64 SinceCycles = State->StalledSinceCycles[Index].Load(EMemoryOrder::Relaxed);
+		if (!State->bIsWatched[Index] || SinceCycles == 0)
+		{
+			continue;
+		}
+
+		const uint64 EffectiveSinceCycles = FMath::Max(SinceCycles, Resumed);
+		if (NowCycles <= EffectiveSinceCycles || FPlatformTime::ToSeconds64(NowCycles - EffectiveSinceCycles) < TimeoutSeconds[Index])
+		{
+			continue;
+		}
+
+		StalledSince[Index] = SinceCycles;
+
+		if (ReportedSinceCycles[Index] == SinceCycles)
+		{
+			bHasReportedStall = true;
+		}
+		else
+		{
+			bHasNewStall = true;
+		}
+
+		if (CulpritThread == INDEX_NONE || EffectiveSinceCycles < FMath::Max(StalledSince[CulpritThread], Resumed))
+		{
+			CulpritThread = Index;
+		}
+	}
+
+	if (!bHasNewStall)
+	{
+		// Nothing is stalled or waiting for the reported thread to recover
+		return;
+	}
+
+	// Threads that stall while another one is reported already are part of the same hang.
+	// Breakpoints stop the watched threads too, there's no point reporting them.
+	if (bHasReportedStall || FPlatformMisc::IsDebuggerPresent())
+	{
+		for (int32 Index = 0; Index < SentryHangWatchdog::NumThreads; ++Index)
+		{
+			if (StalledSince[Index] != 0)
+			{
+				ReportedSinceCycles[Index] = StalledSince[Index];
+			}
+		}
+		return;
+	}
+
+	FSentryHangReport Report;
+
+	// Culprit goes first so that its stack is the closest to the moment the hang was detected at
+	int32 CaptureOrder[SentryHangWatchdog::NumThreads] = { CulpritThread };
+	for (int32 Index = 0, OrderIndex = 1; Index < SentryHangWatchdog::NumThreads; ++Index)
+	{
+		if (Index != CulpritThread)
+		{
+			CaptureOrder[OrderIndex++] = Index;
+		}
+	}
+
+	for (int32 Index : CaptureOrder)
+	{
+		const uint32 ThreadId = State->ThreadIds[Index].Load(EMemoryOrder::Relaxed);
+		if (!State->bIsWatched[Index] || ThreadId == 0)
+		{
+			continue;
+		}
+
+		uint64 ProgramCounters[SentryHangWatchdog::MaxDepth];
+		const int32 Depth = static_cast<int32>(FPlatformStackWalk::CaptureThreadStackBackTrace(ThreadId, ProgramCounters, SentryHangWatchdog::MaxDepth));
+		if (Depth <= 0)
+		{
+			continue;
+		}
+
+		FSentryHangThreadStack& ThreadStack = Report.Threads.AddDefaulted_GetRef();
+		ThreadStack.Name = GetThreadName(static_cast<ESentryHangThread>(Index));
+		ThreadStack.ThreadId = ThreadId;
+		ThreadStack.bIsStalled = StalledSince[Index] != 0;
+		ThreadStack.StalledSeconds = ThreadStack.bIsStalled ? FPlatformTime::ToSeconds64(NowCycles - FMath::Max(StalledSince[Index], Resumed)) : 0.0;
+		ThreadStack.ProgramCounters.Append(ProgramCounters, Depth);
+
+		if (Index == CulpritThread)
+		{
+			Report.CulpritIndex = Report.Threads.Num() - 1;
+		}
+	}
+
+	// Culprit may have recovered while the stacks were being captured, in which case they don't belong to the hang
+	if (Report.CulpritIndex == INDEX_NONE || State->StalledSinceCycles[CulpritThread].Load(EMemoryOrder::Relaxed) != StalledSince[CulpritThread])
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < SentryHangWatchdog::NumThreads; ++Index)
+	{
+		if (StalledSince[Index] != 0)
+		{
+			ReportedSinceCycles[Index] = StalledSince[Index];
+		}
+	}
+
+	OnHangDetected.ExecuteIfBound(Report);
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Atomic.h"
+
+class FRunnableThread;
+
+enum class ESentryHangThread : uint8
+{
+	Game,
+	Render,
+	RHI,
+	Num
+};
+
+struct FSentryHangThreadStack
+{
+	FString Name;
+	uint32 ThreadId = 0;
+
+	/** Whether the thread has been unresponsive for longer than its timeout. */
+	bool bIsStalled = false;
+	double StalledSeconds = 0.0;
+
+	TArray<uint64> ProgramCounters;
+};
+
+struct FSentryHangReport
+{
+	/** Call stacks of all watched threads that have been seen running so far. */
+	TArray<FSentryHangThreadStack> Threads;
+
+	/** Index in Threads of the thread that stalled first, the one the hang is attributed to. */
+	int32 CulpritIndex = INDEX_NONE;
+
+	const FSentryHangThreadStack& GetCulprit() const { return Threads[CulpritIndex]; }
+};
+
+/** Called on the watchdog thread with the call stacks of the watched threads. */
+DECLARE_DELEGATE_OneParam(FSentryOnHangDetected, const FSentryHangReport& /* Report */);
+
+/**
+ * Detects hangs of the game, render and RHI threads.
+ *
+ * The game thread reports a heartbeat once per frame. The render and RHI threads can legitimately idle while waiting
+ * for work, so instead each heartbeat of the game thread sends them a request which they answer once they get to it,
+ * and they're considered unresponsive only while a request is outstanding. This way a game thread waiting on
+ * FlushRenderingCommands doesn't hide the render thread stall behind it.
+ *
+ * Once any thread is unresponsive for longer than its own timeout the call stacks of all watched threads are
+ * captured without suspending the process and reported once per hang, attributed to the thread that stalled first.
+ */
+class FSentryHangWatchdog : public FRunnable
+{
+public:
+	/** Timeouts of 0 disable watching the corresponding thread. */
+	FSentryHangWatchdog(float InGameThreadTimeoutSeconds, float InRenderThreadTimeoutSeconds, float InRHIThreadTimeoutSeconds, FSentryOnHangDetected InOnHangDetected);
+	virtual ~FSentryHangWatchdog() override;
+
+	/** Reports that the game thread is responsive and sends heartbeat requests to the render and RHI threads. */
+	void Heartbeat();
+
+	/** Stops reporting hangs while the game thread is expected to block, e.g. during a blocking map load. */
+	void Suspend();
+
+	/** Resumes reporting hangs, stalls are measured from this point on. */
+	void Resume();
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+	static const TCHAR* GetThreadName(ESentryHangThread HangThread);
+
+private:
+	/** State shared with the heartbeat requests queued on the render and RHI threads which may outlive the watchdog. */
+	struct FSharedState
+	{
+		/**
+		 * Time the current stall started at, in FPlatformTime::Cycles64. For the game thread it's the last heartbeat,
+		 * for the render and RHI threads the time the outstanding request was sent at or 0 if there isn't one.
+		 */
+		TAtomic<uint64> StalledSinceCycles[static_cast<int32>(ESentryHangThread::Num)];
+
+		/** Set by each thread itself since the render and RHI threads can be recreated at runtime. */
+		TAtomic<uint32> ThreadIds[static_cast<int32>(ESentryHangThread::Num)];
+
+		bool bIsWatched[static_cast<int32>(ESentryHangThread::Num)];
+
+		FSharedState();
+
+		/** Sends a heartbeat request unless one is outstanding already, returns whether the caller has to deliver it. */
+		bool Request(ESentryHangThread HangThread);
+
+		/** Answers the outstanding request, called from the requested thread. */
+		void Respond(ESentryHangThread HangThread);
+	};
+
+	void CheckHeartbeats();
+
+	TSharedRef<FSharedState, ESPMode::ThreadSafe> State;
+
+	double TimeoutSeconds[static_cast<int32>(ESentryHangThread::Num)];
+
+	FSentryOnHangDetected OnHangDetected;
+
+	TAtomic<bool> bIsSuspended;
+
+	/** Time of the last Resume call, stalls that started earlier are measured from it. */
+	TAtomic<uint64> ResumedCycles;
+
+	/** Stall start time of each thread that has been reported already, accessed from the watchdog thread only. */
+	uint64 ReportedSinceCycles[static_cast<int32>(ESentryHangThread::Num)] = {};
+
+	FRunnableThread* Thread = nullptr;
+
+	FThreadSafeCounter StopRequested;
+};
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryHitchDetector.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryHitchDetector
+{
+	/** Max number of frames captured per sample. */
+	static constexpr int32 MaxDepth = 64;
+
+	/** Time span covered by the samples ring, long enough to look back at the frame that has just finished. */
+	static constexpr double HistorySeconds = 2.0;
+}
+
+FSentryHitchDetector::FSentryHitchDetector(uint32 InSampledThreadId, float InSampleIntervalMs)
+	: SampledThreadId(InSampledThreadId)
+	, SampleIntervalSeconds(FMath::Max(1.0f, InSampleIntervalMs) / 1000.0)
+{
+	Samples.SetNum(FMath::Max(1, FMath::CeilToInt(SentryHitchDetector::HistorySeconds / SampleIntervalSeconds)));
+
+	Thread = FRunnableThread::Create(this, TEXT("SentryHitchDetector"), 0, TPri_BelowNormal);
+}
+
+FSentryHitchDetector::~FSentryHitchDetector()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+TArray<FSentryHitchDetector::FStackSample> FSentryHitchDetector::GetSamples(double StartTime, double EndTime) const
+{
+	FScopeLock Lock(&SamplesCriticalSection);
+
+	TArray<FStackSample> Result;
+
+	for (int32 Offset = 0; Offset < Samples.Num(); ++Offset)
+	{
+		const FStackSample& Sample = Samples[(NextSample + Offset) % Samples.Num()];
+		if (Sample.ProgramCounters.Num() > 0 && Sample.Time >= StartTime && Sample.Time <= EndTime)
+		{
+			Result.Add(Sample);
+		}
+	}
+
+	return Result;
+}
+
+TArray<FString> FSentryHitchDetector::Symbolicate(const TArray<uint64>& ProgramCounters)
+{
+	TArray<FString> Frames;
+	Frames.Reserve(ProgramCounters.Num());
+
+	for (uint64 ProgramCounter : ProgramCounters)
+	{
+		FProgramCounterSymbolInfo SymbolInfo;
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, SymbolInfo);
+
+		if (SymbolInfo.FunctionName[0] != '\0')
+		{
+			Frames.Add(FString::Printf(TEXT("%s!%s"), ANSI_TO_TCHAR(SymbolInfo.ModuleName), ANSI_TO_TCHAR(SymbolInfo.FunctionName)));
+		}
+		else
+		{
+			Frames.Add(FString::Printf(TEXT("0x%016llx"), ProgramCounter));
+		}
+	}
+
+	return Frames;
+}
+
+uint32 FSentryHitchDetector::Run()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	while (StopRequested.GetValue() == 0)
+	{
+		TakeSample();
+
+		FPlatformProcess::SleepNoStats(static_cast<float>(SampleIntervalSeconds));
+	}
+
+	return 0;
+}
+
+void FSentryHitchDetector::Stop()
+{
+	StopRequested.Set(1);
+}
+
+void FSentryHitchDetector::TakeSample()
+{
+	uint64 ProgramCounters[SentryHitchDetector::MaxDepth];
+	const int32 Depth = static_cast<int32>(FPlatformStackWalk::CaptureThreadStackBackTrace(SampledThreadId, ProgramCounters, SentryHitchDetector::MaxDepth));
+
+	const double Time = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&SamplesCriticalSection);
+
+	FStackSample& Sample = Samples[NextSample];
+	Sample.Time = Time;
+	Sample.ProgramCounters.Reset();
+	Sample.ProgramCounters.Append(ProgramCounters, FMath::Max(0, Depth));
+
+	NextSample = (NextSample + 1) % Samples.Num();
+}
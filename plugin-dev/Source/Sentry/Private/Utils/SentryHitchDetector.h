@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class FRunnableThread;
+
+/**
+ * Samples the call stack of a thread at a low frequency on a dedicated thread.
+ *
+ * Only the most recent samples are kept in a fixed-size ring so that code running during a hitch can be looked up
+ * once the hitching frame has finished. Samples hold raw program counters, symbolication is left to the caller.
+ */
+class FSentryHitchDetector : public FRunnable
+{
+public:
+	struct FStackSample
+	{
+		/** Time the sample was taken at, in FPlatformTime::Seconds. */
+		double Time = 0.0;
+
+		TArray<uint64> ProgramCounters;
+	};
+
+	FSentryHitchDetector(uint32 InSampledThreadId, float InSampleIntervalMs);
+	virtual ~FSentryHitchDetector() override;
+
+	/** Gets the samples taken in the given time range, oldest first. Safe to call from any thread. */
+	TArray<FStackSample> GetSamples(double StartTime, double EndTime) const;
+
+	/** Gets the time between two samples in seconds. */
+	double GetSampleInterval() const { return SampleIntervalSeconds; }
+
+	/** Converts program counters to human-readable frames. Slow, so it shouldn't be called from the game thread. */
+	static TArray<FString> Symbolicate(const TArray<uint64>& ProgramCounters);
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+private:
+	void TakeSample();
+
+	const uint32 SampledThreadId;
+	const double SampleIntervalSeconds;
+
+	TArray<FStackSample> Samples;
+	int32 NextSample = 0;
+
+	mutable FCriticalSection SamplesCriticalSection;
+
+	FRunnableThread* Thread = nullptr;
+
+	FThreadSafeCounter StopRequested;
+};
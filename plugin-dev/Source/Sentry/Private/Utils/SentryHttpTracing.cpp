@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryHttpTracing.h"
+
+#include "GenericPlatform/GenericPlatformHttp.h"
+
+bool SentryHttpTracing::ShouldPropagate(const FString& Url, const TArray<FString>& Targets)
+{
+	if (Targets.Num() == 0)
+	{
+		return true;
+	}
+
+	for (const FString& Target : Targets)
+	{
+		if (!Target.IsEmpty() && Url.Contains(Target))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FString SentryHttpTracing::GetSpanDescription(const FString& Verb, const FString& Url)
+{
+	// Query strings tend to carry tokens and make every request unique, neither of which belongs to span descriptions
+	int32 QueryIndex = INDEX_NONE;
+	Url.FindChar(TEXT('?'), QueryIndex);
+
+	int32 FragmentIndex = INDEX_NONE;
+	Url.FindChar(TEXT('#'), FragmentIndex);
+
+	int32 EndIndex = Url.Len();
+	if (QueryIndex != INDEX_NONE)
+	{
+		EndIndex = FMath::Min(EndIndex, QueryIndex);
+	}
+	if (FragmentIndex != INDEX_NONE)
+	{
+		EndIndex = FMath::Min(EndIndex, FragmentIndex);
+	}
+
+	return FString::Printf(TEXT("%s %s"), Verb.IsEmpty() ? TEXT("GET") : *Verb.ToUpper(), *Url.Left(EndIndex));
+}
+
+FString SentryHttpTracing::GetBaggage(const FString& SentryTrace, const FString& PublicKey, const FString& Release, const FString& Environment)
+{
+	// sentry-trace header is `{trace_id}-{span_id}` optionally followed by `-{sampled}`
+	TArray<FString> Parts;
+	SentryTrace.ParseIntoArray(Parts, TEXT("-"));
+
+	if (Parts.Num() < 2 || Parts[0].Len() != 32)
+	{
+		return FString();
+	}
+
+	TArray<FString> Entries;
+	Entries.Add(FString::Printf(TEXT("sentry-trace_id=%s"), *Parts[0]));
+
+	if (!PublicKey.IsEmpty())
+	{
+		Entries.Add(FString::Printf(TEXT("sentry-public_key=%s"), *FGenericPlatformHttp::UrlEncode(PublicKey)));
+	}
+	if (!Release.IsEmpty())
+	{
+		Entries.Add(FString::Printf(TEXT("sentry-release=%s"), *FGenericPlatformHttp::UrlEncode(Release)));
+	}
+	if (!Environment.IsEmpty())
+	{
+		Entries.Add(FString::Printf(TEXT("sentry-environment=%s"), *FGenericPlatformHttp::UrlEncode(Environment)));
+	}
+	if (Parts.Num() > 2)
+	{
+		Entries.Add(FString::Printf(TEXT("sentry-sampled=%s"), Parts[2] == TEXT("1") ? TEXT("true") : TEXT("false")));
+	}
+
+	return FString::Join(Entries, TEXT(","));
+}
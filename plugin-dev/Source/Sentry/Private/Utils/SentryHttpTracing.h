@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace SentryHttpTracing
+{
+	/** Checks whether tracing headers should be added to requests to the given URL, any target is a substring match and no targets match all URLs. */
+	bool ShouldPropagate(const FString& Url, const TArray<FString>& Targets);
+
+	/** Gets the description of the `http.client` span of a request, e.g. `GET https://example.com/path` with query and fragment stripped. */
+	FString GetSpanDescription(const FString& Verb, const FString& Url);
+
+	/**
+	 * Builds the `baggage` header carrying the dynamic sampling context of the trace the `sentry-trace` header belongs to.
+	 *
+	 * @return Empty string if the `sentry-trace` header is malformed.
+	 */
+	FString GetBaggage(const FString& SentryTrace, const FString& PublicKey, const FString& Release, const FString& Environment);
+}
@@ -0,0 +1,421 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryInputRing.h"
+
+#include "SentryDefines.h"
+
+#include "Framework/Application/IInputProcessor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformTime.h"
+#include "Input/Events.h"
+#include "Misc/CoreMisc.h"
+
+namespace SentryInputRing
+{
+	/** Time continuous input of the same key is coalesced into a single entry for. */
+	static constexpr double CoalescingWindowSeconds = 0.25;
+
+	/** Bumped whenever the serialized layout changes. */
+	static constexpr int32 FormatVersion = 1;
+
+	/** Whether a text field has the user's keyboard focus, in which case keys would spell out what's being typed. */
+	static bool IsEditingText(const FSlateApplication& SlateApp, uint32 UserIndex)
+	{
+		static const FName EditableTextType(TEXT("SEditableText"));
+		static const FName MultiLineEditableTextType(TEXT("SMultiLineEditableText"));
+
+		const TSharedPtr<SWidget> FocusedWidget = SlateApp.GetUserFocusedWidget(UserIndex);
+		if (!FocusedWidget.IsValid())
+		{
+			return false;
+		}
+
+		const FName Type = FocusedWidget->GetType();
+		return Type == EditableTextType || Type == MultiLineEditableTextType;
+	}
+
+	static const TCHAR* GetTypeName(FSentryInputRing::EType Type)
+	{
+		switch (Type)
+		{
+		case FSentryInputRing::EType::KeyDown:
+			return TEXT("key_down");
+		case FSentryInputRing::EType::KeyUp:
+			return TEXT("key_up");
+		case FSentryInputRing::EType::Axis:
+			return TEXT("axis");
+		case FSentryInputRing::EType::MouseMove:
+			return TEXT("mouse_move");
+		case FSentryInputRing::EType::MouseButtonDown:
+			return TEXT("mouse_down");
+		case FSentryInputRing::EType::MouseButtonUp:
+			return TEXT("mouse_up");
+		case FSentryInputRing::EType::Wheel:
+			return TEXT("wheel");
+		case FSentryInputRing::EType::TouchStart:
+			return TEXT("touch_start");
+		case FSentryInputRing::EType::TouchMove:
+			return TEXT("touch_move");
+		case FSentryInputRing::EType::TouchEnd:
+			return TEXT("touch_end");
+		default:
+			return TEXT("unknown");
+		}
+	}
+}
+
+/**
+ * Input pre-processor feeding the ring. Never consumes events.
+ */
+class FSentryInputRingProcessor : public IInputProcessor
+{
+public:
+	explicit FSentryInputRingProcessor(FSentryInputRing& InRing)
+		: Ring(InRing)
+	{
+	}
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
+	{
+		Ring.FlushPending(false);
+	}
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	{
+		if (!InKeyEvent.IsRepeat() && !SentryInputRing::IsEditingText(SlateApp, InKeyEvent.GetUserIndex()))
+		{
+			Ring.Record(FSentryInputRing::EType::KeyDown, InKeyEvent.GetKey().GetFName(), static_cast<uint8>(InKeyEvent.GetUserIndex()));
+		}
+		return false;
+	}
+
+	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	{
+		if (!SentryInputRing::IsEditingText(SlateApp, InKeyEvent.GetUserIndex()))
+		{
+			Ring.Record(FSentryInputRing::EType::KeyUp, InKeyEvent.GetKey().GetFName(), static_cast<uint8>(InKeyEvent.GetUserIndex()));
+		}
+		return false;
+	}
+
+	virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override
+	{
+		Ring.RecordContinuous(FSentryInputRing::EType::Axis, InAnalogInputEvent.GetKey().GetFName(), static_cast<uint8>(InAnalogInputEvent.GetUserIndex()),
+			InAnalogInputEvent.GetAnalogValue(), 0.0f, false);
+		return false;
+	}
+
+	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+	{
+		if (MouseEvent.IsTouchEvent())
+		{
+			const FVector2D Position = MouseEvent.GetScreenSpacePosition();
+			Ring.RecordContinuous(FSentryInputRing::EType::TouchMove, NAME_None, static_cast<uint8>(MouseEvent.GetPointerIndex()), Position.X, Position.Y, false);
+		}
+		else
+		{
+			const FVector2D Delta = MouseEvent.GetCursorDelta();
+			Ring.RecordContinuous(FSentryInputRing::EType::MouseMove, NAME_None, static_cast<uint8>(MouseEvent.GetUserIndex()), Delta.X, Delta.Y, true);
+		}
+		return false;
+	}
+
+	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+	{
+		RecordPointer(MouseEvent, FSentryInputRing::EType::MouseButtonDown, FSentryInputRing::EType::TouchStart);
+		return false;
+	}
+
+	virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+	{
+		RecordPointer(MouseEvent, FSentryInputRing::EType::MouseButtonUp, FSentryInputRing::EType::TouchEnd);
+		return false;
+	}
+
+	virtual bool HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent) override
+	{
+		if (InWheelEvent.GetWheelDelta() != 0.0f)
+		{
+			Ring.RecordContinuous(FSentryInputRing::EType::Wheel, NAME_None, static_cast<uint8>(InWheelEvent.GetUserIndex()), InWheelEvent.GetWheelDelta(), 0.0f, true);
+		}
+		return false;
+	}
+
+private:
+	void RecordPointer(const FPointerEvent& MouseEvent, FSentryInputRing::EType MouseType, FSentryInputRing::EType TouchType)
+	{
+		const FVector2D Position = MouseEvent.GetScreenSpacePosition();
+
+		if (MouseEvent.IsTouchEvent())
+		{
+			Ring.Record(TouchType, NAME_None, static_cast<uint8>(MouseEvent.GetPointerIndex()), Position.X, Position.Y);
+		}
+		else
+		{
+			Ring.Record(MouseType, MouseEvent.GetEffectingButton().GetFName(), static_cast<uint8>(MouseEvent.GetUserIndex()), Position.X, Position.Y);
+		}
+	}
+
+	FSentryInputRing& Ring;
+};
+
+FSentryInputRing::FEntry FSentryInputRing::FEntry::Make(EType Type, FName Key, uint8 Index, float X, float Y)
+{
+	FEntry Entry;
+	Entry.Timestamp = FPlatformTime::Seconds();
+	Entry.FrameNumber = GFrameCounter;
+	Entry.Key = Key;
+	Entry.X = X;
+	Entry.Y = Y;
+	Entry.Count = 1;
+	Entry.Type = Type;
+	Entry.Index = Index;
+	return Entry;
+}
+
+FSentryInputRing& FSentryInputRing::Get()
+{
+	static FSentryInputRing Instance;
+	return Instance;
+}
+
+void FSentryInputRing::Start(int32 Capacity)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	if (!FSlateApplication::IsInitialized())
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Slate isn't initialized, input events won't be recorded."));
+		return;
+	}
+
+	// The ring is only reallocated while inactive, readers check the flag before touching it
+	const int32 NumSlots = FMath::Clamp(Capacity, 16, 4096);
+	if (Entries.Num() != NumSlots)
+	{
+		Entries.Empty(NumSlots);
+		Entries.SetNumZeroed(NumSlots);
+	}
+
+	NumEntriesWritten.Store(0);
+	NumPendingEntries.Store(0);
+
+	Processor = MakeShared<FSentryInputRingProcessor>(*this);
+	if (!FSlateApplication::Get().RegisterInputPreProcessor(Processor))
+	{
+		Processor.Reset();
+		return;
+	}
+
+	bIsActive = true;
+}
+
+void FSentryInputRing::Stop()
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(Processor);
+	}
+	Processor.Reset();
+
+	// Entries aren't freed since the crash handler or a capture on another thread may still be copying them
+	NumEntriesWritten.Store(0);
+	NumPendingEntries.Store(0);
+}
+
+TArray<FSentryInputRing::FEntry> FSentryInputRing::GetEntries() const
+{
+	TArray<FEntry> Result;
+
+	if (!bIsActive || Entries.Num() == 0)
+	{
+		return Result;
+	}
+
+	const uint64 Capacity = static_cast<uint64>(Entries.Num());
+
+	const uint64 End = NumEntriesWritten.Load();
+	const uint64 Begin = End > Capacity ? End - Capacity : 0;
+
+	const int32 NumPending = FMath::Clamp(NumPendingEntries.Load(), 0, MaxPendingEntries);
+
+	Result.Reserve(static_cast<int32>(End - Begin) + NumPending);
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		Result.Add(Entries[Index % Capacity]);
+	}
+
+	// Slots the game thread wrote to in the meantime may be torn, so only entries that are still in the ring are kept
+	const uint64 EndAfterCopy = NumEntriesWritten.Load();
+	const uint64 FirstIntact = EndAfterCopy >= Capacity ? EndAfterCopy - Capacity + 1 : 0;
+	if (FirstIntact > Begin)
+	{
+		Result.RemoveAt(0, static_cast<int32>(FMath::Min(FirstIntact - Begin, End - Begin)));
+	}
+
+	// Continuous input that is still being coalesced is the newest, e.g. the mouse movement right before a crash
+	for (int32 Index = 0; Index < NumPending; ++Index)
+	{
+		Result.Add(PendingEntries[Index]);
+	}
+
+	return Result;
+}
+
+TArray<uint8> FSentryInputRing::Serialize() const
+{
+	const TArray<FEntry> RecordedEntries = GetEntries();
+	if (RecordedEntries.Num() == 0)
+	{
+		return TArray<uint8>();
+	}
+
+	return Serialize(RecordedEntries, FPlatformTime::Seconds(), GFrameCounter);
+}
+
+TArray<uint8> FSentryInputRing::Serialize(const TArray<FEntry>& InEntries, double Now, uint64 FrameNumber)
+{
+	FString Json = FString::Printf(TEXT("{\"version\":%d,\"frame\":%llu,\"events\":["), SentryInputRing::FormatVersion, FrameNumber);
+	Json.Reserve(Json.Len() + InEntries.Num() * 96);
+
+	for (int32 Index = 0; Index < InEntries.Num(); ++Index)
+	{
+		const FEntry& Entry = InEntries[Index];
+
+		if (Index > 0)
+		{
+			Json.AppendChar(TEXT(','));
+		}
+
+		// Times are relative to the capture so that the last steps before it are easy to spot
+		Json += FString::Printf(TEXT("{\"t\":%.3f,\"frame\":%llu,\"type\":\"%s\""), Entry.Timestamp - Now, Entry.FrameNumber, SentryInputRing::GetTypeName(Entry.Type));
+
+		if (!Entry.Key.IsNone())
+		{
+			Json += FString::Printf(TEXT(",\"key\":\"%s\""), *Entry.Key.ToString().ReplaceCharWithEscapedChar());
+		}
+
+		switch (Entry.Type)
+		{
+		case EType::KeyDown:
+		case EType::KeyUp:
+			Json += FString::Printf(TEXT(",\"user\":%d"), Entry.Index);
+			break;
+		case EType::Axis:
+		case EType::Wheel:
+			Json += FString::Printf(TEXT(",\"user\":%d,\"value\":%g"), Entry.Index, Entry.X);
+			break;
+		case EType::MouseMove:
+			Json += FString::Printf(TEXT(",\"user\":%d,\"dx\":%g,\"dy\":%g"), Entry.Index, Entry.X, Entry.Y);
+			break;
+		case EType::MouseButtonDown:
+		case EType::MouseButtonUp:
+			Json += FString::Printf(TEXT(",\"user\":%d,\"x\":%g,\"y\":%g"), Entry.Index, Entry.X, Entry.Y);
+			break;
+		default:
+			Json += FString::Printf(TEXT(",\"finger\":%d,\"x\":%g,\"y\":%g"), Entry.Index, Entry.X, Entry.Y);
+			break;
+		}
+
+		if (Entry.Count > 1)
+		{
+			Json += FString::Printf(TEXT(",\"count\":%d"), Entry.Count);
+		}
+
+		Json.AppendChar(TEXT('}'));
+	}
+
+	Json += TEXT("]}");
+
+	const FTCHARToUTF8 Utf8(*Json);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+void FSentryInputRing::Record(EType Type, FName Key, uint8 Index, float X, float Y)
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	FlushPending(true);
+
+	Publish(FEntry::Make(Type, Key, Index, X, Y));
+}
+
+void FSentryInputRing::RecordContinuous(EType Type, FName Key, uint8 Index, float X, float Y, bool bAccumulate)
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	const int32 NumPending = NumPendingEntries.Load();
+	for (int32 PendingIndex = 0; PendingIndex < NumPending; ++PendingIndex)
+	{
+		FEntry& Pending = PendingEntries[PendingIndex];
+		if (Pending.Type == Type && Pending.Key == Key && Pending.Index == Index)
+		{
+			Pending.X = bAccumulate ? Pending.X + X : X;
+			Pending.Y = bAccumulate ? Pending.Y + Y : Y;
+			Pending.Count = static_cast<uint16>(FMath::Min<int32>(Pending.Count + 1, MAX_uint16));
+			return;
+		}
+	}
+
+	if (NumPending == MaxPendingEntries)
+	{
+		FlushPending(true);
+	}
+
+	PendingEntries[NumPendingEntries.Load()] = FEntry::Make(Type, Key, Index, X, Y);
+	NumPendingEntries.Store(NumPendingEntries.Load() + 1);
+}
+
+void FSentryInputRing::FlushPending(bool bForce)
+{
+	const int32 NumPending = NumPendingEntries.Load();
+	if (NumPending == 0)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	int32 NumKept = 0;
+	for (int32 PendingIndex = 0; PendingIndex < NumPending; ++PendingIndex)
+	{
+		const FEntry& Pending = PendingEntries[PendingIndex];
+		if (bForce || Now - Pending.Timestamp >= SentryInputRing::CoalescingWindowSeconds)
+		{
+			Publish(Pending);
+		}
+		else
+		{
+			PendingEntries[NumKept++] = Pending;
+		}
+	}
+
+	NumPendingEntries.Store(NumKept);
+}
+
+void FSentryInputRing::Publish(const FEntry& Entry)
+{
+	const uint64 Written = NumEntriesWritten.Load();
+	Entries[Written % Entries.Num()] = Entry;
+	NumEntriesWritten.Store(Written + 1);
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+
+class FSentryInputRingProcessor;
+
+/**
+ * Fixed-size ring of the most recent input events (keys, mouse buttons, axis deltas, wheel and touches), attached
+ * to crashes and errors as repro steps. Keys aren't recorded while a text field has focus so that typed text isn't leaked.
+ *
+ * Events are recorded by an input pre-processor on the game thread as packed POD entries in a preallocated ring
+ * published through an atomic counter, so recording never locks or allocates. Continuous input (mouse moves, analog
+ * axes, touch moves) is coalesced into one entry per key within a short window. Entries are serialized to JSON only
+ * when an event is captured or the game crashes.
+ */
+class FSentryInputRing
+{
+public:
+	enum class EType : uint8
+	{
+		KeyDown,
+		KeyUp,
+		Axis,
+		MouseMove,
+		MouseButtonDown,
+		MouseButtonUp,
+		Wheel,
+		TouchStart,
+		TouchMove,
+		TouchEnd
+	};
+
+	struct FEntry
+	{
+		/** Time of the first coalesced event, in FPlatformTime::Seconds. */
+		double Timestamp;
+
+		/** Engine frame counter. */
+		uint64 FrameNumber;
+
+		/** Key, button or axis, none for mouse moves and touches. */
+		FName Key;
+
+		/** Accumulated delta of mouse moves, latest value of axes, wheel delta or touch position. */
+		float X;
+		float Y;
+
+		/** Number of events coalesced into the entry. */
+		uint16 Count;
+
+		EType Type;
+
+		/** Controller for keys and axes, finger for touches. */
+		uint8 Index;
+
+		/** Makes a single event entry stamped with the current time and frame. */
+		static FEntry Make(EType Type, FName Key, uint8 Index, float X = 0.0f, float Y = 0.0f);
+	};
+
+	static FSentryInputRing& Get();
+
+	/** Starts recording input events with room for the given number of entries. Called on the game thread once Slate is initialized. */
+	void Start(int32 Capacity);
+
+	/** Stops recording and discards the recorded events. The ring itself stays allocated so that a concurrent reader never sees it freed. */
+	void Stop();
+
+	bool IsActive() const { return bIsActive; }
+
+	/**
+	 * Gets the recorded entries, oldest first, including continuous input not published yet. Safe to call from any thread, entries
+	 * written concurrently are dropped rather than returned torn. Allocates the result, so the crash handler only calls it from
+	 * the on_crash hook rather than from a signal handler.
+	 */
+	TArray<FEntry> GetEntries() const;
+
+	/** Serializes the recorded entries as a UTF-8 JSON document, empty if nothing was recorded. Allocates, same as GetEntries. */
+	TArray<uint8> Serialize() const;
+
+	/** Serializes entries with timestamps relative to the given time. */
+	static TArray<uint8> Serialize(const TArray<FEntry>& Entries, double Now, uint64 FrameNumber);
+
+	/** Records a discrete event, publishing the pending continuous input first so that the order is kept. Game thread only. */
+	void Record(EType Type, FName Key, uint8 Index, float X = 0.0f, float Y = 0.0f);
+
+	/** Coalesces continuous input with the pending entry of the same type, key and index. Game thread only. */
+	void RecordContinuous(EType Type, FName Key, uint8 Index, float X, float Y, bool bAccumulate);
+
+	/** Publishes the pending continuous input older than the coalescing window. Game thread only. */
+	void FlushPending(bool bForce);
+
+private:
+	FSentryInputRing() = default;
+
+	/** Writes the entry to the ring. Game thread only. */
+	void Publish(const FEntry& Entry);
+
+	FThreadSafeBool bIsActive;
+
+	TArray<FEntry> Entries;
+
+	/** Number of entries written since the start, the slot of the next one is derived from it. */
+	TAtomic<uint64> NumEntriesWritten { 0 };
+
+	static constexpr int32 MaxPendingEntries = 8;
+
+	/** Continuous input being coalesced, published once the window elapses or a discrete event arrives. */
+	FEntry PendingEntries[MaxPendingEntries];
+	TAtomic<int32> NumPendingEntries { 0 };
+
+	TSharedPtr<FSentryInputRingProcessor> Processor;
+};
@@ -0,0 +1,192 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryLoadTracker.h"
+
+#include "Engine/Engine.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+
+FSentryLoadTracker::FSentryLoadTracker(float AsyncLoadThresholdMs, FOnLoadFinished InOnLoadFinished)
+	: AsyncLoadThresholdSeconds(FMath::Max(0.0f, AsyncLoadThresholdMs) / 1000.0)
+	, OnLoadFinished(MoveTemp(InOnLoadFinished))
+{
+}
+
+void FSentryLoadTracker::OnPreLoadMap(const FString& MapName)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Map change cancels whatever the previous map was streaming in, so its load is reported as it is
+	if (CurrentLoad.IsSet())
+	{
+		StreamingLoads.Reset();
+		AsyncLoadStartTime = 0.0;
+		LoadingMapName.Reset();
+
+		FinishLoadIfIdle(Now);
+	}
+
+	BeginLoad(FString::Printf(TEXT("Map load: %s"), *FPackageName::GetShortName(MapName)), Now);
+
+	LoadingMapName = MapName;
+	MapLoadStartTime = Now;
+}
+
+void FSentryLoadTracker::OnPostLoadMap(UWorld* World)
+{
+	if (!CurrentLoad.IsSet() || LoadingMapName.IsEmpty())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	AddSpan(World ? TEXT("map.load.world") : TEXT("map.load.failed"), World ? World->GetMapName() : FPackageName::GetShortName(LoadingMapName), MapLoadStartTime, Now);
+
+	LoadingMapName.Reset();
+
+	FinishLoadIfIdle(Now);
+}
+
+void FSentryLoadTracker::Tick()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	UpdateLevelStreaming(Now);
+	UpdateAsyncLoading(Now);
+
+	FinishLoadIfIdle(Now);
+}
+
+void FSentryLoadTracker::UpdateLevelStreaming(double Now)
+{
+	if (!GEngine)
+	{
+		return;
+	}
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		UWorld* World = Context.World();
+		if (!World || !World->IsGameWorld())
+		{
+			continue;
+		}
+
+		for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+		{
+			if (StreamingLevel && StreamingLevel->HasLoadRequestPending() && !StreamingLoads.Contains(StreamingLevel))
+			{
+				BeginLoad(FString::Printf(TEXT("Level streaming: %s"), *World->GetMapName()), Now);
+				StreamingLoads.Add(StreamingLevel, Now);
+			}
+		}
+	}
+
+	for (auto It = StreamingLoads.CreateIterator(); It; ++It)
+	{
+		ULevelStreaming* StreamingLevel = It.Key().Get();
+		if (StreamingLevel && StreamingLevel->HasLoadRequestPending())
+		{
+			continue;
+		}
+
+		// Levels destroyed while loading are dropped along with their load
+		if (StreamingLevel)
+		{
+			AddSpan(StreamingLevel->IsLevelLoaded() ? TEXT("map.load.streaming") : TEXT("map.load.streaming.failed"),
+				FPackageName::GetShortName(StreamingLevel->GetWorldAssetPackageName()), It.Value(), Now);
+		}
+
+		It.RemoveCurrent();
+	}
+}
+
+void FSentryLoadTracker::UpdateAsyncLoading(double Now)
+{
+	const int32 NumAsyncPackages = GetNumAsyncPackages();
+
+	if (NumAsyncPackages > 0)
+	{
+		if (AsyncLoadStartTime == 0.0)
+		{
+			AsyncLoadStartTime = Now;
+			PeakAsyncPackages = 0;
+		}
+
+		PeakAsyncPackages = FMath::Max(PeakAsyncPackages, NumAsyncPackages);
+		return;
+	}
+
+	if (AsyncLoadStartTime == 0.0)
+	{
+		return;
+	}
+
+	if (Now - AsyncLoadStartTime >= AsyncLoadThresholdSeconds)
+	{
+		BeginLoad(TEXT("Async loading"), AsyncLoadStartTime);
+		AddSpan(TEXT("asset.load"), FString::Printf(TEXT("Async loading (up to %d packages)"), PeakAsyncPackages), AsyncLoadStartTime, Now);
+	}
+
+	AsyncLoadStartTime = 0.0;
+}
+
+void FSentryLoadTracker::BeginLoad(const FString& Name, double Now)
+{
+	if (CurrentLoad.IsSet())
+	{
+		return;
+	}
+
+	FLoad Load;
+	Load.Name = Name;
+	Load.StartTime = Now;
+
+	CurrentLoad = MoveTemp(Load);
+}
+
+void FSentryLoadTracker::AddSpan(const TCHAR* Operation, const FString& Description, double StartTime, double EndTime)
+{
+	// Keeps a game that keeps streaming without ever settling from growing the transaction past what the server accepts
+	static constexpr int32 MaxSpans = 100;
+
+	if (!CurrentLoad.IsSet() || CurrentLoad->Spans.Num() >= MaxSpans)
+	{
+		return;
+	}
+
+	FSpan& Span = CurrentLoad->Spans.AddDefaulted_GetRef();
+	Span.Operation = Operation;
+	Span.Description = Description;
+	Span.StartTime = StartTime;
+	Span.EndTime = EndTime;
+}
+
+void FSentryLoadTracker::FinishLoadIfIdle(double Now)
+{
+	if (!CurrentLoad.IsSet() || !LoadingMapName.IsEmpty() || StreamingLoads.Num() > 0 || AsyncLoadStartTime > 0.0)
+	{
+		return;
+	}
+
+	FLoad Load = MoveTemp(CurrentLoad.GetValue());
+	CurrentLoad.Reset();
+
+	if (Load.Spans.Num() == 0)
+	{
+		return;
+	}
+
+	Load.EndTime = Now;
+
+	for (const FSpan& Span : Load.Spans)
+	{
+		Load.StartTime = FMath::Min(Load.StartTime, Span.StartTime);
+	}
+
+	OnLoadFinished(Load);
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class ULevelStreaming;
+class UWorld;
+
+/**
+ * Times the phases of map loads on the game thread, reported as a single `map.load` transaction per load.
+ *
+ * A load starts with `PreLoadMap` and lasts until the map is loaded and all level streaming and async loading that
+ * followed it is done, so the transaction covers what players actually wait for. Level streaming and async loading
+ * bursts outside of map loads are reported as loads of their own. Streaming levels and the number of async packages
+ * are polled once per frame, which is precise enough for phases that take hundreds of milliseconds.
+ */
+class FSentryLoadTracker
+{
+public:
+	struct FSpan
+	{
+		FString Operation;
+		FString Description;
+
+		/** Time the span started and ended at, in FPlatformTime::Seconds. */
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+	};
+
+	struct FLoad
+	{
+		FString Name;
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+		TArray<FSpan> Spans;
+	};
+
+	using FOnLoadFinished = TFunction<void(const FLoad& Load)>;
+
+	/**
+	 * @param AsyncLoadThresholdMs Async loading bursts shorter than this aren't reported.
+	 * @param OnLoadFinished Called on the game thread once a load with at least one span has finished.
+	 */
+	FSentryLoadTracker(float AsyncLoadThresholdMs, FOnLoadFinished OnLoadFinished);
+
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* World);
+
+	/** Polls level streaming and async loading, called once per frame. */
+	void Tick();
+
+private:
+	void UpdateLevelStreaming(double Now);
+	void UpdateAsyncLoading(double Now);
+
+	/** Starts a load of the given name unless one is in progress. */
+	void BeginLoad(const FString& Name, double Now);
+
+	void AddSpan(const TCHAR* Operation, const FString& Description, double StartTime, double EndTime);
+
+	/** Reports the current load once nothing is loading anymore. */
+	void FinishLoadIfIdle(double Now);
+
+	const double AsyncLoadThresholdSeconds;
+	FOnLoadFinished OnLoadFinished;
+
+	TOptional<FLoad> CurrentLoad;
+
+	/** Map the load of which is in progress, empty between PostLoadMap and the next PreLoadMap. */
+	FString LoadingMapName;
+	double MapLoadStartTime = 0.0;
+
+	/** Streaming levels with a load in flight and the time they were first seen loading at. */
+	TMap<TWeakObjectPtr<ULevelStreaming>, double> StreamingLoads;
+
+	double AsyncLoadStartTime = 0.0;
+	int32 PeakAsyncPackages = 0;
+};
@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryLogCategoryFilter.h"
+
+FSentryLogCategoryFilter::FSentryLogCategoryFilter(const TArray<FString>& Filters)
+{
+	for (const FString& Filter : Filters)
+	{
+		const FString TrimmedFilter = Filter.TrimStartAndEnd();
+		if (TrimmedFilter.IsEmpty())
+		{
+			continue;
+		}
+
+		if (TrimmedFilter.Contains(TEXT("*")) || TrimmedFilter.Contains(TEXT("?")))
+		{
+			Patterns.Add(TrimmedFilter);
+		}
+		else
+		{
+			// FName comparison is case-insensitive which matches how categories were compared before
+			Names.Add(FName(*TrimmedFilter));
+		}
+	}
+}
+
+bool FSentryLogCategoryFilter::Matches(const FName& Category) const
+{
+	if (Names.Contains(Category))
+	{
+		return true;
+	}
+
+	if (Patterns.Num() == 0)
+	{
+		return false;
+	}
+
+	{
+		FReadScopeLock ReadLock(PatternResultsLock);
+		if (const bool* Result = PatternResults.Find(Category))
+		{
+			return *Result;
+		}
+	}
+
+	const FString CategoryString = Category.ToString();
+
+	bool bMatches = false;
+	for (const FString& Pattern : Patterns)
+	{
+		if (CategoryString.MatchesWildcard(Pattern, ESearchCase::IgnoreCase))
+		{
+			bMatches = true;
+			break;
+		}
+	}
+
+	FWriteScopeLock WriteLock(PatternResultsLock);
+	PatternResults.Add(Category, bMatches);
+
+	return bMatches;
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+/**
+ * Matches log categories against a list of category names and wildcard patterns (e.g. `LogNet*`).
+ *
+ * Plain names are compared as FNames. Patterns are evaluated once per category and the result is remembered,
+ * so after the first line of each category matching costs a hash lookup.
+ */
+class FSentryLogCategoryFilter
+{
+public:
+	explicit FSentryLogCategoryFilter(const TArray<FString>& Filters);
+
+	/** Checks whether filter has no entries in which case every category is expected to pass. */
+	bool IsEmpty() const { return Names.Num() == 0 && Patterns.Num() == 0; }
+
+	/** Checks whether the category matches any of the names or patterns. Safe to call from any thread. */
+	bool Matches(const FName& Category) const;
+
+private:
+	TSet<FName> Names;
+	TArray<FString> Patterns;
+
+	/** Results of pattern matching for categories seen so far. */
+	mutable TMap<FName, bool> PatternResults;
+	mutable FRWLock PatternResultsLock;
+};
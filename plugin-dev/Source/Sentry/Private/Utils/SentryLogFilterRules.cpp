@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryLogFilterRules.h"
+
+#include "SentrySettings.h"
+
+#include "Containers/StringConv.h"
+
+FSentryLogFilterRules::FSentryLogFilterRules(const TArray<FSentryLogFilterRule>& Rules)
+{
+	CompiledRules.Reserve(Rules.Num());
+
+	for (const FSentryLogFilterRule& Rule : Rules)
+	{
+		FTCHARToUTF8 Utf8Category(*Rule.Category);
+		FTCHARToUTF8 Utf8Text(*Rule.Text);
+
+		FCompiledRule& CompiledRule = CompiledRules.AddDefaulted_GetRef();
+		CompiledRule.Category.Append(reinterpret_cast<const ANSICHAR*>(Utf8Category.Get()), Utf8Category.Length());
+		CompiledRule.Text.Append(reinterpret_cast<const ANSICHAR*>(Utf8Text.Get()), Utf8Text.Length());
+		CompiledRule.bMatchPrefix = Rule.TextMatch == ESentryLogFilterTextMatch::StartsWith;
+		CompiledRule.MaxLevel = Rule.MaxLevel;
+		CompiledRule.SampleRate = FMath::Clamp(Rule.SampleRate, 0.0f, 1.0f);
+	}
+}
+
+double FSentryLogFilterRules::GetSampleRate(const ANSICHAR* Body, ESentryLevel Level) const
+{
+	if (!Body)
+	{
+		return 1.0;
+	}
+
+	// Category is prepended by the SDK as `[Category] `
+	const ANSICHAR* Category = nullptr;
+	int32 CategoryLength = 0;
+	const ANSICHAR* Message = Body;
+
+	if (Body[0] == '[')
+	{
+		const ANSICHAR* CategoryEnd = FCStringAnsi::Strstr(Body, "] ");
+		if (CategoryEnd)
+		{
+			Category = Body + 1;
+			CategoryLength = static_cast<int32>(CategoryEnd - Category);
+			Message = CategoryEnd + 2;
+		}
+	}
+
+	for (const FCompiledRule& Rule : CompiledRules)
+	{
+		if (Matches(Rule, Category, CategoryLength, Message, Level))
+		{
+			return Rule.SampleRate;
+		}
+	}
+
+	return 1.0;
+}
+
+bool FSentryLogFilterRules::ShouldKeep(const ANSICHAR* Body, ESentryLevel Level) const
+{
+	const double SampleRate = GetSampleRate(Body, Level);
+	if (SampleRate >= 1.0)
+	{
+		return true;
+	}
+
+	return SampleRate > 0.0 && FMath::FRand() < SampleRate;
+}
+
+bool FSentryLogFilterRules::Matches(const FCompiledRule& Rule, const ANSICHAR* Category, int32 CategoryLength, const ANSICHAR* Message, ESentryLevel Level)
+{
+	if (Level > Rule.MaxLevel)
+	{
+		return false;
+	}
+
+	if (Rule.Category.Num() > 0)
+	{
+		if (!Category || CategoryLength != Rule.Category.Num() || FCStringAnsi::Strnicmp(Category, Rule.Category.GetData(), CategoryLength) != 0)
+		{
+			return false;
+		}
+	}
+
+	if (Rule.Text.Num() == 0)
+	{
+		return true;
+	}
+
+	if (Rule.bMatchPrefix)
+	{
+		return FCStringAnsi::Strncmp(Message, Rule.Text.GetData(), Rule.Text.Num()) == 0;
+	}
+
+	// Text isn't terminated, so the first character is looked up and the rest compared at each occurrence
+	const int32 TextLength = Rule.Text.Num();
+	for (const ANSICHAR* Found = FCStringAnsi::Strchr(Message, Rule.Text[0]); Found; Found = FCStringAnsi::Strchr(Found + 1, Rule.Text[0]))
+	{
+		if (FCStringAnsi::Strncmp(Found, Rule.Text.GetData(), TextLength) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryDataTypes.h"
+
+struct FSentryLogFilterRule;
+
+/**
+ * Log filter rules by level, category and message text, compiled once at initialization.
+ *
+ * Rules are evaluated on the UTF-8 log body formatted as `[Category] Message` before a log reaches the `beforeLog` handler.
+ * Evaluating them doesn't allocate or touch any UObjects, so it's safe during garbage collection and from any thread.
+ */
+class FSentryLogFilterRules
+{
+public:
+	explicit FSentryLogFilterRules(const TArray<FSentryLogFilterRule>& Rules);
+
+	/** Gets the sample rate of the first rule matching the log, 1.0 if none does. */
+	double GetSampleRate(const ANSICHAR* Body, ESentryLevel Level) const;
+
+	/** Checks whether the log is kept according to the sample rate of the first matching rule. */
+	bool ShouldKeep(const ANSICHAR* Body, ESentryLevel Level) const;
+
+	bool IsEmpty() const { return CompiledRules.Num() == 0; }
+
+private:
+	struct FCompiledRule
+	{
+		/** UTF-8 encoded category and text without a terminator */
+		TArray<ANSICHAR> Category;
+		TArray<ANSICHAR> Text;
+
+		bool bMatchPrefix;
+		ESentryLevel MaxLevel;
+		double SampleRate;
+	};
+
+	static bool Matches(const FCompiledRule& Rule, const ANSICHAR* Category, int32 CategoryLength, const ANSICHAR* Message, ESentryLevel Level);
+
+	TArray<FCompiledRule> CompiledRules;
+};
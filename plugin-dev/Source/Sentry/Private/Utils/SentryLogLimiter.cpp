@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryLogLimiter.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+
+FSentryLogLimiter::FSentryLogLimiter(float InRate, int32 InBurst, float InRepeatWindow)
+	: Rate(FMath::Max(0.0f, InRate))
+	, Burst(FMath::Max(1, InBurst))
+	, RepeatWindow(FMath::Max(0.0f, InRepeatWindow))
+{
+}
+
+bool FSentryLogLimiter::ShouldForward(const TCHAR* Message, const FName& Category, FString& OutNotice)
+{
+	const double Now = FPlatformTime::Seconds();
+	const uint32 Hash = RepeatWindow > 0.0 ? FCrc::StrCrc32(Message) : 0;
+
+	FScopeLock Lock(&CriticalSection);
+
+	FCategoryState* State = Categories.Find(Category);
+	if (!State)
+	{
+		State = &Categories.Add(Category);
+		State->Tokens = Burst;
+		State->LastRefillTime = Now;
+	}
+
+	if (RepeatWindow > 0.0 && Hash == State->LastHash && Now - State->LastForwardTime < RepeatWindow)
+	{
+		++State->NumRepeated;
+		return false;
+	}
+
+	if (Rate > 0.0f)
+	{
+		State->Tokens = FMath::Min(Burst, State->Tokens + static_cast<float>((Now - State->LastRefillTime) * Rate));
+		State->LastRefillTime = Now;
+
+		if (State->Tokens < 1.0f)
+		{
+			++State->NumRateLimited;
+			return false;
+		}
+
+		State->Tokens -= 1.0f;
+	}
+
+	if (State->NumRepeated > 0 && State->NumRateLimited > 0)
+	{
+		OutNotice = FString::Printf(TEXT("Previous message repeated %d times, %d messages dropped by rate limit"), State->NumRepeated, State->NumRateLimited);
+	}
+	else if (State->NumRepeated > 0)
+	{
+		OutNotice = FString::Printf(TEXT("Previous message repeated %d times"), State->NumRepeated);
+	}
+	else if (State->NumRateLimited > 0)
+	{
+		OutNotice = FString::Printf(TEXT("%d messages dropped by rate limit"), State->NumRateLimited);
+	}
+
+	State->LastHash = Hash;
+	State->LastForwardTime = Now;
+	State->NumRepeated = 0;
+	State->NumRateLimited = 0;
+
+	return true;
+}
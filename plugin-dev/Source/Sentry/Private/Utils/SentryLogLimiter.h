@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Per-category rate limiting and deduplication of log lines forwarded to Sentry.
+ *
+ * Each category has a token bucket refilled at a fixed rate and remembers the hash of its last forwarded line,
+ * so that a line logged every tick neither floods the breadcrumbs nor the structured logs. Suppressed lines are
+ * summarized in a notice forwarded along with the next line that gets through.
+ */
+class FSentryLogLimiter
+{
+public:
+	/**
+	 * @param InRate Lines per second allowed for each category, 0 for no rate limiting.
+	 * @param InBurst Max amount of lines a category can log at once before the rate limit kicks in.
+	 * @param InRepeatWindow Time in seconds during which repeats of the last line of a category are collapsed, 0 for no deduplication.
+	 */
+	FSentryLogLimiter(float InRate, int32 InBurst, float InRepeatWindow);
+
+	/** Checks whether any limiting is configured. */
+	bool IsEnabled() const { return Rate > 0.0f || RepeatWindow > 0.0; }
+
+	/**
+	 * Checks whether the line should be forwarded. Safe to call from any thread.
+	 *
+	 * @param OutNotice Summary of the lines suppressed since the last forwarded one in this category, if any.
+	 */
+	bool ShouldForward(const TCHAR* Message, const FName& Category, FString& OutNotice);
+
+private:
+	struct FCategoryState
+	{
+		float Tokens = 0.0f;
+		double LastRefillTime = 0.0;
+
+		uint32 LastHash = 0;
+		double LastForwardTime = 0.0;
+
+		int32 NumRepeated = 0;
+		int32 NumRateLimited = 0;
+	};
+
+	const float Rate;
+	const float Burst;
+	const double RepeatWindow;
+
+	FCriticalSection CriticalSection;
+	TMap<FName, FCategoryState> Categories;
+};
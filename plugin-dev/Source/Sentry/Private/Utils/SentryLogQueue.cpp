@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryLogQueue.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+FSentryLogQueue::FSentryLogQueue(int32 InCapacity, FConsumer InConsumer, const FSentryLogBatchLimits& InBatchLimits, EThreadPriority InThreadPriority, uint64 InThreadAffinityMask)
+	: Capacity(FMath::Max(1, InCapacity))
+	, Consumer(MoveTemp(InConsumer))
+	, BatchLimits(InBatchLimits)
+{
+	BatchLimits.MaxItems = FMath::Max(1, BatchLimits.MaxItems);
+	BatchLimits.MaxBytes = FMath::Max<int64>(1, BatchLimits.MaxBytes);
+	BatchLimits.FlushIntervalMs = FMath::Max<uint32>(1, BatchLimits.FlushIntervalMs);
+
+	WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("SentryLogQueue"), 0, InThreadPriority, InThreadAffinityMask);
+}
+
+FSentryLogQueue::~FSentryLogQueue()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	// Forward whatever was logged after the worker stopped
+	Flush();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+	WakeUpEvent = nullptr;
+}
+
+bool FSentryLogQueue::Enqueue(const TCHAR* Message, ESentryLevel Level, const FName& Category)
+{
+	if (NumQueued.Increment() > Capacity)
+	{
+		NumQueued.Decrement();
+		NumDropped.Increment();
+		return false;
+	}
+
+	FEntry Entry{ FString(Message).TrimEnd(), Category, Level };
+	NumQueuedBytes.Add(GetSize(Entry.Message));
+
+	Queue.Enqueue(MoveTemp(Entry));
+
+	// Wake the consumer early once a batch is full instead of waiting for the flush interval
+	if (IsBatchFull())
+	{
+		WakeUpEvent->Trigger();
+	}
+
+	return true;
+}
+
+void FSentryLogQueue::Flush()
+{
+	while (Drain(MAX_int32, MAX_int64) > 0)
+	{
+	}
+}
+
+uint32 FSentryLogQueue::Run()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	while (StopRequested.GetValue() == 0)
+	{
+		WakeUpEvent->Wait(BatchLimits.FlushIntervalMs);
+
+		// Whatever is queued once the interval elapses goes out, full batches are handed over one after another
+		do
+		{
+			Drain(BatchLimits.MaxItems, BatchLimits.MaxBytes);
+		}
+		while (StopRequested.GetValue() == 0 && IsBatchFull());
+	}
+
+	return 0;
+}
+
+void FSentryLogQueue::Stop()
+{
+	StopRequested.Set(1);
+	WakeUpEvent->Trigger();
+}
+
+bool FSentryLogQueue::IsBatchFull() const
+{
+	return NumQueued.GetValue() >= BatchLimits.MaxItems || NumQueuedBytes.GetValue() >= BatchLimits.MaxBytes;
+}
+
+int32 FSentryLogQueue::Drain(int32 MaxEntries, int64 MaxBytes)
+{
+	FScopeLock Lock(&ConsumerCriticalSection);
+
+	int32 NumForwarded = 0;
+	int64 NumForwardedBytes = 0;
+
+	FEntry Entry;
+	while (NumForwarded < MaxEntries && NumForwardedBytes < MaxBytes && Queue.Dequeue(Entry))
+	{
+		const int64 Size = GetSize(Entry.Message);
+		NumQueued.Decrement();
+		NumQueuedBytes.Subtract(Size);
+		NumForwardedBytes += Size;
+
+		Consumer(Entry.Message, Entry.Level, Entry.Category.ToString());
+		++NumForwarded;
+	}
+
+	// Reported through the consumer directly since logging it would feed it back into the queue
+	const int64 Dropped = NumDropped.GetValue();
+	if (Dropped > NumReportedDropped)
+	{
+		Consumer(FString::Printf(TEXT("Sentry dropped %lld structured logs because the log queue was full"), Dropped - NumReportedDropped), ESentryLevel::Warning, TEXT("LogSentrySdk"));
+		NumReportedDropped = Dropped;
+	}
+
+	return NumForwarded;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/PlatformAffinity.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+#include "SentryDataTypes.h"
+
+class FRunnableThread;
+class FEvent;
+
+/** Limits of the batches in which queued logs are handed over to the platform SDK. */
+struct FSentryLogBatchLimits
+{
+	/** Max number of logs in a batch, reaching it hands the batch over before the flush interval elapses. */
+	int32 MaxItems = 256;
+
+	/** Max size of the messages in a batch in bytes, reaching it hands the batch over before the flush interval elapses. */
+	int64 MaxBytes = 1024 * 1024;
+
+	/** Max time logs wait in the queue before they are handed over. */
+	uint32 FlushIntervalMs = 100;
+};
+
+/**
+ * Bounded multi-producer single-consumer queue forwarding structured logs to Sentry on a dedicated thread.
+ *
+ * Logging threads only copy the message and push it into a lock-free queue while formatting and handing logs over
+ * to the platform SDK happen in batches on the consumer thread. A batch is handed over once the flush interval
+ * elapses or as soon as it reaches its max number of logs or bytes, so that longer intervals trade log latency for
+ * fewer, larger uploads. Logs pushed while the queue is full are dropped and counted instead of blocking the caller.
+ */
+class FSentryLogQueue : public FRunnable
+{
+public:
+	using FConsumer = TFunction<void(const FString& Message, ESentryLevel Level, const FString& Category)>;
+
+	FSentryLogQueue(int32 InCapacity, FConsumer InConsumer, const FSentryLogBatchLimits& InBatchLimits = FSentryLogBatchLimits(),
+		EThreadPriority InThreadPriority = TPri_BelowNormal, uint64 InThreadAffinityMask = FPlatformAffinity::GetNoAffinityMask());
+	virtual ~FSentryLogQueue() override;
+
+	/**
+	 * Pushes the log into the queue. Safe to call from any thread.
+	 *
+	 * @return False if the queue is full and the log was dropped.
+	 */
+	bool Enqueue(const TCHAR* Message, ESentryLevel Level, const FName& Category);
+
+	/** Forwards all queued logs on the calling thread. */
+	void Flush();
+
+	/** Gets the total number of logs dropped because the queue was full. */
+	int64 GetNumDropped() const { return NumDropped.GetValue(); }
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+private:
+	struct FEntry
+	{
+		FString Message;
+		FName Category;
+		ESentryLevel Level;
+	};
+
+	/** Forwards queued logs until either limit is reached. Returns the number of forwarded logs. */
+	int32 Drain(int32 MaxEntries, int64 MaxBytes);
+
+	/** Checks whether the queued logs fill a whole batch. */
+	bool IsBatchFull() const;
+
+	static int64 GetSize(const FString& Message) { return Message.Len() * sizeof(TCHAR); }
+
+	TQueue<FEntry, EQueueMode::Mpsc> Queue;
+
+	const int32 Capacity;
+	FConsumer Consumer;
+
+	FSentryLogBatchLimits BatchLimits;
+
+	FThreadSafeCounter NumQueued;
+	FThreadSafeCounter64 NumQueuedBytes;
+	FThreadSafeCounter64 NumDropped;
+
+	/** Number of dropped logs that were already reported via the consumer. */
+	int64 NumReportedDropped = 0;
+
+	/** Guards the consumer side of the queue which can be drained by both the worker thread and Flush. */
+	FCriticalSection ConsumerCriticalSection;
+
+	FEvent* WakeUpEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+
+	FThreadSafeCounter StopRequested;
+};
@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryLogRing.h"
+
+#include "SentryMappedFile.h"
+
+FSentryLogRing::FSentryLogRing(int32 InCapacity)
+	: Header(nullptr)
+	, Lines(nullptr)
+	, Capacity(FMath::Max(1, InCapacity))
+{
+	Storage.SetNumZeroed(sizeof(FHeader) + Capacity);
+
+	Header = new (Storage.GetData()) FHeader(static_cast<uint32>(Capacity));
+	Lines = Storage.GetData() + sizeof(FHeader);
+}
+
+FSentryLogRing::FSentryLogRing(uint8* InStorage, int32 InCapacity, TUniquePtr<FSentryMappedFile> InMappedFile)
+	: MappedFile(MoveTemp(InMappedFile))
+	, Header(new (InStorage) FHeader(static_cast<uint32>(InCapacity)))
+	, Lines(InStorage + sizeof(FHeader))
+	, Capacity(InCapacity)
+{
+}
+
+FSentryLogRing::~FSentryLogRing() = default;
+
+TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> FSentryLogRing::CreatePersistent(const FString& Path, int32 InCapacity, TArray<uint8>& OutUnreportedLines)
+{
+	OutUnreportedLines.Reset();
+
+	InCapacity = FMath::Max(1, InCapacity);
+
+	TUniquePtr<FSentryMappedFile> File = FSentryMappedFile::Open(Path, sizeof(FHeader) + InCapacity);
+	if (!File)
+	{
+		return MakeShared<FSentryLogRing, ESPMode::ThreadSafe>(InCapacity);
+	}
+
+	// Lines of the previous session are only readable if it used the same capacity
+	const FHeader* Previous = reinterpret_cast<const FHeader*>(File->GetData());
+	if (Previous->Magic == HeaderMagic && Previous->Capacity == static_cast<uint32>(InCapacity) && !Previous->IsReported.Load())
+	{
+		OutUnreportedLines = CopyLines(File->GetData() + sizeof(FHeader), InCapacity, Previous->NumWritten.Load(), InCapacity);
+	}
+
+	uint8* MappedStorage = File->GetData();
+	return MakeShareable(new FSentryLogRing(MappedStorage, InCapacity, MoveTemp(File)));
+}
+
+void FSentryLogRing::Append(const ANSICHAR* Data, int32 Num)
+{
+	if (!Data || Num <= 0)
+	{
+		return;
+	}
+
+	// Only the end of a line longer than the whole ring can be kept
+	const uint64 Start = Header->NumWritten.AddExchange(Num) + FMath::Max(0, Num - Capacity);
+	if (Num > Capacity)
+	{
+		Data += Num - Capacity;
+		Num = Capacity;
+	}
+
+	const int32 Offset = static_cast<int32>(Start % Capacity);
+	const int32 FirstPart = FMath::Min(Num, Capacity - Offset);
+
+	FMemory::Memcpy(Lines + Offset, Data, FirstPart);
+	FMemory::Memcpy(Lines, Data + FirstPart, Num - FirstPart);
+}
+
+TArray<uint8> FSentryLogRing::Copy(int32 MaxBytes) const
+{
+	return CopyLines(Lines, Capacity, Header->NumWritten.Load(), MaxBytes);
+}
+
+void FSentryLogRing::MarkReported()
+{
+	Header->IsReported.Store(1);
+}
+
+TArray<uint8> FSentryLogRing::CopyLines(const uint8* Lines, int32 Capacity, uint64 End, int32 MaxBytes)
+{
+	const int32 Size = static_cast<int32>(FMath::Min<uint64>(End, FMath::Min(Capacity, FMath::Max(0, MaxBytes))));
+	const int32 Start = static_cast<int32>((End - Size) % Capacity);
+	const int32 FirstPart = FMath::Min(Size, Capacity - Start);
+
+	TArray<uint8> Result;
+	Result.Reserve(Size);
+	Result.Append(Lines + Start, FirstPart);
+	Result.Append(Lines, Size - FirstPart);
+
+	if (End > static_cast<uint64>(Size))
+	{
+		const int32 LineEnd = Result.Find('\n');
+		Result.RemoveAt(0, LineEnd != INDEX_NONE ? LineEnd + 1 : Result.Num(), false);
+	}
+
+	return Result;
+}
+
+int32 FSentryLogRing::ConvertToUTF8(const TCHAR* Source, ANSICHAR* Dest, int32 DestSize)
+{
+	int32 Length = 0;
+
+	for (; Source && *Source; ++Source)
+	{
+		uint32 CodePoint = static_cast<uint32>(*Source);
+
+		// TCHAR is UTF-16 on the supported platforms, unpaired surrogates are replaced
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Source[1] >= 0xDC00 && Source[1] <= 0xDFFF)
+		{
+			CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (static_cast<uint32>(Source[1]) - 0xDC00);
+			++Source;
+		}
+		else if (CodePoint >= 0xD800 && CodePoint <= 0xDFFF)
+		{
+			CodePoint = '?';
+		}
+
+		const int32 NumBytes = CodePoint < 0x80 ? 1 : CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+		if (Length + NumBytes > DestSize)
+		{
+			break;
+		}
+
+		ANSICHAR* Out = Dest + Length;
+		switch (NumBytes)
+		{
+		case 1:
+			Out[0] = static_cast<ANSICHAR>(CodePoint);
+			break;
+		case 2:
+			Out[0] = static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6));
+			Out[1] = static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F));
+			break;
+		case 3:
+			Out[0] = static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12));
+			Out[1] = static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F));
+			Out[2] = static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F));
+			break;
+		default:
+			Out[0] = static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18));
+			Out[1] = static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F));
+			Out[2] = static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F));
+			Out[3] = static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F));
+			break;
+		}
+
+		Length += NumBytes;
+	}
+
+	return Length;
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+class FSentryMappedFile;
+
+/**
+ * Fixed-size ring of the most recent formatted log lines, stored as UTF-8.
+ *
+ * Lets the game log tail be attached to events and crashes without reading the log file, which in long sessions can
+ * grow to hundreds of megabytes and may not have been flushed when the game crashes. The buffer is allocated once and
+ * writers only reserve their range with an atomic add, so appending neither locks nor allocates. A copy taken while
+ * other threads are appending may contain stale bytes in the ranges that are still being written.
+ *
+ * A persistent ring is backed by a memory-mapped file instead, so its lines outlive the process and can be picked
+ * up by the next session if the crash handler couldn't run.
+ */
+class FSentryLogRing
+{
+public:
+	explicit FSentryLogRing(int32 InCapacity);
+	~FSentryLogRing();
+
+	/**
+	 * Creates a ring backed by a memory-mapped file, or an in-memory one if the file can't be mapped.
+	 *
+	 * @param OutUnreportedLines Lines the previous session left in the file without marking them as reported.
+	 */
+	static TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> CreatePersistent(const FString& Path, int32 InCapacity, TArray<uint8>& OutUnreportedLines);
+
+	/** Appends the line, overwriting the oldest data once the ring is full. Safe to call from any thread. */
+	void Append(const ANSICHAR* Data, int32 Num);
+
+	/**
+	 * Copies up to the given number of most recent bytes, oldest first.
+	 * The oldest line is dropped if only a part of it fits or it was partially overwritten.
+	 */
+	TArray<uint8> Copy(int32 MaxBytes = MAX_int32) const;
+
+	/** Marks the lines as reported so that the next session doesn't pick them up, e.g. once attached to a crash or on a clean exit. */
+	void MarkReported();
+
+	bool IsEmpty() const { return Header->NumWritten.Load() == 0; }
+
+	bool IsPersistent() const { return MappedFile.IsValid(); }
+
+	int32 GetCapacity() const { return Capacity; }
+
+	/**
+	 * Converts the string to UTF-8 without allocating, stopping at the last whole character that fits.
+	 *
+	 * @return Number of bytes written to the destination.
+	 */
+	static int32 ConvertToUTF8(const TCHAR* Source, ANSICHAR* Dest, int32 DestSize);
+
+private:
+	/** Placed at the start of the storage so that a persistent ring can be read back after the process is gone. */
+	struct FHeader
+	{
+		explicit FHeader(uint32 InCapacity)
+			: Magic(HeaderMagic)
+			, Capacity(InCapacity)
+			, IsReported(0)
+			, NumWritten(0)
+		{
+		}
+
+		uint32 Magic;
+		uint32 Capacity;
+		TAtomic<uint32> IsReported;
+
+		/** Total number of bytes appended since the ring was created, reserved before they are written. */
+		TAtomic<uint64> NumWritten;
+	};
+
+	static constexpr uint32 HeaderMagic = 0x474C5253; // "SRLG"
+
+	FSentryLogRing(uint8* InStorage, int32 InCapacity, TUniquePtr<FSentryMappedFile> InMappedFile);
+
+	static TArray<uint8> CopyLines(const uint8* Lines, int32 Capacity, uint64 End, int32 MaxBytes);
+
+	/** Heap storage, empty for persistent rings. */
+	TArray<uint8> Storage;
+
+	TUniquePtr<FSentryMappedFile> MappedFile;
+
+	FHeader* Header;
+	uint8* Lines;
+	int32 Capacity;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreGlobals.h"
 #include "GenericPlatform/GenericPlatformStackWalk.h"
+#include "HAL/PlatformStackWalk.h"
 #include "HAL/UnrealMemory.h"
 #include "Misc/OutputDeviceRedirector.h"
 
@@ -26,6 +27,17 @@ void SentryLogUtils::LogStackTrace(const TCHAR* Heading, const ELogVerbosity::Ty
 #endif
 }
 
+FORCENOINLINE TArray<uint64> SentryLogUtils::CaptureStackBackTrace(int32 FramesToSkip, int32 MaxDepth)
+{
+	uint64* BackTrace = (uint64*)FMemory_Alloca(MaxDepth * sizeof(uint64));
+	const int32 Depth = FPlatformStackWalk::CaptureStackBackTrace(BackTrace, MaxDepth);
+
+	// Skip this function's own frame along with the requested ones
+	const int32 Skip = FMath::Min(Depth, FramesToSkip + 1);
+
+	return TArray<uint64>(BackTrace + Skip, Depth - Skip);
+}
+
 ESentryLevel SentryLogUtils::ConvertLogVerbosityToSentryLevel(const ELogVerbosity::Type LogVerbosity)
 {
 	switch (LogVerbosity)
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/Array.h"
 #include "Logging/LogVerbosity.h"
 
 #include "SentryDataTypes.h"
@@ -11,5 +12,9 @@ class SentryLogUtils
 {
 public:
 	static void LogStackTrace(const TCHAR* Heading, const ELogVerbosity::Type LogVerbosity, int FramesToSkip);
+
+	/** Captures raw program counters of the calling thread without symbolicating them, innermost frame first. */
+	static TArray<uint64> CaptureStackBackTrace(int32 FramesToSkip, int32 MaxDepth = 128);
+
 	static ESentryLevel ConvertLogVerbosityToSentryLevel(const ELogVerbosity::Type LogVerbosity);
 };
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryMapPerformance.h"
+
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "RHI.h"
+
+namespace SentryMapPerformance
+{
+	/** Querying process memory is a system call on most platforms, so it's only sampled every so often. */
+	static constexpr uint32 MemorySampleInterval = 60;
+}
+
+FSentryFrameTimeHistogram::FSentryFrameTimeHistogram(float InBucketWidthMs, int32 NumBuckets)
+	: BucketWidthMs(InBucketWidthMs)
+{
+	Buckets.SetNumZeroed(FMath::Max(1, NumBuckets));
+}
+
+void FSentryFrameTimeHistogram::Add(float ValueMs)
+{
+	const int32 Index = FMath::Clamp(FMath::FloorToInt(ValueMs / BucketWidthMs), 0, Buckets.Num() - 1);
+	++Buckets[Index];
+
+	++NumSamples;
+	Sum += ValueMs;
+	Max = FMath::Max(Max, ValueMs);
+}
+
+void FSentryFrameTimeHistogram::Reset()
+{
+	FMemory::Memzero(Buckets.GetData(), Buckets.Num() * sizeof(uint32));
+
+	NumSamples = 0;
+	Sum = 0.0;
+	Max = 0.0f;
+}
+
+float FSentryFrameTimeHistogram::GetPercentile(float Percentile) const
+{
+	if (NumSamples == 0)
+	{
+		return 0.0f;
+	}
+
+	const uint32 Rank = FMath::Max<uint32>(1, FMath::CeilToInt(FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0f * NumSamples));
+
+	uint32 NumBelow = 0;
+	for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+	{
+		NumBelow += Buckets[Index];
+		if (NumBelow >= Rank)
+		{
+			return FMath::Min((Index + 1) * BucketWidthMs, Max);
+		}
+	}
+
+	return Max;
+}
+
+FSentryMapPerformance::FSentryMapPerformance(float InHitchThresholdMs)
+	: HitchThresholdMs(InHitchThresholdMs)
+{
+}
+
+void FSentryMapPerformance::Begin(const FString& InMapName)
+{
+	MapName = InMapName;
+
+	FrameTimes.Reset();
+	GpuTimes.Reset();
+
+	NumHitches = 0;
+	UsedPhysicalHighWater = 0;
+	FramesSinceMemorySample = SentryMapPerformance::MemorySampleInterval;
+}
+
+void FSentryMapPerformance::SampleFrame(float DeltaSeconds)
+{
+	const float FrameTimeMs = DeltaSeconds * 1000.0f;
+
+	FrameTimes.Add(FrameTimeMs);
+
+	if (HitchThresholdMs > 0.0f && FrameTimeMs >= HitchThresholdMs)
+	{
+		++NumHitches;
+	}
+
+	// Reported by the RHI for the last frame the GPU completed, zero if the RHI doesn't support GPU timing
+	const uint32 GpuFrameCycles = RHIGetGPUFrameCycles();
+	if (GpuFrameCycles > 0)
+	{
+		GpuTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GpuFrameCycles)));
+	}
+
+	if (++FramesSinceMemorySample >= SentryMapPerformance::MemorySampleInterval)
+	{
+		FramesSinceMemorySample = 0;
+		UsedPhysicalHighWater = FMath::Max<uint64>(UsedPhysicalHighWater, FPlatformMemory::GetStats().UsedPhysical);
+	}
+}
+
+TMap<FString, TMap<FString, FSentryVariant>> FSentryMapPerformance::GetData() const
+{
+	TMap<FString, TMap<FString, FSentryVariant>> Data;
+
+	TMap<FString, FSentryVariant>& FrameTimeData = Data.Add(TEXT("frame_time"));
+	FrameTimeData.Add(TEXT("frames"), FrameTimes.GetNumSamples());
+	FrameTimeData.Add(TEXT("average_ms"), FrameTimes.GetAverage());
+	FrameTimeData.Add(TEXT("p50_ms"), FrameTimes.GetPercentile(50.0f));
+	FrameTimeData.Add(TEXT("p95_ms"), FrameTimes.GetPercentile(95.0f));
+	FrameTimeData.Add(TEXT("p99_ms"), FrameTimes.GetPercentile(99.0f));
+	FrameTimeData.Add(TEXT("max_ms"), FrameTimes.GetMax());
+
+	TMap<FString, FSentryVariant>& HitchData = Data.Add(TEXT("hitches"));
+	HitchData.Add(TEXT("count"), NumHitches);
+	HitchData.Add(TEXT("threshold_ms"), HitchThresholdMs);
+
+	if (GpuTimes.GetNumSamples() > 0)
+	{
+		TMap<FString, FSentryVariant>& GpuTimeData = Data.Add(TEXT("gpu_time"));
+		GpuTimeData.Add(TEXT("p50_ms"), GpuTimes.GetPercentile(50.0f));
+		GpuTimeData.Add(TEXT("p95_ms"), GpuTimes.GetPercentile(95.0f));
+		GpuTimeData.Add(TEXT("p99_ms"), GpuTimes.GetPercentile(99.0f));
+		GpuTimeData.Add(TEXT("max_ms"), GpuTimes.GetMax());
+	}
+
+	if (UsedPhysicalHighWater > 0)
+	{
+		TMap<FString, FSentryVariant>& MemoryData = Data.Add(TEXT("memory"));
+		MemoryData.Add(TEXT("used_physical_high_water_mb"), static_cast<int32>(UsedPhysicalHighWater / (1024 * 1024)));
+	}
+
+	return Data;
+}
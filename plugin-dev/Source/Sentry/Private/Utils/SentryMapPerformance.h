@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryVariant.h"
+
+/**
+ * Distribution of frame times in fixed-width buckets.
+ * It's written to from the game thread only, so sampling a frame is a single counter increment without any locking.
+ */
+class FSentryFrameTimeHistogram
+{
+public:
+	explicit FSentryFrameTimeHistogram(float InBucketWidthMs = 0.25f, int32 NumBuckets = 1000);
+
+	/** Adds a sample, values beyond the covered range are counted in the last bucket. */
+	void Add(float ValueMs);
+
+	/** Removes all samples. */
+	void Reset();
+
+	/** Gets the value below which the given percentage (0-100) of samples fall, rounded up to the bucket width. */
+	float GetPercentile(float Percentile) const;
+
+	int32 GetNumSamples() const { return NumSamples; }
+	float GetMax() const { return Max; }
+	float GetAverage() const { return NumSamples > 0 ? static_cast<float>(Sum / NumSamples) : 0.0f; }
+
+private:
+	TArray<uint32> Buckets;
+	float BucketWidthMs;
+
+	int32 NumSamples = 0;
+	double Sum = 0.0;
+	float Max = 0.0f;
+};
+
+/**
+ * Frame time, hitch, GPU time and memory statistics accumulated over a single map session.
+ */
+class FSentryMapPerformance
+{
+public:
+	explicit FSentryMapPerformance(float InHitchThresholdMs);
+
+	/** Starts a new session, discarding the statistics of the previous one. */
+	void Begin(const FString& InMapName);
+
+	/** Adds statistics of the last frame. Expected to be called from the game thread once per frame. */
+	void SampleFrame(float DeltaSeconds);
+
+	/** Gets the statistics of the current session grouped the way they are sent as transaction data. */
+	TMap<FString, TMap<FString, FSentryVariant>> GetData() const;
+
+	const FString& GetMapName() const { return MapName; }
+
+private:
+	FString MapName;
+
+	float HitchThresholdMs;
+
+	FSentryFrameTimeHistogram FrameTimes;
+	FSentryFrameTimeHistogram GpuTimes;
+
+	int32 NumHitches = 0;
+	uint64 UsedPhysicalHighWater = 0;
+	uint32 FramesSinceMemorySample = 0;
+};
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryMappedFile.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+FSentryMappedFile::FSentryMappedFile(uint8* InData, int64 InSize, void* InFileHandle, void* InMappingHandle)
+	: Data(InData)
+	, Size(InSize)
+	, FileHandle(InFileHandle)
+	, MappingHandle(InMappingHandle)
+{
+}
+
+FSentryMappedFile::~FSentryMappedFile()
+{
+#if PLATFORM_WINDOWS
+	UnmapViewOfFile(Data);
+	CloseHandle(MappingHandle);
+	CloseHandle(FileHandle);
+#elif PLATFORM_LINUX
+	munmap(Data, Size);
+#endif
+}
+
+TUniquePtr<FSentryMappedFile> FSentryMappedFile::Open(const FString& Path, int64 Size)
+{
+	if (Size <= 0)
+	{
+		return nullptr;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+
+	const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+
+#if PLATFORM_WINDOWS
+	HANDLE File = CreateFileW(*FullPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (File == INVALID_HANDLE_VALUE)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to open %s for mapping (error %u)."), *FullPath, GetLastError());
+		return nullptr;
+	}
+
+	// Mapping extends the file to the requested size if it's smaller
+	HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READWRITE, static_cast<DWORD>(Size >> 32), static_cast<DWORD>(Size & 0xFFFFFFFF), nullptr);
+	void* View = Mapping ? MapViewOfFile(Mapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(Size)) : nullptr;
+	if (!View)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to map %s (error %u)."), *FullPath, GetLastError());
+
+		if (Mapping)
+		{
+			CloseHandle(Mapping);
+		}
+
+		CloseHandle(File);
+		return nullptr;
+	}
+
+	return TUniquePtr<FSentryMappedFile>(new FSentryMappedFile(static_cast<uint8*>(View), Size, File, Mapping));
+#elif PLATFORM_LINUX
+	const int File = open(TCHAR_TO_UTF8(*FullPath), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (File < 0)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to open %s for mapping (errno %d)."), *FullPath, errno);
+		return nullptr;
+	}
+
+	void* View = ftruncate(File, Size) == 0 ? mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, File, 0) : MAP_FAILED;
+	const int MapError = View == MAP_FAILED ? errno : 0;
+
+	// Mapping keeps its own reference to the file
+	close(File);
+
+	if (View == MAP_FAILED)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to map %s (errno %d)."), *FullPath, MapError);
+		return nullptr;
+	}
+
+	return TUniquePtr<FSentryMappedFile>(new FSentryMappedFile(static_cast<uint8*>(View), Size, nullptr, nullptr));
+#else
+	return nullptr;
+#endif
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Writable shared memory mapping of a file.
+ *
+ * Writes to the mapped memory end up in the file through the OS page cache without any syscalls, and since the
+ * pages belong to the OS they are written out even if the process is killed or crashes too hard for a handler to run.
+ * Supported on Windows and Linux only.
+ */
+class FSentryMappedFile
+{
+public:
+	~FSentryMappedFile();
+
+	/** Maps the file, creating it or resizing it to the given size if needed. Null if the file can't be mapped. */
+	static TUniquePtr<FSentryMappedFile> Open(const FString& Path, int64 Size);
+
+	static bool IsSupported() { return PLATFORM_WINDOWS || PLATFORM_LINUX; }
+
+	uint8* GetData() const { return Data; }
+	int64 GetSize() const { return Size; }
+
+private:
+	FSentryMappedFile(uint8* InData, int64 InSize, void* InFileHandle, void* InMappingHandle);
+
+	uint8* Data;
+	int64 Size;
+
+	/** Native handles kept open for the lifetime of the mapping, only used on Windows. */
+	void* FileHandle;
+	void* MappingHandle;
+};
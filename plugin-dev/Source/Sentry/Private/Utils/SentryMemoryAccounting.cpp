@@ -0,0 +1,164 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryMemoryAccounting.h"
+
+#include "SentryVariant.h"
+
+#include "Templates/Atomic.h"
+
+namespace SentryMemoryAccounting
+{
+	static thread_local ESentryMemoryComponent CurrentComponent = ESentryMemoryComponent::Other;
+
+	static TAtomic<int64> NativeBytes[static_cast<int32>(ESentryMemoryComponent::Num)];
+	static TAtomic<bool> bNativeHeapTracked { false };
+
+	static TAtomic<int64> AttachmentBytes { 0 };
+	static TAtomic<int64> CrashVideoBytes { 0 };
+	static TAtomic<int64> CrashAudioBytes { 0 };
+	static TAtomic<int32> NumJniGlobalRefs { 0 };
+
+	static FString FormatBytes(int64 Bytes)
+	{
+		return FString::Printf(TEXT("%10.1f KB"), Bytes / 1024.0);
+	}
+}
+
+SentryMemoryAccounting::FScope::FScope(ESentryMemoryComponent Component)
+	: PreviousComponent(CurrentComponent)
+{
+	CurrentComponent = Component;
+}
+
+SentryMemoryAccounting::FScope::~FScope()
+{
+	CurrentComponent = PreviousComponent;
+}
+
+ESentryMemoryComponent SentryMemoryAccounting::GetCurrentComponent()
+{
+	return CurrentComponent;
+}
+
+void SentryMemoryAccounting::AddNativeBytes(ESentryMemoryComponent Component, int64 DeltaBytes)
+{
+	NativeBytes[static_cast<int32>(Component)] += DeltaBytes;
+}
+
+void SentryMemoryAccounting::MarkNativeHeapTracked()
+{
+	bNativeHeapTracked = true;
+}
+
+void SentryMemoryAccounting::AddAttachmentBytes(int64 DeltaBytes)
+{
+	AttachmentBytes += DeltaBytes;
+}
+
+void SentryMemoryAccounting::SetCrashVideoBytes(int64 Bytes)
+{
+	CrashVideoBytes = Bytes;
+}
+
+void SentryMemoryAccounting::SetCrashAudioBytes(int64 Bytes)
+{
+	CrashAudioBytes = Bytes;
+}
+
+void SentryMemoryAccounting::AddJniGlobalRefs(int32 Delta)
+{
+	NumJniGlobalRefs += Delta;
+}
+
+FSentryMemoryStats SentryMemoryAccounting::GetStats()
+{
+	FSentryMemoryStats Stats;
+	Stats.BreadcrumbBytes = NativeBytes[static_cast<int32>(ESentryMemoryComponent::Breadcrumbs)];
+	Stats.ScopeBytes = NativeBytes[static_cast<int32>(ESentryMemoryComponent::Scope)];
+	Stats.PendingEnvelopeBytes = NativeBytes[static_cast<int32>(ESentryMemoryComponent::PendingEnvelopes)];
+	Stats.NativeSdkOtherBytes = NativeBytes[static_cast<int32>(ESentryMemoryComponent::Other)];
+	Stats.AttachmentBytes = AttachmentBytes;
+	Stats.CrashVideoBytes = CrashVideoBytes + CrashAudioBytes;
+	Stats.NumJniGlobalRefs = NumJniGlobalRefs;
+	Stats.bIsNativeHeapTracked = bNativeHeapTracked;
+	return Stats;
+}
+
+SIZE_T SentryMemoryAccounting::GetAllocatedSize(const FString& String)
+{
+	return String.GetAllocatedSize();
+}
+
+SIZE_T SentryMemoryAccounting::GetAllocatedSize(const FSentryVariant& Variant)
+{
+	switch (Variant.GetType())
+	{
+	case ESentryVariantType::String:
+		return GetAllocatedSize(Variant.GetStringRef());
+	case ESentryVariantType::Array:
+	{
+		SIZE_T Size = Variant.GetArrayRef().GetAllocatedSize();
+		for (const FSentryVariant& Element : Variant.GetArrayRef())
+		{
+			Size += GetAllocatedSize(Element);
+		}
+		return Size;
+	}
+	case ESentryVariantType::Map:
+		return GetAllocatedSize(Variant.GetMapRef());
+	default:
+		return 0;
+	}
+}
+
+SIZE_T SentryMemoryAccounting::GetAllocatedSize(const TMap<FString, FString>& Map)
+{
+	SIZE_T Size = Map.GetAllocatedSize();
+	for (const TPair<FString, FString>& Pair : Map)
+	{
+		Size += GetAllocatedSize(Pair.Key) + GetAllocatedSize(Pair.Value);
+	}
+	return Size;
+}
+
+SIZE_T SentryMemoryAccounting::GetAllocatedSize(const TMap<FString, FSentryVariant>& Map)
+{
+	SIZE_T Size = Map.GetAllocatedSize();
+	for (const TPair<FString, FSentryVariant>& Pair : Map)
+	{
+		Size += GetAllocatedSize(Pair.Key) + GetAllocatedSize(Pair.Value);
+	}
+	return Size;
+}
+
+SIZE_T SentryMemoryAccounting::GetAllocatedSize(const TMap<FString, TMap<FString, FSentryVariant>>& Map)
+{
+	SIZE_T Size = Map.GetAllocatedSize();
+	for (const TPair<FString, TMap<FString, FSentryVariant>>& Pair : Map)
+	{
+		Size += GetAllocatedSize(Pair.Key) + GetAllocatedSize(Pair.Value);
+	}
+	return Size;
+}
+
+TArray<FString> SentryMemoryAccounting::ToLines(const FSentryMemoryStats& Stats)
+{
+	TArray<FString> Lines;
+	Lines.Add(FString::Printf(TEXT("Breadcrumbs        %s"), *FormatBytes(Stats.BreadcrumbBytes)));
+	Lines.Add(FString::Printf(TEXT("Scope              %s"), *FormatBytes(Stats.ScopeBytes)));
+	Lines.Add(FString::Printf(TEXT("Pending envelopes  %s"), *FormatBytes(Stats.PendingEnvelopeBytes)));
+	Lines.Add(FString::Printf(TEXT("Log ring           %s"), *FormatBytes(Stats.LogRingBytes)));
+	Lines.Add(FString::Printf(TEXT("Attachments        %s"), *FormatBytes(Stats.AttachmentBytes)));
+	Lines.Add(FString::Printf(TEXT("Crash video        %s"), *FormatBytes(Stats.CrashVideoBytes)));
+	Lines.Add(FString::Printf(TEXT("Handler objects    %s"), *FormatBytes(Stats.HandlerObjectBytes)));
+	Lines.Add(FString::Printf(TEXT("Native SDK (other) %s"), *FormatBytes(Stats.NativeSdkOtherBytes)));
+	Lines.Add(FString::Printf(TEXT("Total              %s"), *FormatBytes(Stats.GetTotalBytes())));
+	Lines.Add(FString::Printf(TEXT("JNI global refs    %10d"), Stats.NumJniGlobalRefs));
+
+	if (!Stats.bIsNativeHeapTracked)
+	{
+		Lines.Add(TEXT("Native SDK allocations aren't tracked: sentry-native isn't used on this platform, is built without the allocation hooks or accounting is disabled in this build."));
+	}
+
+	return Lines;
+}
@@ -0,0 +1,414 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryMemorySampler.h"
+
+#include "SentryDefines.h"
+#include "SentryMappedFile.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/EngineVersionComparison.h"
+
+namespace SentryMemorySampler
+{
+	/** Peak usage is reported every time it reaches another tenth of the physical memory. */
+	static constexpr uint64 NumWatermarks = 10;
+
+	/** Extra share of the physical memory that has to become available again before low memory is considered over. */
+	static constexpr int32 RecoveryMarginPercent = 5;
+
+	static constexpr int32 MaxReadAttempts = 4;
+
+	static int32 ToMegabytes(uint64 Bytes)
+	{
+		return static_cast<int32>(Bytes / (1024 * 1024));
+	}
+}
+
+TMap<FString, FSentryVariant> FSentryMemorySample::ToContext() const
+{
+	TMap<FString, FSentryVariant> Context;
+	Context.Add(TEXT("sampled_at_seconds"), static_cast<float>(SessionSeconds));
+	Context.Add(TEXT("total_physical_mb"), SentryMemorySampler::ToMegabytes(TotalPhysical));
+	Context.Add(TEXT("available_physical_mb"), SentryMemorySampler::ToMegabytes(AvailablePhysical));
+	Context.Add(TEXT("used_physical_mb"), SentryMemorySampler::ToMegabytes(UsedPhysical));
+	Context.Add(TEXT("used_virtual_mb"), SentryMemorySampler::ToMegabytes(UsedVirtual));
+	Context.Add(TEXT("peak_used_physical_mb"), SentryMemorySampler::ToMegabytes(PeakUsedPhysical));
+	Context.Add(TEXT("memory_trims"), static_cast<int32>(NumMemoryTrims));
+	Context.Add(TEXT("low_memory"), bIsLowMemory);
+	Context.Add(TEXT("under_memory_pressure"), bIsUnderMemoryPressure);
+
+	if (TopTags.Num() > 0)
+	{
+		TMap<FString, FSentryVariant> TagsMb;
+		for (const TPair<FString, int64>& Tag : TopTags)
+		{
+			TagsMb.Add(Tag.Key, SentryMemorySampler::ToMegabytes(static_cast<uint64>(Tag.Value)));
+		}
+
+		Context.Add(TEXT("llm_top_tags_mb"), MoveTemp(TagsMb));
+	}
+
+	return Context;
+}
+
+FSentryMemorySampler::FRecord::FRecord()
+	: Magic(RecordMagic)
+	, Version(RecordVersion)
+	, IsClosed(0)
+	, Sequence(0)
+	, SessionSeconds(0.0)
+	, TotalPhysical(0)
+	, AvailablePhysical(0)
+	, UsedPhysical(0)
+	, UsedVirtual(0)
+	, PeakUsedPhysical(0)
+	, NumMemoryTrims(0)
+	, IsLowMemory(0)
+	, IsUnderMemoryPressure(0)
+	, Padding{}
+	, NumTags(0)
+	, Tags{}
+{
+}
+
+FSentryMemorySampler::FSentryMemorySampler()
+	: Record(&LocalRecord)
+{
+}
+
+FSentryMemorySampler::~FSentryMemorySampler() = default;
+
+FSentryMemorySampler& FSentryMemorySampler::Get()
+{
+	static FSentryMemorySampler Instance;
+	return Instance;
+}
+
+void FSentryMemorySampler::Start(float InIntervalSeconds, int32 InLowMemoryThresholdPercent, int32 InNumTopTags, const FString& PersistPath, FSentryOnMemoryEvent InOnMemoryEvent)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	IntervalSeconds = FMath::Max(1.0f, InIntervalSeconds);
+	LowMemoryThresholdPercent = FMath::Clamp(InLowMemoryThresholdPercent, 1, 90);
+	NumTopTags = FMath::Clamp(InNumTopTags, 0, MaxTopTags);
+	OnMemoryEvent = MoveTemp(InOnMemoryEvent);
+
+	PeakUsedPhysical = 0;
+	NextWatermark = 0;
+	NumMemoryTrims = 0;
+	LastMemoryTrimSeconds = -1.0;
+	bIsLowMemory = false;
+
+	PreviousSessionSample = FSentryMemorySample();
+
+	// Crash handler may read the record at any time, so it's switched to the local one before the file is remapped
+	Record = &LocalRecord;
+	MappedFile.Reset();
+
+	if (FSentryMappedFile::IsSupported() && !PersistPath.IsEmpty())
+	{
+		MappedFile = FSentryMappedFile::Open(PersistPath, sizeof(FRecord));
+	}
+
+	if (MappedFile)
+	{
+		const FRecord* Previous = reinterpret_cast<const FRecord*>(MappedFile->GetData());
+		if (Previous->Magic == RecordMagic && Previous->Version == RecordVersion && !Previous->IsClosed.Load())
+		{
+			Read(*Previous, PreviousSessionSample);
+		}
+
+		Record = new (MappedFile->GetData()) FRecord();
+	}
+	else
+	{
+		new (&LocalRecord) FRecord();
+	}
+
+	bIsActive = true;
+
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddRaw(this, &FSentryMemorySampler::OnMemoryTrim);
+
+	Sample();
+
+	const uint32 Serial = ++StartSerial;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Serial](float DeltaTime)
+	{
+		if (!bIsActive || StartSerial != Serial)
+		{
+			return false;
+		}
+
+		Sample();
+		return true;
+	}), IntervalSeconds);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Memory sampling enabled, sampling every %.1f seconds."), IntervalSeconds);
+}
+
+void FSentryMemorySampler::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+	MemoryTrimHandle.Reset();
+
+	OnMemoryEvent.Unbind();
+
+	// Latest sample stays readable for the crash handler, the next session just won't treat it as a termination
+	Record->IsClosed.Store(1);
+}
+
+bool FSentryMemorySampler::GetPreviousSessionSample(FSentryMemorySample& OutSample) const
+{
+	if (!PreviousSessionSample.IsValid())
+	{
+		return false;
+	}
+
+	OutSample = PreviousSessionSample;
+	return true;
+}
+
+FSentryMemorySample FSentryMemorySampler::GetLatestSample() const
+{
+	FSentryMemorySample LatestSample;
+	Read(*Record, LatestSample);
+	return LatestSample;
+}
+
+FSentryMemorySample FSentryMemorySampler::GetRefreshedSample() const
+{
+	FSentryMemorySample RefreshedSample = GetLatestSample();
+	if (!bIsActive)
+	{
+		return RefreshedSample;
+	}
+
+	// LLM tags and the pressure state are left as of the latest sample, walking the tags is the expensive part
+	const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+
+	RefreshedSample.SessionSeconds = FPlatformTime::Seconds() - GStartTime;
+	RefreshedSample.TotalPhysical = Stats.TotalPhysical;
+	RefreshedSample.AvailablePhysical = Stats.AvailablePhysical;
+	RefreshedSample.UsedPhysical = Stats.UsedPhysical;
+	RefreshedSample.UsedVirtual = Stats.UsedVirtual;
+	RefreshedSample.PeakUsedPhysical = FMath::Max3<uint64>(RefreshedSample.PeakUsedPhysical, Stats.UsedPhysical, Stats.PeakUsedPhysical);
+
+	return RefreshedSample;
+}
+
+void FSentryMemorySampler::Sample()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	check(IsInGameThread());
+
+	const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+
+	FSentryMemorySample NewSample;
+	NewSample.SessionSeconds = FPlatformTime::Seconds() - GStartTime;
+	NewSample.TotalPhysical = Stats.TotalPhysical;
+	NewSample.AvailablePhysical = Stats.AvailablePhysical;
+	NewSample.UsedPhysical = Stats.UsedPhysical;
+	NewSample.UsedVirtual = Stats.UsedVirtual;
+	NewSample.NumMemoryTrims = NumMemoryTrims;
+
+	PeakUsedPhysical = FMath::Max3<uint64>(PeakUsedPhysical, Stats.UsedPhysical, Stats.PeakUsedPhysical);
+	NewSample.PeakUsedPhysical = PeakUsedPhysical;
+
+	const bool bWasLowMemory = bIsLowMemory;
+	if (Stats.TotalPhysical > 0)
+	{
+		// Leaving the low memory state takes some headroom so that usage hovering around the threshold doesn't flood breadcrumbs
+		const int32 ThresholdPercent = bWasLowMemory ? FMath::Min(LowMemoryThresholdPercent + SentryMemorySampler::RecoveryMarginPercent, 100) : LowMemoryThresholdPercent;
+		bIsLowMemory = Stats.AvailablePhysical * 100 < Stats.TotalPhysical * ThresholdPercent;
+	}
+
+	NewSample.bIsLowMemory = bIsLowMemory;
+	NewSample.bIsUnderMemoryPressure = bIsLowMemory || (LastMemoryTrimSeconds >= 0.0 && NewSample.SessionSeconds - LastMemoryTrimSeconds <= 2.0 * IntervalSeconds);
+
+	CollectTopTags(NumTopTags, NewSample.TopTags);
+
+	Publish(NewSample);
+
+	const uint64 WatermarkStep = Stats.TotalPhysical / SentryMemorySampler::NumWatermarks;
+	const bool bHasReachedWatermark = WatermarkStep > 0 && NextWatermark > 0 && PeakUsedPhysical >= NextWatermark;
+	if (WatermarkStep > 0)
+	{
+		// First sample only sets the baseline, usage at startup isn't worth a breadcrumb
+		NextWatermark = (PeakUsedPhysical / WatermarkStep + 1) * WatermarkStep;
+	}
+
+	if (bHasReachedWatermark)
+	{
+		OnMemoryEvent.ExecuteIfBound(ESentryMemoryEvent::WatermarkReached, NewSample);
+	}
+
+	if (bIsLowMemory != bWasLowMemory)
+	{
+		OnMemoryEvent.ExecuteIfBound(bIsLowMemory ? ESentryMemoryEvent::LowMemory : ESentryMemoryEvent::MemoryRecovered, NewSample);
+	}
+}
+
+void FSentryMemorySampler::OnMemoryTrim()
+{
+	// Some platforms broadcast trim requests from their low memory callbacks outside of the game thread
+	if (!IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::GameThread, [this]()
+		{
+			if (bIsActive)
+			{
+				OnMemoryTrim();
+			}
+		});
+		return;
+	}
+
+	++NumMemoryTrims;
+	LastMemoryTrimSeconds = FPlatformTime::Seconds() - GStartTime;
+
+	Sample();
+
+	OnMemoryEvent.ExecuteIfBound(ESentryMemoryEvent::MemoryTrim, GetLatestSample());
+}
+
+void FSentryMemorySampler::Publish(const FSentryMemorySample& NewSample)
+{
+	FRecord& Target = *Record;
+
+	const uint32 Sequence = Target.Sequence.Load();
+	Target.Sequence.Store(Sequence + 1);
+
+	Target.SessionSeconds = NewSample.SessionSeconds;
+	Target.TotalPhysical = NewSample.TotalPhysical;
+	Target.AvailablePhysical = NewSample.AvailablePhysical;
+	Target.UsedPhysical = NewSample.UsedPhysical;
+	Target.UsedVirtual = NewSample.UsedVirtual;
+	Target.PeakUsedPhysical = NewSample.PeakUsedPhysical;
+	Target.NumMemoryTrims = NewSample.NumMemoryTrims;
+	Target.IsLowMemory = NewSample.bIsLowMemory ? 1 : 0;
+	Target.IsUnderMemoryPressure = NewSample.bIsUnderMemoryPressure ? 1 : 0;
+
+	Target.NumTags = static_cast<uint32>(FMath::Min(NewSample.TopTags.Num(), MaxTopTags));
+	for (uint32 Index = 0; Index < Target.NumTags; ++Index)
+	{
+		FRecord::FTag& Tag = Target.Tags[Index];
+
+		const FTCHARToUTF8 NameUtf8(*NewSample.TopTags[Index].Key);
+		const int32 NameLength = FMath::Min(NameUtf8.Length(), static_cast<int32>(UE_ARRAY_COUNT(Tag.Name)) - 1);
+		FMemory::Memcpy(Tag.Name, NameUtf8.Get(), NameLength);
+		Tag.Name[NameLength] = '\0';
+		Tag.Size = NewSample.TopTags[Index].Value;
+	}
+
+	Target.Sequence.Store(Sequence + 2);
+}
+
+bool FSentryMemorySampler::Read(const FRecord& Source, FSentryMemorySample& OutSample)
+{
+	for (int32 Attempt = 0; Attempt < SentryMemorySampler::MaxReadAttempts; ++Attempt)
+	{
+		const uint32 Sequence = Source.Sequence.Load();
+		if (Sequence & 1)
+		{
+			// Either being written right now or the process was killed halfway through writing it
+			continue;
+		}
+
+		FSentryMemorySample Sample;
+		Sample.SessionSeconds = Source.SessionSeconds;
+		Sample.TotalPhysical = Source.TotalPhysical;
+		Sample.AvailablePhysical = Source.AvailablePhysical;
+		Sample.UsedPhysical = Source.UsedPhysical;
+		Sample.UsedVirtual = Source.UsedVirtual;
+		Sample.PeakUsedPhysical = Source.PeakUsedPhysical;
+		Sample.NumMemoryTrims = Source.NumMemoryTrims;
+		Sample.bIsLowMemory = Source.IsLowMemory != 0;
+		Sample.bIsUnderMemoryPressure = Source.IsUnderMemoryPressure != 0;
+
+		const uint32 NumTags = FMath::Min(Source.NumTags, static_cast<uint32>(MaxTopTags));
+		for (uint32 Index = 0; Index < NumTags; ++Index)
+		{
+			const FRecord::FTag& Tag = Source.Tags[Index];
+			int32 NameLength = 0;
+			while (NameLength < UE_ARRAY_COUNT(Tag.Name) && Tag.Name[NameLength] != '\0')
+			{
+				++NameLength;
+			}
+
+			const FUTF8ToTCHAR Name(Tag.Name, NameLength);
+			Sample.TopTags.Emplace(FString(Name.Length(), Name.Get()), Tag.Size);
+		}
+
+		if (Source.Sequence.Load() == Sequence)
+		{
+			OutSample = MoveTemp(Sample);
+			return OutSample.IsValid();
+		}
+	}
+
+	return false;
+}
+
+void FSentryMemorySampler::CollectTopTags(int32 NumTags, TArray<TPair<FString, int64>>& OutTags)
+{
+	OutTags.Reset();
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER && !UE_VERSION_OLDER_THAN(5, 0, 0)
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+	if (NumTags <= 0 || !Tracker.IsEnabled())
+	{
+		return;
+	}
+
+	for (const UE::LLMPrivate::FTagData* TagData : Tracker.GetTrackedTags(ELLMTracker::Default))
+	{
+		FString Name = Tracker.GetTagDisplayName(TagData).ToString();
+
+		// Summary tags such as Total or Untracked overlap with the actual ones
+		if (Name.Contains(TEXT("Total")) || Name.Contains(TEXT("Untracked")) || Name.Contains(TEXT("Untagged")))
+		{
+			continue;
+		}
+
+		const int64 Size = Tracker.GetTagAmountForTracker(ELLMTracker::Default, TagData);
+		if (Size > 0)
+		{
+			OutTags.Emplace(MoveTemp(Name), Size);
+		}
+	}
+
+	OutTags.Sort([](const TPair<FString, int64>& A, const TPair<FString, int64>& B)
+	{
+		return A.Value > B.Value;
+	});
+
+	if (OutTags.Num() > NumTags)
+	{
+		OutTags.SetNum(NumTags);
+	}
+#endif
+}
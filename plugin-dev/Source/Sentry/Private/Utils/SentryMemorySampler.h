@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+
+#include "SentryVariant.h"
+
+class FSentryMappedFile;
+
+/** Memory usage of the game at a point in time. */
+struct FSentryMemorySample
+{
+	/** Seconds since the session started. */
+	double SessionSeconds = 0.0;
+
+	uint64 TotalPhysical = 0;
+	uint64 AvailablePhysical = 0;
+	uint64 UsedPhysical = 0;
+	uint64 UsedVirtual = 0;
+
+	/** Highest physical memory usage seen during the session so far. */
+	uint64 PeakUsedPhysical = 0;
+
+	/** Number of memory trims requested by the platform during the session so far. */
+	uint32 NumMemoryTrims = 0;
+
+	/** Whether the available physical memory was below the low memory threshold. */
+	bool bIsLowMemory = false;
+
+	/** Whether the game was low on memory or the platform requested a memory trim within the last two sampling intervals. */
+	bool bIsUnderMemoryPressure = false;
+
+	/** LLM tags with the most memory and their size in bytes, largest first. Empty unless LLM is enabled. */
+	TArray<TPair<FString, int64>> TopTags;
+
+	bool IsValid() const { return TotalPhysical > 0; }
+
+	/** Converts the sample to the values of the memory context, sizes are in megabytes. */
+	TMap<FString, FSentryVariant> ToContext() const;
+};
+
+enum class ESentryMemoryEvent : uint8
+{
+	/** Peak physical memory usage reached the next 10% of the physical memory. */
+	WatermarkReached,
+	/** Available physical memory dropped below the low memory threshold. */
+	LowMemory,
+	/** Available physical memory got back above the low memory threshold. */
+	MemoryRecovered,
+	/** Platform requested the game to release memory. */
+	MemoryTrim
+};
+
+DECLARE_DELEGATE_TwoParams(FSentryOnMemoryEvent, ESentryMemoryEvent, const FSentryMemorySample&);
+
+/**
+ * Periodic low-cost memory sampler.
+ *
+ * Reads the platform memory stats and, when LLM is enabled, the top tags on a game thread ticker every few seconds,
+ * keeping a high-water mark of the physical memory usage and reporting threshold crossings and platform memory trim
+ * requests. The latest sample is published without locks so that it can be read by the crash handler.
+ *
+ * On Windows/Linux the latest sample is also kept in a memory-mapped file until the sampler is stopped, so that the
+ * next session can tell that this one was terminated while running low on memory, e.g. by the OOM killer.
+ */
+class FSentryMemorySampler
+{
+public:
+	static FSentryMemorySampler& Get();
+
+	/**
+	 * Starts sampling, called on the game thread.
+	 *
+	 * @param PersistPath File to keep the latest sample in, the sample of the previous session is read from it first.
+	 */
+	void Start(float InIntervalSeconds, int32 InLowMemoryThresholdPercent, int32 InNumTopTags, const FString& PersistPath, FSentryOnMemoryEvent InOnMemoryEvent);
+
+	/** Stops sampling and marks the persisted sample as belonging to a session that has ended cleanly. */
+	void Stop();
+
+	/** Checks whether memory is being sampled. */
+	bool IsActive() const { return bIsActive; }
+
+	/**
+	 * Gets the last sample the previous session persisted if it wasn't stopped cleanly.
+	 *
+	 * @return False if the previous session ended cleanly or nothing was persisted.
+	 */
+	bool GetPreviousSessionSample(FSentryMemorySample& OutSample) const;
+
+	/** Gets the latest sample. Doesn't lock or query the platform so that it can be used from the crash handler. */
+	FSentryMemorySample GetLatestSample() const;
+
+	/** Gets the latest sample with the platform memory stats queried again. Cheap enough to be used for every captured event. */
+	FSentryMemorySample GetRefreshedSample() const;
+
+private:
+	static constexpr int32 MaxTopTags = 16;
+
+	/** POD layout of the latest sample, placed at the start of the persisted file so that it can be read back after the process is gone. */
+	struct FRecord
+	{
+		struct FTag
+		{
+			ANSICHAR Name[56];
+			int64 Size;
+		};
+
+		FRecord();
+
+		uint32 Magic;
+		uint32 Version;
+		TAtomic<uint32> IsClosed;
+
+		/** Odd while the sample is being written. */
+		TAtomic<uint32> Sequence;
+
+		double SessionSeconds;
+		uint64 TotalPhysical;
+		uint64 AvailablePhysical;
+		uint64 UsedPhysical;
+		uint64 UsedVirtual;
+		uint64 PeakUsedPhysical;
+		uint32 NumMemoryTrims;
+		uint8 IsLowMemory;
+		uint8 IsUnderMemoryPressure;
+		uint8 Padding[2];
+		uint32 NumTags;
+		FTag Tags[MaxTopTags];
+	};
+
+	static constexpr uint32 RecordMagic = 0x4D4D5253; // "SRMM"
+	static constexpr uint32 RecordVersion = 1;
+
+	FSentryMemorySampler();
+	~FSentryMemorySampler();
+
+	/** Takes a sample, reports threshold crossings and publishes it. Called on the game thread. */
+	void Sample();
+
+	void OnMemoryTrim();
+
+	void Publish(const FSentryMemorySample& NewSample);
+
+	static bool Read(const FRecord& Source, FSentryMemorySample& OutSample);
+
+	static void CollectTopTags(int32 NumTags, TArray<TPair<FString, int64>>& OutTags);
+
+	FThreadSafeBool bIsActive;
+
+	FSentryOnMemoryEvent OnMemoryEvent;
+
+	FDelegateHandle MemoryTrimHandle;
+
+	/** Incremented whenever sampling starts so that the ticker of a previous start stops. */
+	uint32 StartSerial = 0;
+
+	TUniquePtr<FSentryMappedFile> MappedFile;
+
+	/** Record used when the sample can't be persisted. */
+	FRecord LocalRecord;
+
+	/** Record the latest sample is published to, either the local one or the one in the mapped file. */
+	FRecord* Record;
+
+	/** Previous session sample, invalid if it ended cleanly. */
+	FSentryMemorySample PreviousSessionSample;
+
+	// Game thread state
+	float IntervalSeconds = 5.0f;
+	int32 LowMemoryThresholdPercent = 10;
+	int32 NumTopTags = 0;
+	uint64 PeakUsedPhysical = 0;
+	uint64 NextWatermark = 0;
+	uint32 NumMemoryTrims = 0;
+	double LastMemoryTrimSeconds = -1.0;
+	bool bIsLowMemory = false;
+};
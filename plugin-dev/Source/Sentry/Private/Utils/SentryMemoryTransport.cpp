@@ -0,0 +1,105 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryMemoryTransport.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Atomic.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace SentryMemoryTransportState
+{
+	static TAtomic<bool> IsInstalled(false);
+
+	static FCriticalSection Lock;
+	static TArray<FSentryCapturedEnvelope> Envelopes;
+	static int64 TotalBytes = 0;
+}
+
+bool SentryMemoryTransport::IsSupported()
+{
+#if USE_SENTRY_NATIVE
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SentryMemoryTransport::Install()
+{
+	Reset();
+	SentryMemoryTransportState::IsInstalled = true;
+}
+
+void SentryMemoryTransport::Uninstall()
+{
+	SentryMemoryTransportState::IsInstalled = false;
+	Reset();
+}
+
+bool SentryMemoryTransport::IsInstalled()
+{
+	return SentryMemoryTransportState::IsInstalled;
+}
+
+void SentryMemoryTransport::Record(TArray<uint8>&& Envelope)
+{
+	FSentryCapturedEnvelope CapturedEnvelope;
+	CapturedEnvelope.Timestamp = FPlatformTime::Seconds();
+	FSentryEnvelopeBatch::GetItemTypes(Envelope, CapturedEnvelope.ItemTypes);
+	CapturedEnvelope.Data = MoveTemp(Envelope);
+
+	FScopeLock Lock(&SentryMemoryTransportState::Lock);
+
+	SentryMemoryTransportState::TotalBytes += CapturedEnvelope.Data.Num();
+	SentryMemoryTransportState::Envelopes.Add(MoveTemp(CapturedEnvelope));
+}
+
+TArray<FSentryCapturedEnvelope> SentryMemoryTransport::GetEnvelopes()
+{
+	FScopeLock Lock(&SentryMemoryTransportState::Lock);
+	return SentryMemoryTransportState::Envelopes;
+}
+
+int32 SentryMemoryTransport::GetNumEnvelopes()
+{
+	FScopeLock Lock(&SentryMemoryTransportState::Lock);
+	return SentryMemoryTransportState::Envelopes.Num();
+}
+
+int64 SentryMemoryTransport::GetTotalBytes()
+{
+	FScopeLock Lock(&SentryMemoryTransportState::Lock);
+	return SentryMemoryTransportState::TotalBytes;
+}
+
+bool SentryMemoryTransport::WaitForEnvelopes(int32 NumEnvelopes, float TimeoutSeconds)
+{
+	const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+
+	while (GetNumEnvelopes() < NumEnvelopes)
+	{
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			return false;
+		}
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	return true;
+}
+
+void SentryMemoryTransport::Reset()
+{
+	FScopeLock Lock(&SentryMemoryTransportState::Lock);
+
+	SentryMemoryTransportState::Envelopes.Empty();
+	SentryMemoryTransportState::TotalBytes = 0;
+}
+
+#endif
@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_AUTOMATION_TESTS
+
+/** Envelope captured by the memory transport. */
+struct FSentryCapturedEnvelope
+{
+	/** Serialized envelope as it would have been sent. */
+	TArray<uint8> Data;
+
+	/** Types of the envelope items in order. */
+	TArray<FString> ItemTypes;
+
+	/** Time the envelope was handed over to the transport, in FPlatformTime::Seconds. */
+	double Timestamp = 0.0;
+};
+
+/**
+ * Test-only transport keeping envelopes in memory instead of sending them.
+ *
+ * Lets specs and benchmarks assert on payload sizes and capture latency without depending on a DSN or the network.
+ * It has to be installed before the SDK is initialized and is used by every initialization until uninstalled.
+ */
+class SentryMemoryTransport
+{
+public:
+	/** Checks whether the current platform can route envelopes to memory. Android and Apple SDKs own their transports so they aren't supported. */
+	static bool IsSupported();
+
+	/** Makes the SDK initialized after this call capture envelopes in memory. */
+	static void Install();
+
+	/** Restores the regular transport for the next initialization and discards the captured envelopes. */
+	static void Uninstall();
+
+	static bool IsInstalled();
+
+	/** Stores a serialized envelope, called by the platform transports. */
+	static void Record(TArray<uint8>&& Envelope);
+
+	static TArray<FSentryCapturedEnvelope> GetEnvelopes();
+
+	static int32 GetNumEnvelopes();
+
+	/** Gets the combined size of the captured envelopes in bytes. */
+	static int64 GetTotalBytes();
+
+	/** Waits until at least the given number of envelopes has been captured, false on timeout. */
+	static bool WaitForEnvelopes(int32 NumEnvelopes, float TimeoutSeconds);
+
+	static void Reset();
+};
+
+#endif
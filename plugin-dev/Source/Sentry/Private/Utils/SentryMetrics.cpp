@@ -0,0 +1,418 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryMetrics.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/DateTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryMetrics
+{
+	/** Max number of completed buckets a thread keeps if they aren't taken, the oldest ones are dropped. */
+	static constexpr int32 MaxCompletedBuckets = 64;
+
+	static const TCHAR* GetTypeCode(ESentryMetricType Type)
+	{
+		switch (Type)
+		{
+		case ESentryMetricType::Gauge:
+			return TEXT("g");
+		case ESentryMetricType::Distribution:
+			return TEXT("d");
+		default:
+			return TEXT("c");
+		}
+	}
+
+	static FString FormatValue(double Value)
+	{
+		return FString::Printf(TEXT("%.10g"), Value);
+	}
+
+	static void AppendUtf8(TArray<uint8>& Out, const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+}
+
+FSentryMetrics& FSentryMetrics::Get()
+{
+	static FSentryMetrics Instance;
+	return Instance;
+}
+
+FSentryMetrics::FSentryMetrics()
+	: TlsSlot(FPlatformTLS::AllocTlsSlot())
+{
+}
+
+FSentryMetrics::~FSentryMetrics()
+{
+	FPlatformTLS::FreeTlsSlot(TlsSlot);
+}
+
+void FSentryMetrics::Start(const FString& Release, const FString& Environment)
+{
+	TArray<FString> Tags;
+
+	if (!Release.IsEmpty())
+	{
+		Tags.Add(FString::Printf(TEXT("release:%s"), *Sanitize(Release, true)));
+	}
+
+	if (!Environment.IsEmpty())
+	{
+		Tags.Add(FString::Printf(TEXT("environment:%s"), *Sanitize(Environment, true)));
+	}
+
+	DefaultTags = FString::Join(Tags, TEXT(","));
+
+	StartUnixSeconds = FDateTime::UtcNow().ToUnixTimestamp();
+	StartCycles = FPlatformTime::Cycles64();
+
+	bIsActive = true;
+}
+
+void FSentryMetrics::Stop()
+{
+	bIsActive = false;
+}
+
+FSentryMetricKey FSentryMetrics::Register(ESentryMetricType Type, const FString& Name, const FString& Unit, const TMap<FString, FString>& Tags)
+{
+	FSentryMetricKey Key;
+
+	if (Name.IsEmpty())
+	{
+		return Key;
+	}
+
+	// Tags are sorted so that the same set of tags maps to the same key regardless of the order they were added in
+	TArray<FString> SortedTags;
+	SortedTags.Reserve(Tags.Num());
+
+	for (const auto& Tag : Tags)
+	{
+		SortedTags.Add(FString::Printf(TEXT("%s:%s"), *Sanitize(Tag.Key, false), *Sanitize(Tag.Value, true)));
+	}
+
+	SortedTags.Sort();
+
+	FMetricInfo Info;
+	Info.Type = Type;
+	Info.NameAndUnit = FString::Printf(TEXT("%s@%s"), *Sanitize(Name, false), Unit.IsEmpty() ? TEXT("none") : *Sanitize(Unit, false));
+	Info.Tags = FString::Join(SortedTags, TEXT(","));
+
+	const FString Description = FString::Printf(TEXT("%s|%s|%s"), SentryMetrics::GetTypeCode(Type), *Info.NameAndUnit, *Info.Tags);
+
+	Key.Type = Type;
+
+	{
+		FReadScopeLock Lock(RegistryLock);
+
+		if (const int32* Id = KeysByDescription.Find(Description))
+		{
+			Key.Id = *Id;
+			return Key;
+		}
+	}
+
+	FWriteScopeLock Lock(RegistryLock);
+
+	// Another thread may have registered the metric between the locks
+	if (const int32* Id = KeysByDescription.Find(Description))
+	{
+		Key.Id = *Id;
+		return Key;
+	}
+
+	if (Metrics.Num() >= MaxMetrics)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Metric %s can't be registered, at most %d metrics are supported."), *Info.NameAndUnit, MaxMetrics);
+		return Key;
+	}
+
+	Key.Id = Metrics.Add(MoveTemp(Info));
+	KeysByDescription.Add(Description, Key.Id);
+
+	return Key;
+}
+
+void FSentryMetrics::Record(const FSentryMetricKey& Key, double Value)
+{
+	if (!bIsActive || !Key.IsValid())
+	{
+		return;
+	}
+
+	FThreadBuffer& Buffer = GetThreadBuffer();
+
+	// Only contended while the flush takes the completed buckets
+	while (Buffer.bIsBusy.Exchange(true))
+	{
+		FPlatformProcess::YieldThread();
+	}
+
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	if (NowCycles >= Buffer.CurrentEndCycles)
+	{
+		StartBucket(Buffer, NowCycles);
+	}
+
+	if (Buffer.Current.Slots.Num() <= Key.Id)
+	{
+		Buffer.Current.Slots.SetNum(Key.Id + 1);
+	}
+
+	FSlot& Slot = Buffer.Current.Slots[Key.Id];
+
+	if (Key.Type == ESentryMetricType::Distribution && Slot.Samples.Num() >= MaxDistributionSamples)
+	{
+		NumDroppedSamples.Increment();
+	}
+	else
+	{
+		AddSample(Slot, Key.Type, Value);
+	}
+
+	Buffer.bIsBusy = false;
+}
+
+TArray<uint8> FSentryMetrics::TakeEnvelope(bool bIncludeCurrent)
+{
+	TArray<FBucket> Taken;
+
+	{
+		FScopeLock Lock(&BuffersCriticalSection);
+
+		const uint64 NowCycles = FPlatformTime::Cycles64();
+
+		for (const TUniquePtr<FThreadBuffer>& Buffer : Buffers)
+		{
+			while (Buffer->bIsBusy.Exchange(true))
+			{
+				FPlatformProcess::YieldThread();
+			}
+
+			// Threads that stopped recording never complete their current bucket on their own
+			if (Buffer->Current.Slots.Num() > 0 && (bIncludeCurrent || NowCycles >= Buffer->CurrentEndCycles))
+			{
+				Buffer->Completed.Add(MoveTemp(Buffer->Current));
+				Buffer->Current = FBucket();
+				Buffer->CurrentEndCycles = 0;
+			}
+
+			Taken.Append(MoveTemp(Buffer->Completed));
+			Buffer->Completed.Reset();
+
+			Buffer->bIsBusy = false;
+		}
+	}
+
+	TArray<uint8> Envelope;
+
+	if (Taken.Num() == 0)
+	{
+		return Envelope;
+	}
+
+	FString Payload;
+
+	{
+		FReadScopeLock Lock(RegistryLock);
+
+		// Buckets of all threads are merged by their time
+		TMap<int64, TArray<FSlot>> Merged;
+
+		for (FBucket& Bucket : Taken)
+		{
+			TArray<FSlot>& Slots = Merged.FindOrAdd(Bucket.UnixSeconds);
+			if (Slots.Num() < Bucket.Slots.Num())
+			{
+				Slots.SetNum(Bucket.Slots.Num());
+			}
+
+			for (int32 Id = 0; Id < Bucket.Slots.Num(); ++Id)
+			{
+				if (Bucket.Slots[Id].Count > 0)
+				{
+					MergeSlot(Slots[Id], Bucket.Slots[Id], Metrics.IsValidIndex(Id) ? Metrics[Id].Type : ESentryMetricType::Counter);
+				}
+			}
+		}
+
+		Merged.KeySort(TLess<int64>());
+
+		for (const auto& Bucket : Merged)
+		{
+			for (int32 Id = 0; Id < Bucket.Value.Num(); ++Id)
+			{
+				const FSlot& Slot = Bucket.Value[Id];
+				if (Slot.Count == 0 || !Metrics.IsValidIndex(Id))
+				{
+					continue;
+				}
+
+				const FMetricInfo& Info = Metrics[Id];
+
+				FString Values;
+				switch (Info.Type)
+				{
+				case ESentryMetricType::Gauge:
+					Values = FString::Printf(TEXT("%s:%s:%s:%s:%d"), *SentryMetrics::FormatValue(Slot.Last), *SentryMetrics::FormatValue(Slot.Min),
+						*SentryMetrics::FormatValue(Slot.Max), *SentryMetrics::FormatValue(Slot.Sum), Slot.Count);
+					break;
+				case ESentryMetricType::Distribution:
+					for (float Sample : Slot.Samples)
+					{
+						Values += Values.IsEmpty() ? SentryMetrics::FormatValue(Sample) : TEXT(":") + SentryMetrics::FormatValue(Sample);
+					}
+					break;
+				default:
+					Values = SentryMetrics::FormatValue(Slot.Sum);
+					break;
+				}
+
+				const FString Tags = Info.Tags.IsEmpty() || DefaultTags.IsEmpty() ? Info.Tags + DefaultTags : Info.Tags + TEXT(",") + DefaultTags;
+
+				Payload += FString::Printf(TEXT("%s:%s|%s%s%s|T%lld\n"), *Info.NameAndUnit, *Values, SentryMetrics::GetTypeCode(Info.Type),
+					Tags.IsEmpty() ? TEXT("") : TEXT("|#"), *Tags, Bucket.Key);
+			}
+		}
+	}
+
+	const int32 NumDropped = NumDroppedSamples.Set(0);
+	if (NumDropped > 0)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("%d distribution samples were dropped, at most %d samples per metric are kept every %lld seconds."), NumDropped, MaxDistributionSamples, BucketSeconds);
+	}
+
+	if (Payload.IsEmpty())
+	{
+		return Envelope;
+	}
+
+	TArray<uint8> PayloadUtf8;
+	SentryMetrics::AppendUtf8(PayloadUtf8, Payload);
+
+	SentryMetrics::AppendUtf8(Envelope, FString::Printf(TEXT("{}\n{\"type\":\"statsd\",\"length\":%d}\n"), PayloadUtf8.Num()));
+	Envelope.Append(PayloadUtf8);
+	Envelope.Add('\n');
+
+	return Envelope;
+}
+
+FSentryMetrics::FThreadBuffer& FSentryMetrics::GetThreadBuffer()
+{
+	if (FThreadBuffer* Buffer = static_cast<FThreadBuffer*>(FPlatformTLS::GetTlsValue(TlsSlot)))
+	{
+		return *Buffer;
+	}
+
+	// Buffers are owned by the registry, so the samples of threads that have exited are still flushed
+	FThreadBuffer* Buffer = new FThreadBuffer();
+
+	{
+		FScopeLock Lock(&BuffersCriticalSection);
+		Buffers.Emplace(Buffer);
+	}
+
+	FPlatformTLS::SetTlsValue(TlsSlot, Buffer);
+
+	return *Buffer;
+}
+
+void FSentryMetrics::StartBucket(FThreadBuffer& Buffer, uint64 NowCycles) const
+{
+	if (Buffer.Current.Slots.Num() > 0)
+	{
+		if (Buffer.Completed.Num() >= SentryMetrics::MaxCompletedBuckets)
+		{
+			Buffer.Completed.RemoveAt(0);
+		}
+
+		Buffer.Completed.Add(MoveTemp(Buffer.Current));
+	}
+
+	const double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+
+	const int64 NowUnixSeconds = StartUnixSeconds + static_cast<int64>((NowCycles - StartCycles) * SecondsPerCycle);
+	const int64 BucketUnixSeconds = NowUnixSeconds / BucketSeconds * BucketSeconds;
+
+	Buffer.Current = FBucket();
+	Buffer.Current.UnixSeconds = BucketUnixSeconds;
+	Buffer.CurrentEndCycles = StartCycles + static_cast<uint64>((BucketUnixSeconds + BucketSeconds - StartUnixSeconds) / SecondsPerCycle);
+}
+
+void FSentryMetrics::AddSample(FSlot& Slot, ESentryMetricType Type, double Value)
+{
+	if (Slot.Count == 0)
+	{
+		Slot.Min = Value;
+		Slot.Max = Value;
+	}
+	else
+	{
+		Slot.Min = FMath::Min(Slot.Min, Value);
+		Slot.Max = FMath::Max(Slot.Max, Value);
+	}
+
+	Slot.Sum += Value;
+	Slot.Last = Value;
+	++Slot.Count;
+
+	if (Type == ESentryMetricType::Distribution)
+	{
+		Slot.Samples.Add(static_cast<float>(Value));
+	}
+}
+
+void FSentryMetrics::MergeSlot(FSlot& Target, const FSlot& Source, ESentryMetricType Type)
+{
+	if (Target.Count == 0)
+	{
+		Target = Source;
+		return;
+	}
+
+	Target.Min = FMath::Min(Target.Min, Source.Min);
+	Target.Max = FMath::Max(Target.Max, Source.Max);
+	Target.Sum += Source.Sum;
+	Target.Last = Source.Last;
+	Target.Count += Source.Count;
+
+	if (Type == ESentryMetricType::Distribution)
+	{
+		Target.Samples.Append(Source.Samples);
+	}
+}
+
+FString FSentryMetrics::Sanitize(const FString& Value, bool bIsTagValue)
+{
+	FString Sanitized = Value;
+
+	for (TCHAR& Char : Sanitized.GetCharArray())
+	{
+		if (Char == TEXT('\0'))
+		{
+			continue;
+		}
+
+		// Tag values only can't contain the statsd separators, names, units and tag keys are limited to a safe set of characters
+		const bool bIsAllowed = bIsTagValue
+			? Char != TEXT('|') && Char != TEXT(',') && Char != TEXT('\n') && Char != TEXT('\r') && Char != TEXT('\t')
+			: FChar::IsAlnum(Char) || Char == TEXT('_') || Char == TEXT('-') || Char == TEXT('.');
+
+		if (!bIsAllowed)
+		{
+			Char = TEXT('_');
+		}
+	}
+
+	return Sanitized;
+}
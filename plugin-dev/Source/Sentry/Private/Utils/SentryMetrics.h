@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/Atomic.h"
+
+#include "SentryMetricKey.h"
+
+/**
+ * Metrics aggregated locally and sent periodically as a single `statsd` envelope instead of an event per sample.
+ *
+ * Metrics are registered once by type, name, unit and tags which yields a compact key - an index into the registry.
+ * Every thread accumulates its samples in its own buffer of per-key slots for the current 10 second bucket, so
+ * recording a sample is a thread-local lookup, an uncontended atomic exchange guarding the buffer against the flush
+ * and an array access. Buffers are only contended while the flush moves the completed buckets out of them.
+ *
+ * Counters are summed, gauges keep the last, min, max, sum and count of the samples and distributions keep the
+ * samples themselves up to a limit per bucket.
+ */
+class FSentryMetrics
+{
+public:
+	static FSentryMetrics& Get();
+
+	FSentryMetrics();
+	~FSentryMetrics();
+
+	/** Starts accepting samples, release and environment are added as tags to all metrics. */
+	void Start(const FString& Release, const FString& Environment);
+
+	/** Stops accepting samples, samples that haven't been taken yet are kept until the next start. */
+	void Stop();
+
+	bool IsActive() const { return bIsActive; }
+
+	/**
+	 * Gets the key of the metric, registering it on first use. Safe to call from any thread.
+	 *
+	 * @return Invalid key if the name is empty or too many metrics are registered.
+	 */
+	FSentryMetricKey Register(ESentryMetricType Type, const FString& Name, const FString& Unit, const TMap<FString, FString>& Tags);
+
+	/** Records a sample of the metric. Safe to call from any thread. */
+	void Record(const FSentryMetricKey& Key, double Value);
+
+	/**
+	 * Serializes the samples of the completed buckets into an envelope and removes them.
+	 *
+	 * @param bIncludeCurrent Whether the current buckets should be taken as well, e.g. on shutdown.
+	 * @return Empty array if there were no samples.
+	 */
+	TArray<uint8> TakeEnvelope(bool bIncludeCurrent);
+
+	/** Max number of distinct metrics, samples of metrics registered beyond it are dropped. */
+	static constexpr int32 MaxMetrics = 4096;
+
+	/** Max number of samples of a distribution kept per bucket and thread. */
+	static constexpr int32 MaxDistributionSamples = 1024;
+
+	/** Length of the buckets samples are aggregated in. */
+	static constexpr int64 BucketSeconds = 10;
+
+private:
+	struct FSlot
+	{
+		double Sum = 0.0;
+		double Min = 0.0;
+		double Max = 0.0;
+		double Last = 0.0;
+		int32 Count = 0;
+		TArray<float> Samples;
+	};
+
+	struct FBucket
+	{
+		int64 UnixSeconds = 0;
+		TArray<FSlot> Slots;
+	};
+
+	struct FThreadBuffer
+	{
+		/** Set while either the owning thread or the flush accesses the buffer. */
+		TAtomic<bool> bIsBusy { false };
+
+		FBucket Current;
+		uint64 CurrentEndCycles = 0;
+
+		TArray<FBucket> Completed;
+	};
+
+	struct FMetricInfo
+	{
+		ESentryMetricType Type;
+
+		/** Name with unit and the serialized tags, e.g. `frame_time@millisecond` and `|#map:Arena`. */
+		FString NameAndUnit;
+		FString Tags;
+	};
+
+	FThreadBuffer& GetThreadBuffer();
+
+	/** Moves the current bucket of the buffer to the completed ones and starts the one the given time falls into. */
+	void StartBucket(FThreadBuffer& Buffer, uint64 NowCycles) const;
+
+	static void AddSample(FSlot& Slot, ESentryMetricType Type, double Value);
+	static void MergeSlot(FSlot& Target, const FSlot& Source, ESentryMetricType Type);
+
+	static FString Sanitize(const FString& Value, bool bIsTagValue);
+
+	uint32 TlsSlot = 0;
+
+	TAtomic<bool> bIsActive { false };
+
+	/** Unix time and cycle counter at the start, bucket timestamps are derived from the cycles counted since. */
+	int64 StartUnixSeconds = 0;
+	uint64 StartCycles = 0;
+
+	FString DefaultTags;
+
+	mutable FRWLock RegistryLock;
+	TMap<FString, int32> KeysByDescription;
+	TArray<FMetricInfo> Metrics;
+
+	FCriticalSection BuffersCriticalSection;
+	TArray<TUniquePtr<FThreadBuffer>> Buffers;
+
+	FThreadSafeCounter NumDroppedSamples;
+};
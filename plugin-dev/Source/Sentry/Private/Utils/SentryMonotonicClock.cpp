@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryMonotonicClock.h"
+
+#include "Misc/DateTime.h"
+#include "Templates/Atomic.h"
+
+namespace SentryMonotonicClock
+{
+	/** Time after which the process clock is anchored to the wall clock again, in microseconds of the cycle counter. */
+	static constexpr int64 ReanchorIntervalMicroseconds = 1000000;
+}
+
+FSentryMonotonicClock::FSentryMonotonicClock()
+	: Offset(GetWallClockTimestamp() - CyclesToMicroseconds(FPlatformTime::Cycles64()))
+{
+}
+
+int64 FSentryMonotonicClock::GetProcessTimestamp()
+{
+	static TAtomic<int64> ProcessOffset { 0 };
+	static TAtomic<int64> AnchoredAt { 0 };
+
+	const int64 Now = CyclesToMicroseconds(FPlatformTime::Cycles64());
+
+	// Threads racing to anchor the clock again all store an up-to-date offset, so whichever wins doesn't matter
+	const int64 LastAnchoredAt = AnchoredAt.Load();
+	if (LastAnchoredAt == 0 || Now - LastAnchoredAt >= SentryMonotonicClock::ReanchorIntervalMicroseconds)
+	{
+		const int64 Offset = GetWallClockTimestamp() - Now;
+		ProcessOffset.Store(Offset);
+		AnchoredAt.Store(Now);
+		return Now + Offset;
+	}
+
+	return Now + ProcessOffset.Load();
+}
+
+int64 FSentryMonotonicClock::GetWallClockTimestamp()
+{
+	return (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond;
+}
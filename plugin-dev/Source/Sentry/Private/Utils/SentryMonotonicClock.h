@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Wall clock derived from the high-resolution monotonic cycle counter.
+ *
+ * The offset between FPlatformTime::Cycles64 and the wall clock is taken once when the clock is created, so reading
+ * a timestamp afterwards is a single counter read and is immune to system clock adjustments. Transactions create
+ * their own clock so that all of their spans are timed consistently.
+ */
+class FSentryMonotonicClock
+{
+public:
+	/** Anchors the clock to the current wall-clock time. */
+	FSentryMonotonicClock();
+
+	/** Creates a clock from the offset of another one, e.g. one stored by a scoped span. */
+	explicit FSentryMonotonicClock(int64 InOffset)
+		: Offset(InOffset)
+	{
+	}
+
+	/** Gets the current time in microseconds since the Unix epoch. */
+	int64 GetTimestamp() const
+	{
+		return ToTimestamp(FPlatformTime::Cycles64());
+	}
+
+	/** Converts a reading of FPlatformTime::Cycles64 to microseconds since the Unix epoch. */
+	int64 ToTimestamp(uint64 Cycles) const
+	{
+		return CyclesToMicroseconds(Cycles) + Offset;
+	}
+
+	/** Microseconds added to the cycle counter to get the wall-clock time. */
+	int64 GetOffset() const { return Offset; }
+
+	/**
+	 * Gets the current time in microseconds since the Unix epoch from the process-wide clock, for timestamps that don't
+	 * belong to a transaction such as breadcrumbs. The clock is anchored to the wall clock again every second, so it
+	 * follows system clock adjustments and time spent suspended, which the cycle counter doesn't count on every platform.
+	 */
+	static int64 GetProcessTimestamp();
+
+	/** Gets the current wall-clock time in microseconds since the Unix epoch. */
+	static int64 GetWallClockTimestamp();
+
+private:
+	static int64 CyclesToMicroseconds(uint64 Cycles)
+	{
+		return static_cast<int64>(FPlatformTime::GetSecondsPerCycle64() * static_cast<double>(Cycles) * 1000000.0);
+	}
+
+	int64 Offset;
+};
@@ -0,0 +1,306 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryNetworkQuality.h"
+
+#include "SentryDefines.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryNetworkQuality
+{
+	/** Max number of samples listed in the timeline strings of the context, the summary covers all of them. */
+	static constexpr int32 MaxListedSamples = 60;
+
+	/** Losing more packets than this in a second is noticed by players. */
+	static constexpr float HighLossPercent = 5.0f;
+
+	static const TCHAR* GetNetModeName(ENetMode NetMode)
+	{
+		switch (NetMode)
+		{
+		case NM_Client:
+			return TEXT("client");
+		case NM_ListenServer:
+			return TEXT("listen_server");
+		case NM_DedicatedServer:
+			return TEXT("dedicated_server");
+		default:
+			return TEXT("standalone");
+		}
+	}
+
+	template <typename TGetter>
+	static FString JoinValues(const TArray<FSentryNetworkQuality::FSample>& Samples, const TCHAR* Format, TGetter Getter)
+	{
+		FString Values;
+		for (int32 Index = FMath::Max(0, Samples.Num() - MaxListedSamples); Index < Samples.Num(); ++Index)
+		{
+			if (!Values.IsEmpty())
+			{
+				Values += TEXT(",");
+			}
+
+			Values += FString::Printf(Format, Getter(Samples[Index]));
+		}
+
+		return Values;
+	}
+}
+
+FSentryNetworkQuality& FSentryNetworkQuality::Get()
+{
+	static FSentryNetworkQuality Instance;
+	return Instance;
+}
+
+void FSentryNetworkQuality::Start(int32 InHistorySeconds)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		Samples.SetNum(FMath::Clamp(InHistorySeconds, 5, 300));
+		NextSlot = 0;
+		NumSamples = 0;
+		NetMode.Reset();
+	}
+
+	bIsActive = true;
+
+	const uint32 Serial = ++StartSerial;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Serial](float DeltaTime)
+	{
+		if (!bIsActive || StartSerial != Serial)
+		{
+			return false;
+		}
+
+		Sample();
+		return true;
+	}), 1.0f);
+}
+
+void FSentryNetworkQuality::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FScopeLock Lock(&CriticalSection);
+
+	Samples.Empty();
+	NextSlot = 0;
+	NumSamples = 0;
+}
+
+bool FSentryNetworkQuality::GetSamples(TArray<FSample>& OutSamples) const
+{
+	// Crashed thread might be the one holding the lock so waiting for it isn't an option
+	if (!CriticalSection.TryLock())
+	{
+		return false;
+	}
+
+	const int32 Capacity = Samples.Num();
+	const int32 FirstSlot = NumSamples < Capacity ? 0 : NextSlot;
+
+	OutSamples.Reset(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		OutSamples.Add(Samples[(FirstSlot + Index) % Capacity]);
+	}
+
+	CriticalSection.Unlock();
+
+	return true;
+}
+
+TMap<FString, FSentryVariant> FSentryNetworkQuality::ToContext() const
+{
+	TArray<FSample> Timeline;
+	if (!GetSamples(Timeline))
+	{
+		return TMap<FString, FSentryVariant>();
+	}
+
+	FString CurrentNetMode;
+	if (CriticalSection.TryLock())
+	{
+		CurrentNetMode = NetMode;
+		CriticalSection.Unlock();
+	}
+
+	TMap<FString, FSentryVariant> Context = ToContext(Timeline, CurrentNetMode);
+	if (Timeline.Num() > 0)
+	{
+		// Samples stop once the connection closes, which tells apart a disconnected game from a stale timeline
+		Context.Add(TEXT("last_sample_age_seconds"), static_cast<float>(FPlatformTime::Seconds() - Timeline.Last().Time));
+	}
+
+	return Context;
+}
+
+TMap<FString, FSentryVariant> FSentryNetworkQuality::ToContext(const TArray<FSample>& InSamples, const FString& InNetMode)
+{
+	TMap<FString, FSentryVariant> Context;
+
+	if (InSamples.Num() == 0)
+	{
+		return Context;
+	}
+
+	const FSample& Latest = InSamples.Last();
+
+	if (!InNetMode.IsEmpty())
+	{
+		Context.Add(TEXT("net_mode"), InNetMode);
+	}
+
+	Context.Add(TEXT("connections"), Latest.NumConnections);
+	Context.Add(TEXT("ping_ms"), Latest.PingMs);
+	Context.Add(TEXT("in_loss_percent"), Latest.InLossPercent);
+	Context.Add(TEXT("out_loss_percent"), Latest.OutLossPercent);
+	Context.Add(TEXT("in_bytes_per_second"), Latest.InBytesPerSecond);
+	Context.Add(TEXT("out_bytes_per_second"), Latest.OutBytesPerSecond);
+	Context.Add(TEXT("saturation"), Latest.Saturation);
+
+	float PingSum = 0.0f;
+	float PingMax = 0.0f;
+	float LossMax = 0.0f;
+	int32 NumHighLossSamples = 0;
+	int32 NumSaturatedSamples = 0;
+
+	for (const FSample& Sample : InSamples)
+	{
+		const float LossPercent = FMath::Max(Sample.InLossPercent, Sample.OutLossPercent);
+
+		PingSum += Sample.PingMs;
+		PingMax = FMath::Max(PingMax, Sample.PingMs);
+		LossMax = FMath::Max(LossMax, LossPercent);
+
+		NumHighLossSamples += LossPercent > SentryNetworkQuality::HighLossPercent ? 1 : 0;
+		NumSaturatedSamples += Sample.Saturation >= 1.0f ? 1 : 0;
+	}
+
+	Context.Add(TEXT("timeline_seconds"), static_cast<float>(Latest.Time - InSamples[0].Time) + 1.0f);
+	Context.Add(TEXT("ping_avg_ms"), PingSum / InSamples.Num());
+	Context.Add(TEXT("ping_max_ms"), PingMax);
+	Context.Add(TEXT("loss_max_percent"), LossMax);
+	Context.Add(TEXT("high_loss_seconds"), NumHighLossSamples);
+	Context.Add(TEXT("saturated_seconds"), NumSaturatedSamples);
+
+	// Per-second values as strings, which is far more compact than arrays of values
+	Context.Add(TEXT("recent_ping_ms"), SentryNetworkQuality::JoinValues(InSamples, TEXT("%.0f"), [](const FSample& Sample) { return Sample.PingMs; }));
+	Context.Add(TEXT("recent_loss_percent"), SentryNetworkQuality::JoinValues(InSamples, TEXT("%.1f"), [](const FSample& Sample) { return FMath::Max(Sample.InLossPercent, Sample.OutLossPercent); }));
+	Context.Add(TEXT("recent_out_bytes_per_second"), SentryNetworkQuality::JoinValues(InSamples, TEXT("%d"), [](const FSample& Sample) { return Sample.OutBytesPerSecond; }));
+
+	return Context;
+}
+
+bool FSentryNetworkQuality::SampleNetDriver(const UNetDriver& NetDriver, FSample& OutSample)
+{
+	TArray<UNetConnection*, TInlineAllocator<1>> Connections;
+	if (NetDriver.ServerConnection)
+	{
+		Connections.Add(NetDriver.ServerConnection);
+	}
+	else
+	{
+		Connections.Append(NetDriver.ClientConnections);
+	}
+
+	OutSample = FSample();
+
+	for (const UNetConnection* Connection : Connections)
+	{
+		if (!Connection || Connection->GetConnectionState() != USOCK_Open)
+		{
+			continue;
+		}
+
+		OutSample.PingMs += static_cast<float>(Connection->AvgLag * 1000.0);
+		OutSample.InLossPercent = FMath::Max(OutSample.InLossPercent, Connection->GetInLossPercentage().GetAvgLossPercentage() * 100.0f);
+		OutSample.OutLossPercent = FMath::Max(OutSample.OutLossPercent, Connection->GetOutLossPercentage().GetAvgLossPercentage() * 100.0f);
+		OutSample.InBytesPerSecond += Connection->InBytesPerSecond;
+		OutSample.OutBytesPerSecond += Connection->OutBytesPerSecond;
+
+		if (Connection->CurrentNetSpeed > 0)
+		{
+			OutSample.Saturation = FMath::Max(OutSample.Saturation, static_cast<float>(Connection->OutBytesPerSecond) / Connection->CurrentNetSpeed);
+		}
+
+		++OutSample.NumConnections;
+	}
+
+	if (OutSample.NumConnections == 0)
+	{
+		return false;
+	}
+
+	OutSample.PingMs /= OutSample.NumConnections;
+
+	return true;
+}
+
+void FSentryNetworkQuality::Sample()
+{
+	if (!GEngine)
+	{
+		return;
+	}
+
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		UWorld* World = WorldContext.World();
+		const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+
+		FSample NewSample;
+		if (!NetDriver || !SampleNetDriver(*NetDriver, NewSample))
+		{
+			continue;
+		}
+
+		NewSample.Time = FPlatformTime::Seconds();
+
+		FScopeLock Lock(&CriticalSection);
+
+		if (Samples.Num() == 0)
+		{
+			return;
+		}
+
+		Samples[NextSlot] = NewSample;
+		NextSlot = (NextSlot + 1) % Samples.Num();
+		NumSamples = FMath::Min(NumSamples + 1, Samples.Num());
+
+		const TCHAR* NetModeName = SentryNetworkQuality::GetNetModeName(World->GetNetMode());
+		if (NetMode != NetModeName)
+		{
+			NetMode = NetModeName;
+		}
+
+		return;
+	}
+}
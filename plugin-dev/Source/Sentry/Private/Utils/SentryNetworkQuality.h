@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include "SentryVariant.h"
+
+class UNetDriver;
+
+/**
+ * Once-per-second timeline of the quality of the active game network connection, added to events as the `network` context.
+ *
+ * Samples are read from the stats the net driver already keeps for its connections, so nothing is hooked per packet.
+ * Clients sample their server connection while servers aggregate over all client connections. Samples are kept
+ * in a ring preallocated when sampling starts, which keeps the memory constant regardless of the session length.
+ */
+class FSentryNetworkQuality
+{
+public:
+	/** Connection quality in a single second. */
+	struct FSample
+	{
+		/** Time of the sample, in FPlatformTime::Seconds. */
+		double Time = 0.0;
+
+		/** Round trip time in milliseconds, averaged over the connections. */
+		float PingMs = 0.0f;
+
+		/** Share of the packets lost in the last stat period in percent, highest among the connections. */
+		float InLossPercent = 0.0f;
+		float OutLossPercent = 0.0f;
+
+		/** Bandwidth summed over the connections. */
+		int32 InBytesPerSecond = 0;
+		int32 OutBytesPerSecond = 0;
+
+		/** Outgoing bandwidth relative to the net speed of the connection, highest among the connections. Saturated at 1 or more. */
+		float Saturation = 0.0f;
+
+		int32 NumConnections = 0;
+
+		FSample() = default;
+
+		FSample(double InTime, float InPingMs, float InIncomingLossPercent, float InSaturation)
+			: Time(InTime)
+			, PingMs(InPingMs)
+			, InLossPercent(InIncomingLossPercent)
+			, Saturation(InSaturation)
+		{
+		}
+	};
+
+	static FSentryNetworkQuality& Get();
+
+	/**
+	 * Starts sampling the network connection once per second. Called on the game thread.
+	 *
+	 * @param InHistorySeconds Time span covered by the timeline.
+	 */
+	void Start(int32 InHistorySeconds);
+
+	/** Stops sampling and discards the timeline. */
+	void Stop();
+
+	bool IsActive() const { return bIsActive; }
+
+	/** Gets the samples of the timeline, oldest first. Returns false without waiting if the timeline is being updated. */
+	bool GetSamples(TArray<FSample>& OutSamples) const;
+
+	/** Converts the timeline to the values of the network context, empty if there is no connection to report. */
+	TMap<FString, FSentryVariant> ToContext() const;
+
+	/** Converts samples to the values of the network context, the latest sample comes last. */
+	static TMap<FString, FSentryVariant> ToContext(const TArray<FSample>& InSamples, const FString& InNetMode = FString());
+
+	/** Reads the quality of the connections of the net driver, returns false if it has no open connections. */
+	static bool SampleNetDriver(const UNetDriver& NetDriver, FSample& OutSample);
+
+private:
+	FSentryNetworkQuality() = default;
+
+	/** Samples the net driver of the game world. Called on the game thread. */
+	void Sample();
+
+	FThreadSafeBool bIsActive;
+
+	/** Incremented whenever sampling starts so that the ticker of a previous start stops. */
+	uint32 StartSerial = 0;
+
+	mutable FCriticalSection CriticalSection;
+
+	/** Preallocated ring of samples, the oldest one is at NextSlot once the ring is full. */
+	TArray<FSample> Samples;
+	int32 NextSlot = 0;
+	int32 NumSamples = 0;
+
+	/** Net mode of the world the latest sample was taken from. */
+	FString NetMode;
+};
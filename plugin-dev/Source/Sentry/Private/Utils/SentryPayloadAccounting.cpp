@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryPayloadAccounting.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryPayloadAccounting
+{
+	static constexpr int32 NumBuckets = 60;
+
+	struct FCategoryTotals
+	{
+		/** Bytes recorded during each second of the last minute, indexed by the second modulo the bucket count. */
+		int64 Buckets[NumBuckets] = {};
+		int64 BucketSeconds[NumBuckets] = {};
+
+		int64 Total = 0;
+
+		void Add(int64 Second, int64 Bytes)
+		{
+			const int32 Index = static_cast<int32>(Second % NumBuckets);
+			if (BucketSeconds[Index] != Second)
+			{
+				BucketSeconds[Index] = Second;
+				Buckets[Index] = 0;
+			}
+
+			Buckets[Index] += Bytes;
+			Total += Bytes;
+		}
+
+		int64 GetPerMinute(int64 Second) const
+		{
+			int64 Sum = 0;
+			for (int32 i = 0; i < NumBuckets; ++i)
+			{
+				if (Second - BucketSeconds[i] < NumBuckets)
+				{
+					Sum += Buckets[i];
+				}
+			}
+			return Sum;
+		}
+	};
+
+	static FCriticalSection Lock;
+	static FCategoryTotals Categories[static_cast<int32>(ESentryPayloadCategory::Num)];
+	static int64 NumEvents = 0;
+	static int64 NumTrimmedEvents = 0;
+	static int64 MaxEventBytes = 0;
+
+	static int64 GetCurrentSecond()
+	{
+		// Offset keeps the zero-initialized buckets from counting as the current minute right after startup
+		return static_cast<int64>(FPlatformTime::Seconds()) + NumBuckets;
+	}
+}
+
+void SentryPayloadAccounting::Record(ESentryPayloadCategory Category, int64 Bytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	Categories[static_cast<int32>(Category)].Add(GetCurrentSecond(), Bytes);
+}
+
+void SentryPayloadAccounting::RecordEvent(int64 Bytes, bool bWasTrimmed)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Categories[static_cast<int32>(ESentryPayloadCategory::Event)].Add(GetCurrentSecond(), Bytes);
+
+	NumEvents++;
+	NumTrimmedEvents += bWasTrimmed ? 1 : 0;
+	MaxEventBytes = FMath::Max(MaxEventBytes, Bytes);
+}
+
+FSentryPayloadStats SentryPayloadAccounting::GetStats()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int64 Second = GetCurrentSecond();
+
+	const FCategoryTotals& Events = Categories[static_cast<int32>(ESentryPayloadCategory::Event)];
+	const FCategoryTotals& Attachments = Categories[static_cast<int32>(ESentryPayloadCategory::Attachment)];
+
+	FSentryPayloadStats Stats;
+	Stats.EventBytesPerMinute = Events.GetPerMinute(Second);
+	Stats.AttachmentBytesPerMinute = Attachments.GetPerMinute(Second);
+	Stats.TotalEventBytes = Events.Total;
+	Stats.TotalAttachmentBytes = Attachments.Total;
+	Stats.NumEvents = NumEvents;
+	Stats.NumTrimmedEvents = NumTrimmedEvents;
+	Stats.MaxEventBytes = MaxEventBytes;
+	return Stats;
+}
+
+void SentryPayloadAccounting::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (FCategoryTotals& Category : Categories)
+	{
+		Category = FCategoryTotals();
+	}
+
+	NumEvents = 0;
+	NumTrimmedEvents = 0;
+	MaxEventBytes = 0;
+}
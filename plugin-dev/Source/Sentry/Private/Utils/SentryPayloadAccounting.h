@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryPayloadStats.h"
+
+enum class ESentryPayloadCategory : uint8
+{
+	Event,
+	Attachment,
+	Num
+};
+
+/**
+ * Running totals of the outgoing payload sizes shared by all platform implementations.
+ * Per-minute rates are kept in one-second buckets so that recording stays constant time.
+ */
+namespace SentryPayloadAccounting
+{
+	void Record(ESentryPayloadCategory Category, int64 Bytes);
+
+	/** Records the final size of a captured event and whether it had to be trimmed to fit the budget. */
+	void RecordEvent(int64 Bytes, bool bWasTrimmed);
+
+	FSentryPayloadStats GetStats();
+
+	void Reset();
+}
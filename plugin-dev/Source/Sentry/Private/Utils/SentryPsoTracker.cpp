@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryPsoTracker.h"
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryMetrics.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/EngineVersionComparison.h"
+#include "PipelineFileCache.h"
+#include "PipelineStateCache.h"
+
+namespace SentryPsoTracker
+{
+	/** Weight of the latest frame in the running average of frames without misses. */
+	static constexpr float AverageWeight = 0.05f;
+
+	/** Frames longer than this are left out of the average, e.g. loading screens. */
+	static constexpr float MaxAveragedFrameMs = 250.0f;
+
+	/** Estimated stall a frame with new PSOs has to exceed for them to count as compiled at first use rather than precompiled. */
+	static constexpr float MinCompileStallMs = 5.0f;
+}
+
+FSentryPsoTracker& FSentryPsoTracker::Get()
+{
+	static FSentryPsoTracker Instance;
+	return Instance;
+}
+
+void FSentryPsoTracker::Start(float InStallThresholdMs, FSentryOnPsoStall InOnStall)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	StallThresholdMs = FMath::Max(1.0f, InStallThresholdMs);
+	OnStall = InOnStall;
+
+	Stats = FStats();
+	PendingNewPsos = 0;
+	LastFrameEndTime = FPlatformTime::Seconds();
+	AverageFrameMs = 0.0f;
+
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive())
+	{
+		MissesMetric = Metrics.Register(ESentryMetricType::Counter, TEXT("pso.misses"), TEXT("none"), {});
+		StallMetric = Metrics.Register(ESentryMetricType::Distribution, TEXT("pso.stall"), TEXT("millisecond"), {});
+	}
+
+	bIsActive = true;
+
+	OnPipelineStateLoggedHandle = FPipelineFileCacheManager::OnPipelineStateLogged().AddLambda([this](const FPipelineCacheFileFormatPSO& PSO)
+	{
+		++PendingNewPsos;
+	});
+
+	OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSentryPsoTracker::OnEndFrame);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("PSO cache miss tracking enabled, stalls over %.0f ms are reported."), StallThresholdMs);
+}
+
+void FSentryPsoTracker::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FPipelineFileCacheManager::OnPipelineStateLogged().Remove(OnPipelineStateLoggedHandle);
+	OnPipelineStateLoggedHandle.Reset();
+
+	FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+	OnEndFrameHandle.Reset();
+
+	OnStall.Unbind();
+
+	MissesMetric = FSentryMetricKey();
+	StallMetric = FSentryMetricKey();
+}
+
+FSentryPsoTracker::FStats FSentryPsoTracker::GetStats() const
+{
+	FStats Result = Stats;
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	Result.PendingPrecacheRequests = static_cast<int32>(PipelineStateCache::GetNumActivePipelinePrecacheRequests());
+#endif
+
+	return Result;
+}
+
+TMap<FString, FSentryVariant> FSentryPsoTracker::ToContext(const FStats& InStats)
+{
+	TMap<FString, FSentryVariant> Context;
+
+	Context.Add(TEXT("new_psos"), InStats.NewPsos);
+	Context.Add(TEXT("misses"), InStats.Misses);
+	Context.Add(TEXT("frames_with_misses"), InStats.FramesWithMisses);
+	Context.Add(TEXT("stalls"), InStats.Stalls);
+	Context.Add(TEXT("total_stall_ms"), InStats.TotalStallMs);
+	Context.Add(TEXT("max_stall_ms"), InStats.MaxStallMs);
+
+	if (InStats.FramesWithMisses > 0)
+	{
+		Context.Add(TEXT("avg_stall_ms"), InStats.TotalStallMs / InStats.FramesWithMisses);
+	}
+
+	if (InStats.PendingPrecacheRequests >= 0)
+	{
+		Context.Add(TEXT("pending_precache_requests"), InStats.PendingPrecacheRequests);
+	}
+
+	return Context;
+}
+
+float FSentryPsoTracker::EstimateStallMs(float FrameMs, float InAverageFrameMs)
+{
+	return FMath::Max(0.0f, FrameMs - InAverageFrameMs);
+}
+
+void FSentryPsoTracker::OnEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+	const float FrameMs = static_cast<float>((Now - LastFrameEndTime) * 1000.0);
+	LastFrameEndTime = Now;
+
+	const int32 NumNewPsos = PendingNewPsos.Exchange(0);
+	Stats.NewPsos += NumNewPsos;
+
+	const float StallMs = NumNewPsos > 0 ? EstimateStallMs(FrameMs, AverageFrameMs) : 0.0f;
+
+	// PSOs that were new to the file cache but precompiled don't hitch the frame, so it counts towards the average
+	if (NumNewPsos == 0 || StallMs < SentryPsoTracker::MinCompileStallMs)
+	{
+		if (FrameMs < SentryPsoTracker::MaxAveragedFrameMs)
+		{
+			AverageFrameMs = AverageFrameMs > 0.0f ? FMath::Lerp(AverageFrameMs, FrameMs, SentryPsoTracker::AverageWeight) : FrameMs;
+		}
+
+		return;
+	}
+
+	const int32 NumMisses = NumNewPsos;
+
+	Stats.Misses += NumMisses;
+	Stats.FramesWithMisses++;
+	Stats.TotalStallMs += StallMs;
+	Stats.MaxStallMs = FMath::Max(Stats.MaxStallMs, StallMs);
+
+	FSentryMetrics& Metrics = FSentryMetrics::Get();
+	if (Metrics.IsActive() && MissesMetric.IsValid())
+	{
+		Metrics.Record(MissesMetric, NumMisses);
+		Metrics.Record(StallMetric, StallMs);
+	}
+
+	if (StallMs >= StallThresholdMs)
+	{
+		Stats.Stalls++;
+		OnStall.ExecuteIfBound(NumMisses, StallMs);
+	}
+}
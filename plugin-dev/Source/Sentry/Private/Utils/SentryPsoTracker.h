@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+
+#include "SentryMetricKey.h"
+#include "SentryVariant.h"
+
+DECLARE_DELEGATE_TwoParams(FSentryOnPsoStall, int32 /* NumMisses */, float /* StallMs */);
+
+/**
+ * Tracks pipeline state objects that were missing from the PSO cache and had to be compiled at first use.
+ *
+ * New PSOs are counted from the events the pipeline file cache logs them with, on whichever thread creates them.
+ * A PSO new to the file cache may still have been precompiled, e.g. by PSO precaching, so it only counts as a miss
+ * if its frame hitched. Drivers don't report how long a compile took, so the stall of a frame is estimated as the
+ * time it took beyond the running average of frames without hitches. Totals are kept for the `pso` context and
+ * recorded as metrics so that the effectiveness of PSO precaching can be compared between releases.
+ */
+class FSentryPsoTracker
+{
+public:
+	/** Totals since tracking started. */
+	struct FStats
+	{
+		/** Number of PSOs logged as new by the pipeline file cache, whether compiling them stalled or not. */
+		int32 NewPsos = 0;
+
+		/** Number of new PSOs logged in frames that hitched, i.e. the ones that were most likely compiled at first use. */
+		int32 Misses = 0;
+		int32 FramesWithMisses = 0;
+
+		/** Number of frames with misses that stalled for longer than the threshold. */
+		int32 Stalls = 0;
+
+		float TotalStallMs = 0.0f;
+		float MaxStallMs = 0.0f;
+
+		/** Number of PSOs still being precached, negative if the engine doesn't precache PSOs. */
+		int32 PendingPrecacheRequests = -1;
+	};
+
+	static FSentryPsoTracker& Get();
+
+	/**
+	 * Starts tracking PSO cache misses. Called on the game thread.
+	 *
+	 * @param InStallThresholdMs Estimated stall a frame with misses has to exceed to be reported.
+	 * @param InOnStall Called on the game thread for frames that stalled for longer than the threshold.
+	 */
+	void Start(float InStallThresholdMs, FSentryOnPsoStall InOnStall);
+
+	void Stop();
+
+	bool IsActive() const { return bIsActive; }
+
+	/** Gets the totals since tracking started. Called on the game thread. */
+	FStats GetStats() const;
+
+	/** Converts the totals to the values of the pso context. */
+	static TMap<FString, FSentryVariant> ToContext(const FStats& InStats);
+
+	/** Estimates the stall of a frame with misses from its duration and the average duration of frames without misses. */
+	static float EstimateStallMs(float FrameMs, float InAverageFrameMs);
+
+private:
+	FSentryPsoTracker() = default;
+
+	void OnEndFrame();
+
+	FThreadSafeBool bIsActive;
+
+	FDelegateHandle OnPipelineStateLoggedHandle;
+	FDelegateHandle OnEndFrameHandle;
+
+	FSentryOnPsoStall OnStall;
+
+	float StallThresholdMs = 50.0f;
+
+	/** New PSOs logged since the end of the previous frame, incremented on any thread. */
+	TAtomic<int32> PendingNewPsos { 0 };
+
+	/** Game thread only. */
+	FStats Stats;
+	double LastFrameEndTime = 0.0;
+	float AverageFrameMs = 0.0f;
+
+	FSentryMetricKey MissesMetric;
+	FSentryMetricKey StallMetric;
+};
@@ -0,0 +1,267 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryRedactedWidgets.h"
+
+#include "Components/Widget.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "Widgets/SWidget.h"
+#include "Widgets/SWindow.h"
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "ClearQuad.h"
+#include "RHICommandList.h"
+#endif
+
+FSentryRedactedWidgets& FSentryRedactedWidgets::Get()
+{
+	static FSentryRedactedWidgets Instance;
+	return Instance;
+}
+
+void FSentryRedactedWidgets::AddWidget(const TSharedRef<SWidget>& Widget)
+{
+	check(IsInGameThread());
+
+	SlateWidgets.AddUnique(Widget);
+	UpdateEndFrameHandler();
+}
+
+void FSentryRedactedWidgets::AddWidget(UWidget* Widget)
+{
+	check(IsInGameThread());
+
+	if (!Widget)
+	{
+		return;
+	}
+
+	UmgWidgets.AddUnique(Widget);
+	UpdateEndFrameHandler();
+}
+
+void FSentryRedactedWidgets::RemoveWidget(const TSharedRef<SWidget>& Widget)
+{
+	check(IsInGameThread());
+
+	SlateWidgets.Remove(Widget);
+	UpdateEndFrameHandler();
+}
+
+void FSentryRedactedWidgets::RemoveWidget(UWidget* Widget)
+{
+	check(IsInGameThread());
+
+	UmgWidgets.Remove(Widget);
+	UpdateEndFrameHandler();
+}
+
+bool FSentryRedactedWidgets::HasWidgets() const
+{
+	return bHasWidgets;
+}
+
+void FSentryRedactedWidgets::UpdateEndFrameHandler()
+{
+	bHasWidgets = SlateWidgets.Num() > 0 || UmgWidgets.Num() > 0;
+
+	if (HasWidgets() && !OnEndFrameHandle.IsValid())
+	{
+		OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSentryRedactedWidgets::OnEndFrame);
+	}
+	else if (!HasWidgets() && OnEndFrameHandle.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+		OnEndFrameHandle.Reset();
+
+		FScopeLock Lock(&RectsCriticalSection);
+		Rects.Reset();
+		RectsWindow = nullptr;
+	}
+}
+
+void FSentryRedactedWidgets::OnEndFrame()
+{
+	SlateWidgets.RemoveAll([](const TWeakPtr<SWidget>& Widget) { return !Widget.IsValid(); });
+	UmgWidgets.RemoveAll([](const TWeakObjectPtr<UWidget>& Widget) { return !Widget.IsValid(); });
+
+	if (SlateWidgets.Num() == 0 && UmgWidgets.Num() == 0)
+	{
+		// All redacted widgets were destroyed
+		UpdateEndFrameHandler();
+		return;
+	}
+
+	TSharedPtr<SWindow> Window = GEngine && GEngine->GameViewport ? GEngine->GameViewport->GetWindow() : nullptr;
+
+	TArray<FBox2D> NewRects;
+
+	if (Window.IsValid())
+	{
+		// Widget geometry is in desktop space, the window geometry maps it onto the area its back buffer covers,
+		// including any border Slate draws itself, regardless of the window mode and DPI scale
+		const FGeometry WindowGeometry = Window->GetWindowGeometryInScreen();
+		const FVector2D WindowSize = FVector2D(WindowGeometry.GetLocalSize());
+
+		auto AddRect = [&NewRects, &WindowGeometry, &WindowSize](const TSharedPtr<SWidget>& Widget)
+		{
+			if (!Widget.IsValid() || !Widget->GetVisibility().IsVisible() || WindowSize.X <= 0.0 || WindowSize.Y <= 0.0)
+			{
+				return;
+			}
+
+			const FGeometry& Geometry = Widget->GetPaintSpaceGeometry();
+			const FVector2D AbsoluteMin = FVector2D(Geometry.GetAbsolutePosition());
+			const FVector2D AbsoluteMax = AbsoluteMin + FVector2D(Geometry.GetAbsoluteSize());
+
+			const FBox2D Rect(FVector2D(WindowGeometry.AbsoluteToLocal(AbsoluteMin)) / WindowSize, FVector2D(WindowGeometry.AbsoluteToLocal(AbsoluteMax)) / WindowSize);
+			if (Rect.GetArea() > 0.0)
+			{
+				NewRects.Add(Rect);
+			}
+		};
+
+		for (const TWeakPtr<SWidget>& Widget : SlateWidgets)
+		{
+			AddRect(Widget.Pin());
+		}
+
+		for (const TWeakObjectPtr<UWidget>& Widget : UmgWidgets)
+		{
+			if (Widget->IsVisible())
+			{
+				AddRect(Widget->GetCachedWidget());
+			}
+		}
+	}
+
+	FScopeLock Lock(&RectsCriticalSection);
+	Swap(Rects, NewRects);
+	RectsWindow = Window.Get();
+}
+
+TArray<FIntRect> FSentryRedactedWidgets::GetRects(const FIntPoint& Size) const
+{
+	TArray<FIntRect> ScaledRects;
+
+	FScopeLock Lock(&RectsCriticalSection);
+
+	for (const FBox2D& Rect : Rects)
+	{
+		// Rounding outwards so that no partially covered pixel is left unmasked
+		FIntRect ScaledRect(
+			FMath::FloorToInt(Rect.Min.X * Size.X), FMath::FloorToInt(Rect.Min.Y * Size.Y),
+			FMath::CeilToInt(Rect.Max.X * Size.X), FMath::CeilToInt(Rect.Max.Y * Size.Y));
+		ScaledRect.Clip(FIntRect(FIntPoint::ZeroValue, Size));
+
+		if (ScaledRect.Area() > 0)
+		{
+			ScaledRects.Add(ScaledRect);
+		}
+	}
+
+	return ScaledRects;
+}
+
+bool FSentryRedactedWidgets::Apply(const SWindow* Window, TArray<FColor>& Pixels, const FIntPoint& Size) const
+{
+	if (!HasWidgets())
+	{
+		return true;
+	}
+
+	{
+		FScopeLock Lock(&RectsCriticalSection);
+		if (Window != RectsWindow)
+		{
+			return false;
+		}
+	}
+
+	if (Pixels.Num() < Size.X * Size.Y)
+	{
+		return false;
+	}
+
+	for (const FIntRect& Rect : GetRects(Size))
+	{
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+			{
+				Pixels[Y * Size.X + X] = FColor::Black;
+			}
+		}
+	}
+
+	return true;
+}
+
+FSentryTextureRHIRef FSentryRedactedWidgets::Apply(FRHICommandListImmediate& RHICmdList, const SWindow& Window, const FSentryTextureRHIRef& Source, FSentryTextureRHIRef& Scratch) const
+{
+	if (!HasWidgets())
+	{
+		return Source;
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	// No GPU pass to clear the widgets with, leaking them isn't an option
+	return nullptr;
+#else
+	check(IsInRenderingThread());
+
+	{
+		FScopeLock Lock(&RectsCriticalSection);
+		if (&Window != RectsWindow)
+		{
+			return nullptr;
+		}
+	}
+
+	const FIntPoint Size = Source->GetSizeXY();
+
+	const TArray<FIntRect> ClippedRects = GetRects(Size);
+	if (ClippedRects.Num() == 0)
+	{
+		return Source;
+	}
+	if (!Scratch.IsValid() || Scratch->GetSizeXY() != Size || Scratch->GetFormat() != Source->GetFormat())
+	{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		FRHIResourceCreateInfo CreateInfo(TEXT("SentryPrivacyMask"));
+		Scratch = RHICreateTexture2D(Size.X, Size.Y, Source->GetFormat(), 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, CreateInfo);
+#else
+		const FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("SentryPrivacyMask"), Size.X, Size.Y, Source->GetFormat())
+			.SetFlags(ETextureCreateFlags::RenderTargetable | ETextureCreateFlags::ShaderResource);
+		Scratch = RHICreateTexture(Desc);
+#endif
+	}
+
+	RHICmdList.Transition({
+		FRHITransitionInfo(Source, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+		FRHITransitionInfo(Scratch, ERHIAccess::Unknown, ERHIAccess::CopyDest)
+	});
+
+	RHICmdList.CopyTexture(Source, Scratch, FRHICopyTextureInfo());
+
+	RHICmdList.Transition(FRHITransitionInfo(Scratch, ERHIAccess::CopyDest, ERHIAccess::RTV));
+
+	FRHIRenderPassInfo PassInfo(Scratch, ERenderTargetActions::Load_Store);
+	RHICmdList.BeginRenderPass(PassInfo, TEXT("SentryPrivacyMask"));
+
+	// Full-screen clear quad restricted to the widget by the viewport, one draw per redacted widget
+	for (const FIntRect& Rect : ClippedRects)
+	{
+		RHICmdList.SetViewport(Rect.Min.X, Rect.Min.Y, 0.0f, Rect.Max.X, Rect.Max.Y, 1.0f);
+		DrawClearQuad(RHICmdList, FLinearColor::Black);
+	}
+
+	RHICmdList.EndRenderPass();
+
+	RHICmdList.Transition(FRHITransitionInfo(Scratch, ERHIAccess::RTV, ERHIAccess::CopySrc));
+
+	return Scratch;
+#endif
+}
@@ -0,0 +1,221 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentrySamplingProfiler.h"
+
+#include "SentryDefines.h"
+
+#include "CoreGlobals.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+
+namespace SentrySamplingProfiler
+{
+	/** Time span covered by the sample rings, samples of longer transactions are only kept for their end. */
+	static constexpr double HistorySeconds = 30.0;
+
+	/** Number of functions listed per thread and category. */
+	static constexpr int32 NumTopFunctions = 10;
+
+	static FString GetFunctionName(uint64 ProgramCounter, TMap<uint64, FString>& SymbolCache)
+	{
+		if (const FString* CachedName = SymbolCache.Find(ProgramCounter))
+		{
+			return *CachedName;
+		}
+
+		FProgramCounterSymbolInfo SymbolInfo;
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, SymbolInfo);
+
+		FString Name = SymbolInfo.FunctionName[0] != '\0'
+			? FString::Printf(TEXT("%s!%s"), ANSI_TO_TCHAR(SymbolInfo.ModuleName), ANSI_TO_TCHAR(SymbolInfo.FunctionName))
+			: FString::Printf(TEXT("0x%016llx"), ProgramCounter);
+
+		return SymbolCache.Add(ProgramCounter, MoveTemp(Name));
+	}
+
+	static TArray<FSentryVariant> GetTopFunctions(TMap<FString, int32>& Counts, int32 NumSamples)
+	{
+		Counts.ValueSort([](int32 A, int32 B) { return A > B; });
+
+		TArray<FSentryVariant> Result;
+		for (const TPair<FString, int32>& Count : Counts)
+		{
+			if (Result.Num() == NumTopFunctions)
+			{
+				break;
+			}
+
+			Result.Add(FString::Printf(TEXT("%.1f%% %s"), 100.0f * Count.Value / NumSamples, *Count.Key));
+		}
+
+		return Result;
+	}
+}
+
+FSentrySamplingProfiler::FSentrySamplingProfiler(float InSampleRateHz)
+	: SampleIntervalSeconds(1.0 / FMath::Clamp(InSampleRateHz, 1.0f, 1000.0f))
+{
+	const int32 NumSamples = FMath::CeilToInt(SentrySamplingProfiler::HistorySeconds / SampleIntervalSeconds);
+
+	GameThreadRing.Name = TEXT("game_thread");
+	GameThreadRing.Samples.SetNumUninitialized(NumSamples);
+
+	RenderThreadRing.Name = TEXT("render_thread");
+	RenderThreadRing.Samples.SetNumUninitialized(NumSamples);
+
+	Thread = FRunnableThread::Create(this, TEXT("SentrySamplingProfiler"), 0, TPri_AboveNormal);
+}
+
+FSentrySamplingProfiler::~FSentrySamplingProfiler()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+bool FSentrySamplingProfiler::WaitForPendingSummaries(double TimeoutSeconds) const
+{
+	const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+
+	while (PendingSummaries.GetValue() > 0)
+	{
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			return false;
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	return true;
+}
+
+TMap<FString, TMap<FString, FSentryVariant>> FSentrySamplingProfiler::Summarize(double StartTime, double EndTime) const
+{
+	TMap<FString, TMap<FString, FSentryVariant>> Data;
+
+	TMap<uint64, FString> SymbolCache;
+
+	for (const FThreadRing* Ring : { &GameThreadRing, &RenderThreadRing })
+	{
+		const TArray<FSample> Samples = CopySamples(*Ring, StartTime, EndTime);
+		if (Samples.Num() == 0)
+		{
+			continue;
+		}
+
+		TMap<FString, int32> SelfCounts;
+		TMap<FString, int32> TotalCounts;
+		TSet<FString> SampleFunctions;
+
+		for (const FSample& Sample : Samples)
+		{
+			SelfCounts.FindOrAdd(SentrySamplingProfiler::GetFunctionName(Sample.ProgramCounters[0], SymbolCache))++;
+
+			// Recursive functions are counted once per sample
+			SampleFunctions.Reset();
+			for (int32 Index = 0; Index < Sample.Depth; ++Index)
+			{
+				SampleFunctions.Add(SentrySamplingProfiler::GetFunctionName(Sample.ProgramCounters[Index], SymbolCache));
+			}
+
+			for (const FString& Function : SampleFunctions)
+			{
+				TotalCounts.FindOrAdd(Function)++;
+			}
+		}
+
+		TMap<FString, FSentryVariant>& ThreadData = Data.Add(FString::Printf(TEXT("profile.%s"), *Ring->Name));
+		ThreadData.Add(TEXT("samples"), Samples.Num());
+		ThreadData.Add(TEXT("interval_ms"), static_cast<float>(SampleIntervalSeconds * 1000.0));
+		ThreadData.Add(TEXT("top_self"), SentrySamplingProfiler::GetTopFunctions(SelfCounts, Samples.Num()));
+		ThreadData.Add(TEXT("top_total"), SentrySamplingProfiler::GetTopFunctions(TotalCounts, Samples.Num()));
+	}
+
+	return Data;
+}
+
+uint32 FSentrySamplingProfiler::Run()
+{
+	LLM_SCOPE_BYTAG(Sentry);
+
+	double NextSampleTime = FPlatformTime::Seconds();
+
+	while (StopRequested.GetValue() == 0)
+	{
+		TakeSample(GameThreadRing, GGameThreadId);
+
+		// Zero until the render thread is started, and when rendering happens on the game thread
+		if (GRenderThreadId != 0 && GRenderThreadId != GGameThreadId)
+		{
+			TakeSample(RenderThreadRing, GRenderThreadId);
+		}
+
+		// Keeping to a fixed schedule so that the capture cost doesn't skew the sampling rate
+		NextSampleTime += SampleIntervalSeconds;
+		const double Now = FPlatformTime::Seconds();
+		if (NextSampleTime > Now)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(NextSampleTime - Now));
+		}
+		else
+		{
+			NextSampleTime = Now;
+		}
+	}
+
+	return 0;
+}
+
+void FSentrySamplingProfiler::Stop()
+{
+	StopRequested.Set(1);
+}
+
+void FSentrySamplingProfiler::TakeSample(FThreadRing& Ring, uint32 ThreadId)
+{
+	const uint64 WriteCount = Ring.WriteCount.Load(EMemoryOrder::Relaxed);
+
+	FSample& Sample = Ring.Samples[WriteCount % Ring.Samples.Num()];
+	Sample.Depth = static_cast<int32>(FPlatformStackWalk::CaptureThreadStackBackTrace(ThreadId, Sample.ProgramCounters, MaxDepth));
+	Sample.Time = FPlatformTime::Seconds();
+
+	if (Sample.Depth > 0)
+	{
+		// Publishes the sample to readers
+		Ring.WriteCount.Store(WriteCount + 1);
+	}
+}
+
+TArray<FSentrySamplingProfiler::FSample> FSentrySamplingProfiler::CopySamples(const FThreadRing& Ring, double StartTime, double EndTime) const
+{
+	const uint64 Capacity = Ring.Samples.Num();
+
+	const uint64 WriteCount = Ring.WriteCount.Load();
+	const uint64 First = WriteCount > Capacity ? WriteCount - Capacity : 0;
+
+	TArray<FSample> Samples;
+	for (uint64 Index = First; Index < WriteCount; ++Index)
+	{
+		const FSample& Sample = Ring.Samples[Index % Capacity];
+		if (Sample.Time < StartTime || Sample.Time > EndTime)
+		{
+			continue;
+		}
+
+		Samples.Add(Sample);
+
+		// The profiler thread kept writing while copying, drop the sample if its slot could have been reused in the meantime
+		if (Ring.WriteCount.Load() + 1 >= Index + Capacity)
+		{
+			Samples.Pop();
+		}
+	}
+
+	return Samples;
+}
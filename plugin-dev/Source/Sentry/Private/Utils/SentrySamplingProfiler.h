@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Atomic.h"
+
+#include "SentryVariant.h"
+
+class FRunnableThread;
+
+/**
+ * Continuous low-overhead sampling profiler for the game and render threads.
+ *
+ * Call stacks are captured at a fixed rate on a dedicated thread which is the only writer of the per-thread sample
+ * rings, so recording a sample is lock-free. Readers copy samples out and discard the ones that were overwritten
+ * while they were being copied.
+ */
+class FSentrySamplingProfiler : public FRunnable
+{
+public:
+	explicit FSentrySamplingProfiler(float InSampleRateHz);
+	virtual ~FSentrySamplingProfiler() override;
+
+	/**
+	 * Summarizes the samples taken in the given time range (FPlatformTime::Seconds) into transaction data:
+	 * the functions most samples were spent in (self) and the functions that were on the stack most often (total), per thread.
+	 * Symbolication is slow, so it shouldn't be called from the game thread.
+	 */
+	TMap<FString, TMap<FString, FSentryVariant>> Summarize(double StartTime, double EndTime) const;
+
+	/** Tracks a summary made on another thread, so that shutdown can wait for the transaction it finishes. */
+	void BeginPendingSummary() { PendingSummaries.Increment(); }
+	void EndPendingSummary() { PendingSummaries.Decrement(); }
+
+	/**
+	 * Waits for the summaries made on other threads to be done. Called on shutdown before the transport closes.
+	 *
+	 * @return False if some are still pending after the timeout.
+	 */
+	bool WaitForPendingSummaries(double TimeoutSeconds) const;
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+private:
+	static constexpr int32 MaxDepth = 48;
+
+	struct FSample
+	{
+		double Time;
+		int32 Depth;
+		uint64 ProgramCounters[MaxDepth];
+	};
+
+	/** Samples of one thread written by the profiler thread only. */
+	struct FThreadRing
+	{
+		FString Name;
+		TArray<FSample> Samples;
+
+		/** Total number of samples written, the next sample goes to WriteCount % Samples.Num(). */
+		TAtomic<uint64> WriteCount { 0 };
+	};
+
+	void TakeSample(FThreadRing& Ring, uint32 ThreadId);
+
+	/** Copies the samples taken in the given time range that weren't overwritten in the meantime. */
+	TArray<FSample> CopySamples(const FThreadRing& Ring, double StartTime, double EndTime) const;
+
+	const double SampleIntervalSeconds;
+
+	FThreadRing GameThreadRing;
+	FThreadRing RenderThreadRing;
+
+	FRunnableThread* Thread = nullptr;
+
+	FThreadSafeCounter StopRequested;
+
+	FThreadSafeCounter PendingSummaries;
+};
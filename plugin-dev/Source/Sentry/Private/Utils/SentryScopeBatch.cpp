@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryScopeBatch.h"
+
+#include "Interface/SentrySubsystemInterface.h"
+#include "Utils/SentryMemoryAccounting.h"
+
+#include "Misc/ScopeLock.h"
+
+void FSentryScopeBatch::SetTag(const FString& Key, const FString& Value)
+{
+	FScopeLock Lock(&CriticalSection);
+	PendingTags.Add(Key, Value);
+}
+
+void FSentryScopeBatch::RemoveTag(const FString& Key)
+{
+	FScopeLock Lock(&CriticalSection);
+	PendingTags.Add(Key, TOptional<FString>());
+}
+
+void FSentryScopeBatch::SetContext(const FString& Key, const TMap<FString, FSentryVariant>& Values)
+{
+	FScopeLock Lock(&CriticalSection);
+	PendingContexts.Add(Key, Values);
+}
+
+bool FSentryScopeBatch::HasPendingChanges() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return PendingTags.Num() > 0 || PendingContexts.Num() > 0;
+}
+
+SIZE_T FSentryScopeBatch::GetAllocatedSize() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	SIZE_T Size = PendingTags.GetAllocatedSize() + SentryMemoryAccounting::GetAllocatedSize(PendingContexts);
+	for (const auto& Tag : PendingTags)
+	{
+		Size += Tag.Key.GetAllocatedSize() + (Tag.Value.IsSet() ? Tag.Value->GetAllocatedSize() : 0);
+	}
+
+	return Size;
+}
+
+void FSentryScopeBatch::Flush(ISentrySubsystem& Subsystem)
+{
+	TMap<FString, TOptional<FString>> Tags;
+	TMap<FString, TMap<FString, FSentryVariant>> Contexts;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		Tags = MoveTemp(PendingTags);
+		Contexts = MoveTemp(PendingContexts);
+		PendingTags.Reset();
+		PendingContexts.Reset();
+	}
+
+	TMap<FString, FString> TagsToSet;
+	TagsToSet.Reserve(Tags.Num());
+
+	for (const auto& Tag : Tags)
+	{
+		if (Tag.Value.IsSet())
+		{
+			TagsToSet.Add(Tag.Key, Tag.Value.GetValue());
+		}
+		else
+		{
+			Subsystem.RemoveTag(Tag.Key);
+		}
+	}
+
+	if (TagsToSet.Num() > 0)
+	{
+		Subsystem.SetTags(TagsToSet);
+	}
+
+	for (const auto& Context : Contexts)
+	{
+		Subsystem.SetContext(Context.Key, Context.Value);
+	}
+}
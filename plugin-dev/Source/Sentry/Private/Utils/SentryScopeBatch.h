@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include "SentryVariant.h"
+
+class ISentrySubsystem;
+
+/**
+ * Accumulates global scope changes (tags and contexts) so that frequent updates of the same keys are applied
+ * to the native SDK at most once per flush instead of on every call. Only the latest value of each key is kept.
+ */
+class FSentryScopeBatch
+{
+public:
+	void SetTag(const FString& Key, const FString& Value);
+	void RemoveTag(const FString& Key);
+	void SetContext(const FString& Key, const TMap<FString, FSentryVariant>& Values);
+
+	/** Checks whether there are changes waiting to be flushed. */
+	bool HasPendingChanges() const;
+
+	/** Memory held by the changes waiting to be flushed. */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Applies the accumulated changes to the native SDK. Safe to call from any thread. */
+	void Flush(ISentrySubsystem& Subsystem);
+
+private:
+	mutable FCriticalSection CriticalSection;
+
+	/** Pending tag values, unset if the tag was removed. */
+	TMap<FString, TOptional<FString>> PendingTags;
+	TMap<FString, TMap<FString, FSentryVariant>> PendingContexts;
+};
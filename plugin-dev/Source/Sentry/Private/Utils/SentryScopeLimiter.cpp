@@ -0,0 +1,200 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryScopeLimiter.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryScopeLimits
+{
+	static FThreadSafeCounter64 NumEvicted;
+
+	static int32 TrimMap(TMap<FString, FSentryVariant>& Values, int32 Depth, int32 MaxDepth, int32 MaxValues);
+
+	static int32 TrimArray(TArray<FSentryVariant>& Values, int32 Depth, int32 MaxDepth, int32 MaxValues);
+
+	/** Trims the value in place, returns -1 if the value itself has to be dropped. */
+	static int32 TrimValue(FSentryVariant& Value, int32 Depth, int32 MaxDepth, int32 MaxValues)
+	{
+		const ESentryVariantType Type = Value.GetType();
+		if (Type != ESentryVariantType::Array && Type != ESentryVariantType::Map)
+		{
+			return 0;
+		}
+
+		if (MaxDepth > 0 && Depth > MaxDepth)
+		{
+			return -1;
+		}
+
+		int32 NumTrimmed = 0;
+
+		if (Type == ESentryVariantType::Array)
+		{
+			TArray<FSentryVariant> Array = Value.GetValue<TArray<FSentryVariant>>();
+			NumTrimmed = TrimArray(Array, Depth + 1, MaxDepth, MaxValues);
+			if (NumTrimmed > 0)
+			{
+				Value = FSentryVariant(MoveTemp(Array));
+			}
+		}
+		else
+		{
+			TMap<FString, FSentryVariant> Map = Value.GetValue<TMap<FString, FSentryVariant>>();
+			NumTrimmed = TrimMap(Map, Depth + 1, MaxDepth, MaxValues);
+			if (NumTrimmed > 0)
+			{
+				Value = FSentryVariant(MoveTemp(Map));
+			}
+		}
+
+		return NumTrimmed;
+	}
+
+	static int32 TrimArray(TArray<FSentryVariant>& Values, int32 Depth, int32 MaxDepth, int32 MaxValues)
+	{
+		int32 NumTrimmed = 0;
+
+		if (MaxValues > 0 && Values.Num() > MaxValues)
+		{
+			NumTrimmed += Values.Num() - MaxValues;
+			Values.SetNum(MaxValues);
+		}
+
+		for (int32 Index = Values.Num() - 1; Index >= 0; --Index)
+		{
+			const int32 NumValueTrimmed = TrimValue(Values[Index], Depth, MaxDepth, MaxValues);
+			if (NumValueTrimmed < 0)
+			{
+				Values.RemoveAt(Index);
+				++NumTrimmed;
+			}
+			else
+			{
+				NumTrimmed += NumValueTrimmed;
+			}
+		}
+
+		return NumTrimmed;
+	}
+
+	static int32 TrimMap(TMap<FString, FSentryVariant>& Values, int32 Depth, int32 MaxDepth, int32 MaxValues)
+	{
+		int32 NumTrimmed = 0;
+		int32 NumKept = 0;
+
+		for (auto It = Values.CreateIterator(); It; ++It)
+		{
+			if (MaxValues > 0 && NumKept >= MaxValues)
+			{
+				It.RemoveCurrent();
+				++NumTrimmed;
+				continue;
+			}
+
+			const int32 NumValueTrimmed = TrimValue(It.Value(), Depth, MaxDepth, MaxValues);
+			if (NumValueTrimmed < 0)
+			{
+				It.RemoveCurrent();
+				++NumTrimmed;
+				continue;
+			}
+
+			NumTrimmed += NumValueTrimmed;
+			++NumKept;
+		}
+
+		return NumTrimmed;
+	}
+
+	int64 GetNumEvicted()
+	{
+		return NumEvicted.GetValue();
+	}
+
+	void RecordEvicted(int32 Num)
+	{
+		// Dropped scope data is easy to miss on the dashboard, so the first time it happens is logged loudly
+		if (NumEvicted.Add(Num) == 0)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Scope limits were exceeded and scope data was dropped. Raise the limits in the Scope Limits settings if it's needed."));
+		}
+	}
+
+	int32 TrimContext(TMap<FString, FSentryVariant>& Values, int32 MaxDepth, int32 MaxValues)
+	{
+		if (MaxDepth <= 0 && MaxValues <= 0)
+		{
+			return 0;
+		}
+
+		const int32 NumTrimmed = TrimMap(Values, 1, MaxDepth, MaxValues);
+		if (NumTrimmed > 0)
+		{
+			RecordEvicted(NumTrimmed);
+		}
+
+		return NumTrimmed;
+	}
+}
+
+FSentryScopeKeyLimiter::FSentryScopeKeyLimiter(int32 InMaxNum)
+	: MaxNum(FMath::Max(0, InMaxNum))
+	, Counter(0)
+{
+}
+
+bool FSentryScopeKeyLimiter::Touch(const FString& Key, FString& OutEvictedKey)
+{
+	if (!IsEnabled())
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	LastSet.Add(Key, ++Counter);
+
+	if (LastSet.Num() <= MaxNum)
+	{
+		return false;
+	}
+
+	// Eviction only happens when the limit is hit so a linear search is cheaper than maintaining an ordered structure on every set
+	const TPair<FString, uint64>* Oldest = nullptr;
+	for (const auto& Item : LastSet)
+	{
+		if (!Oldest || Item.Value < Oldest->Value)
+		{
+			Oldest = &Item;
+		}
+	}
+
+	OutEvictedKey = Oldest->Key;
+	LastSet.Remove(OutEvictedKey);
+
+	UE_LOG(LogSentrySdk, Verbose, TEXT("Scope key '%s' evicted to stay within the limit of %d."), *OutEvictedKey, MaxNum);
+
+	SentryScopeLimits::RecordEvicted(1);
+
+	return true;
+}
+
+void FSentryScopeKeyLimiter::Remove(const FString& Key)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	LastSet.Remove(Key);
+}
+
+void FSentryScopeKeyLimiter::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+	LastSet.Empty();
+}
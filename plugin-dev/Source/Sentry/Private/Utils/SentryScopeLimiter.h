@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include "SentryVariant.h"
+
+/**
+ * Keeps a keyed scope collection (tags, extras or contexts) within a fixed number of entries.
+ *
+ * Remembers when each key was last set and, once a new key would exceed the limit, picks the least recently set one
+ * to be evicted by the owner of the collection. Every evicted key is counted in `SentryScopeLimits::GetNumEvicted`.
+ */
+class FSentryScopeKeyLimiter
+{
+public:
+	/** @param InMaxNum Max amount of keys in the collection, 0 for no limit. */
+	explicit FSentryScopeKeyLimiter(int32 InMaxNum);
+
+	/** Checks whether the limit is configured. */
+	bool IsEnabled() const { return MaxNum > 0; }
+
+	/**
+	 * Records that the key was set. Safe to call from any thread.
+	 *
+	 * @param OutEvictedKey Key that has to be removed from the collection to stay within the limit, if any.
+	 * @return True if a key has to be evicted.
+	 */
+	bool Touch(const FString& Key, FString& OutEvictedKey);
+
+	/** Records that the key was removed from the collection. */
+	void Remove(const FString& Key);
+
+	/** Forgets all keys, e.g. when the collection is cleared. */
+	void Reset();
+
+private:
+	const int32 MaxNum;
+
+	FCriticalSection CriticalSection;
+	TMap<FString, uint64> LastSet;
+	uint64 Counter;
+};
+
+namespace SentryScopeLimits
+{
+	/** Total amount of scope entries evicted or trimmed because of the configured scope limits. */
+	int64 GetNumEvicted();
+
+	void RecordEvicted(int32 Num);
+
+	/**
+	 * Drops context entries exceeding the configured size limits.
+	 *
+	 * @param MaxDepth Max nesting of arrays and maps within the context, 0 for no limit. Containers nested deeper are dropped.
+	 * @param MaxValues Max amount of values in the context and in each of its nested containers, 0 for no limit.
+	 * @return Amount of dropped values.
+	 */
+	int32 TrimContext(TMap<FString, FSentryVariant>& Values, int32 MaxDepth, int32 MaxValues);
+}
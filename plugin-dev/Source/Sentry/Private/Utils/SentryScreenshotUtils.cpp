@@ -1,18 +1,609 @@
 // Copyright (c) 2025 Sentry. All Rights Reserved.
 
 #include "SentryScreenshotUtils.h"
+#include "Utils/SentryBackBufferCapture.h"
+#include "Utils/SentryRedactedWidgets.h"
 #include "SentryDefines.h"
+#include "SentryModule.h"
+#include "SentrySettings.h"
 
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "Engine/Engine.h"
 #include "Engine/GameViewportClient.h"
 #include "Framework/Application/SlateApplication.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
 #include "HighResScreenshot.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
 #include "ImageUtils.h"
 #include "Misc/EngineVersionComparison.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
 #include "UnrealClient.h"
 
+namespace SentryScreenshotQoi
+{
+	static constexpr uint8 OpIndex = 0x00;
+	static constexpr uint8 OpDiff = 0x40;
+	static constexpr uint8 OpLuma = 0x80;
+	static constexpr uint8 OpRun = 0xc0;
+	static constexpr uint8 OpRgb = 0xfe;
+	static constexpr uint8 OpRgba = 0xff;
+
+	static void WriteBigEndian(TArray<uint8>& Out, uint32 Value)
+	{
+		Out.Add(static_cast<uint8>(Value >> 24));
+		Out.Add(static_cast<uint8>(Value >> 16));
+		Out.Add(static_cast<uint8>(Value >> 8));
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	/** Encodes the bitmap following the QOI specification (https://qoiformat.org/qoi-specification.pdf). */
+	static void Encode(const TArray<FColor>& Pixels, int32 Width, int32 Height, TArray<uint8>& Out)
+	{
+		// Keeps the allocation so that reserved crash buffers are reused
+		Out.Reset();
+
+		Out.Append(reinterpret_cast<const uint8*>("qoif"), 4);
+		WriteBigEndian(Out, Width);
+		WriteBigEndian(Out, Height);
+		Out.Add(4); // RGBA channels
+		Out.Add(0); // sRGB with linear alpha
+
+		FColor Index[64];
+		FMemory::Memzero(Index, sizeof(Index));
+
+		FColor Previous(0, 0, 0, 255);
+		int32 Run = 0;
+
+		for (int32 PixelIndex = 0; PixelIndex < Pixels.Num(); ++PixelIndex)
+		{
+			const FColor& Pixel = Pixels[PixelIndex];
+
+			if (Pixel == Previous)
+			{
+				++Run;
+				if (Run == 62 || PixelIndex == Pixels.Num() - 1)
+				{
+					Out.Add(static_cast<uint8>(OpRun | (Run - 1)));
+					Run = 0;
+				}
+				continue;
+			}
+
+			if (Run > 0)
+			{
+				Out.Add(static_cast<uint8>(OpRun | (Run - 1)));
+				Run = 0;
+			}
+
+			const int32 HashIndex = (Pixel.R * 3 + Pixel.G * 5 + Pixel.B * 7 + Pixel.A * 11) % 64;
+
+			if (Index[HashIndex] == Pixel)
+			{
+				Out.Add(static_cast<uint8>(OpIndex | HashIndex));
+			}
+			else
+			{
+				Index[HashIndex] = Pixel;
+
+				if (Pixel.A == Previous.A)
+				{
+					const int8 DiffR = static_cast<int8>(Pixel.R - Previous.R);
+					const int8 DiffG = static_cast<int8>(Pixel.G - Previous.G);
+					const int8 DiffB = static_cast<int8>(Pixel.B - Previous.B);
+
+					const int8 DiffRG = static_cast<int8>(DiffR - DiffG);
+					const int8 DiffBG = static_cast<int8>(DiffB - DiffG);
+
+					if (DiffR > -3 && DiffR < 2 && DiffG > -3 && DiffG < 2 && DiffB > -3 && DiffB < 2)
+					{
+						Out.Add(static_cast<uint8>(OpDiff | (DiffR + 2) << 4 | (DiffG + 2) << 2 | (DiffB + 2)));
+					}
+					else if (DiffRG > -9 && DiffRG < 8 && DiffG > -33 && DiffG < 32 && DiffBG > -9 && DiffBG < 8)
+					{
+						Out.Add(static_cast<uint8>(OpLuma | (DiffG + 32)));
+						Out.Add(static_cast<uint8>((DiffRG + 8) << 4 | (DiffBG + 8)));
+					}
+					else
+					{
+						Out.Add(OpRgb);
+						Out.Add(Pixel.R);
+						Out.Add(Pixel.G);
+						Out.Add(Pixel.B);
+					}
+				}
+				else
+				{
+					Out.Add(OpRgba);
+					Out.Add(Pixel.R);
+					Out.Add(Pixel.G);
+					Out.Add(Pixel.B);
+					Out.Add(Pixel.A);
+				}
+			}
+
+			Previous = Pixel;
+		}
+
+		// End marker
+		static const uint8 Padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+		Out.Append(Padding, 8);
+	}
+}
+
+namespace SentryScreenshotBuffers
+{
+	/** Interval between refreshes of the latest backbuffer frame that crash screenshots are taken from. */
+	static constexpr float LatestFrameRefreshSeconds = 1.0f;
+
+	/** Buffers reserved up front so that capturing a screenshot in the crash handler doesn't have to allocate them. */
+	struct FCrashBuffers
+	{
+		TArray<FColor> Bitmap;
+		TArray<FColor> Downscaled;
+		TArray<uint8> Encoded;
+
+		FDelegateHandle ViewportResizedHandle;
+
+		/** Flag indicating whether the buffers are in use by a capture. */
+		FThreadSafeBool bInUse;
+	};
+
+	static FCrashBuffers& Get()
+	{
+		static FCrashBuffers Instance;
+		return Instance;
+	}
+
+	static FIntPoint GetDownscaledSize(int32 Width, int32 Height, int32 MaxDimension)
+	{
+		if (MaxDimension <= 0 || FMath::Max(Width, Height) <= MaxDimension)
+		{
+			return FIntPoint(Width, Height);
+		}
+
+		const float Scale = static_cast<float>(MaxDimension) / FMath::Max(Width, Height);
+		return FIntPoint(FMath::Max(1, FMath::RoundToInt(Width * Scale)), FMath::Max(1, FMath::RoundToInt(Height * Scale)));
+	}
+
+	static void Reserve(const FIntPoint& ViewportSize)
+	{
+		FCrashBuffers& Buffers = Get();
+		if (Buffers.bInUse)
+		{
+			return;
+		}
+
+		Buffers.Bitmap.Reserve(ViewportSize.X * ViewportSize.Y);
+
+		const FIntPoint DownscaledSize = GetDownscaledSize(ViewportSize.X, ViewportSize.Y, FSentryModule::Get().GetSettings()->ScreenshotMaxDimension);
+		if (DownscaledSize != ViewportSize)
+		{
+			Buffers.Downscaled.Reserve(DownscaledSize.X * DownscaledSize.Y);
+		}
+
+		// PNG and JPEG encoders manage their own memory, uncompressed size is plenty for a QOI image of a game frame
+		if (FSentryModule::Get().GetSettings()->ScreenshotFormat == ESentryScreenshotFormat::Qoi)
+		{
+			Buffers.Encoded.Reserve(DownscaledSize.X * DownscaledSize.Y * sizeof(FColor) + 22);
+		}
+	}
+
+	/**
+	 * Flips the bitmap upside down in a single pass.
+	 * Rows are swapped in chunks with memcpy which the platform vectorizes (NEON on Android) without allocating.
+	 */
+	static void FlipVertically(TArray<FColor>& Bitmap, int32 Width, int32 Height)
+	{
+		const SIZE_T RowSize = Width * sizeof(FColor);
+
+		uint8 Chunk[4096];
+
+		for (int32 Y = 0; Y < Height / 2; ++Y)
+		{
+			uint8* Top = reinterpret_cast<uint8*>(Bitmap.GetData() + Y * Width);
+			uint8* Bottom = reinterpret_cast<uint8*>(Bitmap.GetData() + (Height - 1 - Y) * Width);
+
+			for (SIZE_T Offset = 0; Offset < RowSize; Offset += sizeof(Chunk))
+			{
+				const SIZE_T Size = FMath::Min<SIZE_T>(sizeof(Chunk), RowSize - Offset);
+				FMemory::Memcpy(Chunk, Top + Offset, Size);
+				FMemory::Memcpy(Top + Offset, Bottom + Offset, Size);
+				FMemory::Memcpy(Bottom + Offset, Chunk, Size);
+			}
+		}
+	}
+
+	/** Nearest-neighbour downscale writing into the given buffer without reallocating it if it's large enough. */
+	static void Downscale(const TArray<FColor>& Src, int32 SrcWidth, int32 SrcHeight, int32 DstWidth, int32 DstHeight, TArray<FColor>& Dst)
+	{
+		Dst.Reset(DstWidth * DstHeight);
+		Dst.AddUninitialized(DstWidth * DstHeight);
+
+		for (int32 Y = 0; Y < DstHeight; ++Y)
+		{
+			const FColor* SrcRow = Src.GetData() + static_cast<int64>(Y) * SrcHeight / DstHeight * SrcWidth;
+			FColor* DstRow = Dst.GetData() + Y * DstWidth;
+
+			for (int32 X = 0; X < DstWidth; ++X)
+			{
+				DstRow[X] = SrcRow[static_cast<int64>(X) * SrcWidth / DstWidth];
+			}
+		}
+	}
+
+	/** Loads the module JPEG screenshots are encoded with, which has to happen on the game thread before encoding on other threads. */
+	static void LoadEncoderModule()
+	{
+		check(IsInGameThread());
+
+		if (FSentryModule::Get().GetSettings()->ScreenshotFormat == ESentryScreenshotFormat::Jpeg)
+		{
+			FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+		}
+	}
+}
+
+namespace SentryScreenshotCache
+{
+	/** Cached frames are downscaled at least to this size to keep the periodic encoding cheap. */
+	static constexpr int32 MaxDimension = 640;
+
+	/** Most recent successfully captured frame, already encoded in the format selected in plugin settings. */
+	struct FLastFrame
+	{
+		FCriticalSection CriticalSection;
+		TArray<uint8> Encoded;
+
+		/** Incremented whenever caching is started or stopped to invalidate pending ticks and encodes. */
+		int32 Generation = 0;
+
+		bool bIsActive = false;
+
+		/** Flag indicating whether the backbuffer capturing was started for the cache rather than for crash screenshots. */
+		bool bOwnsBackBufferCapture = false;
+
+		/** Flag indicating whether a captured frame is being encoded on a background thread. */
+		FThreadSafeBool bIsEncoding;
+	};
+
+	static FLastFrame& Get()
+	{
+		static FLastFrame Instance;
+		return Instance;
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	static FTicker& GetTicker() { return FTicker::GetCoreTicker(); }
+#else
+	static FTSTicker& GetTicker() { return FTSTicker::GetCoreTicker(); }
+#endif
+}
+
+void SentryScreenshotUtils::StartLastFrameCache(float IntervalSeconds)
+{
+	check(IsInGameThread());
+
+	SentryScreenshotCache::FLastFrame& LastFrame = SentryScreenshotCache::Get();
+
+	StopLastFrameCache();
+
+	// Frames are read back from the GPU asynchronously, re-rendering the window with Slate every interval would stall the game thread
+	if (!FSentryBackBufferCapture::Get().IsActive())
+	{
+		if (!FSentryBackBufferCapture::Get().Start(FSentryModule::Get().GetSettings()->ScreenshotIncludeUI, IntervalSeconds))
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Last frame screenshot caching requires backbuffer capturing which isn't available."));
+			return;
+		}
+
+		LastFrame.bOwnsBackBufferCapture = true;
+
+		if (GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport)
+		{
+			FSentryBackBufferCapture::Get().SetViewport(GEngine->GameViewport->Viewport, GEngine->GameViewport->GetWindow());
+		}
+	}
+
+	LastFrame.bIsActive = true;
+
+	const int32 Generation = LastFrame.Generation;
+
+	SentryScreenshotCache::GetTicker().AddTicker(FTickerDelegate::CreateLambda([Generation](float DeltaTime)
+	{
+		if (Generation != SentryScreenshotCache::Get().Generation)
+		{
+			return false;
+		}
+
+		CacheLastFrame(Generation);
+		return true;
+	}), FMath::Max(0.1f, IntervalSeconds));
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Last frame screenshot caching enabled with %.1f seconds interval."), IntervalSeconds);
+}
+
+void SentryScreenshotUtils::StopLastFrameCache()
+{
+	check(IsInGameThread());
+
+	SentryScreenshotCache::FLastFrame& LastFrame = SentryScreenshotCache::Get();
+
+	if (LastFrame.bOwnsBackBufferCapture)
+	{
+		FSentryBackBufferCapture::Get().Stop();
+		LastFrame.bOwnsBackBufferCapture = false;
+	}
+
+	FScopeLock Lock(&LastFrame.CriticalSection);
+
+	++LastFrame.Generation;
+	LastFrame.bIsActive = false;
+	LastFrame.Encoded.Empty();
+}
+
+bool SentryScreenshotUtils::IsLastFrameCacheActive()
+{
+	return SentryScreenshotCache::Get().bIsActive;
+}
+
+bool SentryScreenshotUtils::SaveLastFrame(const FString& ScreenshotSavePath)
+{
+	SentryScreenshotCache::FLastFrame& LastFrame = SentryScreenshotCache::Get();
+
+	// Crashed thread might be the one holding the lock so waiting for it isn't an option
+	if (!LastFrame.CriticalSection.TryLock())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Cached last frame screenshot is being updated and can't be saved"));
+		return false;
+	}
+
+	const bool bSaved = LastFrame.Encoded.Num() > 0 && FFileHelper::SaveArrayToFile(LastFrame.Encoded, *ScreenshotSavePath);
+
+	LastFrame.CriticalSection.Unlock();
+
+	if (!bSaved)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("No cached last frame screenshot could be saved to: %s"), *ScreenshotSavePath);
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Cached last frame screenshot saved to: %s"), *ScreenshotSavePath);
+
+	return true;
+}
+
+void SentryScreenshotUtils::CacheLastFrame(int32 Generation)
+{
+	SentryScreenshotCache::FLastFrame& LastFrame = SentryScreenshotCache::Get();
+
+	// Skip the frame rather than queueing encodes if the previous one is still in progress
+	if (LastFrame.bIsEncoding)
+	{
+		return;
+	}
+
+	// Nothing to capture yet (e.g. during loading), checked here to not log an error every interval
+	if (!GEngine || !GEngine->GameViewport || !GEngine->GameViewport->Viewport || !FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	const int32 SettingsMaxDimension = FSentryModule::Get().GetSettings()->ScreenshotMaxDimension;
+	const int32 MaxDimension = SettingsMaxDimension > 0 ? FMath::Min(SettingsMaxDimension, SentryScreenshotCache::MaxDimension) : SentryScreenshotCache::MaxDimension;
+
+	auto EncodeLastFrame = [MaxDimension, Generation](TSharedRef<TArray<FColor>, ESPMode::ThreadSafe> Bitmap, const FIntVector& ViewportSize)
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Bitmap, ViewportSize, MaxDimension, Generation]()
+		{
+			SentryScreenshotCache::FLastFrame& LastFrame = SentryScreenshotCache::Get();
+
+			TArray<FColor> Downscaled;
+			TArray<uint8> Encoded;
+
+			if (Encode(*Bitmap, ViewportSize, MaxDimension, Downscaled, Encoded))
+			{
+				FScopeLock Lock(&LastFrame.CriticalSection);
+
+				if (Generation == LastFrame.Generation)
+				{
+					LastFrame.Encoded = MoveTemp(Encoded);
+				}
+			}
+
+			LastFrame.bIsEncoding = false;
+		});
+	};
+
+	// Capturing was stopped by someone else (e.g. crash buffers were released), there's no cheap way to get a frame
+	if (!FSentryBackBufferCapture::Get().IsActive())
+	{
+		return;
+	}
+
+	LastFrame.bIsEncoding = true;
+
+	// Only downscaled pixels leave the render thread, encoding happens on a background thread as usual
+	FSentryBackBufferCapture::Get().RequestFrame([EncodeLastFrame, MaxDimension](bool bCaptured, const TArray<FColor>& Bitmap, const FIntPoint& Size)
+	{
+		if (!bCaptured)
+		{
+			SentryScreenshotCache::Get().bIsEncoding = false;
+			return;
+		}
+
+		const FIntPoint DownscaledSize = SentryScreenshotBuffers::GetDownscaledSize(Size.X, Size.Y, MaxDimension);
+
+		TSharedRef<TArray<FColor>, ESPMode::ThreadSafe> Downscaled = MakeShared<TArray<FColor>, ESPMode::ThreadSafe>();
+		SentryScreenshotBuffers::Downscale(Bitmap, Size.X, Size.Y, DownscaledSize.X, DownscaledSize.Y, *Downscaled);
+
+		EncodeLastFrame(Downscaled, FIntVector(DownscaledSize.X, DownscaledSize.Y, 0));
+	});
+}
+
+void SentryScreenshotUtils::ReserveCrashBuffers()
+{
+	check(IsInGameThread());
+
+	SentryScreenshotBuffers::FCrashBuffers& Buffers = SentryScreenshotBuffers::Get();
+
+	SentryScreenshotBuffers::LoadEncoderModule();
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	if (Settings->ScreenshotSource == ESentryScreenshotSource::BackBuffer && !FSentryBackBufferCapture::Get().IsActive())
+	{
+		FSentryBackBufferCapture::Get().Start(Settings->ScreenshotIncludeUI, SentryScreenshotBuffers::LatestFrameRefreshSeconds);
+	}
+
+	if (!Buffers.ViewportResizedHandle.IsValid())
+	{
+		Buffers.ViewportResizedHandle = FViewport::ViewportResizedEvent.AddLambda([](FViewport* Viewport, uint32)
+		{
+			if (Viewport && GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport == Viewport)
+			{
+				SentryScreenshotBuffers::Reserve(Viewport->GetSizeXY());
+				FSentryBackBufferCapture::Get().SetViewport(Viewport, GEngine->GameViewport->GetWindow());
+			}
+		});
+	}
+
+	// Viewport might not exist yet in which case buffers are reserved once it's created and resized for the first time
+	if (GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport)
+	{
+		SentryScreenshotBuffers::Reserve(GEngine->GameViewport->Viewport->GetSizeXY());
+		FSentryBackBufferCapture::Get().SetViewport(GEngine->GameViewport->Viewport, GEngine->GameViewport->GetWindow());
+	}
+}
+
+void SentryScreenshotUtils::ReleaseCrashBuffers()
+{
+	check(IsInGameThread());
+
+	SentryScreenshotBuffers::FCrashBuffers& Buffers = SentryScreenshotBuffers::Get();
+
+	FViewport::ViewportResizedEvent.Remove(Buffers.ViewportResizedHandle);
+	Buffers.ViewportResizedHandle.Reset();
+
+	FSentryBackBufferCapture::Get().Stop();
+
+	Buffers.Bitmap.Empty();
+	Buffers.Downscaled.Empty();
+	Buffers.Encoded.Empty();
+}
+
 bool SentryScreenshotUtils::CaptureScreenshot(const FString& ScreenshotSavePath)
+{
+	SentryScreenshotBuffers::FCrashBuffers& Buffers = SentryScreenshotBuffers::Get();
+
+	// Buffers are shared so a concurrent capture falls back to temporary ones
+	if (!Buffers.bInUse.AtomicSet(true))
+	{
+		FIntVector ViewportSize;
+
+		const bool bSaved = ReadPixels(Buffers.Bitmap, ViewportSize)
+			&& CompressAndSave(Buffers.Bitmap, ViewportSize, ScreenshotSavePath, Buffers.Downscaled, Buffers.Encoded);
+
+		// Keep the allocations for the next capture
+		Buffers.Bitmap.Reset();
+		Buffers.Downscaled.Reset();
+		Buffers.Encoded.Reset();
+
+		Buffers.bInUse = false;
+
+		return bSaved;
+	}
+
+	TArray<FColor> Bitmap;
+	TArray<FColor> Downscaled;
+	TArray<uint8> Encoded;
+	FIntVector ViewportSize;
+
+	if (!ReadPixels(Bitmap, ViewportSize))
+	{
+		return false;
+	}
+
+	return CompressAndSave(Bitmap, ViewportSize, ScreenshotSavePath, Downscaled, Encoded);
+}
+
+void SentryScreenshotUtils::CaptureScreenshotAsync(const FString& ScreenshotSavePath, TFunction<void(bool)> OnCompleted)
+{
+	SentryScreenshotBuffers::LoadEncoderModule();
+
+	if (FSentryBackBufferCapture::Get().IsActive())
+	{
+		FSentryBackBufferCapture::Get().RequestFrame([ScreenshotSavePath, OnCompleted](bool bCaptured, const TArray<FColor>& Bitmap, const FIntPoint& Size)
+		{
+			if (!bCaptured)
+			{
+				AsyncTask(ENamedThreads::GameThread, [OnCompleted]()
+				{
+					OnCompleted(false);
+				});
+				return;
+			}
+
+			TSharedRef<TArray<FColor>, ESPMode::ThreadSafe> FrameBitmap = MakeShared<TArray<FColor>, ESPMode::ThreadSafe>(Bitmap);
+			const FIntVector FrameSize(Size.X, Size.Y, 0);
+
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [FrameBitmap, FrameSize, ScreenshotSavePath, OnCompleted]()
+			{
+				TArray<FColor> Downscaled;
+				TArray<uint8> Encoded;
+
+				const bool bSaved = CompressAndSave(*FrameBitmap, FrameSize, ScreenshotSavePath, Downscaled, Encoded);
+
+				AsyncTask(ENamedThreads::GameThread, [OnCompleted, bSaved]()
+				{
+					OnCompleted(bSaved);
+				});
+			});
+		});
+		return;
+	}
+
+	TSharedRef<TArray<FColor>, ESPMode::ThreadSafe> Bitmap = MakeShared<TArray<FColor>, ESPMode::ThreadSafe>();
+	FIntVector ViewportSize;
+
+	if (!ReadViewportPixels(*Bitmap, ViewportSize))
+	{
+		OnCompleted(false);
+		return;
+	}
+
+	// Compression of large bitmaps takes tens of milliseconds so keep it off the game thread
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Bitmap, ViewportSize, ScreenshotSavePath, OnCompleted]()
+	{
+		TArray<FColor> Downscaled;
+		TArray<uint8> Encoded;
+
+		const bool bSaved = CompressAndSave(*Bitmap, ViewportSize, ScreenshotSavePath, Downscaled, Encoded);
+
+		AsyncTask(ENamedThreads::GameThread, [OnCompleted, bSaved]()
+		{
+			OnCompleted(bSaved);
+		});
+	});
+}
+
+bool SentryScreenshotUtils::ReadPixels(TArray<FColor>& OutBitmap, FIntVector& OutSize)
+{
+	FIntPoint FrameSize;
+	if (FSentryBackBufferCapture::Get().IsActive() && FSentryBackBufferCapture::Get().CopyLatestFrame(OutBitmap, FrameSize))
+	{
+		OutSize = FIntVector(FrameSize.X, FrameSize.Y, 0);
+		return true;
+	}
+
+	// Nothing was presented yet, Slate re-render is only possible on the game or Slate thread
+	return ReadViewportPixels(OutBitmap, OutSize);
+}
+
+bool SentryScreenshotUtils::ReadViewportPixels(TArray<FColor>& OutBitmap, FIntVector& OutSize)
 {
 	if (!GEngine || !GEngine->GameViewport)
 	{
@@ -29,9 +620,6 @@ bool SentryScreenshotUtils::CaptureScreenshot(const FString& ScreenshotSavePath)
 
 	FIntVector ViewportSize(GameViewportClient->Viewport->GetSizeXY().X, GameViewportClient->Viewport->GetSizeXY().Y, 0);
 
-	TArray<FColor>* Bitmap = new TArray<FColor>();
-	Bitmap->SetNumZeroed(ViewportSize.X * ViewportSize.Y);
-
 	if (!FSlateApplication::IsInitialized())
 	{
 		UE_LOG(LogSentrySdk, Error, TEXT("Slate application required for screenshot capturing is not initialized"));
@@ -44,56 +632,153 @@ bool SentryScreenshotUtils::CaptureScreenshot(const FString& ScreenshotSavePath)
 		return false;
 	}
 
+	// Reset keeps the allocation of reserved buffers
+	OutBitmap.Reset();
+	OutBitmap.SetNumZeroed(ViewportSize.X * ViewportSize.Y);
+
 	TSharedPtr<SWindow> WindowPtr = GameViewportClient->GetWindow();
 	TSharedRef<SWidget> WindowRef = WindowPtr.ToSharedRef();
 
-	bool bScreenshotSuccessful = FSlateApplication::Get().TakeScreenshot(WindowRef, *Bitmap, ViewportSize);
+	bool bScreenshotSuccessful = FSlateApplication::Get().TakeScreenshot(WindowRef, OutBitmap, ViewportSize);
 	if (!bScreenshotSuccessful)
 	{
 		UE_LOG(LogSentrySdk, Error, TEXT("Failed to capture screenshot"));
 		return false;
 	}
 
+	OutSize = ViewportSize;
+
 #if PLATFORM_ANDROID
 	FString RHIName = GDynamicRHI ? GDynamicRHI->GetName() : TEXT("Unknown");
 	if (RHIName.Contains(TEXT("OpenGL")))
 	{
-		UE_LOG(LogSentrySdk, Log, TEXT("Applying OpenGL flip/mirror correction for captured screenshot"));
-
-		Algo::Reverse(*Bitmap);
+		UE_LOG(LogSentrySdk, Verbose, TEXT("Applying OpenGL flip correction for captured screenshot"));
 
-		for (int32 Y = 0; Y < ViewportSize.Y; ++Y)
-		{
-			int32 RowStart = Y * ViewportSize.X;
-			int32 RowEnd = RowStart + ViewportSize.X - 1;
-			for (int32 X = 0; X < ViewportSize.X / 2; ++X)
-			{
-				Swap((*Bitmap)[RowStart + X], (*Bitmap)[RowEnd - X]);
-			}
-		}
+		SentryScreenshotBuffers::FlipVertically(OutBitmap, ViewportSize.X, ViewportSize.Y);
 	}
 	else
 	{
-		UE_LOG(LogSentrySdk, Log, TEXT("No flip/mirror correction required captured screenshot (Vulkan or other RHI)"));
+		UE_LOG(LogSentrySdk, Verbose, TEXT("No flip/mirror correction required captured screenshot (Vulkan or other RHI)"));
 	}
 #endif
 
+	// Slate re-renders the window including the redacted widgets, so they're cleared from the pixels here
+	if (!FSentryRedactedWidgets::Get().Apply(WindowPtr.Get(), OutBitmap, FIntPoint(ViewportSize.X, ViewportSize.Y)))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Redacted widgets can't be cleared from the screenshot, it's discarded."));
+		return false;
+	}
+
+	// High-res screenshot config is owned by the game thread so the mask is merged before handing the bitmap over
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
-	GetHighResScreenshotConfig().MergeMaskIntoAlpha(*Bitmap);
-	TArray<uint8>* CompressedBitmap = new TArray<uint8>();
-	FImageUtils::CompressImageArray(ViewportSize.X, ViewportSize.Y, *Bitmap, *CompressedBitmap);
+	GetHighResScreenshotConfig().MergeMaskIntoAlpha(OutBitmap);
 #else
-	GetHighResScreenshotConfig().MergeMaskIntoAlpha(*Bitmap, FIntRect());
-	TArray64<uint8>* CompressedBitmap = new TArray64<uint8>();
-	FImageUtils::PNGCompressImageArray(ViewportSize.X, ViewportSize.Y, *Bitmap, *CompressedBitmap);
+	GetHighResScreenshotConfig().MergeMaskIntoAlpha(OutBitmap, FIntRect());
 #endif
 
-	FFileHelper::SaveArrayToFile(*CompressedBitmap, *ScreenshotSavePath);
+	return true;
+}
+
+FString SentryScreenshotUtils::GetScreenshotExtension()
+{
+	switch (FSentryModule::Get().GetSettings()->ScreenshotFormat)
+	{
+	case ESentryScreenshotFormat::Jpeg:
+		return TEXT("jpg");
+	case ESentryScreenshotFormat::Qoi:
+		return TEXT("qoi");
+	default:
+		return TEXT("png");
+	}
+}
+
+FString SentryScreenshotUtils::GetScreenshotContentType()
+{
+	switch (FSentryModule::Get().GetSettings()->ScreenshotFormat)
+	{
+	case ESentryScreenshotFormat::Jpeg:
+		return TEXT("image/jpeg");
+	case ESentryScreenshotFormat::Qoi:
+		return TEXT("image/qoi");
+	default:
+		return TEXT("image/png");
+	}
+}
 
-	delete Bitmap;
-	delete CompressedBitmap;
+bool SentryScreenshotUtils::CompressAndSave(const TArray<FColor>& Bitmap, const FIntVector& Size, const FString& ScreenshotSavePath, TArray<FColor>& DownscaleBuffer, TArray<uint8>& EncodeBuffer)
+{
+	const bool bSaved = Encode(Bitmap, Size, FSentryModule::Get().GetSettings()->ScreenshotMaxDimension, DownscaleBuffer, EncodeBuffer)
+		&& FFileHelper::SaveArrayToFile(EncodeBuffer, *ScreenshotSavePath);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to save screenshot to: %s"), *ScreenshotSavePath);
+		return false;
+	}
 
 	UE_LOG(LogSentrySdk, Log, TEXT("Screenshot saved to: %s"), *ScreenshotSavePath);
 
 	return true;
 }
+
+bool SentryScreenshotUtils::Encode(const TArray<FColor>& Bitmap, const FIntVector& Size, int32 MaxDimension, TArray<FColor>& DownscaleBuffer, TArray<uint8>& OutEncoded)
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	const TArray<FColor>* Pixels = &Bitmap;
+	int32 Width = Size.X;
+	int32 Height = Size.Y;
+
+	const FIntPoint DownscaledSize = SentryScreenshotBuffers::GetDownscaledSize(Width, Height, MaxDimension);
+	if (DownscaledSize.X != Width || DownscaledSize.Y != Height)
+	{
+		SentryScreenshotBuffers::Downscale(Bitmap, Width, Height, DownscaledSize.X, DownscaledSize.Y, DownscaleBuffer);
+
+		Pixels = &DownscaleBuffer;
+		Width = DownscaledSize.X;
+		Height = DownscaledSize.Y;
+	}
+
+	switch (Settings->ScreenshotFormat)
+	{
+	case ESentryScreenshotFormat::Jpeg:
+	{
+		// Module is loaded up front on the game thread since loading it here could happen on any thread
+		IImageWrapperModule* ImageWrapperModule = FModuleManager::GetModulePtr<IImageWrapperModule>(TEXT("ImageWrapper"));
+		if (!ImageWrapperModule)
+		{
+			return false;
+		}
+
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule->CreateImageWrapper(EImageFormat::JPEG);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Pixels->GetData(), Pixels->Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+		{
+			return false;
+		}
+
+		const auto& CompressedBitmap = ImageWrapper->GetCompressed(FMath::Clamp(Settings->ScreenshotJpegQuality, 1, 100));
+		OutEncoded.Reset();
+		OutEncoded.Append(CompressedBitmap.GetData(), static_cast<int32>(CompressedBitmap.Num()));
+		break;
+	}
+	case ESentryScreenshotFormat::Qoi:
+	{
+		SentryScreenshotQoi::Encode(*Pixels, Width, Height, OutEncoded);
+		break;
+	}
+	default:
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		FImageUtils::CompressImageArray(Width, Height, *Pixels, OutEncoded);
+#else
+		TArray64<uint8> CompressedBitmap;
+		FImageUtils::PNGCompressImageArray(Width, Height, *Pixels, CompressedBitmap);
+		OutEncoded.Reset();
+		OutEncoded.Append(CompressedBitmap.GetData(), static_cast<int32>(CompressedBitmap.Num()));
+#endif
+		break;
+	}
+	}
+
+	return OutEncoded.Num() > 0;
+}
@@ -7,5 +7,71 @@
 class SentryScreenshotUtils
 {
 public:
+	/**
+	 * Captures a screenshot of the game viewport and saves it right away. Used by crash handlers.
+	 * With backbuffer capturing active the latest presented frame is saved without re-rendering the window.
+	 */
 	static bool CaptureScreenshot(const FString& ScreenshotSavePath);
+
+	/**
+	 * Captures a screenshot of the game viewport without blocking the game thread on compression.
+	 * Only the pixel copy happens on the calling thread while compression and writing run on a background task.
+	 *
+	 * @param OnCompleted Called on the game thread once the screenshot was saved or failed to be saved.
+	 */
+	static void CaptureScreenshotAsync(const FString& ScreenshotSavePath, TFunction<void(bool)> OnCompleted);
+
+	/**
+	 * Reserves the buffers used by CaptureScreenshot for the game viewport size and keeps them in sync with viewport resizes,
+	 * so that a capture in the crash handler doesn't have to allocate the bitmap and (for QOI) the encoded image.
+	 * Also starts capturing the presented frames if screenshots are taken from the backbuffer.
+	 */
+	static void ReserveCrashBuffers();
+
+	/** Releases the buffers reserved by ReserveCrashBuffers and stops capturing the presented frames. */
+	static void ReleaseCrashBuffers();
+
+	/**
+	 * Starts periodically capturing a low-resolution frame of the game viewport and keeping it encoded in memory,
+	 * so that crash handlers can save it without touching the GPU or Slate (e.g. when the render thread crashed).
+	 * Frames are read back asynchronously from the backbuffer, which is captured for as long as the cache is active.
+	 */
+	static void StartLastFrameCache(float IntervalSeconds);
+
+	/** Stops capturing frames and discards the cached one. */
+	static void StopLastFrameCache();
+
+	/** Checks whether the last frame screenshot caching is active. */
+	static bool IsLastFrameCacheActive();
+
+	/** Writes the cached frame to disk. Safe to call from crash handlers on any thread. */
+	static bool SaveLastFrame(const FString& ScreenshotSavePath);
+
+	/** Gets the file extension of screenshots in the format selected in plugin settings (without the dot). */
+	static FString GetScreenshotExtension();
+
+	/** Gets the MIME type of screenshots in the format selected in plugin settings. */
+	static FString GetScreenshotContentType();
+
+private:
+	/** Copies the latest presented frame into the bitmap, or the game viewport pixels if there's none. */
+	static bool ReadPixels(TArray<FColor>& OutBitmap, FIntVector& OutSize);
+
+	/** Copies the game viewport pixels into the bitmap. Has to be called on the game or Slate thread. */
+	static bool ReadViewportPixels(TArray<FColor>& OutBitmap, FIntVector& OutSize);
+
+	/** Requests the next presented frame and encodes it on a background thread into the last frame cache. */
+	static void CacheLastFrame(int32 Generation);
+
+	/**
+	 * Downscales and encodes the bitmap in the format selected in plugin settings. Safe to call from any thread.
+	 * The downscaled image is written to the given buffer which isn't reallocated if it's large enough.
+	 */
+	static bool Encode(const TArray<FColor>& Bitmap, const FIntVector& Size, int32 MaxDimension, TArray<FColor>& DownscaleBuffer, TArray<uint8>& OutEncoded);
+
+	/**
+	 * Downscales, compresses the bitmap in the format selected in plugin settings and writes it to disk. Safe to call from any thread.
+	 * Intermediate results are written to the given buffers which aren't reallocated if they are large enough.
+	 */
+	static bool CompressAndSave(const TArray<FColor>& Bitmap, const FIntVector& Size, const FString& ScreenshotSavePath, TArray<FColor>& DownscaleBuffer, TArray<uint8>& EncodeBuffer);
 };
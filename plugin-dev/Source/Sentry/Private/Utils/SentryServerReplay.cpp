@@ -0,0 +1,333 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryServerReplay.h"
+
+#include "SentryDefines.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/DemoNetDriver.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryServerReplay
+{
+	/** Interval between checks of the segment duration and size. */
+	static constexpr float TickInterval = 1.0f;
+
+	/** Shortest segment, rotating more often makes the checkpoints dominate the replay. */
+	static constexpr float MinSegmentSeconds = 10.0f;
+
+	static const TCHAR* CheckpointDelayVariable = TEXT("demo.CheckpointUploadDelayInSeconds");
+}
+
+FSentryServerReplay& FSentryServerReplay::Get()
+{
+	static FSentryServerReplay Instance;
+	return Instance;
+}
+
+bool FSentryServerReplay::Start(const FSentryServerReplayConfig& InConfig)
+{
+	check(IsInGameThread());
+
+	if (!IsRunningDedicatedServer())
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Server replay is only recorded on dedicated servers."));
+		return false;
+	}
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	Config = InConfig;
+	Config.DurationSeconds = FMath::Max(Config.DurationSeconds, 2.0f * SentryServerReplay::MinSegmentSeconds);
+	Config.CheckpointIntervalSeconds = FMath::Max(Config.CheckpointIntervalSeconds, 1.0f);
+	Config.MaxSizeMB = FMath::Max(Config.MaxSizeMB, 4);
+
+	// Checkpoints are what makes recording expensive, the default interval is tuned for seeking rather than overhead.
+	// Console variable applies to every replay so the game's own value is restored once recording stops.
+	if (IConsoleVariable* CheckpointDelay = IConsoleManager::Get().FindConsoleVariable(SentryServerReplay::CheckpointDelayVariable))
+	{
+		PreviousCheckpointDelay = CheckpointDelay->GetString();
+		CheckpointDelay->Set(Config.CheckpointIntervalSeconds, ECVF_SetByCode);
+	}
+
+	// Copies that weren't sent before the previous session ended would never be cleaned up otherwise
+	IFileManager::Get().DeleteDirectory(*GetSnapshotsDirectory(), false, true);
+
+	{
+		FScopeLock Lock(&SegmentsCriticalSection);
+		FinishedSlots.Reset();
+		CurrentSlot = INDEX_NONE;
+	}
+
+	NextSlot = 0;
+
+	bIsActive = true;
+
+	const uint32 Serial = ++StartSerial;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Serial](float DeltaTime)
+	{
+		if (!bIsActive || StartSerial != Serial)
+		{
+			return false;
+		}
+
+		Tick();
+		return true;
+	}), SentryServerReplay::TickInterval);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Server replay enabled: last %.0f seconds, checkpoint every %.0f seconds, up to %d MB."),
+		Config.DurationSeconds, Config.CheckpointIntervalSeconds, Config.MaxSizeMB);
+
+	return true;
+}
+
+void FSentryServerReplay::Stop()
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	if (CurrentSlot != INDEX_NONE)
+	{
+		if (UGameInstance* GameInstance = GetGameInstance())
+		{
+			GameInstance->StopRecordingReplay();
+		}
+
+		FinishSegment();
+	}
+
+	if (!PreviousCheckpointDelay.IsEmpty())
+	{
+		if (IConsoleVariable* CheckpointDelay = IConsoleManager::Get().FindConsoleVariable(SentryServerReplay::CheckpointDelayVariable))
+		{
+			CheckpointDelay->Set(*PreviousCheckpointDelay, ECVF_SetByCode);
+		}
+
+		PreviousCheckpointDelay.Reset();
+	}
+}
+
+bool FSentryServerReplay::GetSegments(TArray<FString>& OutPaths) const
+{
+	// Crashed thread might be the one holding the lock so waiting for it isn't an option
+	if (!SegmentsCriticalSection.TryLock())
+	{
+		return false;
+	}
+
+	for (int32 Slot : FinishedSlots)
+	{
+		OutPaths.Add(FPaths::Combine(GetReplayDirectory(), GetSegmentName(Slot) + TEXT(".replay")));
+	}
+
+	if (CurrentSlot != INDEX_NONE)
+	{
+		OutPaths.Add(FPaths::Combine(GetReplayDirectory(), GetSegmentName(CurrentSlot) + TEXT(".replay")));
+	}
+
+	SegmentsCriticalSection.Unlock();
+
+	return OutPaths.Num() > 0;
+}
+
+FString FSentryServerReplay::GetReplayDirectory()
+{
+	// Default save path of the local file replay streamer
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Demos"));
+}
+
+FString FSentryServerReplay::GetSnapshotsDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryServerReplays"));
+}
+
+void FSentryServerReplay::TrimSnapshots(int64 NewSnapshotsSize) const
+{
+	struct FSnapshotFile
+	{
+		FString Path;
+		FDateTime Timestamp;
+		int64 Size;
+	};
+
+	TArray<FSnapshotFile> Snapshots;
+	int64 TotalSize = NewSnapshotsSize;
+
+	IFileManager::Get().IterateDirectoryStat(*GetSnapshotsDirectory(), [&Snapshots, &TotalSize](const TCHAR* Path, const FFileStatData& StatData)
+	{
+		if (!StatData.bIsDirectory)
+		{
+			Snapshots.Add({ Path, StatData.ModificationTime, StatData.FileSize });
+			TotalSize += StatData.FileSize;
+		}
+		return true;
+	});
+
+	Snapshots.Sort([](const FSnapshotFile& A, const FSnapshotFile& B) { return A.Timestamp < B.Timestamp; });
+
+	const int64 MaxSize = static_cast<int64>(Config.MaxSizeMB) * 1024 * 1024;
+
+	int32 NumDeleted = 0;
+	for (const FSnapshotFile& Snapshot : Snapshots)
+	{
+		if (TotalSize <= MaxSize)
+		{
+			break;
+		}
+
+		if (IFileManager::Get().Delete(*Snapshot.Path, false, true, true))
+		{
+			TotalSize -= Snapshot.Size;
+			++NumDeleted;
+		}
+	}
+
+	if (NumDeleted > 0)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Cleaned up %d old server replay copies."), NumDeleted);
+	}
+}
+
+void FSentryServerReplay::Tick()
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	UWorld* World = GameInstance ? GameInstance->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	const UDemoNetDriver* DemoNetDriver = World->GetDemoNetDriver();
+	const bool bIsRecording = DemoNetDriver && DemoNetDriver->IsRecording();
+
+	if (CurrentSlot == INDEX_NONE)
+	{
+		// Waiting for the server to start listening, or for another replay to stop
+		if (!DemoNetDriver && World->GetNetDriver())
+		{
+			StartSegment();
+		}
+
+		return;
+	}
+
+	if (!bIsRecording)
+	{
+		// Map changes tear down the demo net driver along with the world, the next segment starts once the new one listens
+		FinishSegment();
+		return;
+	}
+
+	const double SegmentSeconds = FMath::Max(SentryServerReplay::MinSegmentSeconds, Config.DurationSeconds / 2.0f);
+	const int64 SegmentMaxSize = static_cast<int64>(Config.MaxSizeMB) * 1024 * 1024 / NumSegmentSlots;
+
+	const FString SegmentPath = FPaths::Combine(GetReplayDirectory(), GetSegmentName(CurrentSlot) + TEXT(".replay"));
+
+	if (FPlatformTime::Seconds() - SegmentStartTime >= SegmentSeconds || IFileManager::Get().FileSize(*SegmentPath) >= SegmentMaxSize)
+	{
+		GameInstance->StopRecordingReplay();
+
+		FinishSegment();
+		StartSegment();
+	}
+}
+
+bool FSentryServerReplay::StartSegment()
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	if (!GameInstance)
+	{
+		return false;
+	}
+
+	const int32 Slot = NextSlot;
+	NextSlot = (NextSlot + 1) % NumSegmentSlots;
+
+	{
+		// Slot is about to be overwritten so it can't be attached anymore
+		FScopeLock Lock(&SegmentsCriticalSection);
+		FinishedSlots.Remove(Slot);
+	}
+
+	// Segment of a previous session would be mistaken for this one if recording fails to start
+	IFileManager::Get().Delete(*FPaths::Combine(GetReplayDirectory(), GetSegmentName(Slot) + TEXT(".replay")), false, true, true);
+
+	TArray<FString> AdditionalOptions;
+	AdditionalOptions.Add(TEXT("ReplayStreamerOverride=LocalFileNetworkReplayStreaming"));
+
+	GameInstance->StartRecordingReplay(GetSegmentName(Slot), GetSegmentName(Slot), AdditionalOptions);
+
+	{
+		FScopeLock Lock(&SegmentsCriticalSection);
+		CurrentSlot = Slot;
+	}
+
+	SegmentStartTime = FPlatformTime::Seconds();
+
+	return true;
+}
+
+void FSentryServerReplay::FinishSegment()
+{
+	if (CurrentSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	const bool bHasSegment = IFileManager::Get().FileExists(*FPaths::Combine(GetReplayDirectory(), GetSegmentName(CurrentSlot) + TEXT(".replay")));
+
+	FScopeLock Lock(&SegmentsCriticalSection);
+
+	if (bHasSegment)
+	{
+		FinishedSlots.Add(CurrentSlot);
+	}
+
+	CurrentSlot = INDEX_NONE;
+}
+
+UGameInstance* FSentryServerReplay::GetGameInstance()
+{
+	if (!GEngine)
+	{
+		return nullptr;
+	}
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (Context.WorldType == EWorldType::Game && Context.OwningGameInstance)
+		{
+			return Context.OwningGameInstance;
+		}
+	}
+
+	return nullptr;
+}
+
+FString FSentryServerReplay::GetSegmentName(int32 Slot)
+{
+	return FString::Printf(TEXT("sentry_server_replay_%d"), Slot);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+
+class UGameInstance;
+
+/** Settings of the server replay recording. */
+struct FSentryServerReplayConfig
+{
+	/** Seconds of the match that the finished segments cover. */
+	float DurationSeconds = 60.0f;
+
+	/** Interval between replay checkpoints, longer intervals are cheaper to record. */
+	float CheckpointIntervalSeconds = 30.0f;
+
+	/** Max size of all segments on disk in megabytes. */
+	int32 MaxSizeMB = 64;
+};
+
+/**
+ * Rolling network replay of the last match seconds on dedicated servers, which have no viewport to record a crash video of.
+ *
+ * Records the server's view of the match with the demo net driver into a ring of replay segments streamed to disk by
+ * the local file replay streamer, so memory usage stays flat no matter how long the match runs. A new segment is started
+ * once the current one covers half the duration or a third of the size budget. The streamer flushes the segment being
+ * recorded to disk periodically, so at crash time the segments only have to be attached and nothing is serialized.
+ */
+class FSentryServerReplay
+{
+public:
+	static FSentryServerReplay& Get();
+
+	/** Starts recording replay segments, only on dedicated servers. Called on the game thread. */
+	bool Start(const FSentryServerReplayConfig& InConfig);
+
+	/** Stops recording, the segments recorded so far are kept on disk. */
+	void Stop();
+
+	/** Checks whether the replay is being recorded. */
+	bool IsActive() const { return bIsActive; }
+
+	/**
+	 * Gets the paths of the replay segments ordered from the oldest to the newest, the last one being the segment that's
+	 * being recorded and holds the match up to the last flush of the streamer. Safe to call from the crash handler.
+	 *
+	 * @return False if there are no segments or they are being rotated.
+	 */
+	bool GetSegments(TArray<FString>& OutPaths) const;
+
+	/** Gets the directory the local file replay streamer writes the segments to. */
+	static FString GetReplayDirectory();
+
+	/** Gets the directory of the segment copies sent along with ensures. */
+	static FString GetSnapshotsDirectory();
+
+	/**
+	 * Deletes the oldest segment copies until the new ones fit into the max size of the replay. Called off the game thread
+	 * before copying the segments for an ensure.
+	 */
+	void TrimSnapshots(int64 NewSnapshotsSize) const;
+
+private:
+	static constexpr int32 NumSegmentSlots = 3;
+
+	void Tick();
+
+	bool StartSegment();
+	void FinishSegment();
+
+	static UGameInstance* GetGameInstance();
+	static FString GetSegmentName(int32 Slot);
+
+	FSentryServerReplayConfig Config;
+
+	FThreadSafeBool bIsActive;
+
+	/** Checkpoint interval the console variable had before recording started, restored once it stops. */
+	FString PreviousCheckpointDelay;
+
+	uint32 StartSerial = 0;
+
+	// Game thread state
+	double SegmentStartTime = 0.0;
+	int32 NextSlot = 0;
+
+	/** Guards the slots against being rotated while the crash handler reads them, only written on the game thread. */
+	mutable FCriticalSection SegmentsCriticalSection;
+
+	/** Slots of the finished segments ordered from the oldest to the newest. */
+	TArray<int32> FinishedSlots;
+
+	/** Slot of the segment being recorded, INDEX_NONE if there's none. */
+	int32 CurrentSlot = INDEX_NONE;
+};
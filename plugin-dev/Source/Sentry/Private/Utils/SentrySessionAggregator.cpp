@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentrySessionAggregator.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace SentrySessionAggregator
+{
+	static void AppendUtf8(TArray<uint8>& Out, const FString& Str)
+	{
+		const FTCHARToUTF8 Converted(*Str);
+		Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	static void SetCountField(const TSharedPtr<FJsonObject>& Object, const TCHAR* Name, int32 Count)
+	{
+		// Omitted counts default to zero
+		if (Count > 0)
+		{
+			Object->SetNumberField(Name, Count);
+		}
+	}
+}
+
+FSentrySessionAggregator::FSentrySessionAggregator(const FString& Release, const FString& Environment)
+	: Release(Release)
+	, Environment(Environment)
+{
+}
+
+void FSentrySessionAggregator::Record(const FDateTime& StartedAt, ESentrySessionStatus Status)
+{
+	const int64 StartedMinute = StartedAt.ToUnixTimestamp() / 60 * 60;
+
+	FScopeLock Lock(&CriticalSection);
+
+	FBucket& Bucket = Buckets.FindOrAdd(StartedMinute);
+
+	switch (Status)
+	{
+	case ESentrySessionStatus::Exited:
+		++Bucket.Exited;
+		break;
+	case ESentrySessionStatus::Errored:
+		++Bucket.Errored;
+		break;
+	case ESentrySessionStatus::Crashed:
+		++Bucket.Crashed;
+		break;
+	case ESentrySessionStatus::Abnormal:
+		++Bucket.Abnormal;
+		break;
+	}
+}
+
+bool FSentrySessionAggregator::IsEmpty() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Buckets.Num() == 0;
+}
+
+TArray<uint8> FSentrySessionAggregator::TakeEnvelope()
+{
+	TMap<int64, FBucket> TakenBuckets;
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		TakenBuckets = MoveTemp(Buckets);
+		Buckets.Reset();
+	}
+
+	TArray<uint8> Envelope;
+
+	if (TakenBuckets.Num() == 0)
+	{
+		return Envelope;
+	}
+
+	TakenBuckets.KeySort(TLess<int64>());
+
+	TArray<TSharedPtr<FJsonValue>> Aggregates;
+	Aggregates.Reserve(TakenBuckets.Num());
+
+	for (const auto& Bucket : TakenBuckets)
+	{
+		TSharedPtr<FJsonObject> Aggregate = MakeShareable(new FJsonObject);
+		Aggregate->SetStringField(TEXT("started"), FDateTime::FromUnixTimestamp(Bucket.Key).ToIso8601());
+
+		SentrySessionAggregator::SetCountField(Aggregate, TEXT("exited"), Bucket.Value.Exited);
+		SentrySessionAggregator::SetCountField(Aggregate, TEXT("errored"), Bucket.Value.Errored);
+		SentrySessionAggregator::SetCountField(Aggregate, TEXT("crashed"), Bucket.Value.Crashed);
+		SentrySessionAggregator::SetCountField(Aggregate, TEXT("abnormal"), Bucket.Value.Abnormal);
+
+		Aggregates.Add(MakeShareable(new FJsonValueObject(Aggregate)));
+	}
+
+	TSharedPtr<FJsonObject> Attributes = MakeShareable(new FJsonObject);
+	Attributes->SetStringField(TEXT("release"), Release);
+
+	if (!Environment.IsEmpty())
+	{
+		Attributes->SetStringField(TEXT("environment"), Environment);
+	}
+
+	TSharedPtr<FJsonObject> Payload = MakeShareable(new FJsonObject);
+	Payload->SetObjectField(TEXT("attrs"), Attributes);
+	Payload->SetArrayField(TEXT("aggregates"), Aggregates);
+
+	FString PayloadJson;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&PayloadJson);
+	FJsonSerializer::Serialize(Payload.ToSharedRef(), Writer);
+
+	TArray<uint8> PayloadUtf8;
+	SentrySessionAggregator::AppendUtf8(PayloadUtf8, PayloadJson);
+
+	SentrySessionAggregator::AppendUtf8(Envelope, FString::Printf(TEXT("{}\n{\"type\":\"sessions\",\"length\":%d}\n"), PayloadUtf8.Num()));
+	Envelope.Append(PayloadUtf8);
+	Envelope.Add('\n');
+
+	return Envelope;
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include "SentryDataTypes.h"
+
+/**
+ * Release health of many short sessions, e.g. the players of a dedicated server, counted in memory.
+ *
+ * Instead of sending an update for every session, sessions are counted by their outcome per minute they started in
+ * and the counts are sent as a single `sessions` envelope with aggregates, so the cost stays the same regardless
+ * of the number of sessions.
+ */
+class FSentrySessionAggregator
+{
+public:
+	FSentrySessionAggregator(const FString& Release, const FString& Environment);
+
+	/** Counts a finished session. Safe to call from any thread. */
+	void Record(const FDateTime& StartedAt, ESentrySessionStatus Status);
+
+	/** Checks whether there are counted sessions that haven't been sent yet. */
+	bool IsEmpty() const;
+
+	/** Serializes the counted sessions into an envelope and resets the counts, empty if nothing was counted. */
+	TArray<uint8> TakeEnvelope();
+
+private:
+	struct FBucket
+	{
+		int32 Exited = 0;
+		int32 Errored = 0;
+		int32 Crashed = 0;
+		int32 Abnormal = 0;
+	};
+
+	const FString Release;
+	const FString Environment;
+
+	mutable FCriticalSection CriticalSection;
+
+	/** Counts of the sessions by the UTC minute they started in, as Unix seconds. */
+	TMap<int64, FBucket> Buckets;
+};
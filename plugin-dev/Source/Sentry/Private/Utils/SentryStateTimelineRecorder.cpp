@@ -0,0 +1,614 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryStateTimelineRecorder.h"
+
+#include "SentryDefines.h"
+
+#include "Utils/SentryStructLayout.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreMisc.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/Class.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace SentryStateTimelineRecorder
+{
+	/** Bumped whenever the serialized layout changes. */
+	static constexpr int32 FormatVersion = 1;
+
+	/** Size of the skip and length fields preceding the changed bytes of each token. */
+	static constexpr int32 TokenHeaderSize = 4;
+
+	static void WriteUint16(uint8* Out, int32 Value)
+	{
+		Out[0] = static_cast<uint8>(Value & 0xFF);
+		Out[1] = static_cast<uint8>((Value >> 8) & 0xFF);
+	}
+
+	static int32 ReadUint16(const uint8* In)
+	{
+		return In[0] | (In[1] << 8);
+	}
+
+	/** Whether the struct only holds values that can be copied and compared bytewise. */
+	static bool IsPlainStruct(const UStruct* Struct)
+	{
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			const FProperty* Property = *It;
+
+			if (Property->IsA<FNumericProperty>() || Property->IsA<FBoolProperty>() || Property->IsA<FEnumProperty>() || Property->IsA<FNameProperty>())
+			{
+				continue;
+			}
+
+			const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+			if (StructProperty && IsPlainStruct(StructProperty->Struct))
+			{
+				continue;
+			}
+
+			return false;
+		}
+
+		return true;
+	}
+
+	/** Writes struct snapshots as JSON objects, see FSentryStructLayout::Write. */
+	class FJsonWriter
+	{
+	public:
+		explicit FJsonWriter(FString& InJson)
+			: Json(InJson)
+		{
+		}
+
+		void WriteBool(const FSentryStructLayout::FField& Field, bool Value)
+		{
+			WriteKey(Field);
+			Json += Value ? TEXT("true") : TEXT("false");
+		}
+
+		void WriteInteger(const FSentryStructLayout::FField& Field, int32 Value)
+		{
+			WriteKey(Field);
+			Json += FString::Printf(TEXT("%d"), Value);
+		}
+
+		void WriteFloat(const FSentryStructLayout::FField& Field, double Value)
+		{
+			WriteKey(Field);
+			Json += FMath::IsFinite(Value) ? FString::Printf(TEXT("%g"), Value) : TEXT("null");
+		}
+
+		void WriteString(const FSentryStructLayout::FField& Field, const FString& Value)
+		{
+			WriteKey(Field);
+			Json += FString::Printf(TEXT("\"%s\""), *Value.ReplaceCharWithEscapedChar());
+		}
+
+		void BeginStruct(const FSentryStructLayout::FField& Field)
+		{
+			WriteKey(Field);
+			Json.AppendChar(TEXT('{'));
+			bNeedsComma = false;
+		}
+
+		void EndStruct(const FSentryStructLayout::FField& Field)
+		{
+			Json.AppendChar(TEXT('}'));
+			bNeedsComma = true;
+		}
+
+	private:
+		void WriteKey(const FSentryStructLayout::FField& Field)
+		{
+			if (bNeedsComma)
+			{
+				Json.AppendChar(TEXT(','));
+			}
+
+			Json += FString::Printf(TEXT("\"%s\":"), *Field.Name.ReplaceCharWithEscapedChar());
+			bNeedsComma = true;
+		}
+
+		FString& Json;
+		bool bNeedsComma = false;
+	};
+}
+
+FSentryStateTimelineRecorder& FSentryStateTimelineRecorder::Get()
+{
+	static FSentryStateTimelineRecorder Instance;
+	return Instance;
+}
+
+int32 FSentryStateTimelineRecorder::Register(const FString& Name, int32 SnapshotSize, const UScriptStruct* Struct, FSentryStateProvider Provider)
+{
+	check(IsInGameThread());
+
+	if (SnapshotSize <= 0 || SnapshotSize > MaxSnapshotSize || !Provider)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("State provider %s wasn't registered, snapshots have to be between 1 and %d bytes."), *Name, MaxSnapshotSize);
+		return INDEX_NONE;
+	}
+
+	for (int32 Handle = 0; Handle < MaxProviders; ++Handle)
+	{
+		FProvider& Slot = Providers[Handle];
+		if (Slot.bIsRegistered)
+		{
+			continue;
+		}
+
+		// Readers still holding the previous description see the generation change and drop what they copied
+		Slot.Generation.Store(Slot.Generation.Load() + 1);
+
+		FCString::Strncpy(Slot.Name, *Name, MaxNameLength);
+		Slot.Layout = nullptr;
+		if (Struct)
+		{
+			const TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Layout = FSentryStructLayout::Get(Struct);
+			Layouts.AddUnique(Layout);
+			Slot.Layout = &Layout.Get();
+		}
+		Slot.Provider = MoveTemp(Provider);
+		Slot.SnapshotSize = SnapshotSize;
+		Slot.Current.SetNumZeroed(SnapshotSize);
+		Slot.Previous.SetNumZeroed(SnapshotSize);
+		Slot.Encoded.SetNumUninitialized(GetMaxEncodedSize(SnapshotSize));
+		Slot.bHasPrevious = false;
+		Slot.NumSamplesSinceKeyframe = 0;
+
+		Slot.bIsRegistered = true;
+
+		return Handle;
+	}
+
+	UE_LOG(LogSentrySdk, Warning, TEXT("State provider %s wasn't registered, all %d slots are taken."), *Name, MaxProviders);
+	return INDEX_NONE;
+}
+
+int32 FSentryStateTimelineRecorder::RegisterStruct(const FString& Name, const UScriptStruct* Struct, FSentryStateProvider Provider)
+{
+	if (!Struct || !SentryStateTimelineRecorder::IsPlainStruct(Struct))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("State provider %s wasn't registered, its struct can only hold numbers, booleans, enums, names and such structs."), *Name);
+		return INDEX_NONE;
+	}
+
+	return Register(Name, Struct->GetStructureSize(), Struct, MoveTemp(Provider));
+}
+
+void FSentryStateTimelineRecorder::Unregister(int32 Handle)
+{
+	check(IsInGameThread());
+
+	if (Handle < 0 || Handle >= MaxProviders)
+	{
+		return;
+	}
+
+	// Buffers are kept until the slot is reused since the crash handler may be reading them
+	Providers[Handle].bIsRegistered = false;
+	Providers[Handle].Provider = nullptr;
+}
+
+void FSentryStateTimelineRecorder::Start(float SampleIntervalSeconds, int32 ArenaSize)
+{
+	check(IsInGameThread());
+
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	Arena.SetNumZeroed(FMath::Clamp(ArenaSize, 16 * 1024, 16 * 1024 * 1024));
+	ArenaWritePos = 0;
+
+	// Unchanged snapshots aren't recorded, so records are rarely smaller than a few tokens
+	Records.SetNumZeroed(FMath::Max(256, Arena.Num() / 32));
+	FirstRecord.Store(0);
+	NumRecordsWritten.Store(0);
+
+	for (FProvider& Provider : Providers)
+	{
+		Provider.bHasPrevious = false;
+	}
+
+	bIsActive = true;
+
+	const uint32 Serial = ++StartSerial;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+	Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Serial](float DeltaTime)
+	{
+		if (!bIsActive || StartSerial != Serial)
+		{
+			return false;
+		}
+
+		Sample();
+		return true;
+	}), FMath::Clamp(SampleIntervalSeconds, 0.05f, 10.0f));
+}
+
+void FSentryStateTimelineRecorder::Stop()
+{
+	check(IsInGameThread());
+
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	FirstRecord.Store(0);
+	NumRecordsWritten.Store(0);
+	Records.Empty();
+	Arena.Empty();
+}
+
+void FSentryStateTimelineRecorder::Sample()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (int32 Slot = 0; Slot < MaxProviders; ++Slot)
+	{
+		FProvider& Provider = Providers[Slot];
+		if (!Provider.bIsRegistered)
+		{
+			continue;
+		}
+
+		FMemory::Memzero(Provider.Current.GetData(), Provider.SnapshotSize);
+		Provider.Provider(Provider.Current.GetData());
+
+		const bool bIsKeyframe = !Provider.bHasPrevious || Provider.NumSamplesSinceKeyframe >= KeyframeInterval || Provider.LastKeyframeRecord < FirstRecord.Load();
+
+		const int32 EncodedSize = EncodeDelta(Provider.Current.GetData(), bIsKeyframe ? nullptr : Provider.Previous.GetData(), Provider.SnapshotSize, Provider.Encoded.GetData());
+		if (EncodedSize == 0 && !bIsKeyframe)
+		{
+			continue;
+		}
+
+		FRecord Record;
+		Record.Timestamp = Now;
+		Record.FrameNumber = GFrameCounter;
+		Record.Offset = 0;
+		Record.Size = EncodedSize;
+		Record.Generation = Provider.Generation.Load();
+		Record.Slot = static_cast<uint8>(Slot);
+		Record.bIsKeyframe = bIsKeyframe;
+
+		Append(Record, Provider.Encoded.GetData());
+
+		if (bIsKeyframe)
+		{
+			Provider.LastKeyframeRecord = NumRecordsWritten.Load() - 1;
+			Provider.NumSamplesSinceKeyframe = 0;
+		}
+		else
+		{
+			++Provider.NumSamplesSinceKeyframe;
+		}
+
+		Swap(Provider.Current, Provider.Previous);
+		Provider.bHasPrevious = true;
+	}
+}
+
+void FSentryStateTimelineRecorder::Append(const FRecord& Record, const uint8* Data)
+{
+	if (Record.Size > Arena.Num())
+	{
+		return;
+	}
+
+	if (ArenaWritePos + Record.Size > Arena.Num())
+	{
+		// Records of the previous lap past the write position are the oldest ones, the space after them stays unused this lap
+		while (FirstRecord.Load() < NumRecordsWritten.Load() && Records[FirstRecord.Load() % Records.Num()].Offset >= ArenaWritePos)
+		{
+			EvictOldest();
+		}
+
+		ArenaWritePos = 0;
+	}
+
+	const int32 Begin = ArenaWritePos;
+	const int32 End = Begin + Record.Size;
+
+	// Records are laid out in the order they were written, so the ones overlapping the new one are the oldest
+	while (FirstRecord.Load() < NumRecordsWritten.Load())
+	{
+		const FRecord& Oldest = Records[FirstRecord.Load() % Records.Num()];
+
+		const bool bIsOverlapping = Oldest.Offset < End && Begin < Oldest.Offset + Oldest.Size;
+		const bool bIsFull = NumRecordsWritten.Load() - FirstRecord.Load() >= static_cast<uint64>(Records.Num());
+		if (!bIsOverlapping && !bIsFull)
+		{
+			break;
+		}
+
+		EvictOldest();
+	}
+
+	// Records are evicted before they're overwritten, so readers can tell the copies that may be torn
+	FMemory::Memcpy(Arena.GetData() + Begin, Data, Record.Size);
+
+	const uint64 Written = NumRecordsWritten.Load();
+
+	FRecord& Slot = Records[Written % Records.Num()];
+	Slot = Record;
+	Slot.Offset = Begin;
+
+	NumRecordsWritten.Store(Written + 1);
+
+	ArenaWritePos = End;
+}
+
+void FSentryStateTimelineRecorder::EvictOldest()
+{
+	FirstRecord.Store(FirstRecord.Load() + 1);
+}
+
+TArray<uint8> FSentryStateTimelineRecorder::Serialize() const
+{
+	if (!bIsActive || Records.Num() == 0)
+	{
+		return TArray<uint8>();
+	}
+
+	const uint64 End = NumRecordsWritten.Load();
+	const uint64 Begin = FirstRecord.Load();
+	if (Begin >= End)
+	{
+		return TArray<uint8>();
+	}
+
+	TArray<FRecord> CopiedRecords;
+	TArray<uint8> CopiedData;
+
+	CopiedRecords.Reserve(static_cast<int32>(End - Begin));
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		FRecord Record = Records[Index % Records.Num()];
+		if (Record.Offset < 0 || Record.Size < 0 || Record.Offset + Record.Size > Arena.Num())
+		{
+			Record.Size = 0;
+		}
+
+		const int32 CopiedOffset = CopiedData.Num();
+		CopiedData.Append(Arena.GetData() + Record.Offset, Record.Size);
+		Record.Offset = CopiedOffset;
+
+		CopiedRecords.Add(Record);
+	}
+
+	// Records evicted in the meantime may have been overwritten by the game thread, so only the ones still in the arena are kept
+	const uint64 FirstIntact = FirstRecord.Load();
+	if (FirstIntact > Begin)
+	{
+		CopiedRecords.RemoveAt(0, static_cast<int32>(FMath::Min(FirstIntact - Begin, End - Begin)));
+	}
+
+	// Descriptions are copied up front and only kept if the slot wasn't reused while they were being copied
+	struct FProviderInfo
+	{
+		TCHAR Name[MaxNameLength];
+		const FSentryStructLayout* Layout;
+		int32 SnapshotSize;
+		uint16 Generation;
+		bool bIsValid;
+	};
+
+	FProviderInfo Infos[MaxProviders];
+	for (int32 Slot = 0; Slot < MaxProviders; ++Slot)
+	{
+		const FProvider& Provider = Providers[Slot];
+		FProviderInfo& Info = Infos[Slot];
+
+		Info.Generation = Provider.Generation.Load();
+		Info.bIsValid = Provider.bIsRegistered;
+		if (!Info.bIsValid)
+		{
+			continue;
+		}
+
+		FMemory::Memcpy(Info.Name, Provider.Name, sizeof(Info.Name));
+		Info.Name[MaxNameLength - 1] = TEXT('\0');
+		Info.Layout = Provider.Layout;
+		Info.SnapshotSize = Provider.SnapshotSize;
+
+		Info.bIsValid = Provider.bIsRegistered && Provider.Generation.Load() == Info.Generation;
+	}
+
+	TArray<uint8> States[MaxProviders];
+	bool bHasState[MaxProviders] = {};
+
+	const double Now = FPlatformTime::Seconds();
+
+	FString Json = FString::Printf(TEXT("{\"version\":%d,\"frame\":%llu,\"samples\":["), SentryStateTimelineRecorder::FormatVersion, GFrameCounter);
+	bool bIsFirst = true;
+
+	for (const FRecord& Record : CopiedRecords)
+	{
+		if (Record.Slot >= MaxProviders)
+		{
+			continue;
+		}
+
+		const FProviderInfo& Info = Infos[Record.Slot];
+		if (!Info.bIsValid || Info.Generation != Record.Generation)
+		{
+			continue;
+		}
+
+		TArray<uint8>& State = States[Record.Slot];
+
+		if (Record.bIsKeyframe)
+		{
+			State.SetNumZeroed(Info.SnapshotSize);
+			FMemory::Memzero(State.GetData(), State.Num());
+			bHasState[Record.Slot] = true;
+		}
+		else if (!bHasState[Record.Slot])
+		{
+			// Differences recorded before the first keyframe still in the arena can't be decoded
+			continue;
+		}
+
+		if (!ApplyDelta(CopiedData.GetData() + Record.Offset, Record.Size, State.GetData(), State.Num()))
+		{
+			bHasState[Record.Slot] = false;
+			continue;
+		}
+
+		if (!bIsFirst)
+		{
+			Json.AppendChar(TEXT(','));
+		}
+		bIsFirst = false;
+
+		// Times are relative to the capture so that the state right before it is easy to spot
+		Json += FString::Printf(TEXT("{\"t\":%.3f,\"frame\":%llu,\"provider\":\"%s\",\"data\":"),
+			Record.Timestamp - Now, Record.FrameNumber, *FString(Info.Name).ReplaceCharWithEscapedChar());
+
+		if (Info.Layout)
+		{
+			Json.AppendChar(TEXT('{'));
+			SentryStateTimelineRecorder::FJsonWriter Writer(Json);
+			Info.Layout->Write(State.GetData(), Writer);
+			Json.AppendChar(TEXT('}'));
+		}
+		else
+		{
+			Json += FString::Printf(TEXT("\"%s\""), *BytesToHex(State.GetData(), State.Num()));
+		}
+
+		Json.AppendChar(TEXT('}'));
+	}
+
+	if (bIsFirst)
+	{
+		return TArray<uint8>();
+	}
+
+	Json += TEXT("]}");
+
+	const FTCHARToUTF8 Utf8(*Json);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+int32 FSentryStateTimelineRecorder::GetMaxEncodedSize(int32 SnapshotSize)
+{
+	// Every token but the first one is preceded by at least a header's worth of unchanged bytes
+	return SnapshotSize + SentryStateTimelineRecorder::TokenHeaderSize * (SnapshotSize / (SentryStateTimelineRecorder::TokenHeaderSize + 1) + 1);
+}
+
+int32 FSentryStateTimelineRecorder::EncodeDelta(const uint8* Snapshot, const uint8* Previous, int32 SnapshotSize, uint8* OutEncoded)
+{
+	using namespace SentryStateTimelineRecorder;
+
+	auto GetDiff = [Snapshot, Previous](int32 Index) -> uint8
+	{
+		return Previous ? Snapshot[Index] ^ Previous[Index] : Snapshot[Index];
+	};
+
+	int32 EncodedSize = 0;
+	int32 Pos = 0;
+
+	while (Pos < SnapshotSize)
+	{
+		const int32 SkipStart = Pos;
+		while (Pos < SnapshotSize && GetDiff(Pos) == 0)
+		{
+			++Pos;
+		}
+
+		if (Pos == SnapshotSize)
+		{
+			break;
+		}
+
+		// Unchanged runs shorter than a token header are cheaper to keep within the changed bytes
+		const int32 ChangedStart = Pos;
+		int32 ChangedEnd = Pos;
+		int32 NumUnchanged = 0;
+
+		while (Pos < SnapshotSize)
+		{
+			if (GetDiff(Pos) != 0)
+			{
+				NumUnchanged = 0;
+				ChangedEnd = Pos + 1;
+			}
+			else if (++NumUnchanged >= TokenHeaderSize)
+			{
+				break;
+			}
+
+			++Pos;
+		}
+
+		Pos = ChangedEnd;
+
+		WriteUint16(OutEncoded + EncodedSize, ChangedStart - SkipStart);
+		WriteUint16(OutEncoded + EncodedSize + 2, ChangedEnd - ChangedStart);
+		EncodedSize += TokenHeaderSize;
+
+		for (int32 Index = ChangedStart; Index < ChangedEnd; ++Index)
+		{
+			OutEncoded[EncodedSize++] = GetDiff(Index);
+		}
+	}
+
+	return EncodedSize;
+}
+
+bool FSentryStateTimelineRecorder::ApplyDelta(const uint8* Encoded, int32 EncodedSize, uint8* InOutSnapshot, int32 SnapshotSize)
+{
+	using namespace SentryStateTimelineRecorder;
+
+	int32 Cursor = 0;
+	int32 Pos = 0;
+
+	while (Cursor < EncodedSize)
+	{
+		if (Cursor + TokenHeaderSize > EncodedSize)
+		{
+			return false;
+		}
+
+		const int32 NumSkipped = ReadUint16(Encoded + Cursor);
+		const int32 NumChanged = ReadUint16(Encoded + Cursor + 2);
+		Cursor += TokenHeaderSize;
+
+		Pos += NumSkipped;
+		if (Pos + NumChanged > SnapshotSize || Cursor + NumChanged > EncodedSize)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < NumChanged; ++Index)
+		{
+			InOutSnapshot[Pos++] ^= Encoded[Cursor++];
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+
+#include "SentryStateTimeline.h"
+
+class FSentryStructLayout;
+class UScriptStruct;
+
+/**
+ * Timeline of the gameplay state snapshots written by the registered providers, attached to crashes and errors.
+ *
+ * Providers are sampled on the game thread at a low fixed rate. Each sample is XOR-ed with the previous snapshot of
+ * its provider and the zero runs of the result are skipped, so unchanged snapshots cost nothing and small changes
+ * only a few bytes. Every few samples a keyframe is encoded against zeros instead, so that the timeline can be
+ * decoded once older samples are evicted. Encoded samples go into a preallocated byte arena used as a ring and are
+ * published through atomic counters, so sampling never allocates or locks and the crash handler can read the arena
+ * while the game thread writes to it. Samples are only decoded to JSON when an event is captured or the game crashes.
+ */
+class FSentryStateTimelineRecorder
+{
+public:
+	static constexpr int32 MaxProviders = 16;
+	static constexpr int32 MaxSnapshotSize = 4096;
+
+	/** Max length of provider names, longer ones are truncated. */
+	static constexpr int32 MaxNameLength = 64;
+
+	/** Number of samples of a provider between its keyframes. */
+	static constexpr int32 KeyframeInterval = 16;
+
+	static FSentryStateTimelineRecorder& Get();
+
+	/** Registers a provider, the struct describes its snapshot if set. Game thread only. */
+	int32 Register(const FString& Name, int32 SnapshotSize, const UScriptStruct* Struct, FSentryStateProvider Provider);
+	int32 RegisterStruct(const FString& Name, const UScriptStruct* Struct, FSentryStateProvider Provider);
+	void Unregister(int32 Handle);
+
+	/** Starts sampling the providers with an arena of the given size. Game thread only. */
+	void Start(float SampleIntervalSeconds, int32 ArenaSize);
+
+	/** Stops sampling and discards the samples, providers stay registered. */
+	void Stop();
+
+	bool IsActive() const { return bIsActive; }
+
+	/** Samples all providers, called by the ticker. Game thread only. */
+	void Sample();
+
+	/**
+	 * Decodes the samples into a UTF-8 JSON document, empty if nothing was sampled. Safe to call from any thread, providers
+	 * registered concurrently are skipped rather than read torn. Allocates the result, so the crash handler only calls it from
+	 * the on_crash hook rather than from a signal handler.
+	 */
+	TArray<uint8> Serialize() const;
+
+	/** Upper bound of the size of an encoded snapshot of the given size. */
+	static int32 GetMaxEncodedSize(int32 SnapshotSize);
+
+	/**
+	 * Encodes the difference of the snapshot from the previous one, or the snapshot itself if there is none, as a sequence of
+	 * tokens made of the number of unchanged bytes to skip and the number of changed bytes that follow (both uint16), followed
+	 * by the changed bytes XOR-ed with the previous ones. Returns the encoded size, 0 if nothing changed.
+	 */
+	static int32 EncodeDelta(const uint8* Snapshot, const uint8* Previous, int32 SnapshotSize, uint8* OutEncoded);
+
+	/** Applies an encoded difference to the snapshot in place, false if the encoding is malformed. */
+	static bool ApplyDelta(const uint8* Encoded, int32 EncodedSize, uint8* InOutSnapshot, int32 SnapshotSize);
+
+private:
+	FSentryStateTimelineRecorder() = default;
+
+	struct FProvider
+	{
+		/** Name kept inline so that readers copying it while the slot is reused can't touch freed memory. */
+		TCHAR Name[MaxNameLength];
+
+		/** Layout of the struct describing the snapshot, resolved on registration so that decoding doesn't look it up. */
+		const FSentryStructLayout* Layout = nullptr;
+
+		FSentryStateProvider Provider;
+		int32 SnapshotSize = 0;
+
+		/**
+		 * Bumped whenever the slot is reused, samples of an earlier provider in the slot are skipped.
+		 * Readers check it again after copying the description to tell whether it changed in the meantime.
+		 */
+		TAtomic<uint16> Generation { 0 };
+
+		TAtomic<bool> bIsRegistered { false };
+
+		/** Buffers allocated on registration so that sampling doesn't allocate. */
+		TArray<uint8> Current;
+		TArray<uint8> Previous;
+		TArray<uint8> Encoded;
+
+		bool bHasPrevious = false;
+		int32 NumSamplesSinceKeyframe = 0;
+
+		/** Index of the last keyframe record, a new one is written as soon as it's evicted. */
+		uint64 LastKeyframeRecord = 0;
+	};
+
+	struct FRecord
+	{
+		/** Time of the sample, in FPlatformTime::Seconds. */
+		double Timestamp;
+
+		/** Engine frame counter. */
+		uint64 FrameNumber;
+
+		/** Range of the encoded sample in the arena. */
+		int32 Offset;
+		int32 Size;
+
+		uint16 Generation;
+		uint8 Slot;
+		bool bIsKeyframe;
+	};
+
+	/** Writes the encoded sample to the arena, evicting the records it overwrites. Game thread only. */
+	void Append(const FRecord& Record, const uint8* Data);
+
+	/** Evicts the oldest record. Game thread only. */
+	void EvictOldest();
+
+	FThreadSafeBool bIsActive;
+	uint32 StartSerial = 0;
+
+	FProvider Providers[MaxProviders];
+
+	/** Layouts of all registered struct types, kept alive since readers may still use the ones of unregistered providers. */
+	TArray<TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe>> Layouts;
+
+	TArray<uint8> Arena;
+	int32 ArenaWritePos = 0;
+
+	TArray<FRecord> Records;
+
+	/** Index of the oldest record still in the arena and the number of records written since the start. */
+	TAtomic<uint64> FirstRecord { 0 };
+	TAtomic<uint64> NumRecordsWritten { 0 };
+};
@@ -0,0 +1,532 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryStaticScopeFragment.h"
+
+#include "Utils/SentryEnvelopeBatch.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeLock.h"
+
+namespace SentryStaticScopeFragment
+{
+	/** Member of a serialized JSON object, positions of the quoted key and the value within the payload. */
+	struct FMember
+	{
+		int32 KeyStart = 0;
+		int32 KeyEnd = 0;
+		int32 ValueStart = 0;
+		int32 ValueEnd = 0;
+	};
+
+	/** Bytes to be inserted into the payload in front of the given position. */
+	struct FInsertion
+	{
+		int32 Position;
+		TArray<uint8> Bytes;
+	};
+
+	static bool IsWhitespace(uint8 Char)
+	{
+		return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+	}
+
+	static int32 SkipWhitespace(const uint8* Data, int32 Length, int32 Position)
+	{
+		while (Position < Length && IsWhitespace(Data[Position]))
+		{
+			Position++;
+		}
+
+		return Position;
+	}
+
+	/** Skips the string starting at the opening quote, returns the position after the closing quote or INDEX_NONE if it's unterminated. */
+	static int32 SkipString(const uint8* Data, int32 Length, int32 Position)
+	{
+		for (Position++; Position < Length; Position++)
+		{
+			if (Data[Position] == '\\')
+			{
+				Position++;
+			}
+			else if (Data[Position] == '"')
+			{
+				return Position + 1;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	/** Skips the value starting at the given position without looking into it, returns the position after it or INDEX_NONE if it's malformed. */
+	static int32 SkipValue(const uint8* Data, int32 Length, int32 Position)
+	{
+		if (Position >= Length)
+		{
+			return INDEX_NONE;
+		}
+
+		if (Data[Position] == '"')
+		{
+			return SkipString(Data, Length, Position);
+		}
+
+		if (Data[Position] == '{' || Data[Position] == '[')
+		{
+			int32 Depth = 0;
+			while (Position < Length)
+			{
+				const uint8 Char = Data[Position];
+				if (Char == '"')
+				{
+					Position = SkipString(Data, Length, Position);
+					if (Position == INDEX_NONE)
+					{
+						return INDEX_NONE;
+					}
+
+					continue;
+				}
+
+				if (Char == '{' || Char == '[')
+				{
+					Depth++;
+				}
+				else if ((Char == '}' || Char == ']') && --Depth == 0)
+				{
+					return Position + 1;
+				}
+
+				Position++;
+			}
+
+			return INDEX_NONE;
+		}
+
+		// Numbers and literals run until the next delimiter
+		const int32 Start = Position;
+		while (Position < Length && Data[Position] != ',' && Data[Position] != '}' && Data[Position] != ']' && !IsWhitespace(Data[Position]))
+		{
+			Position++;
+		}
+
+		return Position > Start ? Position : INDEX_NONE;
+	}
+
+	/** Splits the object starting at the given position into its members, false if it's malformed. */
+	static bool ParseObject(const uint8* Data, int32 Length, int32 Start, TArray<FMember>& OutMembers, int32& OutClosingBrace)
+	{
+		int32 Position = SkipWhitespace(Data, Length, Start);
+		if (Position >= Length || Data[Position] != '{')
+		{
+			return false;
+		}
+
+		Position = SkipWhitespace(Data, Length, Position + 1);
+		if (Position < Length && Data[Position] == '}')
+		{
+			OutClosingBrace = Position;
+			return true;
+		}
+
+		while (Position < Length && Data[Position] == '"')
+		{
+			FMember& Member = OutMembers.AddDefaulted_GetRef();
+			Member.KeyStart = Position;
+			Member.KeyEnd = SkipString(Data, Length, Position);
+			if (Member.KeyEnd == INDEX_NONE)
+			{
+				return false;
+			}
+
+			Position = SkipWhitespace(Data, Length, Member.KeyEnd);
+			if (Position >= Length || Data[Position] != ':')
+			{
+				return false;
+			}
+
+			Member.ValueStart = SkipWhitespace(Data, Length, Position + 1);
+			Member.ValueEnd = SkipValue(Data, Length, Member.ValueStart);
+			if (Member.ValueEnd == INDEX_NONE)
+			{
+				return false;
+			}
+
+			Position = SkipWhitespace(Data, Length, Member.ValueEnd);
+			if (Position < Length && Data[Position] == '}')
+			{
+				OutClosingBrace = Position;
+				return true;
+			}
+
+			if (Position >= Length || Data[Position] != ',')
+			{
+				return false;
+			}
+
+			Position = SkipWhitespace(Data, Length, Position + 1);
+		}
+
+		return false;
+	}
+
+	static TArray<TPair<int32, int32>> GetKeys(const TArray<FMember>& Members)
+	{
+		TArray<TPair<int32, int32>> Keys;
+		Keys.Reserve(Members.Num());
+
+		for (const FMember& Member : Members)
+		{
+			Keys.Emplace(Member.KeyStart, Member.KeyEnd);
+		}
+
+		return Keys;
+	}
+
+	static bool KeyEquals(const uint8* Data, int32 KeyStart, int32 KeyEnd, const uint8* QuotedKey, int32 QuotedKeyLength)
+	{
+		return KeyEnd - KeyStart == QuotedKeyLength && FMemory::Memcmp(Data + KeyStart, QuotedKey, QuotedKeyLength) == 0;
+	}
+
+	static const FMember* FindMember(const uint8* Data, const TArray<FMember>& Members, const ANSICHAR* QuotedKey)
+	{
+		const int32 QuotedKeyLength = FCStringAnsi::Strlen(QuotedKey);
+
+		return Members.FindByPredicate([Data, QuotedKey, QuotedKeyLength](const FMember& Member)
+		{
+			return KeyEquals(Data, Member.KeyStart, Member.KeyEnd, reinterpret_cast<const uint8*>(QuotedKey), QuotedKeyLength);
+		});
+	}
+
+	/** Appends the string as a quoted JSON string, escaping the same characters as the native SDK does. */
+	static void AppendQuoted(TArray<uint8>& Out, const FString& Str)
+	{
+		static const ANSICHAR* HexDigits = "0123456789abcdef";
+
+		const FTCHARToUTF8 Converted(*Str);
+		const uint8* Chars = reinterpret_cast<const uint8*>(Converted.Get());
+
+		Out.Reserve(Out.Num() + Converted.Length() + 2);
+		Out.Add('"');
+
+		for (int32 Index = 0; Index < Converted.Length(); ++Index)
+		{
+			const uint8 Char = Chars[Index];
+			switch (Char)
+			{
+			case '"':
+			case '\\':
+				Out.Add('\\');
+				Out.Add(Char);
+				break;
+			case '\n':
+				Out.Append({ '\\', 'n' });
+				break;
+			case '\r':
+				Out.Append({ '\\', 'r' });
+				break;
+			case '\t':
+				Out.Append({ '\\', 't' });
+				break;
+			default:
+				if (Char < 0x20)
+				{
+					Out.Append({ '\\', 'u', '0', '0', static_cast<uint8>(HexDigits[Char >> 4]), static_cast<uint8>(HexDigits[Char & 0xf]) });
+				}
+				else
+				{
+					Out.Add(Char);
+				}
+			}
+		}
+
+		Out.Add('"');
+	}
+
+	static void AppendAnsi(TArray<uint8>& Out, const ANSICHAR* Str)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(Str), FCStringAnsi::Strlen(Str));
+	}
+}
+
+FSentryStaticScopeFragment::FSentryStaticScopeFragment()
+	: Snapshot(MakeShared<FSnapshot, ESPMode::ThreadSafe>())
+{
+}
+
+void FSentryStaticScopeFragment::SetAttribute(const FString& Key, const FString& Value)
+{
+	TArray<uint8> ValueJson;
+	SentryStaticScopeFragment::AppendQuoted(ValueJson, Value);
+
+	SetEntry(&FSnapshot::Attributes, Key, ValueJson);
+}
+
+void FSentryStaticScopeFragment::SetTag(const FString& Key, const FString& Value)
+{
+	TArray<uint8> ValueJson;
+	SentryStaticScopeFragment::AppendQuoted(ValueJson, Value);
+
+	SetEntry(&FSnapshot::Tags, Key, ValueJson);
+}
+
+void FSentryStaticScopeFragment::RemoveTag(const FString& Key)
+{
+	RemoveEntry(&FSnapshot::Tags, Key);
+}
+
+void FSentryStaticScopeFragment::SetContext(const FString& Key, const ANSICHAR* ValueJson)
+{
+	TArray<uint8> Value;
+	SentryStaticScopeFragment::AppendAnsi(Value, ValueJson);
+
+	SetEntry(&FSnapshot::Contexts, Key, Value);
+}
+
+void FSentryStaticScopeFragment::RemoveContext(const FString& Key)
+{
+	RemoveEntry(&FSnapshot::Contexts, Key);
+}
+
+bool FSentryStaticScopeFragment::IsEmpty() const
+{
+	const FSnapshotRef Current = GetSnapshot();
+	return Current->Attributes.Num() == 0 && Current->Tags.Num() == 0 && Current->Contexts.Num() == 0;
+}
+
+bool FSentryStaticScopeFragment::Splice(TArray<uint8>& Envelope) const
+{
+	int32 HeaderEnd = 0;
+	TArray<FSentryEnvelopeBatch::FItem> Items;
+	if (!FSentryEnvelopeBatch::Parse(Envelope, HeaderEnd, Items) || HeaderEnd >= Envelope.Num())
+	{
+		return false;
+	}
+
+	const bool bHasCandidates = Items.ContainsByPredicate([](const FSentryEnvelopeBatch::FItem& Item)
+	{
+		return Item.Type == TEXT("event") || Item.Type == TEXT("transaction");
+	});
+
+	if (!bHasCandidates || IsEmpty())
+	{
+		return false;
+	}
+
+	TArray<uint8> Spliced;
+	Spliced.Reserve(Envelope.Num() + 1024);
+	Spliced.Append(Envelope.GetData(), HeaderEnd + 1);
+
+	bool bChanged = false;
+	TArray<uint8> Payload;
+
+	for (const FSentryEnvelopeBatch::FItem& Item : Items)
+	{
+		if (Item.Type == TEXT("event") || Item.Type == TEXT("transaction"))
+		{
+			Payload.Reset();
+
+			TSharedPtr<FJsonObject> ItemHeader;
+			if (SplicePayload(Envelope.GetData() + Item.PayloadStart, Item.PayloadEnd - Item.PayloadStart, Payload))
+			{
+				ItemHeader = FSentryEnvelopeBatch::ParseItemHeader(Envelope, Item);
+			}
+
+			if (ItemHeader)
+			{
+				FSentryEnvelopeBatch::AppendItem(Spliced, ItemHeader.ToSharedRef(), Payload.GetData(), Payload.Num());
+				bChanged = true;
+				continue;
+			}
+		}
+
+		Spliced.Append(Envelope.GetData() + Item.Start, Item.PayloadEnd - Item.Start);
+		Spliced.Add('\n');
+	}
+
+	if (!bChanged)
+	{
+		return false;
+	}
+
+	Envelope = MoveTemp(Spliced);
+	return true;
+}
+
+bool FSentryStaticScopeFragment::SplicePayload(const uint8* Payload, int32 Length, TArray<uint8>& OutPayload) const
+{
+	using namespace SentryStaticScopeFragment;
+
+	TArray<FMember> Members;
+	int32 ClosingBrace = 0;
+	if (!ParseObject(Payload, Length, 0, Members, ClosingBrace))
+	{
+		return false;
+	}
+
+	const FSnapshotRef Current = GetSnapshot();
+
+	TArray<FInsertion> Insertions;
+
+	// Attributes and the sections the event has no object for yet are appended to the top level
+	TArray<uint8> TopLevel;
+	AppendMissingEntries(TopLevel, Payload, GetKeys(Members), Current->Attributes, Members.Num() > 0);
+
+	auto SpliceSection = [&](const ANSICHAR* QuotedName, const TArray<FEntry>& Entries)
+	{
+		if (Entries.Num() == 0)
+		{
+			return;
+		}
+
+		const FMember* Section = FindMember(Payload, Members, QuotedName);
+		if (!Section)
+		{
+			if (Members.Num() > 0 || TopLevel.Num() > 0)
+			{
+				TopLevel.Add(',');
+			}
+
+			AppendAnsi(TopLevel, QuotedName);
+			TopLevel.Append({ ':', '{' });
+			AppendMissingEntries(TopLevel, Payload, {}, Entries, false);
+			TopLevel.Add('}');
+			return;
+		}
+
+		// Anything else than an object is left as it is rather than being replaced
+		TArray<FMember> SectionMembers;
+		int32 SectionClosingBrace = 0;
+		if (Payload[Section->ValueStart] != '{' || !ParseObject(Payload, Length, Section->ValueStart, SectionMembers, SectionClosingBrace))
+		{
+			return;
+		}
+
+		TArray<uint8> Bytes;
+		if (AppendMissingEntries(Bytes, Payload, GetKeys(SectionMembers), Entries, SectionMembers.Num() > 0))
+		{
+			Insertions.Add({ SectionClosingBrace, MoveTemp(Bytes) });
+		}
+	};
+
+	SpliceSection("\"tags\"", Current->Tags);
+	SpliceSection("\"contexts\"", Current->Contexts);
+
+	if (TopLevel.Num() > 0)
+	{
+		Insertions.Add({ ClosingBrace, MoveTemp(TopLevel) });
+	}
+
+	if (Insertions.Num() == 0)
+	{
+		return false;
+	}
+
+	Insertions.Sort([](const FInsertion& A, const FInsertion& B)
+	{
+		return A.Position < B.Position;
+	});
+
+	int32 InsertedSize = 0;
+	for (const FInsertion& Insertion : Insertions)
+	{
+		InsertedSize += Insertion.Bytes.Num();
+	}
+
+	OutPayload.Reset(Length + InsertedSize);
+
+	int32 Position = 0;
+	for (const FInsertion& Insertion : Insertions)
+	{
+		OutPayload.Append(Payload + Position, Insertion.Position - Position);
+		OutPayload.Append(Insertion.Bytes);
+		Position = Insertion.Position;
+	}
+
+	OutPayload.Append(Payload + Position, Length - Position);
+
+	return true;
+}
+
+void FSentryStaticScopeFragment::SetEntry(TArray<FEntry> FSnapshot::*Entries, const FString& Key, const TArray<uint8>& ValueJson)
+{
+	FEntry Entry;
+	Entry.Key = Key;
+	SentryStaticScopeFragment::AppendQuoted(Entry.QuotedKey, Key);
+
+	Entry.Member.Reserve(Entry.QuotedKey.Num() + 1 + ValueJson.Num());
+	Entry.Member.Append(Entry.QuotedKey);
+	Entry.Member.Add(':');
+	Entry.Member.Append(ValueJson);
+
+	FScopeLock Lock(&CriticalSection);
+
+	// Snapshots being spliced are never modified, the updated entries are published as a new one
+	TSharedRef<FSnapshot, ESPMode::ThreadSafe> Updated = MakeShared<FSnapshot, ESPMode::ThreadSafe>(*Snapshot);
+
+	TArray<FEntry>& UpdatedEntries = (*Updated).*Entries;
+	if (FEntry* Existing = UpdatedEntries.FindByPredicate([&Key](const FEntry& Other) { return Other.Key.Equals(Key, ESearchCase::CaseSensitive); }))
+	{
+		*Existing = MoveTemp(Entry);
+	}
+	else
+	{
+		UpdatedEntries.Add(MoveTemp(Entry));
+	}
+
+	Snapshot = Updated;
+}
+
+void FSentryStaticScopeFragment::RemoveEntry(TArray<FEntry> FSnapshot::*Entries, const FString& Key)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	auto Matches = [&Key](const FEntry& Entry)
+	{
+		return Entry.Key.Equals(Key, ESearchCase::CaseSensitive);
+	};
+
+	if (!((*Snapshot).*Entries).ContainsByPredicate(Matches))
+	{
+		return;
+	}
+
+	TSharedRef<FSnapshot, ESPMode::ThreadSafe> Updated = MakeShared<FSnapshot, ESPMode::ThreadSafe>(*Snapshot);
+	((*Updated).*Entries).RemoveAll(Matches);
+
+	Snapshot = Updated;
+}
+
+FSentryStaticScopeFragment::FSnapshotRef FSentryStaticScopeFragment::GetSnapshot() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Snapshot;
+}
+
+bool FSentryStaticScopeFragment::AppendMissingEntries(TArray<uint8>& Out, const uint8* Data, const TArray<TPair<int32, int32>>& Keys, const TArray<FEntry>& Entries, bool bLeadingComma)
+{
+	bool bAppended = false;
+
+	for (const FEntry& Entry : Entries)
+	{
+		const bool bPresent = Keys.ContainsByPredicate([Data, &Entry](const TPair<int32, int32>& Key)
+		{
+			return SentryStaticScopeFragment::KeyEquals(Data, Key.Key, Key.Value, Entry.QuotedKey.GetData(), Entry.QuotedKey.Num());
+		});
+
+		if (bPresent)
+		{
+			continue;
+		}
+
+		if (bLeadingComma || bAppended)
+		{
+			Out.Add(',');
+		}
+
+		Out.Append(Entry.Member);
+		bAppended = true;
+	}
+
+	return bAppended;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Scope entries that don't change after initialization (release, default and hardware contexts, promoted tags),
+ * serialized once and spliced into the serialized events and transactions of outgoing envelopes.
+ *
+ * Each entry is kept as a ready-made JSON member. Splicing only scans the top level of the payload along with its
+ * tags and contexts objects and inserts the entries that aren't there yet, so values set on the event or its scope
+ * always take precedence. Thread-safe; entries are published as an immutable snapshot so that splicing doesn't
+ * block setters.
+ */
+class FSentryStaticScopeFragment
+{
+public:
+	FSentryStaticScopeFragment();
+
+	/** Sets a top-level string attribute, e.g. release or environment. */
+	void SetAttribute(const FString& Key, const FString& Value);
+
+	void SetTag(const FString& Key, const FString& Value);
+	void RemoveTag(const FString& Key);
+
+	/** Sets a context from its value already serialized as a JSON object. */
+	void SetContext(const FString& Key, const ANSICHAR* ValueJson);
+	void RemoveContext(const FString& Key);
+
+	bool IsEmpty() const;
+
+	/** Splices the entries into the event and transaction items of a serialized envelope in place, false if the envelope wasn't changed. */
+	bool Splice(TArray<uint8>& Envelope) const;
+
+	/** Splices the entries into a serialized event, false if none were missing or the event is malformed. */
+	bool SplicePayload(const uint8* Payload, int32 Length, TArray<uint8>& OutPayload) const;
+
+private:
+	struct FEntry
+	{
+		FString Key;
+
+		/** Key serialized as a JSON string, quotes included. */
+		TArray<uint8> QuotedKey;
+
+		/** Whole member, i.e. the quoted key followed by a colon and the serialized value. */
+		TArray<uint8> Member;
+	};
+
+	struct FSnapshot
+	{
+		TArray<FEntry> Attributes;
+		TArray<FEntry> Tags;
+		TArray<FEntry> Contexts;
+	};
+
+	typedef TSharedRef<const FSnapshot, ESPMode::ThreadSafe> FSnapshotRef;
+
+	/** Creates the entry and replaces the one with the same key within the given member of a new snapshot. */
+	void SetEntry(TArray<FEntry> FSnapshot::*Entries, const FString& Key, const TArray<uint8>& ValueJson);
+	void RemoveEntry(TArray<FEntry> FSnapshot::*Entries, const FString& Key);
+
+	FSnapshotRef GetSnapshot() const;
+
+	/** Appends the members of the entries whose keys aren't among the given members, comma separated. Returns whether anything was appended. */
+	static bool AppendMissingEntries(TArray<uint8>& Out, const uint8* Data, const TArray<TPair<int32, int32>>& Keys, const TArray<FEntry>& Entries, bool bLeadingComma);
+
+	mutable FCriticalSection CriticalSection;
+	FSnapshotRef Snapshot;
+};
@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryStats.h"
+
+DEFINE_STAT(STAT_SentryBreadcrumbs);
+DEFINE_STAT(STAT_SentryLogs);
+DEFINE_STAT(STAT_SentryCaptures);
+DEFINE_STAT(STAT_SentryScopeMutations);
+DEFINE_STAT(STAT_SentryCrashVideoCapture);
+DEFINE_STAT(STAT_SentryCrashVideoEncode);
+
+DEFINE_STAT(STAT_SentryBreadcrumbsTotal);
+DEFINE_STAT(STAT_SentryLogsTotal);
+DEFINE_STAT(STAT_SentryCapturesTotal);
+DEFINE_STAT(STAT_SentryScopeMutationsTotal);
+DEFINE_STAT(STAT_SentryCrashVideoCaptureTotal);
+DEFINE_STAT(STAT_SentryCrashVideoEncodeTotal);
+
+DEFINE_STAT(STAT_SentryAttachmentMemory);
+DEFINE_STAT(STAT_SentryVideoBufferMemory);
+DEFINE_STAT(STAT_SentryAudioRingMemory);
@@ -0,0 +1,244 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryStructLayout.h"
+
+#include "SentryDefines.h"
+
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Atomic.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+namespace SentryStructLayout
+{
+	struct FCachedLayout
+	{
+		TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Layout;
+
+		/** Cache generation the layout was built in, layouts of earlier generations are rebuilt. */
+		uint32 Generation;
+	};
+
+	static FCriticalSection CacheCriticalSection;
+	static TMap<TWeakObjectPtr<const UScriptStruct>, FCachedLayout> Cache;
+
+	/** Bumped whenever the cache is reset, so that layouts built concurrently with a reset aren't kept. */
+	static TAtomic<uint32> CacheGeneration { 0 };
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	static FDelegateHandle ReloadCompleteHandle;
+#endif
+#if WITH_EDITOR
+	static FDelegateHandle ObjectsReplacedHandle;
+#endif
+
+	/** Builds the variant map of a struct, nested structs become nested maps. */
+	class FVariantWriter
+	{
+	public:
+		FVariantWriter()
+		{
+			Maps.AddDefaulted();
+		}
+
+		void WriteBool(const FSentryStructLayout::FField& Field, bool Value)
+		{
+			Maps.Last().Add(Field.Name, Value);
+		}
+
+		void WriteInteger(const FSentryStructLayout::FField& Field, int32 Value)
+		{
+			Maps.Last().Add(Field.Name, Value);
+		}
+
+		void WriteFloat(const FSentryStructLayout::FField& Field, double Value)
+		{
+			Maps.Last().Add(Field.Name, static_cast<float>(Value));
+		}
+
+		void WriteString(const FSentryStructLayout::FField& Field, const FString& Value)
+		{
+			Maps.Last().Add(Field.Name, Value);
+		}
+
+		void BeginStruct(const FSentryStructLayout::FField& Field)
+		{
+			Maps.AddDefaulted();
+		}
+
+		void EndStruct(const FSentryStructLayout::FField& Field)
+		{
+			TMap<FString, FSentryVariant> Nested = Maps.Pop();
+			Maps.Last().Add(Field.Name, MoveTemp(Nested));
+		}
+
+		TMap<FString, FSentryVariant> Finish()
+		{
+			return Maps.Pop();
+		}
+
+	private:
+		TArray<TMap<FString, FSentryVariant>, TInlineAllocator<4>> Maps;
+	};
+}
+
+TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> FSentryStructLayout::Get(const UScriptStruct* Struct)
+{
+	check(Struct);
+
+	const TWeakObjectPtr<const UScriptStruct> Key(Struct);
+
+	// Generation is read before building so that a reset in the meantime makes the layout stale right away
+	const uint32 Generation = SentryStructLayout::CacheGeneration.Load();
+
+	{
+		FScopeLock Lock(&SentryStructLayout::CacheCriticalSection);
+		if (const SentryStructLayout::FCachedLayout* Cached = SentryStructLayout::Cache.Find(Key))
+		{
+			if (Cached->Generation == Generation && Cached->Layout->IsUpToDate(Struct))
+			{
+				return Cached->Layout;
+			}
+		}
+	}
+
+	// Built outside of the lock since nested structs look up their own layouts, a concurrent build of the same type is harmless
+	TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Layout = MakeShareable(new FSentryStructLayout(Struct));
+
+	FScopeLock Lock(&SentryStructLayout::CacheCriticalSection);
+	SentryStructLayout::Cache.Add(Key, { Layout, Generation });
+	return Layout;
+}
+
+void FSentryStructLayout::ResetCache()
+{
+	FScopeLock Lock(&SentryStructLayout::CacheCriticalSection);
+	SentryStructLayout::CacheGeneration.IncrementExchange();
+	SentryStructLayout::Cache.Empty();
+}
+
+void FSentryStructLayout::BindCacheInvalidation()
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	// Live coding and hot reload replace native struct types along with their properties
+	SentryStructLayout::ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason Reason)
+	{
+		ResetCache();
+	});
+#endif
+
+#if WITH_EDITOR
+	// Recompiled Blueprints and user defined structs are reinstanced, layouts of the old types would point to freed properties
+	SentryStructLayout::ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>& ReplacedObjects)
+	{
+		ResetCache();
+	});
+#endif
+}
+
+void FSentryStructLayout::UnbindCacheInvalidation()
+{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(SentryStructLayout::ReloadCompleteHandle);
+	SentryStructLayout::ReloadCompleteHandle.Reset();
+#endif
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(SentryStructLayout::ObjectsReplacedHandle);
+	SentryStructLayout::ObjectsReplacedHandle.Reset();
+#endif
+
+	ResetCache();
+}
+
+bool FSentryStructLayout::IsUpToDate(const UScriptStruct* Struct) const
+{
+	if (Struct->ChildProperties != FirstProperty || Struct->GetPropertiesSize() != PropertiesSize)
+	{
+		return false;
+	}
+
+	for (const FField& Field : Fields)
+	{
+		if (Field.Type == EFieldType::Struct && !Field.Nested->IsUpToDate(CastFieldChecked<FStructProperty>(Field.Property)->Struct))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+TMap<FString, FSentryVariant> FSentryStructLayout::ToVariantMap(const void* StructData) const
+{
+	SentryStructLayout::FVariantWriter Writer;
+	Write(StructData, Writer);
+	return Writer.Finish();
+}
+
+FSentryStructLayout::FSentryStructLayout(const UScriptStruct* Struct)
+	: FirstProperty(Struct->ChildProperties)
+	, PropertiesSize(Struct->GetPropertiesSize())
+{
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+
+		// Static arrays would need an index per element, fixed-size arrays are rare enough in context structs to skip them
+		if (Property->ArrayDim != 1)
+		{
+			continue;
+		}
+
+		FField Field;
+		Field.Property = Property;
+
+		if (Property->IsA<FBoolProperty>())
+		{
+			Field.Type = EFieldType::Bool;
+		}
+		else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			Field.Type = EFieldType::Enum;
+			Field.NumericProperty = EnumProperty->GetUnderlyingProperty();
+			Field.Enum = EnumProperty->GetEnum();
+		}
+		else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			Field.NumericProperty = NumericProperty;
+			Field.Enum = NumericProperty->GetIntPropertyEnum();
+			Field.Type = Field.Enum ? EFieldType::Enum : NumericProperty->IsFloatingPoint() ? EFieldType::Float : EFieldType::Integer;
+		}
+		else if (Property->IsA<FStrProperty>())
+		{
+			Field.Type = EFieldType::String;
+		}
+		else if (Property->IsA<FNameProperty>())
+		{
+			Field.Type = EFieldType::Name;
+		}
+		else if (Property->IsA<FTextProperty>())
+		{
+			Field.Type = EFieldType::Text;
+		}
+		else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			Field.Type = EFieldType::Struct;
+			Field.Nested = Get(StructProperty->Struct);
+		}
+		else
+		{
+			UE_LOG(LogSentrySdk, Verbose, TEXT("Property %s of struct %s can't be added to a context and is skipped."), *Property->GetName(), *Struct->GetName());
+			continue;
+		}
+
+		Field.Name = Property->GetAuthoredName();
+
+		const FTCHARToUTF8 Utf8Name(*Field.Name);
+		Field.Utf8Name.Append(Utf8Name.Get(), Utf8Name.Length());
+		Field.Utf8Name.Add('\0');
+
+		Fields.Add(MoveTemp(Field));
+	}
+}
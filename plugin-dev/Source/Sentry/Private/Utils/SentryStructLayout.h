@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+#include "SentryVariant.h"
+
+/**
+ * Flattened description of the properties of a struct type that can be written to a context.
+ *
+ * Walking the reflection data of a struct on every call means casting each property to find out what it holds
+ * and converting its name to a key. The layout does that once per struct type, so writing a struct afterwards
+ * is a loop over plain field descriptors that read values at cached offsets straight into the native representation.
+ *
+ * Booleans, numbers, strings, names, texts, enums (written as the name of the value) and nested structs are supported.
+ * Containers and object references are skipped.
+ */
+class FSentryStructLayout
+{
+public:
+	enum class EFieldType : uint8
+	{
+		Bool,
+		Integer,
+		Float,
+		String,
+		Name,
+		Text,
+		Enum,
+		Struct
+	};
+
+	struct FField
+	{
+		/** Key of the field in the context, the authored name of the property. */
+		FString Name;
+
+		/** Key encoded as null-terminated UTF-8 for the native SDK. */
+		TArray<ANSICHAR> Utf8Name;
+
+		EFieldType Type;
+
+		const FProperty* Property;
+
+		/** Numeric property holding the value of integers, floats and enums. */
+		const FNumericProperty* NumericProperty = nullptr;
+
+		const UEnum* Enum = nullptr;
+
+		/** Layout of nested structs. */
+		TSharedPtr<const FSentryStructLayout, ESPMode::ThreadSafe> Nested;
+
+		const void* GetValuePtr(const void* StructData) const
+		{
+			return Property->ContainerPtrToValuePtr<void>(StructData);
+		}
+	};
+
+	/**
+	 * Gets the layout of the struct type, which is built on first use and cached afterwards. Safe to call from any thread.
+	 *
+	 * Cached layouts are rebuilt once the cache was reset or the properties of the struct changed, which happens to
+	 * user defined structs recompiled in place in the editor.
+	 */
+	static TSharedRef<const FSentryStructLayout, ESPMode::ThreadSafe> Get(const UScriptStruct* Struct);
+
+	/** Drops the cached layouts, e.g. after code was reloaded or Blueprint structs were recompiled. */
+	static void ResetCache();
+
+	/** Resets the cache whenever reloading or reinstancing replaces struct types. Called on module startup. */
+	static void BindCacheInvalidation();
+
+	static void UnbindCacheInvalidation();
+
+	const TArray<FField>& GetFields() const { return Fields; }
+
+	/**
+	 * Walks the struct, calling the writer for each supported field. The writer implements:
+	 *
+	 *   void WriteBool(const FField& Field, bool Value);
+	 *   void WriteInteger(const FField& Field, int32 Value);
+	 *   void WriteFloat(const FField& Field, double Value);
+	 *   void WriteString(const FField& Field, const FString& Value);
+	 *   void BeginStruct(const FField& Field);
+	 *   void EndStruct(const FField& Field);
+	 *
+	 * @param MaxDepth Max nesting of structs, 0 for no limit. Structs nested deeper are dropped.
+	 * @param MaxValues Max amount of fields written for the struct and each of its nested structs, 0 for no limit.
+	 * @return Amount of dropped values, matching the way `SentryScopeLimits::TrimContext` counts them.
+	 */
+	template <typename WriterType>
+	int32 Write(const void* StructData, WriterType& Writer, int32 MaxDepth = 0, int32 MaxValues = 0) const
+	{
+		return WriteFields(StructData, Writer, 1, MaxDepth, MaxValues);
+	}
+
+	/** Converts the struct to context values, for the code paths that keep a copy of the context. */
+	TMap<FString, FSentryVariant> ToVariantMap(const void* StructData) const;
+
+private:
+	explicit FSentryStructLayout(const UScriptStruct* Struct);
+
+	template <typename WriterType>
+	int32 WriteFields(const void* StructData, WriterType& Writer, int32 Depth, int32 MaxDepth, int32 MaxValues) const
+	{
+		int32 NumDropped = 0;
+		int32 NumWritten = 0;
+
+		for (const FField& Field : Fields)
+		{
+			if (MaxValues > 0 && NumWritten >= MaxValues)
+			{
+				++NumDropped;
+				continue;
+			}
+
+			const void* ValuePtr = Field.GetValuePtr(StructData);
+
+			switch (Field.Type)
+			{
+			case EFieldType::Bool:
+				Writer.WriteBool(Field, static_cast<const FBoolProperty*>(Field.Property)->GetPropertyValue(ValuePtr));
+				break;
+			case EFieldType::Integer:
+				Writer.WriteInteger(Field, static_cast<int32>(FMath::Clamp<int64>(Field.NumericProperty->GetSignedIntPropertyValue(ValuePtr), MIN_int32, MAX_int32)));
+				break;
+			case EFieldType::Float:
+				Writer.WriteFloat(Field, Field.NumericProperty->GetFloatingPointPropertyValue(ValuePtr));
+				break;
+			case EFieldType::String:
+				Writer.WriteString(Field, *static_cast<const FString*>(ValuePtr));
+				break;
+			case EFieldType::Name:
+				Writer.WriteString(Field, static_cast<const FName*>(ValuePtr)->ToString());
+				break;
+			case EFieldType::Text:
+				Writer.WriteString(Field, static_cast<const FText*>(ValuePtr)->ToString());
+				break;
+			case EFieldType::Enum:
+				Writer.WriteString(Field, Field.Enum->GetNameStringByValue(Field.NumericProperty->GetSignedIntPropertyValue(ValuePtr)));
+				break;
+			case EFieldType::Struct:
+				if (MaxDepth > 0 && Depth > MaxDepth)
+				{
+					++NumDropped;
+					continue;
+				}
+
+				Writer.BeginStruct(Field);
+				NumDropped += Field.Nested->WriteFields(ValuePtr, Writer, Depth + 1, MaxDepth, MaxValues);
+				Writer.EndStruct(Field);
+				break;
+			}
+
+			++NumWritten;
+		}
+
+		return NumDropped;
+	}
+
+	/** Whether the struct still has the properties the layout was built from, including nested structs. */
+	bool IsUpToDate(const UScriptStruct* Struct) const;
+
+	TArray<FField> Fields;
+
+	/** First property and size of the properties at the time the layout was built, recompiling a struct replaces both. */
+	const ::FField* FirstProperty = nullptr;
+	int32 PropertiesSize = 0;
+};
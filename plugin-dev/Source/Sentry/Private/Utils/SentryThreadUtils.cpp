@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Utils/SentryThreadUtils.h"
+
+#include "HAL/PlatformAffinity.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/EngineVersionComparison.h"
+
+EThreadPriority SentryThreadUtils::ToThreadPriority(ESentryThreadPriority Priority)
+{
+	switch (Priority)
+	{
+	case ESentryThreadPriority::Lowest:
+		return TPri_Lowest;
+	case ESentryThreadPriority::Normal:
+		return TPri_Normal;
+	case ESentryThreadPriority::AboveNormal:
+		return TPri_AboveNormal;
+	default:
+		return TPri_BelowNormal;
+	}
+}
+
+uint64 SentryThreadUtils::ToAffinityMask(int64 AffinityMask)
+{
+	return AffinityMask != 0 ? static_cast<uint64>(AffinityMask) : FPlatformAffinity::GetNoAffinityMask();
+}
+
+int32 SentryThreadUtils::ApplyToThreads(const FString& NameFilter, EThreadPriority Priority, uint64 AffinityMask)
+{
+	if (NameFilter.IsEmpty())
+	{
+		return 0;
+	}
+
+	int32 NumThreads = 0;
+
+	FThreadManager::Get().ForEachThread([&NameFilter, Priority, AffinityMask, &NumThreads](uint32 ThreadId, FRunnableThread* Thread)
+	{
+		if (!Thread->GetThreadName().Contains(NameFilter))
+		{
+			return;
+		}
+
+		Thread->SetThreadPriority(Priority);
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+		if (AffinityMask != FPlatformAffinity::GetNoAffinityMask())
+		{
+			Thread->SetThreadAffinity(FThreadAffinity{ AffinityMask });
+		}
+#endif
+
+		++NumThreads;
+	});
+
+	return NumThreads;
+}
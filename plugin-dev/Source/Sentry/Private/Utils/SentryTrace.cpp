@@ -0,0 +1,10 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(SentryChannel)
+
+TRACE_DECLARE_INT_COUNTER(SentryEventsCaptured, TEXT("Sentry/EventsCaptured"));
+TRACE_DECLARE_INT_COUNTER(SentryBreadcrumbsAdded, TEXT("Sentry/BreadcrumbsAdded"));
+TRACE_DECLARE_INT_COUNTER(SentryLogsForwarded, TEXT("Sentry/LogsForwarded"));
+TRACE_DECLARE_INT_COUNTER(SentryBytesAttached, TEXT("Sentry/BytesAttached"));
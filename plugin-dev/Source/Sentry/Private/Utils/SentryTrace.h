@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+/**
+ * Unreal Insights instrumentation of the SDK hot paths.
+ * CPU scopes are emitted on a dedicated channel which can be enabled with `-trace=cpu,sentry`.
+ */
+UE_TRACE_CHANNEL_EXTERN(SentryChannel)
+
+/** Marks the enclosing scope as a CPU event on the Sentry trace channel. */
+#define SENTRY_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Sentry_##Name, SentryChannel)
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(SentryEventsCaptured);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SentryBreadcrumbsAdded);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SentryLogsForwarded);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SentryBytesAttached);
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTraceSampleRules.h"
+
+#include "SentrySettings.h"
+
+#include "Containers/StringConv.h"
+
+FSentryTraceSampleRules::FSentryTraceSampleRules(const TArray<FSentryTraceSampleRule>& Rules, float InDefaultSampleRate)
+	: DefaultSampleRate(FMath::Clamp(InDefaultSampleRate, 0.0f, 1.0f))
+{
+	CompiledRules.Reserve(Rules.Num());
+
+	for (const FSentryTraceSampleRule& Rule : Rules)
+	{
+		FTCHARToUTF8 Utf8Prefix(*Rule.Prefix);
+
+		FCompiledRule& CompiledRule = CompiledRules.AddDefaulted_GetRef();
+		CompiledRule.Prefix.Append(reinterpret_cast<const ANSICHAR*>(Utf8Prefix.Get()), Utf8Prefix.Length());
+		CompiledRule.bMatchOperation = Rule.Target == ESentryTraceSampleRuleTarget::Operation;
+		CompiledRule.SampleRate = FMath::Clamp(Rule.SampleRate, 0.0f, 1.0f);
+	}
+}
+
+double FSentryTraceSampleRules::GetSampleRate(const ANSICHAR* Name, const ANSICHAR* Operation) const
+{
+	for (const FCompiledRule& Rule : CompiledRules)
+	{
+		if (StartsWith(Rule.bMatchOperation ? Operation : Name, Rule.Prefix))
+		{
+			return Rule.SampleRate;
+		}
+	}
+
+	return DefaultSampleRate;
+}
+
+bool FSentryTraceSampleRules::StartsWith(const ANSICHAR* Str, const TArray<ANSICHAR>& Prefix)
+{
+	if (Prefix.Num() == 0)
+	{
+		return true;
+	}
+
+	return Str && FCStringAnsi::Strncmp(Str, Prefix.GetData(), Prefix.Num()) == 0;
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSentryTraceSampleRule;
+
+/**
+ * Sample rate rules by transaction name or operation prefix, compiled once at initialization.
+ *
+ * Evaluating the rules doesn't allocate or touch any UObjects, so it's safe during garbage collection and from any thread.
+ */
+class FSentryTraceSampleRules
+{
+public:
+	FSentryTraceSampleRules(const TArray<FSentryTraceSampleRule>& Rules, float InDefaultSampleRate);
+
+	/** Gets the sample rate of the first rule matching the given UTF-8 name or operation, the default sample rate if none does. */
+	double GetSampleRate(const ANSICHAR* Name, const ANSICHAR* Operation) const;
+
+	bool IsEmpty() const { return CompiledRules.Num() == 0; }
+
+private:
+	struct FCompiledRule
+	{
+		/** UTF-8 encoded prefix without a terminator */
+		TArray<ANSICHAR> Prefix;
+
+		bool bMatchOperation;
+		double SampleRate;
+	};
+
+	static bool StartsWith(const ANSICHAR* Str, const TArray<ANSICHAR>& Prefix);
+
+	TArray<FCompiledRule> CompiledRules;
+	double DefaultSampleRate;
+};
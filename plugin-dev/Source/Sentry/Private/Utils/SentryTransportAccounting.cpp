@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryTransportAccounting.h"
+
+#include "HAL/PlatformTime.h"
+#include "Templates/Atomic.h"
+
+namespace SentryTransportAccounting
+{
+	static TAtomic<bool> bTracked { false };
+
+	static TAtomic<int32> NumQueuedEnvelopes { 0 };
+	static TAtomic<int64> QueuedBytes { 0 };
+	static TAtomic<int32> NumRequestsInFlight { 0 };
+	static TAtomic<int32> NumSpooledEnvelopes { 0 };
+	static TAtomic<int64> SpooledBytes { 0 };
+
+	static TAtomic<float> LastSendLatencyMs { 0.0f };
+	static TAtomic<int64> NumSentRequests { 0 };
+	static TAtomic<int64> NumFailedRequests { 0 };
+	static TAtomic<int64> NumRateLimitedEnvelopes { 0 };
+
+	static TAtomic<double> RateLimitedUntil { 0.0 };
+	static TAtomic<double> OfflineUntil { 0.0 };
+
+	static TAtomic<float> AdaptiveSampleRate { 1.0f };
+}
+
+void SentryTransportAccounting::SetTracked(bool bIsTracked)
+{
+	bTracked = bIsTracked;
+}
+
+void SentryTransportAccounting::SetBacklog(int32 InNumQueuedEnvelopes, int64 InQueuedBytes, int32 InNumRequestsInFlight, int32 InNumSpooledEnvelopes, int64 InSpooledBytes)
+{
+	NumQueuedEnvelopes = InNumQueuedEnvelopes;
+	QueuedBytes = InQueuedBytes;
+	NumRequestsInFlight = InNumRequestsInFlight;
+	NumSpooledEnvelopes = InNumSpooledEnvelopes;
+	SpooledBytes = InSpooledBytes;
+}
+
+void SentryTransportAccounting::RecordRequest(double LatencySeconds, bool bSucceeded)
+{
+	LastSendLatencyMs = static_cast<float>(LatencySeconds * 1000.0);
+
+	if (bSucceeded)
+	{
+		++NumSentRequests;
+	}
+	else
+	{
+		++NumFailedRequests;
+	}
+}
+
+void SentryTransportAccounting::RecordRateLimitedEnvelope()
+{
+	++NumRateLimitedEnvelopes;
+}
+
+void SentryTransportAccounting::SetRateLimitedUntil(double Time)
+{
+	RateLimitedUntil = Time;
+}
+
+void SentryTransportAccounting::SetOfflineUntil(double Time)
+{
+	OfflineUntil = Time;
+}
+
+void SentryTransportAccounting::SetAdaptiveSampleRate(float SampleRate)
+{
+	AdaptiveSampleRate = SampleRate;
+}
+
+FSentryTransportStats SentryTransportAccounting::GetStats()
+{
+	FSentryTransportStats Stats;
+	Stats.bIsTracked = bTracked.Load();
+	Stats.NumQueuedEnvelopes = NumQueuedEnvelopes.Load();
+	Stats.QueuedBytes = QueuedBytes.Load();
+	Stats.NumRequestsInFlight = NumRequestsInFlight.Load();
+	Stats.NumSpooledEnvelopes = NumSpooledEnvelopes.Load();
+	Stats.SpooledBytes = SpooledBytes.Load();
+	Stats.LastSendLatencyMs = LastSendLatencyMs.Load();
+	Stats.NumSentRequests = NumSentRequests.Load();
+	Stats.NumFailedRequests = NumFailedRequests.Load();
+	Stats.NumRateLimitedEnvelopes = NumRateLimitedEnvelopes.Load();
+	Stats.AdaptiveSampleRate = AdaptiveSampleRate.Load();
+
+	const double Now = FPlatformTime::Seconds();
+
+	Stats.RateLimitRemainingSeconds = static_cast<float>(FMath::Max(0.0, RateLimitedUntil.Load() - Now));
+	Stats.bIsRateLimited = Stats.RateLimitRemainingSeconds > 0.0f;
+	Stats.bIsOffline = OfflineUntil.Load() > Now;
+
+	return Stats;
+}
+
+void SentryTransportAccounting::Reset()
+{
+	bTracked = false;
+	SetBacklog(0, 0, 0, 0, 0);
+	LastSendLatencyMs = 0.0f;
+	NumSentRequests = 0;
+	NumFailedRequests = 0;
+	NumRateLimitedEnvelopes = 0;
+	RateLimitedUntil = 0.0;
+	OfflineUntil = 0.0;
+	AdaptiveSampleRate = 1.0f;
+}
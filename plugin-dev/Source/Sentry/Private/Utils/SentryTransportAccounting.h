@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryTransportStats.h"
+
+/**
+ * Upload pipeline state published by the transport. All values are kept in atomics so that reading them
+ * from the game thread every frame never waits for the transport thread.
+ */
+namespace SentryTransportAccounting
+{
+	/** Marks the stats as reported by an active transport. */
+	void SetTracked(bool bIsTracked);
+
+	void SetBacklog(int32 NumQueuedEnvelopes, int64 QueuedBytes, int32 NumRequestsInFlight, int32 NumSpooledEnvelopes, int64 SpooledBytes);
+
+	/** Records a completed request, the latency is measured from the time it was sent. */
+	void RecordRequest(double LatencySeconds, bool bSucceeded);
+
+	void RecordRateLimitedEnvelope();
+
+	/** Sets the time until which the server asked to back off, in FPlatformTime::Seconds. */
+	void SetRateLimitedUntil(double Time);
+
+	/** Sets the time until which the server is considered unreachable, in FPlatformTime::Seconds. */
+	void SetOfflineUntil(double Time);
+
+	void SetAdaptiveSampleRate(float SampleRate);
+
+	FSentryTransportStats GetStats();
+
+	void Reset();
+}
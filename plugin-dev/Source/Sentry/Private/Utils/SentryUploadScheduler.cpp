@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryUploadScheduler.h"
+
+FSentryUploadScheduler::FSentryUploadScheduler(int64 InMaxBytesPerSecond, int64 InLargeUploadSize, bool bInHoldDuringMatch)
+	: MaxBytesPerSecond(FMath::Max<int64>(0, InMaxBytesPerSecond))
+	, LargeUploadSize(FMath::Max<int64>(0, InLargeUploadSize))
+	, bHoldDuringMatch(bInHoldDuringMatch)
+	, Budget(static_cast<double>(MaxBytesPerSecond))
+{
+}
+
+void FSentryUploadScheduler::Schedule(int64 Size, TFunction<void()>&& Upload)
+{
+	PendingUploads.Add({ Size, MoveTemp(Upload) });
+}
+
+void FSentryUploadScheduler::Tick(float DeltaSeconds, bool bIsMatchInProgress, bool bIsTransportBackedUp)
+{
+	// Budget can only build up to one second worth of bandwidth so that idle time doesn't allow a burst later
+	if (MaxBytesPerSecond > 0)
+	{
+		Budget = FMath::Min(Budget + MaxBytesPerSecond * static_cast<double>(DeltaSeconds), static_cast<double>(MaxBytesPerSecond));
+	}
+
+	// Large uploads started now would only pile up on disk or be dropped, small ones are spooled by the transport
+	const bool bHoldLargeUploads = (bIsMatchInProgress && bHoldDuringMatch) || bIsTransportBackedUp;
+
+	int32 Index = 0;
+	while (Index < PendingUploads.Num())
+	{
+		const int64 Size = PendingUploads[Index].Size;
+
+		// Smaller uploads scheduled later can still go while a large one is held
+		if (bHoldLargeUploads && LargeUploadSize > 0 && Size >= LargeUploadSize)
+		{
+			Index++;
+			continue;
+		}
+
+		if (!IsWithinBudget(Size))
+		{
+			break;
+		}
+
+		if (MaxBytesPerSecond > 0)
+		{
+			Budget -= Size;
+		}
+
+		// Upload may schedule another one so it's taken out of the array before it runs
+		TFunction<void()> Upload = MoveTemp(PendingUploads[Index].Upload);
+		PendingUploads.RemoveAt(Index);
+
+		Upload();
+	}
+}
+
+void FSentryUploadScheduler::Flush()
+{
+	// Uploads may schedule others, which are flushed along with them
+	while (PendingUploads.Num() > 0)
+	{
+		TFunction<void()> Upload = MoveTemp(PendingUploads[0].Upload);
+		PendingUploads.RemoveAt(0);
+
+		Upload();
+	}
+}
+
+bool FSentryUploadScheduler::IsWithinBudget(int64 Size) const
+{
+	if (MaxBytesPerSecond <= 0)
+	{
+		return true;
+	}
+
+	// Uploads larger than a second worth of bandwidth wait for the full budget and leave it negative for a while
+	return Budget >= FMath::Min(static_cast<double>(Size), static_cast<double>(MaxBytesPerSecond));
+}
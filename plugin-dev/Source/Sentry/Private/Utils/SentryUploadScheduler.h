@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Paces uploads of large attachments so that they don't compete with game networking.
+ *
+ * Uploads are started in order of scheduling once the bandwidth budget allows. Uploads above the large upload size
+ * are held while a networked match is in progress, if enabled, and while the transport is backed up, i.e. offline or
+ * rate limited, and let through once that ends. Smaller uploads are left to the transport, which spools them to disk
+ * while offline. Since every upload is sent by the platform SDK as a whole, the bandwidth ceiling is kept on average
+ * over time. Not thread-safe.
+ */
+class FSentryUploadScheduler
+{
+public:
+	/**
+	 * @param InMaxBytesPerSecond Average upload rate to keep under, 0 for no limit.
+	 * @param InLargeUploadSize Size from which uploads are held, 0 to never hold uploads.
+	 * @param bInHoldDuringMatch Whether large uploads are held during matches, in addition to while the transport is backed up.
+	 */
+	FSentryUploadScheduler(int64 InMaxBytesPerSecond, int64 InLargeUploadSize, bool bInHoldDuringMatch = true);
+
+	/** Adds an upload of the given size, started from a later Tick. */
+	void Schedule(int64 Size, TFunction<void()>&& Upload);
+
+	/** Starts the uploads the bandwidth budget, the match state and the transport state allow. */
+	void Tick(float DeltaSeconds, bool bIsMatchInProgress, bool bIsTransportBackedUp = false);
+
+	/** Starts all pending uploads regardless of the budget, leaving them to the transport. Called before shutting down. */
+	void Flush();
+
+	int32 GetNumPending() const { return PendingUploads.Num(); }
+
+	/** Gets the bytes that can be uploaded right away, negative while a large upload is being paid off. */
+	double GetBudget() const { return Budget; }
+
+private:
+	struct FPendingUpload
+	{
+		int64 Size;
+		TFunction<void()> Upload;
+	};
+
+	bool IsWithinBudget(int64 Size) const;
+
+	const int64 MaxBytesPerSecond;
+	const int64 LargeUploadSize;
+	const bool bHoldDuringMatch;
+
+	TArray<FPendingUpload> PendingUploads;
+
+	double Budget;
+};
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryWorldScopes.h"
+
+#include "SentryScope.h"
+
+#include "Utils/SentryMemoryAccounting.h"
+
+#include "Misc/ScopeLock.h"
+
+void FSentryWorldScopes::SetTag(FObjectKey World, const FString& Key, const FString& Value)
+{
+	TSharedRef<FWorldScope, ESPMode::ThreadSafe> Scope = FindOrAdd(World);
+
+	FScopeLock Lock(&Scope->CriticalSection);
+	Scope->Data.Tags.Add(Key, Value);
+}
+
+void FSentryWorldScopes::RemoveTag(FObjectKey World, const FString& Key)
+{
+	if (TSharedPtr<FWorldScope, ESPMode::ThreadSafe> Scope = Find(World))
+	{
+		FScopeLock Lock(&Scope->CriticalSection);
+		Scope->Data.Tags.Remove(Key);
+	}
+}
+
+void FSentryWorldScopes::SetContext(FObjectKey World, const FString& Key, const TMap<FString, FSentryVariant>& Values)
+{
+	TSharedRef<FWorldScope, ESPMode::ThreadSafe> Scope = FindOrAdd(World);
+
+	FScopeLock Lock(&Scope->CriticalSection);
+	Scope->Data.Contexts.Add(Key, Values);
+}
+
+void FSentryWorldScopes::RemoveContext(FObjectKey World, const FString& Key)
+{
+	if (TSharedPtr<FWorldScope, ESPMode::ThreadSafe> Scope = Find(World))
+	{
+		FScopeLock Lock(&Scope->CriticalSection);
+		Scope->Data.Contexts.Remove(Key);
+	}
+}
+
+void FSentryWorldScopes::Clear(FObjectKey World)
+{
+	FWriteScopeLock Lock(ScopesLock);
+	Scopes.Remove(World);
+}
+
+bool FSentryWorldScopes::GetSnapshot(FObjectKey World, FSnapshot& OutSnapshot) const
+{
+	TSharedPtr<FWorldScope, ESPMode::ThreadSafe> Scope = Find(World);
+	if (!Scope)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&Scope->CriticalSection);
+	OutSnapshot = Scope->Data;
+
+	return true;
+}
+
+void FSentryWorldScopes::Apply(FObjectKey World, USentryScope* Scope) const
+{
+	FSnapshot Snapshot;
+	if (!Scope || !GetSnapshot(World, Snapshot))
+	{
+		return;
+	}
+
+	// Scope of the world is copied first so that its lock isn't held while the native scope is updated
+	if (Snapshot.Tags.Num() > 0)
+	{
+		Scope->SetTags(Snapshot.Tags);
+	}
+
+	for (const auto& Context : Snapshot.Contexts)
+	{
+		Scope->SetContext(Context.Key, Context.Value);
+	}
+}
+
+int32 FSentryWorldScopes::Num() const
+{
+	FReadScopeLock Lock(ScopesLock);
+	return Scopes.Num();
+}
+
+SIZE_T FSentryWorldScopes::GetAllocatedSize() const
+{
+	FReadScopeLock Lock(ScopesLock);
+
+	SIZE_T Size = Scopes.GetAllocatedSize();
+	for (const auto& Scope : Scopes)
+	{
+		FScopeLock ScopeLock(&Scope.Value->CriticalSection);
+		Size += sizeof(FWorldScope) + SentryMemoryAccounting::GetAllocatedSize(Scope.Value->Data.Tags) + SentryMemoryAccounting::GetAllocatedSize(Scope.Value->Data.Contexts);
+	}
+
+	return Size;
+}
+
+TSharedPtr<FSentryWorldScopes::FWorldScope, ESPMode::ThreadSafe> FSentryWorldScopes::Find(FObjectKey World) const
+{
+	FReadScopeLock Lock(ScopesLock);
+
+	if (const TSharedRef<FWorldScope, ESPMode::ThreadSafe>* Scope = Scopes.Find(World))
+	{
+		return *Scope;
+	}
+
+	return nullptr;
+}
+
+TSharedRef<FSentryWorldScopes::FWorldScope, ESPMode::ThreadSafe> FSentryWorldScopes::FindOrAdd(FObjectKey World)
+{
+	if (TSharedPtr<FWorldScope, ESPMode::ThreadSafe> Scope = Find(World))
+	{
+		return Scope.ToSharedRef();
+	}
+
+	FWriteScopeLock Lock(ScopesLock);
+
+	// Another thread may have added the scope between the locks
+	if (const TSharedRef<FWorldScope, ESPMode::ThreadSafe>* Scope = Scopes.Find(World))
+	{
+		return *Scope;
+	}
+
+	return Scopes.Add(World, MakeShared<FWorldScope, ESPMode::ThreadSafe>());
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+#include "SentryVariant.h"
+
+class USentryScope;
+
+/**
+ * Independent scopes of the worlds running in the same process, e.g. several matches hosted by one dedicated server.
+ *
+ * Tags and contexts set for a world never reach the global scope of the native SDK, they are applied to the local
+ * scope of the events captured for that world only. Every world has its own lock, so matches updating their scopes
+ * concurrently only contend on the shared read lock of the lookup.
+ */
+class FSentryWorldScopes
+{
+public:
+	struct FSnapshot
+	{
+		TMap<FString, FString> Tags;
+		TMap<FString, TMap<FString, FSentryVariant>> Contexts;
+	};
+
+	void SetTag(FObjectKey World, const FString& Key, const FString& Value);
+	void RemoveTag(FObjectKey World, const FString& Key);
+	void SetContext(FObjectKey World, const FString& Key, const TMap<FString, FSentryVariant>& Values);
+	void RemoveContext(FObjectKey World, const FString& Key);
+
+	/** Discards the scope of the world, called once the world is cleaned up. */
+	void Clear(FObjectKey World);
+
+	/** Copies the current scope of the world, false if nothing was set for it. */
+	bool GetSnapshot(FObjectKey World, FSnapshot& OutSnapshot) const;
+
+	/** Applies the scope of the world to the local scope of an event. */
+	void Apply(FObjectKey World, USentryScope* Scope) const;
+
+	/** Number of worlds with a scope. */
+	int32 Num() const;
+
+	/** Memory held by the scopes of all worlds. */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FWorldScope
+	{
+		FCriticalSection CriticalSection;
+		FSnapshot Data;
+	};
+
+	TSharedPtr<FWorldScope, ESPMode::ThreadSafe> Find(FObjectKey World) const;
+	TSharedRef<FWorldScope, ESPMode::ThreadSafe> FindOrAdd(FObjectKey World);
+
+	mutable FRWLock ScopesLock;
+	TMap<FObjectKey, TSharedRef<FWorldScope, ESPMode::ThreadSafe>> Scopes;
+};
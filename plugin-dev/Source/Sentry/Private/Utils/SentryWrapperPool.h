@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+class ISentryBreadcrumb;
+class ISentryEvent;
+class ISentryLog;
+class USentryBreadcrumb;
+class USentryEvent;
+class USentryLog;
+
+/**
+ * Pool of rooted wrapper objects handed to the before-send, before-breadcrumb and before-log handlers.
+ *
+ * Every callback used to create a new UObject only to drop it once the handler returned, which under log-heavy
+ * sessions adds up to noticeable garbage collection work. Pooled objects stay rooted and get a new native
+ * implementation for every callback, so once the pool is warm callbacks don't create any UObjects. Objects are
+ * only valid for the duration of the handler call and mustn't be kept by handlers.
+ */
+template<class Interface, class Unreal>
+class TSentryWrapperPool
+{
+public:
+	/** Object acquired from the pool for the lifetime of the scope. */
+	class FScopedObject
+	{
+	public:
+		explicit FScopedObject(TSharedPtr<Interface> InNativeImpl)
+			: Generation(TSentryWrapperPool::Get().GetGeneration())
+			, Object(TSentryWrapperPool::Get().Acquire(MoveTemp(InNativeImpl)))
+		{
+		}
+
+		~FScopedObject()
+		{
+			TSentryWrapperPool::Get().Release(Object, Generation);
+		}
+
+		FScopedObject(const FScopedObject&) = delete;
+		FScopedObject& operator=(const FScopedObject&) = delete;
+
+		Unreal* Get() const { return Object; }
+
+	private:
+		uint32 Generation;
+		Unreal* Object;
+	};
+
+	static TSentryWrapperPool& Get()
+	{
+		static TSentryWrapperPool Instance;
+		return Instance;
+	}
+
+	/** Gets a pooled object wrapping the given native implementation, creates a new one if the pool is empty. */
+	Unreal* Acquire(TSharedPtr<Interface> InNativeImpl)
+	{
+		if (!InNativeImpl)
+		{
+			return nullptr;
+		}
+
+		{
+			FScopeLock Lock(&CriticalSection);
+
+			if (FreeObjects.Num() > 0)
+			{
+				Unreal* Object = FreeObjects.Pop();
+				Unreal::SetNativeObject(Object, MoveTemp(InNativeImpl));
+				return Object;
+			}
+		}
+
+		Unreal* Object = Unreal::Create(MoveTemp(InNativeImpl));
+		Object->AddToRoot();
+		return Object;
+	}
+
+	/** Returns the object to the pool and releases its native implementation. */
+	void Release(Unreal* Object)
+	{
+		Release(Object, GetGeneration());
+	}
+
+	/**
+	 * Unroots and forgets the pooled objects so that none of them outlive the SDK, called when it's closed.
+	 * Objects still in use by a handler are unrooted once released instead of going back to the pool.
+	 */
+	void Reset()
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		// Objects are already gone if UObjects were shut down first
+		if (UObjectInitialized())
+		{
+			for (Unreal* Object : FreeObjects)
+			{
+				Object->RemoveFromRoot();
+			}
+		}
+
+		FreeObjects.Empty();
+		++Generation;
+	}
+
+	/** Gets the number of objects waiting to be reused. */
+	int32 GetNumFree() const
+	{
+		FScopeLock Lock(&CriticalSection);
+		return FreeObjects.Num();
+	}
+
+private:
+	static constexpr int32 MaxPooledObjects = 8;
+
+	TSentryWrapperPool() = default;
+
+	uint32 GetGeneration() const
+	{
+		FScopeLock Lock(&CriticalSection);
+		return Generation;
+	}
+
+	void Release(Unreal* Object, uint32 AcquiredGeneration)
+	{
+		if (!Object)
+		{
+			return;
+		}
+
+		Unreal::SetNativeObject(Object, nullptr);
+
+		FScopeLock Lock(&CriticalSection);
+
+		// Callbacks running in parallel may need more objects for a moment than are worth keeping around
+		if (FreeObjects.Num() >= MaxPooledObjects || AcquiredGeneration != Generation)
+		{
+			Object->RemoveFromRoot();
+			return;
+		}
+
+		FreeObjects.Push(Object);
+	}
+
+	mutable FCriticalSection CriticalSection;
+
+	TArray<Unreal*> FreeObjects;
+
+	/** Incremented on every reset so that objects acquired before it aren't pooled again. */
+	uint32 Generation = 0;
+};
+
+using FSentryEventWrapperPool = TSentryWrapperPool<ISentryEvent, USentryEvent>;
+using FSentryBreadcrumbWrapperPool = TSentryWrapperPool<ISentryBreadcrumb, USentryBreadcrumb>;
+using FSentryLogWrapperPool = TSentryWrapperPool<ISentryLog, USentryLog>;
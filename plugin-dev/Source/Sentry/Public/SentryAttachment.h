@@ -10,6 +10,9 @@
 
 class ISentryAttachment;
 
+/** Fills the buffer with the next chunk of attachment data. Returns the number of bytes written, 0 once all data was read or a negative value on error. */
+typedef TFunction<int64(uint8* Buffer, int64 BufferSize)> FSentryAttachmentReader;
+
 /**
  * Additional file to store alongside an event or transaction.
  */
@@ -29,6 +32,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void InitializeWithData(const TArray<uint8>& Data, const FString& Filename, const FString& ContentType = FString(TEXT("application/octet-stream")));
 
+	/**
+	 * Initializes an attachment with bytes and a filename, taking over the data instead of copying it.
+	 *
+	 * @param Data The data for the attachment.
+	 * @param Filename The name of the attachment to display in Sentry.
+	 * @param ContentType The content type of the attachment. Default is "application/octet-stream".
+	 */
+	void InitializeWithData(TArray<uint8>&& Data, const FString& Filename, const FString& ContentType = FString(TEXT("application/octet-stream")));
+
+	/**
+	 * Initializes an attachment with data streamed from the reader into a temporary file, so that large generated data
+	 * (e.g. save game snapshots or replays) doesn't have to be held in memory. The file is read when an event is captured
+	 * and deleted once the attachment is no longer referenced.
+	 *
+	 * @param Reader The reader providing the data for the attachment in chunks.
+	 * @param Filename The name of the attachment to display in Sentry.
+	 * @param ContentType The content type of the attachment. Default is "application/octet-stream".
+	 *
+	 * @return False if the data couldn't be read or written to the temporary file.
+	 */
+	bool InitializeWithReader(const FSentryAttachmentReader& Reader, const FString& Filename, const FString& ContentType = FString(TEXT("application/octet-stream")));
+
+	/** Checks whether the attachment data lives in a temporary file that is deleted along with the attachment. */
+	bool IsStreamed() const;
+
+	/** Removes temporary files of streamed attachments left by previous sessions. */
+	static void CleanupStreamedFiles();
+
 	/**
 	 * Initializes an attachment with a path and a filename.
 	 *
@@ -15,6 +15,7 @@ class SENTRY_API USentryBeforeBreadcrumbHandler : public UObject
 	GENERATED_BODY()
 
 public:
+	/** The breadcrumb object is reused once the handler returns, so it mustn't be kept past the call. */
 	UFUNCTION(BlueprintNativeEvent)
 	USentryBreadcrumb* HandleBeforeBreadcrumb(USentryBreadcrumb* Breadcrumb, USentryHint* Hint);
 	virtual USentryBreadcrumb* HandleBeforeBreadcrumb_Implementation(USentryBreadcrumb* Breadcrumb, USentryHint* Hint);
@@ -15,6 +15,7 @@ class SENTRY_API USentryBeforeLogHandler : public UObject
 	GENERATED_BODY()
 
 public:
+	/** The log object is reused once the handler returns, so it mustn't be kept past the call. */
 	UFUNCTION(BlueprintNativeEvent)
 	USentryLog* HandleBeforeLog(USentryLog* LogData);
 	virtual USentryLog* HandleBeforeLog_Implementation(USentryLog* LogData);
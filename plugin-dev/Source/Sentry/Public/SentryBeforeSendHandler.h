@@ -15,6 +15,7 @@ class SENTRY_API USentryBeforeSendHandler : public UObject
 	GENERATED_BODY()
 
 public:
+	/** The event object is reused once the handler returns, so it mustn't be kept past the call. */
 	UFUNCTION(BlueprintNativeEvent)
 	USentryEvent* HandleBeforeSend(USentryEvent* Event, USentryHint* Hint);
 	virtual USentryEvent* HandleBeforeSend_Implementation(USentryEvent* Event, USentryHint* Hint);
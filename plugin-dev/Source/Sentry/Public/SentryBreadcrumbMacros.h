@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryDataTypes.h"
+#include "SentryVariant.h"
+
+/**
+ * Lowest breadcrumb level compiled in by the SENTRY_BREADCRUMB macros (0 - Debug, 4 - Fatal).
+ * Define it in the game module build rules, e.g. as 2 to strip debug and info breadcrumbs from shipping builds.
+ */
+#ifndef SENTRY_BREADCRUMB_COMPILED_MIN_LEVEL
+#define SENTRY_BREADCRUMB_COMPILED_MIN_LEVEL 0
+#endif
+
+namespace SentryBreadcrumbs
+{
+	/** Bit per ESentryLevel that is currently recorded, updated when Sentry is initialized or closed. */
+	extern SENTRY_API uint8 EnabledLevelMask;
+
+	FORCEINLINE bool IsLevelEnabled(ESentryLevel Level)
+	{
+		return (EnabledLevelMask & (1 << static_cast<uint8>(Level))) != 0;
+	}
+
+	/** Adds a breadcrumb of the default type via Sentry engine subsystem. Use SENTRY_BREADCRUMB macros instead of calling it directly. */
+	SENTRY_API void Add(ESentryLevel Level, const TCHAR* Category, const FString& Message, const TMap<FString, FSentryVariant>& Data);
+}
+
+/** Checks whether breadcrumbs of the given level (e.g. Info) are both compiled in and currently recorded. */
+#define SENTRY_BREADCRUMB_IS_ENABLED(Level) \
+	(static_cast<uint8>(ESentryLevel::Level) >= SENTRY_BREADCRUMB_COMPILED_MIN_LEVEL && SentryBreadcrumbs::IsLevelEnabled(ESentryLevel::Level))
+
+/**
+ * Adds a breadcrumb with a printf-style formatted message. Arguments are evaluated only if the level is recorded.
+ *
+ * Example: SENTRY_BREADCRUMB(Info, TEXT("Gameplay"), TEXT("Checkpoint %d reached"), CheckpointIndex);
+ */
+#define SENTRY_BREADCRUMB(Level, Category, Format, ...) \
+	do \
+	{ \
+		if (SENTRY_BREADCRUMB_IS_ENABLED(Level)) \
+		{ \
+			SentryBreadcrumbs::Add(ESentryLevel::Level, Category, FString::Printf(Format, ##__VA_ARGS__), TMap<FString, FSentryVariant>()); \
+		} \
+	} while (0)
+
+/**
+ * Adds a breadcrumb with data. Message and data are evaluated only if the level is recorded.
+ *
+ * Example: SENTRY_BREADCRUMB_DATA(Info, TEXT("Gameplay"), TEXT("Checkpoint reached"), { { TEXT("Index"), CheckpointIndex } });
+ */
+#define SENTRY_BREADCRUMB_DATA(Level, Category, Message, ...) \
+	do \
+	{ \
+		if (SENTRY_BREADCRUMB_IS_ENABLED(Level)) \
+		{ \
+			SentryBreadcrumbs::Add(ESentryLevel::Level, Category, Message, __VA_ARGS__); \
+		} \
+	} while (0)
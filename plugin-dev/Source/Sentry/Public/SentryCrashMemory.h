@@ -0,0 +1,24 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace SentryCrashMemory
+{
+	/**
+	 * Registers a memory region to be dumped into the crash_memory.bin attachment of crash reports on Windows/Linux,
+	 * e.g. the current game state struct, recent network packets or allocator stats. The memory is only read when
+	 * a crash happens. The total size is limited by the plugin settings.
+	 *
+	 * @param Name Name the region is stored under.
+	 * @param Address Start of the region, has to stay valid until the region is unregistered.
+	 * @param Size Size of the region in bytes.
+	 *
+	 * @return Handle to unregister the region with, INDEX_NONE if it couldn't be registered.
+	 */
+	SENTRY_API int32 RegisterRegion(const FString& Name, const void* Address, int32 Size);
+
+	/** Unregisters the memory region, has to be called before its memory is freed. */
+	SENTRY_API void UnregisterRegion(int32 Handle);
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hooks of the optional SentryVideo module into the core crash handling.
+ *
+ * Video recording lives in its own module so that targets which don't use it don't pay for it. The module registers
+ * itself with `FSentryModule::SetCrashVideoCapture` on startup and the core module only talks to it through this interface.
+ * Segment and raw frame rings are owned by the core module since they're flushed by the crash handler directly.
+ */
+class ISentryCrashVideoCapture
+{
+public:
+	virtual ~ISentryCrashVideoCapture() = default;
+
+	/**
+	 * Resolves where the emergency clip is going to be written. Called when the SDK is initialized so that
+	 * the crash handler doesn't have to build paths.
+	 *
+	 * @param Directory Directory to write the clip to.
+	 * @return Path to the clip written by EncodeEmergencyClip.
+	 */
+	virtual FString PrepareEmergencyClip(const FString& Directory) = 0;
+
+	/**
+	 * Encodes the in-memory recording of the video recorder into the clip prepared by PrepareEmergencyClip right away.
+	 * Called from the crash handler.
+	 *
+	 * @return True if the clip was encoded, false if there is no recording in progress or encoding failed.
+	 */
+	virtual bool EncodeEmergencyClip() = 0;
+
+	/**
+	 * Sends a clip of the recent gameplay as a separate event without interrupting the recording. Called on the game thread.
+	 *
+	 * @param RelatedEventId ID of the event the clip belongs to.
+	 * @return True if a clip is being sent.
+	 */
+	virtual bool CaptureSnapshotClip(const FString& RelatedEventId) = 0;
+};
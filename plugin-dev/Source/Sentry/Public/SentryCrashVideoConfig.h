@@ -0,0 +1,271 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SentryDataTypes.h"
+#include "SentryCrashVideoConfig.generated.h"
+
+USTRUCT(BlueprintType)
+struct SENTRY_API FCrashVideoConfig
+{
+	GENERATED_BODY()
+
+	/** Number of seconds to keep in the recording buffer (5-600 seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	float LastSecondsToRecord = 30.0f;
+
+	/**
+	 * Whether to trim clips encoded from the circular buffer to LastSecondsToRecord, starting at the nearest keyframe.
+	 * The buffer can only be dropped a whole keyframe interval at a time, so untrimmed clips may hold several extra seconds.
+	 * Trimming copies the encoded frames as is, the clip isn't re-encoded. Clips encoded by the crash handler are left untrimmed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bTrimToLastSeconds = true;
+
+	/** Frame rate for video recording (15-60 FPS recommended) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	int32 TargetFPS = 30;
+
+	/**
+	 * Whether the recorder captures frames on a fixed cadence of TargetFPS taken from the present timeline
+	 * instead of doing capture bookkeeping on every rendered frame. Keeps recording overhead and output frame pacing
+	 * independent of the render frame rate, which matters most when rendering well above TargetFPS.
+	 * Off by default since it changes how RuntimeVideoRecorder schedules captures. The frame strip and raw frame ring
+	 * always use a fixed cadence.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bFrameRateIndependent = false;
+
+	/** Video width in pixels (-1 for viewport width) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	int32 Width = 1280;
+
+	/** Video height in pixels (-1 for viewport height) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	int32 Height = 720;
+
+	/**
+	 * Whether to fit the requested resolution into the viewport keeping its aspect ratio.
+	 * Avoids capturing frames larger than what's actually rendered and upscaling them in the encoder.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bFitResolutionToViewport = true;
+
+	/** Whether to include UI/widgets in the recording */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bRecordUI = true;
+
+	/**
+	 * Whether to report the split-screen layout of local players with crash reports (`crash_video_layout` context).
+	 * All players are recorded as a single composited stream by one encoder; the reported per-player viewport rectangles
+	 * allow cropping individual player views from it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bTrackSplitScreenLayout = true;
+
+	/** Whether to record audio (disabled by default for performance) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bEnableAudio = false;
+
+	/**
+	 * Whether to keep the last seconds of game audio in a separate in-memory ring (16 kHz mono PCM) instead of encoding it into the video.
+	 * Nothing is encoded until a crash occurs; the audio is then attached next to the crash video as a WAV file.
+	 * Ignored when bEnableAudio is set.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "!bEnableAudio"))
+	bool bRecordAudioRing = false;
+
+	/** Video quality preset (0-100, higher = better quality but larger file) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (ClampMin = "0", ClampMax = "100"))
+	int32 QualityPreset = 50;
+
+	/**
+	 * Whether to keep an already running recording (and its circular buffer) instead of restarting the encoder.
+	 * Useful when recording is re-requested on every map change.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bReuseActiveRecording = false;
+
+	/**
+	 * Whether to keep the last N seconds as a ring of short, already encoded MP4 segments on disk
+	 * instead of encoding the whole circular buffer when a crash occurs.
+	 * The segment that is being recorded at the moment of the crash is not included in the report.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bSegmentedRecording = false;
+
+	/** Duration of a single segment in seconds when segmented recording is enabled (1-30 seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bSegmentedRecording", ClampMin = "1.0", ClampMax = "30.0"))
+	float SegmentDurationSeconds = 5.0f;
+
+	/** Seconds of footage kept before and after every bookmark added via USentryCrashVideoHandler::Bookmark */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (ClampMin = "1.0", ClampMax = "120.0"))
+	float BookmarkWindowSeconds = 10.0f;
+
+	/**
+	 * Max disk space in megabytes taken by segments that are kept for bookmarks after rotating out of the ring (0 to disable bookmarks).
+	 * Once exceeded, the oldest kept segments are released first.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (ClampMin = "0"))
+	int32 MaxBookmarkDiskMB = 64;
+
+	/** Whether to send the clips of the bookmarks that no event referenced when recording stops */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bSendBookmarksOnStop = true;
+
+	/**
+	 * Whether to record per-frame metadata (frame number, game/render/GPU times and IDs of the breadcrumbs added during the frame)
+	 * and attach it to crash reports next to the video as `crash_video_timeline.bin`.
+	 * Breadcrumbs get a `breadcrumb_id` data field so that they can be matched against the frames of the video.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bRecordFrameTimeline = false;
+
+	/**
+	 * Whether to record a strip of heavily downscaled frames instead of a video.
+	 * Much cheaper than video recording, the frames are attached to crash reports as a single JPEG sprite sheet
+	 * (requires "Attach crash frame strip" to be enabled in plugin settings).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bFrameStripOnly = false;
+
+	/** Size of a single frame strip frame in pixels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bFrameStripOnly"))
+	FIntPoint FrameStripFrameSize = FIntPoint(320, 180);
+
+	/** Frame strip capture rate (0.1-10 FPS) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bFrameStripOnly", ClampMin = "0.1", ClampMax = "10.0"))
+	float FrameStripFPS = 2.0f;
+
+	/**
+	 * Whether to keep lightly compressed raw frames in a preallocated memory-mapped ring file instead of encoding video continuously.
+	 * Frames are only encoded (as a Motion JPEG AVI) when a snapshot clip is requested, or on the next launch after a crash,
+	 * which trades disk bandwidth for nearly no encoding CPU while playing. Supported on Windows and Linux only.
+	 * In a multiplayer Play In Editor session the windows of all clients are captured in turns into letterboxed tiles of the same frames.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "!bFrameStripOnly"))
+	bool bRawFrameRing = false;
+
+	/** Size of a single raw frame ring frame in pixels, rounded down to even dimensions */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bRawFrameRing"))
+	FIntPoint RawFrameRingFrameSize = FIntPoint(640, 360);
+
+	/** Raw frame ring capture rate (1-30 FPS) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bRawFrameRing", ClampMin = "1.0", ClampMax = "30.0"))
+	float RawFrameRingFPS = 10.0f;
+
+	/**
+	 * Seconds kept by a second, long tier raw frame ring recorded along with the regular one (0 to record a single ring).
+	 * Its frames are downscaled from the captured ones, so the regular ring can keep a few seconds of crisp footage
+	 * (e.g. 10 seconds at 1280x720 and 30 FPS) while the long tier keeps minutes of context (e.g. 120 seconds at 640x360
+	 * and 5 FPS) at no extra GPU cost. Both are attached to crash reports, snapshot clips contain the regular ring only.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bRawFrameRing", ClampMin = "0.0", ClampMax = "600.0"))
+	float RawFrameRingLongTierSeconds = 0.0f;
+
+	/** Size of a single long tier frame in pixels, at most the size of the regular raw frame ring frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bRawFrameRing"))
+	FIntPoint RawFrameRingLongTierFrameSize = FIntPoint(320, 180);
+
+	/** Long tier capture rate (0.1-30 FPS), at most the regular raw frame ring capture rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bRawFrameRing", ClampMin = "0.1", ClampMax = "30.0"))
+	float RawFrameRingLongTierFPS = 2.0f;
+
+	/**
+	 * Whether to record by scaling frames on the GPU straight into memory consumed by a hardware encoder instead of reading
+	 * them back to the CPU: the input surface of a MediaCodec encoder on Android, IOSurface backed pixel buffers of
+	 * a VideoToolbox session on iOS and macOS. Footage is kept as segments like with segmented recording.
+	 * Requires the OpenGL ES RHI on Android and Metal on Apple platforms; with other RHIs, when recording audio, or once
+	 * the hardware encoder fails, the video recorder is used instead.
+	 * The segment being encoded when the game crashes can't be finalized. On Apple platforms segments are written as
+	 * fragmented MP4 so that it stays playable up to the last second; on Android it's lost, so segments are kept to at
+	 * most 2 seconds there.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "!bFrameStripOnly && !bRawFrameRing"))
+	bool bUseZeroCopyEncoder = false;
+
+	/**
+	 * Whether to pause recording while the application is in background, minimized or not focused, and resume once it's active again.
+	 * Footage recorded before pausing is kept. Off by default since an unfocused window, e.g. while debugging or running
+	 * several clients side by side, would otherwise leave no footage of what it kept rendering.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bPauseWhenInactive = false;
+
+	/**
+	 * Whether to skip crash video recording when no hardware video encoder is expected to be available.
+	 * Prevents software encoding from taking a sizeable share of a CPU core on low-end devices.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bRequireHardwareEncoder = false;
+
+	/**
+	 * Whether to lower recording bitrate, FPS and resolution while the game exceeds the frame time budget
+	 * and raise them again once there is headroom. Every adjustment is reported as a breadcrumb.
+	 * The recorder isn't restarted for it: segmented recording applies the new quality with the next segment, otherwise
+	 * it's applied the next time the recorder starts (e.g. when resuming).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	bool bAdaptiveQuality = false;
+
+	/**
+	 * Max memory in megabytes the recorder's circular buffer is allowed to use (0 for no limit).
+	 * Bitrate and, if required, recording duration are reduced to fit the budget. Not applied to segmented recording.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (ClampMin = "0"))
+	int32 MaxBufferMemoryMB = 256;
+
+	/** Frame time budget in milliseconds used by adaptive quality (max of game thread, render thread and GPU time) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (EditCondition = "bAdaptiveQuality", ClampMin = "1.0", ClampMax = "100.0"))
+	float FrameTimeBudgetMs = 16.67f;
+
+	/**
+	 * Substring of the names of the recorder's encoding and muxing threads to apply the encoder thread priority and affinity to
+	 * (empty to leave the recorder threads as they are). Only threads created with FRunnableThread can be found.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	FString EncoderThreadNameFilter;
+
+	/** Priority of the recorder's encoding and muxing threads */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	ESentryThreadPriority EncoderThreadPriority = ESentryThreadPriority::BelowNormal;
+
+	/**
+	 * Cores 0-31 the recorder's encoding and muxing threads are allowed to run on, one bit per core (0 to let the platform decide).
+	 * Requires Unreal Engine 5.1 or newer.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	int32 EncoderThreadAffinityMask = 0;
+};
+
+/**
+ * Crash video recording configuration selected for matching devices and scalability levels.
+ */
+USTRUCT(BlueprintType)
+struct SENTRY_API FCrashVideoPreset
+{
+	GENERATED_BODY()
+
+	/** Name reported in logs and breadcrumbs when the preset is selected */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	FString Name;
+
+	/**
+	 * Device profiles the preset applies to, e.g. Android_Low (empty for any device).
+	 * Matched against the active device profile and the profiles it's based on.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	TArray<FString> DeviceProfiles;
+
+	/**
+	 * Highest scalability level the preset applies to (0 - Low, 1 - Medium, 2 - High, 3 - Epic, 4 - Cinematic, -1 for any level).
+	 * Compared against the lowest level of all scalability groups.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video", meta = (ClampMin = "-1", ClampMax = "4"))
+	int32 MaxScalabilityLevel = -1;
+
+	/** Recording configuration used when the preset is selected */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Video")
+	FCrashVideoConfig Config;
+};
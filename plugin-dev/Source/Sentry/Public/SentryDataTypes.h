@@ -24,6 +24,32 @@ enum class ESentryCrashedLastRun : uint8
 	Crashed
 };
 
+UENUM(BlueprintType)
+enum class ESentryThreadPriority : uint8
+{
+	Lowest,
+	BelowNormal,
+	Normal,
+	AboveNormal
+};
+
+UENUM(BlueprintType)
+enum class ESentrySessionStatus : uint8
+{
+	Exited,
+	Errored,
+	Crashed,
+	Abnormal
+};
+
+UENUM(BlueprintType)
+enum class ESentryMetricType : uint8
+{
+	Counter,
+	Gauge,
+	Distribution
+};
+
 UENUM(BlueprintType)
 enum class EUserConsent : uint8
 {
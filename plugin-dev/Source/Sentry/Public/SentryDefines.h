@@ -0,0 +1,11 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+SENTRY_API DECLARE_LOG_CATEGORY_EXTERN(LogSentrySdk, Verbose, All);
+
+/** Low-level memory tracker tag for allocations made by the plugin and the underlying SDKs. */
+LLM_DECLARE_TAG(Sentry);
@@ -88,6 +88,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Sentry")
 	bool TryGetContext(const FString& Key, TMap<FString, FSentryVariant>& Value) const;
 
+	/** Tries to get a single value of the event context without converting the whole context. */
+	UFUNCTION(BlueprintPure, Category = "Sentry")
+	bool TryGetContextValue(const FString& Key, const FString& ValueKey, FSentryVariant& Value) const;
+
 	/** Sets context values of the event. */
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void RemoveContext(const FString& Key);
@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/StringView.h"
+
+#include "SentryDataTypes.h"
+#include "SentryVariant.h"
+
+class ISentryEvent;
+
+/**
+ * View of an event about to be sent, passed to native before-send filters.
+ *
+ * It wraps the platform event without copying it or creating any UObjects and is only valid for the duration of the filter call.
+ * Getters look up single keys instead of converting whole tags or contexts. UTF-8 string views point into the native event
+ * on Windows/Linux, on other platforms the values are converted into storage owned by the view.
+ */
+class SENTRY_API FSentryEventView
+{
+public:
+	explicit FSentryEventView(ISentryEvent& InEvent)
+		: Event(InEvent)
+	{
+	}
+
+	/** Gets the ID of the event, allocates the returned string. */
+	FString GetId() const;
+
+	FString GetMessage() const;
+
+	ESentryLevel GetLevel() const;
+	void SetLevel(ESentryLevel Level);
+
+	bool TryGetTag(const FString& Key, FString& Value) const;
+	bool TryGetTagUtf8(FAnsiStringView Key, FAnsiStringView& Value) const;
+	void SetTag(const FString& Key, const FString& Value);
+	void RemoveTag(const FString& Key);
+
+	bool TryGetContextValue(const FString& Key, const FString& ValueKey, FSentryVariant& Value) const;
+	bool TryGetContextStringUtf8(FAnsiStringView Key, FAnsiStringView ValueKey, FAnsiStringView& Value) const;
+
+	void SetFingerprint(const TArray<FString>& Fingerprint);
+
+	bool IsCrash() const;
+	bool IsAnr() const;
+
+private:
+	ISentryEvent& Event;
+
+	/** Storage for strings converted on platforms whose events can't be viewed directly, kept for the lifetime of the view. */
+	mutable TArray<TArray<ANSICHAR>> Scratch;
+};
+
+/**
+ * Native before-send filter, returning false drops the event.
+ *
+ * Filters run on the thread the event is sent from, including during garbage collection and post-load when
+ * the before-send handler is skipped and, on Windows/Linux, inside the crash handler. They must be thread-safe,
+ * should avoid allocating and must not add or remove filters.
+ */
+using FSentryBeforeSendFilter = TFunction<bool(FSentryEventView& Event)>;
@@ -0,0 +1,19 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRHICommandListImmediate;
+
+namespace SentryGpuMarkers
+{
+	/**
+	 * Adds a pass marker to the GPU breadcrumbs reported with GPU crashes.
+	 * Must be called on the render thread, does nothing unless GPU breadcrumbs are enabled in plugin settings.
+	 *
+	 * @param RHICmdList Command list the pass is recorded into.
+	 * @param Name Name of the pass, e.g. the one of a custom render pass.
+	 */
+	SENTRY_API void Add(FRHICommandListImmediate& RHICmdList, FName Name);
+}
@@ -35,6 +35,20 @@ public:
 		}
 	}
 
+	/**
+	 * Replaces the native implementation of an existing object, used to reuse pooled objects.
+	 *
+	 * @param InOutObject The object to rebind.
+	 * @param InObject The native implementation, null to release the current one.
+	 */
+	static void SetNativeObject(Unreal* InOutObject, TSharedPtr<Interface> InObject)
+	{
+		if (InOutObject)
+		{
+			StaticCast<TSentryImplWrapper<Interface, Unreal>*>(InOutObject)->NativeImpl = InObject;
+		}
+	}
+
 	/** Retrieves the underlying native implementation. */
 	TSharedPtr<Interface> GetNativeObject() const { return NativeImpl; }
 
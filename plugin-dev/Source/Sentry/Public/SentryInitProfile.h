@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/** Wall time spent in a single phase of the Sentry initialization. */
+struct FSentryInitPhase
+{
+	/** Name of the phase. */
+	FString Name;
+
+	/** Time when the phase started, as returned by FPlatformTime::Seconds. */
+	double StartTime = 0.0;
+
+	/** Time when the phase ended, as returned by FPlatformTime::Seconds. */
+	double EndTime = 0.0;
+
+	FSentryInitPhase() = default;
+
+	FSentryInitPhase(const FString& InName, double InStartTime, double InEndTime)
+		: Name(InName)
+		, StartTime(InStartTime)
+		, EndTime(InEndTime)
+	{
+	}
+
+	double GetDurationMs() const { return (EndTime - StartTime) * 1000.0; }
+};
+
+/**
+ * Timings of the Sentry initialization phases recorded by USentrySubsystem::Initialize.
+ * Phases may be nested, e.g. building the options is a part of the platform SDK initialization.
+ */
+class SENTRY_API FSentryInitProfile
+{
+public:
+	/** Removes all recorded phases. */
+	void Reset();
+
+	/** Adds a phase, keeping phases ordered by their start time. */
+	void AddPhase(const FString& Name, double StartTime, double EndTime);
+
+	/** Gets recorded phases ordered by their start time. */
+	const TArray<FSentryInitPhase>& GetPhases() const;
+
+	/** Gets the wall time spent in all phases, not counting nested phases twice. */
+	double GetTotalDurationMs() const;
+
+	/** Gets the profile that phases are recorded to on the calling thread, null if there is none. */
+	static FSentryInitProfile* GetCurrent();
+
+	/** Adds a phase to the current profile of the calling thread if there is one. */
+	static void RecordPhase(const FString& Name, double StartTime, double EndTime);
+
+	/** Makes the profile current on the calling thread for the lifetime of the scope. */
+	class SENTRY_API FScopedCurrent
+	{
+	public:
+		explicit FScopedCurrent(FSentryInitProfile* Profile);
+		~FScopedCurrent();
+
+	private:
+		FSentryInitProfile* PreviousProfile;
+	};
+
+private:
+	TArray<FSentryInitPhase> Phases;
+};
+
+/** Records the enclosing scope as a phase of the current initialization profile. */
+class SENTRY_API FSentryInitPhaseScope
+{
+public:
+	explicit FSentryInitPhaseScope(const TCHAR* InName);
+	~FSentryInitPhaseScope();
+
+private:
+	const TCHAR* Name;
+	double StartTime;
+};
+
+/** Records the enclosing scope as an initialization phase and marks it for Unreal Insights. */
+#define SENTRY_INIT_PHASE_SCOPE(PhaseName) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(SentryInit_##PhaseName); \
+	FSentryInitPhaseScope PREPROCESSOR_JOIN(SentryInitPhaseScope, __LINE__)(TEXT(#PhaseName))
@@ -82,6 +82,16 @@ public:
 	static USentryAttachment* CreateSentryAttachmentWithData(const TArray<uint8>& Data, const FString& Filename,
 		const FString& ContentType = FString(TEXT("application/octet-stream")));
 
+	/**
+	 * Creates attachment with bytes and a filename, taking over the data instead of copying it.
+	 *
+	 * @param Data The data for the attachment.
+	 * @param Filename The name of the attachment to display in Sentry.
+	 * @param ContentType The content type of the attachment. Default is "application/octet-stream".
+	 */
+	static USentryAttachment* CreateSentryAttachmentWithData(TArray<uint8>&& Data, const FString& Filename,
+		const FString& ContentType = FString(TEXT("application/octet-stream")));
+
 	/**
 	 * Creates attachment with a path and a filename.
 	 *
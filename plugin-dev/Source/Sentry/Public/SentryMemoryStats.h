@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryMemoryStats.generated.h"
+
+/**
+ * Memory held by the SDK, broken down by component.
+ *
+ * Allocations of sentry-native (Windows/Linux) are attributed to the component that made them and counted exactly,
+ * provided the library is built with the allocation hooks. Containers owned by the plugin are counted by their allocated
+ * size. Memory of the Java and Cocoa SDKs isn't visible to the plugin, only the JNI global references it holds are counted.
+ */
+USTRUCT(BlueprintType)
+struct SENTRY_API FSentryMemoryStats
+{
+	GENERATED_BODY()
+
+	/** Breadcrumbs kept by the native SDK and the persisted breadcrumb ring. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 BreadcrumbBytes = 0;
+
+	/** Tags, contexts, extras and user of the global and world scopes, including scope changes waiting to be applied. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 ScopeBytes = 0;
+
+	/** Envelopes and events being built, queued or batched in memory, the offline spool on disk excluded. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 PendingEnvelopeBytes = 0;
+
+	/** Game log tail ring. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 LogRingBytes = 0;
+
+	/** Byte attachments added to the scopes. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 AttachmentBytes = 0;
+
+	/** Estimated size of the crash video buffers and the crash audio ring, 0 if neither is enabled. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 CrashVideoBytes = 0;
+
+	/** Handler UObjects created by the SDK (before send, before breadcrumb, before log and trace sampler). */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 HandlerObjectBytes = 0;
+
+	/** Allocations of the native SDK not made on behalf of any of the components above, e.g. options and the session. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 NativeSdkOtherBytes = 0;
+
+	/** JNI global references held by the Android bridge, their objects live in the Java heap and aren't counted above. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int32 NumJniGlobalRefs = 0;
+
+	/** Whether native SDK allocations are attributed to components, false if the library is built without the allocation hooks. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	bool bIsNativeHeapTracked = false;
+
+	int64 GetTotalBytes() const
+	{
+		return BreadcrumbBytes + ScopeBytes + PendingEnvelopeBytes + LogRingBytes + AttachmentBytes + CrashVideoBytes + HandlerObjectBytes + NativeSdkOtherBytes;
+	}
+};
@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryDataTypes.h"
+
+#include "SentryMetricKey.generated.h"
+
+/**
+ * Handle of a registered metric, combination of its type, name, unit and tags.
+ * Recording a sample for a handle obtained once up front skips the lookup of the metric by its name and tags.
+ */
+USTRUCT(BlueprintType)
+struct SENTRY_API FSentryMetricKey
+{
+	GENERATED_BODY()
+
+	/** Index of the metric in the registry, INDEX_NONE for an invalid key. */
+	UPROPERTY()
+	int32 Id = INDEX_NONE;
+
+	UPROPERTY()
+	ESentryMetricType Type = ESentryMetricType::Counter;
+
+	bool IsValid() const { return Id != INDEX_NONE; }
+};
@@ -3,8 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "Modules/ModuleInterface.h"
+#include "Templates/Atomic.h"
 
+#include "SentryInitProfile.h"
+
+class ISentryCrashVideoCapture;
 class USentrySettings;
 
 class SENTRY_API FSentryModule : public IModuleInterface
@@ -32,6 +37,21 @@ public:
 	/** Gets internal settings object to support runtime configuration changes. */
 	USentrySettings* GetSettings() const;
 
+	/** Gets the time spent loading the settings object on module startup. */
+	const FSentryInitPhase& GetSettingsLoadPhase() const;
+
+	/** Gets the time the module was started up at, in FPlatformTime::Seconds. Most engine modules are loaded by then. */
+	double GetStartupTime() const;
+
+	/**
+	 * Registers hooks of the optional SentryVideo module, nullptr to unregister.
+	 * Hooks have to stay valid until they're unregistered.
+	 */
+	static void SetCrashVideoCapture(ISentryCrashVideoCapture* InCrashVideoCapture);
+
+	/** Gets hooks of the optional SentryVideo module, nullptr if the module isn't loaded. Safe to call from the crash handler. */
+	static ISentryCrashVideoCapture* GetCrashVideoCapture();
+
 	/** Gets path to plugin's binaries folder for current platform. */
 	FString GetBinariesPath();
 
@@ -45,13 +65,16 @@ public:
 	static bool IsMarketplaceVersion();
 
 #if PLATFORM_MAC
-	/** Gets handle to dynamically loaded sentry library. */
+	/** Loads sentry library unless it's already loaded. Called on first use of the Cocoa SDK classes, from any thread. */
+	bool LoadSentryLib();
+
+	/** Gets handle to dynamically loaded sentry library, nullptr until it's loaded. */
 	void* GetSentryLibHandle() const;
 
 	/** Gets an Objective-C/Swift class from the dynamically loaded sentry library.
 	 *
 	 * @param ClassName The unqualified class name (e.g., "SentrySDK", "SentryId")
-	 * @return The Objective-C/Swift Class object if found, nil otherwise
+	 * @return The Objective-C/Swift Class object if found, nil otherwise or if the library fails to load
 	 *
 	 * @note: First tries pattern OBJC_CLASS_$_{ClassName}
 	 * Then tries Swift mangled pattern OBJC_CLASS_$__TtC6Sentry{len}{ClassName} where:
@@ -69,7 +92,16 @@ public:
 private:
 	USentrySettings* SentrySettings = nullptr;
 
+	FSentryInitPhase SettingsLoadPhase;
+
+	double StartupTime = 0.0;
+
 #if PLATFORM_MAC
-	void* mDllHandleSentry = nullptr;
+	TAtomic<void*> mDllHandleSentry { nullptr };
+
+	FCriticalSection SentryLibCriticalSection;
+
+	/** Flag indicating whether loading the library failed, so that it isn't attempted (and logged) on every lookup. */
+	bool bHasSentryLibFailedToLoad = false;
 #endif
 };
@@ -7,10 +7,23 @@
 
 #include "SentryDataTypes.h"
 
+#include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+
+class FSentryLogCategoryFilter;
+class FSentryLogLimiter;
+class FSentryLogQueue;
+class FSentryLogRing;
+class USentrySettings;
+class USentrySubsystem;
+
 class FSentryOutputDevice : public FOutputDevice
 {
 public:
-	FSentryOutputDevice();
+	explicit FSentryOutputDevice(TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> InLogRing = nullptr);
+	virtual ~FSentryOutputDevice() override;
 
 	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override;
 
@@ -21,13 +34,49 @@ public:
 	virtual bool CanBeUsedOnPanicThread() const override;
 #endif
 
+	/**
+	 * Applies the breadcrumb and structured logging levels and categories while logs are being written.
+	 * Whether structured logging is enabled at all and how it's forwarded can only be changed on initialization.
+	 */
+	void ApplySettings(const USentrySettings* Settings);
+
 private:
-	TMap<ESentryLevel, bool> BreadcrumbFlags;
-	TMap<ESentryLevel, bool> StructuredLoggingFlags;
+	/** Bitmasks indexed by ESentryLevel, precomputed so that filtering doesn't need map lookups. */
+	TAtomic<uint8> BreadcrumbLevelMask;
+	TAtomic<uint8> StructuredLoggingLevelMask;
 
 	bool bIsStructuredLoggingEnabled;
-	TArray<FString> StructuredLoggingCategories;
 	bool bSendBreadcrumbsWithStructuredLogging;
 
-	bool ShouldForwardToStructuredLogging(const FString& Category, ESentryLevel Level) const;
+	/**
+	 * Category filter used by the logging threads. Replaced filters are kept alive until the device is destroyed
+	 * since a line may still be matched against them, settings are rarely changed so they don't add up.
+	 */
+	TAtomic<const FSentryLogCategoryFilter*> StructuredLoggingCategories;
+	TArray<TUniquePtr<FSentryLogCategoryFilter>> CategoryFilters;
+	FCriticalSection CategoryFiltersCriticalSection;
+
+	/** Queue forwarding structured logs on a background thread, null if logs are forwarded synchronously. */
+	TUniquePtr<FSentryLogQueue> LogQueue;
+
+	/** Rate limiter and deduplicator of forwarded lines, null if neither is configured. */
+	TUniquePtr<FSentryLogLimiter> LogLimiter;
+
+	/** Ring receiving every formatted line regardless of the filters, null if the game log tail isn't attached. */
+	TSharedPtr<FSentryLogRing, ESPMode::ThreadSafe> LogRing;
+
+	/** Max size of a line written to the log ring, longer lines are truncated. */
+	static constexpr int32 MaxLogRingLineSize = 2048;
+
+	static uint8 GetLevelBit(ESentryLevel Level) { return 1 << static_cast<uint8>(Level); }
+
+	/** Formats the line like the log file does, prefixed with the seconds since start, and appends it to the log ring without allocating. */
+	void AppendToLogRing(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category);
+
+	bool ShouldForwardToStructuredLogging(const FName& Category, ESentryLevel Level) const;
+
+	/** Forwards a line that passed all filters to structured logging and/or breadcrumbs. */
+	void ForwardLine(const TCHAR* V, ESentryLevel Level, const FName& Category, bool bForwardToStructuredLogging, bool bAddBreadcrumb);
+
+	static void ForwardToStructuredLogging(USentrySubsystem* SentrySubsystem, const FString& Message, ESentryLevel Level, const FString& Category);
 };
@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryPayloadStats.generated.h"
+
+/**
+ * Sizes of the payloads handed over to the transport, tracked if enabled in plugin settings.
+ * Event sizes are the size of the serialized event JSON, attachment sizes are the size of the attachments sent along with events.
+ */
+USTRUCT(BlueprintType)
+struct SENTRY_API FSentryPayloadStats
+{
+	GENERATED_BODY()
+
+	/** Bytes of events captured during the last minute. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 EventBytesPerMinute = 0;
+
+	/** Bytes of attachments sent with events captured during the last minute. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 AttachmentBytesPerMinute = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 TotalEventBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 TotalAttachmentBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 NumEvents = 0;
+
+	/** Number of events trimmed to fit the event payload budget. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 NumTrimmedEvents = 0;
+
+	/** Largest event size seen after trimming. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 MaxEventBytes = 0;
+};
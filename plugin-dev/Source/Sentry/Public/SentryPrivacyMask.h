@@ -0,0 +1,23 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class SWidget;
+class UWidget;
+
+namespace SentryPrivacyMask
+{
+	/**
+	 * Redacts the widget from the screenshots and the crash frame strip captured by the plugin, e.g. chat, account details
+	 * or payment forms. The widget's area is cleared to black on the GPU before the frame is read back, so its pixels never
+	 * reach the CPU. The widget stays redacted until it's unredacted or destroyed. Called on the game thread.
+	 */
+	SENTRY_API void RedactWidget(const TSharedRef<SWidget>& Widget);
+	SENTRY_API void RedactWidget(UWidget* Widget);
+
+	/** Stops redacting the widget. Called on the game thread. */
+	SENTRY_API void UnredactWidget(const TSharedRef<SWidget>& Widget);
+	SENTRY_API void UnredactWidget(UWidget* Widget);
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryVariant.h"
+
+class ISentrySpan;
+class USentrySpan;
+class USentryTransaction;
+
+/** Set to 0 in the project build settings to compile SENTRY_SCOPED_SPAN instrumentation out entirely. */
+#ifndef SENTRY_SCOPED_SPANS_ENABLED
+#define SENTRY_SCOPED_SPANS_ENABLED 1
+#endif
+
+/**
+ * Child span measuring the enclosing C++ scope, meant for code that runs too often to create USentrySpan objects for.
+ *
+ * No UObjects are created. On Windows/Linux the native span is used directly without allocating any wrapper,
+ * and nothing is recorded at all if the parent isn't sampled. Can be used from any thread.
+ */
+class SENTRY_API FSentryScopedSpan
+{
+public:
+	FSentryScopedSpan(USentryTransaction* Parent, const TCHAR* Operation, const TCHAR* Description = TEXT(""));
+	FSentryScopedSpan(USentrySpan* Parent, const TCHAR* Operation, const TCHAR* Description = TEXT(""));
+	FSentryScopedSpan(const FSentryScopedSpan& Parent, const TCHAR* Operation, const TCHAR* Description = TEXT(""));
+
+	/** Finishes the span. */
+	~FSentryScopedSpan();
+
+	FSentryScopedSpan(const FSentryScopedSpan&) = delete;
+	FSentryScopedSpan& operator=(const FSentryScopedSpan&) = delete;
+
+	/** Checks whether the span is being recorded, can be used to skip gathering data for it. */
+	bool IsRecording() const;
+
+	/** Sets data associated with the span. */
+	void SetData(const FString& Key, const TMap<FString, FSentryVariant>& Values);
+
+private:
+#if USE_SENTRY_NATIVE
+	/** Native span owned by this object, null if it isn't recorded. */
+	void* NativeSpan = nullptr;
+
+	/** Offset of the monotonic clock of the transaction the span belongs to, it's timed with the cycle counter. */
+	int64 ClockOffset = 0;
+#else
+	TSharedPtr<ISentrySpan> Span;
+#endif
+};
+
+#if SENTRY_SCOPED_SPANS_ENABLED
+#define SENTRY_SCOPED_SPAN(Parent, Operation, Description) FSentryScopedSpan ANONYMOUS_VARIABLE(SentryScopedSpan_)(Parent, Operation, Description)
+#else
+#define SENTRY_SCOPED_SPAN(Parent, Operation, Description)
+#endif
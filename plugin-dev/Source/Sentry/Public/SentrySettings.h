@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Engine/EngineTypes.h"
 #include "Logging/LogVerbosity.h"
+#include "SentryCrashVideoConfig.h"
 #include "SentryDataTypes.h"
 #include "UObject/NoExportTypes.h"
 #include "SentrySettings.generated.h"
@@ -20,7 +21,27 @@ enum class ESentryTracesSamplingType : uint8
 	// Use uniform sample rate for all transactions
 	UniformSampleRate,
 	// Control the sample rate based on the transaction itself and the context in which it's captured
-	TracesSampler
+	TracesSampler,
+	// Control the sample rate by transaction name or operation prefix without calling into Blueprints
+	SampleRules
+};
+
+UENUM(BlueprintType)
+enum class ESentryTraceSampleRuleTarget : uint8
+{
+	// Match the prefix against the transaction name
+	Name,
+	// Match the prefix against the transaction operation
+	Operation
+};
+
+UENUM(BlueprintType)
+enum class ESentryLogFilterTextMatch : uint8
+{
+	// Match the text anywhere in the log message
+	Contains,
+	// Match the text at the start of the log message
+	StartsWith
 };
 
 UENUM(BlueprintType)
@@ -42,6 +63,26 @@ enum class ESentryDatabaseLocation : uint8
 	ProjectUserDirectory
 };
 
+UENUM(BlueprintType)
+enum class ESentryScreenshotFormat : uint8
+{
+	// Lossless, slowest to encode
+	Png,
+	// Lossy, much smaller and faster to encode than PNG
+	Jpeg,
+	// Lossless "Quite OK Image" format, encodes several times faster than PNG
+	Qoi
+};
+
+UENUM(BlueprintType)
+enum class ESentryScreenshotSource : uint8
+{
+	// Last presented frame read back from the GPU without re-rendering anything (Unreal Engine 5.0 or newer)
+	BackBuffer,
+	// Game window re-rendered by Slate when the screenshot is taken
+	Slate
+};
+
 USTRUCT(BlueprintType)
 struct FAutomaticBreadcrumbs
 {
@@ -150,6 +191,50 @@ struct FTagsPromotion
 	bool bPromoteIsUnattended = true;
 };
 
+USTRUCT(BlueprintType)
+struct FSentryTraceSampleRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Match", ToolTip = "Transaction property the prefix is matched against."))
+	ESentryTraceSampleRuleTarget Target = ESentryTraceSampleRuleTarget::Name;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Prefix", ToolTip = "Transactions whose name or operation starts with this prefix are sampled with the rule's sample rate (case-sensitive)."))
+	FString Prefix;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Sample rate", ToolTip = "Sample rate between 0.0 and 1.0 for matching transactions.", ClampMin = 0.0f, ClampMax = 1.0f))
+	float SampleRate = 1.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FSentryLogFilterRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Up to level", ToolTip = "Rule only applies to logs at or below this level."))
+	ESentryLevel MaxLevel = ESentryLevel::Fatal;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Category", ToolTip = "Log category the rule applies to (case-insensitive). Leave empty to apply to all categories."))
+	FString Category;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Match", ToolTip = "How the text is matched against the log message."))
+	ESentryLogFilterTextMatch TextMatch = ESentryLogFilterTextMatch::Contains;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Text", ToolTip = "Text the log message has to contain or start with (case-sensitive). Leave empty to match any message."))
+	FString Text;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
+		Meta = (DisplayName = "Sample rate", ToolTip = "Share of the matching logs that are kept, 0.0 drops all of them.", ClampMin = 0.0f, ClampMax = 1.0f))
+	float SampleRate = 0.0f;
+};
+
 USTRUCT(BlueprintType)
 struct FEnableBuildConfigurations
 {
@@ -214,6 +299,10 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Initialize SDK automatically", ToolTip = "Flag indicating whether to automatically initialize the SDK when the app starts.", ConfigRestartRequired = true))
 	bool InitAutomatically;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General",
+		Meta = (DisplayName = "Initialize SDK asynchronously (for Windows/Linux only)", ToolTip = "Flag indicating whether the platform SDK should be initialized on a background thread to keep it off the startup path. Scope changes and captures made before the initialization completes are queued and applied afterwards. Crashes occurring before that are not reported.", ConfigRestartRequired = true))
+	bool InitAsynchronously;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General",
 		Meta = (DisplayName = "DSN", ToolTip = "The DSN (Data Source Name) tells the SDK where to send the events to. Get your DSN in the Sentry dashboard."))
 	FString Dsn;
@@ -234,14 +323,82 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Sample rate", ToolTip = "Configures the sample rate for error events in the range of 0.0 to 1.0. The default is 1.0 which means that 100% of error events are sent. If set to 0.1 only 10% of error events will be sent. Events are picked randomly.", ClampMin = 0.0f, ClampMax = 1.0f))
 	float SampleRate;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General",
+		Meta = (DisplayName = "Max duplicate events per minute", ToolTip = "Max number of events with the same message, level and call site captured per minute (0 for no limit). Suppressed events are reported in a single summary event once a minute.", ClampMin = 0))
+	int32 MaxDuplicateEventsPerMinute;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General",
+		Meta = (DisplayName = "Max events per minute", ToolTip = "Max number of events captured per minute in total (0 for no limit). Suppressed events are reported in a single summary event once a minute.", ClampMin = 0))
+	int32 MaxEventsPerMinute;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General",
+		Meta = (DisplayName = "Report ensures once per location", ToolTip = "Flag indicating whether an ensure failing repeatedly at the same location (e.g. `ensureAlways`) should be reported only the first time during the session."))
+	bool ReportEnsuresOncePerLocation;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
 		Meta = (DisplayName = "Attach game log to captured events", ToolTip = "Flag indicating whether to attach game log automatically to captured events. Not available in shipping builds."))
 	bool EnableAutoLogAttachment;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Game log tail size (KB)", ToolTip = "Size of the game log tail to attach instead of the whole log file (0 to attach the whole file). The tail is kept in memory so no disk read is needed at capture time. Crash events get the same tail unless the crash log tail is attached. Windows/Linux only.",
+			ClampMin = 0, ClampMax = 65536, EditCondition = "EnableAutoLogAttachment"))
+	int32 AutoLogAttachmentTailSizeKB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach log tail to crashes", ToolTip = "Flag indicating whether the most recent log lines kept in memory should be attached to crash events with their own size. Unlike the log file they are available even if the file wasn't flushed before the crash. Crashes already get the game log tail if its size is set. Windows/Linux only."))
+	bool AttachCrashLogTail;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Crash log tail size (KB)", ToolTip = "Size of the most recent log lines kept in memory for crash events.", ClampMin = 1, ClampMax = 65536, EditCondition = "AttachCrashLogTail"))
+	int32 CrashLogTailSizeKB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach registered memory regions to crashes", ToolTip = "Flag indicating whether memory regions registered with SentryCrashMemory::RegisterRegion should be dumped into a crash_memory.bin attachment of crash events. Windows/Linux only."))
+	bool AttachCrashMemoryRegions;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Crash memory regions size (KB)", ToolTip = "Maximum total size of the registered memory regions, regions exceeding it are truncated or rejected.", ClampMin = 1, ClampMax = 16384,
+			EditCondition = "AttachCrashMemoryRegions"))
+	int32 CrashMemoryRegionsMaxSizeKB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach recent input events", ToolTip = "Flag indicating whether the most recent key, mouse, axis and touch events should be kept in a fixed-size ring and attached to crashes and errors as input_events.json for repro steps. Mouse moves and axis changes are coalesced. Keys aren't recorded while a text field has focus. Requires attaching personally identifiable information. Windows/Linux only."))
+	bool AttachInputEvents;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Input events capacity", ToolTip = "Number of input events kept in the ring.", ClampMin = 16, ClampMax = 4096, EditCondition = "AttachInputEvents"))
+	int32 InputEventsCapacity;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach gameplay state timeline", ToolTip = "Flag indicating whether the snapshots of the providers registered with SentryStateTimeline::RegisterProvider should be sampled into a delta-compressed timeline attached to crashes and errors as state_timeline.json. Windows/Linux only."))
+	bool AttachStateTimeline;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "State timeline sample interval (seconds)", ToolTip = "Time between the samples of the state providers.", ClampMin = 0.05, ClampMax = 10.0, EditCondition = "AttachStateTimeline"))
+	float StateTimelineSampleIntervalSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "State timeline arena size (KB)", ToolTip = "Size of the preallocated arena the encoded samples are kept in, the oldest ones are evicted once it's full.", ClampMin = 16, ClampMax = 16384, EditCondition = "AttachStateTimeline"))
+	int32 StateTimelineArenaSizeKB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Persist log tail across process death", ToolTip = "Flag indicating whether the in-memory log and breadcrumb tails should be backed by memory-mapped files in the Sentry database directory. If the game dies without the crash handler running (e.g. killed for running out of memory), the tails are sent with an event on the next launch. Windows/Linux only."))
+	bool PersistLogTail;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
 		Meta = (DisplayName = "Attach stack trace to captured events", ToolTip = "Flag indicating whether to attach stack trace automatically to captured events."))
 	bool AttachStacktrace;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Max stack trace frames (for Windows/Linux only)", ToolTip = "Max number of innermost frames in the stack traces attached to captured events. Outer frames such as the engine loop are dropped, 0 for no limit.", ClampMin = 0,
+			EditCondition = "AttachStacktrace"))
+	int32 StacktraceMaxFrames;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Cache stack traces by callsite (for Windows/Linux only)", ToolTip = "Flag indicating whether repeated captures from the same callsite should reuse the stack trace of the first one instead of walking the whole stack again. Frames outside the innermost 16 are taken from the first capture.",
+			EditCondition = "AttachStacktrace"))
+	bool bCacheCallsiteStacktraces;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
 		Meta = (DisplayName = "Attach personally identifiable information", ToolTip = "Flag indicating whether to attach personally identifiable information (PII) to captured events."))
 	bool SendDefaultPii;
@@ -250,26 +407,165 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Attach screenshots", ToolTip = "Flag indicating whether to attach screenshot of the application when an error occurs. Currently this feature is supported for Windows and Linux only."))
 	bool AttachScreenshot;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Screenshot format", ToolTip = "Image format of the captured screenshots. JPEG and QOI are considerably faster to encode inside the crash handler than PNG.", EditCondition = "AttachScreenshot"))
+	ESentryScreenshotFormat ScreenshotFormat;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Screenshot source", ToolTip = "Where screenshots are taken from. Backbuffer screenshots reuse the latest presented frame so crash handlers don't have to re-render the window, at the cost of reading a full resolution frame back from the GPU every second while the game runs. Falls back to Slate where backbuffer capturing isn't available.", EditCondition = "AttachScreenshot"))
+	ESentryScreenshotSource ScreenshotSource;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Include UI in screenshots", ToolTip = "Flag indicating whether backbuffer screenshots include the UI drawn on top of the game viewport. Excluding it requires the viewport to render the scene into a separate render target.",
+			EditCondition = "AttachScreenshot && ScreenshotSource == ESentryScreenshotSource::BackBuffer", EditConditionHides))
+	bool ScreenshotIncludeUI;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Screenshot JPEG quality", ToolTip = "Quality of JPEG screenshots (1-100).", ClampMin = 1, ClampMax = 100,
+			EditCondition = "AttachScreenshot && ScreenshotFormat == ESentryScreenshotFormat::Jpeg", EditConditionHides))
+	int32 ScreenshotJpegQuality;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Screenshot max dimension", ToolTip = "Screenshots larger than this in any dimension are downscaled before encoding, keeping the aspect ratio (0 for no limit).", ClampMin = 0, EditCondition = "AttachScreenshot"))
+	int32 ScreenshotMaxDimension;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Cache last frame screenshot", ToolTip = "Flag indicating whether to periodically keep a low-resolution encoded frame in memory and attach it on crash instead of capturing the screen in the crash handler. Helps when the render thread is the one that crashed. Frames are read back from the backbuffer asynchronously, which requires Unreal Engine 5.0 or newer.",
+			EditCondition = "AttachScreenshot"))
+	bool CacheLastFrameScreenshot;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Last frame cache interval (seconds)", ToolTip = "Interval between captures of the cached last frame screenshot.", ClampMin = 0.1,
+			EditCondition = "AttachScreenshot && CacheLastFrameScreenshot", EditConditionHides))
+	float LastFrameScreenshotInterval;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
 		Meta = (DisplayName = "Attach GPU dump", ToolTip = "Flag indicating whether to attach GPU crash dump when an error occurs. Currently this feature is supported for Nvidia graphics only."))
 	bool AttachGpuDump;
 
 	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
-		Meta = (DisplayName = "Attach emergency crash video", ToolTip = "Flag indicating whether to encode and attach the video circular buffer as an MP4 when a crash occurs. Requires RuntimeVideoRecorder plugin and active video recording."))
+		Meta = (DisplayName = "Enable GPU breadcrumbs (for Windows/Linux only)", ToolTip = "Flag indicating whether to track the last passes submitted to and completed by the GPU using fences, and to add them as a context to GPU crashes on any graphics vendor. Custom passes can be marked with SentryGpuMarkers::Add."))
+	bool EnableGpuBreadcrumbs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "GPU breadcrumbs capacity", ToolTip = "Number of most recent GPU pass markers to keep.", ClampMin = 8, ClampMax = 1024,
+			EditCondition = "EnableGpuBreadcrumbs"))
+	int32 GpuBreadcrumbsCapacity;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach emergency crash video", ToolTip = "Flag indicating whether to encode and attach the video circular buffer as an MP4 when a crash occurs. Requires SentryVideo module and RuntimeVideoRecorder plugin and active video recording."))
 	bool AttachCrashVideo;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach crash frame strip", ToolTip = "Flag indicating whether to attach a sprite sheet of downscaled frames captured before a crash. Lightweight alternative to crash video that requires frame strip recording to be started via crash video handler (Unreal Engine 5.0 or newer). Currently this feature is supported for Windows and Linux only."))
+	bool AttachCrashFrameStrip;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Defer crash video upload", ToolTip = "Flag indicating whether the crash handler should only persist the segmented crash video and leave the upload to the next application launch. Keeps crash handling fast. The video is sent as a separate event referencing the crash event ID.", EditCondition = "AttachCrashVideo"))
+	bool DeferCrashVideoUpload;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Upload crash video preview first", ToolTip = "Flag indicating whether only the newest part of a deferred crash video fitting the preview size is uploaded on the next launch. The rest of the clip stays on disk until USentrySubsystem::RequestFullCrashVideo is called for the crash event.", EditCondition = "AttachCrashVideo && DeferCrashVideoUpload"))
+	bool UploadCrashVideoPreviewFirst;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Crash video preview size (KB)", ToolTip = "Max size of the crash video preview. At least the newest video segment is uploaded even if it's larger.", ClampMin = 1, EditCondition = "AttachCrashVideo && DeferCrashVideoUpload && UploadCrashVideoPreviewFirst"))
+	int32 CrashVideoPreviewSizeKB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Full crash video retention (days)", ToolTip = "Days the rest of a crash video is kept on disk after its preview was uploaded (0 to keep it until requested).", ClampMin = 0, EditCondition = "AttachCrashVideo && DeferCrashVideoUpload && UploadCrashVideoPreviewFirst"))
+	int32 CrashVideoFullClipRetentionDays;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Crash video sample rate", ToolTip = "Share of crashes that get an emergency crash video (0.0 - 1.0). Crashes that don't skip encoding and uploading the video altogether.", ClampMin = 0.0, ClampMax = 1.0, EditCondition = "AttachCrashVideo"))
+	float CrashVideoSampleRate;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Crash video de-duplication (days)", ToolTip = "Crashes at the same place as a crash that got a video within this many days don't get another one (0 to send a video for every crash). Currently this feature is supported for Windows and Linux only.", ClampMin = 0, EditCondition = "AttachCrashVideo"))
+	int32 CrashVideoDeduplicationDays;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach video to ensures", ToolTip = "Flag indicating whether to send a clip of the recent gameplay for every captured ensure without interrupting the crash video recording. The clip is sent as a separate event referencing the ensure event ID.", EditCondition = "AttachCrashVideo"))
+	bool AttachEnsureVideo;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Min interval between ensure videos (seconds)", ToolTip = "Ensures captured sooner than this after the last sent ensure video don't get a video of their own.", ClampMin = 0.0, EditCondition = "AttachCrashVideo && AttachEnsureVideo"))
+	float EnsureVideoMinInterval;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Start crash video recording automatically", ToolTip = "Flag indicating whether to start crash video recording once the engine is initialized with the first preset matching the device profile and scalability level, and to switch presets when the scalability settings change. Not applied in the editor. Requires SentryVideo module and RuntimeVideoRecorder plugin.", EditCondition = "AttachCrashVideo"))
+	bool AutoStartCrashVideoRecording;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Crash video presets", ToolTip = "Recording configurations by device profile and scalability level. The first matching preset wins, no recording is started if none matches.", EditCondition = "AttachCrashVideo && AutoStartCrashVideoRecording"))
+	TArray<FCrashVideoPreset> CrashVideoPresets;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach server replay (dedicated servers only)", ToolTip = "Flag indicating whether dedicated servers should keep a rolling network replay of the last seconds of the match and attach it to crash reports. Lets the server's view of the match be replayed where there's no viewport to record a crash video of. Crash attachments are supported for Windows and Linux only."))
+	bool AttachServerReplay;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Server replay duration (seconds)", ToolTip = "Seconds of the match the attached replay covers at least.", ClampMin = 20.0, EditCondition = "AttachServerReplay"))
+	float ServerReplayDurationSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Server replay checkpoint interval (seconds)", ToolTip = "Interval between replay checkpoints. Longer intervals lower the recording overhead but make seeking in the replay slower.", ClampMin = 1.0, EditCondition = "AttachServerReplay"))
+	float ServerReplayCheckpointIntervalSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Server replay max size (MB)", ToolTip = "Max size of the replay segments kept on disk. Segments are rotated early when they would exceed it.", ClampMin = 4, EditCondition = "AttachServerReplay"))
+	int32 ServerReplayMaxSizeMB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Attach server replay to ensures", ToolTip = "Flag indicating whether to send the server replay for every captured ensure. The replay is sent as a separate event referencing the ensure event ID.", EditCondition = "AttachServerReplay"))
+	bool AttachServerReplayToEnsures;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Min interval between ensure server replays (seconds)", ToolTip = "Ensures captured sooner than this after the last sent ensure server replay don't get a replay of their own. Copies of the replay waiting to be sent share the server replay max size.", ClampMin = 0.0, EditCondition = "AttachServerReplay && AttachServerReplayToEnsures"))
+	float ServerReplayEnsureMinInterval;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Attachments",
 		Meta = (DisplayName = "Max attachment size in bytes", Tooltip = "Max attachment size for each attachment in bytes. Default is 20 MiB compressed but this size is planned to be increased. Please also check the maximum attachment size of Relay to make sure your attachments don't get discarded there: https://docs.sentry.io/product/relay/options/"))
 	int32 MaxAttachmentSize;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Max upload bandwidth (KB/s)", ToolTip = "Average upload rate crash videos and video snapshots are kept under (0 for no limit). Uploads are paced rather than throttled, so a single upload is still sent at full speed.", ClampMin = 0))
+	int32 MaxUploadBandwidthKBps;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Defer large uploads during matches", ToolTip = "Flag indicating whether large crash video and video snapshot uploads should wait while the game is connected to a server or has clients connected."))
+	bool DeferLargeUploadsDuringMatch;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Attachments",
+		Meta = (DisplayName = "Large upload threshold (KB)", ToolTip = "Size from which uploads are deferred until the networked match ends, if enabled, and while the transport is offline or rate limited. Smaller uploads are left to the transport.", ClampMin = 0))
+	int32 LargeUploadThresholdKB;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
 		Meta = (DisplayName = "Enable structured logging", ToolTip = "Flag indicating whether to enable structured logging that forwards UE_LOG calls to Sentry logger."))
 	bool EnableStructuredLogging;
 
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Structured Logging",
-		Meta = (DisplayName = "Structured logging categories", ToolTip = "List of UE_LOG categories to forward to Sentry structured logging. Leave empty to forward all.", EditCondition = "EnableStructuredLogging"))
+		Meta = (DisplayName = "Structured logging categories", ToolTip = "List of UE_LOG categories to forward to Sentry structured logging. Supports * and ? wildcards (e.g. LogNet*). Leave empty to forward all.", EditCondition = "EnableStructuredLogging"))
 	TArray<FString> StructuredLoggingCategories;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Log filter rules (for Windows/Linux only)", ToolTip = "Rules evaluated in order before the `beforeLog` handler, the first matching rule decides which share of the log is kept. Logs matching no rule are kept.",
+			EditCondition = "EnableStructuredLogging"))
+	TArray<FSentryLogFilterRule> StructuredLoggingFilterRules;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Log rate limit per category", ToolTip = "Max number of log lines per second forwarded to Sentry logs and breadcrumbs for each log category (0 for no limit). Dropped lines are summarized in the next forwarded line.", ClampMin = 0))
+	float LogRateLimit;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Log rate limit burst", ToolTip = "Max number of log lines a category can forward at once before the rate limit applies.", ClampMin = 1,
+			EditCondition = "LogRateLimit > 0", EditConditionHides))
+	int32 LogRateLimitBurst;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Collapse repeated logs window (seconds)", ToolTip = "Time during which repeats of the last line of a log category are collapsed into a single \"repeated N times\" line (0 to forward every repeat).", ClampMin = 0))
+	float RepeatedLogsWindow;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Structured Logging",
 		Meta = (DisplayName = "Forward log messages with verbosity level", EditCondition = "EnableStructuredLogging"))
 	FStructuredLoggingLevels StructuredLoggingLevels;
@@ -278,10 +574,48 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Also send breadcrumbs", ToolTip = "Whether to also send breadcrumbs when structured logging is enabled.", EditCondition = "EnableStructuredLogging"))
 	bool bSendBreadcrumbsWithStructuredLogging;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Forward logs asynchronously", ToolTip = "Whether to forward structured logs to Sentry in batches on a background thread instead of on the thread that emitted them. Fatal logs are always forwarded right away.",
+			EditCondition = "EnableStructuredLogging"))
+	bool bAsyncStructuredLogging;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Async log queue capacity", ToolTip = "Max number of logs waiting to be forwarded. Logs emitted while the queue is full are dropped.", ClampMin = 1,
+			EditCondition = "EnableStructuredLogging && bAsyncStructuredLogging", EditConditionHides))
+	int32 StructuredLoggingQueueCapacity;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Log batch max items", ToolTip = "Max number of logs handed over from the async log queue to the platform SDK at once. Reaching it hands the queued logs over without waiting for the flush interval. Uploads are still batched by the platform SDK itself. Only applies when logs are forwarded asynchronously.", ClampMin = 1,
+			EditCondition = "EnableStructuredLogging && bAsyncStructuredLogging", EditConditionHides))
+	int32 LogBatchMaxItems;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Log batch max size (bytes)", ToolTip = "Max size of the log messages handed over from the async log queue to the platform SDK at once. Reaching it hands the queued logs over without waiting for the flush interval. Uploads are still batched by the platform SDK itself. Only applies when logs are forwarded asynchronously.", ClampMin = 1024,
+			EditCondition = "EnableStructuredLogging && bAsyncStructuredLogging", EditConditionHides))
+	int32 LogBatchMaxBytes;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Structured Logging",
+		Meta = (DisplayName = "Log flush interval (ms)", ToolTip = "Max time logs wait in the async log queue before they are handed over to the platform SDK. Longer intervals mean fewer wake-ups of the forwarding thread but don't change how the platform SDK batches its uploads. Logs still held are handed over when Sentry is closed. Only applies when logs are forwarded asynchronously.", ClampMin = 1,
+			EditCondition = "EnableStructuredLogging && bAsyncStructuredLogging", EditConditionHides))
+	int32 LogFlushIntervalMs;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Breadcrumbs",
 		Meta = (DisplayName = "Max breadcrumbs", Tooltip = "Total amount of breadcrumbs that should be captured."))
 	int32 MaxBreadcrumbs;
 
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Breadcrumbs",
+		Meta = (DisplayName = "Min breadcrumb level", Tooltip = "Breadcrumbs below this level are discarded before their message and data are built."))
+	ESentryLevel MinBreadcrumbLevel;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Breadcrumbs",
+		Meta = (DisplayName = "Retain breadcrumbs by level (for Windows/Linux only)", Tooltip = "Flag indicating whether a full breadcrumb buffer of a scope evicts the least important breadcrumbs first rather than the oldest ones, so that bursts of debug and info breadcrumbs keep the warnings and errors."))
+	bool bRetainBreadcrumbsByLevel;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Breadcrumbs",
+		Meta = (DisplayName = "Reserved breadcrumbs per level (%)", Tooltip = "Share of the max breadcrumbs reserved for the most recent breadcrumbs of each level, which the more important levels can't evict.", ClampMin = 0, ClampMax = 20,
+			EditCondition = "bRetainBreadcrumbsByLevel"))
+	int32 BreadcrumbLevelReservedPercent;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Breadcrumbs",
 		Meta = (DisplayName = "Automatically add breadcrumbs for events"))
 	FAutomaticBreadcrumbs AutomaticBreadcrumbs;
@@ -290,6 +624,34 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Automatically add breadcrumbs for log messages with verbosity level"))
 	FAutomaticBreadcrumbsForLogs AutomaticBreadcrumbsForLogs;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Max tags (for Windows/Linux only)", ToolTip = "Max amount of tags in a scope. Least recently set tags are evicted once exceeded, 0 for no limit.", ClampMin = 0))
+	int32 MaxScopeTags;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Max extras (for Windows/Linux only)", ToolTip = "Max amount of extras in a scope. Least recently set extras are evicted once exceeded, 0 for no limit.", ClampMin = 0))
+	int32 MaxScopeExtras;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Max contexts (for Windows/Linux only)", ToolTip = "Max amount of contexts in a scope. Least recently set contexts are evicted once exceeded, 0 for no limit.", ClampMin = 0))
+	int32 MaxScopeContexts;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Max context depth (for Windows/Linux only)", ToolTip = "Max nesting of arrays and maps within a context. Deeper values are dropped, 0 for no limit.", ClampMin = 0))
+	int32 MaxContextDepth;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Max context size (for Windows/Linux only)", ToolTip = "Max amount of values in a context and in each of its nested arrays and maps. Values exceeding it are dropped, 0 for no limit.", ClampMin = 0))
+	int32 MaxContextValues;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Max event size, KB (for Windows/Linux only)", ToolTip = "Max serialized size of an event. Oversized events are trimmed by dropping the oldest breadcrumbs, then the largest extras and then the largest contexts until they fit, 0 for no limit.", ClampMin = 0))
+	int32 MaxEventPayloadSizeKB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Scope Limits",
+		Meta = (DisplayName = "Track payload sizes (for Windows/Linux only)", ToolTip = "Flag indicating whether the serialized size of each event and its attachments should be accounted, see GetPayloadStats."))
+	bool TrackPayloadSizes;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Release & Health",
 		Meta = (DisplayName = "Enable automatic session tracking ", ToolTip = "Flag indicating whether the SDK should automatically start a new session when it is initialized."))
 	bool EnableAutoSessionTracking;
@@ -306,6 +668,22 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Override release name", ToolTip = "Release name which will be used for enriching events.", EditCondition = "OverrideReleaseName"))
 	FString Release;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Release & Health",
+		Meta = (DisplayName = "Aggregate sessions", ToolTip = "Flag indicating whether sessions recorded with RecordAggregatedSession should be counted in memory and sent periodically as a single aggregate, e.g. for the players of a dedicated server. Automatic session tracking of the process itself is usually disabled on servers."))
+	bool EnableSessionAggregation;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Release & Health",
+		Meta = (DisplayName = "Session aggregates flush interval (seconds)", ToolTip = "Interval at which the counted sessions are sent.", ClampMin = 10.0, EditCondition = "EnableSessionAggregation"))
+	float SessionAggregationFlushInterval;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Metrics",
+		Meta = (DisplayName = "Enable metrics", ToolTip = "Flag indicating whether counters, gauges and distributions recorded with the metrics API should be aggregated locally in 10 second buckets and sent periodically."))
+	bool EnableMetrics;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Metrics",
+		Meta = (DisplayName = "Metrics flush interval (seconds)", ToolTip = "Interval at which the aggregated metrics are sent.", ClampMin = 10.0, EditCondition = "EnableMetrics"))
+	float MetricsFlushInterval;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
 		Meta = (InlineEditConditionToggle))
 	bool UseProxy;
@@ -314,6 +692,61 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "HTTP proxy", ToolTip = "HTTP proxy through which requests can be tunneled to Sentry.", EditCondition = "UseProxy"))
 	FString ProxyUrl;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Use batched transport (for Windows/Linux only)", ToolTip = "Flag indicating whether envelopes should be sent through the engine's HTTP module with sessions and logs merged into fewer requests. Not used if HTTP proxy is set, since the engine's HTTP module can't tunnel only Sentry requests through it."))
+	bool EnableBatchedTransport;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Batch window (seconds)", ToolTip = "Time during which sessions and logs are collected before they are sent in a single request. Events and transactions are always sent right away.", ClampMin = 0.0, EditCondition = "EnableBatchedTransport"))
+	float TransportBatchWindow;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Compress envelopes", ToolTip = "Flag indicating whether envelopes sent through the batched transport should be gzipped. Large text attachments (e.g. game logs) are gzipped on their own as well so that they take less of the attachment quota, they are uploaded with the `.gz` extension.", EditCondition = "EnableBatchedTransport"))
+	bool CompressEnvelopes;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Spool envelopes while offline", ToolTip = "Flag indicating whether envelopes that couldn't be sent through the batched transport should be persisted and retried later with an exponential backoff, also across sessions.", EditCondition = "EnableBatchedTransport"))
+	bool EnableOfflineSpool;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Max offline spool size (MB)", ToolTip = "Max disk space taken by spooled envelopes. Once reached, the oldest logs and sessions are evicted first, then transactions, then events.", ClampMin = 1, EditCondition = "EnableBatchedTransport && EnableOfflineSpool"))
+	int32 OfflineSpoolMaxSizeMB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Deduplicate attachments", ToolTip = "Flag indicating whether attachments sent through the batched transport with the same content as an attachment of an earlier event should be replaced with a reference to that event instead of being uploaded again.", EditCondition = "EnableBatchedTransport"))
+	bool DeduplicateAttachments;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Attachment deduplication window (minutes)", ToolTip = "Time after which an attachment is uploaded again even if its content has been sent before. If set to 0, attachments are deduplicated for the whole session.", ClampMin = 0.0, EditCondition = "EnableBatchedTransport && DeduplicateAttachments"))
+	float AttachmentDeduplicationWindowMinutes;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Serialize static scope once", ToolTip = "Flag indicating whether release, environment, dist, the default and hardware contexts and promoted tags should be serialized once and spliced into events sent through the batched transport instead of being serialized for every event. Crash reports are not affected.", EditCondition = "EnableBatchedTransport"))
+	bool SerializeStaticScopeOnce;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Warm up transport connection (for Linux only)", ToolTip = "Flag indicating whether a connection to the ingest host should be opened right after initialization and kept alive by the engine's HTTP connection pool so that the first envelope doesn't wait for the DNS lookup and the TLS handshake. Only applies to the batched transport.", EditCondition = "EnableBatchedTransport"))
+	bool WarmUpTransportConnection;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Adaptive sampling", ToolTip = "Flag indicating whether info and debug events and logs as well as transactions should be sampled out as envelopes pile up in the batched transport, e.g. while the server is unreachable. Warnings, errors and crashes are never sampled out, and the rate recovers once the backlog drains.", EditCondition = "EnableBatchedTransport"))
+	bool EnableAdaptiveSampling;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Adaptive sampling max pending envelopes", ToolTip = "Number of queued, in-flight and spooled envelopes at which low-priority payloads are kept at the min rate. Sampling starts once half of it is reached.", ClampMin = 1,
+			EditCondition = "EnableBatchedTransport && EnableAdaptiveSampling"))
+	int32 AdaptiveSamplingMaxPendingEnvelopes;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Adaptive sampling max pending size (MB)", ToolTip = "Size of queued and spooled envelopes at which low-priority payloads are kept at the min rate. Sampling starts once half of it is reached.", ClampMin = 1,
+			EditCondition = "EnableBatchedTransport && EnableAdaptiveSampling"))
+	int32 AdaptiveSamplingMaxPendingSizeMB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Adaptive sampling min rate", ToolTip = "Rate low-priority payloads are kept at once the backlog reaches its limits.", ClampMin = 0.0f, ClampMax = 1.0f,
+			EditCondition = "EnableBatchedTransport && EnableAdaptiveSampling"))
+	float AdaptiveSamplingMinRate;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Hooks",
 		Meta = (DisplayName = "Custom `beforeSend` event handler", ToolTip = "Custom handler for processing events before sending them to Sentry."))
 	TSubclassOf<USentryBeforeSendHandler> BeforeSendHandler;
@@ -326,6 +759,15 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Custom `beforeLog` event handler", ToolTip = "Custom handler for processing structured logs before sending them to Sentry."))
 	TSubclassOf<USentryBeforeLogHandler> BeforeLogHandler;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Hooks",
+		Meta = (DisplayName = "Handler time budget (ms)", ToolTip = "Max time a single call of a custom handler or traces sampler should take. Slower calls are reported with a warning, 0 for no budget.", ClampMin = 0.0f))
+	float HandlerTimeBudgetMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Hooks",
+		Meta = (DisplayName = "Disable handlers exceeding the budget", ToolTip = "Flag indicating whether a handler exceeding the time budget several calls in a row should be skipped for the rest of the session.",
+			EditCondition = "HandlerTimeBudgetMs > 0"))
+	bool bDisableSlowHandlers;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Windows",
 		Meta = (DisplayName = "Override Windows default crash capturing mechanism (UE 5.2+)", ToolTip = "Flag indicating whether to capture crashes automatically on Windows as an alternative to Crash Reporter."))
 	bool EnableAutoCrashCapturing;
@@ -334,10 +776,31 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Sentry database location", ToolTip = "Location where Sentry stores its internal/temporary files."))
 	ESentryDatabaseLocation DatabaseLocation;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Separate database per instance", ToolTip = "Flag indicating whether each game or server instance launched with the `-SentryInstance=<key>` command line argument keeps its own Sentry database. Useful when many instances run on the same machine so that they don't share the Crashpad database, session run lock and log rings. Key should be stable across restarts (e.g. a server slot) so that crashes of an instance are uploaded on its next launch. Instances launched without the argument use the default database."))
+	bool SeparateDatabasePerInstance;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
 		Meta = (DisplayName = "Delay app shutdown until crash report uploaded (for Crashpad only)", ToolTip = "Flag indicating whether Crashpad should delay application shutdown until the upload of the crash report is completed. It is useful in Docker environment where the life cycle of all processes is bound by the root process."))
 	bool CrashpadWaitForUpload;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Shutdown timeout, milliseconds (for Windows/Linux only)", ToolTip = "Max time closing Sentry waits for the transport to send pending envelopes. Envelopes that aren't sent in time are persisted and sent on the next launch.", ClampMin = 0,
+			EditCondition = "!FastExitOnClose"))
+	int32 ShutdownTimeoutMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Fast exit on close (for Windows/Linux only)", ToolTip = "Flag indicating whether closing Sentry should persist pending envelopes right away and send them on the next launch instead of waiting for them to be sent. With the batched transport, requires the offline spool; requests already in flight aren't waited for."))
+	bool FastExitOnClose;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Max crash report age in database (days)", ToolTip = "Crash reports older than this are deleted from the Sentry database in the background after initialization. 0 keeps them until Crashpad prunes them itself.", ClampMin = 0))
+	int32 DatabaseMaxReportAgeDays;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Native",
+		Meta = (DisplayName = "Max crash reports size in database (MB)", ToolTip = "Oldest crash reports are deleted from the Sentry database in the background after initialization until the rest fits this size. 0 for no limit.", ClampMin = 0))
+	int32 DatabaseMaxReportsSizeMB;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Mobile",
 		Meta = (DisplayName = "In-app includes (for Android/Apple only)", Tooltip = "A list of string prefixes of module names that belong to the app."))
 	TArray<FString> InAppInclude;
@@ -347,9 +810,88 @@ class SENTRY_API USentrySettings : public UObject
 	TArray<FString> InAppExclude;
 
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Mobile",
-		Meta = (DisplayName = "Enable ANR error tracking", Tooltip = "Flag indicating whether to enable tracking of ANR (app not responding) errors."))
+		Meta = (DisplayName = "Enable ANR error tracking", Tooltip = "Flag indicating whether to enable tracking of ANR (app not responding) errors. On Windows/Linux a watchdog thread reports the game thread not finishing a frame within the hang timeout."))
 	bool EnableAppNotRespondingTracking;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Game thread hang timeout, seconds (for Windows/Linux only)", ToolTip = "Time the game thread has to be unresponsive for before an App Hanging event with the call stacks of the game, render and RHI threads is sent. Blocking map loads aren't reported.", ClampMin = 0.5f,
+			EditCondition = "EnableAppNotRespondingTracking"))
+	float AppHangTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Render thread hang timeout, seconds (for Windows/Linux only)", ToolTip = "Time the render thread has to be unresponsive for while it has pending work before an App Hanging event is sent. The event is attributed to whichever thread stalled first. Set to 0 to not watch the render thread.", ClampMin = 0.0f,
+			EditCondition = "EnableAppNotRespondingTracking"))
+	float RenderThreadHangTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "RHI thread hang timeout, seconds (for Windows/Linux only)", ToolTip = "Time the RHI thread has to be unresponsive for while it has pending work before an App Hanging event is sent. Only used when the RHI runs on a separate thread. Set to 0 to not watch the RHI thread.", ClampMin = 0.0f,
+			EditCondition = "EnableAppNotRespondingTracking"))
+	float RHIThreadHangTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Attach crash video to app hangs (for Windows/Linux only)", ToolTip = "Flag indicating whether the newest recorded crash video segment should be attached to App Hanging events. Requires segmented crash video recording.",
+			EditCondition = "EnableAppNotRespondingTracking && AttachCrashVideo"))
+	bool AttachCrashVideoToAppHangs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Attach native stacks to ANRs (for Android only)", ToolTip = "Flag indicating whether the native call stacks of the game and render threads should be added to ANR events detected while the game is running. ANRs are only detected while the game is running before Android 11 (API level 30). Later ones are reported on the next launch from the process exit info and get the thread dump recorded by the system attached instead.",
+			EditCondition = "EnableAppNotRespondingTracking"))
+	bool AttachNativeStacksToAnrs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Report process exit reasons (for Android 11+ only)", ToolTip = "Flag indicating whether process exits the SDK doesn't report as crashes, e.g. low memory kills or kills for excessive resource usage, should be queried from the system after initialization and sent as events. Events carry the memory state at exit and the last device conditions and memory contexts of the session that exited."))
+	bool ReportProcessExitReasons;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Enable MetricKit (for iOS only)", ToolTip = "Flag indicating whether the SDK should subscribe to MetricKit. Hang, CPU exception and disk write exception diagnostics are sent as events, and launch, resume and hang time histograms of the daily metric payloads are sent as measurements of an `app.metrickit` transaction. Requires iOS 15 or newer."))
+	bool EnableMetricKit;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Enable memory sampling", ToolTip = "Flag indicating whether to periodically sample the memory usage of the game, add breadcrumbs when memory runs low or the platform requests a memory trim, and add the latest sample to events as a context."))
+	bool EnableMemorySampling;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Memory sampling interval, seconds", ToolTip = "Time between two memory samples.", ClampMin = 1.0f,
+			EditCondition = "EnableMemorySampling"))
+	float MemorySamplingIntervalSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Low memory threshold, percent", ToolTip = "Share of the physical memory that has to be available for the game not to be considered running low on memory.", ClampMin = 1, ClampMax = 90,
+			EditCondition = "EnableMemorySampling"))
+	int32 LowMemoryThresholdPercent;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Number of LLM tags per memory sample", ToolTip = "Number of Low-Level Memory Tracker tags with the most memory to include in memory samples. Only available when LLM is enabled (Unreal Engine 5.0 or newer).", ClampMin = 0, ClampMax = 16,
+			EditCondition = "EnableMemorySampling"))
+	int32 MemorySamplingTopTags;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Memory",
+		Meta = (DisplayName = "Report out of memory terminations (for Windows/Linux only)", ToolTip = "Flag indicating whether to send an Out of Memory event with the last memory sample of the previous session if it was terminated without crashing while running low on memory.",
+			EditCondition = "EnableMemorySampling"))
+	bool ReportOutOfMemoryOnNextLaunch;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Breadcrumbs and logs batch size (for Android only)", ToolTip = "Maximum number of breadcrumbs and logs accumulated natively before they are sent to the Java SDK in a single call. Pending entries are also sent once per frame and before every capture. Set to 0 to send each entry immediately.", ClampMin = 0))
+	int32 AndroidBridgeBatchSize;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Asynchronous scoped captures (for Android only)", ToolTip = "Flag indicating whether captures with a scope callback should return immediately and be processed by the Java SDK on a background thread. The scope callback runs on the calling thread against an empty scope that is merged into the event scope afterwards."))
+	bool EnableAsyncScopedCaptures;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "PixelCopy screenshots for handled errors (for Android only)", ToolTip = "Flag indicating whether screenshots attached to ensures are copied from the game surface with PixelCopy and encoded on a background thread instead of being re-rendered on the game thread. The event is sent once the copy completes; JPEG format is kept, other formats are written as WebP.",
+			EditCondition = "AttachScreenshot"))
+	bool UsePixelCopyScreenshots;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Enable device conditions sampling (for Android/Apple only)", ToolTip = "Flag indicating whether to periodically sample the thermal state, battery level, charging state and, where available, CPU and GPU clocks, and add the latest sample and its trend to events as a context. Crash video quality is lowered while the device throttles."))
+	bool EnableDeviceConditionsSampling;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Mobile",
+		Meta = (DisplayName = "Device conditions sampling interval, seconds", ToolTip = "Time between two device conditions samples.", ClampMin = 1.0f,
+			EditCondition = "EnableDeviceConditionsSampling"))
+	float DeviceConditionsSamplingIntervalSeconds;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
 		Meta = (DisplayName = "Enable tracing", ToolTip = "Flag indicating whether to enable tracing for performance monitoring."))
 	bool EnableTracing;
@@ -360,14 +902,132 @@ class SENTRY_API USentrySettings : public UObject
 
 	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
 		Meta = (DisplayName = "Traces sample rate", ToolTip = "Setting a uniform sample rate for all transactions to a number between 0.0 and 1.0. (For example, to send 20% of transactions, set TracesSampleRate to 0.2).",
-			EditCondition = "EnableTracing && SamplingType == ESentryTracesSamplingType::UniformSampleRate", EditConditionHides))
+			EditCondition = "EnableTracing && (SamplingType == ESentryTracesSamplingType::UniformSampleRate || SamplingType == ESentryTracesSamplingType::SampleRules)", EditConditionHides))
 	float TracesSampleRate;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Traces sample rules", ToolTip = "Sample rates by transaction name or operation prefix. The first matching rule wins, transactions matching none are sampled with the traces sample rate.",
+			EditCondition = "EnableTracing && SamplingType == ESentryTracesSamplingType::SampleRules", EditConditionHides))
+	TArray<FSentryTraceSampleRule> TracesSampleRules;
+
 	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
 		Meta = (DisplayName = "Traces sampler", ToolTip = "Custom handler for determining traces sample rate based on the sampling context.",
 			EditCondition = "EnableTracing && SamplingType == ESentryTracesSamplingType::TracesSampler", EditConditionHides))
 	TSubclassOf<USentryTraceSampler> TracesSampler;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Send startup transaction (for Windows/Linux only)", ToolTip = "Flag indicating whether to send a transaction with a span for every phase of the SDK initialization.", EditCondition = "EnableTracing"))
+	bool SendInitProfileTransaction;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Measure app start", ToolTip = "Flag indicating whether to measure the time from the process start to the first rendered frame and to the first map being interactive. On Windows/Linux an app start transaction is sent as well.", EditCondition = "EnableTracing"))
+	bool SendAppStartTransaction;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Send map performance transactions", ToolTip = "Flag indicating whether to send a transaction per map session with frame time percentiles, hitch count, GPU time and memory high-water mark.", EditCondition = "EnableTracing"))
+	bool EnableMapPerformanceTransactions;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Hitch threshold (ms)", ToolTip = "Frames taking at least this long are counted as hitches in map performance transactions.", ClampMin = 0.0f,
+			EditCondition = "EnableTracing && EnableMapPerformanceTransactions"))
+	float MapPerformanceHitchThresholdMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Add hitch spans (for Windows/Linux only)", ToolTip = "Flag indicating whether to add a span with the sampled game thread call stack to map performance transactions for every hitch.",
+			EditCondition = "EnableTracing && EnableMapPerformanceTransactions"))
+	bool EnableHitchSpans;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Hitch stack sampling interval (ms)", ToolTip = "Time between two samples of the game thread call stack taken for hitch spans.", ClampMin = 1.0f,
+			EditCondition = "EnableTracing && EnableMapPerformanceTransactions && EnableHitchSpans"))
+	float HitchStackSamplingIntervalMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Send sampled frame breakdown transactions", ToolTip = "Flag indicating whether to send a small `game.frame` transaction for one in every N frames with spans for the world tick and its tick groups and the render thread, RHI thread and GPU times of the frame.", EditCondition = "EnableTracing"))
+	bool EnableFrameBreakdownTransactions;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Frame breakdown sample interval (frames)", ToolTip = "Average number of frames between two sampled frames. Sampled frames are picked with some jitter.", ClampMin = 60,
+			EditCondition = "EnableTracing && EnableFrameBreakdownTransactions"))
+	int32 FrameBreakdownSampleInterval;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Attach frame time history (for Windows/Linux only)", ToolTip = "Flag indicating whether to record game thread, render thread, RHI thread and GPU times of recent frames and add them to crashes and errors as the `performance` context."))
+	bool EnableFrameTimeHistory;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Frame time history (seconds)", ToolTip = "Time span covered by the frame time history.", ClampMin = 1.0f, ClampMax = 60.0f,
+			EditCondition = "EnableFrameTimeHistory"))
+	float FrameTimeHistorySeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Attach network quality timeline (for Windows/Linux only)", ToolTip = "Flag indicating whether to sample ping, packet loss, bandwidth and saturation of the game network connection once per second and add them to crashes and errors as the `network` context."))
+	bool EnableNetworkQualityTimeline;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Network quality timeline (seconds)", ToolTip = "Time span covered by the network quality timeline.", ClampMin = 5, ClampMax = 300,
+			EditCondition = "EnableNetworkQualityTimeline"))
+	int32 NetworkQualityTimelineSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Track PSO cache misses", ToolTip = "Flag indicating whether to count pipeline state objects compiled at first use because they were missing from the PSO cache (new PSOs logged in frames that hitched), estimate the stall they caused and keep the totals in the `pso` context and the `pso.misses` and `pso.stall` metrics. Requires PSO logging to be enabled (r.ShaderPipelineCache.LogPSO)."))
+	bool EnablePsoTracking;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "PSO compile stall span threshold (ms)", ToolTip = "Estimated stall a frame with PSO cache misses has to exceed for a `pso.compile` span to be added to the map session transaction. Requires map performance transactions.", ClampMin = 1.0f,
+			EditCondition = "EnablePsoTracking"))
+	float PsoStallSpanThresholdMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Track garbage collection pauses", ToolTip = "Flag indicating whether to record the duration of every garbage collection pause and the number of objects it purged as the `gc.pause` and `gc.objects_purged` metrics and in the frame time history."))
+	bool EnableGcTracking;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Garbage collection span threshold (ms)", ToolTip = "Pause a garbage collection has to exceed for a `gc` span to be added to the map session transaction. Requires map performance transactions.", ClampMin = 1.0f,
+			EditCondition = "EnableGcTracking"))
+	float GcPauseSpanThresholdMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Track synchronous file reads on the game thread", ToolTip = "Flag indicating whether to insert a platform file layer timing synchronous file opens and reads on the game thread. Slow ones are recorded as the `file_io.sync` metric and as `file.read` spans with the file path and call stack in map session transactions. Requires restarting the game.", ConfigRestartRequired = true))
+	bool EnableSyncFileIoTracking;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Synchronous file read threshold (ms)", ToolTip = "Time a synchronous file open or read on the game thread has to exceed to be reported.", ClampMin = 0.1f,
+			EditCondition = "EnableSyncFileIoTracking"))
+	float SyncFileIoThresholdMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Send map load transactions", ToolTip = "Flag indicating whether to send a `map.load` transaction with spans for the map load, level streaming and async loading bursts every time a map is loaded or levels are streamed in.", EditCondition = "EnableTracing"))
+	bool EnableLoadTransactions;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Async loading span threshold (ms)", ToolTip = "Async loading bursts shorter than this aren't added to map load transactions.", ClampMin = 0.0f,
+			EditCondition = "EnableTracing && EnableLoadTransactions"))
+	float AsyncLoadSpanThresholdMs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Trace HTTP requests", ToolTip = "Flag indicating whether requests passed to `TraceHttpRequest` get an `http.client` span and distributed tracing headers. When disabled, the call does nothing.", EditCondition = "EnableTracing"))
+	bool EnableHttpTracing;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Trace propagation targets", ToolTip = "Tracing headers are only added to requests the URL of which contains one of these strings. If empty, headers are added to all traced requests.",
+			EditCondition = "EnableTracing && EnableHttpTracing"))
+	TArray<FString> HttpTracePropagationTargets;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Enable profiling", ToolTip = "Flag indicating whether to profile sampled transactions. On Windows/Linux the hottest game and render thread functions are attached to transactions as data.", EditCondition = "EnableTracing"))
+	bool EnableProfiling;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Profiles sample rate", ToolTip = "Share of sampled transactions that are profiled, a number between 0.0 and 1.0.", ClampMin = 0.0f, ClampMax = 1.0f,
+			EditCondition = "EnableTracing && EnableProfiling"))
+	float ProfilesSampleRate;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Performance Monitoring",
+		Meta = (DisplayName = "Profiler sampling frequency (for Windows/Linux only)", ToolTip = "Number of call stack samples taken per second on each of the game and render threads.", ClampMin = 1.0f, ClampMax = 1000.0f,
+			EditCondition = "EnableTracing && EnableProfiling"))
+	float ProfilerSamplingFrequency;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "General|Misc",
 		Meta = (DisplayName = "Editor DSN", ToolTip = "The Editor DSN (Data Source Name) if you want to isolate editor crashes from packaged game crashes, defaults to Dsn if not provided."))
 	FString EditorDsn;
@@ -388,6 +1048,31 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Enable for promoted builds only", ToolTip = "Flag indicating whether to enable for promoted builds only."))
 	bool EnableForPromotedBuildsOnly;
 
+	UPROPERTY(Config, EditAnywhere, Category = "General|Misc",
+		Meta = (DisplayName = "Coalesce scope updates", ToolTip = "Flag indicating whether tags and contexts set on the global scope should be accumulated and applied at most once per frame. Pending changes are also applied before every capture."))
+	bool bCoalesceScopeUpdates;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Misc",
+		Meta = (DisplayName = "Call platform SDK asynchronously (experimental)", ToolTip = "Flag indicating whether scope updates, breadcrumbs and captures should be queued and handed over to the platform SDK on a worker thread so that the calling thread never waits for its locks. Captures return an event ID generated upfront. Scope update coalescing isn't used in this mode."))
+	bool bAsyncPlatformCalls;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Misc",
+		Meta = (DisplayName = "Async platform call queue capacity", ToolTip = "Max number of platform SDK calls waiting for the worker thread. Once reached, the calling thread drains the queue itself before making the call.", ClampMin = 1,
+			EditCondition = "bAsyncPlatformCalls", EditConditionHides))
+	int32 AsyncPlatformCallsQueueCapacity;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Misc",
+		Meta = (DisplayName = "Write crash handler timeline", ToolTip = "Flag indicating whether the duration of each crash handler stage should be written to Saved/SentryCrashTimeline.json. Meant for measuring how close the handler gets to the crash backend timeout. Windows/Linux only."))
+	bool WriteCrashTimeline;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Misc",
+		Meta = (DisplayName = "Background thread priority", ToolTip = "Priority of the threads the plugin sends envelopes and forwards structured logs on."))
+	ESentryThreadPriority BackgroundThreadPriority;
+
+	UPROPERTY(Config, EditAnywhere, Category = "General|Misc",
+		Meta = (DisplayName = "Background thread affinity mask", ToolTip = "Cores the threads the plugin sends envelopes and forwards structured logs on are allowed to run on, one bit per core (0 to let the platform decide).", ClampMin = 0))
+	int64 BackgroundThreadAffinityMask;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Debug Symbols",
 		Meta = (DisplayName = "Upload debug symbols automatically", ToolTip = "Flag indicating whether to automatically upload debug symbols to Sentry when packaging the app."))
 	bool UploadSymbolsAutomatically;
@@ -412,6 +1097,16 @@ class SENTRY_API USentrySettings : public UObject
 		Meta = (DisplayName = "Diagnostic Level", ToolTip = "Logs verbosity level during symbol uploading.", EditCondition = "UploadSymbolsAutomatically"))
 	ESentryCliLogLevel DiagnosticLevel;
 
+	UPROPERTY(Config, EditAnywhere, Category = "Debug Symbols",
+		Meta = (DisplayName = "Parallel upload jobs", ToolTip = "Number of sentry-cli uploads to run in parallel, with debug files split between them by size. Files already uploaded by previous builds are skipped. 0 uploads everything with a single sentry-cli run.",
+			ClampMin = 0, ClampMax = 32, EditCondition = "UploadSymbolsAutomatically"))
+	int32 SymbolUploadJobs;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Debug Symbols",
+		Meta = (DisplayName = "Skip previously uploaded symbols", ToolTip = "Flag indicating whether to keep track of uploaded debug IDs in the project's Intermediate directory and skip unchanged debug files on subsequent builds. The cache isn't aware of files deleted on the server or of uploads to another project, so it's best suited for local iteration.",
+			EditCondition = "UploadSymbolsAutomatically"))
+	bool CacheUploadedSymbols;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Debug Symbols",
 		Meta = (DisplayName = "Use legacy Sentry Gradle plugin (for Android only)", ToolTip = "Flag indicating whether to use legacy Sentry Gradle plugin for debug symbol upload. No engine's Gradle version bump is required if enabled. This can be used as a fallback if the newer Gradle 7.5 causing compatibility issues with other third-party plugins.",
 			EditCondition = "UploadSymbolsAutomatically"))
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <type_traits>
+
+class UScriptStruct;
+
+/** Writes the current snapshot of the state into the given buffer, which is as large as the registered snapshot size. */
+typedef TFunction<void(void* OutSnapshot)> FSentryStateProvider;
+
+namespace SentryStateTimeline
+{
+	/**
+	 * Registers a provider of a small gameplay state snapshot, e.g. the player position, health or the current quest step.
+	 * Snapshots are sampled at a low fixed rate, delta-compressed against the previous one and attached to crashes and errors
+	 * on Windows/Linux as state_timeline.json. Snapshots are written as hex strings. Has to be called on the game thread.
+	 *
+	 * @param Name Name the samples are listed under.
+	 * @param SnapshotSize Size of the snapshot in bytes, up to 4 KB.
+	 * @param Provider Writes the snapshot, called on the game thread.
+	 *
+	 * @return Handle to unregister the provider with, INDEX_NONE if it couldn't be registered.
+	 */
+	SENTRY_API int32 RegisterProvider(const FString& Name, int32 SnapshotSize, FSentryStateProvider Provider);
+
+	/**
+	 * Registers a provider of a snapshot of a plain old data struct, written with the names and values of its properties.
+	 *
+	 * @param Struct Type of the snapshot, it can hold numbers, booleans, enums, names and nested structs of those but no strings, texts, containers or object references.
+	 */
+	SENTRY_API int32 RegisterStructProvider(const FString& Name, const UScriptStruct* Struct, FSentryStateProvider Provider);
+
+	/** Registers a provider of a trivially copyable snapshot type. */
+	template <typename SnapshotType>
+	int32 RegisterProvider(const FString& Name, TFunction<void(SnapshotType&)> Provider)
+	{
+		static_assert(std::is_trivially_copyable<SnapshotType>::value, "Snapshots are compared and copied bytewise");
+
+		return RegisterProvider(Name, sizeof(SnapshotType), [Provider = MoveTemp(Provider)](void* OutSnapshot)
+		{
+			Provider(*static_cast<SnapshotType*>(OutSnapshot));
+		});
+	}
+
+	/** Unregisters the provider, its samples are dropped from the timeline. */
+	SENTRY_API void UnregisterProvider(int32 Handle);
+}
@@ -2,10 +2,20 @@
 
 #pragma once
 
+#include "Async/Future.h"
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "Templates/Atomic.h"
+#include "UObject/ObjectKey.h"
 
 #include "SentryDataTypes.h"
+#include "SentryEventView.h"
+#include "SentryInitProfile.h"
+#include "SentryMetricKey.h"
+#include "SentryMemoryStats.h"
+#include "SentryPayloadStats.h"
+#include "SentryTransportStats.h"
 #include "SentryScope.h"
 #include "SentryTransactionOptions.h"
 #include "SentryVariant.h"
@@ -21,16 +31,42 @@ class USentryBeforeSendHandler;
 class USentryBeforeBreadcrumbHandler;
 class USentryBeforeLogHandler;
 class USentryTransaction;
+class USentrySpan;
 class USentryTraceSampler;
 class USentryTransactionContext;
 
+class ISentryAttachment;
 class ISentrySubsystem;
+class ISentryBreadcrumb;
+class ISentryEvent;
+class FSentryCommandQueue;
 class FSentryOutputDevice;
 class FSentryErrorOutputDevice;
+class FSentryScopeBatch;
+class FSentryWorldScopes;
+class FSentrySessionAggregator;
+class FSentryEnvelopeSender;
+class FSentryFrameBreakdown;
+class FSentryLoadTracker;
+class FSentryMapPerformance;
+class FSentryEventLimiter;
+class FSentryHitchDetector;
+struct FSentrySyncFileIo;
+class FSentryHangWatchdog;
+class FSentryAppStart;
+class FSentryUploadScheduler;
+struct FSentryPendingCrashVideo;
+class ISentryTransaction;
+class ISentrySpan;
+class IHttpRequest;
+struct FSentryHardwareContexts;
 
 DECLARE_DELEGATE_OneParam(FConfigureSettingsNativeDelegate, USentrySettings*);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FConfigureSettingsDelegate, USentrySettings*, Settings);
 
+DECLARE_DELEGATE_OneParam(FScreenshotAttachedNativeDelegate, bool);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FScreenshotAttachedDelegate, bool, bAttached);
+
 /**
  * Sentry main API entry point.
  */
@@ -54,6 +90,20 @@ public:
 	void InitializeWithSettings(const FConfigureSettingsDelegate& OnConfigureSettings);
 	void InitializeWithSettings(const FConfigureSettingsNativeDelegate& OnConfigureSettings);
 
+	/**
+	 * Changes the settings that can be applied without re-initializing the SDK: event and traces sample rates,
+	 * structured logging levels and categories, and log levels added as breadcrumbs. Other values changed by the callback
+	 * take effect on the next initialization.
+	 *
+	 * Sample rates are only updated on Windows and Linux. On Android and Apple platforms the rates the SDK was initialized
+	 * with stay in effect until it's re-initialized, while the logging and breadcrumb levels are updated everywhere.
+	 *
+	 * @param OnConfigureSettings The callback to configure the settings.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry")
+	void UpdateSettings(const FConfigureSettingsDelegate& OnConfigureSettings);
+	void UpdateSettings(const FConfigureSettingsNativeDelegate& OnConfigureSettings);
+
 	/** Closes the Sentry SDK. */
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void Close();
@@ -163,6 +213,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void ClearAttachments();
 
+	/**
+	 * Captures a screenshot of the game viewport and adds it as an attachment to the current scope once it's ready.
+	 * Only the pixel copy happens on the game thread, compression and writing to disk run on a background task.
+	 *
+	 * @param OnAttached The callback invoked on the game thread once the screenshot was attached or failed to be captured.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (AutoCreateRefTerm = "OnAttached"))
+	void AddScreenshotAttachmentAsync(const FScreenshotAttachedDelegate& OnAttached);
+	void AddScreenshotAttachmentAsync(const FScreenshotAttachedNativeDelegate& OnAttached);
+
 	/**
 	 * Captures the message.
 	 *
@@ -251,6 +311,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void SetContext(const FString& Key, const TMap<FString, FSentryVariant>& Values);
 
+	/**
+	 * Sets context values read from the fields of a struct. The property layout of each struct type is reflected once
+	 * and cached, afterwards the fields are written straight into the native context without building intermediate values.
+	 * Booleans, numbers, strings, names, texts, enums and nested structs are supported, other fields are skipped.
+	 *
+	 * @param Key Context key.
+	 * @param Value Struct holding the context values.
+	 */
+	template <typename StructType>
+	void SetContextFromStruct(const FString& Key, const StructType& Value)
+	{
+		SetContextFromStruct(Key, StructType::StaticStruct(), &Value);
+	}
+
+	/**
+	 * Sets context values read from the fields of a struct of the given type.
+	 *
+	 * @param Key Context key.
+	 * @param Struct Type of the struct.
+	 * @param StructData Struct holding the context values.
+	 */
+	void SetContextFromStruct(const FString& Key, const UScriptStruct* Struct, const void* StructData);
+
+	/**
+	 * Sets context values read from the fields of any struct.
+	 *
+	 * @param Key Context key.
+	 * @param Value Struct holding the context values.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Sentry", Meta = (DisplayName = "Set Context From Struct", CustomStructureParam = "Value"))
+	void K2_SetContextFromStruct(const FString& Key, const int32& Value);
+	DECLARE_FUNCTION(execK2_SetContextFromStruct);
+
 	/**
 	 * Sets global tag - key/value string pair which will be attached to every event.
 	 *
@@ -260,6 +353,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void SetTag(const FString& Key, const FString& Value);
 
+	/**
+	 * Sets several global tags at once. On Android and Apple all tags are applied with a single scope update.
+	 *
+	 * @param Tags Tags to set.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry")
+	void SetTags(const TMap<FString, FString>& Tags);
+
 	/**
 	 * Removes global tag.
 	 *
@@ -268,6 +369,77 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void RemoveTag(const FString& Key);
 
+	/**
+	 * Sets a tag attached only to the events captured for the given world with `CaptureMessageForWorld` or
+	 * `CaptureEventForWorld`. Allows several matches hosted by the same process to be reported without their tags
+	 * overwriting each other in the global scope. The world scope is discarded once the world is cleaned up.
+	 *
+	 * @param WorldContextObject Object the world of which the tag is set for.
+	 * @param Key Tag key.
+	 * @param Value Tag value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	void SetWorldTag(const UObject* WorldContextObject, const FString& Key, const FString& Value);
+
+	/**
+	 * Removes a tag from the scope of the given world.
+	 *
+	 * @param WorldContextObject Object the world of which the tag is removed for.
+	 * @param Key Tag key.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	void RemoveWorldTag(const UObject* WorldContextObject, const FString& Key);
+
+	/**
+	 * Sets context values attached only to the events captured for the given world.
+	 *
+	 * @param WorldContextObject Object the world of which the context is set for.
+	 * @param Key Context key.
+	 * @param Values Context values.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	void SetWorldContext(const UObject* WorldContextObject, const FString& Key, const TMap<FString, FSentryVariant>& Values);
+
+	/**
+	 * Removes context from the scope of the given world.
+	 *
+	 * @param WorldContextObject Object the world of which the context is removed for.
+	 * @param Key Context key.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	void RemoveWorldContext(const UObject* WorldContextObject, const FString& Key);
+
+	/**
+	 * Discards all tags and contexts set for the given world, e.g. when a match ends but its world is reused.
+	 *
+	 * @param WorldContextObject Object the world of which the scope is discarded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	void ClearWorldScope(const UObject* WorldContextObject);
+
+	/**
+	 * Captures the message with the tags and contexts of the given world applied on top of the global scope.
+	 *
+	 * @param WorldContextObject Object the world of which the scope is applied.
+	 * @param Message The message to send.
+	 * @param Level The message level.
+	 *
+	 * @return Event ID (non-empty if successful)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	FString CaptureMessageForWorld(const UObject* WorldContextObject, const FString& Message, ESentryLevel Level = ESentryLevel::Info);
+
+	/**
+	 * Captures the event with the tags and contexts of the given world applied on top of the global scope.
+	 *
+	 * @param WorldContextObject Object the world of which the scope is applied.
+	 * @param Event The event to send to Sentry.
+	 *
+	 * @return Event ID (non-empty if successful)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (WorldContext = "WorldContextObject"))
+	FString CaptureEventForWorld(const UObject* WorldContextObject, USentryEvent* Event);
+
 	/**
 	 * Sets the level of all events sent.
 	 *
@@ -293,6 +465,73 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	void EndSession();
 
+	/**
+	 * Counts a finished session towards the release health aggregates sent periodically if session aggregation
+	 * is enabled in the plugin settings. Allows servers to report the sessions of their players at constant cost
+	 * instead of sending an update for every session.
+	 *
+	 * @param StartedAt UTC time the session started at.
+	 * @param Status Outcome of the session.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry")
+	void RecordAggregatedSession(const FDateTime& StartedAt, ESentrySessionStatus Status);
+
+	/**
+	 * Gets the key of a metric. Recording samples for a key obtained once up front is the cheapest way to report
+	 * metrics from hot code, e.g. frame times. Samples are only recorded if metrics are enabled in the plugin settings.
+	 *
+	 * @param Type Type of the metric.
+	 * @param Name Metric name, characters other than letters, digits, `_`, `-` and `.` are replaced.
+	 * @param Unit Unit of the samples, e.g. `millisecond` or `byte`.
+	 * @param Tags Tags the samples are grouped by.
+	 *
+	 * @return Invalid key if the name is empty or the max number of metrics is reached.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Metrics", meta = (AutoCreateRefTerm = "Tags"))
+	FSentryMetricKey RegisterMetric(ESentryMetricType Type, const FString& Name, const FString& Unit, const TMap<FString, FString>& Tags);
+
+	/**
+	 * Records a sample of a metric. Safe to call from any thread.
+	 *
+	 * @param Key Key of the metric returned by RegisterMetric.
+	 * @param Value Value added to a counter or sample of a gauge or distribution.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Metrics")
+	void RecordMetric(const FSentryMetricKey& Key, float Value);
+
+	/**
+	 * Increments a counter metric.
+	 *
+	 * @param Name Metric name.
+	 * @param Value Value added to the counter.
+	 * @param Unit Unit of the value.
+	 * @param Tags Tags the counter is grouped by.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Metrics", meta = (AutoCreateRefTerm = "Tags"))
+	void IncrementCounter(const FString& Name, float Value, const FString& Unit, const TMap<FString, FString>& Tags);
+
+	/**
+	 * Records a sample of a gauge metric, the last, min, max, sum and count of the samples are sent.
+	 *
+	 * @param Name Metric name.
+	 * @param Value Sampled value.
+	 * @param Unit Unit of the value.
+	 * @param Tags Tags the gauge is grouped by.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Metrics", meta = (AutoCreateRefTerm = "Tags"))
+	void SetGauge(const FString& Name, float Value, const FString& Unit, const TMap<FString, FString>& Tags);
+
+	/**
+	 * Records a sample of a distribution metric, e.g. a load time, all samples are sent.
+	 *
+	 * @param Name Metric name.
+	 * @param Value Sampled value.
+	 * @param Unit Unit of the value.
+	 * @param Tags Tags the distribution is grouped by.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Metrics", meta = (AutoCreateRefTerm = "Tags"))
+	void AddDistributionSample(const FString& Name, float Value, const FString& Unit, const TMap<FString, FString>& Tags);
+
 	/**
 	 * Gives user consent for uploading crash reports.
 	 *
@@ -369,6 +608,93 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry", meta = (AutoCreateRefTerm = "BaggageHeaders"))
 	USentryTransactionContext* ContinueTrace(const FString& SentryTrace, const TArray<FString>& BaggageHeaders);
 
+	/**
+	 * Instruments an outgoing HTTP request with an `http.client` span timing it and adds the `sentry-trace` and `baggage`
+	 * headers so that the backend can continue the trace. Does nothing unless HTTP tracing is enabled in plugin settings.
+	 *
+	 * @param Request Request to instrument. Must be called after its completion delegate is bound and before it's processed,
+	 *                binding the completion delegate afterwards drops the span.
+	 * @param Parent Transaction the span is started in. If null, the span goes to the current map performance transaction if there's one,
+	 *               otherwise a standalone `http.client` transaction is started for the request.
+	 */
+	void TraceHttpRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, USentryTransaction* Parent = nullptr);
+
+	/**
+	 * Instruments an outgoing HTTP request with an `http.client` span started as a child of the given span.
+	 *
+	 * @see TraceHttpRequest
+	 */
+	void TraceHttpRequestWithParentSpan(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, USentrySpan* Parent);
+
+	/**
+	 * Applies the tag and context changes accumulated while scope update coalescing is enabled in plugin settings.
+	 * Called automatically once per frame and before any event capture.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry")
+	void FlushScope();
+
+	/**
+	 * Gets the total amount of tags, extras, contexts and context values dropped because of the scope limits configured in plugin settings.
+	 * Scope limits are applied on Windows and Linux only.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry")
+	int64 GetScopeEvictionCount() const;
+
+	/**
+	 * Gets the sizes of the events and attachments captured so far, if payload size tracking or the event size limit is enabled in plugin settings.
+	 * Payload sizes are tracked on Windows and Linux only.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry")
+	FSentryPayloadStats GetPayloadStats() const;
+
+	/**
+	 * Gets the state of the envelope upload pipeline: queue depth, pending bytes, last send latency, failures and rate limiting.
+	 * Cheap enough to be polled every frame, e.g. to defer optional telemetry while uploads are backed up.
+	 * Transport stats are reported on Windows and Linux with the batched transport only.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry")
+	FSentryTransportStats GetTransportStats() const;
+
+	/**
+	 * Gets the memory held by the SDK broken down by component, also printed with the `Sentry.MemReport` console command.
+	 * Allocations of the native SDK are attributed to components on Windows and Linux in non-shipping builds only.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry")
+	FSentryMemoryStats GetMemoryStats() const;
+
+	/** Gets the time in milliseconds the last initialization spent inside the platform SDK, 0 if Sentry wasn't initialized. */
+	UFUNCTION(BlueprintPure, Category = "Sentry")
+	float GetInitializationDurationMs() const;
+
+	/**
+	 * Registers a native filter that runs before the before-send handler for every event, without creating any UObjects.
+	 * Filters persist across re-initialization and run in order of registration.
+	 *
+	 * @return Handle to pass to RemoveBeforeSendFilter.
+	 */
+	FDelegateHandle AddBeforeSendFilter(FSentryBeforeSendFilter Filter);
+
+	/** Unregisters a native before-send filter. */
+	void RemoveBeforeSendFilter(FDelegateHandle Handle);
+
+	/**
+	 * Runs an upload of a large standalone attachment once the upload bandwidth settings allow it, right away if they
+	 * don't limit anything. Must be called from the game thread. Uploads still pending when Sentry is closed are dropped.
+	 */
+	void ScheduleUpload(int64 Size, TFunction<void()> Upload);
+
+	/**
+	 * Uploads the rest of a crash video whose preview was uploaded in place of the full clip, as configured in plugin settings.
+	 * Meant to be called on launch for the crash events a remote config or the backend flags as needing the full clip.
+	 *
+	 * @param CrashEventId - Identifier of the crash event the video belongs to
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry")
+	void RequestFullCrashVideo(const FString& CrashEventId);
+
+	/** Gets the timings of the last initialization phases, complete once Sentry is enabled. */
+	const FSentryInitProfile& GetInitProfile() const;
+
 	/** Checks if Sentry event capturing is supported for current settings. */
 	UFUNCTION(BlueprintCallable, Category = "Sentry")
 	bool IsSupportedForCurrentSettings() const;
@@ -379,15 +705,69 @@ public:
 	/** Gets the before log handler instance. */
 	USentryBeforeLogHandler* GetBeforeLogHandler() const;
 
+	/**
+	 * Gets the engine subsystem without looking it up in the subsystem collection of the engine. Safe to call from any thread.
+	 * Null until the engine initializes the subsystem and after it's deinitialized.
+	 */
+	static USentrySubsystem* Get();
+
+	/** Checks whether Sentry is initialized without looking up the subsystem, cheap enough for per-log-line paths. */
+	static bool IsEnabledFast();
+
+	/**
+	 * Replays the scope changes and breadcrumbs still waiting in the queue on the crashing thread so that they end up in
+	 * the crash event, queued captures are dropped. Skipped if the queue is busy, in which case the calls are lost along with the process.
+	 */
+	static void FlushPlatformCallsOnCrash();
+
 private:
+	/** Creates the handler objects specified in plugin settings. */
+	void CreateHandlers();
+
+	/** Initializes the platform SDK on a background thread, captures made in the meantime are deferred until it completes. */
+	void InitializeAsync();
+
+	/** Initializes the platform SDK and adds the default contexts and tags, returns false if it failed. */
+	bool InitializeNativeImpl();
+
+	/** Hooks up breadcrumbs, output devices and other engine integrations once the platform SDK is initialized. */
+	void CompleteInitialization();
+
+	/** Check whether the asynchronous initialization is still in progress */
+	bool IsInitializingAsync() const;
+
+	/** Queue the scope change or capture if the asynchronous initialization is in progress, returns false if it should be made right away */
+	bool DeferUntilInitialized(TFunction<void()>&& Call);
+
+	/** Make the scope changes and captures queued during the asynchronous initialization, in order */
+	void ReplayDeferredCalls();
+
+	/** Check whether platform SDK calls made on the calling thread are queued */
+	bool CanEnqueuePlatformCall() const;
+
+	/**
+	 * Queue the platform SDK call if asynchronous platform calls are enabled, returns false if it should be made right away.
+	 * Captures are flagged so that the crash handler drops them instead of building events on the crashing thread.
+	 */
+	bool EnqueuePlatformCall(TFunction<void()>&& Call, bool bIsCapture = false);
+
+	/**
+	 * Queue the capture of the event created by the given function if asynchronous platform calls are enabled.
+	 * The event gets an ID generated right away so that it can be returned to the caller before the capture is made.
+	 */
+	bool EnqueueCapture(TFunction<TSharedPtr<ISentryEvent>()>&& CreateNativeEvent, FString& OutEventId);
+
+	/** Add the breadcrumb to the platform SDK */
+	void AddNativeBreadcrumb(TSharedPtr<ISentryBreadcrumb> NativeBreadcrumb);
+
 	/** Adds default context data for all events captured by Sentry SDK. */
 	void AddDefaultContext();
 
-	/** Adds GPU context data for all events captured by Sentry SDK. */
-	void AddGpuContext();
+	/** Adds GPU and device context data for all events captured by Sentry SDK, using values cached during the previous launch when possible. */
+	void AddHardwareContexts();
 
-	/** Adds GPU context data for all events captured by Sentry SDK. */
-	void AddDeviceContext();
+	/** Sets GPU and device contexts on the given native implementation. */
+	static void SetHardwareContexts(TSharedPtr<ISentrySubsystem> NativeImpl, const FSentryHardwareContexts& Contexts);
 
 	/** Promote specified values to tags for all events captured by Sentry SDK. */
 	void PromoteTags();
@@ -413,6 +793,129 @@ private:
 	/** Add custom Sentry output device to intercept errors */
 	void ConfigureErrorOutputDevice();
 
+	/** Start accumulating global scope changes and flushing them once per frame */
+	void ConfigureScopeBatch();
+
+	/** Get the key of the world the scope of which is used for the given object, null if it isn't in a world */
+	static FObjectKey GetWorldScopeKey(const UObject* WorldContextObject);
+
+	/** Start counting sessions recorded with RecordAggregatedSession and sending the aggregates periodically */
+	void ConfigureSessionAggregation();
+
+	/** Start aggregating metrics and sending them periodically */
+	void ConfigureMetrics();
+
+	/** Start deduplicating and rate limiting captured events and reporting the suppressed ones once a minute */
+	void ConfigureEventLimiter();
+
+	/** Check whether the event should be dropped by the event limiter, called before any scope is converted */
+	FORCENOINLINE bool IsCaptureSuppressed(const FString& Message, ESentryLevel Level);
+
+	/** Send a summary of the events suppressed by the event limiter if it's due */
+	void ReportSuppressedEvents();
+
+	/** Send a transaction with a span for every recorded initialization phase */
+	void SendInitProfileTransaction();
+
+	/** Start measuring the time to the first rendered frame and to the first map being interactive */
+	void ConfigureAppStartMeasurement();
+
+	/** Stop measuring the app start */
+	void DisableAppStartMeasurement();
+
+	/** Record the app start metrics and send the app start transaction once the first map is interactive */
+	void FinishAppStartMeasurement();
+
+	/** Start sampling frame performance and sending a transaction with the aggregated statistics for every map session */
+	void ConfigureMapPerformanceTransactions();
+
+	/** Stop sampling frame performance and send the transaction of the current map session */
+	void DisableMapPerformanceTransactions();
+
+	/** Start a transaction for the map session that has just begun */
+	void StartMapPerformanceTransaction(const FString& MapName);
+
+	/** Attach the aggregated statistics to the transaction of the current map session and finish it */
+	void FinishMapPerformanceTransaction();
+
+	/** Add a span with the game thread call stacks sampled during the frame that has just finished to the transaction of the current map session */
+	void AddHitchSpan(float DeltaSeconds);
+
+	/** Start counting PSO cache misses and keep the totals in the pso context */
+	void ConfigurePsoTracking();
+
+	/** Add a span for the frame that has just stalled on compiling PSOs missing from the cache to the transaction of the current map session */
+	void AddPsoStallSpan(int32 NumMisses, float StallMs);
+
+	/** Start recording garbage collection pauses */
+	void ConfigureGcTracking();
+
+	/** Stop recording garbage collection pauses */
+	void DisableGcTracking();
+
+	/** Add a span for the garbage collection pause that has just finished to the transaction of the current map session */
+	void AddGcSpan(float PauseMs, int32 NumObjects);
+
+	/** Start reporting slow synchronous file operations on the game thread if the platform file layer is registered */
+	void ConfigureSyncFileIoTracking();
+
+	/** Add a span with the file path and callsite of a slow synchronous file operation to the transaction of the current map session */
+	void AddSyncFileIoSpan(const FSentrySyncFileIo& Io);
+
+	/** Starts the `http.client` span of a request in the given parent, or a standalone transaction if there's none, and adds the tracing headers */
+	void StartHttpRequestSpan(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, TSharedPtr<ISentryTransaction> ParentTransaction, TSharedPtr<ISentrySpan> ParentSpan);
+
+	/** Start sending a transaction for every map load and level streaming burst */
+	void ConfigureLoadTransactions();
+
+	/** Stop tracking map loads */
+	void DisableLoadTransactions();
+
+	/** Start sending a transaction with the breakdown of one in every N frames */
+	void ConfigureFrameBreakdownTransactions();
+
+	/** Stop sampling frames */
+	void DisableFrameBreakdownTransactions();
+
+	/** Start the watchdog reporting game thread hangs on platforms without built-in hang tracking */
+	void ConfigureAppHangTracking();
+
+	/** Stop the game thread hang watchdog */
+	void DisableAppHangTracking();
+
+	/** Start sampling memory usage and report an out of memory termination of the previous session */
+	void ConfigureMemorySampling();
+
+	/** Send an Out of Memory event if the previous session was terminated without crashing while it was low on memory */
+	void ReportPreviousSessionOutOfMemory();
+
+	/** Start sampling the thermal state, battery and clocks of the device and keep them in the device conditions context */
+	void ConfigureDeviceConditionsSampling();
+
+	/** Upload crash videos persisted by the crash handler during previous sessions */
+	void UploadPendingCrashVideos();
+
+	/** Send the given files of a persisted crash video in as many events as the attachment size limit requires, called on a background thread */
+	static void SendPendingCrashVideo(TWeakObjectPtr<USentrySubsystem> WeakThis, const FSentryPendingCrashVideo& PendingVideo, const TArray<FString>& Files, int64 MaxBatchBytes, bool bIsPreview);
+
+	/** Send a clip of the recent gameplay for the given ensure event unless one was sent recently */
+	void CaptureEnsureVideo(const FString& EnsureEventId);
+
+	/** Sends the server replay segments recorded before the ensure as a separate event referencing it. */
+	void CaptureEnsureServerReplay(const FString& EnsureEventId);
+
+	/** Remember the location of the failed ensure described by the error history, false if it was reported before */
+	bool MarkEnsureReported(const TCHAR* ErrorHist);
+
+	/** Start pacing the uploads of large attachments according to the plugin settings */
+	void ConfigureUploadScheduler();
+
+	/** Check whether any world is connected to a server or has clients connected */
+	static bool IsNetworkedMatchInProgress();
+
+	/** Capture an ensure with the call stack captured on the ensuring thread, runs on the command queue if asynchronous platform calls are enabled */
+	void ReportEnsure(const FString& EnsureMessage, const TArray<uint64>& ProgramCounters);
+
 private:
 	TSharedPtr<ISentrySubsystem> SubsystemNativeImpl;
 
@@ -438,4 +941,132 @@ private:
 
 	FDelegateHandle OnAssertDelegate;
 	FDelegateHandle OnEnsureDelegate;
+
+	/** Pending global scope changes, null if scope update coalescing is disabled */
+	TSharedPtr<FSentryScopeBatch, ESPMode::ThreadSafe> ScopeBatch;
+
+	/** Queue running platform SDK calls on a worker thread, null if asynchronous platform calls are disabled */
+	TSharedPtr<FSentryCommandQueue, ESPMode::ThreadSafe> CommandQueue;
+
+	/** Guards the command queue pointer which is read from any thread while Close() resets it */
+	mutable FRWLock CommandQueueLock;
+
+	/** Independent scopes of the worlds running in this process */
+	TSharedPtr<FSentryWorldScopes, ESPMode::ThreadSafe> WorldScopes;
+	FDelegateHandle WorldCleanupDelegate;
+
+	/** Counted sessions waiting to be sent, null if session aggregation is disabled */
+	TSharedPtr<FSentrySessionAggregator, ESPMode::ThreadSafe> SessionAggregator;
+	TSharedPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> SessionAggregatorSender;
+
+	/** Destination of the aggregated metrics, null if metrics are disabled */
+	TSharedPtr<FSentryEnvelopeSender, ESPMode::ThreadSafe> MetricsSender;
+
+	/** Duplicate and rate limiting state of captured events, null if no limits are configured */
+	TSharedPtr<FSentryEventLimiter, ESPMode::ThreadSafe> EventLimiter;
+
+	/** Streamed attachments added to the global scope, their temporary files are deleted once released */
+	TArray<TSharedPtr<ISentryAttachment>> StreamedAttachments;
+
+	/** Pending uploads of large attachments, null if upload bandwidth isn't limited */
+	TSharedPtr<FSentryUploadScheduler> UploadScheduler;
+
+	/** Frame statistics of the current map session, null if map performance transactions are disabled */
+	TSharedPtr<FSentryMapPerformance, ESPMode::ThreadSafe> MapPerformance;
+
+	/** Transaction of the current map session, null until the first map is loaded */
+	TSharedPtr<ISentryTransaction> MapPerformanceTransaction;
+
+	/** Game thread call stack sampler, null if hitch spans are disabled */
+	TSharedPtr<FSentryHitchDetector, ESPMode::ThreadSafe> HitchDetector;
+
+	/** Number of hitch spans added to the transaction of the current map session */
+	int32 NumHitchSpans = 0;
+
+	/** Number of PSO compile stall spans added to the transaction of the current map session */
+	int32 NumPsoStallSpans = 0;
+
+	/** Number of garbage collection spans added to the transaction of the current map session */
+	int32 NumGcSpans = 0;
+
+	FDelegateHandle GcPreGarbageCollectDelegate;
+	FDelegateHandle GcPostGarbageCollectDelegate;
+	FDelegateHandle GcCompleteDelegate;
+
+	/** Time the current garbage collection started at, zero if none is in progress */
+	double GcStartTime = 0.0;
+
+	/** Number of objects when the current garbage collection started, negative once the purge completed */
+	int32 GcObjectsAtStart = INDEX_NONE;
+
+	float GcPauseSpanThresholdMs = 0.0f;
+
+	FSentryMetricKey GcPauseMetric;
+	FSentryMetricKey GcPurgedMetric;
+
+	/** Number of synchronous file operation spans added to the transaction of the current map session */
+	int32 NumSyncFileIoSpans = 0;
+
+	FSentryMetricKey SyncFileOpenMetric;
+	FSentryMetricKey SyncFileReadMetric;
+
+	FDelegateHandle MapPerformancePreLoadMapDelegate;
+	FDelegateHandle MapPerformancePostLoadMapDelegate;
+
+	/** Phases of the current map load, null if map load transactions are disabled */
+	TSharedPtr<FSentryLoadTracker> LoadTracker;
+
+	FDelegateHandle LoadTrackerPreLoadMapDelegate;
+	FDelegateHandle LoadTrackerPostLoadMapDelegate;
+
+	/** Sampler of per-frame breakdowns, null if frame breakdown transactions are disabled */
+	TSharedPtr<FSentryFrameBreakdown> FrameBreakdown;
+
+	/** Game thread hang watchdog, null unless ANR tracking is enabled on Windows/Linux */
+	TSharedPtr<FSentryHangWatchdog, ESPMode::ThreadSafe> HangWatchdog;
+
+	FDelegateHandle AppHangPreLoadMapDelegate;
+	FDelegateHandle AppHangPostLoadMapDelegate;
+
+	/** Milestones of the app start, null once the measurement is complete or if it's disabled */
+	TSharedPtr<FSentryAppStart> AppStart;
+
+	FDelegateHandle AppStartPreLoadMapDelegate;
+	FDelegateHandle AppStartPostLoadMapDelegate;
+	FDelegateHandle AppStartEndFrameDelegate;
+
+	/** Time when the last ensure video was sent, used to keep ensure storms from spawning an encode each */
+	double LastEnsureVideoTime = 0.0;
+
+	/** Time when the last ensure server replay was copied, same as LastEnsureVideoTime for the replay segments */
+	double LastEnsureServerReplayTime = 0.0;
+
+	FCriticalSection ReportedEnsuresCriticalSection;
+
+	/** Hashes of the locations of ensures reported during the session */
+	TSet<uint32> ReportedEnsureLocations;
+
+	FCriticalSection PendingEnsureReportsCriticalSection;
+
+	/** Ensures being reported on the thread pool, Close() waits for them so that they aren't lost at exit */
+	TArray<TFuture<void>> PendingEnsureReports;
+
+	/** Time spent in the platform SDK initialization, used to track startup cost */
+	float InitializationDurationMs = 0.0f;
+
+	/** Timings of the last initialization phases */
+	FSentryInitProfile InitProfile;
+
+	/** Background platform SDK initialization, valid until it completes on the game thread */
+	TFuture<void> AsyncInitTask;
+
+	/** Incremented on every asynchronous initialization so a stale completion can be told apart */
+	int32 AsyncInitSerial = 0;
+
+	FCriticalSection DeferredCallsCriticalSection;
+
+	/** Scope changes and captures made while the asynchronous initialization is in progress */
+	TArray<TFunction<void()>> DeferredCalls;
+
+	TAtomic<bool> bIsInitializingAsync { false };
 };
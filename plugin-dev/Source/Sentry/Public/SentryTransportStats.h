@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryTransportStats.generated.h"
+
+/**
+ * State of the envelope upload pipeline, reported by the batched transport if it's enabled in plugin settings.
+ * Reading it takes a handful of atomic loads, so it can be polled every frame.
+ */
+USTRUCT(BlueprintType)
+struct SENTRY_API FSentryTransportStats
+{
+	GENERATED_BODY()
+
+	/** Whether the stats are reported, false if the batched transport isn't used. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	bool bIsTracked = false;
+
+	/** Envelopes handed over to the transport and not sent yet, spooled ones excluded. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int32 NumQueuedEnvelopes = 0;
+
+	/** Bytes of the queued envelopes. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 QueuedBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int32 NumRequestsInFlight = 0;
+
+	/** Envelopes persisted by the offline spool, including the ones left by previous sessions. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int32 NumSpooledEnvelopes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 SpooledBytes = 0;
+
+	/** Time from sending the last completed request until its response, 0 if none has completed yet. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	float LastSendLatencyMs = 0.0f;
+
+	/** Requests accepted by the server, each carrying one envelope or a batch of them. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 NumSentRequests = 0;
+
+	/** Requests that failed due to network errors or were rejected by the server, including rate limited ones. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 NumFailedRequests = 0;
+
+	/** Envelopes dropped because the server asked to back off. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	int64 NumRateLimitedEnvelopes = 0;
+
+	/** Whether envelopes are currently dropped because the server asked to back off. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	bool bIsRateLimited = false;
+
+	/** Time until the server's back off request expires. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	float RateLimitRemainingSeconds = 0.0f;
+
+	/** Whether the server is considered unreachable after a failed request and envelopes are spooled instead of sent. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	bool bIsOffline = false;
+
+	/** Rate low-priority payloads are kept at by adaptive sampling, 1 if it's disabled or the backlog is small. */
+	UPROPERTY(BlueprintReadOnly, Category = "Sentry")
+	float AdaptiveSampleRate = 1.0f;
+};
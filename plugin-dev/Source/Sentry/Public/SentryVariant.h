@@ -4,7 +4,6 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
-#include "Misc/Variant.h"
 
 #include "SentryVariant.generated.h"
 
@@ -22,20 +21,11 @@ enum class ESentryVariantType : uint8
 	Map
 };
 
-template<>
-struct TVariantTraits<TArray<FSentryVariant>>
-{
-	static constexpr EVariantTypes GetType() { return EVariantTypes::Custom; }
-};
-
-template<>
-struct TVariantTraits<TMap<FString, FSentryVariant>>
-{
-	static constexpr EVariantTypes GetType() { return EVariantTypes::Custom; }
-};
-
 /**
  * Blueprint-exposed struct that can represent multiple types.
+ *
+ * Scalars are stored inline. Nested arrays and maps are immutable once wrapped and shared between copies of the variant,
+ * so passing context values around or converting them to native SDK types never deep copies or deserializes them.
  */
 USTRUCT(BlueprintType)
 struct SENTRY_API FSentryVariant
@@ -47,16 +37,33 @@ struct SENTRY_API FSentryVariant
 	FSentryVariant(float InValue);
 	FSentryVariant(bool InValue);
 	FSentryVariant(const FString& InValue);
+	FSentryVariant(FString&& InValue);
 	FSentryVariant(const TCHAR* InValue);
 	FSentryVariant(const TArray<FSentryVariant>& InValue);
+	FSentryVariant(TArray<FSentryVariant>&& InValue);
 	FSentryVariant(const TMap<FString, FSentryVariant>& InValue);
+	FSentryVariant(TMap<FString, FSentryVariant>&& InValue);
 
 	template<typename T>
 	T GetValue() const
 	{
-		return Value.GetValue<T>();
+		T Result;
+		ReadValue(Result);
+		return Result;
+	}
+
+	/** Gets the string value without copying it, empty if the variant doesn't contain a string. */
+	const FString& GetStringRef() const
+	{
+		return StringValue;
 	}
 
+	/** Gets the array value without copying it, empty if the variant doesn't contain an array. */
+	const TArray<FSentryVariant>& GetArrayRef() const;
+
+	/** Gets the map value without copying it, empty if the variant doesn't contain a map. */
+	const TMap<FString, FSentryVariant>& GetMapRef() const;
+
 	operator int32() const
 	{
 		return GetValue<int32>();
@@ -92,24 +99,39 @@ struct SENTRY_API FSentryVariant
 		return Type;
 	}
 
-	bool operator==(const FSentryVariant& Other) const
-	{
-		return ((Type == Other.Type) && (Value == Other.Value));
-	}
+	bool operator==(const FSentryVariant& Other) const;
 
 	bool operator!=(const FSentryVariant& Other) const
 	{
-		return ((Type != Other.Type) || (Value != Other.Value));
+		return !(*this == Other);
 	}
 
 	friend FArchive& operator<<(FArchive& Ar, FSentryVariant& Variant)
 	{
-		return Ar << Variant.Type << Variant.Value;
+		Variant.Serialize(Ar);
+		return Ar;
 	}
 
 private:
+	void ReadValue(int32& OutValue) const { OutValue = IntValue; }
+	void ReadValue(float& OutValue) const { OutValue = FloatValue; }
+	void ReadValue(bool& OutValue) const { OutValue = bBoolValue; }
+	void ReadValue(FString& OutValue) const { OutValue = StringValue; }
+	void ReadValue(TArray<FSentryVariant>& OutValue) const { OutValue = GetArrayRef(); }
+	void ReadValue(TMap<FString, FSentryVariant>& OutValue) const { OutValue = GetMapRef(); }
+
+	void Serialize(FArchive& Ar);
+
 	ESentryVariantType Type;
-	FVariant Value;
+
+	int32 IntValue;
+	float FloatValue;
+	bool bBoolValue;
+
+	FString StringValue;
+
+	TSharedPtr<const TArray<FSentryVariant>, ESPMode::ThreadSafe> ArrayValue;
+	TSharedPtr<const TMap<FString, FSentryVariant>, ESPMode::ThreadSafe> MapValue;
 };
 
 UCLASS()
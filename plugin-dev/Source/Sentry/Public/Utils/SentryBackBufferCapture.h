@@ -0,0 +1,106 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RHI.h"
+#include "Templates/Atomic.h"
+
+class FRHIGPUTextureReadback;
+class FViewport;
+class SWindow;
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+typedef FTexture2DRHIRef FSentryTextureRHIRef;
+#else
+typedef FTextureRHIRef FSentryTextureRHIRef;
+#endif
+
+/** Called with the pixels of a captured frame, the bitmap is empty if the frame couldn't be captured. */
+typedef TFunction<void(bool bCaptured, const TArray<FColor>& Bitmap, const FIntPoint& Size)> FSentryOnFrameCaptured;
+
+/**
+ * Captures the frames presented in the game window without re-rendering anything.
+ *
+ * Copies the backbuffer right before it's presented into a GPU readback which is polled on later frames,
+ * so neither the render nor the game thread ever wait for the GPU. The latest frame is refreshed periodically
+ * and kept in CPU memory, so that crash handlers can encode it without touching Slate, the renderer or the GPU.
+ */
+class FSentryBackBufferCapture
+{
+public:
+	static FSentryBackBufferCapture& Get();
+
+	/**
+	 * Starts capturing frames of the game window. Called on the game thread.
+	 *
+	 * @param bInIncludeUI Whether to capture the backbuffer with the UI drawn on top. Otherwise the scene render target
+	 * of the game viewport is captured if it has a separate one, the backbuffer is used if it doesn't.
+	 * @param InRefreshIntervalSeconds Interval between refreshes of the latest frame.
+	 */
+	bool Start(bool bInIncludeUI, float InRefreshIntervalSeconds);
+
+	/** Stops capturing frames and discards the latest one. */
+	void Stop();
+
+	/** Checks whether frame capturing is active. */
+	bool IsActive() const { return bIsActive; }
+
+	/** Sets the game viewport to capture, called on the game thread whenever it's created or resized. */
+	void SetViewport(FViewport* Viewport, const TSharedPtr<SWindow>& Window);
+
+	/**
+	 * Requests the next presented frame. Called on the game thread.
+	 *
+	 * @param OnCaptured Called on the render thread once the frame was read back, or on the game thread if capturing stops first.
+	 */
+	void RequestFrame(FSentryOnFrameCaptured OnCaptured);
+
+	/**
+	 * Copies the latest frame into the bitmap. Doesn't wait for the lock so that it can be used from the crash handler;
+	 * the bitmap isn't reallocated if it reserved enough space already.
+	 *
+	 * @return False if no frame was captured yet or it's being updated.
+	 */
+	bool CopyLatestFrame(TArray<FColor>& OutBitmap, FIntPoint& OutSize) const;
+
+private:
+	void OnBackBufferReadyToPresent(SWindow& Window, const FSentryTextureRHIRef& BackBuffer);
+
+	/** Converts the read back pixels and hands them over to the latest frame and the pending requests. Called on the render thread. */
+	void ResolveReadback();
+
+	FThreadSafeBool bIsActive;
+
+	/** Flag indicating whether a frame was requested since the last readback was enqueued. */
+	FThreadSafeBool bIsFrameRequested;
+
+	FDelegateHandle OnBackBufferReadyHandle;
+
+	bool bIncludeUI = true;
+	float RefreshIntervalSeconds = 1.0f;
+
+	/** Window to capture, only compared against the presented window on the render thread. */
+	TAtomic<const SWindow*> CapturedWindow;
+
+	FCriticalSection RequestsCriticalSection;
+	TArray<FSentryOnFrameCaptured> PendingRequests;
+
+	// Render thread state
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+	FSentryTextureRHIRef SceneRenderTarget;
+	FSentryTextureRHIRef PrivacyMaskTarget;
+	FIntPoint ReadbackSize = FIntPoint::ZeroValue;
+	EPixelFormat ReadbackFormat = PF_Unknown;
+	TArray<FSentryOnFrameCaptured> InFlightRequests;
+	TArray<FColor> ResolveBuffer;
+	double LastCaptureTime = 0.0;
+	bool bHasLoggedMissingSceneRenderTarget = false;
+
+	mutable FCriticalSection LatestFrameCriticalSection;
+	TArray<FColor> LatestFrame;
+	FIntPoint LatestFrameSize = FIntPoint::ZeroValue;
+};
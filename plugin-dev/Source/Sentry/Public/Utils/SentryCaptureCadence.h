@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Picks the presented frames to capture on a fixed cadence, independent of the render frame rate.
+ *
+ * Capture times are kept on a fixed grid rather than measured from the last captured frame, so captured frames are
+ * evenly spaced on average at any frame rate instead of drifting to the next multiple of the frame time. Frames that
+ * aren't selected cost a single comparison, and selected frames that can't be captured because the previous one is
+ * still in flight are dropped and counted rather than queued.
+ */
+class SENTRY_API FSentryCaptureCadence
+{
+public:
+	/** Restarts the cadence with the given capture rate. */
+	void Reset(float FramesPerSecond);
+
+	/** Checks whether the frame presented at the given time (FPlatformTime::Seconds) is selected for capture. */
+	bool ShouldCapture(double PresentTime);
+
+	/** Records that a selected frame was dropped because the capture pipeline was busy. */
+	void OnDropped() { ++NumDropped; }
+
+	/** Gets the number of selected frames that were dropped since the last reset. Safe to call from any thread. */
+	int64 GetNumDropped() const { return NumDropped; }
+
+private:
+	double Interval = 1.0 / 30.0;
+	double NextCaptureTime = 0.0;
+
+	TAtomic<int64> NumDropped { 0 };
+};
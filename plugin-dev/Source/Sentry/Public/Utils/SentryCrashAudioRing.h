@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+
+class FSentryCrashAudioListener;
+
+/**
+ * Low-cost audio context for crash reports.
+ *
+ * Keeps the last N seconds of the main submix output as downmixed 16 kHz mono PCM in memory, independently of the
+ * video encoder. Nothing is encoded while the game runs - at crash time the ring is only written out as a WAV file
+ * that is attached next to the crash video.
+ */
+class SENTRY_API FSentryCrashAudioRing
+{
+public:
+	/** Sample rate of the stored audio. */
+	static constexpr int32 SampleRate = 16000;
+
+	static FSentryCrashAudioRing& Get();
+
+	/**
+	 * Starts capturing the main submix output of the main audio device. Audio captured so far is kept if the ring
+	 * already covers the same time span on the same device, e.g. when the video recorder restarts.
+	 */
+	bool Start(float Seconds);
+
+	/** Stops capturing and discards the captured audio. */
+	void Stop();
+
+	/** Checks whether audio capturing is active. */
+	bool IsActive() const { return Listener.IsValid(); }
+
+	/**
+	 * Writes the captured audio to disk as a 16-bit mono WAV file, oldest sample first.
+	 * Safe to call from the crash handler: gives up instead of waiting if the audio thread is writing to the ring.
+	 *
+	 * @return True if the file was written.
+	 */
+	bool WriteWaveFile(const FString& Path) const;
+
+private:
+	TSharedPtr<FSentryCrashAudioListener, ESPMode::ThreadSafe> Listener;
+
+	/** Last stopped listener that might still be referenced by the audio device. */
+	TSharedPtr<FSentryCrashAudioListener, ESPMode::ThreadSafe> RetiredListener;
+
+	/** ID of the audio device the listener is registered with. */
+	uint32 AudioDeviceId = 0;
+
+	/** Number of samples the ring of the listener holds. */
+	int32 Capacity = 0;
+};
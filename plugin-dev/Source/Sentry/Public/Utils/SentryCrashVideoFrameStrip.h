@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RHI.h"
+#include "SentryCaptureCadence.h"
+
+class FRHIGPUTextureReadback;
+class SWindow;
+
+/** Settings of the frame strip recording. */
+struct FSentryFrameStripConfig
+{
+	int32 FrameWidth = 320;
+	int32 FrameHeight = 180;
+	float FramesPerSecond = 2.0f;
+	int32 MaxFrames = 20;
+};
+
+/**
+ * Lightweight alternative to crash video recording.
+ *
+ * Keeps a ring of heavily downscaled frames of the game window read back from the GPU asynchronously
+ * and maintains a JPEG sprite sheet of them on a background thread. At crash time the already encoded
+ * sprite sheet only has to be written to disk.
+ */
+class SENTRY_API FSentryCrashVideoFrameStrip
+{
+public:
+	static FSentryCrashVideoFrameStrip& Get();
+
+	/** Starts capturing frames of the game viewport window. */
+	bool Start(const FSentryFrameStripConfig& InConfig);
+
+	/** Stops capturing frames and discards the captured ones. */
+	void Stop();
+
+	/** Checks whether frame capturing is active. */
+	bool IsActive() const { return bIsActive; }
+
+	/**
+	 * Writes the latest sprite sheet to disk. Frames are laid out from left to right and top to bottom, oldest first.
+	 *
+	 * @return True if the sprite sheet was written.
+	 */
+	bool WriteSpriteSheet(const FString& Path) const;
+
+private:
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer);
+#else
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer);
+#endif
+
+	/** Downscales the read back frame into the ring. Called on the render thread. */
+	void ResolveReadback();
+
+	/** Encodes the frames currently in the ring as a sprite sheet on a background thread. */
+	void EncodeSpriteSheet();
+
+	FSentryFrameStripConfig Config;
+
+	FThreadSafeBool bIsActive;
+	FThreadSafeBool bIsEncoding;
+
+	FDelegateHandle OnBackBufferReadyHandle;
+
+	/** Window to capture, only compared against the presented window on the render thread. */
+	const SWindow* CapturedWindow = nullptr;
+
+	// Render thread state
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	FTexture2DRHIRef PrivacyMaskTarget;
+#else
+	FTextureRHIRef PrivacyMaskTarget;
+#endif
+	FIntPoint ReadbackSize = FIntPoint::ZeroValue;
+	EPixelFormat ReadbackFormat = PF_Unknown;
+	FSentryCaptureCadence CaptureCadence;
+
+	/** Flag indicating whether a copy was enqueued into the readback and hasn't been resolved yet. */
+	bool bIsReadbackInFlight = false;
+
+	mutable FCriticalSection FramesCriticalSection;
+
+	/** Downscaled BGRA frames ordered from the oldest to the newest. */
+	TArray<TArray<FColor>> Frames;
+
+	/** JPEG encoded sprite sheet of the frames. */
+	TArray<uint8> SpriteSheet;
+};
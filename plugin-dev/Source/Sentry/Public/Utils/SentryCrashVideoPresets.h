@@ -0,0 +1,29 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FCrashVideoPreset;
+
+namespace SentryCrashVideoPresets
+{
+	/** Presets used until the project configures its own: cheap tiers for low-end and mobile devices, a detailed one for PCs and consoles. */
+	TArray<FCrashVideoPreset> GetDefaultPresets();
+
+	/**
+	 * Finds the first preset matching the device and the scalability level.
+	 *
+	 * @param DeviceProfiles Active device profile followed by the profiles it's based on.
+	 * @param ScalabilityLevel Lowest level of all scalability groups.
+	 *
+	 * @return Index of the matching preset, INDEX_NONE if there's none.
+	 */
+	SENTRY_API int32 FindPreset(const TArray<FCrashVideoPreset>& Presets, const TArray<FString>& DeviceProfiles, int32 ScalabilityLevel);
+
+	/** Gets the active device profile followed by the profiles it's based on. */
+	SENTRY_API TArray<FString> GetActiveDeviceProfiles();
+
+	/** Gets the lowest level of all scalability groups. */
+	SENTRY_API int32 GetScalabilityLevel();
+}
@@ -0,0 +1,257 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RHI.h"
+#include "SentryCaptureCadence.h"
+
+class FRHIGPUTextureReadback;
+class FSentryMappedFile;
+class SWindow;
+
+/** Settings of the raw frame ring recording. */
+struct FSentryRawFrameRingConfig
+{
+	int32 FrameWidth = 640;
+	int32 FrameHeight = 360;
+	float FramesPerSecond = 10.0f;
+	int32 MaxFrames = 300;
+
+	/** Size of the frames of the long tier, downscaled from the captured frames so it's expected to be smaller. */
+	int32 LongTierFrameWidth = 320;
+	int32 LongTierFrameHeight = 180;
+	float LongTierFramesPerSecond = 2.0f;
+
+	/** Number of frames kept by the long tier, zero to record the single ring only. */
+	int32 LongTierMaxFrames = 0;
+};
+
+/**
+ * Low CPU alternative to continuous crash video encoding.
+ *
+ * Frames of the game window are read back from the GPU asynchronously and downscaled on the render thread, then
+ * converted to YUV 4:2:0 and compressed with LZ4 on a background thread into the next slot of a preallocated,
+ * memory-mapped ring file. Nothing is encoded while playing: the ring is turned into a video only when a clip
+ * is requested, or on the next launch if the game crashed, in which case the crash handler only writes the
+ * event ID into the mapped file header and the OS flushes the pages on its own.
+ *
+ * Ring file layout (little-endian):
+ *   header - "SRFR", uint32 version, uint32 width, uint32 height, float FPS, uint32 number of slots, uint32 slot size,
+ *            uint32 padding, uint64 number of frames written, char[40] crash event ID (zeroed unless the game crashed)
+ *   slots  - uint64 frame index, int64 UTC timestamp (microseconds), uint32 compressed size, uint32 layout of the window tiles,
+ *            LZ4 compressed I420 pixels
+ *
+ * Optionally a second, long tier ring file with the same layout keeps smaller frames at a lower rate for much longer.
+ * Its frames are downscaled on the background thread from the frames of the regular ring, so capturing both costs a single
+ * readback, and the crash gets crisp recent footage along with minutes of context for a fraction of the disk space.
+ *
+ * Several windows, e.g. the clients of a multiplayer PIE session, can be captured at once into tiles of the same frame.
+ * Windows are read back in turns, one per capture, so the ring and the number of readbacks stay the same as with a single
+ * window while each window is captured at a lower resolution and rate. A clip of a single window is cropped from its
+ * tile when encoding.
+ */
+class SENTRY_API FSentryCrashVideoRawRing
+{
+public:
+	static FSentryCrashVideoRawRing& Get();
+
+	~FSentryCrashVideoRawRing();
+
+	/**
+	 * Starts capturing frames of the game viewport window into the ring file. Called on the game thread.
+	 * A ring left behind by a crashed session is claimed first so that it's not overwritten before being encoded.
+	 */
+	bool Start(const FString& InPath, const FSentryRawFrameRingConfig& InConfig);
+
+	/** Stops capturing frames, the ring file is kept and overwritten by the next recording. */
+	void Stop();
+
+	/**
+	 * Captures the given windows into tiles of the frame, in order, instead of the game viewport window only.
+	 * Every change of the windows starts a new layout, whose tiles are black until their windows are captured.
+	 * Called on the game thread.
+	 */
+	void SetCapturedWindows(const TArray<const SWindow*>& Windows);
+
+	/** Gets the number of windows captured into tiles of the frame. */
+	int32 GetNumCapturedWindows() const { return NumCapturedWindows; }
+
+	/** Gets the frame area the window with the given index is captured into with the current layout, empty if there is no such window. */
+	FIntRect GetCapturedWindowRect(int32 WindowIndex) const;
+
+	/** Gets the identifier of the current layout of the captured windows, recorded with every frame. */
+	uint32 GetCapturedWindowsLayout() const { return CapturedWindowsLayout; }
+
+	/**
+	 * Gets the tile of a frame the given item of a grid layout occupies. Tiles have even dimensions and fill the frame
+	 * row by row, with as many columns as the square root of the number of tiles rounded up.
+	 *
+	 * @return Area of the tile, empty if the index is out of range.
+	 */
+	static FIntRect GetTileRect(int32 TileIndex, int32 NumTiles, int32 FrameWidth, int32 FrameHeight);
+
+	/**
+	 * Gets the area of a tile an image is scaled into, keeping the image aspect ratio and centering it between black bars.
+	 * The area has even dimensions and offsets like the tile itself.
+	 */
+	static FIntRect GetLetterboxRect(const FIntRect& TileRect, const FIntPoint& ImageSize);
+
+	/** Checks whether frame capturing is active. */
+	bool IsActive() const { return bIsActive; }
+
+	/**
+	 * Records the crash event in the ring file header so that the ring is encoded and uploaded on the next launch.
+	 * Only touches mapped memory, safe to call from the crash handler.
+	 */
+	bool MarkCrashed(const FString& EventId);
+
+	/**
+	 * Encodes the frames currently in the ring into a video. Touches the disk and takes a while, so it's expected to be called
+	 * from a background thread; frames keep being captured in the meantime.
+	 *
+	 * @param CropRect Area of the frames to encode, e.g. the tile of a single window, empty to encode the whole frames.
+	 * @param CropLayout Layout of the captured windows the crop area belongs to, frames recorded with other layouts are left out.
+	 */
+	bool EncodeVideo(const FString& VideoPath, const FIntRect& CropRect = FIntRect(), uint32 CropLayout = 0) const;
+
+	/** Encodes the frames currently in the long tier ring into a video, fails if the long tier isn't recorded. */
+	bool EncodeLongTierVideo(const FString& VideoPath) const;
+
+	/** Gets the path of the ring file recorded into by default. */
+	static FString GetDefaultPath();
+
+	/** Gets the path of the long tier ring file recorded next to the given ring. */
+	static FString GetLongTierPath(const FString& RingPath);
+
+	/** Checks whether the ring file, or the ring claimed from it, is a long tier ring. */
+	static bool IsLongTierRing(const FString& RingPath);
+
+	/**
+	 * Renames the ring file left behind by a crashed session so that the next recording starts with a new one.
+	 *
+	 * @return True if the ring belongs to a crashed session and was claimed.
+	 */
+	static bool ClaimCrashedRing(const FString& RingPath);
+
+	/** Finds the rings claimed from crashed sessions in the given directory, along with the IDs of the crash events. */
+	static TMap<FString, FString> FindClaimedRings(const FString& Directory);
+
+	/** Encodes the frames of a claimed ring file into a video, reading them through a mapping of the file. Expected to be called from a background thread. */
+	static bool EncodeRingFile(const FString& RingPath, const FString& VideoPath);
+
+	/**
+	 * Encodes the ring as a Motion JPEG AVI, frames are taken from the oldest to the newest.
+	 *
+	 * @param RingData Mapped or loaded ring file.
+	 * @param Lock Held while copying frames out of a ring that is being recorded into, null for ring files loaded from disk.
+	 * @param CropRect Area of the frames to encode, e.g. the tile of a single window, empty to encode the whole frames.
+	 * @param CropLayout Layout of the captured windows the crop area belongs to, frames recorded with other layouts are left out.
+	 */
+	static bool EncodeRing(const uint8* RingData, int64 RingSize, const FString& VideoPath, FCriticalSection* Lock, const FIntRect& CropRect = FIntRect(), uint32 CropLayout = 0);
+
+	/** Converts BGRA pixels to I420 (BT.601, limited range). Width and height are expected to be even. */
+	static void ConvertToI420(const FColor* Pixels, int32 Width, int32 Height, uint8* OutI420);
+
+	/** Converts I420 pixels back to BGRA. */
+	static void ConvertFromI420(const uint8* I420, int32 Width, int32 Height, FColor* OutPixels);
+
+	/** Downscales BGRA pixels averaging the source pixels covered by every target pixel. */
+	static void Downscale(const FColor* Pixels, int32 Width, int32 Height, FColor* OutPixels, int32 OutWidth, int32 OutHeight);
+
+private:
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer);
+#else
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer);
+#endif
+
+	/** Captured window along with the state of its readback, only used by the render thread. */
+	struct FCapturedTile
+	{
+		const SWindow* Window = nullptr;
+		FIntRect Rect;
+
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		FTexture2DRHIRef PrivacyMaskTarget;
+#else
+		FTextureRHIRef PrivacyMaskTarget;
+#endif
+		FIntPoint ReadbackSize = FIntPoint::ZeroValue;
+		EPixelFormat ReadbackFormat = PF_Unknown;
+
+		/** Area of the tile the window image is letterboxed into. */
+		FIntRect ImageRect;
+
+		/** Time the window was last presented at, windows that stopped presenting lose their turn to be captured. */
+		double LastPresentTime = 0.0;
+
+		/** Flag indicating whether a copy was enqueued into the readback and hasn't been resolved yet. */
+		bool bIsReadbackInFlight = false;
+	};
+
+	/** Replaces the captured tiles with ones for the given windows. Called on the render thread. */
+	void SetTiles(const TArray<const SWindow*>& Windows, uint32 Layout);
+
+	/** Downscales the read back frame into its tile and hands the frame over to a background thread. Called on the render thread. */
+	void ResolveReadback(FCapturedTile& Tile);
+
+	/** Converts and compresses the downscaled frame into the next ring slot, and into the long tier if it's due. Called on a background thread. */
+	void WriteFrame(const TArray<FColor>& Frame, uint32 Layout);
+
+	/** Downscales the frame into the next slot of the long tier ring. Called on the writing thread. */
+	void WriteLongTierFrame(const TArray<FColor>& Frame);
+
+	FSentryRawFrameRingConfig Config;
+
+	FString Path;
+
+	FThreadSafeBool bIsActive;
+	FThreadSafeBool bIsWriting;
+
+	FDelegateHandle OnBackBufferReadyHandle;
+
+	/** Number of windows captured into tiles, set on the game thread. */
+	int32 NumCapturedWindows = 0;
+
+	/** Layout of the captured windows, changed on the game thread along with them. */
+	uint32 CapturedWindowsLayout = 0;
+
+	// Render thread state
+	TArray<FCapturedTile> Tiles;
+
+	/** Layout the tiles were set up with. */
+	uint32 TilesLayout = 0;
+
+	/** Shared by all tiles, which take turns so that capturing several windows costs as many readbacks as a single one. */
+	FSentryCaptureCadence CaptureCadence;
+
+	/** Index of the tile whose window is captured next. */
+	int32 NextTileIndex = 0;
+
+	/** Frame the tiles are downscaled into, kept between frames so that every tile shows the last image of its window. */
+	TArray<FColor> TiledFrame;
+
+	/** Guards the mapped ring against being written while a clip is encoded from it. */
+	mutable FCriticalSection RingCriticalSection;
+
+	/** Shared so that a clip being encoded keeps the mapping alive if recording stops in the meantime. */
+	TSharedPtr<FSentryMappedFile, ESPMode::ThreadSafe> MappedFile;
+
+	/** Long tier ring, null unless it's recorded. Guarded by the same lock as the regular ring. */
+	TSharedPtr<FSentryMappedFile, ESPMode::ThreadSafe> LongTierMappedFile;
+
+	/** Time the next long tier frame is due at, only used by the writing thread. */
+	double NextLongTierFrameTime = 0.0;
+
+	/** Scratch buffer of the I420 pixels of the frame being written, only used by the writing thread. */
+	TArray<uint8> I420Buffer;
+
+	/** Scratch buffers of the long tier frame being written, only used by the writing thread. */
+	TArray<FColor> LongTierFrame;
+	TArray<uint8> LongTierI420Buffer;
+};
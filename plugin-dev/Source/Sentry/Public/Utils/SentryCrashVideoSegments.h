@@ -0,0 +1,158 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Ring of already encoded crash video segments kept on disk.
+ *
+ * When segmented recording is enabled, the crash video handler records the gameplay as a sequence of short
+ * MP4 files and registers every finalized one here. At crash time there is nothing left to encode -
+ * the crash handler only writes a small concat index and attaches the segments that are already on disk.
+ *
+ * Bookmarks mark moments worth keeping: segments overlapping the window around a bookmark are pinned
+ * instead of being evicted, within a disk budget, until the bookmark is sent or removed.
+ */
+class SENTRY_API FSentryCrashVideoSegments
+{
+public:
+	static FSentryCrashVideoSegments& Get();
+
+	/** Resets the ring and sets how many segments should be kept. */
+	void Configure(int32 InMaxSegments);
+
+	/**
+	 * Sets the time span kept around bookmarks and how much disk space segments pinned by bookmarks may take.
+	 *
+	 * @param InWindowSeconds - Seconds kept before and after every bookmark
+	 * @param InMaxPinnedBytes - Max total size of pinned segments, the oldest ones are released first (0 to disable pinning)
+	 */
+	void ConfigureBookmarks(float InWindowSeconds, int64 InMaxPinnedBytes);
+
+	/**
+	 * Changes how many segments should be kept without dropping the ones that still fit.
+	 *
+	 * @return Paths of segments evicted from the ring that can be deleted from disk.
+	 */
+	TArray<FString> SetMaxSegments(int32 InMaxSegments);
+
+	/**
+	 * Registers a finalized segment.
+	 *
+	 * @return Paths of segments evicted from the ring that can be deleted from disk.
+	 */
+	TArray<FString> AddSegment(const FString& SegmentPath);
+
+	/** Gets finalized segments ordered from the oldest to the newest. */
+	TArray<FString> GetSegments() const;
+
+	/** Checks whether the ring contains any finalized segments. */
+	bool HasSegments() const;
+
+	/** Removes all segments and bookmarks from the ring without touching the files on disk. */
+	void Reset();
+
+	/**
+	 * Marks a moment whose segments should be kept, replacing a bookmark with the same name.
+	 *
+	 * @param Time - Time of the moment in FPlatformTime::Seconds
+	 * @return Paths of segments that are no longer pinned and can be deleted from disk.
+	 */
+	TArray<FString> AddBookmark(const FString& Name, double Time);
+
+	/**
+	 * Removes a bookmark.
+	 *
+	 * @return Paths of segments that are no longer pinned and can be deleted from disk.
+	 */
+	TArray<FString> RemoveBookmark(const FString& Name);
+
+	/** Checks whether a bookmark with the given name exists. */
+	bool HasBookmark(const FString& Name) const;
+
+	/** Gets the names of all bookmarks, oldest first. */
+	TArray<FString> GetBookmarkNames() const;
+
+	/** Gets the pinned and ring segments overlapping the window around a bookmark, ordered from the oldest to the newest. */
+	TArray<FString> GetBookmarkSegments(const FString& Name) const;
+
+	/** Gets the total size of the segments pinned by bookmarks. */
+	int64 GetPinnedBytes() const;
+
+	/**
+	 * Gets the newest finalized segments whose total size fits the given budget, ordered from the oldest to the newest.
+	 * Since every segment starts with a keyframe, dropping the oldest ones keeps the video playable up to the crash point.
+	 *
+	 * @param MaxBytes - Max total size of the returned segments (0 for no limit)
+	 */
+	TArray<FString> GetNewestSegmentsWithinSize(int64 MaxBytes) const;
+
+	/**
+	 * Writes an ffconcat index referencing the given segments.
+	 *
+	 * @return True if the index was written.
+	 */
+	static bool WriteIndex(const FString& IndexPath, const TArray<FString>& SegmentPaths);
+
+	/**
+	 * Gets the directory of the newest segment along with the concat index and timeline paths in it.
+	 * Refreshed only when a segment from a different directory is registered so the crash handler doesn't have to build them.
+	 * Copied under the lock since the recording thread may register a segment at the same time.
+	 */
+	void GetPaths(FString& OutDirectory, FString& OutIndexPath, FString& OutTimelinePath) const;
+
+private:
+	struct FSegment
+	{
+		FString Path;
+
+		/** Approximate time span covered by the segment in FPlatformTime::Seconds. */
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+
+		/** File size, only looked up once the segment is pinned. */
+		int64 Size = 0;
+	};
+
+	struct FBookmark
+	{
+		FString Name;
+		double Time = 0.0;
+	};
+
+	/** Removes the oldest segments exceeding the limit, pinning those overlapping a bookmark. Expects the lock to be held. */
+	TArray<FString> EvictExcessSegments();
+
+	/** Checks whether the segment overlaps the window of any bookmark. Expects the lock to be held. */
+	bool IsBookmarked(const FSegment& Segment) const;
+
+	/** Checks whether the segment overlaps the window of the bookmark. */
+	bool Overlaps(const FSegment& Segment, const FBookmark& Bookmark) const;
+
+	/** Releases the pinned segments that no bookmark needs anymore, then the oldest ones exceeding the budget. Expects the lock to be held. */
+	TArray<FString> ReleasePinnedSegments();
+
+	mutable FCriticalSection CriticalSection;
+
+	TArray<FSegment> Segments;
+
+	/** Segments evicted from the ring but kept for bookmarks, oldest first. */
+	TArray<FSegment> PinnedSegments;
+	int64 PinnedBytes = 0;
+
+	TArray<FBookmark> Bookmarks;
+
+	float BookmarkWindowSeconds = 10.0f;
+	int64 MaxPinnedBytes = 0;
+
+	/** End time of the newest segment, or the time the ring was reset at, used as the start of the next segment. */
+	double LastSegmentEndTime = 0.0;
+
+	FString Directory;
+	FString IndexPath;
+	FString TimelinePath;
+
+	int32 MaxSegments = 0;
+};
@@ -0,0 +1,117 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+
+/**
+ * Per-frame metadata recorded next to the crash video.
+ *
+ * Every frame the game thread appends a fixed-size record with the frame number, frame stats and the range of
+ * breadcrumb IDs added during the frame to an in-memory ring, which takes a few nanoseconds and never allocates.
+ * Breadcrumbs carry their ID in the `breadcrumb_id` data field while the timeline is active, so that hitches and
+ * logs can be matched against the footage exactly instead of by timestamp.
+ *
+ * When a crash occurs the ring is written as a little-endian binary side-car attached next to the video:
+ *   header  - "SRVT", uint32 version, uint32 number of videos, uint32 number of frames
+ *   videos  - uint32 video index, uint32 padding, int64 UTC start time (microseconds), char[64] video file name
+ *   frames  - FFrame records ordered from the oldest to the newest
+ */
+class SENTRY_API FSentryCrashVideoTimeline
+{
+public:
+	/** Metadata of a single frame. */
+	struct FFrame
+	{
+		/** Engine frame counter. */
+		uint64 FrameNumber;
+
+		/** UTC time the frame ended at, in microseconds. */
+		int64 TimestampUs;
+
+		/** Seconds since the video the frame belongs to started recording. */
+		float VideoSeconds;
+
+		/** Index of the video the frame belongs to, increases whenever the recorder is restarted. */
+		uint32 VideoIndex;
+
+		/** Game thread, render thread and GPU time of the last completed frame in milliseconds. */
+		float GameThreadMs;
+		float RenderThreadMs;
+		float GpuMs;
+
+		/** First ID of the breadcrumbs added during the frame. */
+		uint32 FirstBreadcrumbId;
+
+		/** Number of breadcrumbs added during the frame. */
+		uint32 NumBreadcrumbs;
+
+		uint32 Padding;
+	};
+
+	static FSentryCrashVideoTimeline& Get();
+
+	/**
+	 * Starts recording frame metadata. Called on the game thread.
+	 *
+	 * @param MaxFrames Number of most recent frames to keep, enough to cover the recorded video duration.
+	 */
+	void Start(int32 MaxFrames);
+
+	/** Stops recording frame metadata and discards the recorded frames. */
+	void Stop();
+
+	/** Checks whether frame metadata is being recorded. */
+	bool IsActive() const { return bIsActive; }
+
+	/** Marks the start of a new video, called whenever the recorder starts writing a new file. */
+	void OnVideoStarted(const FString& VideoPath);
+
+	/** Gets the ID of a newly added breadcrumb. Safe to call from any thread. */
+	uint32 OnBreadcrumbAdded();
+
+	/**
+	 * Writes the recorded frames to the side-car file. Safe to call from the crash handler.
+	 *
+	 * @return True if the file was written.
+	 */
+	bool Write(const FString& Path) const;
+
+private:
+	static constexpr int32 MaxVideos = 64;
+
+	struct FVideo
+	{
+		uint32 VideoIndex;
+		uint32 Padding;
+		int64 StartTimestampUs;
+		ANSICHAR FileName[64];
+	};
+
+	void OnEndFrame();
+
+	static int64 GetTimestampUs();
+
+	FThreadSafeBool bIsActive;
+
+	FDelegateHandle OnEndFrameHandle;
+
+	/** Last breadcrumb ID handed out. */
+	FThreadSafeCounter LastBreadcrumbId;
+
+	/** Guards the rings against being written while the crash handler reads them. */
+	mutable FCriticalSection CriticalSection;
+
+	TArray<FFrame> Frames;
+	int64 NumFramesWritten = 0;
+
+	FVideo Videos[MaxVideos];
+	int32 NumVideosStarted = 0;
+
+	// Game thread state
+	double VideoStartSeconds = 0.0;
+	uint32 LastFrameBreadcrumbId = 0;
+};
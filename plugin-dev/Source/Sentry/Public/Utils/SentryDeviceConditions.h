@@ -0,0 +1,156 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include "SentryVariant.h"
+
+/** Thermal state reported by the platform, normalized to the levels used by iOS. */
+enum class ESentryThermalState : uint8
+{
+	Unknown,
+	/** No throttling. */
+	Nominal,
+	/** Light throttling that doesn't affect the user experience much. */
+	Fair,
+	/** Performance is reduced noticeably. */
+	Serious,
+	/** Performance is reduced significantly and the device is about to shut down. */
+	Critical
+};
+
+/** Thermal, power and clock state of the device at a point in time. Values that the platform doesn't report are negative. */
+struct FSentryDeviceConditions
+{
+	/** Seconds since the sampler started. */
+	double SampledAtSeconds = 0.0;
+
+	ESentryThermalState ThermalState = ESentryThermalState::Unknown;
+
+	/** Battery level in percent. */
+	int32 BatteryLevel = -1;
+
+	bool bIsCharging = false;
+
+	/** Highest current and max frequency among the CPU cores. */
+	int32 CpuFrequencyMHz = -1;
+	int32 CpuMaxFrequencyMHz = -1;
+
+	int32 GpuFrequencyMHz = -1;
+
+	/** Whether the device was throttling as of this sample, determined from the samples so far by FSentryThrottleDetector. */
+	bool bIsThrottled = false;
+
+	FSentryDeviceConditions() = default;
+
+	FSentryDeviceConditions(double InSampledAtSeconds, ESentryThermalState InThermalState, int32 InBatteryLevel, int32 InCpuFrequencyMHz, int32 InCpuMaxFrequencyMHz)
+		: SampledAtSeconds(InSampledAtSeconds)
+		, ThermalState(InThermalState)
+		, BatteryLevel(InBatteryLevel)
+		, CpuFrequencyMHz(InCpuFrequencyMHz)
+		, CpuMaxFrequencyMHz(InCpuMaxFrequencyMHz)
+	{
+	}
+
+	/** Checks whether the platform reports a thermal state severe enough to throttle. */
+	bool IsThermallyThrottled() const;
+
+	/** Checks whether the CPU is clocked well below its max, which alone may as well be the device saving power while idle. */
+	bool HasReducedClock() const;
+
+	/** Checks whether the CPU is clocked close enough to its max to no longer consider it throttled, or the clock is unknown. */
+	bool HasRecoveredClock() const;
+
+	/** Checks whether the conditions differ enough from the given ones to update the context of events. */
+	bool HasChangedSince(const FSentryDeviceConditions& Previous) const;
+
+	static FString ThermalStateToString(ESentryThermalState State);
+};
+
+/**
+ * Tells throttling apart from dynamic frequency scaling lowering the clocks of an idle device.
+ *
+ * A severe thermal state counts right away. Reduced clocks have to persist over several samples before they count,
+ * and throttling only ends once the clocks are back close to their max, so a clock hovering around the threshold
+ * doesn't flip the state on every sample.
+ */
+class SENTRY_API FSentryThrottleDetector
+{
+public:
+	/** Number of consecutive samples with reduced clocks considered sustained throttling. */
+	static constexpr int32 SustainedSamples = 3;
+
+	/** Updates the state with the given sample and returns whether the device is throttling. */
+	bool Update(const FSentryDeviceConditions& Conditions);
+
+	bool IsThrottled() const { return bIsThermallyThrottled || bIsClockThrottled; }
+
+	void Reset();
+
+private:
+	int32 NumReducedClockSamples = 0;
+
+	bool bIsThermallyThrottled = false;
+	bool bIsClockThrottled = false;
+};
+
+DECLARE_DELEGATE_RetVal_OneParam(bool, FSentryQueryDeviceConditions, FSentryDeviceConditions&);
+DECLARE_DELEGATE_TwoParams(FSentryOnDeviceConditionsChanged, const FSentryDeviceConditions& /* Previous */, const FSentryDeviceConditions& /* Current */);
+
+/**
+ * Low-frequency sampler of the thermal state, battery and clocks of mobile devices.
+ *
+ * Conditions are queried from the platform on a game thread ticker and kept in a short history so that events can
+ * tell whether the device was heating up or cooling down. Consumers are notified only when the conditions change
+ * noticeably, which keeps the scope context from being rewritten on every sample.
+ */
+class SENTRY_API FSentryDeviceConditionsSampler
+{
+public:
+	static FSentryDeviceConditionsSampler& Get();
+
+	/** Starts sampling, called on the game thread. */
+	void Start(float InIntervalSeconds, FSentryQueryDeviceConditions InQuery, FSentryOnDeviceConditionsChanged InOnChanged);
+
+	void Stop();
+
+	bool IsActive() const { return bIsActive; }
+
+	/** Checks whether the device was throttling as of the latest sample. Safe to call from any thread. */
+	bool IsThrottled() const { return bIsThrottled; }
+
+	/** Converts the latest sample and the trend of the history to the values of the device conditions context. */
+	TMap<FString, FSentryVariant> ToContext() const;
+
+	/** Converts samples to the values of the device conditions context, the latest sample comes last. */
+	static TMap<FString, FSentryVariant> ToContext(const TArray<FSentryDeviceConditions>& InHistory);
+
+private:
+	static constexpr int32 MaxHistory = 12;
+
+	FSentryDeviceConditionsSampler() = default;
+
+	/** Queries the conditions and notifies about changes. Called on the game thread. */
+	void Sample();
+
+	FThreadSafeBool bIsActive;
+	FThreadSafeBool bIsThrottled;
+
+	FSentryQueryDeviceConditions Query;
+	FSentryOnDeviceConditionsChanged OnChanged;
+
+	/** Incremented whenever sampling starts so that the ticker of a previous start stops. */
+	uint32 StartSerial = 0;
+
+	double StartSeconds = 0.0;
+
+	/** Latest samples, oldest first. */
+	TArray<FSentryDeviceConditions> History;
+
+	/** Sample consumers were last notified about. */
+	FSentryDeviceConditions LastReported;
+
+	FSentryThrottleDetector ThrottleDetector;
+};
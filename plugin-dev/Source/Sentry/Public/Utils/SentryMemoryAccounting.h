@@ -0,0 +1,81 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SentryMemoryStats.h"
+
+struct FSentryVariant;
+
+/** Attributing native SDK allocations costs a small header per allocation, so it's left out of shipping builds by default. */
+#ifndef SENTRY_MEMORY_ACCOUNTING
+#define SENTRY_MEMORY_ACCOUNTING !UE_BUILD_SHIPPING
+#endif
+
+/** Components native SDK allocations are attributed to. */
+enum class ESentryMemoryComponent : uint8
+{
+	Other,
+	Breadcrumbs,
+	Scope,
+	PendingEnvelopes,
+	Num
+};
+
+/**
+ * Memory held by the SDK, reported with `Sentry.MemReport` and USentrySubsystem::GetMemoryStats.
+ *
+ * Allocations of the native SDK are attributed to the component set for the allocating thread with a scope, everything
+ * else is either published here by its owner as it changes or measured by the subsystem when the stats are read.
+ */
+namespace SentryMemoryAccounting
+{
+	/** Attributes native SDK allocations of the calling thread to the component while in scope. */
+	class FScope
+	{
+	public:
+		explicit FScope(ESentryMemoryComponent Component);
+		~FScope();
+
+		FScope(const FScope&) = delete;
+		FScope& operator=(const FScope&) = delete;
+
+	private:
+		ESentryMemoryComponent PreviousComponent;
+	};
+
+	ESentryMemoryComponent GetCurrentComponent();
+
+	/** Records native SDK memory allocated or freed on behalf of the component, called by the allocation hooks. */
+	void AddNativeBytes(ESentryMemoryComponent Component, int64 DeltaBytes);
+
+	/** Records that sentry-native allocates through the hooks, so its heap usage is known to be complete. */
+	void MarkNativeHeapTracked();
+
+	void AddAttachmentBytes(int64 DeltaBytes);
+
+	SENTRY_API void SetCrashVideoBytes(int64 Bytes);
+	void SetCrashAudioBytes(int64 Bytes);
+
+	void AddJniGlobalRefs(int32 Delta);
+
+	/** Gets the values published so far, components measured on demand are added by the subsystem. */
+	FSentryMemoryStats GetStats();
+
+	/** Allocated size of the containers including the strings and nested values they own. */
+	SIZE_T GetAllocatedSize(const FString& String);
+	SIZE_T GetAllocatedSize(const FSentryVariant& Variant);
+	SIZE_T GetAllocatedSize(const TMap<FString, FString>& Map);
+	SIZE_T GetAllocatedSize(const TMap<FString, FSentryVariant>& Map);
+	SIZE_T GetAllocatedSize(const TMap<FString, TMap<FString, FSentryVariant>>& Map);
+
+	/** Formats the stats as a human-readable table, one component per line. */
+	TArray<FString> ToLines(const FSentryMemoryStats& Stats);
+}
+
+#if SENTRY_MEMORY_ACCOUNTING
+#define SENTRY_MEMORY_SCOPE(Component) const SentryMemoryAccounting::FScope PREPROCESSOR_JOIN(SentryMemoryScope, __LINE__)(ESentryMemoryComponent::Component)
+#else
+#define SENTRY_MEMORY_SCOPE(Component)
+#endif
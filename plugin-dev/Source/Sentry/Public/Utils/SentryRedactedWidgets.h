@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "RHI.h"
+#include "Templates/Atomic.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "SentryBackBufferCapture.h"
+
+class SWidget;
+class SWindow;
+class UWidget;
+
+/**
+ * Widgets redacted from the frames captured by the plugin (screenshots and crash frame strip).
+ *
+ * The game thread updates the rectangles of the redacted widgets in the game viewport window once per frame, relative to
+ * the window size so that they map onto the presented back buffer (or a screenshot) at any resolution and DPI scale.
+ * Capture passes on the render thread copy the captured texture into a scratch render target and clear the rectangles to
+ * black on the GPU before reading it back, so redacting doesn't add any per-frame CPU work on the captured pixels.
+ * Frames of other windows, or captured where the GPU pass isn't available, aren't captured at all while widgets are redacted.
+ */
+class SENTRY_API FSentryRedactedWidgets
+{
+public:
+	static FSentryRedactedWidgets& Get();
+
+	/** Redacts the widget until it's unredacted or destroyed. Called on the game thread. */
+	void AddWidget(const TSharedRef<SWidget>& Widget);
+	void AddWidget(UWidget* Widget);
+
+	/** Stops redacting the widget. Called on the game thread. */
+	void RemoveWidget(const TSharedRef<SWidget>& Widget);
+	void RemoveWidget(UWidget* Widget);
+
+	/** Checks whether any widgets are redacted. Safe to call from any thread. */
+	bool HasWidgets() const;
+
+	/**
+	 * Copies the texture with the redacted widgets cleared if any of them are visible in the window. Called on the render thread.
+	 *
+	 * @param Window Window the texture was presented in.
+	 * @param Source Back buffer of the window, left in the CopySrc state.
+	 * @param Scratch Render target the masked copy is made in, (re)created if it doesn't match the source.
+	 *
+	 * @return Texture to read back, either the source or the scratch render target. Null if widgets are redacted but can't
+	 *         be cleared from the texture (another window, or an engine version without the GPU pass), which mustn't be captured then.
+	 */
+	FSentryTextureRHIRef Apply(FRHICommandListImmediate& RHICmdList, const SWindow& Window, const FSentryTextureRHIRef& Source, FSentryTextureRHIRef& Scratch) const;
+
+	/**
+	 * Clears the redacted widgets from pixels captured from the window on the CPU, e.g. a Slate screenshot.
+	 *
+	 * @return False if widgets are redacted but can't be cleared from the pixels of the window, which mustn't be used then.
+	 */
+	bool Apply(const SWindow* Window, TArray<FColor>& Pixels, const FIntPoint& Size) const;
+
+private:
+	/** Updates the rectangles of the visible redacted widgets. Called on the game thread. */
+	void OnEndFrame();
+
+	void UpdateEndFrameHandler();
+
+	FDelegateHandle OnEndFrameHandle;
+
+	// Game thread state
+	TArray<TWeakPtr<SWidget>> SlateWidgets;
+	TArray<TWeakObjectPtr<UWidget>> UmgWidgets;
+
+	/** Flag indicating whether any widgets are redacted, read by capture passes on the render thread. */
+	TAtomic<bool> bHasWidgets { false };
+
+	mutable FCriticalSection RectsCriticalSection;
+
+	/** Rectangles of the visible redacted widgets, in fractions of the window size. */
+	TArray<FBox2D> Rects;
+
+	/** Window the rectangles belong to. */
+	const SWindow* RectsWindow = nullptr;
+
+	/** Gets the rectangles scaled to a capture of the window of the given size, clipped to it. */
+	TArray<FIntRect> GetRects(const FIntPoint& Size) const;
+};
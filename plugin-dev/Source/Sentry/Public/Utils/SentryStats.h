@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeExit.h"
+#include "Stats/Stats.h"
+
+/**
+ * Self-overhead of the SDK viewable in-game with `stat sentry`.
+ * Each duty has a per-frame cycle counter and a cumulative time accumulated since startup, both inclusive of nested duties.
+ */
+DECLARE_STATS_GROUP(TEXT("Sentry"), STATGROUP_Sentry, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Breadcrumbs"), STAT_SentryBreadcrumbs, STATGROUP_Sentry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Logs"), STAT_SentryLogs, STATGROUP_Sentry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Captures"), STAT_SentryCaptures, STATGROUP_Sentry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scope Mutations"), STAT_SentryScopeMutations, STATGROUP_Sentry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crash Video Capture"), STAT_SentryCrashVideoCapture, STATGROUP_Sentry, SENTRY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crash Video Encode"), STAT_SentryCrashVideoEncode, STATGROUP_Sentry, SENTRY_API);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Breadcrumbs Total (ms)"), STAT_SentryBreadcrumbsTotal, STATGROUP_Sentry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Logs Total (ms)"), STAT_SentryLogsTotal, STATGROUP_Sentry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Captures Total (ms)"), STAT_SentryCapturesTotal, STATGROUP_Sentry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Scope Mutations Total (ms)"), STAT_SentryScopeMutationsTotal, STATGROUP_Sentry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Crash Video Capture Total (ms)"), STAT_SentryCrashVideoCaptureTotal, STATGROUP_Sentry, SENTRY_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Crash Video Encode Total (ms)"), STAT_SentryCrashVideoEncodeTotal, STATGROUP_Sentry, SENTRY_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Attachment Data"), STAT_SentryAttachmentMemory, STATGROUP_Sentry, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Crash Video Buffer (Estimated)"), STAT_SentryVideoBufferMemory, STATGROUP_Sentry, SENTRY_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Crash Audio Ring"), STAT_SentryAudioRingMemory, STATGROUP_Sentry, );
+
+#if STATS
+/**
+ * Counts the enclosing scope towards both the per-frame and the cumulative cost of the given duty.
+ * The scope is only timed while stats are collected since the accumulator ignores updates otherwise.
+ */
+#define SENTRY_STAT_SCOPE(Duty) \
+	SCOPE_CYCLE_COUNTER(STAT_Sentry##Duty); \
+	const double PREPROCESSOR_JOIN(SentryStatStartTime, __LINE__) = FThreadStats::IsCollectingData() ? FPlatformTime::Seconds() : 0.0; \
+	ON_SCOPE_EXIT \
+	{ \
+		if (PREPROCESSOR_JOIN(SentryStatStartTime, __LINE__) > 0.0) \
+		{ \
+			INC_FLOAT_STAT_BY(STAT_Sentry##Duty##Total, static_cast<float>((FPlatformTime::Seconds() - PREPROCESSOR_JOIN(SentryStatStartTime, __LINE__)) * 1000.0)); \
+		} \
+	}
+#else
+#define SENTRY_STAT_SCOPE(Duty)
+#endif
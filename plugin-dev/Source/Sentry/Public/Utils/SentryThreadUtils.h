@@ -0,0 +1,26 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformAffinity.h"
+
+#include "SentryDataTypes.h"
+
+namespace SentryThreadUtils
+{
+	SENTRY_API EThreadPriority ToThreadPriority(ESentryThreadPriority Priority);
+
+	/** Converts a configured affinity mask to the one threads are created with, no mask lets the platform decide. */
+	SENTRY_API uint64 ToAffinityMask(int64 AffinityMask);
+
+	/**
+	 * Changes the priority and affinity of running threads, e.g. worker threads of other plugins.
+	 * Affinity of running threads can only be changed on Unreal Engine 5.1 or newer.
+	 *
+	 * @param NameFilter Substring of the names of the threads to change.
+	 *
+	 * @return Number of threads changed.
+	 */
+	SENTRY_API int32 ApplyToThreads(const FString& NameFilter, EThreadPriority Priority, uint64 AffinityMask);
+}
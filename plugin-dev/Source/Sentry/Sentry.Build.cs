@@ -38,27 +38,17 @@ public class Sentry : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"UMG",
 				"Projects",
 				"Json",
-				"HTTP"
+				"HTTP",
+				"RenderCore",
+				"RHI",
+				"ImageWrapper"
 				// ... add private dependencies that you statically link with here ...	
 			}
 		);
 
-		bool bEnableVideoRecording = true;
-		if (bEnableVideoRecording)
-		{
-			PrivateDependencyModuleNames.AddRange(
-				new string[]
-				{
-                    "RuntimeVideoRecorder",
-                }
-			);
-
-            PublicDefinitions.Add("HAS_RUNTIME_VIDEO_RECORDER=1");
-            bEnableVideoRecording = true;
-        }
-
 		string PlatformThirdPartyPath = Path.GetFullPath(Path.Combine(PluginDirectory, "Source", "ThirdParty", Target.Platform.ToString()));
 		string PlatformBinariesPath = Path.GetFullPath(Path.Combine(PluginDirectory, "Binaries", Target.Platform.ToString()));
 
@@ -67,6 +57,7 @@ public class Sentry : ModuleRules
 			PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "Private", "Apple"));
 
 			PublicAdditionalFrameworks.Add(new Framework("Sentry", Path.Combine(PlatformThirdPartyPath, "Sentry.embeddedframework.zip"), null, true));
+			PublicWeakFrameworks.Add("MetricKit");
 
 			string PluginPath = Utils.MakePathRelativeTo(ModuleDirectory, Target.RelativeEnginePath);
 
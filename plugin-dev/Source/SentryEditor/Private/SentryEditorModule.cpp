@@ -3,7 +3,9 @@
 #include "SentryEditorModule.h"
 #include "SentrySettings.h"
 #include "SentrySettingsCustomization.h"
+#include "SentrySymToolsDownloader.h"
 
+#include "Async/Async.h"
 #include "Modules/ModuleManager.h"
 #include "PropertyEditorModule.h"
 
@@ -18,6 +20,12 @@ void FSentryEditorModule::StartupModule()
 	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
 	PropertyModule.RegisterCustomClassLayout("SentrySettings", FOnGetDetailCustomizationInstance::CreateStatic(&FSentrySettingsCustomization::MakeInstance));
 	PropertyModule.NotifyCustomizationModuleChanged();
+
+	// Symbol upload tools downloaded for other projects are reused without waiting for the settings to be opened
+	Async(EAsyncExecution::ThreadPool, []()
+	{
+		FSentrySymToolsDownloader().SyncWithCache();
+	});
 }
 
 void FSentryEditorModule::ShutdownModule()
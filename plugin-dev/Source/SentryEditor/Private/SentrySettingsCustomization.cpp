@@ -14,8 +14,12 @@
 #include "Engine/Engine.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/EngineVersion.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "PropertyHandle.h"
 
@@ -49,6 +53,7 @@ void OnDocumentationLinkClicked(const FSlateHyperlinkRun::FMetadata& Metadata);
 FSentrySettingsCustomization::FSentrySettingsCustomization()
 	: CliDownloader(MakeShareable(new FSentrySymToolsDownloader()))
 	, IsCompilingLinuxBinaries(false)
+	, LinuxBinariesCompileStartTime(0.0)
 {
 }
 
@@ -115,7 +120,7 @@ void FSentrySettingsCustomization::DrawGeneralNotice(IDetailLayoutBuilder& Detai
 			FText::FromString(TEXT("Sentry Linux pre-compiled binaries are missing.")), FText::FromString(TEXT("Compile")));
 
 		TSharedRef<SWidget> LinuxBinariesCompilingWidget = MakeLinuxBinariesStatusRow(FName(TEXT("SettingsEditor.WarningIcon")),
-			FText::FromString(TEXT("Compiling Sentry for Linux...")), FText());
+			TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateSP(this, &FSentrySettingsCustomization::GetLinuxBinariesCompilingMessage)), FText());
 
 		TSharedRef<SWidget> LinuxBinariesConfiguredWidget = MakeLinuxBinariesStatusRow(FName(TEXT("SettingsEditor.GoodIcon")),
 			FText::FromString(TEXT("Sentry Linux pre-compiled binaries are ready.")), FText());
@@ -386,7 +391,7 @@ TSharedRef<SWidget> FSentrySettingsCustomization::MakeGeneralSettingsStatusRow(F
 	return Result;
 }
 
-TSharedRef<SWidget> FSentrySettingsCustomization::MakeLinuxBinariesStatusRow(FName IconName, FText Message, FText ButtonMessage)
+TSharedRef<SWidget> FSentrySettingsCustomization::MakeLinuxBinariesStatusRow(FName IconName, TAttribute<FText> Message, FText ButtonMessage)
 {
 	// clang-format off
 	TSharedRef<SHorizontalBox> Result = SNew(SHorizontalBox)
@@ -425,14 +430,21 @@ TSharedRef<SWidget> FSentrySettingsCustomization::MakeLinuxBinariesStatusRow(FNa
 				SNew(SButton)
 				.OnClicked_Lambda([this]() -> FReply
 				{
+					// Binaries compiled for another project with the same plugin and engine versions can be reused as is
+					if (RestoreLinuxBinariesFromCache())
+					{
+						return FReply::Handled();
+					}
+
 					IsCompilingLinuxBinaries = true;
+					LinuxBinariesCompileStartTime = FPlatformTime::Seconds();
 
 					// In case the plugin installed via Epic Games launcher it's supposed to be <EngineDir>/Plugins/Marketplace/Sentry
 					const FString PluginPath = FPaths::ConvertRelativePathToFull(IPluginManager::Get().FindPlugin(TEXT("Sentry"))->GetBaseDir());
 
 					const FString TempLinuxBinariesPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectDir(), TEXT("Intermediate"), TEXT("SentryLinuxBinaries")));
 
-					FString CommandLine = FString::Printf(TEXT("BuildPlugin -Plugin=\"%s/Sentry.uplugin\" -Package=\"%s\" -CreateSubFolder -TargetPlatforms=Linux"), *PluginPath, *TempLinuxBinariesPath);
+					FString CommandLine = FString::Printf(TEXT("BuildPlugin -Plugin=\"%s/Sentry.uplugin\" -Package=\"%s\" -CreateSubFolder -TargetPlatforms=Linux -NoHostPlatform"), *PluginPath, *TempLinuxBinariesPath);
 
 					IUATHelperModule::Get().CreateUatTask(CommandLine, FText::FromString("Windows"),
 						FText::FromString("Compiling Sentry for Linux"),
@@ -447,8 +459,11 @@ TSharedRef<SWidget> FSentrySettingsCustomization::MakeLinuxBinariesStatusRow(FNa
 						{
 							if (result.Equals(TEXT("Completed")))
 							{
-								FPlatformFileManager::Get().GetPlatformFile().CopyDirectoryTree(*GetLinuxBinariesDirPath(),
-									*FPaths::Combine(TempLinuxBinariesPath, TEXT("Intermediate"), TEXT("Build"), TEXT("Linux")), true);
+								const FString CompiledBinariesPath = FPaths::Combine(TempLinuxBinariesPath, TEXT("Intermediate"), TEXT("Build"), TEXT("Linux"));
+
+								FPlatformFileManager::Get().GetPlatformFile().CopyDirectoryTree(*GetLinuxBinariesDirPath(), *CompiledBinariesPath, true);
+
+								StoreLinuxBinariesInCache(CompiledBinariesPath);
 							}
 
 							IsCompilingLinuxBinaries = false;
@@ -603,6 +618,44 @@ FString FSentrySettingsCustomization::GetLinuxBinariesDirPath() const
 	return FPaths::Combine(PluginPath, TEXT("Intermediate"), TEXT("Build"), TEXT("Linux"));
 }
 
+FString FSentrySettingsCustomization::GetLinuxBinariesCachePath() const
+{
+	// Bundled sentry-native revision is tied to the plugin version so there's no need to track it separately
+	const FString CacheKey = FString::Printf(TEXT("%s-%s"), *FSentryModule::Get().GetPluginVersion(), *FEngineVersion::Current().ToString(EVersionComponent::Changelist));
+	return FPaths::Combine(FPlatformProcess::UserSettingsDir(), TEXT("Sentry"), TEXT("LinuxBinaries"), CacheKey);
+}
+
+bool FSentrySettingsCustomization::RestoreLinuxBinariesFromCache() const
+{
+	const FString CachePath = GetLinuxBinariesCachePath();
+
+	// Marker is written last so that a cache entry interrupted while being stored isn't used
+	if (!FPaths::FileExists(FPaths::Combine(CachePath, TEXT(".complete"))))
+	{
+		return false;
+	}
+
+	return FPlatformFileManager::Get().GetPlatformFile().CopyDirectoryTree(*GetLinuxBinariesDirPath(), *FPaths::Combine(CachePath, TEXT("Linux")), true);
+}
+
+void FSentrySettingsCustomization::StoreLinuxBinariesInCache(const FString& BinariesPath) const
+{
+	const FString CachePath = GetLinuxBinariesCachePath();
+
+	IFileManager::Get().DeleteDirectory(*CachePath, false, true);
+
+	if (FPlatformFileManager::Get().GetPlatformFile().CopyDirectoryTree(*FPaths::Combine(CachePath, TEXT("Linux")), *BinariesPath, true))
+	{
+		FFileHelper::SaveStringToFile(FString(), *FPaths::Combine(CachePath, TEXT(".complete")));
+	}
+}
+
+FText FSentrySettingsCustomization::GetLinuxBinariesCompilingMessage() const
+{
+	const int32 ElapsedSeconds = FMath::FloorToInt(FPlatformTime::Seconds() - LinuxBinariesCompileStartTime);
+	return FText::FromString(FString::Printf(TEXT("Compiling Sentry for Linux... (%d:%02d elapsed, see the output log for details)"), ElapsedSeconds / 60, ElapsedSeconds % 60));
+}
+
 int32 FSentrySettingsCustomization::GetGeneralSettingsStatusAsInt() const
 {
 	USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
@@ -10,9 +10,13 @@
 #include "Runtime/Launch/Resources/Version.h"
 
 #include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
 #include "Misc/EngineVersionComparison.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
 
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
 #include "HAL/PlatformFilemanager.h"
@@ -30,20 +34,66 @@ const FString FSentrySymToolsDownloader::SentryCliExecName = TEXT("sentry-cli-Li
 
 const FString FSentrySymToolsDownloader::SentrySymUploadScriptName = TEXT("upload-debug-symbols.py");
 
+FCriticalSection FSentrySymToolsDownloader::CacheCriticalSection;
+
 void FSentrySymToolsDownloader::Download(const TFunction<void(bool)>& OnCompleted)
 {
-	SentryCliDownloadRequest = FHttpModule::Get().CreateRequest();
-	SentryScriptDownloadRequest = FHttpModule::Get().CreateRequest();
+	TSharedRef<FDownloadState> State = MakeShared<FDownloadState>();
+	State->OnCompleted = OnCompleted;
 
-	const FString SentryCliExecPath = GetSentryCliPath();
-	const FString CliDownloadUrl = FString::Printf(TEXT("https://github.com/getsentry/sentry-cli/releases/download/%s/%s"), *GetSentryCliVersion(), *SentryCliExecName);
+	const FSymTool SentryCliTool = GetSentryCliTool();
+	const FSymTool SymUploadScriptTool = GetSymUploadScriptTool();
 
-	const FString PluginVersion = FSentryModule::Get().GetPluginVersion();
-	const FString SymUploadScriptPath = GetSymUploadScriptPath();
-	const FString SymUploadScriptDownloadUrl = FString::Printf(TEXT("https://raw.githubusercontent.com/getsentry/sentry-unreal/refs/tags/%s/plugin-dev/Scripts/%s"), *PluginVersion, *SentrySymUploadScriptName);
+	bool bIsSentryCliCached = false;
+	bool bIsSymUploadScriptCached = false;
+
+	{
+		FScopeLock Lock(&CacheCriticalSection);
+
+		// Tools cached by other projects or engine installs don't need to be downloaded again
+		bIsSentryCliCached = InstallFromCache(SentryCliTool);
+		bIsSymUploadScriptCached = InstallFromCache(SymUploadScriptTool);
+	}
+
+	State->NumPending = (bIsSentryCliCached ? 0 : 1) + (bIsSymUploadScriptCached ? 0 : 1);
 
-	Download(SentryCliDownloadRequest, CliDownloadUrl, SentryCliExecPath, OnCompleted);
-	Download(SentryScriptDownloadRequest, SymUploadScriptDownloadUrl, SymUploadScriptPath, OnCompleted);
+	if (State->NumPending == 0)
+	{
+		OnCompleted(GetStatus() == ESentrySymToolsStatus::Configured);
+		return;
+	}
+
+	if (!bIsSentryCliCached)
+	{
+		SentryCliDownloadRequest = FHttpModule::Get().CreateRequest();
+		Download(SentryCliDownloadRequest, SentryCliTool, State);
+	}
+
+	if (!bIsSymUploadScriptCached)
+	{
+		SentryScriptDownloadRequest = FHttpModule::Get().CreateRequest();
+		Download(SentryScriptDownloadRequest, SymUploadScriptTool, State);
+	}
+}
+
+void FSentrySymToolsDownloader::SyncWithCache()
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	for (const FSymTool& Tool : { GetSentryCliTool(), GetSymUploadScriptTool() })
+	{
+		if (FPaths::FileExists(Tool.InstallPath))
+		{
+			if (!IsCached(Tool.CachePath))
+			{
+				StoreInCache(Tool.InstallPath, Tool.CachePath);
+			}
+		}
+		else
+		{
+			InstallFromCache(Tool);
+		}
+	}
 }
 
 ESentrySymToolsStatus FSentrySymToolsDownloader::GetStatus()
@@ -63,59 +113,158 @@ ESentrySymToolsStatus FSentrySymToolsDownloader::GetStatus()
 	return ESentrySymToolsStatus::Missing;
 }
 
-void FSentrySymToolsDownloader::Download(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& Request, const FString& Url, const FString& SavePath, const TFunction<void(bool)>& OnCompleted)
+void FSentrySymToolsDownloader::Download(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& Request, const FSymTool& Tool, const TSharedRef<FDownloadState>& State)
 {
-	Request->OnProcessRequestComplete().BindLambda([this, SavePath, OnCompleted](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+	const FString PartialPath = Tool.CachePath + TEXT(".part");
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(PartialPath), true);
+
+	TSharedPtr<FArchive> Writer;
+
+#if !UE_VERSION_OLDER_THAN(5, 4, 0)
+	// Response body goes straight to disk instead of being held in memory until the request completes
+	Writer = MakeShareable(IFileManager::Get().CreateFileWriter(*PartialPath));
+	if (!Writer.IsValid() || !Request->SetResponseBodyReceiveStream(Writer.ToSharedRef()))
 	{
-		if (!bSuccess || !Response.IsValid())
-		{
-			OnCompleted(false);
-			return;
-		}
+		CompleteDownload(State, false);
+		return;
+	}
+#endif
 
-		FString DirPath, Filename, Extension;
-		FPaths::Split(SavePath, DirPath, Filename, Extension);
+	Request->OnProcessRequestComplete().BindLambda([this, Tool, State, PartialPath, Writer](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+	{
+		bool bIsDownloaded = bSuccess && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
 
-		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+#if !UE_VERSION_OLDER_THAN(5, 4, 0)
+		bIsDownloaded = Writer->Close() && bIsDownloaded;
+#else
+		bIsDownloaded = bIsDownloaded && FFileHelper::SaveArrayToFile(Response->GetContent(), *PartialPath);
+#endif
 
-		if (!PlatformFile.DirectoryExists(*DirPath))
-		{
-			if (!PlatformFile.CreateDirectoryTree(*DirPath))
-			{
-				OnCompleted(false);
-				return;
-			}
-		}
+		FScopeLock Lock(&CacheCriticalSection);
 
-		if (PlatformFile.FileExists(*SavePath))
-		{
-			if (!PlatformFile.DeleteFile(*SavePath))
-			{
-				OnCompleted(false);
-				return;
-			}
-		}
+		// Downloads are moved into the cache only once complete so that a partial file is never picked up
+		bIsDownloaded = bIsDownloaded &&
+			IFileManager::Get().Move(*Tool.CachePath, *PartialPath, true) &&
+			StoreInCache(Tool.CachePath, Tool.CachePath) &&
+			InstallFromCache(Tool);
+
+		IFileManager::Get().Delete(*PartialPath, false, false, true);
+
+		Lock.Unlock();
+
+		CompleteDownload(State, bIsDownloaded);
+	});
+
+	Request->SetURL(Tool.Url);
+	Request->SetVerb(TEXT("GET"));
+
+	Request->ProcessRequest();
+}
+
+void FSentrySymToolsDownloader::CompleteDownload(const TSharedRef<FDownloadState>& State, bool bIsSucceeded)
+{
+	State->bIsFailed |= !bIsSucceeded;
+
+	if (--State->NumPending > 0)
+	{
+		return;
+	}
+
+	State->OnCompleted(!State->bIsFailed && GetStatus() == ESentrySymToolsStatus::Configured);
+}
+
+FSentrySymToolsDownloader::FSymTool FSentrySymToolsDownloader::GetSentryCliTool() const
+{
+	const FString SentryCliVersion = GetSentryCliVersion();
 
-		FFileHelper::SaveArrayToFile(Response->GetContent(), *SavePath);
+	FSymTool Tool;
+	Tool.InstallPath = GetSentryCliPath();
+	Tool.CachePath = FPaths::Combine(GetCacheDir(), TEXT("sentry-cli"), SentryCliVersion, SentryCliExecName);
+	Tool.Url = FString::Printf(TEXT("https://github.com/getsentry/sentry-cli/releases/download/%s/%s"), *SentryCliVersion, *SentryCliExecName);
+	return Tool;
+}
+
+FSentrySymToolsDownloader::FSymTool FSentrySymToolsDownloader::GetSymUploadScriptTool() const
+{
+	const FString PluginVersion = FSentryModule::Get().GetPluginVersion();
+
+	FSymTool Tool;
+	Tool.InstallPath = GetSymUploadScriptPath();
+	Tool.CachePath = FPaths::Combine(GetCacheDir(), TEXT("scripts"), PluginVersion, SentrySymUploadScriptName);
+	Tool.Url = FString::Printf(TEXT("https://raw.githubusercontent.com/getsentry/sentry-unreal/refs/tags/%s/plugin-dev/Scripts/%s"), *PluginVersion, *SentrySymUploadScriptName);
+	return Tool;
+}
+
+bool FSentrySymToolsDownloader::InstallFromCache(const FSymTool& Tool) const
+{
+	if (!IsCached(Tool.CachePath))
+	{
+		return false;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Tool.InstallPath), true);
+
+	if (IFileManager::Get().Copy(*Tool.InstallPath, *Tool.CachePath, true) != COPY_OK)
+	{
+		return false;
+	}
 
 #if PLATFORM_LINUX || PLATFORM_MAC
-		if (!SetExecutePermission(SavePath))
-		{
-			OnCompleted(false);
-			return;
-		}
+	if (!SetExecutePermission(Tool.InstallPath))
+	{
+		return false;
+	}
 #endif
 
-		if (GetStatus() == ESentrySymToolsStatus::Configured)
+	return true;
+}
+
+bool FSentrySymToolsDownloader::StoreInCache(const FString& FilePath, const FString& CachePath) const
+{
+	if (FilePath != CachePath)
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(CachePath), true);
+
+		if (IFileManager::Get().Copy(*CachePath, *FilePath, true) != COPY_OK)
 		{
-			OnCompleted(true);
+			return false;
 		}
-	});
+	}
 
-	Request->SetURL(Url);
-	Request->SetVerb(TEXT("GET"));
+	const FString Checksum = GetFileChecksum(CachePath);
+	return !Checksum.IsEmpty() && FFileHelper::SaveStringToFile(Checksum, *(CachePath + TEXT(".sha1")));
+}
 
-	Request->ProcessRequest();
+bool FSentrySymToolsDownloader::IsCached(const FString& CachePath) const
+{
+	FString ExpectedChecksum;
+	if (!FFileHelper::LoadFileToString(ExpectedChecksum, *(CachePath + TEXT(".sha1"))))
+	{
+		return false;
+	}
+
+	// Entries damaged by an interrupted copy or modified by other tools are ignored and replaced with a new download
+	return ExpectedChecksum.TrimStartAndEnd() == GetFileChecksum(CachePath);
+}
+
+FString FSentrySymToolsDownloader::GetFileChecksum(const FString& FilePath) const
+{
+	TArray<uint8> FileContents;
+	if (!FFileHelper::LoadFileToArray(FileContents, *FilePath, FILEREAD_Silent))
+	{
+		return FString();
+	}
+
+	uint8 Hash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(FileContents.GetData(), FileContents.Num(), Hash);
+
+	return BytesToHex(Hash, FSHA1::DigestSize);
+}
+
+FString FSentrySymToolsDownloader::GetCacheDir() const
+{
+	return FPaths::Combine(FPlatformProcess::UserSettingsDir(), TEXT("Sentry"), TEXT("SymTools"));
 }
 
 FString FSentrySymToolsDownloader::GetSentryCliPath() const
@@ -42,7 +42,7 @@ private:
 	void SetPropertiesUpdateHandler(IDetailLayoutBuilder& DetailBuilder);
 
 	TSharedRef<SWidget> MakeGeneralSettingsStatusRow(FName IconName, FText Message, FText ButtonMessage);
-	TSharedRef<SWidget> MakeLinuxBinariesStatusRow(FName IconName, FText Message, FText ButtonMessage);
+	TSharedRef<SWidget> MakeLinuxBinariesStatusRow(FName IconName, TAttribute<FText> Message, FText ButtonMessage);
 	TSharedRef<SWidget> MakeSentryCliStatusRow(FName IconName, FText Message, FText ButtonMessage);
 
 	void UpdateProjectName();
@@ -56,6 +56,14 @@ private:
 	FString GetCrcConfigPath() const;
 	// Gets path to plugin's Linux pre-compiled binaries directory
 	FString GetLinuxBinariesDirPath() const;
+	// Gets path to per-user cache of Linux binaries compiled for the current plugin and engine versions
+	FString GetLinuxBinariesCachePath() const;
+
+	// Copies cached Linux binaries into the plugin directory, false if there are none
+	bool RestoreLinuxBinariesFromCache() const;
+	void StoreLinuxBinariesInCache(const FString& BinariesPath) const;
+
+	FText GetLinuxBinariesCompilingMessage() const;
 
 	int32 GetGeneralSettingsStatusAsInt() const;
 	int32 GetLinuxBinariesStatusAsInt() const;
@@ -70,4 +78,5 @@ private:
 	static const FString DefaultCrcEndpoint;
 
 	bool IsCompilingLinuxBinaries;
+	double LinuxBinariesCompileStartTime;
 };
@@ -13,15 +13,48 @@ enum class ESentrySymToolsStatus : uint8
 	Configured
 };
 
+/**
+ * Downloads sentry-cli and the symbol upload script into the plugin directory.
+ *
+ * Downloaded tools are kept in a per-user cache shared by all projects and engine installs, keyed by the sentry-cli
+ * and plugin versions, along with their checksums. Tools found in the cache are installed without network access.
+ */
 class FSentrySymToolsDownloader
 {
 public:
 	void Download(const TFunction<void(bool)>& OnCompleted);
 
+	/** Installs missing tools from the cache and adds installed tools missing from the cache to it, without network access. */
+	void SyncWithCache();
+
 	ESentrySymToolsStatus GetStatus();
 
 private:
-	void Download(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& Request, const FString& Url, const FString& SavePath, const TFunction<void(bool)>& OnCompleted);
+	struct FSymTool
+	{
+		FString InstallPath;
+		FString CachePath;
+		FString Url;
+	};
+
+	struct FDownloadState
+	{
+		int32 NumPending = 0;
+		bool bIsFailed = false;
+		TFunction<void(bool)> OnCompleted;
+	};
+
+	void Download(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& Request, const FSymTool& Tool, const TSharedRef<FDownloadState>& State);
+	void CompleteDownload(const TSharedRef<FDownloadState>& State, bool bIsSucceeded);
+
+	FSymTool GetSentryCliTool() const;
+	FSymTool GetSymUploadScriptTool() const;
+
+	bool InstallFromCache(const FSymTool& Tool) const;
+	bool StoreInCache(const FString& FilePath, const FString& CachePath) const;
+	bool IsCached(const FString& CachePath) const;
+	FString GetFileChecksum(const FString& FilePath) const;
+	FString GetCacheDir() const;
 
 	FString GetSentryCliPath() const;
 	FString GetSentryCliVersion() const;
@@ -33,6 +66,9 @@ private:
 	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SentryCliDownloadRequest;
 	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SentryScriptDownloadRequest;
 
+	/** Serializes cache and install directory updates, the startup sync runs in the background while a download may be started. */
+	static FCriticalSection CacheCriticalSection;
+
 	const static FString SentryCliExecName;
 	const static FString SentrySymUploadScriptName;
 };
@@ -0,0 +1,360 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "AppleSentryVideoToolboxEncoder.h"
+
+#include "SentryDefines.h"
+
+#include "DynamicRHI.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#import <AVFoundation/AVFoundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
+#import <MetalPerformanceShaders/MetalPerformanceShaders.h>
+#import <VideoToolbox/VideoToolbox.h>
+
+namespace SentryAppleVideoToolboxEncoder
+{
+	static constexpr uint32 StopTimeoutMs = 2000;
+
+	static bool IsKeyFrame(CMSampleBufferRef Sample)
+	{
+		CFArrayRef Attachments = CMSampleBufferGetSampleAttachmentsArray(Sample, false);
+		if (!Attachments || CFArrayGetCount(Attachments) == 0)
+		{
+			return true;
+		}
+
+		CFDictionaryRef Attachment = static_cast<CFDictionaryRef>(CFArrayGetValueAtIndex(Attachments, 0));
+		return !CFDictionaryContainsKey(Attachment, kCMSampleAttachmentKey_NotSync);
+	}
+}
+
+FAppleSentryVideoToolboxEncoder::FAppleSentryVideoToolboxEncoder()
+{
+	FramesSubmittedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FAppleSentryVideoToolboxEncoder::~FAppleSentryVideoToolboxEncoder()
+{
+	Stop();
+
+	FPlatformProcess::ReturnSynchEventToPool(FramesSubmittedEvent);
+	FramesSubmittedEvent = nullptr;
+}
+
+bool FAppleSentryVideoToolboxEncoder::Start(const FString& Directory, int32 InWidth, int32 InHeight, int32 FramesPerSecond, int32 Bitrate, float InSegmentDurationSeconds, int32 FirstSegmentIndex)
+{
+	Stop();
+
+	id<MTLDevice> Device = GDynamicRHI ? (id<MTLDevice>)GDynamicRHI->RHIGetNativeDevice() : nil;
+	if (!Device || !MPSSupportsMTLDevice(Device))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Metal device doesn't support scaling frames for the video encoder."));
+		return false;
+	}
+
+	SegmentsDirectory = Directory;
+	Width = InWidth;
+	Height = InHeight;
+	SegmentDurationSeconds = InSegmentDurationSeconds;
+	LastForcedKeyFrameNs = 0;
+	bHasFailed = false;
+
+	if (FirstSegmentIndex >= 0)
+	{
+		FScopeLock Lock(&WriterLock);
+		NextSegmentIndex = FirstSegmentIndex;
+	}
+
+	@autoreleasepool
+	{
+		// Pool buffers are backed by IOSurfaces, which Metal writes into and the encoder reads from without copies
+		NSDictionary* SourceAttributes = @{
+			(NSString*)kCVPixelBufferPixelFormatTypeKey : @(kCVPixelFormatType_32BGRA),
+			(NSString*)kCVPixelBufferWidthKey : @(Width),
+			(NSString*)kCVPixelBufferHeightKey : @(Height),
+			(NSString*)kCVPixelBufferIOSurfacePropertiesKey : @{},
+			(NSString*)kCVPixelBufferMetalCompatibilityKey : @YES
+		};
+
+#if PLATFORM_MAC
+		NSDictionary* EncoderSpecification = @{ (NSString*)kVTVideoEncoderSpecification_RequireHardwareAcceleratedVideoEncoder : @YES };
+#else
+		// Encoding is always hardware accelerated on iOS
+		NSDictionary* EncoderSpecification = nil;
+#endif
+
+		VTCompressionOutputCallback OnFrameEncoded = [](void* RefCon, void* SourceFrameRefCon, OSStatus Status, VTEncodeInfoFlags InfoFlags, CMSampleBufferRef Sample)
+		{
+			if (Status == noErr && Sample && (InfoFlags & kVTEncodeInfo_FrameDropped) == 0)
+			{
+				static_cast<FAppleSentryVideoToolboxEncoder*>(RefCon)->WriteSample(Sample);
+			}
+		};
+
+		VTCompressionSessionRef NewSession = nullptr;
+		const OSStatus Status = VTCompressionSessionCreate(kCFAllocatorDefault, Width, Height, kCMVideoCodecType_H264,
+			(CFDictionaryRef)EncoderSpecification, (CFDictionaryRef)SourceAttributes, kCFAllocatorDefault, OnFrameEncoded, this, &NewSession);
+
+		if (Status != noErr || !NewSession)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to create hardware video encoder session (error %d)."), static_cast<int32>(Status));
+			return false;
+		}
+
+		VTSessionSetProperty(NewSession, kVTCompressionPropertyKey_RealTime, kCFBooleanTrue);
+		VTSessionSetProperty(NewSession, kVTCompressionPropertyKey_ProfileLevel, kVTProfileLevel_H264_Main_AutoLevel);
+		// Without B-frames samples arrive in presentation order, which keeps segment cuts simple
+		VTSessionSetProperty(NewSession, kVTCompressionPropertyKey_AllowFrameReordering, kCFBooleanFalse);
+		VTSessionSetProperty(NewSession, kVTCompressionPropertyKey_AverageBitRate, (CFNumberRef)@(Bitrate));
+		VTSessionSetProperty(NewSession, kVTCompressionPropertyKey_ExpectedFrameRate, (CFNumberRef)@(FramesPerSecond));
+		VTSessionSetProperty(NewSession, kVTCompressionPropertyKey_MaxKeyFrameIntervalDuration, (CFNumberRef)@(SegmentDurationSeconds));
+		VTCompressionSessionPrepareToEncodeFrames(NewSession);
+
+		CVMetalTextureCacheRef NewTextureCache = nullptr;
+		if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nullptr, Device, nullptr, &NewTextureCache) != kCVReturnSuccess)
+		{
+			VTCompressionSessionInvalidate(NewSession);
+			CFRelease(NewSession);
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to create Metal texture cache for the video encoder."));
+			return false;
+		}
+
+		// Work committed to the queue of the RHI runs after the frame it was scheduled from, so the back buffer is complete
+		id<MTLCommandQueue> Queue = (id<MTLCommandQueue>)GDynamicRHI->RHIGetNativeGraphicsQueue();
+		CommandQueue = Queue ? [Queue retain] : [Device newCommandQueue];
+
+		Session = NewSession;
+		TextureCache = NewTextureCache;
+		Scaler = [[MPSImageBilinearScale alloc] initWithDevice:Device];
+	}
+
+	return true;
+}
+
+void FAppleSentryVideoToolboxEncoder::Stop()
+{
+	if (!Session)
+	{
+		return;
+	}
+
+	// Frames still on the GPU keep their own reference to the session, but are awaited so that they end up in the last segment
+	// Event may still be signaled from an earlier drain, hence the count is checked again after every wake up
+	const double WaitEndTime = FPlatformTime::Seconds() + SentryAppleVideoToolboxEncoder::StopTimeoutMs / 1000.0;
+	while (NumPendingFrames > 0)
+	{
+		const double RemainingSeconds = WaitEndTime - FPlatformTime::Seconds();
+		if (RemainingSeconds <= 0.0 || !FramesSubmittedEvent->Wait(FMath::CeilToInt(RemainingSeconds * 1000.0)))
+		{
+			break;
+		}
+	}
+
+	VTCompressionSessionRef StoppedSession = static_cast<VTCompressionSessionRef>(Session);
+	Session = nullptr;
+
+	VTCompressionSessionCompleteFrames(StoppedSession, kCMTimeInvalid);
+	VTCompressionSessionInvalidate(StoppedSession);
+	CFRelease(StoppedSession);
+
+	{
+		FScopeLock Lock(&WriterLock);
+		FinishSegment();
+	}
+
+	CVMetalTextureCacheRef StoppedTextureCache = static_cast<CVMetalTextureCacheRef>(TextureCache);
+	CVMetalTextureCacheFlush(StoppedTextureCache, 0);
+	CFRelease(StoppedTextureCache);
+	TextureCache = nullptr;
+
+	[(id<MTLCommandQueue>)CommandQueue release];
+	CommandQueue = nullptr;
+
+	[(MPSImageBilinearScale*)Scaler release];
+	Scaler = nullptr;
+}
+
+void FAppleSentryVideoToolboxEncoder::EncodeFrame(void* Texture, int64 PresentationTimeNs)
+{
+	if (!Session || !Texture || bHasFailed)
+	{
+		return;
+	}
+
+	@autoreleasepool
+	{
+		VTCompressionSessionRef EncoderSession = static_cast<VTCompressionSessionRef>(Session);
+
+		CVPixelBufferRef PixelBuffer = nullptr;
+		if (CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, VTCompressionSessionGetPixelBufferPool(EncoderSession), &PixelBuffer) != kCVReturnSuccess)
+		{
+			// Pool is exhausted while the encoder is behind, the frame is dropped
+			return;
+		}
+
+		CVMetalTextureRef TargetTexture = nullptr;
+		if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, static_cast<CVMetalTextureCacheRef>(TextureCache), PixelBuffer, nullptr,
+				MTLPixelFormatBGRA8Unorm, Width, Height, 0, &TargetTexture) != kCVReturnSuccess)
+		{
+			CVPixelBufferRelease(PixelBuffer);
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to share the video encoder pixel buffer with Metal, zero-copy crash video recording is disabled."));
+			bHasFailed = true;
+			return;
+		}
+
+		id<MTLCommandBuffer> CommandBuffer = [(id<MTLCommandQueue>)CommandQueue commandBuffer];
+
+		// Scaling writes straight into the IOSurface of the pixel buffer, the encoder converts it to YUV in hardware
+		[(MPSImageBilinearScale*)Scaler encodeToCommandBuffer:CommandBuffer sourceTexture:(id<MTLTexture>)Texture destinationTexture:CVMetalTextureGetTexture(TargetTexture)];
+
+		// Keyframes are forced at segment boundaries so that every segment can be cut right on time
+		const bool bForceKeyFrame = PresentationTimeNs - LastForcedKeyFrameNs >= static_cast<int64>(SegmentDurationSeconds * 1e9);
+		if (bForceKeyFrame)
+		{
+			LastForcedKeyFrameNs = PresentationTimeNs;
+		}
+
+		++NumPendingFrames;
+		CFRetain(EncoderSession);
+
+		[CommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> CompletedBuffer)
+		{
+			if (CompletedBuffer.status == MTLCommandBufferStatusCompleted)
+			{
+				NSDictionary* FrameProperties = bForceKeyFrame ? @{ (NSString*)kVTEncodeFrameOptionKey_ForceKeyFrame : @YES } : nil;
+
+				VTCompressionSessionEncodeFrame(EncoderSession, PixelBuffer, CMTimeMake(PresentationTimeNs, 1000000000), kCMTimeInvalid,
+					(CFDictionaryRef)FrameProperties, nullptr, nullptr);
+			}
+
+			CFRelease(TargetTexture);
+			CVPixelBufferRelease(PixelBuffer);
+			CFRelease(EncoderSession);
+
+			if (--NumPendingFrames == 0)
+			{
+				FramesSubmittedEvent->Trigger();
+			}
+		}];
+
+		[CommandBuffer commit];
+	}
+}
+
+TArray<FString> FAppleSentryVideoToolboxEncoder::TakeFinishedSegments()
+{
+	TArray<FString> Segments;
+
+	FString Segment;
+	while (FinishedSegments.Dequeue(Segment))
+	{
+		Segments.Add(Segment);
+	}
+
+	return Segments;
+}
+
+void FAppleSentryVideoToolboxEncoder::WriteSample(void* SampleBuffer)
+{
+	CMSampleBufferRef Sample = static_cast<CMSampleBufferRef>(SampleBuffer);
+
+	const bool bIsKeyFrame = SentryAppleVideoToolboxEncoder::IsKeyFrame(Sample);
+	const CMTime PresentationTime = CMSampleBufferGetPresentationTimeStamp(Sample);
+
+	FScopeLock Lock(&WriterLock);
+
+	@autoreleasepool
+	{
+		if (Writer && bIsKeyFrame && CMTimeGetSeconds(PresentationTime) - SegmentStartSeconds >= SegmentDurationSeconds)
+		{
+			FinishSegment();
+		}
+
+		if (!Writer)
+		{
+			// Every segment has to start with a keyframe to be playable on its own
+			if (!bIsKeyFrame)
+			{
+				return;
+			}
+
+			SegmentPath = FPaths::Combine(SegmentsDirectory, FString::Printf(TEXT("crash_video_segment_%04d.mp4"), NextSegmentIndex++));
+
+			NSError* Error = nil;
+			AVAssetWriter* NewWriter = [[AVAssetWriter alloc] initWithURL:[NSURL fileURLWithPath:SegmentPath.GetNSString()] fileType:AVFileTypeMPEG4 error:&Error];
+			if (!NewWriter)
+			{
+				UE_LOG(LogSentrySdk, Warning, TEXT("Failed to create crash video segment writer: %s"), *FString(Error.localizedDescription));
+				return;
+			}
+
+			// Samples are already encoded so they're passed through as they are
+			AVAssetWriterInput* NewInput = [[AVAssetWriterInput alloc] initWithMediaType:AVMediaTypeVideo outputSettings:nil sourceFormatHint:CMSampleBufferGetFormatDescription(Sample)];
+			NewInput.expectsMediaDataInRealTime = YES;
+
+			// Segment being written when the game crashes is never finalized, fragments keep it playable up to the last one
+			NewWriter.movieFragmentInterval = CMTimeMake(1, 1);
+
+			[NewWriter addInput:NewInput];
+
+			if (![NewWriter startWriting])
+			{
+				UE_LOG(LogSentrySdk, Warning, TEXT("Failed to start crash video segment writer: %s"), *FString(NewWriter.error.localizedDescription));
+				[NewInput release];
+				[NewWriter release];
+				return;
+			}
+
+			[NewWriter startSessionAtSourceTime:PresentationTime];
+
+			Writer = NewWriter;
+			WriterInput = NewInput;
+			SegmentStartSeconds = CMTimeGetSeconds(PresentationTime);
+		}
+
+		AVAssetWriterInput* Input = (AVAssetWriterInput*)WriterInput;
+		if (Input.readyForMoreMediaData)
+		{
+			[Input appendSampleBuffer:Sample];
+		}
+	}
+}
+
+void FAppleSentryVideoToolboxEncoder::FinishSegment()
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	AVAssetWriter* FinishingWriter = (AVAssetWriter*)Writer;
+	AVAssetWriterInput* FinishingInput = (AVAssetWriterInput*)WriterInput;
+	const FString FinishingPath = SegmentPath;
+
+	Writer = nullptr;
+	WriterInput = nullptr;
+
+	[FinishingInput markAsFinished];
+
+	[FinishingWriter finishWritingWithCompletionHandler:^
+	{
+		if (FinishingWriter.status == AVAssetWriterStatusCompleted)
+		{
+			FinishedSegments.Enqueue(FinishingPath);
+		}
+		else
+		{
+			IFileManager::Get().Delete(*FinishingPath);
+		}
+
+		[FinishingInput release];
+		[FinishingWriter release];
+	}];
+}
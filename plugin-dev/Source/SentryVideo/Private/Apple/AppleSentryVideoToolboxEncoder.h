@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+
+class FEvent;
+
+/**
+ * Hardware H.264 encoder fed with IOSurface backed pixel buffers, so that frames rendered by the game never touch the CPU.
+ *
+ * Frames are scaled on the GPU straight into pixel buffers of the VideoToolbox session pool, which are shared with Metal
+ * through the texture cache. Output is muxed into short MP4 segments, each starting with a keyframe, which are handed
+ * over once finalized.
+ */
+class FAppleSentryVideoToolboxEncoder
+{
+public:
+	FAppleSentryVideoToolboxEncoder();
+	~FAppleSentryVideoToolboxEncoder();
+
+	/**
+	 * Starts encoding into segments written to the given directory.
+	 *
+	 * @param FirstSegmentIndex Index of the first segment file name, or -1 to continue the numbering of the previous recording.
+	 */
+	bool Start(const FString& Directory, int32 InWidth, int32 InHeight, int32 FramesPerSecond, int32 Bitrate, float InSegmentDurationSeconds, int32 FirstSegmentIndex);
+
+	/** Stops encoding, the segment being recorded is finalized in the background. */
+	void Stop();
+
+	/** Scales the Metal texture into a pixel buffer and encodes it once the GPU is done. Called on the RHI thread. */
+	void EncodeFrame(void* Texture, int64 PresentationTimeNs);
+
+	/** Gets segments finalized since the last call, ordered from the oldest to the newest. */
+	TArray<FString> TakeFinishedSegments();
+
+	bool HasFailed() const { return bHasFailed; }
+
+private:
+	/** Writes an encoded frame into the current segment. Called on the encoder callback thread. */
+	void WriteSample(void* SampleBuffer);
+
+	/** Finalizes the current segment, must be called with the writer lock held. */
+	void FinishSegment();
+
+	FString SegmentsDirectory;
+	int32 Width = 0;
+	int32 Height = 0;
+	float SegmentDurationSeconds = 0.0f;
+
+	// Apple handles are kept opaque so that the header doesn't depend on Objective-C
+	void* Session = nullptr;
+	void* TextureCache = nullptr;
+	void* CommandQueue = nullptr;
+	void* Scaler = nullptr;
+
+	// RHI thread state
+	int64 LastForcedKeyFrameNs = 0;
+	TAtomic<bool> bHasFailed { false };
+
+	/** Frames handed to the GPU which weren't submitted to the encoder yet. */
+	TAtomic<int32> NumPendingFrames { 0 };
+
+	/** Triggered once the last pending frame was submitted to the encoder. */
+	FEvent* FramesSubmittedEvent = nullptr;
+
+	// Encoder callback thread state
+	FCriticalSection WriterLock;
+	void* Writer = nullptr;
+	void* WriterInput = nullptr;
+	FString SegmentPath;
+	double SegmentStartSeconds = 0.0;
+	int32 NextSegmentIndex = 0;
+
+	TQueue<FString, EQueueMode::Mpsc> FinishedSegments;
+};
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "SentryCrashVideoAttachment.h"
+#include "SentryCrashVideoHandler.h"
+#include "SentryDefines.h"
+#include "SentryModule.h"
+#include "SentrySettings.h"
+#include "Utils/SentryCrashVideoPresets.h"
+
+#include "Containers/Ticker.h"
+#include "DeviceProfiles/DeviceProfileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/Paths.h"
+#include "Scalability.h"
+
+namespace SentryCrashVideoPresetTicker
+{
+	/** Delay before the preset is re-evaluated when the recorder was busy as the scalability settings changed. */
+	static constexpr float RetryInterval = 1.0f;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	static FTicker& Get() { return FTicker::GetCoreTicker(); }
+#else
+	static FTSTicker& Get() { return FTSTicker::GetCoreTicker(); }
+#endif
+}
+
+void USentryCrashVideoAttachment::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	VideoHandler = NewObject<USentryCrashVideoHandler>(this);
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	UE_LOG(LogSentrySdk, Warning, TEXT("Sentry Crash Video Attachment: RuntimeVideoRecorder plugin not found. Video crash recording will not be available."));
+#else
+	UE_LOG(LogSentrySdk, Log, TEXT("Sentry Crash Video Attachment subsystem initialized."));
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	if (Settings && Settings->AttachCrashVideo && Settings->AutoStartCrashVideoRecording && !GIsEditor)
+	{
+		// Game viewport the recorder captures is created after engine subsystems are initialized
+		FCoreDelegates::OnPostEngineInit.AddWeakLambda(this, [this]()
+		{
+			EnableCrashVideoRecordingWithPreset();
+		});
+	}
+#endif
+}
+
+void USentryCrashVideoAttachment::Deinitialize()
+{
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	StopPresetTracking();
+
+	DisableCrashVideoRecording();
+
+	VideoHandler = nullptr;
+
+	Super::Deinitialize();
+}
+
+void USentryCrashVideoAttachment::EnableCrashVideoRecording(
+	float LastSecondsToRecord,
+	int32 TargetFPS,
+	int32 Width,
+	int32 Height,
+	bool bRecordUI,
+	bool bEnableAudioRecording)
+{
+	if (!VideoHandler)
+	{
+		return;
+	}
+
+	FCrashVideoConfig Config;
+	Config.LastSecondsToRecord = LastSecondsToRecord;
+	Config.TargetFPS = TargetFPS;
+	Config.Width = Width;
+	Config.Height = Height;
+	Config.bRecordUI = bRecordUI;
+	Config.bEnableAudio = bEnableAudioRecording;
+
+	StopPresetTracking();
+
+	VideoHandler->StartContinuousRecording(Config);
+}
+
+bool USentryCrashVideoAttachment::EnableCrashVideoRecordingWithPreset()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	if (!VideoHandler || !Settings)
+	{
+		return false;
+	}
+
+	const int32 PresetIndex = SentryCrashVideoPresets::FindPreset(Settings->CrashVideoPresets,
+		SentryCrashVideoPresets::GetActiveDeviceProfiles(), SentryCrashVideoPresets::GetScalabilityLevel());
+
+	StartPresetTracking();
+
+	ActivePresetIndex = PresetIndex;
+
+	if (PresetIndex == INDEX_NONE)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("No crash video preset matches the device profile %s, crash video recording is not started."), *UDeviceProfileManager::Get().GetActiveDeviceProfileName());
+		return false;
+	}
+
+	const FCrashVideoPreset& Preset = Settings->CrashVideoPresets[PresetIndex];
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video preset %s selected."), *Preset.Name);
+
+	return VideoHandler->GetRecordingState() == ECrashVideoRecordingState::Idle
+		? VideoHandler->StartContinuousRecording(Preset.Config)
+		: VideoHandler->UpdateRecordingConfig(Preset.Config);
+}
+
+FString USentryCrashVideoAttachment::GetActiveCrashVideoPreset() const
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	if (!bIsPresetTracked || !Settings || !Settings->CrashVideoPresets.IsValidIndex(ActivePresetIndex))
+	{
+		return FString();
+	}
+
+	return Settings->CrashVideoPresets[ActivePresetIndex].Name;
+}
+
+void USentryCrashVideoAttachment::UpdateCrashVideoPreset()
+{
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	if (!VideoHandler || !Settings)
+	{
+		return;
+	}
+
+	const ECrashVideoRecordingState State = VideoHandler->GetRecordingState();
+	if (State == ECrashVideoRecordingState::Finalizing || State == ECrashVideoRecordingState::WaitingForPreviousRecording)
+	{
+		SchedulePresetUpdateRetry();
+		return;
+	}
+
+	if (State == ECrashVideoRecordingState::Idle && ActivePresetIndex != INDEX_NONE)
+	{
+		// Recording was stopped via the handler, it's not restarted behind the caller's back
+		StopPresetTracking();
+		return;
+	}
+
+	const int32 PresetIndex = SentryCrashVideoPresets::FindPreset(Settings->CrashVideoPresets,
+		SentryCrashVideoPresets::GetActiveDeviceProfiles(), SentryCrashVideoPresets::GetScalabilityLevel());
+
+	if (PresetIndex == ActivePresetIndex)
+	{
+		return;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Scalability settings changed, switching crash video preset from %s to %s."),
+		Settings->CrashVideoPresets.IsValidIndex(ActivePresetIndex) ? *Settings->CrashVideoPresets[ActivePresetIndex].Name : TEXT("none"),
+		PresetIndex != INDEX_NONE ? *Settings->CrashVideoPresets[PresetIndex].Name : TEXT("none"));
+
+	ActivePresetIndex = PresetIndex;
+
+	if (PresetIndex == INDEX_NONE)
+	{
+		VideoHandler->StopContinuousRecording();
+	}
+	else if (State == ECrashVideoRecordingState::Idle)
+	{
+		VideoHandler->StartContinuousRecording(Settings->CrashVideoPresets[PresetIndex].Config);
+	}
+	else
+	{
+		VideoHandler->UpdateRecordingConfig(Settings->CrashVideoPresets[PresetIndex].Config);
+	}
+}
+
+void USentryCrashVideoAttachment::StartPresetTracking()
+{
+	bIsPresetTracked = true;
+
+	if (!ScalabilityChangedDelegate.IsValid())
+	{
+		ScalabilityChangedDelegate = Scalability::OnScalabilitySettingsChanged.AddWeakLambda(this, [this](const Scalability::FQualityLevels& QualityLevels)
+		{
+			UpdateCrashVideoPreset();
+		});
+	}
+}
+
+void USentryCrashVideoAttachment::StopPresetTracking()
+{
+	bIsPresetTracked = false;
+	ActivePresetIndex = INDEX_NONE;
+
+	if (ScalabilityChangedDelegate.IsValid())
+	{
+		Scalability::OnScalabilitySettingsChanged.Remove(ScalabilityChangedDelegate);
+		ScalabilityChangedDelegate.Reset();
+	}
+}
+
+void USentryCrashVideoAttachment::SchedulePresetUpdateRetry()
+{
+	if (bIsPresetUpdateRetryScheduled)
+	{
+		return;
+	}
+
+	bIsPresetUpdateRetryScheduled = true;
+
+	TWeakObjectPtr<USentryCrashVideoAttachment> WeakThis(this);
+
+	SentryCrashVideoPresetTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float DeltaTime)
+	{
+		USentryCrashVideoAttachment* CrashVideoAttachment = WeakThis.Get();
+		if (!CrashVideoAttachment)
+		{
+			return false;
+		}
+
+		CrashVideoAttachment->bIsPresetUpdateRetryScheduled = false;
+
+		if (CrashVideoAttachment->bIsPresetTracked)
+		{
+			CrashVideoAttachment->UpdateCrashVideoPreset();
+		}
+
+		return false;
+	}), SentryCrashVideoPresetTicker::RetryInterval);
+}
+
+void USentryCrashVideoAttachment::DisableCrashVideoRecording()
+{
+	StopPresetTracking();
+
+	if (VideoHandler && VideoHandler->GetRecordingState() != ECrashVideoRecordingState::Idle)
+	{
+		VideoHandler->StopContinuousRecording();
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording disabled."));
+	}
+}
+
+bool USentryCrashVideoAttachment::IsCrashVideoRecordingEnabled() const
+{
+	return VideoHandler && VideoHandler->IsRecording();
+}
+
+FString USentryCrashVideoAttachment::GetCrashVideoDirectory() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"));
+}
@@ -0,0 +1,2485 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "SentryCrashVideoHandler.h"
+#include "SentrySubsystem.h"
+#include "SentryAttachment.h"
+#include "SentryBreadcrumbMacros.h"
+#include "SentryDefines.h"
+#include "SentryEventView.h"
+#include "SentryLibrary.h"
+#include "SentryModule.h"
+#include "SentryScope.h"
+#include "SentrySettings.h"
+
+#include "Utils/SentryCrashAudioRing.h"
+#include "Utils/SentryCrashVideoFrameStrip.h"
+#include "Utils/SentryCrashVideoGovernor.h"
+#include "Utils/SentryCrashVideoRawRing.h"
+#include "Utils/SentryCrashVideoRetention.h"
+#include "Utils/SentryCrashVideoSegments.h"
+#include "Utils/SentryCrashVideoSurfaceEncoder.h"
+#include "Utils/SentryCrashVideoTimeline.h"
+#include "Utils/SentryCrashVideoTrimmer.h"
+#include "Utils/SentryPieClients.h"
+#include "Utils/SentryDeviceConditions.h"
+#include "Utils/SentryMemoryAccounting.h"
+#include "Utils/SentryRedactedWidgets.h"
+#include "Utils/SentryStats.h"
+#include "Utils/SentryThreadUtils.h"
+#include "Utils/SentryVideoRecorderUtils.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/FileHelper.h"
+#include "Misc/EngineVersionComparison.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Ticker.h"
+#include "Stats/Stats.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <mfapi.h>
+#include <mftransform.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+#include "RuntimeVideoRecorder.h"
+#include "RuntimeEncoderSettings.h"
+#else
+#pragma message("Warning: RuntimeVideoRecorder is not available. Video crash recording will be disabled.")
+#endif
+
+DECLARE_STATS_GROUP(TEXT("SentryCrashVideo"), STATGROUP_SentryCrashVideo, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Recorder Restarts"), STAT_SentryCrashVideoRestarts, STATGROUP_SentryCrashVideo);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dropped Frames (Estimated)"), STAT_SentryCrashVideoDroppedFrames, STATGROUP_SentryCrashVideo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Restart Latency (ms)"), STAT_SentryCrashVideoRestartLatency, STATGROUP_SentryCrashVideo);
+
+namespace SentryHardwareEncoder
+{
+#if PLATFORM_WINDOWS
+	/** Checks whether Media Foundation, which the recorder encodes through, has a hardware H.264 encoder registered. */
+	static bool IsAvailable()
+	{
+		MFT_REGISTER_TYPE_INFO OutputType = { MFMediaType_Video, MFVideoFormat_H264 };
+
+		IMFActivate** Activates = nullptr;
+		UINT32 NumActivates = 0;
+
+		if (FAILED(MFTEnumEx(MFT_CATEGORY_VIDEO_ENCODER, MFT_ENUM_FLAG_HARDWARE | MFT_ENUM_FLAG_SORTANDFILTER, nullptr, &OutputType, &Activates, &NumActivates)))
+		{
+			return false;
+		}
+
+		for (UINT32 Index = 0; Index < NumActivates; ++Index)
+		{
+			Activates[Index]->Release();
+		}
+		CoTaskMemFree(Activates);
+
+		return NumActivates > 0;
+	}
+#elif PLATFORM_LINUX
+	/** Checks whether the vendor's encoding library can be loaded, the GPU alone doesn't mean the driver ships one. */
+	static bool IsAvailable()
+	{
+		auto CanLoad = [](const TCHAR* Library)
+		{
+			void* Handle = FPlatformProcess::GetDllHandle(Library);
+			if (!Handle)
+			{
+				return false;
+			}
+
+			FPlatformProcess::FreeDllHandle(Handle);
+			return true;
+		};
+
+		if (IsRHIDeviceNVIDIA())
+		{
+			return CanLoad(TEXT("libnvidia-encode.so.1"));
+		}
+
+		// AMD and Intel GPUs encode through VA-API which also needs a render node to open
+		return CanLoad(TEXT("libva.so.2")) && IFileManager::Get().FileExists(TEXT("/dev/dri/renderD128"));
+	}
+#endif
+}
+
+namespace SentryCrashVideoTicker
+{
+	/** Interval between checks of the video file state while waiting for the recorder to flush it. */
+	static constexpr float PollInterval = 0.1f;
+
+	/** Max time to wait for the recorder to flush the video file before giving up. */
+	static constexpr double FinalizeTimeout = 10.0;
+
+	/** Interval between adaptive quality evaluations. */
+	static constexpr float QualityEvaluationInterval = 3.0f;
+
+	/** Interval between checks of the local players layout. */
+	static constexpr float LayoutTrackingInterval = 1.0f;
+
+	/** Delay after which the encoder thread settings are applied again to the threads the recorder spawns with the first frames. */
+	static constexpr float EncoderThreadsSpawnDelay = 1.0f;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	static FTicker& Get() { return FTicker::GetCoreTicker(); }
+#else
+	static FTSTicker& Get() { return FTSTicker::GetCoreTicker(); }
+#endif
+}
+
+namespace SentryCrashVideoBookmarks
+{
+	/** Tag of events whose value names the bookmark to send the footage of. */
+	static const ANSICHAR* EventTag = "video_bookmark";
+
+	/** Copies the footage of a bookmark into its clip directory, returns the clip files including the segment index. */
+	static TArray<FString> CopyClip(const FString& ClipDirectory, const TArray<FString>& BookmarkSegments, const TArray<FString>& ReleasedSegments)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		PlatformFile.CreateDirectoryTree(*ClipDirectory);
+
+		TArray<FString> Files;
+		for (const FString& Segment : BookmarkSegments)
+		{
+			const FString ClipSegment = FPaths::Combine(ClipDirectory, FPaths::GetCleanFilename(Segment));
+
+			// Released segments aren't used by anything else anymore so they're moved, others may be evicted and fail to copy
+			const bool bIsReleased = ReleasedSegments.Contains(Segment);
+			if (bIsReleased ? PlatformFile.MoveFile(*ClipSegment, *Segment) : PlatformFile.CopyFile(*ClipSegment, *Segment))
+			{
+				Files.Add(ClipSegment);
+			}
+		}
+
+		for (const FString& Segment : ReleasedSegments)
+		{
+			PlatformFile.DeleteFile(*Segment);
+		}
+
+		const FString IndexPath = FPaths::Combine(ClipDirectory, TEXT("crash_video_segments.ffconcat"));
+		if (Files.Num() > 0 && FSentryCrashVideoSegments::WriteIndex(IndexPath, Files))
+		{
+			Files.Add(IndexPath);
+		}
+
+		return Files;
+	}
+}
+
+static int32 GetBitrateForConfig(const FCrashVideoConfig& Config)
+{
+	return FMath::Lerp(2000000, 10000000, Config.QualityPreset / 100.0f); // 2-10 Mbps
+}
+
+void USentryCrashVideoHandler::BeginDestroy()
+{
+	StopContinuousRecording();
+	Super::BeginDestroy();
+}
+
+bool USentryCrashVideoHandler::StartContinuousRecordingSimple(float LastSecondsToRecord)
+{
+	FCrashVideoConfig Config;
+	Config.LastSecondsToRecord = LastSecondsToRecord;
+	return StartContinuousRecording(Config);
+}
+
+bool USentryCrashVideoHandler::StartContinuousRecording(const FCrashVideoConfig& Config)
+{
+	// Check if already recording
+	if (RecordingState == ECrashVideoRecordingState::Recording || RecordingState == ECrashVideoRecordingState::Paused)
+	{
+		if (Config.bReuseActiveRecording)
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording is already active - keeping the existing buffer."));
+			return true;
+		}
+
+		UE_LOG(LogSentrySdk, Warning, TEXT("Crash video recording is already active."));
+		return false;
+	}
+
+	// Validate Sentry is initialized
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry subsystem is not initialized. Please initialize Sentry before enabling crash video recording."));
+		return false;
+	}
+
+	// Checked before any capture mode is started so that the pending start or finalization doesn't overwrite its state
+	if (RecordingState == ECrashVideoRecordingState::WaitingForPreviousRecording)
+	{
+		// Start is already scheduled - it will pick up the updated config
+		CurrentConfig = Config;
+		ClampConfig();
+		return true;
+	}
+
+	if (RecordingState == ECrashVideoRecordingState::Finalizing)
+	{
+		// Our own recording is still being flushed, start the new one once its file is finalized so that it isn't overwritten
+		CurrentConfig = Config;
+		ClampConfig();
+		ScheduleRecordingStart();
+		return true;
+	}
+
+	if (Config.bFrameStripOnly)
+	{
+		CurrentConfig = Config;
+		CurrentConfig.LastSecondsToRecord = FMath::Clamp(Config.LastSecondsToRecord, 5.0f, 600.0f);
+
+		FSentryFrameStripConfig FrameStripConfig;
+		FrameStripConfig.FrameWidth = CurrentConfig.FrameStripFrameSize.X;
+		FrameStripConfig.FrameHeight = CurrentConfig.FrameStripFrameSize.Y;
+		FrameStripConfig.FramesPerSecond = CurrentConfig.FrameStripFPS;
+		FrameStripConfig.MaxFrames = FMath::CeilToInt(CurrentConfig.LastSecondsToRecord * CurrentConfig.FrameStripFPS);
+
+		if (!FSentryCrashVideoFrameStrip::Get().Start(FrameStripConfig))
+		{
+			return false;
+		}
+
+		// Video recorder isn't involved so there's nothing to pause, restart or clean up
+		RecordingState = ECrashVideoRecordingState::Recording;
+		return true;
+	}
+
+	if (Config.bRawFrameRing)
+	{
+		CurrentConfig = Config;
+		CurrentConfig.LastSecondsToRecord = FMath::Clamp(Config.LastSecondsToRecord, 5.0f, 600.0f);
+
+		FSentryRawFrameRingConfig RawFrameRingConfig;
+		RawFrameRingConfig.FrameWidth = CurrentConfig.RawFrameRingFrameSize.X;
+		RawFrameRingConfig.FrameHeight = CurrentConfig.RawFrameRingFrameSize.Y;
+		RawFrameRingConfig.FramesPerSecond = CurrentConfig.RawFrameRingFPS;
+		RawFrameRingConfig.MaxFrames = FMath::CeilToInt(CurrentConfig.LastSecondsToRecord * CurrentConfig.RawFrameRingFPS);
+		RawFrameRingConfig.LongTierFrameWidth = CurrentConfig.RawFrameRingLongTierFrameSize.X;
+		RawFrameRingConfig.LongTierFrameHeight = CurrentConfig.RawFrameRingLongTierFrameSize.Y;
+		RawFrameRingConfig.LongTierFramesPerSecond = CurrentConfig.RawFrameRingLongTierFPS;
+		RawFrameRingConfig.LongTierMaxFrames = FMath::CeilToInt(FMath::Clamp(CurrentConfig.RawFrameRingLongTierSeconds, 0.0f, 600.0f) * CurrentConfig.RawFrameRingLongTierFPS);
+
+		if (!FSentryCrashVideoRawRing::Get().Start(FSentryCrashVideoRawRing::GetDefaultPath(), RawFrameRingConfig))
+		{
+			return false;
+		}
+
+		// Frames go straight to the mapped ring file, so like the frame strip there's no recorder to pause or restart
+		RecordingState = ECrashVideoRecordingState::Recording;
+
+		if (GIsEditor)
+		{
+			CapturedClientWindows.Reset();
+			UpdateCapturedClientWindows();
+
+			if (!bIsTrackingEditorClients)
+			{
+				ScheduleEditorClientTracking();
+			}
+		}
+
+		return true;
+	}
+
+	// Encoder surface carries video only, recording audio along needs the video recorder
+	if (Config.bUseZeroCopyEncoder && !Config.bEnableAudio && FSentryCrashVideoSurfaceEncoder::IsSupported())
+	{
+		CurrentConfig = Config;
+		ClampConfig();
+
+		return BeginSurfaceEncoderRecording();
+	}
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	UE_LOG(LogSentrySdk, Error, TEXT("RuntimeVideoRecorder plugin not found. Please add it to your project dependencies or use a capture mode that doesn't need it."));
+	UE_LOG(LogSentrySdk, Error, TEXT("1. Install RuntimeVideoRecorder from Fab/Marketplace"));
+	UE_LOG(LogSentrySdk, Error, TEXT("2. Add 'RuntimeVideoRecorder' to your module's Build.cs dependencies"));
+	return false;
+#else
+	// Get Runtime Video Recorder subsystem
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder)
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to get RuntimeVideoRecorder subsystem. Ensure the plugin is enabled."));
+		return false;
+	}
+
+	const FString HardwareEncoder = GetHardwareEncoderName();
+	if (HardwareEncoder.IsEmpty())
+	{
+		if (Config.bRequireHardwareEncoder)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("No hardware video encoder available - crash video recording is disabled as software encoding isn't allowed."));
+			return false;
+		}
+
+		UE_LOG(LogSentrySdk, Log, TEXT("No hardware video encoder available - crash video will be software encoded."));
+	}
+	else
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video is expected to use %s hardware encoder."), *HardwareEncoder);
+	}
+
+	// Validate and clamp config values
+	CurrentConfig = Config;
+	ClampConfig();
+
+	if (VideoRecorder->IsRecordingInProgress())
+	{
+		if (CurrentConfig.bReuseActiveRecording)
+		{
+			// Hand the running recording and its circular buffer over instead of tearing the encoder down
+			UE_LOG(LogSentrySdk, Log, TEXT("Another recording is in progress - reusing it for crash video recording."));
+			RecordingState = ECrashVideoRecordingState::Recording;
+			CurrentSessionVideoPath.Empty();
+			bIsBorrowedRecording = true;
+			return true;
+		}
+
+		UE_LOG(LogSentrySdk, Warning, TEXT("Another recording is in progress. Stopping it..."));
+		VideoRecorder->StopRecording_NativeAPI();
+
+		ScheduleRecordingStart();
+		return true;
+	}
+
+	return BeginRecording();
+
+#endif // HAS_RUNTIME_VIDEO_RECORDER
+}
+
+bool USentryCrashVideoHandler::BeginRecording()
+{
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	return false;
+#else
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder)
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to get RuntimeVideoRecorder subsystem. Ensure the plugin is enabled."));
+		RecordingState = ECrashVideoRecordingState::Idle;
+		return false;
+	}
+
+	// Create crash video directory
+	FString CrashVideoDir = GetCrashVideoDirectory();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*CrashVideoDir))
+	{
+		if (!PlatformFile.CreateDirectoryTree(*CrashVideoDir))
+		{
+			UE_LOG(LogSentrySdk, Error, TEXT("Failed to create crash video directory: %s"), *CrashVideoDir);
+			RecordingState = ECrashVideoRecordingState::Idle;
+			return false;
+		}
+	}
+
+	++RecordingGeneration;
+	bIsRestartingRecorder = false;
+	bIsBorrowedRecording = false;
+
+	RecordingStats = FCrashVideoRecordingStats();
+	SET_DWORD_STAT(STAT_SentryCrashVideoRestarts, 0);
+	SET_DWORD_STAT(STAT_SentryCrashVideoDroppedFrames, 0);
+	SET_FLOAT_STAT(STAT_SentryCrashVideoRestartLatency, 0.0f);
+
+	FitConfigToMemoryBudget();
+	ResetQualityGovernor();
+
+	const FSentryCrashVideoQuality BaseQuality = QualityGovernor->GetQuality();
+
+	FSentryCrashVideoTrimmer::Get().Configure(CurrentConfig.bTrimToLastSeconds ? CurrentConfig.LastSecondsToRecord : 0.0f);
+
+	if (CurrentConfig.bRecordFrameTimeline)
+	{
+		// Enough frames to cover the recorded duration at high frame rates
+		FSentryCrashVideoTimeline::Get().Start(FMath::CeilToInt(CurrentConfig.LastSecondsToRecord * 120.0f));
+	}
+
+	bool bSuccess = false;
+
+	if (CurrentConfig.bSegmentedRecording)
+	{
+		// Segments from previous sessions were already handed over to the crash reporter, bookmark clips may still be copied out
+		WaitForBookmarkCopies();
+		PlatformFile.DeleteDirectoryRecursively(*GetSegmentsDirectory());
+		PlatformFile.CreateDirectoryTree(*GetSegmentsDirectory());
+
+		// Keep enough finalized segments to cover the requested duration
+		FSentryCrashVideoSegments::Get().Configure(FMath::CeilToInt(CurrentConfig.LastSecondsToRecord / CurrentConfig.SegmentDurationSeconds));
+		FSentryCrashVideoSegments::Get().ConfigureBookmarks(CurrentConfig.BookmarkWindowSeconds, static_cast<int64>(CurrentConfig.MaxBookmarkDiskMB) * 1024 * 1024);
+
+		NextSegmentIndex = 0;
+		CurrentSessionVideoPath = GenerateSegmentFilename();
+
+		// Each segment is written as a regular video so the recorder's circular buffer isn't needed
+		bSuccess = StartRecorder(CurrentSessionVideoPath, 0.0f);
+	}
+	else
+	{
+		// Generate filename for this recording session
+		CurrentSessionVideoPath = GenerateVideoFilename();
+
+		bSuccess = StartRecorder(CurrentSessionVideoPath, CurrentConfig.LastSecondsToRecord);
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to start crash video recording. Check RuntimeVideoRecorder logs for details."));
+		FSentryCrashVideoTimeline::Get().Stop();
+		RecordingState = ECrashVideoRecordingState::Idle;
+		return false;
+	}
+
+	RecordingState = ECrashVideoRecordingState::Recording;
+	bCrashDetected = false;
+
+	SET_MEMORY_STAT(STAT_SentryVideoBufferMemory, GetEstimatedBufferMemory());
+	SentryMemoryAccounting::SetCrashVideoBytes(GetEstimatedBufferMemory());
+
+	if (CurrentConfig.bSegmentedRecording)
+	{
+		ScheduleSegmentRotation();
+	}
+
+	if (CurrentConfig.bAdaptiveQuality)
+	{
+		ScheduleQualityGovernor();
+	}
+
+	if (CurrentConfig.bTrackSplitScreenLayout)
+	{
+		LastSplitScreenLayout.Empty();
+		UpdateSplitScreenLayoutContext();
+		ScheduleSplitScreenLayoutTracking();
+	}
+
+	BindApplicationStateDelegates();
+
+	if (CurrentConfig.bRecordAudioRing && !CurrentConfig.bEnableAudio)
+	{
+		FSentryCrashAudioRing::Get().Start(CurrentConfig.LastSecondsToRecord);
+	}
+
+	// Segments are managed by the segment ring
+	if (!CurrentConfig.bSegmentedRecording)
+	{
+		CleanupOldVideos(CurrentSessionVideoPath);
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording enabled:"));
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Duration: %.1f seconds"), CurrentConfig.LastSecondsToRecord);
+	UE_LOG(LogSentrySdk, Log, TEXT("  - FPS: %d"), CurrentConfig.TargetFPS);
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Resolution: %dx%d"), BaseQuality.Width, BaseQuality.Height);
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Quality: %d/100"), CurrentConfig.QualityPreset);
+	UE_LOG(LogSentrySdk, Log, TEXT("  - UI Recording: %s"), CurrentConfig.bRecordUI ? TEXT("Yes") : TEXT("No"));
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Audio: %s"), CurrentConfig.bEnableAudio ? TEXT("Yes") : TEXT("No"));
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Estimated Buffer Memory: %.1f MB"), GetEstimatedBufferMemoryMB());
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Adaptive Quality: %s"), CurrentConfig.bAdaptiveQuality ? *FString::Printf(TEXT("Yes (%.2f ms budget)"), CurrentConfig.FrameTimeBudgetMs) : TEXT("No"));
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Segmented: %s"), CurrentConfig.bSegmentedRecording ? *FString::Printf(TEXT("Yes (%.1f seconds per segment)"), CurrentConfig.SegmentDurationSeconds) : TEXT("No"));
+	UE_LOG(LogSentrySdk, Log, TEXT("  - Save Path: %s"), *CurrentSessionVideoPath);
+
+	return true;
+#endif
+}
+
+bool USentryCrashVideoHandler::BeginSurfaceEncoderRecording()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Encoder writes segments on its own, from then on they're handled just like the ones of segmented recording
+	CurrentConfig.bSegmentedRecording = true;
+
+	WaitForBookmarkCopies();
+	PlatformFile.DeleteDirectoryRecursively(*GetSegmentsDirectory());
+	PlatformFile.CreateDirectoryTree(*GetSegmentsDirectory());
+
+	// Segment being encoded when the game crashes is lost along with it, shorter segments bound how much that is
+	CurrentConfig.SegmentDurationSeconds = FMath::Min(CurrentConfig.SegmentDurationSeconds, FSentryCrashVideoSurfaceEncoder::GetMaxSegmentDurationSeconds());
+
+	FSentryCrashVideoSegments::Get().Configure(FMath::CeilToInt(CurrentConfig.LastSecondsToRecord / CurrentConfig.SegmentDurationSeconds));
+	FSentryCrashVideoSegments::Get().ConfigureBookmarks(CurrentConfig.BookmarkWindowSeconds, static_cast<int64>(CurrentConfig.MaxBookmarkDiskMB) * 1024 * 1024);
+
+	++RecordingGeneration;
+	RecordingStats = FCrashVideoRecordingStats();
+
+	ResetQualityGovernor();
+
+	FSentryCrashVideoTrimmer::Get().Configure(0.0f);
+
+	if (CurrentConfig.bRecordFrameTimeline)
+	{
+		FSentryCrashVideoTimeline::Get().Start(FMath::CeilToInt(CurrentConfig.LastSecondsToRecord * 120.0f));
+	}
+
+	if (!StartSurfaceEncoder(0))
+	{
+		FSentryCrashVideoTimeline::Get().Stop();
+		RecordingState = ECrashVideoRecordingState::Idle;
+		return false;
+	}
+
+	bUsesSurfaceEncoder = true;
+	RecordingState = ECrashVideoRecordingState::Recording;
+	bCrashDetected = false;
+
+	ScheduleSurfaceEncoderSegmentPolling();
+
+	BindApplicationStateDelegates();
+
+	if (CurrentConfig.bRecordAudioRing)
+	{
+		FSentryCrashAudioRing::Get().Start(CurrentConfig.LastSecondsToRecord);
+	}
+
+	return true;
+}
+
+bool USentryCrashVideoHandler::StartSurfaceEncoder(int32 FirstSegmentIndex)
+{
+	const FSentryCrashVideoQuality Quality = QualityGovernor->GetQuality();
+
+	FSentrySurfaceEncoderConfig EncoderConfig;
+	EncoderConfig.Width = Quality.Width;
+	EncoderConfig.Height = Quality.Height;
+	EncoderConfig.FramesPerSecond = Quality.FPS;
+	EncoderConfig.Bitrate = Quality.Bitrate;
+	EncoderConfig.SegmentDurationSeconds = CurrentConfig.SegmentDurationSeconds;
+
+	// Unlike the video recorder the encoder needs an actual resolution
+	if ((EncoderConfig.Width <= 0 || EncoderConfig.Height <= 0) && GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport)
+	{
+		const FIntPoint ViewportSize = GEngine->GameViewport->Viewport->GetSizeXY();
+		EncoderConfig.Width = EncoderConfig.Width <= 0 ? ViewportSize.X : EncoderConfig.Width;
+		EncoderConfig.Height = EncoderConfig.Height <= 0 ? ViewportSize.Y : EncoderConfig.Height;
+	}
+
+	const bool bStarted = FSentryCrashVideoSurfaceEncoder::Get().Start(GetSegmentsDirectory(), EncoderConfig, FirstSegmentIndex);
+	if (bStarted)
+	{
+		FSentryCrashVideoTimeline::Get().OnVideoStarted(GetSegmentsDirectory());
+	}
+
+	return bStarted;
+}
+
+void USentryCrashVideoHandler::ScheduleSurfaceEncoderSegmentPolling()
+{
+	const uint32 Generation = RecordingGeneration;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	// Keeps polling while paused since the encoder finalizes the last segment after being stopped
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingGeneration != Generation || !Handler->bUsesSurfaceEncoder)
+		{
+			return false;
+		}
+
+		Handler->CollectSurfaceEncoderSegments();
+
+		if (FSentryCrashVideoSurfaceEncoder::Get().HasFailed())
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Hardware encoder failed - falling back to the video recorder for crash video recording."));
+
+			FCrashVideoConfig FallbackConfig = Handler->CurrentConfig;
+			FallbackConfig.bUseZeroCopyEncoder = false;
+
+			Handler->StopContinuousRecording();
+			Handler->StartContinuousRecording(FallbackConfig);
+			return false;
+		}
+
+		return true;
+	}), SentryCrashVideoTicker::PollInterval);
+}
+
+void USentryCrashVideoHandler::CollectSurfaceEncoderSegments()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (const FString& SegmentPath : FSentryCrashVideoSurfaceEncoder::Get().TakeFinishedSegments())
+	{
+		for (const FString& EvictedSegment : FSentryCrashVideoSegments::Get().AddSegment(SegmentPath))
+		{
+			PlatformFile.DeleteFile(*EvictedSegment);
+		}
+	}
+}
+
+bool USentryCrashVideoHandler::StartRecorder(const FString& VideoPath, float CircularBufferSeconds)
+{
+	SENTRY_STAT_SCOPE(CrashVideoCapture);
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	return false;
+#else
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder)
+	{
+		return false;
+	}
+
+	// Quality is lowered by the governor when adaptive quality is enabled and the game runs over budget
+	const FSentryCrashVideoQuality Quality = QualityGovernor->GetQuality();
+
+	FRuntimeEncoderSettings EncoderSettings;
+	EncoderSettings.VideoBitrate = Quality.Bitrate;
+
+	// Recorder captures the UI on its own and can't mask it, so redacted widgets are kept out by not recording the UI at all
+	bool bRecordUI = CurrentConfig.bRecordUI;
+	if (bRecordUI && FSentryRedactedWidgets::Get().HasWidgets())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Widgets are redacted, crash video is recorded without the UI."));
+		bRecordUI = false;
+	}
+
+	const bool bStarted = VideoRecorder->StartRecording(
+		VideoPath,
+		Quality.FPS,
+		Quality.Width,
+		Quality.Height,
+		EncoderSettings,
+		bRecordUI,
+		CurrentConfig.bEnableAudio,
+		CurrentConfig.bFrameRateIndependent,
+		false,  // bAllowManualCaptureOnly
+		CircularBufferSeconds,  // Non-zero value enables circular buffer
+		false,  // bPostponeEncoding
+		nullptr // InSubmix
+	);
+
+	if (bStarted)
+	{
+		FSentryCrashVideoTimeline::Get().OnVideoStarted(VideoPath);
+
+		ApplyEncoderThreadSettings();
+	}
+
+	return bStarted;
+#endif
+}
+
+void USentryCrashVideoHandler::ScheduleSegmentRotation()
+{
+#if HAS_RUNTIME_VIDEO_RECORDER
+	const uint32 Generation = RecordingGeneration;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	float SegmentTime = 0.0f;
+
+	// Segment duration is re-read on every tick so that config updates apply to the current segment
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation, SegmentTime](float DeltaTime) mutable
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingGeneration != Generation || Handler->RecordingState != ECrashVideoRecordingState::Recording)
+		{
+			// Recording was stopped or restarted
+			return false;
+		}
+
+		SegmentTime += DeltaTime;
+		if (SegmentTime >= Handler->CurrentConfig.SegmentDurationSeconds)
+		{
+			SegmentTime = 0.0f;
+			Handler->RestartRecorder();
+		}
+
+		return true;
+	}), SentryCrashVideoTicker::PollInterval);
+#endif
+}
+
+void USentryCrashVideoHandler::StopRecorderAsync(TFunction<void(USentryCrashVideoHandler*)> OnRecorderStopped)
+{
+	SENTRY_STAT_SCOPE(CrashVideoCapture);
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder)
+	{
+		return;
+	}
+
+	if (VideoRecorder->IsRecordingInProgress())
+	{
+		VideoRecorder->StopRecording_NativeAPI();
+	}
+
+	bIsRestartingRecorder = true;
+
+	const uint32 Generation = RecordingGeneration;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation, StartTime, OnRecorderStopped](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingGeneration != Generation)
+		{
+			// Recording was stopped or restarted
+			return false;
+		}
+
+		URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+		if (!VideoRecorder)
+		{
+			Handler->bIsRestartingRecorder = false;
+			Handler->RecordingState = ECrashVideoRecordingState::Idle;
+			return false;
+		}
+
+		if (VideoRecorder->IsRecordingInProgress())
+		{
+			if (FPlatformTime::Seconds() - StartTime > SentryCrashVideoTicker::FinalizeTimeout)
+			{
+				UE_LOG(LogSentrySdk, Error, TEXT("Timed out waiting for crash video recorder to stop. Crash video recording stopped."));
+				Handler->bIsRestartingRecorder = false;
+				Handler->RecordingState = ECrashVideoRecordingState::Idle;
+				FSentryCrashVideoTimeline::Get().Stop();
+				return false;
+			}
+
+			return true;
+		}
+
+		if (Handler->CurrentConfig.bSegmentedRecording)
+		{
+			// Recorder is idle so the segment file is complete - hand it over to the ring
+			const FString SegmentPath = VideoRecorder->GetLastRecordingFilepath();
+
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			if (PlatformFile.FileExists(*SegmentPath) && PlatformFile.FileSize(*SegmentPath) > 0)
+			{
+				for (const FString& EvictedSegment : FSentryCrashVideoSegments::Get().AddSegment(SegmentPath))
+				{
+					PlatformFile.DeleteFile(*EvictedSegment);
+				}
+			}
+		}
+
+		Handler->bIsRestartingRecorder = false;
+
+		OnRecorderStopped(Handler);
+
+		return false;
+	}), SentryCrashVideoTicker::PollInterval);
+#endif
+}
+
+bool USentryCrashVideoHandler::ContinueRecording(double StopTime)
+{
+	SENTRY_STAT_SCOPE(CrashVideoCapture);
+
+	float CircularBufferSeconds = CurrentConfig.LastSecondsToRecord;
+
+	if (CurrentConfig.bSegmentedRecording)
+	{
+		CurrentSessionVideoPath = GenerateSegmentFilename();
+		CircularBufferSeconds = 0.0f;
+	}
+	else
+	{
+		CurrentSessionVideoPath = GenerateVideoFilename();
+	}
+
+	if (!StartRecorder(CurrentSessionVideoPath, CircularBufferSeconds))
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to restart crash video recorder. Crash video recording stopped."));
+		RecordingState = ECrashVideoRecordingState::Idle;
+		FSentryCrashVideoTimeline::Get().Stop();
+		return false;
+	}
+
+	if (!CurrentConfig.bSegmentedRecording)
+	{
+		CleanupOldVideos(CurrentSessionVideoPath);
+	}
+
+	// Nothing is captured between stopping and starting the recorder
+	const float LatencyMs = (FPlatformTime::Seconds() - StopTime) * 1000.0;
+
+	RecordingStats.NumRestarts++;
+	RecordingStats.DroppedFrames += FMath::CeilToInt(LatencyMs / 1000.0f * QualityGovernor->GetQuality().FPS);
+	RecordingStats.LastRestartLatencyMs = LatencyMs;
+	RecordingStats.MaxRestartLatencyMs = FMath::Max(RecordingStats.MaxRestartLatencyMs, LatencyMs);
+
+	SET_DWORD_STAT(STAT_SentryCrashVideoRestarts, RecordingStats.NumRestarts);
+	SET_DWORD_STAT(STAT_SentryCrashVideoDroppedFrames, RecordingStats.DroppedFrames);
+	SET_FLOAT_STAT(STAT_SentryCrashVideoRestartLatency, LatencyMs);
+
+	return true;
+}
+
+void USentryCrashVideoHandler::RestartRecorder()
+{
+#if HAS_RUNTIME_VIDEO_RECORDER
+	if (bIsRestartingRecorder)
+	{
+		return;
+	}
+
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder || !VideoRecorder->IsRecordingInProgress())
+	{
+		return;
+	}
+
+	const double StopTime = FPlatformTime::Seconds();
+
+	StopRecorderAsync([StopTime](USentryCrashVideoHandler* Handler)
+	{
+		if (Handler->RecordingState == ECrashVideoRecordingState::Recording)
+		{
+			Handler->ContinueRecording(StopTime);
+		}
+	});
+#endif
+}
+
+bool USentryCrashVideoHandler::UpdateRecordingConfig(const FCrashVideoConfig& NewConfig)
+{
+	if (RecordingState == ECrashVideoRecordingState::WaitingForPreviousRecording)
+	{
+		// Recording hasn't started yet so it will pick up the new config as is
+		return StartContinuousRecording(NewConfig);
+	}
+
+	if (RecordingState != ECrashVideoRecordingState::Recording && RecordingState != ECrashVideoRecordingState::Paused)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("No crash video recording in progress to update."));
+		return false;
+	}
+
+	const FCrashVideoConfig PreviousConfig = CurrentConfig;
+
+	// Switching capture modes requires a new capture pipeline; frame strip is cheap to restart anyway
+	if (NewConfig.bFrameStripOnly || PreviousConfig.bFrameStripOnly || NewConfig.bRawFrameRing || PreviousConfig.bRawFrameRing || NewConfig.bSegmentedRecording != PreviousConfig.bSegmentedRecording ||
+		bUsesSurfaceEncoder || NewConfig.bUseZeroCopyEncoder != PreviousConfig.bUseZeroCopyEncoder)
+	{
+		StopContinuousRecording();
+		return StartContinuousRecording(NewConfig);
+	}
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	// Recordings the remaining settings apply to go through the video recorder
+	return false;
+#else
+	const FSentryCrashVideoQuality PreviousQuality = QualityGovernor->GetQuality();
+
+	CurrentConfig = NewConfig;
+	ClampConfig();
+	FitConfigToMemoryBudget();
+	ResetQualityGovernor();
+
+	const FSentryCrashVideoQuality Quality = QualityGovernor->GetQuality();
+
+	FSentryCrashVideoTrimmer::Get().Configure(CurrentConfig.bTrimToLastSeconds ? CurrentConfig.LastSecondsToRecord : 0.0f);
+
+	if (CurrentConfig.bSegmentedRecording)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		const int32 MaxSegments = FMath::CeilToInt(CurrentConfig.LastSecondsToRecord / CurrentConfig.SegmentDurationSeconds);
+		FSentryCrashVideoSegments::Get().ConfigureBookmarks(CurrentConfig.BookmarkWindowSeconds, static_cast<int64>(CurrentConfig.MaxBookmarkDiskMB) * 1024 * 1024);
+		for (const FString& EvictedSegment : FSentryCrashVideoSegments::Get().SetMaxSegments(MaxSegments))
+		{
+			PlatformFile.DeleteFile(*EvictedSegment);
+		}
+	}
+
+	if (CurrentConfig.bAdaptiveQuality && !PreviousConfig.bAdaptiveQuality)
+	{
+		ScheduleQualityGovernor();
+	}
+
+	if (CurrentConfig.bTrackSplitScreenLayout && !PreviousConfig.bTrackSplitScreenLayout)
+	{
+		LastSplitScreenLayout.Empty();
+		UpdateSplitScreenLayoutContext();
+		ScheduleSplitScreenLayoutTracking();
+	}
+
+	if (CurrentConfig.bPauseWhenInactive != PreviousConfig.bPauseWhenInactive)
+	{
+		BindApplicationStateDelegates();
+	}
+
+	// Audio ring doesn't depend on the encoder so it's resized right away
+	const bool bRecordAudioRing = CurrentConfig.bRecordAudioRing && !CurrentConfig.bEnableAudio;
+	const bool bWasRecordingAudioRing = PreviousConfig.bRecordAudioRing && !PreviousConfig.bEnableAudio;
+	if (!bRecordAudioRing)
+	{
+		FSentryCrashAudioRing::Get().Stop();
+	}
+	else if (!bWasRecordingAudioRing || CurrentConfig.LastSecondsToRecord != PreviousConfig.LastSecondsToRecord)
+	{
+		FSentryCrashAudioRing::Get().Start(CurrentConfig.LastSecondsToRecord);
+	}
+
+	SET_MEMORY_STAT(STAT_SentryVideoBufferMemory, GetEstimatedBufferMemory());
+	SentryMemoryAccounting::SetCrashVideoBytes(GetEstimatedBufferMemory());
+
+	const bool bResolutionChanged = Quality.Width != PreviousQuality.Width || Quality.Height != PreviousQuality.Height;
+
+	// Segmented recording picks everything up with the next segment while restarting the circular buffer loses its content,
+	// so only a resolution change is worth it since the recorder has no way to rescale frames on the fly
+	if (bResolutionChanged && !CurrentConfig.bSegmentedRecording && RecordingState == ECrashVideoRecordingState::Recording && !bIsBorrowedRecording)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video resolution changed to %dx%d - restarting the recorder."), Quality.Width, Quality.Height);
+		RestartRecorder();
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording config updated: %.1f seconds, %d FPS, %dx%d, %d bps"),
+		CurrentConfig.LastSecondsToRecord, Quality.FPS, Quality.Width, Quality.Height, Quality.Bitrate);
+
+	return true;
+#endif
+}
+
+void USentryCrashVideoHandler::PauseRecording()
+{
+	bResumePending = false;
+
+	// Recording reused from someone else keeps running for its owner
+	if (RecordingState != ECrashVideoRecordingState::Recording || CurrentConfig.bFrameStripOnly || CurrentConfig.bRawFrameRing || bIsBorrowedRecording)
+	{
+		return;
+	}
+
+	if (bUsesSurfaceEncoder)
+	{
+		// Encoder stops right away, segments recorded so far stay in the ring
+		FSentryCrashVideoSurfaceEncoder::Get().Stop();
+		RecordingState = ECrashVideoRecordingState::Paused;
+
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording paused."));
+		return;
+	}
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+	// Invalidate tickers of the active recording, they're scheduled again on resume
+	++RecordingGeneration;
+
+	RecordingState = ECrashVideoRecordingState::Paused;
+
+	StopRecorderAsync([](USentryCrashVideoHandler* Handler)
+	{
+		if (Handler->bResumePending)
+		{
+			Handler->ResumeRecording();
+		}
+	});
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording paused."));
+#endif
+}
+
+void USentryCrashVideoHandler::ResumeRecording()
+{
+	if (RecordingState != ECrashVideoRecordingState::Paused)
+	{
+		return;
+	}
+
+	if (bIsRestartingRecorder)
+	{
+		// The recorder is still flushing footage recorded before pausing
+		bResumePending = true;
+		return;
+	}
+
+	bResumePending = false;
+
+	if (bUsesSurfaceEncoder)
+	{
+		if (!StartSurfaceEncoder(-1))
+		{
+			UE_LOG(LogSentrySdk, Error, TEXT("Failed to resume zero-copy crash video recording."));
+			return;
+		}
+
+		RecordingState = ECrashVideoRecordingState::Recording;
+
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording resumed."));
+		return;
+	}
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+	++RecordingGeneration;
+
+	RecordingState = ECrashVideoRecordingState::Recording;
+
+	if (!ContinueRecording(FPlatformTime::Seconds()))
+	{
+		return;
+	}
+
+	if (CurrentConfig.bSegmentedRecording)
+	{
+		ScheduleSegmentRotation();
+	}
+
+	if (CurrentConfig.bAdaptiveQuality)
+	{
+		ScheduleQualityGovernor();
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording resumed."));
+#endif
+}
+
+void USentryCrashVideoHandler::BindApplicationStateDelegates()
+{
+	UnbindApplicationStateDelegates();
+
+	if (!CurrentConfig.bPauseWhenInactive)
+	{
+		return;
+	}
+
+	OnEnterBackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddWeakLambda(this, [this]()
+	{
+		PauseRecording();
+	});
+
+	OnEnterForegroundHandle = FCoreDelegates::ApplicationHasEnteredForegroundDelegate.AddWeakLambda(this, [this]()
+	{
+		ResumeRecording();
+	});
+
+	// Desktop applications get deactivated when minimized or losing focus
+	if (FSlateApplication::IsInitialized())
+	{
+		OnActivationStateChangedHandle = FSlateApplication::Get().OnApplicationActivationStateChanged().AddWeakLambda(this, [this](bool bIsActive)
+		{
+			if (bIsActive)
+			{
+				ResumeRecording();
+			}
+			else
+			{
+				PauseRecording();
+			}
+		});
+	}
+}
+
+void USentryCrashVideoHandler::UnbindApplicationStateDelegates()
+{
+	FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(OnEnterBackgroundHandle);
+	FCoreDelegates::ApplicationHasEnteredForegroundDelegate.Remove(OnEnterForegroundHandle);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnApplicationActivationStateChanged().Remove(OnActivationStateChangedHandle);
+	}
+
+	OnEnterBackgroundHandle.Reset();
+	OnEnterForegroundHandle.Reset();
+	OnActivationStateChangedHandle.Reset();
+}
+
+void USentryCrashVideoHandler::ScheduleQualityGovernor()
+{
+#if HAS_RUNTIME_VIDEO_RECORDER
+	const uint32 Generation = RecordingGeneration;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	float TimeSinceEvaluation = 0.0f;
+
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation, TimeSinceEvaluation](float DeltaTime) mutable
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingGeneration != Generation || Handler->RecordingState != ECrashVideoRecordingState::Recording || !Handler->CurrentConfig.bAdaptiveQuality)
+		{
+			return false;
+		}
+
+		// The slowest of game thread, render thread and GPU bounds the frame
+		const float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+		const float RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+		const float GpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+
+		Handler->QualityGovernor->AddFrameSample(FMath::Max3(GameThreadMs, RenderThreadMs, GpuMs));
+
+		TimeSinceEvaluation += DeltaTime;
+		if (TimeSinceEvaluation < SentryCrashVideoTicker::QualityEvaluationInterval || Handler->bIsRestartingRecorder)
+		{
+			return true;
+		}
+
+		TimeSinceEvaluation = 0.0f;
+
+		Handler->QualityGovernor->SetThrottled(FSentryDeviceConditionsSampler::Get().IsThrottled());
+
+		const int32 PreviousLevel = Handler->QualityGovernor->GetLevel();
+		if (Handler->QualityGovernor->Evaluate())
+		{
+			Handler->AddQualityBreadcrumb(PreviousLevel);
+
+			SET_MEMORY_STAT(STAT_SentryVideoBufferMemory, Handler->GetEstimatedBufferMemory());
+			SentryMemoryAccounting::SetCrashVideoBytes(Handler->GetEstimatedBufferMemory());
+
+			// Restarting the recorder would drop its circular buffer, so the new quality waits for the next segment or,
+			// without segments, for the next time the recorder is started anyway (e.g. on resume or a config update)
+		}
+
+		return true;
+	}));
+#endif
+}
+
+void USentryCrashVideoHandler::ScheduleSplitScreenLayoutTracking()
+{
+#if HAS_RUNTIME_VIDEO_RECORDER
+	const uint32 Generation = RecordingGeneration;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingGeneration != Generation || !Handler->CurrentConfig.bTrackSplitScreenLayout)
+		{
+			return false;
+		}
+
+		// Players can join and leave at any time so the layout has to be polled
+		if (Handler->RecordingState == ECrashVideoRecordingState::Recording)
+		{
+			Handler->UpdateSplitScreenLayoutContext();
+		}
+
+		return true;
+	}), SentryCrashVideoTicker::LayoutTrackingInterval);
+#endif
+}
+
+void USentryCrashVideoHandler::UpdateSplitScreenLayoutContext()
+{
+	UGameViewportClient* GameViewport = GEngine ? GEngine->GameViewport : nullptr;
+	UWorld* World = GameViewport ? GameViewport->GetWorld() : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (!GameInstance)
+	{
+		return;
+	}
+
+	const bool bSplitScreen = GameInstance->GetNumLocalPlayers() > 1 && !GameViewport->IsSplitscreenForceDisabled();
+
+	TArray<FSentryVariant> Players;
+	FString Layout = bSplitScreen ? TEXT("split") : TEXT("single");
+
+	const TArray<ULocalPlayer*>& LocalPlayers = GameInstance->GetLocalPlayers();
+	for (int32 PlayerIndex = 0; PlayerIndex < LocalPlayers.Num(); ++PlayerIndex)
+	{
+		const ULocalPlayer* LocalPlayer = LocalPlayers[PlayerIndex];
+		if (!LocalPlayer)
+		{
+			continue;
+		}
+
+		// Viewport rectangle normalized to the recorded frame
+		const float X = static_cast<float>(LocalPlayer->Origin.X);
+		const float Y = static_cast<float>(LocalPlayer->Origin.Y);
+		const float Width = static_cast<float>(LocalPlayer->Size.X);
+		const float Height = static_cast<float>(LocalPlayer->Size.Y);
+
+		Layout += FString::Printf(TEXT(";%d:%.3f,%.3f,%.3f,%.3f"), PlayerIndex, X, Y, Width, Height);
+
+		Players.Add(TMap<FString, FSentryVariant>({
+			{ TEXT("index"), PlayerIndex },
+			{ TEXT("x"), X },
+			{ TEXT("y"), Y },
+			{ TEXT("width"), Width },
+			{ TEXT("height"), Height }
+		}));
+	}
+
+	if (Layout == LastSplitScreenLayout)
+	{
+		return;
+	}
+
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+	{
+		return;
+	}
+
+	LastSplitScreenLayout = Layout;
+
+	SentrySubsystem->SetContext(TEXT("crash_video_layout"), {
+		{ TEXT("split_screen"), bSplitScreen },
+		{ TEXT("local_players"), Players.Num() },
+		{ TEXT("players"), Players }
+	});
+}
+
+void USentryCrashVideoHandler::ScheduleEditorClientTracking()
+{
+	bIsTrackingEditorClients = true;
+
+	const uint32 Generation = ++EditorClientTrackingGeneration;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->EditorClientTrackingGeneration != Generation)
+		{
+			return false;
+		}
+
+		// Clients join and leave while PIE is running, e.g. when a client is started later or its window is closed
+		Handler->UpdateEditorClients();
+
+		return Handler->bIsTrackingEditorClients && Handler->EditorClientTrackingGeneration == Generation;
+	}), SentryCrashVideoTicker::LayoutTrackingInterval);
+}
+
+void USentryCrashVideoHandler::UpdateEditorClients()
+{
+	if (RecordingState == ECrashVideoRecordingState::Idle)
+	{
+		bIsTrackingEditorClients = false;
+		EditorRecordingClients.Reset();
+		return;
+	}
+
+	if (SentryPieClients::GetClientWindows().Num() == 0 && EditorRecordingClients.Num() > 0)
+	{
+		// Clients that didn't disable the recording in EndPlay are gone along with PIE, so is the game they shared it in
+		UE_LOG(LogSentrySdk, Log, TEXT("Play In Editor session ended, stopping the crash video recording it shared."));
+		StopContinuousRecording();
+		return;
+	}
+
+	UpdateCapturedClientWindows();
+}
+
+void USentryCrashVideoHandler::UpdateCapturedClientWindows()
+{
+	if (!CurrentConfig.bRawFrameRing || RecordingState != ECrashVideoRecordingState::Recording)
+	{
+		return;
+	}
+
+	const TArray<const SWindow*> ClientWindows = SentryPieClients::GetClientWindows();
+	if (ClientWindows == CapturedClientWindows)
+	{
+		return;
+	}
+
+	CapturedClientWindows = ClientWindows;
+
+	// All clients share one ring and one capture cadence, each is downscaled into its own tile of the frame
+	FSentryCrashVideoRawRing::Get().SetCapturedWindows(CapturedClientWindows);
+}
+
+bool USentryCrashVideoHandler::JoinEditorRecording(const UObject* WorldContextObject, const FCrashVideoConfig& Config)
+{
+	const int32 ClientInstance = SentryPieClients::GetClientInstance(WorldContextObject);
+	if (ClientInstance == INDEX_NONE || RecordingState == ECrashVideoRecordingState::Idle || EditorRecordingClients.Num() == 0)
+	{
+		return false;
+	}
+
+	const bool bStartedByOtherClient = EditorRecordingClients.Num() > 1 || !EditorRecordingClients.Contains(ClientInstance);
+	if (!bStartedByOtherClient && !FCrashVideoConfig::StaticStruct()->CompareScriptStruct(&Config, &EditorRecordingConfig, PPF_None))
+	{
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording is already shared by the Play In Editor clients, the client joins it."));
+
+	EditorRecordingClients.Add(ClientInstance);
+	return true;
+}
+
+void USentryCrashVideoHandler::AddEditorRecordingClient(const UObject* WorldContextObject, const FCrashVideoConfig& Config)
+{
+	const int32 ClientInstance = SentryPieClients::GetClientInstance(WorldContextObject);
+	if (ClientInstance == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (EditorRecordingClients.Num() == 0)
+	{
+		EditorRecordingConfig = Config;
+	}
+
+	EditorRecordingClients.Add(ClientInstance);
+
+	// Recording is stopped along with PIE in every mode, in case clients don't disable it when they end play
+	if (!bIsTrackingEditorClients)
+	{
+		ScheduleEditorClientTracking();
+	}
+}
+
+bool USentryCrashVideoHandler::RemoveEditorRecordingClient(const UObject* WorldContextObject)
+{
+	const int32 ClientInstance = SentryPieClients::GetClientInstance(WorldContextObject);
+	if (ClientInstance == INDEX_NONE)
+	{
+		return false;
+	}
+
+	EditorRecordingClients.Remove(ClientInstance);
+	return EditorRecordingClients.Num() > 0;
+}
+
+void USentryCrashVideoHandler::ApplyEncoderThreadSettings()
+{
+	if (CurrentConfig.EncoderThreadNameFilter.IsEmpty())
+	{
+		return;
+	}
+
+	auto Apply = [](const FCrashVideoConfig& Config)
+	{
+		return SentryThreadUtils::ApplyToThreads(Config.EncoderThreadNameFilter,
+			SentryThreadUtils::ToThreadPriority(Config.EncoderThreadPriority),
+			SentryThreadUtils::ToAffinityMask(static_cast<uint32>(Config.EncoderThreadAffinityMask)));
+	};
+
+	if (Apply(CurrentConfig) > 0)
+	{
+		return;
+	}
+
+	const uint32 Generation = RecordingGeneration;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Generation, Apply](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingGeneration != Generation || Handler->RecordingState != ECrashVideoRecordingState::Recording)
+		{
+			return false;
+		}
+
+		if (Apply(Handler->CurrentConfig) == 0 && !Handler->bHasLoggedMissingEncoderThreads)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("No recorder threads matching '%s' found, encoder thread priority and affinity are not applied."), *Handler->CurrentConfig.EncoderThreadNameFilter);
+			Handler->bHasLoggedMissingEncoderThreads = true;
+		}
+
+		return false;
+	}), SentryCrashVideoTicker::EncoderThreadsSpawnDelay);
+}
+
+void USentryCrashVideoHandler::AddQualityBreadcrumb(int32 PreviousLevel) const
+{
+	if (!SENTRY_BREADCRUMB_IS_ENABLED(Info))
+	{
+		return;
+	}
+
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+	{
+		return;
+	}
+
+	const int32 Level = QualityGovernor->GetLevel();
+	const FSentryCrashVideoQuality Quality = QualityGovernor->GetQuality();
+
+	const FString Message = Level > PreviousLevel
+		? TEXT("Crash video quality lowered")
+		: TEXT("Crash video quality raised");
+
+	SentrySubsystem->AddBreadcrumbWithParams(Message, TEXT("CrashVideo"), TEXT("Default"),
+		{
+			{ TEXT("Level"), Level },
+			{ TEXT("FPS"), Quality.FPS },
+			{ TEXT("Width"), Quality.Width },
+			{ TEXT("Height"), Quality.Height },
+			{ TEXT("Bitrate"), Quality.Bitrate },
+			{ TEXT("FrameTimeMs"), QualityGovernor->GetLastAverageFrameTimeMs() },
+			{ TEXT("Throttled"), QualityGovernor->IsThrottled() }
+		},
+		ESentryLevel::Info);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("%s to level %d: %d FPS, %dx%d, %d bps (average frame time %.2f ms)"),
+		*Message, Level, Quality.FPS, Quality.Width, Quality.Height, Quality.Bitrate, QualityGovernor->GetLastAverageFrameTimeMs());
+}
+
+void USentryCrashVideoHandler::ScheduleRecordingStart()
+{
+#if HAS_RUNTIME_VIDEO_RECORDER
+	RecordingState = ECrashVideoRecordingState::WaitingForPreviousRecording;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, StartTime](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler || Handler->RecordingState != ECrashVideoRecordingState::WaitingForPreviousRecording)
+		{
+			// Handler was destroyed or the pending start was cancelled
+			return false;
+		}
+
+		URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+		if (!VideoRecorder)
+		{
+			Handler->RecordingState = ECrashVideoRecordingState::Idle;
+			return false;
+		}
+
+		// The recorder reports idle as soon as it's stopped, yet the file of a recording being finalized is still being written
+		if (!VideoRecorder->IsRecordingInProgress() && !Handler->bIsFinalizationPending)
+		{
+			// Pending config may not use the recorder at all, so the capture mode is picked again
+			const FCrashVideoConfig PendingConfig = Handler->CurrentConfig;
+			Handler->RecordingState = ECrashVideoRecordingState::Idle;
+			Handler->StartContinuousRecording(PendingConfig);
+			return false;
+		}
+
+		// Finalization has its own timeout after which the flag is cleared, so this one only needs to outlast it
+		if (FPlatformTime::Seconds() - StartTime > 2.0 * SentryCrashVideoTicker::FinalizeTimeout)
+		{
+			UE_LOG(LogSentrySdk, Error, TEXT("Timed out waiting for the previous recording to stop. Crash video recording was not started."));
+			Handler->RecordingState = ECrashVideoRecordingState::Idle;
+			return false;
+		}
+
+		return true;
+	}), SentryCrashVideoTicker::PollInterval);
+#endif
+}
+
+void USentryCrashVideoHandler::StopContinuousRecording()
+{
+	// Clients sharing the recording are released along with it
+	EditorRecordingClients.Reset();
+	bIsTrackingEditorClients = false;
+	++EditorClientTrackingGeneration;
+
+	if (RecordingState == ECrashVideoRecordingState::WaitingForPreviousRecording)
+	{
+		// Cancel the pending start
+		RecordingState = ECrashVideoRecordingState::Idle;
+		return;
+	}
+
+	if (RecordingState != ECrashVideoRecordingState::Recording && RecordingState != ECrashVideoRecordingState::Paused)
+	{
+		return;
+	}
+
+	if (CurrentConfig.bFrameStripOnly)
+	{
+		FSentryCrashVideoFrameStrip::Get().Stop();
+		RecordingState = ECrashVideoRecordingState::Idle;
+		return;
+	}
+
+	// Snapshot encoding reads from the ring or the recorder that's about to be stopped
+	WaitForSnapshot();
+
+	if (CurrentConfig.bRawFrameRing)
+	{
+		FSentryCrashVideoRawRing::Get().Stop();
+		CapturedClientWindows.Reset();
+		RecordingState = ECrashVideoRecordingState::Idle;
+		return;
+	}
+
+	if (bUsesSurfaceEncoder)
+	{
+		FSentryCrashVideoSurfaceEncoder::Get().Stop();
+		bUsesSurfaceEncoder = false;
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording stopped."));
+	}
+#if HAS_RUNTIME_VIDEO_RECORDER
+	else
+	{
+		// Recording reused from someone else is left to its owner
+		URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+		if (VideoRecorder && VideoRecorder->IsRecordingInProgress() && !bIsBorrowedRecording)
+		{
+			VideoRecorder->StopRecording_NativeAPI();
+			UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording stopped."));
+		}
+	}
+#endif
+
+	UnbindApplicationStateDelegates();
+	UnbindBookmarkFilter();
+
+	// Bookmarks nothing referenced are sent now, before the footage they kept is discarded along with the ring
+	for (const FString& BookmarkName : FSentryCrashVideoSegments::Get().GetBookmarkNames())
+	{
+		if (CurrentConfig.bSendBookmarksOnStop)
+		{
+			// Stopping may be part of the handler's destruction, so the clip is sent right away
+			SendBookmarkClip(BookmarkName, FString(), true);
+		}
+		else
+		{
+			RemoveBookmark(BookmarkName);
+		}
+	}
+
+	FSentryCrashAudioRing::Get().Stop();
+	FSentryCrashVideoTimeline::Get().Stop();
+
+	// Invalidate all pending tickers of the stopped recording
+	++RecordingGeneration;
+	bIsRestartingRecorder = false;
+	bResumePending = false;
+	bIsBorrowedRecording = false;
+
+	RecordingState = ECrashVideoRecordingState::Idle;
+	CurrentSessionVideoPath.Empty();
+
+	// Video recorded before stopping shouldn't be attached to subsequent crashes
+	FSentryCrashVideoSegments::Get().Reset();
+
+	SET_MEMORY_STAT(STAT_SentryVideoBufferMemory, 0);
+	SentryMemoryAccounting::SetCrashVideoBytes(0);
+}
+
+FString USentryCrashVideoHandler::GetCrashVideoDirectory() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SentryCrashVideos"));
+}
+
+FString USentryCrashVideoHandler::CaptureAndAttachVideo()
+{
+	SENTRY_STAT_SCOPE(CrashVideoCapture);
+
+	if (RecordingState != ECrashVideoRecordingState::Recording)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("No recording in progress to capture."));
+		return FString();
+	}
+
+	if (CurrentConfig.bFrameStripOnly)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Frame strip is attached to crash reports only and can't be captured manually."));
+		return FString();
+	}
+
+	if (CurrentConfig.bRawFrameRing)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Raw frame ring can't be captured manually, use CaptureSnapshotClip instead."));
+		return FString();
+	}
+
+	if (bUsesSurfaceEncoder)
+	{
+		// Finalized segments are already on disk, the one being encoded can't be finalized without restarting the encoder
+		CollectSurfaceEncoderSegments();
+
+		const TArray<FString> SegmentPaths = FSentryCrashVideoSegments::Get().GetNewestSegmentsWithinSize(FSentryModule::Get().GetSettings()->MaxAttachmentSize);
+
+		bool bAttached = false;
+		for (const FString& SegmentPath : SegmentPaths)
+		{
+			bAttached |= AttachVideoToSentry(SegmentPath);
+		}
+
+		const FString VideoPath = SegmentPaths.Num() > 0 ? SegmentPaths.Last() : FString();
+		OnVideoFinalized.Broadcast(bAttached, VideoPath);
+
+		return bAttached ? VideoPath : FString();
+	}
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	return FString();
+#else
+	const FString ExpectedVideoPath = CurrentSessionVideoPath;
+
+	TFuture<FString> Finalization = FinalizeAndSaveVideoAsync();
+
+	// Finalization that can't start, e.g. since another one is in progress, has already failed by now
+	const bool bFailedToStart = Finalization.IsReady() && Finalization.Get().IsEmpty();
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+	Finalization.Next([WeakThis](const FString& VideoPath)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler)
+		{
+			return;
+		}
+
+		bool bAttached = false;
+
+		if (Handler->CurrentConfig.bSegmentedRecording && !VideoPath.IsEmpty())
+		{
+			// Attach the whole segment ring so that the captured video covers the configured duration
+			Handler->DeleteReleasedSegments(FSentryCrashVideoSegments::Get().AddSegment(VideoPath));
+
+			const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+			for (const FString& SegmentPath : FSentryCrashVideoSegments::Get().GetNewestSegmentsWithinSize(Settings->MaxAttachmentSize))
+			{
+				bAttached |= Handler->AttachVideoToSentry(SegmentPath);
+			}
+		}
+		else
+		{
+			bAttached = !VideoPath.IsEmpty() && Handler->AttachVideoToSentry(VideoPath);
+		}
+
+		if (bAttached)
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("Video captured and attached to Sentry: %s"), *VideoPath);
+		}
+
+		Handler->OnVideoFinalized.Broadcast(bAttached, VideoPath);
+	});
+
+	return bFailedToStart ? FString() : ExpectedVideoPath;
+#endif
+}
+
+bool USentryCrashVideoHandler::CaptureSnapshotClip(const FString& RelatedEventId, const UObject* WorldContextObject)
+{
+	if (RecordingState != ECrashVideoRecordingState::Recording || CurrentConfig.bFrameStripOnly)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("No recording in progress to take a snapshot of."));
+		return false;
+	}
+
+	if (bIsCapturingSnapshot)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("Video snapshot is already in progress, skipping."));
+		return false;
+	}
+
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+
+	if (CurrentConfig.bRawFrameRing)
+	{
+		const FString VideoPath = FPaths::Combine(GetSnapshotsDirectory(), FString::Printf(TEXT("snapshot_video_%s.avi"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+		const int64 MaxAttachmentSize = Settings->MaxAttachmentSize;
+
+		// Footage of a single PIE client is cropped from its tile of the shared frames, recorded since the clients last changed
+		FIntRect CropRect;
+		const uint32 CropLayout = FSentryCrashVideoRawRing::Get().GetCapturedWindowsLayout();
+		if (WorldContextObject && CapturedClientWindows.Num() > 1)
+		{
+			CropRect = FSentryCrashVideoRawRing::Get().GetCapturedWindowRect(CapturedClientWindows.IndexOfByKey(SentryPieClients::GetClientWindow(WorldContextObject)));
+		}
+
+		bIsCapturingSnapshot = true;
+
+		TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+		// Frames are only encoded now, which takes a while, so keep it off the game thread while capture keeps running
+		PendingSnapshot = Async(EAsyncExecution::ThreadPool, [WeakThis, VideoPath, MaxAttachmentSize, RelatedEventId, CropRect, CropLayout]()
+		{
+			bool bEncoded = false;
+
+			{
+				SENTRY_STAT_SCOPE(CrashVideoEncode);
+				bEncoded = FSentryCrashVideoRawRing::Get().EncodeVideo(VideoPath, CropRect, CropLayout);
+			}
+
+			const int64 VideoSize = bEncoded ? IFileManager::Get().FileSize(*VideoPath) : -1;
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, VideoPath, VideoSize, MaxAttachmentSize, RelatedEventId]()
+			{
+				USentryCrashVideoHandler* Handler = WeakThis.Get();
+				if (!Handler)
+				{
+					return;
+				}
+
+				Handler->bIsCapturingSnapshot = false;
+
+				if (VideoSize <= 0)
+				{
+					UE_LOG(LogSentrySdk, Error, TEXT("Failed to encode raw frame ring snapshot."));
+					return;
+				}
+
+				Handler->CleanupOldSnapshots(VideoPath);
+
+				if (MaxAttachmentSize > 0 && VideoSize > MaxAttachmentSize)
+				{
+					UE_LOG(LogSentrySdk, Warning, TEXT("Video snapshot size (%lld bytes) exceeds max attachment size (%lld bytes), skipping: %s"), VideoSize, MaxAttachmentSize, *VideoPath);
+					return;
+				}
+
+				Handler->SendSnapshotClip({ VideoPath }, RelatedEventId);
+			});
+		});
+
+		return true;
+	}
+
+	if (CurrentConfig.bSegmentedRecording)
+	{
+		if (bUsesSurfaceEncoder)
+		{
+			CollectSurfaceEncoderSegments();
+		}
+
+		// Finalized segments are already encoded so there is nothing to wait for
+		const TArray<FString> SegmentPaths = FSentryCrashVideoSegments::Get().GetNewestSegmentsWithinSize(Settings->MaxAttachmentSize);
+		if (SegmentPaths.Num() == 0)
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("No finalized video segments to take a snapshot of yet."));
+			return false;
+		}
+
+		TArray<FString> Files = SegmentPaths;
+
+		const FString IndexPath = FPaths::Combine(GetSegmentsDirectory(), TEXT("crash_video_segments.ffconcat"));
+		if (FSentryCrashVideoSegments::WriteIndex(IndexPath, SegmentPaths))
+		{
+			Files.Add(IndexPath);
+		}
+
+		SendSnapshotClip(Files, RelatedEventId);
+		return true;
+	}
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	return false;
+#else
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder || !VideoRecorder->IsRecordingInProgress())
+	{
+		return false;
+	}
+
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	const FString OutputBasePath = FPaths::Combine(GetSnapshotsDirectory(), FString::Printf(TEXT("snapshot_video_%s"), *Timestamp));
+	const int64 MaxAttachmentSize = Settings->MaxAttachmentSize;
+
+	bIsCapturingSnapshot = true;
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	// Weak pointers can't be resolved off the game thread. The recorder is an engine subsystem and stopping the recording
+	// waits for the snapshot, so the pointer resolved here stays valid while the buffer is encoded.
+	PendingSnapshot = Async(EAsyncExecution::ThreadPool, [WeakThis, VideoRecorder, OutputBasePath, MaxAttachmentSize, RelatedEventId]()
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputBasePath), true);
+
+		bool bEncoded = false;
+
+		{
+			SENTRY_STAT_SCOPE(CrashVideoEncode);
+			bEncoded = VideoRecorder->EncodeCircularBufferToVideo(OutputBasePath);
+		}
+
+		// EncodeCircularBufferToVideo appends "_crash_recovery.mp4" to the given path
+		const FString VideoPath = OutputBasePath + TEXT("_crash_recovery.mp4");
+
+		if (bEncoded)
+		{
+			FSentryCrashVideoTrimmer::Get().TrimClip(VideoPath);
+		}
+
+		const int64 VideoSize = bEncoded ? IFileManager::Get().FileSize(*VideoPath) : -1;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, VideoPath, VideoSize, MaxAttachmentSize, RelatedEventId]()
+		{
+			USentryCrashVideoHandler* Handler = WeakThis.Get();
+			if (!Handler)
+			{
+				return;
+			}
+
+			Handler->bIsCapturingSnapshot = false;
+
+			if (VideoSize <= 0)
+			{
+				UE_LOG(LogSentrySdk, Error, TEXT("Failed to encode video snapshot."));
+				return;
+			}
+
+			Handler->CleanupOldSnapshots(VideoPath);
+
+			if (MaxAttachmentSize > 0 && VideoSize > MaxAttachmentSize)
+			{
+				UE_LOG(LogSentrySdk, Warning, TEXT("Video snapshot size (%lld bytes) exceeds max attachment size (%lld bytes), skipping: %s"), VideoSize, MaxAttachmentSize, *VideoPath);
+				return;
+			}
+
+			Handler->SendSnapshotClip({ VideoPath }, RelatedEventId);
+		});
+	});
+
+	return true;
+#endif
+}
+
+void USentryCrashVideoHandler::SendSnapshotClip(const TArray<FString>& Files, const FString& RelatedEventId, const FString& BookmarkName) const
+{
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry subsystem not available."));
+		return;
+	}
+
+	int64 TotalSize = 0;
+	for (const FString& File : Files)
+	{
+		TotalSize += FMath::Max<int64>(0, IFileManager::Get().FileSize(*File));
+	}
+
+	TWeakObjectPtr<USentrySubsystem> WeakSubsystem(SentrySubsystem);
+
+	// Upload may be deferred while a match is in progress so it must not depend on the handler still being around
+	SentrySubsystem->ScheduleUpload(TotalSize, [WeakSubsystem, Files, RelatedEventId, BookmarkName]()
+	{
+		USentrySubsystem* SentrySubsystem = WeakSubsystem.Get();
+		if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+		{
+			return;
+		}
+
+		SentrySubsystem->CaptureMessageWithScope(TEXT("Video snapshot"), FConfigureScopeNativeDelegate::CreateLambda([&Files, &RelatedEventId, &BookmarkName](USentryScope* Scope)
+		{
+			if (!RelatedEventId.IsEmpty())
+			{
+				Scope->SetTag(TEXT("related_event_id"), RelatedEventId);
+			}
+
+			if (!BookmarkName.IsEmpty())
+			{
+				Scope->SetTag(TEXT("crash_video_bookmark"), BookmarkName);
+			}
+
+			for (const FString& File : Files)
+			{
+				// Segments can be rotated out while the upload is deferred
+				if (!IFileManager::Get().FileExists(*File))
+				{
+					continue;
+				}
+
+				const TCHAR* ContentType = File.EndsWith(TEXT(".mp4")) ? TEXT("video/mp4") : File.EndsWith(TEXT(".avi")) ? TEXT("video/x-msvideo") : TEXT("text/plain");
+				Scope->AddAttachment(USentryLibrary::CreateSentryAttachmentWithPath(File, FPaths::GetCleanFilename(File), ContentType));
+			}
+		}), ESentryLevel::Info);
+
+		UE_LOG(LogSentrySdk, Log, TEXT("Video snapshot sent to Sentry (%d file(s))."), Files.Num());
+	});
+}
+
+bool USentryCrashVideoHandler::Bookmark(const FString& Name)
+{
+	if (Name.IsEmpty())
+	{
+		return false;
+	}
+
+	if (RecordingState != ECrashVideoRecordingState::Recording && RecordingState != ECrashVideoRecordingState::Paused)
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("No recording in progress to bookmark."));
+		return false;
+	}
+
+	if (!CurrentConfig.bSegmentedRecording || CurrentConfig.bFrameStripOnly || CurrentConfig.bRawFrameRing || CurrentConfig.MaxBookmarkDiskMB <= 0)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Video bookmarks require segmented or zero-copy recording with MaxBookmarkDiskMB above zero."));
+		return false;
+	}
+
+	DeleteReleasedSegments(FSentryCrashVideoSegments::Get().AddBookmark(Name, FPlatformTime::Seconds()));
+
+	BindBookmarkFilter();
+
+	if (SENTRY_BREADCRUMB_IS_ENABLED(Info))
+	{
+		if (USentrySubsystem* SentrySubsystem = USentrySubsystem::Get())
+		{
+			SentrySubsystem->AddBreadcrumbWithParams(TEXT("Crash video bookmark"), TEXT("CrashVideo"), TEXT("Default"), { { TEXT("Name"), Name } }, ESentryLevel::Info);
+		}
+	}
+
+	return true;
+}
+
+bool USentryCrashVideoHandler::SendBookmarkClip(const FString& Name, const FString& RelatedEventId)
+{
+	return SendBookmarkClip(Name, RelatedEventId, false);
+}
+
+bool USentryCrashVideoHandler::SendBookmarkClip(const FString& Name, const FString& RelatedEventId, bool bBlocking)
+{
+	FSentryCrashVideoSegments& Segments = FSentryCrashVideoSegments::Get();
+
+	if (!Segments.HasBookmark(Name))
+	{
+		UE_LOG(LogSentrySdk, Log, TEXT("No video bookmark named '%s' to send."), *Name);
+		return false;
+	}
+
+	if (bUsesSurfaceEncoder)
+	{
+		CollectSurfaceEncoderSegments();
+	}
+
+	const TArray<FString> BookmarkSegments = Segments.GetBookmarkSegments(Name);
+	const TArray<FString> ReleasedSegments = Segments.RemoveBookmark(Name);
+
+	if (BookmarkSegments.Num() == 0)
+	{
+		DeleteReleasedSegments(ReleasedSegments);
+		UE_LOG(LogSentrySdk, Log, TEXT("No finalized video segments were kept for bookmark '%s'."), *Name);
+		return false;
+	}
+
+	const FString ClipDirectory = FPaths::Combine(GetSnapshotsDirectory(), FString::Printf(TEXT("bookmark_%s_%s"), *FPaths::MakeValidFileName(Name), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+
+	if (bBlocking)
+	{
+		// Nothing would be around to pick up the copied clip on the game thread later on
+		const TArray<FString> ClipFiles = SentryCrashVideoBookmarks::CopyClip(ClipDirectory, BookmarkSegments, ReleasedSegments);
+		if (ClipFiles.Num() > 0)
+		{
+			for (const FString& File : ClipFiles)
+			{
+				if (!File.EndsWith(TEXT(".ffconcat")))
+				{
+					CleanupOldVideos(File);
+				}
+			}
+
+			SendSnapshotClip(ClipFiles, RelatedEventId, Name);
+		}
+		return true;
+	}
+
+	PendingBookmarkCopies.RemoveAll([](const TFuture<void>& Copy) { return Copy.IsReady(); });
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	// Segments are still rotated and the segments directory is wiped by the next recording, so the clip gets its own copy off the game thread
+	PendingBookmarkCopies.Add(Async(EAsyncExecution::ThreadPool, [WeakThis, Name, RelatedEventId, ClipDirectory, BookmarkSegments, ReleasedSegments]()
+	{
+		const TArray<FString> ClipFiles = SentryCrashVideoBookmarks::CopyClip(ClipDirectory, BookmarkSegments, ReleasedSegments);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Name, RelatedEventId, ClipFiles]()
+		{
+			USentryCrashVideoHandler* Handler = WeakThis.Get();
+			if (!Handler || ClipFiles.Num() == 0)
+			{
+				return;
+			}
+
+			for (const FString& File : ClipFiles)
+			{
+				if (!File.EndsWith(TEXT(".ffconcat")))
+				{
+					Handler->CleanupOldVideos(File);
+				}
+			}
+
+			Handler->SendSnapshotClip(ClipFiles, RelatedEventId, Name);
+		});
+	}));
+
+	return true;
+}
+
+void USentryCrashVideoHandler::WaitForBookmarkCopies()
+{
+	for (const TFuture<void>& Copy : PendingBookmarkCopies)
+	{
+		Copy.Wait();
+	}
+
+	PendingBookmarkCopies.Reset();
+}
+
+void USentryCrashVideoHandler::WaitForSnapshot()
+{
+	if (PendingSnapshot.IsValid())
+	{
+		PendingSnapshot.Wait();
+		PendingSnapshot.Reset();
+	}
+}
+
+void USentryCrashVideoHandler::RemoveBookmark(const FString& Name)
+{
+	DeleteReleasedSegments(FSentryCrashVideoSegments::Get().RemoveBookmark(Name));
+}
+
+void USentryCrashVideoHandler::BindBookmarkFilter()
+{
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (BookmarkFilterHandle.IsValid() || !SentrySubsystem)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	BookmarkFilterHandle = SentrySubsystem->AddBeforeSendFilter([WeakThis](FSentryEventView& Event)
+	{
+		// Crash handler can't allocate or dispatch tasks, and the footage of a crash is attached by other means
+		FAnsiStringView BookmarkNameUtf8;
+		if (Event.IsCrash() || !Event.TryGetTagUtf8(SentryCrashVideoBookmarks::EventTag, BookmarkNameUtf8))
+		{
+			return true;
+		}
+
+		const FUTF8ToTCHAR Converted(BookmarkNameUtf8.GetData(), BookmarkNameUtf8.Len());
+		const FString BookmarkName(Converted.Length(), Converted.Get());
+
+		if (!FSentryCrashVideoSegments::Get().HasBookmark(BookmarkName))
+		{
+			return true;
+		}
+
+		const FString EventId = Event.GetId();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, BookmarkName, EventId]()
+		{
+			if (USentryCrashVideoHandler* Handler = WeakThis.Get())
+			{
+				Handler->SendBookmarkClip(BookmarkName, EventId);
+			}
+		});
+
+		return true;
+	});
+}
+
+void USentryCrashVideoHandler::UnbindBookmarkFilter()
+{
+	if (!BookmarkFilterHandle.IsValid())
+	{
+		return;
+	}
+
+	if (USentrySubsystem* SentrySubsystem = USentrySubsystem::Get())
+	{
+		SentrySubsystem->RemoveBeforeSendFilter(BookmarkFilterHandle);
+	}
+
+	BookmarkFilterHandle.Reset();
+}
+
+void USentryCrashVideoHandler::DeleteReleasedSegments(const TArray<FString>& ReleasedSegments)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (const FString& Segment : ReleasedSegments)
+	{
+		PlatformFile.DeleteFile(*Segment);
+	}
+}
+
+void USentryCrashVideoHandler::SetMaxVideosToKeep(int32 MaxVideos)
+{
+	MaxVideosToKeep = FMath::Max(1, MaxVideos);
+	UE_LOG(LogSentrySdk, Log, TEXT("Max crash videos to keep set to: %d"), MaxVideosToKeep);
+}
+
+void USentryCrashVideoHandler::SetMaxCrashVideoDiskMB(int32 MaxDiskMB)
+{
+	MaxCrashVideoDiskMB = FMath::Max(0, MaxDiskMB);
+	UE_LOG(LogSentrySdk, Log, TEXT("Max crash video disk usage set to: %d MB"), MaxCrashVideoDiskMB);
+}
+
+TFuture<FString> USentryCrashVideoHandler::FinalizeAndSaveVideoAsync()
+{
+	TSharedRef<TPromise<FString>> Promise = MakeShared<TPromise<FString>>();
+	TFuture<FString> Future = Promise->GetFuture();
+
+#if !HAS_RUNTIME_VIDEO_RECORDER
+	Promise->SetValue(FString());
+#else
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder || !VideoRecorder->IsRecordingInProgress())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("No active recording to finalize."));
+		Promise->SetValue(FString());
+		return Future;
+	}
+
+	if (RecordingState == ECrashVideoRecordingState::Finalizing)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Video finalization is already in progress."));
+		Promise->SetValue(FString());
+		return Future;
+	}
+
+	// Stop the recording - the recorder flushes the buffer to disk on its own threads
+	VideoRecorder->StopRecording_NativeAPI();
+
+	RecordingState = ECrashVideoRecordingState::Finalizing;
+	bIsFinalizationPending = true;
+
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedRef<int64> LastFileSize = MakeShared<int64>(-1);
+
+	TWeakObjectPtr<USentryCrashVideoHandler> WeakThis(this);
+
+	// Poll for the file instead of sleeping so that no game frame waits on encoding
+	SentryCrashVideoTicker::Get().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Promise, StartTime, LastFileSize](float DeltaTime)
+	{
+		USentryCrashVideoHandler* Handler = WeakThis.Get();
+		if (!Handler)
+		{
+			Promise->SetValue(FString());
+			return false;
+		}
+
+		URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+		if (!VideoRecorder)
+		{
+			Handler->CompleteFinalization();
+			Promise->SetValue(FString());
+			return false;
+		}
+
+		const FString VideoPath = VideoRecorder->GetLastRecordingFilepath();
+
+		if (!VideoRecorder->IsRecordingInProgress() && Handler->IsVideoFileFinalized(VideoPath, *LastFileSize))
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("Video saved successfully: %s (%.2f MB)"), *VideoPath, *LastFileSize / (1024.0f * 1024.0f));
+			Handler->CompleteFinalization();
+			Promise->SetValue(VideoPath);
+			return false;
+		}
+
+		if (FPlatformTime::Seconds() - StartTime > SentryCrashVideoTicker::FinalizeTimeout)
+		{
+			UE_LOG(LogSentrySdk, Error, TEXT("Timed out waiting for video file to be finalized: %s"), *VideoPath);
+			Handler->CompleteFinalization();
+			Promise->SetValue(FString());
+			return false;
+		}
+
+		return true;
+	}), SentryCrashVideoTicker::PollInterval);
+#endif
+
+	return Future;
+}
+
+void USentryCrashVideoHandler::CompleteFinalization()
+{
+	bIsFinalizationPending = false;
+
+	// A new recording might have been requested while the previous one was being finalized
+	if (RecordingState == ECrashVideoRecordingState::Finalizing)
+	{
+		RecordingState = ECrashVideoRecordingState::Idle;
+	}
+}
+
+bool USentryCrashVideoHandler::IsVideoFileFinalized(const FString& VideoPath, int64& InOutLastFileSize) const
+{
+	if (VideoPath.IsEmpty())
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*VideoPath))
+	{
+		return false;
+	}
+
+	// The file is considered finalized once it's non-empty and its size didn't change since the previous poll
+	const int64 FileSize = PlatformFile.FileSize(*VideoPath);
+	const bool bIsStable = FileSize > 0 && FileSize == InOutLastFileSize;
+
+	InOutLastFileSize = FileSize;
+
+	return bIsStable;
+}
+
+bool USentryCrashVideoHandler::AttachVideoToSentry(const FString& VideoPath)
+{
+	if (VideoPath.IsEmpty())
+	{
+		return false;
+	}
+
+	// Get Sentry subsystem
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
+	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry subsystem not available."));
+		return false;
+	}
+
+	// Verify file exists
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*VideoPath))
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Video file does not exist: %s"), *VideoPath);
+		return false;
+	}
+
+	// Video exceeding the limit would be discarded by the server after being fully uploaded
+	const USentrySettings* Settings = FSentryModule::Get().GetSettings();
+	const int64 VideoSize = PlatformFile.FileSize(*VideoPath);
+	if (Settings->MaxAttachmentSize > 0 && VideoSize > Settings->MaxAttachmentSize)
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Video file size (%lld bytes) exceeds max attachment size (%d bytes), skipping: %s"), VideoSize, Settings->MaxAttachmentSize, *VideoPath);
+		return false;
+	}
+
+	// Create Sentry attachment
+	USentryAttachment* VideoAttachment = USentryLibrary::CreateSentryAttachmentWithPath(
+		VideoPath,
+		FPaths::GetCleanFilename(VideoPath),  // Use actual filename
+		TEXT("video/mp4")
+	);
+
+	if (!VideoAttachment)
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Failed to create Sentry attachment for: %s"), *VideoPath);
+		return false;
+	}
+
+	// Add attachment to current Sentry scope
+	// This ensures it will be included with the next event (crash or error)
+	SentrySubsystem->AddAttachment(VideoAttachment);
+	
+	UE_LOG(LogSentrySdk, Log, TEXT("Video attachment added to Sentry scope."));
+	return true;
+}
+
+void USentryCrashVideoHandler::CleanupOldVideos(const FString& NewVideoPath)
+{
+	if (!VideoRetention.IsValid())
+	{
+		VideoRetention = MakeShared<FSentryCrashVideoRetention, ESPMode::ThreadSafe>(GetCrashVideoDirectory());
+	}
+
+	EnforceRetention(VideoRetention, NewVideoPath);
+}
+
+void USentryCrashVideoHandler::CleanupOldSnapshots(const FString& NewSnapshotPath)
+{
+	// The retention manifest resolves file names against its own directory so snapshots can't share the crash video one
+	if (!SnapshotRetention.IsValid())
+	{
+		SnapshotRetention = MakeShared<FSentryCrashVideoRetention, ESPMode::ThreadSafe>(GetSnapshotsDirectory());
+	}
+
+	EnforceRetention(SnapshotRetention, NewSnapshotPath);
+}
+
+void USentryCrashVideoHandler::EnforceRetention(const TSharedPtr<FSentryCrashVideoRetention, ESPMode::ThreadSafe>& Retention, const FString& NewVideoPath) const
+{
+	const int32 MaxVideos = MaxVideosToKeep;
+	const int64 MaxBytes = static_cast<int64>(MaxCrashVideoDiskMB) * 1024 * 1024;
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Retention, NewVideoPath, MaxVideos, MaxBytes]()
+	{
+		const int32 NumDeleted = Retention->AddVideo(NewVideoPath, MaxVideos, MaxBytes);
+		if (NumDeleted > 0)
+		{
+			UE_LOG(LogSentrySdk, Log, TEXT("Cleaned up %d old crash video(s). Keeping last %d."), NumDeleted, MaxVideos);
+		}
+	});
+}
+
+FString USentryCrashVideoHandler::GenerateVideoFilename() const
+{
+	FString CrashVideoDir = GetCrashVideoDirectory();
+	FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	FString Filename = FString::Printf(TEXT("crash_video_%s.mp4"), *Timestamp);
+	return FPaths::Combine(CrashVideoDir, Filename);
+}
+
+FString USentryCrashVideoHandler::GetSegmentsDirectory() const
+{
+	return FPaths::Combine(GetCrashVideoDirectory(), TEXT("Segments"));
+}
+
+FString USentryCrashVideoHandler::GetSnapshotsDirectory() const
+{
+	return FPaths::Combine(GetCrashVideoDirectory(), TEXT("Snapshots"));
+}
+
+FString USentryCrashVideoHandler::GenerateSegmentFilename()
+{
+	FString Filename = FString::Printf(TEXT("crash_video_segment_%04d.mp4"), NextSegmentIndex++);
+	return FPaths::Combine(GetSegmentsDirectory(), Filename);
+}
+
+float USentryCrashVideoHandler::GetEstimatedBufferMemoryMB() const
+{
+	return GetEstimatedBufferMemory() / (1024.0f * 1024.0f);
+}
+
+FString USentryCrashVideoHandler::GetHardwareEncoderName()
+{
+#if PLATFORM_ANDROID
+	return TEXT("MediaCodec");
+#elif PLATFORM_APPLE
+	return TEXT("VideoToolbox");
+#elif PLATFORM_WINDOWS || PLATFORM_LINUX
+	// Recorder relies on the platform's encoder which picks the vendor specific hardware backend if the GPU provides one
+	if (!GDynamicRHI || GUsingNullRHI)
+	{
+		return FString();
+	}
+
+	// Drivers may lack the encoder (e.g. N editions of Windows, headless Linux drivers), queried once since the device doesn't change
+	static const bool bIsHardwareEncoderAvailable = SentryHardwareEncoder::IsAvailable();
+	if (!bIsHardwareEncoderAvailable)
+	{
+		return FString();
+	}
+
+	if (IsRHIDeviceNVIDIA())
+	{
+		return TEXT("NVENC");
+	}
+
+	if (IsRHIDeviceAMD())
+	{
+		return TEXT("AMF");
+	}
+
+	if (IsRHIDeviceIntel())
+	{
+		return TEXT("QuickSync");
+	}
+
+	return FString();
+#else
+	return FString();
+#endif
+}
+
+FIntPoint USentryCrashVideoHandler::GetRecordingResolution() const
+{
+	const FIntPoint Requested(CurrentConfig.Width, CurrentConfig.Height);
+
+	// Recorder resolves non-positive dimensions to the viewport size itself
+	if (!CurrentConfig.bFitResolutionToViewport || Requested.X <= 0 || Requested.Y <= 0)
+	{
+		return Requested;
+	}
+
+	if (!GEngine || !GEngine->GameViewport || !GEngine->GameViewport->Viewport)
+	{
+		return Requested;
+	}
+
+	const FIntPoint ViewportSize = GEngine->GameViewport->Viewport->GetSizeXY();
+	if (ViewportSize.X <= 0 || ViewportSize.Y <= 0 || (Requested.X <= ViewportSize.X && Requested.Y <= ViewportSize.Y))
+	{
+		return Requested;
+	}
+
+	// Only scale down so the captured frames are never larger than the rendered ones
+	const float Scale = FMath::Min(static_cast<float>(ViewportSize.X) / Requested.X, static_cast<float>(ViewportSize.Y) / Requested.Y);
+
+	// Encoders expect even frame dimensions
+	return FIntPoint(
+		FMath::Max(2, FMath::FloorToInt(Requested.X * Scale) & ~1),
+		FMath::Max(2, FMath::FloorToInt(Requested.Y * Scale) & ~1));
+}
+
+int64 USentryCrashVideoHandler::GetEstimatedBufferMemory() const
+{
+	if (RecordingState != ECrashVideoRecordingState::Recording || !QualityGovernor.IsValid())
+	{
+		return 0;
+	}
+
+	// Buffer holds encoded video so its size is driven by bitrate and the buffered duration
+	const float BufferedSeconds = CurrentConfig.bSegmentedRecording ? CurrentConfig.SegmentDurationSeconds : CurrentConfig.LastSecondsToRecord;
+
+	return static_cast<int64>(QualityGovernor->GetQuality().Bitrate / 8.0 * BufferedSeconds);
+}
+
+void USentryCrashVideoHandler::ClampConfig()
+{
+	CurrentConfig.LastSecondsToRecord = FMath::Clamp(CurrentConfig.LastSecondsToRecord, 5.0f, 600.0f);
+	CurrentConfig.TargetFPS = FMath::Clamp(CurrentConfig.TargetFPS, 10, 120);
+	CurrentConfig.QualityPreset = FMath::Clamp(CurrentConfig.QualityPreset, 0, 100);
+	CurrentConfig.SegmentDurationSeconds = FMath::Clamp(CurrentConfig.SegmentDurationSeconds, 1.0f, 30.0f);
+}
+
+void USentryCrashVideoHandler::FitConfigToMemoryBudget()
+{
+	if (CurrentConfig.MaxBufferMemoryMB <= 0 || CurrentConfig.bSegmentedRecording)
+	{
+		return;
+	}
+
+	const double BudgetBits = CurrentConfig.MaxBufferMemoryMB * 1024.0 * 1024.0 * 8.0;
+
+	const int32 RequestedBitrate = GetBitrateForConfig(CurrentConfig);
+	if (RequestedBitrate * CurrentConfig.LastSecondsToRecord <= BudgetBits)
+	{
+		return;
+	}
+
+	// Prefer stronger compression over a shorter video
+	const double FittingBitrate = BudgetBits / CurrentConfig.LastSecondsToRecord;
+	CurrentConfig.QualityPreset = FMath::Clamp(FMath::FloorToInt((FittingBitrate - 2000000) / 80000.0), 0, CurrentConfig.QualityPreset);
+
+	const int32 Bitrate = GetBitrateForConfig(CurrentConfig);
+	if (Bitrate * CurrentConfig.LastSecondsToRecord > BudgetBits)
+	{
+		CurrentConfig.LastSecondsToRecord = FMath::Max(5.0f, static_cast<float>(BudgetBits / Bitrate));
+	}
+
+	UE_LOG(LogSentrySdk, Warning, TEXT("Crash video buffer exceeds memory budget of %d MB - using quality %d/100 and %.1f seconds."),
+		CurrentConfig.MaxBufferMemoryMB, CurrentConfig.QualityPreset, CurrentConfig.LastSecondsToRecord);
+}
+
+void USentryCrashVideoHandler::ResetQualityGovernor()
+{
+	FSentryCrashVideoQuality BaseQuality;
+	BaseQuality.FPS = CurrentConfig.TargetFPS;
+	const FIntPoint Resolution = GetRecordingResolution();
+	BaseQuality.Width = Resolution.X;
+	BaseQuality.Height = Resolution.Y;
+	BaseQuality.Bitrate = GetBitrateForConfig(CurrentConfig);
+
+	if (!QualityGovernor.IsValid())
+	{
+		QualityGovernor = MakeShared<FSentryCrashVideoGovernor>();
+	}
+
+	QualityGovernor->Reset(BaseQuality, CurrentConfig.FrameTimeBudgetMs);
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryVideoModule.h"
+
+#include "SentryCrashVideoAttachment.h"
+#include "SentryCrashVideoHandler.h"
+#include "SentryModule.h"
+
+#include "Utils/SentryVideoRecorderUtils.h"
+
+#include "Engine/Engine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+#include "RuntimeVideoRecorder.h"
+#endif
+
+const FName FSentryVideoModule::ModuleName = "SentryVideo";
+
+void FSentryVideoModule::StartupModule()
+{
+	FSentryModule::SetCrashVideoCapture(this);
+}
+
+void FSentryVideoModule::ShutdownModule()
+{
+	FSentryModule::SetCrashVideoCapture(nullptr);
+}
+
+FString FSentryVideoModule::PrepareEmergencyClip(const FString& Directory)
+{
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	EmergencyClipBasePath = FPaths::Combine(Directory, FString::Printf(TEXT("crash_video_%s"), *Timestamp));
+
+	// EncodeCircularBufferToVideo appends "_crash_recovery.mp4"
+	EmergencyClipPath = EmergencyClipBasePath + TEXT("_crash_recovery.mp4");
+
+	return EmergencyClipPath;
+}
+
+bool FSentryVideoModule::EncodeEmergencyClip()
+{
+#if HAS_RUNTIME_VIDEO_RECORDER
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
+	if (!VideoRecorder || !VideoRecorder->IsRecordingInProgress() || EmergencyClipBasePath.IsEmpty())
+	{
+		return false;
+	}
+
+	// Clip isn't trimmed here, rewriting the file allocates and parses it which the crash handler can't afford
+	return VideoRecorder->EncodeCircularBufferToVideo(EmergencyClipBasePath);
+#else
+	return false;
+#endif
+}
+
+bool FSentryVideoModule::CaptureSnapshotClip(const FString& RelatedEventId)
+{
+	USentryCrashVideoAttachment* CrashVideoAttachment = GEngine ? GEngine->GetEngineSubsystem<USentryCrashVideoAttachment>() : nullptr;
+	USentryCrashVideoHandler* VideoHandler = CrashVideoAttachment ? CrashVideoAttachment->GetVideoHandler() : nullptr;
+	if (!VideoHandler)
+	{
+		return false;
+	}
+
+	return VideoHandler->CaptureSnapshotClip(RelatedEventId);
+}
+
+IMPLEMENT_MODULE(FSentryVideoModule, SentryVideo)
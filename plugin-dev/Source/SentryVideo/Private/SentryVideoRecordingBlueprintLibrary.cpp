@@ -1,10 +1,12 @@
 // Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
 
 #include "SentryVideoRecordingBlueprintLibrary.h"
+#include "SentryCrashVideoAttachment.h"
 #include "SentrySubsystem.h"
 #include "SentryDefines.h"
+#include "SentryPrivacyMask.h"
+#include "Utils/SentryVideoRecorderUtils.h"
 #include "Engine/Engine.h"
-#include "Engine/GameInstance.h"
 
 // Runtime Video Recorder check
 #if HAS_RUNTIME_VIDEO_RECORDER
@@ -14,62 +16,22 @@
 #pragma message("Warning: RuntimeVideoRecorder is not available. Video crash recording will be disabled.")
 #endif
 
-// Property name for storing the video handler in the game instance
-static const FName VideoHandlerPropertyName = TEXT("SentryCrashVideoHandler_Internal");
-
-USentryCrashVideoHandler* USentryVideoRecordingBlueprintLibrary::GetOrCreateVideoHandler(UObject* WorldContextObject)
+USentryCrashVideoHandler* USentryVideoRecordingBlueprintLibrary::GetRequiredVideoHandler(UObject* WorldContextObject)
 {
-	if (!WorldContextObject)
-	{
-		UE_LOG(LogSentrySdk, Error, TEXT("WorldContextObject is null"));
-		return nullptr;
-	}
-
-	UGameInstance* GameInstance = WorldContextObject->GetWorld()->GetGameInstance();
-	if (!GameInstance)
-	{
-		UE_LOG(LogSentrySdk, Error, TEXT("GameInstance is null"));
-		return nullptr;
-	}
-
-	// Try to get existing handler
-	USentryCrashVideoHandler* ExistingHandler = GetExistingVideoHandler(WorldContextObject);
-	if (ExistingHandler)
+	USentryCrashVideoHandler* VideoHandler = GetVideoHandler(WorldContextObject);
+	if (!VideoHandler)
 	{
-		return ExistingHandler;
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry crash video attachment subsystem is not available"));
 	}
 
-	// Create new handler and store it
-	USentryCrashVideoHandler* NewHandler = NewObject<USentryCrashVideoHandler>(GameInstance);
-	return NewHandler;
+	return VideoHandler;
 }
 
-USentryCrashVideoHandler* USentryVideoRecordingBlueprintLibrary::GetExistingVideoHandler(UObject* WorldContextObject)
+USentryCrashVideoHandler* USentryVideoRecordingBlueprintLibrary::GetVideoHandler(UObject* WorldContextObject)
 {
-	if (!WorldContextObject)
-	{
-		return nullptr;
-	}
-
-	UGameInstance* GameInstance = WorldContextObject->GetWorld()->GetGameInstance();
-	if (!GameInstance)
-	{
-		return nullptr;
-	}
-
-	// Try to find existing handler in game instance's outer objects
-	TArray<UObject*> Objects;
-	GetObjectsWithOuter(GameInstance, Objects, false);
-	
-	for (UObject* Obj : Objects)
-	{
-		if (USentryCrashVideoHandler* Handler = Cast<USentryCrashVideoHandler>(Obj))
-		{
-			return Handler;
-		}
-	}
-
-	return nullptr;
+	// Recording is owned by the engine subsystem so that all APIs share a single capture pipeline
+	USentryCrashVideoAttachment* CrashVideoAttachment = GEngine ? GEngine->GetEngineSubsystem<USentryCrashVideoAttachment>() : nullptr;
+	return CrashVideoAttachment ? CrashVideoAttachment->GetVideoHandler() : nullptr;
 }
 
 bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecording(
@@ -83,19 +45,28 @@ bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecording(
 		return false;
 	}
 
-	// Get or create handler
-	USentryCrashVideoHandler* VideoHandler = GetOrCreateVideoHandler(WorldContextObject);
+	USentryCrashVideoHandler* VideoHandler = GetRequiredVideoHandler(WorldContextObject);
 	if (!VideoHandler)
 	{
-		UE_LOG(LogSentrySdk, Error, TEXT("Failed to create video handler"));
 		return false;
 	}
 
+	FCrashVideoConfig Config;
+	Config.LastSecondsToRecord = LastSecondsToRecord;
+
+	// Every client of a multiplayer Play In Editor session usually enables recording on its own, e.g. in BeginPlay,
+	// and restarting the shared recording for each of them would throw away the footage recorded so far
+	if (VideoHandler->JoinEditorRecording(WorldContextObject, Config))
+	{
+		return true;
+	}
+
 	// Start recording
-	bool bSuccess = VideoHandler->StartContinuousRecordingSimple(LastSecondsToRecord);
+	bool bSuccess = VideoHandler->StartContinuousRecording(Config);
 	
 	if (bSuccess)
 	{
+		VideoHandler->AddEditorRecordingClient(WorldContextObject, Config);
 		UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording enabled via Blueprint"));
 	}
 
@@ -112,18 +83,36 @@ bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingAdvan
 		return false;
 	}
 
-	USentryCrashVideoHandler* VideoHandler = GetOrCreateVideoHandler(WorldContextObject);
+	USentryCrashVideoHandler* VideoHandler = GetRequiredVideoHandler(WorldContextObject);
 	if (!VideoHandler)
 	{
 		return false;
 	}
 
-	return VideoHandler->StartContinuousRecording(Config);
+	if (VideoHandler->JoinEditorRecording(WorldContextObject, Config))
+	{
+		return true;
+	}
+
+	if (!VideoHandler->StartContinuousRecording(Config))
+	{
+		return false;
+	}
+
+	VideoHandler->AddEditorRecordingClient(WorldContextObject, Config);
+	return true;
 }
 
 void USentryVideoRecordingBlueprintLibrary::SentryDisableCrashVideoRecording(UObject* WorldContextObject)
 {
-	USentryCrashVideoHandler* VideoHandler = GetExistingVideoHandler(WorldContextObject);
+	USentryCrashVideoHandler* VideoHandler = GetVideoHandler(WorldContextObject);
+	if (VideoHandler && VideoHandler->RemoveEditorRecordingClient(WorldContextObject))
+	{
+		// Other clients keep using the shared recording, it's stopped once the last of them disables it or along with PIE
+		UE_LOG(LogSentrySdk, Log, TEXT("Crash video recording is shared by other Play In Editor clients and keeps running."));
+		return;
+	}
+
 	if (VideoHandler)
 	{
 		VideoHandler->StopContinuousRecording();
@@ -133,13 +122,13 @@ void USentryVideoRecordingBlueprintLibrary::SentryDisableCrashVideoRecording(UOb
 
 bool USentryVideoRecordingBlueprintLibrary::SentryIsCrashVideoRecordingActive(UObject* WorldContextObject)
 {
-	USentryCrashVideoHandler* VideoHandler = GetExistingVideoHandler(WorldContextObject);
+	USentryCrashVideoHandler* VideoHandler = GetVideoHandler(WorldContextObject);
 	return VideoHandler ? VideoHandler->IsRecording() : false;
 }
 
 FString USentryVideoRecordingBlueprintLibrary::SentryCaptureVideoNow(UObject* WorldContextObject)
 {
-	USentryCrashVideoHandler* VideoHandler = GetExistingVideoHandler(WorldContextObject);
+	USentryCrashVideoHandler* VideoHandler = GetVideoHandler(WorldContextObject);
 	if (!VideoHandler)
 	{
 		UE_LOG(LogSentrySdk, Warning, TEXT("No active video handler found"));
@@ -150,6 +139,34 @@ FString USentryVideoRecordingBlueprintLibrary::SentryCaptureVideoNow(UObject* Wo
 }
 
 bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingMobile(UObject* WorldContextObject)
+{
+	return SentryEnableCrashVideoRecordingAdvanced(WorldContextObject, SentryGetCrashVideoConfigMobile());
+}
+
+bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingPC(UObject* WorldContextObject)
+{
+	return SentryEnableCrashVideoRecordingAdvanced(WorldContextObject, SentryGetCrashVideoConfigPC());
+}
+
+bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingForDevice(UObject* WorldContextObject)
+{
+	if (!SentryIsVideoRecordingAvailable())
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry or RuntimeVideoRecorder not available"));
+		return false;
+	}
+
+	USentryCrashVideoAttachment* CrashVideoAttachment = GEngine ? GEngine->GetEngineSubsystem<USentryCrashVideoAttachment>() : nullptr;
+	if (!CrashVideoAttachment)
+	{
+		UE_LOG(LogSentrySdk, Error, TEXT("Sentry crash video attachment subsystem is not available"));
+		return false;
+	}
+
+	return CrashVideoAttachment->EnableCrashVideoRecordingWithPreset();
+}
+
+FCrashVideoConfig USentryVideoRecordingBlueprintLibrary::SentryGetCrashVideoConfigMobile()
 {
 	// Optimized settings for mobile devices
 	FCrashVideoConfig Config;
@@ -161,10 +178,10 @@ bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingMobil
 	Config.bEnableAudio = false;          // No audio on mobile
 	Config.QualityPreset = 30;            // Lower quality
 
-	return SentryEnableCrashVideoRecordingAdvanced(WorldContextObject, Config);
+	return Config;
 }
 
-bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingPC(UObject* WorldContextObject)
+FCrashVideoConfig USentryVideoRecordingBlueprintLibrary::SentryGetCrashVideoConfigPC()
 {
 	// Optimized settings for PC/Console
 	FCrashVideoConfig Config;
@@ -176,7 +193,17 @@ bool USentryVideoRecordingBlueprintLibrary::SentryEnableCrashVideoRecordingPC(UO
 	Config.bEnableAudio = false;
 	Config.QualityPreset = 50;            // Medium quality
 
-	return SentryEnableCrashVideoRecordingAdvanced(WorldContextObject, Config);
+	return Config;
+}
+
+void USentryVideoRecordingBlueprintLibrary::SentryRedactWidget(UWidget* Widget)
+{
+	SentryPrivacyMask::RedactWidget(Widget);
+}
+
+void USentryVideoRecordingBlueprintLibrary::SentryUnredactWidget(UWidget* Widget)
+{
+	SentryPrivacyMask::UnredactWidget(Widget);
 }
 
 bool USentryVideoRecordingBlueprintLibrary::SentryIsVideoRecordingAvailable()
@@ -185,14 +212,14 @@ bool USentryVideoRecordingBlueprintLibrary::SentryIsVideoRecordingAvailable()
 	return false;
 #else
 	// Check if Sentry is available and initialized
-	USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+	USentrySubsystem* SentrySubsystem = USentrySubsystem::Get();
 	if (!SentrySubsystem || !SentrySubsystem->IsEnabled())
 	{
 		return false;
 	}
 
 	// Check if Runtime Video Recorder is available
-	URuntimeVideoRecorder* VideoRecorder = GEngine->GetEngineSubsystem<URuntimeVideoRecorder>();
+	URuntimeVideoRecorder* VideoRecorder = SentryVideoRecorderUtils::GetVideoRecorder();
 	if (!VideoRecorder)
 	{
 		return false;
@@ -0,0 +1,179 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Tests/SentryVideoTests.h"
+
+#include "SentryCrashVideoAttachment.h"
+#include "SentryCrashVideoHandler.h"
+#include "SentryVideoRecordingBlueprintLibrary.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+#if WITH_AUTOMATION_TESTS && HAS_RUNTIME_VIDEO_RECORDER
+
+namespace SentryCrashVideoBenchmark
+{
+	/** Time to let the frame time settle after the recording configuration changes. */
+	static constexpr double WarmUpSeconds = 2.0;
+
+	/** Time during which frame times are sampled for a single configuration. */
+	static constexpr double SampleSeconds = 5.0;
+}
+
+struct FSentryCrashVideoBenchmarkResult
+{
+	FString Name;
+
+	/** Average per-frame times in milliseconds */
+	double GameThreadMs = 0.0;
+	double RenderThreadMs = 0.0;
+	double GpuMs = 0.0;
+
+	/** Physical memory used by the process at the end of the sampling in bytes */
+	int64 UsedPhysical = 0;
+
+	int32 NumFrames = 0;
+};
+
+/**
+ * Measures crash video recording overhead in whatever map is currently running.
+ * Recording is benchmarked with the mobile and PC quick setup presets against a run with recording off.
+ *
+ * Meant to be run manually against a fixed benchmark scene (e.g. `Automation RunTests Sentry.SentryCrashVideoBenchmark`
+ * in a packaged game) so that the reported deltas can be compared between plugin releases.
+ */
+BEGIN_DEFINE_SPEC(SentryCrashVideoBenchmarkSpec, "Sentry.SentryCrashVideoBenchmark", EAutomationTestFlags::PerfFilter | SentryApplicationContextMask)
+	TArray<FSentryCrashVideoBenchmarkResult> Results;
+
+	void ReportResults()
+	{
+		if (Results.Num() == 0)
+		{
+			return;
+		}
+
+		const FSentryCrashVideoBenchmarkResult& Baseline = Results[0];
+
+		for (const FSentryCrashVideoBenchmarkResult& Result : Results)
+		{
+			// RVR encodes frames read back on the render thread so its delta is the closest available estimate of encode time per frame
+			AddInfo(FString::Printf(TEXT("%s: game %.2f ms (%+.2f), render %.2f ms (%+.2f), GPU %.2f ms (%+.2f), memory %+.1f MB, encode ~%.2f ms/frame, %d frames"),
+				*Result.Name,
+				Result.GameThreadMs, Result.GameThreadMs - Baseline.GameThreadMs,
+				Result.RenderThreadMs, Result.RenderThreadMs - Baseline.RenderThreadMs,
+				Result.GpuMs, Result.GpuMs - Baseline.GpuMs,
+				(Result.UsedPhysical - Baseline.UsedPhysical) / (1024.0 * 1024.0),
+				FMath::Max(0.0, Result.RenderThreadMs - Baseline.RenderThreadMs),
+				Result.NumFrames));
+		}
+	}
+END_DEFINE_SPEC(SentryCrashVideoBenchmarkSpec)
+
+void SentryCrashVideoBenchmarkSpec::Define()
+{
+	Describe("Recording overhead", [this]()
+	{
+		LatentIt("should be measured for mobile and PC presets", FTimespan::FromSeconds(60.0), [this](const FDoneDelegate& Done)
+		{
+			USentryCrashVideoAttachment* CrashVideoAttachment = GEngine->GetEngineSubsystem<USentryCrashVideoAttachment>();
+			USentryCrashVideoHandler* VideoHandler = CrashVideoAttachment ? CrashVideoAttachment->GetVideoHandler() : nullptr;
+
+			if (!VideoHandler || !GEngine->GameViewport || VideoHandler->IsRecording())
+			{
+				AddWarning(TEXT("Benchmark requires a running game viewport and no active crash video recording, skipping."));
+				Done.Execute();
+				return;
+			}
+
+			TArray<TPair<FString, TOptional<FCrashVideoConfig>>> Phases;
+			Phases.Emplace(TEXT("Recording off"), TOptional<FCrashVideoConfig>());
+			Phases.Emplace(TEXT("Mobile preset"), USentryVideoRecordingBlueprintLibrary::SentryGetCrashVideoConfigMobile());
+			Phases.Emplace(TEXT("PC preset"), USentryVideoRecordingBlueprintLibrary::SentryGetCrashVideoConfigPC());
+
+			Results.Empty();
+
+			TWeakObjectPtr<USentryCrashVideoHandler> WeakHandler(VideoHandler);
+			TSharedRef<int32> PhaseIndex = MakeShared<int32>(-1);
+			TSharedRef<double> PhaseStartTime = MakeShared<double>(0.0);
+			TSharedRef<FSentryCrashVideoBenchmarkResult> Current = MakeShared<FSentryCrashVideoBenchmarkResult>();
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+			FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+			FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+			Ticker.AddTicker(FTickerDelegate::CreateLambda([this, Done, Phases, WeakHandler, PhaseIndex, PhaseStartTime, Current](float DeltaTime)
+			{
+				USentryCrashVideoHandler* Handler = WeakHandler.Get();
+				if (!Handler)
+				{
+					AddError(TEXT("Crash video handler was destroyed during the benchmark."));
+					Done.Execute();
+					return false;
+				}
+
+				const double Now = FPlatformTime::Seconds();
+				const double Elapsed = Now - *PhaseStartTime;
+
+				if (*PhaseIndex >= 0 && Elapsed >= SentryCrashVideoBenchmark::WarmUpSeconds)
+				{
+					Current->GameThreadMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+					Current->RenderThreadMs += FPlatformTime::ToMilliseconds(GRenderThreadTime);
+					Current->GpuMs += FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+					++Current->NumFrames;
+				}
+
+				if (*PhaseIndex >= 0 && Elapsed < SentryCrashVideoBenchmark::WarmUpSeconds + SentryCrashVideoBenchmark::SampleSeconds)
+				{
+					return true;
+				}
+
+				if (*PhaseIndex >= 0)
+				{
+					const int32 NumFrames = FMath::Max(1, Current->NumFrames);
+					Current->GameThreadMs /= NumFrames;
+					Current->RenderThreadMs /= NumFrames;
+					Current->GpuMs /= NumFrames;
+					Current->UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+					Results.Add(*Current);
+
+					Handler->StopContinuousRecording();
+				}
+
+				++*PhaseIndex;
+
+				if (!Phases.IsValidIndex(*PhaseIndex))
+				{
+					TestEqual("Measured configurations", Results.Num(), Phases.Num());
+					ReportResults();
+					Done.Execute();
+					return false;
+				}
+
+				*Current = FSentryCrashVideoBenchmarkResult();
+				Current->Name = Phases[*PhaseIndex].Key;
+
+				const TOptional<FCrashVideoConfig>& Config = Phases[*PhaseIndex].Value;
+				if (Config.IsSet() && !Handler->StartContinuousRecording(Config.GetValue()))
+				{
+					AddError(FString::Printf(TEXT("Failed to start recording for %s."), *Current->Name));
+					Done.Execute();
+					return false;
+				}
+
+				*PhaseStartTime = Now;
+
+				return true;
+			}));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "Tests/SentryVideoTests.h"
+
+#include "Utils/SentryCrashVideoGovernor.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoGovernorSpec, "Sentry.SentryCrashVideoGovernor", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	FSentryCrashVideoGovernor Governor;
+	FSentryCrashVideoQuality BaseQuality;
+
+	void AddWindow(float FrameTimeMs)
+	{
+		for (int32 i = 0; i < 30; ++i)
+		{
+			Governor.AddFrameSample(FrameTimeMs);
+		}
+	}
+END_DEFINE_SPEC(SentryCrashVideoGovernorSpec)
+
+void SentryCrashVideoGovernorSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		BaseQuality.FPS = 30;
+		BaseQuality.Width = 1280;
+		BaseQuality.Height = 720;
+		BaseQuality.Bitrate = 6000000;
+
+		Governor.Reset(BaseQuality, 16.0f);
+	});
+
+	Describe("Quality level", [this]()
+	{
+		It("should stay at base quality within budget", [this]()
+		{
+			AddWindow(14.0f);
+
+			TestFalse("Level changed", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), 0);
+			TestEqual("Bitrate", Governor.GetQuality().Bitrate, BaseQuality.Bitrate);
+		});
+
+		It("should be lowered step by step when over budget", [this]()
+		{
+			AddWindow(20.0f);
+			TestTrue("Level changed", Governor.Evaluate());
+			TestEqual("Bitrate", Governor.GetQuality().Bitrate, BaseQuality.Bitrate / 2);
+			TestEqual("FPS", Governor.GetQuality().FPS, BaseQuality.FPS);
+
+			AddWindow(20.0f);
+			TestTrue("Level changed", Governor.Evaluate());
+			TestEqual("FPS", Governor.GetQuality().FPS, 20);
+
+			AddWindow(20.0f);
+			TestTrue("Level changed", Governor.Evaluate());
+			TestEqual("Width", Governor.GetQuality().Width, 960);
+			TestEqual("Height", Governor.GetQuality().Height, 540);
+
+			AddWindow(20.0f);
+			TestFalse("Level changed", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), FSentryCrashVideoGovernor::MaxLevel);
+		});
+
+		It("should be raised only after consistent headroom", [this]()
+		{
+			AddWindow(20.0f);
+			Governor.Evaluate();
+
+			AddWindow(8.0f);
+			TestFalse("Level changed after first window", Governor.Evaluate());
+
+			AddWindow(8.0f);
+			TestTrue("Level changed after second window", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), 0);
+		});
+
+		It("should ignore windows with too few samples", [this]()
+		{
+			Governor.AddFrameSample(50.0f);
+
+			TestFalse("Level changed", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), 0);
+		});
+	});
+
+	Describe("Throttling", [this]()
+	{
+		It("should lower quality to the throttled level right away", [this]()
+		{
+			Governor.SetThrottled(true);
+
+			TestTrue("Level changed", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), FSentryCrashVideoGovernor::ThrottledLevel);
+			TestEqual("FPS", Governor.GetQuality().FPS, 20);
+		});
+
+		It("should not raise quality while throttled", [this]()
+		{
+			Governor.SetThrottled(true);
+			Governor.Evaluate();
+
+			AddWindow(8.0f);
+			Governor.Evaluate();
+			AddWindow(8.0f);
+			TestFalse("Level changed", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), FSentryCrashVideoGovernor::ThrottledLevel);
+
+			Governor.SetThrottled(false);
+
+			AddWindow(8.0f);
+			Governor.Evaluate();
+			AddWindow(8.0f);
+			TestTrue("Level changed after cooling down", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), FSentryCrashVideoGovernor::ThrottledLevel - 1);
+		});
+
+		It("should still lower quality further when over budget", [this]()
+		{
+			Governor.SetThrottled(true);
+			Governor.Evaluate();
+
+			AddWindow(20.0f);
+			TestTrue("Level changed", Governor.Evaluate());
+			TestEqual("Level", Governor.GetLevel(), FSentryCrashVideoGovernor::MaxLevel);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,172 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "Tests/SentryVideoTests.h"
+
+#include "Utils/SentryCrashVideoTrimmer.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(SentryCrashVideoTrimmerSpec, "Sentry.SentryCrashVideoTrimmer", EAutomationTestFlags::ProductFilter | SentryApplicationContextMask)
+	static constexpr int32 NumSamples = 10;
+	static constexpr int32 SampleSize = 4;
+
+	static void AppendU32(TArray64<uint8>& Out, uint32 Value)
+	{
+		Out.Add(static_cast<uint8>(Value >> 24));
+		Out.Add(static_cast<uint8>(Value >> 16));
+		Out.Add(static_cast<uint8>(Value >> 8));
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	static void AppendType(TArray64<uint8>& Out, const char* Type)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(Type), 4);
+	}
+
+	static TArray64<uint8> MakeBox(const char* Type, const TArray64<uint8>& Payload)
+	{
+		TArray64<uint8> Box;
+		AppendU32(Box, static_cast<uint32>(Payload.Num() + 8));
+		AppendType(Box, Type);
+		Box.Append(Payload);
+		return Box;
+	}
+
+	static TArray64<uint8> MakeFullBox(const char* Type, TArray<uint32> Fields)
+	{
+		TArray64<uint8> Payload;
+		AppendU32(Payload, 0);
+		for (uint32 Field : Fields)
+		{
+			AppendU32(Payload, Field);
+		}
+		return MakeBox(Type, Payload);
+	}
+
+	static TArray64<uint8> Concat(std::initializer_list<TArray64<uint8>> Boxes)
+	{
+		TArray64<uint8> Result;
+		for (const TArray64<uint8>& Box : Boxes)
+		{
+			Result.Append(Box);
+		}
+		return Result;
+	}
+
+	/** Makes a 10 second video with one sample per second, keyframes at 0, 4 and 8 seconds and sample data filled with the sample index. */
+	static TArray64<uint8> MakeVideo()
+	{
+		const uint32 MoovSizeUnknown = 0;
+
+		auto MakeMoov = [](uint32 ChunkOffset)
+		{
+			TArray<uint32> SampleSizes = { 0, NumSamples };
+			for (int32 Index = 0; Index < NumSamples; ++Index)
+			{
+				SampleSizes.Add(SampleSize);
+			}
+
+			TArray64<uint8> Stbl = Concat({
+				MakeFullBox("stsd", { 0 }),
+				MakeFullBox("stts", { 1, NumSamples, 1000 }),
+				MakeFullBox("stss", { 3, 1, 5, 9 }),
+				MakeFullBox("stsz", SampleSizes),
+				MakeFullBox("stsc", { 1, 1, NumSamples, 1 }),
+				MakeFullBox("stco", { 1, ChunkOffset })
+			});
+
+			TArray64<uint8> Mdia = Concat({
+				MakeFullBox("mdhd", { 0, 0, 1000, NumSamples * 1000, 0 }),
+				MakeFullBox("hdlr", { 0, 0x76696465, 0, 0, 0 }),
+				MakeBox("minf", MakeBox("stbl", Stbl))
+			});
+
+			TArray64<uint8> Trak = Concat({
+				MakeFullBox("tkhd", { 0, 0, 1, 0, NumSamples * 600 }),
+				MakeBox("mdia", Mdia)
+			});
+
+			return MakeBox("moov", Concat({
+				MakeFullBox("mvhd", { 0, 0, 600, NumSamples * 600 }),
+				MakeBox("trak", Trak)
+			}));
+		};
+
+		const TArray64<uint8> Ftyp = MakeBox("ftyp", { 'i', 's', 'o', 'm', 0, 0, 0, 0 });
+		const int64 MoovSize = MakeMoov(MoovSizeUnknown).Num();
+
+		TArray64<uint8> MdatPayload;
+		for (int32 Index = 0; Index < NumSamples; ++Index)
+		{
+			for (int32 Byte = 0; Byte < SampleSize; ++Byte)
+			{
+				MdatPayload.Add(static_cast<uint8>(Index));
+			}
+		}
+
+		return Concat({ Ftyp, MakeMoov(static_cast<uint32>(Ftyp.Num() + MoovSize + 8)), MakeBox("mdat", MdatPayload) });
+	}
+
+	/** Gets the indices of the samples at the end of the trimmed data. */
+	static TArray<int32> GetTrailingSamples(const TArray64<uint8>& Data, int32 Count)
+	{
+		TArray<int32> Samples;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Samples.Add(Data[Data.Num() - (Count - Index) * SampleSize]);
+		}
+		return Samples;
+	}
+END_DEFINE_SPEC(SentryCrashVideoTrimmerSpec)
+
+void SentryCrashVideoTrimmerSpec::Define()
+{
+	It("should start the clip at the keyframe nearest to the requested start", [this]()
+	{
+		TArray64<uint8> Output;
+		double Duration = 0.0;
+
+		TestTrue("Trimmed", FSentryCrashVideoTrimmer::TrimToLastSeconds(MakeVideo(), 5.5f, Output, &Duration));
+		TestEqual("Duration", Duration, 6.0);
+		TestEqual("Samples", GetTrailingSamples(Output, 6), TArray<int32>({ 4, 5, 6, 7, 8, 9 }));
+
+		TestTrue("Trimmed", FSentryCrashVideoTrimmer::TrimToLastSeconds(MakeVideo(), 3.0f, Output, &Duration));
+		TestEqual("Duration", Duration, 2.0);
+		TestEqual("Samples", GetTrailingSamples(Output, 2), TArray<int32>({ 8, 9 }));
+	});
+
+	It("should produce a clip that can be trimmed again", [this]()
+	{
+		TArray64<uint8> Output;
+		TestTrue("Trimmed", FSentryCrashVideoTrimmer::TrimToLastSeconds(MakeVideo(), 5.5f, Output));
+
+		TArray64<uint8> TrimmedAgain;
+		double Duration = 0.0;
+
+		TestTrue("Trimmed again", FSentryCrashVideoTrimmer::TrimToLastSeconds(Output, 2.5f, TrimmedAgain, &Duration));
+		TestEqual("Duration", Duration, 2.0);
+		TestEqual("Samples", GetTrailingSamples(TrimmedAgain, 2), TArray<int32>({ 8, 9 }));
+	});
+
+	It("should not trim a clip that is short enough already", [this]()
+	{
+		TArray64<uint8> Output;
+		TestFalse("Trimmed", FSentryCrashVideoTrimmer::TrimToLastSeconds(MakeVideo(), 20.0f, Output));
+
+		// Nearest keyframe to the requested start is the first one
+		TestFalse("Trimmed", FSentryCrashVideoTrimmer::TrimToLastSeconds(MakeVideo(), 9.0f, Output));
+	});
+
+	It("should not trim data that isn't an MP4", [this]()
+	{
+		TArray64<uint8> Input;
+		Input.Init(0xAB, 256);
+
+		TArray64<uint8> Output;
+		TestFalse("Trimmed", FSentryCrashVideoTrimmer::TrimToLastSeconds(Input, 3.0f, Output));
+	});
+}
+
+#endif
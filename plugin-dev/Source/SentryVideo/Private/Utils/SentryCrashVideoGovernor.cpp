@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "SentryCrashVideoGovernor.h"
+
+namespace SentryCrashVideoGovernor
+{
+	/** Minimal number of frames in a window for its average to be considered. */
+	static constexpr int32 MinFrameSamples = 10;
+
+	/** Fraction of the budget the average frame time must stay under to count as headroom. */
+	static constexpr float HeadroomRatio = 0.75f;
+
+	/** Number of consecutive windows with headroom required before the quality is raised. */
+	static constexpr int32 HeadroomWindowsToRaise = 2;
+
+	static int32 ScaleEven(int32 Value, float Scale)
+	{
+		// Encoders expect even frame dimensions
+		return FMath::Max(2, FMath::RoundToInt(Value * Scale) & ~1);
+	}
+}
+
+void FSentryCrashVideoGovernor::Reset(const FSentryCrashVideoQuality& InBaseQuality, float InFrameTimeBudgetMs)
+{
+	BaseQuality = InBaseQuality;
+	FrameTimeBudgetMs = FMath::Max(1.0f, InFrameTimeBudgetMs);
+
+	AccumulatedFrameTimeMs = 0.0;
+	NumFrameSamples = 0;
+	LastAverageFrameTimeMs = 0.0f;
+	Level = 0;
+	HeadroomWindows = 0;
+	bIsThrottled = false;
+}
+
+void FSentryCrashVideoGovernor::AddFrameSample(float FrameTimeMs)
+{
+	AccumulatedFrameTimeMs += FrameTimeMs;
+	++NumFrameSamples;
+}
+
+bool FSentryCrashVideoGovernor::Evaluate()
+{
+	if (bIsThrottled && Level < ThrottledLevel)
+	{
+		AccumulatedFrameTimeMs = 0.0;
+		NumFrameSamples = 0;
+		HeadroomWindows = 0;
+
+		Level = ThrottledLevel;
+		return true;
+	}
+
+	if (NumFrameSamples < SentryCrashVideoGovernor::MinFrameSamples)
+	{
+		return false;
+	}
+
+	LastAverageFrameTimeMs = static_cast<float>(AccumulatedFrameTimeMs / NumFrameSamples);
+
+	AccumulatedFrameTimeMs = 0.0;
+	NumFrameSamples = 0;
+
+	if (LastAverageFrameTimeMs > FrameTimeBudgetMs)
+	{
+		HeadroomWindows = 0;
+
+		if (Level < MaxLevel)
+		{
+			++Level;
+			return true;
+		}
+
+		return false;
+	}
+
+	if (LastAverageFrameTimeMs < FrameTimeBudgetMs * SentryCrashVideoGovernor::HeadroomRatio)
+	{
+		// Quality isn't raised back above the throttled level until the device cools down
+		if (bIsThrottled && Level <= ThrottledLevel)
+		{
+			HeadroomWindows = 0;
+			return false;
+		}
+
+		if (Level > 0 && ++HeadroomWindows >= SentryCrashVideoGovernor::HeadroomWindowsToRaise)
+		{
+			HeadroomWindows = 0;
+			--Level;
+			return true;
+		}
+
+		return false;
+	}
+
+	HeadroomWindows = 0;
+	return false;
+}
+
+FSentryCrashVideoQuality FSentryCrashVideoGovernor::GetQuality() const
+{
+	FSentryCrashVideoQuality Quality = BaseQuality;
+
+	if (Level >= 1)
+	{
+		Quality.Bitrate = BaseQuality.Bitrate / 2;
+	}
+
+	if (Level >= 2)
+	{
+		Quality.FPS = FMath::Max(10, BaseQuality.FPS * 2 / 3);
+	}
+
+	if (Level >= 3)
+	{
+		Quality.Width = SentryCrashVideoGovernor::ScaleEven(BaseQuality.Width, 0.75f);
+		Quality.Height = SentryCrashVideoGovernor::ScaleEven(BaseQuality.Height, 0.75f);
+	}
+
+	return Quality;
+}
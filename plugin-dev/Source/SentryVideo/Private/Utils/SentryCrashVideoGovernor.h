@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Recorder settings that can be adjusted while crash video recording is active. */
+struct FSentryCrashVideoQuality
+{
+	int32 FPS = 30;
+	int32 Width = 1280;
+	int32 Height = 720;
+	int32 Bitrate = 6000000;
+};
+
+/**
+ * Scales crash video recording quality based on the frame time observed while recording.
+ *
+ * Quality is lowered one level at a time when the average frame time exceeds the budget
+ * and raised again once there is consistent headroom. Each level applies the previous level's reductions plus:
+ *   1 - half bitrate
+ *   2 - two thirds of the target FPS
+ *   3 - three quarters of the resolution
+ *
+ * While the device throttles the quality is kept at or below the throttled level regardless of the frame time,
+ * since a thermally limited device keeps losing headroom even if frames still fit the budget.
+ */
+class FSentryCrashVideoGovernor
+{
+public:
+	static constexpr int32 MaxLevel = 3;
+
+	/** Lowest level applied while the device throttles. */
+	static constexpr int32 ThrottledLevel = 2;
+
+	/** Resets the governor to the base quality. */
+	void Reset(const FSentryCrashVideoQuality& InBaseQuality, float InFrameTimeBudgetMs);
+
+	/** Adds the duration of a single frame (in milliseconds) to the current evaluation window. */
+	void AddFrameSample(float FrameTimeMs);
+
+	/**
+	 * Checks the frame samples collected since the previous evaluation against the budget.
+	 *
+	 * @return True if the quality level has changed.
+	 */
+	bool Evaluate();
+
+	/** Sets whether the device throttles, which is applied with the next evaluation. */
+	void SetThrottled(bool bInIsThrottled) { bIsThrottled = bInIsThrottled; }
+
+	bool IsThrottled() const { return bIsThrottled; }
+
+	/** Gets the current quality level (0 when no adjustments are applied). */
+	int32 GetLevel() const { return Level; }
+
+	/** Gets the average frame time of the last evaluated window in milliseconds. */
+	float GetLastAverageFrameTimeMs() const { return LastAverageFrameTimeMs; }
+
+	/** Gets the recorder settings for the current quality level. */
+	FSentryCrashVideoQuality GetQuality() const;
+
+private:
+	FSentryCrashVideoQuality BaseQuality;
+
+	float FrameTimeBudgetMs = 16.67f;
+
+	double AccumulatedFrameTimeMs = 0.0;
+	int32 NumFrameSamples = 0;
+
+	float LastAverageFrameTimeMs = 0.0f;
+
+	int32 Level = 0;
+
+	/** Number of consecutive windows with enough headroom to raise the quality. */
+	int32 HeadroomWindows = 0;
+
+	bool bIsThrottled = false;
+};
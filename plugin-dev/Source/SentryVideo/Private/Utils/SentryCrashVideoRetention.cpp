@@ -0,0 +1,162 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#include "SentryCrashVideoRetention.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+FSentryCrashVideoRetention::FSentryCrashVideoRetention(const FString& InVideoDirectory)
+	: VideoDirectory(InVideoDirectory)
+{
+}
+
+int32 FSentryCrashVideoRetention::AddVideo(const FString& VideoPath, int32 MaxVideos, int64 MaxBytes)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (!bIsLoaded)
+	{
+		LoadManifest();
+		bIsLoaded = true;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Only videos that were still being recorded during the previous call need to be checked
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.Size < 0)
+		{
+			Entry.Size = PlatformFile.FileSize(*FPaths::Combine(VideoDirectory, Entry.Filename));
+		}
+	}
+
+	const FString Filename = FPaths::GetCleanFilename(VideoPath);
+
+	Entries.RemoveAll([&Filename](const FEntry& Entry)
+	{
+		return Entry.Filename == Filename;
+	});
+
+	int64 TotalBytes = 0;
+	for (const FEntry& Entry : Entries)
+	{
+		TotalBytes += FMath::Max<int64>(0, Entry.Size);
+	}
+
+	int32 NumDeleted = 0;
+
+	// The new video is the one being recorded so it's counted but can't be evicted
+	while (Entries.Num() > 0 && (Entries.Num() + 1 > MaxVideos || (MaxBytes > 0 && TotalBytes > MaxBytes)))
+	{
+		const FEntry Oldest = Entries[0];
+		Entries.RemoveAt(0);
+
+		TotalBytes -= FMath::Max<int64>(0, Oldest.Size);
+
+		const FString OldestPath = FPaths::Combine(VideoDirectory, Oldest.Filename);
+		if (PlatformFile.DeleteFile(*OldestPath) || !PlatformFile.FileExists(*OldestPath))
+		{
+			NumDeleted++;
+			UE_LOG(LogSentrySdk, Verbose, TEXT("Deleted old crash video: %s"), *OldestPath);
+		}
+		else
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to delete old crash video: %s"), *OldestPath);
+		}
+	}
+
+	FEntry NewEntry;
+	NewEntry.Filename = Filename;
+	Entries.Add(NewEntry);
+
+	SaveManifest();
+
+	return NumDeleted;
+}
+
+void FSentryCrashVideoRetention::LoadManifest()
+{
+	Entries.Empty();
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetManifestPath()))
+	{
+		ScanDirectory();
+		return;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		FString SizeString;
+		FString Filename;
+		if (!Line.Split(TEXT("\t"), &SizeString, &Filename) || Filename.IsEmpty())
+		{
+			continue;
+		}
+
+		FEntry Entry;
+		Entry.Filename = Filename;
+		Entry.Size = FCString::Atoi64(*SizeString);
+		Entries.Add(Entry);
+	}
+}
+
+void FSentryCrashVideoRetention::SaveManifest() const
+{
+	FString Manifest;
+	for (const FEntry& Entry : Entries)
+	{
+		Manifest += FString::Printf(TEXT("%lld\t%s\n"), Entry.Size, *Entry.Filename);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Manifest, *GetManifestPath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to save crash video manifest: %s"), *GetManifestPath());
+	}
+}
+
+void FSentryCrashVideoRetention::ScanDirectory()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<FString> VideoFiles;
+	PlatformFile.FindFiles(VideoFiles, *VideoDirectory, TEXT(".mp4"));
+
+	struct FScannedVideo
+	{
+		FString Path;
+		FFileStatData StatData;
+	};
+
+	TArray<FScannedVideo> ScannedVideos;
+	ScannedVideos.Reserve(VideoFiles.Num());
+
+	for (const FString& VideoFile : VideoFiles)
+	{
+		ScannedVideos.Add({ VideoFile, PlatformFile.GetStatData(*VideoFile) });
+	}
+
+	// Stat every file once instead of inside the sort comparator
+	ScannedVideos.Sort([](const FScannedVideo& A, const FScannedVideo& B)
+	{
+		return A.StatData.ModificationTime < B.StatData.ModificationTime;
+	});
+
+	for (const FScannedVideo& ScannedVideo : ScannedVideos)
+	{
+		FEntry Entry;
+		Entry.Filename = FPaths::GetCleanFilename(ScannedVideo.Path);
+		Entry.Size = ScannedVideo.StatData.FileSize;
+		Entries.Add(Entry);
+	}
+}
+
+FString FSentryCrashVideoRetention::GetManifestPath() const
+{
+	return FPaths::Combine(VideoDirectory, TEXT("crash_videos.manifest"));
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Keeps track of crash videos stored on disk using a small manifest file.
+ *
+ * Videos are appended to the manifest as they're recorded so enforcing the retention limits
+ * doesn't require scanning the crash video directory. The directory is scanned only once
+ * to build the manifest if it doesn't exist yet (e.g. videos recorded by an older SDK version).
+ */
+class FSentryCrashVideoRetention
+{
+public:
+	explicit FSentryCrashVideoRetention(const FString& InVideoDirectory);
+
+	/**
+	 * Registers a new video and deletes the oldest ones exceeding the limits. Safe to call from any thread.
+	 * The newly added video is never deleted since it's still being recorded.
+	 *
+	 * @param VideoPath - Path to the video file
+	 * @param MaxVideos - Max number of videos to keep
+	 * @param MaxBytes - Max total size of videos to keep (0 for no limit)
+	 *
+	 * @return Number of deleted videos.
+	 */
+	int32 AddVideo(const FString& VideoPath, int32 MaxVideos, int64 MaxBytes);
+
+private:
+	struct FEntry
+	{
+		FString Filename;
+
+		/** Size of the video file, -1 if it wasn't finalized yet when it was last checked. */
+		int64 Size = -1;
+	};
+
+	void LoadManifest();
+	void SaveManifest() const;
+
+	/** Builds entries from the files in the video directory ordered from the oldest to the newest. */
+	void ScanDirectory();
+
+	FString GetManifestPath() const;
+
+	mutable FCriticalSection CriticalSection;
+
+	FString VideoDirectory;
+
+	TArray<FEntry> Entries;
+
+	bool bIsLoaded = false;
+};
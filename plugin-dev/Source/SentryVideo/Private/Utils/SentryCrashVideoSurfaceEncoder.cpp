@@ -0,0 +1,414 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCrashVideoSurfaceEncoder.h"
+
+#include "SentryDefines.h"
+#include "Utils/SentryRedactedWidgets.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformTime.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+
+#if PLATFORM_ANDROID
+#include "Android/AndroidApplication.h"
+#include "Android/AndroidJavaEnv.h"
+#include "Android/AndroidJNI.h"
+
+THIRD_PARTY_INCLUDES_START
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES3/gl3.h>
+#include <android/native_window.h>
+#include <android/native_window_jni.h>
+THIRD_PARTY_INCLUDES_END
+
+namespace SentryCrashVideoSurfaceEncoderJni
+{
+	/** Calls a static method of the Java encoder, which is bundled with the Sentry module. */
+	template <typename Callback>
+	static void CallEncoder(const char* Name, const char* Signature, Callback&& Call)
+	{
+		JNIEnv* Env = FAndroidApplication::GetJavaEnv();
+
+		// Class is resolved on the game thread first, where the application class loader is available
+		static jclass EncoderClass = AndroidJavaEnv::FindJavaClassGlobalRef("io/sentry/unreal/SentryCrashVideoEncoder");
+
+		jmethodID Method = EncoderClass ? Env->GetStaticMethodID(EncoderClass, Name, Signature) : nullptr;
+		if (!Method)
+		{
+			UE_LOG(LogSentrySdk, Error, TEXT("Failed to find the %hs method of the Java video encoder."), Name);
+			return;
+		}
+
+		Call(Env, EncoderClass, Method);
+
+		if (Env->ExceptionCheck())
+		{
+			Env->ExceptionDescribe();
+			Env->ExceptionClear();
+		}
+	}
+}
+#endif
+
+FSentryCrashVideoSurfaceEncoder& FSentryCrashVideoSurfaceEncoder::Get()
+{
+	static FSentryCrashVideoSurfaceEncoder Instance;
+	return Instance;
+}
+
+bool FSentryCrashVideoSurfaceEncoder::IsSupported()
+{
+#if PLATFORM_ANDROID && !UE_VERSION_OLDER_THAN(5, 0, 0)
+	return GDynamicRHI && FString(GDynamicRHI->GetName()).Contains(TEXT("OpenGL"));
+#elif PLATFORM_APPLE && !UE_VERSION_OLDER_THAN(5, 0, 0)
+	return GDynamicRHI && FString(GDynamicRHI->GetName()).Contains(TEXT("Metal"));
+#else
+	return false;
+#endif
+}
+
+bool FSentryCrashVideoSurfaceEncoder::Start(const FString& Directory, const FSentrySurfaceEncoderConfig& InConfig, int32 FirstSegmentIndex)
+{
+	check(IsInGameThread());
+
+#if !(PLATFORM_ANDROID || PLATFORM_APPLE) || UE_VERSION_OLDER_THAN(5, 0, 0)
+	UE_LOG(LogSentrySdk, Warning, TEXT("Zero-copy crash video recording is supported on Android, iOS and macOS with Unreal Engine 5.0 or newer only."));
+	return false;
+#else
+	if (bIsActive)
+	{
+		Stop();
+	}
+
+	if (!IsSupported())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Zero-copy crash video recording requires the %s RHI (active RHI: %s)."), PLATFORM_ANDROID ? TEXT("OpenGL ES") : TEXT("Metal"), GDynamicRHI ? GDynamicRHI->GetName() : TEXT("None"));
+		return false;
+	}
+
+	if (!FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Slate renderer required for zero-copy crash video recording is not available."));
+		return false;
+	}
+
+	if (!GEngine || !GEngine->GameViewport || !GEngine->GameViewport->GetWindow().IsValid())
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Game viewport window required for zero-copy crash video recording is not available."));
+		return false;
+	}
+
+	// Hardware encoders expect even frame dimensions
+	Config = InConfig;
+	Config.Width = FMath::Clamp(Config.Width, 64, 1920) & ~1;
+	Config.Height = FMath::Clamp(Config.Height, 64, 1080) & ~1;
+	Config.FramesPerSecond = FMath::Clamp(Config.FramesPerSecond, 1, 60);
+	Config.SegmentDurationSeconds = FMath::Clamp(Config.SegmentDurationSeconds, 1.0f, GetMaxSegmentDurationSeconds());
+
+	if (!StartPlatformEncoder(Directory, FirstSegmentIndex))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to start hardware video encoder for zero-copy crash video recording."));
+		return false;
+	}
+
+	CapturedWindow = GEngine->GameViewport->GetWindow().Get();
+	CaptureCadence.Reset(Config.FramesPerSecond);
+
+	bIsActive = true;
+
+	OnBackBufferReadyHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddRaw(this, &FSentryCrashVideoSurfaceEncoder::OnBackBufferReadyToPresent);
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Zero-copy crash video recording enabled: %dx%d at %d FPS, %.1f second segments in %s."),
+		Config.Width, Config.Height, Config.FramesPerSecond, Config.SegmentDurationSeconds, *Directory);
+
+	return true;
+#endif
+}
+
+bool FSentryCrashVideoSurfaceEncoder::StartPlatformEncoder(const FString& Directory, int32 FirstSegmentIndex)
+{
+#if PLATFORM_ANDROID
+	ANativeWindow* Window = nullptr;
+
+	SentryCrashVideoSurfaceEncoderJni::CallEncoder("start", "(Ljava/lang/String;IIIIFI)Landroid/view/Surface;", [&](JNIEnv* Env, jclass EncoderClass, jmethodID Method)
+	{
+		auto JavaDirectory = FJavaHelper::ToJavaString(Env, Directory);
+
+		jobject Surface = Env->CallStaticObjectMethod(EncoderClass, Method, *JavaDirectory, Config.Width, Config.Height, Config.FramesPerSecond, Config.Bitrate,
+			static_cast<double>(Config.SegmentDurationSeconds), FirstSegmentIndex);
+
+		if (Surface)
+		{
+			// Window keeps its own reference to the surface so the local Java reference can go
+			Window = ANativeWindow_fromSurface(Env, Surface);
+			Env->DeleteLocalRef(Surface);
+		}
+	});
+
+	if (!Window)
+	{
+		SentryCrashVideoSurfaceEncoderJni::CallEncoder("stop", "()V", [](JNIEnv* Env, jclass EncoderClass, jmethodID Method)
+		{
+			Env->CallStaticVoidMethod(EncoderClass, Method);
+		});
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to get the native window of the video encoder surface."));
+		return false;
+	}
+
+	NativeWindow = Window;
+	EncoderSurface = nullptr;
+	ReadFramebuffer = 0;
+	bHasFailed = false;
+
+	return true;
+#elif PLATFORM_APPLE
+	return AppleEncoder.Start(Directory, Config.Width, Config.Height, Config.FramesPerSecond, Config.Bitrate, Config.SegmentDurationSeconds, FirstSegmentIndex);
+#else
+	return false;
+#endif
+}
+
+void FSentryCrashVideoSurfaceEncoder::Stop()
+{
+	if (!bIsActive)
+	{
+		return;
+	}
+
+	bIsActive = false;
+
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(OnBackBufferReadyHandle);
+	}
+
+	OnBackBufferReadyHandle.Reset();
+
+	// EGL surface has to be gone before the encoder releases the surface it renders into
+	ENQUEUE_RENDER_COMMAND(SentryReleaseCrashVideoEncoderSurface)([this](FRHICommandListImmediate& RHICmdList)
+	{
+		RHICmdList.EnqueueLambda([this](FRHICommandListImmediate&)
+		{
+			ReleaseSurface();
+		});
+	});
+
+	FlushRenderingCommands();
+
+	PrivacyMaskTarget.SafeRelease();
+	CapturedWindow = nullptr;
+
+#if PLATFORM_ANDROID
+	if (NativeWindow)
+	{
+		ANativeWindow_release(static_cast<ANativeWindow*>(NativeWindow));
+		NativeWindow = nullptr;
+	}
+
+	SentryCrashVideoSurfaceEncoderJni::CallEncoder("stop", "()V", [](JNIEnv* Env, jclass EncoderClass, jmethodID Method)
+	{
+		Env->CallStaticVoidMethod(EncoderClass, Method);
+	});
+#elif PLATFORM_APPLE
+	AppleEncoder.Stop();
+#endif
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Zero-copy crash video recording stopped, %lld frame(s) were dropped."), CaptureCadence.GetNumDropped());
+}
+
+bool FSentryCrashVideoSurfaceEncoder::HasFailed() const
+{
+#if PLATFORM_APPLE
+	return AppleEncoder.HasFailed();
+#else
+	return bHasFailed;
+#endif
+}
+
+TArray<FString> FSentryCrashVideoSurfaceEncoder::TakeFinishedSegments()
+{
+	TArray<FString> Segments;
+
+#if PLATFORM_ANDROID
+	SentryCrashVideoSurfaceEncoderJni::CallEncoder("pollFinishedSegment", "()Ljava/lang/String;", [&Segments](JNIEnv* Env, jclass EncoderClass, jmethodID Method)
+	{
+		while (jstring Segment = static_cast<jstring>(Env->CallStaticObjectMethod(EncoderClass, Method)))
+		{
+			Segments.Add(FJavaHelper::FStringFromLocalRef(Env, Segment));
+		}
+	});
+#elif PLATFORM_APPLE
+	Segments = AppleEncoder.TakeFinishedSegments();
+#endif
+
+	return Segments;
+}
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+void FSentryCrashVideoSurfaceEncoder::OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer)
+#else
+void FSentryCrashVideoSurfaceEncoder::OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer)
+#endif
+{
+	check(IsInRenderingThread());
+
+	if (!bIsActive || &Window != CapturedWindow || !BackBuffer.IsValid())
+	{
+		return;
+	}
+
+	// Frames are picked from the present timeline on a fixed cadence, the ones in between cost nothing
+	const double PresentTime = FPlatformTime::Seconds();
+	if (!CaptureCadence.ShouldCapture(PresentTime))
+	{
+		return;
+	}
+
+	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+
+	// Redacted widgets are cleared in a copy on the GPU, which is then blitted instead of the back buffer
+	auto Source = FSentryRedactedWidgets::Get().Apply(RHICmdList, Window, BackBuffer, PrivacyMaskTarget);
+	if (!Source.IsValid())
+	{
+		return;
+	}
+
+	const int64 PresentationTimeNs = static_cast<int64>(PresentTime * 1e9);
+
+#if PLATFORM_APPLE
+	// Frame rendering has to be committed before the scaling pass, which goes to the same Metal queue
+	RHICmdList.SubmitCommandsHint();
+#endif
+
+	// Rendering context is only current on the RHI thread, the texture reference keeps the source alive until then
+	RHICmdList.EnqueueLambda([this, Source, PresentationTimeNs](FRHICommandListImmediate&)
+	{
+#if PLATFORM_APPLE
+		AppleEncoder.EncodeFrame(Source->GetNativeResource(), PresentationTimeNs);
+#else
+		const uint32* Texture = static_cast<const uint32*>(Source->GetNativeResource());
+		if (Texture && *Texture != 0)
+		{
+			EncodeFrame(*Texture, Source->GetSizeXY(), PresentationTimeNs);
+		}
+#endif
+	});
+}
+
+void FSentryCrashVideoSurfaceEncoder::EncodeFrame(uint32 Texture, FIntPoint TextureSize, int64 PresentationTimeNs)
+{
+#if PLATFORM_ANDROID
+	if (bHasFailed || !NativeWindow)
+	{
+		return;
+	}
+
+	const EGLDisplay Display = eglGetCurrentDisplay();
+	const EGLContext Context = eglGetCurrentContext();
+	if (Display == EGL_NO_DISPLAY || Context == EGL_NO_CONTEXT)
+	{
+		return;
+	}
+
+	if (!EncoderSurface)
+	{
+		// Surface has to use the config of the RHI context so that the context can be made current with it
+		EGLint ConfigId = 0;
+		eglQueryContext(Display, Context, EGL_CONFIG_ID, &ConfigId);
+
+		const EGLint ConfigAttributes[] = { EGL_CONFIG_ID, ConfigId, EGL_NONE };
+		EGLConfig EglConfig = nullptr;
+		EGLint NumConfigs = 0;
+
+		EGLSurface NewSurface = EGL_NO_SURFACE;
+		if (eglChooseConfig(Display, ConfigAttributes, &EglConfig, 1, &NumConfigs) && NumConfigs > 0)
+		{
+			NewSurface = eglCreateWindowSurface(Display, EglConfig, static_cast<ANativeWindow*>(NativeWindow), nullptr);
+		}
+
+		if (NewSurface == EGL_NO_SURFACE)
+		{
+			UE_LOG(LogSentrySdk, Warning, TEXT("Failed to create EGL surface for the video encoder (error 0x%x), zero-copy crash video recording is disabled."), eglGetError());
+			bHasFailed = true;
+			return;
+		}
+
+		EncoderSurface = NewSurface;
+	}
+
+	static const PFNEGLPRESENTATIONTIMEANDROIDPROC PresentationTimeANDROID =
+		reinterpret_cast<PFNEGLPRESENTATIONTIMEANDROIDPROC>(eglGetProcAddress("eglPresentationTimeANDROID"));
+
+	const EGLSurface PreviousDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+	const EGLSurface PreviousReadSurface = eglGetCurrentSurface(EGL_READ);
+
+	// Blitting goes around the RHI state cache, so everything touched is restored afterwards
+	GLint PreviousReadFramebuffer = 0;
+	GLint PreviousDrawFramebuffer = 0;
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &PreviousReadFramebuffer);
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &PreviousDrawFramebuffer);
+	const GLboolean bWasScissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+
+	if (!eglMakeCurrent(Display, static_cast<EGLSurface>(EncoderSurface), static_cast<EGLSurface>(EncoderSurface), Context))
+	{
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to make the video encoder surface current (error 0x%x), zero-copy crash video recording is disabled."), eglGetError());
+		bHasFailed = true;
+		return;
+	}
+
+	if (ReadFramebuffer == 0)
+	{
+		glGenFramebuffers(1, &ReadFramebuffer);
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, ReadFramebuffer);
+	glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, Texture, 0);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glDisable(GL_SCISSOR_TEST);
+
+	// Encoder resolution is fitted to the viewport aspect ratio, so the frame is only scaled down
+	glBlitFramebuffer(0, 0, TextureSize.X, TextureSize.Y, 0, 0, Config.Width, Config.Height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+	if (PresentationTimeANDROID)
+	{
+		PresentationTimeANDROID(Display, static_cast<EGLSurface>(EncoderSurface), PresentationTimeNs);
+	}
+
+	eglSwapBuffers(Display, static_cast<EGLSurface>(EncoderSurface));
+
+	glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+
+	eglMakeCurrent(Display, PreviousDrawSurface, PreviousReadSurface, Context);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, PreviousReadFramebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, PreviousDrawFramebuffer);
+	if (bWasScissorEnabled)
+	{
+		glEnable(GL_SCISSOR_TEST);
+	}
+#endif
+}
+
+void FSentryCrashVideoSurfaceEncoder::ReleaseSurface()
+{
+#if PLATFORM_ANDROID
+	const EGLDisplay Display = eglGetCurrentDisplay();
+
+	if (ReadFramebuffer != 0 && eglGetCurrentContext() != EGL_NO_CONTEXT)
+	{
+		glDeleteFramebuffers(1, &ReadFramebuffer);
+	}
+
+	if (EncoderSurface && Display != EGL_NO_DISPLAY)
+	{
+		eglDestroySurface(Display, static_cast<EGLSurface>(EncoderSurface));
+	}
+#endif
+
+	ReadFramebuffer = 0;
+	EncoderSurface = nullptr;
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RHI.h"
+#include "Utils/SentryCaptureCadence.h"
+
+#if PLATFORM_APPLE
+#include "Apple/AppleSentryVideoToolboxEncoder.h"
+#endif
+
+class SWindow;
+
+/** Settings of the surface encoder recording. */
+struct FSentrySurfaceEncoderConfig
+{
+	int32 Width = 1280;
+	int32 Height = 720;
+	int32 FramesPerSecond = 30;
+	int32 Bitrate = 2500000;
+	float SegmentDurationSeconds = 5.0f;
+};
+
+/**
+ * Zero-copy crash video recording on Android, iOS and macOS.
+ *
+ * The game window back buffer is scaled on the GPU straight into memory consumed by a hardware encoder, so frames are
+ * never read back to the CPU. The encoder writes MP4 segments starting with a keyframe, which are picked up on the game
+ * thread and kept in the segment ring just like the segments of regular segmented recording.
+ *
+ * On Android the back buffer is blitted into the input surface of a MediaCodec encoder, which is attached to the OpenGL ES
+ * context of the RHI, so only the OpenGL ES RHI is supported. Vulkan would need a dedicated swapchain presenting into the
+ * encoder surface, recording falls back to the video recorder there.
+ *
+ * On Apple platforms the back buffer is scaled with Metal into IOSurface backed pixel buffers of a VideoToolbox session.
+ */
+class FSentryCrashVideoSurfaceEncoder
+{
+public:
+	static FSentryCrashVideoSurfaceEncoder& Get();
+
+	/** Checks whether zero-copy recording is supported by the platform and the active RHI. */
+	static bool IsSupported();
+
+	/**
+	 * Starts encoding frames of the game viewport window into segments written to the given directory. Called on the game thread.
+	 *
+	 * @param FirstSegmentIndex Index of the first segment file name, or -1 to continue the numbering of the previous recording
+	 *                          so that a resumed recording doesn't overwrite earlier segments.
+	 */
+	bool Start(const FString& Directory, const FSentrySurfaceEncoderConfig& InConfig, int32 FirstSegmentIndex);
+
+	/** Stops encoding, the segment being recorded is finalized in the background and reported by TakeFinishedSegments. */
+	void Stop();
+
+	/** Checks whether frames are being encoded. */
+	bool IsActive() const { return bIsActive; }
+
+	/** Checks whether the hardware encoder failed, in which case no more frames are encoded until it's restarted. */
+	bool HasFailed() const;
+
+	/** Gets the longest segment allowed, bounding the footage lost with the segment being encoded when the game crashes. */
+	static float GetMaxSegmentDurationSeconds() { return PLATFORM_ANDROID ? 2.0f : 30.0f; }
+
+	/** Gets segments finalized since the last call, ordered from the oldest to the newest. */
+	TArray<FString> TakeFinishedSegments();
+
+private:
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer);
+#else
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer);
+#endif
+
+	/** Starts the hardware encoder of the platform with the current config. */
+	bool StartPlatformEncoder(const FString& Directory, int32 FirstSegmentIndex);
+
+	/** Blits the back buffer texture into the encoder surface. Called where the rendering context is current. */
+	void EncodeFrame(uint32 Texture, FIntPoint TextureSize, int64 PresentationTimeNs);
+
+	/** Destroys the encoder surface and the framebuffer used for blitting. Called where the rendering context is current. */
+	void ReleaseSurface();
+
+	FSentrySurfaceEncoderConfig Config;
+
+	FThreadSafeBool bIsActive;
+
+	FDelegateHandle OnBackBufferReadyHandle;
+
+	/** Window to capture, only compared against the presented window on the render thread. */
+	const SWindow* CapturedWindow = nullptr;
+
+	// Render thread state
+	FSentryCaptureCadence CaptureCadence;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	FTexture2DRHIRef PrivacyMaskTarget;
+#else
+	FTextureRHIRef PrivacyMaskTarget;
+#endif
+
+	// Rendering context state, EGL and GL handles are kept opaque so that the header doesn't depend on EGL
+	void* NativeWindow = nullptr;
+	void* EncoderSurface = nullptr;
+	uint32 ReadFramebuffer = 0;
+	TAtomic<bool> bHasFailed { false };
+
+#if PLATFORM_APPLE
+	FAppleSentryVideoToolboxEncoder AppleEncoder;
+#endif
+};
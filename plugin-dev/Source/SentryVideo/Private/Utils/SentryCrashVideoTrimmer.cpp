@@ -0,0 +1,813 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryCrashVideoTrimmer.h"
+
+#include "SentryDefines.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace SentryCrashVideoTrimmer
+{
+	static constexpr uint32 MakeType(const char (&Code)[5])
+	{
+		return (static_cast<uint32>(static_cast<uint8>(Code[0])) << 24) | (static_cast<uint32>(static_cast<uint8>(Code[1])) << 16) |
+			(static_cast<uint32>(static_cast<uint8>(Code[2])) << 8) | static_cast<uint32>(static_cast<uint8>(Code[3]));
+	}
+
+	static constexpr uint32 Ftyp = MakeType("ftyp");
+	static constexpr uint32 Moov = MakeType("moov");
+	static constexpr uint32 Moof = MakeType("moof");
+	static constexpr uint32 Mdat = MakeType("mdat");
+	static constexpr uint32 Mvhd = MakeType("mvhd");
+	static constexpr uint32 Trak = MakeType("trak");
+	static constexpr uint32 Tkhd = MakeType("tkhd");
+	static constexpr uint32 Edts = MakeType("edts");
+	static constexpr uint32 Mdia = MakeType("mdia");
+	static constexpr uint32 Mdhd = MakeType("mdhd");
+	static constexpr uint32 Hdlr = MakeType("hdlr");
+	static constexpr uint32 Minf = MakeType("minf");
+	static constexpr uint32 Stbl = MakeType("stbl");
+	static constexpr uint32 Stsd = MakeType("stsd");
+	static constexpr uint32 Stts = MakeType("stts");
+	static constexpr uint32 Ctts = MakeType("ctts");
+	static constexpr uint32 Stss = MakeType("stss");
+	static constexpr uint32 Stsz = MakeType("stsz");
+	static constexpr uint32 Stsc = MakeType("stsc");
+	static constexpr uint32 Stco = MakeType("stco");
+	static constexpr uint32 Co64 = MakeType("co64");
+	static constexpr uint32 Vide = MakeType("vide");
+
+	/** Box of the movie header, only the boxes leading to the sample tables are parsed into children. */
+	struct FBox
+	{
+		uint32 Type = 0;
+		TArray64<uint8> Payload;
+		TArray<FBox> Children;
+		bool bIsContainer = false;
+	};
+
+	struct FTrack
+	{
+		FBox* Box = nullptr;
+		FBox* Mdhd = nullptr;
+		FBox* Tkhd = nullptr;
+		FBox* Stbl = nullptr;
+
+		uint32 HandlerType = 0;
+		uint32 Timescale = 0;
+		uint32 SampleDescriptionIndex = 1;
+
+		TArray<uint32> Sizes;
+		TArray<int64> Offsets;
+		TArray<int64> DecodeTimes;
+		TArray<uint32> Deltas;
+		TArray<uint32> CompositionOffsets;
+		TArray<bool> IsSync;
+
+		bool bHasCtts = false;
+		uint8 CttsVersion = 0;
+		bool bHasStss = false;
+
+		int32 FirstKeptSample = 0;
+		uint64 ChunkOffset = 0;
+
+		int32 GetNumKept() const { return Sizes.Num() - FirstKeptSample; }
+	};
+
+	static uint32 ReadU32(const uint8* Data)
+	{
+		return (static_cast<uint32>(Data[0]) << 24) | (static_cast<uint32>(Data[1]) << 16) | (static_cast<uint32>(Data[2]) << 8) | static_cast<uint32>(Data[3]);
+	}
+
+	static uint64 ReadU64(const uint8* Data)
+	{
+		return (static_cast<uint64>(ReadU32(Data)) << 32) | ReadU32(Data + 4);
+	}
+
+	static void PutU32(uint8* Data, uint32 Value)
+	{
+		Data[0] = static_cast<uint8>(Value >> 24);
+		Data[1] = static_cast<uint8>(Value >> 16);
+		Data[2] = static_cast<uint8>(Value >> 8);
+		Data[3] = static_cast<uint8>(Value);
+	}
+
+	static void PutU64(uint8* Data, uint64 Value)
+	{
+		PutU32(Data, static_cast<uint32>(Value >> 32));
+		PutU32(Data + 4, static_cast<uint32>(Value));
+	}
+
+	static void AppendU32(TArray64<uint8>& Out, uint32 Value)
+	{
+		const int64 Offset = Out.AddUninitialized(4);
+		PutU32(Out.GetData() + Offset, Value);
+	}
+
+	static void AppendU64(TArray64<uint8>& Out, uint64 Value)
+	{
+		const int64 Offset = Out.AddUninitialized(8);
+		PutU64(Out.GetData() + Offset, Value);
+	}
+
+	static bool IsContainer(uint32 Type)
+	{
+		return Type == Moov || Type == Trak || Type == Mdia || Type == Minf || Type == Stbl;
+	}
+
+	/**
+	 * Reads the header of the box at the given offset.
+	 *
+	 * @return False if the box doesn't fit the data.
+	 */
+	static bool ReadBoxHeader(const uint8* Data, int64 Size, int64 Offset, uint32& OutType, int64& OutHeaderSize, int64& OutBoxSize)
+	{
+		if (Size - Offset < 8)
+		{
+			return false;
+		}
+
+		OutBoxSize = ReadU32(Data + Offset);
+		OutType = ReadU32(Data + Offset + 4);
+		OutHeaderSize = 8;
+
+		if (OutBoxSize == 1)
+		{
+			if (Size - Offset < 16)
+			{
+				return false;
+			}
+
+			OutBoxSize = static_cast<int64>(ReadU64(Data + Offset + 8));
+			OutHeaderSize = 16;
+		}
+		else if (OutBoxSize == 0)
+		{
+			OutBoxSize = Size - Offset;
+		}
+
+		return OutBoxSize >= OutHeaderSize && OutBoxSize <= Size - Offset;
+	}
+
+	static bool ParseBoxes(const uint8* Data, int64 Size, TArray<FBox>& OutBoxes)
+	{
+		int64 Offset = 0;
+
+		while (Offset < Size)
+		{
+			uint32 Type = 0;
+			int64 HeaderSize = 0;
+			int64 BoxSize = 0;
+
+			if (!ReadBoxHeader(Data, Size, Offset, Type, HeaderSize, BoxSize))
+			{
+				return false;
+			}
+
+			FBox& Box = OutBoxes.AddDefaulted_GetRef();
+			Box.Type = Type;
+			Box.bIsContainer = IsContainer(Type);
+
+			if (Box.bIsContainer)
+			{
+				if (!ParseBoxes(Data + Offset + HeaderSize, BoxSize - HeaderSize, Box.Children))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				Box.Payload.Append(Data + Offset + HeaderSize, BoxSize - HeaderSize);
+			}
+
+			Offset += BoxSize;
+		}
+
+		return true;
+	}
+
+	static void SerializeBox(const FBox& Box, TArray64<uint8>& Out)
+	{
+		const int64 Start = Out.Num();
+
+		AppendU32(Out, 0);
+		AppendU32(Out, Box.Type);
+
+		if (Box.bIsContainer)
+		{
+			for (const FBox& Child : Box.Children)
+			{
+				SerializeBox(Child, Out);
+			}
+		}
+		else
+		{
+			Out.Append(Box.Payload);
+		}
+
+		// Movie header never comes close to 4 GB so the compact size is always enough
+		PutU32(Out.GetData() + Start, static_cast<uint32>(Out.Num() - Start));
+	}
+
+	static FBox* FindChild(FBox* Box, uint32 Type)
+	{
+		if (!Box)
+		{
+			return nullptr;
+		}
+
+		return Box->Children.FindByPredicate([Type](const FBox& Child) { return Child.Type == Type; });
+	}
+
+	/** Gets the times scale of `mvhd` and `mdhd`, which share the layout of the leading fields. */
+	static bool ReadTimescale(const FBox& Box, uint32& OutTimescale)
+	{
+		const int64 Offset = Box.Payload.Num() > 0 && Box.Payload[0] == 1 ? 20 : 12;
+		if (Box.Payload.Num() < Offset + 4)
+		{
+			return false;
+		}
+
+		OutTimescale = ReadU32(Box.Payload.GetData() + Offset);
+		return OutTimescale > 0;
+	}
+
+	/** Overwrites the duration field of a full box, which is 32 bits wide in version 0 and 64 bits in version 1. */
+	static void WriteDuration(FBox& Box, int64 V0Offset, int64 V1Offset, uint64 Duration)
+	{
+		if (Box.Payload.Num() > 0 && Box.Payload[0] == 1)
+		{
+			if (Box.Payload.Num() >= V1Offset + 8)
+			{
+				PutU64(Box.Payload.GetData() + V1Offset, Duration);
+			}
+		}
+		else if (Box.Payload.Num() >= V0Offset + 4)
+		{
+			PutU32(Box.Payload.GetData() + V0Offset, static_cast<uint32>(FMath::Min<uint64>(Duration, MAX_uint32)));
+		}
+	}
+
+	/** Gets the number of entries of a sample table and checks that they fit the box. */
+	static bool ReadTableEntries(const FBox* Box, int64 EntryOffset, int64 EntrySize, uint32& OutNumEntries)
+	{
+		if (!Box || Box->Payload.Num() < EntryOffset)
+		{
+			return false;
+		}
+
+		OutNumEntries = ReadU32(Box->Payload.GetData() + EntryOffset - 4);
+		return Box->Payload.Num() >= EntryOffset + static_cast<int64>(OutNumEntries) * EntrySize;
+	}
+
+	static bool ParseTrack(FBox& TrakBox, int64 FileSize, FTrack& OutTrack)
+	{
+		OutTrack.Box = &TrakBox;
+		OutTrack.Tkhd = FindChild(&TrakBox, Tkhd);
+
+		FBox* MdiaBox = FindChild(&TrakBox, Mdia);
+		FBox* HdlrBox = FindChild(MdiaBox, Hdlr);
+		OutTrack.Mdhd = FindChild(MdiaBox, Mdhd);
+		OutTrack.Stbl = FindChild(FindChild(MdiaBox, Minf), Stbl);
+
+		if (!OutTrack.Tkhd || !OutTrack.Mdhd || !HdlrBox || !OutTrack.Stbl || HdlrBox->Payload.Num() < 12 || !ReadTimescale(*OutTrack.Mdhd, OutTrack.Timescale))
+		{
+			return false;
+		}
+
+		OutTrack.HandlerType = ReadU32(HdlrBox->Payload.GetData() + 8);
+
+		FBox* StszBox = FindChild(OutTrack.Stbl, Stsz);
+		FBox* SttsBox = FindChild(OutTrack.Stbl, Stts);
+		FBox* CttsBox = FindChild(OutTrack.Stbl, Ctts);
+		FBox* StssBox = FindChild(OutTrack.Stbl, Stss);
+		FBox* StscBox = FindChild(OutTrack.Stbl, Stsc);
+		FBox* StcoBox = FindChild(OutTrack.Stbl, Stco);
+		FBox* Co64Box = FindChild(OutTrack.Stbl, Co64);
+
+		if (!FindChild(OutTrack.Stbl, Stsd) || !StszBox || StszBox->Payload.Num() < 12)
+		{
+			return false;
+		}
+
+		// Sample sizes
+		const uint32 UniformSize = ReadU32(StszBox->Payload.GetData() + 4);
+		const uint32 NumSamples = ReadU32(StszBox->Payload.GetData() + 8);
+
+		if (UniformSize == 0 && StszBox->Payload.Num() < 12 + static_cast<int64>(NumSamples) * 4)
+		{
+			return false;
+		}
+
+		OutTrack.Sizes.SetNumUninitialized(NumSamples);
+		for (uint32 Index = 0; Index < NumSamples; ++Index)
+		{
+			OutTrack.Sizes[Index] = UniformSize != 0 ? UniformSize : ReadU32(StszBox->Payload.GetData() + 12 + Index * 4);
+		}
+
+		// Decode times
+		uint32 NumEntries = 0;
+		if (!ReadTableEntries(SttsBox, 8, 8, NumEntries))
+		{
+			return false;
+		}
+
+		OutTrack.Deltas.Reserve(NumSamples);
+		for (uint32 Entry = 0; Entry < NumEntries && static_cast<uint32>(OutTrack.Deltas.Num()) < NumSamples; ++Entry)
+		{
+			const uint32 Count = ReadU32(SttsBox->Payload.GetData() + 8 + Entry * 8);
+			const uint32 Delta = ReadU32(SttsBox->Payload.GetData() + 12 + Entry * 8);
+
+			for (uint32 Index = 0; Index < Count && static_cast<uint32>(OutTrack.Deltas.Num()) < NumSamples; ++Index)
+			{
+				OutTrack.Deltas.Add(Delta);
+			}
+		}
+
+		if (static_cast<uint32>(OutTrack.Deltas.Num()) != NumSamples)
+		{
+			return false;
+		}
+
+		OutTrack.DecodeTimes.SetNumUninitialized(NumSamples);
+		int64 DecodeTime = 0;
+		for (uint32 Index = 0; Index < NumSamples; ++Index)
+		{
+			OutTrack.DecodeTimes[Index] = DecodeTime;
+			DecodeTime += OutTrack.Deltas[Index];
+		}
+
+		// Composition offsets
+		if (CttsBox)
+		{
+			if (!ReadTableEntries(CttsBox, 8, 8, NumEntries))
+			{
+				return false;
+			}
+
+			OutTrack.bHasCtts = true;
+			OutTrack.CttsVersion = CttsBox->Payload[0];
+			OutTrack.CompositionOffsets.Reserve(NumSamples);
+
+			for (uint32 Entry = 0; Entry < NumEntries && static_cast<uint32>(OutTrack.CompositionOffsets.Num()) < NumSamples; ++Entry)
+			{
+				const uint32 Count = ReadU32(CttsBox->Payload.GetData() + 8 + Entry * 8);
+				const uint32 Offset = ReadU32(CttsBox->Payload.GetData() + 12 + Entry * 8);
+
+				for (uint32 Index = 0; Index < Count && static_cast<uint32>(OutTrack.CompositionOffsets.Num()) < NumSamples; ++Index)
+				{
+					OutTrack.CompositionOffsets.Add(Offset);
+				}
+			}
+
+			if (static_cast<uint32>(OutTrack.CompositionOffsets.Num()) != NumSamples)
+			{
+				return false;
+			}
+		}
+
+		// Sync samples, every sample is a sync sample if the table is missing
+		OutTrack.IsSync.Init(StssBox == nullptr, NumSamples);
+		if (StssBox)
+		{
+			if (!ReadTableEntries(StssBox, 8, 4, NumEntries))
+			{
+				return false;
+			}
+
+			OutTrack.bHasStss = true;
+
+			for (uint32 Entry = 0; Entry < NumEntries; ++Entry)
+			{
+				const uint32 SampleNumber = ReadU32(StssBox->Payload.GetData() + 8 + Entry * 4);
+				if (SampleNumber >= 1 && SampleNumber <= NumSamples)
+				{
+					OutTrack.IsSync[SampleNumber - 1] = true;
+				}
+			}
+		}
+
+		// Chunk offsets
+		TArray<uint64> ChunkOffsets;
+		if (StcoBox && ReadTableEntries(StcoBox, 8, 4, NumEntries))
+		{
+			for (uint32 Entry = 0; Entry < NumEntries; ++Entry)
+			{
+				ChunkOffsets.Add(ReadU32(StcoBox->Payload.GetData() + 8 + Entry * 4));
+			}
+		}
+		else if (Co64Box && ReadTableEntries(Co64Box, 8, 8, NumEntries))
+		{
+			for (uint32 Entry = 0; Entry < NumEntries; ++Entry)
+			{
+				ChunkOffsets.Add(ReadU64(Co64Box->Payload.GetData() + 8 + Entry * 8));
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		// Samples are laid out in chunks back to back, the number of samples per chunk changes at the listed chunks
+		if (!ReadTableEntries(StscBox, 8, 12, NumEntries) || (NumEntries == 0 && NumSamples > 0))
+		{
+			return false;
+		}
+
+		if (NumEntries > 0)
+		{
+			OutTrack.SampleDescriptionIndex = ReadU32(StscBox->Payload.GetData() + 16);
+		}
+
+		OutTrack.Offsets.SetNumUninitialized(NumSamples);
+
+		uint32 Sample = 0;
+		uint32 Entry = 0;
+
+		for (int32 Chunk = 0; Chunk < ChunkOffsets.Num() && Sample < NumSamples; ++Chunk)
+		{
+			while (Entry + 1 < NumEntries && static_cast<uint32>(Chunk + 1) >= ReadU32(StscBox->Payload.GetData() + 8 + (Entry + 1) * 12))
+			{
+				++Entry;
+			}
+
+			const uint32 SamplesPerChunk = ReadU32(StscBox->Payload.GetData() + 12 + Entry * 12);
+
+			uint64 Offset = ChunkOffsets[Chunk];
+			for (uint32 Index = 0; Index < SamplesPerChunk && Sample < NumSamples; ++Index, ++Sample)
+			{
+				if (Offset + OutTrack.Sizes[Sample] > static_cast<uint64>(FileSize))
+				{
+					return false;
+				}
+
+				OutTrack.Offsets[Sample] = static_cast<int64>(Offset);
+				Offset += OutTrack.Sizes[Sample];
+			}
+		}
+
+		return Sample == NumSamples;
+	}
+
+	/** Appends run-length encoded values of the kept samples as (count, value) pairs. */
+	static void AppendRuns(const TArray<uint32>& Values, int32 First, TArray64<uint8>& Out)
+	{
+		const int64 NumEntriesOffset = Out.AddUninitialized(4);
+		uint32 NumEntries = 0;
+
+		for (int32 Index = First; Index < Values.Num();)
+		{
+			int32 RunEnd = Index + 1;
+			while (RunEnd < Values.Num() && Values[RunEnd] == Values[Index])
+			{
+				++RunEnd;
+			}
+
+			AppendU32(Out, static_cast<uint32>(RunEnd - Index));
+			AppendU32(Out, Values[Index]);
+			++NumEntries;
+
+			Index = RunEnd;
+		}
+
+		PutU32(Out.GetData() + NumEntriesOffset, NumEntries);
+	}
+
+	static FBox MakeLeaf(uint32 Type, uint8 Version = 0)
+	{
+		FBox Box;
+		Box.Type = Type;
+		AppendU32(Box.Payload, static_cast<uint32>(Version) << 24);
+		return Box;
+	}
+
+	/** Rebuilds the sample tables so that they only describe the kept samples, stored in a single chunk. */
+	static void RebuildSampleTables(FTrack& Track)
+	{
+		const int32 First = Track.FirstKeptSample;
+		const int32 NumKept = Track.GetNumKept();
+
+		// Per-sample tables that aren't rebuilt (sample groups, dependencies) would describe the wrong samples
+		TArray<FBox> Children;
+		Children.Add(*FindChild(Track.Stbl, Stsd));
+
+		FBox SttsBox = MakeLeaf(Stts);
+		AppendRuns(Track.Deltas, First, SttsBox.Payload);
+		Children.Add(MoveTemp(SttsBox));
+
+		if (Track.bHasCtts)
+		{
+			FBox CttsBox = MakeLeaf(Ctts, Track.CttsVersion);
+			AppendRuns(Track.CompositionOffsets, First, CttsBox.Payload);
+			Children.Add(MoveTemp(CttsBox));
+		}
+
+		if (Track.bHasStss)
+		{
+			FBox StssBox = MakeLeaf(Stss);
+			const int64 NumEntriesOffset = StssBox.Payload.AddUninitialized(4);
+			uint32 NumEntries = 0;
+
+			for (int32 Index = First; Index < Track.IsSync.Num(); ++Index)
+			{
+				if (Track.IsSync[Index])
+				{
+					AppendU32(StssBox.Payload, static_cast<uint32>(Index - First + 1));
+					++NumEntries;
+				}
+			}
+
+			PutU32(StssBox.Payload.GetData() + NumEntriesOffset, NumEntries);
+			Children.Add(MoveTemp(StssBox));
+		}
+
+		FBox StszBox = MakeLeaf(Stsz);
+		AppendU32(StszBox.Payload, 0);
+		AppendU32(StszBox.Payload, static_cast<uint32>(NumKept));
+		for (int32 Index = First; Index < Track.Sizes.Num(); ++Index)
+		{
+			AppendU32(StszBox.Payload, Track.Sizes[Index]);
+		}
+		Children.Add(MoveTemp(StszBox));
+
+		FBox StscBox = MakeLeaf(Stsc);
+		AppendU32(StscBox.Payload, NumKept > 0 ? 1 : 0);
+		if (NumKept > 0)
+		{
+			AppendU32(StscBox.Payload, 1);
+			AppendU32(StscBox.Payload, static_cast<uint32>(NumKept));
+			AppendU32(StscBox.Payload, Track.SampleDescriptionIndex);
+		}
+		Children.Add(MoveTemp(StscBox));
+
+		// 64-bit offsets keep the header size independent of where the data ends up
+		FBox Co64Box = MakeLeaf(Co64);
+		AppendU32(Co64Box.Payload, NumKept > 0 ? 1 : 0);
+		if (NumKept > 0)
+		{
+			AppendU64(Co64Box.Payload, Track.ChunkOffset);
+		}
+		Children.Add(MoveTemp(Co64Box));
+
+		Track.Stbl->Children = MoveTemp(Children);
+	}
+}
+
+FSentryCrashVideoTrimmer& FSentryCrashVideoTrimmer::Get()
+{
+	static FSentryCrashVideoTrimmer Instance;
+	return Instance;
+}
+
+bool FSentryCrashVideoTrimmer::TrimClip(const FString& Path) const
+{
+	if (ClipSeconds <= 0.0f)
+	{
+		return false;
+	}
+
+	TArray64<uint8> Input;
+	if (!FFileHelper::LoadFileToArray(Input, *Path))
+	{
+		return false;
+	}
+
+	TArray64<uint8> Output;
+	double Duration = 0.0;
+
+	if (!TrimToLastSeconds(Input, ClipSeconds, Output, &Duration))
+	{
+		return false;
+	}
+
+	const FString TrimmedPath = Path + TEXT(".trim");
+
+	if (!FFileHelper::SaveArrayToFile(Output, *TrimmedPath) || !IFileManager::Get().Move(*Path, *TrimmedPath, true))
+	{
+		IFileManager::Get().Delete(*TrimmedPath);
+		UE_LOG(LogSentrySdk, Warning, TEXT("Failed to save trimmed crash clip: %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogSentrySdk, Log, TEXT("Crash clip trimmed to %.2f seconds (%lld -> %lld bytes): %s"), Duration, Input.Num(), Output.Num(), *Path);
+
+	return true;
+}
+
+bool FSentryCrashVideoTrimmer::TrimToLastSeconds(const TArray64<uint8>& Input, float Seconds, TArray64<uint8>& Output, double* OutDurationSeconds)
+{
+	using namespace SentryCrashVideoTrimmer;
+
+	const uint8* Data = Input.GetData();
+	const int64 Size = Input.Num();
+
+	TArray64<uint8> FtypBox;
+	FBox MoovBox;
+	bool bHasMoov = false;
+
+	int64 Offset = 0;
+	while (Offset < Size)
+	{
+		uint32 Type = 0;
+		int64 HeaderSize = 0;
+		int64 BoxSize = 0;
+
+		if (!ReadBoxHeader(Data, Size, Offset, Type, HeaderSize, BoxSize))
+		{
+			return false;
+		}
+
+		if (Type == Moof)
+		{
+			// Samples of fragmented files are described by the fragments rather than by the movie header
+			return false;
+		}
+
+		if (Type == Ftyp)
+		{
+			FtypBox.Append(Data + Offset, BoxSize);
+		}
+		else if (Type == Moov)
+		{
+			MoovBox.Type = Moov;
+			MoovBox.bIsContainer = true;
+
+			if (!ParseBoxes(Data + Offset + HeaderSize, BoxSize - HeaderSize, MoovBox.Children))
+			{
+				return false;
+			}
+
+			bHasMoov = true;
+		}
+
+		Offset += BoxSize;
+	}
+
+	FBox* MvhdBox = FindChild(&MoovBox, Mvhd);
+	uint32 MovieTimescale = 0;
+
+	if (!bHasMoov || !MvhdBox || !ReadTimescale(*MvhdBox, MovieTimescale))
+	{
+		return false;
+	}
+
+	TArray<FTrack> Tracks;
+	FTrack* VideoTrack = nullptr;
+
+	for (FBox& Child : MoovBox.Children)
+	{
+		if (Child.Type != Trak)
+		{
+			continue;
+		}
+
+		FTrack& Track = Tracks.AddDefaulted_GetRef();
+		if (!ParseTrack(Child, Size, Track))
+		{
+			return false;
+		}
+	}
+
+	for (FTrack& Track : Tracks)
+	{
+		if (Track.HandlerType == Vide && Track.Sizes.Num() > 0)
+		{
+			VideoTrack = &Track;
+			break;
+		}
+	}
+
+	if (!VideoTrack)
+	{
+		return false;
+	}
+
+	// Clip starts at the keyframe nearest to the requested start so that it's playable without re-encoding
+	const int64 TotalDuration = VideoTrack->DecodeTimes.Last() + VideoTrack->Deltas.Last();
+	const int64 TargetStart = TotalDuration - static_cast<int64>(static_cast<double>(Seconds) * VideoTrack->Timescale);
+
+	if (TargetStart <= 0)
+	{
+		return false;
+	}
+
+	int32 CutSample = 0;
+	for (int32 Index = 0; Index < VideoTrack->Sizes.Num(); ++Index)
+	{
+		if (VideoTrack->IsSync[Index] && FMath::Abs(VideoTrack->DecodeTimes[Index] - TargetStart) < FMath::Abs(VideoTrack->DecodeTimes[CutSample] - TargetStart))
+		{
+			CutSample = Index;
+		}
+	}
+
+	if (CutSample == 0)
+	{
+		return false;
+	}
+
+	const double CutSeconds = static_cast<double>(VideoTrack->DecodeTimes[CutSample]) / VideoTrack->Timescale;
+
+	for (FTrack& Track : Tracks)
+	{
+		if (&Track == VideoTrack)
+		{
+			Track.FirstKeptSample = CutSample;
+			continue;
+		}
+
+		const int64 TrackCutTime = static_cast<int64>(CutSeconds * Track.Timescale);
+
+		Track.FirstKeptSample = Track.Sizes.Num();
+		for (int32 Index = 0; Index < Track.Sizes.Num(); ++Index)
+		{
+			if (Track.DecodeTimes[Index] >= TrackCutTime && Track.IsSync[Index])
+			{
+				Track.FirstKeptSample = Index;
+				break;
+			}
+		}
+	}
+
+	// Durations are updated before the header is sized, only the chunk offsets change afterwards
+	uint64 MovieDuration = 0;
+	uint64 MediaDataSize = 0;
+
+	for (FTrack& Track : Tracks)
+	{
+		uint64 MediaDuration = 0;
+		for (int32 Index = Track.FirstKeptSample; Index < Track.Sizes.Num(); ++Index)
+		{
+			MediaDuration += Track.Deltas[Index];
+			MediaDataSize += Track.Sizes[Index];
+		}
+
+		const uint64 TrackDuration = static_cast<uint64>(static_cast<double>(MediaDuration) * MovieTimescale / Track.Timescale);
+		MovieDuration = FMath::Max(MovieDuration, TrackDuration);
+
+		WriteDuration(*Track.Mdhd, 16, 24, MediaDuration);
+		WriteDuration(*Track.Tkhd, 20, 28, TrackDuration);
+
+		Track.Box->Children.RemoveAll([](const FBox& Child) { return Child.Type == Edts; });
+	}
+
+	WriteDuration(*MvhdBox, 16, 24, MovieDuration);
+
+	// Trak boxes were changed, so the track pointers into them are refreshed before the tables are rebuilt
+	for (FTrack& Track : Tracks)
+	{
+		Track.Stbl = FindChild(FindChild(FindChild(Track.Box, Mdia), Minf), Stbl);
+		RebuildSampleTables(Track);
+	}
+
+	TArray64<uint8> MoovData;
+	SerializeBox(MoovBox, MoovData);
+
+	const int64 MdatHeaderSize = MediaDataSize + 8 > MAX_uint32 ? 16 : 8;
+	uint64 ChunkOffset = FtypBox.Num() + MoovData.Num() + MdatHeaderSize;
+
+	for (FTrack& Track : Tracks)
+	{
+		Track.ChunkOffset = ChunkOffset;
+		for (int32 Index = Track.FirstKeptSample; Index < Track.Sizes.Num(); ++Index)
+		{
+			ChunkOffset += Track.Sizes[Index];
+		}
+
+		RebuildSampleTables(Track);
+	}
+
+	MoovData.Reset();
+	SerializeBox(MoovBox, MoovData);
+
+	Output.Reset(FtypBox.Num() + MoovData.Num() + MdatHeaderSize + MediaDataSize);
+	Output.Append(FtypBox);
+	Output.Append(MoovData);
+
+	if (MdatHeaderSize == 16)
+	{
+		AppendU32(Output, 1);
+		AppendU32(Output, Mdat);
+		AppendU64(Output, MediaDataSize + 16);
+	}
+	else
+	{
+		AppendU32(Output, static_cast<uint32>(MediaDataSize + 8));
+		AppendU32(Output, Mdat);
+	}
+
+	for (const FTrack& Track : Tracks)
+	{
+		for (int32 Index = Track.FirstKeptSample; Index < Track.Sizes.Num(); ++Index)
+		{
+			Output.Append(Data + Track.Offsets[Index], Track.Sizes[Index]);
+		}
+	}
+
+	if (OutDurationSeconds)
+	{
+		*OutDurationSeconds = static_cast<double>(TotalDuration - VideoTrack->DecodeTimes[CutSample]) / VideoTrack->Timescale;
+	}
+
+	return true;
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trims encoded crash clips down to the requested duration without re-encoding.
+ *
+ * The recorder's circular buffer can only be dropped a whole GOP at a time, so an encoded clip usually starts
+ * a few seconds earlier than requested. The MP4 is rewritten so that it starts at the video keyframe nearest to
+ * the requested start: samples before it are dropped from every track, the sample tables of the kept ones are
+ * rebuilt with a single chunk per track, and the sample data is copied into a new `mdat` placed after `moov`.
+ * Edit lists are dropped since they refer to the original timeline. Fragmented MP4s are left as is.
+ */
+class FSentryCrashVideoTrimmer
+{
+public:
+	static FSentryCrashVideoTrimmer& Get();
+
+	/** Sets the duration clips are trimmed to, 0 disables trimming. Called on the game thread. */
+	void Configure(float InClipSeconds) { ClipSeconds = FMath::Max(0.0f, InClipSeconds); }
+
+	/**
+	 * Trims the clip file in place to the configured duration. Loads the whole clip into memory, so it must not be
+	 * called from the crash handler.
+	 *
+	 * @return True if the clip was trimmed, false if trimming is disabled, the clip is short enough already or can't be parsed.
+	 */
+	bool TrimClip(const FString& Path) const;
+
+	/**
+	 * Trims MP4 data to the last seconds, starting at the video keyframe nearest to the requested start.
+	 *
+	 * @param OutDurationSeconds Duration of the trimmed video track.
+	 * @return True if the data was trimmed, false if there is nothing to trim or the data isn't a supported MP4.
+	 */
+	static bool TrimToLastSeconds(const TArray64<uint8>& Input, float Seconds, TArray64<uint8>& Output, double* OutDurationSeconds = nullptr);
+
+private:
+	float ClipSeconds = 0.0f;
+};
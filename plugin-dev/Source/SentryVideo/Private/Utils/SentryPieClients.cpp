@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryPieClients.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "Widgets/SWindow.h"
+
+namespace SentryPieClients
+{
+	static const SWindow* GetWindow(const FWorldContext& Context)
+	{
+		if (Context.WorldType != EWorldType::PIE || !Context.World() || !Context.GameViewport)
+		{
+			return nullptr;
+		}
+
+		return Context.GameViewport->GetWindow().Get();
+	}
+
+	static const FWorldContext* GetWorldContext(const UObject* WorldContextObject)
+	{
+		UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+		return World ? GEngine->GetWorldContextFromWorld(World) : nullptr;
+	}
+}
+
+TArray<const SWindow*> SentryPieClients::GetClientWindows()
+{
+	TArray<const SWindow*> Windows;
+
+	if (!GIsEditor || !GEngine)
+	{
+		return Windows;
+	}
+
+	TArray<const FWorldContext*> Clients;
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (GetWindow(Context))
+		{
+			Clients.Add(&Context);
+		}
+	}
+
+	Clients.Sort([](const FWorldContext& A, const FWorldContext& B) { return A.PIEInstance < B.PIEInstance; });
+
+	for (const FWorldContext* Context : Clients)
+	{
+		// Clients sharing a window (e.g. split-screen within one instance) are captured once
+		Windows.AddUnique(GetWindow(*Context));
+	}
+
+	return Windows;
+}
+
+const SWindow* SentryPieClients::GetClientWindow(const UObject* WorldContextObject)
+{
+	const FWorldContext* Context = GetWorldContext(WorldContextObject);
+	return Context ? GetWindow(*Context) : nullptr;
+}
+
+bool SentryPieClients::IsClient(const UObject* WorldContextObject)
+{
+	return GIsEditor && WorldContextObject && GetClientWindow(WorldContextObject) != nullptr;
+}
+
+int32 SentryPieClients::GetClientInstance(const UObject* WorldContextObject)
+{
+	const FWorldContext* Context = GIsEditor && WorldContextObject ? GetWorldContext(WorldContextObject) : nullptr;
+	return Context && GetWindow(*Context) ? Context->PIEInstance : INDEX_NONE;
+}
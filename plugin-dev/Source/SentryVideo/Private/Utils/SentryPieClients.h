@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class SWindow;
+
+/**
+ * Clients of a multiplayer Play In Editor session, all running in the editor process and sharing its crash video recording.
+ *
+ * Clients are ordered by their PIE instance so that the order stays the same while clients join and leave. Dedicated
+ * servers and other PIE worlds without a game viewport aren't counted as clients.
+ */
+namespace SentryPieClients
+{
+	/** Gets the windows of the running PIE clients, empty outside of PIE. */
+	TArray<const SWindow*> GetClientWindows();
+
+	/** Gets the window of the PIE client the object belongs to, null if it doesn't belong to a PIE client. */
+	const SWindow* GetClientWindow(const UObject* WorldContextObject);
+
+	/** Checks whether the object belongs to a PIE client. */
+	bool IsClient(const UObject* WorldContextObject);
+
+	/** Gets the PIE instance of the client the object belongs to, INDEX_NONE if it doesn't belong to a PIE client. */
+	int32 GetClientInstance(const UObject* WorldContextObject);
+}
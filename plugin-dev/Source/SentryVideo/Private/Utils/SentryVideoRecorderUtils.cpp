@@ -0,0 +1,25 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryVideoRecorderUtils.h"
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+
+#include "Engine/Engine.h"
+#include "RuntimeVideoRecorder.h"
+#include "UObject/WeakObjectPtr.h"
+
+URuntimeVideoRecorder* SentryVideoRecorderUtils::GetVideoRecorder()
+{
+	static TWeakObjectPtr<URuntimeVideoRecorder> CachedVideoRecorder;
+
+	URuntimeVideoRecorder* VideoRecorder = CachedVideoRecorder.Get();
+	if (!VideoRecorder && GEngine)
+	{
+		VideoRecorder = GEngine->GetEngineSubsystem<URuntimeVideoRecorder>();
+		CachedVideoRecorder = VideoRecorder;
+	}
+
+	return VideoRecorder;
+}
+
+#endif
@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if HAS_RUNTIME_VIDEO_RECORDER
+
+class URuntimeVideoRecorder;
+
+class SentryVideoRecorderUtils
+{
+public:
+	/**
+	 * Gets the Runtime Video Recorder engine subsystem. It lives as long as the engine, so it's only looked up in the
+	 * subsystem collection until it's found once. Null if the engine isn't running or the plugin is disabled.
+	 */
+	static URuntimeVideoRecorder* GetVideoRecorder();
+};
+
+#endif
@@ -6,12 +6,17 @@
 #include "Subsystems/EngineSubsystem.h"
 #include "SentryCrashVideoAttachment.generated.h"
 
+class USentryCrashVideoHandler;
+
 /**
  * Subsystem that integrates Runtime Video Recorder with Sentry crash reporting.
  * Automatically records last N seconds of gameplay and attaches video to crash reports.
+ *
+ * Owns the single crash video handler used by the SDK so that only one capture pipeline and one buffer exist
+ * no matter whether recording is controlled via this subsystem or the Blueprint library.
  */
 UCLASS()
-class SENTRY_API USentryCrashVideoAttachment : public UEngineSubsystem
+class SENTRYVIDEO_API USentryCrashVideoAttachment : public UEngineSubsystem
 {
 	GENERATED_BODY()
 
@@ -37,6 +42,21 @@ public:
 		bool bEnableAudioRecording = false
 	);
 
+	/**
+	 * Enable automatic video recording for crash reports with the first crash video preset from plugin settings
+	 * matching the device profile and scalability level. The preset is re-selected whenever the scalability settings change.
+	 *
+	 * @return True if a matching preset was found and recording started or was scheduled to start
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool EnableCrashVideoRecordingWithPreset();
+
+	/**
+	 * Get the name of the crash video preset recording is currently using, empty if it wasn't started with a preset.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	FString GetActiveCrashVideoPreset() const;
+
 	/**
 	 * Disable automatic video recording for crash reports.
 	 */
@@ -47,7 +67,7 @@ public:
 	 * Check if crash video recording is currently active.
 	 */
 	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
-	bool IsCrashVideoRecordingEnabled() const { return bIsVideoRecordingEnabled; }
+	bool IsCrashVideoRecordingEnabled() const;
 
 	/**
 	 * Get the path where crash videos will be saved.
@@ -55,39 +75,35 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
 	FString GetCrashVideoDirectory() const;
 
+	/**
+	 * Get the crash video handler shared by all crash video recording APIs.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	USentryCrashVideoHandler* GetVideoHandler() const { return VideoHandler; }
+
 protected:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
 private:
-	/**
-	 * Called when a crash or assert occurs.
-	 * Finalizes the video recording and attaches it to the Sentry crash report.
-	 */
-	void OnCrashDetected(const FString& Message);
+	/** Switches to the preset matching the current scalability level if it has changed. */
+	void UpdateCrashVideoPreset();
 
-	/**
-	 * Saves the current video buffer to disk.
-	 * @return Path to the saved video file, or empty string if save failed.
-	 */
-	FString SaveCrashVideo();
+	void StartPresetTracking();
+	void StopPresetTracking();
 
-	/**
-	 * Attaches the video file to the current Sentry scope.
-	 */
-	void AttachVideoToSentry(const FString& VideoPath);
+	/** Re-evaluates the preset once the recorder has settled, scalability changes can arrive while it's finalizing. */
+	void SchedulePresetUpdateRetry();
 
-	/**
-	 * Cleans up old crash video files to prevent disk space issues.
-	 */
-	void CleanupOldCrashVideos();
+	UPROPERTY()
+	USentryCrashVideoHandler* VideoHandler;
 
-private:
-	bool bIsVideoRecordingEnabled = false;
-	FString CrashVideoPath;
-	float RecordingDuration = 30.0f;
-	
-	// Delegate handle for crash detection
-	FDelegateHandle OnAssertDelegateHandle;
-};
+	/** Whether recording follows the presets, cleared when recording is enabled with an explicit config or disabled. */
+	bool bIsPresetTracked = false;
 
+	int32 ActivePresetIndex = INDEX_NONE;
+
+	bool bIsPresetUpdateRetryScheduled = false;
+
+	FDelegateHandle ScalabilityChangedDelegate;
+};
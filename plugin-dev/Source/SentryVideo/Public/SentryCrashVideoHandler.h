@@ -0,0 +1,602 @@
+// Copyright (c) 2025 Unreal Solutions Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "UObject/Object.h"
+#include "SentryCrashVideoConfig.h"
+#include "SentryCrashVideoHandler.generated.h"
+
+class FSentryCrashVideoGovernor;
+class FSentryCrashVideoRetention;
+class SWindow;
+
+/**
+ * Handler class that manages automatic video recording for crash reports.
+ * 
+ * This class integrates Runtime Video Recorder with Sentry's crash reporting system.
+ * When enabled, it continuously records gameplay in a circular buffer (last N seconds)
+ * and automatically attaches the video to crash reports sent to Sentry.
+ * 
+ * Usage Example:
+ * 
+ * // In your game initialization (e.g., BeginPlay):
+ * USentryCrashVideoHandler* VideoHandler = NewObject<USentryCrashVideoHandler>();
+ * VideoHandler->StartContinuousRecording(30.0f); // Record last 30 seconds
+ * 
+ * // The video will automatically be attached to any crash reports
+ * 
+ * Features:
+ * - Low performance overhead (uses circular buffer)
+ * - Configurable duration (5 seconds to 10 minutes)
+ * - Automatic cleanup of old videos
+ * - Works with all Sentry crash types (native crashes, asserts, ensures)
+ */
+
+UENUM(BlueprintType)
+enum class ECrashVideoRecordingState : uint8
+{
+	// No recording is active
+	Idle,
+	// Waiting for another recording to stop before starting the crash video recording
+	WaitingForPreviousRecording,
+	// Crash video recording is active
+	Recording,
+	// Recording was stopped and the video file is being flushed to disk
+	Finalizing,
+	// Recording is suspended while the application is in background or inactive
+	Paused
+};
+
+/**
+ * Counters describing how often the crash video recorder had to be restarted and how many frames were lost meanwhile.
+ */
+USTRUCT(BlueprintType)
+struct FCrashVideoRecordingStats
+{
+	GENERATED_BODY()
+
+	/** Number of recorder restarts (segment rotations and quality changes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Video")
+	int32 NumRestarts = 0;
+
+	/** Estimated number of frames that weren't recorded while the recorder was restarting */
+	UPROPERTY(BlueprintReadOnly, Category = "Video")
+	int32 DroppedFrames = 0;
+
+	/** Time between stopping the recorder and starting it again for the last restart in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Video")
+	float LastRestartLatencyMs = 0.0f;
+
+	/** Longest restart latency since recording started in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Video")
+	float MaxRestartLatencyMs = 0.0f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCrashVideoFinalized, bool, bSuccess, const FString&, VideoPath);
+
+UCLASS(BlueprintType)
+class SENTRYVIDEO_API USentryCrashVideoHandler : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Configuration for crash video recording.
+	 */
+
+	/**
+	 * Start continuous video recording for crash reports.
+	 * Records in a circular buffer, keeping only the last N seconds.
+	 *
+	 * If another recording is in progress it is stopped first and the crash video recording starts
+	 * once the recorder reports that it's idle, without blocking the calling thread.
+	 * 
+	 * @param Config - Configuration for video recording
+	 * @return True if recording started successfully or was scheduled to start
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool StartContinuousRecording(const FCrashVideoConfig& Config);
+
+	/**
+	 * Start continuous recording with default settings.
+	 * 
+	 * @param LastSecondsToRecord - Duration to keep in buffer (default 30 seconds)
+	 * @return True if recording started successfully
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool StartContinuousRecordingSimple(float LastSecondsToRecord = 30.0f);
+
+	/**
+	 * Apply a new configuration to the active recording without losing what's been recorded so far.
+	 *
+	 * Settings handled by the SDK itself (pausing, adaptive quality, kept duration in segmented mode) apply immediately.
+	 * In segmented mode encoder changes take effect with the next segment. Otherwise the recorder is restarted only when
+	 * the recording resolution changes, and other encoder changes are picked up with the next restart (e.g. after pausing).
+	 * Switching between frame strip, segmented and single-file recording starts a new recording.
+	 *
+	 * @param NewConfig - Recording configuration to apply
+	 * @return True if the configuration was applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool UpdateRecordingConfig(const FCrashVideoConfig& NewConfig);
+
+	/**
+	 * Stop continuous video recording.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	void StopContinuousRecording();
+
+	/**
+	 * Pause continuous video recording keeping the footage recorded so far.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	void PauseRecording();
+
+	/**
+	 * Resume continuous video recording paused via PauseRecording.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	void ResumeRecording();
+
+	/**
+	 * Check if continuous recording is active.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	bool IsRecording() const { return RecordingState == ECrashVideoRecordingState::Recording; }
+
+	/**
+	 * Get the current state of the crash video recording.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	ECrashVideoRecordingState GetRecordingState() const { return RecordingState; }
+
+	/**
+	 * Get the directory where crash videos are stored.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	FString GetCrashVideoDirectory() const;
+
+	/**
+	 * Get the directory where segments of the current session are stored. It's emptied whenever segmented recording starts.
+	 */
+	FString GetSegmentsDirectory() const;
+
+	/**
+	 * Manually trigger a video save and attachment (useful for non-crash error reporting).
+	 * This stops the current recording and attaches it to the next Sentry event.
+	 *
+	 * The call doesn't wait for the recorder to flush the video - finalization happens asynchronously
+	 * and the attachment is added to the scope once the file is verified (see `OnVideoFinalized`).
+	 *
+	 * @return Path where the video file is going to be saved, or empty if there is nothing to capture or the capture failed to start
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	FString CaptureAndAttachVideo();
+
+	/**
+	 * Finalize the current recording without blocking the calling thread.
+	 * The recorder is stopped immediately and the output file is polled until it's flushed to disk.
+	 *
+	 * @return Future that resolves on the game thread with the path to the saved video, or empty if failed
+	 */
+	TFuture<FString> FinalizeAndSaveVideoAsync();
+
+	/**
+	 * Send a clip of the recent gameplay to Sentry without interrupting the continuous recording.
+	 *
+	 * In segmented mode the already finalized segments are sent as-is. Otherwise the recorder's circular buffer
+	 * is encoded on a worker thread while capture keeps running. The clip is sent as a separate event
+	 * tagged with `related_event_id`. Only one snapshot can be in progress at a time.
+	 *
+	 * @param RelatedEventId - ID of the event the clip provides context for (e.g. an ensure)
+	 * @param WorldContextObject - Object of the PIE client to send the footage of when several clients share a raw frame ring, whole frames are sent if null
+	 * @return True if the snapshot was started.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool CaptureSnapshotClip(const FString& RelatedEventId, const UObject* WorldContextObject = nullptr);
+
+	/**
+	 * Mark the current moment so that the footage around it is kept without encoding or sending anything yet.
+	 *
+	 * Segments overlapping BookmarkWindowSeconds before and after the bookmark are pinned instead of being rotated out,
+	 * within MaxBookmarkDiskMB. They're sent as a clip once an event tagged `video_bookmark` with the bookmark name is
+	 * captured, when SendBookmarkClip is called, or when recording stops if bSendBookmarksOnStop is set.
+	 * Requires segmented or zero-copy recording as the recorder's circular buffer can't be pinned.
+	 *
+	 * @param Name - Name of the bookmark, replaces an existing bookmark with the same name
+	 * @return True if the bookmark was added.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool Bookmark(const FString& Name);
+
+	/**
+	 * Send the footage kept for a bookmark as a clip and remove the bookmark.
+	 * Footage recorded after calling this is not included even if it falls into the bookmark window.
+	 *
+	 * @param Name - Name of the bookmark
+	 * @param RelatedEventId - ID of the event the clip provides context for (empty if none)
+	 * @return True if the clip is being sent.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	bool SendBookmarkClip(const FString& Name, const FString& RelatedEventId);
+
+	/**
+	 * Remove a bookmark without sending its footage.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	void RemoveBookmark(const FString& Name);
+
+	/** Fired on the game thread once a manually captured video was flushed to disk and verified. */
+	UPROPERTY(BlueprintAssignable, Category = "Sentry|Video")
+	FOnCrashVideoFinalized OnVideoFinalized;
+
+	/**
+	 * Set maximum number of crash videos to keep on disk.
+	 * Older videos will be automatically deleted.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	void SetMaxVideosToKeep(int32 MaxVideos);
+
+	/**
+	 * Set maximum total size of crash videos to keep on disk in megabytes (0 for no limit).
+	 * Older videos will be automatically deleted.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	void SetMaxCrashVideoDiskMB(int32 MaxDiskMB);
+
+	/**
+	 * Get estimated memory used by the recorder's buffer in megabytes.
+	 * In segmented mode this is the size of a single segment since finalized segments are kept on disk.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	float GetEstimatedBufferMemoryMB() const;
+
+	/**
+	 * Get the name of the hardware video encoder expected to be used on this device (e.g. NVENC, AMF, QuickSync).
+	 * On Windows and Linux the encoder is only reported if the driver actually provides it.
+	 *
+	 * @return Encoder name or an empty string if only software encoding is expected to be available.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	static FString GetHardwareEncoderName();
+
+	/**
+	 * Get recorder restart counters for the current recording session.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	FCrashVideoRecordingStats GetRecordingStats() const { return RecordingStats; }
+
+	/**
+	 * Joins the active recording on behalf of a client of a multiplayer Play In Editor session.
+	 *
+	 * A client joins a recording another client started, or one it started itself with the same configuration. Any other
+	 * recording is left to StartContinuousRecording, so that a different configuration isn't silently ignored.
+	 *
+	 * @return True if the client joined and the recording doesn't need to be started.
+	 */
+	bool JoinEditorRecording(const UObject* WorldContextObject, const FCrashVideoConfig& Config);
+
+	/**
+	 * Counts the PIE client that started the recording. A recording started by PIE clients is stopped once all of them
+	 * disabled it, or along with PIE.
+	 */
+	void AddEditorRecordingClient(const UObject* WorldContextObject, const FCrashVideoConfig& Config);
+
+	/**
+	 * Releases the recording on behalf of a PIE client.
+	 *
+	 * @return True if other PIE clients still use the recording and it has to keep running.
+	 */
+	bool RemoveEditorRecordingClient(const UObject* WorldContextObject);
+
+public:
+	// Destructor
+	virtual void BeginDestroy() override;
+
+private:
+	/**
+	 * Starts the recorder with the current configuration.
+	 * Expects that no other recording is in progress.
+	 */
+	bool BeginRecording();
+
+	/**
+	 * Waits until the recorder is idle and starts the crash video recording afterwards.
+	 */
+	void ScheduleRecordingStart();
+
+	/**
+	 * Starts zero-copy recording into the segment ring with the current configuration.
+	 */
+	bool BeginSurfaceEncoderRecording();
+
+	/**
+	 * Starts the surface encoder with the current quality.
+	 *
+	 * @param FirstSegmentIndex - Index of the first segment, -1 to continue the numbering of the previous recording
+	 */
+	bool StartSurfaceEncoder(int32 FirstSegmentIndex);
+
+	/**
+	 * Periodically moves segments finalized by the surface encoder into the segment ring while zero-copy recording is active.
+	 */
+	void ScheduleSurfaceEncoderSegmentPolling();
+
+	/**
+	 * Adds segments finalized by the surface encoder to the segment ring and deletes the evicted ones.
+	 */
+	void CollectSurfaceEncoderSegments();
+
+	/**
+	 * Starts the recorder writing to the given file.
+	 *
+	 * @param VideoPath - Output file path
+	 * @param CircularBufferSeconds - Length of the recorder's circular buffer (0 to write all frames to the file)
+	 */
+	bool StartRecorder(const FString& VideoPath, float CircularBufferSeconds);
+
+	/**
+	 * Periodically finalizes the current segment and starts the next one while segmented recording is active.
+	 */
+	void ScheduleSegmentRotation();
+
+	/**
+	 * Samples frame times and adjusts recording quality while adaptive quality is enabled.
+	 */
+	void ScheduleQualityGovernor();
+
+	/**
+	 * Periodically checks the local players layout of the recorded viewport while split-screen layout tracking is enabled.
+	 */
+	void ScheduleSplitScreenLayoutTracking();
+
+	/**
+	 * Reports the local players layout to Sentry if it changed since the last update.
+	 */
+	void UpdateSplitScreenLayoutContext();
+
+	/**
+	 * Periodically checks the PIE clients while a recording is shared by them or the raw frame ring is recorded in the editor.
+	 */
+	void ScheduleEditorClientTracking();
+
+	/**
+	 * Stops a recording started by PIE clients once PIE has ended, and keeps the raw frame ring tiles up to date.
+	 */
+	void UpdateEditorClients();
+
+	/**
+	 * Captures the windows of all PIE clients into tiles of the raw frame ring.
+	 */
+	void UpdateCapturedClientWindows();
+
+	/**
+	 * Stops the recorder and invokes the callback once it's idle.
+	 * In segmented mode the finished segment is registered in the segment ring.
+	 */
+	void StopRecorderAsync(TFunction<void(USentryCrashVideoHandler*)> OnRecorderStopped);
+
+	/**
+	 * Starts the recorder writing to a new file (or segment) and records restart stats.
+	 */
+	bool ContinueRecording(double StopTime);
+
+	/**
+	 * Stops the recorder and starts it again with the current quality once it's idle.
+	 */
+	void RestartRecorder();
+
+	/**
+	 * Subscribes to application state changes used to pause recording while the app is inactive.
+	 */
+	void BindApplicationStateDelegates();
+
+	/**
+	 * Unsubscribes from application state changes.
+	 */
+	void UnbindApplicationStateDelegates();
+
+	/**
+	 * Applies the encoder thread priority and affinity to the recorder threads, or once the recorder has had time
+	 * to spawn them if it creates them lazily.
+	 */
+	void ApplyEncoderThreadSettings();
+
+	/**
+	 * Reports a quality adjustment made by the adaptive quality governor.
+	 */
+	void AddQualityBreadcrumb(int32 PreviousLevel) const;
+
+	/**
+	 * Clamps values of the current config to the supported ranges.
+	 */
+	void ClampConfig();
+
+	/**
+	 * Lowers bitrate and recording duration of the current config so that the circular buffer fits MaxBufferMemoryMB.
+	 */
+	void FitConfigToMemoryBudget();
+
+	/**
+	 * Resets the quality governor to the quality requested by the current config.
+	 */
+	void ResetQualityGovernor();
+
+	/**
+	 * Get the recording resolution for the current config and viewport size.
+	 */
+	FIntPoint GetRecordingResolution() const;
+
+	/**
+	 * Get estimated memory used by the recorder's buffer in bytes.
+	 */
+	int64 GetEstimatedBufferMemory() const;
+
+	/**
+	 * Resets the finalizing state unless a new recording was requested in the meantime, which is then free to start.
+	 */
+	void CompleteFinalization();
+
+	/**
+	 * Checks whether the recorder has finished writing the video file.
+	 * Used by the finalization ticker so that the game thread never sleeps while waiting for the encoder.
+	 */
+	bool IsVideoFileFinalized(const FString& VideoPath, int64& InOutLastFileSize) const;
+
+	/**
+	 * Attach video file to current Sentry scope.
+	 * Used for manual video captures (non-crash events).
+	 */
+	bool AttachVideoToSentry(const FString& VideoPath);
+
+	/**
+	 * Sends snapshot clip files to Sentry as a separate event.
+	 *
+	 * @param BookmarkName - Name of the bookmark the clip was kept for, empty for regular snapshots
+	 */
+	void SendSnapshotClip(const TArray<FString>& Files, const FString& RelatedEventId, const FString& BookmarkName = FString()) const;
+
+	/**
+	 * Sends the footage kept for a bookmark. When blocking, the clip is copied on the calling thread and handed over
+	 * right away so that it's sent even if the handler is being destroyed.
+	 */
+	bool SendBookmarkClip(const FString& Name, const FString& RelatedEventId, bool bBlocking);
+
+	/**
+	 * Waits for bookmark clips still being copied out of the segments directory, before the directory is wiped.
+	 */
+	void WaitForBookmarkCopies();
+
+	/**
+	 * Waits for the snapshot clip still being encoded, before the recording it reads from is stopped.
+	 */
+	void WaitForSnapshot();
+
+	/**
+	 * Registers the before-send filter sending bookmark clips for events tagged with a bookmark name.
+	 */
+	void BindBookmarkFilter();
+
+	/**
+	 * Unregisters the bookmark before-send filter.
+	 */
+	void UnbindBookmarkFilter();
+
+	/**
+	 * Deletes segments released from bookmarks.
+	 */
+	static void DeleteReleasedSegments(const TArray<FString>& ReleasedSegments);
+
+	/**
+	 * Get the directory where snapshot clips are stored.
+	 */
+	FString GetSnapshotsDirectory() const;
+
+	/**
+	 * Registers a new video in the retention manifest and deletes old ones exceeding the limits on a background thread.
+	 */
+	void CleanupOldVideos(const FString& NewVideoPath);
+
+	/**
+	 * Same as CleanupOldVideos for snapshot clips, which are kept apart from crash videos in the snapshots directory.
+	 */
+	void CleanupOldSnapshots(const FString& NewSnapshotPath);
+
+	/**
+	 * Registers the new video with the given retention and deletes old ones exceeding the limits on a background thread.
+	 */
+	void EnforceRetention(const TSharedPtr<FSentryCrashVideoRetention, ESPMode::ThreadSafe>& Retention, const FString& NewVideoPath) const;
+
+	/**
+	 * Generate a unique filename for crash video.
+	 */
+	FString GenerateVideoFilename() const;
+
+	/**
+	 * Generate a filename for the next crash video segment.
+	 */
+	FString GenerateSegmentFilename();
+
+private:
+	ECrashVideoRecordingState RecordingState = ECrashVideoRecordingState::Idle;
+
+	/** Whether the finalization ticker is still waiting for the stopped recording's file, kept apart from the state which a pending start overrides. */
+	bool bIsFinalizationPending = false;
+
+	FCrashVideoConfig CurrentConfig;
+	FString CurrentSessionVideoPath;
+	int32 MaxVideosToKeep = 10;
+	int32 MaxCrashVideoDiskMB = 0;
+
+	/** Tracks videos stored on disk so that cleanup doesn't need to scan the crash video directory. */
+	TSharedPtr<FSentryCrashVideoRetention, ESPMode::ThreadSafe> VideoRetention;
+
+	/** Tracks snapshot clips stored on disk, same as VideoRetention for the snapshots directory. */
+	TSharedPtr<FSentryCrashVideoRetention, ESPMode::ThreadSafe> SnapshotRetention;
+	
+	/** Incremented on every recording start so that tickers of previous recordings can detect they are stale. */
+	uint32 RecordingGeneration = 0;
+
+	bool bHasLoggedMissingEncoderThreads = false;
+
+	/** Flag indicating whether the recorder is being restarted to begin a new segment or apply new quality. */
+	bool bIsRestartingRecorder = false;
+
+	/** Whether recording should resume once the recorder stops after pausing. */
+	bool bResumePending = false;
+
+	FDelegateHandle OnEnterBackgroundHandle;
+	FDelegateHandle OnEnterForegroundHandle;
+	FDelegateHandle OnActivationStateChangedHandle;
+
+	/** Recorder restart counters for the current recording session. */
+	FCrashVideoRecordingStats RecordingStats;
+
+	/** Adjusts recording quality based on frame time when adaptive quality is enabled. */
+	TSharedPtr<FSentryCrashVideoGovernor> QualityGovernor;
+
+	/** Flag indicating whether a snapshot clip is being encoded. */
+	bool bIsCapturingSnapshot = false;
+
+	/** Last local players layout reported to Sentry. */
+	FString LastSplitScreenLayout;
+
+	/** Windows of the PIE clients captured into tiles of the raw frame ring, in tile order. */
+	TArray<const SWindow*> CapturedClientWindows;
+
+	/** PIE instances of the clients that enabled the recording, it's stopped once the last of them disables it. */
+	TSet<int32> EditorRecordingClients;
+
+	/** Configuration the PIE clients enabled the recording with. */
+	FCrashVideoConfig EditorRecordingConfig;
+
+	/** Incremented whenever PIE client tracking is scheduled or cancelled so that stale tracking tickers stop. */
+	uint32 EditorClientTrackingGeneration = 0;
+
+	/** Flag indicating whether the PIE clients are being tracked. */
+	bool bIsTrackingEditorClients = false;
+
+	/** Before-send filter picking up events that reference a bookmark. */
+	FDelegateHandle BookmarkFilterHandle;
+
+	/** Bookmark clips being copied out of the segments directory on background threads. */
+	TArray<TFuture<void>> PendingBookmarkCopies;
+
+	/** Snapshot clip being encoded on a background thread. */
+	TFuture<void> PendingSnapshot;
+
+	/** Index of the next segment within the current recording session. */
+	int32 NextSegmentIndex = 0;
+
+	/** Flag indicating whether frames are recorded by the Android surface encoder instead of the video recorder. */
+	bool bUsesSurfaceEncoder = false;
+
+	/** Flag indicating whether the recording was started by someone else and reused, so it's left running when stopped. */
+	bool bIsBorrowedRecording = false;
+
+	// Crash-resistant state tracking
+	FThreadSafeBool bCrashDetected;
+};
+
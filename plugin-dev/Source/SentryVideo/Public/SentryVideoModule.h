@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleInterface.h"
+
+#include "SentryCrashVideoCapture.h"
+
+/**
+ * Optional module with the crash video recording features of the SDK.
+ * Registers itself as the crash video capture of the core module while loaded.
+ */
+class SENTRYVIDEO_API FSentryVideoModule : public IModuleInterface, public ISentryCrashVideoCapture
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	/** ISentryCrashVideoCapture implementation */
+	virtual FString PrepareEmergencyClip(const FString& Directory) override;
+	virtual bool EncodeEmergencyClip() override;
+	virtual bool CaptureSnapshotClip(const FString& RelatedEventId) override;
+
+	static const FName ModuleName;
+
+private:
+	/** Path passed to the recorder which appends its own suffix to it. */
+	FString EmergencyClipBasePath;
+	FString EmergencyClipPath;
+};
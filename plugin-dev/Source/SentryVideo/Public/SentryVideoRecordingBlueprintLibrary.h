@@ -7,6 +7,8 @@
 #include "SentryCrashVideoHandler.h"
 #include "SentryVideoRecordingBlueprintLibrary.generated.h"
 
+class UWidget;
+
 /**
  * Blueprint function library for easy integration of crash video recording with Sentry.
  * Provides simple one-line functions to enable crash video recording in your game.
@@ -19,7 +21,7 @@
  * That's it! Videos will automatically be attached to crash reports.
  */
 UCLASS()
-class SENTRY_API USentryVideoRecordingBlueprintLibrary : public UBlueprintFunctionLibrary
+class SENTRYVIDEO_API USentryVideoRecordingBlueprintLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
@@ -27,6 +29,9 @@ public:
 	/**
 	 * Enable automatic crash video recording with default settings.
 	 * This is the simplest way to enable crash video recording.
+	 *
+	 * Clients of a multiplayer Play In Editor session share a single recording: clients enabling it after the first one
+	 * join the running recording, and with the raw frame ring every client is captured into a tile of the same frames.
 	 * 
 	 * @param WorldContextObject - World context (usually Self)
 	 * @param LastSecondsToRecord - Number of seconds to keep in buffer (default 30)
@@ -56,6 +61,7 @@ public:
 
 	/**
 	 * Disable crash video recording.
+	 * A recording shared by other Play In Editor clients keeps running until the last client that enabled it disables it, or PIE ends.
 	 * 
 	 * @param WorldContextObject - World context (usually Self)
 	 */
@@ -74,9 +80,10 @@ public:
 	/**
 	 * Manually capture and attach the current video buffer to the next Sentry event.
 	 * Useful for non-crash errors where you want to include video context.
+	 * The video is finalized asynchronously and attached once it's flushed to disk.
 	 * 
 	 * @param WorldContextObject - World context (usually Self)
-	 * @return Path to the saved video file, or empty if failed
+	 * @return Path where the video file is going to be saved, or empty if failed
 	 * 
 	 * Example (Blueprint):
 	 *   1. Sentry Capture Video Now
@@ -103,6 +110,46 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sentry|Video", meta = (WorldContext = "WorldContextObject"))
 	static bool SentryEnableCrashVideoRecordingPC(UObject* WorldContextObject);
 
+	/**
+	 * Quick setup picking the recording configuration from the crash video presets in plugin settings
+	 * by device profile and scalability level, switching presets whenever the scalability settings change.
+	 * 
+	 * @param WorldContextObject - World context (usually Self)
+	 * @return True if a matching preset was found and recording started successfully
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video", meta = (WorldContext = "WorldContextObject"))
+	static bool SentryEnableCrashVideoRecordingForDevice(UObject* WorldContextObject);
+
+	/**
+	 * Get the recording configuration used by the mobile quick setup.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	static FCrashVideoConfig SentryGetCrashVideoConfigMobile();
+
+	/**
+	 * Get the recording configuration used by the PC/Console quick setup.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sentry|Video")
+	static FCrashVideoConfig SentryGetCrashVideoConfigPC();
+
+	/**
+	 * Redact the widget from the screenshots and the crash frame strip captured by Sentry.
+	 * The widget's area is blacked out on the GPU before the frame is read back.
+	 * Recording the UI into crash videos is disabled while any widget is redacted.
+	 * 
+	 * @param Widget - Widget to redact until it's unredacted or destroyed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	static void SentryRedactWidget(UWidget* Widget);
+
+	/**
+	 * Stop redacting the widget from the frames captured by Sentry.
+	 * 
+	 * @param Widget - Widget previously passed to Sentry Redact Widget
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Sentry|Video")
+	static void SentryUnredactWidget(UWidget* Widget);
+
 	/**
 	 * Check if Sentry and Runtime Video Recorder are both available.
 	 * Use this before enabling crash video recording to verify prerequisites.
@@ -122,14 +169,13 @@ public:
 
 private:
 	/**
-	 * Get or create the video handler for the given world.
-	 * Stores handler in the game instance to prevent garbage collection.
+	 * Get the video handler owned by the crash video attachment subsystem, logging an error if it's not available.
 	 */
-	static USentryCrashVideoHandler* GetOrCreateVideoHandler(UObject* WorldContextObject);
+	static USentryCrashVideoHandler* GetRequiredVideoHandler(UObject* WorldContextObject);
 
 	/**
-	 * Get existing video handler if it exists.
+	 * Get the video handler owned by the crash video attachment subsystem.
 	 */
-	static USentryCrashVideoHandler* GetExistingVideoHandler(UObject* WorldContextObject);
+	static USentryCrashVideoHandler* GetVideoHandler(UObject* WorldContextObject);
 };
 
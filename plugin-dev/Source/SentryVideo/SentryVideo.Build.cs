@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+using UnrealBuildTool;
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+public class SentryVideo : ModuleRules
+{
+	public SentryVideo(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"Sentry"
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"Slate",
+				"SlateCore",
+				"UMG",
+				"RenderCore",
+				"RHI"
+			}
+		);
+
+		// Video recorder is a separate Fab plugin, without it only the frame strip, raw frame ring and zero-copy paths are built
+		bool bEnableVideoRecording = IsRuntimeVideoRecorderAvailable(Target);
+		if (bEnableVideoRecording)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"RuntimeVideoRecorder",
+				}
+			);
+		}
+
+		PublicDefinitions.Add("HAS_RUNTIME_VIDEO_RECORDER=" + (bEnableVideoRecording ? "1" : "0"));
+
+		if (Target.Platform == UnrealTargetPlatform.Win64)
+		{
+			// Hardware encoder availability is queried from Media Foundation
+			PublicSystemLibraries.AddRange(new string[] { "mfplat.lib", "mfuuid.lib" });
+		}
+		else if (Target.Platform == UnrealTargetPlatform.IOS || Target.Platform == UnrealTargetPlatform.Mac)
+		{
+			// Zero-copy crash video recording scales frames with Metal into pixel buffers of a VideoToolbox session
+			PublicFrameworks.AddRange(new string[] { "AVFoundation", "CoreMedia", "CoreVideo", "Metal", "MetalPerformanceShaders", "VideoToolbox" });
+		}
+		else if (Target.Platform == UnrealTargetPlatform.Android)
+		{
+			// Zero-copy crash video recording starts the Java encoder through the engine's JNI helpers and renders into its surface through EGL
+			PrivateDependencyModuleNames.Add("Launch");
+			PublicSystemLibraries.AddRange(new string[] { "EGL", "GLESv3", "android" });
+		}
+	}
+
+	// SENTRY_ENABLE_VIDEO_RECORDING overrides the lookup, e.g. for engines with the recorder installed elsewhere
+	private bool IsRuntimeVideoRecorderAvailable(ReadOnlyTargetRules Target)
+	{
+		string EnvValue = Environment.GetEnvironmentVariable("SENTRY_ENABLE_VIDEO_RECORDING");
+		if (!string.IsNullOrEmpty(EnvValue))
+		{
+			return EnvValue == "1" || EnvValue.Equals("true", StringComparison.OrdinalIgnoreCase);
+		}
+
+		List<string> PluginDirectories = new List<string>();
+		if (Target.ProjectFile != null)
+		{
+			PluginDirectories.Add(Path.Combine(Target.ProjectFile.Directory.FullName, "Plugins"));
+		}
+		PluginDirectories.Add(Path.Combine(EngineDirectory, "Plugins", "Marketplace"));
+
+		foreach (string PluginDirectory in PluginDirectories)
+		{
+			if (Directory.Exists(PluginDirectory) && Directory.GetFiles(PluginDirectory, "RuntimeVideoRecorder.uplugin", SearchOption.AllDirectories).Length > 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
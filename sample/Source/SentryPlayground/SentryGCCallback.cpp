@@ -12,7 +12,7 @@ void FSentryGCCallback::AddReferencedObjects(FReferenceCollector& Collector)
 	if (IsGarbageCollecting())
 	{
 		// This should trigger the Sentry's beforeSend callback invocation (if configured)
-		// and skip its handler due to current GC limitations
+		// which holds the event until GC finishes and only then passes it to the handler
 		USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
 		if (SentrySubsystem)
 		{
@@ -6,10 +6,13 @@
 #include "SentrySubsystem.h"
 #include "SentrySettings.h"
 #include "SentryPlaygroundUtils.h"
+#include "SentryPlaygroundStressTest.h"
+#include "SentryPlaygroundVideoSweep.h"
 #include "SentryUser.h"
 
 #include "Misc/CommandLine.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 
 void USentryPlaygroundGameInstance::Init()
 {
@@ -20,7 +23,10 @@ void USentryPlaygroundGameInstance::Init()
 	// Check for expected test parameters to decide between running integration tests
 	// or launching the sample app with UI for manual testing
 	if (FParse::Param(FCommandLine::Get(), TEXT("crash-capture")) || 
-		FParse::Param(FCommandLine::Get(), TEXT("message-capture")))
+		FParse::Param(FCommandLine::Get(), TEXT("message-capture")) ||
+		FParse::Param(FCommandLine::Get(), TEXT("crash-timeline")) ||
+		FParse::Param(FCommandLine::Get(), TEXT("stress")) ||
+		FParse::Param(FCommandLine::Get(), TEXT("video-sweep")))
 	{
 		RunIntegrationTest(CommandLine);
 	}
@@ -45,6 +51,22 @@ void USentryPlaygroundGameInstance::RunIntegrationTest(const TCHAR* CommandLine)
 		{
 			Settings->Dsn = Dsn;
 		}
+
+		// Enable the most expensive crash handler stages so that their timings end up in the crash timeline
+		if (FParse::Param(CommandLine, TEXT("crash-timeline")))
+		{
+			Settings->AttachScreenshot = true;
+			Settings->AttachGpuDump = true;
+			Settings->AttachCrashVideo = true;
+			Settings->WriteCrashTimeline = true;
+		}
+
+		// Recording is driven by the sweep itself
+		if (FParse::Param(CommandLine, TEXT("video-sweep")))
+		{
+			Settings->AttachCrashVideo = true;
+			Settings->AutoStartCrashVideoRecording = false;
+		}
 	}));
 
 	if (!SentrySubsystem->IsEnabled())
@@ -61,7 +83,7 @@ void USentryPlaygroundGameInstance::RunIntegrationTest(const TCHAR* CommandLine)
 	SentrySubsystem->AddBreadcrumbWithParams(
 		TEXT("Context configuration finished"), TEXT("Test"), TEXT("info"), TMap<FString, FSentryVariant>(), ESentryLevel::Info);
 
-	if (FParse::Param(CommandLine, TEXT("crash-capture")))
+	if (FParse::Param(CommandLine, TEXT("crash-capture")) || FParse::Param(CommandLine, TEXT("crash-timeline")))
 	{
 		RunCrashTest();
 	}
@@ -69,6 +91,14 @@ void USentryPlaygroundGameInstance::RunIntegrationTest(const TCHAR* CommandLine)
 	{
 		RunMessageTest();
 	}
+	else if (FParse::Param(CommandLine, TEXT("stress")))
+	{
+		RunStressTest(CommandLine);
+	}
+	else if (FParse::Param(CommandLine, TEXT("video-sweep")))
+	{
+		RunVideoSweep(CommandLine);
+	}
 }
 
 void USentryPlaygroundGameInstance::RunCrashTest()
@@ -98,6 +128,78 @@ void USentryPlaygroundGameInstance::RunMessageTest()
 	CompleteTestWithResult(TEXT("message-capture"), !EventId.IsEmpty(), TEXT("Test complete"));
 }
 
+void USentryPlaygroundGameInstance::RunStressTest(const TCHAR* CommandLine)
+{
+	StressTest = MakeShared<FSentryPlaygroundStressTest>(FSentryStressTestConfig::FromCommandLine(CommandLine));
+	StressTest->Start();
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+
+	StressTestTickerHandle = Ticker.AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime)
+	{
+		if (StressTest->Tick(DeltaTime))
+		{
+			return true;
+		}
+
+		USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+
+		const FString Report = StressTest->GetReport();
+
+		UE_LOG(LogSentrySample, Log, TEXT("STRESS_RESULT: %s\n"), *Report);
+
+		StressTest.Reset();
+
+		CompleteTestWithResult(TEXT("stress"), SentrySubsystem->IsEnabled(), TEXT("Test complete"));
+		return false;
+	}));
+}
+
+void USentryPlaygroundGameInstance::RunVideoSweep(const TCHAR* CommandLine)
+{
+	VideoSweep = MakeShared<FSentryPlaygroundVideoSweep>(FSentryVideoSweepConfig::FromCommandLine(CommandLine));
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker& Ticker = FTicker::GetCoreTicker();
+#else
+	FTSTicker& Ticker = FTSTicker::GetCoreTicker();
+#endif
+
+	VideoSweepTickerHandle = Ticker.AddTicker(FTickerDelegate::CreateLambda([this, bIsStarted = false](float DeltaTime) mutable
+	{
+		// Camera path starts from the player's view, which only exists once the map has begun play
+		if (!bIsStarted)
+		{
+			UWorld* World = GetWorld();
+			if (!World || !World->HasBegunPlay())
+			{
+				return true;
+			}
+
+			VideoSweep->Start(World);
+			bIsStarted = true;
+		}
+
+		if (VideoSweep->Tick(DeltaTime))
+		{
+			return true;
+		}
+
+		UE_LOG(LogSentrySample, Log, TEXT("VIDEO_SWEEP_RESULT: %s\n"), *VideoSweep->GetOutputPath());
+
+		const int32 NumCombinations = VideoSweep->GetNumCombinations();
+
+		VideoSweep.Reset();
+
+		CompleteTestWithResult(TEXT("video-sweep"), NumCombinations > 0, TEXT("Test complete"));
+		return false;
+	}));
+}
+
 void USentryPlaygroundGameInstance::ConfigureTestContext()
 {
 	USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
@@ -6,8 +6,13 @@
 #include "Engine/GameInstance.h"
 #include "SentryPlaygroundUtils.h"
 #include "SentrySubsystem.h"
+#include "Containers/Ticker.h"
+#include "Misc/EngineVersionComparison.h"
 #include "SentryPlaygroundGameInstance.generated.h"
 
+class FSentryPlaygroundStressTest;
+class FSentryPlaygroundVideoSweep;
+
 /**
  * 
  */
@@ -23,8 +28,21 @@ private:
 	void RunIntegrationTest(const TCHAR* CommandLine);
 	void RunCrashTest();
 	void RunMessageTest();
+	void RunStressTest(const TCHAR* CommandLine);
+	void RunVideoSweep(const TCHAR* CommandLine);
 
 	void ConfigureTestContext();
 
 	void CompleteTestWithResult(const FString& TestName, bool Result, const FString& Message);
+
+	TSharedPtr<FSentryPlaygroundStressTest> StressTest;
+	TSharedPtr<FSentryPlaygroundVideoSweep> VideoSweep;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FDelegateHandle StressTestTickerHandle;
+	FDelegateHandle VideoSweepTickerHandle;
+#else
+	FTSTicker::FDelegateHandle StressTestTickerHandle;
+	FTSTicker::FDelegateHandle VideoSweepTickerHandle;
+#endif
 };
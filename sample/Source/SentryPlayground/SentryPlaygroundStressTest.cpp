@@ -0,0 +1,321 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryPlaygroundStressTest.h"
+
+#include "SentryPlayground.h"
+
+#include "SentryAttachment.h"
+#include "SentryLibrary.h"
+#include "SentryScope.h"
+#include "SentrySpan.h"
+#include "SentrySubsystem.h"
+#include "SentryTransaction.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+static constexpr int32 NumOperations = 5;
+
+FSentryStressTestConfig FSentryStressTestConfig::FromCommandLine(const TCHAR* CommandLine)
+{
+	FSentryStressTestConfig Config;
+
+	FParse::Value(CommandLine, TEXT("stress-threads="), Config.NumThreads);
+	FParse::Value(CommandLine, TEXT("stress-duration="), Config.DurationSeconds);
+	FParse::Value(CommandLine, TEXT("stress-logs="), Config.LogsPerSecond);
+	FParse::Value(CommandLine, TEXT("stress-breadcrumbs="), Config.BreadcrumbsPerSecond);
+	FParse::Value(CommandLine, TEXT("stress-captures="), Config.CapturesPerSecond);
+	FParse::Value(CommandLine, TEXT("stress-transactions="), Config.TransactionsPerSecond);
+	FParse::Value(CommandLine, TEXT("stress-attachments="), Config.AttachmentsPerSecond);
+	FParse::Value(CommandLine, TEXT("stress-attachment-size="), Config.AttachmentSize);
+
+	Config.NumThreads = FMath::Max(1, Config.NumThreads);
+	Config.AttachmentSize = FMath::Max(1, Config.AttachmentSize);
+
+	return Config;
+}
+
+void FSentryPlaygroundStressTest::FOperationStats::Append(const FOperationStats& Other)
+{
+	NumCalls += Other.NumCalls;
+	NumDropped += Other.NumDropped;
+	LatenciesUs.Append(Other.LatenciesUs);
+}
+
+FSentryPlaygroundStressTest::FSentryPlaygroundStressTest(const FSentryStressTestConfig& InConfig)
+	: Config(InConfig)
+	, bStopRequested(false)
+	, StartTime(0.0)
+	, EndTime(0.0)
+	, StartUsedPhysical(0)
+	, PeakUsedPhysical(0)
+	, bIsFinished(false)
+{
+	AttachmentData.SetNumUninitialized(Config.AttachmentSize);
+	for (int32 i = 0; i < AttachmentData.Num(); ++i)
+	{
+		AttachmentData[i] = static_cast<uint8>(i);
+	}
+}
+
+FSentryPlaygroundStressTest::~FSentryPlaygroundStressTest()
+{
+	bStopRequested = true;
+
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+}
+
+void FSentryPlaygroundStressTest::Start()
+{
+	UE_LOG(LogSentrySample, Display, TEXT("Starting stress test: %d threads, %.0f s, %.1f logs/s, %.1f breadcrumbs/s, %.1f captures/s, %.1f transactions/s, %.1f attachments/s"),
+		Config.NumThreads, Config.DurationSeconds, Config.LogsPerSecond, Config.BreadcrumbsPerSecond, Config.CapturesPerSecond, Config.TransactionsPerSecond, Config.AttachmentsPerSecond);
+
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysical = StartUsedPhysical;
+
+	StartTime = FPlatformTime::Seconds();
+	EndTime = StartTime + Config.DurationSeconds;
+
+	for (const EOperation Operation : { EOperation::Transaction, EOperation::Attachment })
+	{
+		const float Rate = GetRate(Operation);
+		GameThreadSchedules[static_cast<int32>(Operation)].Interval = Rate > 0.0f ? 1.0 / Rate : 0.0;
+		GameThreadSchedules[static_cast<int32>(Operation)].NextTime = StartTime;
+	}
+
+	for (int32 WorkerIndex = 0; WorkerIndex < Config.NumThreads; ++WorkerIndex)
+	{
+		Workers.Add(Async(EAsyncExecution::Thread, [this, WorkerIndex]()
+		{
+			RunWorker(WorkerIndex);
+		}));
+	}
+}
+
+bool FSentryPlaygroundStressTest::Tick(float DeltaTime)
+{
+	if (bIsFinished)
+	{
+		return false;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+
+	if (Now < EndTime)
+	{
+		static const EOperation GameThreadOperations[] = { EOperation::Transaction, EOperation::Attachment };
+		RunDueOperations(GameThreadOperations, GameThreadSchedules, Stats, Now, INDEX_NONE);
+		return true;
+	}
+
+	bStopRequested = true;
+
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+
+	Workers.Empty();
+
+	bIsFinished = true;
+	return false;
+}
+
+FString FSentryPlaygroundStressTest::GetReport() const
+{
+	const double Duration = FMath::Max(FMath::Min(FPlatformTime::Seconds(), EndTime) - StartTime, 0.001);
+
+	TArray<FString> OperationReports;
+
+	for (int32 i = 0; i < NumOperations; ++i)
+	{
+		const FOperationStats& OperationStats = Stats[i];
+		if (OperationStats.NumCalls == 0)
+		{
+			continue;
+		}
+
+		TArray<float> Latencies = OperationStats.LatenciesUs;
+		Latencies.Sort();
+
+		const auto GetPercentile = [&Latencies](float Percentile)
+		{
+			return Latencies.Num() > 0 ? Latencies[FMath::Min(Latencies.Num() - 1, FMath::FloorToInt(Latencies.Num() * Percentile))] : 0.0f;
+		};
+
+		OperationReports.Add(FString::Printf(TEXT("\"%s\":{\"calls\":%lld,\"per_second\":%.1f,\"dropped\":%lld,\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f}"),
+			GetOperationName(static_cast<EOperation>(i)), OperationStats.NumCalls, OperationStats.NumCalls / Duration, OperationStats.NumDropped,
+			GetPercentile(0.5f), GetPercentile(0.99f), Latencies.Num() > 0 ? Latencies.Last() : 0.0f));
+	}
+
+	const uint64 EndUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+	return FString::Printf(TEXT("{\"duration_s\":%.1f,\"threads\":%d,%s,\"memory_growth_mb\":%.1f,\"memory_peak_growth_mb\":%.1f}"),
+		Duration, Config.NumThreads, *FString::Join(OperationReports, TEXT(",")),
+		(static_cast<double>(EndUsedPhysical) - StartUsedPhysical) / (1024.0 * 1024.0),
+		(static_cast<double>(PeakUsedPhysical) - StartUsedPhysical) / (1024.0 * 1024.0));
+}
+
+void FSentryPlaygroundStressTest::RunWorker(int32 WorkerIndex)
+{
+	static const EOperation WorkerOperations[] = { EOperation::Log, EOperation::Breadcrumb, EOperation::Capture };
+
+	FSchedule Schedules[NumOperations];
+	FOperationStats WorkerStats[NumOperations];
+
+	const double WorkerStartTime = FPlatformTime::Seconds();
+
+	for (const EOperation Operation : WorkerOperations)
+	{
+		// Each worker generates its share of the total rate, offset so that workers don't fire in lockstep
+		const float Rate = GetRate(Operation) / Config.NumThreads;
+		FSchedule& Schedule = Schedules[static_cast<int32>(Operation)];
+		Schedule.Interval = Rate > 0.0f ? 1.0 / Rate : 0.0;
+		Schedule.NextTime = WorkerStartTime + Schedule.Interval * WorkerIndex / Config.NumThreads;
+
+		WorkerStats[static_cast<int32>(Operation)].LatenciesUs.Reserve(FMath::Min<int64>(FMath::CeilToInt(Rate * Config.DurationSeconds) + 1, 1000000));
+	}
+
+	while (!bStopRequested)
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double NextTime = RunDueOperations(WorkerOperations, Schedules, WorkerStats, Now, WorkerIndex);
+
+		FPlatformProcess::Sleep(FMath::Clamp(static_cast<float>(NextTime - FPlatformTime::Seconds()), 0.0f, 0.01f));
+	}
+
+	FScopeLock Lock(&StatsLock);
+
+	for (int32 i = 0; i < NumOperations; ++i)
+	{
+		Stats[i].Append(WorkerStats[i]);
+	}
+}
+
+double FSentryPlaygroundStressTest::RunDueOperations(TArrayView<const EOperation> Operations, FSchedule* Schedules, FOperationStats* OperationStats, double Now, int32 WorkerIndex)
+{
+	double NextTime = Now + 1.0;
+
+	for (const EOperation Operation : Operations)
+	{
+		FSchedule& Schedule = Schedules[static_cast<int32>(Operation)];
+		if (Schedule.Interval <= 0.0)
+		{
+			continue;
+		}
+
+		FOperationStats& Stat = OperationStats[static_cast<int32>(Operation)];
+
+		// Calls that fell more than a second behind are skipped rather than bursted, the reported rate shows the shortfall
+		Schedule.NextTime = FMath::Max(Schedule.NextTime, Now - 1.0);
+
+		while (Schedule.NextTime <= Now && !bStopRequested)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			const bool bIsAccepted = RunOperation(Operation, WorkerIndex, Stat.NumCalls);
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+
+			Stat.LatenciesUs.Add(static_cast<float>(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1e6));
+			Stat.NumCalls++;
+			Stat.NumDropped += bIsAccepted ? 0 : 1;
+
+			Schedule.NextTime += Schedule.Interval;
+		}
+
+		NextTime = FMath::Min(NextTime, Schedule.NextTime);
+	}
+
+	return NextTime;
+}
+
+bool FSentryPlaygroundStressTest::RunOperation(EOperation Operation, int32 WorkerIndex, int64 CallIndex)
+{
+	USentrySubsystem* SentrySubsystem = GEngine->GetEngineSubsystem<USentrySubsystem>();
+
+	switch (Operation)
+	{
+	case EOperation::Log:
+		UE_LOG(LogSentrySample, Warning, TEXT("Stress test log %lld from worker %d"), CallIndex, WorkerIndex);
+		return true;
+	case EOperation::Breadcrumb:
+		SentrySubsystem->AddBreadcrumbWithParams(FString::Printf(TEXT("Stress test breadcrumb %lld"), CallIndex), TEXT("stress"), TEXT("default"),
+			{ { TEXT("worker"), WorkerIndex }, { TEXT("call"), static_cast<int32>(CallIndex) } }, ESentryLevel::Info);
+		return true;
+	case EOperation::Capture:
+		return !SentrySubsystem->CaptureMessage(FString::Printf(TEXT("Stress test message from worker %d"), WorkerIndex), ESentryLevel::Warning).IsEmpty();
+	case EOperation::Transaction:
+	{
+		USentryTransaction* Transaction = SentrySubsystem->StartTransaction(TEXT("Stress test transaction"), TEXT("stress.transaction"));
+		if (!Transaction)
+		{
+			return false;
+		}
+
+		USentrySpan* Span = Transaction->StartChildSpan(TEXT("stress.span"), TEXT("Stress test span"));
+		if (Span)
+		{
+			Span->Finish();
+		}
+
+		Transaction->Finish();
+		return true;
+	}
+	case EOperation::Attachment:
+	{
+		USentryAttachment* Attachment = USentryLibrary::CreateSentryAttachmentWithData(AttachmentData, TEXT("stress.bin"));
+		return !SentrySubsystem->CaptureMessageWithScope(TEXT("Stress test message with attachment"), FConfigureScopeNativeDelegate::CreateLambda([Attachment](USentryScope* Scope)
+		{
+			Scope->AddAttachment(Attachment);
+		}), ESentryLevel::Warning).IsEmpty();
+	}
+	default:
+		return false;
+	}
+}
+
+float FSentryPlaygroundStressTest::GetRate(EOperation Operation) const
+{
+	switch (Operation)
+	{
+	case EOperation::Log:
+		return Config.LogsPerSecond;
+	case EOperation::Breadcrumb:
+		return Config.BreadcrumbsPerSecond;
+	case EOperation::Capture:
+		return Config.CapturesPerSecond;
+	case EOperation::Transaction:
+		return Config.TransactionsPerSecond;
+	case EOperation::Attachment:
+		return Config.AttachmentsPerSecond;
+	default:
+		return 0.0f;
+	}
+}
+
+const TCHAR* FSentryPlaygroundStressTest::GetOperationName(EOperation Operation)
+{
+	switch (Operation)
+	{
+	case EOperation::Log:
+		return TEXT("logs");
+	case EOperation::Breadcrumb:
+		return TEXT("breadcrumbs");
+	case EOperation::Capture:
+		return TEXT("captures");
+	case EOperation::Transaction:
+		return TEXT("transactions");
+	case EOperation::Attachment:
+		return TEXT("attachments");
+	default:
+		return TEXT("unknown");
+	}
+}
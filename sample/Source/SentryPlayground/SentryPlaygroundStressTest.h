@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
+
+struct FSentryStressTestConfig
+{
+	int32 NumThreads = 4;
+	float DurationSeconds = 30.0f;
+
+	/** Rates are totals per second across all threads, 0 disables the corresponding operation */
+	float LogsPerSecond = 1000.0f;
+	float BreadcrumbsPerSecond = 500.0f;
+	float CapturesPerSecond = 5.0f;
+	float TransactionsPerSecond = 5.0f;
+	float AttachmentsPerSecond = 0.5f;
+
+	int32 AttachmentSize = 256 * 1024;
+
+	/** Reads `-stress-threads=`, `-stress-duration=`, `-stress-logs=`, `-stress-breadcrumbs=`, `-stress-captures=`,
+	 * `-stress-transactions=`, `-stress-attachments=` and `-stress-attachment-size=` overrides. */
+	static FSentryStressTestConfig FromCommandLine(const TCHAR* CommandLine);
+};
+
+/**
+ * Load generator for validating the SDK at production event rates.
+ *
+ * Logs, breadcrumbs and message captures are generated by worker threads. Transactions and captures with attachments
+ * create UObjects so they're generated from the game thread in Tick. Every call is timed to report its latency
+ * percentiles, captures which don't return an event ID are counted as dropped. Meant to be run against a local
+ * mock DSN sink (see scripts/mock-dsn-sink.py) which reports how many items actually arrived.
+ */
+class FSentryPlaygroundStressTest
+{
+public:
+	explicit FSentryPlaygroundStressTest(const FSentryStressTestConfig& InConfig);
+	~FSentryPlaygroundStressTest();
+
+	void Start();
+
+	/** Runs the game thread operations, returns false once the test has finished. */
+	bool Tick(float DeltaTime);
+
+	/** Gets the results as a JSON object. */
+	FString GetReport() const;
+
+private:
+	enum class EOperation : uint8
+	{
+		Log,
+		Breadcrumb,
+		Capture,
+		Transaction,
+		Attachment,
+		Num
+	};
+
+	struct FOperationStats
+	{
+		int64 NumCalls = 0;
+		int64 NumDropped = 0;
+		TArray<float> LatenciesUs;
+
+		void Append(const FOperationStats& Other);
+	};
+
+	struct FSchedule
+	{
+		double Interval = 0.0;
+		double NextTime = 0.0;
+	};
+
+	void RunWorker(int32 WorkerIndex);
+
+	/** Runs the operations due at the given time, returns the time the next one is due. */
+	double RunDueOperations(TArrayView<const EOperation> Operations, FSchedule* Schedules, FOperationStats* Stats, double Now, int32 WorkerIndex);
+
+	bool RunOperation(EOperation Operation, int32 WorkerIndex, int64 CallIndex);
+
+	float GetRate(EOperation Operation) const;
+
+	static const TCHAR* GetOperationName(EOperation Operation);
+
+	FSentryStressTestConfig Config;
+
+	TArray<TFuture<void>> Workers;
+	TAtomic<bool> bStopRequested;
+
+	double StartTime;
+	double EndTime;
+
+	uint64 StartUsedPhysical;
+	uint64 PeakUsedPhysical;
+
+	TArray<uint8> AttachmentData;
+
+	FSchedule GameThreadSchedules[static_cast<int32>(EOperation::Num)];
+
+	/** Stats of the game thread operations and, once finished, merged stats of the worker threads */
+	FOperationStats Stats[static_cast<int32>(EOperation::Num)];
+	FCriticalSection StatsLock;
+
+	bool bIsFinished;
+};
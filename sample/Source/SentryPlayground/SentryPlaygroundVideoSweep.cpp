@@ -0,0 +1,373 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#include "SentryPlaygroundVideoSweep.h"
+
+#include "SentryPlayground.h"
+
+#include "SentryCrashVideoHandler.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+static constexpr double SegmentsFlushSeconds = 1.0;
+
+static const TCHAR* VideoSweepCsvHeader = TEXT("encoder,width,height,fps,quality,frames,frame_ms,capture_cost_ms,game_thread_ms,render_thread_ms,gpu_ms,encode_ms,memory_growth_mb,buffer_memory_mb,output_bytes,bytes_per_second");
+
+FSentryVideoSweepConfig FSentryVideoSweepConfig::FromCommandLine(const TCHAR* CommandLine)
+{
+	FSentryVideoSweepConfig Config;
+
+	FString List;
+	TArray<FString> Values;
+
+	if (FParse::Value(CommandLine, TEXT("sweep-resolutions="), List) && List.ParseIntoArray(Values, TEXT(",")) > 0)
+	{
+		Config.Resolutions.Empty();
+		for (const FString& Value : Values)
+		{
+			FString Width, Height;
+			if (Value.Split(TEXT("x"), &Width, &Height) && FCString::Atoi(*Width) > 0 && FCString::Atoi(*Height) > 0)
+			{
+				Config.Resolutions.Add(FIntPoint(FCString::Atoi(*Width), FCString::Atoi(*Height)));
+			}
+		}
+	}
+
+	if (FParse::Value(CommandLine, TEXT("sweep-fps="), List) && List.ParseIntoArray(Values, TEXT(",")) > 0)
+	{
+		Config.FramesPerSecond.Empty();
+		for (const FString& Value : Values)
+		{
+			Config.FramesPerSecond.Add(FMath::Max(1, FCString::Atoi(*Value)));
+		}
+	}
+
+	if (FParse::Value(CommandLine, TEXT("sweep-quality="), List) && List.ParseIntoArray(Values, TEXT(",")) > 0)
+	{
+		Config.QualityPresets.Empty();
+		for (const FString& Value : Values)
+		{
+			Config.QualityPresets.Add(FMath::Clamp(FCString::Atoi(*Value), 0, 100));
+		}
+	}
+
+	if (FParse::Value(CommandLine, TEXT("sweep-encoders="), List) && List.ParseIntoArray(Values, TEXT(",")) > 0)
+	{
+		Config.Encoders = Values;
+	}
+
+	FParse::Value(CommandLine, TEXT("sweep-seconds="), Config.RecordSeconds);
+	FParse::Value(CommandLine, TEXT("sweep-cooldown="), Config.CooldownSeconds);
+
+	if (!FParse::Value(CommandLine, TEXT("sweep-output="), Config.OutputPath))
+	{
+		Config.OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("VideoSweep.csv"));
+	}
+
+	// Recorder keeps at least 5 seconds in its buffer
+	Config.RecordSeconds = FMath::Max(5.0f, Config.RecordSeconds);
+	Config.CooldownSeconds = FMath::Max(0.0f, Config.CooldownSeconds);
+
+	return Config;
+}
+
+void FSentryPlaygroundVideoSweep::FFrameStats::Reset()
+{
+	*this = FFrameStats();
+
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysical = StartUsedPhysical;
+}
+
+void FSentryPlaygroundVideoSweep::FFrameStats::AddFrame(float DeltaTime)
+{
+	NumFrames++;
+	FrameMs += DeltaTime * 1000.0;
+	GameThreadMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	RenderThreadMs += FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	GpuMs += FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+FSentryPlaygroundVideoSweep::FSentryPlaygroundVideoSweep(const FSentryVideoSweepConfig& InConfig)
+	: Config(InConfig)
+{
+	for (const FString& Encoder : Config.Encoders)
+	{
+		for (const FIntPoint& Resolution : Config.Resolutions)
+		{
+			for (const int32 FramesPerSecond : Config.FramesPerSecond)
+			{
+				for (const int32 QualityPreset : Config.QualityPresets)
+				{
+					FCombination& Combination = Combinations.AddDefaulted_GetRef();
+					Combination.Encoder = Encoder;
+					Combination.VideoConfig = MakeVideoConfig(Encoder, Resolution, FramesPerSecond, QualityPreset, Config.RecordSeconds);
+				}
+			}
+		}
+	}
+}
+
+FSentryPlaygroundVideoSweep::~FSentryPlaygroundVideoSweep()
+{
+	if (VideoHandler.IsValid())
+	{
+		VideoHandler->StopContinuousRecording();
+	}
+}
+
+void FSentryPlaygroundVideoSweep::Start(UWorld* InWorld)
+{
+	UE_LOG(LogSentrySample, Display, TEXT("Starting crash video sweep: %d combinations, %.0f s each"), Combinations.Num(), Config.RecordSeconds);
+
+	World = InWorld;
+	PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+
+	if (PlayerController.IsValid())
+	{
+		StartRotation = PlayerController->GetControlRotation();
+		StartLocation = PlayerController->GetPawn() ? PlayerController->GetPawn()->GetActorLocation() : FVector::ZeroVector;
+	}
+
+	VideoHandler.Reset(NewObject<USentryCrashVideoHandler>());
+
+	Rows.Add(VideoSweepCsvHeader);
+
+	BeginPhase(EPhase::Baseline);
+}
+
+bool FSentryPlaygroundVideoSweep::Tick(float DeltaTime)
+{
+	if (Phase == EPhase::Finished)
+	{
+		return false;
+	}
+
+	const double PhaseTime = FPlatformTime::Seconds() - PhaseStartTime;
+
+	switch (Phase)
+	{
+	case EPhase::Baseline:
+		UpdateCamera(PhaseTime);
+		BaselineStats.AddFrame(DeltaTime);
+
+		if (PhaseTime >= Config.RecordSeconds)
+		{
+			UE_LOG(LogSentrySample, Display, TEXT("Baseline frame time: %.2f ms"), BaselineStats.FrameMs / FMath::Max(1, BaselineStats.NumFrames));
+			BeginPhase(Combinations.Num() > 0 ? EPhase::Recording : EPhase::Finished);
+		}
+		break;
+
+	case EPhase::Recording:
+		UpdateCamera(PhaseTime);
+		RecordingStats.AddFrame(DeltaTime);
+
+		if (PhaseTime >= Config.RecordSeconds)
+		{
+			EndRecording();
+		}
+		break;
+
+	case EPhase::Finalizing:
+		if (!PendingVideo.IsValid())
+		{
+			// Stopped segmented recording leaves the last segment to be flushed by the encoder
+			if (PhaseTime >= SegmentsFlushSeconds)
+			{
+				CompleteCombination(0.0, GetSegmentsSize());
+			}
+		}
+		else if (PendingVideo.IsReady())
+		{
+			const FString VideoPath = PendingVideo.Get();
+			const double EncodeMs = (FPlatformTime::Seconds() - FinalizeStartTime) * 1000.0;
+
+			VideoHandler->StopContinuousRecording();
+
+			CompleteCombination(EncodeMs, VideoPath.IsEmpty() ? 0 : FMath::Max<int64>(0, IFileManager::Get().FileSize(*VideoPath)));
+		}
+		break;
+
+	case EPhase::Cooldown:
+		if (PhaseTime >= Config.CooldownSeconds)
+		{
+			BeginPhase(CombinationIndex < Combinations.Num() ? EPhase::Recording : EPhase::Finished);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return Phase != EPhase::Finished;
+}
+
+void FSentryPlaygroundVideoSweep::BeginPhase(EPhase InPhase)
+{
+	Phase = InPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+
+	switch (Phase)
+	{
+	case EPhase::Baseline:
+		BaselineStats.Reset();
+		break;
+
+	case EPhase::Recording:
+		BeginRecording();
+		break;
+
+	case EPhase::Finished:
+		if (FFileHelper::SaveStringArrayToFile(Rows, *Config.OutputPath))
+		{
+			UE_LOG(LogSentrySample, Display, TEXT("Crash video sweep report written to %s"), *Config.OutputPath);
+		}
+		else
+		{
+			UE_LOG(LogSentrySample, Error, TEXT("Failed to write crash video sweep report to %s"), *Config.OutputPath);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void FSentryPlaygroundVideoSweep::BeginRecording()
+{
+	const FCombination& Combination = Combinations[CombinationIndex];
+
+	UE_LOG(LogSentrySample, Display, TEXT("Crash video sweep %d/%d: %s %dx%d, %d FPS, quality %d"), CombinationIndex + 1, Combinations.Num(),
+		*Combination.Encoder, Combination.VideoConfig.Width, Combination.VideoConfig.Height, Combination.VideoConfig.TargetFPS, Combination.VideoConfig.QualityPreset);
+
+	BufferMemoryMB = 0.0f;
+
+	RecordingStats.Reset();
+
+	if (!VideoHandler->StartContinuousRecording(Combination.VideoConfig))
+	{
+		UE_LOG(LogSentrySample, Warning, TEXT("Failed to start recording, combination skipped"));
+		CompleteCombination(0.0, 0);
+	}
+}
+
+void FSentryPlaygroundVideoSweep::EndRecording()
+{
+	BufferMemoryMB = VideoHandler->GetEstimatedBufferMemoryMB();
+
+	if (Combinations[CombinationIndex].Encoder == TEXT("recorder"))
+	{
+		// Circular buffer is only encoded when the clip is saved, which is what a crash pays for
+		FinalizeStartTime = FPlatformTime::Seconds();
+		PendingVideo = VideoHandler->FinalizeAndSaveVideoAsync();
+
+		Phase = EPhase::Finalizing;
+		return;
+	}
+
+	// Segments are encoded while recording, so their cost is part of the capture cost and there is nothing left to encode.
+	// Produced segments are measured once the one still being written is flushed.
+	VideoHandler->StopContinuousRecording();
+
+	PendingVideo = TFuture<FString>();
+	BeginPhase(EPhase::Finalizing);
+}
+
+void FSentryPlaygroundVideoSweep::CompleteCombination(double EncodeMs, int64 OutputBytes)
+{
+	const FCombination& Combination = Combinations[CombinationIndex];
+
+	const int32 NumFrames = FMath::Max(1, RecordingStats.NumFrames);
+	const int32 NumBaselineFrames = FMath::Max(1, BaselineStats.NumFrames);
+
+	const double FrameMs = RecordingStats.FrameMs / NumFrames;
+	const double CaptureCostMs = FrameMs - BaselineStats.FrameMs / NumBaselineFrames;
+
+	const FString Row = FString::Printf(TEXT("%s,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f,%lld,%.0f"),
+		*Combination.Encoder, Combination.VideoConfig.Width, Combination.VideoConfig.Height, Combination.VideoConfig.TargetFPS, Combination.VideoConfig.QualityPreset,
+		RecordingStats.NumFrames, FrameMs, CaptureCostMs,
+		RecordingStats.GameThreadMs / NumFrames, RecordingStats.RenderThreadMs / NumFrames, RecordingStats.GpuMs / NumFrames, EncodeMs,
+		(static_cast<double>(RecordingStats.PeakUsedPhysical) - RecordingStats.StartUsedPhysical) / (1024.0 * 1024.0), BufferMemoryMB,
+		OutputBytes, OutputBytes / Config.RecordSeconds);
+
+	UE_LOG(LogSentrySample, Log, TEXT("VIDEO_SWEEP_ROW: %s\n"), *Row);
+
+	Rows.Add(Row);
+
+	CombinationIndex++;
+
+	BeginPhase(EPhase::Cooldown);
+}
+
+void FSentryPlaygroundVideoSweep::UpdateCamera(double PathTime)
+{
+	APlayerController* Controller = PlayerController.Get();
+	if (!Controller)
+	{
+		return;
+	}
+
+	// Same full turn for every run so that all combinations encode comparable footage
+	const float Yaw = StartRotation.Yaw + 360.0f * static_cast<float>(FMath::Clamp(PathTime / Config.RecordSeconds, 0.0, 1.0));
+	Controller->SetControlRotation(FRotator(StartRotation.Pitch, Yaw, 0.0f));
+
+	if (APawn* Pawn = Controller->GetPawn())
+	{
+		Pawn->SetActorLocation(StartLocation);
+	}
+}
+
+int64 FSentryPlaygroundVideoSweep::GetSegmentsSize() const
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *VideoHandler->GetSegmentsDirectory(), TEXT("*"), true, false);
+
+	int64 TotalSize = 0;
+	for (const FString& File : Files)
+	{
+		// Index only lists the segments
+		if (!File.EndsWith(TEXT(".ffconcat")))
+		{
+			TotalSize += FMath::Max<int64>(0, IFileManager::Get().FileSize(*File));
+		}
+	}
+
+	return TotalSize;
+}
+
+FCrashVideoConfig FSentryPlaygroundVideoSweep::MakeVideoConfig(const FString& Encoder, const FIntPoint& Resolution, int32 FramesPerSecond, int32 QualityPreset, float RecordSeconds)
+{
+	FCrashVideoConfig VideoConfig;
+	VideoConfig.LastSecondsToRecord = RecordSeconds;
+	VideoConfig.Width = Resolution.X;
+	VideoConfig.Height = Resolution.Y;
+	VideoConfig.TargetFPS = FramesPerSecond;
+	VideoConfig.QualityPreset = QualityPreset;
+
+	// Anything that would change the requested values behind the sweep's back is turned off
+	VideoConfig.bFitResolutionToViewport = false;
+	VideoConfig.bAdaptiveQuality = false;
+	VideoConfig.bPauseWhenInactive = false;
+	VideoConfig.MaxBufferMemoryMB = 0;
+
+	VideoConfig.bSegmentedRecording = Encoder != TEXT("recorder");
+	VideoConfig.bUseZeroCopyEncoder = Encoder == TEXT("zerocopy");
+
+	// One extra segment is kept so that none of the segments recorded during the run is evicted before it's measured
+	if (VideoConfig.bSegmentedRecording)
+	{
+		VideoConfig.LastSecondsToRecord += VideoConfig.SegmentDurationSeconds;
+	}
+
+	return VideoConfig;
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Sentry. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Async/Future.h"
+#include "SentryCrashVideoConfig.h"
+#include "UObject/StrongObjectPtr.h"
+
+class APlayerController;
+class USentryCrashVideoHandler;
+
+struct FSentryVideoSweepConfig
+{
+	/** Resolutions as `WIDTHxHEIGHT` */
+	TArray<FIntPoint> Resolutions = { FIntPoint(1920, 1080), FIntPoint(1280, 720), FIntPoint(854, 480) };
+	TArray<int32> FramesPerSecond = { 15, 30 };
+	TArray<int32> QualityPresets = { 25, 50, 75 };
+
+	/** Recording backends: `recorder` (circular buffer), `segmented` and `zerocopy` */
+	TArray<FString> Encoders = { TEXT("recorder"), TEXT("segmented"), TEXT("zerocopy") };
+
+	/** Seconds every combination records for, which is also the length of the camera path */
+	float RecordSeconds = 15.0f;
+
+	/** Seconds after every combination that aren't measured to let the recorder settle */
+	float CooldownSeconds = 2.0f;
+
+	FString OutputPath;
+
+	/** Reads `-sweep-resolutions=`, `-sweep-fps=`, `-sweep-quality=`, `-sweep-encoders=` (comma separated lists),
+	 * `-sweep-seconds=`, `-sweep-cooldown=` and `-sweep-output=` overrides. */
+	static FSentryVideoSweepConfig FromCommandLine(const TCHAR* CommandLine);
+};
+
+/**
+ * Measures the cost of crash video recording configurations to pick per-platform presets from data.
+ *
+ * Every combination of resolution, frame rate, quality preset and recording backend records the same camera path:
+ * a full turn of the first player's view from where it stood when the sweep started. A run without recording comes first
+ * and serves as the baseline the capture cost of every combination is measured against. Results are written as CSV,
+ * one row per combination, with sizes normalized to a second of footage.
+ */
+class FSentryPlaygroundVideoSweep
+{
+public:
+	explicit FSentryPlaygroundVideoSweep(const FSentryVideoSweepConfig& InConfig);
+	~FSentryPlaygroundVideoSweep();
+
+	void Start(UWorld* InWorld);
+
+	/** Advances the sweep, returns false once every combination was measured. */
+	bool Tick(float DeltaTime);
+
+	/** Gets the path of the written CSV report. */
+	const FString& GetOutputPath() const { return Config.OutputPath; }
+
+	int32 GetNumCombinations() const { return Combinations.Num(); }
+
+private:
+	enum class EPhase : uint8
+	{
+		Baseline,
+		Recording,
+		Finalizing,
+		Cooldown,
+		Finished
+	};
+
+	struct FCombination
+	{
+		FString Encoder;
+		FCrashVideoConfig VideoConfig;
+	};
+
+	struct FFrameStats
+	{
+		int32 NumFrames = 0;
+		double FrameMs = 0.0;
+		double GameThreadMs = 0.0;
+		double RenderThreadMs = 0.0;
+		double GpuMs = 0.0;
+		uint64 StartUsedPhysical = 0;
+		uint64 PeakUsedPhysical = 0;
+
+		void Reset();
+		void AddFrame(float DeltaTime);
+	};
+
+	void BeginPhase(EPhase InPhase);
+
+	void BeginRecording();
+	void EndRecording();
+	void CompleteCombination(double EncodeMs, int64 OutputBytes);
+
+	/** Turns the view of the first player along the camera path. */
+	void UpdateCamera(double PathTime);
+
+	/** Sums the sizes of the segments written by the last segmented recording, which are all that's in the segments directory. */
+	int64 GetSegmentsSize() const;
+
+	static FCrashVideoConfig MakeVideoConfig(const FString& Encoder, const FIntPoint& Resolution, int32 FramesPerSecond, int32 QualityPreset, float RecordSeconds);
+
+	FSentryVideoSweepConfig Config;
+
+	TArray<FCombination> Combinations;
+	int32 CombinationIndex = 0;
+
+	TStrongObjectPtr<USentryCrashVideoHandler> VideoHandler;
+
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<APlayerController> PlayerController;
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+
+	EPhase Phase = EPhase::Baseline;
+	double PhaseStartTime = 0.0;
+
+	FFrameStats BaselineStats;
+	FFrameStats RecordingStats;
+
+	float BufferMemoryMB = 0.0f;
+
+	double FinalizeStartTime = 0.0;
+	TFuture<FString> PendingVideo;
+
+	TArray<FString> Rows;
+};
@@ -106,7 +106,7 @@ function buildSentryNative()
 {
     Push-Location -Path "$modulesDir/sentry-native"
 
-    cmake -B "build" -D SENTRY_BACKEND=crashpad -D SENTRY_SDK_NAME=sentry.native.unreal -D SENTRY_BUILD_SHARED_LIBS=OFF
+    cmake -B "build" -D SENTRY_BACKEND=crashpad -D SENTRY_SDK_NAME=sentry.native.unreal -D SENTRY_BUILD_SHARED_LIBS=OFF -D CMAKE_PROJECT_INCLUDE="$PSScriptRoot/sentry-native-allocator.cmake"
     cmake --build "build" --target sentry --config RelWithDebInfo --parallel
     cmake --build "build" --target crashpad_handler --config RelWithDebInfo --parallel
     cmake --install "build" --prefix "install" --config RelWithDebInfo
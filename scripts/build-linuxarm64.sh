@@ -4,10 +4,13 @@ set -euo pipefail
 export sentryNativeRoot=$1
 export sentryArtifactsDestination=$2
 
+scriptDir="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+
 rm -rf "${sentryArtifactsDestination}/"*
 
 # Build sentry-native using clang and libc++ for static libs
 cmake -S "${sentryNativeRoot}" -B "${sentryNativeRoot}/build" -D SENTRY_BACKEND=crashpad -D SENTRY_SDK_NAME=sentry.native.unreal -D SENTRY_BUILD_SHARED_LIBS=OFF \
+    -D CMAKE_PROJECT_INCLUDE="${scriptDir}/sentry-native-allocator.cmake" \
     -D CMAKE_BUILD_TYPE=RelWithDebInfo -D CMAKE_C_COMPILER=clang-13 -D CMAKE_CXX_COMPILER="clang++-13" \
     -D CMAKE_C_FLAGS="-mno-outline-atomics" -D CMAKE_CXX_FLAGS="-stdlib=libc++ -mno-outline-atomics" -D CMAKE_EXE_LINKER_FLAGS="-stdlib=libc++ -mno-outline-atomics"
 cmake --build "${sentryNativeRoot}/build" --target sentry --parallel
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Crash handler latency benchmark for the sample app.
+#
+# Runs SentryPlayground with `-crash-timeline`, which enables screenshot, GPU dump and crash video attachments and
+# triggers a controlled crash. The SDK writes the duration of each crash handler stage to SentryCrashTimeline.json,
+# this script combines it with the modification time of the minidump written by the crash backend and fails if the
+# handler or the dump exceeds the given budgets.
+#
+# Usage: python3 measure-crash-latency.py --exe <path to SentryPlayground> --saved-dir <path to Saved> [--dsn <dsn>]
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import time
+
+
+def run_sample(exe, dsn, timeout):
+    args = [exe, '-crash-timeline', '-nosplash', '-unattended', '-log']
+    if dsn:
+        args.append(f'-dsn={dsn}')
+
+    print(f'Running {" ".join(args)}', flush=True)
+
+    try:
+        return subprocess.run(args, timeout=timeout).returncode
+    except subprocess.TimeoutExpired:
+        print(f'Sample app did not crash within {timeout} seconds', file=sys.stderr)
+        return None
+
+
+def find_minidump(database_path, since):
+    # Crashpad keeps reports in its own database while breakpad and inproc write them next to the run data
+    candidates = glob.glob(os.path.join(database_path, '**', '*.dmp'), recursive=True)
+    candidates = [path for path in candidates if os.path.getmtime(path) >= since]
+
+    return max(candidates, key=os.path.getmtime) if candidates else None
+
+
+def wait_for_minidump(database_path, since, timeout):
+    # Out-of-process backends may still be writing the dump after the game process is gone
+    deadline = time.time() + timeout
+    while True:
+        minidump = find_minidump(database_path, since)
+        if minidump or time.time() >= deadline:
+            return minidump
+        time.sleep(0.25)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Measures crash handler latency of the sample app.')
+    parser.add_argument('--exe', required=True, help='Path to the packaged SentryPlayground executable')
+    parser.add_argument('--saved-dir', required=True, help='Path to the Saved directory of the packaged sample')
+    parser.add_argument('--dsn', help='DSN override, e.g. the one of a local mock sink')
+    parser.add_argument('--timeout', type=float, default=120.0, help='Seconds to wait for the sample to crash')
+    parser.add_argument('--handler-budget-ms', type=float, default=5000.0, help='Fail if the crash handler takes longer')
+    parser.add_argument('--dump-budget-ms', type=float, default=10000.0, help='Fail if the minidump is written later than this after the crash')
+    parser.add_argument('--output', help='Path of the JSON file the results are written to')
+    args = parser.parse_args()
+
+    timeline_path = os.path.join(args.saved_dir, 'SentryCrashTimeline.json')
+    if os.path.exists(timeline_path):
+        os.remove(timeline_path)
+
+    exit_code = run_sample(args.exe, args.dsn, args.timeout)
+
+    if not os.path.exists(timeline_path):
+        print(f'Crash timeline was not written to {timeline_path}, exit code: {exit_code}', file=sys.stderr)
+        return 1
+
+    with open(timeline_path, 'r', encoding='utf-8') as file:
+        timeline = json.load(file)
+
+    handler_start = timeline['handler_start_unix_ms'] / 1000.0
+
+    minidump = wait_for_minidump(timeline['database_path'], handler_start, args.dump_budget_ms / 1000.0)
+    time_to_dump_ms = (os.path.getmtime(minidump) - handler_start) * 1000.0 if minidump else None
+
+    result = {
+        'platform': timeline.get('platform'),
+        'exit_code': exit_code,
+        'handler_total_ms': timeline['handler_total_ms'],
+        'time_to_dump_written_ms': time_to_dump_ms,
+        'minidump': minidump,
+        'stages': timeline['stages'],
+    }
+
+    print(f'CRASH_TIMELINE_RESULT: {json.dumps(result)}', flush=True)
+
+    for stage in timeline['stages']:
+        print(f'  {stage["name"]:<16} {stage["duration_ms"]:10.1f} ms')
+    print(f'  {"total":<16} {timeline["handler_total_ms"]:10.1f} ms')
+    print(f'  {"dump written":<16} {time_to_dump_ms:10.1f} ms' if time_to_dump_ms is not None else '  dump written     missing')
+
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as file:
+            json.dump(result, file, indent=2)
+
+    success = True
+
+    if timeline['handler_total_ms'] > args.handler_budget_ms:
+        print(f'Crash handler took {timeline["handler_total_ms"]:.1f} ms, budget is {args.handler_budget_ms:.1f} ms', file=sys.stderr)
+        success = False
+
+    if time_to_dump_ms is None:
+        print(f'No minidump found in {timeline["database_path"]}', file=sys.stderr)
+        success = False
+    elif time_to_dump_ms > args.dump_budget_ms:
+        print(f'Minidump was written {time_to_dump_ms:.1f} ms after the crash, budget is {args.dump_budget_ms:.1f} ms', file=sys.stderr)
+        success = False
+
+    return 0 if success else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
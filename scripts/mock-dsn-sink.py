@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+# Local Sentry ingestion endpoint for stress testing the sample app.
+#
+# Accepts envelopes for any project, counts envelopes, items by type and bytes and prints per-second stats.
+# Point the sample at it with a DSN like http://public@127.0.0.1:8969/1 and run it with `-stress`.
+#
+# Usage: python3 mock-dsn-sink.py [--port 8969] [--host 127.0.0.1]
+
+import argparse
+import gzip
+import json
+import sys
+import threading
+import time
+import zlib
+from collections import Counter
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.envelopes = 0
+        self.bytes = 0
+        self.items = Counter()
+        self.errors = 0
+        self.start_time = time.time()
+
+    def add(self, num_bytes, item_types):
+        with self.lock:
+            self.envelopes += 1
+            self.bytes += num_bytes
+            self.items.update(item_types)
+
+    def add_error(self):
+        with self.lock:
+            self.errors += 1
+
+    def snapshot(self):
+        with self.lock:
+            return self.envelopes, self.bytes, Counter(self.items), self.errors
+
+
+STATS = Stats()
+
+
+def decode_body(body, encoding):
+    if encoding == 'gzip':
+        return gzip.decompress(body)
+    if encoding == 'deflate':
+        return zlib.decompress(body)
+    return body
+
+
+def parse_item_types(envelope):
+    lines = envelope.split(b'\n')
+    item_types = []
+
+    # The first line is the envelope header, then each item is a header line optionally followed by a payload
+    index = 1
+    while index < len(lines):
+        line = lines[index]
+        index += 1
+        if not line.strip():
+            continue
+
+        header = json.loads(line)
+        item_types.append(header.get('type', 'unknown'))
+
+        length = header.get('length')
+        if length is None:
+            index += 1
+            continue
+
+        # Payloads with an explicit length may contain newlines, skip over them by byte count
+        consumed = 0
+        while index < len(lines) and consumed < length:
+            consumed += len(lines[index]) + 1
+            index += 1
+
+    return item_types
+
+
+class EnvelopeHandler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get('Content-Length', 0)))
+
+        try:
+            if not self.path.rstrip('/').endswith('/envelope'):
+                raise ValueError(f'unexpected path {self.path}')
+
+            envelope = decode_body(body, self.headers.get('Content-Encoding'))
+            STATS.add(len(body), parse_item_types(envelope))
+        except Exception as e:
+            STATS.add_error()
+            print(f'Failed to parse request: {e}', file=sys.stderr)
+
+        response = b'{}'
+        self.send_response(200)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(response)))
+        self.end_headers()
+        self.wfile.write(response)
+
+    def log_message(self, format, *args):
+        pass
+
+
+def format_items(items):
+    return ', '.join(f'{item_type}={count}' for item_type, count in sorted(items.items())) or '-'
+
+
+def report_loop(interval):
+    last_envelopes, last_bytes, last_items, _ = STATS.snapshot()
+
+    while True:
+        time.sleep(interval)
+        envelopes, num_bytes, items, errors = STATS.snapshot()
+
+        print(f'{(envelopes - last_envelopes) / interval:.1f} envelopes/s, '
+              f'{(num_bytes - last_bytes) / interval / 1024:.1f} KB/s, '
+              f'items: {format_items(items - last_items)}, errors: {errors}', flush=True)
+
+        last_envelopes, last_bytes, last_items = envelopes, num_bytes, items
+
+
+def print_totals():
+    envelopes, num_bytes, items, errors = STATS.snapshot()
+    duration = max(time.time() - STATS.start_time, 0.001)
+
+    print(f'SINK_RESULT: {json.dumps({"duration_s": round(duration, 1), "envelopes": envelopes, "bytes": num_bytes, "items": dict(items), "errors": errors})}', flush=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mock Sentry DSN sink for stress testing.')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=8969)
+    parser.add_argument('--interval', type=float, default=1.0, help='Seconds between stats reports')
+    args = parser.parse_args()
+
+    server = ThreadingHTTPServer((args.host, args.port), EnvelopeHandler)
+    server.daemon_threads = True
+
+    threading.Thread(target=report_loop, args=(args.interval,), daemon=True).start()
+
+    print(f'Listening on http://{args.host}:{args.port}, use DSN http://public@{args.host}:{args.port}/1', flush=True)
+
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        print_totals()
+
+
+if __name__ == '__main__':
+    main()
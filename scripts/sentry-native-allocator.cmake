@@ -0,0 +1,17 @@
+# Routes sentry-native heap allocations through the hooks the Unreal plugin defines in
+# GenericPlatformSentryAllocator.cpp, so that they go through FMemory and are tracked under the Sentry LLM tag.
+#
+# Passed to the sentry-native configure step via -D CMAKE_PROJECT_INCLUDE=<path to this file>. Only the `sentry` library
+# is affected, crashpad and its handler executable keep using the CRT allocator.
+
+if(NOT EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/src/sentry_alloc.c")
+    return()
+endif()
+
+if(MSVC)
+    set(SENTRY_UNREAL_FORCE_INCLUDE "/FI${CMAKE_CURRENT_LIST_DIR}/sentry-native-allocator.h")
+else()
+    set(SENTRY_UNREAL_FORCE_INCLUDE "-include${CMAKE_CURRENT_LIST_DIR}/sentry-native-allocator.h")
+endif()
+
+set_property(SOURCE "${CMAKE_CURRENT_SOURCE_DIR}/src/sentry_alloc.c" APPEND PROPERTY COMPILE_OPTIONS "${SENTRY_UNREAL_FORCE_INCLUDE}")
@@ -0,0 +1,24 @@
+/*
+ * Force-included into sentry-native's sentry_alloc.c by sentry-native-allocator.cmake.
+ *
+ * The CRT header is included first so that its own malloc/free declarations aren't renamed, then the calls made by
+ * sentry_malloc/sentry_free are redirected to the hooks implemented by the Unreal plugin.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *sentry_unreal_malloc(size_t size);
+void sentry_unreal_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define malloc sentry_unreal_malloc
+#define free sentry_unreal_free